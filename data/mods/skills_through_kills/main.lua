@@ -321,5 +321,6 @@ sidebar.register_widget({
   height = 2,
   order = 25,
   default_toggle = true,
+  refresh = "turn",
   draw = draw_xp_widget,
 })
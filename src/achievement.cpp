@@ -989,6 +989,12 @@ void achievements_tracker::notify( const cata::event &e )
     }
 }
 
+auto achievements_tracker::subscribed_events() const -> std::vector<event_type>
+{
+    // Everything else reaches us through the stats_tracker watchers
+    return { event_type::game_start };
+}
+
 void achievements_tracker::serialize( JsonOut &jsout ) const
 {
     jsout.start_object();
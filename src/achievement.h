@@ -235,6 +235,7 @@ class achievements_tracker : public event_subscriber
 
         void clear();
         void notify( const cata::event & ) override;
+        auto subscribed_events() const -> std::vector<event_type> override;
 
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
@@ -217,9 +217,11 @@ std::string io::enum_to_string<action_id>( action_id data )
             PAIR( ACTION_DISPLAY_SUBMAP_GRID )
             PAIR( ACTION_DISPLAY_SOUND_ABSORPTION )
             PAIR( ACTION_DISPLAY_SOUND_WALLS )
+            PAIR( ACTION_DISPLAY_PATHFINDING_HEAT )
             PAIR( ACTION_TOGGLE_ZONE_OVERLAY )
             PAIR( ACTION_DISPLAY_TILES_NO_VFX )
             PAIR( ACTION_TOGGLE_HOUR_TIMER )
+            PAIR( ACTION_TOGGLE_FRAME_TIMING )
             PAIR( ACTION_SWAP_TO_NPC )
         case NUM_ACTIONS:
             break;
@@ -485,10 +487,14 @@ std::string action_ident( action_id act )
             return "debug_sound_absorption";
         case ACTION_DISPLAY_SOUND_WALLS:
             return "debug_sound_walls";
+        case ACTION_DISPLAY_PATHFINDING_HEAT:
+            return "debug_pathfinding_heat";
         case ACTION_TOGGLE_ZONE_OVERLAY:
             return "toggle_zone_overlay";
         case ACTION_TOGGLE_HOUR_TIMER:
             return "debug_hour_timer";
+        case ACTION_TOGGLE_FRAME_TIMING:
+            return "debug_frame_timing";
         case ACTION_TOGGLE_DEBUG_MODE:
             return "debug_mode";
         case ACTION_ZOOM_OUT:
@@ -617,6 +623,7 @@ bool can_action_change_worldstate( const action_id act )
         case ACTION_DISPLAY_TRANSPARENCY:
         case ACTION_DISPLAY_OUTSIDE:
         case ACTION_DISPLAY_SUBMAP_GRID:
+        case ACTION_DISPLAY_PATHFINDING_HEAT:
         case ACTION_TOGGLE_ZONE_OVERLAY:
         case ACTION_ZOOM_OUT:
         case ACTION_ZOOM_IN:
@@ -1134,7 +1141,8 @@ action_id handle_action_menu()
                 ACTION_DISPLAY_TEMPERATURE, ACTION_DISPLAY_VEHICLE_AI, ACTION_DISPLAY_VISIBILITY,
                 ACTION_DISPLAY_LIGHTING, ACTION_DISPLAY_TRANSPARENCY, ACTION_DISPLAY_RADIATION,
                 ACTION_DISPLAY_OUTSIDE, ACTION_DISPLAY_SUBMAP_GRID, ACTION_DISPLAY_SOUND_ABSORPTION,
-                ACTION_DISPLAY_SOUND_WALLS, ACTION_TOGGLE_ZONE_OVERLAY, ACTION_TOGGLE_DEBUG_MODE
+                ACTION_DISPLAY_SOUND_WALLS, ACTION_DISPLAY_PATHFINDING_HEAT, ACTION_TOGGLE_ZONE_OVERLAY,
+                ACTION_TOGGLE_DEBUG_MODE
             } );
             register_lua_action_entries( category_id );
         } else if( category_id == "interact" ) {
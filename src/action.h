@@ -351,12 +351,16 @@ enum action_id : int {
     ACTION_DISPLAY_SOUND_ABSORPTION,
     /** Toggle sound walls overlay */
     ACTION_DISPLAY_SOUND_WALLS,
+    /** Toggle overlay of tiles the pathfinder explored last turn */
+    ACTION_DISPLAY_PATHFINDING_HEAT,
     /** Toggle zone overlay */
     ACTION_TOGGLE_ZONE_OVERLAY,
     /** Toggle visual effect rendering */
     ACTION_DISPLAY_TILES_NO_VFX,
     /** Toggle timing of the game hours */
     ACTION_TOGGLE_HOUR_TIMER,
+    /** Toggle the frame timing overlay */
+    ACTION_TOGGLE_FRAME_TIMING,
     /** Swap to an NPC in faction menu **/
     ACTION_SWAP_TO_NPC,
     /** Not an action, serves as count of enumerated actions */
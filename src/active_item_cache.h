@@ -8,6 +8,7 @@
 
 #include "point.h"
 #include "safe_reference.h"
+#include "timer_wheel.h"
 
 class item;
 
@@ -23,11 +24,11 @@ struct active_item_count {
     int64_t rottable = 0;
 };
 
-struct active_item_queue {
-    int cursor = 0;
-    int64_t processing_credit = 0;
-    int last_processed_turn = 0;
-    std::vector<cache_reference<item>> items;
+/** An item processed once every @ref speed + 1 turns. */
+struct slow_active_item {
+    cache_reference<item> ref;
+    /// item::processing_speed() when the item was added.
+    int speed = 0;
 };
 
 namespace std
@@ -43,7 +44,13 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, active_item_queue> active_items;
+        /** Items with a processing speed of one, handed out every turn. */
+        std::vector<cache_reference<item>> every_turn_items;
+        /**
+         * Slower items keyed by the turn they are next due.  A handed out item re-arms
+         * itself one period later, so a turn only touches the items due on it.
+         */
+        timer_wheel<slow_active_item> slow_items;
         std::unordered_map<special_item_type, std::vector<cache_reference<item>>> special_items;
 
     public:
@@ -81,9 +88,9 @@ class active_item_cache
         auto get_const() const -> std::vector<const item *>;
 
         /**
-         * Returns items from each list at the average rate requested by item::processing_speed().
-         * Items returned are rotated through their respective lists, otherwise only the first
-         * n items will ever be processed.
+         * Returns the items due this turn: every item of processing speed one, and each slower
+         * item once every item::processing_speed() + 1 turns since it was added.  Turns spent
+         * outside the reality bubble are caught up at once, handing each due item out once.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
          */
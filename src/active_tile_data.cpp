@@ -174,6 +174,13 @@ void solar_tile::update_internal( time_point to, const tripoint_abs_ms &p, distr
     grid.mod_resource( static_cast<int>( std::min( static_cast<int64_t>( INT_MAX ), produced ) ) );
 }
 
+auto solar_tile::next_update_due() const -> std::optional<time_point>
+{
+    // Sunlight is summed in whole ticks, see above
+    constexpr int tick_turns = to_turns<int>( 10_minutes );
+    return time_point::from_turn( ( to_turn<int>( get_last_updated() ) / tick_turns + 1 ) * tick_turns );
+}
+
 auto solar_tile::get_power_w() const -> int
 {
     return static_cast<int>( compute_solar_energy( power, sunlight( calendar::turn ) ) );
@@ -212,6 +219,11 @@ void battery_tile::update_internal( time_point, const tripoint_abs_ms &, distrib
     // TODO: Shouldn't have this function!
 }
 
+auto battery_tile::next_update_due() const -> std::optional<time_point>
+{
+    return std::nullopt;
+}
+
 active_tile_data *battery_tile::clone() const
 {
     return new battery_tile( *this );
@@ -371,6 +383,15 @@ void steady_consumer_tile::update_internal( time_point to, const tripoint_abs_ms
     get_distribution_grid_tracker().get_transform_queue().add( p, transform.id, transform.msg );
 }
 
+auto steady_consumer_tile::next_update_due() const -> std::optional<time_point>
+{
+    const int every = to_turns<int>( consume_every );
+    if( every <= 0 ) {
+        return std::nullopt;
+    }
+    return time_point::from_turn( ( to_turn<int>( get_last_updated() ) / every + 1 ) * every );
+}
+
 active_tile_data *steady_consumer_tile::clone() const
 {
     return new steady_consumer_tile( *this );
@@ -401,6 +422,11 @@ void vehicle_connector_tile::update_internal( time_point, const tripoint_abs_ms
 {
 }
 
+auto vehicle_connector_tile::next_update_due() const -> std::optional<time_point>
+{
+    return std::nullopt;
+}
+
 active_tile_data *vehicle_connector_tile::clone() const
 {
     return new vehicle_connector_tile( *this );
@@ -438,6 +464,11 @@ void countdown_tile::update_internal( time_point to, const tripoint_abs_ms &p,
 
 }
 
+auto countdown_tile::next_update_due() const -> std::optional<time_point>
+{
+    return get_last_updated() + ( ticks == -1 ? timer : time_duration::from_turns( ticks ) );
+}
+
 active_tile_data *countdown_tile::clone() const
 {
     return new countdown_tile( *this );
@@ -470,6 +501,11 @@ void grid_link_tile::update_internal( time_point, const tripoint_abs_ms &,
     // outside the normal per-grid update path.  Nothing to do here.
 }
 
+auto grid_link_tile::next_update_due() const -> std::optional<time_point>
+{
+    return std::nullopt;
+}
+
 active_tile_data *grid_link_tile::clone() const
 {
     return new grid_link_tile( *this );
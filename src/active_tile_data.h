@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include "calendar.h"
 #include "coordinates.h"
@@ -32,13 +33,22 @@ class active_tile_data
             last_updated = to;
         }
 
-        time_point get_last_updated() {
+        time_point get_last_updated() const {
             return last_updated;
         }
         void set_last_updated( time_point t ) {
             last_updated = t;
         }
 
+        /**
+         * Earliest time at which updating this tile can have any effect, or nullopt if it
+         * only acts when other tiles draw on it or feed into it.  Updates catch up from
+         * @ref last_updated, so updating later than this loses nothing.
+         */
+        virtual auto next_update_due() const -> std::optional<time_point> {
+            return last_updated + 1_turns;
+        }
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
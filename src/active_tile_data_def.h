@@ -28,6 +28,7 @@ class battery_tile : public active_tile_data
         int max_stored;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -71,6 +72,7 @@ class solar_tile : public active_tile_data
         int power;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -87,6 +89,7 @@ class steady_consumer_tile : public active_tile_data
         active_tiles::furn_transform transform;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -99,6 +102,7 @@ class vehicle_connector_tile : public active_tile_data
         std::vector<tripoint_abs_ms> connected_vehicles;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -113,6 +117,7 @@ class countdown_tile : public active_tile_data
         int ticks = -1;
 
         void update_internal( time_point to, const tripoint_abs_ms &p, distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -188,6 +193,7 @@ class grid_link_tile : public active_tile_data
 
         void update_internal( time_point to, const tripoint_abs_ms &p,
                               distribution_grid &grid ) override;
+        auto next_update_due() const -> std::optional<time_point> override;
         active_tile_data *clone() const override;
         const std::string &get_type() const override;
         void store( JsonOut &jsout ) const override;
@@ -2753,6 +2753,10 @@ static std::unordered_set<tripoint_abs_ms> generic_multi_activity_locations( pla
             if( found_one_point ) {
                 break;
             }
+            // Most of the search area is bare ground, which the submap item rows rule out
+            if( !here.has_items( elem ) ) {
+                continue;
+            }
             for( const item * const &stack_elem : here.i_at( elem ) ) {
                 if( stack_elem->has_var( "activity_var" ) && stack_elem->get_var( "activity_var", "" ) == p.name ) {
                     const furn_t &f = here.furn( elem ).obj();
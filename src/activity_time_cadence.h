@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "calendar.h"
 
 namespace activity_time_cadence
@@ -25,4 +27,16 @@ inline constexpr auto cache_refresh() -> time_duration
     return fixed_window();
 }
 
+/** Least real time between full redraws while waiting, however fast turns pass. */
+inline constexpr auto render_min_wall_interval() -> std::chrono::milliseconds
+{
+    return std::chrono::milliseconds{ 500 };
+}
+
+/** Least real time between refreshes of the waiting progress popup. */
+inline constexpr auto popup_min_wall_interval() -> std::chrono::milliseconds
+{
+    return std::chrono::milliseconds{ 100 };
+}
+
 } // namespace activity_time_cadence
@@ -559,7 +559,10 @@ void advanced_inventory::recalc_pane( side p )
 {
     auto &pane = panes[p];
     pane.recalc = false;
+    pane.narrow = false;
     pane.items.clear();
+    // Filtering and naming the stacks ask for the same names over and over
+    const item::tname_memo_scope names;
     // Add items from the source location or in case of all 9 surrounding squares,
     // add items from several locations.
     if( pane.get_area() == AIM_ALL ) {
@@ -600,6 +603,31 @@ void advanced_inventory::recalc_pane( side p )
     } else {
         pane.add_items_from_area( squares[pane.get_area()] );
     }
+    arrange_pane( pane );
+}
+
+void advanced_inventory::narrow_pane( side p )
+{
+    auto &pane = panes[p];
+    pane.narrow = false;
+    // The totals of the pane's area follow the entries it shows
+    advanced_inv_area &square = squares[pane.get_area()];
+    std::erase_if( pane.items, [&]( const advanced_inv_listitem & it ) {
+        if( !it.is_item_entry() ) {
+            return true;
+        }
+        if( !pane.is_filtered( it ) ) {
+            return false;
+        }
+        square.volume -= it.volume;
+        square.weight -= it.weight;
+        return true;
+    } );
+    arrange_pane( pane );
+}
+
+void advanced_inventory::arrange_pane( advanced_inventory_pane &pane )
+{
     // Insert category headers (only expected when sorting by category)
     if( pane.sortby == SORTBY_CATEGORY ) {
         std::set<const item_category *> categories;
@@ -629,6 +657,8 @@ void advanced_inventory::redraw_pane( side p )
     auto &pane = panes[p];
     if( recalc || pane.recalc ) {
         recalc_pane( p );
+    } else if( pane.narrow ) {
+        narrow_pane( p );
     }
     pane.fix_index();
 
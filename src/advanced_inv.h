@@ -132,6 +132,10 @@ class advanced_inventory
         bool move_all_items( bool nested_call = false );
         void print_items( const advanced_inventory_pane &pane, bool active );
         void recalc_pane( side p );
+        /** Drops the entries of a pane that its narrowed filter no longer lets through. */
+        void narrow_pane( side p );
+        /** Adds category headers, sorts and paginates the entries of a pane. */
+        void arrange_pane( advanced_inventory_pane &pane );
         void redraw_pane( side p );
         void redraw_sidebar();
         // Returns the x coordinate where the header started. The header is
@@ -275,7 +275,11 @@ void advanced_inventory_pane::set_filter( const std::string &new_filter )
     if( filter == new_filter ) {
         return;
     }
+    // Container contents aren't filtered, so dropping entries by the filter would be wrong
+    narrow = !recalc && get_area() != AIM_CONTAINER && filter_narrows( filter, new_filter );
     filter = new_filter;
     filtercache.clear();
-    recalc = true;
+    if( !narrow ) {
+        recalc = true;
+    }
 }
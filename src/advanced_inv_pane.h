@@ -80,6 +80,10 @@ class advanced_inventory_pane
          * Whether to recalculate the content of this pane.
          */
         bool recalc = false;
+        /**
+         * Whether the filter was narrowed, so only the current entries need checking again.
+         */
+        bool narrow = false;
 
         void add_items_from_area( advanced_inv_area &square, bool vehicle_override = false );
         /**
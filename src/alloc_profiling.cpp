@@ -0,0 +1,153 @@
+#include "alloc_profiling.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(CATA_ALLOC_PROFILING) && defined(_WIN32)
+#include <malloc.h>
+#endif
+
+#include "profile.h"
+
+namespace alloc_profiling
+{
+
+namespace
+{
+
+struct thread_slot {
+    std::atomic<std::uint64_t> allocations{ 0 };
+    std::atomic<std::uint64_t> bytes{ 0 };
+};
+
+// Nothing here may allocate, since it runs inside operator new.
+std::array<thread_slot, max_threads> slots;
+std::atomic<std::size_t> slots_used{ 0 };
+thread_local std::size_t slot_index = max_threads;
+
+auto own_slot() -> thread_slot &
+{
+    if( slot_index == max_threads ) {
+        slot_index = std::min( slots_used.fetch_add( 1, std::memory_order_relaxed ),
+                               max_threads - 1 );
+    }
+    return slots[slot_index];
+}
+
+auto read( const thread_slot &slot ) -> counts
+{
+    return counts{ slot.allocations.load( std::memory_order_relaxed ),
+                   slot.bytes.load( std::memory_order_relaxed ) };
+}
+
+#if defined(CATA_ALLOC_PROFILING)
+void record( const std::size_t size )
+{
+    thread_slot &slot = own_slot();
+    // Only the owning thread writes a slot, other threads merely read it.
+    slot.allocations.store( slot.allocations.load( std::memory_order_relaxed ) + 1,
+                            std::memory_order_relaxed );
+    slot.bytes.store( slot.bytes.load( std::memory_order_relaxed ) + size,
+                      std::memory_order_relaxed );
+}
+#endif
+
+} // namespace
+
+auto this_thread() -> counts
+{
+    return read( own_slot() );
+}
+
+auto this_thread_slot() -> std::size_t
+{
+    own_slot();
+    return slot_index;
+}
+
+auto per_thread() -> std::vector<counts>
+{
+    const auto used = std::min( slots_used.load( std::memory_order_relaxed ), max_threads );
+    auto result = std::vector<counts>();
+    result.reserve( used );
+    for( std::size_t i = 0; i < used; ++i ) {
+        result.push_back( read( slots[i] ) );
+    }
+    return result;
+}
+
+auto total() -> counts
+{
+    auto sum = counts();
+    for( const counts &c : per_thread() ) {
+        sum += c;
+    }
+    return sum;
+}
+
+} // namespace alloc_profiling
+
+#if defined(CATA_ALLOC_PROFILING)
+
+// The other forms of new and delete are defined by the standard library in terms of these.
+
+auto operator new( const std::size_t size ) -> void *
+{
+    alloc_profiling::record( size );
+    void *const p = std::malloc( size == 0 ? 1 : size );
+    if( p == nullptr ) {
+        throw std::bad_alloc();
+    }
+    TracyAlloc( p, size );
+    return p;
+}
+
+auto operator new( const std::size_t size, const std::align_val_t alignment ) -> void *
+{
+    alloc_profiling::record( size );
+    const auto align = static_cast<std::size_t>( alignment );
+    // aligned_alloc wants a multiple of the alignment
+    const auto rounded = std::max( ( size + align - 1 ) / align * align, align );
+#if defined(_WIN32)
+    void *const p = _aligned_malloc( rounded, align );
+#else
+    void *const p = std::aligned_alloc( align, rounded );
+#endif
+    if( p == nullptr ) {
+        throw std::bad_alloc();
+    }
+    TracyAlloc( p, size );
+    return p;
+}
+
+void operator delete( void *const p ) noexcept
+{
+    TracyFree( p );
+    std::free( p );
+}
+
+void operator delete( void *const p, std::size_t ) noexcept
+{
+    TracyFree( p );
+    std::free( p );
+}
+
+void operator delete( void *const p, std::align_val_t ) noexcept
+{
+    TracyFree( p );
+#if defined(_WIN32)
+    _aligned_free( p );
+#else
+    std::free( p );
+#endif
+}
+
+void operator delete( void *const p, std::size_t, const std::align_val_t alignment ) noexcept
+{
+    operator delete( p, alignment );
+}
+
+#endif
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * Heap allocation counts, per thread, from a replacement of the global operator new.
+ *
+ * The replacement is only built with CATA_ALLOC_PROFILING (the CMake option of the same
+ * name), since every allocation pays for it.  It also reports each allocation to Tracy
+ * memory profiling when Tracy is built in.  Without it, every count stays at zero.
+ *
+ * @ref frame_timing charges the counts of the main thread to the named phases the same
+ * way it charges time, so they can be read per do_turn phase.
+ */
+namespace alloc_profiling
+{
+
+#if defined(CATA_ALLOC_PROFILING)
+inline constexpr bool compiled_in = true;
+#else
+inline constexpr bool compiled_in = false;
+#endif
+
+/** Threads counted separately; any further threads share the last slot. */
+inline constexpr std::size_t max_threads = 64;
+
+struct counts {
+    std::uint64_t allocations = 0;
+    std::uint64_t bytes = 0;
+
+    auto operator+=( const counts &rhs ) -> counts & {
+        allocations += rhs.allocations;
+        bytes += rhs.bytes;
+        return *this;
+    }
+    auto operator-( const counts &rhs ) const -> counts {
+        return counts{ allocations - rhs.allocations, bytes - rhs.bytes };
+    }
+};
+
+/** Allocations made so far by the calling thread. */
+auto this_thread() -> counts;
+
+/** Slot the calling thread is counted in, an index into @ref per_thread. */
+auto this_thread_slot() -> std::size_t;
+
+/** Allocations made so far by each thread that has allocated, by slot. */
+auto per_thread() -> std::vector<counts>;
+
+/** Allocations made so far by all threads. */
+auto total() -> counts;
+
+} // namespace alloc_profiling
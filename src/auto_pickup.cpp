@@ -637,12 +637,14 @@ void rule_list::refresh_map_items( cache &map_items ) const
             continue;
         }
 
+        // Compiled once per rule, it is checked against every item type
+        const auto matches = filter_from_string<itype>( elem.sRule, wildcard_itype_filter );
         if( !elem.bExclude ) {
             //Check include patterns against all itemfactory items
             for( const itype *e : item_controller->all() ) {
                 const std::string &cur_item = e->nname( 1 );
 
-                if( !test_pattern_function( *e, elem.sRule ) && !wildcard_match( cur_item, elem.sRule ) ) {
+                if( !matches( *e ) && !wildcard_match( cur_item, elem.sRule ) ) {
                     continue;
                 }
 
@@ -653,7 +655,7 @@ void rule_list::refresh_map_items( cache &map_items ) const
             //only re-exclude items from the existing mapping for now
             //new exclusions will process during pickup attempts
             for( auto &map_item : map_items ) {
-                if( !test_pattern_function( *( map_items.temp_items[ map_item.first ] ), elem.sRule ) &&
+                if( !matches( *( map_items.temp_items[ map_item.first ] ) ) &&
                     !wildcard_match( map_item.first, elem.sRule ) ) {
                     continue;
                 }
@@ -251,7 +251,7 @@ void avatar::prepare_map_memory_region( const tripoint_abs_ms &p1, const tripoin
     player_map_memory->prepare_region( p1, p2 );
 }
 
-const memorized_terrain_tile &avatar::get_memorized_tile( const tripoint_abs_ms &pos ) const
+memorized_terrain_tile avatar::get_memorized_tile( const tripoint_abs_ms &pos ) const
 {
     return player_map_memory->get_tile( pos );
 }
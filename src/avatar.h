@@ -79,6 +79,9 @@ class avatar : public player
         bool save_map_memory();
         void load_map_memory();
         void clear_map_memory();
+        const map_memory &get_map_memory() const {
+            return *player_map_memory;
+        }
 
         // newcharacter.cpp
         bool create( character_type type, const std::string &tempname = "" );
@@ -122,7 +125,7 @@ class avatar : public player
         void memorize_tile( const tripoint_abs_ms &pos, const std::string &ter, int subtile,
                             int rotation );
         /** Returns last stored overlay tile in given location in tiles mode */
-        const memorized_terrain_tile &get_memorized_tile( const tripoint_abs_ms &p ) const;
+        memorized_terrain_tile get_memorized_tile( const tripoint_abs_ms &p ) const;
         /** Memorizes the base terrain tile separately from the overlay slot */
         void memorize_terrain_tile( const tripoint_abs_ms &pos, const std::string &ter, int subtile,
                                     int rotation );
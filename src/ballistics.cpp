@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <optional>
 #include <set>
@@ -90,6 +91,40 @@ scoped_projectile_animation_suppression::~scoped_projectile_animation_suppressio
 namespace
 {
 
+/**
+ * The clear path of the last shot that was on target.  Every round of a burst, and every
+ * pellet of a volley, fired at the same tile would otherwise search the same lines of sight
+ * again.  Good until the map shifts or its sight caches change.
+ */
+struct clear_path_memo {
+    const map *m = nullptr;
+    point_abs_sm map_origin;
+    std::uint64_t generation = 0;
+    tripoint_bub_ms source;
+    tripoint_bub_ms target;
+    std::vector<tripoint_bub_ms> path;
+};
+
+auto find_clear_path_memoized( const map &here, const tripoint_bub_ms &source,
+                               const tripoint_bub_ms &target ) -> std::vector<tripoint_bub_ms>
+{
+    // Projectiles change the map, so they are only ever fired from the main thread.
+    static clear_path_memo memo;
+    if( memo.m != &here || memo.map_origin != here.get_abs_sub() ||
+        memo.generation != here.sight_generation() || memo.source != source ||
+        memo.target != target ) {
+        memo = clear_path_memo{
+            .m = &here,
+            .map_origin = here.get_abs_sub(),
+            .generation = here.sight_generation(),
+            .source = source,
+            .target = target,
+            .path = here.find_clear_path( source, target ),
+        };
+    }
+    return memo.path;
+}
+
 void drop_or_embed_projectile( dealt_projectile_attack &attack )
 {
     auto &proj = attack.proj;
@@ -427,7 +462,7 @@ auto projectile_attack( const projectile &proj_arg, const tripoint_bub_ms &sourc
         trajectory = line_to( source, target );
     } else {
         // Go around obstacles a little if we're on target.
-        trajectory = here.find_clear_path( source, target );
+        trajectory = find_clear_path_memoized( here, source, target );
     }
 
     add_msg( m_debug, "missed_by_tiles: %.2f; missed_by: %.2f; target (orig/hit): %d,%d,%d/%d,%d,%d",
@@ -1,9 +1,9 @@
 #include "batch_turns.h"
 
 #include <algorithm>
-#include <bitset>
 #include <cstddef>
 #include <ranges>
+#include <utility>
 
 #include "profile.h"
 
@@ -101,22 +101,7 @@ void batch_turns_field( submap &sm, int n )
         }
     } );
 
-    // Compact + deduplicate — mirrors the same fix in process_fields_in_submap.
-    std::bitset<SEEX *SEEY> seen;
-    sm.field_cache.erase(
-    std::ranges::remove_if( sm.field_cache, [&]( const point_sm_ms & local ) {
-        if( !sm.get_field( local ).displayed_field_type() ) {
-            return true;
-        }
-        const auto idx = static_cast<std::size_t>( local.x() + local.y() * SEEX );
-        if( seen.test( idx ) ) {
-            return true;
-        }
-        seen.set( idx );
-        return false;
-    } ).begin(),
-    sm.field_cache.end()
-    );
+    sm.compact_field_cache();
 }
 
 void batch_turns_items( submap &sm, int n )
@@ -136,6 +121,63 @@ void batch_turns_items( submap &sm, int n )
     );
 }
 
+static void batch_turns_vehicles( submap &sm, int )
+{
+    for( const auto &veh_ptr : sm.vehicles ) {
+        if( veh_ptr ) {
+            veh_ptr->update_time( calendar::turn );
+        }
+    }
+}
+
+namespace
+{
+
+struct batch_turns_step {
+    std::string name;
+    submap_batch_turns_fn advance;
+};
+
+auto batch_turns_registry() -> std::vector<batch_turns_step> &
+{
+    static std::vector<batch_turns_step> steps = {
+        { "field", batch_turns_field },
+        { "items", batch_turns_items },
+        { "vehicles", batch_turns_vehicles },
+    };
+    return steps;
+}
+
+} // namespace
+
+void register_submap_batch_turns( const std::string &name, submap_batch_turns_fn advance )
+{
+    auto &steps = batch_turns_registry();
+    const auto found = std::ranges::find( steps, name, &batch_turns_step::name );
+    if( found != steps.end() ) {
+        found->advance = std::move( advance );
+    } else {
+        steps.push_back( { name, std::move( advance ) } );
+    }
+}
+
+void unregister_submap_batch_turns( const std::string &name )
+{
+    auto &steps = batch_turns_registry();
+    std::erase_if( steps, [&]( const batch_turns_step & step ) {
+        return step.name == name;
+    } );
+}
+
+auto submap_batch_turns_steps() -> std::vector<std::string>
+{
+    std::vector<std::string> names;
+    for( const batch_turns_step &step : batch_turns_registry() ) {
+        names.push_back( step.name );
+    }
+    return names;
+}
+
 void run_submap_batch_turns( submap &sm, int n )
 {
     ZoneScoped;
@@ -143,11 +185,8 @@ void run_submap_batch_turns( submap &sm, int n )
     if( n <= 0 ) {
         return;
     }
-    batch_turns_field( sm, n );
-    batch_turns_items( sm, n );
-    for( const auto &veh_ptr : sm.vehicles ) {
-        if( veh_ptr ) {
-            veh_ptr->update_time( calendar::turn );
-        }
+    sm.load_deferred_items();
+    for( const batch_turns_step &step : batch_turns_registry() ) {
+        step.advance( sm, n );
     }
 }
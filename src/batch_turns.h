@@ -13,8 +13,18 @@
  * distribution_grid_tracker::update().
  */
 
+#include <functional>
+#include <string>
+#include <vector>
+
 class submap;
 
+/**
+ * Closed-form catch-up of one subsystem's state in a submap, by a number of turns.
+ * Must scale O(1) with the number of turns and have no side effects outside the submap.
+ */
+using submap_batch_turns_fn = std::function<void( submap &, int )>;
+
 /**
  * Analytically advance field intensity/age in @p sm by @p n turns.
  * Uses the half_life formula to compute expected intensity drops rather than
@@ -32,8 +42,21 @@ void batch_turns_field( submap &sm, int n );
 void batch_turns_items( submap &sm, int n );
 
 /**
- * Convenience wrapper: calls batch_turns_field, batch_turns_items, and
- * vehicle::update_time for every vehicle on the submap.  Intended for use
+ * Add a catch-up step run by run_submap_batch_turns, after those already there.
+ * A step registered under an existing @p name replaces it in place.
+ * Steps are registered on the main thread, before any submap is caught up.
+ * Fields, items and vehicles are registered from the start, in that order.
+ */
+void register_submap_batch_turns( const std::string &name, submap_batch_turns_fn advance );
+
+/** Remove the catch-up step registered as @p name, if any. */
+void unregister_submap_batch_turns( const std::string &name );
+
+/** Names of the registered catch-up steps, in the order they run. */
+auto submap_batch_turns_steps() -> std::vector<std::string>;
+
+/**
+ * Runs every registered catch-up step on the submap.  Intended for use
  * immediately before submap actualization.
  */
 void run_submap_batch_turns( submap &sm, int n );
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "game_constants.h"
+#include "point.h"
+
+/**
+ * Element order of the per-tile arrays of level_cache, and of every scratch grid that
+ * is indexed alongside them or handed to shadowcasting.  Selected at build time:
+ *
+ * - linear (default): `x * sy + y`, one column after another.
+ * - tiled (`CATA_LEVEL_CACHE_TILED`, CMake `LEVEL_CACHE_LAYOUT=TILED`): one SEEX x SEEY
+ *   block per submap, blocks column by column and tiles column by column inside a
+ *   block.  A tile's 3x3 neighbourhood then spans at most four blocks of 576 bytes of
+ *   floats instead of three full columns of the reality bubble.  Grids must be a whole
+ *   number of submaps on both axes, which every level_cache is.
+ *
+ *   Blocks are also addressed through a ring origin (grid_shape::origin): the block of
+ *   submap (0, 0) sits at block `origin` of the storage and the rest wrap around.
+ *   map::shift then moves the origin by the shift and refills only the blocks that
+ *   scrolled in, instead of copying every cache.
+ *
+ * The GPU lighting shaders assume the linear order, so the tiled layout cannot be
+ * combined with CATA_SDL.
+ */
+namespace cache_layout
+{
+
+#if defined(CATA_LEVEL_CACHE_TILED)
+inline constexpr bool tiled = true;
+#else
+inline constexpr bool tiled = false;
+#endif
+
+/** Size of a grid in tiles, and where its first block is stored. */
+struct grid_shape {
+    int sx = 0;
+    int sy = 0;
+    /// Storage block holding submap (0, 0).  Always zero in the linear layout and for
+    /// scratch grids; each coordinate is in [0, blocks on that axis).
+    point origin = point_zero;
+
+    /** The shape after the grid content moved by @p by submaps, as map::shift does. */
+    constexpr auto shifted( const point &by ) const -> grid_shape {
+        const int blocks_x = sx / SEEX;
+        const int blocks_y = sy / SEEY;
+        return grid_shape{ sx, sy, point( ( ( origin.x + by.x ) % blocks_x + blocks_x ) % blocks_x,
+                                          ( ( origin.y + by.y ) % blocks_y + blocks_y ) % blocks_y ) };
+    }
+};
+
+/** Index of tile (@p x, @p y) in a grid of @p shape */
+constexpr auto index( const int x, const int y, const grid_shape &shape ) -> int
+{
+    if constexpr( tiled ) {
+        const int blocks_x = shape.sx / SEEX;
+        const int blocks_y = shape.sy / SEEY;
+        int bx = x / SEEX + shape.origin.x;
+        int by = y / SEEY + shape.origin.y;
+        bx -= bx >= blocks_x ? blocks_x : 0;
+        by -= by >= blocks_y ? blocks_y : 0;
+        return ( bx * blocks_y + by ) * ( SEEX * SEEY ) + ( x % SEEX ) * SEEY + y % SEEY;
+    } else {
+        return x * shape.sy + y;
+    }
+}
+
+/** Inverse of index() */
+constexpr auto point_at( const int i, const grid_shape &shape ) -> point
+{
+    if constexpr( tiled ) {
+        const int block = i / ( SEEX * SEEY );
+        const int in_block = i % ( SEEX * SEEY );
+        const int blocks_x = shape.sx / SEEX;
+        const int blocks_y = shape.sy / SEEY;
+        int bx = block / blocks_y - shape.origin.x;
+        int by = block % blocks_y - shape.origin.y;
+        bx += bx < 0 ? blocks_x : 0;
+        by += by < 0 ? blocks_y : 0;
+        return point( bx * SEEX + in_block / SEEY, by * SEEY + in_block % SEEY );
+    } else {
+        return point( i / shape.sy, i % shape.sy );
+    }
+}
+
+} // namespace cache_layout
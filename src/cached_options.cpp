@@ -7,11 +7,15 @@ bool debug_mode = false;
 bool json_report_strict = true;
 bool use_tiles = false;
 bool colored_lighting = false;
+bool pipeline_gpu_lighting = false;
+int light_cluster_distance = 60;
 bool use_pinyin_search = false;
 bool use_tiles_overmap = false;
 bool log_from_top;
 int message_ttl;
 int message_cooldown;
+int message_limit = 255;
+int turn_spike_threshold_ms = 0;
 bool display_mod_source;
 bool display_object_ids;
 bool trigdist;
@@ -23,6 +27,10 @@ float prevent_occlusion_min_dist = 0.0f;
 float prevent_occlusion_max_dist = 0.0f;
 bool static_z_effect = false;
 bool overmap_transparency = true;
+bool vehicle_armor_color = true;
+int lua_idle_gc_step_kb = 64;
+int lua_memory_limit_mb = 0;
+int lua_task_budget_us = 2000;
 bool tile_iso;
 bool pixel_minimap_option = false;
 int PICKUP_RANGE;
@@ -34,13 +42,25 @@ int  lod_demotion_cooldown = 3;
 int  lod_action_budget = 128;
 int  lod_macro_interval = 3;
 int  lod_coarse_scent_interval = 3;
+int  lod_coarse_replan_interval = 3;
 int  lod_group_morale_max_tier = 0;
 int  activity_skip_monster_lod_gate = 1;
 
 bool reality_bubble_fire_spread = false;
 visibility_scaling_mode visibility_scaling = visibility_scaling_mode::smart;
 bool lazy_border_enabled        = false;
+bool predictive_prefetch_enabled = false;
+bool deferred_submap_items = false;
+bool zlevel_lighting_culling = true;
+bool npc_field_of_view = true;
+bool hierarchical_pathfinding = true;
+bool persistent_d_maps = true;
+bool flow_field_pathfinding = true;
+bool binary_map_saves = false;
+bool dictionary_save_compression = false;
 int  retained_omt_cache_length = 3;
+int  map_memory_budget_mb      = 0;
+int  lazy_border_sim_interval  = 0;
 int  fire_spread_submap_cap    = 25;
 pocket_sim_level pocket_simulation_level = pocket_sim_level::off;
 int  safe_mode_proximity = 0;
@@ -48,8 +68,15 @@ int  safe_mode_proximity = 0;
 bool parallel_enabled = true;
 bool parallel_monster_planning = true;
 int  monster_plan_chunk_size = 8;
+bool parallel_npc_planning = true;
 bool parallel_map_cache = true;
 bool parallel_scent_update = true;
+bool parallel_field_processing = true;
+bool parallel_item_processing = true;
+bool parallel_pathfinding = true;
+bool parallel_sound_flood_fill = true;
+bool parallel_explosion_shrapnel = true;
+bool parallel_autodrive_planning = true;
 
 FungalOptions fungal_opt;
 
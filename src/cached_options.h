@@ -31,6 +31,16 @@ extern bool json_report_strict;
 extern bool use_tiles;
 /** Render-only colored light tinting. Always false for non-TILES builds. */
 extern bool colored_lighting;
+/**
+ * Let GPU lighting dispatched at the start of a turn finish at its first reader instead of
+ * before monsters move.  Always false for builds without SDL GPU compute.
+ */
+extern bool pipeline_gpu_lighting;
+/**
+ * Distance from the player past which neighbouring vehicle lights are cast as one.
+ * 0 only merges lights sharing a tile.  Cached from the LIGHT_CLUSTER_DISTANCE option.
+ */
+extern int light_cluster_distance;
 
 /**
  * Enable pinyin-based fallback matching for Chinese search text.
@@ -47,6 +57,10 @@ extern bool use_tiles_overmap;
 extern bool log_from_top;
 extern int message_ttl;
 extern int message_cooldown;
+/** Messages kept in the log; cached from MESSAGE_LIMIT. */
+extern int message_limit;
+/** Busy time, in ms, over which a turn has the turns around it written out; 0 for never. */
+extern int turn_spike_threshold_ms;
 
 /** Display mod source for items, furniture, terrain and monsters.*/
 extern bool display_mod_source;
@@ -83,6 +97,16 @@ extern bool static_z_effect;
 /** Render overmap air as transparent and render tiles that are below. */
 extern bool overmap_transparency;
 
+/** Vehicle plating colors the part it covers, see vehicle::part_color. */
+extern bool vehicle_armor_color;
+
+/** KiB of Lua garbage collected per step while waiting for input, 0 to leave it to Lua. */
+extern int lua_idle_gc_step_kb;
+/** MiB all Lua states may hold together before allocations fail, 0 for no limit. */
+extern int lua_memory_limit_mb;
+/** Microseconds per turn that Lua tasks may be resumed for, see cata::run_lua_tasks(). */
+extern int lua_task_budget_us;
+
 /**
  * Whether to show the pixel minimap. Always false for ncurses build,
  * but can be toggled during game in sdl build.
@@ -109,6 +133,7 @@ extern int  lod_demotion_cooldown;
 extern int  lod_action_budget;
 extern int  lod_macro_interval;
 extern int  lod_coarse_scent_interval;
+extern int  lod_coarse_replan_interval;
 extern int  lod_group_morale_max_tier;
 extern int  activity_skip_monster_lod_gate;
 
@@ -124,7 +149,28 @@ enum class visibility_scaling_mode {
 extern visibility_scaling_mode visibility_scaling;
 
 extern bool lazy_border_enabled;
+extern bool predictive_prefetch_enabled;
+/** Keep loaded submap items serialized until first use; see submap::has_deferred_items(). */
+extern bool deferred_submap_items;
+/** Light only the z-levels the avatar can see; see map::lighting_observed_levels(). */
+extern bool zlevel_lighting_culling;
+/** Cast NPCs' fields of view in one batch per turn; see map::remember_fields_of_view(). */
+extern bool npc_field_of_view;
+/** Plan long routes over per-submap portal graphs first; see Pathfinding::get_route_hierarchical(). */
+extern bool hierarchical_pathfinding;
+/** Keep d_maps between turns and repair them; see Pathfinding::end_turn(). */
+extern bool persistent_d_maps;
+/** Monsters take one step at a time from shared d_maps; see Pathfinding::next_step(). */
+extern bool flow_field_pathfinding;
+/** Write map blobs in the submap_binary format instead of JSON. */
+extern bool binary_map_saves;
+/** Compress SQLite save blobs with the shipped save_dictionary dictionaries. */
+extern bool dictionary_save_compression;
 extern int retained_omt_cache_length;
+/** Resident submap memory, in MiB, above which retained columns are evicted; 0 for no cap. */
+extern int map_memory_budget_mb;
+/** Turns between coarse catch-up rounds of lazy-border submaps, 0 to leave them frozen. */
+extern int lazy_border_sim_interval;
 
 /**
  * Maximum number of fire-spread-loaded submaps allowed across all dimensions
@@ -155,8 +201,15 @@ extern int safe_mode_proximity;
 extern bool parallel_enabled;
 extern bool parallel_monster_planning;
 extern int  monster_plan_chunk_size;
+extern bool parallel_npc_planning;
 extern bool parallel_map_cache;
 extern bool parallel_scent_update;
+extern bool parallel_field_processing;
+extern bool parallel_item_processing;
+extern bool parallel_pathfinding;
+extern bool parallel_sound_flood_fill;
+extern bool parallel_explosion_shrapnel;
+extern bool parallel_autodrive_planning;
 
 /* Options related to fungal activity */
 struct FungalOptions {
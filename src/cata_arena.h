@@ -1,17 +1,98 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
 #include <mutex>
-#include <set>
+#include <new>
 #include <unordered_map>
+#include <vector>
 
+#include "lock_stats.h"
 #include "safe_reference.h"
 
+/**
+ * Typed slab allocator with deferred destruction.
+ *
+ * Objects are carved from fixed-size slabs and recycled through per-thread free
+ * lists, so churn never reaches the general-purpose heap.  T opts in by routing
+ * its class-specific operator new/delete to allocate()/deallocate().
+ *
+ * mark_for_destruction() invalidates safe_reference/cache_reference immediately
+ * but keeps the memory alive until cleanup(), which destroys every pending
+ * object and returns the blocks to the shared free list in one batch.
+ *
+ * Slabs are kept for the life of the process: block addresses stay valid for
+ * pointer-keyed lookups, and the next load reuses them.
+ */
 template <typename T>
 class cata_arena
 {
     private:
-        std::set<T *> pending_deletion;
-        std::mutex pending_deletion_mutex;
+        // Free blocks are linked through their own storage.
+        struct free_block {
+            free_block *next;
+        };
+
+        static constexpr size_t block_size = std::max( sizeof( T ), sizeof( free_block ) );
+        static constexpr size_t blocks_per_slab = 256;
+        // A thread's list above this size hands half back to the shared list.
+        static constexpr size_t local_limit = 2 * blocks_per_slab;
+        static_assert( alignof( T ) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__,
+                       "slabs come from plain operator new[]" );
+
+        struct block_list {
+            free_block *head = nullptr;
+            size_t count = 0;
+
+            void push( void *p ) {
+                free_block *b = static_cast<free_block *>( p );
+                b->next = head;
+                head = b;
+                ++count;
+            }
+
+            /// Unlink up to @p n blocks from the front.
+            block_list take( size_t n ) {
+                block_list out;
+                while( head != nullptr && out.count < n ) {
+                    free_block *b = head;
+                    head = b->next;
+                    --count;
+                    out.push( b );
+                }
+                return out;
+            }
+
+            void splice( block_list &&other ) {
+                while( other.head != nullptr ) {
+                    free_block *b = other.head;
+                    other.head = b->next;
+                    push( b );
+                }
+                other.count = 0;
+            }
+        };
+
+        struct local_cache {
+            block_list blocks;
+
+            ~local_cache() {
+                // Exiting worker threads return their blocks instead of leaking them.
+                get_instance().give_back( std::move( blocks ) );
+            }
+        };
+
+        std::vector<T *> pending_deletion;
+        using pending_deletion_mutex_type =
+            lock_stats::counted<std::mutex, "cata_arena::pending_deletion_mutex">;
+        TracyLockable( pending_deletion_mutex_type, pending_deletion_mutex );
+
+        block_list shared_free;
+        std::vector<std::unique_ptr<std::byte[]>> slabs;
+        std::mutex shared_free_mutex;
 
         static cata_arena<T> &get_instance() {
             // Heap-allocated and never deleted — intentional. This avoids the static
@@ -23,28 +104,99 @@ class cata_arena
             return *instance;
         }
 
+        static local_cache &get_local_cache() {
+            static thread_local local_cache cache;
+            return cache;
+        }
+
+        void give_back( block_list &&blocks ) {
+            auto lk = std::lock_guard( shared_free_mutex );
+            shared_free.splice( std::move( blocks ) );
+        }
+
+        /// Relinks a batch of at most blocks_per_slab blocks so they pop in address order.
+        static block_list in_address_order( block_list &&blocks ) {
+            auto sorted = std::array<free_block *, blocks_per_slab> {};
+            size_t n = 0;
+            for( free_block *b = blocks.head; b != nullptr; b = b->next ) {
+                sorted[n++] = b;
+            }
+            std::sort( sorted.begin(), sorted.begin() + n, std::greater<>() );
+            auto out = block_list{};
+            for( size_t i = 0; i < n; ++i ) {
+                out.push( sorted[i] );
+            }
+            return out;
+        }
+
+        void refill( local_cache &cache ) {
+            auto batch = block_list{};
+            {
+                auto lk = std::lock_guard( shared_free_mutex );
+                if( shared_free.head == nullptr ) {
+                    auto slab = std::make_unique<std::byte[]>( block_size * blocks_per_slab );
+                    for( size_t i = blocks_per_slab; i-- > 0; ) {
+                        shared_free.push( slab.get() + i * block_size );
+                    }
+                    slabs.push_back( std::move( slab ) );
+                }
+                batch = shared_free.take( blocks_per_slab );
+            }
+            // Recycled blocks come back in whatever order they were freed in.  Handing a
+            // batch out by address keeps items created together, like a submap's, close in
+            // memory.  Only called with an empty cache, so nothing is reordered by splicing.
+            cache.blocks = in_address_order( std::move( batch ) );
+        }
+
+        void *allocate_internal() {
+            local_cache &cache = get_local_cache();
+            if( cache.blocks.head == nullptr ) {
+                refill( cache );
+            }
+            free_block *b = cache.blocks.head;
+            cache.blocks.head = b->next;
+            --cache.blocks.count;
+            return b;
+        }
+
+        void deallocate_internal( void *p ) {
+            local_cache &cache = get_local_cache();
+            cache.blocks.push( p );
+            if( cache.blocks.count > local_limit ) {
+                give_back( cache.blocks.take( local_limit / 2 ) );
+            }
+        }
+
         void mark_for_destruction_internal( T *alloc ) {
             auto lk = std::lock_guard( pending_deletion_mutex );
             safe_reference<T>::mark_destroyed( alloc );
             cache_reference<T>::mark_destroyed( alloc );
-            pending_deletion.insert( alloc );
+            pending_deletion.push_back( alloc );
         }
 
         bool cleanup_internal() {
-            auto dcopy = std::set<T *> {};
+            auto dcopy = std::vector<T *> {};
             {
                 auto lk = std::lock_guard( pending_deletion_mutex );
                 if( pending_deletion.empty() ) {
                     return false;
                 }
                 dcopy.swap( pending_deletion );
+                // The old std::set tolerated an object being marked twice; keep that.
+                std::ranges::sort( dcopy );
+                const auto dupes = std::ranges::unique( dcopy );
+                dcopy.erase( dupes.begin(), dupes.end() );
                 for( T * const &p : dcopy ) {
                     safe_reference<T>::mark_deallocated( p );
                 }
             }
+            // Destructors may mark more objects; those land in the next round.
+            auto freed = block_list{};
             for( T * const &p : dcopy ) {
-                delete p;
+                p->~T();
+                freed.push( p );
             }
+            give_back( std::move( freed ) );
             return true;
         }
 
@@ -56,6 +208,26 @@ class cata_arena
 
         using value_type = T;
 
+        /** Storage for one T.  For T::operator new. */
+        static void *allocate( size_t size ) {
+            if( size != sizeof( T ) ) {
+                return ::operator new( size );
+            }
+            return get_instance().allocate_internal();
+        }
+
+        /** Returns storage from allocate().  For T::operator delete. */
+        static void deallocate( void *p, size_t size ) {
+            if( p == nullptr ) {
+                return;
+            }
+            if( size != sizeof( T ) ) {
+                ::operator delete( p );
+                return;
+            }
+            get_instance().deallocate_internal( p );
+        }
+
         static void mark_for_destruction( T *alloc ) {
             get_instance().mark_for_destruction_internal( alloc );
         }
@@ -64,6 +236,13 @@ class cata_arena
             return get_instance().cleanup_internal();
         }
 
+        /** Bytes of slab storage reserved so far, including free blocks. */
+        static size_t reserved_bytes() {
+            cata_arena<T> &arena = get_instance();
+            auto lk = std::lock_guard( arena.shared_free_mutex );
+            return arena.slabs.size() * blocks_per_slab * block_size;
+        }
+
         ~cata_arena() {
             while( cleanup_internal() ) {}
         }
@@ -1,6 +1,5 @@
 #include "cata_libintl.h"
 
-#include "fstream_utils.h"
 #include "string_utils.h"
 #include "string_formatter.h"
 
@@ -10,7 +9,7 @@
 #include <cassert>
 #include <iostream>
 #include <limits>
-#include <sstream>
+#include <string_view>
 
 // ===============================================================================================
 // Plural forms
@@ -364,21 +363,16 @@ constexpr u8 PLF_SEPARATOR = 0;
 
 trans_catalogue trans_catalogue::load_from_file( const std::string &file_path )
 {
-    std::stringstream buffer;
-    cata_ifstream file = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file_path ) );
-    if( !file.is_open() ) {
+    std::unique_ptr<mmap_file> file = mmap_file::open( file_path );
+    if( !file ) {
         throw std::runtime_error( "failed to open file" );
     }
-    buffer << file->rdbuf();
-    if( file.fail() ) {
-        throw std::runtime_error( "failed to read file" );
-    }
-    return load_from_memory( buffer.str() );
+    return trans_catalogue( std::move( file ), nullptr );
 }
 
 trans_catalogue trans_catalogue::load_from_memory( std::string mo_file )
 {
-    return trans_catalogue( std::move( mo_file ) );
+    return trans_catalogue( nullptr, std::make_unique<std::string>( std::move( mo_file ) ) );
 }
 
 u8 trans_catalogue::get_u8( u32 offs ) const
@@ -446,8 +440,10 @@ void trans_catalogue::process_file_header()
     constexpr u32 OFFS_NUM_STRINGS = 8;
     constexpr u32 OFFS_ORIG_TABLE_BEGIN = 12;
     constexpr u32 OFFS_TRANS_TABLE_BEGIN = 16;
+    constexpr u32 OFFS_HASH_TABLE_SIZE = 20;
+    constexpr u32 OFFS_HASH_TABLE_BEGIN = 24;
 
-    u32 magic = this->buffer.size() > 4 ? get_u32( OFFS_MAGIC_NUMBER ) : 0;
+    u32 magic = buf_size() > 4 ? get_u32( OFFS_MAGIC_NUMBER ) : 0;
     if( magic != MO_MAGIC_NUMBER_LE && magic != MO_MAGIC_NUMBER_BE ) {
         throw std::runtime_error( "not a MO file" );
     }
@@ -464,6 +460,8 @@ void trans_catalogue::process_file_header()
     number_of_strings = get_u32( OFFS_NUM_STRINGS );
     offs_orig_table = get_u32( OFFS_ORIG_TABLE_BEGIN );
     offs_trans_table = get_u32( OFFS_TRANS_TABLE_BEGIN );
+    hash_table_size = get_u32( OFFS_HASH_TABLE_SIZE );
+    offs_hash_table = get_u32( OFFS_HASH_TABLE_BEGIN );
 }
 
 void trans_catalogue::check_string_terminators()
@@ -535,6 +533,47 @@ void trans_catalogue::check_string_plurals()
     }
 }
 
+void trans_catalogue::check_hash_table()
+{
+    // The probe step is taken modulo (size - 2), so smaller tables are unusable.
+    // Files written without a hash table (size 0) are searched by sorted index instead.
+    if( hash_table_size <= 2 ) {
+        hash_table_size = 0;
+        return;
+    }
+    if( static_cast<uint64_t>( offs_hash_table ) + static_cast<uint64_t>( hash_table_size ) * 4 >
+        buf_size() ) {
+        std::string e = string_format(
+                            "hash table extends beyond EOF (size:%#x offs:%#x fsize:%#x)",
+                            hash_table_size, offs_hash_table, buf_size()
+                        );
+        throw std::runtime_error( e );
+    }
+    for( u32 i = 0; i < hash_table_size; i++ ) {
+        // Slots hold entry number + 1, with 0 marking an empty slot.
+        u32 offs = offs_hash_table + i * 4;
+        if( get_u32_unsafe( offs ) > number_of_strings ) {
+            std::string e = string_format(
+                                "hash table slot at offs %#x: entry %#x out of range",
+                                offs, get_u32_unsafe( offs )
+                            );
+            throw std::runtime_error( e );
+        }
+    }
+}
+
+void trans_catalogue::build_sorted_index()
+{
+    // 0th entry is the metadata, we skip it
+    sorted_entries.reserve( number_of_strings > 0 ? number_of_strings - 1 : 0 );
+    for( u32 i = 1; i < number_of_strings; i++ ) {
+        sorted_entries.push_back( i );
+    }
+    std::sort( sorted_entries.begin(), sorted_entries.end(), [this]( u32 a, u32 b ) {
+        return strcmp( get_nth_orig_string( a ), get_nth_orig_string( b ) ) < 0;
+    } );
+}
+
 void trans_catalogue::check_encoding( const meta_headers &headers )
 {
     // HACK: The checks here are rather crude and don't account for
@@ -660,11 +699,21 @@ trans_catalogue::catalogue_plurals_info trans_catalogue::parse_plf_header(
     return ret;
 }
 
-trans_catalogue::trans_catalogue( std::string buffer )
+trans_catalogue::trans_catalogue( std::unique_ptr<mmap_file> mapping,
+                                  std::unique_ptr<std::string> owned )
+    : mapping( std::move( mapping ) )
+    , owned_buffer( std::move( owned ) )
 {
-    set_buffer( std::move( buffer ) );
+    std::string_view data = this->mapping ? this->mapping->view() : *owned_buffer;
+    if( data.size() > std::numeric_limits<u32>::max() ) {
+        throw std::runtime_error( "file too large" );
+    }
+    buffer = data.data();
+    buffer_size = static_cast<u32>( data.size() );
+
     process_file_header();
     check_string_terminators();
+    check_hash_table();
 
     meta_headers headers = string_split( get_metadata(), '\n' );
 
@@ -672,6 +721,10 @@ trans_catalogue::trans_catalogue( std::string buffer )
     this->plurals = parse_plf_header( headers );
 
     check_string_plurals();
+
+    if( hash_table_size == 0 ) {
+        build_sorted_index();
+    }
 }
 
 bool trans_catalogue::check_nth_translation_has_plf( u32 n ) const
@@ -726,92 +779,108 @@ const char *trans_catalogue::get_nth_pl_translation( u32 n, size_t num ) const
     return nullptr;
 }
 
-// ===============================================================================================
-// Translation library
-// ===============================================================================================
-
-std::vector<trans_library::library_string_descr>::const_iterator trans_library::find_entry(
-    const char *id ) const
+u32 trans_catalogue::hash_string( const char *id )
 {
-    auto it = std::lower_bound( strings.begin(), strings.end(),
-    id, [this]( const library_string_descr & a_descr, const char *b ) -> bool {
-        const char *a = this->catalogues[a_descr.catalogue].get_nth_orig_string( a_descr.entry );
-        return strcmp( a, b ) < 0;
-    } );
-
-    if( it != strings.end() ) {
-        const char *found = catalogues[it->catalogue].get_nth_orig_string( it->entry );
-        if( strcmp( id, found ) == 0 ) {
-            return it;
+    // Same as hashpjw() in GNU gettext
+    u32 hval = 0;
+    for( const char *c = id; *c != '\0'; c++ ) {
+        hval = ( hval << 4 ) + static_cast<u8>( *c );
+        u32 g = hval & 0xf0000000;
+        if( g != 0 ) {
+            hval ^= g >> 24;
+            hval ^= g;
         }
     }
-
-    return strings.end();
+    return hval;
 }
 
-void trans_library::build_string_table()
+u32 trans_catalogue::find_entry( const char *id, u32 hash ) const
 {
-    assert( strings.empty() );
+    if( hash_table_size == 0 ) {
+        auto it = std::lower_bound( sorted_entries.begin(), sorted_entries.end(),
+        id, [this]( u32 entry, const char *b ) -> bool {
+            return strcmp( get_nth_orig_string( entry ), b ) < 0;
+        } );
+        if( it != sorted_entries.end() && strcmp( get_nth_orig_string( *it ), id ) == 0 ) {
+            return *it;
+        }
+        return 0;
+    }
 
-    for( size_t i_cat = 0; i_cat < catalogues.size(); i_cat++ ) {
-        const trans_catalogue &cat = catalogues[i_cat];
-        u32 num = cat.get_num_strings();
-        // 0th entry is the metadata, we skip it
-        strings.reserve( num - 1 );
-        for( u32 i = 1; i < num; i++ ) {
-            const char *i_cstr = cat.get_nth_orig_string( i );
+    // Open addressing with double hashing, as written by msgfmt
+    u32 idx = hash % hash_table_size;
+    u32 incr = 1 + hash % ( hash_table_size - 2 );
+    // A full table without the string would otherwise probe forever.
+    for( u32 probes = 0; probes < hash_table_size; probes++ ) {
+        u32 slot = get_u32_unsafe( offs_hash_table + idx * 4 );
+        if( slot == 0 ) {
+            return 0;
+        }
+        // The metadata entry is never a match: its msgid is empty.
+        u32 entry = slot - 1;
+        if( entry != 0 && strcmp( get_nth_orig_string( entry ), id ) == 0 ) {
+            return entry;
+        }
+        if( idx >= hash_table_size - incr ) {
+            idx -= hash_table_size - incr;
+        } else {
+            idx += incr;
+        }
+    }
+    return 0;
+}
 
-            auto it = std::lower_bound( strings.begin(), strings.end(),
-            i_cstr, [this]( const library_string_descr & a_descr, const char *b ) -> bool {
-                const char *a = this->catalogues[a_descr.catalogue].get_nth_orig_string( a_descr.entry );
-                return strcmp( a, b ) < 0;
-            } );
+// ===============================================================================================
+// Translation library
+// ===============================================================================================
 
-            library_string_descr desc = { static_cast<u32>( i_cat ), i };
-            if( it == strings.end() ) {
-                // Not found, or all elements are greater
-                strings.push_back( desc );
-            } else if( strcmp( catalogues[it->catalogue].get_nth_orig_string( it->entry ), i_cstr ) == 0 ) {
-                // Overwrite existing string only if new string has plural form(s),
-                // but existing one does not.
-                if(
-                    cat.check_nth_translation_has_plf( i ) &&
-                    !catalogues[it->catalogue].check_nth_translation_has_plf( it->entry )
-                ) {
-                    *it = desc;
-                }
-                continue;
-            } else {
-                strings.insert( it, desc );
+trans_library::library_string_descr trans_library::find_entry( const char *id ) const
+{
+    u32 hash = trans_catalogue::hash_string( id );
+    library_string_descr ret = { nullptr, 0 };
+    for( const trans_catalogue &cat : catalogues ) {
+        u32 entry = cat.find_entry( id, hash );
+        if( entry == 0 ) {
+            continue;
+        }
+        if( !ret.catalogue ) {
+            ret = { &cat, entry };
+            if( cat.check_nth_translation_has_plf( entry ) ) {
+                break;
             }
+        } else if( cat.check_nth_translation_has_plf( entry ) ) {
+            // Later catalogue overrides the string only if it has plural form(s),
+            // but the first one does not.
+            ret = { &cat, entry };
+            break;
         }
     }
+    return ret;
 }
 
 trans_library trans_library::create( std::vector<trans_catalogue> catalogues )
 {
     trans_library lib;
     lib.catalogues = std::move( catalogues );
-    lib.build_string_table();
     return lib;
 }
 
 const char *trans_library::lookup_string( const char *id ) const
 {
-    auto it = find_entry( id );
-    if( it == strings.end() ) {
+    library_string_descr found = find_entry( id );
+    if( !found.catalogue ) {
         return nullptr;
     }
-    return catalogues[it->catalogue].get_nth_translation( it->entry );
+    return found.catalogue->get_nth_translation( found.entry );
 }
 
 const char *trans_library::lookup_pl_string( const char *id, size_t n ) const
 {
-    auto it = find_entry( id );
-    if( it == strings.end() ) {
+    library_string_descr found = find_entry( id );
+    if( !found.catalogue ) {
         return nullptr;
     }
-    return catalogues[it->catalogue].get_nth_pl_translation( it->entry, n );
+    return found.catalogue->get_nth_pl_translation( found.entry, n );
 }
 
 const char *trans_library::get( const char *msgid ) const
@@ -5,6 +5,8 @@
 #include <vector>
 #include <cstdint>
 
+#include "mmap_file.h"
+
 /**
  * Runtime localization system for Cataclysm: Bright Nights.
  *
@@ -18,6 +20,10 @@
  * 4. Supports loading MO files from arbitrary paths
  * 5. Supports loading multiple MO files into a single "domain"
  *
+ * MO files are memory-mapped and looked up in place through the hash table
+ * msgfmt stores in them, so loading a catalogue costs little more than
+ * validating it.
+ *
  * For MO file structure, see GNU gettext manual:
  * https://www.gnu.org/software/gettext/manual/
  */
@@ -94,21 +100,25 @@ class trans_catalogue
         // =========== MEMBERS ===========
 
         bool is_little_endian = true; // File endianness
-        std::string buffer; // Data buffer
+        std::unique_ptr<mmap_file> mapping; // Backing storage of files loaded from disk
+        std::unique_ptr<std::string> owned_buffer; // Backing storage of files loaded from memory
+        const char *buffer = nullptr; // Data buffer, points into one of the above
+        u32 buffer_size = 0;
         catalogue_plurals_info plurals; // Plural rules
         u32 number_of_strings = 0; // Number of strings (id-translation pairs)
         u32 offs_orig_table = 0; // Offset of table with original strings
         u32 offs_trans_table = 0; // Offset of table with translated strings
+        u32 hash_table_size = 0; // Number of slots in the hash table, 0 if absent
+        u32 offs_hash_table = 0; // Offset of the hash table
+        // Entries sorted by original string, built only for files without a hash table
+        std::vector<u32> sorted_entries;
 
         // =========== METHODS ===========
 
-        explicit trans_catalogue( std::string buffer );
+        trans_catalogue( std::unique_ptr<mmap_file> mapping, std::unique_ptr<std::string> owned );
 
-        void set_buffer( std::string buffer ) {
-            this->buffer = std::move( buffer );
-        }
         u32 buf_size() const {
-            return static_cast<u32>( buffer.size() );
+            return buffer_size;
         }
 
         u8 get_u8( u32 offs ) const;
@@ -141,6 +151,8 @@ class trans_catalogue
         void process_file_header();
         void check_string_terminators();
         void check_string_plurals();
+        void check_hash_table();
+        void build_sorted_index();
         std::string get_metadata() const;
         static void check_encoding( const meta_headers &headers );
         static catalogue_plurals_info parse_plf_header( const meta_headers &headers );
@@ -169,6 +181,15 @@ class trans_catalogue
         const char *get_nth_orig_string( u32 n ) const;
         /** Check whether translated string contains plural forms. */
         bool check_nth_translation_has_plf( u32 n ) const;
+
+        /** Hash of a msgid (with msgctxt) as used by MO file hash tables. */
+        static u32 hash_string( const char *id );
+        /**
+         * Find entry with given original msgid (with msgctxt).
+         * @param hash hash_string() of @p id
+         * @returns Entry number, or 0 if not found (0th entry is the metadata).
+         */
+        u32 find_entry( const char *id, u32 hash ) const;
 };
 
 /**
@@ -180,18 +201,14 @@ class trans_library
     private:
         // Describes which catalogue the string comes from
         struct library_string_descr {
-            u32 catalogue;
+            const trans_catalogue *catalogue;
             u32 entry;
         };
 
-        // Full index of loaded strings
-        std::vector<library_string_descr> strings;
-
         // Full index of loaded catalogues
         std::vector<trans_catalogue> catalogues;
 
-        void build_string_table();
-        std::vector<library_string_descr>::const_iterator find_entry( const char *id ) const;
+        library_string_descr find_entry( const char *id ) const;
         const char *lookup_string( const char *id ) const;
         const char *lookup_pl_string( const char *id, size_t n ) const;
 
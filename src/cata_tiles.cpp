@@ -7,8 +7,11 @@
 #include <bitset>
 #include <cassert>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <limits>
 #include <optional>
@@ -38,6 +41,7 @@
 #include "field_type.h"
 #include "flag.h"
 #include "filesystem.h"
+#include "frame_timing.h"
 #include "fstream_utils.h"
 #include "game.h"
 #include "game_constants.h"
@@ -66,6 +70,7 @@
 #include "overlay_ordering.h"
 #include "overmap_location.h"
 #include "path_info.h"
+#include "pathfinding.h"
 #include "pixel_minimap.h"
 #include "player.h"
 #include "rect_range.h"
@@ -74,11 +79,13 @@
 #include "sdl_wrappers.h"
 #include "sdltiles.h"
 #include "sounds.h"
+#include "startup_timeline.h"
 #include "string_formatter.h"
 #include "string_id.h"
 #include "string_utils.h"
 #include "submap.h"
 #include "submap_load_manager.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "travel/travel_destination.h"
@@ -388,7 +395,9 @@ cata_tiles::~cata_tiles() = default;
 
 void cata_tiles::on_options_changed()
 {
+    invalidate_retained_frame();
     memory_map_mode = get_option <std::string>( "MEMORY_MAP_MODE" );
+    use_sprite_batch = get_option<bool>( "SPRITE_BATCHING" );
 
     pixel_minimap_settings settings;
 
@@ -488,9 +497,13 @@ void cata_tiles::load_tileset(
     // when the loading has succeeded.
     std::unique_ptr<tileset> new_tileset_ptr = std::make_unique<tileset>();
     tileset_loader loader( *new_tileset_ptr, renderer );
-    loader.load( tileset_id, precheck, /*pump_events=*/pump_events );
+    {
+        startup_timeline::span timing( "Tileset " + tileset_id, "tileset" );
+        loader.load( tileset_id, precheck, /*pump_events=*/pump_events );
+    }
     tileset_ptr = std::move( new_tileset_ptr );
     tileset_mod_list_stamp = mod_list;
+    clear_looks_like_cache();
 
     set_draw_scale( 16 );
 
@@ -682,9 +695,7 @@ static void apply_blend_filter(
     }
 }
 
-template<bool SkipTransparent = true, typename FilterFn>
-static SDL_Surface_Ptr apply_color_filter_blit_copy(
-    const SDL_Surface_Ptr &src, FilterFn filter_func )
+static SDL_Surface_Ptr blit_copy( const SDL_Surface_Ptr &src )
 {
     assert( src );
     SDL_Surface_Ptr dst = create_surface_32( src->w, src->h );
@@ -693,20 +704,54 @@ static SDL_Surface_Ptr apply_color_filter_blit_copy(
         !SDL_BlitSurface( src.get(), nullptr, dst.get(), nullptr ),
         "SDL_BlitSurface failed"
     );
+    return dst;
+}
+
+/**
+ * Copies @p rect of @p src into a new surface of the same size.  Unlike a blit
+ * this only reads @p src, so several threads may copy from one surface at once.
+ * @p src must pass can_copy_pixels().
+ */
+static SDL_Surface_Ptr copy_surface_pixels( const SDL_Surface &src, const SDL_Rect &rect )
+{
+    SDL_Surface_Ptr dst = create_surface_32( rect.w, rect.h );
+    assert( dst );
+    const auto *from = static_cast<const std::byte *>( src.pixels ) + rect.y * src.pitch +
+                       rect.x * sizeof( SDL_Color );
+    auto *to = static_cast<std::byte *>( dst->pixels );
+    for( int y = 0; y < rect.h; ++y, from += src.pitch, to += dst->pitch ) {
+        std::memcpy( to, from, rect.w * sizeof( SDL_Color ) );
+    }
+    return dst;
+}
 
-    auto pix = static_cast<SDL_Color *>( dst->pixels );
+/** Whether copy_surface_pixels() gives the same pixels as a blit of @p surf without blending. */
+static bool can_copy_pixels( SDL_Surface &surf )
+{
+    return surf.format == sdl_color_pixel_format && !SDL_MUSTLOCK( &surf ) &&
+           !SDL_SurfaceHasRLE( &surf ) && !SDL_SurfaceHasColorKey( &surf );
+}
 
-    for( int y = 0, ey = dst->h; y < ey; ++y ) {
-        for( int x = 0, ex = dst->w; x < ex; ++x, ++pix ) {
-            if constexpr( SkipTransparent ) {
-                if( pix->a == 0x00 ) {
-                    continue;
-                }
+/**
+ * Returns a copy of @p src with @p filter_func applied to every pixel that is
+ * not fully transparent.  The rows are filtered on the thread pool.  @p src
+ * must pass can_copy_pixels().
+ */
+template<typename FilterFn>
+static SDL_Surface_Ptr apply_color_filter_copy( const SDL_Surface &src, FilterFn filter_func )
+{
+    SDL_Surface_Ptr dst = copy_surface_pixels( src, SDL_Rect{ 0, 0, src.w, src.h } );
+    std::byte *const pixels = static_cast<std::byte *>( dst->pixels );
+    const int pitch = dst->pitch;
+    const int width = dst->w;
+    parallel_for_chunked( "tileset_color_filter", 0, dst->h, 16, [&]( const int y ) {
+        auto *pix = reinterpret_cast<SDL_Color *>( pixels + y * pitch );
+        for( int x = 0; x < width; ++x, ++pix ) {
+            if( pix->a != 0x00 ) {
+                *pix = filter_func( *pix );
             }
-            *pix = filter_func( *pix );
         }
-    }
-
+    } );
     return dst;
 }
 
@@ -1159,8 +1204,51 @@ bool tileset_loader::copy_surface_to_dynamic_atlas(
 
     SDL_SetSurfaceBlendMode( surf.get(), SDL_BLENDMODE_NONE );
 
-    auto state = sdl_save_render_state( renderer.get() );
+    if( ts.lazy_sprites ) {
+        // Keep the image in system memory; each sprite goes to the atlas the
+        // first time it is drawn.
+        SDL_Surface_Ptr sheet = create_surface_32( surf->w, surf->h );
+        SDL_FillSurfaceRect( sheet.get(), nullptr, SDL_MapRGBA( SDL_GetPixelFormatDetails( sheet->format ),
+                             nullptr, 255, 255, 255, 0 ) );
+        throwErrorIf( !SDL_BlitSurface( surf.get(), nullptr, sheet.get(), nullptr ),
+                      "SDL_BlitSurface failed" );
+        const int sheet_index = static_cast<int>( ts.lazy_sheets.size() );
+        ts.lazy_sheets.push_back( std::move( sheet ) );
+        for( const SDL_Rect src_rect : input_range ) {
+            const point pos( offset + point( src_rect.x, src_rect.y ) );
+            const int index =
+                this->offset + ( pos.x / sprite_width ) +
+                ( pos.y / sprite_height ) * ( tile_atlas_width / sprite_width );
+            ts.add_lazy_sprite( index, sheet_index, src_rect );
+        }
+        return true;
+    }
+
+    std::vector<SDL_Rect> src_rects;
     for( const SDL_Rect src_rect : input_range ) {
+        src_rects.push_back( src_rect );
+    }
+    // Cutting out and hashing the sprites only reads the sheet, so do it on the
+    // thread pool when the pixels can be copied directly.  Adding them to the
+    // atlas stays on this thread.
+    struct sprite_slice {
+        SDL_Surface_Ptr surf;
+        size_t hash = 0;
+    };
+    std::vector<sprite_slice> slices;
+    if( can_copy_pixels( *surf ) ) {
+        slices.resize( src_rects.size() );
+        parallel_for( "tileset_slice", 0, static_cast<int>( src_rects.size() ), [&]( const int i ) {
+            sprite_slice &slice = slices[i];
+            slice.surf = copy_surface_pixels( *surf, src_rects[i] );
+            SDL_SetSurfaceBlendMode( slice.surf.get(), SDL_BLENDMODE_NONE );
+            slice.hash = get_surface_hash( slice.surf.get(), nullptr );
+        } );
+    }
+
+    auto state = sdl_save_render_state( renderer.get() );
+    for( size_t i = 0; i < src_rects.size(); ++i ) {
+        const SDL_Rect &src_rect = src_rects[i];
         assert( offset.x % sprite_width == 0 );
         assert( offset.y % sprite_height == 0 );
 
@@ -1172,21 +1260,28 @@ bool tileset_loader::copy_surface_to_dynamic_atlas(
             this->offset + ( pos.x / sprite_width ) +
             ( pos.y / sprite_height ) * ( tile_atlas_width / sprite_width );
 
-        SDL_FillSurfaceRect( st_surf, nullptr, SDL_MapRGBA( SDL_GetPixelFormatDetails( st_surf->format ),
-                             nullptr, 255, 255, 255, 0 ) );
-        SDL_BlitSurface( surf.get(), &src_rect, st_surf, &st_sub_rect );
-
-        const auto surf_hash = get_surface_hash( st_surf, nullptr );
+        SDL_Surface *sprite_surf = st_surf;
+        SDL_Rect sprite_rect = st_sub_rect;
+        size_t surf_hash = 0;
+        if( !slices.empty() ) {
+            sprite_surf = slices[i].surf.get();
+            sprite_rect = SDL_Rect{ 0, 0, sprite_surf->w, sprite_surf->h };
+            surf_hash = slices[i].hash;
+        } else {
+            SDL_FillSurfaceRect( st_surf, nullptr, SDL_MapRGBA( SDL_GetPixelFormatDetails( st_surf->format ),
+                                 nullptr, 255, 255, 255, 0 ) );
+            SDL_BlitSurface( surf.get(), &src_rect, st_surf, &st_sub_rect );
+            surf_hash = get_surface_hash( st_surf, nullptr );
+        }
 
         auto atl_tex = ts.tileset_atlas->get_or_create_sprite( sprite_width, sprite_height,
         surf_hash, [&]( SDL_Surface * dstSurf, const SDL_Rect * dstRect ) {
-            const SDL_Rect srcRect{ ( st_sub_rect.x ), ( st_sub_rect.y ), ( st_sub_rect.w ), ( st_sub_rect.h ) };
-            SDL_BlitSurface( st_surf, &srcRect, dstSurf, dstRect );
+            SDL_BlitSurface( sprite_surf, &sprite_rect, dstSurf, dstRect );
         } );
 
         const auto tex_key = tileset_lookup_key{ index, TILESET_NO_MASK, tileset_fx_type::none, TILESET_NO_COLOR, TILESET_NO_WARP, point_zero };
-        auto &[at_tex, at_rect] = atl_tex;
-        auto [it, ok] = ts.tile_lookup.emplace( tex_key, tileset::tile_lookup_entry{ texture( std::move( at_tex ), at_rect ), point_zero } );
+        const auto &[at_tex, at_rect] = atl_tex;
+        auto [it, ok] = ts.add_tile_lookup( tex_key, at_tex, at_rect, point_zero );
         if( !ok ) {
             dbg( DL::Error ) << "dynamic atlas hash collision, you will likely see minor graphical issues" <<
                              std::endl;
@@ -1441,29 +1536,32 @@ texture_result tileset::get_or_default( const int sprite_index,
 
 #if defined(DYNAMIC_ATLAS)
 
-    const auto base_tex_key = tileset_lookup_key{ sprite_index, TILESET_NO_MASK, tileset_fx_type::none, TILESET_NO_COLOR, TILESET_NO_WARP, point_zero };
-    const auto mask_tex_key = tileset_lookup_key{ mask_index, TILESET_NO_MASK, tileset_fx_type::none, TILESET_NO_COLOR, TILESET_NO_WARP, point_zero };
     const auto mod_tex_key = tileset_lookup_key{ sprite_index, mask_index, type, tint, warp_hash, sprite_offset };
 
     if( g->display_overlay_state( ACTION_DISPLAY_TILES_NO_VFX ) ) {
-        const auto base_tex_it = tile_lookup.find( base_tex_key );
-        if( base_tex_it == tile_lookup.end() ) {
+        const tile_lookup_entry *base_entry = find_base_sprite( sprite_index );
+        if( !base_entry ) {
             return { nullptr, point_zero };
         }
-        return { &base_tex_it->second.tex, base_tex_it->second.warp_offset };
+        return { &base_entry->tex, base_entry->warp_offset };
     }
 
     const auto mod_tex_it = tile_lookup.find( mod_tex_key );
     if( mod_tex_it != tile_lookup.end() ) {
+        if( mod_tex_it->second.sheet >= 0 ) {
+            tileset_atlas->mark_used( mod_tex_it->second.sheet );
+        }
         return { &mod_tex_it->second.tex, mod_tex_it->second.warp_offset };
     }
 
-    const auto base_tex_it = tile_lookup.find( base_tex_key );
-    if( base_tex_it == tile_lookup.end() ) {
+    // Both count as drawn this frame, so making the new sprite below cannot
+    // evict the sheets they are on.
+    const tile_lookup_entry *base_entry = find_base_sprite( sprite_index );
+    if( !base_entry ) {
         return { nullptr, point_zero };
     }
 
-    const auto mask_tex_it = tile_lookup.find( mask_tex_key );
+    const tile_lookup_entry *mask_entry = find_base_sprite( mask_index );
 
     const color_pixel_function_pointer vfx_func = get_pixel_function( type );
     if( !vfx_func ) {
@@ -1476,8 +1574,8 @@ texture_result tileset::get_or_default( const int sprite_index,
         const auto &r = get_sdl_renderer();
         const auto rp = r.get();
 
-        const texture &base_tex = base_tex_it->second.tex;
-        const texture *mask_tex = ( mask_tex_it != tile_lookup.end() ) ? &mask_tex_it->second.tex : nullptr;
+        const texture &base_tex = base_entry->tex;
+        const texture *mask_tex = mask_entry ? &mask_entry->tex : nullptr;
 
         const auto [spr_w, spr_h] = base_tex.dimension();
 
@@ -1694,9 +1792,8 @@ texture_result tileset::get_or_default( const int sprite_index,
         } );
 
         sdl_restore_render_state( rp, state );
-        auto &[at_tex, at_rect] = atl_tex;
-        auto [entry, ok] = tile_lookup.emplace( mod_tex_key,
-                                                tile_lookup_entry{ texture( std::move( at_tex ), at_rect ), warp_output_offset } );
+        const auto &[at_tex, at_rect] = atl_tex;
+        auto [entry, ok] = add_tile_lookup( mod_tex_key, at_tex, at_rect, warp_output_offset );
         if( !ok ) {
             dbg( DL::Error ) << "dynamic atlas hash collision, you will likely see minor graphical issues" <<
                              std::endl;
@@ -1729,9 +1826,55 @@ texture_result tileset::get_or_default( const int sprite_index,
 #endif
 }
 
+auto tileset::texture_memory_usage() const -> std::size_t
+{
+    // Textures are counted as 32 bit RGBA, whatever the renderer actually uses
+    constexpr auto bytes_per_pixel = std::size_t{ 4 };
+    auto bytes = std::size_t{ 0 };
+#if defined(DYNAMIC_ATLAS)
+    const auto surface_bytes = []( const SDL_Surface * surf ) -> std::size_t {
+        return surf == nullptr ? 0 : static_cast<std::size_t>( surf->pitch ) * surf->h;
+    };
+    if( tileset_atlas ) {
+        for( const dynamic_atlas::sprite_sheet &sheet : *tileset_atlas ) {
+            bytes += static_cast<std::size_t>( sheet.atlas_width ) * sheet.atlas_height * bytes_per_pixel;
+            bytes += surface_bytes( sheet.surface.get() );
+        }
+    }
+    for( const SDL_Surface_Ptr &sheet : lazy_sheets ) {
+        bytes += surface_bytes( sheet.get() );
+    }
+    for( const auto &[hash, warp] : warp_cache ) {
+        bytes += surface_bytes( warp.surface.get() );
+    }
+#else
+    for( const std::vector<texture> *values : {
+             &tile_values, &shadow_tile_values, &night_tile_values, &overexposed_tile_values,
+             &underwater_tile_values, &underwater_dark_tile_values, &memory_tile_values,
+             &z_overlay_values
+         } ) {
+        for( const texture &tex : *values ) {
+            const auto [w, h] = tex.dimension();
+            bytes += static_cast<std::size_t>( w ) * h * bytes_per_pixel;
+        }
+    }
+#endif
+    return bytes;
+}
+
 #if defined(DYNAMIC_ATLAS)
 std::tuple<bool, SDL_Surface *, SDL_Rect> tileset::get_sprite_surface( int sprite_index ) const
 {
+    if( lazy_sprites ) {
+        // The pixels are still in system memory, no need to read the atlas back.
+        if( sprite_index < 0 || std::cmp_greater_equal( sprite_index, lazy_sprite_sources.size() ) ||
+            lazy_sprite_sources[sprite_index].sheet < 0 ) {
+            return std::make_tuple( false, nullptr, SDL_Rect{} );
+        }
+        const lazy_sprite &src = lazy_sprite_sources[sprite_index];
+        return std::make_tuple( true, lazy_sheets[src.sheet].get(), src.rect );
+    }
+
     const auto base_tex_key = tileset_lookup_key{
         sprite_index, TILESET_NO_MASK, tileset_fx_type::none, TILESET_NO_COLOR, TILESET_NO_WARP, point_zero
     };
@@ -1749,11 +1892,66 @@ std::tuple<bool, SDL_Surface *, SDL_Rect> tileset::get_sprite_surface( int sprit
 
 void tileset::ensure_readback_loaded() const
 {
-    if( tileset_atlas ) {
+    // get_sprite_surface() does not use the readback with lazy sprites.
+    if( tileset_atlas && !lazy_sprites ) {
         tileset_atlas->readback_load();
     }
 }
 
+void tileset::begin_frame() const
+{
+    if( tileset_atlas ) {
+        tileset_atlas->next_frame();
+    }
+}
+
+void tileset::add_lazy_sprite( const int sprite_index, const int sheet, const SDL_Rect &rect )
+{
+    if( std::cmp_greater_equal( sprite_index, lazy_sprite_sources.size() ) ) {
+        lazy_sprite_sources.resize( sprite_index + 1 );
+    }
+    lazy_sprite_sources[sprite_index] = lazy_sprite{ sheet, rect };
+}
+
+auto tileset::add_tile_lookup( const tileset_lookup_key &key, const SDL_Texture_SharedPtr &tex,
+                               const SDL_Rect &rect, const point warp_offset ) const
+-> std::pair<std::unordered_map<tileset_lookup_key, tile_lookup_entry>::iterator, bool>
+{
+    return tile_lookup.emplace( key, tile_lookup_entry{ texture( tex, rect ), warp_offset, tileset_atlas->sheet_index( tex ) } );
+}
+
+auto tileset::find_base_sprite( const int sprite_index ) const -> const tile_lookup_entry *
+{
+    const auto key = tileset_lookup_key{ sprite_index, TILESET_NO_MASK, tileset_fx_type::none, TILESET_NO_COLOR, TILESET_NO_WARP, point_zero };
+    auto it = tile_lookup.find( key );
+    if( it == tile_lookup.end() ) {
+        if( sprite_index < 0 || std::cmp_greater_equal( sprite_index, lazy_sprite_sources.size() ) ||
+            lazy_sprite_sources[sprite_index].sheet < 0 ) {
+            return nullptr;
+        }
+        const lazy_sprite &src = lazy_sprite_sources[sprite_index];
+        SDL_Surface_Ptr sprite_surf = copy_surface_pixels( *lazy_sheets[src.sheet], src.rect );
+        SDL_SetSurfaceBlendMode( sprite_surf.get(), SDL_BLENDMODE_NONE );
+        const size_t surf_hash = get_surface_hash( sprite_surf.get(), nullptr );
+        const auto [at_tex, at_rect] = tileset_atlas->get_or_create_sprite( src.rect.w, src.rect.h,
+        surf_hash, [&]( SDL_Surface * dstSurf, const SDL_Rect * dstRect ) {
+            SDL_BlitSurface( sprite_surf.get(), nullptr, dstSurf, dstRect );
+        } );
+        it = add_tile_lookup( key, at_tex, at_rect, point_zero ).first;
+    }
+    if( it->second.sheet >= 0 ) {
+        tileset_atlas->mark_used( it->second.sheet );
+    }
+    return &it->second;
+}
+
+void tileset::evict_atlas_sheet( const int sheet ) const
+{
+    std::erase_if( tile_lookup, [&]( const auto & it ) {
+        return it.second.sheet == sheet;
+    } );
+}
+
 size_t tileset::register_warp_surface( SDL_Surface_Ptr surface, const point offset,
                                        const bool offset_mode ) const
 {
@@ -1810,6 +2008,10 @@ bool tileset_loader::create_textures_from_tile_atlas( const SDL_Surface_Ptr &til
             { std::make_tuple( &ts.memory_tile_values, tilecontext->memory_map_mode ) }
         }
     };
+    // Filtering is plain pixel work that runs on the thread pool; only making
+    // the textures has to stay on this thread.  The one blit resolves the color
+    // key and RLE encoding of the sheet for every filter.
+    SDL_Surface_Ptr blitted;
     for( tiles_pixel_color_entry &entry : tile_values_data ) {
         std::vector<texture> *tile_values = std::get<0>( entry );
         color_pixel_function_pointer color_pixel_function = get_color_pixel_function( std::get<1>
@@ -1819,7 +2021,10 @@ bool tileset_loader::create_textures_from_tile_atlas( const SDL_Surface_Ptr &til
             // TODO: Move it inside apply_color_filter.
             success = copy_surface_to_texture( tile_atlas, offset, *tile_values );
         } else {
-            success = copy_surface_to_texture( apply_color_filter_blit_copy( tile_atlas, color_pixel_function ),
+            if( !blitted ) {
+                blitted = blit_copy( tile_atlas );
+            }
+            success = copy_surface_to_texture( apply_color_filter_copy( *blitted, color_pixel_function ),
                                                offset,
                                                *tile_values );
         }
@@ -1837,9 +2042,42 @@ static void extend_vector_by( std::vector<T> &vec, const size_t additional_size
     vec.resize( vec.size() + additional_size );
 }
 
+void tileset_loader::prefetch_images( std::vector<std::string> paths )
+{
+    prefetch_paths = std::move( paths );
+    next_prefetch = 0;
+    prefetched_images.clear();
+    cata_thread_pool &pool = get_thread_pool();
+    const size_t window = pool.num_workers() + 1;
+    for( ; next_prefetch < prefetch_paths.size() && prefetched_images.size() < window; ++next_prefetch ) {
+        const std::string &path = prefetch_paths[next_prefetch];
+        prefetched_images.emplace_back( path, pool.submit_returning( "tileset_decode", [path]() {
+            return load_image( path.c_str() );
+        } ) );
+    }
+}
+
+SDL_Surface_Ptr tileset_loader::take_image( const std::string &path )
+{
+    if( prefetched_images.empty() || prefetched_images.front().first != path ) {
+        return load_image( path.c_str() );
+    }
+    std::future<SDL_Surface_Ptr> decoding = std::move( prefetched_images.front().second );
+    prefetched_images.pop_front();
+    if( next_prefetch < prefetch_paths.size() ) {
+        const std::string &next = prefetch_paths[next_prefetch++];
+        prefetched_images.emplace_back( next, get_thread_pool().submit_returning( "tileset_decode",
+        [next]() {
+            return load_image( next.c_str() );
+        } ) );
+    }
+    get_thread_pool().wait_helping( decoding );
+    return decoding.get();
+}
+
 void tileset_loader::load_tileset( const std::string &img_path, const bool pump_events )
 {
-    const SDL_Surface_Ptr tile_atlas = load_image( img_path.c_str() );
+    const SDL_Surface_Ptr tile_atlas = take_image( img_path );
     assert( tile_atlas );
     tile_atlas_width = tile_atlas->w;
 
@@ -1974,6 +2212,7 @@ void cata_tiles::set_draw_scale( float scale )
 
     tile_ratiox = ( static_cast<float>( tile_width ) / static_cast<float>( fontwidth ) );
     tile_ratioy = ( static_cast<float>( tile_height ) / static_cast<float>( fontheight ) );
+    invalidate_retained_frame();
 }
 
 std::optional<tile_search_result> cata_tiles::tile_type_search( const tile_search_params &tile )
@@ -2235,6 +2474,14 @@ void tileset_loader::load( const std::string &tileset_id, const bool precheck,
     }
 #if defined(DYNAMIC_ATLAS)
     ts.tileset_atlas = std::make_unique<dynamic_atlas>( 4096, 4096, ts.tile_width, ts.tile_height );
+    ts.lazy_sprites = get_option<bool>( "LAZY_TILESET_SPRITES" );
+    if( ts.lazy_sprites ) {
+        const tileset *const owner = &ts;
+        ts.tileset_atlas->set_sheet_limit( get_option<int>( "TILESET_ATLAS_PAGES" ),
+        [owner]( const int sheet ) {
+            owner->evict_atlas_sheet( sheet );
+        } );
+    }
     ts.tileset_atlas->start_batch();
 #endif
     // Load tile information if available.
@@ -2324,6 +2571,15 @@ void tileset_loader::load_internal( const JsonObject &config, const std::string
                                     const std::string &img_path, const bool pump_events )
 {
     if( config.has_array( "tiles-new" ) ) {
+        std::vector<std::string> image_paths;
+        for( const JsonObject &tile_part_def : config.get_array( "tiles-new" ) ) {
+            tile_part_def.allow_omitted_members();
+            const std::string path = tileset_root + '/' + tile_part_def.get_string( "file" );
+            if( file_exist( path ) ) {
+                image_paths.push_back( path );
+            }
+        }
+        prefetch_images( std::move( image_paths ) );
         // new system, several entries
         // When loading multiple tileset images this defines where
         // the tiles from the most recently loaded image start from.
@@ -3042,6 +3298,38 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
 #endif
 
     ZoneScoped;
+    const frame_timing::scoped_phase phase( frame_timing::group::map_draw, "cata_tiles::draw" );
+    const retained_frame_key frame_key{
+        .dest = dest,
+        .width = width,
+        .height = height,
+        .tile_width = tile_width,
+        .tile_height = tile_height,
+        .iso = tile_iso,
+        .center = center,
+        .player_pos = g->u.abs_pos(),
+        .player_moves = g->u.get_moves(),
+        .turn = calendar::turn,
+    };
+    const bool volatile_frame = frame_is_volatile();
+    if( !volatile_frame && last_frame.valid && last_frame.key == frame_key ) {
+        ZoneScopedN( "cata_tiles_reuse_frame" );
+        // Streaming still has to make progress while the view stands still.
+        if( submap_loader.has_deferred_lazy_border_work() ) {
+            submap_loader.process_deferred_lazy_border_work();
+        }
+        const SDL_FRect dst{ static_cast<float>( dest.x ), static_cast<float>( dest.y ),
+                             static_cast<float>( width ), static_cast<float>( height ) };
+        RenderCopy( renderer, last_frame.texture, nullptr, &dst );
+        overlay_strings.insert( last_frame.overlay_strings.begin(), last_frame.overlay_strings.end() );
+        color_blocks = last_frame.color_blocks;
+        TracyPlot( "Cata Tiles Frame Reused", static_cast<int64_t>( 1 ) );
+        return;
+    }
+    TracyPlot( "Cata Tiles Frame Reused", static_cast<int64_t>( 0 ) );
+#if defined(DYNAMIC_ATLAS)
+    tileset_ptr->begin_frame();
+#endif
     {
         //set clipping to prevent drawing over stuff we shouldn't
         SDL_Rect clipRect = {dest.x, dest.y, width, height};
@@ -3051,6 +3339,9 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
         //fill render area with black to prevent artifacts where no new pixels are drawn
         geometry->rect( renderer, point{ clipRect.x, clipRect.y }, clipRect.w, clipRect.h, SDL_Color{ 0, 0, 0, 255 } );
     }
+    if( use_sprite_batch ) {
+        batch.begin( renderer );
+    }
 
     point s;
     get_window_tile_counts( width, height, s.x, s.y );
@@ -3288,6 +3579,22 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
             }
         }
     }
+    if( g->display_overlay_state( ACTION_DISPLAY_LIGHTING ) && g->displaying_lighting_condition == 1 ) {
+        // Boxes around merged vehicle lights, with the count cast as one on the light that is cast.
+        for( const auto &cluster : here.access_cache( center.z() ).vehicle_light_clusters ) {
+            const auto color = cluster.members > 1 ? SDL_Color{ 255, 160, 0, 100 } :
+                               SDL_Color{ 0, 200, 0, 60 };
+            color_blocks.first = SDL_BLENDMODE_BLEND;
+            for( const auto x : std::views::iota( cluster.min.x(), cluster.max.x() + 1 ) ) {
+                for( const auto y : std::views::iota( cluster.min.y(), cluster.max.y() + 1 ) ) {
+                    color_blocks.second.emplace( player_to_screen( point_bub_ms( x, y ) ), color );
+                }
+            }
+            overlay_strings.emplace( player_to_screen( cluster.light.p.xy() ) + quarter_tile,
+                                     formatted_text( std::to_string( cluster.members ), catacurses::black,
+                                             direction::NORTH ) );
+        }
+    }
 
     std::vector<tile_render_info> &draw_points = *draw_points_cache;
     int min_z = OVERMAP_HEIGHT;
@@ -3441,6 +3748,14 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
                     draw_debug_tile( intensity, string_format( "%.2f", tr ) );
                 }
 
+                if( g->display_overlay_state( ACTION_DISPLAY_PATHFINDING_HEAT ) ) {
+                    const int heat = Pathfinding::explored_heat_at( bub_to_abs( tripoint_bub_ms( temp_x, temp_y,
+                                     center.z() ) ) );
+                    if( heat > 0 ) {
+                        draw_debug_tile( std::min( heat * 2, 10 ), std::to_string( heat ) );
+                    }
+                }
+
                 if( g->display_overlay_state( ACTION_DISPLAY_OUTSIDE ) ) {
                     // Use the flat level_cache directly: it includes Phase3 vehicle overrides
                     // (outside=false / sheltered=true for covered vehicle tiles) that the
@@ -3702,6 +4017,7 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
         if( p.pos.z() != center.z() ) {
             return;
         }
+        batch.flush();
         const auto screen_tl = player_to_screen( p.pos.xy() );
         const auto tile_rect = SDL_Rect{ screen_tl.x, screen_tl.y, tile_width, tile_height };
         const auto in_selected_zone = has_selected_zone && p.pos.z() == selected_z &&
@@ -4155,6 +4471,7 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
                                   ( g->is_zones_manager_open() && g->is_zone_submap_grid_overlay_enabled() );
 
     if( draw_submap_grid && !iso_mode ) {
+        batch.flush();
         point_abs_sm sm_start = project_to<coords::sm>( bub_to_abs( point_bub_ms( min_col,
                                 min_row ) + o.raw() ) );
         point_abs_sm sm_end = project_to<coords::sm>( bub_to_abs( point_bub_ms( max_col,
@@ -4246,8 +4563,86 @@ void cata_tiles::draw( point dest, const tripoint_bub_ms &center, int width, int
         }
     }
 
+    batch.end();
     printErrorIf( !SDL_SetRenderClipRect( renderer.get(), nullptr ),
                   "SDL_SetRenderClipRect failed" );
+
+    if( volatile_frame ) {
+        last_frame.valid = false;
+    } else {
+        retain_frame( frame_key, overlay_strings, color_blocks );
+    }
+}
+
+bool cata_tiles::frame_is_volatile() const
+{
+    const bool animating = do_draw_explosion || do_draw_custom_explosion ||
+                           do_draw_bullet || do_draw_hit || do_draw_line ||
+                           do_draw_cursor || do_draw_highlight || do_draw_weather ||
+                           do_draw_sct || do_draw_zones || do_draw_cone_aoe;
+    const bool overridden = !radiation_override.empty() || !terrain_override.empty() ||
+                            !furniture_override.empty() || !graffiti_override.empty() ||
+                            !trap_override.empty() || !field_override.empty() ||
+                            !item_override.empty() || !vpart_override.empty() ||
+                            !draw_below_override.empty() || !monster_override.empty();
+    // Debug overlays read state that the game does not redraw the main UI for.
+    const bool overlaid = g->displaying_overlays || g->show_zone_overlay ||
+                          g->debug_submap_grid_overlay || g->is_zones_manager_open();
+    return animating || overridden || overlaid || terrain_requires_animation();
+}
+
+void cata_tiles::retain_frame( const retained_frame_key &key,
+                               const std::multimap<point, formatted_text> &overlay_strings,
+                               const color_block_overlay_container &color_blocks )
+{
+    ZoneScoped;
+    last_frame.valid = false;
+
+    // The view can only be copied back out of an unscaled offscreen target.
+    SDL_Texture *const target = SDL_GetRenderTarget( renderer.get() );
+    int logical_w = 0;
+    int logical_h = 0;
+    SDL_RendererLogicalPresentation present = SDL_LOGICAL_PRESENTATION_DISABLED;
+    SDL_GetRenderLogicalPresentation( renderer.get(), &logical_w, &logical_h, &present );
+    if( target == nullptr || present != SDL_LOGICAL_PRESENTATION_DISABLED ) {
+        return;
+    }
+
+    if( !last_frame.texture || last_frame.texture->w != key.width ||
+        last_frame.texture->h != key.height || last_frame.texture->format != target->format ) {
+        last_frame.texture = CreateTexture( renderer, target->format, SDL_TEXTUREACCESS_TARGET,
+                                            key.width, key.height );
+        if( !last_frame.texture ) {
+            return;
+        }
+        SetTextureBlendMode( last_frame.texture, SDL_BLENDMODE_NONE );
+    }
+
+    const auto state = sdl_save_render_state( renderer.get() );
+    SDL_BlendMode target_blend = SDL_BLENDMODE_NONE;
+    SDL_GetTextureBlendMode( target, &target_blend );
+    SDL_SetTextureBlendMode( target, SDL_BLENDMODE_NONE );
+    SetRenderTarget( renderer, last_frame.texture );
+    SDL_SetRenderClipRect( renderer.get(), nullptr );
+    const SDL_FRect src{ static_cast<float>( key.dest.x ), static_cast<float>( key.dest.y ),
+                         static_cast<float>( key.width ), static_cast<float>( key.height ) };
+    const bool copied = SDL_RenderTexture( renderer.get(), target, &src, nullptr );
+    printErrorIf( !copied, "SDL_RenderTexture failed" );
+    SDL_SetTextureBlendMode( target, target_blend );
+    sdl_restore_render_state( renderer.get(), state );
+    if( !copied ) {
+        return;
+    }
+
+    last_frame.key = key;
+    last_frame.overlay_strings = overlay_strings;
+    last_frame.color_blocks = color_blocks;
+    last_frame.valid = true;
+}
+
+void cata_tiles::invalidate_retained_frame()
+{
+    last_frame.valid = false;
 }
 
 bool cata_tiles::terrain_requires_animation() const
@@ -4305,11 +4700,36 @@ cata_tiles::find_tile_looks_like_by_string_id( const std::string &id, TILE_CATEG
         return std::nullopt;
     }
     const T &obj = s_id.obj();
-    return find_tile_looks_like( obj.looks_like, category, looks_like_jumps_limit - 1 );
+    return resolve_tile_looks_like( obj.looks_like, category, looks_like_jumps_limit - 1 );
 }
 
-auto cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
-                                       const int looks_like_jumps_limit ) const -> std::optional<tile_lookup_res>
+auto cata_tiles::find_tile_looks_like( const std::string &id,
+                                       const TILE_CATEGORY category ) const -> std::optional<tile_lookup_res>
+{
+    const season_type season = season_of_year( calendar::turn );
+    if( season != looks_like_season ) {
+        clear_looks_like_cache();
+        looks_like_season = season;
+    }
+    auto &cache = looks_like_cache[category];
+    if( const auto it = cache.find( id ); it != cache.end() ) {
+        return it->second;
+    }
+    constexpr int looks_like_jumps_limit = 10;
+    auto res = resolve_tile_looks_like( id, category, looks_like_jumps_limit );
+    cache.emplace( id, res );
+    return res;
+}
+
+auto cata_tiles::clear_looks_like_cache() const -> void
+{
+    for( auto &cache : looks_like_cache ) {
+        cache.clear();
+    }
+}
+
+auto cata_tiles::resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+        const int looks_like_jumps_limit ) const -> std::optional<tile_lookup_res>
 {
     if( id.empty() || looks_like_jumps_limit <= 0 ) {
         return std::nullopt;
@@ -4348,7 +4768,7 @@ auto cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY cate
             int jump_limit = looks_like_jumps_limit;
             for( const std::string &looks_like : type_tmp.obj().looks_like ) {
 
-                ret = find_tile_looks_like( looks_like, category, jump_limit - 1 );
+                ret = resolve_tile_looks_like( looks_like, category, jump_limit - 1 );
                 if( ret.has_value() ) {
                     return ret;
                 }
@@ -4367,23 +4787,23 @@ auto cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY cate
             auto base_id = id.substr( 3 );
             const vpart_id base_vpid( base_id );
             if( !base_vpid.is_valid() ) {  // Fixed Fallback
-                return find_tile_looks_like( base_id, C_FURNITURE, looks_like_jumps_limit - 1 )
-                       .or_else( [ &, this] { return find_tile_looks_like( base_id, C_TERRAIN, looks_like_jumps_limit - 1 ); } );
+                return resolve_tile_looks_like( base_id, C_FURNITURE, looks_like_jumps_limit - 1 )
+                       .or_else( [ &, this] { return resolve_tile_looks_like( base_id, C_TERRAIN, looks_like_jumps_limit - 1 ); } );
             }
-            return find_tile_looks_like( "vp_" + base_vpid.obj().looks_like, category,
+            return resolve_tile_looks_like( "vp_" + base_vpid.obj().looks_like, category,
                                          looks_like_jumps_limit - 1 );
         }
         case C_ITEM: {
             itype_id iid = itype_id( id );
             if( !iid.is_valid() ) {
                 if( id.starts_with( "corpse_" ) ) {
-                    return find_tile_looks_like(
+                    return resolve_tile_looks_like(
                                itype_corpse.str(), category, looks_like_jumps_limit - 1
                            );
                 }
                 return std::nullopt;
             }
-            return find_tile_looks_like( iid->looks_like.str(), category, looks_like_jumps_limit - 1 );
+            return resolve_tile_looks_like( iid->looks_like.str(), category, looks_like_jumps_limit - 1 );
         }
 
         case C_BULLET: {
@@ -4394,7 +4814,7 @@ auto cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY cate
                 return std::nullopt;
             }
             if( !iid->looks_like.is_empty() ) {
-                return find_tile_looks_like( "animation_bullet_" + iid->looks_like.str(), category,
+                return resolve_tile_looks_like( "animation_bullet_" + iid->looks_like.str(), category,
                                              looks_like_jumps_limit - 1 );
             }
             return std::nullopt;
@@ -4876,6 +5296,11 @@ bool cata_tiles::draw_sprite_at( const tile_type &tile, point_bub_ms p,
         uint8_t old_b = 255;
         uint8_t old_alpha = 255;
         SDL_BlendMode old_blend_mode = SDL_BLENDMODE_BLEND;
+        if( batch.active() ) {
+            const SDL_Color color{ light_tint.color.r, light_tint.color.g, light_tint.color.b, light_tint.alpha };
+            sprite_tex->queue( batch, destination, rotation, flip, color, SDL_BLENDMODE_ADD );
+            return true;
+        }
         sprite_tex->get_color_mod( &old_r, &old_g, &old_b );
         sprite_tex->get_alpha_mod( &old_alpha );
         sprite_tex->get_blend_mode( &old_blend_mode );
@@ -4895,8 +5320,16 @@ bool cata_tiles::draw_sprite_at( const tile_type &tile, point_bub_ms p,
         int ret = 0;
 
         // UV warping is now handled in get_or_default, so we just render normally
-        sprite_tex->set_alpha_mod( 255 );
-        ret = sprite_tex->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
+        if( batch.active() ) {
+            SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+            sprite_tex->get_blend_mode( &blend_mode );
+            sprite_tex->queue( batch, destination, rotation, flip, SDL_Color{ 255, 255, 255, 255 },
+                               blend_mode );
+            ret = 1;
+        } else {
+            sprite_tex->set_alpha_mod( 255 );
+            ret = sprite_tex->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
+        }
         if( should_apply_light_tint && !render_dynamic_light_tint( rotation, flip ) ) {
             ret = 0;
         }
@@ -4906,7 +5339,12 @@ bool cata_tiles::draw_sprite_at( const tile_type &tile, point_bub_ms p,
                 tileset_ptr->get_or_default(
                     tile_idx, TILESET_NO_MASK, tileset_fx_type::z_overlay, TILESET_NO_COLOR,
                     effective_warp_hash, tile_offset );
-            if( overlay_tex ) {
+            if( overlay_tex && batch.active() ) {
+                SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+                overlay_tex->get_blend_mode( &blend_mode );
+                const SDL_Color color{ 255, 255, 255, static_cast<Uint8>( std::min( 192, overlay_count ) ) };
+                overlay_tex->queue( batch, destination, rotation, flip, color, blend_mode );
+            } else if( overlay_tex ) {
                 overlay_tex->set_alpha_mod( std::min( 192, overlay_count ) );
                 overlay_tex->render_copy_ex( renderer, &destination, rotation, nullptr, flip );
                 overlay_tex->set_alpha_mod( 255 );
@@ -5032,6 +5470,7 @@ bool cata_tiles::draw_color_at( const SDL_Color &color, point_bub_ms pos, SDL_Bl
         float( tile_height )
     };
 
+    batch.flush();
     SDL_BlendMode old_blend_mode;
     GetRenderDrawBlendMode( renderer, old_blend_mode );
     SetRenderDrawBlendMode( renderer, blend_mode );
@@ -5202,6 +5641,7 @@ bool cata_tiles::draw_block( const tripoint_bub_ms &p, SDL_Color color, int scal
         rect.y += tile_height / 8;
     }
 
+    batch.flush();
     geometry->rect( renderer, point{ rect.x, rect.y }, rect.w, rect.h, color );
     return true;
 }
@@ -6499,6 +6939,18 @@ void tileset_loader::ensure_default_item_highlight()
 
     int index = offset;
 
+    ts.tile_ids[ITEM_HIGHLIGHT].sprite.fg.add( std::vector<int>( {index} ), 1 );
+    if( ts.lazy_sprites ) {
+        SDL_Surface_Ptr surface = create_surface_32( ts.tile_width, ts.tile_height );
+        SDL_FillSurfaceRect( surface.get(), nullptr,
+                             SDL_MapRGBA( SDL_GetPixelFormatDetails( surface->format ), nullptr, 0, 0, 127,
+                                          highlight_alpha ) );
+        ts.lazy_sheets.push_back( std::move( surface ) );
+        ts.add_lazy_sprite( index, static_cast<int>( ts.lazy_sheets.size() ) - 1,
+                            SDL_Rect{ 0, 0, ts.tile_width, ts.tile_height } );
+        return;
+    }
+
     auto [tex, rect] = ts.tileset_atlas->create_sprite(
                            ts.tile_width, ts.tile_height, std::nullopt, [&]( SDL_Surface * dstSurf,
     const SDL_Rect * dstRect ) {
@@ -6508,15 +6960,14 @@ void tileset_loader::ensure_default_item_highlight()
         SDL_FillSurfaceRect( dstSurf, dstRect, col );
     } );
 
-    ts.tile_ids[ITEM_HIGHLIGHT].sprite.fg.add( std::vector<int>( {index} ), 1 );
-    ts.tile_lookup.emplace( tileset_lookup_key{
+    ts.add_tile_lookup( tileset_lookup_key{
         index,
         TILESET_NO_MASK,
         tileset_fx_type::none,
         TILESET_NO_COLOR,
         TILESET_NO_WARP,
         point_zero
-    }, tileset::tile_lookup_entry{ texture( tex, rect ), point_zero } );
+    }, tex, rect, point_zero );
 #else
     const Uint8 highlight_alpha = 127;
 
@@ -7089,6 +7540,7 @@ void cata_tiles::draw_zones_frame( std::multimap<point, formatted_text> &overlay
     const point screen_tl = player_to_screen( min_local );
     const point screen_br = player_to_screen( max_local ) + point( tile_width, tile_height );
 
+    batch.flush();
     draw_zone_overlay( {
         .renderer = renderer,
         .rect = { screen_tl.x, screen_tl.y, screen_br.x - screen_tl.x, screen_br.y - screen_tl.y },
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -27,6 +30,7 @@
 #include "sdl_geometry.h"
 #include "sdl_utils.h"
 #include "sdl_wrappers.h"
+#include "sprite_batch.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -186,6 +190,17 @@ class texture
             return SDL_RenderTexture( renderer.get(), sdl_texture_ptr.get(), &srcrect, &fdst );
         }
 
+        /// Queues this texture in @p batch the way @ref render_copy_ex would draw it, modulated by
+        /// @p color instead of the texture's own colour and alpha mod.
+        void queue( sprite_batch &batch, const SDL_Rect &dstrect, const double angle,
+                    const SDL_FlipMode flip, const SDL_Color &color, const SDL_BlendMode blend ) const {
+            const SDL_FRect fdst{ float( dstrect.x ), float( dstrect.y ),
+                                  float( dstrect.w ), float( dstrect.h ) };
+            const SDL_FColor fcolor{ color.r / 255.0f, color.g / 255.0f, color.b / 255.0f,
+                                     color.a / 255.0f };
+            batch.add( sdl_texture_ptr.get(), blend, srcrect, fdst, angle, flip, fcolor );
+        }
+
         bool get_blend_mode( SDL_BlendMode *mode ) const {
             return SDL_GetTextureBlendMode( sdl_texture_ptr.get(), mode );
         }
@@ -384,10 +399,37 @@ class tileset
         struct tile_lookup_entry {
             texture tex;
             point warp_offset;  // Offset induced by UV warp extending beyond sprite bounds
+            int sheet = -1;  // Atlas sheet holding the texture
         };
         mutable std::unordered_map<tileset_lookup_key, tile_lookup_entry> tile_lookup;
+
+        // Where a sprite's pixels are kept until it is first drawn (LAZY_TILESET_SPRITES).
+        struct lazy_sprite {
+            int sheet = -1;  // Index into lazy_sheets, -1 if the sprite is not lazy
+            SDL_Rect rect = { 0, 0, 0, 0 };
+        };
+        bool lazy_sprites = false;
+        // Tileset images in system memory, with the color key already applied
+        std::vector<SDL_Surface_Ptr> lazy_sheets;
+        // Indexed by sprite index
+        std::vector<lazy_sprite> lazy_sprite_sources;
+
+        void add_lazy_sprite( int sprite_index, int sheet, const SDL_Rect &rect );
+        /** Adds @p tex to tile_lookup, remembering which atlas sheet holds it. */
+        auto add_tile_lookup( const tileset_lookup_key &key, const SDL_Texture_SharedPtr &tex,
+                              const SDL_Rect &rect, point warp_offset ) const
+        -> std::pair<std::unordered_map<tileset_lookup_key, tile_lookup_entry>::iterator, bool>;
+        /**
+         * Returns the unmodified sprite, uploading it to the atlas first if it
+         * is lazy and not there yet.  Counts as a use of its atlas sheet.
+         */
+        auto find_base_sprite( int sprite_index ) const -> const tile_lookup_entry *;
+        /** Forgets every texture on atlas sheet @p sheet, which is being reused. */
+        void evict_atlas_sheet( int sheet ) const;
     public:
         dynamic_atlas *texture_atlas() const { return tileset_atlas.get(); }
+        /** Starts a new frame for the least-recently-used order of atlas sheets. */
+        void begin_frame() const;
     private:
 #else
         std::vector<texture> tile_values;
@@ -428,6 +470,9 @@ class tileset
         friend class tileset_loader;
 
     public:
+        /** Approximate bytes of sprite sheets in texture and system memory. */
+        auto texture_memory_usage() const -> std::size_t;
+
         int get_tile_width() const {
             return tile_width;
         }
@@ -541,8 +586,22 @@ class tileset_loader
 
         int tile_atlas_width = 0;
 
+        /** Tileset images still to be decoded, in the order load_tileset() will ask for them. */
+        std::vector<std::string> prefetch_paths;
+        std::size_t next_prefetch = 0;
+        /** Images being decoded on the thread pool, oldest first. */
+        std::deque<std::pair<std::string, std::future<SDL_Surface_Ptr>>> prefetched_images;
+
         void ensure_default_item_highlight();
 
+        /**
+         * Starts decoding @p paths on the thread pool, a few images ahead of
+         * load_tileset() so large tilesets are not all held in memory at once.
+         */
+        void prefetch_images( std::vector<std::string> paths );
+        /** Returns the decoded image at @p path, decoding it now if it was not prefetched. */
+        SDL_Surface_Ptr take_image( const std::string &path );
+
         /** Returns false if failed to create texture. */
         bool copy_surface_to_texture( const SDL_Surface_Ptr &surf, point offset,
                                       std::vector<texture> &target ) const;
@@ -718,6 +777,9 @@ class cata_tiles
 
         bool terrain_requires_animation() const;
 
+        /** Forget the retained map view, so that the next @ref draw renders it in full. */
+        void invalidate_retained_frame();
+
         /** Simply displays character on a screen with given X,Y position **/
         void display_character( const Character &ch, const point_bub_ms &p );
 
@@ -807,6 +869,16 @@ class cata_tiles
         void draw_om_tile_recursively( const tripoint_abs_omt omp, const std::string &id, int rotation,
                                        int subtile, int base_z_offset );
 
+        /**
+         * Draws the terrain of the @p tiles overmap tiles starting at @p corner_NW by compositing
+         * cached @ref om_chunk textures, redrawing only chunks whose terrain or knowledge changed.
+         */
+        void draw_om_terrain_chunks( const tripoint_abs_omt &corner_NW, point tiles,
+                                     bool has_debug_vision, const std::string &default_oter,
+                                     const std::string &display_oter );
+        /** Terrain, seen and explored state of the chunk at @p chunk, plus the terrain bordering it. */
+        auto om_chunk_signature( const tripoint &chunk, bool has_debug_vision ) const -> std::vector<int>;
+
         /**
          * @brief Try to draw either foreground or background using the given reference.
          *
@@ -960,8 +1032,21 @@ class cata_tiles
         bool draw_item_highlight( const tripoint_bub_ms &pos );
 
     public:
-        auto find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
-                                   int looks_like_jumps_limit = 10 ) const -> std::optional<tile_lookup_res>;
+        /**
+         * Tile drawn for @p id, following `looks_like` chains if the tileset has none of its own.
+         * Results are remembered until the season or the tileset changes.
+         */
+        auto find_tile_looks_like( const std::string &id,
+                                   TILE_CATEGORY category ) const -> std::optional<tile_lookup_res>;
+    protected:
+        auto resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                      int looks_like_jumps_limit ) const -> std::optional<tile_lookup_res>;
+        /** Resolved @ref find_tile_looks_like lookups, per category, for @ref looks_like_season. */
+        mutable std::array<std::unordered_map<std::string, std::optional<tile_lookup_res>>, C_OVERMAP_NOTE + 1>
+        looks_like_cache;
+        mutable season_type looks_like_season = season_type::NUM_SEASONS;
+        auto clear_looks_like_cache() const -> void;
+    public:
 
         // Animation layers
         void init_explosion( const tripoint_bub_ms &p, int radius, const std::string &name );
@@ -1203,6 +1288,69 @@ class cata_tiles
         std::map<tripoint_bub_ms, std::tuple<mtype_id, int, bool, Attitude>> monster_override;
         pimpl<std::vector<tile_render_info>> draw_points_cache;
 
+        /** Side, in overmap tiles, of the square chunks the overmap terrain is cached in. */
+        static constexpr int om_chunk_size = 16;
+        /** Overmap terrain of one chunk, as drawn by @ref draw_om_terrain_chunks. */
+        struct om_chunk {
+            SDL_Texture_Ptr texture;
+            std::vector<int> signature;
+            uint64_t last_used = 0;
+        };
+        /** What the look of every chunk depends on besides its own signature. */
+        struct om_chunk_context {
+            int tile_width = 0;
+            int tile_height = 0;
+            season_type season = season_type::NUM_SEASONS;
+            bool forest_trails = false;
+            std::string default_oter;
+            std::string display_oter;
+
+            bool operator==( const om_chunk_context & ) const = default;
+        };
+        /** Keyed by chunk position, that is the overmap tile position divided by @ref om_chunk_size. */
+        std::unordered_map<tripoint, om_chunk> om_chunks;
+        om_chunk_context om_chunks_context;
+        uint64_t om_chunk_frame = 0;
+
+        /** Everything a full @ref draw of the map view depends on that can change between frames. */
+        struct retained_frame_key {
+            point dest;
+            int width = 0;
+            int height = 0;
+            int tile_width = 0;
+            int tile_height = 0;
+            bool iso = false;
+            tripoint_bub_ms center;
+            tripoint_abs_ms player_pos;
+            int player_moves = 0;
+            time_point turn;
+
+            bool operator==( const retained_frame_key & ) const = default;
+        };
+        /**
+         * Copy of the last map view drawn in full, along with the overlays it produced.
+         * Reused while the game has not redrawn the main UI since, e.g. when only a window
+         * on top of the map is redrawn.
+         */
+        struct retained_frame {
+            SDL_Texture_Ptr texture;
+            retained_frame_key key;
+            std::multimap<point, formatted_text> overlay_strings;
+            color_block_overlay_container color_blocks;
+            bool valid = false;
+        };
+        retained_frame last_frame;
+
+        /** Collects the sprites of @ref draw so they are submitted in as few calls as possible. */
+        sprite_batch batch;
+        bool use_sprite_batch = true;
+
+        /** Whether the map view shows something that changes without the game redrawing the main UI. */
+        bool frame_is_volatile() const;
+        void retain_frame( const retained_frame_key &key,
+                           const std::multimap<point, formatted_text> &overlay_strings,
+                           const color_block_overlay_container &color_blocks );
+
     private:
         /**
          * Tracks active night vision goggle status for each draw call.
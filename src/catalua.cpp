@@ -3,13 +3,18 @@
 #include "debug.h"
 
 #include <algorithm>
+#include <chrono>
 #include <clocale>
 #include <functional>
+#include <iterator>
+#include <limits>
+#include <map>
 #include <optional>
 #include <ranges>
 #include <sstream>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 constexpr int LUA_API_VERSION = 2;
@@ -19,6 +24,7 @@ constexpr int LUA_API_VERSION = 2;
 
 #include "avatar.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "catalua_console.h"
 #include "catalua_coord.h"
 #include "catalua_hooks.h"
@@ -43,6 +49,9 @@ constexpr int LUA_API_VERSION = 2;
 #include "path_info.h"
 #include "point.h"
 #include "player_activity.h"
+#include "frame_timing.h"
+#include "profile.h"
+#include "turn_recorder.h"
 #include "worldfactory.h"
 
 namespace cata
@@ -175,13 +184,26 @@ auto get_active_lua_state() -> lua_state * // *NOPAD*
 auto get_lua_callback( lua_state &state, const char *table_name,
                        const std::string &callback_id ) -> sol::protected_function
 {
+    auto cached_table = state.callback_cache.find( std::string_view( table_name ) );
+    if( cached_table != state.callback_cache.end() ) {
+        const auto cached = cached_table->second.find( callback_id );
+        if( cached != cached_table->second.end() ) {
+            return cached->second;
+        }
+    }
+
     const auto maybe_table = state.lua.globals()["game"][table_name].get<sol::optional<sol::table>>();
     if( !maybe_table ) {
         debugmsg( "Lua callback table '%s' is not available", table_name );
         return sol::lua_nil;
     }
 
-    return maybe_table->get_or<sol::protected_function>( callback_id, sol::lua_nil );
+    auto callback = maybe_table->get_or<sol::protected_function>( callback_id, sol::lua_nil );
+    // Misses aren't cached, so callbacks registered later are still found.
+    if( callback != sol::lua_nil ) {
+        state.callback_cache[table_name].emplace( callback_id, callback );
+    }
+    return callback;
 }
 
 auto run_lua_callback( const char *table_name, const std::string &callback_id,
@@ -312,6 +334,7 @@ void init_global_state_tables( lua_state &state, const std::vector<mod_id> &modl
 
     // Main game data table
     sol::table gt = lua.globals()["game"];
+    state.callback_cache.clear();
 
     // Internal table that bypasses read-only facades
     sol::table it = lua.create_table();
@@ -321,6 +344,7 @@ void init_global_state_tables( lua_state &state, const std::vector<mod_id> &modl
     it["mod_storage"] = mod_storage;
     it["hook_test_results"] = lua.create_table();
     it["on_every_x_hooks"] = std::vector<cata::on_every_x_hooks>();
+    it["tasks"] = cata::lua_task_list();
     gt["hooks"] = hooks;
 
     // Runtime infrastructure
@@ -484,9 +508,10 @@ struct hook_cache_entry {
     std::vector<hook_entry> entries;
 };
 
-auto get_hook_cache() -> std::unordered_map<std::string, hook_cache_entry> &
+// Transparent, so hooks run on hot paths don't build a std::string per call just to find their entry.
+auto get_hook_cache() -> std::map<std::string, hook_cache_entry, std::less<>> &
 {
-    static auto cache = std::unordered_map<std::string, hook_cache_entry> {};
+    static auto cache = std::map<std::string, hook_cache_entry, std::less<>> {};
     return cache;
 }
 
@@ -562,11 +587,32 @@ auto build_hook_entries( sol::state_view lua, std::string_view hook_name,
     return entries;
 }
 
+bool hook_profiling = false;
+std::map<std::pair<std::string, std::string>, hook_profile_entry> hook_timings;
+
+auto record_hook_time( const std::string_view hook_name, const std::string &mod_id,
+                       const std::chrono::steady_clock::time_point start ) -> void
+{
+    const auto ms = std::chrono::duration<double, std::milli>( std::chrono::steady_clock::now() -
+                    start ).count();
+    auto &entry = hook_timings[ { std::string{ hook_name }, mod_id }];
+    if( entry.calls == 0 ) {
+        entry.hook_name = hook_name;
+        entry.mod_id = mod_id;
+    }
+    ++entry.calls;
+    entry.total_ms += ms;
+}
+
 auto get_hook_entries( sol::state_view lua, std::string_view hook_name,
                        const sol::table &hooks ) -> const std::vector<hook_entry> &
 {
     auto &cache = get_hook_cache();
-    auto &entry = cache[std::string{ hook_name }];
+    auto it = cache.find( hook_name );
+    if( it == cache.end() ) {
+        it = cache.emplace( std::string{ hook_name }, hook_cache_entry{} ).first;
+    }
+    auto &entry = it->second;
 
     const int len = table_rawlen( lua, hooks );
     if( entry.rawlen != len ) {
@@ -579,6 +625,26 @@ auto get_hook_entries( sol::state_view lua, std::string_view hook_name,
 
 } // namespace
 
+void set_hook_profiling( const bool enable )
+{
+    hook_profiling = enable;
+    hook_timings.clear();
+}
+
+auto hook_profiling_enabled() -> bool
+{
+    return hook_profiling;
+}
+
+auto hook_profile() -> std::vector<hook_profile_entry>
+{
+    auto result = std::vector<hook_profile_entry> {};
+    result.reserve( hook_timings.size() );
+    std::ranges::copy( hook_timings | std::views::values, std::back_inserter( result ) );
+    std::ranges::sort( result, std::ranges::greater{}, &hook_profile_entry::total_ms );
+    return result;
+}
+
 auto has_hooks( std::string_view hook_name, const hook_opts &opts ) -> bool
 {
     auto &state = opts.state ? *opts.state : *DynamicDataLoader::get_instance().lua;
@@ -601,17 +667,10 @@ auto run_hooks( std::string_view hook_name,
     auto &state = opts.state ? *opts.state : *DynamicDataLoader::get_instance().lua;
     auto &lua = state.lua;
 
-    auto params = lua.create_table();
     auto results = lua.create_table();
     results["allowed"] = true;
 
-    params["results"] = results;
-    params["prev"] = sol::lua_nil;
-
-    if( init ) {
-        init( params );
-    }
-
+    // Most call sites have no hooks registered, so don't build their params for nothing.
     const auto maybe_hooks = lua.globals()["game"]["hooks"][hook_name].get<sol::optional<sol::table>>();
     if( !maybe_hooks ) {
         return results;
@@ -619,11 +678,25 @@ auto run_hooks( std::string_view hook_name,
 
     const auto &hooks = *maybe_hooks;
     const auto &entries = get_hook_entries( lua, hook_name, hooks );
+    if( entries.empty() ) {
+        return results;
+    }
+
+    auto params = lua.create_table();
+    params["results"] = results;
+    params["prev"] = sol::lua_nil;
+
+    if( init ) {
+        init( params );
+    }
 
     auto out_idx = 1;
     auto i = size_t{ 0 };
     while( i < entries.size() ) {
         const hook_entry &e = entries[i];
+        ZoneScopedN( "lua_hook" );
+        ZoneText( hook_name.data(), hook_name.size() );
+        ZoneText( e.mod_id.c_str(), e.mod_id.size() );
         try {
             const sol::object obj = hooks.get_or<sol::object>( e.index, sol::lua_nil );
             if( obj == sol::lua_nil ) {
@@ -640,7 +713,13 @@ auto run_hooks( std::string_view hook_name,
                 func = obj.as<sol::protected_function>();
             }
 
+            const auto start = hook_profiling ? std::chrono::steady_clock::now() :
+                               std::chrono::steady_clock::time_point{};
             sol::protected_function_result res = func( params );
+            turn_recorder::count( turn_recorder::counter::lua_hooks_run );
+            if( hook_profiling ) {
+                record_hook_time( hook_name, e.mod_id, start );
+            }
             check_func_result( res );
 
             sol::object result = sol::make_object( lua, sol::lua_nil );
@@ -960,8 +1039,18 @@ void resolve_lua_bionic_and_mutation_callbacks()
     mutation_branch::resolve_lua_callbacks( mutation_callback_actors );
 }
 
+int on_every_x_hooks_generation = 0;
+
 void run_on_every_x_hooks( lua_state &state )
 {
+    // Hooks fire when the turn crosses a multiple of their interval, so nothing can be due
+    // before the nearest one and those turns skip the hook table.  Loading an earlier save
+    // moves the turn backwards, which replans as well.
+    if( state.on_every_x_planned_generation == on_every_x_hooks_generation &&
+        calendar::turn >= state.on_every_x_planned_at && calendar::turn < state.on_every_x_next_due ) {
+        return;
+    }
+
     std::vector<cata::on_every_x_hooks> &master_table =
         state.lua["game"]["cata_internal"]["on_every_x_hooks"];
     for( auto &entry : master_table ) {
@@ -972,6 +1061,7 @@ void run_on_every_x_hooks( lua_state &state )
             [&entry]( auto & func ) {
                 try {
                     sol::protected_function_result res = func();
+                    turn_recorder::count( turn_recorder::counter::lua_hooks_run );
                     check_func_result( res );
                     // erase function only if it returns a boolean AND it's false
                     return res.get_type() == sol::type::boolean && !res.get<bool>();
@@ -988,6 +1078,99 @@ void run_on_every_x_hooks( lua_state &state )
             );
         }
     }
+
+    const int now = to_turn<int>( calendar::turn );
+    int next_due = std::numeric_limits<int>::max();
+    for( const auto &entry : master_table ) {
+        const int interval = to_turns<int>( entry.interval );
+        if( interval > 0 && !entry.functions.empty() ) {
+            next_due = std::min( next_due, ( now / interval + 1 ) * interval );
+        }
+    }
+    state.on_every_x_next_due = calendar::turn_zero + time_duration::from_turns( next_due );
+    state.on_every_x_planned_at = calendar::turn;
+    state.on_every_x_planned_generation = on_every_x_hooks_generation;
+}
+
+void run_lua_tasks( lua_state &state )
+{
+    lua_task_list &list = state.lua["game"]["cata_internal"]["tasks"];
+    if( list.tasks.empty() ) {
+        return;
+    }
+
+    using clock = std::chrono::steady_clock;
+    const auto deadline = clock::now() + std::chrono::microseconds( lua_task_budget_us );
+    const auto run_handler = [&]( const sol::protected_function & func, const int id,
+    const char *what, auto &&... args ) {
+        if( func == sol::lua_nil ) {
+            return;
+        }
+        sol::protected_function_result res = func( std::forward<decltype( args )>( args )... );
+        if( !res.valid() ) {
+            const sol::error err = res;
+            debugmsg( "Failed to run %s of Lua task %d: %s", what, id, err.what() );
+        }
+    };
+    const auto first_value = []( const sol::protected_function_result & res ) {
+        return res.return_count() > 0 ? res.get<sol::object>() : sol::object();
+    };
+
+    // Tasks take turns, one step each, until the budget is spent.  Whoever is next when it
+    // runs out goes first on the next turn, so a task with long steps can't starve the rest.
+    size_t next = 0;
+    while( !list.tasks.empty() ) {
+        if( next >= list.tasks.size() ) {
+            next = 0;
+        }
+        if( list.tasks[next].cancelled ) {
+            const lua_task task = list.tasks[next];
+            list.tasks.erase( list.tasks.begin() + next );
+            run_handler( task.on_cancel, task.id, "on_cancel" );
+            continue;
+        }
+
+        // Steps may start more tasks, so keep copies rather than a reference into the list.
+        const lua_task task = list.tasks[next];
+        sol::coroutine routine = task.routine;
+        sol::protected_function_result res = routine();
+        if( res.status() == sol::call_status::yielded ) {
+            run_handler( task.on_progress, task.id, "on_progress", first_value( res ) );
+            ++next;
+        } else {
+            list.tasks.erase( list.tasks.begin() + next );
+            if( res.valid() ) {
+                run_handler( task.on_done, task.id, "on_done", first_value( res ) );
+            } else {
+                const sol::error err = res;
+                debugmsg( "Lua task %d failed: %s", task.id, err.what() );
+            }
+        }
+
+        if( clock::now() >= deadline ) {
+            break;
+        }
+    }
+    if( next < list.tasks.size() ) {
+        std::rotate( list.tasks.begin(), list.tasks.begin() + next, list.tasks.end() );
+    }
+}
+
+auto step_lua_gc_while_idle() -> bool
+{
+    const auto &state = DynamicDataLoader::get_instance().lua;
+    if( lua_idle_gc_step_kb <= 0 || !state ) {
+        return false;
+    }
+    ZoneScopedPhaseN( turn, "lua_idle_gc_step" );
+    // Returns 1 once the step finished a collection cycle.
+    return lua_gc( state->lua.lua_state(), LUA_GCSTEP, lua_idle_gc_step_kb ) == 0;
+}
+
+auto lua_memory_usage() -> std::size_t
+{
+    const auto &state = DynamicDataLoader::get_instance().lua;
+    return state ? state->lua.memory_used() : 0;
 }
 
 auto run_lua_examine( const std::string &callback_id, player &who,
@@ -1116,6 +1299,7 @@ void run_on_mapgen_postprocess_hooks_batch( lua_state &state, mapgen_constructor
                 }
 
                 sol::protected_function_result res = func( params );
+                turn_recorder::count( turn_recorder::counter::lua_hooks_run );
                 check_func_result( res );
 
                 if( res.valid() ) {
@@ -46,6 +46,19 @@ void run_mod_main_script( lua_state &state, const mod_id &mod );
 void run_on_game_load_hooks( lua_state &state );
 void run_on_game_save_hooks( lua_state &state );
 void run_on_every_x_hooks( lua_state &state );
+/**
+ * Resume the tasks started with gapi.add_task() in turn, until the LUA_TASK_BUDGET
+ * option's time is used up.  At least one task step runs per call.
+ */
+void run_lua_tasks( lua_state &state );
+/**
+ * Run one step of Lua garbage collection, sized by the LUA_IDLE_GC_STEP option.
+ * For idle points such as waiting for input.
+ * @return whether the current collection cycle still has work left.
+ */
+auto step_lua_gc_while_idle() -> bool;
+/** Bytes the Lua state has allocated, 0 before it exists. */
+auto lua_memory_usage() -> std::size_t;
 auto run_lua_examine( const std::string &callback_id, player &who,
                       const tripoint_bub_ms &pos ) -> void;
 auto get_lua_activity_on_finish( const player_activity &act ) -> std::string;
@@ -2,6 +2,7 @@
 #include "catalua_coord.h"
 #include "catalua_bindings_utils.h"
 #include "catalua_bindings_game_internal.h"
+#include "catalua_hooks.h"
 #include "catalua_impl.h"
 #include "catalua_luna.h"
 #include "catalua_luna_doc.h"
@@ -141,9 +142,29 @@ void cata::detail::reg_game_api( sol::state &lua )
         } );
         return out;
     } );
+    DOC( "Start or stop timing Lua hooks by mod. Either way, clears the recorded times." );
+    luna::set_fx( lib, "set_hook_profiling", &cata::set_hook_profiling );
+    DOC( "Get recorded hook times, slowest first. Returns array of { hook=string, mod_id=string, calls=int, total_ms=number }." );
+    luna::set_fx( lib, "get_hook_profile", []( sol::this_state lua_this ) {
+        sol::state_view lua( lua_this );
+        auto out = lua.create_table();
+        const auto entries = cata::hook_profile();
+        auto indices = std::views::iota( size_t{ 0 }, entries.size() );
+        std::ranges::for_each( indices, [&]( const size_t idx ) {
+            const auto &entry = entries[idx];
+            out[idx + 1] = lua.create_table_with(
+                               "hook", entry.hook_name,
+                               "mod_id", entry.mod_id,
+                               "calls", entry.calls,
+                               "total_ms", entry.total_ms
+                           );
+        } );
+        return out;
+    } );
     luna::set_fx( lib, "add_on_every_x_hook",
     []( sol::this_state lua_this, time_duration interval, sol::protected_function f ) {
         sol::state_view lua( lua_this );
+        ++on_every_x_hooks_generation;
         std::vector<on_every_x_hooks> &hooks = lua["game"]["cata_internal"]["on_every_x_hooks"];
         for( auto &entry : hooks ) {
             if( entry.interval == interval ) {
@@ -156,6 +177,49 @@ void cata::detail::reg_game_api( sol::state &lua )
         hooks.push_back( on_every_x_hooks{ interval, vec } );
     } );
 
+    DOC( "Start a long-running task.  The function runs as a coroutine, a step at a time each turn "
+         "within the LUA_TASK_BUDGET option, and should call coroutine.yield( progress ) often.  "
+         "Optional opts table may have on_progress( progress ), on_done( result ) and on_cancel() "
+         "functions.  Returns the task id." );
+    luna::set_fx( lib, "add_task",
+    []( sol::this_state lua_this, sol::protected_function f, sol::optional<sol::table> opts ) -> int {
+        sol::state_view lua( lua_this );
+        lua_task_list &list = lua["game"]["cata_internal"]["tasks"];
+        auto task = lua_task{};
+        task.id = list.next_id++;
+        task.thread = sol::thread::create( lua );
+        task.routine = sol::coroutine( task.thread.state(), f );
+        if( opts )
+        {
+            task.on_progress = opts->get_or<sol::protected_function>( "on_progress", sol::lua_nil );
+            task.on_done = opts->get_or<sol::protected_function>( "on_done", sol::lua_nil );
+            task.on_cancel = opts->get_or<sol::protected_function>( "on_cancel", sol::lua_nil );
+        }
+        list.tasks.push_back( std::move( task ) );
+        return list.tasks.back().id;
+    } );
+    DOC( "Cancel a task started with add_task.  Its on_cancel runs before the next step would have.  "
+         "Returns false if no such task is running." );
+    luna::set_fx( lib, "cancel_task", []( sol::this_state lua_this, int id ) -> bool {
+        sol::state_view lua( lua_this );
+        lua_task_list &list = lua["game"]["cata_internal"]["tasks"];
+        const auto it = std::ranges::find( list.tasks, id, &lua_task::id );
+        if( it == list.tasks.end() || it->cancelled )
+        {
+            return false;
+        }
+        it->cancelled = true;
+        return true;
+    } );
+    DOC( "Number of tasks that are still running." );
+    luna::set_fx( lib, "task_count", []( sol::this_state lua_this ) -> int {
+        sol::state_view lua( lua_this );
+        const lua_task_list &list = lua["game"]["cata_internal"]["tasks"];
+        return static_cast<int>( std::ranges::count_if( list.tasks, []( const lua_task & t ) {
+            return !t.cancelled;
+        } ) );
+    } );
+
     DOC( "Register a Lua-defined action menu entry in the in-game action menu." );
     luna::set_fx( lib, "register_action_menu_entry", []( sol::table opts ) -> void {
         auto id = opts.get_or( "id", std::string{} );
@@ -20,6 +20,7 @@
 #include "overmap.h"
 #include "sol/sol.hpp"
 #include "sounds.h"
+#include "string_formatter.h"
 #include "trap.h"
 #include "detached_ptr.h"
 #include "veh_type.h"
@@ -32,6 +33,8 @@
 #include <algorithm>
 #include <cmath>
 #include <iterator>
+#include <stdexcept>
+#include <vector>
 
 LUNA_VAL( wrapped_vehicle, "WrappedVehicle" )
 
@@ -65,6 +68,32 @@ struct replace_vehicle_request {
     std::optional<bool> has_keys = std::nullopt;
 };
 
+/// Value at every point of @p points, in the range's order.
+template<typename Range, typename Get>
+auto values_in_rect( const Range &points, Get get )
+{
+    auto values = std::vector<decltype( get( *points.begin() ) )> {};
+    values.reserve( points.size() );
+    for( const auto p : points ) {
+        values.push_back( get( p ) );
+    }
+    return values;
+}
+
+/// Sets every point of @p points from @p values, in the range's order.
+template<typename Range, typename Value, typename Set>
+auto set_values_in_rect( const Range &points, const std::vector<Value> &values, Set set ) -> void
+{
+    if( values.size() != points.size() ) {
+        throw std::runtime_error( string_format( "expected %d values for the area, got %d",
+                                  points.size(), values.size() ) );
+    }
+    auto value = values.begin();
+    for( const auto p : points ) {
+        set( p, *value++ );
+    }
+}
+
 auto vehicle_part_with_feature_at( map &m, const tripoint_bub_ms &pos, const std::string &feature,
                                    const bool unbroken ) -> std::optional<vpart_reference>
 {
@@ -547,6 +576,39 @@ void cata::detail::reg_map( sol::state &lua )
                       sol::resolve<furn_id( const tripoint_bub_ms & )const>( &map::furn ) );
         luna::set_fx( ut, "set_furn_at", []( map & m, const tripoint_bub_ms & p, const furn_id & id ) { m.furn_set( p, id ); } );
 
+        DOC( "Terrain of every point in the rectangle between two corners, clipped to the map, in `points_in_rectangle` order (x fastest)." );
+        luna::set_fx( ut, "get_ter_in_rect", []( const map & m, const tripoint_bub_ms & from,
+        const tripoint_bub_ms & to ) -> std::vector<ter_id> {
+            return values_in_rect( m.points_in_rectangle( from, to ), [&m]( const tripoint_bub_ms & p )
+            {
+                return m.ter( p );
+            } );
+        } );
+        DOC( "Sets the terrain of every point in the rectangle from an array in `get_ter_in_rect` order." );
+        luna::set_fx( ut, "set_ter_in_rect", []( map & m, const tripoint_bub_ms & from,
+        const tripoint_bub_ms & to, const std::vector<ter_id> &ids ) -> void {
+            set_values_in_rect( m.points_in_rectangle( from, to ), ids, [&m]( const tripoint_bub_ms & p, const ter_id & id )
+            {
+                m.ter_set( p, id );
+            } );
+        } );
+        DOC( "Furniture of every point in the rectangle between two corners, clipped to the map, in `points_in_rectangle` order (x fastest)." );
+        luna::set_fx( ut, "get_furn_in_rect", []( const map & m, const tripoint_bub_ms & from,
+        const tripoint_bub_ms & to ) -> std::vector<furn_id> {
+            return values_in_rect( m.points_in_rectangle( from, to ), [&m]( const tripoint_bub_ms & p )
+            {
+                return m.furn( p );
+            } );
+        } );
+        DOC( "Sets the furniture of every point in the rectangle from an array in `get_furn_in_rect` order." );
+        luna::set_fx( ut, "set_furn_in_rect", []( map & m, const tripoint_bub_ms & from,
+        const tripoint_bub_ms & to, const std::vector<furn_id> &ids ) -> void {
+            set_values_in_rect( m.points_in_rectangle( from, to ), ids, [&m]( const tripoint_bub_ms & p, const furn_id & id )
+            {
+                m.furn_set( p, id );
+            } );
+        } );
+
         luna::set_fx( ut, "has_field_at",
                       []( const map & m, const tripoint_bub_ms & p, const field_type_id & fid ) -> bool { return !!m.field_at( p ).find_field( fid ); } );
         luna::set_fx( ut, "get_field_int_at", &map::get_field_intensity );
@@ -700,6 +762,39 @@ void cata::detail::reg_map( sol::state &lua )
         []( const mapgen_constructor & m, const point_omt_ms & p ) { return m.furn( p ); } );
         luna::set_fx( ut, "set_furn_at",
         []( mapgen_constructor & m, const point_omt_ms & p, const furn_id & id ) { m.furn_set( p, id ); } );
+
+        DOC( "Terrain of every point in the rectangle between two corners, clipped to the map, in `points_in_rectangle` order (x fastest)." );
+        luna::set_fx( ut, "get_ter_in_rect", []( const mapgen_constructor & m, const point_omt_ms & from,
+        const point_omt_ms & to ) -> std::vector<ter_id> {
+            return values_in_rect( m.points_in_rectangle( from, to ), [&m]( const point_omt_ms & p )
+            {
+                return m.ter( p );
+            } );
+        } );
+        DOC( "Sets the terrain of every point in the rectangle from an array in `get_ter_in_rect` order." );
+        luna::set_fx( ut, "set_ter_in_rect", []( mapgen_constructor & m, const point_omt_ms & from,
+        const point_omt_ms & to, const std::vector<ter_id> &ids ) -> void {
+            set_values_in_rect( m.points_in_rectangle( from, to ), ids, [&m]( const point_omt_ms & p, const ter_id & id )
+            {
+                m.ter_set( p, id );
+            } );
+        } );
+        DOC( "Furniture of every point in the rectangle between two corners, clipped to the map, in `points_in_rectangle` order (x fastest)." );
+        luna::set_fx( ut, "get_furn_in_rect", []( const mapgen_constructor & m, const point_omt_ms & from,
+        const point_omt_ms & to ) -> std::vector<furn_id> {
+            return values_in_rect( m.points_in_rectangle( from, to ), [&m]( const point_omt_ms & p )
+            {
+                return m.furn( p );
+            } );
+        } );
+        DOC( "Sets the furniture of every point in the rectangle from an array in `get_furn_in_rect` order." );
+        luna::set_fx( ut, "set_furn_in_rect", []( mapgen_constructor & m, const point_omt_ms & from,
+        const point_omt_ms & to, const std::vector<furn_id> &ids ) -> void {
+            set_values_in_rect( m.points_in_rectangle( from, to ), ids, [&m]( const point_omt_ms & p, const furn_id & id )
+            {
+                m.furn_set( p, id );
+            } );
+        } );
         luna::set_fx( ut, "get_temperature",
         []( const mapgen_constructor & m, const point_omt_ms & p ) { return m.get_temperature( p ); } );
         luna::set_fx( ut, "set_temperature",
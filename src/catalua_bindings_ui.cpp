@@ -4,6 +4,7 @@
 #include "catalua_bindings_utils.h"
 #include "catalua_luna.h"
 #include "catalua_luna_doc.h"
+#include "debug.h"
 
 #include "lua_sidebar_widgets.h"
 #include "panels.h"
@@ -141,7 +142,9 @@ void cata::detail::reg_ui_elements( sol::state &lua )
         DOC( "Sidebar utility functions." );
         luna::userlib lib = luna::begin_lib( lua, "sidebar" );
         DOC( "Register a Lua sidebar widget. Options: id(string), name(string), height(int, use -2 to fill remaining space), order(int, 1-based), draw(function), " );
-        DOC( "default_toggle(bool), redraw_every_frame(bool), panel_visible(bool|function), render(function). " );
+        DOC( "default_toggle(bool), redraw_every_frame(bool), panel_visible(bool|function), render(function), " );
+        DOC( "refresh(string: frame, turn or event), refresh_ms(int). Unless refresh is frame (the default), what panel_visible, render and draw " );
+        DOC( "return is reused until the turn changes, until invalidate_widget(id) is called, or for refresh_ms milliseconds if given." );
         DOC( "draw(width, height) returns an array of entries: each entry is string or table { text=string, color=Color|string }." );
         DOC( "text may include color tags like <color_red>text</color> for multi-color lines." );
         luna::set_fx( lib, "register_widget", []( const sol::table & opts ) {
@@ -179,6 +182,19 @@ void cata::detail::reg_ui_elements( sol::state &lua )
                     panel_visible_value = panel_visible_obj.as<bool>();
                 }
             }
+            using cata::lua_sidebar_widgets::refresh_policy;
+            const auto refresh_ms = get_opt_int( "refresh_ms", 0 );
+            const auto refresh_name = opts.get_or<std::string>( "refresh", refresh_ms > 0 ? "interval" : "frame" );
+            auto refresh = refresh_policy::every_frame;
+            if( refresh_name == "turn" ) {
+                refresh = refresh_policy::per_turn;
+            } else if( refresh_name == "event" ) {
+                refresh = refresh_policy::on_event;
+            } else if( refresh_name == "interval" ) {
+                refresh = refresh_policy::interval;
+            } else if( refresh_name != "frame" ) {
+                debugmsg( "Lua sidebar widget has unknown refresh policy '%s'.", refresh_name );
+            }
             auto draw_fn = opts.get_or<sol::protected_function>( "draw", sol::lua_nil );
             auto render_fn = opts.get_or<sol::protected_function>( "render", sol::lua_nil );
             auto render_opt = render_fn == sol::lua_nil ?
@@ -195,10 +211,16 @@ void cata::detail::reg_ui_elements( sol::state &lua )
                 .panel_visible_fn = panel_visible_fn,
                 .draw = draw_fn,
                 .render = render_opt,
+                .refresh = refresh,
+                .refresh_interval_ms = refresh_ms,
             };
             cata::lua_sidebar_widgets::register_widget( widget_opts );
             panel_manager::get_manager().sync_lua_panels();
         } );
+        DOC( "Make the widget with the given id call its callbacks again on the next sidebar redraw." );
+        luna::set_fx( lib, "invalidate_widget", []( const std::string & id ) {
+            cata::lua_sidebar_widgets::invalidate_widget( id );
+        } );
         DOC( "Clear all registered Lua sidebar widgets." );
         luna::set_fx( lib, "clear_widgets", []() {
             cata::lua_sidebar_widgets::clear_widgets();
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <functional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "catalua_sol_fwd.h"
 
@@ -33,6 +35,20 @@ const hook_opts &opts = {} ) -> sol::table;
 /// Return whether a hook currently has registered entries without building params/results tables.
 auto has_hooks( std::string_view hook_name, const hook_opts &opts = {} ) -> bool;
 
+/// Time spent in one mod's entries of one hook while hook profiling was enabled.
+struct hook_profile_entry {
+    std::string hook_name;
+    std::string mod_id;
+    int calls = 0;
+    double total_ms = 0.0;
+};
+
+/// Start or stop timing hook entries by mod.  Either way, clears what was recorded.
+void set_hook_profiling( bool enable );
+auto hook_profiling_enabled() -> bool;
+/// Recorded hook entries, slowest first.
+auto hook_profile() -> std::vector<hook_profile_entry>;
+
 /// Define all hooks that are used in the game.
 void define_hooks( lua_state &state );
 
@@ -1,5 +1,6 @@
 #include "catalua_impl.h"
 
+#include "cached_options.h"
 #include "catalua_bindings.h"
 #include "catalua_loader.h"
 #include "catalua_log.h"
@@ -7,22 +8,60 @@
 #include "debug.h"
 #include "string_formatter.h"
 
+#include <atomic>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <optional>
 #include <stdexcept>
 #include <utility>
 
+namespace
+{
+
+std::atomic<std::size_t> lua_bytes_in_use = 0;
+
+/// The stock allocator, plus accounting for the LUA_MEMORY_LIMIT option.
+auto lua_alloc( void *, void *ptr, const std::size_t osize, const std::size_t nsize ) -> void *
+{
+    // For new blocks Lua passes the kind of object instead of an old size.
+    const std::size_t old_size = ptr ? osize : 0;
+    if( nsize == 0 ) {
+        std::free( ptr );
+        lua_bytes_in_use -= old_size;
+        return nullptr;
+    }
+    const auto limit = static_cast<std::size_t>( lua_memory_limit_mb ) * 1024 * 1024;
+    // Lua expects shrinking to always succeed, and turns a failed growth into a script error.
+    if( limit > 0 && nsize > old_size && lua_bytes_in_use + nsize - old_size > limit ) {
+        return nullptr;
+    }
+    void *const result = std::realloc( ptr, nsize );
+    if( result ) {
+        lua_bytes_in_use += nsize;
+        lua_bytes_in_use -= old_size;
+    }
+    return result;
+}
+
+} // namespace
+
+auto lua_memory_in_use() -> std::size_t
+{
+    return lua_bytes_in_use;
+}
+
 sol::state make_lua_state()
 {
-    sol::state lua;
+    sol::state lua( sol::default_at_panic, &lua_alloc );
 
     lua.open_libraries(
         sol::lib::base,
         sol::lib::package,
         sol::lib::math,
         sol::lib::string,
-        sol::lib::table
+        sol::lib::table,
+        sol::lib::coroutine
     );
 
     // Register custom module loader for relative/absolute imports
@@ -38,7 +77,9 @@ void run_lua_script( sol::state &lua, const std::string &script_name )
     // RAII guard ensures stack cleanup even if exception occurs
     const auto guard = cata::lua_loader::script_context_guard{ script_name };
 
-    sol::load_result load_res = lua.load_file( script_name );
+    const int status = cata::lua_loader::load_file( lua.lua_state(), script_name );
+    sol::load_result load_res( lua.lua_state(), sol::absolute_index( lua.lua_state(), -1 ), 1, 1,
+                               static_cast<sol::load_status>( status ) );
 
     if( !load_res.valid() ) {
         sol::error err = load_res;
@@ -1,5 +1,11 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
 #include "calendar.h"
 #include "catalua_sol.h"
 
@@ -10,6 +16,25 @@ struct on_every_x_hooks {
     std::vector<sol::protected_function> functions;
 };
 
+/** Long-running Lua function resumed a little each turn, see run_lua_tasks(). */
+struct lua_task {
+    int id = 0;
+    sol::thread thread;
+    sol::coroutine routine;
+    sol::protected_function on_progress;
+    sol::protected_function on_done;
+    sol::protected_function on_cancel;
+    bool cancelled = false;
+};
+
+struct lua_task_list {
+    int next_id = 1;
+    std::vector<lua_task> tasks;
+};
+
+/** Bumped on every on_every_x hook registration, so lua states replan their next due turn. */
+extern int on_every_x_hooks_generation;
+
 /**
  * Lua state handle.
  * Definition is hidden from outside code to prevent sol::state
@@ -18,6 +43,18 @@ struct on_every_x_hooks {
 struct lua_state {
     sol::state lua;
 
+    /** No on_every_x hook is due before this turn, see run_on_every_x_hooks(). */
+    time_point on_every_x_next_due;
+    time_point on_every_x_planned_at;
+    int on_every_x_planned_generation = -1;
+
+    /**
+     * Callbacks from game.<table>[id] that were already looked up, by table and id.
+     * Lives as long as the state, so reloading mods starts over.
+     */
+    std::map<std::string, std::map<std::string, sol::protected_function, std::less<>>, std::less<>>
+    callback_cache;
+
     lua_state() = default;
     ~lua_state() = default;
 };
@@ -25,6 +62,8 @@ struct lua_state {
 } // namespace cata
 
 sol::state make_lua_state();
+/// Bytes currently held by all Lua states.
+auto lua_memory_in_use() -> std::size_t;
 void run_lua_script( sol::state &lua, const std::string &script_name );
 void run_console_input( sol::state &lua, const std::string &chunk );
 void check_func_result( sol::protected_function_result &res );
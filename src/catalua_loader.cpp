@@ -1,11 +1,17 @@
 #include "catalua_loader.h"
 
 #include "catalua_sol.h"
+#include "debug.h"
 #include "filesystem.h"
 #include "path_info.h"
+#include "string_formatter.h"
 
 #include <algorithm>
+#include <cstdint>
+#include <fstream>
 #include <ranges>
+#include <string>
+#include <string_view>
 
 namespace fs = std::filesystem;
 
@@ -134,6 +140,56 @@ auto search_module( lua_State *L, std::string_view modname ) -> std::optional<fs
     return std::nullopt;
 }
 
+// Cached chunks start with this, the 64-bit source hash, then the lua_dump output.
+constexpr auto cache_magic = std::string_view{ "CBLC" LUA_RELEASE "\n" };
+
+// FNV-1a, so cache keys stay the same across runs and platforms.
+auto hash_bytes( std::string_view bytes ) -> uint64_t
+{
+    auto hash = uint64_t{ 0xcbf29ce484222325ULL };
+    for( const auto c : bytes ) {
+        hash = ( hash ^ static_cast<unsigned char>( c ) ) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+auto cache_header( uint64_t source_hash ) -> std::string
+{
+    auto header = std::string{ cache_magic };
+    for( auto i = 0; i < 8; ++i ) {
+        header.push_back( static_cast<char>( source_hash & 0xff ) );
+        source_hash >>= 8;
+    }
+    return header;
+}
+
+auto append_chunk( lua_State *, const void *p, size_t size, void *out ) -> int
+{
+    static_cast<std::string *>( out )->append( static_cast<const char *>( p ), size );
+    return 0;
+}
+
+auto write_cache( fs::path const &cache_path, std::string const &contents ) -> void
+{
+    auto ec = std::error_code{};
+    fs::create_directories( cache_path.parent_path(), ec );
+    auto tmp_path = cache_path;
+    tmp_path += ".tmp";
+    {
+        auto out = std::ofstream( tmp_path, std::ios::binary | std::ios::trunc );
+        out.write( contents.data(), static_cast<std::streamsize>( contents.size() ) );
+        if( !out ) {
+            DebugLog( DL::Warn, DC::Lua ) << "Failed to write Lua chunk cache " << tmp_path.string();
+            fs::remove( tmp_path, ec );
+            return;
+        }
+    }
+    fs::rename( tmp_path, cache_path, ec );
+    if( ec ) {
+        fs::remove( tmp_path, ec );
+    }
+}
+
 // The actual loader that executes the module
 // Upvalue 1: path string
 auto module_loader( lua_State *L ) -> int
@@ -145,7 +201,7 @@ auto module_loader( lua_State *L ) -> int
     const auto guard = script_context_guard{ path };
 
     // Load the file
-    const auto status = luaL_loadfile( L, path.string().c_str() );
+    const auto status = load_file( L, path );
     if( status != LUA_OK ) {
         return lua_error( L );
     }
@@ -190,6 +246,53 @@ script_context_guard::~script_context_guard()
     pop_path();
 }
 
+auto load_file( lua_State *L, fs::path const &path ) -> int
+{
+    const auto name = path.string();
+    const auto chunkname = "@" + name;
+    if( !file_exist( name ) ) {
+        lua_pushfstring( L, "cannot open %s", name.c_str() );
+        return LUA_ERRFILE;
+    }
+    auto source = read_entire_file( name );
+    // What luaL_loadfile skips: a UTF-8 BOM and a first line starting with '#'.
+    if( source.starts_with( "\xEF\xBB\xBF" ) ) {
+        source.erase( 0, 3 );
+    }
+    if( source.starts_with( '#' ) ) {
+        source.erase( 0, std::min( source.find( '\n' ), source.size() ) );
+    }
+    // Precompiled files have nothing to cache.
+    if( source.starts_with( LUA_SIGNATURE ) ) {
+        return luaL_loadbufferx( L, source.data(), source.size(), chunkname.c_str(), "b" );
+    }
+
+    const auto cache_path = fs::path{ PATH_INFO::lua_cachedir() } /
+                            string_format( "%016llx.luac", static_cast<unsigned long long>( hash_bytes( name ) ) );
+    const auto header = cache_header( hash_bytes( source ) );
+    const auto cached = file_exist( cache_path.string() ) ? read_entire_file( cache_path.string() ) :
+                        std::string{};
+    if( cached.starts_with( header ) ) {
+        const auto chunk = std::string_view{ cached }.substr( header.size() );
+        if( luaL_loadbufferx( L, chunk.data(), chunk.size(), chunkname.c_str(), "b" ) == LUA_OK ) {
+            return LUA_OK;
+        }
+        // A damaged cache entry; compile the source and replace it.
+        lua_pop( L, 1 );
+    }
+
+    const auto status = luaL_loadbufferx( L, source.data(), source.size(), chunkname.c_str(), "t" );
+    if( status != LUA_OK ) {
+        return status;
+    }
+    // Keep debug info so error messages and tracebacks still name lines.
+    auto contents = header;
+    if( lua_dump( L, append_chunk, &contents, 0 ) == 0 ) {
+        write_cache( cache_path, contents );
+    }
+    return LUA_OK;
+}
+
 auto register_searcher( lua_State *L ) -> void
 {
     // Insert our searcher at position 2 (after preload, before default Lua searcher)
@@ -26,4 +26,11 @@ class script_context_guard
 // Register custom searcher - call once during lua state init
 auto register_searcher( lua_State *L ) -> void;
 
+// Load the Lua file at path as a chunk on top of the stack, like luaL_loadfile.
+// The compiled chunk is cached in PATH_INFO::lua_cachedir(), keyed by the Lua
+// release and a hash of the source, so unchanged scripts skip the compiler on
+// later launches.  Returns the lua_load status; on failure the error message
+// is on the stack instead.
+auto load_file( lua_State *L, std::filesystem::path const &path ) -> int;
+
 } // namespace cata::lua_loader
@@ -145,32 +145,33 @@ static void serialize_lua_object( const sol::object &val, JsonOut &jsout,
 {
     sol::state_view lua( val.lua_state() );
 
-    jsout.start_object();
+    // Booleans, integers and strings are written bare, since they make up most
+    // of the saved data and their JSON type is unambiguous.
     switch( val.get_type() ) {
-        case sol::type::boolean: {
-            jsout.member_as_string( "type", "bool" );
-            jsout.member( "data" );
+        case sol::type::boolean:
             jsout.write( val.as<bool>() );
-            break;
-        }
-        case sol::type::number: {
-            // There's no clear difference in JSON between int and float,
-            // so we have to be explicit to avoid subtle errors down the line
+            return;
+        case sol::type::number:
             if( is_number_integer( lua, val ) ) {
-                jsout.member_as_string( "type", "int" );
-                jsout.member( "data" );
                 jsout.write( val.as<int64_t>() );
-            } else {
-                jsout.member_as_string( "type", "float" );
-                jsout.member( "data" );
-                jsout.write( val.as<double>() );
+                return;
             }
             break;
-        }
-        case sol::type::string: {
-            jsout.member_as_string( "type", "string" );
-            jsout.member( "data" );
+        case sol::type::string:
             jsout.write( val.as<std::string>() );
+            return;
+        default:
+            break;
+    }
+
+    jsout.start_object();
+    switch( val.get_type() ) {
+        case sol::type::number: {
+            // There's no clear difference in JSON between int and float,
+            // so floats stay tagged to avoid subtle errors down the line
+            jsout.member_as_string( "type", "float" );
+            jsout.member( "data" );
+            jsout.write( val.as<double>() );
             break;
         }
         case sol::type::table: {
@@ -263,7 +264,7 @@ deserialize_lua_object( sol::state_view lua, const JsonObject &jo )
         bool data = jo.get_bool( "data" );
         return sol::object( lua, sol::in_place, data );
     } else if( entry_type == "int" ) {
-        int data = jo.get_int( "data" );
+        int64_t data = jo.get_member( "data" ).get_int64();
         return sol::object( lua, sol::in_place, data );
     } else if( entry_type == "float" ) {
         double data = jo.get_float( "data" );
@@ -310,6 +311,19 @@ deserialize_lua_object( sol::state_view lua, const JsonObject &jo )
     return sol::nil;
 }
 
+static sol::object deserialize_lua_value( sol::state_view lua, const JsonValue &jv )
+{
+    if( jv.test_string() ) {
+        return sol::object( lua, sol::in_place, jv.get_string() );
+    } else if( jv.test_bool() ) {
+        return sol::object( lua, sol::in_place, jv.get_bool() );
+    } else if( jv.test_int() ) {
+        return sol::object( lua, sol::in_place, jv.get_int64() );
+    }
+    // Tagged record, also how older saves stored every value
+    return deserialize_lua_object( lua, jv.get_object() );
+}
+
 void deserialize_lua_table( sol::table t, JsonObject &obj )
 {
     sol::state_view lua( t.lua_state() );
@@ -323,12 +337,15 @@ void deserialize_lua_table( sol::table t, JsonObject &obj )
         debugmsg( "invalid array size %d", arr.size() );
         return;
     }
-    for( size_t idx = 0; idx < arr.size(); idx += 2 ) {
-        JsonObject jo_key = arr.get_object( idx );
-        JsonObject jo_val = arr.get_object( idx + 1 );
-        sol::object key = deserialize_lua_object( lua, jo_key );
-        sol::object val = deserialize_lua_object( lua, jo_val );
-        t.set( key, val );
+    std::optional<sol::object> key;
+    for( const JsonValue jv : arr ) {
+        sol::object val = deserialize_lua_value( lua, jv );
+        if( !key ) {
+            key = std::move( val );
+        } else {
+            t.set( *key, val );
+            key.reset();
+        }
     }
 }
 
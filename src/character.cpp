@@ -585,6 +585,7 @@ void Character::move_operator_common( Character &&source ) noexcept
     bio_soporific_powered_at_last_sleep_check = source.bio_soporific_powered_at_last_sleep_check ;
     my_traits = std::move( source.my_traits );
     cached_mutations = std::move( source.cached_mutations );
+    cached_mutation_values = std::move( source.cached_mutation_values );
     _skills = std::move( source._skills );
     autolearn_skills_stamp = std::move( source.autolearn_skills_stamp );
     learned_recipes = std::move( source.learned_recipes );
@@ -632,7 +633,15 @@ void Character::move_operator_common( Character &&source ) noexcept
 
     cached_moves = source.cached_moves ;
     cached_position = source.cached_position ;
+    cached_radius = source.cached_radius ;
+    cached_clear_path = source.cached_clear_path ;
     cached_crafting_inventory = std::move( source.cached_crafting_inventory );
+    cached_possessions = std::move( source.cached_possessions );
+    cached_possessions_generation = source.cached_possessions_generation ;
+    cached_possessions_burrow = source.cached_possessions_burrow ;
+    cached_possessions_power = source.cached_possessions_power ;
+    cached_bionic_tools = std::move( source.cached_bionic_tools );
+    cached_trait_tools = std::move( source.cached_trait_tools );
 
     npc_ai_info_cache = source.npc_ai_info_cache ;
 
@@ -7602,7 +7611,8 @@ float calc_mutation_value_multiplicative( const std::vector<const mutation_branc
     return ret;
 }
 
-static const std::map<std::string, std::function <float( std::vector<const mutation_branch *> )>>
+static const
+std::map<std::string, std::function <float( const std::vector<const mutation_branch *> & )>>
 mutation_value_map = {
     { "pain_recovery", calc_mutation_value<&mutation_branch::pain_recovery> },
     { "healing_awake", calc_mutation_value<&mutation_branch::healing_awake> },
@@ -7650,6 +7660,10 @@ mutation_value_map = {
 
 float Character::mutation_value( const std::string &val ) const
 {
+    const auto cached = cached_mutation_values.find( val );
+    if( cached != cached_mutation_values.end() ) {
+        return cached->second;
+    }
     // Syntax similar to tuple get<n>()
     const auto found = mutation_value_map.find( val );
 
@@ -7661,6 +7675,14 @@ float Character::mutation_value( const std::string &val ) const
     }
 }
 
+void Character::recalc_mutation_values()
+{
+    cached_mutation_values.clear();
+    for( const auto &[name, calc] : mutation_value_map ) {
+        cached_mutation_values.emplace( name, calc( cached_mutations ) );
+    }
+}
+
 float Character::healing_rate( float at_rest_quality ) const
 {
     // TODO: Cache
@@ -8997,6 +9019,7 @@ void Character::recalculate_enchantment_cache()
         }
     }
 
+    enchantment_cache->cache_totals();
     enchantment_cache->activate_effects( *this );
     enchantment_cache->deactivate_removed_effects( *this, old_ench_sources );
 
@@ -9008,12 +9031,18 @@ void Character::recalculate_enchantment_cache()
 
 void Character::rebuild_mutation_cache()
 {
-    cached_mutations.clear();
+    std::vector<const mutation_branch *> mutations;
+    mutations.reserve( my_mutations.size() + enchantment_cache->get_mutations().size() );
     for( const std::pair<const trait_id, char_trait_data> &mut : my_mutations ) {
-        cached_mutations.push_back( &mut.first.obj() );
+        mutations.push_back( &mut.first.obj() );
     }
     for( const trait_id &mut : enchantment_cache->get_mutations() ) {
-        cached_mutations.push_back( &mut.obj() );
+        mutations.push_back( &mut.obj() );
+    }
+    // This runs every turn with the enchantments, but the mutations rarely change
+    if( mutations != cached_mutations || cached_mutation_values.empty() ) {
+        cached_mutations = std::move( mutations );
+        recalc_mutation_values();
     }
 }
 
@@ -2358,6 +2358,12 @@ class Character : public Creature, public location_visitable<Character>
          * Pointers to mutation branches in @ref my_mutations.
          */
         std::vector<const mutation_branch *> cached_mutations;
+        /**
+         * Every @ref mutation_value for @ref cached_mutations, worked out when they change
+         * rather than each time one is asked for.
+         */
+        std::unordered_map<std::string, float> cached_mutation_values;
+        void recalc_mutation_values();
 
         void store( JsonOut &json ) const;
         void load( const JsonObject &data );
@@ -2467,7 +2473,20 @@ class Character : public Creature, public location_visitable<Character>
 
         int cached_moves = 0;
         tripoint_bub_ms cached_position;
+        int cached_radius = 0;
+        bool cached_clear_path = false;
         inventory cached_crafting_inventory;
+        /**
+         * The part of the crafting inventory the character carries, which unlike what is around
+         * them is kept across turns until an item is moved or destroyed somewhere.
+         */
+        inventory cached_possessions;
+        std::optional<uint64_t> cached_possessions_generation;
+        bool cached_possessions_burrow = false;
+        units::energy cached_possessions_power = 0_kJ;
+        /** Bionic and trait tools in @ref cached_possessions, owned here so they outlive the turn. */
+        std::vector<detached_ptr<item>> cached_bionic_tools;
+        std::vector<detached_ptr<item>> cached_trait_tools;
 
         mutable std::array<double, npc_ai_info::num_npc_ai_info> npc_ai_info_cache;
 
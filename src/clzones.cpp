@@ -20,6 +20,7 @@
 #include "cursesdef.h"
 #include "debug.h"
 #include "faction.h"
+#include "flat_hash_map.h"
 #include "fstream_utils.h"
 #include "game.h"
 #include "generic_factory.h"
@@ -31,6 +32,7 @@
 #include "itype.h"
 #include "json.h"
 #include "line.h"
+#include "lock_stats.h"
 #include "make_static.h"
 #include "map.h"
 #include "map_iterator.h"
@@ -324,7 +326,7 @@ auto blueprint_options::get_covered_points( const tripoint_abs_ms &start,
 
     const auto shape = make_circle_shape( bounds, border_only );
     if( circle_layout && border_only ) {
-        auto fill_set = std::unordered_set<tripoint_abs_ms>();
+        auto fill_set = cata::flat_hash_set<tripoint_abs_ms>();
         const auto circle_fill = make_circle_shape( bounds, false );
         for( auto z = bounds.min.z(); z <= bounds.max.z(); ++z ) {
             for( auto y = bounds.min.y(); y <= bounds.max.y(); ++y ) {
@@ -336,7 +338,7 @@ auto blueprint_options::get_covered_points( const tripoint_abs_ms &start,
                 }
             }
         }
-        auto border_set = std::unordered_set<tripoint_abs_ms>();
+        auto border_set = cata::flat_hash_set<tripoint_abs_ms>();
         const auto neighbors = std::array<point, 8> {
             point_east, point_west, point_north, point_south,
             point_east + point_north, point_east + point_south,
@@ -563,6 +565,15 @@ bool loot_options::query()
     return query_loot() == changed;
 }
 
+bool loot_options::matches( const item &it ) const
+{
+    if( !mark_filter || mark_filter_source != mark ) {
+        mark_filter = item_filter_from_string( mark );
+        mark_filter_source = mark;
+    }
+    return mark_filter( it );
+}
+
 std::string loot_options::get_zone_name_suggestion() const
 {
     if( !mark.empty() ) {
@@ -870,6 +881,50 @@ bool zone_manager::has_defined( const zone_type_id &type, const faction_id &fac
     return type_iter != area_cache.end();
 }
 
+namespace
+{
+
+auto make_zone_area( const zone_data &zone ) -> zone_area
+{
+    const auto bounds = make_zone_bounds( zone.get_start_point(), zone.get_end_point() );
+    auto area = zone_area{ bounds.min, bounds.max, std::nullopt };
+    if( zone.get_type() == zone_CONSTRUCTION_BLUEPRINT ) {
+        auto tiles = get_zone_covered_points( zone );
+        const auto box = rectangle_points( bounds );
+        if( tiles.size() != box.size() ) {
+            std::sort( tiles.begin(), tiles.end() );
+            area.tiles = std::move( tiles );
+        }
+    }
+    return area;
+}
+
+} // namespace
+
+bool zone_area::contains( const tripoint_abs_ms &p ) const
+{
+    if( p.x() < min.x() || p.x() > max.x() || p.y() < min.y() || p.y() > max.y() ||
+        p.z() < min.z() || p.z() > max.z() ) {
+        return false;
+    }
+    return !tiles || std::binary_search( tiles->begin(), tiles->end(), p );
+}
+
+std::optional<tripoint_abs_ms> zone_area::closest_to( const tripoint_abs_ms &p ) const
+{
+    if( !tiles ) {
+        return tripoint_abs_ms( std::clamp( p.x(), min.x(), max.x() ),
+                                std::clamp( p.y(), min.y(), max.y() ),
+                                std::clamp( p.z(), min.z(), max.z() ) );
+    }
+    if( tiles->empty() ) {
+        return std::nullopt;
+    }
+    return *std::ranges::min_element( *tiles, {}, [&p]( const tripoint_abs_ms & t ) {
+        return square_dist( t, p );
+    } );
+}
+
 void zone_manager::cache_data()
 {
     area_cache.clear();
@@ -878,12 +933,7 @@ void zone_manager::cache_data()
         if( !elem.get_enabled() ) {
             return;
         }
-
-        auto &cache = area_cache[elem.get_type_hash()];
-        const auto points = get_zone_covered_points( elem );
-        std::ranges::for_each( points, [&]( const tripoint_abs_ms & point ) {
-            cache.insert( point );
-        } );
+        area_cache[elem.get_type_hash()].push_back( make_zone_area( elem ) );
     } );
 }
 
@@ -895,24 +945,19 @@ void zone_manager::cache_vzones()
         if( elem == nullptr || !elem->get_enabled() ) {
             return;
         }
-
-        auto &cache = vzone_cache[elem->get_type_hash()];
-        const auto points = get_zone_covered_points( *elem );
-        std::ranges::for_each( points, [&]( const tripoint_abs_ms & point ) {
-            cache.insert( point );
-        } );
+        vzone_cache[elem->get_type_hash()].push_back( make_zone_area( *elem ) );
     } );
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
+std::array<const std::vector<zone_area> *, 2> zone_manager::get_areas( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
-
-    return type_iter->second;
+    static const std::vector<zone_area> none;
+    const std::string hash = zone_data::make_type_hash( type, fac );
+    const auto area_iter = area_cache.find( hash );
+    const auto vzone_iter = vzone_cache.find( hash );
+    return { area_iter == area_cache.end() ? &none : &area_iter->second,
+             vzone_iter == vzone_cache.end() ? &none : &vzone_iter->second };
 }
 
 std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set_loot( const tripoint_abs_ms &where,
@@ -941,48 +986,34 @@ std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set_loot( const trip
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
-
-    return type_iter->second;
-}
-
 bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.contains( where ) || vzone_set.contains( where );
+    return std::ranges::any_of( get_areas( type, fac ), [&]( const std::vector<zone_area> *areas ) {
+        return std::ranges::any_of( *areas, [&]( const zone_area & area ) {
+            return area.contains( where );
+        } );
+    } );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( auto &point : point_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    // Only tiles on the same level count
+    const auto near = [&]( const zone_area & area ) {
+        if( where.z() < area.min.z() || where.z() > area.max.z() ) {
+            return false;
         }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+        if( area.tiles ) {
+            return std::ranges::any_of( *area.tiles, [&]( const tripoint_abs_ms & t ) {
+                return t.z() == where.z() && square_dist( t, where ) <= range;
+            } );
         }
-    }
-
-    return false;
+        return square_dist( *area.closest_to( where ), where ) <= range;
+    };
+    return std::ranges::any_of( get_areas( type, fac ), [&]( const std::vector<zone_area> *areas ) {
+        return std::ranges::any_of( *areas, near );
+    } );
 }
 
 bool zone_manager::has_loot_dest_near( const tripoint_abs_ms &where ) const
@@ -1026,36 +1057,28 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
         return false;
     }
     const loot_options &options = dynamic_cast<const loot_options &>( zone->get_options() );
-    std::string filter_string = options.get_mark();
-    auto z = item_filter_from_string( filter_string );
-
-    return z( *it );
+    return options.matches( *it );
 }
 
 std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     auto near_point_set = std::unordered_set<tripoint_abs_ms>();
-
-    for( auto &point : point_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                if( it && has( zone_LOOT_CUSTOM, point ) ) {
-                    if( custom_loot_has( point, it ) ) {
-                        near_point_set.insert( point );
-                    }
-                } else {
-                    near_point_set.insert( point );
-                }
-            }
+    const auto add_near = [&]( const zone_area & area ) {
+        if( where.z() < area.min.z() || where.z() > area.max.z() ) {
+            return;
         }
-    }
-
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( auto &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
+        // Only the part of the zone within range gets expanded into tiles
+        const int min_x = std::max( area.min.x(), where.x() - range );
+        const int max_x = std::min( area.max.x(), where.x() + range );
+        const int min_y = std::max( area.min.y(), where.y() - range );
+        const int max_y = std::min( area.max.y(), where.y() + range );
+        for( int y = min_y; y <= max_y; ++y ) {
+            for( int x = min_x; x <= max_x; ++x ) {
+                const tripoint_abs_ms point( x, y, where.z() );
+                if( area.tiles && !area.contains( point ) ) {
+                    continue;
+                }
                 if( it && has( zone_LOOT_CUSTOM, point ) ) {
                     if( custom_loot_has( point, it ) ) {
                         near_point_set.insert( point );
@@ -1065,6 +1088,9 @@ std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &
                 }
             }
         }
+    };
+    for( const std::vector<zone_area> *areas : get_areas( type, fac ) ) {
+        std::ranges::for_each( *areas, add_near );
     }
 
     return near_point_set;
@@ -1078,34 +1104,24 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
         return std::nullopt;
     }
 
-    tripoint_abs_ms nearest_pos = tripoint_abs_ms( INT_MIN, INT_MIN, INT_MIN );
+    std::optional<tripoint_abs_ms> nearest_pos;
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    for( const std::vector<zone_area> *areas : get_areas( type, fac ) ) {
+        for( const zone_area &area : *areas ) {
+            const std::optional<tripoint_abs_ms> p = area.closest_to( where );
+            if( !p ) {
+                continue;
             }
-        }
-    }
-
-    const std::unordered_set<tripoint_abs_ms> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+            const int cur_dist = square_dist( *p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
-    if( nearest_dist > range ) {
-        return std::nullopt;
-    }
     return nearest_pos;
 }
 
@@ -1252,7 +1268,8 @@ struct deferred_zone {
     tripoint_abs_ms     start;
     tripoint_abs_ms     end;
 };
-std::mutex                 g_deferred_zones_mutex;
+using deferred_zones_mutex_type = lock_stats::counted<std::mutex, "clzones::g_deferred_zones_mutex">;
+TracyLockable( deferred_zones_mutex_type, g_deferred_zones_mutex );
 std::vector<deferred_zone> g_deferred_zones;
 } // namespace
 
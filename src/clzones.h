@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
 #include <functional>
 #include <map>
@@ -222,6 +223,9 @@ class loot_options : public zone_options, public mark_option
     private:
         // basic item filter.
         std::string mark;
+        // mark compiled by matches(), and what it was compiled from
+        mutable std::function<bool( const item & )> mark_filter;
+        mutable std::string mark_filter_source;
 
         enum query_loot_result {
             canceled,
@@ -235,6 +239,8 @@ class loot_options : public zone_options, public mark_option
         std::string get_mark() const override {
             return mark;
         }
+        /** Whether @p it passes the item filter. */
+        bool matches( const item &it ) const;
 
         bool has_options() const override {
             return true;
@@ -363,6 +369,21 @@ class zone_data
         void deserialize( JsonIn &jsin );
 };
 
+/**
+ * The tiles of one enabled zone, kept as its bounding box rather than tile by tile.
+ * Zones that don't fill their box, like round blueprints, also list their tiles.
+ */
+struct zone_area {
+    tripoint_abs_ms min;
+    tripoint_abs_ms max;
+    /** Sorted tiles of a zone that doesn't fill its box. */
+    std::optional<std::vector<tripoint_abs_ms>> tiles;
+
+    bool contains( const tripoint_abs_ms &p ) const;
+    /** Closest tile to @p p, by Chebyshev distance. */
+    std::optional<tripoint_abs_ms> closest_to( const tripoint_abs_ms &p ) const;
+};
+
 class zone_manager
 {
     public:
@@ -381,11 +402,10 @@ class zone_manager
         std::vector<zone_data> removed_vzones;
 
         std::map<zone_type_id, zone_type> types;
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
-                const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
+        std::unordered_map<std::string, std::vector<zone_area>> area_cache;
+        std::unordered_map<std::string, std::vector<zone_area>> vzone_cache;
+        /** Areas of the enabled zones of @p type, then of the vehicle zones of it. */
+        std::array<const std::vector<zone_area> *, 2> get_areas( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
 
         //Cache number of items already checked on each source tile when sorting
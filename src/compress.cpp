@@ -1,6 +1,7 @@
 #include "compress.h"
 
 #include <zlib.h>
+#include <algorithm>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -50,4 +51,213 @@ void zlib_decompress( const void *compressed_data, int compressed_size, std::str
     } while( result == Z_BUF_ERROR );
 
     output.resize( decompressedSize );
-}
\ No newline at end of file
+}
+
+void zlib_compress( const std::string &input, std::vector<std::byte> &output,
+                    std::string_view dictionary )
+{
+    z_stream stream{};
+    if( deflateInit( &stream, Z_BEST_SPEED ) != Z_OK ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    if( deflateSetDictionary( &stream, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                              dictionary.size() ) != Z_OK ) {
+        deflateEnd( &stream );
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( deflateBound( &stream, input.size() ) );
+    stream.next_in = reinterpret_cast<Bytef *>( const_cast<char *>( input.data() ) );
+    stream.avail_in = input.size();
+    stream.next_out = reinterpret_cast<Bytef *>( output.data() );
+    stream.avail_out = output.size();
+
+    const int result = deflate( &stream, Z_FINISH );
+    deflateEnd( &stream );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib compression error" );
+    }
+
+    output.resize( stream.total_out );
+}
+
+void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output,
+                      std::string_view dictionary )
+{
+    z_stream stream{};
+    if( inflateInit( &stream ) != Z_OK ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+    stream.next_in = reinterpret_cast<Bytef *>( const_cast<void *>( compressed_data ) );
+    stream.avail_in = compressed_size;
+
+    // Same growth strategy as the dictionary-less overload.
+    output.resize( std::max<size_t>( static_cast<size_t>( compressed_size ) * 8, 256 ) );
+    int result;
+    do {
+        if( stream.total_out == output.size() ) {
+            output.resize( output.size() * 2 );
+        }
+        stream.next_out = reinterpret_cast<Bytef *>( output.data() + stream.total_out );
+        stream.avail_out = output.size() - stream.total_out;
+
+        result = inflate( &stream, Z_NO_FLUSH );
+        if( result == Z_NEED_DICT ) {
+            result = inflateSetDictionary( &stream, reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                           dictionary.size() );
+        }
+    } while( result == Z_OK || ( result == Z_BUF_ERROR && stream.avail_out == 0 ) );
+
+    const auto total = stream.total_out;
+    inflateEnd( &stream );
+    if( result != Z_STREAM_END ) {
+        throw std::runtime_error( "Zlib decompression failed" );
+    }
+
+    output.resize( total );
+}
+
+namespace
+{
+
+// Big enough for a typical submap blob in one call into zlib.
+constexpr auto staging_size = std::size_t{ 64 * 1024 };
+
+auto scratch_pool() -> std::vector<std::unique_ptr<std::string>> & // *NOPAD*
+{
+    static thread_local auto pool = std::vector<std::unique_ptr<std::string>> {};
+    return pool;
+}
+
+} // namespace
+
+scratch_buffer::scratch_buffer()
+{
+    auto &pool = scratch_pool();
+    if( pool.empty() ) {
+        buffer_ = std::make_unique<std::string>();
+    } else {
+        buffer_ = std::move( pool.back() );
+        pool.pop_back();
+    }
+}
+
+scratch_buffer::~scratch_buffer()
+{
+    buffer_->clear();
+    scratch_pool().push_back( std::move( buffer_ ) );
+}
+
+zlib_ostreambuf::zlib_ostreambuf( std::vector<std::byte> &output, dictionary_fn choose_dictionary )
+    : output_( output )
+    , choose_dictionary_( std::move( choose_dictionary ) )
+{
+    output_.clear();
+    auto &staging = staging_.get();
+    staging.resize( staging_size );
+    setp( staging.data(), staging.data() + staging.size() );
+}
+
+zlib_ostreambuf::~zlib_ostreambuf()
+{
+    if( stream_ ) {
+        deflateEnd( stream_.get() );
+    }
+}
+
+auto zlib_ostreambuf::start() -> void
+{
+    stream_ = std::make_unique<z_stream>();
+    if( deflateInit( stream_.get(), Z_BEST_SPEED ) != Z_OK ) {
+        stream_.reset();
+        throw std::runtime_error( "Zlib compression error" );
+    }
+    const auto head = std::string_view( pbase(), pptr() - pbase() );
+    const auto dictionary = choose_dictionary_ ? choose_dictionary_( head ) : std::string_view{};
+    if( !dictionary.empty() ) {
+        if( deflateSetDictionary( stream_.get(), reinterpret_cast<const Bytef *>( dictionary.data() ),
+                                  dictionary.size() ) != Z_OK ) {
+            throw std::runtime_error( "Zlib compression error" );
+        }
+        used_dictionary_ = true;
+    }
+}
+
+auto zlib_ostreambuf::deflate_buffer( const int flush ) -> void
+{
+    if( !stream_ ) {
+        start();
+    }
+    stream_->next_in = reinterpret_cast<Bytef *>( pbase() );
+    stream_->avail_in = pptr() - pbase();
+    int result;
+    do {
+        // Grow by at least the staging size so each round makes progress.
+        const auto used = output_.size();
+        output_.resize( used + std::max<std::size_t>( deflateBound( stream_.get(), stream_->avail_in ),
+                        staging_size ) );
+        stream_->next_out = reinterpret_cast<Bytef *>( output_.data() + used );
+        stream_->avail_out = output_.size() - used;
+        result = deflate( stream_.get(), flush );
+        output_.resize( output_.size() - stream_->avail_out );
+        if( result == Z_STREAM_ERROR ) {
+            throw std::runtime_error( "Zlib compression error" );
+        }
+    } while( stream_->avail_in > 0 || ( flush == Z_FINISH && result != Z_STREAM_END ) );
+    setp( pbase(), epptr() );
+}
+
+auto zlib_ostreambuf::overflow( const int_type ch ) -> int_type
+{
+    if( finished_ ) {
+        return traits_type::eof();
+    }
+    try {
+        deflate_buffer( Z_NO_FLUSH );
+    } catch( const std::runtime_error & ) {
+        return traits_type::eof();
+    }
+    if( !traits_type::eq_int_type( ch, traits_type::eof() ) ) {
+        *pptr() = traits_type::to_char_type( ch );
+        pbump( 1 );
+    }
+    return traits_type::not_eof( ch );
+}
+
+auto zlib_ostreambuf::finish() -> void
+{
+    if( finished_ ) {
+        return;
+    }
+    deflate_buffer( Z_FINISH );
+    finished_ = true;
+}
+
+memory_istreambuf::memory_istreambuf( const std::string_view data ) : data_( data )
+{
+    // streambuf wants mutable pointers, but nothing here writes through them.
+    auto *begin = const_cast<char *>( data_.data() );
+    setg( begin, begin, begin + data_.size() );
+}
+
+auto memory_istreambuf::seekoff( const off_type off, const std::ios_base::seekdir dir,
+                                 const std::ios_base::openmode which ) -> pos_type
+{
+    if( !( which & std::ios_base::in ) ) {
+        return pos_type( off_type( -1 ) );
+    }
+    const auto base = dir == std::ios_base::beg ? off_type{ 0 }
+                      : dir == std::ios_base::cur ? off_type( gptr() - eback() )
+                      : off_type( data_.size() );
+    const auto target = base + off;
+    if( target < 0 || target > static_cast<off_type>( data_.size() ) ) {
+        return pos_type( off_type( -1 ) );
+    }
+    setg( eback(), eback() + target, egptr() );
+    return pos_type( target );
+}
+
+auto memory_istreambuf::seekpos( const pos_type pos, const std::ios_base::openmode which ) -> pos_type
+{
+    return seekoff( off_type( pos ), std::ios_base::beg, which );
+}
@@ -1,10 +1,101 @@
 #pragma once
 
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <streambuf>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "contiguous_streambuf.h"
 #include "fstream_utils.h"
 
+struct z_stream_s;
+
 void zlib_compress( const std::string &input, std::vector<std::byte> &output );
 void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output );
+/** zlib_compress() with a preset dictionary.  The same dictionary is needed to decompress. */
+void zlib_compress( const std::string &input, std::vector<std::byte> &output,
+                    std::string_view dictionary );
+void zlib_decompress( const void *compressed_data, int compressed_size, std::string &output,
+                      std::string_view dictionary );
+
+/**
+ * Buffer borrowed from a per-thread pool and handed back on destruction, so
+ * repeated saves and loads on one thread reuse the same allocation.
+ */
+class scratch_buffer
+{
+    public:
+        scratch_buffer();
+        ~scratch_buffer();
+        scratch_buffer( const scratch_buffer & ) = delete;
+        auto operator=( const scratch_buffer & ) -> scratch_buffer & = delete;
+
+        /// Empty on acquisition; capacity is kept from earlier users.
+        auto get() -> std::string & { // *NOPAD*
+            return *buffer_;
+        }
+
+    private:
+        std::unique_ptr<std::string> buffer_;
+};
+
+/**
+ * Output streambuf that deflates everything written to it into @p output, so
+ * serializers can write straight into the compressed payload.
+ *
+ * The first chunk is held back until it fills up or finish() is called;
+ * @p choose_dictionary sees it and returns the preset dictionary to use, or
+ * an empty view for none.  This lets callers pick a dictionary by format.
+ */
+class zlib_ostreambuf : public std::streambuf
+{
+    public:
+        using dictionary_fn = std::function<std::string_view( std::string_view head )>;
+
+        explicit zlib_ostreambuf( std::vector<std::byte> &output,
+                                  dictionary_fn choose_dictionary = nullptr );
+        ~zlib_ostreambuf() override;
+
+        /// Flush the remaining input and end the stream.  Throws on zlib errors.
+        auto finish() -> void;
+        /// Whether the first chunk was compressed with a dictionary.
+        auto used_dictionary() const -> bool {
+            return used_dictionary_;
+        }
+
+    protected:
+        auto overflow( int_type ch ) -> int_type override;
+
+    private:
+        auto start() -> void;
+        auto deflate_buffer( int flush ) -> void;
+
+        std::vector<std::byte> &output_;
+        dictionary_fn choose_dictionary_;
+        scratch_buffer staging_;
+        std::unique_ptr<z_stream_s> stream_;
+        bool used_dictionary_ = false;
+        bool finished_ = false;
+};
+
+/** Seekable read-only view of a buffer, for JsonIn without copying into a stringstream. */
+class memory_istreambuf : public contiguous_streambuf
+{
+    public:
+        explicit memory_istreambuf( std::string_view data );
+
+        auto view() const -> std::string_view {
+            return data_;
+        }
 
+    protected:
+        auto seekoff( off_type off, std::ios_base::seekdir dir,
+                      std::ios_base::openmode which ) -> pos_type override;
+        auto seekpos( pos_type pos, std::ios_base::openmode which ) -> pos_type override;
 
+    private:
+        std::string_view data_;
+};
@@ -9,15 +9,16 @@
 #    include "field.h"
 #    include "game.h"
 #    include "game_constants.h"
+#    include "gpu_pipeline_cache.h"
 #    include "gpu_platform.h"
 #    include "item.h"
 #    include "itype.h"
+#    include "light_clusters.h"
 #    include "lightmap.h"
 #    include "map.h"
 #    include "math_defines.h"
 #    include "monster.h"
 #    include "npc.h"
-#    include "path_info.h"
 #    include "profile.h"
 #    include "shadowcasting.h"
 #    include "submap.h"
@@ -33,9 +34,9 @@
 #    include <algorithm>
 #    include <array>
 #    include <bit>
+#    include <chrono>
 #    include <cmath>
 #    include <cstring>
-#    include <fstream>
 #    include <iterator>
 #    include <limits>
 #    include <numeric>
@@ -61,30 +62,6 @@ static constexpr auto light_source_vehicle_external_z_frac = 0.8f;
 // Pipeline management
 // ---------------------------------------------------------------------------
 
-auto read_blob(std::string const& path) -> std::vector<std::byte> {
-    auto ifs = std::ifstream(path, std::ios::binary | std::ios::ate);
-    if (!ifs) { return {}; }
-    auto const size = static_cast<std::size_t>(ifs.tellg());
-    ifs.seekg(0);
-    std::vector<std::byte> buf(size);
-    ifs.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(size));
-    return buf;
-}
-
-auto preferred_ext(SDL_GPUShaderFormat const fmts) -> std::string_view {
-    if (fmts & SDL_GPU_SHADERFORMAT_DXIL) { return ".dxil"; }
-    if (fmts & SDL_GPU_SHADERFORMAT_SPIRV) { return ".spv"; }
-    if (fmts & SDL_GPU_SHADERFORMAT_MSL) { return ".msl"; }
-    return {};
-}
-
-auto preferred_fmt(SDL_GPUShaderFormat const fmts) -> SDL_GPUShaderFormat {
-    if (fmts & SDL_GPU_SHADERFORMAT_DXIL) { return SDL_GPU_SHADERFORMAT_DXIL; }
-    if (fmts & SDL_GPU_SHADERFORMAT_SPIRV) { return SDL_GPU_SHADERFORMAT_SPIRV; }
-    if (fmts & SDL_GPU_SHADERFORMAT_MSL) { return SDL_GPU_SHADERFORMAT_MSL; }
-    return SDL_GPU_SHADERFORMAT_INVALID;
-}
-
 SDL_GPUComputePipeline* s_ambient_pipeline = nullptr;
 SDL_GPUComputePipeline* s_daylight_diffuse_pipeline = nullptr;
 SDL_GPUComputePipeline* s_raytrace_pipeline = nullptr;
@@ -147,47 +124,16 @@ auto ensure_pipeline_device(SDL_GPUDevice* const device) -> bool {
 auto load_pipeline(
     SDL_GPUDevice* const device, std::string_view const name, int const ro_bufs, int const rw_bufs,
     int const threadcount_x, int const threadcount_y) -> SDL_GPUComputePipeline* {
-    auto const fmts = SDL_GetGPUShaderFormats(device);
-    auto const fmt = preferred_fmt(fmts);
-    auto const ext = preferred_ext(fmts);
-
-    if (fmt == SDL_GPU_SHADERFORMAT_INVALID || ext.empty()) {
-        DebugLog(DL::Error, DC::Main) << "SDL_GPU: lm: no supported shader format for " << name;
-        return nullptr;
-    }
-
-    auto const path = PATH_INFO::shaders() + std::string{name} + std::string{ext};
-    auto const blob = read_blob(path);
-    if (blob.empty()) {
-        DebugLog(DL::Error, DC::Main)
-            << "SDL_GPU: lm: shader blob not found: " << path
-            << " (run a build with shadercross to compile shaders)";
-        return nullptr;
-    }
-
-    SDL_GPUComputePipelineCreateInfo const info{
-        .code_size = blob.size(),
-        .code = reinterpret_cast<Uint8 const*>(blob.data()),
-        .entrypoint = compute_shader_entrypoint(fmt),
-        .format = fmt,
-        .num_samplers = 0,
-        .num_readonly_storage_textures = 0,
-        .num_readonly_storage_buffers = static_cast<Uint32>(ro_bufs),
-        .num_readwrite_storage_textures = 0,
-        .num_readwrite_storage_buffers = static_cast<Uint32>(rw_bufs),
-        .num_uniform_buffers = 1,
-        .threadcount_x = static_cast<Uint32>(threadcount_x),
-        .threadcount_y = static_cast<Uint32>(threadcount_y),
-        .threadcount_z = 1,
-        .props = 0,
-    };
-
-    auto* const pipeline = SDL_CreateGPUComputePipeline(device, &info);
-    if (pipeline == nullptr) {
-        DebugLog(DL::Error, DC::Main)
-            << "SDL_GPU: lm: pipeline creation failed for " << name << ": " << SDL_GetError();
-    }
-    return pipeline;
+    return create_compute_pipeline(
+        device, name,
+        {
+            .readonly_buffers = ro_bufs,
+            .readwrite_buffers = rw_bufs,
+            .uniform_buffers = 1,
+            .threads_x = threadcount_x,
+            .threads_y = threadcount_y,
+        },
+        "lm");
 }
 
 auto ensure_seen_pipelines(SDL_GPUDevice* const device) -> bool {
@@ -611,6 +557,19 @@ struct pending_gpu_lighting_work {
 
 auto s_pending_lighting_work = pending_gpu_lighting_work{};
 auto s_next_lighting_work_id = uint64_t{1};
+auto s_lighting_timings = gpu_lighting_timings{};
+
+// Adds the lifetime of the enclosing scope to a gpu_lighting_timings field.
+struct phase_timer {
+    double& total_ms;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ~phase_timer() {
+        total_ms += std::chrono::duration<double, std::milli>(
+                        std::chrono::steady_clock::now() - start)
+                        .count();
+    }
+};
 
 struct pending_gpu_visibility_work {
     bool active = false;
@@ -1588,10 +1547,6 @@ auto add_active_item_sources(source_accumulator& acc) -> void {
     }
 }
 
-auto vehicle_light_flags(vpart_reference const& part) -> uint32_t {
-    return vehicle_lighting::is_external(part) ? light_source_external_vehicle : uint32_t{0};
-}
-
 auto vehicle_light_color(vpart_reference const& part) -> std::optional<uint32_t> {
     if (part.info().light_color && color_is_set(*part.info().light_color)) {
         return pack_rgb(*part.info().light_color);
@@ -1617,6 +1572,7 @@ auto append_vehicle_source(
 auto add_vehicle_sources(source_accumulator& acc) -> void {
     ZoneScopedN("gpu_lm_collect_vehicle_sources");
     auto const odd_turn = calendar::once_every(2_turns);
+    auto emitters = std::vector<light_clusters::emitter>{};
     for (auto const& wrapped : const_cast<map&>(acc.m).get_vehicles()) {
         auto* const veh = wrapped.v;
         if (veh == nullptr) { continue; }
@@ -1638,17 +1594,34 @@ auto add_vehicle_sources(source_accumulator& acc) -> void {
             auto const pos = part.pos();
             if (!acc.m.inbounds(pos)) { continue; }
 
-            auto const flags = vehicle_light_flags(part);
+            auto const scope = vehicle_lighting::is_external(part) ? veh : nullptr;
             auto const color_rgb =
-                acc.collect_colored_sources ? vehicle_light_color(part) : std::optional<uint32_t>{};
+                acc.collect_colored_sources ? vehicle_light_color(part).value_or(0u) : 0u;
+            auto const add_arc = [&](float const luminance, units::angle const direction,
+                                     units::angle const width) {
+                emitters.push_back({
+                    .p = pos,
+                    .shape = light_clusters::emitter_shape::arc,
+                    .direction = direction,
+                    .width = width,
+                    .luminance = luminance,
+                    .color_rgb = color_rgb,
+                    .scope = scope,
+                });
+            };
+            auto const add_point = [&](float const luminance) {
+                emitters.push_back({
+                    .p = pos,
+                    .shape = light_clusters::emitter_shape::point,
+                    .luminance = luminance,
+                    .color_rgb = color_rgb,
+                    .scope = scope,
+                });
+            };
             if (info.has_flag(VPFLAG_CONE_LIGHT) || info.has_flag(VPFLAG_WIDE_CONE_LIGHT)) {
                 if (vehicle_luminance > lit_level::LIT) {
-                    append_vehicle_source(
-                        acc,
-                        make_directional_source(
-                            pos, vehicle_luminance, veh->face.dir() + vehicle_part.direction,
-                            vehicle_lighting::arc_width(info), flags),
-                        color_rgb);
+                    add_arc(vehicle_luminance, veh->face.dir() + vehicle_part.direction,
+                            vehicle_lighting::arc_width(info));
                 }
             } else if (info.rotating_light) {
                 auto const& rotating_light = *info.rotating_light;
@@ -1657,34 +1630,18 @@ auto add_vehicle_sources(source_accumulator& acc) -> void {
                 for (auto const beam_index : std::views::iota(0, rotating_light.beam_count())) {
                     auto const beam_direction =
                         direction + rotating_light.beam_spacing() * static_cast<double>(beam_index);
-                    append_vehicle_source(
-                        acc,
-                        make_directional_source(
-                            pos, static_cast<float>(info.bonus), beam_direction,
-                            rotating_light.arc_width(), flags),
-                        color_rgb);
+                    add_arc(static_cast<float>(info.bonus), beam_direction,
+                            rotating_light.arc_width());
                 }
             } else if (info.has_flag(VPFLAG_HALF_CIRCLE_LIGHT)) {
-                append_vehicle_source(
-                    acc,
-                    make_directional_source(
-                        pos, static_cast<float>(info.bonus),
-                        veh->face.dir() + vehicle_part.direction, vehicle_lighting::arc_width(info),
-                        flags),
-                    color_rgb);
+                add_arc(static_cast<float>(info.bonus), veh->face.dir() + vehicle_part.direction,
+                        vehicle_lighting::arc_width(info));
             } else if (info.has_flag(VPFLAG_CIRCLE_LIGHT)) {
                 if (vehicle_lighting::circle_light_is_active(info, odd_turn)) {
-                    append_vehicle_source(
-                        acc,
-                        make_source(pos.x(), pos.y(), pos.z(), static_cast<float>(info.bonus),
-                                    flags),
-                        color_rgb);
+                    add_point(static_cast<float>(info.bonus));
                 }
             } else {
-                append_vehicle_source(
-                    acc,
-                    make_source(pos.x(), pos.y(), pos.z(), static_cast<float>(info.bonus), flags),
-                    color_rgb);
+                add_point(static_cast<float>(info.bonus));
             }
         }
 
@@ -1711,6 +1668,30 @@ auto add_vehicle_sources(source_accumulator& acc) -> void {
             }
         }
     }
+
+    auto const options = light_clusters::options{
+        .viewer = get_player_character().bub_pos(),
+        .lod_distance = light_cluster_distance,
+    };
+    auto const clusters = light_clusters::cluster_emitters(std::move(emitters), options);
+    auto const& m = acc.m;
+    for (auto const z : std::views::iota(-OVERMAP_DEPTH, OVERMAP_HEIGHT + 1)) {
+        const_cast<level_cache&>(m.get_cache_ref(z)).vehicle_light_clusters.clear();
+    }
+    for (auto const& c : clusters) {
+        auto const& light = c.light;
+        auto const flags = light.scope != nullptr ? light_source_external_vehicle : uint32_t{0};
+        auto const color_rgb =
+            light.color_rgb != 0u ? std::optional<uint32_t>{light.color_rgb} : std::nullopt;
+        append_vehicle_source(
+            acc,
+            light.shape == light_clusters::emitter_shape::arc
+                ? make_directional_source(light.p, light.luminance, light.direction, light.width,
+                                          flags)
+                : make_source(light.p.x(), light.p.y(), light.p.z(), light.luminance, flags),
+            color_rgb);
+        const_cast<level_cache&>(m.get_cache_ref(light.p.z())).vehicle_light_clusters.push_back(c);
+    }
 }
 
 auto add_character_sources(source_accumulator& acc) -> void {
@@ -2674,23 +2655,35 @@ auto shift_lighting_resident_inputs(shift_lighting_residency_params const& p) ->
         }
     }
 
-    auto* const fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
-    if (fence == nullptr) {
-        DebugLog(DL::Error, DC::Main)
-            << "SDL_GPU: lm: shift command buffer submission failed: " << SDL_GetError();
-        invalidate_shift_inputs();
-        return false;
-    }
-    auto wait_succeeded = true;
-    {
-        ZoneScopedN("gpu_lm_shift_fence_wait");
-        wait_succeeded = SDL_WaitForGPUFences(p.device, true, &fence, 1);
-    }
-    SDL_ReleaseGPUFence(p.device, fence);
-    if (!wait_succeeded) {
-        DebugLog(DL::Error, DC::Main) << "SDL_GPU: lm: shift fence wait failed: " << SDL_GetError();
-        invalidate_shift_inputs();
-        return false;
+    if (pipeline_gpu_lighting) {
+        // Later lighting passes are submitted after this buffer on the same device, so
+        // they already see the shifted inputs; only the handles below are swapped now.
+        if (!SDL_SubmitGPUCommandBuffer(cmd)) {
+            DebugLog(DL::Error, DC::Main)
+                << "SDL_GPU: lm: shift command buffer submission failed: " << SDL_GetError();
+            invalidate_shift_inputs();
+            return false;
+        }
+    } else {
+        auto* const fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+        if (fence == nullptr) {
+            DebugLog(DL::Error, DC::Main)
+                << "SDL_GPU: lm: shift command buffer submission failed: " << SDL_GetError();
+            invalidate_shift_inputs();
+            return false;
+        }
+        auto wait_succeeded = true;
+        {
+            ZoneScopedN("gpu_lm_shift_fence_wait");
+            wait_succeeded = SDL_WaitForGPUFences(p.device, true, &fence, 1);
+        }
+        SDL_ReleaseGPUFence(p.device, fence);
+        if (!wait_succeeded) {
+            DebugLog(DL::Error, DC::Main)
+                << "SDL_GPU: lm: shift fence wait failed: " << SDL_GetError();
+            invalidate_shift_inputs();
+            return false;
+        }
     }
 
     if (shift_transparency) {
@@ -2762,6 +2755,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
     }
     ensure_resource_device(device);
     if (!ensure_pipelines(device)) { return {}; }
+    s_lighting_timings = {};
 
     auto lightmap_levels = sorted_unique(*p.dirty_levels);
     if (lightmap_levels.empty() && !p.rebuild_seen_cache && !p.download_seen_cache
@@ -2790,6 +2784,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
     auto const collect_colored_sources = colored_lighting && !source_collection_levels.empty();
     if (!source_collection_levels.empty()) {
         ZoneScopedN("gpu_lm_collect_sources");
+        auto const timer = phase_timer{s_lighting_timings.collect_sources_ms};
         auto collection = collect_sources(*p.m, source_collection_levels, collect_colored_sources);
         source_stats = collection.stats;
         all_sources = std::move(collection.sources);
@@ -2832,6 +2827,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
 
     if (has_structural_upload(input_uploads)) {
         ZoneScopedN("gpu_lm_pack_inputs");
+        auto const timer = phase_timer{s_lighting_timings.pack_inputs_ms};
         if (!input_uploads.transparency_levels.empty()) {
             pack_float_cache(
                 *p.m, input_uploads.transparency_levels, cache_xy,
@@ -2861,6 +2857,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
     }
     {
         ZoneScopedN("gpu_lm_pack_source_map");
+        auto const timer = phase_timer{s_lighting_timings.pack_inputs_ms};
         pack_float_cache(
             *p.m, source_map_upload_levels, cache_xy,
             [](level_cache const& lc) -> std::vector<float> const& { return lc.sm; },
@@ -2911,6 +2908,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
     if (!lightmap_levels.empty() && s_lighting_resources.static_lighting_valid
         && !structural_upload_levels.empty()) {
         ZoneScopedN("gpu_lm_structural_signature");
+        auto const timer = phase_timer{s_lighting_timings.pack_inputs_ms};
         checked_structural_signatures.reserve(structural_upload_levels.size());
         for (auto const z : structural_upload_levels) {
             auto const signature = structural_level_signature(*p.m, z, cache_x, cache_y);
@@ -3163,6 +3161,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
     // ── Upload: single transfer buffer covering all inputs ───────────────────
     if (upload_total > 0) {
         ZoneScopedN("gpu_lm_stage_upload");
+        auto const timer = phase_timer{s_lighting_timings.stage_upload_ms};
         auto* const mapped = static_cast<std::byte*>(
             SDL_MapGPUTransferBuffer(device, upload_tbuf, false));
         if (mapped == nullptr) {
@@ -3212,6 +3211,7 @@ auto begin_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params con
 
     {
         ZoneScopedN("gpu_lm_record_commands");
+        auto const timer = phase_timer{s_lighting_timings.record_commands_ms};
 
         // [Pass 1] Copy: upload all input buffers.
         if (upload_total > 0) {
@@ -3658,6 +3658,7 @@ auto finish_gpu_lighting(SDL_GPUDevice* const device, gpu_lighting_work const& w
     if (pending.fence != nullptr) {
         auto wait_succeeded = true;
         ZoneScopedN("gpu_lm_fence_wait");
+        auto const timer = phase_timer{s_lighting_timings.fence_wait_ms};
         wait_succeeded = SDL_WaitForGPUFences(device, true, &pending.fence, 1);
         SDL_ReleaseGPUFence(device, pending.fence);
         pending.fence = nullptr;
@@ -3675,6 +3676,7 @@ auto finish_gpu_lighting(SDL_GPUDevice* const device, gpu_lighting_work const& w
     // ── Download results to CPU level_cache ──────────────────────────────────
     {
         ZoneScopedN("gpu_lm_unpack_download");
+        auto const timer = phase_timer{s_lighting_timings.readback_ms};
         // lm_all stores uint (bit-reinterpretation of positive floats).
         // Copying uint bytes directly into float storage is valid since the
         // bit pattern is preserved.
@@ -3800,6 +3802,8 @@ auto run_gpu_lighting(SDL_GPUDevice* const device, run_gpu_lighting_params const
     return finish_gpu_lighting(device, work);
 }
 
+auto last_gpu_lighting_timings() -> gpu_lighting_timings { return s_lighting_timings; }
+
 auto begin_gpu_visibility(SDL_GPUDevice* const device, run_gpu_visibility_params const& p)
     -> gpu_visibility_work {
     ZoneScopedN("begin_gpu_visibility");
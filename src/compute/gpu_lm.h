@@ -261,6 +261,20 @@ auto finish_gpu_lighting(SDL_GPUDevice* device, gpu_lighting_work const& work) -
 // data before returning.
 auto run_gpu_lighting(SDL_GPUDevice* device, run_gpu_lighting_params const& p) -> bool;
 
+// Wall-clock milliseconds the last lighting pass spent in each phase, from its
+// begin to its finish.  SDL_GPU has no timestamp queries, so the kernels are
+// measured together as the fence wait.
+struct gpu_lighting_timings {
+    double collect_sources_ms = 0.0;
+    double pack_inputs_ms = 0.0;
+    double stage_upload_ms = 0.0;
+    double record_commands_ms = 0.0;
+    double fence_wait_ms = 0.0;
+    double readback_ms = 0.0;
+};
+
+auto last_gpu_lighting_timings() -> gpu_lighting_timings;
+
 // ---------------------------------------------------------------------------
 // run_gpu_visibility_params
 // Input to the final visibility classification compute pass.
@@ -0,0 +1,298 @@
+#if defined(CATA_SDL)
+#    include "gpu_pipeline_cache.h"
+
+#    include "debug.h"
+#    include "gpu_platform.h"
+#    include "path_info.h"
+#    include "profile.h"
+
+#    include <SDL3/SDL_gpu.h>
+#    include <algorithm>
+#    include <chrono>
+#    include <condition_variable>
+#    include <cstddef>
+#    include <cstdint>
+#    include <filesystem>
+#    include <fstream>
+#    include <mutex>
+#    include <optional>
+#    include <sstream>
+#    include <string>
+#    include <string_view>
+#    include <thread>
+#    include <utility>
+#    include <vector>
+
+namespace cata_gpu {
+
+namespace {
+
+constexpr auto manifest_magic = std::string_view{"cata-gpu-pipelines 1"};
+
+struct shader_blob {
+    SDL_GPUShaderFormat format = SDL_GPU_SHADERFORMAT_INVALID;
+    std::vector<std::byte> code;
+    uint64_t hash = 0;
+};
+
+struct manifest_entry {
+    std::string name;
+    uint64_t hash = 0;
+    compute_layout layout;
+};
+
+enum class warm_state { queued, building, ready };
+
+struct warm_pipeline {
+    manifest_entry entry;
+    warm_state state = warm_state::queued;
+    SDL_GPUComputePipeline* pipeline = nullptr;
+};
+
+struct pipeline_cache {
+    std::mutex mutex;
+    std::condition_variable built;
+    SDL_GPUDevice* device = nullptr;
+    std::string device_key;
+    // Pipelines of the manifest, until someone claims them.
+    std::vector<warm_pipeline> warm;
+    // Everything created on the device this session, for the next manifest.
+    std::vector<manifest_entry> created;
+    std::thread worker;
+};
+
+pipeline_cache s_cache;
+
+auto select_format(SDL_GPUShaderFormat const fmts)
+    -> std::pair<SDL_GPUShaderFormat, std::string_view> {
+    if (fmts & SDL_GPU_SHADERFORMAT_DXIL) { return {SDL_GPU_SHADERFORMAT_DXIL, ".dxil"}; }
+    if (fmts & SDL_GPU_SHADERFORMAT_SPIRV) { return {SDL_GPU_SHADERFORMAT_SPIRV, ".spv"}; }
+    if (fmts & SDL_GPU_SHADERFORMAT_MSL) { return {SDL_GPU_SHADERFORMAT_MSL, ".msl"}; }
+    return {SDL_GPU_SHADERFORMAT_INVALID, ""};
+}
+
+auto hash_blob(std::vector<std::byte> const& code) -> uint64_t {
+    auto hash = uint64_t{0xcbf29ce484222325ULL};
+    for (auto const b : code) { hash = (hash ^ static_cast<uint8_t>(b)) * 0x100000001b3ULL; }
+    return hash;
+}
+
+auto read_blob(SDL_GPUDevice* const device, std::string_view const name)
+    -> std::optional<shader_blob> {
+    auto const [fmt, ext] = select_format(SDL_GetGPUShaderFormats(device));
+    if (fmt == SDL_GPU_SHADERFORMAT_INVALID) { return std::nullopt; }
+
+    auto const path = PATH_INFO::shaders() + std::string{name} + std::string{ext};
+    auto ifs = std::ifstream(path, std::ios::binary | std::ios::ate);
+    if (!ifs) { return std::nullopt; }
+    auto const size = static_cast<std::size_t>(ifs.tellg());
+    ifs.seekg(0);
+    auto code = std::vector<std::byte>(size);
+    ifs.read(reinterpret_cast<char*>(code.data()), static_cast<std::streamsize>(size));
+    if (code.empty()) { return std::nullopt; }
+    auto const hash = hash_blob(code);
+    return shader_blob{.format = fmt, .code = std::move(code), .hash = hash};
+}
+
+auto build_pipeline(
+    SDL_GPUDevice* const device, shader_blob const& blob, compute_layout const& layout)
+    -> SDL_GPUComputePipeline* {
+    SDL_GPUComputePipelineCreateInfo const info{
+        .code_size = blob.code.size(),
+        .code = reinterpret_cast<Uint8 const*>(blob.code.data()),
+        .entrypoint = compute_shader_entrypoint(blob.format),
+        .format = blob.format,
+        .num_samplers = 0,
+        .num_readonly_storage_textures = 0,
+        .num_readonly_storage_buffers = static_cast<Uint32>(layout.readonly_buffers),
+        .num_readwrite_storage_textures = 0,
+        .num_readwrite_storage_buffers = static_cast<Uint32>(layout.readwrite_buffers),
+        .num_uniform_buffers = static_cast<Uint32>(layout.uniform_buffers),
+        .threadcount_x = static_cast<Uint32>(layout.threads_x),
+        .threadcount_y = static_cast<Uint32>(layout.threads_y),
+        .threadcount_z = 1,
+        .props = 0,
+    };
+    return SDL_CreateGPUComputePipeline(device, &info);
+}
+
+auto manifest_path() -> std::string { return PATH_INFO::gpu_cachedir() + "pipelines.txt"; }
+
+auto read_manifest(std::string const& device_key) -> std::vector<manifest_entry> {
+    auto in = std::ifstream(manifest_path());
+    auto line = std::string{};
+    if (!std::getline(in, line) || line != manifest_magic) { return {}; }
+    if (!std::getline(in, line) || line != device_key) { return {}; }
+
+    auto entries = std::vector<manifest_entry>{};
+    while (std::getline(in, line)) {
+        auto fields = std::istringstream(line);
+        auto e = manifest_entry{};
+        fields >> e.name >> std::hex >> e.hash >> std::dec >> e.layout.readonly_buffers
+            >> e.layout.readwrite_buffers >> e.layout.uniform_buffers >> e.layout.threads_x
+            >> e.layout.threads_y;
+        if (fields && !e.name.empty()) { entries.push_back(std::move(e)); }
+    }
+    return entries;
+}
+
+auto write_manifest(std::string const& device_key, std::vector<manifest_entry> const& entries)
+    -> void {
+    auto const path = std::filesystem::path{manifest_path()};
+    auto ec = std::error_code{};
+    std::filesystem::create_directories(path.parent_path(), ec);
+    auto tmp_path = path;
+    tmp_path += ".tmp";
+    {
+        auto out = std::ofstream(tmp_path, std::ios::trunc);
+        out << manifest_magic << '\n' << device_key << '\n';
+        for (auto const& e : entries) {
+            out << e.name << ' ' << std::hex << e.hash << std::dec << ' '
+                << e.layout.readonly_buffers << ' ' << e.layout.readwrite_buffers << ' '
+                << e.layout.uniform_buffers << ' ' << e.layout.threads_x << ' '
+                << e.layout.threads_y << '\n';
+        }
+        if (!out) {
+            DebugLog(DL::Warn, DC::Main)
+                << "SDL_GPU: failed to write pipeline manifest " << tmp_path.string();
+            std::filesystem::remove(tmp_path, ec);
+            return;
+        }
+    }
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) { std::filesystem::remove(tmp_path, ec); }
+}
+
+// Callers hold s_cache.mutex.
+auto find_warm(std::string_view const name, compute_layout const& layout)
+    -> std::vector<warm_pipeline>::iterator {
+    return std::ranges::find_if(s_cache.warm, [&](warm_pipeline const& w) {
+        return w.entry.name == name && w.entry.layout == layout;
+    });
+}
+
+auto record_created(manifest_entry entry) -> void {
+    auto const known = std::ranges::any_of(s_cache.created, [&](manifest_entry const& e) {
+        return e.name == entry.name && e.layout == entry.layout;
+    });
+    if (!known) { s_cache.created.push_back(std::move(entry)); }
+}
+
+auto warm_up_worker() -> void {
+    ZoneScopedN("gpu_pipeline_warm_up");
+    auto const start = std::chrono::steady_clock::now();
+    auto count = 0;
+    while (true) {
+        auto entry = manifest_entry{};
+        {
+            auto const lock = std::lock_guard(s_cache.mutex);
+            auto const it = std::ranges::find(s_cache.warm, warm_state::queued, &warm_pipeline::state);
+            if (it == s_cache.warm.end()) { break; }
+            it->state = warm_state::building;
+            entry = it->entry;
+        }
+
+        auto* pipeline = static_cast<SDL_GPUComputePipeline*>(nullptr);
+        auto const blob = read_blob(s_cache.device, entry.name);
+        // A rebuilt shader is left for its first use, which records the new hash.
+        if (blob && blob->hash == entry.hash) {
+            pipeline = build_pipeline(s_cache.device, *blob, entry.layout);
+            count += pipeline != nullptr ? 1 : 0;
+        }
+        {
+            auto const lock = std::lock_guard(s_cache.mutex);
+            auto const it = find_warm(entry.name, entry.layout);
+            it->state = warm_state::ready;
+            it->pipeline = pipeline;
+        }
+        s_cache.built.notify_all();
+    }
+    auto const elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+    DebugLog(DL::Info, DC::Main) << "SDL_GPU: warmed up " << count << " compute pipelines in "
+                                 << elapsed.count() << " ms";
+}
+
+} // namespace
+
+auto create_compute_pipeline(
+    SDL_GPUDevice* const device, std::string_view const name, compute_layout const& layout,
+    std::string_view const log_tag) -> SDL_GPUComputePipeline* {
+    {
+        auto lock = std::unique_lock(s_cache.mutex);
+        if (device == s_cache.device) {
+            s_cache.built.wait(lock, [&] {
+                auto const it = find_warm(name, layout);
+                return it == s_cache.warm.end() || it->state != warm_state::building;
+            });
+            auto const it = find_warm(name, layout);
+            if (it != s_cache.warm.end()) {
+                // Still queued, or failed: build it here, which logs why.
+                auto* const pipeline = it->pipeline;
+                auto entry = std::move(it->entry);
+                s_cache.warm.erase(it);
+                if (pipeline != nullptr) {
+                    record_created(std::move(entry));
+                    return pipeline;
+                }
+            }
+        }
+    }
+
+    auto const blob = read_blob(device, name);
+    if (!blob) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: " << log_tag << ": shader blob not found for " << name
+            << " in " << PATH_INFO::shaders() << " (run a build with shadercross to compile shaders)";
+        return nullptr;
+    }
+    auto* const pipeline = build_pipeline(device, *blob, layout);
+    if (pipeline == nullptr) {
+        DebugLog(DL::Error, DC::Main) << "SDL_GPU: " << log_tag << ": pipeline creation failed for "
+                                      << name << ": " << SDL_GetError();
+        return nullptr;
+    }
+
+    auto const lock = std::lock_guard(s_cache.mutex);
+    if (device == s_cache.device) {
+        record_created({.name = std::string{name}, .hash = blob->hash, .layout = layout});
+    }
+    return pipeline;
+}
+
+auto start_pipeline_warm_up(SDL_GPUDevice* const device, std::string device_key) -> void {
+    if (device == nullptr || s_cache.device != nullptr) { return; }
+    auto entries = read_manifest(device_key);
+    DebugLog(DL::Info, DC::Main) << "SDL_GPU: pipeline manifest lists " << entries.size()
+                                 << " pipelines for this device";
+
+    auto const lock = std::lock_guard(s_cache.mutex);
+    s_cache.device = device;
+    s_cache.device_key = std::move(device_key);
+    for (auto& e : entries) { s_cache.warm.push_back({.entry = std::move(e)}); }
+    // SDL_GPU creates resources from any thread; command buffers stay on the main thread.
+    if (!s_cache.warm.empty()) { s_cache.worker = std::thread(warm_up_worker); }
+}
+
+auto shutdown_pipeline_cache() -> void {
+    if (s_cache.worker.joinable()) { s_cache.worker.join(); }
+    auto const lock = std::lock_guard(s_cache.mutex);
+    if (s_cache.device == nullptr) { return; }
+
+    // Built but never used this session, still good for the next.
+    for (auto& w : s_cache.warm) {
+        if (w.pipeline == nullptr) { continue; }
+        SDL_ReleaseGPUComputePipeline(s_cache.device, w.pipeline);
+        record_created(std::move(w.entry));
+    }
+    write_manifest(s_cache.device_key, s_cache.created);
+
+    s_cache.warm.clear();
+    s_cache.created.clear();
+    s_cache.device_key.clear();
+    s_cache.device = nullptr;
+}
+
+} // namespace cata_gpu
+
+#endif // defined( CATA_SDL )
@@ -0,0 +1,42 @@
+#pragma once
+#if defined(CATA_SDL)
+
+#    include <string>
+#    include <string_view>
+
+struct SDL_GPUDevice;
+struct SDL_GPUComputePipeline;
+
+namespace cata_gpu {
+
+// Resource counts and workgroup size of a compute shader, as the pipeline is created with.
+struct compute_layout {
+    int readonly_buffers = 0;
+    int readwrite_buffers = 0;
+    int uniform_buffers = 1;
+    int threads_x = 1;
+    int threads_y = 1;
+
+    auto operator==(compute_layout const&) const -> bool = default;
+};
+
+// Creates the compute pipeline of shaders/<name> in the device's preferred format, or hands
+// over the one the warm-up already built.  The caller owns the pipeline and releases it.
+// Returns nullptr, after logging under log_tag, if the blob is missing or creation failed.
+auto create_compute_pipeline(
+    SDL_GPUDevice* device, std::string_view name, compute_layout const& layout,
+    std::string_view log_tag) -> SDL_GPUComputePipeline*;
+
+// Starts building, on a worker thread, the pipelines last session created on this device.
+// The manifest in PATH_INFO::gpu_cachedir() is keyed by device_key and every entry by the
+// hash of its shader blob, so a new driver or a rebuilt shader is simply built on first use.
+// Together with the driver's own pipeline cache this moves the compile off the first turn.
+auto start_pipeline_warm_up(SDL_GPUDevice* device, std::string device_key) -> void;
+
+// Waits for the warm-up, releases what nobody claimed and writes the manifest for next
+// session.  Called from cata_gpu::shutdown() before the device is destroyed.
+auto shutdown_pipeline_cache() -> void;
+
+} // namespace cata_gpu
+
+#endif // defined( CATA_SDL )
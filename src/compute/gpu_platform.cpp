@@ -4,6 +4,8 @@
 #    include "debug.h"
 #    include "filesystem.h"
 #    include "gpu_lm.h"
+#    include "gpu_pipeline_cache.h"
+#    include "gpu_scent.h"
 #    include "gpu_transparency.h"
 #    include "path_info.h"
 #    include "preload_config.h"
@@ -562,12 +564,23 @@ auto init() -> void {
     if (fmt != SDL_GPU_SHADERFORMAT_INVALID) { probe_shader(device, fmt, ext); }
 
     s_device = device;
+    // Overlaps building last session's pipelines with loading the game data.
+    auto device_key = join(
+        {driver != nullptr ? driver : "unknown", std::string{ext}, selected_device_info.name,
+         selected_device_info.driver_version, selected_device_info.driver_info},
+        "|");
+    // The manifest holds the key on one line.
+    std::ranges::replace(device_key, '\n', ' ');
+    std::ranges::replace(device_key, '\r', ' ');
+    start_pipeline_warm_up(device, std::move(device_key));
 }
 
 auto shutdown() -> void {
     if (s_device != nullptr) {
         shutdown_transparency();
+        shutdown_scent();
         shutdown_lm();
+        shutdown_pipeline_cache();
         SDL_DestroyGPUDevice(s_device);
         s_device = nullptr;
     }
@@ -0,0 +1,252 @@
+#if defined(CATA_SDL)
+#    include "gpu_scent.h"
+
+#    include "debug.h"
+#    include "gpu_pipeline_cache.h"
+#    include "gpu_platform.h"
+#    include "profile.h"
+
+#    include <SDL3/SDL_gpu.h>
+#    include <algorithm>
+#    include <array>
+#    include <cstddef>
+#    include <cstdint>
+#    include <cstring>
+#    include <string>
+#    include <string_view>
+#    include <vector>
+
+namespace cata_gpu {
+
+namespace {
+
+constexpr auto window_bytes = static_cast<Uint32>(
+    sizeof(int) * scent_diffusion::window_side * scent_diffusion::window_side);
+constexpr auto out_bytes = static_cast<Uint32>(
+    sizeof(int) * scent_diffusion::out_side * scent_diffusion::out_side);
+constexpr auto threadcount = 8;
+
+// Must match cbuffer Constants in scent_diffuse_compute.hlsl.
+struct scent_push_constants {
+    int32_t window_side = scent_diffusion::window_side;
+    int32_t out_side = scent_diffusion::out_side;
+    int32_t pad[2] = {};
+};
+static_assert(sizeof(scent_push_constants) == 16);
+
+struct scent_resources {
+    SDL_GPUDevice* device = nullptr;
+    SDL_GPUComputePipeline* pipeline = nullptr;
+    // scent, transfer, holes
+    std::array<SDL_GPUBuffer*, 3> inputs = {};
+    SDL_GPUBuffer* diffused = nullptr;
+    SDL_GPUTransferBuffer* upload = nullptr;
+    SDL_GPUTransferBuffer* download = nullptr;
+    // Set once creating anything failed on this device, so it is not retried every turn.
+    bool failed = false;
+};
+
+auto s_resources = scent_resources{};
+
+auto release_scent_resources() -> void {
+    auto* const device = s_resources.device;
+    if (device == nullptr) { return; }
+    if (s_resources.pipeline != nullptr) {
+        SDL_ReleaseGPUComputePipeline(device, s_resources.pipeline);
+    }
+    for (auto* const buffer : s_resources.inputs) {
+        if (buffer != nullptr) { SDL_ReleaseGPUBuffer(device, buffer); }
+    }
+    if (s_resources.diffused != nullptr) { SDL_ReleaseGPUBuffer(device, s_resources.diffused); }
+    if (s_resources.upload != nullptr) { SDL_ReleaseGPUTransferBuffer(device, s_resources.upload); }
+    if (s_resources.download != nullptr) {
+        SDL_ReleaseGPUTransferBuffer(device, s_resources.download);
+    }
+    s_resources = {};
+}
+
+auto create_pipeline(SDL_GPUDevice* const device) -> SDL_GPUComputePipeline* {
+    return create_compute_pipeline(
+        device, "scent_diffuse_compute",
+        {
+            .readonly_buffers = 3,  // scent, transfer, holes
+            .readwrite_buffers = 1, // diffused
+            .uniform_buffers = 1,
+            .threads_x = threadcount,
+            .threads_y = threadcount,
+        },
+        "scent");
+}
+
+auto create_buffer(SDL_GPUDevice* const device, SDL_GPUBufferUsageFlags const usage,
+                   Uint32 const bytes) -> SDL_GPUBuffer* {
+    auto const ci = SDL_GPUBufferCreateInfo{.usage = usage, .size = bytes, .props = 0};
+    auto* const buffer = SDL_CreateGPUBuffer(device, &ci);
+    if (buffer == nullptr) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: scent failed to allocate a buffer (" << bytes << " bytes): "
+            << SDL_GetError();
+    }
+    return buffer;
+}
+
+auto create_transfer_buffer(
+    SDL_GPUDevice* const device, SDL_GPUTransferBufferUsage const usage, Uint32 const bytes)
+    -> SDL_GPUTransferBuffer* {
+    auto const ci = SDL_GPUTransferBufferCreateInfo{.usage = usage, .size = bytes, .props = 0};
+    auto* const buffer = SDL_CreateGPUTransferBuffer(device, &ci);
+    if (buffer == nullptr) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: scent failed to allocate a transfer buffer (" << bytes << " bytes): "
+            << SDL_GetError();
+    }
+    return buffer;
+}
+
+auto ensure_resources(SDL_GPUDevice* const device) -> bool {
+    if (s_resources.device != device) {
+        if (s_resources.device != nullptr && !SDL_WaitForGPUIdle(s_resources.device)) {
+            DebugLog(DL::Warn, DC::Main)
+                << "SDL_GPU: scent: wait for idle during device switch failed: "
+                << SDL_GetError();
+        }
+        release_scent_resources();
+        s_resources.device = device;
+    }
+    if (s_resources.failed) { return false; }
+    if (s_resources.pipeline != nullptr) { return true; }
+
+    s_resources.pipeline = create_pipeline(device);
+    for (auto*& buffer : s_resources.inputs) {
+        buffer = create_buffer(device, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_READ, window_bytes);
+    }
+    s_resources.diffused =
+        create_buffer(device, SDL_GPU_BUFFERUSAGE_COMPUTE_STORAGE_WRITE, out_bytes);
+    s_resources.upload = create_transfer_buffer(
+        device, SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD,
+        window_bytes * static_cast<Uint32>(s_resources.inputs.size()));
+    s_resources.download =
+        create_transfer_buffer(device, SDL_GPU_TRANSFERBUFFERUSAGE_DOWNLOAD, out_bytes);
+
+    auto const complete = s_resources.pipeline != nullptr
+        && std::ranges::none_of(s_resources.inputs, [](auto* b) { return b == nullptr; })
+        && s_resources.diffused != nullptr && s_resources.upload != nullptr
+        && s_resources.download != nullptr;
+    if (!complete) {
+        release_scent_resources();
+        s_resources.device = device;
+        s_resources.failed = true;
+    }
+    return complete;
+}
+
+} // namespace
+
+auto shutdown_scent() -> void {
+    if (s_resources.device == nullptr) { return; }
+    if (!SDL_WaitForGPUIdle(s_resources.device)) {
+        DebugLog(DL::Warn, DC::Main)
+            << "SDL_GPU: scent: wait for idle during shutdown failed: " << SDL_GetError();
+    }
+    release_scent_resources();
+}
+
+auto dispatch_scent_diffusion(
+    SDL_GPUDevice* const device, scent_diffusion::window const& in, scent_diffusion::step& out)
+    -> bool {
+    ZoneScopedN("dispatch_scent_diffusion");
+    if (device == nullptr || !ensure_resources(device)) { return false; }
+
+    {
+        ZoneScopedN("gpu_scent_stage_upload");
+        auto* const mapped = static_cast<std::byte*>(
+            SDL_MapGPUTransferBuffer(device, s_resources.upload, true));
+        if (mapped == nullptr) {
+            DebugLog(DL::Error, DC::Main)
+                << "SDL_GPU: scent upload transfer map failed: " << SDL_GetError();
+            return false;
+        }
+        std::memcpy(mapped, in.scent.data(), window_bytes);
+        std::memcpy(mapped + window_bytes, in.transfer.data(), window_bytes);
+        std::memcpy(mapped + 2 * window_bytes, in.holes.data(), window_bytes);
+        SDL_UnmapGPUTransferBuffer(device, s_resources.upload);
+    }
+
+    auto* const cmd = SDL_AcquireGPUCommandBuffer(device);
+    if (cmd == nullptr) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: scent command buffer acquisition failed: " << SDL_GetError();
+        return false;
+    }
+
+    {
+        auto* const cp = SDL_BeginGPUCopyPass(cmd);
+        for (auto i = Uint32{0}; i < s_resources.inputs.size(); ++i) {
+            SDL_GPUTransferBufferLocation const src{
+                .transfer_buffer = s_resources.upload, .offset = i * window_bytes};
+            SDL_GPUBufferRegion const dst{
+                .buffer = s_resources.inputs[i], .offset = 0, .size = window_bytes};
+            SDL_UploadToGPUBuffer(cp, &src, &dst, true);
+        }
+        SDL_EndGPUCopyPass(cp);
+    }
+    {
+        auto const rw_binding = SDL_GPUStorageBufferReadWriteBinding{
+            .buffer = s_resources.diffused,
+            .cycle = true,
+            .padding1 = 0,
+            .padding2 = 0,
+            .padding3 = 0,
+        };
+        auto* const cp = SDL_BeginGPUComputePass(cmd, nullptr, 0, &rw_binding, 1);
+        SDL_BindGPUComputePipeline(cp, s_resources.pipeline);
+        SDL_BindGPUComputeStorageBuffers(
+            cp, 0, s_resources.inputs.data(), static_cast<Uint32>(s_resources.inputs.size()));
+        auto const push = scent_push_constants{};
+        SDL_PushGPUComputeUniformData(cmd, 0, &push, sizeof(push));
+        auto const groups =
+            static_cast<Uint32>((scent_diffusion::out_side + threadcount - 1) / threadcount);
+        SDL_DispatchGPUCompute(cp, groups, groups, 1);
+        SDL_EndGPUComputePass(cp);
+    }
+    {
+        auto* const cp = SDL_BeginGPUCopyPass(cmd);
+        SDL_GPUBufferRegion const src{
+            .buffer = s_resources.diffused, .offset = 0, .size = out_bytes};
+        SDL_GPUTransferBufferLocation const dst{
+            .transfer_buffer = s_resources.download, .offset = 0};
+        SDL_DownloadFromGPUBuffer(cp, &src, &dst);
+        SDL_EndGPUCopyPass(cp);
+    }
+
+    auto* const fence = SDL_SubmitGPUCommandBufferAndAcquireFence(cmd);
+    if (fence == nullptr) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: scent command buffer submission failed: " << SDL_GetError();
+        return false;
+    }
+    auto wait_succeeded = true;
+    {
+        ZoneScopedN("gpu_scent_fence_wait");
+        wait_succeeded = SDL_WaitForGPUFences(device, true, &fence, 1);
+    }
+    SDL_ReleaseGPUFence(device, fence);
+    if (!wait_succeeded) {
+        DebugLog(DL::Error, DC::Main) << "SDL_GPU: scent fence wait failed: " << SDL_GetError();
+        return false;
+    }
+
+    auto const* const mapped =
+        static_cast<int const*>(SDL_MapGPUTransferBuffer(device, s_resources.download, false));
+    if (mapped == nullptr) {
+        DebugLog(DL::Error, DC::Main)
+            << "SDL_GPU: scent download transfer map failed: " << SDL_GetError();
+        return false;
+    }
+    out.diffused.assign(mapped, mapped + out_bytes / sizeof(int));
+    SDL_UnmapGPUTransferBuffer(device, s_resources.download);
+    return true;
+}
+
+} // namespace cata_gpu
+#endif // defined( CATA_SDL )
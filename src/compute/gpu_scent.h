@@ -0,0 +1,22 @@
+#pragma once
+#if defined(CATA_SDL)
+
+#    include "scent_diffusion.h"
+
+struct SDL_GPUDevice;
+
+namespace cata_gpu {
+
+// Runs scent_diffusion::diffuse as the scent_diffuse_compute shader and downloads the
+// diffused square into out.diffused.  The pipeline and the buffers (all of a fixed size)
+// are created on first use and kept from turn to turn, so a turn costs one upload, one
+// dispatch and one download.  Returns false, with out untouched, if the GPU could not
+// run it; the caller then diffuses on the CPU.
+auto dispatch_scent_diffusion(
+    SDL_GPUDevice* device, scent_diffusion::window const& in, scent_diffusion::step& out) -> bool;
+
+// Release scent compute resources before the SDL GPU device is destroyed.
+auto shutdown_scent() -> void;
+
+} // namespace cata_gpu
+#endif // defined( CATA_SDL )
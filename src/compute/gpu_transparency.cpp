@@ -4,11 +4,11 @@
 #    include "coordinates.h"
 #    include "debug.h"
 #    include "field.h"
+#    include "gpu_pipeline_cache.h"
 #    include "gpu_platform.h"
 #    include "map.h"
 #    include "mapbuffer.h"
 #    include "mapdata.h"
-#    include "path_info.h"
 #    include "profile.h"
 #    include "submap.h"
 
@@ -17,7 +17,6 @@
 #    include <array>
 #    include <cmath>
 #    include <cstring>
-#    include <fstream>
 #    include <ranges>
 #    include <string>
 #    include <string_view>
@@ -27,30 +26,6 @@ namespace cata_gpu {
 
 namespace {
 
-auto read_blob(std::string const& path) -> std::vector<std::byte> {
-    auto ifs = std::ifstream(path, std::ios::binary | std::ios::ate);
-    if (!ifs) { return {}; }
-    auto const size = static_cast<std::size_t>(ifs.tellg());
-    ifs.seekg(0);
-    std::vector<std::byte> buf(size);
-    ifs.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(size));
-    return buf;
-}
-
-auto preferred_shader_format(SDL_GPUShaderFormat const fmts) -> SDL_GPUShaderFormat {
-    if (fmts & SDL_GPU_SHADERFORMAT_DXIL) { return SDL_GPU_SHADERFORMAT_DXIL; }
-    if (fmts & SDL_GPU_SHADERFORMAT_SPIRV) { return SDL_GPU_SHADERFORMAT_SPIRV; }
-    if (fmts & SDL_GPU_SHADERFORMAT_MSL) { return SDL_GPU_SHADERFORMAT_MSL; }
-    return SDL_GPU_SHADERFORMAT_INVALID;
-}
-
-auto preferred_shader_ext(SDL_GPUShaderFormat const fmts) -> std::string_view {
-    if (fmts & SDL_GPU_SHADERFORMAT_DXIL) { return ".dxil"; }
-    if (fmts & SDL_GPU_SHADERFORMAT_SPIRV) { return ".spv"; }
-    if (fmts & SDL_GPU_SHADERFORMAT_MSL) { return ".msl"; }
-    return {};
-}
-
 SDL_GPUComputePipeline* s_pipeline = nullptr;
 auto* s_pipeline_device = static_cast<SDL_GPUDevice*>(nullptr);
 
@@ -211,46 +186,16 @@ auto ensure_pipeline(SDL_GPUDevice* const device) -> SDL_GPUComputePipeline* {
     if (!ensure_pipeline_device(device)) { return nullptr; }
     if (s_pipeline != nullptr) { return s_pipeline; }
 
-    auto const fmts = SDL_GetGPUShaderFormats(device);
-    auto const fmt = preferred_shader_format(fmts);
-    auto const ext = preferred_shader_ext(fmts);
-
-    if (fmt == SDL_GPU_SHADERFORMAT_INVALID || ext.empty()) {
-        DebugLog(DL::Error, DC::Main) << "SDL_GPU: transparency: no supported shader format";
-        return nullptr;
-    }
-
-    auto const path = PATH_INFO::shaders() + "transparency_compute" + std::string{ext};
-    auto const blob = read_blob(path);
-    if (blob.empty()) {
-        DebugLog(DL::Error, DC::Main)
-            << "SDL_GPU: transparency shader blob not found: " << path
-            << " (build with shadercross to compile shaders)";
-        return nullptr;
-    }
-
-    SDL_GPUComputePipelineCreateInfo const info{
-        .code_size = blob.size(),
-        .code = reinterpret_cast<Uint8 const*>(blob.data()),
-        .entrypoint = compute_shader_entrypoint(fmt),
-        .format = fmt,
-        .num_samplers = 0,
-        .num_readonly_storage_textures = 0,
-        .num_readonly_storage_buffers = 3, // submap_in, ter_lut, furn_lut
-        .num_readwrite_storage_textures = 0,
-        .num_readwrite_storage_buffers = 2, // compact output, full resident output
-        .num_uniform_buffers = 1,           // push constants (slot 0)
-        .threadcount_x = 12,
-        .threadcount_y = 12,
-        .threadcount_z = 1,
-        .props = 0,
-    };
-
-    s_pipeline = SDL_CreateGPUComputePipeline(device, &info);
-    if (s_pipeline == nullptr) {
-        DebugLog(DL::Error, DC::Main)
-            << "SDL_GPU: transparency pipeline creation failed: " << SDL_GetError();
-    }
+    s_pipeline = create_compute_pipeline(
+        device, "transparency_compute",
+        {
+            .readonly_buffers = 3,  // submap_in, ter_lut, furn_lut
+            .readwrite_buffers = 2, // compact output, full resident output
+            .uniform_buffers = 1,   // push constants (slot 0)
+            .threads_x = 12,
+            .threads_y = 12,
+        },
+        "transparency");
     return s_pipeline;
 }
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+#include <streambuf>
+#include <string_view>
+
+/**
+ * Input streambuf whose whole content sits in one buffer.  JsonIn scans the
+ * unread part directly instead of going through the stream one character at
+ * a time.
+ */
+class contiguous_streambuf : public std::streambuf
+{
+    public:
+        /// Unread bytes, from the current position to the end.
+        auto remaining() const -> std::string_view {
+            return std::string_view( gptr(), static_cast<std::size_t>( egptr() - gptr() ) );
+        }
+        /// Consumes @p n bytes of remaining().
+        auto advance( const std::size_t n ) -> void {
+            gbump( static_cast<int>( n ) );
+        }
+};
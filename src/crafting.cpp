@@ -610,33 +610,71 @@ const inventory &Character::crafting_inventory( const tripoint_bub_ms &src_pos,
     if( src_pos == tripoint_bub_ms::zero() ) {
         inv_pos = bub_pos();
     }
-    const auto cache_hit = cached_time == calendar::turn
-                           && cached_position == inv_pos;
+    const auto power = get_power_level();
+    if( power != cached_possessions_power ) {
+        // Bionic tools run on whatever power is left, which doesn't change what else is carried.
+        for( detached_ptr<item> &tool : cached_bionic_tools ) {
+            tool->charges = units::to_kilojoule( power );
+        }
+        cached_possessions_power = power;
+    }
+    const auto burrow = has_trait( trait_BURROW );
+    const auto possessions_hit = cached_possessions_generation == item::location_generation()
+                                 && cached_possessions_burrow == burrow;
+    const auto cache_hit = possessions_hit
+                           && cached_time == calendar::turn
+                           && cached_position == inv_pos
+                           && cached_radius == radius
+                           && cached_clear_path == clear_path;
     if( cache_hit ) {
         return cached_crafting_inventory;
     }
-    cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
-    cached_crafting_inventory.add_items( inv, true );
-    cached_crafting_inventory.add_item( primary_weapon(), true );
-    cached_crafting_inventory.add_items( worn, true );
-    for( const bionic &bio : get_bionic_collection() ) {
-        const bionic_data &bio_data = bio.info();
-        if( ( !bio_data.has_flag( flag_BIONIC_TOGGLED ) || bio.powered ) &&
-            !bio_data.fake_item.is_empty() ) {
-            cached_crafting_inventory.add_item( *item::spawn_temporary( bio.info().fake_item, calendar::turn,
-                                                units::to_kilojoule( get_power_level() ) ), true );
+
+    if( !possessions_hit ) {
+        cached_possessions.clear();
+        cached_bionic_tools.clear();
+        cached_trait_tools.clear();
+        cached_possessions.add_items( inv, true );
+        cached_possessions.add_item( primary_weapon(), true );
+        cached_possessions.add_items( worn, true );
+        for( const bionic &bio : get_bionic_collection() ) {
+            const bionic_data &bio_data = bio.info();
+            if( ( !bio_data.has_flag( flag_BIONIC_TOGGLED ) || bio.powered ) &&
+                !bio_data.fake_item.is_empty() ) {
+                cached_bionic_tools.push_back( item::spawn( bio.info().fake_item, calendar::turn,
+                                               units::to_kilojoule( power ) ) );
+                cached_possessions.add_item( *cached_bionic_tools.back(), true );
+            }
+        }
+        if( burrow ) {
+            cached_trait_tools.push_back( item::spawn( "pickaxe", calendar::turn ) );
+            cached_trait_tools.push_back( item::spawn( "shovel", calendar::turn ) );
+            for( detached_ptr<item> &tool : cached_trait_tools ) {
+                cached_possessions.add_item( *tool, true );
+            }
         }
+        cached_possessions.update_quality_cache();
+        // Destroying the previous tools counted as a change too.
+        cached_possessions_generation = item::location_generation();
+        cached_possessions_burrow = burrow;
     }
-    if( has_trait( trait_BURROW ) ) {
-        cached_crafting_inventory.add_item( *item::spawn_temporary( "pickaxe", calendar::turn ), true );
-        cached_crafting_inventory.add_item( *item::spawn_temporary( "shovel", calendar::turn ), true );
+
+    // What is around the character can't be kept past the turn: the tools furniture and vehicles
+    // provide are temporary items, and their charges follow grids and batteries as they change.
+    cached_crafting_inventory.form_from_map( inv_pos, radius, this, false, clear_path );
+    cached_crafting_inventory.update_quality_cache();
+    for( size_t i = 0; i < cached_possessions.size(); i++ ) {
+        for( item *it : cached_possessions.const_stack( static_cast<int>( i ) ) ) {
+            cached_crafting_inventory.add_item( *it, true );
+        }
     }
+    cached_crafting_inventory.add_to_quality_cache( cached_possessions.get_quality_cache() );
 
     cached_moves = moves;
     cached_time = calendar::turn;
     cached_position = inv_pos;
-    // cache the qualities of the items in cached_crafting_inventory
-    cached_crafting_inventory.update_quality_cache();
+    cached_radius = radius;
+    cached_clear_path = clear_path;
     return cached_crafting_inventory;
 }
 
@@ -644,6 +682,7 @@ void Character::invalidate_crafting_inventory()
 {
     cached_time = calendar::before_time_starts;
     cached_position = tripoint_bub_ms::min();
+    cached_possessions_generation.reset();
 }
 
 void Character::make_craft( const recipe_id &id_to_make, int batch_size,
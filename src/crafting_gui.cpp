@@ -45,6 +45,7 @@
 #include "recipe.h"
 #include "recipe_dictionary.h"
 #include "requirements.h"
+#include "skill.h"
 #include "string_formatter.h"
 #include "string_input_popup.h"
 #include "string_utils.h"
@@ -60,6 +61,8 @@ static const std::string flag_BLIND_HARD( "BLIND_HARD" );
 static const std::string flag_BLIND_NEARLY_IMPOSSIBLE( "BLIND_NEARLY_IMPOSSIBLE" );
 static const std::string flag_BLIND_IMPOSSIBLE( "BLIND_IMPOSSIBLE" );
 
+static const trait_id trait_DEBUG_HS( "DEBUG_HS" );
+
 
 enum TAB_MODE {
     NORMAL,
@@ -212,6 +215,119 @@ struct availability {
 
 };
 
+/**
+ * Availability of recipes kept across openings of the crafting menu.  When it opens again, only
+ * recipes that could use an item type or tool quality whose stock in the crafting inventory
+ * changed are evaluated again.
+ */
+class availability_memory
+{
+    public:
+        auto refresh( Character &crafter, const inventory &inv,
+                      const recipe_subset &available_recipes ) ->
+        std::unordered_map<const recipe *, availability> & { // *NOPAD*
+            auto next_items = item_stock();
+            inv.visit_items( [&]( const item * e ) {
+                stock &s = next_items[e->typeId()];
+                s.count += e->count();
+                s.charges += e->ammo_remaining();
+                s.rotten += e->rotten() ? 1 : 0;
+                s.unusable += is_crafting_component( *e ) ? 0 : 1;
+                return VisitResponse::NEXT;
+            } );
+            const quality_stock &next_qualities = inv.get_quality_cache();
+            auto next_skills = std::vector<int>();
+            next_skills.reserve( Skill::skills.size() );
+            for( const Skill &sk : Skill::skills ) {
+                next_skills.push_back( crafter.get_skill_level( sk.ident() ) );
+            }
+            const bool next_hammerspace = crafter.has_trait( trait_DEBUG_HS );
+
+            if( crafter.getID() != crafter_id || next_skills != skill_levels ||
+                next_hammerspace != hammerspace || recipe_dict.version() != recipes_version ) {
+                cache.clear();
+            } else {
+                forget_changed( next_items, next_qualities );
+                // Which recipes are known, and what nested categories contain, aren't about items
+                std::erase_if( cache, [&]( const auto & e ) {
+                    return e.first->is_nested() || e.second.known != available_recipes.contains( *e.first );
+                } );
+            }
+
+            items = std::move( next_items );
+            qualities = next_qualities;
+            skill_levels = std::move( next_skills );
+            hammerspace = next_hammerspace;
+            crafter_id = crafter.getID();
+            recipes_version = recipe_dict.version();
+            return cache;
+        }
+
+    private:
+        struct stock {
+            int count = 0;
+            int charges = 0;
+            int rotten = 0;
+            int unusable = 0;
+
+            bool operator==( const stock & ) const = default;
+        };
+        using item_stock = std::unordered_map<itype_id, stock>;
+        using quality_stock = std::map<quality_id, std::map<int, int>>;
+
+        void forget( const std::vector<const recipe *> &recipes ) {
+            for( const recipe *r : recipes ) {
+                cache.erase( r );
+            }
+        }
+
+        void forget_changed( const item_stock &next_items, const quality_stock &next_qualities ) {
+            bool charges_changed = false;
+            for( const auto &[id, s] : next_items ) {
+                const auto old = items.find( id );
+                if( old == items.end() || old->second != s ) {
+                    forget( recipe_dict.recipes_using( id ) );
+                    charges_changed |= ( old == items.end() ? 0 : old->second.charges ) != s.charges;
+                }
+            }
+            for( const auto &[id, s] : items ) {
+                if( !next_items.contains( id ) ) {
+                    forget( recipe_dict.recipes_using( id ) );
+                    charges_changed |= s.charges != 0;
+                }
+            }
+            for( const auto &[id, levels] : next_qualities ) {
+                const auto old = qualities.find( id );
+                if( old == qualities.end() || old->second != levels ) {
+                    forget( recipe_dict.recipes_using( id ) );
+                }
+            }
+            for( const auto &[id, levels] : qualities ) {
+                if( !next_qualities.contains( id ) ) {
+                    forget( recipe_dict.recipes_using( id ) );
+                }
+            }
+            // Tools can draw charges from items they don't name, such as a UPS
+            if( charges_changed ) {
+                forget( recipe_dict.recipes_using_charges() );
+            }
+        }
+
+        std::unordered_map<const recipe *, availability> cache;
+        item_stock items;
+        quality_stock qualities;
+        std::vector<int> skill_levels;
+        bool hammerspace = false;
+        character_id crafter_id;
+        uint64_t recipes_version = 0;
+};
+
+auto remembered_availability() -> availability_memory & // *NOPAD*
+{
+    static auto memory = availability_memory();
+    return memory;
+}
+
 struct list_nested_options {
     const recipe *rec = nullptr;
     const inventory *crafting_inv = nullptr;
@@ -866,7 +982,8 @@ const recipe *select_crafting_recipe( int &batch_size_out, Character &crafter )
     std::string filterstring;
 
     const auto &available_recipes = crafter.get_available_recipes( crafting_inv, &helpers );
-    std::unordered_map<const recipe *, availability> availability_cache( available_recipes.size() );
+    auto &availability_cache = remembered_availability().refresh( crafter, crafting_inv,
+                               available_recipes );
 
     const std::string new_recipe_str = pgettext( "crafting gui", "NEW!" );
     const nc_color new_recipe_str_col = c_light_green;
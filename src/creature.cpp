@@ -447,6 +447,30 @@ bool Creature::sees( const Creature &critter ) const
     return sees( critter.bub_pos(), critter.is_avatar() ) && visible( ch );
 }
 
+auto Creature::sight_memo_key( const map &here ) const -> sight_memo::key
+{
+    return sight_memo::key{
+        .map = &here,
+        .map_origin = here.get_abs_sub().raw(),
+        .origin = bub_pos().raw(),
+        .generation = here.sight_generation(),
+    };
+}
+
+auto Creature::knows_field_of_view( const map &here, const int range ) const -> bool
+{
+    return sight_memo_.complete( sight_memo_key( here ), range );
+}
+
+auto Creature::remember_field_of_view( const map &here, const int range,
+                                       const std::function<bool( const point_bub_ms & )> &in_view ) const -> void
+{
+    const auto from = bub_pos().xy();
+    sight_memo_.remember_all( sight_memo_key( here ), range, [&]( const point & offset ) {
+        return in_view( from + point_rel_ms( offset ) );
+    } );
+}
+
 bool Creature::sees( const tripoint_bub_ms &t, bool /*is_avatar*/, int range_mod ) const
 {
     map &here = get_map();
@@ -492,7 +516,23 @@ bool Creature::sees( const tripoint_bub_ms &t, bool /*is_avatar*/, int range_mod
         if( range_mod > 0 ) {
             range = std::min( range, range_mod );
         }
-        return here.sees( bub_pos(), t, range );
+        if( range >= 0 && range < wanted_range ) {
+            return false;
+        }
+        // The ray itself does not depend on the range, so its answer is remembered per
+        // target tile until this creature moves or the map's transparency changes.
+        const auto from = bub_pos();
+        if( t.z() != from.z() ) {
+            return here.sees( from, t, -1 );
+        }
+        const auto key = sight_memo_key( here );
+        const auto offset = ( t.xy() - from.xy() ).raw();
+        if( const auto known = sight_memo_.find( key, offset ) ) {
+            return *known;
+        }
+        const auto visible = here.sees( from, t, -1 );
+        sight_memo_.remember( key, offset, visible );
+        return visible;
     } else {
         return false;
     }
@@ -2,6 +2,7 @@
 
 #include <climits>
 #include <cstddef>
+#include <functional>
 #include <map>
 #include <optional>
 #include <set>
@@ -22,6 +23,7 @@
 #include "coordinates.h"
 #include "enums.h"
 #include "memory_fast.h"
+#include "sight_memo.h"
 
 enum game_message_type : int;
 class nc_color;
@@ -40,6 +42,7 @@ class field;
 class field_entry;
 class JsonObject;
 class JsonOut;
+class map;
 class mapbuffer;
 class time_duration;
 class player;
@@ -348,6 +351,15 @@ class Creature
         virtual bool sees( const tripoint_bub_ms &t, bool is_avatar = false, int range_mod = 0 ) const;
         /*@}*/
 
+        /** Whether the line-of-sight rays of sees() up to @p range away are all known already. */
+        auto knows_field_of_view( const map &here, int range ) const -> bool;
+        /**
+         * Takes a field of view cast from this creature's tile as the answers of its
+         * line-of-sight rays up to @p range away.  See map::remember_fields_of_view.
+         */
+        auto remember_field_of_view( const map &here, int range,
+                                     const std::function<bool( const point_bub_ms & )> &in_view ) const -> void;
+
         /**
          * How far the creature sees under the given light. Places outside this range can
          * @param light_level See @ref game::light_level.
@@ -1088,4 +1100,7 @@ class Creature
         mutable mapbuffer *cached_mapbuffer_ = nullptr;
         mutable dimension_id cached_mapbuffer_dim_;
         mutable std::size_t cached_mapbuffer_generation_ = 0;
+        // Answers of the line-of-sight rays of sees( const tripoint_bub_ms & ).
+        mutable sight_memo sight_memo_;
+        auto sight_memo_key( const map &here ) const -> sight_memo::key;
 };
@@ -2,11 +2,14 @@
 
 #include <algorithm>
 #include <cassert>
+#include <iterator>
 #include <ostream>
 #include <string>
 #include <utility>
 
 #include "debug.h"
+#include "flat_hash_map.h"
+#include "line.h"
 #include "map.h"
 #include "mongroup.h"
 #include "monster.h"
@@ -38,6 +41,93 @@ auto Creature_tracker::find( const tripoint_abs_ms &pos ) const -> shared_ptr_fa
     return nullptr;
 }
 
+auto Creature_tracker::find_in_radius( const tripoint_abs_ms &center, const int radius,
+                                       const monster_filter &filter ) const -> std::vector<monster *>
+{
+    std::vector<monster *> ret;
+    const point_abs_sm lo = project_to<coords::sm>( center.xy() - point( radius, radius ) );
+    const point_abs_sm hi = project_to<coords::sm>( center.xy() + point( radius, radius ) );
+    const int min_z = std::max( center.z() - radius, -OVERMAP_DEPTH );
+    const int max_z = std::min( center.z() + radius, OVERMAP_HEIGHT );
+    for( int z = min_z; z <= max_z; ++z ) {
+        if( monsters_by_z[z + OVERMAP_DEPTH] == 0 ) {
+            continue;
+        }
+        for( int x = lo.x(); x <= hi.x(); ++x ) {
+            for( int y = lo.y(); y <= hi.y(); ++y ) {
+                const auto iter = monsters_by_submap.find( tripoint_abs_sm( x, y, z ) );
+                if( iter == monsters_by_submap.end() ) {
+                    continue;
+                }
+                for( monster *critter : iter->second ) {
+                    if( !critter->is_dead() && square_dist( critter->abs_pos(), center ) <= radius &&
+                        ( !filter || filter( *critter ) ) ) {
+                        ret.push_back( critter );
+                    }
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+auto Creature_tracker::find_nearest( const tripoint_abs_ms &center, const int radius,
+                                     const size_t count,
+                                     const monster_filter &filter ) const -> std::vector<monster *>
+{
+    std::vector<monster *> ret = find_in_radius( center, radius, filter );
+    const auto closer = [&]( const monster * lhs, const monster * rhs ) {
+        return rl_dist( lhs->abs_pos(), center ) < rl_dist( rhs->abs_pos(), center );
+    };
+    if( ret.size() > count ) {
+        std::ranges::partial_sort( ret, ret.begin() + count, closer );
+        ret.resize( count );
+    } else {
+        std::ranges::sort( ret, closer );
+    }
+    return ret;
+}
+
+auto Creature_tracker::tracked_faction( const monster &critter ) -> mfaction_id
+{
+    static const mfaction_str_id playerfaction( "player" );
+    // Only 1 faction per mon at the moment.
+    return critter.friendly == 0 ? critter.faction : playerfaction.id();
+}
+
+void Creature_tracker::add_to_grid( monster &critter, const tripoint_abs_ms &pos )
+{
+    monsters_by_submap[project_to<coords::sm>( pos )].push_back( &critter );
+    monsters_by_z[pos.z() + OVERMAP_DEPTH]++;
+}
+
+void Creature_tracker::remove_from_grid( const monster &critter, const tripoint_abs_ms &pos )
+{
+    const auto erase_from = [&]( decltype( monsters_by_submap )::iterator iter ) {
+        std::vector<monster *> &bucket = iter->second;
+        const auto found = std::ranges::find( bucket, &critter );
+        if( found == bucket.end() ) {
+            return false;
+        }
+        bucket.erase( found );
+        monsters_by_z[iter->first.z() + OVERMAP_DEPTH]--;
+        if( bucket.empty() ) {
+            monsters_by_submap.erase( iter );
+        }
+        return true;
+    };
+    const auto iter = monsters_by_submap.find( project_to<coords::sm>( pos ) );
+    if( iter != monsters_by_submap.end() && erase_from( iter ) ) {
+        return;
+    }
+    // Like remove_from_location_map, look for it under another location.
+    for( auto it = monsters_by_submap.begin(); it != monsters_by_submap.end(); ++it ) {
+        if( erase_from( it ) ) {
+            return;
+        }
+    }
+}
+
 int Creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::ranges::find_if( monsters_list,
@@ -93,6 +183,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 
     monsters_list.emplace_back( critter_ptr );
     monsters_by_location[critter.abs_pos()] = critter_ptr;
+    add_to_grid( critter, critter.abs_pos() );
     add_to_faction_map( critter_ptr );
     return true;
 }
@@ -100,15 +191,7 @@ bool Creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
 void Creature_tracker::add_to_faction_map( const shared_ptr_fast<monster> &critter_ptr )
 {
     assert( critter_ptr );
-    monster &critter = *critter_ptr;
-
-    // Only 1 faction per mon at the moment.
-    if( critter.friendly == 0 ) {
-        monster_faction_map_[ critter.faction ].insert( critter_ptr );
-    } else {
-        static const mfaction_str_id playerfaction( "player" );
-        monster_faction_map_[ playerfaction ].insert( critter_ptr );
-    }
+    monster_faction_map_[ tracked_faction( *critter_ptr ) ].insert( critter_ptr );
 }
 
 void Creature_tracker::update_faction( const monster &critter )
@@ -172,6 +255,10 @@ auto Creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
     if( iter != monsters_list.end() ) {
         monsters_by_location.erase( critter.abs_pos() );
         monsters_by_location[new_pos] = *iter;
+        if( project_to<coords::sm>( critter.abs_pos() ) != project_to<coords::sm>( new_pos ) ) {
+            remove_from_grid( critter, critter.abs_pos() );
+            add_to_grid( **iter, new_pos );
+        }
         return true;
     } else {
         const auto old_pos = critter.abs_pos();
@@ -188,6 +275,7 @@ auto Creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
 
 void Creature_tracker::remove_from_location_map( const monster &critter )
 {
+    remove_from_grid( critter, critter.abs_pos() );
     const auto pos_iter = monsters_by_location.find( critter.abs_pos() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
         monsters_by_location.erase( pos_iter );
@@ -234,6 +322,8 @@ void Creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    monsters_by_z = {};
     monster_faction_map_.clear();
     removed_.clear();
 }
@@ -241,9 +331,12 @@ void Creature_tracker::clear()
 void Creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
+    monsters_by_z = {};
     monster_faction_map_.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
         monsters_by_location[mon_ptr->abs_pos()] = mon_ptr;
+        add_to_grid( *mon_ptr, mon_ptr->abs_pos() );
         add_to_faction_map( mon_ptr );
     }
 }
@@ -263,12 +356,14 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
         monsters_by_location.erase( first_iter );
+        remove_from_grid( *first_ptr, first.abs_pos() );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
         monsters_by_location.erase( second_iter );
+        remove_from_grid( *second_ptr, second.abs_pos() );
     }
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
@@ -279,9 +374,11 @@ void Creature_tracker::swap_positions( monster &first, monster &second )
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
         monsters_by_location[first.abs_pos()] = first_ptr;
+        add_to_grid( *first_ptr, first.abs_pos() );
     }
     if( second_ptr ) {
         monsters_by_location[second.abs_pos()] = second_ptr;
+        add_to_grid( *second_ptr, second.abs_pos() );
     }
 }
 
@@ -290,6 +387,11 @@ bool Creature_tracker::kill_marked_for_death()
     // Important: `Creature::die` must not be called after creature objects (NPCs, monsters) have
     // been removed, the dying creature could still have a pointer (the killer) to another creature.
     bool monster_is_dead = false;
+    if( std::ranges::none_of( monsters_list, []( const shared_ptr_fast<monster> &mon_ptr ) {
+    return mon_ptr->is_dead();
+    } ) ) {
+        return false;
+    }
     // Copy the list so we can iterate the copy safely *and* add new monsters from within monster::die
     // This happens for example with blob monsters (they split into two smaller monsters).
     const auto copy = monsters_list;
@@ -312,15 +414,87 @@ bool Creature_tracker::kill_marked_for_death()
 void Creature_tracker::remove_dead()
 {
     // Can't use game::all_monsters() as it would not contain *dead* monsters.
-    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
-        const monster &critter = **iter;
-        if( critter.is_dead() ) {
-            remove_from_location_map( critter );
-            iter = monsters_list.erase( iter );
+    // Survivors keep their order, so temporary ids of the living stay in sequence.
+    const auto first_dead = std::stable_partition( monsters_list.begin(), monsters_list.end(),
+    []( const shared_ptr_fast<monster> &mon_ptr ) {
+        return !mon_ptr->is_dead();
+    } );
+    if( first_dead != monsters_list.end() ) {
+        // Held until the containers are compacted, so the faction sets can still compare them
+        const std::vector<shared_ptr_fast<monster>> dead( std::make_move_iterator( first_dead ),
+                std::make_move_iterator( monsters_list.end() ) );
+        monsters_list.erase( first_dead, monsters_list.end() );
+        remove_all( dead );
+    }
+
+    removed_.clear();
+}
+
+void Creature_tracker::remove_all( const std::vector<shared_ptr_fast<monster>> &dead )
+{
+    cata::flat_hash_set<const monster *> gone;
+    cata::flat_hash_set<tripoint_abs_sm> buckets;
+    cata::flat_hash_set<mfaction_id> factions;
+    gone.reserve( dead.size() );
+    size_t unlocated = 0;
+    for( const shared_ptr_fast<monster> &mon_ptr : dead ) {
+        gone.insert( mon_ptr.get() );
+        buckets.insert( project_to<coords::sm>( mon_ptr->abs_pos() ) );
+        factions.insert( tracked_faction( *mon_ptr ) );
+        const auto pos_iter = monsters_by_location.find( mon_ptr->abs_pos() );
+        if( pos_iter != monsters_by_location.end() && pos_iter->second == mon_ptr ) {
+            monsters_by_location.erase( pos_iter );
         } else {
-            ++iter;
+            unlocated++;
         }
     }
+    const auto is_gone = [&]( const monster * critter ) {
+        return gone.contains( critter );
+    };
+
+    // Those not at their own position (or already taken out when they moved while dead)
+    // cost one sweep in all, rather than one each.
+    if( unlocated > 0 ) {
+        std::erase_if( monsters_by_location, [&]( const auto & entry ) {
+            return is_gone( entry.second.get() );
+        } );
+    }
 
-    removed_.clear();
+    size_t ungridded = dead.size();
+    const auto compact_bucket = [&]( const auto iter ) {
+        const size_t erased = std::erase_if( iter->second, is_gone );
+        monsters_by_z[iter->first.z() + OVERMAP_DEPTH] -= static_cast<int>( erased );
+        ungridded -= std::min( ungridded, erased );
+        return iter->second.empty() ? monsters_by_submap.erase( iter ) : std::next( iter );
+    };
+    for( const tripoint_abs_sm &sm : buckets ) {
+        if( const auto iter = monsters_by_submap.find( sm ); iter != monsters_by_submap.end() ) {
+            compact_bucket( iter );
+        }
+    }
+    if( ungridded > 0 ) {
+        for( auto iter = monsters_by_submap.begin(); iter != monsters_by_submap.end(); ) {
+            iter = compact_bucket( iter );
+        }
+    }
+
+    // Expired entries go too; they compare as null and would upset the set order.
+    size_t unfiled = dead.size();
+    const auto compact_faction = [&]( auto &members ) {
+        unfiled -= std::min( unfiled, static_cast<size_t>( std::erase_if( members,
+        [&]( const weak_ptr_fast<monster> &member ) {
+            const shared_ptr_fast<monster> critter = member.lock();
+            return critter == nullptr || is_gone( critter.get() );
+        } ) ) );
+    };
+    for( const mfaction_id &faction : factions ) {
+        if( const auto iter = monster_faction_map_.find( faction ); iter != monster_faction_map_.end() ) {
+            compact_faction( iter->second );
+        }
+    }
+    if( unfiled > 0 ) {
+        for( auto &[faction, members] : monster_faction_map_ ) {
+            compact_faction( members );
+        }
+    }
 }
@@ -1,12 +1,15 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <functional>
 #include <memory>
 #include <set>
 #include <unordered_map>
 #include <vector>
 
 #include "coordinates.h"
+#include "game_constants.h"
 #include "memory_fast.h"
 #include "type_id.h"
 
@@ -48,6 +51,22 @@ class Creature_tracker
          */
         auto find( const tripoint_bub_ms &pos ) const -> shared_ptr_fast<monster>;
         auto find( const tripoint_abs_ms &pos ) const -> shared_ptr_fast<monster>;
+
+        using monster_filter = std::function<bool( const monster & )>;
+        /**
+         * Returns the live monsters no more than @p radius tiles from @p center along each axis
+         * (z included), in no particular order. Only the submaps the radius touches are looked
+         * at, so the cost follows local density rather than the total monster count.
+         * @p filter, if set, picks the monsters to keep.
+         * The pointers stay valid until the end of the turn, like those from @ref find.
+         */
+        auto find_in_radius( const tripoint_abs_ms &center, int radius,
+                             const monster_filter &filter = nullptr ) const -> std::vector<monster *>;
+        /** Up to @p count monsters from @ref find_in_radius, nearest (by rl_dist) first. */
+        auto find_nearest( const tripoint_abs_ms &center, int radius, size_t count,
+                           const monster_filter &filter = nullptr ) const -> std::vector<monster *>;
+        /** The faction @p critter is tracked under: its own, or the player's when it is friendly. */
+        static auto tracked_faction( const monster &critter ) -> mfaction_id;
         /**
          * Returns a temporary id of the given monster (which must exist in the tracker).
          * The id is valid until monsters are added or removed from the tracker.
@@ -78,7 +97,10 @@ class Creature_tracker
         void swap_positions( monster &first, monster &second );
         /** Kills 0 hp monsters. Returns if it killed any. */
         bool kill_marked_for_death();
-        /** Removes dead monsters from. Their pointers are invalidated. */
+        /**
+         * Removes dead monsters from the tracker. Their pointers are invalidated.
+         * All of them leave each container in one pass, however many died this turn.
+         */
         void remove_dead();
 
         const std::vector<shared_ptr_fast<monster>> &get_monsters_list() const {
@@ -95,7 +117,16 @@ class Creature_tracker
     private:
         std::vector<shared_ptr_fast<monster>> monsters_list;
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        /** The same monsters as @ref monsters_by_location, bucketed by the submap they stand on. */
+        std::unordered_map<tripoint_abs_sm, std::vector<monster *>> monsters_by_submap;
+        /** How many monsters @ref monsters_by_submap holds on each z-level, so empty levels are skipped. */
+        std::array<int, OVERMAP_LAYERS> monsters_by_z = {};
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        void add_to_grid( monster &critter, const tripoint_abs_ms &pos );
+        /** Looks in the bucket of @p pos first, then everywhere else. */
+        void remove_from_grid( const monster &critter, const tripoint_abs_ms &pos );
+        /** Takes @p dead, already out of @ref monsters_list, out of every other container. */
+        void remove_all( const std::vector<shared_ptr_fast<monster>> &dead );
 };
 
@@ -124,6 +124,9 @@ static bool capturing = false;
 static std::string captured;
 static std::ostringstream captured_log;
 
+/** Where debugmsgs on this thread go while collect_debugmsgs_during() runs. */
+static thread_local std::vector<deferred_debugmsg> *deferred_sink = nullptr;
+
 
 #if defined(_WIN32) && defined(LIBBACKTRACE)
 // Get the image base of a module from its PE header
@@ -220,6 +223,26 @@ capture_debugmsg::~capture_debugmsg()
     capturing = false;
 }
 
+std::vector<deferred_debugmsg> collect_debugmsgs_during( const std::function<void()> &func )
+{
+    std::vector<deferred_debugmsg> msgs;
+    std::vector<deferred_debugmsg> *const outer = deferred_sink;
+    deferred_sink = &msgs;
+    on_out_of_scope restore_sink( [outer]() {
+        deferred_sink = outer;
+    } );
+    func();
+    return msgs;
+}
+
+void replay_debugmsgs( const std::vector<deferred_debugmsg> &msgs )
+{
+    for( const deferred_debugmsg &msg : msgs ) {
+        realDebugmsg( msg.filename.c_str(), msg.line.c_str(), msg.funcname.c_str(), msg.level,
+                      msg.text );
+    }
+}
+
 bool debug_has_error_been_observed()
 {
     return error_observed;
@@ -504,6 +527,11 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     assert( line != nullptr );
     assert( funcname != nullptr );
 
+    if( deferred_sink != nullptr ) {
+        deferred_sink->push_back( { filename, line, funcname, debug_level, text } );
+        return;
+    }
+
     if( capturing ) {
         captured += text;
     } else {
@@ -51,6 +51,7 @@
 #include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 #include <functional>
 
 #include "string_formatter.h"
@@ -208,6 +209,24 @@ void debug_reset_ignored_messages();
  */
 std::string capture_debugmsg_during( const std::function<void()> &func );
 
+/** A debugmsg held back by collect_debugmsgs_during(). */
+struct deferred_debugmsg {
+    std::string filename;
+    std::string line;
+    std::string funcname;
+    DL level;
+    std::string text;
+};
+
+/**
+ * Runs func, holding back the debugmsgs it raises on the calling thread instead
+ * of reporting them.  Lets work split across threads report through
+ * replay_debugmsgs() in a fixed order once it is done.
+ */
+std::vector<deferred_debugmsg> collect_debugmsgs_during( const std::function<void()> &func );
+/** Reports msgs as if debugmsg had been called for each of them, in order. */
+void replay_debugmsgs( const std::vector<deferred_debugmsg> &msgs );
+
 /**
  * Should be called after catacurses::stdscr is initialized.
  * If catacurses::stdscr is available, shows all buffered debugmsg prompts,
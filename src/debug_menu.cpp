@@ -44,6 +44,7 @@
 #include "cursesdef.h"
 #include "debug.h"
 #include "thread_pool.h"
+#include "turn_task_graph.h"
 #include "effect.h"
 #include "enum_conversions.h"
 #include "enums.h"
@@ -59,6 +60,7 @@
 #include "json.h"
 #include "json_export.h"
 #include "language.h"
+#include "lock_stats.h"
 #include "magic/magic.h"
 #include "map.h"
 #include "mapbuffer_registry.h"
@@ -69,6 +71,7 @@
 #include "mapgendata.h"
 #include "martialarts.h"
 #include "memory_fast.h"
+#include "memory_usage.h"
 #include "messages.h"
 #include "mission.h"
 #include "monster.h"
@@ -84,6 +87,7 @@
 #include "overmap_ui.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
+#include "pathfinding.h"
 #include "pimpl.h"
 #include "player.h"
 #include "pldata.h"
@@ -97,6 +101,7 @@
 #include "string_id.h"
 #include "string_input_popup.h"
 #include "string_utils.h"
+#include "submap_load_manager.h"
 #include "trait_group.h"
 #include "translations.h"
 #include "type_id.h"
@@ -163,6 +168,7 @@ enum debug_menu_index {
     DEBUG_DISPLAY_WEATHER,
     DEBUG_DISPLAY_SCENTS,
     DEBUG_DISPLAY_DISTRIBUTION_GRIDS,
+    DEBUG_DISPLAY_RESIDENCY,
     DEBUG_CHANGE_TIME,
     DEBUG_SET_AUTOMOVE,
     DEBUG_SHOW_MUT_CAT,
@@ -177,6 +183,12 @@ enum debug_menu_index {
     DEBUG_CRASH_GAME,
     DEBUG_SHOW_WORKER_MSG,
     DEBUG_CRASH_WORKER,
+    DEBUG_TURN_TASK_GRAPH,
+    DEBUG_THREAD_POOL_STATS,
+    DEBUG_PATHFINDING_STATS,
+    DEBUG_MEMORY_USAGE,
+    DEBUG_LOCK_CONTENTION,
+    DEBUG_SUBMAP_CHURN,
     DEBUG_RELOAD_TRANSLATIONS,
     DEBUG_MAP_EXTRA,
     DEBUG_DISPLAY_NPC_PATH,
@@ -201,10 +213,12 @@ enum debug_menu_index {
     DEBUG_DISPLAY_SUBMAP_GRID,
     DEBUG_DISPLAY_TERRAIN_SOUND_ABSORPTION,
     DEBUG_DISPLAY_SOUND_WALLS,
+    DEBUG_DISPLAY_PATHFINDING_HEAT,
     DEBUG_TEST_MAP_EXTRA_DISTRIBUTION,
     DEBUG_VEHICLE_BATTERY_CHARGE,
     DEBUG_VEHICLE_EXPORT_JSON,
     DEBUG_HOUR_TIMER,
+    DEBUG_FRAME_TIMING,
     DEBUG_NESTED_MAPGEN,
     DEBUG_RESET_IGNORED_MESSAGES,
     DEBUG_RELOAD_TILES,
@@ -246,6 +260,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_DISPLAY_WEATHER, true, 'w', _( "Display weather" ) ) },
             { uilist_entry( DEBUG_DISPLAY_SCENTS, true, 'S', _( "Display overmap scents" ) ) },
             { uilist_entry( DEBUG_DISPLAY_DISTRIBUTION_GRIDS, true, 'G', _( "Display overmap distribution grids" ) ) },
+            { uilist_entry( DEBUG_DISPLAY_RESIDENCY, true, 0, _( "Display overmap submap residency" ) ) },
             { uilist_entry( DEBUG_DISPLAY_SCENTS_LOCAL, true, 's', _( "Toggle display local scents" ) ) },
             { uilist_entry( DEBUG_DISPLAY_SCENTS_TYPE_LOCAL, true, 'y', _( "Toggle display local scents type" ) ) },
             { uilist_entry( DEBUG_DISPLAY_TEMP, true, 'T', _( "Toggle display temperature" ) ) },
@@ -258,6 +273,7 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_DISPLAY_SUBMAP_GRID, true, 'o', _( "Toggle display submap grid" ) ) },
             { uilist_entry( DEBUG_DISPLAY_TERRAIN_SOUND_ABSORPTION, true, 'Q', _( "Toggle display terrain sound absorption" ) ) },
             { uilist_entry( DEBUG_DISPLAY_SOUND_WALLS, true, 'q', _( "Toggle display sound walls" ) ) },
+            { uilist_entry( DEBUG_DISPLAY_PATHFINDING_HEAT, true, 0, _( "Toggle display pathfinding explored tiles" ) ) },
 #if defined(TILES)
             { uilist_entry( ACTION_TOGGLE_ZONE_OVERLAY, true, 'z', _( "Toggle zone overlay" ) ) },
 #endif
@@ -267,11 +283,18 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( DEBUG_BENCHMARK, true, 'b', _( "Draw benchmark" ) ) },
             { uilist_entry( DEBUG_BENCHMARK_FPS, true, 'B', _( "FPS benchmark" ) ) },
             { uilist_entry( DEBUG_HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
+            { uilist_entry( DEBUG_FRAME_TIMING, true, 0, _( "Toggle frame timing overlay" ) ) },
             { uilist_entry( DEBUG_TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( DEBUG_SHOW_MSG, true, 'd', _( "Show debug message" ) ) },
             { uilist_entry( DEBUG_CRASH_GAME, true, 'C', _( "Crash game (test crash handling)" ) ) },
             { uilist_entry( DEBUG_SHOW_WORKER_MSG, true, 0, _( "Show debug message (worker thread)" ) ) },
             { uilist_entry( DEBUG_CRASH_WORKER, true, 0, _( "Crash worker thread (test crash handling)" ) ) },
+            { uilist_entry( DEBUG_TURN_TASK_GRAPH, true, 0, _( "Show turn task graph and critical path" ) ) },
+            { uilist_entry( DEBUG_THREAD_POOL_STATS, true, 0, _( "Show thread pool telemetry" ) ) },
+            { uilist_entry( DEBUG_PATHFINDING_STATS, true, 0, _( "Show pathfinding statistics" ) ) },
+            { uilist_entry( DEBUG_MEMORY_USAGE, true, 0, _( "Show memory usage by owner" ) ) },
+            { uilist_entry( DEBUG_LOCK_CONTENTION, true, 0, _( "Show lock contention" ) ) },
+            { uilist_entry( DEBUG_SUBMAP_CHURN, true, 0, _( "Show submap churn" ) ) },
             { uilist_entry( DEBUG_RELOAD_TRANSLATIONS, true, 'L', _( "Reload translations" ) ) },
             { uilist_entry( DEBUG_DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
             { uilist_entry( DEBUG_PRINT_FACTION_INFO, true, 'f', _( "Print faction info to console" ) ) },
@@ -1542,7 +1565,7 @@ void debug()
             for( int i = 0; i < OMAPX; i++ ) {
                 for( int j = 0; j < OMAPY; j++ ) {
                     for( int k = -OVERMAP_DEPTH; k <= OVERMAP_HEIGHT; k++ ) {
-                        cur_om.seen( { i, j, k } ) = true;
+                        cur_om.set_seen( { i, j, k }, true );
                     }
                 }
             }
@@ -1953,6 +1976,13 @@ void debug()
         case DEBUG_DISPLAY_DISTRIBUTION_GRIDS:
             ui::omap::display_distribution_grids();
             break;
+        case DEBUG_DISPLAY_RESIDENCY:
+            popup( _( "Tiles blink with the load request keeping them resident.\n"
+                      "Simulated: B reality bubble, P player base, S script, F fire spread,\n"
+                      "O portal preload\n"
+                      "Resident only: l lazy border, p prefetch, r retained after leaving" ) );
+            ui::omap::display_residency();
+            break;
         case DEBUG_DISPLAY_SCENTS_LOCAL:
             g->display_toggle_overlay( ACTION_DISPLAY_SCENT );
             break;
@@ -1986,6 +2016,9 @@ void debug()
         case DEBUG_DISPLAY_SOUND_WALLS:
             g->display_toggle_overlay( ACTION_DISPLAY_SOUND_WALLS );
             break;
+        case DEBUG_DISPLAY_PATHFINDING_HEAT:
+            g->display_toggle_overlay( ACTION_DISPLAY_PATHFINDING_HEAT );
+            break;
         case DEBUG_DISPLAY_SUBMAP_GRID:
             g->debug_submap_grid_overlay = !g->debug_submap_grid_overlay;
             break;
@@ -1995,6 +2028,9 @@ void debug()
         case DEBUG_HOUR_TIMER:
             g->toggle_debug_hour_timer();
             break;
+        case DEBUG_FRAME_TIMING:
+            g->toggle_debug_frame_timing();
+            break;
         case DEBUG_SWAP_CHAR:
             control_npc_menu();
             break;
@@ -2132,16 +2168,57 @@ void debug()
             raise( SIGSEGV );
             break;
         case DEBUG_SHOW_WORKER_MSG:
-            get_thread_pool().submit_returning( []() {
+            get_thread_pool().submit_returning( "debug_worker_msg", []() {
                 debugmsg( "Test debugmsg from worker thread" );
             } ).get();
             drain_worker_thread_debugmsgs();
             break;
         case DEBUG_CRASH_WORKER:
-            get_thread_pool().submit( []() {
+            get_thread_pool().submit( "debug_worker_crash", []() {
                 raise( SIGSEGV );
             } );
             break;
+        case DEBUG_TURN_TASK_GRAPH: {
+            const std::string report = turn_task_graph::dump_all();
+            DebugLog( DL::Info, DC::Main ) << report;
+            popup( "%s", report );
+            break;
+        }
+        case DEBUG_THREAD_POOL_STATS: {
+            const std::string report = get_thread_pool().describe_stats();
+            DebugLog( DL::Info, DC::Main ) << report;
+            popup( "%s", report );
+            break;
+        }
+        case DEBUG_PATHFINDING_STATS: {
+            const std::string report = Pathfinding::describe_stats();
+            DebugLog( DL::Info, DC::Main ) << report;
+            popup( "%s", report );
+            break;
+        }
+        case DEBUG_MEMORY_USAGE: {
+            const std::string report = memory_usage::describe( memory_usage::collect() );
+            DebugLog( DL::Info, DC::Main ) << report;
+            popup( "%s", report );
+            break;
+        }
+        case DEBUG_LOCK_CONTENTION: {
+            const std::string report = lock_stats::describe( lock_stats::collect() );
+            DebugLog( DL::Info, DC::Main ) << report;
+            if( query_yn( _( "%s\nReset the counters?" ), report ) ) {
+                lock_stats::reset();
+            }
+            break;
+        }
+        case DEBUG_SUBMAP_CHURN: {
+            const std::string report = describe_churn( submap_loader.last_turn_churn(),
+                                       submap_loader.total_churn() );
+            DebugLog( DL::Info, DC::Main ) << report;
+            if( query_yn( _( "%s\nReset the counters?" ), report ) ) {
+                submap_loader.reset_churn();
+            }
+            break;
+        }
         case DEBUG_RELOAD_TRANSLATIONS:
             l10n_data::reload_catalogues();
             break;
@@ -51,12 +51,18 @@ distribution_grid::operator bool() const
 
 void distribution_grid::update( time_point to )
 {
+    if( !next_update_due_ || to < *next_update_due_ ) {
+        return;
+    }
+    std::optional<time_point> due;
     for( const auto &c : contents ) {
         submap *sm = mb.lookup_submap( c.first );
         if( sm == nullptr ) {
             return;
         }
 
+        // Grid updates change stored charge and timestamps.
+        sm->mark_modified();
         for( const tile_location &loc : c.second ) {
             auto &active = sm->active_furniture[loc.on_submap];
             if( !active ) {
@@ -65,8 +71,12 @@ void distribution_grid::update( time_point to )
                 return;
             }
             active->update( to, loc.absolute, *this );
+            if( const auto tile_due = active->next_update_due() ) {
+                due = due ? std::min( *due, *tile_due ) : *tile_due;
+            }
         }
     }
+    next_update_due_ = due;
 }
 
 // TODO: Shouldn't be here
@@ -764,6 +774,7 @@ void grid_furn_transform_queue::apply( mapbuffer &mb, distribution_grid_tracker
 
         // TODO: this is copy-pasted from map.cpp
         sm->set_furn( p_within_sm, qt.id );
+        sm->mark_modified();
         if( old_t.active ) {
             sm->active_furniture.erase( p_within_sm );
             // TODO: Only for g->m? Observer pattern?
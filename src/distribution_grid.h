@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -55,13 +56,25 @@ class distribution_grid
 
         mutable std::optional<int> cached_amount_here;
 
+        /** Earliest @ref active_tile_data::next_update_due of the contents, as of the last walk. */
+        std::optional<time_point> next_update_due_ = calendar::before_time_starts;
+
         mapbuffer &mb;
 
     public:
         distribution_grid( const std::vector<tripoint_abs_sm> &global_submap_coords, mapbuffer &buffer );
         bool empty() const;
         explicit operator bool() const;
+        /**
+         * Bring every tile of the grid up to @p to.  Grids whose tiles can't do anything
+         * before their next due time are left alone until then, and are caught up as a
+         * whole when it comes.  Changing the contents builds a new grid.
+         */
         void update( time_point to );
+        /** When update() will next walk the tiles, nullopt if nothing on the grid acts on its own. */
+        auto next_update_due() const -> std::optional<time_point> {
+            return next_update_due_;
+        }
         int mod_resource( int amt, bool recurse = true );
         int get_resource( bool recurse = true ) const;
         const std::vector<tripoint_abs_ms> &get_contents() const {
@@ -358,6 +358,17 @@ atlas_texture dynamic_atlas::allocate_sprite_internal( const int w, const int h
 
     const auto &r = get_sdl_renderer();
     const bool is_software = ( std::string_view( SDL_GetRendererName( r.get() ) ) == "software" );
+
+    if( !is_software && max_sheets > 0 && std::cmp_greater_equal( sheets.size(), max_sheets ) ) {
+        const auto evicted = evict_sheet_internal();
+        if( evicted.has_value() ) {
+            auto &s = sheets[evicted.value()];
+            const auto p = s.packer->pack( w, h );
+            if( p.has_value() ) {
+                return get_texture( s.texture, p.value(), w, h );
+            }
+        }
+    }
     int tex_width;
     int tex_height;
 
@@ -407,6 +418,51 @@ atlas_texture dynamic_atlas::allocate_sprite_internal( const int w, const int h
     return get_texture( entry.texture, rect.value(), w, h );
 }
 
+void dynamic_atlas::set_sheet_limit( const int max_sheets, eviction_callback on_evict )
+{
+    this->max_sheets = max_sheets;
+    this->on_evict = std::move( on_evict );
+}
+
+auto dynamic_atlas::sheet_index( const SDL_Texture_SharedPtr &tex ) const -> int
+{
+    const auto it = std::ranges::find_if( sheets, [&]( const sprite_sheet & s ) {
+        return s.texture == tex;
+    } );
+    return it == sheets.end() ? -1 : static_cast<int>( std::distance( sheets.begin(), it ) );
+}
+
+auto dynamic_atlas::evict_sheet_internal() -> std::optional<int>
+{
+    auto victim = std::optional<int>();
+    for( int i = 0; std::cmp_less( i, sheets.size() ); ++i ) {
+        const auto &s = sheets[i];
+        if( s.last_used < frame && ( !victim || s.last_used < sheets[*victim].last_used ) ) {
+            victim = i;
+        }
+    }
+    if( !victim ) {
+        dbg( DL::Info ) << "dynamic atlas: every sheet was drawn this frame, growing past the limit of "
+                        << max_sheets;
+        return std::nullopt;
+    }
+
+    auto &s = sheets[*victim];
+    std::erase_if( sprite_ids, [&]( const auto & it ) {
+        return it.second.first == *victim;
+    } );
+    s.packer = std::make_unique<stripe_texture_packer>(
+                   SDL_Rect{0, 0, s.atlas_width, s.atlas_height},
+                   hint_sprite_width
+               );
+    s.dirty = true;
+    s.last_used = frame;
+    if( on_evict ) {
+        on_evict( *victim );
+    }
+    return victim;
+}
+
 void dynamic_atlas::readback_dump( const std::string &s )
 {
     readback_load();
@@ -2,6 +2,7 @@
 
 #if defined(TILES)
 
+#include <cstdint>
 #include <string>
 #include <optional>
 #include <vector>
@@ -38,8 +39,12 @@ class dynamic_atlas
             int atlas_width;
             int atlas_height;
             bool dirty;
+            /** Frame in which a sprite on this sheet was last drawn, see mark_used(). */
+            uint64_t last_used = 0;
         };
         using sprite_callback = std::function<void( SDL_Surface *, const SDL_Rect * )>;
+        /** Called with the index of a sheet whose sprites were all dropped. */
+        using eviction_callback = std::function<void( int )>;
 
         dynamic_atlas()
             : max_atlas_width( 0 ), max_atlas_height( 0 ), hint_sprite_width( 0 ),
@@ -63,6 +68,25 @@ class dynamic_atlas
         void start_batch();
         void end_batch();
 
+        /**
+         * Caps the atlas at @p max_sheets sheets (0 for no cap).  Once the cap is
+         * reached, a sprite that fits nowhere reuses the sheet drawn least
+         * recently: its sprites are forgotten and @p on_evict is told so the
+         * owner can drop what it keeps of them.  Sheets drawn in the current
+         * frame are never reused; the atlas grows past the cap instead.
+         * Has no effect with the software renderer, which uses a texture per sprite.
+         */
+        void set_sheet_limit( int max_sheets, eviction_callback on_evict );
+        /** Starts a new frame for the least-recently-used order. */
+        void next_frame() {
+            ++frame;
+        }
+        void mark_used( const int sheet ) {
+            sheets[sheet].last_used = frame;
+        }
+        /** Index of the sheet holding @p tex, or -1. */
+        auto sheet_index( const SDL_Texture_SharedPtr &tex ) const -> int;
+
         auto get_staging_area( int width,
                                int height ) -> std::tuple<SDL_Texture *, SDL_Surface *, SDL_Rect>;
 
@@ -77,6 +101,7 @@ class dynamic_atlas
 
         auto assign_id_internal( size_t id, const atlas_texture &tex ) -> bool;
         auto allocate_sprite_internal( int w, int h ) -> atlas_texture;
+        auto evict_sheet_internal() -> std::optional<int>;
         auto update_staging_area( staging_area &staging, int width, int height ) const
         -> std::tuple<SDL_Texture *, SDL_Surface *, SDL_Rect>;
         std::vector<sprite_sheet> sheets;
@@ -90,6 +115,10 @@ class dynamic_atlas
         int hint_sprite_width;
         int hint_sprite_height;
         bool is_batching;
+
+        int max_sheets = 0;
+        eviction_callback on_evict;
+        uint64_t frame = 1;
 };
 
 #endif
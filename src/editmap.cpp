@@ -2182,8 +2182,8 @@ void editmap::edit_mapgen()
 void editmap::cleartmpmap( map &tmpmap )
 {
     auto &ch = tmpmap.get_cache( target.z() );
-    std::fill( ch.veh_exists_at.begin(), ch.veh_exists_at.end(), false );
-    ch.veh_cached_parts.clear();
+    ch.veh_parts.clear_all();
+    ch.veh_rope.clear_all();
     ch.vehicle_list.clear();
     ch.zone_vehicles.clear();
 }
@@ -418,6 +418,11 @@ bool effect_type::load_mod_data( const JsonObject &jo, const std::string &member
     }
 }
 
+bool effect_type::has_mod( const std::string &arg ) const
+{
+    return mod_args.contains( arg );
+}
+
 bool effect_type::has_flag( const flag_id &flag ) const
 {
     return flags.contains( flag );
@@ -931,6 +936,9 @@ std::vector<efftype_id> effect::get_blocks_effects() const
 
 int effect::get_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -963,6 +971,9 @@ int effect::get_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double min = 0;
     double max = 0;
@@ -995,6 +1006,9 @@ int effect::get_avg_mod( const std::string &arg, bool reduced ) const
 
 int effect::get_amount( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     int intensity_capped = eff_type->max_effective_intensity > 0 ? std::min(
                                eff_type->max_effective_intensity, intensity ) : intensity;
     auto &mod_data = eff_type->mod_data;
@@ -1012,6 +1026,9 @@ int effect::get_amount( const std::string &arg, bool reduced ) const
 
 int effect::get_min_val( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double ret = 0;
     auto found = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "min_val" ) );
@@ -1027,6 +1044,9 @@ int effect::get_min_val( const std::string &arg, bool reduced ) const
 
 int effect::get_max_val( const std::string &arg, bool reduced ) const
 {
+    if( !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     double ret = 0;
     auto found = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "max_val" ) );
@@ -1052,6 +1072,10 @@ bool effect::get_sizing( const std::string &arg ) const
 
 double effect::get_percentage( const std::string &arg, int val, bool reduced ) const
 {
+    // A valueless check can only trigger off a chance the type gives
+    if( val == 0 && !eff_type->has_mod( arg ) ) {
+        return 0;
+    }
     auto &mod_data = eff_type->mod_data;
     auto found_top_base = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "chance_top" ) );
     auto found_top_scale = mod_data.find( std::make_tuple( "scaling_mods", reduced, arg,
@@ -1130,6 +1154,10 @@ double effect::get_percentage( const std::string &arg, int val, bool reduced ) c
 bool effect::activated( const time_point &when, const std::string &arg, int val, bool reduced,
                         double mod ) const
 {
+    // A valueless check can only trigger off a chance the type gives
+    if( val == 0 && !eff_type->has_mod( arg ) ) {
+        return false;
+    }
     auto &mod_data = eff_type->mod_data;
     auto found_top_base = mod_data.find( std::make_tuple( "base_mods", reduced, arg, "chance_top" ) );
     auto found_top_scale = mod_data.find( std::make_tuple( "scaling_mods", reduced, arg,
@@ -1387,6 +1415,9 @@ void load_effect_type( const JsonObject &jo )
 
     new_etype.load_mod_data( jo, "base_mods" );
     new_etype.load_mod_data( jo, "scaling_mods" );
+    for( const auto &entry : new_etype.mod_data ) {
+        new_etype.mod_args.insert( std::get<2>( entry.first ) );
+    }
 
     new_etype.impairs_movement = hardcoded_movement_impairing.contains( new_etype.id );
 
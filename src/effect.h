@@ -4,6 +4,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -146,6 +147,9 @@ class effect_type
         /** Check if the effect type has the specified flag */
         bool has_flag( const flag_id &flag ) const;
 
+        /** Whether any base or scaling mod is given for @p arg ("SPEED", "HURT", ...). */
+        bool has_mod( const std::string &arg ) const;
+
         static void check_consistency();
 
         LUA_TYPE_OPS( effect_type, id );
@@ -214,6 +218,8 @@ class effect_type
         /** Key tuple order is:("base_mods"/"scaling_mods", reduced: bool, type of mod: "STR", desired argument: "tick") */
         std::unordered_map <
         std::tuple<std::string, bool, std::string, std::string>, double, cata::tuple_hash > mod_data;
+        /** Every mod type in @ref mod_data, so effects without one skip building the keys. */
+        std::unordered_set<std::string> mod_args;
 };
 
 class effect
@@ -270,6 +270,7 @@ bool enchantment::add(const enchantment& rhs) {
 }
 
 void enchantment::force_add(const enchantment& rhs) {
+    totals_cached = false;
     for (const auto& pair_values : rhs.values_add) {
         values_add[pair_values.first] += pair_values.second;
     }
@@ -304,7 +305,35 @@ void enchantment::force_add(const enchantment& rhs) {
     }
 }
 
+void enchantment::cache_totals() {
+    totals_cached = false;
+    totals.clear();
+    const auto add_totals = [this](const enchantment_value_id& value) {
+        if (!totals.contains(value) && value.is_valid()) {
+            totals.emplace(value, value_totals{get_value_add(value), get_value_multiply(value),
+                                               get_value_max(value)});
+        }
+    };
+    for (const auto& pair_values : values_add) { add_totals(pair_values.first); }
+    for (const auto& pair_values : values_multiply) { add_totals(pair_values.first); }
+    for (const auto& pair_values : values_max) { add_totals(pair_values.first); }
+    totals_cached = true;
+}
+
+enchantment::value_totals enchantment::get_totals(const enchantment_value_id value) const {
+    if (totals.empty()) { return {}; }
+    if (!value.is_valid()) {
+        debugmsg("Tried to get invalid enchantment value \"%s\".", value);
+        return {};
+    }
+    // A value with nothing of its own only inherits what its parents have
+    const auto it = totals.find(value);
+    if (it != totals.end()) { return it->second; }
+    return value->has_parent() ? get_totals(value->get_parent()) : value_totals{};
+}
+
 int enchantment::get_value_add(const enchantment_value_id value) const {
+    if (totals_cached) { return get_totals(value).add; }
     if (!value.is_valid()) { debugmsg("Tried to get invalid enchantment value \"%s\".", value); }
     int result = 0;
     if (values_add.contains(value)) { result += values_add.at(value); }
@@ -314,6 +343,7 @@ int enchantment::get_value_add(const enchantment_value_id value) const {
 }
 
 double enchantment::get_value_multiply(const enchantment_value_id value) const {
+    if (totals_cached) { return get_totals(value).multiply; }
     if (!value.is_valid()) { debugmsg("Tried to get invalid enchantment value \"%s\".", value); }
     double result = 0;
     if (values_multiply.contains(value)) { result += values_multiply.at(value); }
@@ -323,6 +353,7 @@ double enchantment::get_value_multiply(const enchantment_value_id value) const {
 }
 
 int enchantment::get_value_max(const enchantment_value_id value) const {
+    if (totals_cached) { return get_totals(value).max; }
     if (!value.is_valid()) { debugmsg("Tried to get invalid enchantment value \"%s\".", value); }
     int result = 0;
     if (values_max.contains(value)) { result = values_max.at(value); }
@@ -332,6 +363,7 @@ int enchantment::get_value_max(const enchantment_value_id value) const {
 }
 
 double enchantment::calc_bonus(enchantment_value_id value, double base, bool round) const {
+    if (totals_cached && totals.empty()) { return 0.0; }
     double add = value->can_add ? get_value_add(value) : 0.0;
     double mul = value->can_mult ? get_value_multiply(value) : 0.0;
     double max = value->can_max ? get_value_max(value) : 0.0;
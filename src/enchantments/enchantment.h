@@ -49,6 +49,12 @@ public:
     // adds two enchantments together and ignores their conditions
     void force_add(const enchantment& rhs);
 
+    /**
+     * Sums every value up front, parents included, so the getters below don't walk the
+     * value maps on each call.  Anything added afterwards drops the sums again.
+     */
+    void cache_totals();
+
     int get_value_add(enchantment_value_id value) const;
     double get_value_multiply(enchantment_value_id value) const;
     int get_value_max(enchantment_value_id value) const;
@@ -115,6 +121,16 @@ private:
     // values from which the highest value is chosen
     std::map<enchantment_value_id, int> values_max;
 
+    struct value_totals {
+        int add = 0;
+        double multiply = 0.0;
+        int max = 0;
+    };
+    // filled by cache_totals for every value in the maps above
+    std::map<enchantment_value_id, value_totals> totals;
+    bool totals_cached = false;
+    value_totals get_totals(enchantment_value_id value) const;
+
     std::vector<fake_spell> hit_me_effect;
     std::vector<fake_spell> hit_you_effect;
 
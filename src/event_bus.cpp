@@ -1,6 +1,7 @@
 #include "event_bus.h"
 
 #include <algorithm>
+#include <utility>
 
 #include "debug.h"
 #include "options.h"
@@ -29,6 +30,16 @@ void event_subscriber::on_unsubscribe( event_bus *b )
     }
 }
 
+void event_subscriber::flush_deferred()
+{
+    // Events sent while these are handled either queue afresh or, if they
+    // aren't deferred, arrive in between, just as they would have undeferred.
+    const std::vector<cata::event> pending = std::exchange( deferred, {} );
+    for( const cata::event &e : pending ) {
+        notify( e );
+    }
+}
+
 event_bus::~event_bus()
 {
     while( !subscribers.empty() ) {
@@ -41,6 +52,20 @@ void event_bus::subscribe( event_subscriber *s )
     if( get_option<bool>( "ENABLE_EVENTS" ) ) {
         subscribers.push_back( s );
         s->on_subscribe( this );
+        const std::vector<event_type> wanted = s->subscribed_events();
+        if( wanted.empty() ) {
+            for( std::vector<event_subscriber *> &for_type : subscribers_by_type ) {
+                for_type.push_back( s );
+            }
+        } else {
+            for( const event_type type : wanted ) {
+                subscribers_by_type[static_cast<size_t>( type )].push_back( s );
+            }
+        }
+        s->deferrable.reset();
+        for( const event_type type : s->deferred_events() ) {
+            s->deferrable.set( static_cast<size_t>( type ) );
+        }
     }
 }
 
@@ -52,12 +77,38 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &for_type : subscribers_by_type ) {
+            std::erase( for_type, s );
+        }
+        // Delivering these now could reach a subscriber that's being destroyed
+        s->deferred.clear();
     }
 }
 
 void event_bus::send( const cata::event &e ) const
+{
+    const auto type = static_cast<size_t>( e.type() );
+    for( event_subscriber *s : subscribers_by_type[type] ) {
+        if( defer_events && s->deferrable[type] ) {
+            s->deferred.push_back( e );
+        } else {
+            s->flush_deferred();
+            s->notify( e );
+        }
+    }
+}
+
+void event_bus::set_defer_events( const bool defer )
+{
+    defer_events = defer;
+    if( !defer ) {
+        flush_deferred();
+    }
+}
+
+void event_bus::flush_deferred()
 {
     for( event_subscriber *s : subscribers ) {
-        s->notify( e );
+        s->flush_deferred();
     }
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <array>
+#include <bitset>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -7,6 +10,8 @@
 
 class event_bus;
 
+inline constexpr auto num_event_types = static_cast<size_t>( event_type::num_event_types );
+
 class event_subscriber
 {
     public:
@@ -15,11 +20,27 @@ class event_subscriber
         event_subscriber &operator=( const event_subscriber & ) = delete;
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
+
+        /** Event types this subscriber is notified of when subscribed; all of them if empty. */
+        virtual auto subscribed_events() const -> std::vector<event_type> {
+            return {};
+        }
+        /**
+         * Event types that a deferring bus may queue and deliver later in one batch.
+         * Only worth it for frequent events whose handling isn't needed straight away.
+         */
+        virtual auto deferred_events() const -> std::vector<event_type> {
+            return {};
+        }
+        /** Delivers the events queued for this subscriber, in the order they were sent. */
+        void flush_deferred();
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
         void on_unsubscribe( event_bus * );
         event_bus *subscribed_to = nullptr;
+        std::bitset<num_event_types> deferrable;
+        std::vector<cata::event> deferred;
 };
 
 class event_bus
@@ -37,8 +58,18 @@ class event_bus
         void send( Args &&... args ) const {
             send( cata::event::make<Type>( std::forward<Args>( args )... ) );
         }
+
+        /**
+         * Whether events a subscriber lists in @ref event_subscriber::deferred_events
+         * are queued until @ref flush_deferred instead of delivered as they're sent.
+         * Any other event delivered to that subscriber flushes its queue first.
+         */
+        void set_defer_events( bool defer );
+        void flush_deferred();
     private:
         std::vector<event_subscriber *> subscribers;
+        std::array<std::vector<event_subscriber *>, num_event_types> subscribers_by_type;
+        bool defer_events = false;
 };
 
 event_bus &get_event_bus();
@@ -20,6 +20,7 @@
 #include "animation.h"
 #include "avatar.h"
 #include "ballistics.h"
+#include "cached_options.h"
 #include "catalua_hooks.h"
 #include "catalua_sol.h"
 #include "bodypart.h"
@@ -30,6 +31,7 @@
 #include "cata_algo.h"
 #include "color.h"
 #include "creature.h"
+#include "creature_tracker.h"
 #include "damage.h"
 #include "debug.h"
 #include "enums.h"
@@ -65,6 +67,7 @@
 #include "shadowcasting.h"
 #include "sounds.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -118,6 +121,59 @@ auto is_emp_card_reader( const ter_id &terrain ) -> bool
            terrain == t_card_industrial;
 }
 
+/**
+ * Which tiles around an explosion stop shrapnel on its own z-level, read from the map once
+ * so that the lines of flight to every tile in range don't look them up again.
+ */
+class shrapnel_obstacles
+{
+    public:
+        shrapnel_obstacles( const map &m, const tripoint_bub_ms &center, const int range )
+            : corner( center.xy() + point_rel_ms( -range, -range ) )
+            , side( 2 * range + 1 )
+            , z( center.z() )
+            , blocked( static_cast<size_t>( side ) * side ) {
+            for( int y = 0; y < side; y++ ) {
+                for( int x = 0; x < side; x++ ) {
+                    const tripoint_bub_ms p( corner + point_rel_ms( x, y ), z );
+                    blocked[y * side + x] = m.inbounds( p ) && m.impassable( p );
+                }
+            }
+        }
+
+        /** Same answer as ExplosionProcess::is_occluded for a line within range. */
+        auto occluded( const map &m, const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const ->
+        bool {
+            if( from == to ) {
+                return false;
+            }
+            tripoint_bub_ms last_position = from;
+            std::vector<tripoint_bub_ms> line_of_movement = line_to( from, to );
+            line_of_movement.insert( line_of_movement.begin(), from );
+            for( const tripoint_bub_ms &position : line_of_movement ) {
+                if( position != to && is_blocked( position ) ) {
+                    return true;
+                }
+                if( m.obstructed_by_vehicle_rotation( last_position, position ) ) {
+                    return true;
+                }
+                last_position = position;
+            }
+            return false;
+        }
+
+    private:
+        auto is_blocked( const tripoint_bub_ms &p ) const -> bool {
+            const point_rel_ms offset = p.xy() - corner;
+            return blocked[offset.y() * side + offset.x()];
+        }
+
+        point_bub_ms corner;
+        int side;
+        int z;
+        std::vector<char> blocked;
+};
+
 } // namespace
 
 static float obstacle_blast_percentage( float range, float distance )
@@ -489,6 +545,7 @@ void ExplosionProcess::fill_maps()
     map &here = get_map();
 
     const int shrapnel_range = shrapnel.has_value() ? shrapnel.value().range : 0;
+    std::vector<dist_point_pair> shrapnel_candidates;
     const int aoe_radius = std::max( blast_radius, shrapnel_range );
     const int z_levels_affected = aoe_radius / ExplosionConstants::Z_LEVEL_DIST;
     const tripoint_range<tripoint_bub_ms> affected_block(
@@ -515,9 +572,30 @@ void ExplosionProcess::fill_maps()
         }
 
         if( shrapnel && static_cast<int>( std::lround( distance ) ) <= shrapnel_range &&
-            target.z() == center.z() &&
-            !is_occluded( center, target ) ) {
-            shrapnel_map.emplace_back( distance, target );
+            target.z() == center.z() ) {
+            shrapnel_candidates.emplace_back( distance, target );
+        }
+    }
+
+    if( !shrapnel_candidates.empty() ) {
+        // Nothing changes the map until the events run, so the lines can be traced in parallel.
+        const shrapnel_obstacles obstacles( here, center, shrapnel_range );
+        std::vector<char> reached( shrapnel_candidates.size() );
+        const auto trace = [&]( const int i ) {
+            reached[i] = !obstacles.occluded( here, center, shrapnel_candidates[i].second );
+        };
+        const int num_candidates = static_cast<int>( shrapnel_candidates.size() );
+        if( parallel_enabled && parallel_explosion_shrapnel && !is_pool_worker_thread() ) {
+            parallel_for( "explosion_shrapnel_lines", 0, num_candidates, trace );
+        } else {
+            for( int i = 0; i < num_candidates; i++ ) {
+                trace( i );
+            }
+        }
+        for( size_t i = 0; i < shrapnel_candidates.size(); i++ ) {
+            if( reached[i] ) {
+                shrapnel_map.push_back( shrapnel_candidates[i] );
+            }
         }
     }
 
@@ -1272,10 +1350,11 @@ static std::map<const Creature *, int> legacy_shrapnel( const tripoint_bub_ms &s
     map &here = get_map();
 
     auto &_exp_cache = here.access_cache( src.z() );
-    const int exp_sx = _exp_cache.cache_x;
-    const int exp_sy = _exp_cache.cache_y;
-    auto obstacle_cache = std::vector<float>( static_cast<size_t>( exp_sx ) * exp_sy, 0.0f );
-    auto visited_cache  = std::vector<float>( static_cast<size_t>( exp_sx ) * exp_sy, 0.0f );
+    // Cast against the level's vehicle cache, so the scratch grids take its shape.
+    const auto exp_shape = _exp_cache.shape();
+    const auto exp_cells = static_cast<size_t>( exp_shape.sx ) * exp_shape.sy;
+    auto obstacle_cache = std::vector<float>( exp_cells, 0.0f );
+    auto visited_cache  = std::vector<float>( exp_cells, 0.0f );
 
     // TODO: Calculate range based on max effective range for projectiles.
     // Basically bisect between 0 and map diameter using shrapnel_calc().
@@ -1283,12 +1362,12 @@ static std::map<const Creature *, int> legacy_shrapnel( const tripoint_bub_ms &s
     const tripoint_range<tripoint_bub_ms> area = here.points_on_zlevel( src.z() );
 
     here.build_obstacle_cache( area.min(), area.max() + tripoint_south_east,
-                               obstacle_cache.data(), exp_sy );
+                               obstacle_cache.data(), exp_shape );
 
     // Shadowcasting normally ignores the origin square,
     // so apply it manually to catch monsters standing on the explosive.
     // This "blocks" some fragments, but does not apply deceleration.
-    visited_cache[src.x() * exp_sy + src.y()] = 1.0f;
+    visited_cache[cache_layout::index( src.x(), src.y(), exp_shape )] = 1.0f;
 
     // This is used to limit radius
     // By default, the radius is 60, so negative values can be helpful here
@@ -1298,12 +1377,12 @@ static std::map<const Creature *, int> legacy_shrapnel( const tripoint_bub_ms &s
         accumulate_fragment_cloud
     };
     castLightAll( visited_cache.data(), obstacle_cache.data(),
-                  _exp_cache.vehicle_obstructed_cache.data(), exp_sx, exp_sy,
+                  _exp_cache.vehicle_obstructed_cache.data(), exp_shape,
                   src.xy(), offset_distance, fragment.range + 1.0f, k_shrapnel_model );
 
     // Now visited_caches are populated with density and velocity of fragments.
     for( const tripoint_bub_ms &target : area ) {
-        if( visited_cache[target.x() * exp_sy + target.y()] <= 0.0f ||
+        if( visited_cache[cache_layout::index( target.x(), target.y(), exp_shape )] <= 0.0f ||
             rl_dist( src, target ) > fragment.range ) {
             continue;
         }
@@ -1774,8 +1853,9 @@ void explosion_funcs::flashbang( const queued_explosion &qe )
                                  time_duration::from_turns( 10 - dist ) );
         }
     }
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.type->in_species( ROBOT ) ) {
+    for( monster *critter_ptr : g->critter_tracker->find_in_radius( bub_to_abs( p ), 8 ) ) {
+        monster &critter = *critter_ptr;
+        if( critter.is_dead() || critter.type->in_species( ROBOT ) ) {
             continue;
         }
         // TODO: can the following code be called for all types of creatures
@@ -1828,8 +1908,14 @@ void explosion_funcs::shockwave( const queued_explosion &qe )
     se.variant = "shockwave";
     sounds::sound( se );
 
-    for( monster &critter : g->all_monsters() ) {
-        if( critter.bub_pos().z() != p.z() ) {
+    const auto same_level = [&]( const monster & critter ) {
+        return critter.bub_pos().z() == p.z();
+    };
+    for( monster *critter_ptr : g->critter_tracker->find_in_radius( bub_to_abs( p ), sw.radius,
+            same_level ) ) {
+        monster &critter = *critter_ptr;
+        // An earlier knockback may have killed it
+        if( critter.is_dead() ) {
             continue;
         }
         if( rl_dist( critter.bub_pos(), p ) <= sw.radius ) {
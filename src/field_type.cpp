@@ -1,5 +1,6 @@
 #include "field_type.h"
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "assign.h"
@@ -272,7 +273,21 @@ void field_types::finalize_all()
     set_field_type_ids();
     all_field_types.finalize();
     for( const field_type &fd : all_field_types.get_all() ) {
-        const_cast<field_type &>( fd ).finalize();
+        field_type &type = const_cast<field_type &>( fd );
+        type.finalize();
+        type.affects_creatures = std::ranges::any_of( type.intensity_levels,
+        []( const field_intensity_level & level ) {
+            return !level.field_effects.empty();
+        } );
+    }
+    // Handled by type in map::player_in_field and map::monster_in_field
+    for( const field_type_id &fd : {
+             fd_web, fd_acid, fd_sap, fd_sludge, fd_fire, fd_smoke, fd_toxic_gas, fd_tear_gas,
+             fd_nuke_gas, fd_relax_gas, fd_fungal_haze, fd_dazzling, fd_flame_burst,
+             fd_electricity, fd_fatigue, fd_shock_vent, fd_acid_vent, fd_bees, fd_incendiary,
+             fd_fungicidal_gas, fd_insecticidal_gas
+         } ) {
+        const_cast<field_type &>( fd.obj() ).affects_creatures = true;
     }
 }
 
@@ -183,6 +183,8 @@ struct field_type {
         bool accelerated_decay = false;
         bool display_items = true;
         bool display_field = false;
+        // Whether standing in it can do anything to a creature, set in finalize_all
+        bool affects_creatures = false;
         field_type_id wandering_field;
         std::string looks_like;
 
@@ -28,7 +28,7 @@ const auto cardinal_offsets = std::to_array( { tripoint_east, tripoint_west, tri
  */
 auto submap_has_fire( const submap &sm ) -> bool
 {
-    if( sm.field_count == 0 ) {
+    if( sm.field_count == 0 || !sm.may_have_field( fd_fire ) ) {
         return false;
     }
     return std::ranges::any_of( sm.field_cache, [&]( const point_sm_ms & local ) {
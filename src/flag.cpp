@@ -463,3 +463,12 @@ const std::vector<json_flag> &json_flag::get_all()
 {
     return json_flags_all.get_all();
 }
+
+auto flag_bits::position( const flag_id &f ) -> std::optional<size_t>
+{
+    if( !f.is_valid() ) {
+        return std::nullopt;
+    }
+    const auto bit = static_cast<size_t>( f.id().to_i() );
+    return bit < capacity ? std::optional<size_t>( bit ) : std::nullopt;
+}
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "catalua_type_operators.h"
+#include "flag_bits.h"
 #include "translations.h"
 #include "type_id.h"
 
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <bitset>
+#include <cstddef>
+#include <optional>
+
+#include "type_id.h"
+
+/**
+ * Flags as bits, so testing for one is a bit lookup instead of a search of a set.
+ * A flag's bit is its int id, which holds while the game data is loaded.  Flags whose
+ * id is past @ref capacity (only ever defined by large mods) have no bit, and must be
+ * looked up in the set the bits were made from.
+ */
+namespace flag_bits
+{
+constexpr size_t capacity = 512;
+using bitset = std::bitset<capacity>;
+
+/** The bit of @p f, or nothing if it has none or isn't a loaded flag. */
+auto position( const flag_id &f ) -> std::optional<size_t>;
+
+template<typename Flags>
+auto of( const Flags &flags ) -> bitset
+{
+    bitset result;
+    for( const flag_id &f : flags ) {
+        if( const std::optional<size_t> bit = position( f ) ) {
+            result.set( *bit );
+        }
+    }
+    return result;
+}
+} // namespace flag_bits
@@ -0,0 +1,364 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace cata
+{
+
+/**
+ * std::hash with its result run through a 64-bit finalizer.
+ *
+ * std::hash of the point types (and so of every coords:: point) is a multiply-add of the
+ * coordinates, whose low bits depend mostly on x.  Mixing every input bit into every output
+ * bit lets a power-of-two table index by masking.
+ */
+template<typename T>
+struct flat_hash {
+    auto operator()( const T &v ) const noexcept -> std::size_t {
+        auto x = static_cast<std::uint64_t>( std::hash<T> {}( v ) );
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= x >> 33;
+        return static_cast<std::size_t>( x );
+    }
+};
+
+namespace flat_hash_detail
+{
+
+struct key_of_pair {
+    template<typename Pair>
+    auto operator()( const Pair &p ) const noexcept -> const auto & {
+        return p.first;
+    }
+};
+
+struct key_of_self {
+    template<typename Key>
+    auto operator()( const Key &k ) const noexcept -> const Key & {
+        return k;
+    }
+};
+
+/**
+ * Values in one contiguous array, found through an open-addressing table of indices into it.
+ *
+ * The index table is probed linearly and kept at most half full; being four bytes a slot,
+ * that costs little next to the values.  Erasing moves the last value into the gap, so
+ * iteration order is insertion order until the first erase, and erasing invalidates
+ * iterators to the last value as well as the erased one.
+ */
+template<typename Value, typename Key, typename KeyOf, typename Hash, typename KeyEqual>
+class table
+{
+    private:
+        using storage = std::vector<Value>;
+
+    public:
+        using key_type = Key;
+        using value_type = Value;
+        using size_type = std::size_t;
+        using hasher = Hash;
+        using key_equal = KeyEqual;
+        using const_iterator = typename storage::const_iterator;
+        // Sets hand out only const iterators, like std::unordered_set
+        using iterator = std::conditional_t<std::is_same_v<Value, Key>, const_iterator,
+              typename storage::iterator>;
+
+        auto begin() noexcept -> iterator {
+            return values.begin();
+        }
+        auto end() noexcept -> iterator {
+            return values.end();
+        }
+        auto begin() const noexcept -> const_iterator {
+            return values.begin();
+        }
+        auto end() const noexcept -> const_iterator {
+            return values.end();
+        }
+        auto cbegin() const noexcept -> const_iterator {
+            return values.cbegin();
+        }
+        auto cend() const noexcept -> const_iterator {
+            return values.cend();
+        }
+
+        auto size() const noexcept -> size_type {
+            return values.size();
+        }
+        auto empty() const noexcept -> bool {
+            return values.empty();
+        }
+        void clear() noexcept {
+            values.clear();
+            slots.clear();
+        }
+        /** Makes room for @p n values without growing again. */
+        void reserve( const size_type n ) {
+            values.reserve( n );
+            if( slots_for( n ) > slots.size() ) {
+                rehash( slots_for( n ) );
+            }
+        }
+
+        auto find( const Key &key ) -> iterator {
+            const auto slot = find_slot( key );
+            return slot == npos || slots[slot] == none ? end() : begin() + slots[slot];
+        }
+        auto find( const Key &key ) const -> const_iterator {
+            const auto slot = find_slot( key );
+            return slot == npos || slots[slot] == none ? end() : begin() + slots[slot];
+        }
+        auto contains( const Key &key ) const -> bool {
+            const auto slot = find_slot( key );
+            return slot != npos && slots[slot] != none;
+        }
+        auto count( const Key &key ) const -> size_type {
+            return contains( key ) ? 1 : 0;
+        }
+
+        auto erase( const Key &key ) -> size_type {
+            const auto slot = find_slot( key );
+            if( slot == npos || slots[slot] == none ) {
+                return 0;
+            }
+            erase_slot( slot );
+            return 1;
+        }
+        /** Returns an iterator to the value moved into @p pos, or end() if it was the last. */
+        auto erase( const_iterator pos ) -> iterator {
+            const auto index = pos - cbegin();
+            erase_slot( find_slot( KeyOf {}( *pos ) ) );
+            return begin() + index;
+        }
+
+        friend auto operator==( const table &lhs, const table &rhs ) -> bool {
+            if( lhs.size() != rhs.size() ) {
+                return false;
+            }
+            for( const Value &v : lhs ) {
+                const auto it = rhs.find( KeyOf {}( v ) );
+                if( it == rhs.end() || !( *it == v ) ) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+    protected:
+        /** Constructs a value from @p args unless one with @p key is already present. */
+        template<typename... Args>
+        auto emplace_unique( const Key &key, Args &&... args ) -> std::pair<iterator, bool> {
+            if( slots_for( values.size() + 1 ) > slots.size() ) {
+                rehash( slots_for( values.size() + 1 ) );
+            }
+            const auto slot = find_slot( key );
+            if( slots[slot] != none ) {
+                return { begin() + slots[slot], false };
+            }
+            values.emplace_back( std::forward<Args>( args )... );
+            slots[slot] = static_cast<std::uint32_t>( values.size() - 1 );
+            return { end() - 1, true };
+        }
+
+    private:
+        static constexpr std::uint32_t none = UINT32_MAX;
+        static constexpr size_type npos = SIZE_MAX;
+
+        static auto slots_for( const size_type n ) -> size_type {
+            return std::max<size_type>( 8, std::bit_ceil( n * 2 ) );
+        }
+
+        auto home_slot( const Key &key ) const -> size_type {
+            return Hash {}( key ) & ( slots.size() - 1 );
+        }
+
+        /** Slot holding the key, the empty slot where it would go, or npos if there are none. */
+        auto find_slot( const Key &key ) const -> size_type {
+            if( slots.empty() ) {
+                return npos;
+            }
+            const auto mask = slots.size() - 1;
+            for( auto slot = home_slot( key );; slot = ( slot + 1 ) & mask ) {
+                if( slots[slot] == none || KeyEqual {}( KeyOf {}( values[slots[slot]] ), key ) ) {
+                    return slot;
+                }
+            }
+        }
+
+        void rehash( const size_type slot_count ) {
+            slots.assign( slot_count, none );
+            const auto mask = slot_count - 1;
+            for( std::uint32_t i = 0; i < values.size(); ++i ) {
+                auto slot = home_slot( KeyOf {}( values[i] ) );
+                while( slots[slot] != none ) {
+                    slot = ( slot + 1 ) & mask;
+                }
+                slots[slot] = i;
+            }
+        }
+
+        void erase_slot( size_type hole ) {
+            const auto mask = slots.size() - 1;
+            const auto index = slots[hole];
+            // Shift back later members of the probe run that may fill the hole, so lookups
+            // never need tombstones
+            for( auto next = ( hole + 1 ) & mask; slots[next] != none; next = ( next + 1 ) & mask ) {
+                const auto home = home_slot( KeyOf {}( values[slots[next]] ) );
+                if( ( ( next - home ) & mask ) >= ( ( next - hole ) & mask ) ) {
+                    slots[hole] = slots[next];
+                    hole = next;
+                }
+            }
+            slots[hole] = none;
+
+            const auto last = static_cast<std::uint32_t>( values.size() - 1 );
+            if( index != last ) {
+                auto slot = home_slot( KeyOf {}( values[last] ) );
+                while( slots[slot] != last ) {
+                    slot = ( slot + 1 ) & mask;
+                }
+                slots[slot] = index;
+                values[index] = std::move( values[last] );
+            }
+            values.pop_back();
+        }
+
+        storage values;
+        /** Indices into values, or none; the size is zero or a power of two. */
+        std::vector<std::uint32_t> slots;
+};
+
+} // namespace flat_hash_detail
+
+/**
+ * Hash map for small, cheaply compared keys such as the coords:: points, as a drop-in for
+ * the std::unordered_map uses on hot paths.
+ *
+ * Values are `std::pair<Key, T>` rather than `std::pair<const Key, T>`; keys must not be
+ * changed through iterators.  See @ref flat_hash_detail::table for iterator invalidation.
+ */
+template<typename Key, typename T, typename Hash = flat_hash<Key>,
+         typename KeyEqual = std::equal_to<Key>>
+class flat_hash_map : public
+    flat_hash_detail::table<std::pair<Key, T>, Key, flat_hash_detail::key_of_pair, Hash, KeyEqual>
+{
+    private:
+        using base = flat_hash_detail::table<std::pair<Key, T>, Key, flat_hash_detail::key_of_pair,
+              Hash, KeyEqual>;
+
+    public:
+        using mapped_type = T;
+        using typename base::value_type;
+        using typename base::iterator;
+        using typename base::const_iterator;
+
+        flat_hash_map() = default;
+        flat_hash_map( std::initializer_list<value_type> init ) {
+            insert( init.begin(), init.end() );
+        }
+
+        template<typename... Args>
+        auto try_emplace( const Key &key, Args &&... args ) -> std::pair<iterator, bool> {
+            return this->emplace_unique( key, std::piecewise_construct, std::forward_as_tuple( key ),
+                                         std::forward_as_tuple( std::forward<Args>( args )... ) );
+        }
+        template<typename M>
+        auto emplace( const Key &key, M &&mapped ) -> std::pair<iterator, bool> {
+            return try_emplace( key, std::forward<M>( mapped ) );
+        }
+        auto insert( const value_type &v ) -> std::pair<iterator, bool> {
+            return this->emplace_unique( v.first, v );
+        }
+        auto insert( value_type &&v ) -> std::pair<iterator, bool> {
+            const Key key = v.first;
+            return this->emplace_unique( key, std::move( v ) );
+        }
+        template<typename InputIt>
+        void insert( InputIt first, InputIt last ) {
+            for( ; first != last; ++first ) {
+                insert( *first );
+            }
+        }
+        template<typename M>
+        auto insert_or_assign( const Key &key, M &&mapped ) -> std::pair<iterator, bool> {
+            auto result = try_emplace( key, std::forward<M>( mapped ) );
+            if( !result.second ) {
+                result.first->second = std::forward<M>( mapped );
+            }
+            return result;
+        }
+
+        auto operator[]( const Key &key ) -> T & {
+            return try_emplace( key ).first->second;
+        }
+        auto at( const Key &key ) -> T & {
+            const auto it = this->find( key );
+            if( it == this->end() ) {
+                throw std::out_of_range( "cata::flat_hash_map::at" );
+            }
+            return it->second;
+        }
+        auto at( const Key &key ) const -> const T & {
+            const auto it = this->find( key );
+            if( it == this->end() ) {
+                throw std::out_of_range( "cata::flat_hash_map::at" );
+            }
+            return it->second;
+        }
+};
+
+/** Hash set counterpart of @ref flat_hash_map. */
+template<typename Key, typename Hash = flat_hash<Key>, typename KeyEqual = std::equal_to<Key>>
+class flat_hash_set : public
+    flat_hash_detail::table<Key, Key, flat_hash_detail::key_of_self, Hash, KeyEqual>
+{
+    private:
+        using base = flat_hash_detail::table<Key, Key, flat_hash_detail::key_of_self, Hash, KeyEqual>;
+
+    public:
+        using typename base::value_type;
+        using typename base::iterator;
+
+        flat_hash_set() = default;
+        flat_hash_set( std::initializer_list<Key> init ) {
+            insert( init.begin(), init.end() );
+        }
+        template<typename InputIt>
+        flat_hash_set( InputIt first, InputIt last ) {
+            insert( first, last );
+        }
+
+        auto insert( const Key &key ) -> std::pair<iterator, bool> {
+            return this->emplace_unique( key, key );
+        }
+        template<typename InputIt>
+        void insert( InputIt first, InputIt last ) {
+            if constexpr( std::forward_iterator<InputIt> ) {
+                this->reserve( this->size() + std::distance( first, last ) );
+            }
+            for( ; first != last; ++first ) {
+                insert( *first );
+            }
+        }
+        template<typename... Args>
+        auto emplace( Args &&... args ) -> std::pair<iterator, bool> {
+            return insert( Key( std::forward<Args>( args )... ) );
+        }
+};
+
+} // namespace cata
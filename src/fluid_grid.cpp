@@ -183,6 +183,7 @@ auto clear_transformer_last_run_at( const tripoint_abs_ms &p ) -> void
     }
 
     target_submap->transformer_last_run.erase( target_pos );
+    target_submap->mark_modified();
 }
 
 auto volume_from_charges( const itype_id &liquid_type, int charges ) -> units::volume
@@ -1018,6 +1019,12 @@ class fluid_grid_tracker
         mapbuffer &mb;
         std::optional<half_open_rectangle<point_abs_sm>> bounds;
         std::set<tripoint_abs_omt> grids_requiring_updates;
+        /**
+         * When each of @ref grids_requiring_updates next has a transformer due, nullopt if never.
+         * Grids without an entry are run on the next update.  Any structure change drops
+         * them all, since it may merge or split grids.
+         */
+        std::map<tripoint_abs_omt, std::optional<time_point>> transformers_due;
 
         auto is_within_bounds( const tripoint_abs_sm &sm ) const -> bool {
             return bounds && bounds->contains( sm.xy() );
@@ -1025,6 +1032,7 @@ class fluid_grid_tracker
 
         auto rebuild_transformer_grids() -> void {
             grids_requiring_updates.clear();
+            transformers_due.clear();
             if( !bounds ) {
                 return;
             }
@@ -1044,6 +1052,7 @@ class fluid_grid_tracker
             if( !bounds ) {
                 return;
             }
+            transformers_due.clear();
             const auto base = project_to<coords::sm>( omt_pos );
             const auto submaps = std::array<tripoint_abs_sm, 4> {
                 base + point_zero,
@@ -1120,7 +1129,11 @@ class fluid_grid_tracker
                 return;
             }
             std::ranges::for_each( grids_requiring_updates, [&]( const tripoint_abs_omt & omt_pos ) {
-                fluid_grid::process_transformers_at( omt_pos, to );
+                const auto due = transformers_due.find( omt_pos );
+                if( due != transformers_due.end() && ( !due->second || to < *due->second ) ) {
+                    return;
+                }
+                transformers_due[omt_pos] = fluid_grid::process_transformers_at( omt_pos, to );
             } );
         }
 
@@ -1196,12 +1209,14 @@ class fluid_grid_tracker
                 auto liquid_item = item::spawn( entry.first, calendar::turn );
                 liquid_item->charges = liquid_item->charges_per_volume( entry.second );
                 items.push_back( std::move( liquid_item ) );
+                target_submap->note_item_added( target_pos );
             } );
         }
 
         auto clear() -> void {
             parent_storage_grids.clear();
             grids_requiring_updates.clear();
+            transformers_due.clear();
             bounds.reset();
         }
 };
@@ -1409,18 +1424,33 @@ auto purify_water( const tripoint_abs_omt &p ) -> units::volume
     return dirty_volume;
 }
 
-auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> void
+auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> std::optional<time_point>
 {
     const auto grid = grid_at( p );
     if( grid.empty() ) {
-        return;
+        return std::nullopt;
     }
 
     auto &mbuf = MAPBUFFER_REGISTRY.get( get_map().get_bound_dimension() );
     auto transformers = collect_transformers( grid, mbuf );
     if( transformers.empty() ) {
-        return;
+        return std::nullopt;
     }
+    // Transformers run on whole ticks of their interval, counted from turn zero
+    const auto next_due = [&]() -> std::optional<time_point> {
+        auto due = std::optional<time_point> {};
+        std::ranges::for_each( transformers, [&]( const transformer_instance & inst )
+        {
+            const auto interval = to_turns<int>( inst.config->tick_interval );
+            if( interval <= 0 ) {
+                return;
+            }
+            const auto last_run = to_turn<int>( transformer_last_run_at( inst.pos ) );
+            const auto next = time_point::from_turn( ( last_run / interval + 1 ) * interval );
+            due = due ? std::min( *due, next ) : next;
+        } );
+        return due;
+    };
 
     auto &storage = get_fluid_grid_tracker().storage_at( p );
     auto state = storage.get_state();
@@ -1491,7 +1521,7 @@ auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> void
         std::ranges::for_each( processed_transformers, [&]( const tripoint_abs_ms & pos ) {
             set_transformer_last_run_at( pos, to );
         } );
-        return;
+        return next_due();
     }
 
     auto total_inputs_ml = std::map<itype_id, double> {};
@@ -1537,7 +1567,7 @@ auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> void
     }
 
     if( scale <= 0.0 ) {
-        return;
+        return next_due();
     }
 
     std::ranges::for_each( requests, [&]( const transform_request & request ) {
@@ -1608,6 +1638,7 @@ auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> void
     std::ranges::for_each( processed_transformers, [&]( const tripoint_abs_ms & pos ) {
         set_transformer_last_run_at( pos, to );
     } );
+    return next_due();
 }
 
 auto update( time_point to ) -> void
@@ -1701,6 +1732,7 @@ auto on_tank_removed( const tripoint_abs_ms &p ) -> void
         auto liquid_item = item::spawn( entry.first, calendar::turn );
         liquid_item->charges = liquid_item->charges_per_volume( entry.second );
         items.push_back( std::move( liquid_item ) );
+        target_submap->note_item_added( target_pos );
     } );
 }
 
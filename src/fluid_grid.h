@@ -2,6 +2,7 @@
 
 #include <bitset>
 #include <map>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <string>
@@ -85,7 +86,11 @@ auto seed_liquid_charges_for_mapgen( const seed_liquid_mapgen_opts &options ) ->
 auto drain_liquid_charges( const tripoint_abs_omt &p, const itype_id &liquid_type,
                            int charges ) -> int;
 auto purify_water( const tripoint_abs_omt &p ) -> units::volume;
-auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> void;
+/**
+ * Run the transformers on the grid at @p p up to @p to.  Returns when one of them next
+ * comes due, nullopt if none ever will.
+ */
+auto process_transformers_at( const tripoint_abs_omt &p, time_point to ) -> std::optional<time_point>;
 auto update( time_point to ) -> void;
 auto bind_dimension( const dimension_id &dim_id ) -> void;
 auto load( const map &m ) -> void;
@@ -0,0 +1,233 @@
+#include "frame_timing.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include "thread_pool.h"
+#include "turn_recorder.h"
+
+namespace frame_timing
+{
+
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+
+struct open_phase {
+    group g;
+    const char *name;
+    clock::time_point resumed;
+    alloc_profiling::counts resumed_allocs;
+    float ms = 0.0f;
+    alloc_profiling::counts allocs;
+};
+
+bool recording = false;
+// Bumped on every toggle, so phases opened before it don't close later ones.
+unsigned session = 0;
+frame_history recorded;
+frame_sample current;
+clock::time_point frame_start;
+std::vector<open_phase> open_phases;
+
+auto ms_between( const clock::time_point from, const clock::time_point to ) -> float
+{
+    return std::chrono::duration<float, std::milli>( to - from ).count();
+}
+
+void charge( const group g, const char *const name, const float ms,
+             const alloc_profiling::counts &allocs )
+{
+    turn_recorder::charge( g, name, ms );
+    if( !recording ) {
+        return;
+    }
+    current.group_ms[static_cast<size_t>( g )] += ms;
+    if( g == group::input ) {
+        return;
+    }
+    auto it = std::ranges::find( current.phase_ms, name, &std::pair<const char *, float>::first );
+    if( it == current.phase_ms.end() ) {
+        current.phase_ms.emplace_back( name, ms );
+    } else {
+        it->second += ms;
+    }
+    if constexpr( alloc_profiling::compiled_in ) {
+        using phase_counts = std::pair<const char *, alloc_profiling::counts>;
+        auto alloc_it = std::ranges::find( current.phase_allocs, name, &phase_counts::first );
+        if( alloc_it == current.phase_allocs.end() ) {
+            current.phase_allocs.emplace_back( name, allocs );
+        } else {
+            alloc_it->second += allocs;
+        }
+    }
+}
+
+} // namespace
+
+auto group_name( const group g ) -> const char *
+{
+    switch( g ) {
+        case group::input:
+            return "input";
+        case group::turn:
+            return "do_turn";
+        case group::map_draw:
+            return "map draw";
+        case group::ui_redraw:
+            return "ui redraw";
+        case group::present:
+            return "present";
+        case group::num_groups:
+            break;
+    }
+    return "other";
+}
+
+auto frame_sample::busy_ms() const -> float
+{
+    return std::max( 0.0f, total_ms - group_ms[static_cast<size_t>( group::input )] );
+}
+
+void frame_history::push( frame_sample sample )
+{
+    if( frames.size() == capacity ) {
+        frames.pop_front();
+    }
+    frames.push_back( std::move( sample ) );
+}
+
+void frame_history::clear()
+{
+    frames.clear();
+}
+
+auto frame_history::percentile( const float fraction ) const -> float
+{
+    if( frames.empty() ) {
+        return 0.0f;
+    }
+    std::vector<float> busy;
+    busy.reserve( frames.size() );
+    for( const frame_sample &f : frames ) {
+        busy.push_back( f.busy_ms() );
+    }
+    // Nearest rank, so the result is always a frame that actually happened.
+    const auto rank = static_cast<size_t>( std::ceil( std::clamp( fraction, 0.0f, 1.0f ) * busy.size() ) );
+    const auto nth = busy.begin() + std::max<size_t>( rank, 1 ) - 1;
+    std::nth_element( busy.begin(), nth, busy.end() );
+    return *nth;
+}
+
+auto frame_history::stutters() const -> int
+{
+    const float threshold = std::max( stutter_min_ms, 2.0f * percentile( 0.5f ) );
+    return static_cast<int>( std::ranges::count_if( frames, [threshold]( const frame_sample & f ) {
+        return f.busy_ms() > threshold;
+    } ) );
+}
+
+auto frame_history::slowest_phases( const size_t count ) const ->
+std::vector<std::pair<const char *, float>>
+{
+    std::map<const char *, float> totals;
+    for( const frame_sample &f : frames ) {
+        for( const auto &[name, ms] : f.phase_ms ) {
+            totals[name] += ms;
+        }
+    }
+    std::vector<std::pair<const char *, float>> result( totals.begin(), totals.end() );
+    std::ranges::sort( result, []( const auto & a, const auto & b ) {
+        return a.second > b.second;
+    } );
+    if( result.size() > count ) {
+        result.resize( count );
+    }
+    return result;
+}
+
+auto enabled() -> bool
+{
+    return recording;
+}
+
+void set_enabled( const bool enable )
+{
+    recording = enable;
+    ++session;
+    recorded.clear();
+    current = frame_sample();
+    open_phases.clear();
+    frame_start = clock::now();
+}
+
+auto history() -> const frame_history &
+{
+    return recorded;
+}
+
+void end_frame()
+{
+    if( !recording ) {
+        return;
+    }
+    const clock::time_point now = clock::now();
+    const alloc_profiling::counts allocs_now = alloc_profiling::this_thread();
+    // Phases spanning frames are charged to the frame they were running in.
+    for( open_phase &p : open_phases ) {
+        if( &p == &open_phases.back() ) {
+            p.ms += ms_between( p.resumed, now );
+            p.resumed = now;
+            p.allocs += allocs_now - p.resumed_allocs;
+            p.resumed_allocs = allocs_now;
+        }
+        charge( p.g, p.name, p.ms, p.allocs );
+        p.ms = 0.0f;
+        p.allocs = alloc_profiling::counts();
+    }
+    current.total_ms = ms_between( frame_start, now );
+    frame_start = now;
+    recorded.push( std::move( current ) );
+    current = frame_sample();
+}
+
+scoped_phase::scoped_phase( const group g, const char *const name )
+    : active( ( recording || turn_recorder::in_turn() ) && !is_pool_worker_thread() )
+    , opened_in( session )
+{
+    if( !active ) {
+        return;
+    }
+    const clock::time_point now = clock::now();
+    const alloc_profiling::counts allocs_now = alloc_profiling::this_thread();
+    if( !open_phases.empty() ) {
+        open_phase &outer = open_phases.back();
+        outer.ms += ms_between( outer.resumed, now );
+        outer.allocs += allocs_now - outer.resumed_allocs;
+    }
+    open_phases.push_back( open_phase{ g, name, now, allocs_now } );
+}
+
+scoped_phase::~scoped_phase()
+{
+    // Toggling the overlay drops phases that were open at the time; the turn recorder
+    // loses them too, for that one turn.
+    if( !active || opened_in != session || open_phases.empty() ) {
+        return;
+    }
+    const clock::time_point now = clock::now();
+    const alloc_profiling::counts allocs_now = alloc_profiling::this_thread();
+    const open_phase done = open_phases.back();
+    open_phases.pop_back();
+    auto allocs = done.allocs;
+    allocs += allocs_now - done.resumed_allocs;
+    charge( done.g, done.name, done.ms + ms_between( done.resumed, now ), allocs );
+    if( !open_phases.empty() ) {
+        open_phases.back().resumed = now;
+        open_phases.back().resumed_allocs = allocs_now;
+    }
+}
+
+} // namespace frame_timing
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <utility>
+#include <vector>
+
+#include "alloc_profiling.h"
+#include "profile.h"
+
+/**
+ * Wall clock breakdown of recent frames, for the frame timing overlay.
+ *
+ * Time is charged to the innermost open @ref frame_timing::scoped_phase, so nested
+ * phases don't count twice: waiting for input inside do_turn shows up as input, not
+ * as turn processing.  A frame ends each time the display is presented.
+ */
+namespace frame_timing
+{
+
+enum class group : int {
+    input,
+    turn,
+    map_draw,
+    ui_redraw,
+    present,
+    num_groups
+};
+
+inline constexpr auto num_groups = static_cast<size_t>( group::num_groups );
+
+auto group_name( group g ) -> const char *;
+
+struct frame_sample {
+    // Wall time since the previous frame ended
+    float total_ms = 0.0f;
+    std::array<float, num_groups> group_ms = {};
+    // Exclusive time of each named phase that ran this frame, except input waits
+    std::vector<std::pair<const char *, float>> phase_ms;
+    // Allocations on the main thread by the same phases, with CATA_ALLOC_PROFILING only
+    std::vector<std::pair<const char *, alloc_profiling::counts>> phase_allocs;
+
+    /** Time not spent waiting for input, which is what a player perceives as lag. */
+    auto busy_ms() const -> float;
+};
+
+/** The last @ref capacity frames and their statistics. */
+class frame_history
+{
+    public:
+        static constexpr size_t capacity = 240;
+
+        void push( frame_sample sample );
+        void clear();
+        auto samples() const -> const std::deque<frame_sample> & {
+            return frames;
+        }
+
+        /** Busy time that @p fraction of the recorded frames stay within. */
+        auto percentile( float fraction ) const -> float;
+        /**
+         * Frames whose busy time is both over @ref stutter_min_ms and over twice the median,
+         * so consistently slow frames aren't all counted.
+         */
+        auto stutters() const -> int;
+        /** Named phases by their total time over the recorded frames, slowest first. */
+        auto slowest_phases( size_t count ) const -> std::vector<std::pair<const char *, float>>;
+
+        static constexpr float stutter_min_ms = 1000.0f / 30.0f;
+
+    private:
+        std::deque<frame_sample> frames;
+};
+
+auto enabled() -> bool;
+void set_enabled( bool enable );
+auto history() -> const frame_history &;
+
+/** Closes the current frame and records it, if the overlay is enabled. */
+void end_frame();
+
+/** Charges the time until it goes out of scope to @p g under @p name. */
+class scoped_phase
+{
+    public:
+        scoped_phase( group g, const char *name );
+        ~scoped_phase();
+        scoped_phase( const scoped_phase & ) = delete;
+        scoped_phase &operator=( const scoped_phase & ) = delete;
+
+    private:
+        bool active;
+        unsigned opened_in;
+};
+
+} // namespace frame_timing
+
+#define FRAME_TIMING_CONCAT_( a, b ) a##b
+#define FRAME_TIMING_CONCAT( a, b ) FRAME_TIMING_CONCAT_( a, b )
+
+/** @ref ZoneScopedN that is also timed as part of @p grp of the frame timing overlay. */
+#define ZoneScopedPhaseN( grp, name ) \
+    ZoneScopedN( name ); \
+    const frame_timing::scoped_phase FRAME_TIMING_CONCAT( frame_phase_, __LINE__ )( frame_timing::group::grp, name )
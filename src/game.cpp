@@ -98,6 +98,7 @@
 #include "filesystem.h"
 #include "flag_trait.h"
 #include "flag.h"
+#include "frame_timing.h"
 #include "fstream_utils.h"
 #include "game_constants.h"
 #include "game_inventory.h"
@@ -139,6 +140,7 @@
 #include "mapsharing.h"
 #include "memorial_logger.h"
 #include "memory_fast.h"
+#include "memory_usage.h"
 #include "messages.h"
 #include "mission.h"
 #include "mod_manager.h"
@@ -194,6 +196,8 @@
 #include "translations.h"
 #include "travel/travel_destination.h"
 #include "trap.h"
+#include "turn_recorder.h"
+#include "turn_task_graph.h"
 #include "ui.h"
 #include "ui_manager.h"
 #include "uistate.h"
@@ -443,7 +447,6 @@ extern bool add_key_to_quick_shortcuts( int key, const std::string &category, bo
 //The one and only game instance
 std::unique_ptr<game> g;
 
-std::atomic<uint32_t> g_npc_friends_dirty_version{ 1 };
 uint32_t g_npcmove_attitude_epoch{ 0 };
 
 //The one and only uistate instance
@@ -503,6 +506,7 @@ game::game() :
     events().subscribe( &*memorial_logger_ptr );
     events().subscribe( &*achievements_tracker_ptr );
     events().subscribe( &*spell_events_ptr );
+    events().set_defer_events( true );
     world_generator = std::make_unique<worldfactory>();
     // do nothing, everything that was in here is moved to init_data() which is called immediately after g = new game; in main.cpp
     // The reason for this move is so that g is not uninitialized when it gets to installing the parts into vehicles.
@@ -757,6 +761,7 @@ auto game::release_active_load_regions() -> void
 {
     m.release_active_load_region();
     lazy_border_region_.release();
+    prefetch_region_.release();
 }
 
 auto game::update_active_load_regions( const dimension_id &dim_id,
@@ -784,6 +789,65 @@ auto game::update_active_load_regions( const dimension_id &dim_id,
     }
 }
 
+auto game::update_prefetch_region() -> void
+{
+    ZoneScoped;
+    // Turns of travel the prefetch request covers ahead of the bubble.
+    static constexpr auto prefetch_horizon_turns = 4.0f;
+    // How many route steps ahead auto-travel looks to pick a heading.
+    static constexpr auto prefetch_route_steps = std::size_t{ 3 };
+
+    if( !predictive_prefetch_enabled || !m.has_active_load_region() ) {
+        prefetch_region_.release();
+        return;
+    }
+
+    auto heading = point_zero;
+    auto tiles_per_turn = 0.0f;
+    if( u.in_vehicle && u.controlling_vehicle ) {
+        if( const vehicle *veh = veh_pointer_or_null( m.veh_at( u.bub_pos() ) ) ) {
+            // Snap to the nearest of the 8 directions: sin( 22.5 degrees ) ~= 0.38.
+            const auto snap = []( const float c ) {
+                return c > 0.38f ? 1 : c < -0.38f ? -1 : 0;
+            };
+            const auto dir = veh->dir_vec();
+            const auto sign = veh->velocity < 0 ? -1 : 1;
+            heading = point( snap( dir.x ) * sign, snap( dir.y ) * sign );
+            tiles_per_turn = std::abs( veh->velocity ) / vehicles::cmps_per_tile;
+        }
+    }
+    // A planned route knows about upcoming turns, so it wins over the current heading.
+    if( u.has_destination() && !u.omt_path.empty() ) {
+        const auto steps = std::min( prefetch_route_steps, u.omt_path.size() );
+        const auto delta = u.omt_path[u.omt_path.size() - steps].xy() - u.abs_omt_pos().xy();
+        if( delta != point_rel_omt::zero() ) {
+            heading = point( delta.x(), delta.y() );
+        }
+        tiles_per_turn = std::max( tiles_per_turn, 1.0f );
+    }
+
+    const auto lookahead = std::min( g_mapsize,
+                                     static_cast<int>( tiles_per_turn * prefetch_horizon_turns / SEEX ) );
+    const auto bubble_begin = player_reality_bubble_origin().xy();
+    const auto bubble_end = bubble_begin + point_rel_sm( g_mapsize, g_mapsize );
+    const auto bounds = prefetch_bounds_ahead( bubble_begin, bubble_end, heading, lookahead );
+    if( !bounds ) {
+        prefetch_region_.release();
+        return;
+    }
+    // Moving the request on a heading change drops queued jobs that are no longer ahead.
+    if( !prefetch_region_ ) {
+        prefetch_region_ = mapbuffer_load_region( {
+            .buffer = MAPBUFFER_REGISTRY.get( m.get_bound_dimension() ),
+            .source = load_request_source::prefetch,
+            .begin = bounds->first,
+            .end = bounds->second,
+        } );
+    } else {
+        prefetch_region_.update( bounds->first, bounds->second );
+    }
+}
+
 void game::load_map( const point_abs_sm &pos_sm, const bool pump_events )
 {
     // Bind the map to the target dimension BEFORE m.load() so loadn() uses the
@@ -1349,7 +1413,6 @@ void game::load_npcs()
         } else if( temp->get_mapbuffer().add_active_npc( temp ) ) {
             active_npc.push_back( temp );
             just_added.push_back( temp );
-            ++g_npc_friends_dirty_version;
         }
     }
 
@@ -1370,33 +1433,29 @@ void game::load_npcs()
                    pos.y() >= req.begin.y() && pos.y() < req.end.y();
         };
 
-        for( auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
-            const tripoint_abs_sm center_z( request_center.x(),
-                                            request_center.y(), z );
-            for( const auto &temp : overmap_buffer.get_npcs_near(
-                     center_z, search_distance ) ) {
-                temp->set_dimension( req.dim_id );
-                const auto id = temp->getID();
-                const auto already_active = std::ranges::any_of( active_npc,
-                [id]( const shared_ptr_fast<npc> &n ) {
-                    return n->getID() == id;
-                } );
-                if( already_active || temp->is_active() ) {
-                    continue;
-                }
-                const auto sm_loc = project_to<coords::sm>( temp->abs_pos() );
-                if( !contains_request( sm_loc.xy() ) ||
-                    buffer.get_submap( sm_loc ) == nullptr ||
-                    !place_npc_on_absolute_mapbuffer( *temp, buffer ) ) {
-                    continue;
-                }
-                if( temp->marked_for_death ) {
-                    temp->die( nullptr );
-                } else if( temp->get_mapbuffer().add_active_npc( temp ) ) {
-                    active_npc.push_back( temp );
-                    just_added.push_back( temp );
-                    ++g_npc_friends_dirty_version;
-                }
+        // One query over every z-level; the NPC index visits only the request's submaps
+        const tripoint_abs_sm center_all_z( request_center, INT_MIN );
+        for( const auto &temp : overmap_buffer.get_npcs_near( center_all_z, search_distance ) ) {
+            temp->set_dimension( req.dim_id );
+            const auto id = temp->getID();
+            const auto already_active = std::ranges::any_of( active_npc,
+            [id]( const shared_ptr_fast<npc> &n ) {
+                return n->getID() == id;
+            } );
+            if( already_active || temp->is_active() ) {
+                continue;
+            }
+            const auto sm_loc = project_to<coords::sm>( temp->abs_pos() );
+            if( !contains_request( sm_loc.xy() ) ||
+                buffer.get_submap( sm_loc ) == nullptr ||
+                !place_npc_on_absolute_mapbuffer( *temp, buffer ) ) {
+                continue;
+            }
+            if( temp->marked_for_death ) {
+                temp->die( nullptr );
+            } else if( temp->get_mapbuffer().add_active_npc( temp ) ) {
+                active_npc.push_back( temp );
+                just_added.push_back( temp );
             }
         }
     }
@@ -1987,13 +2046,15 @@ auto game::advance_time_action_tick() -> int
 // Returns true if game is over (death, saved, quit, etc)
 bool game::do_turn()
 {
-    ZoneScopedN( "game::do_turn" );
+    const turn_recorder::scoped_turn recorded_turn( to_turn<int>( calendar::turn ) );
+    ZoneScopedPhaseN( turn, "game::do_turn" );
     const auto reset_time_action_tick = on_out_of_scope( [this]() {
         action_time_scale::set_calendar_turns_this_tick_to_next_tick(
             time_action_scale_turn_remainder );
     } );
     {
-        ZoneScopedN( "do_turn_initial_cleanup" );
+        ZoneScopedPhaseN( turn, "do_turn_initial_cleanup" );
+        events().flush_deferred();
         cleanup_arenas();
         if( is_game_over() ) {
             return cleanup_at_end();
@@ -2009,7 +2070,7 @@ bool game::do_turn()
     const auto monperf = asleep && get_option<bool>( "SLEEP_SKIP_MON" );
     const auto npcperf = asleep && get_option<bool>( "SLEEP_SKIP_NPC" );
     {
-        ZoneScopedN( "do_turn_population_plots" );
+        ZoneScopedPhaseN( turn, "do_turn_population_plots" );
         TracyPlot( "Total Monsters", static_cast<int64_t>( critter_tracker->size() ) );
         auto total_npcs = int64_t{ 0 };
         auto simulated_npcs = int64_t{ 0 };
@@ -2024,10 +2085,15 @@ bool game::do_turn()
         }
         TracyPlot( "Total NPCs", total_npcs );
         TracyPlot( "Total Simulated NPCs", simulated_npcs );
+        get_thread_pool().plot_stats();
+        // Walks every resident submap, so only while a profiler is there to see it
+        if( TracyIsConnected && calendar::once_every( 10_turns ) ) {
+            memory_usage::plot( memory_usage::collect() );
+        }
     }
     // Actual stuff
     {
-        ZoneScopedN( "do_turn_calendar" );
+        ZoneScopedPhaseN( turn, "do_turn_calendar" );
         if( new_game ) {
             new_game = false;
         } else {
@@ -2044,7 +2110,7 @@ bool game::do_turn()
     // Mark visibility dirty for this turn. Lightmap dirtiness is derived from
     // dynamic light state in build_map_cache and from explicit map mutations.
     {
-        ZoneScopedN( "do_turn_invalidate_visibility" );
+        ZoneScopedPhaseN( turn, "do_turn_invalidate_visibility" );
         m.invalidate_visibility_caches();
         mon_info_cache_dirty = true;
     }
@@ -2052,21 +2118,21 @@ bool game::do_turn()
     // starting a new turn, clear out temperature cache
     weather_manager &weather = get_weather();
     {
-        ZoneScopedN( "do_turn_clear_temp_cache" );
+        ZoneScopedPhaseN( turn, "do_turn_clear_temp_cache" );
         weather.clear_temp_cache();
     }
 
     if( npcs_dirty ) {
-        ZoneScopedN( "do_turn_load_npcs" );
+        ZoneScopedPhaseN( turn, "do_turn_load_npcs" );
         load_npcs();
     }
 
     {
-        ZoneScopedN( "do_turn_timed_events" );
+        ZoneScopedPhaseN( turn, "do_turn_timed_events" );
         timed_events.process();
     }
     {
-        ZoneScopedN( "do_turn_missions" );
+        ZoneScopedPhaseN( turn, "do_turn_missions" );
         mission::process_all();
     }
     // If controlling a vehicle that is owned by someone else
@@ -2081,13 +2147,13 @@ bool game::do_turn()
         u.check_mount_is_spooked();
     }
     if( action_time_scale::once_every_this_tick( 1_days ) ) {
-        ZoneScopedN( "do_turn_overmap_mongroups" );
+        ZoneScopedPhaseN( turn, "do_turn_overmap_mongroups" );
         get_overmapbuffer( current_dimension_id_ ).process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( action_time_scale::once_every_this_tick( time_duration::from_minutes( 2.5 ) ) ) {
-        ZoneScopedN( "do_turn_overmap_hordes" );
+        ZoneScopedPhaseN( turn, "do_turn_overmap_hordes" );
         get_overmapbuffer( current_dimension_id_ ).move_hordes();
         if( u.has_trait( trait_HAS_NEMESIS ) ) {
             get_overmapbuffer( current_dimension_id_ ).move_nemesis();
@@ -2100,7 +2166,7 @@ bool game::do_turn()
     debug_hour_timer.print_time();
 
     {
-        ZoneScopedN( "do_turn_update_body" );
+        ZoneScopedPhaseN( turn, "do_turn_update_body" );
         u.update_body( action_time_scale::calendar_duration_this_tick() );
     }
 
@@ -2108,25 +2174,25 @@ bool game::do_turn()
     if( get_option<bool>( "AUTOSAVE" ) &&
         action_time_scale::once_every_this_tick( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
-        ZoneScopedN( "do_turn_autosave" );
+        ZoneScopedPhaseN( turn, "do_turn_autosave" );
         autosave();
     }
 
     {
-        ZoneScopedN( "do_turn_weather_update" );
+        ZoneScopedPhaseN( turn, "do_turn_weather_update" );
         weather.update_weather();
         reset_light_level();
     }
 
     {
-        ZoneScopedN( "do_turn_pre_action_updates" );
+        ZoneScopedPhaseN( turn, "do_turn_pre_action_updates" );
         perhaps_add_random_npc();
         process_voluntary_act_interrupt();
         process_activity();
         update_performance_bubble();
     }
     if( !soundperf ) {
-        ZoneScopedN( "do_turn_player_sound" );
+        ZoneScopedPhaseN( turn, "do_turn_player_sound" );
         // Sound information and is broken up into three main blocks: Player, Monsters, NPCs
         // Player is special in that they are immediatly informed of the sounds they made on their turn for displayed sound marker purposes
         // Each sound block is generally a map::cull_heard_sounds(), feeding the AI in question remaining sounds, and then moving said AI.
@@ -2144,7 +2210,7 @@ bool game::do_turn()
 
     if( !u.has_effect( effect_sleep ) || uquit == QUIT_WATCH ) {
         if( u.moves > 0 || uquit == QUIT_WATCH ) {
-            ZoneScopedN( "do_turn_player_action_loop" );
+            ZoneScopedPhaseN( turn, "do_turn_player_action_loop" );
             while( u.moves > 0 || uquit == QUIT_WATCH ) {
                 cleanup_dead();
                 mon_info_update();
@@ -2167,7 +2233,7 @@ bool game::do_turn()
                 const auto moves_before_action = u.moves;
                 auto handled_action = false;
                 {
-                    ZoneScopedN( "do_turn_handle_action" );
+                    ZoneScopedPhaseN( turn, "do_turn_handle_action" );
                     handled_action = handle_action();
                 }
                 if( handled_action ) {
@@ -2205,7 +2271,7 @@ bool game::do_turn()
     }
 
     if( driving_view_offset.x != 0 || driving_view_offset.y != 0 ) {
-        ZoneScopedN( "do_turn_driving_offset" );
+        ZoneScopedPhaseN( turn, "do_turn_driving_offset" );
         // Still have a view offset, but might not be driving anymore,
         // or the option has been deactivated,
         // might also happen when someone dives from a moving car.
@@ -2216,7 +2282,7 @@ bool game::do_turn()
 
     // No-scent debug mutation has to be processed here or else it takes time to start working
     {
-        ZoneScopedN( "do_turn_scent" );
+        ZoneScopedPhaseN( turn, "do_turn_scent" );
         if( !u.has_active_bionic( bionic_id( "bio_scent_mask" ) ) &&
             !u.has_trait( trait_id( "DEBUG_NOSCENT" ) ) ) {
             scent.set( u.bub_pos(), u.scent, u.get_type_of_scent() );
@@ -2227,52 +2293,87 @@ bool game::do_turn()
 
     // We need floor cache before checking falling 'n stuff
     {
-        ZoneScopedN( "do_turn_build_floor_caches" );
+        ZoneScopedPhaseN( turn, "do_turn_build_floor_caches" );
         m.build_floor_caches();
     }
 
     if( !vehperf ) {
-        ZoneScopedN( "do_turn_vehicle_physics" );
+        ZoneScopedPhaseN( turn, "do_turn_vehicle_physics" );
         m.process_falling();
         autopilot_vehicles();
         m.vehmove();
     }
     {
-        ZoneScopedN( "do_turn_process_items" );
+        ZoneScopedPhaseN( turn, "do_turn_process_items" );
         m.process_items();
     }
     {
-        ZoneScopedN( "do_turn_creature_in_field" );
+        ZoneScopedPhaseN( turn, "do_turn_creature_in_field" );
         m.creature_in_field( u );
     }
     {
-        ZoneScopedN( "do_turn_distribution_trackers" );
-        for( auto &[dim_id, tracker_ptr] : grid_trackers_ ) {
-            if( tracker_ptr ) {
-                tracker_ptr->update( calendar::turn );
-            }
-        }
-    }
-    {
-        ZoneScopedN( "do_turn_dimension_ticks" );
-        tick_portal_links();
-        tick_temporary_pocket_dimensions();
-        tick_vehicle_portal_taps();
-    }
-    {
-        ZoneScopedN( "do_turn_fluid_grid" );
-        fluid_grid::update( calendar::turn );
+        ZoneScopedPhaseN( turn, "do_turn_world_systems" );
+        // Built once; the phases go through g rather than capturing this, since
+        // the game object can be replaced (e.g. between test cases).
+        using res = turn_resource;
+        static auto world_systems = []() {
+            auto graph = std::make_unique<turn_task_graph>( "do_turn_world_systems" );
+            graph->add( {
+                .name = "do_turn_distribution_trackers",
+                .reads = { res::calendar, res::avatar, res::mapbuffer },
+                .writes = { res::power_grids, res::map_items, res::map_terrain },
+                .run = []() {
+                    for( auto &[dim_id, tracker_ptr] : g->grid_trackers_ ) {
+                        if( tracker_ptr ) {
+                            tracker_ptr->update( calendar::turn );
+                        }
+                    }
+                },
+            } );
+            graph->add( {
+                .name = "do_turn_portal_links",
+                .reads = { res::calendar },
+                .writes = { res::power_grids, res::portals },
+                .run = []() { g->tick_portal_links(); },
+            } );
+            graph->add( {
+                .name = "do_turn_pocket_dimensions",
+                .reads = { res::calendar },
+                .writes = { res::avatar, res::portals, res::messages },
+                .run = []() { g->tick_temporary_pocket_dimensions(); },
+            } );
+            graph->add( {
+                .name = "do_turn_vehicle_portal_taps",
+                .reads = { res::portals },
+                .writes = { res::vehicles, res::power_grids },
+                .run = []() { g->tick_vehicle_portal_taps(); },
+            } );
+            graph->add( {
+                .name = "do_turn_fluid_grid",
+                .reads = { res::calendar, res::mapbuffer, res::overmap },
+                .writes = { res::fluid_grids, res::map_items },
+                .run = []() { fluid_grid::update( calendar::turn ); },
+            } );
+            return graph;
+        }();
+        world_systems->run();
     }
 
     // Update vision caches for monsters. If this turns out to be expensive,
     // consider a stripped down cache just for monsters.
+    // Pipelined GPU lighting is dispatched here instead of at draw time, so it runs
+    // while monsters and NPCs move and is finished by the first visibility update.
     {
-        ZoneScopedN( "do_turn_monster_visibility_cache" );
-        m.build_map_cache( get_levz(), true );
+        ZoneScopedPhaseN( turn, "do_turn_monster_visibility_cache" );
+        if( pipeline_gpu_lighting ) {
+            m.build_map_cache( get_levz(), false, true );
+        } else {
+            m.build_map_cache( get_levz(), true );
+        }
     }
     // This has to be done after updating our map caches, as sound propagation relies on terrain.
     if( !soundperf ) {
-        ZoneScopedN( "do_turn_sound_before_monsters" );
+        ZoneScopedPhaseN( turn, "do_turn_sound_before_monsters" );
         // Cull stale sounds that have been heard by everyone. Should nominally catch all stale sounds made by the player on the prior turn.
         m.cull_heard_sounds();
         // Apply sounds from previous turn to monster AI.
@@ -2281,12 +2382,12 @@ bool game::do_turn()
     }
 
     if( !monperf ) {
-        ZoneScopedN( "do_turn_monmove" );
+        ZoneScopedPhaseN( turn, "do_turn_monmove" );
         monmove();
     }
 
     if( !soundperf ) {
-        ZoneScopedN( "do_turn_sound_before_npcs" );
+        ZoneScopedPhaseN( turn, "do_turn_sound_before_npcs" );
         // Cull any noises that have already been heard by everyone. This should generally cull all stale sounds made by monsters on the prior turn.
         m.cull_heard_sounds();
         // Batch floodfill sounds made by monsters or other qued sources.
@@ -2297,73 +2398,77 @@ bool game::do_turn()
     }
 
     if( !npcperf ) {
-        ZoneScopedN( "do_turn_npcmove" );
+        ZoneScopedPhaseN( turn, "do_turn_npcmove" );
         npcmove();
     } else {
-        ZoneScopedN( "do_turn_sleep_skip_npc_process" );
+        ZoneScopedPhaseN( turn, "do_turn_sleep_skip_npc_process" );
         sleep_skip_npc_process();
     }
     if( action_time_scale::once_every_this_tick( 5_minutes ) ) {
-        ZoneScopedN( "do_turn_overmap_npc_move" );
+        ZoneScopedPhaseN( turn, "do_turn_overmap_npc_move" );
         overmap_npc_move();
     }
 
     if( !soundperf ) {
-        ZoneScopedN( "do_turn_sound_after_npcs" );
+        ZoneScopedPhaseN( turn, "do_turn_sound_after_npcs" );
         // Floodfill any sounds cued up by NPCs during their respective turns or from other sources.
         m.batch_flood_fill_sounds();
     }
     // We want to clear our floodfill que anyways, so that sounds dont accumulate in the que if soundperf is on.
     // This function will also print a debug sound diagnostic to the log if !soundperf.
     {
-        ZoneScopedN( "do_turn_clear_floodfill" );
+        ZoneScopedPhaseN( turn, "do_turn_clear_floodfill" );
         sounds::clear_floodfill_que( soundperf );
     }
     {
-        ZoneScopedN( "do_turn_update_stair_monsters" );
+        ZoneScopedPhaseN( turn, "do_turn_update_stair_monsters" );
         update_stair_monsters();
     }
     {
-        ZoneScopedN( "do_turn_final_mon_info_update" );
+        ZoneScopedPhaseN( turn, "do_turn_final_mon_info_update" );
         mon_info_update();
     }
     {
-        ZoneScopedN( "do_turn_player_process_turn" );
+        ZoneScopedPhaseN( turn, "do_turn_player_process_turn" );
         u.process_turn();
     }
 
     {
-        ZoneScopedN( "do_turn_lua_every_x" );
+        ZoneScopedPhaseN( turn, "do_turn_lua_every_x" );
         cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
     }
+    {
+        ZoneScopedPhaseN( turn, "do_turn_lua_tasks" );
+        cata::run_lua_tasks( *DynamicDataLoader::get_instance().lua );
+    }
 
     {
-        ZoneScopedN( "do_turn_explosions" );
+        ZoneScopedPhaseN( turn, "do_turn_explosions" );
         explosion_handler::get_explosion_queue().execute();
     }
     {
-        ZoneScopedN( "do_turn_cleanup_dead" );
+        ZoneScopedPhaseN( turn, "do_turn_cleanup_dead" );
         cleanup_dead();
     }
 
     if( u.moves < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
-        ZoneScopedN( "do_turn_force_redraw" );
+        ZoneScopedPhaseN( turn, "do_turn_force_redraw" );
         ui_manager::redraw();
         refresh_display();
     }
 
     if( get_levz() >= 0 && !u.is_underwater() ) {
-        ZoneScopedN( "do_turn_weather_effects" );
+        ZoneScopedPhaseN( turn, "do_turn_weather_effects" );
         handle_weather_effects( weather.weather_id );
     }
 
     {
-        ZoneScopedN( "do_turn_wait_activity_redraw" );
+        ZoneScopedPhaseN( turn, "do_turn_wait_activity_redraw" );
         handle_wait_activity_redraw();
     }
 
     {
-        ZoneScopedN( "do_turn_bodytemp_wetness" );
+        ZoneScopedPhaseN( turn, "do_turn_bodytemp_wetness" );
         u.update_bodytemp( m, weather );
         character_funcs::update_body_wetness( u, get_weather().get_precise() );
         u.apply_wetness_morale( weather.temperature );
@@ -2373,7 +2478,7 @@ bool game::do_turn()
         sfx::remove_hearing_loss();
     }
     {
-        ZoneScopedN( "do_turn_sfx" );
+        ZoneScopedPhaseN( turn, "do_turn_sfx" );
         sfx::do_danger_music();
         sfx::do_vehicle_engine_sfx();
         sfx::do_vehicle_exterior_engine_sfx();
@@ -2382,7 +2487,7 @@ bool game::do_turn()
 
     // Tick all loaded submaps: fields for every submap, items/vehicles for batch-eligible ones.
     {
-        ZoneScopedN( "do_turn_world_tick" );
+        ZoneScopedPhaseN( turn, "do_turn_world_tick" );
         world_tick();
     }
 
@@ -2392,20 +2497,25 @@ bool game::do_turn()
     // Ensure trackers exist for all active dimensions before update() fires
     // on_submap_loaded events (mirrors the logic in load_map / update_map).
     for( const auto &dim_id : submap_loader.active_dimensions() ) {
-        ZoneScopedN( "do_turn_ensure_distribution_trackers" );
+        ZoneScopedPhaseN( turn, "do_turn_ensure_distribution_trackers" );
         ensure_distribution_grid_tracker_for( dim_id );
     }
     {
-        ZoneScopedN( "do_turn_lazy_border_focus" );
+        ZoneScopedPhaseN( turn, "do_turn_lazy_border_focus" );
+        update_prefetch_region();
         submap_loader.update_lazy_border_focus( current_dimension_id_, u.abs_pos() );
     }
     {
-        ZoneScopedN( "do_turn_submap_loader_update" );
+        ZoneScopedPhaseN( turn, "do_turn_submap_loader_update" );
         submap_loader.update( is_draw_tiles_mode() );
     }
+    {
+        ZoneScopedPhaseN( turn, "do_turn_lazy_border_simulation" );
+        submap_loader.process_lazy_border_simulation();
+    }
     // Destroy trackers for non-primary dimensions with no remaining tracked submaps.
     {
-        ZoneScopedN( "do_turn_cleanup_distribution_trackers" );
+        ZoneScopedPhaseN( turn, "do_turn_cleanup_distribution_trackers" );
         for( auto it = grid_trackers_.begin(); it != grid_trackers_.end(); ) {
             if( !it->first.is_empty() && !it->second->has_tracked_submaps() ) {
                 submap_loader.remove_listener( it->second.get() );
@@ -2416,10 +2526,10 @@ bool game::do_turn()
         }
     }
 
-    // Finally, clear pathfinding cache
+    // Finally, release pathfinding caches nobody used this turn
     {
-        ZoneScopedN( "do_turn_clear_pathfinding" );
-        Pathfinding::clear_d_maps();
+        ZoneScopedPhaseN( turn, "do_turn_clear_pathfinding" );
+        Pathfinding::end_turn();
     }
 
     return false;
@@ -2542,6 +2652,22 @@ auto game::has_activity_skip_blocking_npc_state() -> bool
     return npcs_dirty;
 }
 
+auto game::has_activity_skip_aware_hostile() -> bool
+{
+    for( monster &mon : all_monsters() ) {
+        if( mon.attack_target() == &u ||
+            ( mon.attitude_to( u ) == Attitude::A_HOSTILE && mon.sees( u ) ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+auto game::is_activity_skip_sleep() -> bool
+{
+    return u.has_effect( effect_sleep ) && ( !u.activity || !*u.activity );
+}
+
 auto game::has_activity_skip_relevant_vehicle() -> bool
 {
     return std::ranges::any_of( m.get_vehicles(), []( const wrapped_vehicle & wrapped ) {
@@ -2603,14 +2729,19 @@ auto game::can_activity_fixed_window_skip( const time_duration &duration ) -> bo
     if( debug_infinite_speed_can_freeze_time() ) {
         return false;
     }
-    if( !u.activity || !*u.activity || u.activity->complete() || u.has_destination() ||
-        u.is_mounted() ) {
+    if( u.has_destination() || u.is_mounted() ) {
         return false;
     }
-    if( u.activity->id() == ACT_AUTODRIVE || !u.activity->rooted() ||
-        !u.activity->has_idle_bubble_effect() || u.activity->has_special_turns() ||
-        !u.activity->assistants().empty() ) {
-        return false;
+    // Sleep has no activity of its own; it ends when the sleep effect does
+    if( !is_activity_skip_sleep() ) {
+        if( !u.activity || !*u.activity || u.activity->complete() ) {
+            return false;
+        }
+        if( u.activity->id() == ACT_AUTODRIVE || !u.activity->rooted() ||
+            !u.activity->has_idle_bubble_effect() || u.activity->has_special_turns() ||
+            !u.activity->assistants().empty() ) {
+            return false;
+        }
     }
     if( u.in_vehicle && u.controlling_vehicle ) {
         return false;
@@ -2631,6 +2762,10 @@ auto game::can_activity_fixed_window_skip( const time_duration &duration ) -> bo
     if( has_activity_skip_blocking_npc_state() ) {
         return false;
     }
+    // A sleeper can't react to anything, so don't skip past a hostile closing in
+    if( is_activity_skip_sleep() && has_activity_skip_aware_hostile() ) {
+        return false;
+    }
     return true;
 }
 
@@ -2658,11 +2793,12 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
     ZoneScopedN( "activity_fixed_window_execute" );
     auto skipped_turns = 0;
     weather_manager &weather = get_weather();
-    const auto starting_activity = u.activity->id();
+    const auto sleeping = is_activity_skip_sleep();
+    const auto starting_activity = sleeping ? activity_id::NULL_ID() : u.activity->id();
     auto activity_monsters = activity_monmove_cache {};
     const auto requested_turns = to_turns<int>( duration );
     while( skipped_turns < requested_turns ) {
-        if( is_game_over() || !u.activity || !*u.activity ) {
+        if( is_game_over() || ( !sleeping && ( !u.activity || !*u.activity ) ) ) {
             break;
         }
 
@@ -2707,12 +2843,20 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
 
         debug_hour_timer.print_time();
         u.update_body( action_time_scale::calendar_duration_this_tick() );
-        process_voluntary_act_interrupt();
-        if( !u.activity || !*u.activity ) {
-            break;
+        if( sleeping ) {
+            // Loud enough noises wake the sleeper, which ends the skip below
+            m.cull_heard_sounds();
+            sounds::process_sound_markers( &u );
+            if( action_time_scale::once_every_this_tick( 1_hours ) ) {
+                add_artifact_dreams();
+            }
+        } else {
+            process_voluntary_act_interrupt();
+            if( !u.activity || !*u.activity ) {
+                break;
+            }
+            process_activity();
         }
-
-        process_activity();
         if( is_game_over() ) {
             break;
         }
@@ -2720,8 +2864,8 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
             activity_fixed_window_force_normal_turn_ = true;
             break;
         }
-        const auto activity_continues = u.activity && *u.activity &&
-                                        u.activity->id() == starting_activity;
+        const auto activity_continues = sleeping || ( u.activity && *u.activity &&
+                                        u.activity->id() == starting_activity );
 
         if( m.has_field_at( u.bub_pos() ) ) {
             m.creature_in_field( u );
@@ -2757,6 +2901,11 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
                     break;
                 }
             }
+            if( sleeping && action_time_scale::once_every_this_tick( 1_minutes ) &&
+                has_activity_skip_aware_hostile() ) {
+                activity_fixed_window_force_normal_turn_ = true;
+                break;
+            }
         }
 
         {
@@ -2767,6 +2916,10 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
             ZoneScopedN( "do_turn_lua_every_x" );
             cata::run_on_every_x_hooks( *DynamicDataLoader::get_instance().lua );
         }
+        {
+            ZoneScopedN( "do_turn_lua_tasks" );
+            cata::run_lua_tasks( *DynamicDataLoader::get_instance().lua );
+        }
         explosion_handler::get_explosion_queue().execute();
         cleanup_dead();
 
@@ -2778,7 +2931,8 @@ auto game::execute_activity_fixed_window_skip( const time_duration &duration ) -
         u.apply_wetness_morale( weather.temperature );
         u.volume = 0;
 
-        if( !activity_continues || u.activity->complete() ) {
+        if( sleeping ? !u.has_effect( effect_sleep ) :
+            !activity_continues || u.activity->complete() ) {
             break;
         }
     }
@@ -2838,7 +2992,8 @@ auto game::try_activity_fixed_window_skip() -> bool
         activity_fixed_window_force_normal_turn_ = false;
         return false;
     }
-    if( !u.activity || !*u.activity || calendar::turn < next_activity_fixed_window_check_ ) {
+    if( ( ( !u.activity || !*u.activity ) && !is_activity_skip_sleep() ) ||
+        calendar::turn < next_activity_fixed_window_check_ ) {
         return false;
     }
     const auto duration = activity_fixed_window_duration();
@@ -2870,7 +3025,8 @@ auto game::handle_wait_activity_redraw( const bool force ) -> void
         wait_redraw = true;
         wait_message = _( "Wait till you wake up…" );
         wait_refresh_rate = 30_minutes;
-        if( action_time_scale::once_every_this_tick( 1_hours ) ) {
+        // Forced redraws end a fixed-window skip, which has had its dreams already
+        if( !force && action_time_scale::once_every_this_tick( 1_hours ) ) {
             add_artifact_dreams();
         }
     } else if( u.has_destination() ) {
@@ -2887,11 +3043,26 @@ auto game::handle_wait_activity_redraw( const bool force ) -> void
     }
     if( wait_redraw ) {
         ZoneScopedN( "wait_redraw" );
-        if( force || first_redraw_since_waiting_started ||
-            action_time_scale::once_every_this_tick( std::min( 1_minutes, wait_refresh_rate ) ) ) {
-            if( force || first_redraw_since_waiting_started ||
-                action_time_scale::once_every_this_tick( wait_refresh_rate ) ) {
+        const auto immediate = force || first_redraw_since_waiting_started;
+        wait_popup_pending_ |= action_time_scale::once_every_this_tick(
+                                   std::min( 1_minutes, wait_refresh_rate ) );
+        wait_redraw_pending_ |= action_time_scale::once_every_this_tick( wait_refresh_rate );
+        // Turns of a long activity can pass far faster than anyone can watch them, so
+        // redraws that come due are held until enough real time has passed.  Driving
+        // redraws every turn and is left alone.
+        const auto throttled = wait_refresh_rate > 1_turns;
+        const auto now = std::chrono::steady_clock::now();
+        const auto popup_gap = activity_time_cadence::popup_min_wall_interval();
+        const auto redraw_gap = activity_time_cadence::render_min_wall_interval();
+        const auto waited = [&]( const std::chrono::steady_clock::time_point last,
+        const std::chrono::milliseconds interval ) {
+            return !throttled || now - last >= interval;
+        };
+        if( immediate || ( wait_popup_pending_ && waited( last_wait_popup_, popup_gap ) ) ) {
+            if( immediate || ( wait_redraw_pending_ && waited( last_wait_redraw_, redraw_gap ) ) ) {
                 ui_manager::redraw();
+                wait_redraw_pending_ = false;
+                last_wait_redraw_ = now;
             }
 
             ui_adaptor dummy( ui_adaptor::disable_uis_below {} );
@@ -2900,10 +3071,14 @@ auto game::handle_wait_activity_redraw( const bool force ) -> void
             ui_manager::redraw();
             refresh_display();
             first_redraw_since_waiting_started = false;
+            wait_popup_pending_ = false;
+            last_wait_popup_ = now;
         }
     } else {
         wait_popup.reset();
         first_redraw_since_waiting_started = true;
+        wait_redraw_pending_ = false;
+        wait_popup_pending_ = false;
     }
 }
 
@@ -3489,7 +3664,9 @@ input_context get_default_mode_input_context()
     ctxt.register_action( "debug_submap_grid" );
     ctxt.register_action( "debug_sound_absorption" );
     ctxt.register_action( "debug_sound_walls" );
+    ctxt.register_action( "debug_pathfinding_heat" );
     ctxt.register_action( "debug_hour_timer" );
+    ctxt.register_action( "debug_frame_timing" );
     ctxt.register_action( "debug_mode" );
     if( use_tiles ) {
         ctxt.register_action( "zoom_out" );
@@ -3952,8 +4129,10 @@ bool game::load( const save_t &name )
 
     get_weather().nextweather = calendar::turn;
 
-    get_active_world()->read_from_file( name.base_path() + SAVE_EXTENSION_LOG,
-                                        std::bind( &memorial_logger::load, &memorial(), _1 ), true );
+    memorial().load( [&]( const std::string & suffix, file_read_fn reader ) {
+        return get_active_world()->read_from_file( name.base_path() + SAVE_EXTENSION_LOG + suffix,
+                reader, true );
+    } );
 
 #if defined(__ANDROID__)
     get_active_world()->read_from_file( name.base_path() + SAVE_EXTENSION_SHORTCUTS,
@@ -4111,6 +4290,7 @@ bool game::save_maps()
         // save_all() dispatches dimension saves in parallel; each slot uses
         // notify_tracker=is_primary and show_progress=false (worker-thread safe).
         MAPBUFFER_REGISTRY.save_all(); // can throw
+        submap_loader.on_maps_saved();
         return true;
     } catch( const std::exception &err ) {
         popup( _( "Failed to save the maps: %s" ), err.what() );
@@ -4125,10 +4305,9 @@ bool game::save_player_data()
         serialize( fout );
     }, _( "player data" ) );
     const bool saved_map_memory = u.save_map_memory();
-    const bool saved_log = world->write_to_player_file( SAVE_EXTENSION_LOG, [&](
-    std::ostream & fout ) {
-        fout << memorial().dump();
-    }, _( "player memorial" ) );
+    const bool saved_log = memorial().save( [&]( const std::string & suffix, file_write_fn writer ) {
+        return world->write_to_player_file( SAVE_EXTENSION_LOG + suffix, writer, _( "player memorial" ) );
+    } );
 #if defined(__ANDROID__)
     const bool saved_shortcuts = world->write_to_player_file( SAVE_EXTENSION_SHORTCUTS, [&](
     std::ostream & fout ) {
@@ -4209,6 +4388,14 @@ bool game::save( bool quitting )
             world_generator->active_world->info->add_save( save_t::from_save_id( u.get_save_id() ) );
 
             auto duration = world->commit_save_tx();
+            if( quitting ) {
+                try {
+                    world->flush_map_writes();
+                } catch( const std::exception &err ) {
+                    popup( _( "Failed to save map data: %s" ), err.what() );
+                    return false;
+                }
+            }
             add_msg( m_info, _( "World Saved (took %dms)." ), duration );
             return true;
         }
@@ -4436,6 +4623,12 @@ shared_ptr_fast<ui_adaptor> game::create_or_get_main_ui_adaptor()
 
 void game::invalidate_main_ui_adaptor() const
 {
+#if defined(TILES)
+    // The map may have changed under the view, so it can't be reused from the last frame.
+    if( tilecontext ) {
+        tilecontext->invalidate_retained_frame();
+    }
+#endif
     shared_ptr_fast<ui_adaptor> ui = main_ui_adaptor.lock();
     if( ui ) {
         ui->invalidate_ui();
@@ -5667,7 +5860,10 @@ int game::tier_assign_all()
             new_tier = 2;
         } else {
             const int dist = rl_dist( mon.bub_pos(), player_pos );
-            if( dist <= tier01_dist || !mon.is_wandering() ) {
+            if( dist <= tier01_dist || !mon.is_wandering() || mon.lod_alerted ) {
+                new_tier = 0;
+            } else if( u.sees( mon ) ) {
+                // Whatever the player can watch acts at full fidelity.
                 new_tier = 0;
             } else if( dist <= tier12_dist ) {
                 new_tier = 1;
@@ -5689,6 +5885,7 @@ int game::tier_assign_all()
         if( mon.lod_cooldown > 0 ) {
             mon.lod_cooldown--;
         }
+        mon.lod_alerted = false;
 
         tier_counts[mon.lod_tier]++;
     }
@@ -5702,11 +5899,47 @@ int game::tier_assign_all()
 }
 
 // World tick — processes ALL loaded submaps every turn.
+// How often a dormant pocket dimension is caught up, and how long those catch-ups may take per turn.
+static const time_duration dormant_dimension_interval = 1_minutes;
+static constexpr auto dormant_dimension_budget = std::chrono::microseconds { 1000 };
+
+auto game::is_dimension_active( const dimension_id &dim ) const -> bool
+{
+    if( dim.is_empty() || dim == current_dimension_id_ ) {
+        return true;
+    }
+    // A live power portal couples the dimension to another one every turn.
+    const auto tracker = grid_trackers_.find( dim );
+    return tracker != grid_trackers_.end() && tracker->second &&
+    std::ranges::any_of( tracker->second->get_export_nodes(), []( const auto & node ) {
+        return !node.paused;
+    } );
+}
+
+auto game::catch_up_dimension( mapbuffer &mb ) -> void
+{
+    ZoneScoped;
+    mb.for_each_simulated_submap( [&]( const tripoint_abs_sm &, submap & sm ) {
+        const auto n = to_turns<int>( calendar::turn - sm.last_touched );
+        if( n > 0 ) {
+            if( pocket_simulation_level == pocket_sim_level::minimal ) {
+                batch_turns_field( sm, n );
+            } else if( pocket_simulation_level != pocket_sim_level::none ) {
+                run_submap_batch_turns( sm, n );
+            }
+        }
+        sm.last_touched = calendar::turn;
+    } );
+}
+
 void game::world_tick()
 {
     ZoneScoped;
     TracyPlot( "Active Dimensions", static_cast<int64_t>( loaded_dimensions_.size() ) );
 
+    const auto dormant_deadline = std::chrono::steady_clock::now() + dormant_dimension_budget;
+    auto total_dormant_dimensions = int64_t{ 0 };
+
     const auto fire_spread = reality_bubble_fire_spread;
     const auto do_emits = action_time_scale::once_every_this_tick( 10_seconds );
 
@@ -5722,21 +5955,78 @@ void game::world_tick()
     auto total_emitter_active_submaps = int64_t{ 0 };
     auto total_fire_request_submaps = int64_t{ 0 };
     auto total_field_count = int64_t{ 0 };
+    // Dimensions that get a full tick this turn.
+    struct dimension_tick {
+        dimension_id dim;
+        mapbuffer *mb = nullptr;
+        std::vector<tripoint_abs_sm> fire_submaps;
+        std::vector<tripoint_bub_ms> dirty;
+    };
+    std::vector<dimension_tick> ticking;
     MAPBUFFER_REGISTRY.for_each( [&]( const dimension_id & dim, mapbuffer & mb ) {
-        ZoneScopedN( "world_tick_dimension" );
-        ZoneText( dim.c_str(), dim.str().size() );
-
         // When pocket simulation is disabled, skip all non-primary dimensions.
         // The primary dimension always uses dim == "" (empty string).
-        // none/minimal/moderate distinctions are deferred to a future PR —
-        // for now any setting other than "off" runs the full simulation path.
         if( pocket_simulation_level == pocket_sim_level::off && !dim.is_empty() ) {
             return;
         }
 
+        // Below "full", a pocket nobody is in and no portal is drawing on sleeps, and is
+        // only caught up with batch turns every dormant_dimension_interval, while the
+        // turn's budget lasts.  Waking up catches it up one last time before full ticks.
+        if( pocket_simulation_level != pocket_sim_level::full && !dim.is_empty() ) {
+            if( !is_dimension_active( dim ) ) {
+                ++total_dormant_dimensions;
+                auto &last = dormant_dimensions_.try_emplace( dim, calendar::turn ).first->second;
+                if( calendar::turn - last >= dormant_dimension_interval &&
+                    std::chrono::steady_clock::now() < dormant_deadline ) {
+                    ZoneScopedN( "world_tick_dormant_dimension" );
+                    catch_up_dimension( mb );
+                    last = calendar::turn;
+                }
+                return;
+            }
+            if( dormant_dimensions_.erase( dim ) > 0 ) {
+                catch_up_dimension( mb );
+            }
+        }
+        ticking.push_back( dimension_tick{ .dim = dim, .mb = &mb, .fire_submaps = {}, .dirty = {} } );
+    } );
+
+    // Fields of different dimensions run side by side: a dimension's field processing only
+    // touches the submaps of its own mapbuffer and draws from per-submap rng streams, while
+    // map cache invalidations are queued for this thread.  Everything else below (emitters,
+    // fire-spread requests, Lua) stays on the main thread, dimension by dimension.
+    // With a single dimension, its submaps are spread over the workers instead.
+    const auto parallel_fields = parallel_enabled && parallel_field_processing;
+    const auto fan_out = parallel_fields && ticking.size() > 1;
+    const auto process_fields = [&]( dimension_tick & t ) {
+        ZoneScopedN( "wtd_process_fields" );
+        t.fire_submaps = process_fields_in_submaps( t.dim, t.mb->simulated_submap_positions(), *t.mb,
+                         parallel_fields && !fan_out, fan_out ? &t.dirty : nullptr );
+        std::sort( t.fire_submaps.begin(), t.fire_submaps.end() );
+    };
+    if( fan_out ) {
+        parallel_for( "world_tick_dimensions", 0, static_cast<int>( ticking.size() ), [&]( const int i ) {
+            process_fields( ticking[i] );
+        } );
+    } else {
+        std::ranges::for_each( ticking, process_fields );
+    }
+
+    std::ranges::for_each( ticking, [&]( const dimension_tick & t ) {
+        ZoneScopedN( "world_tick_dimension" );
+        const dimension_id &dim = t.dim;
+        mapbuffer &mb = *t.mb;
+        ZoneText( dim.c_str(), dim.str().size() );
+        std::ranges::for_each( t.dirty, [&]( const tripoint_bub_ms & p ) {
+            m.set_transparency_cache_dirty( p );
+            m.set_seen_cache_dirty( p );
+        } );
+
         {
             ZoneScopedN( "world_tick_simulated_submaps" );
             total_loaded_submaps += static_cast<int64_t>( mb.loaded_submap_count() );
+            const auto &fire_submaps = t.fire_submaps;
             mb.for_each_simulated_submap( [&]( const tripoint_abs_sm & pos_sm, submap & sm ) {
                 ++total_simulated_submaps;
 
@@ -5747,11 +6037,8 @@ void game::world_tick()
                 }
                 total_field_count += sm.field_count;
 
-                auto has_fire = false;
-                if( sm.field_count > 0 ) {
-                    ZoneScopedN( "wtd_process_fields" );
-                    has_fire = process_fields_in_submap( dim, sm, pos_sm, mb );
-                }
+                const auto has_fire = std::binary_search( fire_submaps.begin(), fire_submaps.end(),
+                                      pos_sm );
                 sm.last_touched = calendar::turn;
 
                 // Furniture field emitters — covers all loaded submaps, not just the bubble.
@@ -5826,6 +6113,11 @@ void game::world_tick()
         }
     } );
 
+    std::erase_if( dormant_dimensions_, []( const auto & entry ) {
+        return !MAPBUFFER_REGISTRY.is_registered( entry.first );
+    } );
+
+    TracyPlot( "World Tick Dormant Dimensions", total_dormant_dimensions );
     TracyPlot( "World Tick Loaded Submaps", total_loaded_submaps );
     TracyPlot( "World Tick Simulated Submaps", total_simulated_submaps );
     TracyPlot( "World Tick No-Field Submaps", total_no_field_submaps );
@@ -5936,6 +6228,7 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
     // Configurable via Debug → Performance → "Monster LOD" settings.
     const int action_budget  = lod_action_budget;
     const int macro_interval = lod_macro_interval;
+    const int replan_interval = lod_coarse_replan_interval;
 
     // Dynamic budget: at least the floor, but expanded to cover all Tier-0
     // monsters so the cap never defers a full-AI monster.
@@ -6253,6 +6546,12 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
     // Compare against "LOD Tier 0 (Full AI)" to verify the budget floor is safe.
     TracyPlot( "LOD Eligible (post-cap)", static_cast<int64_t>( eligible.size() ) );
 
+    // Tier-1 monsters keep following their last plan for replan_interval turns,
+    // unless a sound or a hit since the tiers were assigned alerted them.
+    const auto reuses_last_plan = [&]( const monster & critter ) {
+        return critter.lod_tier == 1 && !critter.lod_alerted &&
+               current_turn < critter.lod_next_plan_turn;
+    };
     {
         ZoneScopedN( "monmove_build_plannable" );
         plannable.reserve( eligible.size() );
@@ -6266,6 +6565,7 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
                 critter->moves > 0 &&
                 critter->next_turn <= current_turn &&
                 critter->lod_tier < 2 &&
+                !reuses_last_plan( *critter ) &&
                 critter->is_simulated() ) {
                 plannable.push_back( critter );
             }
@@ -6280,7 +6580,7 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
         ZoneScopedN( "monmove_compute_plans" );
         if( parallel_enabled && parallel_monster_planning ) {
             ZoneScopedN( "monmove_compute_plans_parallel" );
-            parallel_for_chunked( 0, static_cast<int>( plannable.size() ),
+            parallel_for_chunked( "monster_plans", 0, static_cast<int>( plannable.size() ),
             monster_plan_chunk_size, [&]( int i ) {
                 precomputed[i] = plannable[i]->compute_plan( plan_ctx );
             } );
@@ -6300,6 +6600,27 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
         }
     }
 
+    // Routes the plans are expected to need, searched together so that ones towards
+    //   different destinations run on the pool instead of one by one during execution.
+    std::vector<RouteRequest> route_requests;
+    std::vector<int> plan_route( plannable.size(), -1 );
+    std::vector<std::vector<tripoint_abs_ms>> prefetched_routes;
+    if( !get_option<bool>( "USE_LEGACY_PATHFINDING" ) ) {
+        ZoneScopedN( "monmove_route_batch" );
+        for( const auto index : std::views::iota( size_t{ 0 }, plannable.size() ) ) {
+            if( plannable[index]->type->lua_ai.has_value() ) {
+                continue;
+            }
+            auto request = plannable[index]->plan_route_request( precomputed[index] );
+            if( request ) {
+                plan_route[index] = static_cast<int>( route_requests.size() );
+                route_requests.push_back( std::move( *request ) );
+            }
+        }
+        prefetched_routes = Pathfinding::route_batch( route_requests );
+    }
+    TracyPlot( "Monmove Batched Routes", static_cast<int64_t>( route_requests.size() ) );
+
     // LOD-D: execute each eligible monster's turn.
     // Bio-alarm helper — called after each monster finishes its move loop.
     // static const: string_id hash lookup happens once, not every turn.
@@ -6365,9 +6686,11 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
     auto monmove_move_iterations = int64_t{ 0 };
     auto monmove_preplans_used = int64_t{ 0 };
     auto monmove_fallback_plans = int64_t{ 0 };
+    auto monmove_reused_plans = int64_t{ 0 };
     auto monmove_serial_replans = int64_t{ 0 };
     auto monmove_controlled_moves = int64_t{ 0 };
     auto monmove_action_repath_requests = int64_t{ 0 };
+    auto monmove_prefetched_routes_used = int64_t{ 0 };
     auto monmove_action_route_candidates = int64_t{ 0 };
     auto monmove_action_idle = int64_t{ 0 };
     auto monmove_action_move = int64_t{ 0 };
@@ -6432,6 +6755,7 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
                 continue;
             }
             bool used_preplan = false;
+            auto route_index = -1;
             while( critter.moves > 0 && !critter.is_dead() &&
                    !critter.has_effect( effect_ridden ) ) {
                 ++monmove_move_iterations;
@@ -6439,8 +6763,12 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
                 const auto use_direct_monster_move =
                     critter.has_effect( effect_ai_controlled ) || critter.type->lua_ai.has_value();
                 if( !use_direct_monster_move ) {
-                    if( !used_preplan ) {
+                    if( reuses_last_plan( critter ) ) {
+                        // Goal and path are still those of the last plan
+                        ++monmove_reused_plans;
+                    } else if( !used_preplan ) {
                         used_preplan = true;
+                        critter.lod_next_plan_turn = current_turn + replan_interval;
                         const auto it = plan_index.find( &critter );
                         if( it == plan_index.end() ) {
                             ++monmove_fallback_plans;
@@ -6454,6 +6782,7 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
                                 ZoneScopedN( "monmove_apply_precomputed_plan" );
                                 critter.apply_plan( precomputed[it->second] );
                             }
+                            route_index = plan_route[it->second];
                         }
                     } else {
                         ++monmove_serial_replans;
@@ -6462,11 +6791,25 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
                             critter.plan();
                         }
                     }
-                    const monster_action_t action = [&critter]() {
+                    monster_action_t action = [&critter]() {
                         ZoneScopedN( "monmove_decide_action" );
                         return critter.decide_action();
                     }
                     ();
+                    if( route_index >= 0 && action.needs_repath &&
+                        action.kind == monster_action_kind::idle ) {
+                        // Only good for where the monster stood and aimed when it was found
+                        const RouteRequest &request = route_requests[route_index];
+                        if( request.from == bub_to_abs( critter.bub_pos() ) &&
+                            request.to == bub_to_abs( critter.move_target() ) ) {
+                            auto &route = action.prefetched_route.emplace();
+                            for( const tripoint_abs_ms &p : prefetched_routes[route_index] ) {
+                                route.push_back( abs_to_bub( p ) );
+                            }
+                            ++monmove_prefetched_routes_used;
+                        }
+                        route_index = -1;
+                    }
                     record_monmove_action( critter, action );
                     {
                         ZoneScopedN( "monmove_execute_action" );
@@ -6500,9 +6843,11 @@ void game::monmove( const monster_activity_ai_mode mode, activity_monmove_cache
     TracyPlot( "Monmove Move Iterations", monmove_move_iterations );
     TracyPlot( "Monmove Preplans Used", monmove_preplans_used );
     TracyPlot( "Monmove Fallback Plans", monmove_fallback_plans );
+    TracyPlot( "Monmove Reused Plans", monmove_reused_plans );
     TracyPlot( "Monmove Serial Replans", monmove_serial_replans );
     TracyPlot( "Monmove Controlled Moves", monmove_controlled_moves );
     TracyPlot( "Monmove Action Repath Requests", monmove_action_repath_requests );
+    TracyPlot( "Monmove Prefetched Routes Used", monmove_prefetched_routes_used );
     TracyPlot( "Monmove Action Route Candidates", monmove_action_route_candidates );
     TracyPlot( "Monmove Action Idle", monmove_action_idle );
     TracyPlot( "Monmove Action Move", monmove_action_move );
@@ -6553,6 +6898,19 @@ void game::npcmove()
     processing_npcs_ = true;
     const bool has_creature_do_turn_hooks = cata::has_hooks( "on_creature_do_turn" );
     const bool has_npc_do_turn_hooks = cata::has_hooks( "on_npc_do_turn" );
+    if( npc_field_of_view ) {
+        ZoneScopedN( "npc_fields_of_view" );
+        auto observers = std::vector<const Creature *> {};
+        for( const npc &guy : all_npcs() ) {
+            if( guy.is_simulated() && !guy.is_dead() ) {
+                observers.push_back( &guy );
+            }
+        }
+        m.remember_fields_of_view( observers );
+    }
+    if( parallel_enabled && parallel_npc_planning ) {
+        plan_npc_danger();
+    }
     for( npc &guy : g->all_npcs() ) {
         // Don't process NPCs in unloaded submaps like a LEMON
         if( !guy.is_simulated() ) {
@@ -6614,11 +6972,42 @@ void game::npcmove()
         if( !guy.is_dead() ) {
             guy.npc_update_body();
         }
+        // Plans are only valid for the turn they were computed in.
+        guy.pending_danger_plan.reset();
     }
     processing_npcs_ = false;
     cleanup_dead();
 }
 
+void game::plan_npc_danger()
+{
+    ZoneScoped;
+    // Snapshot raw pointers up front: workers must not touch shared_ptr refcounts.
+    auto monsters = std::vector<monster *> {};
+    for( const shared_ptr_fast<monster> &mon_ptr : critter_tracker->get_monsters_list() ) {
+        if( !mon_ptr->is_dead() ) {
+            monsters.push_back( mon_ptr.get() );
+        }
+    }
+    auto plannable = std::vector<npc *> {};
+    for( npc &guy : all_npcs() ) {
+        if( guy.is_simulated() && !guy.is_dead() ) {
+            // Refreshing the range cache mutates the NPC, so do it before planning.
+            if( !guy.confident_range_cache ) {
+                guy.invalidate_range_cache();
+            }
+            plannable.push_back( &guy );
+        }
+    }
+
+    // Workers skip the shared per-monster attitude cache; writing it from
+    // several NPCs at once would race.
+    const auto ctx = npc_plan_context{ .monsters = &monsters, .write_attitude_cache = false };
+    parallel_for( "npc_danger_plans", 0, static_cast<int>( plannable.size() ), [&]( int i ) {
+        plannable[i]->pending_danger_plan = plannable[i]->compute_danger_plan( ctx );
+    } );
+}
+
 void game::sleep_skip_npc_process()
 {
     // SLEEP_SKIP_NPC is active: NPC movement is suppressed while the player
@@ -6705,36 +7094,61 @@ void game::overmap_npc_move()
             travelling_npcs.push_back( npc_to_add );
         }
     }
-    for( auto &elem : travelling_npcs ) {
-        if( elem->has_omt_destination() ) {
-            if( !elem->omt_path.empty() && rl_dist( elem->omt_path.back(), elem->abs_omt_pos() ) > 2 ) {
-                //recalculate path, we got distracted doing something else probably
-                elem->omt_path.clear();
-            }
-            if( elem->omt_path.empty() ) {
-                const tripoint_abs_omt &from = elem->abs_omt_pos();
-                const tripoint_abs_omt &to = elem->goal;
-                elem->omt_path = get_overmapbuffer( elem->get_dimension() ).get_travel_path(
-                                     elem->abs_omt_pos(), elem->goal,
-                                     overmap_path_params::for_npc() );
-                if( elem->omt_path.empty() ) {
-                    add_msg( m_debug, "%s couldn't find overmap path from %s to %s",
-                             elem->get_name(), from.to_string(), to.to_string() );
-                    elem->goal = npc::no_goal_point;
-                    elem->mission = NPC_MISSION_NULL;
-                }
-            } else {
-                if( elem->omt_path.back() == elem->abs_omt_pos() ) {
-                    elem->omt_path.pop_back();
-                }
-                // TODO: fix point types
-                elem->travel_overmap(
-                    project_to<coords::sm>( elem->omt_path.back() ) );
+    std::erase_if( travelling_npcs, []( const npc * guy ) {
+        return !guy->has_omt_destination();
+    } );
+    if( travelling_npcs.empty() ) {
+        return;
+    }
+
+    // Everyone who needs a new path this turn is planned in one batch per dimension,
+    // so the searches run side by side and companions heading the same way share one.
+    std::map<dimension_id, std::vector<npc *>> unplanned;
+    std::unordered_set<const npc *> planned;
+    for( npc *elem : travelling_npcs ) {
+        if( !elem->omt_path.empty() && rl_dist( elem->omt_path.back(), elem->abs_omt_pos() ) > 2 ) {
+            //recalculate path, we got distracted doing something else probably
+            elem->omt_path.clear();
+        }
+        if( elem->omt_path.empty() ) {
+            unplanned[elem->get_dimension()].push_back( elem );
+            planned.insert( elem );
+        }
+    }
+    for( auto &[dim, npcs] : unplanned ) {
+        std::vector<std::pair<tripoint_abs_omt, tripoint_abs_omt>> trips;
+        trips.reserve( npcs.size() );
+        std::ranges::transform( npcs, std::back_inserter( trips ), []( const npc * guy ) {
+            return std::make_pair( guy->abs_omt_pos(), guy->goal );
+        } );
+        std::vector<std::vector<tripoint_abs_omt>> paths = get_overmapbuffer( dim ).get_travel_paths(
+                    trips, overmap_path_params::for_npc() );
+        for( size_t i = 0; i < npcs.size(); ++i ) {
+            npc &guy = *npcs[i];
+            guy.omt_path = std::move( paths[i] );
+            if( guy.omt_path.empty() ) {
+                add_msg( m_debug, "%s couldn't find overmap path from %s to %s",
+                         guy.get_name(), trips[i].first.to_string(), trips[i].second.to_string() );
+                guy.goal = npc::no_goal_point;
+                guy.mission = NPC_MISSION_NULL;
             }
-            reload_npcs();
         }
     }
-    return;
+
+    // Those that just got their path set out next turn, as before.
+    for( npc *elem : travelling_npcs ) {
+        if( planned.contains( elem ) ) {
+            continue;
+        }
+        if( elem->omt_path.back() == elem->abs_omt_pos() ) {
+            elem->omt_path.pop_back();
+        }
+        // TODO: fix point types
+        elem->travel_overmap(
+            project_to<coords::sm>( elem->omt_path.back() ) );
+    }
+    // One reload picks up everyone who walked into or out of the reality bubble.
+    reload_npcs();
 }
 
 /* Knockback target at t by force number of tiles in direction from s to t
@@ -9773,8 +10187,10 @@ look_around_result game::look_around( bool show_window, tripoint_bub_ms &center,
     ctxt.register_action( "debug_outside" );
     ctxt.register_action( "debug_sound_absorption" );
     ctxt.register_action( "debug_sound_walls" );
+    ctxt.register_action( "debug_pathfinding_heat" );
     ctxt.register_action( "debug_submap_grid" );
     ctxt.register_action( "debug_hour_timer" );
+    ctxt.register_action( "debug_frame_timing" );
     ctxt.register_action( "CONFIRM" );
     ctxt.register_action( "QUIT" );
     ctxt.register_action( "HELP_KEYBINDINGS" );
@@ -9967,6 +10383,10 @@ look_around_result game::look_around( bool show_window, tripoint_bub_ms &center,
             if( !MAP_SHARING::isCompetitive() || MAP_SHARING::isDebugger() ) {
                 display_sound_walls();
             }
+        } else if( action == "debug_pathfinding_heat" ) {
+            if( !MAP_SHARING::isCompetitive() || MAP_SHARING::isDebugger() ) {
+                display_pathfinding_heat();
+            }
         } else if( action == "debug_radiation" ) {
             if( !MAP_SHARING::isCompetitive() || MAP_SHARING::isDebugger() ) {
                 display_radiation();
@@ -9979,6 +10399,8 @@ look_around_result game::look_around( bool show_window, tripoint_bub_ms &center,
             g->debug_submap_grid_overlay = !g->debug_submap_grid_overlay;
         } else if( action == "debug_hour_timer" ) {
             toggle_debug_hour_timer();
+        } else if( action == "debug_frame_timing" ) {
+            toggle_debug_frame_timing();
         } else if( action == "EXTENDED_DESCRIPTION" ) {
             extended_description( lp );
         } else if( action == "CENTER" ) {
@@ -15108,6 +15530,7 @@ auto game::update_map( const tripoint_abs_ms &center ) -> point_rel_sm
         const auto bubble_begin = player_reality_bubble_origin().xy();
         const auto bubble_end = bubble_begin + point_rel_sm( g_mapsize, g_mapsize );
         update_active_load_regions( m.get_bound_dimension(), bubble_begin, bubble_end );
+        update_prefetch_region();
         // Ensure trackers exist for all active dimensions before firing events.
         for( const auto &dim_id : submap_loader.active_dimensions() ) {
             ensure_distribution_grid_tracker_for( dim_id );
@@ -15179,6 +15602,11 @@ auto game::update_map( const tripoint_abs_ms &center ) -> point_rel_sm
         m.spawn_monsters_new_submaps( shift ); // Static monsters
     }
 
+    {
+        ZoneScopedN( "update_map_generate_overmaps_ahead" );
+        get_overmapbuffer( current_dimension_id_ ).generate_ahead( project_to<coords::omt>( center ) );
+    }
+
     // Update what parts of the world map we can see
     update_overmap_seen();
     // update_map() only shifts the loaded x/y window; vertical loaded-state
@@ -15595,6 +16023,8 @@ void game::display_toggle_overlay( const action_id action )
     } else {
         displaying_overlays = action;
     }
+    // Only worth counting while someone looks at it
+    Pathfinding::set_collect_explored_heat( display_overlay_state( ACTION_DISPLAY_PATHFINDING_HEAT ) );
 }
 
 void game::display_scent()
@@ -15669,6 +16099,20 @@ void game::toggle_debug_hour_timer()
     debug_hour_timer.toggle();
 }
 
+void game::toggle_debug_frame_timing()
+{
+    // Curses builds have no overlay, so the summary is reported when timing stops.
+    if( frame_timing::enabled() ) {
+        const frame_timing::frame_history &frames = frame_timing::history();
+        add_msg( "frame timing disabled: %d frames, p50 %.1f ms, p99 %.1f ms, %d stutters",
+                 static_cast<int>( frames.samples().size() ), frames.percentile( 0.5f ),
+                 frames.percentile( 0.99f ), frames.stutters() );
+    } else {
+        add_msg( "frame timing enabled" );
+    }
+    frame_timing::set_enabled( !frame_timing::enabled() );
+}
+
 void game::debug_hour_timer::toggle()
 {
     enabled = !enabled;
@@ -15701,7 +16145,8 @@ void game::display_lighting()
         }
         uilist lighting_menu;
         std::vector<std::string> lighting_menu_strings{
-            "Global lighting conditions"
+            "Global lighting conditions",
+            "Vehicle light clusters"
         };
 
         int count = 0;
@@ -15753,6 +16198,13 @@ void game::display_sound_walls()
     }
 }
 
+void game::display_pathfinding_heat()
+{
+    if( use_tiles ) {
+        display_toggle_overlay( ACTION_DISPLAY_PATHFINDING_HEAT );
+    }
+}
+
 void game::display_tiles_no_vfx()
 {
     if( use_tiles ) {
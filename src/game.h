@@ -64,9 +64,6 @@ extern std::unique_ptr<game> g;
 
 extern const int savegame_version;
 extern int savegame_loading_version;
-// Monotonically increasing counter; bumped whenever NPC faction membership or active NPC list
-// changes so each NPC can lazily invalidate its cached friends list.
-extern std::atomic<uint32_t> g_npc_friends_dirty_version;
 // Bumped once per npcmove() pass; monsters use it to know when their cached generic-NPC
 // attitude is stale.
 extern uint32_t g_npcmove_attitude_epoch;
@@ -1026,10 +1023,16 @@ class game : public submap_load_listener
         auto monmove( monster_activity_ai_mode mode = monster_activity_ai_mode::normal,
                       activity_monmove_cache *cache = nullptr ) -> void;
         void npcmove();          // NPC movement (split from monmove for per-option sleep-skip)
+        /** Precompute every simulated NPC's danger plan in parallel (see npc_plan.h). */
+        void plan_npc_danger();
         void sleep_skip_npc_process(); // Sleep-only NPC processing when SLEEP_SKIP_NPC is active
         int  tier_assign_all(); // LOD tier assignment, O(M), called from monmove(); returns Tier 0 count
         // Out-of-bubble world simulation
         void world_tick();       // Tick all loaded submaps outside the player's reality bubble
+        /** Whether pocket dimension @p dim gets a full world tick this turn rather than batched catch-up. */
+        auto is_dimension_active( const dimension_id &dim ) const -> bool;
+        /** Advance the simulated submaps of @p mb to now through batch turns, per POCKET_SIMULATION_LEVEL. */
+        auto catch_up_dimension( mapbuffer &mb ) -> void;
         void overmap_npc_move(); // NPC overmap movement
         void process_voluntary_act_interrupt(); // Process
         void process_activity(); // Processes and enacts the player's activity
@@ -1042,6 +1045,10 @@ class game : public submap_load_listener
         auto can_activity_fixed_window_skip( const time_duration &duration ) -> bool;
         auto has_activity_skip_blocking_npc_state() -> bool;
         auto has_activity_skip_relevant_vehicle() -> bool;
+        /** Whether any monster is hunting the player or is hostile and can see them. */
+        auto has_activity_skip_aware_hostile() -> bool;
+        /** Whether the player is asleep with no activity, which skips like a rooted one. */
+        auto is_activity_skip_sleep() -> bool;
         auto has_activity_skip_active_fire() -> bool;
         auto run_activity_skip_batch_turns( int skipped_turns ) -> void;
         auto handle_wait_activity_redraw( bool force = false ) -> void;
@@ -1095,6 +1102,7 @@ class game : public submap_load_listener
         void display_outside(); // Displays outside/sheltered/indoors overlay
         void display_sound_absorption(); // Displays terrain sound absorption overlay
         void display_sound_walls(); // Displays sound walls overlay
+        void display_pathfinding_heat(); // Displays tiles the pathfinder explored last turn
         void display_tiles_no_vfx(); // Disables tileset visual effects
 
         // prints the IRL time in ms of the last full in-game hour
@@ -1183,6 +1191,8 @@ class game : public submap_load_listener
         bool display_overlay_state( action_id );
         // toggles the timing of in-game hours
         void toggle_debug_hour_timer();
+        // toggles the frame timing overlay
+        void toggle_debug_frame_timing();
         /** Creature for which to display the visibility map */
         Creature *displaying_visibility_creature;
         /** Type of lighting condition overlay to display */
@@ -1253,6 +1263,11 @@ class game : public submap_load_listener
         bool processing_npcs_ = false;
         /** Is this the first redraw since waiting (sleeping or activity) started */
         bool first_redraw_since_waiting_started = true;
+        /** Redraws while waiting that came due in game time but were held back in real time */
+        bool wait_redraw_pending_ = false;
+        bool wait_popup_pending_ = false;
+        std::chrono::steady_clock::time_point last_wait_redraw_;
+        std::chrono::steady_clock::time_point last_wait_popup_;
         /** Is Zone manager open or not - changes graphics of some zone tiles */
         bool zones_manager_open = false;
         /** Zone manager toggle for submap grid overlay (only active while the UI is open) */
@@ -1325,6 +1340,8 @@ class game : public submap_load_listener
         auto update_active_load_regions( const dimension_id &dim_id,
                                          const point_abs_sm &begin,
                                          const point_abs_sm &end ) -> void;
+        /// Keep a resident-only request ahead of the bubble while driving fast or auto-travelling.
+        auto update_prefetch_region() -> void;
 
         /// Dimension ID the player is currently in.  "" = overworld (primary).
         /// Always updated via set_active_dimension_id().
@@ -1334,12 +1351,17 @@ class game : public submap_load_listener
         /// Keyed by dimension_id.  The overworld ("") may be absent on fresh games.
         std::unordered_map<dimension_id, dimension_info> loaded_dimensions_;
 
+        /// Dormant pocket dimensions, with the turn each was last caught up by world_tick().
+        /// A dimension leaves the map, after a final catch-up, as soon as it becomes active.
+        std::map<dimension_id, time_point> dormant_dimensions_;
+
         /// The dimension ID of the single "kept alive" pocket dimension.
         /// Empty = no pocket is kept.  When the player enters a new bounded pocket this
         /// slot is evicted (saved + removed from registry) and replaced with the new one.
         dimension_id kept_pocket_dimension_id_;
 
         mapbuffer_load_region lazy_border_region_;
+        mapbuffer_load_region prefetch_region_;
 
         // True while the bubble is temporarily shrunk for an ongoing long activity.
         // Entry requires >= ACTIVITY_BUBBLE_GRACE minutes remaining; once set, stays true
@@ -20,6 +20,7 @@ template<typename T>
 void game_object<T>::destroy_in_place()
 {
     T *self = static_cast<T *>( this );
+    ++generation;
     self->on_destroy();
     cata_arena<T>::mark_for_destruction( self );
 }
@@ -27,6 +28,7 @@ void game_object<T>::destroy_in_place()
 template<typename T>
 void game_object<T>::remove_location()
 {
+    ++generation;
     loc = nullptr;
 }
 
@@ -37,6 +39,7 @@ void game_object<T>::set_location( location<T> *own )
         debugmsg( "Attempted to set the location of [%s] that already has one.", debug_name() );
         detach().release();
     }
+    ++generation;
     loc = own;
 }
 
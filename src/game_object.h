@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <utility>
 
 #include "coordinates.h"
@@ -58,8 +59,20 @@ class game_object
 
         tripoint_bub_ms bub_pos( ) const;
         tripoint_abs_ms abs_pos( ) const;
+
+        /**
+         * Changes whenever any object of this type is put into or taken out of a location, or
+         * destroyed, so caches of pointers to them can tell when they may have gone stale.
+         */
+        static uint64_t location_generation() {
+            return generation;
+        }
+
         /** Returns the name that will be used when referring to the object in error messages */
         virtual std::string debug_name() const = 0;
+
+    private:
+        static inline uint64_t generation = 0;
 };
 
 
@@ -144,6 +144,59 @@ class generic_factory
         std::unordered_map<string_id<T>, int_id<T>> map;
         std::unordered_map<std::string, T> abstracts;
 
+        // Open-addressed table from the interned string of every key of `map` to its int_id,
+        // built by `finalize`.  It answers the first lookup of a string_id instance with one
+        // or two probes into a flat array instead of walking `map`'s buckets.  Anything that
+        // changes `map` afterwards bumps `version` (or clears `index_version`), and lookups
+        // go back to `map` until the next `finalize`.  Not used for dynamic string_ids.
+        struct index_slot {
+            int key = INVALID_CID;
+            int cid = INVALID_CID;
+        };
+        std::vector<index_slot> index;
+        int index_shift = 0;
+        int64_t index_version = INVALID_VERSION;
+
+        static uint32_t index_hash( const int key, const int shift ) {
+            // Fibonacci hashing: interned ids are dense, the multiply spreads them out
+            return ( static_cast<uint32_t>( key ) * 2654435769U ) >> shift;
+        }
+
+        void build_index() {
+            if constexpr( !string_id_params<T>::dynamic ) {
+                int bits = 1;
+                while( ( size_t( 1 ) << bits ) < map.size() * 2 ) {
+                    bits++;
+                }
+                const uint32_t mask = ( uint32_t( 1 ) << bits ) - 1;
+                index.assign( mask + 1, index_slot() );
+                index_shift = 32 - bits;
+                for( const auto &[sid, iid] : map ) {
+                    uint32_t slot = index_hash( sid._id._id, index_shift );
+                    while( index[slot].key != INVALID_CID ) {
+                        slot = ( slot + 1 ) & mask;
+                    }
+                    index[slot] = { sid._id._id, iid.to_i() };
+                }
+                index_version = version;
+            }
+        }
+
+        bool find_in_index( const string_id<T> &id, int_id<T> &result ) const {
+            const int key = id._id._id;
+            const uint32_t mask = static_cast<uint32_t>( index.size() ) - 1;
+            for( uint32_t slot = index_hash( key, index_shift ); ; slot = ( slot + 1 ) & mask ) {
+                const index_slot &s = index[slot];
+                if( s.key == key ) {
+                    result = int_id<T>( s.cid );
+                    return true;
+                }
+                if( s.key == INVALID_CID ) {
+                    return false;
+                }
+            }
+        }
+
         std::string type_name;
         std::string id_member_name;
         std::string alias_member_name;
@@ -156,6 +209,14 @@ class generic_factory
                 return is_valid( result );
             }
 
+            if constexpr( !string_id_params<T>::dynamic ) {
+                if( index_version == version ) {
+                    const bool found = find_in_index( id, result );
+                    id.set_cid_version( found ? result.to_i() : INVALID_CID, version );
+                    return found;
+                }
+            }
+
             const auto iter = map.find( id );
             // map lookup happens at most once per string_id instance per generic_factory::version
             // id was not found, explicitly marking it as "invalid"
@@ -173,6 +234,7 @@ class generic_factory
             if( !find_id( id, i_id ) ) {
                 return;
             }
+            index_version = INVALID_VERSION;
             auto iter = map.begin();
             const auto end = map.end();
             for( ; iter != end; ) {
@@ -385,6 +447,7 @@ class generic_factory
             for( size_t i = 0; i < list.size(); i++ ) {
                 list[i].id.set_cid_version( static_cast<int>( i ), version );
             }
+            build_index();
             set_finalized( true );
         }
 
@@ -417,6 +480,8 @@ class generic_factory
             inc_version();
             list.clear();
             map.clear();
+            index.clear();
+            index_version = INVALID_VERSION;
             abstracts.clear();
             deferred.clear();
         }
@@ -3048,6 +3048,13 @@ bool game::handle_action()
                 display_sound_walls();
                 break;
 
+            case ACTION_DISPLAY_PATHFINDING_HEAT:
+                if( MAP_SHARING::isCompetitive() && !MAP_SHARING::isDebugger() ) {
+                    break;    //don't do anything when sharing and not debugger
+                }
+                display_pathfinding_heat();
+                break;
+
             case ACTION_DISPLAY_SUBMAP_GRID:
                 g->debug_submap_grid_overlay = !g->debug_submap_grid_overlay;
                 break;
@@ -3060,6 +3067,10 @@ bool game::handle_action()
                 toggle_debug_hour_timer();
                 break;
 
+            case ACTION_TOGGLE_FRAME_TIMING:
+                toggle_debug_frame_timing();
+                break;
+
             case ACTION_TOGGLE_DEBUG_MODE:
                 if( MAP_SHARING::isCompetitive() && !MAP_SHARING::isDebugger() ) {
                     break;    //don't do anything when sharing and not debugger
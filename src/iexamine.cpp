@@ -3764,6 +3764,7 @@ void iexamine::keg( player &p, const tripoint_bub_ms &examp )
             auto &items = target_submap->get_items( target_pos );
             auto liquid_item = item::spawn( liquid_type, calendar::turn, available );
             auto iter = items.insert( items.end(), std::move( liquid_item ) );
+            target_submap->note_item_added( target_pos );
             item *water_item = *iter;
             const auto before = water_item->charges;
             fn( *water_item );
@@ -3802,6 +3803,7 @@ void iexamine::keg( player &p, const tripoint_bub_ms &examp )
                 auto &items = target_submap->get_items( target_pos );
                 auto liquid_item = item::spawn( liquid_type, calendar::turn, available );
                 auto iter = items.insert( items.end(), std::move( liquid_item ) );
+                target_submap->note_item_added( target_pos );
                 item *water_item = *iter;
                 const auto before = water_item->charges;
                 if( !p.eat( *water_item ) ) {
@@ -4751,6 +4753,7 @@ auto iexamine::fluid_grid_fixture( player &p, const tripoint_bub_ms &examp ) ->
     auto &items = target_submap->get_items( target_pos );
     auto liquid_item = item::spawn( liquid_type, calendar::turn, available );
     auto iter = items.insert( items.end(), std::move( liquid_item ) );
+    target_submap->note_item_added( target_pos );
     item *water_item = *iter;
     const auto before = water_item->charges;
     liquid_handler::handle_liquid( *water_item );
@@ -3,8 +3,11 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <deque>
 #include <exception>
+#include <filesystem>
 #include <fstream>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <set>
@@ -24,6 +27,7 @@
 #include "behavior.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "catalua.h"
 #include "cata_utility.h"
 #include "catalua_impl.h"
@@ -31,6 +35,7 @@
 #include "panels.h"
 #include "clothing_mod.h"
 #include "clzones.h"
+#include "compress.h"
 #include "construction.h"
 #include "construction_category.h"
 #include "construction_group.h"
@@ -54,6 +59,7 @@
 #include "flag.h"
 #include "flag_trait.h"
 #include "gates.h"
+#include "get_version.h"
 #include "harvest.h"
 #include "item_action.h"
 #include "item_category.h"
@@ -89,6 +95,8 @@
 #include "overmap_connection.h"
 #include "overmap_location.h"
 #include "overmap_special.h"
+#include "options.h"
+#include "path_info.h"
 #include "profession.h"
 #include "recipe_dictionary.h"
 #include "recipe_groups.h"
@@ -103,8 +111,10 @@
 #include "sounds.h"
 #include "speech.h"
 #include "start_location.h"
+#include "startup_timeline.h"
 #include "string_formatter.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -483,8 +493,69 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+namespace
+{
+
+/**
+ * A data file read and indexed off the main thread.  The objects point into
+ * @ref jsin, so the whole struct stays put once it is built.
+ */
+struct parsed_data_file {
+    std::string contents;
+    std::unique_ptr<memory_istreambuf> buf;
+    std::unique_ptr<std::istream> stream;
+    std::unique_ptr<JsonIn> jsin;
+    std::vector<JsonObject> objects;
+    // Objects before the error are still dispatched, as a serial load would.
+    std::exception_ptr error;
+
+    // Drops the objects without reporting their members as unvisited.
+    void discard() {
+        for( const JsonObject &jo : objects ) {
+            jo.allow_omitted_members();
+        }
+        objects.clear();
+    }
+};
+
+auto parse_data_file( const std::string &file ) -> std::unique_ptr<parsed_data_file>
+{
+    auto parsed = std::make_unique<parsed_data_file>();
+    try {
+        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
+        parsed->contents.assign( std::istreambuf_iterator<char>( *infile ),
+                                 std::istreambuf_iterator<char>() );
+        parsed->buf = std::make_unique<memory_istreambuf>( parsed->contents );
+        parsed->stream = std::make_unique<std::istream>( parsed->buf.get() );
+        parsed->jsin = std::make_unique<JsonIn>( *parsed->stream, file );
+        JsonIn &jsin = *parsed->jsin;
+        // TEMPORARY until 0.G: Remove single object support for consistency
+        if( jsin.test_object() ) {
+            parsed->objects.emplace_back( jsin );
+            // if there's anything else in the file, it's an error.
+            jsin.eat_whitespace();
+            if( jsin.good() ) {
+                jsin.error( string_format( "expected single-object file but found '%c'", jsin.peek() ) );
+            }
+        } else if( jsin.test_array() ) {
+            jsin.start_array();
+            while( !jsin.end_array() ) {
+                parsed->objects.emplace_back( jsin );
+            }
+        } else {
+            // not an object or an array?
+            jsin.error( "expected object or array" );
+        }
+    } catch( ... ) {
+        parsed->error = std::current_exception();
+    }
+    return parsed;
+}
+
+} // namespace
+
 void DynamicDataLoader::load_data_from_path( const std::string &path, const std::string &src,
-        loading_ui &ui )
+        loading_ui & )
 {
     assert( !finalized && "Can't load additional data after finalization.  Must be unloaded first." );
     // We assume that each folder is consistent in itself,
@@ -503,25 +574,58 @@ void DynamicDataLoader::load_data_from_path( const std::string &path, const std:
             files.push_back( path );
         }
     }
-    // iterate over each file
-    for( auto &files_i : files ) {
-        const std::string &file = files_i;
-        // open the file as a stream
-        cata_ifstream infile = std::move( cata_ifstream().mode( cata_ios_mode::binary ).open( file ) );
-        // and stuff it into ram
-        std::istringstream iss(
-            std::string(
-                ( std::istreambuf_iterator<char>( *infile ) ),
-                std::istreambuf_iterator<char>()
-            )
-        );
-        try {
-            // parse it
-            JsonIn jsin( iss, file );
-            load_all_from_json( jsin, src, ui, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
+    // Files are read and indexed on the thread pool, a bounded window ahead
+    // of the main thread, which still dispatches their objects in order.
+    cata_thread_pool &pool = get_thread_pool();
+    const size_t window = std::max<size_t>( 4, 2 * ( pool.num_workers() + 1 ) );
+    std::deque<std::future<std::unique_ptr<parsed_data_file>>> pending;
+    size_t next = 0;
+    const auto fill_window = [&]() {
+        for( ; next < files.size() && pending.size() < window; ++next ) {
+            // The loading screen waits on these, so they go ahead of any background work
+            pending.push_back( pool.submit_returning( task_priority::interactive, "load_data_parse",
+            [file = files[next]]() {
+                return parse_data_file( file );
+            } ) );
         }
+    };
+
+    // Per-type load_object time of this pack, for the startup timeline.
+    startup_timeline::span timing( src, "load_data", src );
+    const bool timed = startup_timeline::enabled();
+
+    try {
+        for( const std::string &file : files ) {
+            fill_window();
+            pool.wait_helping( pending.front() );
+            const std::unique_ptr<parsed_data_file> parsed = pending.front().get();
+            pending.pop_front();
+            try {
+                for( JsonObject &jo : parsed->objects ) {
+                    if( timed ) {
+                        const auto start = startup_timeline::clock::now();
+                        load_object( jo, src, path, file );
+                        timing.add_part( jo.get_string( "type" ), startup_timeline::clock::now() - start );
+                    } else {
+                        load_object( jo, src, path, file );
+                    }
+                    jo.finish();
+                }
+                if( parsed->error ) {
+                    std::rethrow_exception( parsed->error );
+                }
+            } catch( const JsonError &err ) {
+                throw std::runtime_error( err.what() );
+            }
+            inp_mngr.pump_events();
+        }
+    } catch( ... ) {
+        // Files parsed ahead must not outlive the load or report on their own.
+        for( auto &f : pending ) {
+            pool.wait_helping( f );
+            f.get()->discard();
+        }
+        throw;
     }
 }
 
@@ -846,14 +950,93 @@ void DynamicDataLoader::check_consistency( loading_ui &ui )
     }
 
     ui.show();
-    for( const named_entry &e : entries ) {
-        e.second();
+    if( !get_option<bool>( "PARALLEL_DATA_CHECKS" ) || get_thread_pool().num_workers() == 0 ) {
+        for( const named_entry &e : entries ) {
+            e.second();
+            ui.proceed();
+        }
+        finalized = true;
+        return;
+    }
+
+    // The checks only read finalized data, so they can run side by side.  Their
+    // debugmsgs are held back and reported in list order, the same as a serial run.
+    std::vector<std::vector<deferred_debugmsg>> msgs( entries.size() );
+    parallel_for( "check_consistency", 0, static_cast<int>( entries.size() ), [&]( const int i ) {
+        startup_timeline::span timing( entries[i].first, "check_consistency" );
+        msgs[i] = collect_debugmsgs_during( entries[i].second );
+    } );
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        replay_debugmsgs( msgs[i] );
         ui.proceed();
     }
 
     finalized = true;
 }
 
+// Keys of recent data sets that passed every consistency check.
+static constexpr size_t data_check_cache_size = 16;
+
+static std::string data_check_cache_path()
+{
+    return PATH_INFO::config_dir() + "data_check_cache.json";
+}
+
+/**
+ * Hash of everything the consistency checks see: the game version, the pack
+ * order and the path, size and modification time of every data and Lua file
+ * in the packs.  FNV-1a, so keys stay stable across runs and platforms.
+ */
+static std::string data_check_key( const std::vector<mod_id> &packs )
+{
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    const auto mix = [&]( const std::string_view bytes ) {
+        for( const char c : bytes ) {
+            hash = ( hash ^ static_cast<unsigned char>( c ) ) * 0x100000001b3ULL;
+        }
+        hash = ( hash ^ 0xff ) * 0x100000001b3ULL;
+    };
+    mix( getVersionString() );
+    mix( json_report_strict ? "strict" : "lenient" );
+    for( const mod_id &mod : packs ) {
+        mix( mod.str() );
+        for( const char *ext : { ".json", ".lua" } ) {
+            for( const std::string &file : get_files_from_path( ext, mod->path, true, true ) ) {
+                std::error_code ec;
+                const auto size = std::filesystem::file_size( file, ec );
+                const auto mtime = std::filesystem::last_write_time( file, ec );
+                mix( file );
+                mix( std::to_string( ec ? 0 : size ) );
+                mix( std::to_string( ec ? 0 : mtime.time_since_epoch().count() ) );
+            }
+        }
+    }
+    return string_format( "%016llx", static_cast<unsigned long long>( hash ) );
+}
+
+static std::vector<std::string> read_data_check_cache()
+{
+    std::vector<std::string> keys;
+    read_from_file_json( data_check_cache_path(), [&]( JsonIn & jsin ) {
+        jsin.read( keys );
+    }, true );
+    return keys;
+}
+
+static void remember_data_check( const std::string &key )
+{
+    std::vector<std::string> keys = read_data_check_cache();
+    keys.erase( std::remove( keys.begin(), keys.end(), key ), keys.end() );
+    keys.insert( keys.begin(), key );
+    if( keys.size() > data_check_cache_size ) {
+        keys.resize( data_check_cache_size );
+    }
+    write_to_file( data_check_cache_path(), [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.write( keys );
+    }, _( "data check cache" ) );
+}
+
 /**
  * Load & finalize specified content packs.
  * @param ui structure for load progress display
@@ -898,6 +1081,7 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
                     mod->name(), mod
                 );
             }
+            startup_timeline::span timing( "preload.lua", "lua", mod.str() );
             cata::set_mod_being_loaded( *loader.lua, mod );
             cata::run_mod_preload_script( *loader.lua, mod );
         }
@@ -916,19 +1100,36 @@ static void load_and_finalize_packs( loading_ui &ui, const std::string &msg,
 
     for( const mod_id &mod : available ) {
         if( mod->lua_api_version ) {
+            startup_timeline::span timing( "finalize.lua", "lua", mod.str() );
             cata::set_mod_being_loaded( *loader.lua, mod );
             cata::run_mod_finalize_script( *loader.lua, mod );
         }
     }
 
-    loader.check_consistency( ui );
+    // The checks only report; skipping them for data that already passed
+    // leaves the loaded data exactly the same.
+    const bool use_check_cache = get_option<bool>( "CACHE_DATA_CHECKS" );
+    const std::string check_key = use_check_cache ? data_check_key( available ) : std::string();
+    if( use_check_cache && std::ranges::contains( read_data_check_cache(), check_key ) ) {
+        loader.mark_checked();
+    } else {
+        const bool had_error = debug_has_error_been_observed();
+        loader.check_consistency( ui );
+        if( use_check_cache && !had_error && !debug_has_error_been_observed() ) {
+            remember_data_check( check_key );
+        }
+    }
 
-    init::load_main_lua_scripts( *loader.lua, packs );
+    {
+        startup_timeline::span timing( "Lua main scripts", "lua" );
+        init::load_main_lua_scripts( *loader.lua, packs );
+    }
     cata::clear_mod_being_loaded( *loader.lua );
     // Update cached hook-presence flag so worker threads know whether to queue
     // deferred mapgen postprocess hooks (avoids lock + allocation overhead per omt
     // when no on_mapgen_postprocess hooks are registered).
     refresh_mapgen_postprocess_hook_presence( *loader.lua );
+    startup_timeline::write();
 }
 
 auto init::load_main_lua_scripts( cata::lua_state &state, const std::vector<mod_id> &packs ) -> int
@@ -940,6 +1141,7 @@ auto init::load_main_lua_scripts( cata::lua_state &state, const std::vector<mod_
     )" );
     auto range = packs | std::views::filter( []( const mod_id & mod ) { return mod.is_valid() && mod->lua_api_version; } );
     for( const auto &mod : range ) {
+        startup_timeline::span timing( "main.lua", "lua", mod.str() );
         cata::set_mod_being_loaded( state, mod );
         cata::run_mod_main_script( state, mod );
     }
@@ -1104,6 +1306,7 @@ void init::load_soundpack_files( const std::string &soundpack_path )
     // Leverage DynamicDataLoader to load a soundpack.
     // It's not a mod, so we avoid the regular mod loading routines.
     // clear_loaded_data() is not needed here, tileset gets loaded on game init before any mods
+    startup_timeline::span timing( "Soundpack", "sound" );
     loading_ui ui( false );
     DynamicDataLoader::get_instance().load_data_from_path( soundpack_path, "sound_core", ui );
 }
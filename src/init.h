@@ -121,6 +121,13 @@ class DynamicDataLoader
          * @param ui Finalization status display.
          */
         void check_consistency( loading_ui &ui );
+        /**
+         * Marks the data finalized without checking it again, for data that is
+         * known to have passed @ref check_consistency before.
+         */
+        void mark_checked() {
+            finalized = true;
+        }
 
         /**
          * Returns the single instance of this class.
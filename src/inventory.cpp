@@ -594,9 +594,9 @@ void inventory::form_from_map( map &m, std::vector<tripoint_bub_ms> pts, const C
                 if( !found_tools.contains( id.str() ) ) {
                     item &tool = *item::spawn_temporary( id, bday );
                     tool.charges = veh->fuel_left( itype_battery, true );
-                    tool.item_tags.insert( flag_PSEUDO );
+                    tool.set_flag( flag_PSEUDO );
                     if( id == itype_hotplate ) {
-                        tool.item_tags.insert( flag_HEATS_FOOD );
+                        tool.set_flag( flag_HEATS_FOOD );
                     }
                     add_item_by_items_type_cache( tool, false );
                     found_tools.insert( id.str() );
@@ -618,7 +618,7 @@ void inventory::form_from_map( map &m, std::vector<tripoint_bub_ms> pts, const C
         if( autoclavepart && !has_autodoc ) {
             item &autoclave = *item::spawn_temporary( "autoclave", bday );
             autoclave.charges = veh->fuel_left( itype_battery, true );
-            autoclave.item_tags.insert( flag_PSEUDO );
+            autoclave.set_flag( flag_PSEUDO );
             add_item_by_items_type_cache( autoclave, false );
             has_autodoc = true;
         }
@@ -1093,6 +1093,15 @@ const std::map<quality_id, std::map<int, int>> &inventory::get_quality_cache() c
     return quality_cache;
 }
 
+void inventory::add_to_quality_cache( const std::map<quality_id, std::map<int, int>> &qualities )
+{
+    for( const auto &[quality, levels] : qualities ) {
+        for( const auto &[level, count] : levels ) {
+            quality_cache[quality][level] += count;
+        }
+    }
+}
+
 int inventory::count_item( const itype_id &item_type ) const
 {
     int num = 0;
@@ -227,6 +227,8 @@ class inventory : public temp_visitable<inventory>
 
         void update_quality_cache();
         const std::map<quality_id, std::map<int, int>> &get_quality_cache() const;
+        /** Counts the qualities of items added since @ref update_quality_cache, without visiting them. */
+        void add_to_quality_cache( const std::map<quality_id, std::map<int, int>> &qualities );
 
         void build_items_type_cache();
 
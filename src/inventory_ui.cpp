@@ -459,6 +459,8 @@ size_t inventory_column::get_cells_width() const
 
 void inventory_column::set_filter( const std::string &filter )
 {
+    // Only what the last filter let through can match one that narrows it
+    narrow_paging = paging_is_valid && filter_narrows( paged_filter, filter );
     entries_cell_cache.clear();
     paging_is_valid = false;
     prepare_paging( filter );
@@ -814,29 +816,37 @@ void inventory_column::prepare_paging( const std::string &filter )
     }
 
     entries_cell_cache.clear();
+    // Entries are filtered twice and then renamed, each asking for the item names
+    const item::tname_memo_scope names;
 
     const auto filter_fn = filter_from_string<inventory_entry>(
     filter, [this]( const std::string & filter ) {
         return preset.get_filter( filter );
     } );
 
-    // First, remove all non-items
-    for( size_t i = 0; i < entries_hidden.size(); ++i ) {
-        entries.push_back( entries_hidden[i] );
+    if( !narrow_paging ) {
+        for( size_t i = 0; i < entries_hidden.size(); ++i ) {
+            entries.push_back( entries_hidden[i] );
+        }
+        entries_hidden.clear();
     }
+    narrow_paging = false;
+    paged_filter = filter;
 
-    entries_hidden.clear();
-    for( size_t i = 0; i < entries.size(); ++i ) {
-        if( entries[i].is_item() && !filter_fn( entries[i] ) ) {
-            entries_hidden.push_back( entries[i] );
+    // Remove all non-items, and hide what doesn't match
+    std::vector<inventory_entry> shown;
+    shown.reserve( entries.size() );
+    for( inventory_entry &entry : entries ) {
+        if( !entry.is_item() ) {
+            continue;
+        }
+        if( filter_fn( entry ) ) {
+            shown.push_back( std::move( entry ) );
+        } else {
+            entries_hidden.push_back( std::move( entry ) );
         }
     }
-
-    const auto new_end = std::remove_if( entries.begin(),
-    entries.end(), [&filter_fn]( const inventory_entry & entry ) {
-        return !entry.is_item() || !filter_fn( entry );
-    } );
-    entries.erase( new_end, entries.end() );
+    entries = std::move( shown );
     // don't sort with stale names
     std::ranges::for_each( entries, &inventory_entry::update_cache );
     // Then sort them with respect to categories
@@ -350,6 +350,12 @@ class inventory_column
         std::vector<inventory_entry> entries_hidden;
         bool paging_is_valid = false;
 
+    private:
+        /** The filter the current entries were paged with. */
+        std::string paged_filter;
+        /** Whether the next paging only needs to recheck the entries shown now. */
+        bool narrow_paging = false;
+
     protected:
         struct entry_cell_cache_t {
             bool assigned = false;
@@ -18,6 +18,7 @@
 #include <sstream>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -29,6 +30,7 @@
 #include "bionics.h"
 #include "bodypart.h"
 #include "cached_item_options.h"
+#include "cata_arena.h"
 #include "catalua_icallback_actor.h"
 #include "cata_utility.h"
 #include "catacharset.h"
@@ -109,6 +111,7 @@
 #include "string_id_utils.h"
 #include "string_utils.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
@@ -249,8 +252,9 @@ item &null_item_reference()
 
 namespace item_internal
 {
-bool goes_bad_temp_cache = false;
-const item *goes_bad_temp_cache_for = nullptr;
+// Per thread: map::process_items() plans rot on worker threads.
+thread_local bool goes_bad_temp_cache = false;
+thread_local const item *goes_bad_temp_cache_for = nullptr;
 inline bool goes_bad_cache_fetch()
 {
     return goes_bad_temp_cache;
@@ -271,7 +275,7 @@ inline bool goes_bad_cache_is_for( const item *i )
 }
 
 struct scoped_goes_bad_cache {
-    scoped_goes_bad_cache( item *i ) {
+    scoped_goes_bad_cache( const item *i ) {
         goes_bad_cache_set( i );
     }
     ~scoped_goes_bad_cache() {
@@ -463,6 +467,7 @@ item::item( const item &source ) : game_object<item>( source ), contents( this )
     type = source.type;
     faults = source.faults;
     item_tags = source.item_tags;
+    own_flag_bits = source.own_flag_bits;
     curammo = source.curammo;
     item_vars_ = source.item_vars_;
     corpse = source.corpse;
@@ -515,6 +520,7 @@ item &item::operator=( const item &source )
     type = source.type;
     faults = source.faults;
     item_tags = source.item_tags;
+    own_flag_bits = source.own_flag_bits;
     curammo = source.curammo;
     item_vars_ = source.item_vars_;
     corpse = source.corpse;
@@ -578,6 +584,16 @@ void item::on_destroy()
 
 item::~item() = default;
 
+void *item::operator new( size_t size )
+{
+    return cata_arena<item>::allocate( size );
+}
+
+void item::operator delete( void *p, size_t size )
+{
+    cata_arena<item>::deallocate( p, size );
+}
+
 detached_ptr<item> item::make_corpse( const mtype_id &mt, time_point turn, const std::string &name,
                                       const int upgrade_time )
 {
@@ -5160,7 +5176,69 @@ void item::on_map_placement( const map &m, const tripoint_bub_ms &p )
     }
 }
 
+namespace
+{
+
+struct tname_key {
+    const item *it;
+    unsigned int quantity;
+    unsigned int truncate;
+    bool with_prefix;
+
+    bool operator==( const tname_key & ) const = default;
+};
+
+struct tname_key_hash {
+    auto operator()( const tname_key &k ) const -> size_t {
+        size_t h = std::hash<const item *>()( k.it );
+        h ^= std::hash<unsigned int>()( k.quantity ) + 0x9e3779b9 + ( h << 6 ) + ( h >> 2 );
+        h ^= std::hash<unsigned int>()( k.truncate * 2 + k.with_prefix ) + 0x9e3779b9 + ( h << 6 ) +
+             ( h >> 2 );
+        return h;
+    }
+};
+
+int tname_memo_depth = 0;
+uint64_t tname_memo_generation = 0;
+std::unordered_map<tname_key, std::string, tname_key_hash> tname_memo;
+
+} // namespace
+
+item::tname_memo_scope::tname_memo_scope()
+{
+    if( tname_memo_depth++ == 0 ) {
+        tname_memo_generation = item::location_generation();
+    }
+}
+
+item::tname_memo_scope::~tname_memo_scope()
+{
+    if( --tname_memo_depth == 0 ) {
+        tname_memo.clear();
+    }
+}
+
 std::string item::tname( unsigned int quantity, bool with_prefix, unsigned int truncate ) const
+{
+    if( tname_memo_depth == 0 || is_pool_worker_thread() ) {
+        return tname_uncached( quantity, with_prefix, truncate );
+    }
+    // A moved or destroyed item may leave a stale entry under a pointer that gets reused
+    if( tname_memo_generation != item::location_generation() ) {
+        tname_memo.clear();
+        tname_memo_generation = item::location_generation();
+    }
+    const tname_key key{ this, quantity, truncate, with_prefix };
+    if( const auto it = tname_memo.find( key ); it != tname_memo.end() ) {
+        return it->second;
+    }
+    std::string name = tname_uncached( quantity, with_prefix, truncate );
+    tname_memo.emplace( key, name );
+    return name;
+}
+
+std::string item::tname_uncached( unsigned int quantity, bool with_prefix,
+                                  unsigned int truncate ) const
 {
     int dirt_level = get_var( "dirt", 0 ) / 2000;
     std::string dirt_symbol;
@@ -6144,6 +6222,7 @@ void item::unset_flags()
                                     item_tags.count( flag_ETHEREAL_ITEM ) ||
                                     item_tags.count( flag_PROCESSING );
     item_tags.clear();
+    own_flag_bits.reset();
     if( affects_processing ) {
         invalidate_processing_cache_upwards();
     }
@@ -6156,34 +6235,27 @@ bool item::has_fault( const fault_id &fault ) const
 
 bool item::has_own_flag( const flag_id &f ) const
 {
+    if( const std::optional<size_t> bit = flag_bits::position( f ) ) {
+        return own_flag_bits.test( *bit );
+    }
     return item_tags.count( f );
 }
 
 bool item::has_flag( const flag_id &f ) const
 {
-    // Check if we have any gun/toolmods with the flag, and if we do
-    // check if that flag should be inherited.
-    // `json_flag::get` is pretty expensive so it's faster to do it
-    // last as frequently there are no gun/toolmods with the flag f
-    auto mods = is_gun() ? gunmods() : toolmods();
-
-    const auto flag_in_mods = [&f]( const auto & mods ) -> bool {
-        return std::any_of( mods.begin(), mods.end(), [&f]( const item * e )-> bool {
-            return ( !e->is_gun() && e->has_flag( f ) );
-        } );
-    };
-
-    if( f->inherit() && flag_in_mods( mods ) ) {
+    // Type and item specific flags are single bit tests, so they go first
+    if( type->has_flag( f ) || has_own_flag( f ) ) {
         return true;
     }
 
-    // other item type flags
-    if( type->has_flag( f ) ) {
-        return true;
+    // Gathering the gun/toolmods allocates, so only do it for flags they can pass on
+    if( !f->inherit() ) {
+        return false;
     }
-
-    // now check for item specific flags
-    return has_own_flag( f );
+    const auto mods = is_gun() ? gunmods() : toolmods();
+    return std::any_of( mods.begin(), mods.end(), [&f]( const item * e ) -> bool {
+        return !e->is_gun() && e->has_flag( f );
+    } );
 }
 
 bool item::has_vitamin( const vitamin_id &v ) const
@@ -6213,6 +6285,9 @@ void item::set_flag( const flag_id &flag )
         const bool affects_processing = flag == flag_RADIO_ACTIVATION || flag == flag_ETHEREAL_ITEM ||
                                         flag == flag_PROCESSING;
         const bool inserted = item_tags.insert( flag ).second;
+        if( const std::optional<size_t> bit = flag_bits::position( flag ) ) {
+            own_flag_bits.set( *bit );
+        }
         if( inserted && affects_processing ) {
             invalidate_processing_cache_upwards();
         }
@@ -6226,6 +6301,9 @@ void item::unset_flag( const flag_id &flag )
     const bool affects_processing = flag == flag_RADIO_ACTIVATION || flag == flag_ETHEREAL_ITEM ||
                                     flag == flag_PROCESSING;
     const bool erased = item_tags.erase( flag ) > 0;
+    if( const std::optional<size_t> bit = flag_bits::position( flag ) ) {
+        own_flag_bits.reset( *bit );
+    }
     if( erased && affects_processing ) {
         invalidate_processing_cache_upwards();
     }
@@ -6560,12 +6638,18 @@ auto get_hourly_rotpoints_at_temp( const units::temperature temp ) -> int
 }
 
 auto item::calc_rot( time_point time, const units::temperature temp ) const -> time_duration
+{
+    return calc_rot( time, temp, rot, last_rot_check );
+}
+
+auto item::calc_rot( time_point time, const units::temperature temp,
+                     const time_duration &current_rot, const time_point &since ) const -> time_duration
 {
     // Avoid needlessly calculating already rotten things.  Corpses should
     // always rot away and food rots away at twice the shelf life.  If the food
     // is in a sealed container they won't rot away, this avoids needlessly
     // calculating their rot in that case.
-    if( !is_corpse() && get_shelf_life() != 0_turns && rot / get_shelf_life() > 2.0 ) {
+    if( !is_corpse() && get_shelf_life() != 0_turns && current_rot / get_shelf_life() > 2.0 ) {
         return 0_seconds;
     }
 
@@ -6580,11 +6664,11 @@ auto item::calc_rot( time_point time, const units::temperature temp ) const -> t
     // conditions by applying starting variation bonus/penalty of +/- 20% of base shelf-life
     // positive = food was produced some time before calendar::start and/or bad storage
     // negative = food was stored in good conditions before calendar::start
-    if( last_rot_check <= calendar::start_of_cataclysm ) {
+    if( since <= calendar::start_of_cataclysm ) {
         time_duration spoil_variation = get_shelf_life() * 0.2f;
         added_rot += rng( -spoil_variation, spoil_variation );
     }
-    time_duration time_delta = time - last_rot_check;
+    time_duration time_delta = time - since;
     added_rot += factor * time_delta / 1_hours * get_hourly_rotpoints_at_temp( temp ) * 1_turns;
     return added_rot;
 }
@@ -10373,6 +10457,36 @@ auto item::update_rot( const rot_context &context ) -> void
         return;
     }
 
+    apply_rot_update( compute_rot_update( context ) );
+}
+
+auto item::plan_rot_update( const rot_context &context ) const -> std::optional<rot_update>
+{
+    // calc_rot() rolls a starting spoilage variation; leave that roll to the main thread.
+    // Preserved items do not rot, they only have their check time bumped.
+    if( calendar::turn - last_rot_check < 0_turns ||
+        last_rot_check <= calendar::start_of_cataclysm || is_in_preserving_container() ) {
+        return std::nullopt;
+    }
+    return compute_rot_update( context );
+}
+
+auto item::apply_rot_update( const rot_update &update ) -> bool
+{
+    if( last_rot_check != update.from ) {
+        return false;
+    }
+    rot = update.rot;
+    last_rot_check = update.last_rot_check;
+    return true;
+}
+
+auto item::compute_rot_update( const rot_context &context ) const -> rot_update
+{
+    const auto now = calendar::turn;
+    auto new_rot = rot;
+    auto checked = last_rot_check;
+
     // process rot at most once every 100_turns (10 min)
     // note we're also gated by item::processing_speed
     static constexpr auto smallest_interval = 10_minutes;
@@ -10381,7 +10495,7 @@ auto item::update_rot( const rot_context &context ) -> void
     auto temp = weather.get_temperature( context.position );
     temp = clip_by_temperature_flag( temp, context.temperature );
 
-    auto time = last_rot_check;
+    auto time = checked;
     item_internal::scoped_goes_bad_cache _cache( this );
 
     if( now - time > 1_hours ) {
@@ -10413,17 +10527,18 @@ auto item::update_rot( const rot_context &context ) -> void
                                            context.temperature );
 
             // Calculate item rot
-            rot += calc_rot( time, env_temperature_clipped );
-            last_rot_check = time;
+            new_rot += calc_rot( time, env_temperature_clipped, new_rot, checked );
+            checked = time;
         }
     }
 
     // Remaining <1 h from above
     // and items that are held near the player
     if( now - time > smallest_interval ) {
-        rot += calc_rot( now, temp );
-        last_rot_check = now;
+        new_rot += calc_rot( now, temp, new_rot, checked );
+        checked = now;
     }
+    return { .from = last_rot_check, .rot = new_rot, .last_rot_check = checked };
 }
 
 auto item::process_rot( detached_ptr<item> &&self, const bool seals,
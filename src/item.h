@@ -17,6 +17,7 @@
 #include "detached_ptr.h"
 #include "dimension_info.h"
 #include "enums.h"
+#include "flag_bits.h"
 #include "flat_set.h"
 #include "game_object.h"
 #include "gun_mode.h"
@@ -305,6 +306,10 @@ class item : public location_visitable<item>, public game_object<item>
         ~item();
         void on_destroy();
 
+        /** Items are allocated from cata_arena<item> slabs. */
+        static void *operator new( size_t size );
+        static void operator delete( void *p, size_t size );
+
         inline static detached_ptr<item> spawn( JsonIn &jsin ) {
             detached_ptr<item> p = spawn();
             p->deserialize( jsin );
@@ -501,6 +506,20 @@ class item : public location_visitable<item>, public game_object<item>
          */
         std::string tname( unsigned int quantity = 1, bool with_prefix = true,
                            unsigned int truncate = 0 ) const;
+        /**
+         * While one of these is alive, @ref tname results are remembered per item and
+         * arguments, so sorting and filtering long lists builds each name once.
+         * Items mustn't change while it is open: the memo only forgets on its own when
+         * items move between locations or are destroyed.
+         */
+        class tname_memo_scope
+        {
+            public:
+                tname_memo_scope();
+                ~tname_memo_scope();
+                tname_memo_scope( const tname_memo_scope & ) = delete;
+                tname_memo_scope &operator=( const tname_memo_scope & ) = delete;
+        };
         std::string display_money( unsigned int quantity, unsigned int total,
                                    const std::optional<unsigned int> &selected = std::nullopt ) const;
         /**
@@ -953,6 +972,9 @@ class item : public location_visitable<item>, public game_object<item>
          * @param temp Temperature at which the rot is calculated
          */
         auto calc_rot( time_point time, const units::temperature temp ) const -> time_duration;
+        /** As above, starting from the given @ref rot and last_rot_check instead of the item's own. */
+        auto calc_rot( time_point time, units::temperature temp, const time_duration &current_rot,
+                       const time_point &since ) const -> time_duration;
 
         /**
          * Time that this item is guaranteed to stay fresh.
@@ -1007,6 +1029,23 @@ class item : public location_visitable<item>, public game_object<item>
                          const weather_manager &weather_generator ) -> void;
         auto update_rot( const rot_context &context ) -> void;
 
+        /** Result of a rot update: the item's new @ref rot and last_rot_check. */
+        struct rot_update {
+            /// last_rot_check the update was worked out from.
+            time_point from;
+            time_duration rot = 0_turns;
+            time_point last_rot_check;
+        };
+
+        /**
+         * What update_rot( @p context ) would change, without changing it.  Safe to
+         * call off the main thread.  Returns nullopt when the update would roll the RNG
+         * or the item sits in a preserving container.
+         */
+        auto plan_rot_update( const rot_context &context ) const -> std::optional<rot_update>;
+        /** Applies @p update unless the item's rot has been checked since it was planned. */
+        auto apply_rot_update( const rot_update &update ) -> bool;
+
         /** Get @ref rot value relative to shelf life (or 0 if item does not spoil) */
         double get_relative_rot() const;
 
@@ -2459,6 +2498,9 @@ class item : public location_visitable<item>, public game_object<item>
         };
 
         const use_function *get_use_internal( const std::string &use_name ) const;
+        std::string tname_uncached( unsigned int quantity, bool with_prefix,
+                                    unsigned int truncate ) const;
+        auto compute_rot_update( const rot_context &context ) const -> rot_update;
         static detached_ptr<item> process_internal( detached_ptr<item> &&self, player *carrier,
                 const tripoint_bub_ms &pos, bool activate,
                 bool seals, temperature_flag flag, const weather_manager &weather_generator );
@@ -2544,6 +2586,8 @@ class item : public location_visitable<item>, public game_object<item>
 
         // TODO: Move to private ASAP
         FlagsSetType item_tags; // generic item specific flags
+        /** Mirror of @ref item_tags for @ref has_own_flag, kept in sync by set_flag/unset_flag. */
+        flag_bits::bitset own_flag_bits;
 
         std::vector<detached_ptr<item>> remove_components();
         detached_ptr<item> remove_component( item &it );
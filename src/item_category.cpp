@@ -32,6 +32,11 @@ void item_category::load_item_cat( const JsonObject &jo, const std::string &src
     item_category_factory.load( jo, src );
 }
 
+const std::vector<item_category> &item_category::get_all()
+{
+    return item_category_factory.get_all();
+}
+
 void item_category::load( const JsonObject &jo, const std::string & )
 {
     mandatory( jo, was_loaded, "id", id );
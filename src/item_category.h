@@ -78,6 +78,7 @@ class item_category
         bool was_loaded = false;
 
         static void load_item_cat( const JsonObject &jo, const std::string &src );
+        static const std::vector<item_category> &get_all();
         void load( const JsonObject &jo, const std::string & );
 };
 
@@ -46,6 +46,16 @@ auto item_contents::processing_items() const -> const std::vector<item *> & // *
 auto item_contents::invalidate_processing_cache() const -> void
 {
     processing_cache_dirty = true;
+    type_cache_dirty = true;
+}
+
+auto item_contents::has_type_recursive( const itype_id &id ) const -> bool
+{
+    if( items.empty() ) {
+        return false;
+    }
+    update_type_cache();
+    return cached_types.contains( id );
 }
 
 auto item_contents::update_processing_cache() const -> void
@@ -63,6 +73,25 @@ auto item_contents::update_processing_cache() const -> void
     processing_cache_dirty = false;
 }
 
+auto item_contents::update_type_cache() const -> void
+{
+    if( !type_cache_dirty ) {
+        return;
+    }
+
+    cached_types.clear();
+    for( const item * const &contained_item : items ) {
+        cached_types.insert( contained_item->typeId() );
+        if( !contained_item->contents.empty() ) {
+            // Nested summaries are reused, so only changed branches are walked again.
+            contained_item->contents.update_type_cache();
+            cached_types.insert( contained_item->contents.cached_types.begin(),
+                                 contained_item->contents.cached_types.end() );
+        }
+    }
+    type_cache_dirty = false;
+}
+
 ret_val<bool> item_contents::insert_item( detached_ptr<item> &&it )
 {
     bool stacked = false;
@@ -5,6 +5,7 @@
 #include <list>
 #include <set>
 #include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "ret_val.h"
@@ -30,7 +31,13 @@ class item_contents
         bool empty() const;
         auto has_processing_items() const -> bool;
         auto processing_items() const -> const std::vector<item *> &; // *NOPAD*
+        /** Also drops the summary of contained types. */
         auto invalidate_processing_cache() const -> void;
+        /**
+         * Whether an item of type @p id is inside, at any depth.  Answered from a summary
+         * of the subtree that is rebuilt only after the contents change.
+         */
+        auto has_type_recursive( const itype_id &id ) const -> bool;
 
         /** returns a list of pointers to all top-level items */
         const std::vector<item *> &all_items_top() const;
@@ -115,11 +122,14 @@ class item_contents
         void on_destroy();
     private:
         auto update_processing_cache() const -> void;
+        auto update_type_cache() const -> void;
 
         item *owner;
         location_vector<item> items;
         mutable bool processing_cache_dirty = true;
         mutable std::vector<item *> cached_processing_items;
+        mutable bool type_cache_dirty = true;
+        mutable std::unordered_set<itype_id> cached_types;
 };
 
 
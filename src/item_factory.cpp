@@ -69,6 +69,10 @@ static std::set<itype_id> item_blacklist;
 
 static DynamicDataLoader::deferred_json deferred;
 
+// Shared by every Item_factory instance, so ids cached against a previous one are never
+// mistaken for valid after the factory is recreated.
+static int64_t template_index_version = 0;
+
 static const ammo_effect_str_id ammo_effect_COOKOFF( "COOKOFF" );
 static const ammo_effect_str_id ammo_effect_EXPLOSIVE( "EXPLOSIVE" );
 static const ammo_effect_str_id ammo_effect_EXPLOSIVE_BIG( "EXPLOSIVE_BIG" );
@@ -194,6 +198,8 @@ auto defmode_name( itype &obj )
 
 void Item_factory::finalize_pre( itype &obj )
 {
+    // Flags may still change until finalize_post
+    obj.item_tag_bits.reset();
     // TODO: separate repairing from reinforcing/enhancement
     if( obj.damage_max() == obj.damage_min() ) {
         obj.item_tags.insert( flag_NO_REPAIR );
@@ -663,6 +669,7 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    obj.update_flag_bits();
 
     // handle complex firearms as a special case
     if( obj.gun && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
@@ -729,6 +736,10 @@ void Item_factory::finalize()
     // Wire Lua callback actor pointers onto itype objects
     resolve_lua_callbacks();
 
+    for( auto &g : m_template_groups ) {
+        g.second->finalize();
+    }
+
     // for each item register all (non-obsolete) potential recipes
     for( const std::pair<const recipe_id, recipe> &p : recipe_dict ) {
         const recipe &rec = p.second;
@@ -741,6 +752,23 @@ void Item_factory::finalize()
             it->second.recipes.push_back( p.first );
         }
     }
+
+    build_template_index();
+}
+
+void Item_factory::build_template_index()
+{
+    do {
+        template_index_version++;
+    } while( template_index_version == INVALID_VERSION );
+    m_template_version = template_index_version;
+
+    m_template_index.clear();
+    m_template_index.reserve( m_templates.size() );
+    for( auto &e : m_templates ) {
+        e.second.id.set_cid_version( static_cast<int>( m_template_index.size() ), m_template_version );
+        m_template_index.push_back( &e.second );
+    }
 }
 
 void Item_factory::finalize_item_blacklist()
@@ -1656,11 +1684,17 @@ const itype *Item_factory::find_template( const itype_id &id ) const
         assert( frozen );
     }
 
+    if( id._version == m_template_version && id._cid != INVALID_CID ) {
+        return m_template_index[id._cid];
+    }
+
     auto found = m_templates.find( id );
     if( found != m_templates.end() ) {
+        id.set_cid_version( found->second.id._cid, found->second.id._version );
         return &found->second;
     }
 
+    std::lock_guard<std::recursive_mutex> lock( m_runtimes_mutex );
     auto rt = m_runtimes.find( id );
     if( rt != m_runtimes.end() ) {
         return rt->second.get();
@@ -3060,6 +3094,8 @@ void Item_factory::clear()
     m_runtimes.clear();
     m_template_groups.clear();
     m_templates.clear();
+    m_template_index.clear();
+    m_template_version = INVALID_VERSION;
 
     gun_tools.clear();
     repair_actions.clear();
@@ -3718,7 +3754,14 @@ void item_group::debug_spawn()
 
 bool Item_factory::has_template( const itype_id &id ) const
 {
-    return m_templates.contains( id ) || m_runtimes.contains( id );
+    if( id._version == m_template_version && id._cid != INVALID_CID ) {
+        return true;
+    }
+    if( m_templates.contains( id ) ) {
+        return true;
+    }
+    std::lock_guard<std::recursive_mutex> lock( m_runtimes_mutex );
+    return m_runtimes.contains( id );
 }
 
 std::vector<const itype *> Item_factory::all() const
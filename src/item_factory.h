@@ -4,6 +4,7 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -251,8 +252,18 @@ class Item_factory
         std::map<itype_id, itype> m_abstracts;
 
         std::unordered_map<itype_id, itype> m_templates;
+        /**
+         * m_templates by dense index, built at finalization.  find_template() caches the index
+         * on the itype_id it is called with, tagged with m_template_version, the same way
+         * generic_factory caches int_ids.
+         */
+        std::vector<const itype *> m_template_index;
+        int64_t m_template_version = INVALID_VERSION;
+        void build_template_index();
 
         mutable std::map<itype_id, std::unique_ptr<itype>> m_runtimes;
+        /** Guards m_runtimes, which find_template() fills in from const code that may run in parallel */
+        mutable std::recursive_mutex m_runtimes_mutex;
 
         using GroupMap = std::map<item_group_id, std::unique_ptr<Item_spawn_data>>;
         GroupMap m_template_groups;
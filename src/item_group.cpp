@@ -66,7 +66,7 @@ detached_ptr<item> Single_item_creator::create_single( const time_point &birthda
             return detached_ptr<item>();
         }
         rec.push_back( id );
-        Item_spawn_data *isd = item_controller->get_group( item_group_id( id ) );
+        Item_spawn_data *isd = get_group();
         if( isd == nullptr ) {
             debugmsg( "unknown item spawn list %s", id.c_str() );
             return detached_ptr<item>();
@@ -113,7 +113,7 @@ std::vector<detached_ptr<item>> Single_item_creator::create( const time_point &b
                 return result;
             }
             rec.push_back( id );
-            Item_spawn_data *isd = item_controller->get_group( item_group_id( id ) );
+            Item_spawn_data *isd = get_group();
             if( isd == nullptr ) {
                 debugmsg( "unknown item spawn list %s", id.c_str() );
                 return result;
@@ -132,6 +132,28 @@ std::vector<detached_ptr<item>> Single_item_creator::create( const time_point &b
     return result;
 }
 
+Item_spawn_data *Single_item_creator::get_group() const
+{
+    // Groups made after finalization, like inline mapgen ones, are looked up every time
+    return group != nullptr ? group : item_controller->get_group( item_group_id( id ) );
+}
+
+void Single_item_creator::finalize()
+{
+    if( type == S_ITEM_GROUP ) {
+        group = item_controller->get_group( item_group_id( id ) );
+    }
+    if( modifier ) {
+        for( Item_spawn_data *isd : {
+                 modifier->ammo.get(), modifier->container.get(), modifier->contents.get()
+             } ) {
+            if( isd != nullptr ) {
+                isd->finalize();
+            }
+        }
+    }
+}
+
 void Single_item_creator::check_consistency( const std::string &context ) const
 {
     if( type == S_ITEM ) {
@@ -717,6 +739,24 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         sic->inherit_ammo_mag_chances( with_ammo, with_magazine );
     }
     items.push_back( std::move( ptr ) );
+    cumulative_prob.push_back( sum_prob );
+}
+
+void Item_group::update_cumulative_prob()
+{
+    cumulative_prob.clear();
+    int total = 0;
+    for( const auto &elem : items ) {
+        total += elem->probability;
+        cumulative_prob.push_back( total );
+    }
+}
+
+size_t Item_group::pick( const int p ) const
+{
+    // The first entry whose running total passes the roll, as walking the list would find
+    return std::distance( cumulative_prob.begin(),
+                          std::upper_bound( cumulative_prob.begin(), cumulative_prob.end(), p ) );
 }
 
 std::vector<detached_ptr<item>> Item_group::create( const time_point &birthday,
@@ -733,16 +773,9 @@ std::vector<detached_ptr<item>> Item_group::create( const time_point &birthday,
                            std::make_move_iterator( tmp.end() ) );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            p -= ( elem )->probability;
-            if( p >= 0 ) {
-                continue;
-            }
-            std::vector<detached_ptr<item>> tmp = ( elem )->create( birthday, rec );
-            result.insert( result.end(), std::make_move_iterator( tmp.begin() ),
-                           std::make_move_iterator( tmp.end() ) );
-            break;
+        const size_t picked = pick( rng( 0, sum_prob - 1 ) );
+        if( picked < items.size() ) {
+            result = items[picked]->create( birthday, rec );
         }
     }
 
@@ -759,13 +792,9 @@ detached_ptr<item> Item_group::create_single( const time_point &birthday, Recurs
             return ( elem )->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            p -= ( elem )->probability;
-            if( p >= 0 ) {
-                continue;
-            }
-            return ( elem )->create_single( birthday, rec );
+        const size_t picked = pick( rng( 0, sum_prob - 1 ) );
+        if( picked < items.size() ) {
+            return items[picked]->create_single( birthday, rec );
         }
     }
     return detached_ptr<item>();
@@ -778,6 +807,13 @@ void Item_group::check_consistency( const std::string &context ) const
     }
 }
 
+void Item_group::finalize()
+{
+    for( const auto &elem : items ) {
+        elem->finalize();
+    }
+}
+
 bool Item_group::remove_item( const itype_id &itemid )
 {
     for( prop_list::iterator a = items.begin(); a != items.end(); ) {
@@ -788,6 +824,7 @@ bool Item_group::remove_item( const itype_id &itemid )
             ++a;
         }
     }
+    update_cumulative_prob();
     return items.empty();
 }
 
@@ -800,7 +837,8 @@ bool Item_group::remove_specific_item( const std::string &itemid )
         } else if( b->type == Single_item_creator::Type::S_ITEM ) {
             if( itemid == b->id ) {
                 sum_prob -= ( *a )->probability;
-                a = items.erase( a );
+                items.erase( a );
+                update_cumulative_prob();
                 return true;
             }
             ++a;
@@ -820,7 +858,8 @@ bool Item_group::remove_specific_group( const std::string &itemid )
         } else if( b->type == Single_item_creator::Type::S_ITEM_GROUP ) {
             if( itemid == b->id ) {
                 sum_prob -= ( *a )->probability;
-                a = items.erase( a );
+                items.erase( a );
+                update_cumulative_prob();
                 return true;
             }
             ++a;
@@ -130,6 +130,11 @@ class Item_spawn_data
          * checking for valid item types and valid settings.
          */
         virtual void check_consistency( const std::string &context ) const = 0;
+        /**
+         * Called once all item groups are loaded, to look up ahead of time what
+         * spawning would otherwise look up on every roll.
+         */
+        virtual void finalize() {}
         /**
          * For item blacklisted, remove the given item from this and
          * all linked groups.
@@ -254,6 +259,7 @@ class Single_item_creator : public Item_spawn_data
                                                 RecursionList &rec ) const override;
         detached_ptr<item>create_single( const time_point &birthday, RecursionList &rec ) const override;
         void check_consistency( const std::string &context ) const override;
+        void finalize() override;
         bool remove_item( const itype_id &itemid ) override;
         bool replace_item( const itype_id &itemid, const itype_id &replacementid,
                            const std::string &context ) override;
@@ -261,6 +267,12 @@ class Single_item_creator : public Item_spawn_data
         bool has_item( const itype_id &itemid ) const override;
         std::set<const itype *> every_item() const override;
         std::vector<detached_ptr<item>> every_item_modified( bool modify = true ) const override;
+
+    private:
+        /** The group of an S_ITEM_GROUP entry, once @ref finalize has found it. */
+        Item_spawn_data *group = nullptr;
+
+        Item_spawn_data *get_group() const;
 };
 
 /**
@@ -311,6 +323,7 @@ class Item_group : public Item_spawn_data
         bool has_item( const itype_id &itemid ) const override;
         std::set<const itype *> every_item() const override;
         std::vector<detached_ptr<item>> every_item_modified( bool modify = true ) const override;
+        void finalize() override;
         /**
          * Hack for testing. TODO: Find a better way.
          */
@@ -338,6 +351,15 @@ class Item_group : public Item_spawn_data
          * Links to the entries in this group.
          */
         prop_list items;
+        /**
+         * Running total of the probabilities of @ref items, so a distribution can pick
+         * its entry with a binary search.
+         */
+        std::vector<int> cumulative_prob;
+
+        /** Index of the entry of a distribution that a roll of @p p in [0, sum_prob) picks. */
+        size_t pick( int p ) const;
+        void update_cumulative_prob();
 };
 
 
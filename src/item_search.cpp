@@ -1,6 +1,7 @@
 #include "item_search.h"
 
 #include <map>
+#include <set>
 #include <utility>
 
 #include "cata_utility.h"
@@ -14,53 +15,110 @@
 #include "type_id.h"
 #include "string_utils.h"
 
-std::pair<std::string, std::string> get_both( const std::string &a );
+namespace
+{
 
-std::function<bool( const item & )> basic_item_filter( std::string filter )
+using text_match = bool ( * )( const std::string &, const std::string & );
+
+bool lcmatch_text( const std::string &str, const std::string &qry )
+{
+    return lcmatch( str, qry );
+}
+
+/** Splits off the one letter field prefix of a basic query, if it has one. */
+char split_prefix( std::string &filter )
+{
+    const size_t colon = filter.find( ':' );
+    if( colon == std::string::npos || colon < 1 ) {
+        return '\0';
+    }
+    const char flag = filter[colon - 1];
+    filter = filter.substr( colon + 1 );
+    return flag;
+}
+
+std::pair<std::string, std::string> get_both( const std::string &a )
 {
-    size_t colon;
-    char flag = '\0';
-    if( ( colon = filter.find( ':' ) ) != std::string::npos ) {
-        if( colon >= 1 ) {
-            flag = filter[colon - 1];
-            filter = filter.substr( colon + 1 );
+    size_t split_mark = a.find( ';' );
+    return std::make_pair( a.substr( 0, split_mark ),
+                           a.substr( split_mark + 1 ) );
+}
+
+/**
+ * Ids of everything in @p all whose name matches @p filter.  There are only a few dozen
+ * of each, so resolving them up front lets items be checked by id instead of by name.
+ */
+template<typename Id, typename T, typename Ident, typename Name>
+std::set<Id> matching_ids( const std::vector<T> &all, Ident ident, Name name,
+                           const std::string &filter, text_match match )
+{
+    std::set<Id> result;
+    for( const T &e : all ) {
+        if( match( std::invoke( name, e ), filter ) ) {
+            result.insert( std::invoke( ident, e ) );
         }
     }
-    switch( flag ) {
+    return result;
+}
+
+std::set<item_category_id> matching_categories( const std::string &filter, text_match match )
+{
+    return matching_ids<item_category_id>( item_category::get_all(), &item_category::get_id,
+                                           &item_category::name, filter, match );
+}
+
+std::set<material_id> matching_materials( const std::string &filter, text_match match )
+{
+    return matching_ids<material_id>( materials::get_all(), &material_type::ident,
+                                      &material_type::name, filter, match );
+}
+
+std::set<quality_id> matching_qualities( const std::string &filter, text_match match )
+{
+    return matching_ids<quality_id>( quality::get_all(), []( const quality & q ) {
+        return q.id;
+    }, []( const quality & q ) {
+        return q.name.translated();
+    }, filter, match );
+}
+
+std::function<bool( const item & )> compile_item_filter( std::string filter, text_match match,
+        std::function<bool( const item & )>( *basic )( std::string ) )
+{
+    switch( split_prefix( filter ) ) {
         // category
         case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category().name(), filter );
+            return [cats = matching_categories( filter, match )]( const item & i ) {
+                return cats.contains( i.get_category().get_id() );
             };
         // material
         case 'm':
-            return [filter]( const item & i ) {
-                return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const material_id & mat ) {
-                    return lcmatch( mat->name(), filter );
+            return [mats = matching_materials( filter, match )]( const item & i ) {
+                return std::ranges::any_of( i.made_of(), [&mats]( const material_id & mat ) {
+                    return mats.contains( mat );
                 } );
             };
         // qualities
         case 'q':
-            return [filter]( const item & i ) {
-                return std::any_of( i.quality_of().begin(), i.quality_of().end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, filter );
+            return [quals = matching_qualities( filter, match )]( const item & i ) {
+                return std::ranges::any_of( i.quality_of(), [&quals]( const std::pair<quality_id, int> &e ) {
+                    return quals.contains( e.first );
                 } );
             };
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const auto pair = get_both( filter );
+            return [first = filter_from_string<item>( pair.first, basic ),
+                          second = filter_from_string<item>( pair.second, basic )]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [filter, match]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( auto &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( match( component.to_string(), filter ) ) {
                         return true;
                     }
                 }
@@ -68,76 +126,64 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [filter, match]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && match( note, filter );
             };
         // skill taught
         case 'k':
-            return [filter]( const item & i ) {
+            return [filter, match]( const item & i ) {
                 if( i.is_book() ) {
                     const islot_book &book = *i.type->book;
-                    return lcmatch( book.skill->name(), filter );
+                    return match( book.skill->name(), filter );
                 }
                 return false;
             };
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( a.tname(), filter );
+            return [filter, match]( const item & a ) {
+                return match( a.tname(), filter );
             };
     }
 }
 
-std::function<bool( const itype & )> basic_itype_filter( std::string filter )
+std::function<bool( const itype & )> compile_itype_filter( std::string filter, text_match match,
+        std::function<bool( const itype & )>( *basic )( std::string ) )
 {
-    size_t colon;
-    char flag = '\0';
-    if( ( colon = filter.find( ':' ) ) != std::string::npos ) {
-        if( colon >= 1 ) {
-            flag = filter[colon - 1];
-            filter = filter.substr( colon + 1 );
-        }
-    }
-    switch( flag ) {
+    switch( split_prefix( filter ) ) {
         // category
         case 'c':
-            return [filter]( const itype & i ) {
-                return lcmatch( i.category_force->name(), filter );
+            return [cats = matching_categories( filter, match )]( const itype & i ) {
+                return cats.contains( i.category_force );
             };
         // material
         case 'm':
-            return [filter]( const itype & i ) {
-                return std::any_of( i.materials.begin(), i.materials.end(),
-                [&filter]( const material_id & mat ) {
-                    return lcmatch( mat->name(), filter );
+            return [mats = matching_materials( filter, match )]( const itype & i ) {
+                return std::ranges::any_of( i.materials, [&mats]( const material_id & mat ) {
+                    return mats.contains( mat );
                 } );
             };
         case 'M':
-            return [filter]( const itype & i ) {
-                bool pure_material = true;
-                for( auto &mat : i.materials ) {
-                    if( !lcmatch( mat->name(), filter ) ) {
-                        pure_material = false;
-                    }
-                }
-                return pure_material;
+            return [mats = matching_materials( filter, match )]( const itype & i ) {
+                return std::ranges::all_of( i.materials, [&mats]( const material_id & mat ) {
+                    return mats.contains( mat );
+                } );
             };
         // qualities
         case 'q':
-            return [filter]( const itype & i ) {
-                return std::any_of( i.qualities.begin(), i.qualities.end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return lcmatch( e.first->name, filter );
+            return [quals = matching_qualities( filter, match )]( const itype & i ) {
+                return std::ranges::any_of( i.qualities, [&quals]( const std::pair<quality_id, int> &e ) {
+                    return quals.contains( e.first );
                 } );
             };
         // both
-        case 'b':
-            return [filter]( const itype & i ) {
-                auto pair = get_both( filter );
-                return itype_filter_from_string( pair.first )( i )
-                       && itype_filter_from_string( pair.second )( i );
+        case 'b': {
+            const auto pair = get_both( filter );
+            return [first = filter_from_string<itype>( pair.first, basic ),
+                          second = filter_from_string<itype>( pair.second, basic )]( const itype & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         // TODO: Move dissambled components into itype so we can implement this
         // case 'd':
@@ -152,21 +198,33 @@ std::function<bool( const itype & )> basic_itype_filter( std::string filter )
         //     };
         // skill taught
         case 'k':
-            return [filter]( const itype & i ) {
+            return [filter, match]( const itype & i ) {
                 if( i.book != NULL ) {
                     const islot_book &book = *i.book;
-                    return lcmatch( book.skill->name(), filter );
+                    return match( book.skill->name(), filter );
                 }
                 return false;
             };
         // by name
         default:
-            return [filter]( const itype & a ) {
-                return lcmatch( a.nname( 1 ), filter );
+            return [filter, match]( const itype & a ) {
+                return match( a.nname( 1 ), filter );
             };
     }
 }
 
+} // namespace
+
+std::function<bool( const item & )> basic_item_filter( std::string filter )
+{
+    return compile_item_filter( std::move( filter ), lcmatch_text, basic_item_filter );
+}
+
+std::function<bool( const itype & )> basic_itype_filter( std::string filter )
+{
+    return compile_itype_filter( std::move( filter ), lcmatch_text, basic_itype_filter );
+}
+
 std::function<bool( const item & )> item_filter_from_string( const std::string &filter )
 {
     return filter_from_string<item>( filter, basic_item_filter );
@@ -177,164 +235,51 @@ std::function<bool( const itype & )> itype_filter_from_string( const std::string
     return filter_from_string<itype>( filter, basic_itype_filter );
 }
 
-std::pair<std::string, std::string> get_both( const std::string &a )
-{
-    size_t split_mark = a.find( ';' );
-    return std::make_pair( a.substr( 0, split_mark ),
-                           a.substr( split_mark + 1 ) );
-}
-
-std::function<bool( const item & )> wildcard_item_filter( std::string filter )
+int filter_query_cost( const std::string &query )
 {
-    size_t colon;
-    char flag = '\0';
-    if( ( colon = filter.find( ':' ) ) != std::string::npos ) {
-        if( colon >= 1 ) {
-            flag = filter[colon - 1];
-            filter = filter.substr( colon + 1 );
-        }
+    const size_t colon = query.find( ':' );
+    if( colon == std::string::npos || colon < 1 ) {
+        // Names of items are put together from scratch
+        return 2;
     }
-    switch( flag ) {
-        // category
+    switch( query[colon - 1] ) {
         case 'c':
-            return [filter]( const item & i ) {
-                return wildcard_match( i.get_category().name(), filter );
-            };
-        // material
         case 'm':
-            return [filter]( const item & i ) {
-                return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const material_id & mat ) {
-                    return wildcard_match( mat->name(), filter );
-                } );
-            };
-        // qualities
+        case 'M':
         case 'q':
-            return [filter]( const item & i ) {
-                return std::any_of( i.quality_of().begin(), i.quality_of().end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return wildcard_match( e.first->name.translated(), filter );
-                } );
-            };
-        // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                auto func1 = filter_from_string<item>( pair.first, wildcard_item_filter );
-                auto func2 = filter_from_string<item>( pair.second, wildcard_item_filter );
-
-                return func1( i ) && func2( i );
-            };
-        // disassembled components
-        case 'd':
-            return [filter]( const item & i ) {
-                const auto &components = i.get_uncraft_components();
-                for( auto &component : components ) {
-                    if( wildcard_match( component.to_string(), filter ) ) {
-                        return true;
-                    }
-                }
-                return false;
-            };
-        // item notes
-        case 'n':
-            return [filter]( const item & i ) {
-                const std::string note = i.get_var( "item_note" );
-                return !note.empty() && wildcard_match( note, filter );
-            };
-        // skill taught
-        case 'k':
-            return [filter]( const item & i ) {
-                if( i.is_book() ) {
-                    const islot_book &book = *i.type->book;
-                    return wildcard_match( book.skill->name(), filter );
-                }
-                return false;
-            };
-        // by name
+            return 0;
         default:
-            return [filter]( const item & a ) {
-                return wildcard_match( a.tname(), filter );
-            };
+            return 1;
     }
 }
 
-std::function<bool( const itype & )> wildcard_itype_filter( std::string filter )
+bool filter_narrows( const std::string &wider, const std::string &narrower )
 {
-    size_t colon;
-    char flag = '\0';
-    if( ( colon = filter.find( ':' ) ) != std::string::npos ) {
-        if( colon >= 1 ) {
-            flag = filter[colon - 1];
-            filter = filter.substr( colon + 1 );
-        }
+    if( wider.empty() ) {
+        return true;
     }
-    switch( flag ) {
-        // category
-        case 'c':
-            return [filter]( const itype & i ) {
-                return wildcard_match( i.category_force->name(), filter );
-            };
-        // material
-        case 'm':
-            return [filter]( const itype & i ) {
-                return std::any_of( i.materials.begin(), i.materials.end(),
-                [&filter]( const material_id & mat ) {
-                    return wildcard_match( mat->name(), filter );
-                } );
-            };
-        case 'M':
-            return [filter]( const itype & i ) {
-                bool pure_material = true;
-                for( auto &mat : i.materials ) {
-                    if( !wildcard_match( mat->name(), filter ) ) {
-                        pure_material = false;
-                    }
-                }
-                return pure_material;
-            };
-        // qualities
-        case 'q':
-            return [filter]( const itype & i ) {
-                return std::any_of( i.qualities.begin(), i.qualities.end(),
-                [&filter]( const std::pair<quality_id, int> &e ) {
-                    return wildcard_match( e.first->name.translated(), filter );
-                } );
-            };
-        // both
-        case 'b':
-            return [filter]( const itype & i ) {
-                auto pair = get_both( filter );
-                auto func1 = filter_from_string<itype>( pair.first, wildcard_itype_filter );
-                auto func2 = filter_from_string<itype>( pair.second, wildcard_itype_filter );
-
-                return func1( i ) && func2( i );
-            };
-        // disassembled components
-        // TODO: Move dissambled components into itype so we can implement this
-        // case 'd':
-        //     return [filter]( const item & i ) {
-        //         const auto &components = i.get_uncraft_components();
-        //         for( auto &component : components ) {
-        //             if( lcmatch( component.to_string(), filter ) ) {
-        //                 return true;
-        //             }
-        //         }
-        //         return false;
-        //     };
-        // skill taught
-        case 'k':
-            return [filter]( const itype & i ) {
-                if( i.book != NULL ) {
-                    const islot_book &book = *i.book;
-                    return wildcard_match( book.skill->name(), filter );
-                }
-                return false;
-            };
-        // by name
-        default:
-            return [filter]( const itype & a ) {
-                return wildcard_match( a.nname( 1 ), filter );
-            };
+    if( !narrower.starts_with( wider ) ) {
+        return false;
+    }
+    // Alternatives and exclusions can match more as they grow
+    if( narrower[0] == '-' || narrower.find_first_of( ",{}" ) != std::string::npos ) {
+        return false;
     }
-}
\ No newline at end of file
+    const size_t colon = wider.find( ':' );
+    if( colon == std::string::npos ) {
+        // Typing the colon of a prefix switches from the name to another field
+        return narrower.find( ':', wider.size() ) == std::string::npos;
+    }
+    // Both halves of b: are matched separately
+    return colon == 0 || wider[colon - 1] != 'b';
+}
+
+std::function<bool( const item & )> wildcard_item_filter( std::string filter )
+{
+    return compile_item_filter( std::move( filter ), wildcard_match, wildcard_item_filter );
+}
+
+std::function<bool( const itype & )> wildcard_itype_filter( std::string filter )
+{
+    return compile_itype_filter( std::move( filter ), wildcard_match, wildcard_itype_filter );
+}
@@ -4,13 +4,21 @@
 #include <algorithm>
 #include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "string_utils.h"
 #include "itype.h"
 
+/**
+ * Rough cost of checking a single query without commas, for checking cheap ones first.
+ * Queries by category, material or quality are resolved to ids when they are compiled.
+ */
+int filter_query_cost( const std::string &query );
+
 /**
  * Get a function that returns true if the value matches the query.
+ * The query is only parsed here, so keep the function around for checking many values.
  */
 template<typename T>
 std::function<bool( const T & )> filter_from_string( std::string filter,
@@ -35,16 +43,12 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
         std::vector<std::function<bool( const T & )> > functions;
         // Functions that must all return true
         std::vector<std::function<bool( const T & )> > inv_functions;
+        std::vector<std::pair<int, std::string>> queries;
         size_t comma = filter.find( ',' );
         while( !filter.empty() ) {
             const auto &current_filter = trim( filter.substr( 0, comma ) );
             if( !current_filter.empty() ) {
-                auto current_func = filter_from_string( current_filter, basic_filter );
-                if( current_filter[0] == '-' ) {
-                    inv_functions.push_back( current_func );
-                } else {
-                    functions.push_back( current_func );
-                }
+                queries.emplace_back( filter_query_cost( current_filter ), current_filter );
             }
             if( comma != std::string::npos ) {
                 filter = trim( filter.substr( comma + 1 ) );
@@ -53,6 +57,16 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
                 break;
             }
         }
+        // The results don't depend on the order, but the cheap checks can spare the others
+        std::ranges::stable_sort( queries, {}, &std::pair<int, std::string>::first );
+        for( const auto &[cost, current_filter] : queries ) {
+            auto current_func = filter_from_string( current_filter, basic_filter );
+            if( current_filter[0] == '-' ) {
+                inv_functions.push_back( current_func );
+            } else {
+                functions.push_back( current_func );
+            }
+        }
 
         return [functions, inv_functions]( const T & it ) {
             auto apply = [&]( const std::function<bool( const T & )> &func ) {
@@ -75,8 +89,8 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
     }
     const bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter, basic_filter]( const T & i ) {
-            return !filter_from_string( filter.substr( 1 ), basic_filter )( i );
+        return [included = filter_from_string( filter.substr( 1 ), basic_filter )]( const T & i ) {
+            return !included( i );
         };
     }
 
@@ -102,5 +116,12 @@ std::function<bool( const item & )> basic_item_filter( std::string filter );
  */
 std::function<bool( const itype & )> basic_itype_filter( std::string filter );
 
+/**
+ * Whether @p narrower can only match what @p wider matches, judging by the queries alone,
+ * so a list already filtered by @p wider only needs its matches checked again.
+ * That's the case when @p narrower appends plain text to a single substring query.
+ */
+bool filter_narrows( const std::string &wider, const std::string &narrower );
+
 std::function<bool( const item & )> wildcard_item_filter( std::string filter );
 std::function<bool( const itype & )> wildcard_itype_filter( std::string filter );
\ No newline at end of file
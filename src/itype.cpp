@@ -164,9 +164,19 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
+    if( item_tag_bits ) {
+        if( const std::optional<size_t> bit = flag_bits::position( flag ) ) {
+            return item_tag_bits->test( *bit );
+        }
+    }
     return item_tags.contains( flag );
 }
 
+void itype::update_flag_bits()
+{
+    item_tag_bits = flag_bits::of( item_tags );
+}
+
 const itype::FlagsSetType &itype::get_flags() const
 {
     return item_tags;
@@ -19,6 +19,7 @@
 #include "data_vars.h"
 #include "enums.h" // point
 #include "explosion.h"
+#include "flag_bits.h"
 #include "game_constants.h"
 #include "hsv_color.h"
 #include "iuse.h" // use_function
@@ -1135,6 +1136,10 @@ struct itype {
         int repair_difficulty = -1;
 
         FlagsSetType item_tags;
+        /** @ref item_tags as bits, from when the type is finalized on. */
+        std::optional<flag_bits::bitset> item_tag_bits;
+        /** Builds @ref item_tag_bits, after which @ref item_tags must not change. */
+        void update_flag_bits();
 
         std::string get_item_type_string() const;
 
@@ -1,6 +1,7 @@
 #include "json.h"
 
 #include <algorithm>
+#include <bit>
 #include <bitset>
 #include <cmath> // pow
 #include <cstdint>
@@ -19,6 +20,7 @@
 
 #include "cached_options.h"
 #include "cata_utility.h"
+#include "contiguous_streambuf.h"
 #include "debug.h"
 #include "string_formatter.h"
 #include "string_utils.h"
@@ -32,6 +34,186 @@ static bool is_whitespace( char ch )
     return ( ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r' );
 }
 
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#define CATA_JSON_SSE2
+#include <emmintrin.h>
+#endif
+
+// Scanners for contiguous buffers.  Each returns the first byte in [p, end)
+// it has to stop at, or end; with SSE2 they test 16 bytes at a time.
+
+#if defined(CATA_JSON_SSE2)
+static __m128i load16( const char *p )
+{
+    return _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) );
+}
+
+static __m128i any_of( const __m128i v, const char a, const char b, const char c, const char d )
+{
+    return _mm_or_si128( _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( a ) ),
+                                       _mm_cmpeq_epi8( v, _mm_set1_epi8( b ) ) ),
+                         _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( c ) ),
+                                       _mm_cmpeq_epi8( v, _mm_set1_epi8( d ) ) ) );
+}
+#endif
+
+// Stops at the first non-whitespace byte
+static const char *scan_whitespace( const char *p, const char *const end )
+{
+#if defined(CATA_JSON_SSE2)
+    for( ; end - p >= 16; p += 16 ) {
+        const unsigned ws = _mm_movemask_epi8( any_of( load16( p ), ' ', '\n', '\t', '\r' ) );
+        if( ws != 0xffff ) {
+            return p + std::countr_zero( ~ws );
+        }
+    }
+#endif
+    while( p != end && is_whitespace( *p ) ) {
+        ++p;
+    }
+    return p;
+}
+
+// Stops where skip_string has to look: quotes, backslashes and line breaks
+static const char *scan_string_skip( const char *p, const char *const end )
+{
+#if defined(CATA_JSON_SSE2)
+    for( ; end - p >= 16; p += 16 ) {
+        const unsigned hit = _mm_movemask_epi8( any_of( load16( p ), '"', '\\', '\r', '\n' ) );
+        if( hit != 0 ) {
+            return p + std::countr_zero( hit );
+        }
+    }
+#endif
+    while( p != end && *p != '"' && *p != '\\' && *p != '\r' && *p != '\n' ) {
+        ++p;
+    }
+    return p;
+}
+
+// Stops at anything get_string cannot copy verbatim: quotes, escapes,
+// control characters and UTF-8 sequences, which it validates
+static const char *scan_string_plain( const char *p, const char *const end )
+{
+    const auto plain = []( const char ch ) {
+        const unsigned char uc = static_cast<unsigned char>( ch );
+        return uc >= 0x20 && uc < 0x80 && ch != '"' && ch != '\\';
+    };
+#if defined(CATA_JSON_SSE2)
+    for( ; end - p >= 16; p += 16 ) {
+        const __m128i v = load16( p );
+        // Signed compare: bytes from 0x80 up are negative, so this also catches them.
+        const __m128i special = _mm_or_si128( _mm_cmplt_epi8( v, _mm_set1_epi8( 0x20 ) ),
+                                              _mm_or_si128( _mm_cmpeq_epi8( v, _mm_set1_epi8( '"' ) ),
+                                                      _mm_cmpeq_epi8( v, _mm_set1_epi8( '\\' ) ) ) );
+        const unsigned hit = _mm_movemask_epi8( special );
+        if( hit != 0 ) {
+            return p + std::countr_zero( hit );
+        }
+    }
+#endif
+    while( p != end && plain( *p ) ) {
+        ++p;
+    }
+    return p;
+}
+
+// Deeper values go through the checked path
+static constexpr int max_fast_skip_depth = 128;
+
+// From just after an opening quote to just after the closing one, or nullptr
+// if the string has to be looked at by skip_string
+static const char *scan_string_body( const char *p, const char *const end )
+{
+    while( true ) {
+        p = scan_string_skip( p, end );
+        if( p == end || *p == '\r' || *p == '\n' ) {
+            return nullptr;
+        }
+        if( *p == '"' ) {
+            return p + 1;
+        }
+        // Like skip_string, take whatever follows the backslash.
+        if( end - p < 2 ) {
+            return nullptr;
+        }
+        p += 2;
+    }
+}
+
+static const char *scan_literal( const char *p, const char *const end, const std::string_view word )
+{
+    if( static_cast<size_t>( end - p ) < word.size() || std::string_view( p, word.size() ) != word ) {
+        return nullptr;
+    }
+    return p + word.size();
+}
+
+/**
+ * Skips one value, accepting exactly what skip_value accepts, trailing commas
+ * included.  Returns nullptr instead of reporting anything: the caller then
+ * reruns the checked path from the same position, which reports the error.
+ */
+static const char *scan_value( const char *p, const char *const end, const int depth )
+{
+    p = scan_whitespace( p, end );
+    if( p == end ) {
+        return nullptr;
+    }
+    switch( *p ) {
+        case '"':
+            return scan_string_body( p + 1, end );
+        case '{':
+        case '[': {
+            if( depth >= max_fast_skip_depth ) {
+                return nullptr;
+            }
+            const bool object = *p == '{';
+            const char close = object ? '}' : ']';
+            p = scan_whitespace( p + 1, end );
+            while( p != end && *p != close ) {
+                if( object ) {
+                    if( *p != '"' || !( p = scan_string_body( p + 1, end ) ) ) {
+                        return nullptr;
+                    }
+                    p = scan_whitespace( p, end );
+                    if( p == end || *p != ':' ) {
+                        return nullptr;
+                    }
+                    ++p;
+                }
+                if( !( p = scan_value( p, end, depth + 1 ) ) ) {
+                    return nullptr;
+                }
+                p = scan_whitespace( p, end );
+                if( p != end && *p == ',' ) {
+                    p = scan_whitespace( p + 1, end );
+                } else if( p == end || *p != close ) {
+                    return nullptr;
+                }
+            }
+            return p == end ? nullptr : p + 1;
+        }
+        case 't':
+            return scan_literal( p, end, "true" );
+        case 'f':
+            return scan_literal( p, end, "false" );
+        case 'n':
+            return scan_literal( p, end, "null" );
+        default:
+            break;
+    }
+    if( *p != '-' && ( *p < '0' || *p > '9' ) ) {
+        return nullptr;
+    }
+    // skip all of (+-0123456789.eE), as skip_number does
+    while( p != end && ( *p == '+' || *p == '-' || ( *p >= '0' && *p <= '9' ) ||
+                         *p == 'e' || *p == 'E' || *p == '.' ) ) {
+        ++p;
+    }
+    return p;
+}
+
 // for parsing \uxxxx escapes
 static std::string utf16_to_utf8( uint32_t ch )
 {
@@ -809,6 +991,16 @@ void add_array_to_set( std::set<std::string> &s, const JsonObject &json, const s
     }
 }
 
+contiguous_streambuf *JsonIn::contiguous_buffer( std::istream &s )
+{
+    return dynamic_cast<contiguous_streambuf *>( s.rdbuf() );
+}
+
+contiguous_streambuf *JsonIn::fast_buffer()
+{
+    return buffer != nullptr && stream->good() ? buffer : nullptr;
+}
+
 int JsonIn::tell()
 {
     return stream->tellg();
@@ -831,6 +1023,11 @@ void JsonIn::seek( int pos )
 
 void JsonIn::eat_whitespace()
 {
+    if( contiguous_streambuf *const buf = fast_buffer() ) {
+        const std::string_view rest = buf->remaining();
+        buf->advance( scan_whitespace( rest.data(), rest.data() + rest.size() ) - rest.data() );
+        // The loop below then only peeks, which sets eof at the end like before.
+    }
     while( is_whitespace( peek() ) ) {
         stream->get();
     }
@@ -911,6 +1108,16 @@ void JsonIn::skip_string()
 {
     char ch;
     eat_whitespace();
+    if( contiguous_streambuf *const buf = fast_buffer() ) {
+        const std::string_view rest = buf->remaining();
+        if( !rest.empty() && rest.front() == '"' ) {
+            if( const char *after = scan_string_body( rest.data() + 1, rest.data() + rest.size() ) ) {
+                buf->advance( after - rest.data() );
+                end_value();
+                return;
+            }
+        }
+    }
     stream->get( ch );
     if( ch != '"' ) {
         std::stringstream err;
@@ -934,6 +1141,15 @@ void JsonIn::skip_string()
 void JsonIn::skip_value()
 {
     eat_whitespace();
+    if( contiguous_streambuf *const buf = fast_buffer() ) {
+        const std::string_view rest = buf->remaining();
+        if( const char *after = scan_value( rest.data(), rest.data() + rest.size(), 0 ) ) {
+            buf->advance( after - rest.data() );
+            end_value();
+            return;
+        }
+        // Malformed or very deep: the checked path below reports or handles it.
+    }
     char ch = peek();
     // it's either a string '"'
     if( ch == '"' ) {
@@ -1197,6 +1413,13 @@ std::string JsonIn::get_string()
         }
         // add chars to the string, one at a time
         do {
+            // Plain runs are copied straight out of a contiguous buffer.
+            if( contiguous_streambuf *const buf = fast_buffer() ) {
+                const std::string_view rest = buf->remaining();
+                const char *const stop = scan_string_plain( rest.data(), rest.data() + rest.size() );
+                s.append( rest.data(), stop );
+                buf->advance( stop - rest.data() );
+            }
             ch = stream->peek();
             if( !stream->good() ) {
                 err = "read operation failed";
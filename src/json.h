@@ -38,6 +38,7 @@
  * Further documentation can be found below.
  */
 
+class contiguous_streambuf;
 class JsonArray;
 class JsonDeserializer;
 class JsonObject;
@@ -171,19 +172,25 @@ class JsonIn
 {
     private:
         std::istream *stream;
+        // The stream's buffer when it is contiguous, for the scanning fast paths
+        contiguous_streambuf *buffer;
         shared_ptr_fast<std::string> path;
         bool ate_separator = false;
 
+        static contiguous_streambuf *contiguous_buffer( std::istream &s );
+        // The buffer, if the fast paths can use it at the current position
+        contiguous_streambuf *fast_buffer();
+
         void skip_separator();
         void skip_pair_separator();
         void end_value();
 
     public:
-        JsonIn( std::istream &s ) : stream( &s ) {}
+        JsonIn( std::istream &s ) : stream( &s ), buffer( contiguous_buffer( s ) ) {}
         JsonIn( std::istream &s, const std::string &path )
-            : stream( &s ), path( make_shared_fast<std::string>( path ) ) {}
+            : stream( &s ), buffer( contiguous_buffer( s ) ), path( make_shared_fast<std::string>( path ) ) {}
         JsonIn( std::istream &s, const json_source_location &loc )
-            : stream( &s ), path( loc.path ) {
+            : stream( &s ), buffer( contiguous_buffer( s ) ), path( loc.path ) {
             seek( loc.offset );
         }
         JsonIn( const JsonIn & ) = delete;
@@ -153,6 +153,11 @@ void kill_tracker::notify( const cata::event &e )
     }
 }
 
+auto kill_tracker::subscribed_events() const -> std::vector<event_type>
+{
+    return { event_type::character_kills_monster, event_type::character_kills_character };
+}
+
 void kill_tracker::add_monster( mtype_id victim )
 {
     kills[victim]++;
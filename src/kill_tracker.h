@@ -43,6 +43,7 @@ class kill_tracker : public event_subscriber
         void clear();
 
         void notify( const cata::event & ) override;
+        auto subscribed_events() const -> std::vector<event_type> override;
         /** directly adds a monster kill to the tracker, bypassing the event bus. */
         void add_monster( mtype_id );
         /** directly adds an NPC kill to the tracker, bypassing the event bus. */
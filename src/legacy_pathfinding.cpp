@@ -239,8 +239,6 @@ auto get_legacy_pathfinding_tile( const map &here,
     const auto tile = here.maptile_at_internal( bubble_pos );
     auto vehicle_part = -1;
     const auto *vehicle = here.veh_at_internal( bubble_pos, vehicle_part );
-    const auto &terrain = tile.get_ter_t();
-    const auto &furniture = tile.get_furn_t();
 
     return legacy_pathfinding_tile {
         .terrain = tile.get_ter(),
@@ -248,20 +246,20 @@ auto get_legacy_pathfinding_tile( const map &here,
         .trap = tile.get_trap(),
         .vehicle_ptr_ = vehicle,
         .vehicle_part = vehicle_part,
-        .move_cost = here.move_cost_internal( furniture, terrain, vehicle, vehicle_part ),
+        .move_cost = here.move_cost_internal( tile.get_furn(), tile.get_ter(), vehicle, vehicle_part ),
     };
 }
 
 auto get_pf_special_from_tile( const legacy_pathfinding_tile &tile ) -> pf_special
 {
     auto cur_value = PF_NORMAL;
-    const auto &terrain = tile.terrain.obj();
+    const auto ter_flags = cache_attr::of( tile.terrain );
 
     if( tile.move_cost > 2 ) {
         cur_value |= PF_SLOW;
     } else if( tile.move_cost <= 0 ) {
         cur_value |= PF_WALL;
-        if( terrain.has_flag( TFLAG_CLIMBABLE ) ) {
+        if( ( ter_flags & cache_attr::climbable ) != 0 ) {
             cur_value |= PF_CLIMBABLE;
         }
     }
@@ -270,17 +268,15 @@ auto get_pf_special_from_tile( const legacy_pathfinding_tile &tile ) -> pf_speci
         cur_value |= PF_VEHICLE;
     }
 
-    if( !tile.trap.obj().is_benign() || !terrain.trap.obj().is_benign() ) {
+    if( !tile.trap.obj().is_benign() || !tile.terrain.obj().trap.obj().is_benign() ) {
         cur_value |= PF_TRAP;
     }
 
-    if( terrain.has_flag( TFLAG_GOES_DOWN ) || terrain.has_flag( TFLAG_GOES_UP ) ||
-        terrain.has_flag( TFLAG_RAMP ) || terrain.has_flag( TFLAG_RAMP_UP ) ||
-        terrain.has_flag( TFLAG_RAMP_DOWN ) ) {
+    if( ( ter_flags & cache_attr::changes_level ) != 0 ) {
         cur_value |= PF_UPDOWN;
     }
 
-    if( terrain.has_flag( TFLAG_SHARP ) ) {
+    if( ( ter_flags & cache_attr::sharp ) != 0 ) {
         cur_value |= PF_SHARP;
     }
 
@@ -460,15 +456,17 @@ std::vector<tripoint_abs_ms> map::route( const tripoint_abs_ms &f, const tripoin
                     continue;
                 }
 
-                const auto &terrain = p_tile->terrain.obj();
-                const auto &furniture = p_tile->furniture.obj();
+                const auto ter_flags = cache_attr::of( p_tile->terrain );
+                const auto furn_flags = cache_attr::of( p_tile->furniture );
+                const bool ter_opens = ( ter_flags & cache_attr::openable ) != 0;
+                const bool furn_opens = ( furn_flags & cache_attr::openable ) != 0;
 
                 const int cost = p_tile->move_cost;
                 // Don't calculate bash rating unless we intend to actually use it
                 const int rating = ( bash == 0 || cost != 0 ) ? -1 :
-                                   bash_rating_internal( bash, furniture, terrain, false, veh, part );
+                                   bash_rating_internal( bash, p_tile->furniture, p_tile->terrain, false, veh, part );
 
-                if( cost == 0 && rating <= 0 && ( !doors || !terrain.open || !furniture.open ) && veh == nullptr &&
+                if( cost == 0 && rating <= 0 && ( !doors || !ter_opens || !furn_opens ) && veh == nullptr &&
                     climb_cost <= 0 ) {
                     layer.state[index] = ASL_CLOSED; // Close it so that next time we won't try to calculate costs
                     continue;
@@ -479,8 +477,9 @@ std::vector<tripoint_abs_ms> map::route( const tripoint_abs_ms &f, const tripoin
                     if( climb_cost > 0 && p_special & PF_CLIMBABLE ) {
                         // Climbing fences
                         newg += climb_cost;
-                    } else if( doors && ( terrain.open || furniture.open ) &&
-                               ( !terrain.has_flag( "OPENCLOSE_INSIDE" ) || !furniture.has_flag( "OPENCLOSE_INSIDE" ) ||
+                    } else if( doors && ( ter_opens || furn_opens ) &&
+                               ( ( ter_flags & cache_attr::opens_inside ) == 0 ||
+                                 ( furn_flags & cache_attr::opens_inside ) == 0 ||
                                  !is_outside( abs_to_map_local( *this, cur ) ) ) ) {
                         // Only try to open INSIDE doors from the inside
                         // To open and then move onto the tile
@@ -524,7 +523,7 @@ std::vector<tripoint_abs_ms> map::route( const tripoint_abs_ms &f, const tripoin
                         newg += 500;
                     } else {
                         // Unbashable and unopenable from here
-                        if( !doors || !terrain.open || !furniture.open ) {
+                        if( !doors || !ter_opens || !furn_opens ) {
                             // Or anywhere else for that matter
                             layer.state[index] = ASL_CLOSED;
                         }
@@ -534,11 +533,11 @@ std::vector<tripoint_abs_ms> map::route( const tripoint_abs_ms &f, const tripoin
                 }
 
                 if( trapavoid && p_special & PF_TRAP ) {
-                    const auto &ter_trp = terrain.trap.obj();
+                    const auto &ter_trp = p_tile->terrain.obj().trap.obj();
                     const auto &trp = ter_trp.is_benign() ? p_tile->trap.obj() : ter_trp;
                     if( !trp.is_benign() ) {
                         // For now make them detect all traps
-                        if( terrain.has_flag( TFLAG_NO_FLOOR ) ) {
+                        if( ( ter_flags & cache_attr::ledge ) != 0 ) {
                             // Special case - ledge in z-levels
                             // Warning: really expensive, needs a cache
                             const auto below = p + tripoint_rel_ms::below();
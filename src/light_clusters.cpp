@@ -0,0 +1,133 @@
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ranges>
+#include <span>
+#include <tuple>
+
+namespace light_clusters
+{
+
+namespace
+{
+
+// Directions and widths closer than this are the same.
+constexpr auto angle_step_degrees = 0.1;
+constexpr auto angle_steps_per_turn = static_cast<long long>( 360.0 / angle_step_degrees );
+
+auto direction_key( const units::angle a ) -> long long
+{
+    const auto steps = std::llround( units::to_degrees( a ) / angle_step_degrees );
+    return ( steps % angle_steps_per_turn + angle_steps_per_turn ) % angle_steps_per_turn;
+}
+
+auto width_key( const units::angle a ) -> long long
+{
+    return std::llround( units::to_degrees( a ) / angle_step_degrees );
+}
+
+// Lights with equal keys may merge.
+auto key_of( const emitter &e )
+{
+    const auto is_arc = e.shape == emitter_shape::arc;
+    return std::tuple( e.p.z(), static_cast<int>( e.shape ), reinterpret_cast<std::uintptr_t>( e.scope ),
+                       e.color_rgb, is_arc ? direction_key( e.direction ) : 0,
+                       is_arc ? width_key( e.width ) : 0 );
+}
+
+auto chebyshev( const point_bub_ms &a, const point_bub_ms &b ) -> int
+{
+    return std::max( std::abs( a.x() - b.x() ), std::abs( a.y() - b.y() ) );
+}
+
+// How far around itself a light gathers neighbours.
+auto merge_reach( const emitter &e, const options &opt ) -> int
+{
+    if( opt.lod_distance <= 0 ) {
+        return 0;
+    }
+    // Off the viewer's level the light is only seen from afar.
+    if( e.p.z() != opt.viewer.z() ) {
+        return 2;
+    }
+    const auto d = chebyshev( e.p.xy(), opt.viewer.xy() );
+    return d <= opt.lod_distance ? 0 : d <= 2 * opt.lod_distance ? 1 : 2;
+}
+
+auto tile_of( const emitter &e )
+{
+    return std::pair( e.p.x(), e.p.y() );
+}
+
+// Clusters one group of lights sharing a key, brightest first.
+auto cluster_group( std::span<const emitter> group, const options &opt,
+                    std::vector<cluster> &out ) -> void
+{
+    auto by_tile = std::vector<int>( group.size() );
+    for( int i = 0; i < static_cast<int>( group.size() ); ++i ) {
+        by_tile[i] = i;
+    }
+    std::ranges::sort( by_tile, {}, [&]( const int i ) {
+        return tile_of( group[i] );
+    } );
+    auto taken = std::vector<bool>( group.size(), false );
+
+    for( int seed = 0; seed < static_cast<int>( group.size() ); ++seed ) {
+        if( taken[seed] ) {
+            continue;
+        }
+        taken[seed] = true;
+        const auto &light = group[seed];
+        auto c = cluster{ .light = light, .members = 1, .min = light.p.xy(), .max = light.p.xy() };
+
+        const auto reach = merge_reach( light, opt );
+        for( int dx = -reach; dx <= reach; ++dx ) {
+            for( int dy = -reach; dy <= reach; ++dy ) {
+                const auto tile = std::pair( light.p.x() + dx, light.p.y() + dy );
+                const auto [first, last] = std::ranges::equal_range( by_tile, tile, {}, [&]( const int i ) {
+                    return tile_of( group[i] );
+                } );
+                for( const auto other : std::ranges::subrange( first, last ) ) {
+                    // Away from the seed, both ends must be far enough to merge.
+                    if( taken[other] || ( ( dx != 0 || dy != 0 ) && merge_reach( group[other], opt ) == 0 ) ) {
+                        continue;
+                    }
+                    taken[other] = true;
+                    ++c.members;
+                    c.min = point_bub_ms( std::min( c.min.x(), group[other].p.x() ),
+                                          std::min( c.min.y(), group[other].p.y() ) );
+                    c.max = point_bub_ms( std::max( c.max.x(), group[other].p.x() ),
+                                          std::max( c.max.y(), group[other].p.y() ) );
+                }
+            }
+        }
+        out.push_back( c );
+    }
+}
+
+} // namespace
+
+auto cluster_emitters( std::vector<emitter> emitters,
+                       const options &opt ) -> std::vector<cluster>
+{
+    std::ranges::sort( emitters, []( const emitter & a, const emitter & b ) {
+        return std::tuple( key_of( a ), b.luminance ) < std::tuple( key_of( b ), a.luminance );
+    } );
+
+    auto out = std::vector<cluster> {};
+    out.reserve( emitters.size() );
+    auto begin = emitters.begin();
+    while( begin != emitters.end() ) {
+        const auto key = key_of( *begin );
+        const auto end = std::find_if( begin, emitters.end(), [&]( const emitter & e ) {
+            return key_of( e ) != key;
+        } );
+        cluster_group( std::span( begin, end ), opt, out );
+        begin = end;
+    }
+    return out;
+}
+
+} // namespace light_clusters
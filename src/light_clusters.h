@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "coordinates.h"
+#include "units_angle.h"
+
+class vehicle;
+
+/**
+ * Merging of vehicle lights into fewer emitters before they are cast.
+ *
+ * Headlights, floodlights and dome lights each cost a cast of their own, so a convoy or
+ * a lit base casts hundreds of lights that mostly land on the same tiles.  Lights of the
+ * same shape, direction, width and colour merge:
+ *  - where they share a tile, into the brightest of them, which covers the others since
+ *    light combines by max;
+ *  - past the LOD distance from the viewer, with their neighbours too: within one tile,
+ *    or two past twice that distance.  The brightest light of each group is cast for it.
+ */
+namespace light_clusters
+{
+
+enum class emitter_shape : int {
+    point,
+    arc,
+};
+
+struct emitter {
+    tripoint_bub_ms p;
+    emitter_shape shape = emitter_shape::point;
+    /// Arcs only.
+    units::angle direction = units::from_degrees( 0 );
+    units::angle width = units::from_degrees( 360 );
+    float luminance = 0.0f;
+    uint32_t color_rgb = 0u;
+    /// Lights only merge within one scope; external vehicle lights are cast against
+    /// their own vehicle's cache, so they use the vehicle.
+    const vehicle *scope = nullptr;
+};
+
+struct cluster {
+    /// What to cast for the cluster.
+    emitter light;
+    int members = 0;
+    /// Corners of the box holding every member, for the debug overlay.
+    point_bub_ms min;
+    point_bub_ms max;
+};
+
+struct options {
+    tripoint_bub_ms viewer;
+    /// Chebyshev distance from the viewer past which neighbours merge; 0 for never.
+    int lod_distance = 0;
+};
+
+/** Clusters of @p emitters, in no particular order. */
+auto cluster_emitters( std::vector<emitter> emitters, const options &opt ) -> std::vector<cluster>;
+
+} // namespace light_clusters
@@ -36,6 +36,7 @@
 #include "item.h"
 #include "item_stack.h"
 #include "itype.h"
+#include "light_clusters.h"
 #include "line.h"
 #include "map.h"
 #include "mapbuffer.h"
@@ -88,13 +89,14 @@ auto has_vertical_light_blocker( const level_cache &cache, const int x, const in
 
 struct vehicle_external_light_cache_scope {
     level_cache &cache;
+    const vehicle &veh;
     std::vector<std::pair<std::size_t, float>> transparency_restore;
     std::vector<std::pair<std::size_t, diagonal_blocks>> obscured_restore;
     std::vector<std::pair<std::size_t, float>> lm_restore;
     std::vector<std::pair<std::size_t, float>> sm_restore;
 
-    vehicle_external_light_cache_scope( level_cache &cache, vehicle &veh, const int zlev ) :
-        cache( cache ) {
+    vehicle_external_light_cache_scope( level_cache &cache, const vehicle &veh, const int zlev ) :
+        cache( cache ), veh( veh ) {
         for( const auto &part : veh.get_all_parts() ) {
             const auto pos = part.pos();
             if( pos.z() != zlev || !cache.inbounds( pos.xy() ) ) {
@@ -494,6 +496,65 @@ auto make_colored_light_callback( level_cache &cache, const uint32_t color_rgb,
 
 auto apply_cpu_colored_light_3d( map &here, const cpu_colored_light_opt &opt ) -> void;
 
+struct point_light_rays {
+    float luminance = 0.0f;
+    uint8_t octants = 0;
+};
+
+/* The rays apply_light_source casts for a source of @p luminance at @p p: none for dim
+     sources, and none into octants that brighter-or-equal buffered neighbours already light.
+
+   If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
+     neighboring fires to the north and west that were applied via light_source_buffer
+   If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
+   If there's a 100 luminance magnesium flare south added via apply_light_source instead od
+     add_light_source, it's unbuffered so we'll still cast rays into sy.
+
+      ey
+    nnnNnnn
+    w     e
+    w  5 +e
+ sx W 5*1+E ex
+    w ++++e
+    w+++++e
+    sssSsss
+       sy
+*/
+auto rays_of_point_light( const level_cache &cache, const point_bub_ms &p,
+                          float luminance ) -> point_light_rays
+{
+    if( luminance <= lit_level::LOW ) {
+        return {};
+    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
+        luminance = 1.49f;
+    }
+    const float *lsb_data = cache.light_source_buffer.data();
+    const int sx = cache.cache_x;
+    const int sy = cache.cache_y;
+    bool north = ( p.y() != 0       && lsb_data[cache.idx( p.x(), p.y() - 1 )] < luminance );
+    bool south = ( p.y() != sy - 1  && lsb_data[cache.idx( p.x(), p.y() + 1 )] < luminance );
+    bool east  = ( p.x() != sx - 1  && lsb_data[cache.idx( p.x() + 1, p.y() )] < luminance );
+    bool west  = ( p.x() != 0       && lsb_data[cache.idx( p.x() - 1, p.y() )] < luminance );
+
+    // Build octant mask from the directions that have a weaker-or-absent neighbor
+    // in the light-source buffer.  Skipping covered directions is an optimization
+    // for dense fire / lava: equal-brightness neighbors already project those rays.
+    auto mask = uint8_t{};
+    if( north ) {
+        mask |= OCTANT_NORTH;
+    }
+    if( east ) {
+        mask |= OCTANT_EAST;
+    }
+    if( south ) {
+        mask |= OCTANT_SOUTH;
+    }
+    if( west ) {
+        mask |= OCTANT_WEST;
+    }
+    return { luminance, mask };
+}
+
 } // namespace
 
 static const efftype_id effect_haslight( "haslight" );
@@ -546,6 +607,43 @@ bool map::build_transparency_cache( const int zlev )
     auto &map_cache = get_cache( zlev );
     auto &transparency_cache = map_cache.transparency_cache;
 
+#if defined( CATA_SDL ) && !defined( CATA_GPU_VERIFY )
+    // The resident GPU output only takes whole submaps.
+    const bool patch_tiles = !cata_compute::uses_sdl_gpu_compute();
+#else
+    const bool patch_tiles = true;
+#endif
+    if( patch_tiles && map_cache.transparency_cache_dirty.none() &&
+        !map_cache.transparency_dirty_tiles.empty() ) {
+        // Only single tiles changed (a door opened, a field spread): recompute just those,
+        // and report a change only if one of them actually became more or less transparent.
+        bool changed = false;
+        for( const point_bub_ms &p : map_cache.transparency_dirty_tiles ) {
+            const auto sm_pos = tripoint_bub_sm( p.x() / SEEX, p.y() / SEEY, zlev );
+            auto *cur_submap = get_mapbuffer().lookup_submap_in_memory(
+                                   map_local_to_abs( *this, sm_pos ) );
+            if( cur_submap == nullptr ) {
+                continue;
+            }
+            auto value = cur_submap->refresh_transparency_tile( *this, sm_pos,
+                         point_sm_ms( p.x() % SEEX, p.y() % SEEY ) );
+            if( std::fabs( value - LIGHT_TRANSPARENCY_OPEN_AIR ) <= 0.0001f ) {
+                value = LIGHT_TRANSPARENCY_OPEN_AIR;
+            } else if( std::fabs( value - weather_lookup_.transparency ) <= 0.0001f ) {
+                value = weather_lookup_.transparency;
+            }
+            float &cached = transparency_cache[map_cache.idx( p.x(), p.y() )];
+            if( cached != value ) {
+                cached = value;
+                changed = true;
+            }
+        }
+        map_cache.transparency_dirty_tiles.clear();
+        return changed;
+    }
+    map_cache.fold_dirty_tiles( map_cache.transparency_cache_dirty,
+                                map_cache.transparency_dirty_tiles );
+
     if( map_cache.transparency_cache_dirty.none() ) {
         return false;
     }
@@ -690,6 +788,7 @@ bool map::build_transparency_cache( const int zlev )
                 transparency_cache[map_cache.idx( x, y )] = normalized_flat_value( value );
             }
             cur_submap->transparency_dirty = false;
+            cur_submap->transparency_dirty_tiles.reset();
             ++ref_index;
         }
 
@@ -759,7 +858,7 @@ bool map::build_transparency_cache( const int zlev )
     };
 
     if( parallel_enabled && parallel_map_cache && !is_pool_worker_thread() ) {
-        parallel_for( 0, my_MAPSIZE, process_smx );
+        parallel_for( "transparency_cache", 0, my_MAPSIZE, process_smx );
     } else {
         for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
             process_smx( smx );
@@ -801,6 +900,8 @@ auto map::build_transparency_caches( const int minz, const int maxz ) -> std::ve
             auto &map_cache = get_cache( zlev );
             auto &transparency_cache = map_cache.transparency_cache;
 
+            map_cache.fold_dirty_tiles( map_cache.transparency_cache_dirty,
+                                        map_cache.transparency_dirty_tiles );
             if( map_cache.transparency_cache_dirty.none() ) {
                 continue;
             }
@@ -962,6 +1063,7 @@ auto map::build_transparency_caches( const int minz, const int maxz ) -> std::ve
                 transparency_cache[map_cache.idx( x, y )] = normalized_flat_value( value );
             }
             cur_submap->transparency_dirty = false;
+            cur_submap->transparency_dirty_tiles.reset();
         }
 
         for( const auto &state : level_states ) {
@@ -1324,9 +1426,8 @@ void map::build_sunlight_cache( int pzlev )
                 std::views::iota( 0, map_cache.cache_x * map_cache.cache_y ),
             [&]( int i ) {
                 const auto idx = static_cast<size_t>( i );
-                const auto x = i / map_cache.cache_y;
-                const auto y = i % map_cache.cache_y;
-                const auto sun_state = direct_sunlight_state_at( point_bub_ms( x, y ), zlev );
+                const auto sun_state = direct_sunlight_state_at(
+                                           point_bub_ms( cache_layout::point_at( i, map_cache.shape() ) ), zlev );
                 if( sun_state == direct_sunlight_state::direct ) {
                     lm[idx] = outside_light_level;
                     fully_inside = false;
@@ -1564,7 +1665,7 @@ void map::generate_lightmap_worker( const int zlev )
         };
 
         if( parallel_enabled && parallel_map_cache && !is_pool_worker_thread() ) {
-            parallel_for( 0, my_MAPSIZE, process_smx );
+            parallel_for( "lightmap", 0, my_MAPSIZE, process_smx );
         } else {
             for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
                 process_smx( smx );
@@ -1594,7 +1695,8 @@ void map::generate_lightmap_worker( const int zlev )
         } );
 
 
-        // Apply any vehicle light sources.
+        // Gather the vehicle light sources, cast below once they are all known.
+        auto vehicle_lights = std::vector<light_clusters::emitter> {};
         auto vehs = get_vehicles();
         for( auto &vv : vehs ) {
             auto *v = vv.v;
@@ -1616,11 +1718,6 @@ void map::generate_lightmap_worker( const int zlev )
                 }
             }
 
-            auto apply_external_light = [&]( const auto & apply_light ) {
-                auto scope = vehicle_external_light_cache_scope( map_cache, *v, zlev );
-                apply_light();
-            };
-
             struct vehicle_arc_light_def {
                 tripoint_bub_ms src;
                 units::angle direction = 0_degrees;
@@ -1636,36 +1733,26 @@ void map::generate_lightmap_worker( const int zlev )
                 uint32_t color_rgb = 0u;
             };
 
-            auto apply_vehicle_arc = [&]( const vehicle_arc_light_def & def ) {
-                if( def.external ) {
-                    apply_external_light( [&]() {
-                        apply_light_arc( {
-                            .p = def.src,
-                            .angle = def.direction,
-                            .luminance = def.luminance,
-                            .wideangle = def.width,
-                            .color_rgb = def.color_rgb,
-                        } );
-                    } );
-                } else {
-                    apply_light_arc( {
-                        .p = def.src,
-                        .angle = def.direction,
-                        .luminance = def.luminance,
-                        .wideangle = def.width,
-                        .color_rgb = def.color_rgb,
-                    } );
-                }
+            auto add_vehicle_arc = [&]( const vehicle_arc_light_def & def ) {
+                vehicle_lights.push_back( {
+                    .p = def.src,
+                    .shape = light_clusters::emitter_shape::arc,
+                    .direction = def.direction,
+                    .width = def.width,
+                    .luminance = def.luminance,
+                    .color_rgb = def.color_rgb,
+                    .scope = def.external ? v : nullptr,
+                } );
             };
 
-            auto apply_vehicle_point = [&]( const vehicle_point_light_def & def ) {
-                if( def.external ) {
-                    apply_external_light( [&]() {
-                        apply_light_source( def.src, def.luminance, def.color_rgb );
-                    } );
-                } else {
-                    add_deferred_point_light( def.src, def.luminance, def.color_rgb );
-                }
+            auto add_vehicle_point = [&]( const vehicle_point_light_def & def ) {
+                vehicle_lights.push_back( {
+                    .p = def.src,
+                    .shape = light_clusters::emitter_shape::point,
+                    .luminance = def.luminance,
+                    .color_rgb = def.color_rgb,
+                    .scope = def.external ? v : nullptr,
+                } );
             };
 
             for( const auto &part : lights ) {
@@ -1684,7 +1771,7 @@ void map::generate_lightmap_worker( const int zlev )
                 const auto color_rgb = vehicle_light_color( part ).value_or( 0u );
                 if( vp.has_flag( VPFLAG_CONE_LIGHT ) ) {
                     if( veh_luminance > lit_level::LIT ) {
-                        apply_vehicle_arc( {
+                        add_vehicle_arc( {
                             .src = src,
                             .direction = v->face.dir() + vehicle_part.direction,
                             .luminance = veh_luminance,
@@ -1696,7 +1783,7 @@ void map::generate_lightmap_worker( const int zlev )
 
                 } else if( vp.has_flag( VPFLAG_WIDE_CONE_LIGHT ) ) {
                     if( veh_luminance > lit_level::LIT ) {
-                        apply_vehicle_arc( {
+                        add_vehicle_arc( {
                             .src = src,
                             .direction = v->face.dir() + vehicle_part.direction,
                             .luminance = veh_luminance,
@@ -1713,7 +1800,7 @@ void map::generate_lightmap_worker( const int zlev )
                     for( const auto beam_index : std::views::iota( 0, rotating_light.beam_count() ) ) {
                         const auto beam_direction =
                             direction + rotating_light.beam_spacing() * static_cast<double>( beam_index );
-                        apply_vehicle_arc( {
+                        add_vehicle_arc( {
                             .src = src,
                             .direction = beam_direction,
                             .luminance = static_cast<float>( vp.bonus ),
@@ -1723,7 +1810,7 @@ void map::generate_lightmap_worker( const int zlev )
                         } );
                     }
                 } else if( vp.has_flag( VPFLAG_HALF_CIRCLE_LIGHT ) ) {
-                    apply_vehicle_arc( {
+                    add_vehicle_arc( {
                         .src = src,
                         .direction = v->face.dir() + vehicle_part.direction,
                         .luminance = static_cast<float>( vp.bonus ),
@@ -1735,7 +1822,7 @@ void map::generate_lightmap_worker( const int zlev )
                 } else if( vp.has_flag( VPFLAG_CIRCLE_LIGHT ) ) {
                     const auto odd_turn = calendar::once_every( 2_turns );
                     if( vehicle_lighting::circle_light_is_active( vp, odd_turn ) ) {
-                        apply_vehicle_point( {
+                        add_vehicle_point( {
                             .src = src,
                             .luminance = static_cast<float>( vp.bonus ),
                             .external = external,
@@ -1744,7 +1831,7 @@ void map::generate_lightmap_worker( const int zlev )
                     }
 
                 } else {
-                    apply_vehicle_point( {
+                    add_vehicle_point( {
                         .src = src,
                         .luminance = static_cast<float>( vp.bonus ),
                         .external = external,
@@ -1769,6 +1856,40 @@ void map::generate_lightmap_worker( const int zlev )
             }
         }
 
+        {
+            ZoneScopedN( "generate_lightmap_vehicle_lights" );
+            auto &clusters = map_cache.vehicle_light_clusters;
+            clusters = light_clusters::cluster_emitters( std::move( vehicle_lights ), {
+                .viewer = get_player_character().bub_pos(),
+                .lod_distance = light_cluster_distance,
+            } );
+            // External lights of one vehicle go together, so its cache is swapped once for them.
+            std::ranges::sort( clusters, {}, []( const light_clusters::cluster & c ) {
+                return reinterpret_cast<std::uintptr_t>( c.light.scope );
+            } );
+            auto scope = std::optional<vehicle_external_light_cache_scope> {};
+            for( const auto &c : clusters ) {
+                const auto &light = c.light;
+                if( light.scope != nullptr && ( !scope || &scope->veh != light.scope ) ) {
+                    scope.reset();
+                    scope.emplace( map_cache, *light.scope, zlev );
+                }
+                if( light.shape == light_clusters::emitter_shape::arc ) {
+                    apply_light_arc( {
+                        .p = light.p,
+                        .angle = light.direction,
+                        .luminance = light.luminance,
+                        .wideangle = light.width,
+                        .color_rgb = light.color_rgb,
+                    } );
+                } else if( light.scope != nullptr ) {
+                    apply_light_source( light.p, light.luminance, light.color_rgb );
+                } else {
+                    add_deferred_point_light( light.p, light.luminance, light.color_rgb );
+                }
+            }
+        }
+
     } // ZoneScopedN generate_lightmap_collect
 
     /* Now that we have position and intensity of all bulk light sources, apply_ them
@@ -1778,6 +1899,11 @@ void map::generate_lightmap_worker( const int zlev )
     */
     {
         ZoneScopedN( "generate_lightmap_flush" );
+        // Uncoloured sources are batched for apply_point_lights; coloured ones also write the
+        // colour caches and are applied one by one.  Every write is a max, so the order of
+        // the two groups does not matter.
+        auto plain_lights = std::vector<std::pair<point_bub_ms, float>> {};
+        plain_lights.reserve( map_cache.light_source_points.size() );
         for( const auto &source : map_cache.light_source_points ) {
             const auto p = tripoint_bub_ms( source, zlev );
             const auto idx = map_cache.idx( p.x(), p.y() );
@@ -1791,13 +1917,14 @@ void map::generate_lightmap_worker( const int zlev )
                 apply_light_source( p, colored_luminance, color_rgb );
             } else {
                 if( luminance > 0.0f ) {
-                    apply_light_source( p, luminance );
+                    plain_lights.emplace_back( source, luminance );
                 }
                 if( color_rgb != 0u && colored_luminance > 0.0f ) {
                     apply_light_source( p, colored_luminance, color_rgb );
                 }
             }
         }
+        apply_point_lights( zlev, plain_lights );
         for( const std::pair<tripoint_bub_ms, float> &elem : lm_override ) {
             lm[map_cache.idx( elem.first.x(), elem.first.y() )] = elem.second;
         }
@@ -1831,6 +1958,7 @@ lit_level map::light_at( const tripoint_bub_ms &p ) const
     const auto &map_cache = get_cache_ref( p.z() );
     record_cpu_lm_read( map_cache.lm_cpu_cache_valid, cpu_lm_light_reads_valid,
                         cpu_lm_light_reads_stale );
+    note_ambient_lightmap_read( map_cache, p.z() );
     const auto &lm = map_cache.lm;
     const auto &sm = map_cache.sm;
     if( sm[map_cache.idx( p.x(), p.y() )] >= LIGHT_SOURCE_BRIGHT ) {
@@ -1888,11 +2016,19 @@ float map::ambient_light_at( const tripoint_bub_ms &p,
     record_cpu_lm_read( map_cache.lm_cpu_cache_valid, cpu_lm_ambient_reads_valid,
                         cpu_lm_ambient_reads_stale );
     record_cpu_lm_ambient_location( map_cache.lm_cpu_cache_valid, location );
+    note_ambient_lightmap_read( map_cache, p.z() );
     const auto light = map_cache.lm[map_cache.idx( p.x(), p.y() )];
 
     return light;
 }
 
+void map::note_ambient_lightmap_read( const level_cache &map_cache, const int z ) const
+{
+    if( map_cache.lightmap_ambient_only ) {
+        ( *ambient_lightmap_reads_ )[z + OVERMAP_DEPTH].store( true, std::memory_order_relaxed );
+    }
+}
+
 void map::flush_lightmap_cpu_read_counters() const
 {
     ZoneScopedN( "flush_lightmap_cpu_read_counters" );
@@ -2218,7 +2354,6 @@ void map::apply_vision_transparency_cache( const tripoint_bub_ms &center, int ta
     level_cache &map_cache = get_cache( target_z );
     auto &transparency_cache = map_cache.transparency_cache;
     auto *blocked_data = map_cache.vehicle_obscured_cache.data();
-    const int sy = map_cache.cache_y;
 
     int i = 0;
     for( point adjacent : eight_adjacent_offsets ) {
@@ -2238,10 +2373,10 @@ void map::apply_vision_transparency_cache( const tripoint_bub_ms &center, int ta
             }
 
             bool &relevant_blocked =
-                adjacent == point_north_east ? blocked_data[center.x() * sy + center.y()].ne :
-                adjacent == point_south_east ? blocked_data[p.x() * sy + p.y()].nw :
-                adjacent == point_south_west ? blocked_data[p.x() * sy + p.y()].ne :
-                /* point_north_west */         blocked_data[center.x() * sy + center.y()].nw;
+                adjacent == point_north_east ? blocked_data[map_cache.idx( center.x(), center.y() )].ne :
+                adjacent == point_south_east ? blocked_data[map_cache.idx( p.x(), p.y() )].nw :
+                adjacent == point_south_west ? blocked_data[map_cache.idx( p.x(), p.y() )].ne :
+                /* point_north_west */         blocked_data[map_cache.idx( center.x(), center.y() )].nw;
 
             //We only set the restore cache if we actually flip the bit
             blocked_restore_cache[i] = !relevant_blocked;
@@ -2259,7 +2394,6 @@ void map::restore_vision_transparency_cache( const tripoint_bub_ms &center, int
     auto &map_cache = get_cache( target_z );
     auto &transparency_cache = map_cache.transparency_cache;
     auto *blocked_data = map_cache.vehicle_obscured_cache.data();
-    const int sy = map_cache.cache_y;
 
     int i = 0;
     for( point adjacent : eight_adjacent_offsets ) {
@@ -2271,10 +2405,10 @@ void map::restore_vision_transparency_cache( const tripoint_bub_ms &center, int
 
         if( blocked_restore_cache[i] ) {
             bool &relevant_blocked =
-                adjacent == point_north_east ? blocked_data[center.x() * sy + center.y()].ne :
-                adjacent == point_south_east ? blocked_data[p.x() * sy + p.y()].nw :
-                adjacent == point_south_west ? blocked_data[p.x() * sy + p.y()].ne :
-                /* point_north_west */         blocked_data[center.x() * sy + center.y()].nw;
+                adjacent == point_north_east ? blocked_data[map_cache.idx( center.x(), center.y() )].ne :
+                adjacent == point_south_east ? blocked_data[map_cache.idx( p.x(), p.y() )].nw :
+                adjacent == point_south_west ? blocked_data[map_cache.idx( p.x(), p.y() )].ne :
+                /* point_north_west */         blocked_data[map_cache.idx( center.x(), center.y() )].nw;
             relevant_blocked = false;
         }
 
@@ -2334,11 +2468,11 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
         for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
             auto &cur_cache = get_cache( z );
             const int idx = z + OVERMAP_DEPTH;
-            transparency_caches[idx] = { cur_cache.transparency_cache.data(), cur_cache.cache_x, cur_cache.cache_y };
-            seen_caches[idx]         = { cur_cache.seen_cache.data(),         cur_cache.cache_x, cur_cache.cache_y };
-            floor_caches[idx]         = { cur_cache.floor_cache.data(),         cur_cache.cache_x, cur_cache.cache_y };
-            vehicle_floor_caches[idx] = { cur_cache.vehicle_floor_cache.data(), cur_cache.cache_x, cur_cache.cache_y };
-            blocked_caches[idx] = { cur_cache.vehicle_obscured_cache.data(), cur_cache.cache_x, cur_cache.cache_y };
+            transparency_caches[idx] = { cur_cache.transparency_cache.data(), cur_cache.shape() };
+            seen_caches[idx] = { cur_cache.seen_cache.data(), cur_cache.shape() };
+            floor_caches[idx] = { cur_cache.floor_cache.data(), cur_cache.shape() };
+            vehicle_floor_caches[idx] = { cur_cache.vehicle_floor_cache.data(), cur_cache.shape() };
+            blocked_caches[idx] = { cur_cache.vehicle_obscured_cache.data(), cur_cache.shape() };
             std::fill( cur_cache.seen_cache.begin(), cur_cache.seen_cache.end(),
                        light_transparency_solid );
             cur_cache.seen_cache_dirty = false;
@@ -2360,7 +2494,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
             // No cast_zlight; off-level tiles filled from the projected result.
             origin_cache.seen_cache[origin_cache.idx( origin.x(), origin.y() )] = VISIBILITY_FULL;
             castLightAll( origin_cache.seen_cache.data(), origin_cache.transparency_cache.data(),
-                          origin_cache.vehicle_obscured_cache.data(), origin_cache.cache_x, origin_cache.cache_y,
+                          origin_cache.vehicle_obscured_cache.data(), origin_cache.shape(),
                           origin.xy(), 0, VISIBILITY_FULL, k_sight_model, &weather_lookup_ );
         }
 
@@ -2419,7 +2553,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
                             continue;
                         }
                         const auto &fc = floor_caches[floor_z + OVERMAP_DEPTH];
-                        if( fx >= 0 && fy >= 0 && fx < fc.sx && fy < fc.sy &&
+                        if( fx >= 0 && fy >= 0 && fx < fc.shape.sx && fy < fc.shape.sy &&
                             fc.at( fx, fy ) ) {
                             return false;
                         }
@@ -2445,19 +2579,19 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
                         if( oz != cz && oz > -OVERMAP_DEPTH && cz < OVERMAP_HEIGHT ) {
                             if( oz < cz ) {
                                 const auto &fc = floor_caches[cz + OVERMAP_DEPTH];
-                                if( cx < fc.sx && cy < fc.sy && fc.at( cx, cy ) ) {
+                                if( cx < fc.shape.sx && cy < fc.shape.sy && fc.at( cx, cy ) ) {
                                     return false;
                                 }
                             } else {
                                 const auto &fc = floor_caches[oz + OVERMAP_DEPTH];
-                                if( ox >= 0 && oy >= 0 && ox < fc.sx && oy < fc.sy &&
+                                if( ox >= 0 && oy >= 0 && ox < fc.shape.sx && oy < fc.shape.sy &&
                                     fc.at( ox, oy ) ) {
                                     return false;
                                 }
                             }
                         }
                         const auto &ic = transparency_caches[cz + OVERMAP_DEPTH];
-                        if( cx < ic.sx && cy < ic.sy &&
+                        if( cx < ic.shape.sx && cy < ic.shape.sy &&
                             ic.at( cx, cy ) <= LIGHT_TRANSPARENCY_SOLID ) {
                             return false;
                         }
@@ -2492,7 +2626,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
                     }
                     const auto &fc  = floor_caches[floor_z + OVERMAP_DEPTH];
                     const auto &vfc = vehicle_floor_caches[floor_z + OVERMAP_DEPTH];
-                    if( fx >= 0 && fy >= 0 && fx < fc.sx && fy < fc.sy &&
+                    if( fx >= 0 && fy >= 0 && fx < fc.shape.sx && fy < fc.shape.sy &&
                         fc.at( fx, fy ) && !vfc.at( fx, fy ) ) {
                         return true;
                     }
@@ -2523,7 +2657,7 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
                     std::fill( temp_seen.begin(), temp_seen.end(), light_transparency_solid );
                     temp_seen[zc.idx( origin.x(), origin.y() )] = VISIBILITY_FULL;
                     castLightAll( temp_seen.data(), zc.transparency_cache.data(),
-                                  zc.vehicle_obscured_cache.data(), zc.cache_x, zc.cache_y,
+                                  zc.vehicle_obscured_cache.data(), zc.shape(),
                                   origin.xy(), 0, VISIBILITY_FULL, k_sight_model, &weather_lookup_ );
                 }
 
@@ -2650,8 +2784,10 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
                 }
             };
 
-            constexpr int z_lo = -OVERMAP_DEPTH;
-            constexpr int z_hi = OVERMAP_HEIGHT;
+            // Past a boundary with a floor on every tile nothing is seen; those levels keep
+            // the solid fill from above.
+            const auto [z_lo, z_hi] = zlevel_lighting_culling ? zlevel_sight_span( origin.z() ) :
+                                      std::pair{ -OVERMAP_DEPTH, OVERMAP_HEIGHT };
 
             // Going down: crossing from z=k to z=k-1 is blocked by floor_cache[k].
             // Accumulate one level at a time so each step is a single OR-sweep.
@@ -2670,8 +2806,8 @@ void map::build_seen_cache( const tripoint_bub_ms &origin, const int target_z )
             for( int z = origin.z() - 1; z >= z_lo; --z ) {
                 const auto &vfc = vehicle_floor_caches[z + 1 + OVERMAP_DEPTH];
                 const auto  sc  = seen_caches[z + OVERMAP_DEPTH];
-                const auto vfc_span = std::span( vfc.data, static_cast<size_t>( vfc.sx * vfc.sy ) );
-                const auto  sc_span = std::span( sc.data,  static_cast<size_t>( sc.sx  * sc.sy ) );
+                const auto vfc_span = std::span( vfc.data, static_cast<size_t>( vfc.shape.sx * vfc.shape.sy ) );
+                const auto  sc_span = std::span( sc.data,  static_cast<size_t>( sc.shape.sx  * sc.shape.sy ) );
                 std::ranges::transform( sc_span, vfc_span, sc_span.begin(),
                                         []( float s, bool v ) -> float { return v ? 0.0f : s; } );
             }
@@ -2814,7 +2950,7 @@ void map::apply_vehicle_optics( const tripoint_bub_ms &origin, const int target_
         // at an offset appears to give reasonable results though.
         castLightAll( target_cache.camera_cache.data(), target_cache.transparency_cache.data(),
                       target_cache.vehicle_obscured_cache.data(),
-                      target_cache.cache_x, target_cache.cache_y,
+                      target_cache.shape(),
                       mirror_pos.xy(), offset_distance, VISIBILITY_FULL,
                       k_sight_model, &weather_lookup_ );
     }
@@ -2887,10 +3023,10 @@ auto apply_cpu_colored_light_3d( map &here, const cpu_colored_light_opt &opt ) -
     for( const auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
         auto &cache = here.access_cache( z );
         const auto idx = z + OVERMAP_DEPTH;
-        transparency_caches[idx] = { cache.transparency_cache.data(), cache.cache_x, cache.cache_y };
-        floor_caches[idx] = { cache.floor_cache.data(), cache.cache_x, cache.cache_y };
-        blocked_caches[idx] = { cache.vehicle_obscured_cache.data(), cache.cache_x, cache.cache_y };
-        output_caches[idx] = { nullptr, cache.cache_x, cache.cache_y };
+        transparency_caches[idx] = { cache.transparency_cache.data(), cache.shape() };
+        floor_caches[idx] = { cache.floor_cache.data(), cache.shape() };
+        blocked_caches[idx] = { cache.vehicle_obscured_cache.data(), cache.shape() };
+        output_caches[idx] = { nullptr, cache.shape() };
     }
 
     auto context = cpu_colored_light_3d_context{
@@ -2919,67 +3055,27 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance, uint32_
     auto *lm_data        = cache.lm.data();
     auto *sm_data        = cache.sm.data();
     auto *trans_data     = cache.transparency_cache.data();
-    auto *lsb_data       = cache.light_source_buffer.data();
     auto *blocked_data   = cache.vehicle_obscured_cache.data();
-    const int sx = cache.cache_x;
-    const int sy = cache.cache_y;
 
     const auto p2 = p.xy();
 
     if( inbounds( p ) ) {
         const float min_light = std::max( static_cast<float>( lit_level::LOW ), luminance );
-        lm_data[p2.x() * sy + p2.y()] = std::max( lm_data[p2.x() * sy + p2.y()], min_light );
-        sm_data[p2.x() * sy + p2.y()] = std::max( sm_data[p2.x() * sy + p2.y()], luminance );
+        lm_data[cache.idx( p2.x(), p2.y() )] = std::max( lm_data[cache.idx( p2.x(), p2.y() )], min_light );
+        sm_data[cache.idx( p2.x(), p2.y() )] = std::max( sm_data[cache.idx( p2.x(), p2.y() )], luminance );
         if( colored_lighting && color_rgb != 0u ) {
             write_colored_light_cache( cache, cache.idx( p2.x(), p2.y() ), luminance, color_rgb );
         }
     }
-    if( luminance <= lit_level::LOW ) {
+    const auto rays = rays_of_point_light( cache, p2, luminance );
+    if( rays.luminance <= 0.0f ) {
         return;
-    } else if( luminance <= lit_level::BRIGHT_ONLY ) {
-        luminance = 1.49f;
-    }
-
-    /* If we're a 5 luminance fire , we skip casting rays into ey && sx if we have
-         neighboring fires to the north and west that were applied via light_source_buffer
-       If there's a 1 luminance candle east in buffer, we still cast rays into ex since it's smaller
-       If there's a 100 luminance magnesium flare south added via apply_light_source instead od
-         add_light_source, it's unbuffered so we'll still cast rays into sy.
-
-          ey
-        nnnNnnn
-        w     e
-        w  5 +e
-     sx W 5*1+E ex
-        w ++++e
-        w+++++e
-        sssSsss
-           sy
-    */
-    bool north = ( p2.y() != 0       && lsb_data[p2.x() * sy + p2.y() - 1]       < luminance );
-    bool south = ( p2.y() != sy - 1  && lsb_data[p2.x() * sy + p2.y() + 1]       < luminance );
-    bool east  = ( p2.x() != sx - 1  && lsb_data[( p2.x() + 1 ) * sy + p2.y()]   < luminance );
-    bool west  = ( p2.x() != 0       && lsb_data[( p2.x() - 1 ) * sy + p2.y()]   < luminance );
-
-    // Build octant mask from the directions that have a weaker-or-absent neighbor
-    // in the light-source buffer.  Skipping covered directions is an optimization
-    // for dense fire / lava: equal-brightness neighbors already project those rays.
-    auto mask = uint8_t{};
-    if( north ) {
-        mask |= OCTANT_NORTH;
-    }
-    if( east ) {
-        mask |= OCTANT_EAST;
-    }
-    if( south ) {
-        mask |= OCTANT_SOUTH;
-    }
-    if( west ) {
-        mask |= OCTANT_WEST;
     }
+    luminance = rays.luminance;
+    const auto mask = rays.octants;
     if( mask != 0 ) {
         auto colored_context = cpu_colored_light_cache_context {};
-        castLightOctants( lm_data, trans_data, blocked_data, sx, sy, p2, 0, luminance,
+        castLightOctants( lm_data, trans_data, blocked_data, cache.shape(), p2, 0, luminance,
                           k_light_model, mask, &weather_lookup_,
                           make_colored_light_callback( cache, color_rgb, colored_context ) );
     }
@@ -2993,6 +3089,85 @@ void map::apply_light_source( const tripoint_bub_ms &p, float luminance, uint32_
     }
 }
 
+void map::apply_point_lights( const int zlev,
+                              const std::vector<std::pair<point_bub_ms, float>> &lights )
+{
+    ZoneScoped;
+    auto &cache = get_cache( zlev );
+    auto *lm_data = cache.lm.data();
+    auto *sm_data = cache.sm.data();
+    const auto *trans_data = cache.transparency_cache.data();
+    const auto *blocked_data = cache.vehicle_obscured_cache.data();
+    const auto shape = cache.shape();
+    const auto cells = cache.lm.size();
+
+    // Source tiles first, exactly as apply_light_source writes them.
+    auto sources = std::vector<point_light_layer::source> {};
+    sources.reserve( lights.size() );
+    for( const auto &[p, luminance] : lights ) {
+        if( inbounds( tripoint_bub_ms( p, zlev ) ) ) {
+            const auto i = cache.idx( p.x(), p.y() );
+            lm_data[i] = std::max( { lm_data[i], static_cast<float>( lit_level::LOW ), luminance } );
+            sm_data[i] = std::max( sm_data[i], luminance );
+        }
+        const auto rays = rays_of_point_light( cache, p, luminance );
+        if( rays.luminance > 0.0f && rays.octants != 0 ) {
+            sources.push_back( { p.raw(), rays.luminance, rays.octants } );
+        }
+    }
+
+    // Light only ever raises lm, so each block of sources is cast into its own zeroed
+    // buffer and the buffers are folded in with max: the same lm as casting serially,
+    // however the sources are split.
+    const auto cast = [&]( const std::span<const point_light_layer::source> batch, float *out ) {
+        const auto cast_one = [&]( const point_light_layer::source & s, float * into ) {
+            castLightOctants( into, trans_data, blocked_data, shape, point_bub_ms( s.p ), 0,
+                              s.luminance, k_light_model, s.octants, &weather_lookup_ );
+        };
+        // Below this many sources the pool dispatch and the fold cost more than the casts.
+        constexpr auto min_lights_per_block = std::size_t{ 16 };
+        const auto parallel = parallel_enabled && parallel_map_cache && !is_pool_worker_thread() &&
+                              batch.size() >= 2 * min_lights_per_block;
+        if( !parallel ) {
+            for( const auto &s : batch ) {
+                cast_one( s, out );
+            }
+            return;
+        }
+        const auto workers = static_cast<std::size_t>( get_thread_pool().num_workers() ) + 1;
+        const auto blocks = std::min( workers, batch.size() / min_lights_per_block );
+        // Named through a reference so the workers fill this thread's buffers, not their own.
+        thread_local auto scratch = std::vector<std::vector<float>> {};
+        auto &block_lm = scratch;
+        block_lm.resize( blocks );
+        parallel_for( "lightmap_point_lights", 0, static_cast<int>( blocks ), [&]( const int block ) {
+            auto &into = block_lm[block];
+            into.assign( cells, 0.0f );
+            for( auto i = static_cast<std::size_t>( block ); i < batch.size(); i += blocks ) {
+                cast_one( batch[i], into.data() );
+            }
+        } );
+        for( const auto &into : block_lm ) {
+            for( std::size_t i = 0; i < cells; ++i ) {
+                out[i] = std::max( out[i], into[i] );
+            }
+        }
+    };
+
+    // Only the part of last turn's layer that moved, dimmed or lost its shadows is cast again.
+    const auto &layer = cache.point_lights.update( std::move( sources ), {
+        .transparency = trans_data,
+        .blocked = blocked_data,
+        .shape = shape,
+        .weather_transparency = weather_lookup_.transparency,
+        .max_view_distance = g_max_view_distance,
+        .trig_dist = trigdist,
+    }, cast );
+    for( std::size_t i = 0; i < cells; ++i ) {
+        lm_data[i] = std::max( lm_data[i], layer[i] );
+    }
+}
+
 void map::apply_directional_light( const tripoint_bub_ms &p, int direction, float luminance )
 {
     apply_directional_light( {
@@ -3010,8 +3185,6 @@ auto map::apply_directional_light( const apply_directional_light_options &opt )
     auto *lm_data      = cache.lm.data();
     auto *trans_data   = cache.transparency_cache.data();
     auto *blocked_data = cache.vehicle_obscured_cache.data();
-    const int sx = cache.cache_x;
-    const int sy = cache.cache_y;
 
     // direction convention: 90=north-facing (light goes south), 0=east-facing (west),
     // 270=south-facing (north), 180=west-facing (east).  Each maps to the two octants
@@ -3028,7 +3201,7 @@ auto map::apply_directional_light( const apply_directional_light_options &opt )
     }
     if( mask != 0 ) {
         auto colored_context = cpu_colored_light_cache_context {};
-        castLightOctants( lm_data, trans_data, blocked_data, sx, sy, p2, 0, opt.luminance,
+        castLightOctants( lm_data, trans_data, blocked_data, cache.shape(), p2, 0, opt.luminance,
                           k_light_model, mask, &weather_lookup_,
                           make_colored_light_callback( cache, opt.color_rgb, colored_context ) );
     }
@@ -3192,7 +3365,7 @@ auto map::apply_light_ray( const apply_light_ray_options &opt ) -> void
 
             // TODO: clamp coordinates to map bounds before this method is called.
             if( p.x() >= 0 && p.y() >= 0 && p.x() < sx && p.y() < sy ) {
-                const int idx = p.x() * sy + p.y();
+                const int idx = cache_ref.idx( p.x(), p.y() );
                 auto current_transparency = trans_data[idx];
                 auto is_opaque = current_transparency == LIGHT_TRANSPARENCY_SOLID;
                 if( !opt.lit[idx] ) {
@@ -3227,7 +3400,7 @@ auto map::apply_light_ray( const apply_light_ray_options &opt ) -> void
             t += a.x();
 
             if( p.x() >= 0 && p.y() >= 0 && p.x() < sx && p.y() < sy ) {
-                const int idx = p.x() * sy + p.y();
+                const int idx = cache_ref.idx( p.x(), p.y() );
                 auto current_transparency = trans_data[idx];
                 auto is_opaque = current_transparency == LIGHT_TRANSPARENCY_SOLID;
                 if( !opt.lit[idx] ) {
@@ -472,6 +472,7 @@ loading_ui::loading_ui( bool display )
 
 loading_ui::~loading_ui()
 {
+    end_context();
 #if defined( TILES )
     clear_sdl_display_buffer_before_redraw();
 #endif
@@ -479,13 +480,33 @@ loading_ui::~loading_ui()
 
 void loading_ui::add_entry( const std::string &description )
 {
+    if( startup_timeline::enabled() ) {
+        entries.push_back( description );
+    }
     if( menu != nullptr ) {
         menu->addentry( menu->entries.size(), true, 0, description );
     }
 }
 
+void loading_ui::end_context()
+{
+    if( !context.empty() ) {
+        startup_timeline::record( context, "loading_ui", {}, context_start,
+                                  startup_timeline::clock::now() );
+    }
+    context.clear();
+    entries.clear();
+    next_entry = 0;
+}
+
 void loading_ui::new_context( const std::string &desc )
 {
+    end_context();
+    if( startup_timeline::enabled() ) {
+        context = desc;
+        context_start = startup_timeline::clock::now();
+        entry_start = context_start;
+    }
     if( menu != nullptr ) {
         menu->reset();
         menu->settext( desc );
@@ -514,6 +535,13 @@ void loading_ui::proceed()
 {
     init();
 
+    if( next_entry < entries.size() ) {
+        const auto now = startup_timeline::clock::now();
+        startup_timeline::record( entries[next_entry], context, {}, entry_start, now );
+        ++next_entry;
+        entry_start = now;
+    }
+
     if( menu != nullptr && !menu->entries.empty() ) {
         if( menu->selected >= 0 && menu->selected < static_cast<int>( menu->entries.size() ) ) {
             // TODO: Color it red if it errored hard, yellow on warnings
@@ -532,6 +560,11 @@ void loading_ui::show()
 {
     init();
 
+    if( next_entry == 0 ) {
+        // Time spent setting up the context is not part of the first entry.
+        entry_start = startup_timeline::clock::now();
+    }
+
     if( menu != nullptr ) {
         ui_manager::redraw();
         refresh_display();
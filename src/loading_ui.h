@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "point.h"
+#include "startup_timeline.h"
 
 #if defined( TILES )
 struct loading_image_cache;
@@ -63,7 +64,15 @@ class loading_ui
         loading_image_selection_state loading_image_selection;
 #endif
 
+        // Recorded in the startup timeline whether or not the menu is shown.
+        std::string context;
+        std::vector<std::string> entries;
+        std::size_t next_entry = 0;
+        startup_timeline::clock::time_point context_start;
+        startup_timeline::clock::time_point entry_start;
+
         void init();
+        void end_context();
     public:
         loading_ui( bool display );
         ~loading_ui();
@@ -0,0 +1,60 @@
+#include "lock_stats.h"
+
+#include "string_formatter.h"
+
+namespace lock_stats
+{
+
+namespace
+{
+
+std::atomic<site *> sites{ nullptr };
+
+} // namespace
+
+site::site( const char *const name ) : name( name )
+{
+    next = sites.load( std::memory_order_relaxed );
+    while( !sites.compare_exchange_weak( next, this, std::memory_order_release,
+                                         std::memory_order_relaxed ) ) {
+    }
+}
+
+auto collect() -> std::vector<site_usage>
+{
+    auto usage = std::vector<site_usage>();
+    for( const site *s = sites.load( std::memory_order_acquire ); s != nullptr; s = s->next ) {
+        usage.push_back( {
+            .name = s->name,
+            .acquisitions = s->acquisitions.load( std::memory_order_relaxed ),
+            .contended = s->contended.load( std::memory_order_relaxed ),
+            .wait_ms = static_cast<double>( s->wait_ns.load( std::memory_order_relaxed ) ) / 1e6,
+        } );
+    }
+    std::ranges::sort( usage, []( const site_usage & a, const site_usage & b ) {
+        return a.wait_ms > b.wait_ms;
+    } );
+    return usage;
+}
+
+void reset()
+{
+    for( site *s = sites.load( std::memory_order_acquire ); s != nullptr; s = s->next ) {
+        s->acquisitions.store( 0, std::memory_order_relaxed );
+        s->contended.store( 0, std::memory_order_relaxed );
+        s->wait_ns.store( 0, std::memory_order_relaxed );
+    }
+}
+
+auto describe( const std::vector<site_usage> &usage ) -> std::string
+{
+    auto out = string_format( "%-40s %12s %10s %10s\n", "mutex", "locks", "contended", "wait ms" );
+    for( const site_usage &s : usage ) {
+        out += string_format( "%-40s %12d %10d %10.2f\n", s.name, s.acquisitions, s.contended,
+                              s.wait_ms );
+    }
+    out += "\nCounted since the game started or the counters were last reset.\n";
+    return out;
+}
+
+} // namespace lock_stats
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// For TracyLockable at the declarations of counted mutexes
+#include "profile.h"
+
+/**
+ * Always-on contention counters for the mutexes shared between the main thread and the
+ * thread pool workers.
+ *
+ * A mutex declared as @ref lock_stats::counted counts its acquisitions, the ones that
+ * found it held, and the time spent waiting for those.  Every mutex of the same type
+ * and name adds to one @ref lock_stats::site, so each mapbuffer's submap mutex is
+ * reported together.  An uncontended acquisition costs one relaxed atomic increment
+ * over the plain mutex.
+ *
+ * Tracy sees these mutexes when they're declared through TracyLockable as well.
+ */
+namespace lock_stats
+{
+
+/** Counters shared by every mutex of one name. */
+struct site {
+    explicit site( const char *name );
+
+    const char *name;
+    std::atomic<std::uint64_t> acquisitions{ 0 };
+    std::atomic<std::uint64_t> contended{ 0 };
+    std::atomic<std::uint64_t> wait_ns{ 0 };
+    // Sites form a list that is only ever pushed to, so reading it needs no lock
+    site *next = nullptr;
+
+    void record_wait( const std::chrono::steady_clock::duration waited ) {
+        contended.fetch_add( 1, std::memory_order_relaxed );
+        wait_ns.fetch_add( static_cast<std::uint64_t>(
+                               std::chrono::duration_cast<std::chrono::nanoseconds>( waited ).count() ),
+                           std::memory_order_relaxed );
+    }
+};
+
+/** A string literal usable as a template argument. */
+template<std::size_t N>
+struct site_name {
+    constexpr site_name( const char ( &s )[N] ) {
+        std::copy_n( s, N, value );
+    }
+    char value[N];
+};
+
+/** @p Mutex with its locking counted under @p Name. */
+template<typename Mutex, site_name Name>
+class counted
+{
+    public:
+        void lock() {
+            site &s = stats();
+            s.acquisitions.fetch_add( 1, std::memory_order_relaxed );
+            if( m.try_lock() ) {
+                return;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            m.lock();
+            s.record_wait( std::chrono::steady_clock::now() - start );
+        }
+        auto try_lock() -> bool {
+            const bool locked = m.try_lock();
+            if( locked ) {
+                stats().acquisitions.fetch_add( 1, std::memory_order_relaxed );
+            }
+            return locked;
+        }
+        void unlock() {
+            m.unlock();
+        }
+
+        void lock_shared() requires requires( Mutex & mtx ) {
+            mtx.lock_shared();
+        } {
+            site &s = stats();
+            s.acquisitions.fetch_add( 1, std::memory_order_relaxed );
+            if( m.try_lock_shared() ) {
+                return;
+            }
+            const auto start = std::chrono::steady_clock::now();
+            m.lock_shared();
+            s.record_wait( std::chrono::steady_clock::now() - start );
+        }
+        auto try_lock_shared() -> bool requires requires( Mutex & mtx ) {
+            mtx.try_lock_shared();
+        } {
+            const bool locked = m.try_lock_shared();
+            if( locked ) {
+                stats().acquisitions.fetch_add( 1, std::memory_order_relaxed );
+            }
+            return locked;
+        }
+        void unlock_shared() requires requires( Mutex & mtx ) {
+            mtx.unlock_shared();
+        } {
+            m.unlock_shared();
+        }
+
+    private:
+        static auto stats() -> site & {
+            static site s( Name.value );
+            return s;
+        }
+
+        Mutex m;
+};
+
+struct site_usage {
+    std::string name;
+    std::uint64_t acquisitions = 0;
+    std::uint64_t contended = 0;
+    double wait_ms = 0.0;
+};
+
+/** Every site that has been locked so far, the longest waits first. */
+auto collect() -> std::vector<site_usage>;
+
+/** Zeroes the counters of every site. */
+void reset();
+
+/** @p usage as a table for the debug menu. */
+auto describe( const std::vector<site_usage> &usage ) -> std::string;
+
+} // namespace lock_stats
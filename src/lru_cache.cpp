@@ -1,8 +1,9 @@
 #include "lru_cache.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <sstream>
-#include <iterator>
 #include <string>
 
 #include "coordinates.h"
@@ -10,65 +11,170 @@
 #include "point.h"
 
 template<typename Key, typename Value>
-Value lru_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
+std::size_t lru_cache<Key, Value>::home_slot( const Key &key ) const
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        return found->second->second;
+    // Fibonacci hashing, so weak hashes such as a point's still spread over the table
+    const auto h = static_cast<std::uint64_t>( std::hash<Key> {}( key ) );
+    return static_cast<std::size_t>( ( h * 0x9E3779B97F4A7C15ULL ) >> 32 ) & ( slots.size() - 1 );
+}
+
+template<typename Key, typename Value>
+std::size_t lru_cache<Key, Value>::find_slot( const Key &key ) const
+{
+    const auto mask = slots.size() - 1;
+    auto slot = home_slot( key );
+    while( slots[slot] != none && !( entries[slots[slot]].kv.first == key ) ) {
+        slot = ( slot + 1 ) & mask;
+    }
+    return slot;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::grow()
+{
+    // Keep the table at most half full, so probes stay short
+    slots.assign( std::max<std::size_t>( 16, slots.size() * 2 ), none );
+    for( std::uint32_t i = 0; i < entries.size(); ++i ) {
+        slots[find_slot( entries[i].kv.first )] = i;
     }
-    return default_;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::unlink( const std::uint32_t index )
+{
+    entry &e = entries[index];
+    ( e.older == none ? oldest : entries[e.older].newer ) = e.newer;
+    ( e.newer == none ? newest : entries[e.newer].older ) = e.older;
+    e.older = none;
+    e.newer = none;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::link_newest( const std::uint32_t index )
+{
+    entry &e = entries[index];
+    e.older = newest;
+    e.newer = none;
+    ( newest == none ? oldest : entries[newest].newer ) = index;
+    newest = index;
+}
+
+template<typename Key, typename Value>
+void lru_cache<Key, Value>::erase( const std::uint32_t index )
+{
+    unlink( index );
+
+    // Backward-shift deletion: pull later entries of the probe run into the hole, so
+    // lookups never need tombstones.
+    const auto mask = slots.size() - 1;
+    auto hole = find_slot( entries[index].kv.first );
+    slots[hole] = none;
+    for( auto slot = ( hole + 1 ) & mask; slots[slot] != none; slot = ( slot + 1 ) & mask ) {
+        const auto home = home_slot( entries[slots[slot]].kv.first );
+        // Stays put if its home lies cyclically within (hole, slot]
+        const bool stays = hole <= slot ? hole < home && home <= slot : hole < home || home <= slot;
+        if( !stays ) {
+            slots[hole] = slots[slot];
+            slots[slot] = none;
+            hole = slot;
+        }
+    }
+
+    // Move the last entry into the gap to keep the array contiguous
+    const auto last = static_cast<std::uint32_t>( entries.size() - 1 );
+    if( index != last ) {
+        slots[find_slot( entries[last].kv.first )] = index;
+        entry &moved = entries[index];
+        moved = std::move( entries[last] );
+        ( moved.older == none ? oldest : entries[moved.older].newer ) = index;
+        ( moved.newer == none ? newest : entries[moved.newer].older ) = index;
+    }
+    entries.pop_back();
+}
+
+template<typename Key, typename Value>
+const Value &lru_cache<Key, Value>::get( const Key &pos, const Value &default_ ) const
+{
+    const Value *const found = find( pos );
+    return found != nullptr ? *found : default_;
+}
+
+template<typename Key, typename Value>
+const Value *lru_cache<Key, Value>::find( const Key &pos ) const
+{
+    if( !entries.empty() ) {
+        const auto index = slots[find_slot( pos )];
+        if( index != none ) {
+            ++counters.hits;
+            return &entries[index].kv.second;
+        }
+    }
+    ++counters.misses;
+    return nullptr;
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::remove( const Key &pos )
 {
-    auto found = map.find( pos );
-    if( found != map.end() ) {
-        ordered_list.erase( found->second );
-        map.erase( found );
+    if( entries.empty() ) {
+        return;
+    }
+    const auto index = slots[find_slot( pos )];
+    if( index != none ) {
+        erase( index );
     }
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::insert( int limit, const Key &pos, const Value &t )
 {
-    auto found = map.find( pos );
+    if( ( entries.size() + 1 ) * 2 > slots.size() ) {
+        grow();
+    }
+    const auto slot = find_slot( pos );
 
-    if( found == map.end() ) {
-        // Need new entry in map.  Make the new list entry and point to it.
-        ordered_list.emplace_back( pos, t );
-        map[pos] = std::prev( ordered_list.end() );
+    if( slots[slot] == none ) {
+        const auto index = static_cast<std::uint32_t>( entries.size() );
+        entries.push_back( entry{ Pair( pos, t ) } );
+        slots[slot] = index;
+        link_newest( index );
         trim( limit );
     } else {
-        // Splice existing entry to the back.  Does not invalidate the
-        // iterator, so no need to change the map.
-        auto list_iterator = found->second;
-        ordered_list.splice( ordered_list.end(), ordered_list, list_iterator );
-        // Update the moved item
-        list_iterator->second = t;
+        // Move the existing entry to the newest end and update it
+        const auto index = slots[slot];
+        unlink( index );
+        link_newest( index );
+        entries[index].kv.second = t;
     }
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::trim( int limit )
 {
-    while( map.size() > static_cast<size_t>( limit ) ) {
-        map.erase( ordered_list.front().first );
-        ordered_list.pop_front();
+    while( entries.size() > static_cast<size_t>( std::max( limit, 0 ) ) ) {
+        erase( oldest );
+        ++counters.evictions;
     }
 }
 
 template<typename Key, typename Value>
 void lru_cache<Key, Value>::clear()
 {
-    map.clear();
-    ordered_list.clear();
+    entries.clear();
+    std::ranges::fill( slots, none );
+    oldest = none;
+    newest = none;
 }
 
 template<typename Key, typename Value>
-const std::list<typename lru_cache<Key, Value>::Pair> &lru_cache<Key, Value>::list() const
+std::vector<typename lru_cache<Key, Value>::Pair> lru_cache<Key, Value>::list() const
 {
-    return ordered_list;
+    auto result = std::vector<Pair>();
+    result.reserve( entries.size() );
+    for( auto index = oldest; index != none; index = entries[index].newer ) {
+        result.push_back( entries[index].kv );
+    }
+    return result;
 }
 
 // explicit template initialization for lru_cache of all types
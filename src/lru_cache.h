@@ -1,11 +1,31 @@
 #pragma once
 
-#include <list>
-#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
+#include <vector>
 
 #include "enums.h" // IWYU pragma: keep
 
+/** Lookups and evictions of one @ref lru_cache since it was made or its stats were reset. */
+struct lru_cache_stats {
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t evictions = 0;
+
+    auto hit_rate() const -> double {
+        const auto lookups = hits + misses;
+        return lookups == 0 ? 0.0 : static_cast<double>( hits ) / static_cast<double>( lookups );
+    }
+};
+
+/**
+ * Cache of at most `limit` entries that evicts the least recently inserted one.
+ *
+ * Entries live in one contiguous array, linked in insertion order by index, and are found
+ * through an open-addressing table of indices into it.  Once both have grown to the limit,
+ * inserting and evicting allocate nothing.
+ */
 template<typename Key, typename Value>
 class lru_cache
 {
@@ -13,15 +33,52 @@ class lru_cache
         using Pair = std::pair<Key, Value>;
 
         void insert( int limit, const Key &, const Value & );
-        Value get( const Key &, const Value &default_ ) const;
+        /**
+         * The value cached for the key, or @p default_ when there is none.  The reference
+         * is valid until the cache is next changed.
+         */
+        const Value &get( const Key &, const Value &default_ ) const;
+        /** The value cached for the key, or nullptr.  Counted like get(). */
+        const Value *find( const Key & ) const;
         void remove( const Key & );
 
         void clear();
-        const std::list<Pair> &list() const;
+        /** The cached entries, least recently inserted first. */
+        std::vector<Pair> list() const;
+        std::size_t size() const {
+            return entries.size();
+        }
+
+        const lru_cache_stats &stats() const {
+            return counters;
+        }
+        void reset_stats() {
+            counters = {};
+        }
     private:
+        static constexpr std::uint32_t none = UINT32_MAX;
+
+        struct entry {
+            Pair kv;
+            std::uint32_t older = none;
+            std::uint32_t newer = none;
+        };
+
+        std::size_t home_slot( const Key & ) const;
+        /** Slot holding the key, or the empty slot where it would go. */
+        std::size_t find_slot( const Key & ) const;
+        void grow();
+        void unlink( std::uint32_t index );
+        void link_newest( std::uint32_t index );
+        void erase( std::uint32_t index );
         void trim( int limit );
-        std::list<Pair> ordered_list;
-        std::unordered_map<Key, typename std::list<Pair>::iterator> map;
+
+        std::vector<entry> entries;
+        /** Indices into entries, or none; the size is zero or a power of two. */
+        std::vector<std::uint32_t> slots;
+        std::uint32_t oldest = none;
+        std::uint32_t newest = none;
+        mutable lru_cache_stats counters;
 };
 
 
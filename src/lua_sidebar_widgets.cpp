@@ -15,6 +15,12 @@ auto widgets_storage() -> std::vector<widget_entry> & // *NOPAD*
     return widgets;
 }
 
+auto next_generation() -> uint64_t
+{
+    static auto generation = uint64_t{ 0 };
+    return ++generation;
+}
+
 auto normalize_name( const std::string &id, const std::string &name ) -> std::string
 {
     return name.empty() ? id : name;
@@ -35,6 +41,10 @@ auto register_widget( const widget_options &opts ) -> void
         debugmsg( "Lua sidebar widget '%s' has non-positive height.", opts.id );
         return;
     }
+    if( opts.refresh == refresh_policy::interval && opts.refresh_interval_ms <= 0 ) {
+        debugmsg( "Lua sidebar widget '%s' has non-positive refresh interval.", opts.id );
+        return;
+    }
 
     auto entry_name = normalize_name( opts.id, opts.name );
     auto new_entry = widget_entry{
@@ -48,6 +58,9 @@ auto register_widget( const widget_options &opts ) -> void
         .panel_visible_fn = opts.panel_visible_fn,
         .draw = opts.draw,
         .render = opts.render,
+        .refresh = opts.refresh,
+        .refresh_interval_ms = opts.refresh_interval_ms,
+        .generation = next_generation(),
     };
 
     auto &widgets = widgets_storage();
@@ -65,6 +78,15 @@ auto clear_widgets() -> void
     widgets_storage().clear();
 }
 
+auto invalidate_widget( const std::string_view id ) -> void
+{
+    auto &widgets = widgets_storage();
+    auto match = std::ranges::find( widgets, id, &widget_entry::id );
+    if( match != widgets.end() ) {
+        match->generation = next_generation();
+    }
+}
+
 auto get_widgets() -> const std::vector<widget_entry> & // *NOPAD*
 {
     return widgets_storage();
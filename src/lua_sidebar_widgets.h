@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -9,6 +10,14 @@
 
 namespace cata::lua_sidebar_widgets
 {
+/** When the output of a widget's Lua callbacks may be reused instead of calling them again. */
+enum class refresh_policy : int {
+    every_frame, // call them on every sidebar redraw
+    per_turn,    // reuse until the game turn changes
+    on_event,    // reuse until invalidate_widget() is called for it
+    interval,    // reuse for refresh_interval_ms
+};
+
 struct widget_entry {
     std::string id;
     std::string name;
@@ -20,6 +29,10 @@ struct widget_entry {
     std::optional<sol::protected_function> panel_visible_fn;
     sol::protected_function draw;
     std::optional<sol::protected_function> render;
+    refresh_policy refresh = refresh_policy::every_frame;
+    int refresh_interval_ms = 0;
+    // Changes whenever cached output of this widget must be thrown away
+    uint64_t generation = 0;
 };
 
 struct widget_options {
@@ -33,10 +46,14 @@ struct widget_options {
     std::optional<sol::protected_function> panel_visible_fn;
     sol::protected_function draw;
     std::optional<sol::protected_function> render;
+    refresh_policy refresh = refresh_policy::every_frame;
+    int refresh_interval_ms = 0;
 };
 
 auto register_widget( const widget_options &opts ) -> void;
 auto clear_widgets() -> void;
+/** Makes the widget call its callbacks again on the next redraw, whatever its refresh policy. */
+auto invalidate_widget( std::string_view id ) -> void;
 auto get_widgets() -> const std::vector<widget_entry> &; // *NOPAD*
 auto find_widget( std::string_view id ) -> const widget_entry *; // *NOPAD*
 } // namespace cata::lua_sidebar_widgets
@@ -2265,3 +2265,7 @@ void spell_events::notify(const cata::event& e) {
             break;
     }
 }
+
+auto spell_events::subscribed_events() const -> std::vector<event_type> {
+    return {event_type::player_levels_spell};
+}
@@ -145,6 +145,7 @@ struct fake_spell {
 class spell_events: public event_subscriber {
 public:
     void notify(const cata::event&) override;
+    auto subscribed_events() const -> std::vector<event_type> override;
 };
 
 class spell_type {
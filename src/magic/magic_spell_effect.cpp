@@ -14,6 +14,7 @@
 #include "explosion.h"
 #include "field.h"
 #include "field_type.h"
+#include "flat_hash_map.h"
 #include "game.h"
 #include "handle_liquid.h"
 #include "item.h"
@@ -195,14 +196,20 @@ static std::set<tripoint_bub_ms> spell_effect_cone_range_override(
         end_points.emplace(potential);
     }
     map& here = get_map();
+    // Neighbouring rays cross mostly the same tiles; test and collect each tile once
+    auto open_tiles = cata::flat_hash_map<tripoint_bub_ms, bool>();
+    const auto is_open = [&](const tripoint_bub_ms& tp) {
+        const auto [it, inserted] = open_tiles.try_emplace(tp, false);
+        if (inserted) { it->second = here.passable(tp) || here.has_flag("THIN_OBSTACLE", tp); }
+        return it->second;
+    };
+    auto reached = cata::flat_hash_set<tripoint_bub_ms>();
     for (const tripoint_bub_ms& ep : end_points) {
         std::vector<tripoint_bub_ms> trajectory = line_to(source, ep);
         tripoint_bub_ms last_point = source;
         for (const tripoint_bub_ms& tp : trajectory) {
-            if (ignore_walls
-                || (!here.obstructed_by_vehicle_rotation(tp, last_point)
-                    && (here.passable(tp) || here.has_flag("THIN_OBSTACLE", tp)))) {
-                targets.emplace(tp);
+            if (ignore_walls || (!here.obstructed_by_vehicle_rotation(tp, last_point) && is_open(tp))) {
+                reached.insert(tp);
             } else {
                 break;
             }
@@ -210,7 +217,10 @@ static std::set<tripoint_bub_ms> spell_effect_cone_range_override(
         }
     }
     // we don't want to hit ourselves in the blast!
-    targets.erase(source);
+    reached.erase(source);
+    auto sorted = std::vector<tripoint_bub_ms>(reached.begin(), reached.end());
+    std::sort(sorted.begin(), sorted.end());
+    targets.insert(sorted.begin(), sorted.end());
     return targets;
 }
 
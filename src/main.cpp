@@ -35,6 +35,7 @@
 #include "language.h"
 #include "loading_ui.h"
 #include "runtime_handlers.h"
+#include "startup_timeline.h"
 #include "string_formatter.h"
 #include "main_menu.h"
 #include "mapsharing.h"
@@ -270,7 +271,7 @@ int main( int argc, char *argv[] )
         const char *section_default = nullptr;
         const char *section_map_sharing = "Map sharing";
         const char *section_user_directory = "User directories";
-        const std::array<arg_handler, 17> first_pass_arguments = {{
+        const std::array<arg_handler, 18> first_pass_arguments = {{
                 {
                     "--seed", "<string of letters and or numbers>",
                     "Sets the random number generator's seed value",
@@ -461,6 +462,19 @@ int main( int argc, char *argv[] )
                         return 0;
                     }
                 },
+                {
+                    "--startup-trace", "<output path>",
+                    "Records how long each part of loading takes, per mod, as a chrome://tracing JSON file",
+                    section_default,
+                    []( int num_args, const char **params ) -> int {
+                        if( num_args < 1 )
+                        {
+                            return -1;
+                        }
+                        startup_timeline::enable( params[0] );
+                        return 1;
+                    }
+                },
                 {
                     "--lua-doc", "<output path>",
                     "Generate Lua docs to given path and exit",
@@ -841,7 +855,10 @@ int main( int argc, char *argv[] )
     // First load and initialize everything that does not
     // depend on the mods.
     try {
-        g->load_static_data();
+        {
+            startup_timeline::span timing( "Static data", "startup" );
+            g->load_static_data();
+        }
         if( verifyexit ) {
             exit_handler( 0 );
         }
@@ -17,6 +17,7 @@
 #include <limits>
 #include <mutex>
 #include <shared_mutex>
+#include <span>
 #include <optional>
 #include <ostream>
 #include <queue>
@@ -86,6 +87,7 @@
 #include "map_feature_descriptions.h"
 #include "math_defines.h"
 #include "memory_fast.h"
+#include "memory_usage.h"
 #include "messages.h"
 #include "mission.h"
 #include "mongroup.h"
@@ -116,6 +118,7 @@
 #include "timed_event.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_recorder.h"
 #include "ui_manager.h"
 #include "value_ptr.h"
 #include "veh_type.h"
@@ -506,15 +509,21 @@ map::map( int mapsize )
     }
 
     dbg( DL::Info ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE;
-    skew_vision_cache_mutex = std::make_unique<std::shared_mutex>();
+    skew_vision_cache_mutex = std::make_unique<skew_vision_mutex_type>();
     skew_vision_cache.resize( vision_cache_slots );
+    ambient_lightmap_reads_ = std::make_unique<std::array<std::atomic<bool>, OVERMAP_LAYERS>>();
 }
 
-map::~map() = default;
+map::~map()
+{
+    // The unpack writes into this map's caches.
+    finish_deferred_lighting();
+}
 map &map::operator=( map && )  noexcept = default;
 
 auto map::resize( int new_mapsize ) -> void
 {
+    finish_deferred_lighting();
     my_MAPSIZE = new_mapsize;
     for( auto &ptr : caches ) {
         ptr = std::make_unique<level_cache>( SEEX * new_mapsize, SEEY * new_mapsize );
@@ -746,6 +755,21 @@ void map::set_suspension_cache_dirty( const int zlev )
     }
 }
 
+// Queues tile @p p of @p ch for patching unless its whole submap is already dirty.
+static auto mark_tile_dirty( level_cache &ch, cata_dynamic_bitset &submap_bits,
+                             std::vector<point_bub_ms> &tiles, const tripoint_bub_ms &p ) -> void
+{
+    const auto smp = project_to<coords::sm>( p );
+    if( submap_bits.test( static_cast<size_t>( ch.bidx( smp.x(), smp.y() ) ) ) ) {
+        return;
+    }
+    tiles.push_back( p.xy() );
+    // Past a submap's worth of single tiles, rebuilding whole submaps is no slower.
+    if( tiles.size() > static_cast<size_t>( SEEX * SEEY ) ) {
+        ch.fold_dirty_tiles( submap_bits, tiles );
+    }
+}
+
 void map::set_floor_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
@@ -769,13 +793,9 @@ void map::set_floor_cache_dirty( const tripoint_bub_ms &p )
         return;
     }
     level_cache &ch = get_cache( p.z() );
-    const auto smp = project_to<coords::sm>( p );
-    ch.floor_cache_dirty.set( static_cast<size_t>( ch.bidx( smp.x(), smp.y() ) ) );
-    const auto abs_sm = map_local_to_abs( *this, tripoint_bub_sm{ smp.x(), smp.y(), p.z() } );
-    get_mapbuffer().mark_submap_caches_dirty( {
-        .begin = abs_sm.xy(),
-        .end = abs_sm.xy() + point_rel_sm( 1, 1 ),
-        .zlev = abs_sm.z(),
+    mark_tile_dirty( ch, ch.floor_cache_dirty, ch.floor_dirty_tiles, p );
+    get_mapbuffer().mark_tile_caches_dirty( {
+        .pos = map_local_to_abs( *this, p ),
         .floor = true,
     } );
     // outside_cache and sheltered_cache at z-1 depend on floor_cache at z.
@@ -796,14 +816,10 @@ void map::set_seen_cache_dirty( const int &zlevel )
 void map::set_transparency_cache_dirty( const tripoint_bub_ms &p )
 {
     if( inbounds( p ) ) {
-        const auto smp = project_to<coords::sm>( p );
-        level_cache &ch = get_cache( smp.z() );
-        ch.transparency_cache_dirty.set( static_cast<size_t>( ch.bidx( smp.x(), smp.y() ) ) );
-        const auto abs_sm = map_local_to_abs( *this, smp );
-        get_mapbuffer().mark_submap_caches_dirty( {
-            .begin = abs_sm.xy(),
-            .end = abs_sm.xy() + point_rel_sm( 1, 1 ),
-            .zlev = abs_sm.z(),
+        level_cache &ch = get_cache( p.z() );
+        mark_tile_dirty( ch, ch.transparency_cache_dirty, ch.transparency_dirty_tiles, p );
+        get_mapbuffer().mark_tile_caches_dirty( {
+            .pos = map_local_to_abs( *this, p ),
             .transparency = true,
         } );
     }
@@ -935,21 +951,28 @@ void map::add_vehicle_to_cache( vehicle *veh )
             // (issue #9590). The top tile is kept so climbing down while boarded resolves.
             const auto len = veh->part( part ).info().ladder_length();
             const auto min_z = std::max( p.z() - len, -OVERMAP_DEPTH );
-            for( const auto z : std::views::iota( min_z, p.z() + 1 ) ) {
-                cached_veh_rope[tripoint_bub_ms( p.xy(), z )] = std::make_pair( veh, static_cast<int>( part ) );
+            if( inbounds( p.xy() ) ) {
+                for( const auto z : std::views::iota( min_z, p.z() + 1 ) ) {
+                    level_cache &rope_ch = get_cache( z );
+                    rope_ch.veh_rope.set( rope_ch.idx( p.x(), p.y() ), veh, part );
+                }
             }
         }
+        // Parts off the map are never looked up: veh_at_internal only takes tiles in bounds.
+        if( !inbounds( p ) ) {
+            continue;
+        }
         level_cache &ch = get_cache( p.z() );
         ch.veh_in_active_range = true;
 
         // DANGER: Unlike what you think where you can just use vpr.has_flag( VPFLAG_NOCOLLIDE )
         // THAT DOES NOT WORK DO NOT TRY AND CHANGE THIS MESS
-        if( !ch.veh_cached_parts.contains( p ) ||
+        const int i = ch.idx( p.x(), p.y() );
+        if( !ch.veh_parts.has( i ) ||
             ( !veh->part_info( vpr.part_index() ).has_flag( VPFLAG_NOCOLLIDE ) ) ) {
-            ch.veh_cached_parts[p] = std::make_pair( veh,  static_cast<int>( vpr.part_index() ) );
-        }
-        if( inbounds( p ) ) {
-            ch.veh_exists_at[ch.idx( p.x(), p.y() )] = true;
+            if( !ch.veh_parts.set( i, veh, static_cast<int>( vpr.part_index() ) ) ) {
+                debugmsg( "vehicle part cache is full at %d %d %d", p.x(), p.y(), p.z() );
+            }
         }
     }
 
@@ -963,13 +986,12 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &p
         return;
     }
 
+    if( !inbounds( pt ) ) {
+        return;
+    }
     level_cache &ch = get_cache( pt.z() );
-    auto it = ch.veh_cached_parts.find( pt );
-    if( it != ch.veh_cached_parts.end() && it->second.first == veh ) {
-        if( inbounds( pt ) ) {
-            ch.veh_exists_at[ch.idx( pt.x(), pt.y() )] = false;
-        }
-        ch.veh_cached_parts.erase( it );
+    const int i = ch.idx( pt.x(), pt.y() );
+    if( ch.veh_parts.clear_if( i, veh ) ) {
         // The rope-ladder cache stores the whole hanging column (see add_vehicle_to_cache),
         // so a bare erase( pt ) would leave the rope tiles below the part. When pt is one of
         // this vehicle's rope tiles (a column top), drop every tile this vehicle owns in that
@@ -977,13 +999,10 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &p
         // NOT break on gaps, so an interleaved column from another vehicle can't strand this
         // vehicle's lower tiles, and only this vehicle's entries are removed. Index-free on
         // purpose: part indices may be stale here (this can run mid-part_removal_cleanup).
-        if( const auto top = cached_veh_rope.find( pt );
-            top != cached_veh_rope.end() && top->second.first == veh ) {
+        if( ch.veh_rope.get( i ).first == veh ) {
             for( const auto z : std::views::iota( -OVERMAP_DEPTH, pt.z() + 1 ) ) {
-                const auto col_it = cached_veh_rope.find( tripoint_bub_ms( pt.xy(), z ) );
-                if( col_it != cached_veh_rope.end() && col_it->second.first == veh ) {
-                    cached_veh_rope.erase( col_it );
-                }
+                level_cache &rope_ch = get_cache( z );
+                rope_ch.veh_rope.clear_if( rope_ch.idx( pt.x(), pt.y() ), veh );
             }
         }
     }
@@ -994,17 +1013,10 @@ void map::clear_vehicle_cache( )
 {
     for( int zlev = -OVERMAP_DEPTH; zlev <= OVERMAP_HEIGHT; zlev++ ) {
         level_cache &ch = get_cache( zlev );
-        while( !ch.veh_cached_parts.empty() ) {
-            const auto part = ch.veh_cached_parts.begin();
-            const auto &p = part->first;
-            if( inbounds( p ) ) {
-                ch.veh_exists_at[ch.idx( p.x(), p.y() )] = false;
-            }
-            ch.veh_cached_parts.erase( part );
-        }
+        ch.veh_parts.clear_all();
+        ch.veh_rope.clear_all();
         ch.veh_in_active_range = false;
     }
-    cached_veh_rope.clear();
 }
 
 void map::clear_vehicle_list( const int zlev )
@@ -1109,6 +1121,7 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             reset_vehicle_cache( );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_modified();
             get_mapbuffer().unregister_vehicle( veh );
             if( veh->tracking_on ) {
                 get_overmapbuffer( bound_dimension_ ).remove_vehicle( veh );
@@ -1414,11 +1427,7 @@ bool map::vehproceed( VehicleList &vehicle_list )
         level_cache &cache = get_cache( zlev );
 
         // Check if any vehicles exist in the active range for this z-level
-        cache.veh_in_active_range = cache.veh_in_active_range &&
-                                    std::ranges::any_of( cache.veh_exists_at,
-        []( bool veh_exists ) {
-            return veh_exists;
-        } );
+        cache.veh_in_active_range = cache.veh_in_active_range && cache.veh_parts.any();
     }
 
     return true;
@@ -2013,20 +2022,14 @@ const vehicle *map::veh_at_internal( const tripoint_bub_ms &p, int &part_num ) c
 {
     // This function is called A LOT. Move as much out of here as possible.
     const level_cache &ch = get_cache( p.z() );
-    if( !ch.veh_in_active_range || !ch.veh_exists_at[ch.idx( p.x(), p.y() )] ) {
+    if( !ch.veh_in_active_range ) {
         part_num = -1;
         return nullptr; // Clear cache indicates no vehicle. This should optimize a great deal.
     }
 
-    const auto it = ch.veh_cached_parts.find( p );
-    if( it != ch.veh_cached_parts.end() ) {
-        part_num = it->second.second;
-        return it->second.first;
-    }
-
-    debugmsg( "vehicle part cache indicated vehicle not found: %d %d %d", p.x(), p.y(), p.z() );
-    part_num = -1;
-    return nullptr;
+    const auto [veh, part] = ch.veh_parts.get( ch.idx( p.x(), p.y() ) );
+    part_num = part;
+    return veh;
 }
 
 vehicle *map::veh_at_internal( const tripoint_bub_ms &p, int &part_num )
@@ -2288,7 +2291,9 @@ bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp )
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_modified();
         dst_submap->is_uniform = false;
+        dst_submap->mark_modified();
         invalidate_max_populated_zlev( dest.z() );
 
         // Update abs_sm_pos for the submap boundary crossing.
@@ -2878,10 +2883,13 @@ std::string map::features( const tripoint_bub_ms &p )
     return result;
 }
 
-int map::move_cost_internal( const furn_t &furniture, const ter_t &terrain, const vehicle *veh,
+int map::move_cost_internal( const furn_id &furniture, const ter_id &terrain, const vehicle *veh,
                              const int vpart ) const
 {
-    if( terrain.movecost == 0 || ( furniture.id && furniture.movecost < 0 ) ) {
+    const int ter_cost = cache_attr::move_cost( terrain );
+    const bool has_furniture = ( cache_attr::of( furniture ) & cache_attr::present ) != 0;
+    const int furn_cost = has_furniture ? cache_attr::move_cost( furniture ) : 0;
+    if( ter_cost == 0 || furn_cost < 0 ) {
         return 0;
     }
 
@@ -2896,11 +2904,7 @@ int map::move_cost_internal( const furn_t &furniture, const ter_t &terrain, cons
         }
     }
 
-    if( furniture.id ) {
-        return std::max( terrain.movecost + furniture.movecost, 0 );
-    }
-
-    return std::max( terrain.movecost, 0 );
+    return std::max( ter_cost + furn_cost, 0 );
 }
 
 bool map::is_wall_adjacent( const tripoint_bub_ms &center ) const
@@ -2922,13 +2926,11 @@ int map::move_cost( const tripoint_bub_ms &p, const vehicle *ignored_vehicle ) c
         return 0;
     }
 
-    const furn_t &furniture = furn( p ).obj();
-    const ter_t &terrain = ter( p ).obj();
     const optional_vpart_position vp = veh_at( p );
     vehicle *const veh = ( !vp || &vp->vehicle() == ignored_vehicle ) ? nullptr : &vp->vehicle();
     const int part = veh ? vp->part_index() : -1;
 
-    return move_cost_internal( furniture, terrain, veh, part );
+    return move_cost_internal( furn( p ), ter( p ), veh, part );
 }
 
 bool map::impassable( const tripoint_bub_ms &p ) const
@@ -3046,12 +3048,8 @@ bool map::has_floor( const tripoint_bub_ms &p, bool visible_only ) const
     if( !sm ) {
         return false;
     }
-    if( sm->floor_dirty ) {
-        const int smx = divide_round_to_minus_infinity( p.x(), SEEX );
-        const int smy = divide_round_to_minus_infinity( p.y(), SEEY );
-        sm->rebuild_floor_cache( *this, tripoint_bub_sm( smx, smy, p.z() ) );
-    }
-    return sm->floor_cache[l.x()][l.y()] || ( !visible_only && has_flag( TFLAG_Z_TRANSPARENT, p ) );
+    return sm->refresh_floor_tile( *this, project_to<coords::sm>( p ), l ) ||
+           ( !visible_only && has_flag( TFLAG_Z_TRANSPARENT, p ) );
 }
 
 bool map::floor_between( const tripoint_bub_ms &first, const tripoint_bub_ms &second ) const
@@ -3422,17 +3420,20 @@ bool map::has_flag_ter_or_furn( const ter_bitflags flag, const tripoint_bub_ms &
 
 // Bashable - common function
 
-int map::bash_rating_internal( const int str, const furn_t &furniture,
-                               const ter_t &terrain, const bool allow_floor,
+int map::bash_rating_internal( const int str, const furn_id &furniture,
+                               const ter_id &terrain, const bool allow_floor,
                                const vehicle *veh, const int part ) const
 {
+    const auto furn_bash = cache_attr::bash_strength( furniture );
+    const auto ter_bash = cache_attr::bash_strength( terrain );
     bool furn_smash = false;
     bool ter_smash = false;
     ///\EFFECT_STR determines what furniture can be smashed
-    if( furniture.id && furniture.bash.str_max != -1 ) {
+    if( ( cache_attr::of( furniture ) & cache_attr::present ) != 0 && furn_bash.second != -1 ) {
         furn_smash = true;
         ///\EFFECT_STR determines what terrain can be smashed
-    } else if( terrain.bash.str_max != -1 && ( !terrain.bash.bash_below || allow_floor ) ) {
+    } else if( ter_bash.second != -1 &&
+               ( ( cache_attr::of( terrain ) & cache_attr::bash_below ) == 0 || allow_floor ) ) {
         ter_smash = true;
     }
 
@@ -3444,11 +3445,11 @@ int map::bash_rating_internal( const int str, const furn_t &furniture,
     int bash_min = 0;
     int bash_max = 0;
     if( furn_smash ) {
-        bash_min = furniture.bash.str_min;
-        bash_max = furniture.bash.str_max;
+        bash_min = furn_bash.first;
+        bash_max = furn_bash.second;
     } else if( ter_smash ) {
-        bash_min = terrain.bash.str_min;
-        bash_max = terrain.bash.str_max;
+        bash_min = ter_bash.first;
+        bash_max = ter_bash.second;
     } else {
         return -1;
     }
@@ -3532,12 +3533,10 @@ int map::bash_rating( const int str, const tripoint_bub_ms &p, const bool allow_
         return -1;
     }
 
-    const furn_t &furniture = furn( p ).obj();
-    const ter_t &terrain = ter( p ).obj();
     const optional_vpart_position vp = veh_at( p );
     vehicle *const veh = vp ? &vp->vehicle() : nullptr;
     const int part = vp ? vp->part_index() : -1;
-    return bash_rating_internal( str, furniture, terrain, allow_floor, veh, part );
+    return bash_rating_internal( str, furn( p ), ter( p ), allow_floor, veh, part );
 }
 
 // End of 3D bashable
@@ -3622,10 +3621,7 @@ float map::get_transparency( const tripoint_bub_ms &p ) const
     if( !sm ) {
         return LIGHT_TRANSPARENCY_SOLID;
     }
-    if( sm->transparency_dirty ) {
-        sm->rebuild_transparency_cache( *this, project_to<coords::sm>( p ) );
-    }
-    return sm->transparency_cache[l.x()][l.y()];
+    return sm->refresh_transparency_tile( *this, project_to<coords::sm>( p ), l );
 }
 
 bool map::is_last_ter_wall( const bool no_furn, const tripoint_bub_ms &p,
@@ -3749,6 +3745,9 @@ void map::decay_fields_and_scent( const time_duration &amount )
 
         if( to_proc > 0 ) {
             for( const auto sm_ms : submap_tiles() ) {
+                if( !cur_submap->may_have_field_at( sm_ms ) ) {
+                    continue;
+                }
                 const auto ms_pos = project_combine( p, sm_ms );
 
                 field &fields = cur_submap->get_field( sm_ms );
@@ -6019,6 +6018,7 @@ void map::add_item( const tripoint_bub_ms &p, detached_ptr<item> &&new_item )
     new_item->on_map_placement( *this, p );
 
     current_submap->get_items( l ).push_back( std::move( new_item ) );
+    current_submap->note_item_added( l );
     return;
 }
 
@@ -6236,6 +6236,38 @@ std::vector<tripoint_abs_sm> map::check_submap_active_item_consistency()
     return result;
 }
 
+/**
+ * Rot worked out ahead of time for one item in an active item's tree, plus the
+ * inputs it was worked out from.  Applied only if they still hold.
+ */
+struct planned_rot {
+    item *target = nullptr;
+    tripoint_bub_ms pos;
+    temperature_flag flag = temperature_flag::TEMP_NORMAL;
+    units::temperature weather_temperature = 0_c;
+    int local_temperature = 0;
+    item::rot_update update;
+};
+
+/**
+ * Output of map::plan_items_in_submap(), consumed by map::process_items_in_submap().
+ *
+ * Planning snapshots the submap's active item list and, for trees that do
+ * nothing but rot, works out the rot they are about to take.  It runs on worker
+ * threads and only reads the world.  Processing then runs item::process() on
+ * the main thread in the original order, with the rot already applied where
+ * its inputs are unchanged, so the expensive out-of-bubble rot catch-up is
+ * done in parallel.  Mirrors monster_plan_t.
+ */
+struct submap_item_plan {
+    submap *sm = nullptr;
+    tripoint_bub_sm gridp;
+    std::vector<item *> active_items;
+    /// Rot of active_items[i] and its contents is rot[rot_offsets[i]..rot_offsets[i + 1]).
+    std::vector<planned_rot> rot;
+    std::vector<size_t> rot_offsets;
+};
+
 void map::process_items()
 {
     // Defer explosion drains during processing: an item here can be detached but
@@ -6283,7 +6315,7 @@ void map::process_items()
         submaps_with_active_items_copy = std::vector<tripoint_abs_sm>(
                                              active_item_submaps.begin(), active_item_submaps.end() );
     }
-    auto active_items = std::vector<item *> {};
+    auto plans = std::vector<submap_item_plan> {};
     {
         ZoneScopedN( "process_items_scan_active_submaps" );
         for( const tripoint_abs_sm &abs_pos : submaps_with_active_items_copy ) {
@@ -6302,29 +6334,119 @@ void map::process_items()
                     total_active_items += counts.total;
                     total_rottable_active_items += counts.rottable;
                 }
-                process_items_in_submap( *current_submap, local_pos, active_items );
+                plans.push_back( submap_item_plan{ .sm = current_submap, .gridp = local_pos } );
             }
         }
     }
+    {
+        ZoneScopedN( "process_items_plan" );
+        if( parallel_enabled && parallel_item_processing && !is_pool_worker_thread() ) {
+            parallel_for( "process_items_plan", 0, static_cast<int>( plans.size() ), [&]( const int i ) {
+                plan_items_in_submap( plans[i] );
+            } );
+        } else {
+            std::ranges::for_each( plans, [this]( submap_item_plan & plan ) {
+                plan_items_in_submap( plan );
+            } );
+        }
+    }
+    std::ranges::for_each( plans, [this]( submap_item_plan & plan ) {
+        process_items_in_submap( plan );
+    } );
     TracyPlot( "Total Active Items", total_active_items );
     TracyPlot( "Total Rottable Active Items", total_rottable_active_items );
 }
 
-auto map::process_items_in_submap( submap &current_submap, const tripoint_bub_sm &gridp,
-                                   std::vector<item *> &active_items ) -> void
+// True if item::process_internal() touches nothing but the item's own rot
+// before reaching its rot step.
+static auto rot_step_is_isolated( const item &it ) -> bool
 {
-    ZoneScopedN( "process_items_in_submap" );
+    if( it.has_flag( flag_ETHEREAL_ITEM ) || it.is_artifact() || it.is_relic() || !it.faults.empty() ) {
+        return false;
+    }
+    if( !it.is_active() ) {
+        return true;
+    }
+    static const auto side_effect_flags = std::array {
+        flag_FAKE_SMOKE, flag_FAKE_CLONING_VAT, flag_FAKE_MILL, flag_WET, flag_LITCIG,
+        flag_WATER_EXTINGUISH, flag_WIND_EXTINGUISH, flag_WATER_DISABLE, flag_CABLE_SPOOL, flag_IS_UPS,
+    };
+    return it.is_food() && !it.is_tool() && it.type->emits.empty() && !it.type->countdown_action &&
+    std::ranges::none_of( side_effect_flags, [&it]( const flag_id & f ) {
+        return it.has_flag( f );
+    } );
+}
+
+static auto tree_rot_is_isolated( const item &it ) -> bool
+{
+    return rot_step_is_isolated( it ) &&
+    std::ranges::all_of( it.contents.processing_items(), []( const item * content ) {
+        return content == nullptr || tree_rot_is_isolated( *content );
+    } );
+}
+
+static auto plan_tree_rot( const item &it, const planned_rot &base,
+                           const item::rot_context &context, std::vector<planned_rot> &out ) -> void
+{
+    std::ranges::for_each( it.contents.processing_items(), [&]( const item * content ) {
+        if( content != nullptr ) {
+            plan_tree_rot( *content, base, context, out );
+        }
+    } );
+    if( !it.is_active() || !it.is_food() || !it.goes_bad() ) {
+        return;
+    }
+    if( const auto update = it.plan_rot_update( context ) ) {
+        auto planned = base;
+        planned.target = const_cast<item *>( &it );
+        planned.update = *update;
+        out.push_back( planned );
+    }
+}
+
+auto map::plan_items_in_submap( submap_item_plan &plan ) const -> void
+{
+    ZoneScopedN( "plan_items_in_submap" );
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
-    {
-        ZoneScopedN( "process_items_copy_active_items" );
-        current_submap.active_items.get_for_processing( active_items );
+    plan.sm->active_items.get_for_processing( plan.active_items );
+    plan.rot.clear();
+    plan.rot_offsets.assign( 1, 0 );
+    const auto &weather = get_weather();
+    for( const item *active_item : plan.active_items ) {
+        if( active_item != nullptr && active_item->is_loaded() && tree_rot_is_isolated( *active_item ) ) {
+            const auto pos = active_item->bub_pos();
+            const auto abs_pos = bub_to_abs( pos );
+            const auto base = planned_rot{
+                .target = nullptr,
+                .pos = pos,
+                .flag = rot::temp::for_location( *this, *active_item ),
+                .weather_temperature = weather.get_temperature( abs_pos ),
+                .local_temperature = g != nullptr && !g->new_game ? get_temperature( pos ) : 0,
+                .update = {},
+            };
+            const auto context = item::rot_context{
+                .position = abs_pos,
+                .temperature = base.flag,
+                .weather = &weather,
+                .local_temperature = base.local_temperature,
+            };
+            plan_tree_rot( *active_item, base, context, plan.rot );
+        }
+        plan.rot_offsets.push_back( plan.rot.size() );
     }
-    const point grid_offset( gridp.x() * SEEX, gridp.y() * SEEY );
+}
+
+auto map::process_items_in_submap( submap_item_plan &plan ) -> void
+{
+    ZoneScopedN( "process_items_in_submap" );
+    turn_recorder::count( turn_recorder::counter::items_processed, plan.active_items.size() );
+    const auto &weather = get_weather();
     {
         ZoneScopedN( "process_items_active_items" );
-        for( item *&active_item_ref : active_items ) {
+        for( size_t i = 0; i < plan.active_items.size(); ++i ) {
+            item *active_item_ref = plan.active_items[i];
             if( !active_item_ref || !active_item_ref->is_loaded() ) {
                 // The item was destroyed, so skip it.
                 continue;
@@ -6332,6 +6454,18 @@ auto map::process_items_in_submap( submap &current_submap, const tripoint_bub_sm
 
             const auto map_location = active_item_ref->bub_pos();
             const auto flag = rot::temp::for_location( *this, *active_item_ref );
+            const auto planned = std::span( plan.rot ).subspan( plan.rot_offsets[i],
+                                 plan.rot_offsets[i + 1] - plan.rot_offsets[i] );
+            if( !planned.empty() && planned.front().pos == map_location && planned.front().flag == flag &&
+                planned.front().weather_temperature == weather.get_temperature( bub_to_abs( map_location ) ) &&
+                planned.front().local_temperature == ( g != nullptr &&
+                        !g->new_game ? get_temperature( map_location ) : 0 ) ) {
+                std::ranges::for_each( planned, []( const planned_rot & p ) {
+                    if( p.target->is_loaded() ) {
+                        p.target->apply_rot_update( p.update );
+                    }
+                } );
+            }
             process_map_items( active_item_ref, map_location, flag );
         }
     }
@@ -6468,8 +6602,15 @@ bool map::has_items( const tripoint_bub_ms &p ) const
     if( current_submap == nullptr ) {
         return false;
     }
+    if( !current_submap->may_have_items_at( l ) ) {
+        return false;
+    }
 
-    return !current_submap->get_items( l ).empty();
+    if( current_submap->get_items( l ).empty() ) {
+        current_submap->note_no_items_at( l );
+        return false;
+    }
+    return true;
 }
 
 template <typename Stack>
@@ -6864,7 +7005,7 @@ const field &map::field_at( const tripoint_bub_ms &p ) const
     }
 
     point_sm_ms l;
-    submap *const current_submap = get_submap_at( tripoint_bub_ms( p ), l );
+    const submap *const current_submap = get_submap_at( tripoint_bub_ms( p ), l );
 
     if( current_submap == nullptr ) {
         nulfield = field();
@@ -6955,6 +7096,15 @@ bool map::has_field_at( const tripoint_bub_ms &p, bool check_bounds )
     return get_mapbuffer().has_field_at( map_local_to_abs( *this, p ), resident_item_lookup() );
 }
 
+bool map::has_creature_field_at( const tripoint_bub_ms &p )
+{
+    if( get_mapbuffer().is_outside_pocket_dimension_bounds( map_local_to_abs( *this, p ) ) ) {
+        return false;
+    }
+    return get_mapbuffer().has_creature_field_at( map_local_to_abs( *this, p ),
+            resident_item_lookup() );
+}
+
 field_entry *map::get_field( const tripoint_bub_ms &p, const field_type_id &type )
 {
     return get_mapbuffer().get_field_entry( map_local_to_abs( *this, p ), type,
@@ -7081,6 +7231,7 @@ auto map::update_visibility_cache( const int zlev,
                                    const std::function<void()> &while_gpu_pending ) -> void
 {
     ZoneScopedN( "update_visibility_cache" );
+    finish_deferred_lighting();
     const auto player_pos = g->u.bub_pos();
 #if defined( CATA_SDL )
     if( cata_compute::uses_sdl_gpu_compute() ) {
@@ -7203,7 +7354,7 @@ auto map::update_visibility_cache( const int zlev,
 
         // Fill visibility_cache.  apparent_light_at is read-only per tile.
         if( parallel_enabled && parallel_map_cache ) {
-            parallel_for( 0, vc_cache.cache_x, [&]( int x ) {
+            parallel_for( "visibility_cache", 0, vc_cache.cache_x, [&]( int x ) {
                 const auto dx = std::abs( x - player_pos.x() );
                 for( const auto y : std::views::iota( 0, vc_cache.cache_y ) ) {
                     const auto dy = std::abs( y - player_pos.y() );
@@ -7749,6 +7900,53 @@ void map::draw_from_above( const catacurses::window &w, const tripoint_bub_ms &p
     }
 }
 
+// Sight model for remember_fields_of_view; only reaching a tile matters, not how well.
+static const light_model k_fov_model = {
+    sight_calc, sight_check, update_light, nullptr, sight_from_lookup, accumulate_transparency
+};
+
+void map::remember_fields_of_view( std::span<const Creature *const> observers ) const
+{
+    ZoneScoped;
+    struct pending {
+        const Creature *who = nullptr;
+        int range = 0;
+    };
+    auto by_level = std::array<std::vector<pending>, OVERMAP_LAYERS> {};
+    for( const Creature *const who : observers ) {
+        const auto p = who->bub_pos();
+        if( !inbounds( p ) ) {
+            continue;
+        }
+        const auto range = std::min( sight_memo::radius,
+                                     std::max( who->sight_range( default_daylight_level() ), who->sight_range( 0 ) ) );
+        // Adjacent targets never ask for a ray.
+        if( range > 1 && !who->knows_field_of_view( *this, range ) ) {
+            by_level[p.z() + OVERMAP_DEPTH].push_back( { .who = who, .range = range } );
+        }
+    }
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+        const auto &level = by_level[z + OVERMAP_DEPTH];
+        if( level.empty() ) {
+            continue;
+        }
+        const auto &ch = get_cache_ref( z );
+        auto batch = std::vector<fov_observer> {};
+        batch.reserve( level.size() );
+        std::ranges::transform( level, std::back_inserter( batch ), []( const pending & o ) {
+            return fov_observer{ .origin = o.who->bub_pos().xy(), .range = o.range };
+        } );
+        cast_fov_batch( batch, ch.transparency_cache.data(), ch.vehicle_obscured_cache.data(),
+        ch.shape(), k_fov_model, &weather_lookup_, [&]( const std::size_t i, const float * seen ) {
+            level[i].who->remember_field_of_view( *this, level[i].range, [&]( const point_bub_ms & t ) {
+                return t.x() >= 0 && t.y() >= 0 && t.x() < ch.cache_x && t.y() < ch.cache_y &&
+                       seen[ch.idx( t.x(), t.y() )] > LIGHT_TRANSPARENCY_SOLID;
+            } );
+        } );
+    }
+}
+
 bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int range ) const
 {
     int dummy = 0;
@@ -7782,7 +7980,7 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
     // don't serialize against each other.  The ray trace runs fully unlocked.
     const auto slot_idx = std::hash<int64_t> {}( key ) & ( vision_cache_slots - 1 );
     {
-        std::shared_lock<std::shared_mutex> lock( *skew_vision_cache_mutex );
+        std::shared_lock lock( *skew_vision_cache_mutex );
         const auto &slot = skew_vision_cache[slot_idx];
         if( slot.key == key && slot.value >= 0 ) {
             return slot.value > 0;
@@ -7812,7 +8010,7 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
             return true;
         } );
         {
-            std::unique_lock<std::shared_mutex> lock( *skew_vision_cache_mutex );
+            std::unique_lock lock( *skew_vision_cache_mutex );
             skew_vision_cache[slot_idx] = { key, static_cast<char>( visible ? 1 : 0 ) };
         }
         return visible;
@@ -7849,7 +8047,7 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
         return true;
     } );
     {
-        std::unique_lock<std::shared_mutex> lock( *skew_vision_cache_mutex );
+        std::unique_lock lock( *skew_vision_cache_mutex );
         skew_vision_cache[slot_idx] = { key, static_cast<char>( visible ? 1 : 0 ) };
     }
     return visible;
@@ -8361,7 +8559,9 @@ void map::shift_vehicle_z( vehicle &veh, int z_shift )
     auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
     dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
     src_submap->vehicles.erase( src_submap_veh_it );
+    src_submap->mark_modified();
     dst_submap->is_uniform = false;
+    dst_submap->mark_modified();
     invalidate_max_populated_zlev( dst.z() );
 
     update_vehicle_list( dst_submap, dst.z() );
@@ -8387,6 +8587,8 @@ void map::shift( const point_rel_sm &sp )
     if( sp == point_rel_sm::zero() ) {
         return; // Skip this?
     }
+    // The download lands in bubble coordinates of the lighting's own turn.
+    finish_deferred_lighting();
 
     if( std::abs( sp.x() ) > 1 || std::abs( sp.y() ) > 1 ) {
         debugmsg( "map::shift called with a shift of more than one submap" );
@@ -8434,6 +8636,28 @@ void map::shift( const point_rel_sm &sp )
     auto const shift_flat_cache = [&]( auto & cache, auto & scratch, level_cache & gc,
     const auto fill_value ) {
         using cache_value = std::ranges::range_value_t<std::remove_reference_t<decltype( cache )>>;
+
+        if constexpr( cache_layout::tiled ) {
+            // Blocks that stay in the bubble keep their storage; moving the ring origin
+            // (shift_cache_origin, once per level) re-addresses them.  Only the blocks
+            // scrolling in need filling, and they are addressed with the new origin.
+            const auto shifted = gc.shape().shifted( sp.raw() );
+            const auto fill = static_cast<cache_value>( fill_value );
+            const auto block_size = SEEX * SEEY;
+            for( const auto smx : std::views::iota( 0, gc.cache_mapsize ) ) {
+                for( const auto smy : std::views::iota( 0, gc.cache_mapsize ) ) {
+                    const auto source_smx = smx + sp.x();
+                    const auto source_smy = smy + sp.y();
+                    if( source_smx < 0 || source_smx >= gc.cache_mapsize || source_smy < 0 ||
+                        source_smy >= gc.cache_mapsize ) {
+                        std::fill_n( cache.begin() + cache_layout::index( smx * SEEX, smy * SEEY, shifted ),
+                                     block_size, fill );
+                    }
+                }
+            }
+            return;
+        }
+
         scratch.assign( cache.begin(), cache.end() );
 
         const auto source_offset_x = sp.x() * SEEX;
@@ -8478,6 +8702,12 @@ void map::shift( const point_rel_sm &sp )
     auto short_shift_scratch = std::vector<short> {};
     auto bool_shift_scratch = std::vector<bool> {};
 
+    auto const shift_cache_origin = [&]( level_cache & gc ) {
+        if constexpr( cache_layout::tiled ) {
+            gc.cache_origin = gc.shape().shifted( sp.raw() ).origin;
+        }
+    };
+
     auto const shift_submap_dirty_bits = [&]( cata_dynamic_bitset & dirty_bits, level_cache & gc ) {
         const auto old_dirty = dirty_bits;
         dirty_bits.reset();
@@ -8608,6 +8838,8 @@ void map::shift( const point_rel_sm &sp )
                 shift_flat_cache( gc.floor_cache, char_shift_scratch, gc, '\x01' );
                 shift_flat_cache( gc.outside_cache, char_shift_scratch, gc, '\0' );
                 shift_flat_cache( gc.sheltered_cache, char_shift_scratch, gc, '\x01' );
+                gc.fold_dirty_tiles( gc.transparency_cache_dirty, gc.transparency_dirty_tiles );
+                gc.fold_dirty_tiles( gc.floor_cache_dirty, gc.floor_dirty_tiles );
                 shift_submap_dirty_bits( gc.transparency_cache_dirty, gc );
                 shift_submap_dirty_bits( gc.floor_cache_dirty, gc );
                 shift_submap_dirty_bits( gc.outside_cache_dirty, gc );
@@ -8619,6 +8851,9 @@ void map::shift( const point_rel_sm &sp )
                                   static_cast<short>( SOUND_ABSORPTION_OPEN_FIELD ) );
                 shift_flat_cache( gc.sound_wall_cache, bool_shift_scratch, gc, false );
                 shift_submap_dirty_bits( gc.absorption_cache_dirty, gc );
+                // Every tile array of the level moves with the origin, including the
+                // ones rebuilt after a shift anyway.
+                shift_cache_origin( gc );
             }
             // Iterate in shift-direction order so copy_grid never reads an
             // already-overwritten source slot.  sp >= 0 → forward; sp < 0 → reverse.
@@ -9060,6 +9295,7 @@ void map::spawn_monsters_submap( const tripoint_bub_sm &gp, bool ignore_sight )
         }
     }
     current_submap->spawns.clear();
+    current_submap->mark_modified();
 }
 
 void map::spawn_monsters( bool ignore_sight )
@@ -9267,7 +9503,7 @@ void map::build_outside_cache( const int zlev )
     };
 
     if( parallel_enabled && parallel_map_cache && !is_pool_worker_thread() ) {
-        parallel_for( 0, my_MAPSIZE, process_smx );
+        parallel_for( "outside_cache", 0, my_MAPSIZE, process_smx );
     } else {
         for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
             process_smx( smx );
@@ -9278,7 +9514,7 @@ void map::build_outside_cache( const int zlev )
 }
 
 void map::build_obstacle_cache( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
-                                float *obstacle_cache, int cache_sy )
+                                float *obstacle_cache, const cache_layout::grid_shape &shape )
 {
     const point_sm_ms min_submap{ std::max( 0, start.x() / SEEX ), std::max( 0, start.y() / SEEY ) };
     const point_sm_ms max_submap{
@@ -9296,7 +9532,7 @@ void map::build_obstacle_cache( const tripoint_bub_ms &start, const tripoint_bub
             if( !view ) {
                 for( const auto sm_ms : submap_tiles() ) {
                     const auto ms_pos = project_combine( gridp, sm_ms );
-                    obstacle_cache[ms_pos.x() * cache_sy + ms_pos.y()] = 1000.0f;
+                    obstacle_cache[cache_layout::index( ms_pos.x(), ms_pos.y(), shape )] = 1000.0f;
                 }
                 continue;
             }
@@ -9308,9 +9544,9 @@ void map::build_obstacle_cache( const tripoint_bub_ms &start, const tripoint_bub
                 int furn_move = cur_submap.get_furn( sm_ms ).obj().movecost;
                 const auto ms_pos = project_combine( gridp, sm_ms );
                 if( ter_move == 0 || furn_move < 0 || ter_move + furn_move == 0 ) {
-                    obstacle_cache[ms_pos.x() * cache_sy + ms_pos.y()] = 1000.0f;
+                    obstacle_cache[cache_layout::index( ms_pos.x(), ms_pos.y(), shape )] = 1000.0f;
                 } else {
-                    obstacle_cache[ms_pos.x() * cache_sy + ms_pos.y()] = 0.0f;
+                    obstacle_cache[cache_layout::index( ms_pos.x(), ms_pos.y(), shape )] = 0.0f;
                 }
             }
         }
@@ -9331,7 +9567,7 @@ void map::build_obstacle_cache( const tripoint_bub_ms &start, const tripoint_bub
             }
 
             if( vp.obstacle_at_part() ) {
-                obstacle_cache[p.x() * cache_sy + p.y()] = 1000.0f;
+                obstacle_cache[cache_layout::index( p.x(), p.y(), shape )] = 1000.0f;
             }
         }
     }
@@ -9342,11 +9578,46 @@ bool map::build_floor_cache( const int zlev )
 {
     ZoneScopedN( "build_floor_cache" );
     auto &ch = get_cache( zlev );
+    auto &floor_cache = ch.floor_cache;
+    if( ch.floor_cache_dirty.none() && !ch.floor_dirty_tiles.empty() ) {
+        // Only single tiles changed: patch them and keep the rest of the level.
+        bool gained = false;
+        bool lost = false;
+        for( const point_bub_ms &p : ch.floor_dirty_tiles ) {
+            const auto sm_pos = tripoint_bub_sm( p.x() / SEEX, p.y() / SEEY, zlev );
+            submap *cur_submap = get_mapbuffer().lookup_submap_in_memory(
+                                     map_local_to_abs( *this, sm_pos ) );
+            if( cur_submap == nullptr ) {
+                continue;
+            }
+            const char value = cur_submap->refresh_floor_tile( *this, sm_pos,
+                               point_sm_ms( p.x() % SEEX, p.y() % SEEY ) ) ? '\x01' : '\0';
+            char &cached = floor_cache[ch.idx( p.x(), p.y() )];
+            if( cached != value ) {
+                cached = value;
+                ( value != 0 ? gained : lost ) = true;
+            }
+        }
+        ch.floor_dirty_tiles.clear();
+        if( gained ) {
+            ch.has_any_floor = true;
+            // The tile that gained a floor may have been the last gap.
+            ch.has_floor_gap = std::ranges::any_of( floor_cache, []( char c ) { return c == 0; } );
+        }
+        if( lost ) {
+            ch.has_floor_gap = true;
+            if( !gained ) {
+                // The tile that lost its floor may have been the last one.
+                ch.has_any_floor = std::ranges::any_of( floor_cache, []( char c ) { return c != 0; } );
+            }
+        }
+        return gained || lost;
+    }
+    ch.fold_dirty_tiles( ch.floor_cache_dirty, ch.floor_dirty_tiles );
     if( ch.floor_cache_dirty.none() ) {
         return false;
     }
 
-    auto &floor_cache = ch.floor_cache;
     const bool rebuild_all = ch.floor_cache_dirty.all();
 
     // When rebuilding all submaps we can bulk-initialize the whole level to
@@ -9393,6 +9664,8 @@ bool map::build_floor_cache( const int zlev )
     ch.floor_cache_dirty.reset();
     ch.has_any_floor = std::ranges::any_of( floor_cache,
     []( char c ) { return c != 0; } );
+    ch.has_floor_gap = std::ranges::any_of( floor_cache,
+    []( char c ) { return c == 0; } );
     return true;
 }
 
@@ -9551,11 +9824,76 @@ void map::do_vehicle_caching( int z )
     }
 }
 
-void map::build_map_cache( const int zlev, bool skip_lightmap )
+void map::finish_deferred_lighting()
 {
+#if defined( CATA_SDL )
+    if( deferred_gpu_lighting_id_ == 0 ) {
+        return;
+    }
     ZoneScoped;
+    const auto work = cata_gpu::gpu_lighting_work{ .id = std::exchange( deferred_gpu_lighting_id_, 0 ) };
+    const auto levels = std::exchange( deferred_gpu_lighting_levels_, {} );
+    if( !cata_gpu::finish_gpu_lighting( cata_gpu::get_device(), work ) ) {
+        debugmsg( "SDL_GPU lighting completion failed; see debug.log for details" );
+        return;
+    }
+    std::ranges::for_each( levels, [this]( int z ) {
+        auto &c = get_cache( z );
+        c.lightmap_dirty = false;
+        c.lightmap_ambient_only = false;
+        mark_visibility_cache_dirty( z );
+    } );
+#endif
+}
+
+auto map::zlevel_sight_span( const int origin_z ) const -> std::pair<int, int>
+{
+    // Light and sight cross from z - 1 into z through tiles of z without a floor.  Vehicle
+    // roofs count as gaps, as build_seen_cache lets them through.
+    const auto boundary_open = [this]( const int z ) {
+        const auto &ch = get_cache_ref( z );
+        return ch.has_floor_gap || std::ranges::any_of( ch.vehicle_floor_cache, []( const char c ) {
+            return c != '\0';
+        } );
+    };
+    auto lo = origin_z;
+    while( lo > -OVERMAP_DEPTH && boundary_open( lo ) ) {
+        --lo;
+    }
+    auto hi = origin_z;
+    while( hi < OVERMAP_HEIGHT && boundary_open( hi + 1 ) ) {
+        ++hi;
+    }
+    return { lo, hi };
+}
+
+auto map::lighting_observed_levels( const int zlev ) const -> std::bitset<OVERMAP_LAYERS>
+{
+    auto observed = std::bitset<OVERMAP_LAYERS> {};
+    const auto observe_from = [&]( const int origin_z ) {
+        const auto [lo, hi] = zlevel_sight_span( origin_z );
+        for( int z = lo; z <= hi; ++z ) {
+            observed.set( z + OVERMAP_DEPTH );
+        }
+    };
+    // Cameras and mirrors extend the view on the avatar's own level.
+    observe_from( zlev );
+    const auto view_z = g->ter_view_p.z();
+    if( view_z != zlev && view_z >= -OVERMAP_DEPTH && view_z <= OVERMAP_HEIGHT ) {
+        observe_from( view_z );
+    }
+    return observed;
+}
+
+void map::build_map_cache( const int zlev, bool skip_lightmap, bool defer_lighting_finish )
+{
+    ZoneScoped;
+    // Nothing below may dispatch GPU work while lighting is still in flight.
+    finish_deferred_lighting();
 #if defined( CATA_SDL )
     const auto use_sdl_gpu_compute = cata_compute::uses_sdl_gpu_compute();
+#else
+    static_cast<void>( defer_lighting_finish );
 #endif
     flush_lightmap_cpu_read_counters();
     const auto valid_lm_levels = std::ranges::count_if(
@@ -9617,7 +9955,9 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         // Floor caches are z-independent so they can run in any order.
         // They must complete before outside/sheltered caches which read floor[z+1].
         for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
-            const bool floor_was_dirty = !get_cache_ref( z ).floor_cache_dirty.none();
+            const level_cache &floor_ch = get_cache_ref( z );
+            const bool floor_was_dirty = !floor_ch.floor_cache_dirty.none() ||
+                                         !floor_ch.floor_dirty_tiles.empty();
             if( build_floor_cache( z ) ) {
                 seen_cache_dirty = true;
             }
@@ -9655,7 +9995,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         // Vehicle cache clearing only — floor/outside/sheltered are already done above.
         if( parallel_enabled && parallel_map_cache ) {
             std::mutex dirty_mutex;
-            parallel_for( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1, [&]( int z ) {
+            parallel_for( "map_cache_levels", -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1, [&]( int z ) {
                 level_cache &ch = get_cache( z );
                 const bool vehicle_floor_was_dirty = level_has_vehicle_floor( ch );
                 // vehicle_floor_cache is written by vehicles one level below (via
@@ -9802,9 +10142,23 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     }
 #endif
     auto dirty_lightmap_levels = std::vector<int> {};
+    auto ambient_lightmap_levels = std::vector<int> {};
     if( !skip_lightmap ) {
         ZoneScopedN( "Phase4_lightmap_prepare" );
         invalidate_lightmap_caches_if_light_state_changed();
+        // Sunlight-only levels get their lights once seen or read.
+        auto lit_levels = zlevel_lighting_culling ? lighting_observed_levels( zlev ) :
+                          std::bitset<OVERMAP_LAYERS> {}.set();
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+            const auto i = static_cast<size_t>( z + OVERMAP_DEPTH );
+            if( ( *ambient_lightmap_reads_ )[i].exchange( false, std::memory_order_relaxed ) ) {
+                lit_levels.set( i );
+            }
+            auto &c = get_cache( z );
+            if( c.lightmap_ambient_only && lit_levels.test( i ) ) {
+                c.lightmap_dirty = true;
+            }
+        }
         auto needs_lightmap_dispatch = [this]( const int z ) {
             return get_cache( z ).lightmap_dirty;
         };
@@ -9817,7 +10171,14 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         std::ranges::sort( dirty_lightmap_levels );
         dirty_lightmap_levels.erase( std::ranges::unique( dirty_lightmap_levels ).begin(),
                                      dirty_lightmap_levels.end() );
+        const auto is_lit = [&]( const int z ) {
+            return lit_levels.test( static_cast<size_t>( z + OVERMAP_DEPTH ) );
+        };
+        std::ranges::remove_copy_if( dirty_lightmap_levels, std::back_inserter( ambient_lightmap_levels ),
+                                     is_lit );
+        std::erase_if( dirty_lightmap_levels, std::not_fn( is_lit ) );
         TracyPlot( "Map Dirty LM Levels", static_cast<int64_t>( dirty_lightmap_levels.size() ) );
+        TracyPlot( "Map Ambient LM Levels", static_cast<int64_t>( ambient_lightmap_levels.size() ) );
     }
 
 #if defined( CATA_SDL )
@@ -9839,7 +10200,11 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
             std::fill( c.light_source_color_buffer.begin(),
                        c.light_source_color_buffer.end(), 0u );
             c.light_source_points.clear();
-            std::ranges::fill( c.lm, 0.0f );
+            // The download overwrites lm of every dirty level; until then deferred
+            // readers see the previous lighting rather than darkness.
+            if( !defer_lighting_finish ) {
+                std::ranges::fill( c.lm, 0.0f );
+            }
             c.lm_cpu_cache_valid = false;
             ++c.lm_cpu_cache_generation;
         }
@@ -9889,6 +10254,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     seen_cache_dirty |= build_vision_transparency_cache( get_player_character() );
     if( seen_cache_dirty ) {
         skew_vision_cache.assign( vision_cache_slots, vision_cache_slot{} );
+        ++sight_generation_;
     }
     const auto need_seen_rebuild = seen_cache_dirty || force_seen_rebuild_for_gpu_residency ||
                                    m_last_seen_cache_origin != p;
@@ -9918,17 +10284,11 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
             if( gpu_device != nullptr ) {
                 if( !dirty_lightmap_levels.empty() ) {
                     ZoneScopedN( "Phase4_lightmap_finish" );
-                    const bool gpu_lighting_ok = cata_gpu::finish_gpu_lighting( gpu_device,
-                                                 pending_gpu_lighting );
-                    if( !gpu_lighting_ok ) {
-                        debugmsg( "SDL_GPU lighting completion failed; see debug.log for details" );
-                        return;
+                    deferred_gpu_lighting_id_ = pending_gpu_lighting.id;
+                    deferred_gpu_lighting_levels_ = std::move( dirty_lightmap_levels );
+                    if( !defer_lighting_finish ) {
+                        finish_deferred_lighting();
                     }
-
-                    std::ranges::for_each( dirty_lightmap_levels, [this]( int z ) {
-                        get_cache( z ).lightmap_dirty = false;
-                        mark_visibility_cache_dirty( z );
-                    } );
                 }
             } else if( !dirty_lightmap_levels.empty() ) {
                 debugmsg( "SDL_GPU lighting is required for lightmap rebuild, but no GPU device is available" );
@@ -9937,7 +10297,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
         } else
 #endif
         {
-            if( !dirty_lightmap_levels.empty() ) {
+            if( !dirty_lightmap_levels.empty() || !ambient_lightmap_levels.empty() ) {
                 auto colored_light_levels = std::vector<int> {};
                 std::ranges::copy( std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ),
                                    std::back_inserter( colored_light_levels ) );
@@ -9946,8 +10306,20 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
                     std::ranges::fill( c.colored_light_cache, 0u );
                     c.colored_light_cache_active = false;
                 }
+                // Sunlight only: build_sunlight_cache refills lm, nothing casts into sm.
+                for( const int z : ambient_lightmap_levels ) {
+                    auto &c = get_cache( z );
+                    std::ranges::fill( c.sm, 0.0f );
+                    std::ranges::fill( c.light_source_buffer, 0.0f );
+                    std::ranges::fill( c.colored_light_source_buffer, 0.0f );
+                    std::ranges::fill( c.light_source_color_buffer, 0u );
+                    c.light_source_points.clear();
+                    std::ranges::fill( c.lm, 0.0f );
+                }
 
-                if( dirty_lightmap_levels.size() > 1 && parallel_enabled && parallel_map_cache ) {
+                if( dirty_lightmap_levels.empty() ) {
+                    build_sunlight_cache( zlev );
+                } else if( dirty_lightmap_levels.size() > 1 && parallel_enabled && parallel_map_cache ) {
                     // Multiple dirty levels: hoist shared initialization outside the
                     // parallel loop so worker threads never race on cross-level writes.
                     //
@@ -9993,7 +10365,7 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
                     // Pre-warm the vehicle list cache serially to avoid heap corruption
                     // from concurrent writes to last_full_vehicle_list.
                     get_vehicles();
-                    parallel_for( 0, static_cast<int>( dirty_lightmap_levels.size() ), [&]( int i ) {
+                    parallel_for( "lightmap_levels", 0, static_cast<int>( dirty_lightmap_levels.size() ), [&]( int i ) {
                         generate_lightmap_worker( dirty_lightmap_levels[i] );
                     } );
                 } else {
@@ -10020,12 +10392,23 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
                 std::ranges::for_each( dirty_lightmap_levels, [this]( int z ) {
                     auto &c = get_cache( z );
                     c.lightmap_dirty = false;
+                    c.lightmap_ambient_only = false;
                     c.lm_cpu_cache_valid = true;
                     mark_visibility_cache_dirty( z );
                 } );
 
-            } // end if( !dirty_lightmap_levels.empty() )
+            } // end if( !dirty_lightmap_levels.empty() || !ambient_lightmap_levels.empty() )
         }
+        // These hold the sunlight from above, or on the GPU path the previous lighting, until
+        // they are seen or read.  The stale CPU flag sends their readers to the slow path.
+        std::ranges::for_each( ambient_lightmap_levels, [this]( int z ) {
+            auto &c = get_cache( z );
+            c.lightmap_dirty = false;
+            c.lightmap_ambient_only = true;
+            c.lm_cpu_cache_valid = false;
+            ++c.lm_cpu_cache_generation;
+            mark_visibility_cache_dirty( z );
+        } );
     }
 }
 
@@ -10293,25 +10676,24 @@ auto map::function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &en
     }
 }
 
-void map::scent_blockers( std::vector<char> &scent_transfer, int st_sy,
+void map::scent_blockers( std::vector<char> &scent_transfer, const cache_layout::grid_shape &shape,
                           const tripoint_bub_ms &min, const tripoint_bub_ms &max )
 {
-    if( st_sy <= 0 ) {
+    if( shape.sy <= 0 ) {
         return;
     }
-    const auto scent_cache_x = static_cast<int>( scent_transfer.size() / static_cast<size_t>( st_sy ) );
     const auto reduce = TFLAG_REDUCE_SCENT;
     const auto block = TFLAG_NO_SCENT;
     auto fill_values = [&]( const tripoint_bub_sm & gp, const submap * sm, point_sm_ms lp ) {
         // We need to generate the x/y coordinates, because we can't get them "for free"
         const auto p = project_combine( gp, lp );
         if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            scent_transfer[p.x() * st_sy + p.y()] = 0;
+            scent_transfer[cache_layout::index( p.x(), p.y(), shape )] = 0;
         } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
                    sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            scent_transfer[p.x() * st_sy + p.y()] = 1;
+            scent_transfer[cache_layout::index( p.x(), p.y(), shape )] = 1;
         } else {
-            scent_transfer[p.x() * st_sy + p.y()] = 5;
+            scent_transfer[cache_layout::index( p.x(), p.y(), shape )] = 5;
         }
 
         return ITER_CONTINUE;
@@ -10322,10 +10704,10 @@ void map::scent_blockers( std::vector<char> &scent_transfer, int st_sy,
     const inclusive_cuboid<tripoint_bub_ms> local_bounds( min, max );
     const auto mark_vehicle_obstruction = [&]( const tripoint_bub_ms & part_pos ) {
         if( !local_bounds.contains( part_pos ) || part_pos.x() < 0 || part_pos.y() < 0 ||
-            part_pos.x() >= scent_cache_x || part_pos.y() >= st_sy ) {
+            part_pos.x() >= shape.sx || part_pos.y() >= shape.sy ) {
             return;
         }
-        const auto index = static_cast<size_t>( part_pos.x() * st_sy + part_pos.y() );
+        const auto index = static_cast<size_t>( cache_layout::index( part_pos.x(), part_pos.y(), shape ) );
         if( scent_transfer[index] == 5 ) {
             scent_transfer[index] = 1;
         }
@@ -10488,17 +10870,19 @@ std::list<Creature *> map::get_creatures_in_radius( const tripoint_bub_ms &cente
 
 bool map::has_rope_at( tripoint_bub_ms pt ) const
 {
-    if( cached_veh_rope.contains( pt ) ) {
-        auto veh_pair = get_rope_at( pt );
-        vehicle *veh = veh_pair.first;
-        int veh_part = veh_pair.second;
+    const auto [veh, veh_part] = get_rope_at( pt );
+    if( veh != nullptr ) {
         return veh->part( veh_part ).info().ladder_length() >= veh->bub_ms_location().z() - pt.z();
     }
     return false;
 }
 std::pair<vehicle *, int> map::get_rope_at( const tripoint_bub_ms &pt ) const
 {
-    return cached_veh_rope.at( pt );
+    if( !inbounds( pt ) ) {
+        return { nullptr, -1 };
+    }
+    const level_cache &ch = get_cache_ref( pt.z() );
+    return ch.veh_rope.get( ch.idx( pt.x(), pt.y() ) );
 }
 
 level_cache &map::access_cache( int zlev )
@@ -10552,7 +10936,8 @@ level_cache::level_cache( int mx, int my )
       visibility_cache( static_cast<size_t>( mx * my ), lit_level::DARK ),
       colored_light_cache( static_cast<size_t>( mx * my ), 0u ),
       map_memory_seen_cache( static_cast<size_t>( mx * my ) ),
-      veh_exists_at( static_cast<size_t>( mx * my ), false ),
+      veh_parts( static_cast<size_t>( mx * my ) ),
+      veh_rope( static_cast<size_t>( mx * my ) ),
       absorption_cache( static_cast<size_t>( mx * my ), 0 ),
       sound_wall_cache( static_cast<size_t>( mx * my ), false )
 
@@ -10564,6 +10949,53 @@ level_cache::level_cache( int mx, int my )
     floor_cache_dirty.set();
 }
 
+auto level_cache::memory_usage() const -> std::size_t
+{
+    using memory_usage::capacity_bytes;
+    const auto bitset_bytes = []( const cata_dynamic_bitset & bits ) {
+        return ( bits.size() + 7 ) / 8;
+    };
+    const auto tiles = static_cast<std::size_t>( cache_x ) * cache_y;
+    return sizeof( level_cache ) +
+           bitset_bytes( transparency_cache_dirty ) + bitset_bytes( outside_cache_dirty ) +
+           bitset_bytes( floor_cache_dirty ) + bitset_bytes( absorption_cache_dirty ) +
+           bitset_bytes( sound_wall_cache_dirty ) + bitset_bytes( map_memory_seen_cache ) +
+           capacity_bytes( transparency_dirty_tiles ) + capacity_bytes( floor_dirty_tiles ) +
+           capacity_bytes( lm ) + capacity_bytes( sm ) + capacity_bytes( light_source_buffer ) +
+           capacity_bytes( colored_light_source_buffer ) + capacity_bytes( light_source_color_buffer ) +
+           capacity_bytes( light_source_points ) + capacity_bytes( vehicle_light_clusters ) +
+           capacity_bytes( outside_cache ) + capacity_bytes( sheltered_cache ) +
+           capacity_bytes( floor_cache ) + capacity_bytes( vehicle_floor_cache ) +
+           capacity_bytes( transparency_cache ) + capacity_bytes( vehicle_obscured_cache ) +
+           capacity_bytes( vehicle_obstructed_cache ) + capacity_bytes( seen_cache ) +
+           capacity_bytes( camera_cache ) + capacity_bytes( visibility_cache ) +
+           capacity_bytes( colored_light_cache ) +
+           capacity_bytes( map_memory_seen_cache_dirty_points ) + capacity_bytes( absorption_cache ) +
+           ( sound_wall_cache.capacity() + 7 ) / 8 +
+           // veh_parts and veh_rope keep one 32 bit entry per tile
+           2 * tiles * sizeof( std::uint32_t );
+}
+
+auto map::cache_memory_usage() const -> std::size_t
+{
+    auto bytes = std::size_t{ 0 };
+    for( const auto &cache : caches ) {
+        if( cache ) {
+            bytes += cache->memory_usage();
+        }
+    }
+    return bytes;
+}
+
+auto level_cache::fold_dirty_tiles( cata_dynamic_bitset &bits,
+                                    std::vector<point_bub_ms> &tiles ) const -> void
+{
+    for( const auto &p : tiles ) {
+        bits.set( static_cast<size_t>( bidx( p.x() / SEEX, p.y() / SEEY ) ) );
+    }
+    tiles.clear();
+}
+
 // Default constructor: zero-sized null sentinel — not for normal use.
 sound_instance_cache::sound_instance_cache() = default;
 
@@ -10590,6 +11022,15 @@ sound_instance_cache::sound_instance_cache( sound_event &input_sound,
 
 }
 
+auto sound_instance_cache::set_sound( const sound_event &other ) -> void
+{
+    sound = other;
+    movement_noise = other.movement_noise;
+    from_player = other.from_player;
+    from_monster = other.from_monster;
+    from_npc = other.from_npc;
+}
+
 sound_filter_key::sound_filter_key() = default;
 
 sound_cache::sound_cache() = default;
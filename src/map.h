@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <climits>
 #include "cata_dynamic_bitset.h"
@@ -24,6 +25,7 @@
 #include <vector>
 
 #include "bodypart.h"
+#include "cache_layout.h"
 #include "calendar.h"
 #include "coordinates.h"
 #include "dimension_info.h"
@@ -35,17 +37,21 @@
 #include "item_stack.h"
 #include "legacy_pathfinding.h"
 #include "lightmap.h"
+#include "lock_stats.h"
+#include "light_clusters.h"
 #include "line.h"
 #include "lru_cache.h"
 #include "mapbuffer.h"
 #include "mapdata.h"
 #include "mapgen_functions.h"
 #include "memory_fast.h"
+#include "point_light_layer.h"
 #include "shadowcasting.h"
 #include "submap_load_manager.h"
 #include "type_id.h"
 #include "units.h"
 #include "sounds.h"
+#include "vehicle_part_index.h"
 #include "vpart_position.h"
 
 
@@ -85,6 +91,7 @@ class tileray;
 class vpart_reference;
 struct mongroup;
 struct projectile;
+struct submap_item_plan;
 struct veh_collision;
 
 template<typename T>
@@ -344,11 +351,14 @@ struct level_cache {
     int cache_x = 0;
     int cache_y = 0;
     int cache_mapsize = 0;
-
-    /// Flat index for tile-coordinate arrays: vec[x * cache_y + y].
-    /// Uses the runtime cache_y stride (= SEEY * mapsize) so that all
-    /// vector accesses correctly reflect the actual loaded-area dimensions.
-    auto idx( int x, int y ) const -> int { return x * cache_y + y; }
+    // Ring origin of the tile arrays in submaps, moved by map::shift (tiled layout only).
+    point cache_origin = point_zero;
+
+    /// Dimensions and ring origin of the tile-coordinate arrays.  Pass it (never a bare
+    /// cache_y) to cache_layout and shadowcasting for anything indexed like these arrays.
+    auto shape() const -> cache_layout::grid_shape { return { cache_x, cache_y, cache_origin }; }
+    /// Flat index for tile-coordinate arrays, in the build's cache_layout order.
+    auto idx( int x, int y ) const -> int { return cache_layout::index( x, y, shape() ); }
     // Flat index for submap-coordinate bitsets: bitset[sx * cache_mapsize + sy]
     int bidx( int sx, int sy ) const {
         return sx * cache_mapsize + sy;
@@ -367,11 +377,22 @@ struct level_cache {
     // Should be set for a tile position if the tile in question changes significantly, or if a tile feature that affects sound propagation is added/removed.
     cata_dynamic_bitset absorption_cache_dirty;
     cata_dynamic_bitset sound_wall_cache_dirty;
+    // Single tiles to patch on the next transparency/floor build, in submaps whose bit
+    // above is clear.  Patching costs O(tiles) and only relights if a value changed.
+    std::vector<point_bub_ms> transparency_dirty_tiles;
+    std::vector<point_bub_ms> floor_dirty_tiles;
+    /// Moves @p tiles into whole-submap bits of @p bits, for paths that only rebuild submaps.
+    auto fold_dirty_tiles( cata_dynamic_bitset &bits, std::vector<point_bub_ms> &tiles ) const -> void;
+    /** Approximate bytes held by the cache arrays of this level. */
+    auto memory_usage() const -> std::size_t;
 
     bool seen_cache_dirty = false;
     // Set by map mutations and dynamic light-state changes; cleared after
     // generate_lightmap completes for this level.
     bool lightmap_dirty = true;
+    // True while lm only holds sunlight because nobody could see the level when it was
+    // last lit; see map::lighting_observed_levels().
+    bool lightmap_ambient_only = false;
     // True when CPU lm contains current lighting for the whole level. SDL GPU
     // lighting may keep resident GPU lm current while leaving this false.
     bool lm_cpu_cache_valid = false;
@@ -382,12 +403,14 @@ struct level_cache {
     bool visibility_cache_dirty = true;
     // Set by build_floor_cache; true when at least one tile has a floor.
     bool has_any_floor = true;
+    // Set by build_floor_cache; true when at least one tile has no floor.
+    bool has_floor_gap = true;
     bool suspension_cache_initialized = false;
     bool suspension_cache_dirty = false;
     std::list<point_abs_ms> suspension_cache;
 
     // ---- 12 tile-coordinate arrays (size: cache_x * cache_y) ----
-    // All indexed as: vec[x * cache_y + y]  (X-outer layout, matching old C-array [MAPSIZE_X][MAPSIZE_Y])
+    // All indexed through idx(); see cache_layout.h for the element order.
     std::vector<float>              lm;
     std::vector<float>              sm;
     // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
@@ -397,6 +420,10 @@ struct level_cache {
     std::vector<uint32_t>           light_source_color_buffer;
     // Source tiles touched in light_source_buffer.
     std::vector<point_bub_ms>        light_source_points;
+    // What last turn's uncoloured point lights cast, updated in place by apply_point_lights.
+    point_light_layer               point_lights;
+    // Vehicle lights as last cast, after merging; drawn by the lighting debug overlay.
+    std::vector<light_clusters::cluster> vehicle_light_clusters;
 
     // True when the tile has sky access via the 3×3 overhang rule (top-down floor cascade).
     // False means fully enclosed — protected from rain, wind, weather effects.
@@ -450,8 +477,10 @@ struct level_cache {
     bool                            map_memory_seen_cache_dirty_all = true;
 
     bool veh_in_active_range = false;
-    std::vector<bool>               veh_exists_at;
-    std::map<tripoint_bub_ms, std::pair<vehicle *, int>> veh_cached_parts;
+    // vehicle part on each tile, indexed by idx()
+    vehicle_part_index              veh_parts;
+    // ladder or rope part hanging over each tile, indexed by idx()
+    vehicle_part_index              veh_rope;
     std::set<vehicle *> vehicle_list;
     std::set<vehicle *> zone_vehicles;
 
@@ -479,6 +508,11 @@ struct sound_instance_cache {
                                    const int &f_r );
     sound_instance_cache( const sound_instance_cache &other ) = default;
     sound_instance_cache &operator=( const sound_instance_cache &other ) = default;
+    sound_instance_cache( sound_instance_cache &&other ) = default;
+    sound_instance_cache &operator=( sound_instance_cache &&other ) = default;
+
+    // Hands this flood to another sound with the same origin and volume.
+    auto set_sound( const sound_event &other ) -> void;
 
     // The originating sound, includes volume @1m, tripoint, description, type,
     // etc.
@@ -971,7 +1005,7 @@ class map : public submap_load_listener
          * Internal versions of public functions to avoid checking same variables multiple times.
          * They lack safety checks, because their callers already do those.
          */
-        int move_cost_internal( const furn_t &furniture, const ter_t &terrain,
+        int move_cost_internal( const furn_id &furniture, const ter_id &terrain,
                                 const vehicle *veh, int vpart ) const;
         bool impassable( const tripoint_bub_ms &p ) const;
         bool passable( const tripoint_bub_ms &p ) const;
@@ -1013,6 +1047,20 @@ class map : public submap_load_listener
         * Returns whether `F` sees `T` with a view range of `range`.
         */
         bool sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, int range ) const;
+        /**
+         * Moves whenever an answer of sees() may have changed without either end moving,
+         * for callers that remember answers (see sight_memo).
+         */
+        auto sight_generation() const -> uint64_t {
+            return sight_generation_;
+        }
+        /**
+         * Casts the same-level field of view of every observer in one batch (see
+         * cast_fov_batch) and hands it to its sight memo, so that sees() checks against
+         * many targets this turn cost a bit test each.  Observers whose memo still holds
+         * a whole field of view for their tile are skipped.
+         */
+        void remember_fields_of_view( std::span<const Creature *const> observers ) const;
     private:
         /**
          * Don't expose the slope adjust outside map functions.
@@ -1326,8 +1374,8 @@ class map : public submap_load_listener
         /** Returns a success rating from -1 to 10 for a given tile based on a set strength, used for AI movement planning
         *  Values roughly correspond to 10% increment chances of success on a given bash, rounded down. -1 means the square is not bashable */
         int bash_rating( int str, const tripoint_bub_ms &p, bool allow_floor = false ) const;
-        int bash_rating_internal( int str, const furn_t &furniture,
-                                  const ter_t &terrain, bool allow_floor,
+        int bash_rating_internal( int str, const furn_id &furniture,
+                                  const ter_id &terrain, bool allow_floor,
                                   const vehicle *veh, int part ) const;
 
 
@@ -1786,6 +1834,11 @@ class map : public submap_load_listener
          * @return false there's no fields at `p`
          */
         bool has_field_at( const tripoint_bub_ms &p, bool check_bounds = true );
+        /**
+         * @return false if no field at `p` can affect a creature standing there,
+         * true if one might
+         */
+        bool has_creature_field_at( const tripoint_bub_ms &p );
         /**
          * Get field of specific type at point.
          * @return NULL if there is no such field entry at that place.
@@ -1826,7 +1879,7 @@ class map : public submap_load_listener
          * Build the map of scent-resistant tiles.
          * Should be way faster than if done in `game.cpp` using public map functions.
          */
-        void scent_blockers( std::vector<char> &scent_transfer, int st_sy,
+        void scent_blockers( std::vector<char> &scent_transfer, const cache_layout::grid_shape &shape,
                              const tripoint_bub_ms &min, const tripoint_bub_ms &max );
 
         // Computers
@@ -1908,10 +1961,24 @@ class map : public submap_load_listener
                         const std::string &name = "NONE" ) const;
         void do_vehicle_caching( int z );
         // Note: in 3D mode, will actually build caches on ALL z-levels
-        void build_map_cache( int zlev, bool skip_lightmap = false );
+        // With @p defer_lighting_finish, GPU lighting is left running for
+        // finish_deferred_lighting; lm keeps the previous lighting until then.
+        void build_map_cache( int zlev, bool skip_lightmap = false,
+                              bool defer_lighting_finish = false );
+        // Waits for and unpacks GPU lighting that build_map_cache left in flight, if any.
+        // Called by the first readers of this turn's lighting: the next cache build,
+        // visibility and map shifts.
+        void finish_deferred_lighting();
+        // Lowest and highest z-level the view from @p origin_z can reach: it stops at the
+        // first level boundary with a floor on every tile.
+        auto zlevel_sight_span( int origin_z ) const -> std::pair<int, int>;
+        // Z-levels build_map_cache casts lights on, indexed by z + OVERMAP_DEPTH: what the
+        // avatar or the look-around view can see.  The rest keep sunlight only until they
+        // are seen, or until light_at or ambient_light_at read them.
+        auto lighting_observed_levels( int zlev ) const -> std::bitset<OVERMAP_LAYERS>;
         // Unlike the other caches, this populates a supplied cache instead of an internal cache.
         void build_obstacle_cache( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
-                                   float *obstacle_cache, int cache_sy );
+                                   float *obstacle_cache, const cache_layout::grid_shape &shape );
 
         vehicle *add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
                               const tripoint_bub_ms &p,
@@ -2129,6 +2196,8 @@ class map : public submap_load_listener
         void generate_lightmap( int zlev );
         void generate_lightmap_worker( int zlev );
         void flush_lightmap_cpu_read_counters() const;
+        // Asks the next build_map_cache to cast the lights of a sunlight-only level.
+        void note_ambient_lightmap_read( const level_cache &map_cache, int z ) const;
         void build_seen_cache( const tripoint_bub_ms &origin, int target_z );
         auto vision_transparency_block_mask() const -> uint32_t;
         // Applies vehicle mirror/camera FOV from @p origin's vehicle.
@@ -2179,6 +2248,11 @@ class map : public submap_load_listener
         // Reset to tripoint_min by invalidate_map_cache so any full-cache invalidation
         // forces a seen_cache rebuild regardless of whether the player moved.
         tripoint_bub_ms m_last_seen_cache_origin = tripoint_bub_ms( tripoint_min );
+        // GPU lighting submitted by build_map_cache and not finished yet, and its levels.
+        uint64_t deferred_gpu_lighting_id_ = 0;
+        std::vector<int> deferred_gpu_lighting_levels_;
+        // Set by reads of a sunlight-only lightmap, so the next build lights that level.
+        std::unique_ptr<std::array<std::atomic<bool>, OVERMAP_LAYERS>> ambient_lightmap_reads_;
         bool visibility_caches_dirty_ = true;
         std::size_t m_last_lightmap_source_signature = 0;
         bool m_last_lightmap_source_signature_valid = false;
@@ -2282,6 +2356,10 @@ class map : public submap_load_listener
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint_bub_ms &p, float luminance, uint32_t color_rgb = 0u );
+        // apply_light_source for many uncoloured sources on @p zlev at once.  Only what changed
+        // since the last call on that level is cast again (see point_light_layer), on the thread
+        // pool when there is enough of it; the result is the same as applying them one by one.
+        void apply_point_lights( int zlev, const std::vector<std::pair<point_bub_ms, float>> &lights );
         // Handle just cardinal directions and 45 deg angles.
         void apply_directional_light( const tripoint_bub_ms &p, int direction, float luminance );
         auto apply_directional_light( const apply_directional_light_options &opt ) -> void;
@@ -2314,8 +2392,8 @@ class map : public submap_load_listener
         void process_items();
     private:
         // Iterates over every item on the map, passing each item to the provided function.
-        auto process_items_in_submap( submap &current_submap, const tripoint_bub_sm &gridp,
-                                      std::vector<item *> &active_items ) -> void;
+        auto plan_items_in_submap( submap_item_plan &plan ) const -> void;
+        auto process_items_in_submap( submap_item_plan &plan ) -> void;
         void process_items_in_vehicles( submap &current_submap );
         void process_items_in_vehicle( vehicle &cur_veh, submap &current_submap );
 
@@ -2371,14 +2449,18 @@ class map : public submap_load_listener
         // shared_mutex allows concurrent cache reads (common case)
         // while still serialising inserts.  Use shared_lock for reads and
         // unique_lock for writes in map::sees().
-        mutable std::unique_ptr<std::shared_mutex> skew_vision_cache_mutex;
+        // Counted, but not shown to Tracy, which can't wrap a mutex made by make_unique.
+        using skew_vision_mutex_type =
+            lock_stats::counted<std::shared_mutex, "map::skew_vision_cache_mutex">;
+        mutable std::unique_ptr<skew_vision_mutex_type> skew_vision_cache_mutex;
+        // Bumped together with clearing skew_vision_cache.
+        uint64_t sight_generation_ = 0;
 
         /**
          * Vehicle list doesn't change often, but is pretty expensive.
          */
         VehicleList last_full_vehicle_list;
         bool last_full_vehicle_list_dirty = true;
-        std::map<tripoint_bub_ms, std::pair<vehicle *, int> > cached_veh_rope;
 
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
@@ -2403,6 +2485,8 @@ class map : public submap_load_listener
         const level_cache &get_cache_ref( int zlev ) const {
             return *caches[zlev + OVERMAP_DEPTH];
         }
+        /** Approximate bytes held by the level caches of every z-level. */
+        auto cache_memory_usage() const -> std::size_t;
 
         /**
         * Holds the individual caches for sounds. Each individual cache has a std::vector<short> that stores mdB spl volumes for the flooded area, a sound_event, and some filtering bools.
@@ -2955,24 +2955,21 @@ void apply_function( const string_id<map_extra> &id, mapgen_constructor &m,
     bool applied_successfully = false;
 
     const map_extra &extra = id.obj();
+    overmapbuffer &omap = get_overmapbuffer( m.get_bound_dimension() );
     switch( extra.generator_method ) {
         case map_extra_method::map_extra_function: {
-            const map_extra_pointer mx_func = get_function( extra.generator_id );
-            if( mx_func != nullptr ) {
-                applied_successfully = mx_func( m, abs_omt );
+            if( extra.function != nullptr ) {
+                applied_successfully = extra.function( m, abs_omt );
             }
             break;
         }
         case map_extra_method::mapgen: {
-            mapgendata dat( abs_omt, m, 0.0f, calendar::turn,
-                            nullptr, get_overmapbuffer( m.get_bound_dimension() ) );
+            mapgendata dat( abs_omt, m, 0.0f, calendar::turn, nullptr, omap );
             applied_successfully = run_mapgen_func( extra.generator_id, dat );
             break;
         }
         case map_extra_method::update_mapgen: {
-            mapgendata dat( abs_omt, m, 0.0f,
-                            calendar::start_of_cataclysm, nullptr,
-                            get_overmapbuffer( m.get_bound_dimension() ) );
+            mapgendata dat( abs_omt, m, 0.0f, calendar::start_of_cataclysm, nullptr, omap );
             applied_successfully = run_mapgen_update_func( extra.generator_id, dat );
             break;
         }
@@ -2985,7 +2982,6 @@ void apply_function( const string_id<map_extra> &id, mapgen_constructor &m,
         return;
     }
 
-    overmapbuffer &omap = get_overmapbuffer( m.get_bound_dimension() );
     omap.add_extra( abs_omt, id );
 
     // auto_note_settings (unordered_sets) is not thread-safe, so autonote
@@ -3105,6 +3101,13 @@ void map_extra::load( const JsonObject &jo, const std::string & )
                            map_extra_method::null );
         mandatory( jg, was_loaded, "generator_id", generator_id );
     }
+    function = nullptr;
+    if( generator_method == map_extra_method::map_extra_function ) {
+        const auto iter = MapExtras::builtin_functions.find( generator_id );
+        if( iter != MapExtras::builtin_functions.end() ) {
+            function = iter->second;
+        }
+    }
     optional( jo, was_loaded, "sym", symbol, unicode_codepoint_from_symbol_reader, NULL_UNICODE );
     color = jo.has_member( "color" ) ? color_from_string( jo.get_string( "color" ) ) : c_white;
     optional( jo, was_loaded, "looks_like", looks_like );
@@ -3121,8 +3124,7 @@ void map_extra::check() const
     }
     switch( generator_method ) {
         case map_extra_method::map_extra_function: {
-            const map_extra_pointer mx_func = MapExtras::get_function( generator_id );
-            if( mx_func == nullptr ) {
+            if( function == nullptr ) {
                 debugmsg( "invalid map extra function (%s) defined for map extra (%s)", generator_id, id.str() );
                 break;
             }
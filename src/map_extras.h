@@ -42,6 +42,8 @@ class map_extra
         uint32_t symbol = UTF8_getch( "X" );
         nc_color color = c_red;
         std::optional<std::string> looks_like;
+        /** Builtin function named by @ref generator_id, resolved on load rather than per OMT. */
+        map_extra_pointer function = nullptr;
 
         std::string get_symbol() const {
             return utf32_to_utf8( symbol );
@@ -1,7 +1,6 @@
 #include <algorithm>
 #include <array>
 #include <ranges>
-#include <bitset>
 #include <cstddef>
 #include <list>
 #include <memory>
@@ -56,6 +55,7 @@
 #include "string_id.h"
 #include "submap.h"
 #include "teleport.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
@@ -529,6 +529,11 @@ void map::player_in_field( player &u )
 
 void map::creature_in_field( Creature &critter )
 {
+    // Most creatures stand where no field, or only blood and the like, is: skip the
+    // vehicle lookups below.
+    if( !has_creature_field_at( critter.bub_pos() ) ) {
+        return;
+    }
     bool in_vehicle = false;
     bool inside_vehicle = false;
     player *u = critter.as_player();
@@ -1000,8 +1005,22 @@ struct SubTile {
 struct field_cache_dirty_context {
     map &here;
     dimension_id const &dimension;
+    /// When set, invalidations are queued here instead of touching the map caches,
+    /// which are not safe to write from worker threads.
+    std::vector<tripoint_bub_ms> *deferred = nullptr;
 };
 
+auto mark_tile_cache_dirty( field_cache_dirty_context const &ctx,
+                            const tripoint_bub_ms &bub_pos ) -> void
+{
+    if( ctx.deferred != nullptr ) {
+        ctx.deferred->push_back( bub_pos );
+        return;
+    }
+    ctx.here.set_transparency_cache_dirty( bub_pos );
+    ctx.here.set_seen_cache_dirty( bub_pos );
+}
+
 auto mark_field_cache_dirty( field_cache_dirty_context const &ctx,
                              const tripoint_abs_sm &abs_sm,
                              const field_type_id &type ) -> void
@@ -1016,9 +1035,7 @@ auto mark_field_cache_dirty( field_cache_dirty_context const &ctx,
     if( !submap_loader.is_properly_requested( ctx.dimension, abs_sm ) ) {
         return;
     }
-    const auto bub_pos = abs_to_bub( project_to<coords::ms>( abs_sm ) );
-    ctx.here.set_transparency_cache_dirty( bub_pos );
-    ctx.here.set_seen_cache_dirty( bub_pos );
+    mark_tile_cache_dirty( ctx, abs_to_bub( project_to<coords::ms>( abs_sm ) ) );
 }
 
 // Resolve `local + delta` crossing submap boundaries via mapbuffer.
@@ -1050,8 +1067,7 @@ auto sub_add_field( SubTile &dst, field_type_id type, int intensity,
         return nullptr;
     }
     if( dst.get_field().add_field( type, intensity, age ) ) {
-        ++dst.sm->field_count;
-        dst.sm->field_cache.push_back( dst.local );
+        dst.sm->note_field_added( dst.local, type );
         dst.sm->is_uniform = false;
     }
     return dst.get_field().find_field( type );
@@ -1108,8 +1124,7 @@ auto gas_spread_sub( field_cache_dirty_context const &dirty, field_entry &cur,
         cur.set_field_age( age - age_frac );
         mark_field_cache_dirty( dirty, dst.abs_sm, type );
     } else if( dst.get_field().add_field( type, 1, 0_turns ) ) {
-        ++dst.sm->field_count;
-        dst.sm->field_cache.push_back( dst.local );
+        dst.sm->note_field_added( dst.local, type );
         dst.sm->is_uniform = false;
         f = dst.get_field().find_field( type );
         if( f ) {
@@ -1130,9 +1145,9 @@ static const std::array<point, 8> eight_dirs_sm = {{
     }
 };
 
-auto process_fields_in_submap( const dimension_id &dim, submap &sm,
-                               const tripoint_abs_sm &pos,
-                               mapbuffer &mb ) -> bool
+static auto process_submap_fields( const dimension_id &dim, submap &sm,
+                                   const tripoint_abs_sm &pos, mapbuffer &mb,
+                                   std::vector<tripoint_bub_ms> *deferred_dirty ) -> bool
 {
     ZoneScopedN( "process_fields_in_submap" );
     if( sm.field_count == 0 ) {
@@ -1141,7 +1156,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
 
     map &map = get_map();
     const auto in_bubble = submap_loader.is_properly_requested( dim, pos );
-    const auto dirty_context = field_cache_dirty_context{ map, dim };
+    const auto dirty_context = field_cache_dirty_context{ map, dim, deferred_dirty };
 
     auto has_fire = false;
     // Snapshot before iterating: wandering-field spread can push_back to sm.field_cache
@@ -1173,8 +1188,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                 }
                 curfield.remove_field( it++ );
                 if( in_bubble && dirty_transparency_cache ) {
-                    map.set_transparency_cache_dirty( abs_to_bub( project_to<coords::ms>( pos ) ) );
-                    map.set_seen_cache_dirty( abs_to_bub( project_to<coords::ms>( pos ) ) );
+                    mark_tile_cache_dirty( dirty_context, abs_to_bub( project_to<coords::ms>( pos ) ) );
                 }
                 continue;
             }
@@ -1316,8 +1330,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                             if( fire_above ) {
                                 fire_above->mod_field_age( -2_turns );
                             } else if( above_sm->get_field( local ).add_field( fd_fire, 1, 0_turns ) ) {
-                                ++above_sm->field_count;
-                                above_sm->field_cache.push_back( local );
+                                above_sm->note_field_added( local, fd_fire );
                                 above_sm->is_uniform = false;
                             }
                         }
@@ -1440,8 +1453,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                         auto *fire_below = below_sm->get_field( local ).find_field( fd_fire );
                         if( !fire_below ) {
                             if( below_sm->get_field( local ).add_field( fd_fire, 1, 0_turns ) ) {
-                                ++below_sm->field_count;
-                                below_sm->field_cache.push_back( local );
+                                below_sm->note_field_added( local, fd_fire );
                                 below_sm->is_uniform = false;
                             }
                             cur.set_field_intensity( cur.get_field_intensity() - 1 );
@@ -1741,8 +1753,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                         if( dst.valid() && !dst.get_field().find_field( fd_bees ) ) {
                             if( dst.get_field().add_field( fd_bees, cur.get_field_intensity(),
                                                            cur.get_field_age() ) ) {
-                                ++dst.sm->field_count;
-                                dst.sm->field_cache.push_back( dst.local );
+                                dst.sm->note_field_added( dst.local, fd_bees );
                                 dst.sm->is_uniform = false;
                             }
                             cur.set_field_intensity( 0 );
@@ -1775,8 +1786,7 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                                 wfld->set_field_intensity( wfld->get_field_intensity() + 1 );
                             }
                         } else if( sm.get_field( wlocal ).add_field( wtype, wintens, 0_turns ) ) {
-                            ++sm.field_count;
-                            sm.field_cache.push_back( wlocal );
+                            sm.note_field_added( wlocal, wtype );
                         }
                     }
                 }
@@ -1804,40 +1814,90 @@ auto process_fields_in_submap( const dimension_id &dim, submap &sm,
             }
 
             if( in_bubble && dirty_transparency_cache ) {
-                map.set_transparency_cache_dirty( abs_to_bub( project_to<coords::ms>( pos ) ) );
-                map.set_seen_cache_dirty( abs_to_bub( project_to<coords::ms>( pos ) ) );
+                mark_tile_cache_dirty( dirty_context, abs_to_bub( project_to<coords::ms>( pos ) ) );
             }
 
         } // end field-entry loop
     } );
 
-    // Compact + deduplicate the field_cache in one O(n) pass.
-    //
-    // Two failure modes fixed here:
-    //   1. Dead entries: a position is pushed when a field is first created, but
-    //      never removed when it dies.  The cache grows each creation/death cycle.
-    //   2. Duplicate live entries: when a bolt or spread effect adds a second field
-    //      type to a tile already in the cache, add_field() returns true (new type),
-    //      so the same position is pushed again.  The shock_vent state machine then
-    //      runs N times per tick instead of once, flooding the room with electricity.
-    //
-    // The bitset tracks which of the 144 submap tiles have already been kept so
-    // duplicates are discarded in the same pass that removes dead entries.
-    std::bitset<SEEX *SEEY> seen;
-    sm.field_cache.erase(
-    std::ranges::remove_if( sm.field_cache, [&]( const point_sm_ms & local ) {
-        if( !sm.get_field( local ).displayed_field_type() ) {
-            return true;
-        }
-        const auto idx = static_cast<std::size_t>( local.x() + local.y() * SEEX );
-        if( seen.test( idx ) ) {
-            return true;
-        }
-        seen.set( idx );
-        return false;
-    } ).begin(),
-    sm.field_cache.end()
-    );
+    sm.compact_field_cache();
 
     return has_fire;
 }
+
+auto process_fields_in_submap( const dimension_id &dim, submap &sm,
+                               const tripoint_abs_sm &pos,
+                               mapbuffer &mb ) -> bool
+{
+    return process_submap_fields( dim, sm, pos, mb, nullptr );
+}
+
+auto process_fields_in_submaps( const dimension_id &dim,
+                                const std::vector<tripoint_abs_sm> &positions,
+                                mapbuffer &mb, bool parallel,
+                                std::vector<tripoint_bub_ms> *deferred_dirty )
+-> std::vector<tripoint_abs_sm>
+{
+    ZoneScopedN( "process_fields_in_submaps" );
+    struct job {
+        tripoint_abs_sm pos;
+        submap *sm = nullptr;
+        bool has_fire = false;
+        std::vector<tripoint_bub_ms> dirty;
+    };
+
+    // Field effects reach at most one submap in any direction.  Submaps whose
+    // coordinates agree modulo 3 on every axis are at least 3 apart on one of
+    // them, so their 3x3x3 neighbourhoods never overlap and a whole class can
+    // run at once.
+    constexpr auto num_classes = 27;
+    const auto class_of = []( const tripoint_abs_sm & p ) {
+        const auto m3 = []( const int v ) {
+            return ( ( v % 3 ) + 3 ) % 3;
+        };
+        return m3( p.x() ) + 3 * m3( p.y() ) + 9 * m3( p.z() );
+    };
+    auto classes = std::array<std::vector<job>, num_classes> {};
+    std::ranges::for_each( positions, [&]( const tripoint_abs_sm & p ) {
+        auto *const sm = mb.lookup_submap_in_memory( p );
+        if( sm != nullptr && sm->field_count > 0 ) {
+            classes[class_of( p )].push_back( job{ .pos = p, .sm = sm, .has_fire = false, .dirty = {} } );
+        }
+    } );
+
+    // Each submap rolls from its own stream, so results do not depend on
+    // which thread runs it or in what order within a class.
+    const auto seed = g->get_seed();
+    const auto run = [&]( job & j ) {
+        auto stream = rng_stream( seed, rng_stream_key( project_to<coords::ms>( j.pos ) ),
+                                  calendar::turn, 0xf1e1d );
+        const auto stream_scope = rng_stream_scope( stream );
+        j.has_fire = process_submap_fields( dim, *j.sm, j.pos, mb, &j.dirty );
+    };
+
+    auto &here = get_map();
+    auto fire_positions = std::vector<tripoint_abs_sm> {};
+    std::ranges::for_each( classes, [&]( std::vector<job> &jobs ) {
+        if( parallel ) {
+            parallel_for( "process_fields", 0, static_cast<int>( jobs.size() ), [&]( const int i ) {
+                run( jobs[i] );
+            } );
+        } else {
+            std::ranges::for_each( jobs, run );
+        }
+        std::ranges::for_each( jobs, [&]( const job & j ) {
+            if( deferred_dirty != nullptr ) {
+                deferred_dirty->insert( deferred_dirty->end(), j.dirty.begin(), j.dirty.end() );
+            } else {
+                std::ranges::for_each( j.dirty, [&here]( const tripoint_bub_ms & p ) {
+                    here.set_transparency_cache_dirty( p );
+                    here.set_seen_cache_dirty( p );
+                } );
+            }
+            if( j.has_fire ) {
+                fire_positions.push_back( j.pos );
+            }
+        } );
+    } );
+    return fire_positions;
+}
@@ -1,5 +1,7 @@
 #include "map_memory.h"
 
+#include <map>
+
 #include "cuboid_rectangle.h"
 #include "debug.h"
 #include "filesystem.h"
@@ -10,13 +12,39 @@
 #include "translations.h"
 #include "map.h"
 #include "world.h"
-const memorized_terrain_tile mm_submap::default_tile { "", 0, 0 };
+const memorized_terrain_tile mm_submap::default_tile {
+    memorized_tile_names::get().name( memorized_tile_names::none ), 0, 0
+};
 const int mm_submap::default_symbol = 0;
 
 // MM_SIZE = g_mapsize * 2 (runtime; used inline where needed)
 
 #define dbg(x) DebugLog((x),DC::MapMem)
 
+memorized_tile_names &memorized_tile_names::get()
+{
+    static memorized_tile_names instance;
+    return instance;
+}
+
+memorized_tile_names::memorized_tile_names()
+{
+    intern( std::string() );
+}
+
+memorized_tile_names::id memorized_tile_names::intern( const std::string &name )
+{
+    const auto it = ids.find( name );
+    if( it != ids.end() ) {
+        return it->second;
+    }
+    const id ret = static_cast<id>( names.size() );
+    // deque keeps the strings in place, so the views used as keys stay valid
+    const std::string &stored = names.emplace_back( name );
+    ids.emplace( stored, ret );
+    return ret;
+}
+
 mm_submap::mm_submap() = default;
 
 mm_region::mm_region() : submaps {{ nullptr }} {}
@@ -38,7 +66,7 @@ map_memory::map_memory()
     clear_cache();
 }
 
-const memorized_terrain_tile &map_memory::get_tile( const tripoint_abs_ms &pos )
+memorized_terrain_tile map_memory::get_tile( const tripoint_abs_ms &pos )
 {
     const auto p = project_remain<coords::sm>( pos );
     const mm_submap &sm = get_submap( p.quotient_tripoint );
@@ -199,7 +227,7 @@ static void temp_remove_open_air( const shared_ptr_fast<mm_submap> &sm )
         return;
     }
     for( const auto sm_ms : submap_tiles() ) {
-        const memorized_terrain_tile &t = sm->tile( sm_ms );
+        const memorized_terrain_tile t = sm->tile( sm_ms );
 
         if( !t.tile.empty() && ( t.tile == "t_open_air" || t.tile == "t_open_air_rooved" ||
                                  t.tile == "t_open_air_rooved_outside" ) ) {
@@ -296,6 +324,7 @@ bool map_memory::save( const tripoint_abs_ms &pos )
     // we are certain that each region will be filled.
     std::map<tripoint_abs_mmr, mm_region> regions;
     for( auto &it : submaps ) {
+        it.second->compact();
         const auto reg = project_to<coords::mmr>( it.first );
         const auto within_reg = project_remain<coords::mmr>( it.first ).remainder;
         regions[reg].submaps[within_reg.x()][within_reg.y()] = it.second;
@@ -364,3 +393,16 @@ void map_memory::clear_cache()
     cache_pos = tripoint_abs_sm::zero();
     cache_size = point_rel_sm::zero();
 }
+
+auto map_memory::memory_usage() const -> std::size_t
+{
+    auto bytes = cached.capacity() * sizeof( shared_ptr_fast<mm_submap> );
+    for( const auto &entry : submaps ) {
+        // The hash node and the key next to it
+        bytes += sizeof( entry ) + sizeof( void * );
+        if( entry.second ) {
+            bytes += sizeof( mm_submap ) + entry.second->heap_bytes();
+        }
+    }
+    return bytes;
+}
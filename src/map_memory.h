@@ -1,7 +1,13 @@
 #pragma once
 
-#include <map>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 #include "game_constants.h"
 #include "memory_fast.h"
@@ -10,8 +16,44 @@
 class JsonOut;
 class JsonIn;
 
+/**
+ * Interns the tile ids map memory stores, so each memorized tile holds an index
+ * instead of its own copy of the name.  Names are never removed, which keeps
+ * references to them valid for the rest of the process.
+ */
+class memorized_tile_names
+{
+    public:
+        using id = uint32_t;
+        /** Id of the empty name, which means "nothing memorized". */
+        static constexpr id none = 0;
+
+        static memorized_tile_names &get();
+
+        id intern( const std::string &name );
+        const std::string &name( id i ) const {
+            return names[i];
+        }
+
+    private:
+        memorized_tile_names();
+
+        std::deque<std::string> names;
+        std::unordered_map<std::string_view, id> ids;
+};
+
+/** A memorized tile as stored: an interned name and packed subtile and rotation. */
+struct mm_tile {
+    memorized_tile_names::id name = memorized_tile_names::none;
+    int16_t subtile = 0;
+    int16_t rotation = 0;
+
+    bool operator==( const mm_tile &rhs ) const = default;
+};
+
+/** A memorized tile as handed out; @ref tile is owned by @ref memorized_tile_names. */
 struct memorized_terrain_tile {
-    std::string tile;
+    const std::string &tile;
     int subtile;
     int rotation;
 
@@ -24,6 +66,57 @@ struct memorized_terrain_tile {
     }
 };
 
+/**
+ * One value per tile of a submap. Stored as a single value while every tile holds
+ * the same one, which is the case for most of what is ever memorized.
+ */
+template<typename T>
+class mm_layer
+{
+    public:
+        explicit mm_layer( const T &fill ) : fill( fill ) {}
+
+        const T &get( const point_sm_ms &p ) const {
+            return cells.empty() ? fill : cells[p.y() * SEEX + p.x()];
+        }
+
+        void set( const point_sm_ms &p, const T &value ) {
+            if( cells.empty() ) {
+                if( value == fill ) {
+                    return;
+                }
+                // call 'reserve' first to force allocation of exact size
+                cells.reserve( SEEX * SEEY );
+                cells.resize( SEEX * SEEY, fill );
+            }
+            cells[p.y() * SEEX + p.x()] = value;
+        }
+
+        /** Whether every tile holds @p value. */
+        bool is_uniform( const T &value ) const {
+            return cells.empty() && fill == value;
+        }
+
+        auto heap_bytes() const -> std::size_t {
+            return cells.capacity() * sizeof( T );
+        }
+
+        /** Drops the per tile storage if every tile holds the same value. */
+        void compact() {
+            const auto same_as_first = [&]( const T & c ) {
+                return c == cells.front();
+            };
+            if( !cells.empty() && std::ranges::all_of( cells, same_as_first ) ) {
+                fill = cells.front();
+                std::vector<T>().swap( cells );
+            }
+        }
+
+    private:
+        T fill;
+        std::vector<T> cells; // holds either 0 or SEEX*SEEY elements
+};
+
 /** Represent a submap-sized chunk of tile memory. */
 struct mm_submap {
     public:
@@ -35,68 +128,65 @@ struct mm_submap {
 
         /** Whether this mm_submap is empty. Empty submaps are skipped during saving. */
         bool is_empty() const {
-            return tiles.empty() && symbols.empty() && terrain_tiles.empty();
+            return tiles.is_uniform( mm_tile() ) && symbols.is_uniform( default_symbol ) &&
+                   terrain_tiles.is_uniform( mm_tile() );
         }
 
-        const memorized_terrain_tile &tile( const point_sm_ms &p ) const {
-            if( tiles.empty() ) {
-                return default_tile;
-            } else {
-                return tiles[p.y() * SEEX + p.x()];
-            }
+        memorized_terrain_tile tile( const point_sm_ms &p ) const {
+            return unpack( tiles.get( p ) );
         }
 
         void set_tile( const point_sm_ms &p, const memorized_terrain_tile &value ) {
-            if( tiles.empty() ) {
-                // call 'reserve' first to force allocation of exact size
-                tiles.reserve( SEEX * SEEY );
-                tiles.resize( SEEX * SEEY, default_tile );
-            }
-            tiles[p.y() * SEEX + p.x()] = value;
+            tiles.set( p, pack( value ) );
         }
 
-        const memorized_terrain_tile &terrain_tile( const point_sm_ms &p ) const {
-            if( terrain_tiles.empty() ) {
-                return default_tile;
-            } else {
-                return terrain_tiles[p.y() * SEEX + p.x()];
-            }
+        memorized_terrain_tile terrain_tile( const point_sm_ms &p ) const {
+            return unpack( terrain_tiles.get( p ) );
         }
 
         void set_terrain_tile( const point_sm_ms &p, const memorized_terrain_tile &value ) {
-            if( terrain_tiles.empty() ) {
-                terrain_tiles.reserve( SEEX * SEEY );
-                terrain_tiles.resize( SEEX * SEEY, default_tile );
-            }
-            terrain_tiles[p.y() * SEEX + p.x()] = value;
+            terrain_tiles.set( p, pack( value ) );
         }
 
         int symbol( const point_sm_ms &p ) const {
-            if( symbols.empty() ) {
-                return default_symbol;
-            } else {
-                return symbols[p.y() * SEEX + p.x()];
-            }
+            return symbols.get( p );
         }
 
         void set_symbol( const point_sm_ms &p, int value ) {
-            if( symbols.empty() ) {
-                // call 'reserve' first to force allocation of exact size
-                symbols.reserve( SEEX * SEEY );
-                symbols.resize( SEEX * SEEY, default_symbol );
-            }
-            symbols[p.y() * SEEX + p.x()] = value;
+            symbols.set( p, value );
+        }
+
+        /** Collapses layers whose tiles all hold the same value. */
+        void compact() {
+            tiles.compact();
+            terrain_tiles.compact();
+            symbols.compact();
+        }
+
+        auto heap_bytes() const -> std::size_t {
+            return tiles.heap_bytes() + terrain_tiles.heap_bytes() + symbols.heap_bytes();
         }
 
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
     private:
-        std::vector<memorized_terrain_tile>
-        tiles;         // overlay: furniture, vpart, trap — 0 or SEEX*SEEY
-        std::vector<memorized_terrain_tile>
-        terrain_tiles; // base terrain layer             — 0 or SEEX*SEEY
-        std::vector<int> symbols; // holds either 0 or SEEX*SEEY elements
+        static mm_tile pack( const memorized_terrain_tile &value ) {
+            return mm_tile{
+                memorized_tile_names::get().intern( value.tile ),
+                static_cast<int16_t>( value.subtile ),
+                static_cast<int16_t>( value.rotation )
+            };
+        }
+        static memorized_terrain_tile unpack( const mm_tile &value ) {
+            return memorized_terrain_tile{
+                memorized_tile_names::get().name( value.name ), value.subtile, value.rotation
+            };
+        }
+
+        mm_layer<mm_tile> tiles{ mm_tile() };         // overlay: furniture, vpart, trap
+        mm_layer<mm_tile> terrain_tiles{ mm_tile() }; // base terrain layer
+        mm_layer<int> symbols{ 0 };                   // 0 is default_symbol
         bool valid = true;
 };
 
@@ -160,7 +250,7 @@ class map_memory
          * Returns memorized overlay tile (furniture, vehicle part, trap).
          * @param pos tile position, in global ms coords.
          */
-        const memorized_terrain_tile &get_tile( const tripoint_abs_ms &pos );
+        memorized_terrain_tile get_tile( const tripoint_abs_ms &pos );
 
         /**
          * Memorizes base terrain tile, overwriting old value.
@@ -207,8 +297,14 @@ class map_memory
          */
         void clear_memorized_tile( const tripoint_abs_ms &pos );
 
+        /** Approximate bytes held by the memorized submaps, for the memory usage panel. */
+        auto memory_usage() const -> std::size_t;
+        auto memorized_submap_count() const -> std::size_t {
+            return submaps.size();
+        }
+
     private:
-        std::map<tripoint_abs_sm, shared_ptr_fast<mm_submap>> submaps;
+        std::unordered_map<tripoint_abs_sm, shared_ptr_fast<mm_submap>> submaps;
 
         std::vector<shared_ptr_fast<mm_submap>> cached;
         tripoint_abs_sm cache_pos;
@@ -0,0 +1,261 @@
+#include "map_snapshot.h"
+
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include "mmap_file.h"
+#include "sqlite3.h"
+#include "string_formatter.h"
+
+namespace
+{
+
+constexpr auto magic = std::string_view{ "CBMS" };
+constexpr auto format_version = uint32_t{ 1 };
+constexpr auto header_size = std::size_t{ 4 + 4 + 8 + 8 };
+constexpr auto entry_size = std::size_t{ 3 * 8 + 4 * 4 };
+
+auto read_le( const char *p, const std::size_t n ) -> uint64_t
+{
+    auto v = uint64_t{ 0 };
+    for( auto i = n; i > 0; --i ) {
+        v = ( v << 8 ) | static_cast<unsigned char>( p[i - 1] );
+    }
+    return v;
+}
+
+auto append_le( std::string &out, uint64_t v, const std::size_t n ) -> void
+{
+    for( auto i = std::size_t{ 0 }; i < n; ++i ) {
+        out.push_back( static_cast<char>( v & 0xff ) );
+        v >>= 8;
+    }
+}
+
+struct index_entry {
+    uint64_t path_offset = 0;
+    uint64_t data_offset = 0;
+    uint64_t compression_offset = 0;
+    uint32_t path_size = 0;
+    uint32_t data_size = 0;
+    uint32_t compression_size = 0;
+};
+
+auto decode_entry( const char *p ) -> index_entry
+{
+    return {
+        .path_offset = read_le( p, 8 ),
+        .data_offset = read_le( p + 8, 8 ),
+        .compression_offset = read_le( p + 16, 8 ),
+        .path_size = static_cast<uint32_t>( read_le( p + 24, 4 ) ),
+        .data_size = static_cast<uint32_t>( read_le( p + 28, 4 ) ),
+        .compression_size = static_cast<uint32_t>( read_le( p + 32, 4 ) ),
+    };
+}
+
+auto encode_entry( std::string &out, const index_entry &e ) -> void
+{
+    append_le( out, e.path_offset, 8 );
+    append_le( out, e.data_offset, 8 );
+    append_le( out, e.compression_offset, 8 );
+    append_le( out, e.path_size, 4 );
+    append_le( out, e.data_size, 4 );
+    append_le( out, e.compression_size, 4 );
+    append_le( out, 0, 4 );
+}
+
+class statement
+{
+    public:
+        statement( sqlite3 *db, const char *sql ) : db_( db ) {
+            if( sqlite3_prepare_v2( db, sql, -1, &stmt_, nullptr ) != SQLITE_OK ) {
+                throw std::runtime_error( string_format( "Failed to prepare map snapshot query: %s",
+                                          sqlite3_errmsg( db ) ) );
+            }
+        }
+        ~statement() {
+            sqlite3_finalize( stmt_ );
+        }
+        statement( const statement & ) = delete;
+        auto operator=( const statement & ) -> statement & = delete;
+
+        /// True while there are rows.
+        auto step() -> bool {
+            const auto ret = sqlite3_step( stmt_ );
+            if( ret != SQLITE_ROW && ret != SQLITE_DONE ) {
+                throw std::runtime_error( string_format( "Map snapshot query failed: %s",
+                                          sqlite3_errmsg( db_ ) ) );
+            }
+            return ret == SQLITE_ROW;
+        }
+        auto column( const int index ) const -> std::string_view {
+            const auto *data = sqlite3_column_blob( stmt_, index );
+            const auto size = sqlite3_column_bytes( stmt_, index );
+            return data == nullptr ? std::string_view{} :
+                   std::string_view( static_cast<const char *>( data ), size );
+        }
+        auto column_int( const int index ) const -> int64_t {
+            return sqlite3_column_int64( stmt_, index );
+        }
+
+    private:
+        sqlite3 *db_;
+        sqlite3_stmt *stmt_ = nullptr;
+};
+
+} // namespace
+
+map_snapshot::~map_snapshot() = default;
+
+auto map_snapshot::open( const std::string &path ) -> std::unique_ptr<map_snapshot>
+{
+    auto snapshot = std::unique_ptr<map_snapshot>( new map_snapshot() );
+    snapshot->file_ = mmap_file::open( path );
+    if( snapshot->file_ == nullptr ) {
+        return nullptr;
+    }
+    snapshot->base_ = snapshot->file_->data();
+    snapshot->mapped_size_ = snapshot->file_->size();
+
+    const auto size_ok = snapshot->mapped_size_ >= header_size;
+    if( !size_ok || std::string_view( snapshot->base_, magic.size() ) != magic ||
+        read_le( snapshot->base_ + 4, 4 ) != format_version ) {
+        return nullptr;
+    }
+    snapshot->generation_ = read_le( snapshot->base_ + 8, 8 );
+    const auto count = read_le( snapshot->base_ + 16, 8 );
+    if( count > ( snapshot->mapped_size_ - header_size ) / entry_size ) {
+        return nullptr;
+    }
+    snapshot->entry_count_ = static_cast<std::size_t>( count );
+    // Check every range once here so lookups need no bounds checks.
+    const auto in_bounds = [&]( const uint64_t offset, const uint32_t size ) {
+        return offset <= snapshot->mapped_size_ && size <= snapshot->mapped_size_ - offset;
+    };
+    for( auto i = std::size_t{ 0 }; i < snapshot->entry_count_; ++i ) {
+        const auto e = decode_entry( snapshot->base_ + header_size + i * entry_size );
+        if( !in_bounds( e.path_offset, e.path_size ) || !in_bounds( e.data_offset, e.data_size ) ||
+            !in_bounds( e.compression_offset, e.compression_size ) ) {
+            return nullptr;
+        }
+    }
+    return snapshot;
+}
+
+auto map_snapshot::bytes( const uint64_t offset, const uint32_t size ) const -> std::string_view
+{
+    return std::string_view( base_ + offset, size );
+}
+
+auto map_snapshot::path_at( const std::size_t index ) const -> std::string_view
+{
+    const auto e = decode_entry( base_ + header_size + index * entry_size );
+    return bytes( e.path_offset, e.path_size );
+}
+
+auto map_snapshot::find( const std::string_view path ) const -> std::optional<entry>
+{
+    auto lo = std::size_t{ 0 };
+    auto hi = entry_count_;
+    while( lo < hi ) {
+        const auto mid = lo + ( hi - lo ) / 2;
+        if( path_at( mid ) < path ) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if( lo == entry_count_ || path_at( lo ) != path ) {
+        return std::nullopt;
+    }
+    const auto e = decode_entry( base_ + header_size + lo * entry_size );
+    return entry{
+        .data = bytes( e.data_offset, e.data_size ),
+        .compression = bytes( e.compression_offset, e.compression_size ),
+    };
+}
+
+auto map_snapshot::write( sqlite3 *db, const uint64_t generation, const std::string &path ) -> void
+{
+    auto count_stmt = statement( db, "SELECT count(*) FROM files" );
+    if( !count_stmt.step() ) {
+        throw std::runtime_error( "Failed to count map database rows" );
+    }
+    const auto count = static_cast<uint64_t>( count_stmt.column_int( 0 ) );
+
+    const auto tmp_path = path + ".tmp";
+    try {
+        auto out = std::ofstream( tmp_path, std::ios::binary | std::ios::trunc );
+        auto header = std::string( magic );
+        append_le( header, format_version, 4 );
+        append_le( header, generation, 8 );
+        append_le( header, count, 8 );
+        out.write( header.data(), header.size() );
+        // Index goes in once every offset is known.
+        const auto index_size = count * entry_size;
+        out.write( std::string( index_size, '\0' ).data(), index_size );
+
+        auto entries = std::vector<index_entry> {};
+        entries.reserve( count );
+        auto offset = header_size + index_size;
+        // Only a handful of distinct compression values exist; store each once.
+        auto compressions = std::map<std::string, uint64_t, std::less<>> {};
+        auto rows = statement( db, "SELECT path, compression, data FROM files ORDER BY path" );
+        while( rows.step() ) {
+            if( entries.size() == count ) {
+                throw std::runtime_error( "Map database changed while writing a snapshot" );
+            }
+            const auto row_path = rows.column( 0 );
+            const auto compression = rows.column( 1 );
+            const auto data = rows.column( 2 );
+            auto e = index_entry{
+                .path_offset = offset,
+                .data_offset = 0,
+                .compression_offset = 0,
+                .path_size = static_cast<uint32_t>( row_path.size() ),
+                .data_size = static_cast<uint32_t>( data.size() ),
+                .compression_size = static_cast<uint32_t>( compression.size() ),
+            };
+            out.write( row_path.data(), row_path.size() );
+            offset += row_path.size();
+
+            const auto known = compressions.find( compression );
+            if( known != compressions.end() ) {
+                e.compression_offset = known->second;
+            } else {
+                e.compression_offset = offset;
+                compressions.emplace( std::string( compression ), offset );
+                out.write( compression.data(), compression.size() );
+                offset += compression.size();
+            }
+
+            e.data_offset = offset;
+            out.write( data.data(), data.size() );
+            offset += data.size();
+            entries.push_back( e );
+        }
+        if( entries.size() != count ) {
+            throw std::runtime_error( "Map database changed while writing a snapshot" );
+        }
+
+        auto index = std::string{};
+        index.reserve( index_size );
+        for( const auto &e : entries ) {
+            encode_entry( index, e );
+        }
+        out.seekp( header_size );
+        out.write( index.data(), index.size() );
+        out.close();
+        if( !out ) {
+            throw std::runtime_error( "Failed to write map snapshot " + tmp_path );
+        }
+    } catch( ... ) {
+        auto ec = std::error_code{};
+        std::filesystem::remove( tmp_path, ec );
+        throw;
+    }
+    std::filesystem::rename( tmp_path, path );
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+
+class mmap_file;
+struct sqlite3;
+
+/**
+ * Read-only packed copy of the `files` table of a map database, memory-mapped
+ * so loading looks blobs up without going through SQLite.
+ *
+ * Layout, all integers little-endian:
+ *
+ *     "CBMS"  u32 format_version  u64 generation  u64 entry_count
+ *     entry_count * { u64 path_offset  u64 data_offset  u64 compression_offset
+ *                     u32 path_size    u32 data_size    u32 compression_size  u32 reserved }
+ *     path, compression and blob bytes
+ *
+ * Entries are sorted by path and offsets count from the start of the file.
+ * Blobs are stored exactly as the `data` column holds them, still compressed,
+ * and the `compression` column travels with them.
+ *
+ * `generation` is the database's `PRAGMA user_version` when the snapshot was
+ * taken.  sqlite_map_db bumps it on the first write of every session, so a
+ * snapshot that no longer matches the database is detected on the next open.
+ */
+class map_snapshot
+{
+    public:
+        struct entry {
+            std::string_view data;
+            std::string_view compression;
+        };
+
+        ~map_snapshot();
+        map_snapshot( const map_snapshot & ) = delete;
+        auto operator=( const map_snapshot & ) -> map_snapshot & = delete;
+
+        /** Maps the snapshot at @p path; nullptr if it is missing or malformed. */
+        static auto open( const std::string &path ) -> std::unique_ptr<map_snapshot>;
+        /**
+         * Writes every row of @p db to a new snapshot at @p path, replacing any
+         * old one only once the new file is complete.  Run it inside a read
+         * transaction so the rows match @p generation.  Throws on failure.
+         */
+        static auto write( sqlite3 *db, uint64_t generation, const std::string &path ) -> void;
+
+        auto generation() const -> uint64_t {
+            return generation_;
+        }
+        auto size() const -> std::size_t {
+            return entry_count_;
+        }
+        /// Views into the mapping, valid for the snapshot's lifetime.
+        auto find( std::string_view path ) const -> std::optional<entry>;
+
+    private:
+        map_snapshot() = default;
+
+        auto bytes( uint64_t offset, uint32_t size ) const -> std::string_view;
+        auto path_at( std::size_t index ) const -> std::string_view;
+
+        std::unique_ptr<mmap_file> file_;
+        const char *base_ = nullptr;
+        std::size_t mapped_size_ = 0;
+        uint64_t generation_ = 0;
+        std::size_t entry_count_ = 0;
+};
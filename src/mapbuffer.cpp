@@ -8,6 +8,7 @@
 #include <cstdlib>
 #include <exception>
 #include <functional>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -19,8 +20,10 @@
 
 #include "avatar.h"
 #include "batch_turns.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
+#include "compress.h"
 #include "creature.h"
 #include "debug.h"
 #include "detached_ptr.h"
@@ -39,6 +42,7 @@
 #include "json.h"
 #include "map.h"
 #include "mapdata.h"
+#include "mapgen_async.h"
 #include "mapgen_constructor.h"
 #include "map_iterator.h"
 #include "map_mutation_hooks.h"
@@ -47,16 +51,19 @@
 #include "messages.h"
 #include "mongroup.h"
 #include "mtype.h"
+#include "omdata.h"
 #include "options.h"
 #include "overmapbuffer.h"
 #include "output.h"
 #include "popup.h"
 #include "profile.h"
+#include "regional_settings.h"
 #include "rng.h"
 #include "rot.h"
 #include "skill.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
 #include "submap_load_manager.h"
 #include "thread_pool.h"
 #include "translations.h"
@@ -124,14 +131,35 @@ auto uniform_terrain_for_omt( const dimension_id &dimension_id,
     static const oter_id rock( "empty_rock" );
     static const oter_id air( "open_air" );
 
-    const auto terrain_type = get_overmapbuffer( dimension_id ).ter( omt_addr );
+    auto &omap = get_overmapbuffer( dimension_id );
+    const auto terrain_type = omap.ter( omt_addr );
     if( terrain_type == air ) {
         return t_open_air;
     }
     if( terrain_type == rock ) {
         return t_rock;
     }
-    return std::nullopt;
+
+    // Otherwise only mapgen that fills the map with one terrain and nothing else, and only
+    // where mapgen_constructor::generate wouldn't add to it afterwards.  Above ground,
+    // uniform submaps would count as empty when finding the highest populated level.
+    if( omt_addr.z() > 0 || mapgen_postprocess_hooks_present() ||
+        terrain_type->get_static_spawns().group ) {
+        return std::nullopt;
+    }
+    const auto fill = uniform_mapgen_terrain( terrain_type->get_mapgen_id() );
+    if( !fill ) {
+        return std::nullopt;
+    }
+    const auto &settings = omap.get_settings( omt_addr );
+    if( settings.region_terrain_and_furniture.terrain.contains( *fill ) ) {
+        return std::nullopt;
+    }
+    const auto extra_it = settings.region_extras.find( terrain_type->get_extras() );
+    if( extra_it != settings.region_extras.end() && extra_it->second.chance > 0 ) {
+        return std::nullopt;
+    }
+    return fill;
 }
 
 auto add_uniform_omt( mapbuffer &dest, const tripoint_abs_sm &base,
@@ -197,6 +225,7 @@ auto add_spawn_to_submap( const add_submap_spawn_options &options ) -> void
     }
 
     options.sm.spawns.emplace_back( options.type, 1, options.local, -1, -1, options.disposition );
+    options.sm.mark_modified();
 }
 
 auto handle_decayed_corpse( const actualize_tile_options &options, const item &corpse ) -> void
@@ -612,9 +641,10 @@ auto tile_allows_item_despite_noitem_flag( const item &target,
 auto move_cost_from_tile_parts( const ter_id &terrain_id, const furn_id &furniture_id,
                                 const optional_vpart_position &vp ) -> int
 {
-    const auto &terrain = terrain_id.obj();
-    const auto &furniture = furniture_id.obj();
-    if( terrain.movecost == 0 || ( furniture.id && furniture.movecost < 0 ) ) {
+    const int ter_cost = cache_attr::move_cost( terrain_id );
+    const bool has_furniture = ( cache_attr::of( furniture_id ) & cache_attr::present ) != 0;
+    const int furn_cost = has_furniture ? cache_attr::move_cost( furniture_id ) : 0;
+    if( ter_cost == 0 || furn_cost < 0 ) {
         return 0;
     }
 
@@ -628,11 +658,7 @@ auto move_cost_from_tile_parts( const ter_id &terrain_id, const furn_id &furnitu
         return 8;
     }
 
-    if( furniture.id ) {
-        return std::max( terrain.movecost + furniture.movecost, 0 );
-    }
-
-    return std::max( terrain.movecost, 0 );
+    return std::max( ter_cost + furn_cost, 0 );
 }
 
 auto omt_submap_offsets() -> const std::array<point_omt_sm, 4> &
@@ -760,6 +786,17 @@ auto mark_post_pass_changed( submap &sm ) -> void
     sm.outside_dirty = true;
     sm.absorption_dirty = true;
     sm.pf_dirty = true;
+    sm.pf_revision = submap::next_pf_revision();
+}
+
+/// Submaps read from disk from @p first on match their saved copy.  Ones
+/// restored from pending writes are not on disk yet and stay modified.
+auto mark_loaded_saved( std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &loaded,
+                        const std::size_t first ) -> void
+{
+    std::ranges::for_each( loaded | std::views::drop( first ), []( auto & entry ) {
+        entry.second->mark_saved();
+    } );
 }
 
 } // namespace
@@ -844,20 +881,20 @@ auto mapbuffer_abs_tile_view::get_radiation() const -> int
 
 auto mapbuffer_abs_tile_view::get_lum() const -> std::uint8_t
 {
+    sm_->load_deferred_items();
     return sm_->get_lum( local_ );
 }
 
 auto mapbuffer_abs_tile_view::move_cost_ter_furn() const -> int
 {
-    const auto &terrain = get_ter_t();
-    const auto &furniture = get_furn_t();
-    if( terrain.movecost == 0 || ( furniture.id && furniture.movecost < 0 ) ) {
+    const int ter_cost = cache_attr::move_cost( get_ter() );
+    const auto furniture = get_furn();
+    const bool has_furniture = ( cache_attr::of( furniture ) & cache_attr::present ) != 0;
+    const int furn_cost = has_furniture ? cache_attr::move_cost( furniture ) : 0;
+    if( ter_cost == 0 || furn_cost < 0 ) {
         return 0;
     }
-    if( furniture.id ) {
-        return std::max( terrain.movecost + furniture.movecost, 0 );
-    }
-    return std::max( terrain.movecost, 0 );
+    return std::max( ter_cost + furn_cost, 0 );
 }
 
 auto mapbuffer_abs_tile_view::passable_ter_furn() const -> bool
@@ -1378,7 +1415,7 @@ auto mapbuffer::get_boundary_terrain() const -> ter_id
 void mapbuffer::clear()
 {
     {
-        std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+        std::lock_guard lk( submaps_mutex_ );
         creature_tracker_.clear();
         active_npcs_.clear();
         active_npcs_by_location_.clear();
@@ -1388,15 +1425,35 @@ void mapbuffer::clear()
         submaps_with_active_items_.clear();
         submaps_with_luminous_items_.clear();
         submaps.clear();
+        resident_index_.clear();
         pocket_info_.reset();
     }
     std::lock_guard<std::mutex> pw_lk( pending_writes_mutex_ );
     pending_writes_.clear();
 }
 
+auto mapbuffer::memory_usage() const -> std::size_t
+{
+    auto bytes = std::size_t{ 0 };
+    {
+        std::lock_guard lk( submaps_mutex_ );
+        for( const auto &[pos, sm] : submaps ) {
+            bytes += sizeof( pos ) + sizeof( sm );
+            if( sm ) {
+                bytes += sm->memory_usage();
+            }
+        }
+    }
+    std::lock_guard<std::mutex> pw_lk( pending_writes_mutex_ );
+    for( const auto &[omt, data] : pending_writes_ ) {
+        bytes += sizeof( omt ) + data.capacity();
+    }
+    return bytes;
+}
+
 bool mapbuffer::add_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &sm )
 {
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     if( submaps.contains( p ) ) {
         return false;
     }
@@ -1409,6 +1466,8 @@ bool mapbuffer::add_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &s
     refresh_luminous_item_submap_index( p, {
         .mode = mapbuffer_lookup_mode::resident_only,
     } );
+    // Published last: lock-free readers must not see the submap before its side tables.
+    resident_index_.insert_or_assign( p, submaps[p].get() );
 
     return true;
 }
@@ -1435,6 +1494,7 @@ void mapbuffer::remove_submap( tripoint_abs_sm addr )
     unregister_submap_vehicles( addr );
     submaps_with_active_items_.erase( addr );
     submaps_with_luminous_items_.erase( addr );
+    resident_index_.erase( addr );
     submaps.erase( m_target );
 }
 
@@ -1459,6 +1519,7 @@ void mapbuffer::transfer_all_to( mapbuffer &dest )
         } ) ) {
             dest.submaps_with_luminous_items_.insert( kv.first );
         }
+        dest.resident_index_.insert_or_assign( kv.first, kv.second.get() );
         dest.submaps.emplace( kv.first, std::move( kv.second ) );
     }
     loaded_vehicles_.clear();
@@ -1466,6 +1527,7 @@ void mapbuffer::transfer_all_to( mapbuffer &dest )
     vehicle_footprint_locations_.clear();
     submaps_with_active_items_.clear();
     submaps_with_luminous_items_.clear();
+    resident_index_.clear();
     submaps.clear();
 }
 
@@ -1481,7 +1543,7 @@ void mapbuffer::unload_omt( const tripoint_abs_omt &omt_addr, bool save )
     // Hold the mutex for the entire save+erase so that background lazy-border
     // preload_omt() workers (which acquire the mutex per add_submap()) cannot
     // race with our submaps.find()/erase() calls.
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     std::list<tripoint_abs_sm> to_delete;
     if( save ) {
         // Serialise into the pending-writes cache (no disk I/O).  The data will
@@ -1506,27 +1568,7 @@ void mapbuffer::unload_omt( const tripoint_abs_omt &omt_addr, bool save )
 
         if( !all_uniform && !disable_mapgen ) {
             std::ostringstream buf;
-            {
-                JsonOut jsout( buf );
-                jsout.start_array();
-                for( const tripoint_abs_sm &addr : addrs ) {
-                    const auto it = submaps.find( addr );
-                    if( it == submaps.end() || !it->second ) {
-                        continue;
-                    }
-                    jsout.start_object();
-                    jsout.member( "version", savegame_version );
-                    jsout.member( "coordinates" );
-                    jsout.start_array();
-                    jsout.write( addr.x() );
-                    jsout.write( addr.y() );
-                    jsout.write( addr.z() );
-                    jsout.end_array();
-                    it->second->store( jsout );
-                    jsout.end_object();
-                }
-                jsout.end_array();
-            }
+            serialize_omt( buf, addrs );
             std::lock_guard<std::mutex> pw_lk( pending_writes_mutex_ );
             pending_writes_[omt_addr] = std::move( buf ).str();
         }
@@ -1568,6 +1610,7 @@ void mapbuffer::unload_omt( const tripoint_abs_omt &omt_addr, bool save )
     for( const auto &p : to_delete ) {
         unregister_submap_vehicles( p );
         submaps_with_active_items_.erase( p );
+        resident_index_.erase( p );
         submaps.erase( p );
     }
 }
@@ -1605,15 +1648,15 @@ submap *mapbuffer::lookup_submap( const tripoint_abs_sm &p )
     try {
         bool found = false;
         if( !pending_data.empty() ) {
-            std::istringstream iss( pending_data );
-            JsonIn jsin( iss );
-            deserialize_into_vec( jsin, loaded, already_loaded );
+            deserialize_omt_blob( pending_data, loaded, already_loaded );
             found = true;
         } else {
-            found = g->get_active_world()->read_map_omt( dimension_id_.str(), omt_addr,
-            [this, &loaded, &already_loaded]( JsonIn & jsin ) {
-                deserialize_into_vec( jsin, loaded, already_loaded );
+            found = g->get_active_world()->read_map_omt_data( dimension_id_.str(), omt_addr,
+            [this, &loaded, &already_loaded]( std::istream & fin ) {
+                deserialize_omt_blob( fin, loaded,
+                                      already_loaded );
             } );
+            mark_loaded_saved( loaded, 0 );
         }
         if( !found ) {
             return nullptr;
@@ -1740,7 +1783,7 @@ auto mapbuffer::for_each_simulated_submap_position(
 
     const auto horizontal_positions = submap_loader.simulated_submaps( dimension_id_ );
     if( horizontal_positions.empty() ) {
-        std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+        std::lock_guard lk( submaps_mutex_ );
         for( const std::pair<const tripoint_abs_sm, std::unique_ptr<submap>> &entry : submaps ) {
             const auto abs_pos = tripoint_abs_sm( entry.first );
             if( entry.second && ( !zlev_filter || abs_pos.z() == *zlev_filter ) &&
@@ -1837,6 +1880,27 @@ auto mapbuffer::mark_submap_caches_dirty(
         sm->outside_dirty = sm->outside_dirty || options.outside;
         sm->absorption_dirty = sm->absorption_dirty || options.absorption;
         sm->pf_dirty = sm->pf_dirty || options.pathfinding;
+        if( options.pathfinding ) {
+            sm->pf_revision = submap::next_pf_revision();
+        }
+    }
+}
+
+auto mapbuffer::mark_tile_caches_dirty( const mapbuffer_mark_tile_caches_dirty_options &options ) -> void
+{
+    if( options.pos.z() < -OVERMAP_DEPTH || options.pos.z() > OVERMAP_HEIGHT ) {
+        return;
+    }
+    const auto split = project_remain<coords::sm>( options.pos );
+    auto *const sm = lookup_submap_in_memory( split.quotient_tripoint );
+    if( sm == nullptr ) {
+        return;
+    }
+    if( options.transparency ) {
+        sm->mark_transparency_tile_dirty( split.remainder );
+    }
+    if( options.floor ) {
+        sm->mark_floor_tile_dirty( split.remainder );
     }
 }
 
@@ -1860,6 +1924,7 @@ auto mapbuffer::clear_spawns( const mapbuffer_submap_bounds_mutation_options &op
                 continue;
             }
             sm->spawns.clear();
+            sm->mark_modified();
         }
     }
 }
@@ -2092,7 +2157,7 @@ auto mapbuffer::remove_active_npc( const npc &guy ) -> void
 
 auto mapbuffer::has_loaded_vehicle( const vehicle *veh ) const -> bool
 {
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     return loaded_vehicles_.contains( const_cast<vehicle *>( veh ) );
 }
 
@@ -2102,7 +2167,7 @@ auto mapbuffer::register_vehicle( vehicle *veh ) -> void
         return;
     }
 
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     veh->set_dimension( dimension_id_ );
     loaded_vehicles_.insert( veh );
     index_vehicle_footprint_unlocked( *veh );
@@ -2110,7 +2175,7 @@ auto mapbuffer::register_vehicle( vehicle *veh ) -> void
 
 auto mapbuffer::unregister_vehicle( vehicle *veh ) -> void
 {
-    std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+    std::lock_guard lk( submaps_mutex_ );
     unindex_vehicle_footprint_unlocked( veh );
     loaded_vehicles_.erase( veh );
 }
@@ -2121,7 +2186,7 @@ auto mapbuffer::refresh_vehicle_footprint( vehicle *veh ) -> void
         return;
     }
 
-    std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+    std::lock_guard lk( submaps_mutex_ );
     if( !loaded_vehicles_.contains( veh ) ) {
         return;
     }
@@ -2131,7 +2196,7 @@ auto mapbuffer::refresh_vehicle_footprint( vehicle *veh ) -> void
 auto mapbuffer::refresh_vehicle_registry_for_submap( const tripoint_abs_sm &p,
         const mapbuffer_lookup_options options ) -> void
 {
-    std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+    std::lock_guard lk( submaps_mutex_ );
     unregister_submap_vehicles( p );
     auto *const sm = get_submap( p, options );
     if( sm == nullptr ) {
@@ -2236,7 +2301,7 @@ auto mapbuffer::vehicle_part_at_loaded_tile( const tripoint_abs_ms &p ) -> optio
         return g->m.veh_at( *local );
     }
 
-    std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+    std::lock_guard lk( submaps_mutex_ );
     return indexed_vehicle_part_at_unlocked( p );
 }
 
@@ -2549,6 +2614,8 @@ auto mapbuffer::set_trap( const tripoint_abs_ms &p, const trap_id trap,
     }
 
     tile->sm->set_trap( tile->local, trap );
+    // Traps weigh into Pathfinding's portal graphs, which outlive the turn.
+    tile->sm->pf_revision = submap::next_pf_revision();
     sync_active_trap_change_side_tables( p, tile->local, old_id, trap );
     return true;
 }
@@ -2700,17 +2767,26 @@ auto mapbuffer::has_field_at( const tripoint_abs_ms &p,
                               const mapbuffer_lookup_options options ) -> bool
 {
     const auto tile = lookup_tile( *this, p, options );
-    return tile && tile->sm->field_count > 0;
+    return tile && tile->sm->field_count > 0 && tile->sm->may_have_field_at( tile->local );
+}
+
+auto mapbuffer::has_creature_field_at( const tripoint_abs_ms &p,
+                                       const mapbuffer_lookup_options options ) -> bool
+{
+    const auto tile = lookup_tile( *this, p, options );
+    return tile && tile->sm->field_count > 0 && tile->sm->may_have_creature_field_at( tile->local );
 }
 
 auto mapbuffer::get_field_entry( const tripoint_abs_ms &p, const field_type_id &type,
                                  const mapbuffer_lookup_options options ) -> field_entry *
 {
-    if( !has_field_at( p, options ) ) {
+    const auto tile = lookup_tile( *this, p, options );
+    if( !tile || tile->sm->field_count == 0 || !tile->sm->may_have_field( type ) ||
+        !tile->sm->may_have_field_at( tile->local ) ) {
         return nullptr;
     }
 
-    return get_field( p, options )->find_field( type );
+    return tile->sm->get_field( tile->local ).find_field( type );
 }
 
 auto mapbuffer::get_field_age( const tripoint_abs_ms &p, const field_type_id &type,
@@ -2817,8 +2893,7 @@ auto mapbuffer::add_field( const tripoint_abs_ms &p,
 
     tile->sm->is_uniform = false;
     if( tile->sm->get_field( tile->local ).add_field( options.type, intensity, options.age ) ) {
-        tile->sm->field_count++;
-        tile->sm->field_cache.push_back( tile->local );
+        tile->sm->note_field_added( tile->local, options.type );
     }
 
     invalidate_active_field_add_caches( p, options.type );
@@ -3094,6 +3169,7 @@ auto mapbuffer::add_item( const tripoint_abs_ms &p, detached_ptr<item> &&new_ite
     }
 
     tile->sm->get_items( tile->local ).push_back( std::move( new_item ) );
+    tile->sm->note_item_added( tile->local );
     return detached_ptr<item>();
 }
 
@@ -3537,6 +3613,7 @@ auto mapbuffer::partial_con_set( const tripoint_abs_ms &p, std::unique_ptr<parti
         return false;
     }
 
+    tile->sm->mark_modified();
     const auto inserted = tile->sm->partial_constructions.emplace( tripoint_sm_ms( tile->local, p.z() ),
                           std::move( con ) ).second;
     if( !inserted ) {
@@ -3553,6 +3630,7 @@ auto mapbuffer::partial_con_remove( const tripoint_abs_ms &p,
         return false;
     }
 
+    tile->sm->mark_modified();
     return tile->sm->partial_constructions.erase( tripoint_sm_ms( tile->local, p.z() ) ) > 0;
 }
 
@@ -3638,6 +3716,7 @@ auto mapbuffer::sync_furniture_change_side_tables( const tripoint_abs_ms &p, sub
     const auto &old_furniture = old_id.obj();
     const auto &new_furniture = new_id.obj();
     auto *const tracker = get_distribution_grid_tracker_for( dimension_id_ );
+    sm.mark_modified();
 
     if( old_furniture.active ) {
         sm.active_furniture.erase( local );
@@ -3856,7 +3935,7 @@ void mapbuffer::save( bool delete_after_save, bool notify_tracker, bool show_pro
     std::list<tripoint_abs_sm> submaps_to_delete;
     std::mutex delete_mutex;
 
-    parallel_for( 0, static_cast<int>( omts_to_process.size() ), [&]( int i ) {
+    parallel_for( "mapbuffer_save", 0, static_cast<int>( omts_to_process.size() ), [&]( int i ) {
         std::list<tripoint_abs_sm> local_delete;
         save_omt( omts_to_process[i].omt_addr, local_delete, omts_to_process[i].delete_after );
         if( !local_delete.empty() ) {
@@ -3950,42 +4029,130 @@ void mapbuffer::save_omt( const tripoint_abs_omt &omt_addr,
         return;
     }
 
-    g->get_active_world()->write_map_omt( dimension_id_.str(), omt_addr, [&]( std::ostream & fout ) {
-        JsonOut jsout( fout );
-        jsout.start_array();
+    // Unchanged omts already match what is on disk.
+    const auto modified = submap_loader.simulated_since_save( dimension_id_, omt_addr.xy() ) ||
+    std::ranges::any_of( submap_addrs, [&]( const tripoint_abs_sm & submap_addr ) {
+        const auto it = submaps.find( submap_addr );
+        return it != submaps.end() && it->second && it->second->is_modified();
+    } );
+    if( modified ) {
+        g->get_active_world()->write_map_omt( dimension_id_.str(), omt_addr, [&]( std::ostream & fout ) {
+            serialize_omt( fout, submap_addrs );
+        } );
         for( const tripoint_abs_sm &submap_addr : submap_addrs ) {
             const auto it = submaps.find( submap_addr );
-            if( it == submaps.end() ) {
-                continue;
+            if( it != submaps.end() && it->second ) {
+                it->second->mark_saved();
             }
-
-            submap *sm = it->second.get();
-            if( sm == nullptr ) {
-                continue;
+        }
+    }
+    if( delete_after_save ) {
+        for( const tripoint_abs_sm &submap_addr : submap_addrs ) {
+            const auto it = submaps.find( submap_addr );
+            if( it != submaps.end() && it->second ) {
+                submaps_to_delete.push_back( submap_addr );
             }
+        }
+    }
+}
 
-            jsout.start_object();
+void mapbuffer::serialize_omt( std::ostream &out, std::span<const tripoint_abs_sm> addrs ) const
+{
+    auto present = std::vector<std::pair<tripoint_abs_sm, const submap *>> {};
+    for( const tripoint_abs_sm &addr : addrs ) {
+        const auto it = submaps.find( addr );
+        if( it != submaps.end() && it->second ) {
+            present.emplace_back( addr, it->second.get() );
+        }
+    }
 
-            jsout.member( "version", savegame_version );
-            jsout.member( "coordinates" );
+    if( binary_map_saves ) {
+        auto blob = submap_binary::writer{};
+        blob.u32( static_cast<uint32_t>( present.size() ) );
+        for( const auto &[addr, sm] : present ) {
+            blob.i32( addr.x() );
+            blob.i32( addr.y() );
+            blob.i32( addr.z() );
+            blob.i32( savegame_version );
+            const auto record = blob.begin_record();
+            sm->store_binary( blob );
+            blob.end_record( record );
+        }
+        out << blob.finish();
+        return;
+    }
 
-            jsout.start_array();
-            jsout.write( submap_addr.x() );
-            jsout.write( submap_addr.y() );
-            jsout.write( submap_addr.z() );
-            jsout.end_array();
+    JsonOut jsout( out );
+    jsout.start_array();
+    for( const auto &[addr, sm] : present ) {
+        jsout.start_object();
 
-            sm->store( jsout );
+        jsout.member( "version", savegame_version );
+        jsout.member( "coordinates" );
 
-            jsout.end_object();
+        jsout.start_array();
+        jsout.write( addr.x() );
+        jsout.write( addr.y() );
+        jsout.write( addr.z() );
+        jsout.end_array();
 
-            if( delete_after_save ) {
-                submaps_to_delete.push_back( submap_addr );
-            }
-        }
+        sm->store( jsout );
 
-        jsout.end_array();
-    } );
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+void mapbuffer::deserialize_omt_blob(
+    std::istream &fin,
+    std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &out,
+    const std::function<bool( const tripoint_abs_sm & )> &skip_if )
+{
+    // Database reads hand over a view of their decompression buffer.
+    if( const auto *view = dynamic_cast<const memory_istreambuf *>( fin.rdbuf() ) ) {
+        deserialize_omt_blob( view->view().substr( static_cast<std::size_t>( fin.tellg() ) ), out,
+                              skip_if );
+        return;
+    }
+    auto scratch = scratch_buffer();
+    auto &blob = scratch.get();
+    blob.assign( std::istreambuf_iterator<char>( fin ), {} );
+    deserialize_omt_blob( blob, out, skip_if );
+}
+
+void mapbuffer::deserialize_omt_blob(
+    const std::string_view blob,
+    std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &out,
+    const std::function<bool( const tripoint_abs_sm & )> &skip_if )
+{
+    if( !submap_binary::is_encoded( blob ) ) {
+        memory_istreambuf view( blob );
+        std::istream iss( &view );
+        JsonIn jsin( iss );
+        deserialize_into_vec( jsin, out, skip_if );
+        return;
+    }
+
+    auto in = submap_binary::reader( blob );
+    for( auto count = in.u32(); count > 0; --count ) {
+        const auto x = in.i32();
+        const auto y = in.i32();
+        const auto z = in.i32();
+        const auto loc = tripoint_abs_sm{ x, y, z };
+        const auto version = in.i32();
+        const auto length = in.u32();
+        if( skip_if && skip_if( loc ) ) {
+            in.skip( length );
+            continue;
+        }
+        const auto start = in.position();
+        auto sm = std::make_unique<submap>( loc, get_dimension_id() );
+        sm->load_binary( in, version, project_to<coords::ms>( loc ), get_dimension_id() );
+        if( in.position() - start != length ) {
+            throw std::runtime_error( "binary submap record length mismatch" );
+        }
+        out.emplace_back( loc, std::move( sm ) );
+    }
 }
 
 void mapbuffer::deserialize_into_vec(
@@ -4061,16 +4228,63 @@ bool mapbuffer::preload_omt( const tripoint_abs_omt &omt_addr )
     }
 
     if( !pending_data.empty() ) {
-        std::istringstream iss( pending_data );
-        JsonIn jsin( iss );
-        deserialize_into_vec( jsin, loaded, already_loaded );
+        deserialize_omt_blob( pending_data, loaded, already_loaded );
     } else {
-        g->get_active_world()->read_map_omt( dimension_id_.str(), omt_addr,
-        [this, &loaded, &already_loaded]( JsonIn & jsin ) {
-            deserialize_into_vec( jsin, loaded, already_loaded );
+        g->get_active_world()->read_map_omt_data( dimension_id_.str(), omt_addr,
+        [this, &loaded, &already_loaded]( std::istream & fin ) {
+            deserialize_omt_blob( fin, loaded,
+                                      already_loaded );
         } );
+        mark_loaded_saved( loaded, 0 );
     }
 
+    add_preloaded_submaps( loaded );
+    return from_cache;
+}
+
+void mapbuffer::preload_omts( std::span<const tripoint_abs_omt> omt_addrs )
+{
+    ZoneScoped;
+    std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> loaded;
+    auto already_loaded = [this]( const tripoint_abs_sm & p ) {
+        return lookup_submap_in_memory( p ) != nullptr;
+    };
+
+    // Same write-back cache check as preload_omt(); only the rest go to disk.
+    auto from_disk = std::vector<tripoint_abs_omt> {};
+    {
+        std::lock_guard<std::mutex> pw_lk( pending_writes_mutex_ );
+        std::ranges::for_each( omt_addrs, [&]( const tripoint_abs_omt & omt_addr ) {
+            const auto it = pending_writes_.find( omt_addr );
+            auto pending_data = std::string{};
+            if( it != pending_writes_.end() ) {
+                pending_data = std::move( it->second );
+                pending_writes_.erase( it );
+            }
+            if( pending_data.empty() ) {
+                from_disk.push_back( omt_addr );
+            } else {
+                deserialize_omt_blob( pending_data, loaded, already_loaded );
+            }
+        } );
+    }
+
+    if( !from_disk.empty() ) {
+        const auto from_cache = loaded.size();
+        g->get_active_world()->read_map_omts_data( dimension_id_.str(), from_disk,
+        [this, &loaded, &already_loaded]( const tripoint_abs_omt &, std::istream & fin ) {
+            deserialize_omt_blob( fin, loaded,
+                                  already_loaded );
+        } );
+        mark_loaded_saved( loaded, from_cache );
+    }
+
+    add_preloaded_submaps( loaded );
+}
+
+void mapbuffer::add_preloaded_submaps(
+    std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &loaded )
+{
     // Add parsed submaps to the in-memory buffer under submaps_mutex_.
     // add_submap() handles concurrent duplicate-add gracefully (keeps in-memory version).
     for( auto &[pos, sm] : loaded ) {
@@ -4087,7 +4301,6 @@ bool mapbuffer::preload_omt( const tripoint_abs_omt &omt_addr )
             }
         }
     }
-    return from_cache;
 }
 
 auto mapbuffer::generate_omt( const tripoint_abs_omt &omt_addr,
@@ -4146,7 +4359,7 @@ auto mapbuffer::run_omt_pillar_post_pass_if_complete( const point_abs_omt &omt_p
         point_rel_sm::south_east(),
     } );
 
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     for( const auto zlev : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
         const auto base = project_to<coords::sm>( tripoint_abs_omt( omt_pos, zlev ) );
         const auto missing = std::ranges::any_of( offsets, [&]( const point_rel_sm & offset ) {
@@ -4171,7 +4384,7 @@ auto mapbuffer::run_omt_pillar_post_pass( const point_abs_omt &omt_pos ) -> void
         point_rel_sm::south_east(),
     } );
 
-    auto lk = std::lock_guard<std::recursive_mutex>( submaps_mutex_ );
+    auto lk = std::lock_guard( submaps_mutex_ );
     struct vertical_transition_link_request {
         tripoint_abs_sm target_pos;
         point_sm_ms local;
@@ -4259,6 +4472,16 @@ auto mapbuffer::actualize_submap( const tripoint_abs_sm &pos ) -> void
         return;
     }
 
+    // add_submap() could not index items the load left serialized.
+    tmpsub->load_deferred_items();
+    if( tmpsub->take_deferred_items_unindexed() ) {
+        const auto resident = mapbuffer_lookup_options {
+            .mode = mapbuffer_lookup_mode::resident_only,
+        };
+        refresh_active_item_submap_index( pos, resident );
+        refresh_luminous_item_submap_index( pos, resident );
+    }
+
     if( tmpsub->last_touched == calendar::turn ) {
         ZoneScopedN( "mapbuffer_actualize_skip_current_turn" );
         return;
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <iosfwd>
 #include <limits>
 #include <list>
 #include <map>
@@ -24,9 +25,11 @@
 #include "dimension_info.h"
 #include "game_constants.h"
 #include "item_stack.h"
+#include "lock_stats.h"
 #include "mapgen_functions.h"
 #include "memory_fast.h"
 #include "point.h"
+#include "sharded_map.h"
 #include "submap_load_manager.h"
 #include "type_id.h"
 #include "vpart_position.h"
@@ -146,6 +149,13 @@ struct mapbuffer_mark_submap_caches_dirty_options {
     bool pathfinding = false;
 };
 
+/// One tile of a submap's transparency/floor cache, for changes that touch a single tile.
+struct mapbuffer_mark_tile_caches_dirty_options {
+    tripoint_abs_ms pos;
+    bool transparency = false;
+    bool floor = false;
+};
+
 struct mapbuffer_submap_bounds_mutation_options {
     point_abs_sm begin;
     point_abs_sm end;
@@ -454,6 +464,7 @@ class mapbuffer
         auto simulated_submap_views( int zlev ) -> std::vector<mapbuffer_abs_submap_view>;
         auto mark_submap_caches_dirty( const mapbuffer_mark_submap_caches_dirty_options &options )
         -> void;
+        auto mark_tile_caches_dirty( const mapbuffer_mark_tile_caches_dirty_options &options ) -> void;
         auto clear_spawns( const mapbuffer_submap_bounds_mutation_options &options ) -> void;
         auto clear_traps( const mapbuffer_submap_bounds_mutation_options &options ) -> void;
         auto fill_terrain( const mapbuffer_fill_terrain_options &options ) -> void;
@@ -551,6 +562,9 @@ class mapbuffer
         mapbuffer_lookup_options options = {} ) -> field *;
         auto has_field_at( const tripoint_abs_ms &p,
         mapbuffer_lookup_options options = {} ) -> bool;
+        /** Whether there might be a field at @p p that can affect a creature standing in it. */
+        auto has_creature_field_at( const tripoint_abs_ms &p,
+                                    mapbuffer_lookup_options options = {} ) -> bool;
         auto get_field_entry( const tripoint_abs_ms &p, const field_type_id &type,
         mapbuffer_lookup_options options = {} ) -> field_entry *;
         auto get_field_age( const tripoint_abs_ms &p, const field_type_id &type,
@@ -659,11 +673,10 @@ class mapbuffer
          * to avoid ~2400 wasted SQLite queries per pocket dimension map load.
          *
          * Thread-safe: may be called from background worker threads (under gen_mutex).
+         * Reads @c resident_index_ and so does not take @c submaps_mutex_.
          */
-        submap *lookup_submap_in_memory( const tripoint_abs_sm &p ) {
-            std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
-            const auto iter = submaps.find( p );
-            return iter != submaps.end() ? iter->second.get() : nullptr;
+        submap *lookup_submap_in_memory( const tripoint_abs_sm &p ) const {
+            return resident_index_.find( p, nullptr );
         }
 
         /**
@@ -698,6 +711,11 @@ class mapbuffer
          * been flushed to actual disk files and must be re-saved before eviction.
          */
         bool preload_omt( const tripoint_abs_omt &omt_addr );
+        /**
+         * preload_omt() for several omts, e.g. the z-levels of one column.  The
+         * disk reads share one database transaction instead of one each.
+         */
+        void preload_omts( std::span<const tripoint_abs_omt> omt_addrs );
 
         /**
          * Generate all submaps in the OMT at @p omt_addr if any are not yet
@@ -795,9 +813,18 @@ class mapbuffer
 
         /// Guards all accesses to `submaps` that may overlap with background
         /// worker threads calling add_submap().  std::recursive_mutex allows
-        /// mapgen code (running under a held lock) to call lookup_submap_in_memory()
-        /// or add_submap() without deadlocking.
-        mutable std::recursive_mutex submaps_mutex_;
+        /// mapgen code (running under a held lock) to call add_submap() without
+        /// deadlocking.
+        using submaps_mutex_type =
+            lock_stats::counted<std::recursive_mutex, "mapbuffer::submaps_mutex_">;
+        mutable TracyLockable( submaps_mutex_type, submaps_mutex_ );
+
+        /// Non-owning copy of `submaps` for lookup_submap_in_memory(), locked per shard
+        /// so that main-thread lookups do not serialize behind preload and mapgen
+        /// workers holding @c submaps_mutex_.  Updated alongside every insertion into
+        /// and removal from `submaps`, by writers that hold @c submaps_mutex_ or that
+        /// own the buffer exclusively.
+        sharded_map<tripoint_abs_sm, submap *> resident_index_;
 
         /// Submaps that preload_omt() could not add (duplicate already in memory).
         /// Their destruction is deferred here and drained on the main thread via
@@ -831,19 +858,22 @@ class mapbuffer
          */
         template<typename Fn>
         void for_each_submap( Fn &&fn ) {
-            std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+            std::lock_guard lk( submaps_mutex_ );
             for( std::pair<const tripoint_abs_sm, std::unique_ptr<submap>> &entry : submaps ) {
                 fn( entry );
             }
         }
 
         auto loaded_submap_count() const -> std::size_t {
-            std::lock_guard<std::recursive_mutex> lk( submaps_mutex_ );
+            std::lock_guard lk( submaps_mutex_ );
             return submaps.size();
         }
 
+        /** Approximate bytes held by the resident submaps and the unsaved writes. */
+        auto memory_usage() const -> std::size_t;
+
         bool is_submap_loaded( const tripoint_abs_sm &p ) const {
-            return submaps.contains( p );
+            return resident_index_.contains( p );
         }
 
         /** Return true if no submaps are currently held in this buffer. */
@@ -904,6 +934,30 @@ class mapbuffer
             JsonIn &jsin,
             std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &out,
             const std::function<bool( const tripoint_abs_sm & )> &skip_if = nullptr );
+        /**
+         * Parse an omt blob in either save format into @p out; see
+         * deserialize_into_vec().  Binary blobs are recognised by their magic.
+         */
+        void deserialize_omt_blob(
+            std::string_view blob,
+            std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &out,
+            const std::function<bool( const tripoint_abs_sm & )> &skip_if = nullptr );
+        /** deserialize_omt_blob() of a stream from world::read_map_omt_data(). */
+        void deserialize_omt_blob(
+            std::istream &fin,
+            std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &out,
+            const std::function<bool( const tripoint_abs_sm & )> &skip_if = nullptr );
+        /**
+         * Add submaps parsed by the preload functions.  Duplicates of resident
+         * submaps are queued for drain_pending_submap_destroy().
+         */
+        void add_preloaded_submaps(
+            std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> &loaded );
+        /**
+         * Write the resident submaps among @p addrs as one omt blob: binary when
+         * BINARY_MAP_SAVES is on, JSON otherwise.
+         */
+        void serialize_omt( std::ostream &out, std::span<const tripoint_abs_sm> addrs ) const;
         void save_omt( const tripoint_abs_omt &omt_addr, std::list<tripoint_abs_sm> &submaps_to_delete,
                        bool delete_after_save );
         auto for_each_simulated_submap_position(
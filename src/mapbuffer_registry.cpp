@@ -100,7 +100,7 @@ void mapbuffer_registry::save_all( bool delete_after_save )
     // parallelised over OMTs, so this gives a second level of parallelism when
     // multiple dimensions are loaded.  show_progress=false suppresses UI popup calls
     // that are not safe off the main thread.
-    parallel_for( 0, static_cast<int>( dim_ids.size() ), [&]( int i ) {
+    parallel_for( "mapbuffer_save_all", 0, static_cast<int>( dim_ids.size() ), [&]( int i ) {
         const auto &dim_id = dim_ids[i];
         const auto is_primary = dim_id == primary_dimension_id();
         // notify_tracker only for primary; show_progress=false (worker thread).
@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <iterator>
+#include <limits>
 #include <map>
 #include <memory>
 #include <unordered_map>
@@ -1062,14 +1063,123 @@ void set_ter_ids()
             ter.trap = trap_str_id( ter.trap_id_str );
         }
     }
+    cache_attr::rebuild_ter();
 }
 
 void reset_furn_ter()
 {
     terrain_data.reset();
     furniture_data.reset();
+    cache_attr::ter_table.clear();
+    cache_attr::furn_table.clear();
 }
 
+namespace cache_attr
+{
+
+table ter_table;
+table furn_table;
+
+auto table::clear() -> void
+{
+    flags.clear();
+    move_cost.clear();
+    bash_str_min.clear();
+    bash_str_max.clear();
+}
+
+auto table::push_back( const entry &e ) -> void
+{
+    const auto narrow = []( const int v ) {
+        return static_cast<std::int16_t>( std::clamp<int>( v, std::numeric_limits<std::int16_t>::min(),
+                                          std::numeric_limits<std::int16_t>::max() ) );
+    };
+    flags.push_back( e.flags );
+    move_cost.push_back( narrow( e.move_cost ) );
+    bash_str_min.push_back( narrow( e.bash_str_min ) );
+    bash_str_max.push_back( narrow( e.bash_str_max ) );
+}
+
+/** Flags terrain and furniture share; @p permeable is the type's own permeability rule. */
+static auto common_flags( const map_data_common_t &data, const bool is_null,
+                          const bool permeable ) -> std::uint32_t
+{
+    auto flags = std::uint32_t{ 0 };
+    const auto set = [&flags]( const bool cond, const std::uint32_t bit ) {
+        flags |= cond ? bit : 0;
+    };
+    set( data.transparent, transparent );
+    set( !is_null, present );
+    set( data.has_flag( TFLAG_NO_FLOOR ), ledge );
+    set( data.has_flag( TFLAG_SHARP ), sharp );
+    set( data.has_flag( TFLAG_CLIMBABLE ), climbable );
+    set( data.has_flag( "OPENCLOSE_INSIDE" ), opens_inside );
+    set( data.has_flag( TFLAG_GOES_DOWN ) || data.has_flag( TFLAG_GOES_UP ) ||
+         data.has_flag( TFLAG_RAMP ) || data.has_flag( TFLAG_RAMP_UP ) ||
+         data.has_flag( TFLAG_RAMP_DOWN ), changes_level );
+    set( data.bash.bash_below, bash_below );
+    set( permeable, cache_attr::permeable );
+    set( data.has_flag( TFLAG_NO_SCENT ), no_scent );
+    set( data.has_flag( TFLAG_BLOCK_WIND ), block_wind );
+    set( data.has_flag( TFLAG_WALL ), wall );
+    set( data.has_flag( TFLAG_CONNECT_TO_WALL ), connect_to_wall );
+    set( data.has_flag( TFLAG_ROAD ), road );
+    return flags;
+}
+
+static auto compute_entry( const ter_t &ter ) -> entry
+{
+    auto flags = common_flags( ter, ter.id.is_null(),
+                               ter.has_flag( TFLAG_PERMEABLE ) || ter.has_flag( TFLAG_REDUCE_SCENT ) );
+    if( ter.has_flag( TFLAG_NO_FLOOR ) || ter.has_flag( TFLAG_Z_TRANSPARENT ) ) {
+        flags |= no_floor;
+    }
+    if( ter.open ) {
+        flags |= openable;
+    }
+    return entry{ flags, ter.movecost, ter.bash.str_min, ter.bash.str_max };
+}
+
+static auto compute_entry( const furn_t &furn ) -> entry
+{
+    auto flags = common_flags( furn, furn.id.is_null(), furn.has_flag( TFLAG_PERMEABLE ) );
+    if( furn.has_flag( TFLAG_SUN_ROOF_ABOVE ) ) {
+        flags |= sun_roof_above;
+    }
+    if( furn.open ) {
+        flags |= openable;
+    }
+    return entry{ flags, furn.movecost, furn.bash.str_min, furn.bash.str_max };
+}
+
+auto compute( const ter_id &id ) -> entry
+{
+    return compute_entry( id.obj() );
+}
+
+auto compute( const furn_id &id ) -> entry
+{
+    return compute_entry( id.obj() );
+}
+
+auto rebuild_ter() -> void
+{
+    ter_table.clear();
+    for( const ter_t &ter : terrain_data.get_all() ) {
+        ter_table.push_back( compute_entry( ter ) );
+    }
+}
+
+auto rebuild_furn() -> void
+{
+    furn_table.clear();
+    for( const furn_t &furn : furniture_data.get_all() ) {
+        furn_table.push_back( compute_entry( furn ) );
+    }
+}
+
+} // namespace cache_attr
+
 furn_id f_null,
         f_hay,
         f_rubble, f_rubble_rock, f_wreckage, f_ash,
@@ -1817,7 +1927,7 @@ void finalize_furn()
         }
     }
     build_fluid_grid_variant_maps();
-
+    cache_attr::rebuild_furn();
 }
 
 int activity_byproduct::roll() const
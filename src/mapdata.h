@@ -3,9 +3,11 @@
 #include <array>
 #include <bitset>
 #include <cstddef>
+#include <cstdint>
 #include <optional>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "active_tile_data.h"
@@ -696,6 +698,111 @@ void verify_terrain();
 auto fluid_grid_connected_variant( const furn_id &id ) -> std::optional<furn_id>;
 auto fluid_grid_disconnected_variant( const furn_id &id ) -> std::optional<furn_id>;
 
+/**
+ * The terrain and furniture properties read by the per-tile caches, the pathfinders and
+ * the sound absorption builder, as flat tables indexed by int_id: one array per
+ * attribute.  Readers resolve an id with one array load instead of following
+ * ter_t/furn_t and testing its flag set; cache builders resolve them once per distinct
+ * id of a submap (see palette_grid::map_cells).
+ * Filled by set_ter_ids/finalize_furn; ids past the tables are resolved directly.
+ */
+namespace cache_attr
+{
+
+enum : std::uint32_t {
+    transparent = 1 << 0,      ///< ter_t/furn_t::transparent
+    no_floor = 1 << 1,         ///< Terrain with NO_FLOOR or Z_TRANSPARENT
+    sun_roof_above = 1 << 2,   ///< Furniture with SUN_ROOF_ABOVE
+    ledge = 1 << 3,            ///< NO_FLOOR
+    sharp = 1 << 4,            ///< SHARP
+    climbable = 1 << 5,        ///< CLIMBABLE
+    openable = 1 << 6,         ///< Has an `open` transformation
+    opens_inside = 1 << 7,     ///< OPENCLOSE_INSIDE
+    changes_level = 1 << 8,    ///< GOES_DOWN, GOES_UP, RAMP, RAMP_UP or RAMP_DOWN
+    bash_below = 1 << 9,       ///< map_bash_info::bash_below
+    // Inputs of submap::rebuild_absorption_cache
+    permeable = 1 << 10,       ///< PERMEABLE, or REDUCE_SCENT on terrain
+    no_scent = 1 << 11,        ///< NO_SCENT
+    block_wind = 1 << 12,      ///< BLOCK_WIND
+    wall = 1 << 13,            ///< WALL
+    connect_to_wall = 1 << 14, ///< CONNECT_TO_WALL
+    road = 1 << 15,            ///< ROAD
+    present = 1 << 16,         ///< Any id but the null one
+};
+
+/** Everything the tables hold about one id. */
+struct entry {
+    std::uint32_t flags = 0;
+    int move_cost = 0;
+    int bash_str_min = 0;
+    int bash_str_max = -1;
+};
+
+/** The attributes of every terrain or every furniture, one array per attribute. */
+struct table {
+    std::vector<std::uint32_t> flags;
+    std::vector<std::int16_t> move_cost;
+    std::vector<std::int16_t> bash_str_min;
+    std::vector<std::int16_t> bash_str_max;
+
+    auto size() const -> std::size_t {
+        return flags.size();
+    }
+    auto clear() -> void;
+    auto push_back( const entry &e ) -> void;
+};
+
+extern table ter_table;
+extern table furn_table;
+
+auto compute( const ter_id &id ) -> entry;
+auto compute( const furn_id &id ) -> entry;
+auto rebuild_ter() -> void;
+auto rebuild_furn() -> void;
+
+inline auto table_for( const ter_id & ) -> const table &
+{
+    return ter_table;
+}
+
+inline auto table_for( const furn_id & ) -> const table &
+{
+    return furn_table;
+}
+
+/** Flag bits of @p id */
+template<typename Id>
+inline auto of( const Id &id ) -> std::uint32_t
+{
+    const auto &t = table_for( id );
+    const auto i = static_cast<std::size_t>( id.to_i() );
+    return i < t.size() ? t.flags[i] : compute( id ).flags;
+}
+
+/** ter_t/furn_t::movecost of @p id */
+template<typename Id>
+inline auto move_cost( const Id &id ) -> int
+{
+    const auto &t = table_for( id );
+    const auto i = static_cast<std::size_t>( id.to_i() );
+    return i < t.size() ? t.move_cost[i] : compute( id ).move_cost;
+}
+
+/** map_bash_info::str_min and str_max of @p id; str_max is -1 if it cannot be bashed */
+template<typename Id>
+inline auto bash_strength( const Id &id ) -> std::pair<int, int>
+{
+    const auto &t = table_for( id );
+    const auto i = static_cast<std::size_t>( id.to_i() );
+    if( i < t.size() ) {
+        return { t.bash_str_min[i], t.bash_str_max[i] };
+    }
+    const auto e = compute( id );
+    return { e.bash_str_min, e.bash_str_max };
+}
+
+} // namespace cache_attr
+
 /*
 runtime index: ter_id
 ter_id refers to a position in the terlist[] where the ter_t struct is stored. These global
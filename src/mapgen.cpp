@@ -195,7 +195,7 @@ auto mapgen_constructor::generate( const tripoint_abs_omt &omt_pos, const time_p
                 if( extra == nullptr ) {
                     debugmsg( "failed to pick extra for type %s", terrain_type->get_extras() );
                 } else {
-                    MapExtras::apply_function( *( ex.values.pick() ), *this, omt_pos );
+                    MapExtras::apply_function( *extra, *this, omt_pos );
                 }
             }
         }
@@ -278,6 +278,7 @@ class mapgen_basic_container
     private:
         std::vector<std::shared_ptr<mapgen_function>> mapgens_;
         weighted_int_list<std::shared_ptr<mapgen_function>> weights_;
+        std::optional<ter_id> uniform_terrain_;
 
     public:
         int add( const std::shared_ptr<mapgen_function> &ptr ) {
@@ -355,6 +356,14 @@ class mapgen_basic_container
             for( auto &mapgen_function_ptr : weights_ ) {
                 mapgen_function_ptr.obj->finalize_parameters();
             }
+            uniform_terrain_ = find_uniform_terrain();
+        }
+        /**
+         * The terrain every function here fills the whole map with, if they all do only that.
+         * Such maps come out the same every time, so they needn't be run at all.
+         */
+        auto uniform_terrain() const -> std::optional<ter_id> {
+            return uniform_terrain_;
         }
         void check_consistency( const std::string &key ) {
             for( auto &mapgen_function_ptr : weights_ ) {
@@ -370,6 +379,20 @@ class mapgen_basic_container
             }
             return result;
         }
+
+    private:
+        auto find_uniform_terrain() const -> std::optional<ter_id> {
+            auto result = std::optional<ter_id> {};
+            for( const weighted_object<int, std::shared_ptr<mapgen_function>> &p : weights_ ) {
+                const auto *const json_func = dynamic_cast<const mapgen_function_json *>( p.obj.get() );
+                const auto fill = json_func ? json_func->uniform_terrain() : std::nullopt;
+                if( !fill || ( result && *result != *fill ) ) {
+                    return std::nullopt;
+                }
+                result = fill;
+            }
+            return result;
+        }
 };
 
 class mapgen_factory
@@ -471,6 +494,13 @@ class mapgen_factory
         auto has_any_direct_lua_generator() const -> bool {
             return any_direct_lua_generator_;
         }
+        auto uniform_terrain( const std::string &key ) const -> std::optional<ter_id> {
+            const auto iter = mapgens_.find( disable_mapgen ? "test" : key );
+            if( iter == mapgens_.end() ) {
+                return std::nullopt;
+            }
+            return iter->second.uniform_terrain();
+        }
         mapgen_parameters get_map_special_params( const std::string &key ) const {
             const auto iter = mapgens_.find( key );
             if( iter == mapgens_.end() ) {
@@ -1436,6 +1466,13 @@ class mapgen_value
         Id get( const mapgendata &dat ) const {
             return source_->get( dat );
         }
+        /** The value when it's a plain id, rather than a parameter, distribution or switch. */
+        std::optional<Id> constant() const {
+            if( const auto *src = dynamic_cast<const id_source *>( source_.get() ) ) {
+                return src->id;
+            }
+            return std::nullopt;
+        }
         std::vector<StringId> all_possible_results( const mapgen_parameters &params ) const {
             return source_->all_possible_results( params );
         }
@@ -2563,6 +2600,45 @@ class jmapgen_terrain : public jmapgen_piece
             id.check( oter_name, parameters );
         }
 };
+/**
+ * Fixed terrain or furniture for a run of cells, merged from single placements by
+ * @ref jmapgen_objects::finalize.  Cells are relative to the point it's applied at.
+ */
+template<typename Id>
+class jmapgen_fixed_cells : public jmapgen_piece
+{
+    public:
+        std::vector<std::pair<point_rel_ms, Id>> cells;
+
+        mapgen_phase phase() const override {
+            return std::is_same_v<Id, ter_id> ? mapgen_phase::terrain : mapgen_phase::furniture;
+        }
+
+        void apply( const mapgendata &dat, const jmapgen_int &x, const jmapgen_int &y
+                  ) const override {
+            const point_rel_ms origin( x.get(), y.get() );
+            for( const auto &[rel, id] : cells ) {
+                const point_omt_ms p( ( origin + rel ).raw() );
+                if constexpr( std::is_same_v<Id, ter_id> ) {
+                    // Same as jmapgen_terrain
+                    dat.m.ter_set( p, id );
+                    if( dat.m.has_flag_ter( TFLAG_WALL, p ) ) {
+                        dat.m.furn_set( p, f_null );
+                        if( !dat.m.has_flag_ter( "PLACE_ITEM", p ) ) {
+                            dat.m.i_clear( p );
+                        }
+                    }
+                } else {
+                    dat.m.furn_set( p, id );
+                }
+            }
+        }
+        bool has_vehicle_collision( const mapgendata &dat, const point_rel_ms &p ) const override {
+            return std::ranges::any_of( cells, [&]( const auto & cell ) {
+                return dat.m.veh_at( point_omt_ms( ( p + cell.first ).raw() ) ).has_value();
+            } );
+        }
+};
 /**
  * Run a transformation.
  * "transform": id of the ter_furn_transform to run.
@@ -3932,6 +4008,55 @@ void jmapgen_objects::finalize()
     []( const jmapgen_obj & l, const jmapgen_obj & r ) {
         return l.second->phase() < r.second->phase();
     } );
+
+    // Fixed terrain and furniture at fixed points, which is most of what "rows" turns into,
+    // is merged into a piece per consecutive run.  Generation then sets them without a
+    // virtual call, value lookup and repeat roll per cell.  None of the merged placements
+    // draw random numbers, so the maps generated with a given seed are unchanged.
+    const auto fixed_point = []( const jmapgen_obj & obj ) -> std::optional<point_rel_ms> {
+        const jmapgen_place &where = obj.first;
+        const jmapgen_int &repeat = obj.second->repeat;
+        if( where.x.val != where.x.valmax || where.y.val != where.y.valmax ||
+            where.repeat.val != 1 || where.repeat.valmax != 1 ||
+            repeat.val != 1 || repeat.valmax != 1 ) {
+            return std::nullopt;
+        }
+        return point_rel_ms( where.x.val, where.y.val );
+    };
+    std::vector<jmapgen_obj> merged;
+    merged.reserve( objects.size() );
+    shared_ptr_fast<jmapgen_fixed_cells<ter_id>> ter_run;
+    shared_ptr_fast<jmapgen_fixed_cells<furn_id>> furn_run;
+    for( jmapgen_obj &obj : objects ) {
+        const std::optional<point_rel_ms> p = fixed_point( obj );
+        const auto *ter = dynamic_cast<const jmapgen_terrain *>( obj.second.get() );
+        const auto *furn = dynamic_cast<const jmapgen_furniture *>( obj.second.get() );
+        const std::optional<ter_id> ter_value = p && ter ? ter->id.constant() : std::nullopt;
+        const std::optional<furn_id> furn_value = p && furn ? furn->id.constant() : std::nullopt;
+        if( ter_value && !ter_value->id().is_null() ) {
+            furn_run.reset();
+            if( !ter_run ) {
+                ter_run = make_shared_fast<jmapgen_fixed_cells<ter_id>>();
+                merged.emplace_back( jmapgen_place(), ter_run );
+            }
+            ter_run->cells.emplace_back( *p, *ter_value );
+        } else if( furn_value && !furn_value->id().is_null() ) {
+            ter_run.reset();
+            if( !furn_run ) {
+                furn_run = make_shared_fast<jmapgen_fixed_cells<furn_id>>();
+                merged.emplace_back( jmapgen_place(), furn_run );
+            }
+            furn_run->cells.emplace_back( *p, *furn_value );
+        } else if( ( ter_value || furn_value ) ) {
+            // Null ids place nothing
+            continue;
+        } else {
+            ter_run.reset();
+            furn_run.reset();
+            merged.push_back( std::move( obj ) );
+        }
+    }
+    objects = std::move( merged );
 }
 
 void jmapgen_objects::check( const std::string &oter_name,
@@ -4211,6 +4336,15 @@ void mapgen_function_json::generate( mapgendata &md )
     }
 }
 
+auto mapgen_function_json::uniform_terrain() const -> std::optional<ter_id>
+{
+    if( fill_ter == t_null || predecessor_mapgen != oter_str_id::NULL_ID() ||
+        !setmap_points.empty() || !objects.empty() ) {
+        return std::nullopt;
+    }
+    return fill_ter;
+}
+
 mapgen_parameters mapgen_function_json::get_mapgen_params( mapgen_parameter_scope scope ) const
 {
     return parameters.params_for_scope( scope );
@@ -5980,6 +6114,7 @@ void map::add_spawn( const mtype_id &type, int count, const tripoint_bub_ms &p,
     }
     spawn_point tmp( type, count, offset, faction_id, mission_id, disposition, name );
     place_on_submap->spawns.push_back( tmp );
+    place_on_submap->mark_modified();
 }
 
 vehicle *map::add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
@@ -6040,6 +6175,7 @@ vehicle *map::add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
         auto *place_on_submap = get_mapbuffer().lookup_submap_in_memory( placed_vehicle->abs_sm_pos );
         place_on_submap->vehicles.push_back( std::move( placed_vehicle_up ) );
         place_on_submap->is_uniform = false;
+        place_on_submap->mark_modified();
         invalidate_max_populated_zlev( placed_vehicle_sm.z() );
 
         auto &ch = get_cache( placed_vehicle_sm.z() );
@@ -6702,11 +6838,17 @@ auto mapgen_function_needs_main_thread( const std::shared_ptr<mapgen_function> &
     if( func->is_lua_generator() ) {
         return true;
     }
-    const auto json_func = std::dynamic_pointer_cast<mapgen_function_json>( func );
+    // Asked from every generation worker, so don't bump the shared reference count.
+    const auto *json_func = dynamic_cast<const mapgen_function_json *>( func.get() );
     return json_func && json_func->predecessor_mapgen != oter_str_id::NULL_ID() &&
            oter_mapgen.has_direct_lua_generator( json_func->predecessor_mapgen.id().str() );
 }
 
+auto uniform_mapgen_terrain( const std::string &mapgen_id ) -> std::optional<ter_id>
+{
+    return oter_mapgen.uniform_terrain( mapgen_id );
+}
+
 auto mapgen_has_any_direct_lua_generator() -> bool
 {
     return oter_mapgen.has_any_direct_lua_generator();
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <memory>
+#include <optional>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
@@ -372,6 +373,10 @@ struct jmapgen_objects {
         void check( const std::string &oter_name, const mapgen_parameters & ) const;
         void finalize();
 
+        bool empty() const {
+            return objects.empty();
+        }
+
         void merge_parameters_into( mapgen_parameters &, const std::string &outer_context ) const;
 
         void apply( const mapgendata &dat ) const;
@@ -446,6 +451,12 @@ class mapgen_function_json : public mapgen_function_json_base, public virtual ma
                               const point_rel_omt &grid_offset, const point_rel_omt & );
         ~mapgen_function_json() override = default;
 
+        /**
+         * The terrain this mapgen fills the whole map with, if that is all it does: only a
+         * "fill_ter", with no predecessor, setmaps or placements of any kind.
+         */
+        auto uniform_terrain() const -> std::optional<ter_id>;
+
         ter_id fill_ter;
         oter_id predecessor_mapgen;
 
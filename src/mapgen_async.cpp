@@ -13,6 +13,7 @@
 #include "catalua.h"
 #include "color.h"
 #include "init.h"
+#include "lock_stats.h"
 #include "map.h"
 #include "map_extras.h"
 #include "mapbuffer_registry.h"
@@ -27,10 +28,12 @@
 namespace
 {
 
-std::mutex                        g_hook_mutex;
+using hook_mutex_type = lock_stats::counted<std::mutex, "mapgen_async::g_hook_mutex">;
+TracyLockable( hook_mutex_type, g_hook_mutex );
 std::vector<deferred_mapgen_hook> g_hooks;
 
-std::mutex                      g_autonote_mutex;
+using autonote_mutex_type = lock_stats::counted<std::mutex, "mapgen_async::g_autonote_mutex">;
+TracyLockable( autonote_mutex_type, g_autonote_mutex );
 std::vector<deferred_autonote>  g_autonotes;
 
 // Cached flag: are any on_mapgen_postprocess hooks registered?
@@ -47,7 +50,7 @@ void push_deferred_mapgen_hook( deferred_mapgen_hook h )
     if( !g_has_mapgen_hooks.load( std::memory_order_relaxed ) ) {
         return;
     }
-    std::lock_guard<std::mutex> lk( g_hook_mutex );
+    std::lock_guard lk( g_hook_mutex );
     g_hooks.push_back( std::move( h ) );
 }
 
@@ -58,6 +61,11 @@ void refresh_mapgen_postprocess_hook_presence( cata::lua_state &state )
         std::memory_order_relaxed );
 }
 
+auto mapgen_postprocess_hooks_present() -> bool
+{
+    return g_has_mapgen_hooks.load( std::memory_order_relaxed );
+}
+
 bool mapgen_hooks_registered()
 {
     return g_has_mapgen_hooks.load( std::memory_order_relaxed );
@@ -65,7 +73,7 @@ bool mapgen_hooks_registered()
 
 void push_deferred_autonote( deferred_autonote entry )
 {
-    std::lock_guard<std::mutex> lk( g_autonote_mutex );
+    std::lock_guard lk( g_autonote_mutex );
     g_autonotes.push_back( std::move( entry ) );
 }
 
@@ -73,7 +81,7 @@ void run_deferred_autonotes()
 {
     std::vector<deferred_autonote> pending;
     {
-        std::lock_guard<std::mutex> lk( g_autonote_mutex );
+        std::lock_guard lk( g_autonote_mutex );
         pending.swap( g_autonotes );
     }
     if( pending.empty() ) {
@@ -113,7 +121,7 @@ void run_deferred_mapgen_hooks()
     // Drain under the lock, then process without holding it.
     std::vector<deferred_mapgen_hook> pending;
     {
-        std::lock_guard<std::mutex> lk( g_hook_mutex );
+        std::lock_guard lk( g_hook_mutex );
         pending.swap( g_hooks );
     }
 
@@ -58,6 +58,9 @@ void push_deferred_mapgen_hook( deferred_mapgen_hook h );
  */
 void refresh_mapgen_postprocess_hook_presence( cata::lua_state &state );
 
+/** The flag last set by refresh_mapgen_postprocess_hook_presence().  Safe from any thread. */
+auto mapgen_postprocess_hooks_present() -> bool;
+
 /**
  * Drain all deferred hooks and run each one on the main thread.
  *
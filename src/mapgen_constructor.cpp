@@ -203,6 +203,7 @@ auto mapgen_constructor::clear_spawns() -> void
 {
     for_each_submap( []( submap & sm ) {
         sm.spawns.clear();
+        sm.mark_modified();
     } );
 }
 
@@ -492,6 +493,7 @@ auto mapgen_constructor::furn_set( const point_omt_ms &p, const furn_id &furnitu
         atd.reset( new_furniture.active->clone() );
         atd->set_last_updated( calendar::turn );
         sm->active_furniture[local] = atd;
+        sm->mark_modified();
     }
     return true;
 }
@@ -556,8 +558,7 @@ auto mapgen_constructor::add_field( const point_omt_ms &p, const field_type_id &
                            type_id, field_intensity, age );
     sm->is_uniform = false;
     if( added ) {
-        sm->field_count++;
-        sm->field_cache.push_back( local );
+        sm->note_field_added( local, type_id );
     }
     return true;
 }
@@ -652,6 +653,7 @@ auto mapgen_constructor::add_item( const point_omt_ms &p, detached_ptr<item> &&n
         sm->active_items.add( *new_item );
     }
     sm->get_items( local ).push_back( std::move( new_item ) );
+    sm->note_item_added( local );
 }
 
 auto mapgen_constructor::add_item_or_charges( const point_omt_ms &pos,
@@ -1176,6 +1178,7 @@ auto mapgen_constructor::add_spawn( const mtype_id &type, const int count,
     }
     const auto offset = project_remain<coords::sm>( p ).remainder;
     sm->spawns.emplace_back( type, count, offset, faction_id, mission_id, disposition, name );
+    sm->mark_modified();
 }
 
 auto mapgen_constructor::add_vehicle( const std::variant<vgroup_id, vproto_id> &type_,
@@ -1215,6 +1218,7 @@ auto mapgen_constructor::add_vehicle( const std::variant<vgroup_id, vproto_id> &
         auto *const real_result = result.get();
         place_on_submap->vehicles.push_back( std::move( result ) );
         place_on_submap->is_uniform = false;
+        place_on_submap->mark_modified();
         return real_result;
     }
     return nullptr;
@@ -1324,6 +1328,7 @@ auto mapgen_constructor::detach_vehicle( vehicle *veh ) -> std::unique_ptr<vehic
     if( iter != sm->vehicles.end() ) {
         std::unique_ptr<vehicle> result = std::move( *iter );
         sm->vehicles.erase( iter );
+        sm->mark_modified();
         result->detach();
         result->refresh_position();
         return std::move( result );
@@ -1347,6 +1352,7 @@ auto mapgen_constructor::destroy_vehicle( vehicle *veh ) -> void
     } );
     if( iter != sm->vehicles.end() ) {
         sm->vehicles.erase( iter );
+        sm->mark_modified();
     }
 }
 
@@ -3,6 +3,7 @@
 #include <functional>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -101,6 +102,8 @@ bool run_mapgen_update_func( const std::string &update_mapgen_id, mapgendata &da
 bool run_mapgen_func( const std::string &mapgen_id, mapgendata &dat );
 auto pick_mapgen_func( const std::string &mapgen_id ) -> std::shared_ptr<mapgen_function>;
 auto mapgen_function_needs_main_thread( const std::shared_ptr<mapgen_function> &func ) -> bool;
+/** Terrain that every mapgen for @p mapgen_id fills the map with and does nothing else. */
+auto uniform_mapgen_terrain( const std::string &mapgen_id ) -> std::optional<ter_id>;
 auto mapgen_has_any_direct_lua_generator() -> bool;
 auto mapgen_id_has_direct_lua_generator( const std::string &mapgen_id ) -> bool;
 std::pair<std::map<ter_id, int>, std::map<furn_id, int>> get_changed_ids_from_update(
@@ -1,5 +1,7 @@
 #include "memorial_logger.h"
 
+#include <algorithm>
+#include <chrono>
 #include <istream>
 #include <list>
 #include <map>
@@ -78,6 +80,11 @@ static const trap_str_id tr_drain( "tr_drain" );
 static const trap_str_id tr_snake( "tr_snake" );
 static const trap_str_id tr_glass_pit( "tr_glass_pit" );
 
+// Chunks saved before the base file is rewritten.
+static constexpr int max_memorial_chunks = 32;
+static const std::string memorial_epoch_marker( "#memorial_epoch " );
+static const std::string memorial_chunk_marker( "#memorial_chunk " );
+
 static const trait_id trait_CANNIBAL( "CANNIBAL" );
 static const trait_id trait_PSYCHOPATH( "PSYCHOPATH" );
 static const trait_id trait_SAPIOVORE( "SAPIOVORE" );
@@ -85,6 +92,9 @@ static const trait_id trait_SAPIOVORE( "SAPIOVORE" );
 void memorial_logger::clear()
 {
     log.clear();
+    saved_entries = 0;
+    saved_chunks = 0;
+    needs_base = true;
 }
 
 /**
@@ -115,10 +125,9 @@ void memorial_logger::add( const std::string &male_msg,
  * entry lines begin with a pipe (|).
  * @param fin The ifstream to read the memorial entries from.
  */
-void memorial_logger::load( std::istream &fin )
+void memorial_logger::read_entries( std::istream &fin )
 {
     std::string entry;
-    log.clear();
     while( fin.peek() == '|' ) {
         getline( fin, entry );
         // strip all \r from end of string
@@ -129,6 +138,91 @@ void memorial_logger::load( std::istream &fin )
     }
 }
 
+/**
+ * Reads the epoch after the entries of a base file, or at the start of a chunk.
+ * Older saves have none, which reads as 0.
+ */
+static uint64_t read_epoch( std::istream &fin, const std::string &marker )
+{
+    std::string line;
+    if( !getline( fin, line ) || !line.starts_with( marker ) ) {
+        return 0;
+    }
+    try {
+        return std::stoull( line.substr( marker.size() ) );
+    } catch( const std::exception & ) {
+        return 0;
+    }
+}
+
+void memorial_logger::load( const chunk_reader &read )
+{
+    const bool has_base = read( "", [&]( std::istream & fin ) {
+        log.clear();
+        read_entries( fin );
+        epoch = read_epoch( fin, memorial_epoch_marker );
+    } );
+    if( !has_base ) {
+        return;
+    }
+    saved_chunks = 0;
+    // Saves from before chunking get a base file with an epoch on the next save.
+    needs_base = epoch == 0;
+    while( !needs_base ) {
+        bool matches = false;
+        const bool has_chunk = read( "." + std::to_string( saved_chunks + 1 ), [&]( std::istream & fin ) {
+            matches = read_epoch( fin, memorial_chunk_marker ) == epoch;
+            if( matches ) {
+                read_entries( fin );
+            }
+        } );
+        if( !has_chunk || !matches ) {
+            break;
+        }
+        saved_chunks++;
+    }
+    saved_entries = log.size();
+}
+
+bool memorial_logger::save( const chunk_writer &write )
+{
+    static const char *eol = cata_files::eol();
+
+    if( needs_base || saved_chunks >= max_memorial_chunks ) {
+        // Any epoch that differs from the last one works; the clock also keeps
+        // a new character from picking up a dead one's chunks.
+        const uint64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                                 std::chrono::system_clock::now().time_since_epoch() ).count();
+        const uint64_t new_epoch = std::max( now, epoch + 1 );
+        if( !write( "", [&]( std::ostream & fout ) {
+        fout << dump() << memorial_epoch_marker << new_epoch << eol;
+    } ) ) {
+            return false;
+        }
+        epoch = new_epoch;
+        saved_chunks = 0;
+        saved_entries = log.size();
+        needs_base = false;
+        return true;
+    }
+
+    if( saved_entries == log.size() ) {
+        return true;
+    }
+    const int chunk = saved_chunks + 1;
+    if( !write( "." + std::to_string( chunk ), [&]( std::ostream & fout ) {
+    fout << memorial_chunk_marker << epoch << eol;
+    std::for_each( log.begin() + saved_entries, log.end(), [&]( const std::string & entry ) {
+            fout << entry << eol;
+        } );
+    } ) ) {
+        return false;
+    }
+    saved_chunks = chunk;
+    saved_entries = log.size();
+    return true;
+}
+
 /**
  * Concatenates all of the memorial log entries, delimiting them with newlines,
  * and returns the resulting string. Used for saving and for writing out to the
@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <iosfwd>
 #include <string>
 #include <vector>
 
 #include "event_bus.h"
+#include "fstream_utils.h"
 #include "string_formatter.h"
 
 namespace cata
@@ -31,8 +35,17 @@ class memorial_logger : public event_subscriber
                         string_format( female_msg, args... ) );
         }
 
-        // Loads the memorial log from a file
-        void load( std::istream &fin );
+        // Storage of the log between saves.  Both take the suffix to append
+        // to the log's file name; the base file has an empty suffix.
+        using chunk_reader = std::function<bool( const std::string &suffix, file_read_fn )>;
+        using chunk_writer = std::function<bool( const std::string &suffix, file_write_fn )>;
+
+        // Loads the memorial log from its base file and the chunks saved after it
+        void load( const chunk_reader &read );
+        // Saves the entries added since the last save as a new chunk.  Every
+        // few saves, or when there is no base file yet, the whole log is
+        // rewritten to the base file instead, which makes the old chunks stale.
+        bool save( const chunk_writer &write );
         // Dumps all memorial events into a single newline-delimited string
         // (this is the content of the temporary file used to preserve the log
         // over saves, not the final memorial file).
@@ -43,7 +56,17 @@ class memorial_logger : public event_subscriber
 
         void notify( const cata::event & ) override;
     private:
+        // Reads entry lines, which all begin with a pipe (|)
+        void read_entries( std::istream &fin );
+
         std::vector<std::string> log;
+        // Entries already on disk, in the base file or a chunk
+        std::size_t saved_entries = 0;
+        int saved_chunks = 0;
+        // Written after the base file's entries and at the start of each of its
+        // chunks; chunks of an older base file do not match it.
+        uint64_t epoch = 0;
+        bool needs_base = true;
 };
 
 
@@ -0,0 +1,96 @@
+#include "memory_usage.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_set>
+
+#include "avatar.h"
+#include "cata_arena.h"
+#include "catalua.h"
+#include "item.h"
+#include "map.h"
+#include "map_memory.h"
+#include "mapbuffer.h"
+#include "mapbuffer_registry.h"
+#include "overmapbuffer.h"
+#include "overmapbuffer_registry.h"
+#include "pathfinding.h"
+#include "profile.h"
+#include "string_formatter.h"
+
+#if defined(TILES)
+#include "cata_tiles.h"
+#include "sdltiles.h"
+#endif
+
+namespace memory_usage
+{
+
+namespace
+{
+
+auto dimension_name( const dimension_id &dim ) -> std::string
+{
+    return dim.str().empty() ? std::string( "primary" ) : dim.str();
+}
+
+} // namespace
+
+auto collect() -> std::vector<owner_usage>
+{
+    ZoneScopedN( "memory_usage_collect" );
+    auto usage = std::vector<owner_usage>();
+    MAPBUFFER_REGISTRY.for_each( [&]( const dimension_id & dim, mapbuffer & buffer ) {
+        usage.push_back( { string_format( "submaps (%s)", dimension_name( dim ) ),
+                           buffer.memory_usage(), buffer.loaded_submap_count() } );
+    } );
+    for_each_overmapbuffer( [&]( const dimension_id & dim, overmapbuffer & omb ) {
+        const auto [count, bytes] = omb.memory_usage();
+        usage.push_back( { string_format( "overmaps (%s)", dimension_name( dim ) ), bytes, count } );
+    } );
+    usage.push_back( { "level caches", get_map().cache_memory_usage(), 0 } );
+    const auto [d_maps, d_map_bytes] = Pathfinding::memory_usage();
+    usage.push_back( { "pathfinding d_maps", d_map_bytes, d_maps } );
+    const map_memory &memory = get_avatar().get_map_memory();
+    usage.push_back( { "map memory", memory.memory_usage(), memory.memorized_submap_count() } );
+    usage.push_back( { "items (arena slabs)", cata_arena<item>::reserved_bytes(), 0 } );
+    usage.push_back( { "lua", cata::lua_memory_usage(), 0 } );
+#if defined(TILES)
+    if( tilecontext && tilecontext->current_tileset() != nullptr ) {
+        usage.push_back( { "tileset textures", tilecontext->current_tileset()->texture_memory_usage(),
+                           0 } );
+    }
+#endif
+    std::ranges::sort( usage, []( const owner_usage & a, const owner_usage & b ) {
+        return a.bytes > b.bytes;
+    } );
+    return usage;
+}
+
+void plot( const std::vector<owner_usage> &usage )
+{
+    // Tracy keeps the name pointers, so each name is kept for the life of the process
+    static auto plot_names = std::unordered_set<std::string>();
+    for( const owner_usage &owner : usage ) {
+        const std::string &name = *plot_names.insert( "Memory " + owner.name ).first;
+        TracyPlot( name.c_str(), static_cast<int64_t>( owner.bytes ) );
+    }
+}
+
+auto describe( const std::vector<owner_usage> &usage ) -> std::string
+{
+    constexpr auto mib = 1024.0 * 1024.0;
+    auto total = std::size_t{ 0 };
+    auto out = string_format( "%-28s %12s %10s\n", "owner", "MiB", "objects" );
+    for( const owner_usage &owner : usage ) {
+        total += owner.bytes;
+        out += string_format( "%-28s %12.1f %10s\n", owner.name,
+                              static_cast<double>( owner.bytes ) / mib,
+                              owner.count > 0 ? std::to_string( owner.count ) : std::string() );
+    }
+    out += string_format( "%-28s %12.1f\n", "total", static_cast<double>( total ) / mib );
+    out += "\nEstimated from what each owner holds, without allocator overhead.\n";
+    return out;
+}
+
+} // namespace memory_usage
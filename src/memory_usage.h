@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Rough byte counts of the large owners of game state, for the memory usage panel of
+ * the debug menu and for Tracy plots.
+ *
+ * Counts are estimated from what each owner holds (container capacities, allocated
+ * layers), not read from the allocator, so allocator overhead and anything not listed
+ * is missing from them.  Compare them against each other and over time, not against
+ * the resident size of the process.
+ */
+namespace memory_usage
+{
+
+struct owner_usage {
+    std::string name;
+    std::size_t bytes = 0;
+    // Objects held, e.g. submaps or overmaps; 0 where nothing is counted
+    std::size_t count = 0;
+};
+
+/** Heap bytes behind @p v, counting what is reserved rather than what is used. */
+template<typename T>
+auto capacity_bytes( const std::vector<T> &v ) -> std::size_t
+{
+    return v.capacity() * sizeof( T );
+}
+
+/** Every tracked owner, the largest first.  Main thread only. */
+auto collect() -> std::vector<owner_usage>;
+
+/** Sends @p usage to Tracy as one plot per owner, in bytes. */
+void plot( const std::vector<owner_usage> &usage );
+
+/** @p usage as a table for the debug menu. */
+auto describe( const std::vector<owner_usage> &usage ) -> std::string;
+
+} // namespace memory_usage
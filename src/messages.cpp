@@ -33,6 +33,8 @@
 #include <ranges>
 #include <map>
 #include <set>
+#include <unordered_map>
+#include <vector>
 
 namespace
 {
@@ -42,8 +44,6 @@ struct game_message : public JsonDeserializer, public JsonSerializer {
     time_point timestamp_in_turns  = calendar::start_of_cataclysm;
     int               timestamp_in_user_actions = 0;
     int               count = 1;
-    // number of times this message has been seen while it was in cooldown.
-    unsigned cooldown_seen = 1;
     // hide the message, because at some point it was in cooldown period.
     bool cooldown_hidden = false;
     game_message_type type  = m_neutral;
@@ -115,11 +115,81 @@ struct game_message : public JsonDeserializer, public JsonSerializer {
     }
 };
 
+/** The newest messages, in a fixed number of slots; adding to a full ring drops the oldest. */
+class message_ring
+{
+    public:
+        size_t size() const {
+            return count;
+        }
+        bool empty() const {
+            return count == 0;
+        }
+        /** @p i counts from the oldest message. */
+        const game_message &operator[]( const size_t i ) const {
+            return slots[( head + i ) % slots.size()];
+        }
+        game_message &back() {
+            return slots[( head + count - 1 ) % slots.size()];
+        }
+        const game_message &back() const {
+            return ( *this )[count - 1];
+        }
+
+        void clear() {
+            head = 0;
+            count = 0;
+        }
+
+        /** Keeps the newest messages that fit in @p capacity. */
+        void set_capacity( const size_t capacity ) {
+            if( capacity == slots.size() ) {
+                return;
+            }
+            const size_t kept = std::min( count, capacity );
+            std::vector<game_message> resized( capacity );
+            for( size_t i = 0; i < kept; ++i ) {
+                resized[i] = std::move( slots[( head + count - kept + i ) % slots.size()] );
+            }
+            slots = std::move( resized );
+            head = 0;
+            count = kept;
+        }
+
+        void push_back( game_message &&m ) {
+            if( count < slots.size() ) {
+                slots[( head + count ) % slots.size()] = std::move( m );
+                ++count;
+            } else {
+                slots[head] = std::move( m );
+                head = ( head + 1 ) % slots.size();
+            }
+        }
+
+    private:
+        std::vector<game_message> slots;
+        size_t head = 0;
+        size_t count = 0;
+};
+
 class messages_impl
 {
+    private:
+        struct cooldown_entry {
+            time_point start;
+            // number of times this message has been seen while it was in cooldown.
+            unsigned seen = 1;
+        };
+
     public:
-        std::deque<game_message> messages;   // Messages to be printed
-        std::vector<game_message> cooldown_templates; // Message cooldown
+        message_ring messages;   // Messages to be printed
+        /** Message cooldowns by message text. */
+        std::unordered_map<std::string, cooldown_entry> cooldowns;
+        /**
+         * Cooldown starts in the order they happened, to expire them from the front.
+         * A start that was moved later leaves its old entry behind, skipped on expiry.
+         */
+        std::deque<std::pair<time_point, std::string>> cooldown_starts;
         time_point curmes = calendar::turn_zero; // The last-seen message.
         bool active = true;
 
@@ -147,12 +217,10 @@ class messages_impl
             }
 
             // update the cooldown message timer due to coalescing
-            const auto cooldown_it = std::ranges::find_if( cooldown_templates,
-            [&m]( game_message & am ) -> bool {
-                return m.message == am.message;
-            } );
-            if( cooldown_it != cooldown_templates.end() ) {
-                cooldown_it->timestamp_in_turns = calendar::turn;
+            const auto cooldown_it = cooldowns.find( m.message );
+            if( cooldown_it != cooldowns.end() && cooldown_it->second.start != calendar::turn ) {
+                cooldown_it->second.start = calendar::turn;
+                cooldown_starts.emplace_back( calendar::turn, m.message );
             }
 
             // coalesce messages
@@ -195,12 +263,9 @@ class messages_impl
                 return;
             }
 
-            unsigned int message_limit = get_option<int>( "MESSAGE_LIMIT" );
-            while( messages.size() > message_limit ) {
-                messages.pop_front();
-            }
-
-            messages.emplace_back( m );
+            // One over the limit, as the log has always kept
+            messages.set_capacity( static_cast<size_t>( std::max( message_limit, 1 ) ) + 1 );
+            messages.push_back( std::move( m ) );
         }
 
         /** Check if the current message needs to be prevented (hidden) or not from being displayed in the side bar.
@@ -213,34 +278,30 @@ class messages_impl
                 return;
             }
 
-            // We look for **exactly the same** message string in the cooldown templates
+            // We look for **exactly the same** message string in the cooldowns
             // If there is one, this means the same message was already displayed.
-            const auto cooldown_it = std::ranges::find_if( cooldown_templates,
-            [&message]( game_message & m_cooldown ) -> bool {
-                return m_cooldown.message == message.message;
-            } );
-            if( cooldown_it == cooldown_templates.end() ) {
+            const auto cooldown_it = cooldowns.find( message.message );
+            if( cooldown_it == cooldowns.end() ) {
                 // nothing found, not in cooldown.
                 return;
             }
-
-            // note: from this point the current message (`message`) has the same string than one of the active cooldown template messages (`cooldown_it`).
+            const cooldown_entry &cooldown = cooldown_it->second;
 
             // check how much times this message has been seen during its cooldown.
             // If it's only one time, then no need to hide it.
-            if( cooldown_it->cooldown_seen == 1 ) {
+            if( cooldown.seen == 1 ) {
                 return;
             }
 
             // check if it's the message that started the cooldown timer.
-            if( message.turn() == cooldown_it->turn() ) {
+            if( message.turn() == cooldown.start ) {
                 return;
             }
 
             // current message turn.
             const auto cm_turn = to_turn<int>( message.turn() );
             // maximum range of the cooldown timer.
-            const auto max_cooldown_range = to_turn<int>( cooldown_it->turn() ) + message_cooldown;
+            const auto max_cooldown_range = to_turn<int>( cooldown.start ) + message_cooldown;
             // If the current message is in the cooldown range then hide it.
             if( cm_turn <= max_cooldown_range ) {
                 message.cooldown_hidden = true;
@@ -253,13 +314,11 @@ class messages_impl
             std::vector<std::pair<std::string, std::string>> result;
             result.reserve( count );
 
-            const int offset = static_cast<std::ptrdiff_t>( messages.size() - count );
-
-            std::transform( begin( messages ) + offset, end( messages ), back_inserter( result ),
-            []( const game_message & msg ) {
-                return std::make_pair( to_string_time_of_day( msg.timestamp_in_turns ),
-                                       msg.get_with_count() );
-            } );
+            for( size_t i = messages.size() - count; i < messages.size(); ++i ) {
+                const game_message &msg = messages[i];
+                result.emplace_back( to_string_time_of_day( msg.timestamp_in_turns ),
+                                     msg.get_with_count() );
+            }
 
             return result;
         }
@@ -274,17 +333,17 @@ class messages_impl
                 return;
             }
 
-            // housekeeping: remove any cooldown message with an expired cooldown time from the cooldown queue.
+            // housekeeping: remove any cooldown with an expired cooldown time.
             const auto now = calendar::turn;
-            for( auto it = cooldown_templates.begin(); it != cooldown_templates.end(); ) {
-                // number of turns elapsed since the cooldown started.
-                const auto turns = to_turns<int>( now - it->turn() );
-                if( turns >= message_cooldown ) {
+            while( !cooldown_starts.empty() &&
+                   to_turns<int>( now - cooldown_starts.front().first ) >= message_cooldown ) {
+                const auto &[start, text] = cooldown_starts.front();
+                const auto it = cooldowns.find( text );
+                if( it != cooldowns.end() && it->second.start == start ) {
                     // time elapsed! remove it.
-                    it = cooldown_templates.erase( it );
-                } else {
-                    ++it;
+                    cooldowns.erase( it );
                 }
+                cooldown_starts.pop_front();
             }
 
             // do not hide messages which bypasses cooldown.
@@ -292,18 +351,15 @@ class messages_impl
                 return;
             }
 
-            // Is the message string already in the cooldown queue?
-            // If it's not we must put it in the cooldown queue now, otherwise just increment the number of times we have seen it.
-            const auto cooldown_message_it = std::ranges::find_if( cooldown_templates,
-            [&message]( game_message & cooldown_message ) -> bool {
-                return cooldown_message.message == message.message;
-            } );
-            if( cooldown_message_it == cooldown_templates.end() ) {
-                // push current message to cooldown message templates.
-                cooldown_templates.emplace_back( message );
+            // Is the message string already in the cooldowns?
+            // If it's not we must start its cooldown now, otherwise just increment the number of times we have seen it.
+            const auto [it, inserted] = cooldowns.try_emplace( message.message,
+                                        cooldown_entry{ message.turn() } );
+            if( inserted ) {
+                cooldown_starts.emplace_back( message.turn(), message.message );
             } else {
                 // increment the number of time we have seen this message.
-                cooldown_message_it->cooldown_seen++;
+                it->second.seen++;
             }
         }
 };
@@ -328,7 +384,12 @@ void Messages::serialize( JsonOut &json )
 {
     json.member( "player_messages" );
     json.start_object();
-    json.member( "messages", player_messages.messages );
+    json.member( "messages" );
+    json.start_array();
+    for( size_t i = 0; i < player_messages.messages.size(); ++i ) {
+        json.write( player_messages.messages[i] );
+    }
+    json.end_array();
     json.member( "curmes", player_messages.curmes );
     json.end_object();
 }
@@ -340,7 +401,14 @@ void Messages::deserialize( const JsonObject &json )
     }
 
     JsonObject obj = json.get_object( "player_messages" );
-    obj.read( "messages", player_messages.messages );
+    std::vector<game_message> messages;
+    obj.read( "messages", messages );
+    player_messages.messages.set_capacity( std::max<size_t>( messages.size(),
+                                           static_cast<size_t>( std::max( message_limit, 1 ) ) + 1 ) );
+    player_messages.messages.clear();
+    for( game_message &m : messages ) {
+        player_messages.messages.push_back( std::move( m ) );
+    }
     obj.read( "curmes", player_messages.curmes );
 }
 
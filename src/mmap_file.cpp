@@ -0,0 +1,91 @@
+#include "mmap_file.h"
+
+#if defined(_WIN32)
+#   if !defined(WIN32_LEAN_AND_MEAN)
+#       define WIN32_LEAN_AND_MEAN
+#   endif
+#   if !defined(NOMINMAX)
+#       define NOMINMAX
+#   endif
+#   include <windows.h>
+#else
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#endif
+
+mmap_file::~mmap_file()
+{
+#if defined(_WIN32)
+    if( base_ != nullptr ) {
+        UnmapViewOfFile( base_ );
+    }
+    if( mapping_ != nullptr ) {
+        CloseHandle( mapping_ );
+    }
+    if( file_ != nullptr ) {
+        CloseHandle( file_ );
+    }
+#else
+    if( base_ != nullptr ) {
+        munmap( const_cast<char *>( base_ ), size_ );
+    }
+#endif
+}
+
+auto mmap_file::open( const std::string &path ) -> std::unique_ptr<mmap_file>
+{
+    auto mapped = std::unique_ptr<mmap_file>( new mmap_file() );
+#if defined(_WIN32)
+    const auto file = CreateFileA( path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE,
+                                   nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr );
+    if( file == INVALID_HANDLE_VALUE ) {
+        return nullptr;
+    }
+    mapped->file_ = file;
+    auto size = LARGE_INTEGER{};
+    if( !GetFileSizeEx( file, &size ) || size.QuadPart < 0 ) {
+        return nullptr;
+    }
+    if( size.QuadPart == 0 ) {
+        // Empty files cannot be mapped.
+        return mapped;
+    }
+    mapped->mapping_ = CreateFileMappingA( file, nullptr, PAGE_READONLY, 0, 0, nullptr );
+    if( mapped->mapping_ == nullptr ) {
+        return nullptr;
+    }
+    mapped->base_ = static_cast<const char *>( MapViewOfFile( mapped->mapping_, FILE_MAP_READ,
+                    0, 0, 0 ) );
+    if( mapped->base_ == nullptr ) {
+        return nullptr;
+    }
+    mapped->size_ = static_cast<std::size_t>( size.QuadPart );
+#else
+    const auto fd = ::open( path.c_str(), O_RDONLY | O_CLOEXEC );
+    if( fd < 0 ) {
+        return nullptr;
+    }
+    struct stat st {};
+    if( fstat( fd, &st ) != 0 || st.st_size < 0 || !S_ISREG( st.st_mode ) ) {
+        ::close( fd );
+        return nullptr;
+    }
+    if( st.st_size == 0 ) {
+        // Empty files cannot be mapped.
+        ::close( fd );
+        return mapped;
+    }
+    void *const base = mmap( nullptr, static_cast<std::size_t>( st.st_size ), PROT_READ, MAP_PRIVATE,
+                             fd, 0 );
+    // The mapping keeps the file alive.
+    ::close( fd );
+    if( base == MAP_FAILED ) {
+        return nullptr;
+    }
+    mapped->base_ = static_cast<const char *>( base );
+    mapped->size_ = static_cast<std::size_t>( st.st_size );
+#endif
+    return mapped;
+}
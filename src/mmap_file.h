@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <string_view>
+
+/**
+ * Read-only memory mapping of a whole file.
+ *
+ * The pages are shared with the OS file cache, so several mappings of the same
+ * file cost no extra memory and nothing is read until it is touched.
+ */
+class mmap_file
+{
+    public:
+        ~mmap_file();
+        mmap_file( const mmap_file & ) = delete;
+        auto operator=( const mmap_file & ) -> mmap_file & = delete;
+
+        /**
+         * Maps the file at @p path; nullptr if it cannot be opened or mapped.
+         * An empty file maps to an empty view.
+         */
+        static auto open( const std::string &path ) -> std::unique_ptr<mmap_file>;
+
+        auto data() const -> const char * {
+            return base_;
+        }
+        auto size() const -> std::size_t {
+            return size_;
+        }
+        /// Valid for the mapping's lifetime.
+        auto view() const -> std::string_view {
+            return std::string_view( base_, size_ );
+        }
+
+    private:
+        mmap_file() = default;
+
+        const char *base_ = nullptr;
+        std::size_t size_ = 0;
+#if defined(_WIN32)
+        void *file_ = nullptr;
+        void *mapping_ = nullptr;
+#endif
+};
@@ -22,6 +22,64 @@
 //     default monster will never get picked, and nor will the others past the
 //     monster that makes the point count go over 1000
 
+auto mongroup_index::insert( const tripoint_om_sm &p, const mongroup &group ) -> mongroup &
+{
+    id group_id;
+    if( free_.empty() ) {
+        group_id = slots_.size();
+        slots_.emplace_back();
+    } else {
+        group_id = free_.back();
+        free_.pop_back();
+    }
+    slot &s = slots_[group_id];
+    s.group.emplace( group );
+    s.pos = p;
+    buckets_[p].push_back( group_id );
+    return *s.group;
+}
+
+auto mongroup_index::erase( id group ) -> void
+{
+    unbucket( group );
+    slots_[group].group.reset();
+    free_.push_back( group );
+}
+
+auto mongroup_index::move( id group, const tripoint_om_sm &p ) -> void
+{
+    slot &s = slots_[group];
+    if( s.pos == p ) {
+        return;
+    }
+    unbucket( group );
+    s.pos = p;
+    buckets_[p].push_back( group );
+}
+
+auto mongroup_index::clear() -> void
+{
+    slots_.clear();
+    free_.clear();
+    buckets_.clear();
+}
+
+auto mongroup_index::ids_at( const tripoint_om_sm &p ) const -> const std::vector<id> &
+{
+    static const std::vector<id> none;
+    const auto it = buckets_.find( p );
+    return it == buckets_.end() ? none : it->second;
+}
+
+auto mongroup_index::unbucket( id group ) -> void
+{
+    const auto it = buckets_.find( slots_[group].pos );
+    std::erase( it->second, group );
+    if( it->second.empty() ) {
+        buckets_.erase( it );
+    }
+}
+
 std::map<mongroup_id, MonsterGroup> MonsterGroupManager::monsterGroupMap;
 MonsterGroupManager::t_string_set MonsterGroupManager::monster_blacklist;
 MonsterGroupManager::t_string_set MonsterGroupManager::monster_whitelist;
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
 #include <map>
+#include <optional>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "calendar.h"
@@ -165,6 +171,120 @@ struct mongroup {
     void serialize( JsonOut &json ) const;
 };
 
+/**
+ * The monster groups of one overmap, bucketed by the submap they stand on.
+ *
+ * Groups live in slots that never move, so references and ids stay valid until the group
+ * is erased, and a group that wanders onto another submap only changes bucket.
+ * Iteration runs in slot order; erasing the group under an iterator does not invalidate it.
+ */
+class mongroup_index
+{
+    private:
+        struct slot {
+            /** Empty while the slot is free. */
+            std::optional<mongroup> group;
+            tripoint_om_sm pos;
+        };
+
+    public:
+        using id = std::uint32_t;
+
+        template<typename Index, typename Group>
+        class basic_iterator
+        {
+            public:
+                using iterator_category = std::forward_iterator_tag;
+                using value_type = mongroup;
+                using difference_type = std::ptrdiff_t;
+                using pointer = Group *;
+                using reference = Group &;
+
+                basic_iterator() = default;
+                basic_iterator( Index *index, id at ) : index_( index ), at_( at ) {
+                    skip_dead();
+                }
+                auto operator*() const -> Group & {
+                    return *index_->slots_[at_].group;
+                }
+                auto operator->() const -> Group * {
+                    return &*index_->slots_[at_].group;
+                }
+                auto operator++() -> basic_iterator & {
+                    ++at_;
+                    skip_dead();
+                    return *this;
+                }
+                auto operator++( int ) -> basic_iterator {
+                    basic_iterator ret = *this;
+                    ++*this;
+                    return ret;
+                }
+                auto operator==( const basic_iterator &rhs ) const -> bool {
+                    return at_ == rhs.at_;
+                }
+                /** Groups added while iterating are visited too, if they land in a later slot. */
+                auto operator==( std::default_sentinel_t ) const -> bool {
+                    return at_ >= index_->slots_.size();
+                }
+                /** Id of the group this points at. */
+                auto group_id() const -> id {
+                    return at_;
+                }
+
+            private:
+                auto skip_dead() -> void {
+                    while( at_ < index_->slots_.size() && !index_->slots_[at_].group ) {
+                        ++at_;
+                    }
+                }
+
+                Index *index_ = nullptr;
+                id at_ = 0;
+        };
+        using iterator = basic_iterator<mongroup_index, mongroup>;
+        using const_iterator = basic_iterator<const mongroup_index, const mongroup>;
+
+        auto begin() -> iterator {
+            return iterator( this, 0 );
+        }
+        auto begin() const -> const_iterator {
+            return const_iterator( this, 0 );
+        }
+        auto end() const -> std::default_sentinel_t {
+            return std::default_sentinel;
+        }
+
+        /** Adds @p group under submap @p p; the returned reference is stable until it is erased. */
+        auto insert( const tripoint_om_sm &p, const mongroup &group ) -> mongroup &;
+        auto erase( id group ) -> void;
+        /** Files group @p group under submap @p p, without copying it. */
+        auto move( id group, const tripoint_om_sm &p ) -> void;
+        auto clear() -> void;
+
+        auto get( id group ) -> mongroup & {
+            return *slots_[group].group;
+        }
+        auto get( id group ) const -> const mongroup & {
+            return *slots_[group].group;
+        }
+        /** Ids of the groups under submap @p p. */
+        auto ids_at( const tripoint_om_sm &p ) const -> const std::vector<id> &;
+        auto size() const -> std::size_t {
+            return slots_.size() - free_.size();
+        }
+        auto empty() const -> bool {
+            return size() == 0;
+        }
+
+    private:
+        std::deque<slot> slots_;
+        std::vector<id> free_;
+        std::unordered_map<tripoint_om_sm, std::vector<id>> buckets_;
+
+        auto unbucket( id group ) -> void;
+};
+
 class MonsterGroupManager
 {
     public:
@@ -22,6 +22,7 @@
 #include "behavior.h"
 #include "calendar.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "cata_utility.h"
 #include "catalua.h"
 #include "catalua_coord.h"
@@ -62,6 +63,7 @@
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
+#include "turn_recorder.h"
 #include "type_id.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
@@ -391,12 +393,10 @@ void monster::wander_to( const tripoint_bub_ms &p, int f )
 // positions, and a true result means the real sight check can be rejected early.
 // A false result is not visibility; callers still have to run Creature::sees().
 //
-// LOGIC-2 / P-5 note: x_in_y aggro-chance rolls inside compute_plan() run on
-// worker-thread RNG (tl_worker_engine).  This is data-race-free (P-5), but it
-// means aggro probabilities are no longer tied to the main-thread minstd_rand0
-// sequence, silently breaking save-file determinism and shifting all subsequent
-// main-thread RNG draws.  If determinism is required, move the x_in_y calls
-// into apply_plan() so they execute on the main thread with the shared engine.
+// LOGIC-2 / P-5 note: rolls inside compute_plan() draw from an rng_stream keyed
+// on the monster's position, the turn and its remaining moves.  They never touch
+// the main-thread engine, and give the same results whichever thread plans the
+// monster and however the batch is split.
 static auto terrain_los_cache_blocks_current_positions( const Creature &seer,
         const Creature &target ) -> bool
 {
@@ -453,6 +453,10 @@ void monster::plan()
 monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx ) const
 {
     ZoneScoped;
+    // A monster may plan several times per turn; remaining moves tell the passes apart.
+    auto stream = rng_stream( g->get_seed(), rng_stream_key( abs_pos() ), calendar::turn,
+                              static_cast<std::uint64_t>( moves ) );
+    const auto stream_scope = rng_stream_scope( stream );
 
     // Thread-safe helpers: use pre-built snapshots when called from a worker
     // thread, falling back to g->all_monsters() / g->all_npcs() on the main
@@ -488,6 +492,18 @@ monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx )
         }
     };
 
+    // Main-thread lookups of nearby monsters go through the tracker's submap grid rather
+    // than every monster; worker threads keep to their snapshots.
+    const auto for_each_monster_near = [&]( int radius, auto &&fn ) {
+        if( ctx.monsters ) {
+            for_each_monster( fn );
+        } else {
+            for( monster *mp : g->critter_tracker->find_in_radius( abs_pos(), radius ) ) {
+                fn( *mp );
+            }
+        }
+    };
+
     monster_plan_t result;
     // Initialise final-value fields from current monster state so a no-op
     // planning pass is a no-op in apply_plan as well.
@@ -626,7 +642,7 @@ monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx )
                 }
             }
         } else if( local_friendly != 0 && !docile && !waiting ) {
-            for_each_monster( [&]( monster & tmp ) {
+            for_each_monster_near( max_sight_range, [&]( monster & tmp ) {
                 if( tmp.friendly == 0 ) {
                     // P-4: distance cull — skip ray trace if target is out of range.
                     const int d_tmp = rl_dist( bub_pos(), tmp.bub_pos() );
@@ -780,19 +796,14 @@ monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx )
                     }
                 }
             } else {
-                // Main-thread fallback: iterate live faction map with weak_ptr.
-                for( const auto &fac : factions ) {
-                    const auto faction_att = faction.obj().attitude( fac.first );
-                    if( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY ) {
-                        continue;
-                    }
-                    std::ranges::for_each( fac.second,
-                    [&]( const weak_ptr_fast<monster> &weak ) {
-                        const shared_ptr_fast<monster> shared = weak.lock();
-                        if( shared ) {
-                            process_sight( *shared );
-                        }
-                    } );
+                // Main-thread fallback: hostile monsters in sight range from the submap grid.
+                const auto hostile = [&]( const monster & mon ) {
+                    const auto faction_att = faction.obj().attitude( Creature_tracker::tracked_faction( mon ) );
+                    return faction_att != MFA_NEUTRAL && faction_att != MFA_FRIENDLY;
+                };
+                for( monster *mon : g->critter_tracker->find_in_radius( abs_pos(), max_sight_range,
+                        hostile ) ) {
+                    process_sight( *mon );
                 }
             }
         }
@@ -839,14 +850,14 @@ monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx )
                     } );
                 }
             } else {
-                // Main-thread fallback: use the live faction map with weak_ptr.
-                std::ranges::for_each( myfaction_iter->second,
-                [&]( const weak_ptr_fast<monster> &weak ) {
-                    const shared_ptr_fast<monster> shared = weak.lock();
-                    if( shared ) {
-                        process_faction_member( *shared );
-                    }
-                } );
+                // Main-thread fallback: faction members in sight range from the submap grid.
+                const auto same_faction = [&]( const monster & mon ) {
+                    return Creature_tracker::tracked_faction( mon ) == actual_faction;
+                };
+                for( monster *mon : g->critter_tracker->find_in_radius( abs_pos(), max_sight_range,
+                        same_faction ) ) {
+                    process_faction_member( *mon );
+                }
             }
         }
     } // cp_group_morale
@@ -1012,8 +1023,46 @@ monster_plan_t monster::compute_plan( const monster::compute_plan_context &ctx )
     return result;
 }
 
+std::optional<RouteRequest> monster::plan_route_request( const monster_plan_t &plan ) const
+{
+    const auto &here = get_map();
+    const auto pos = bub_pos();
+    const auto next_goal = here.inbounds( plan.goal ) ? plan.goal : goal;
+    if( lod_tier > 1 || next_goal == pos || has_flag( MF_STATIONARY ) ) {
+        return std::nullopt;
+    }
+
+    // Same checks as decide_action, ahead of apply_plan
+    const auto path_it = std::ranges::find_if( path, [&pos]( const tripoint_bub_ms & p ) {
+        return p != pos;
+    } );
+    if( path_it != path.end() ) {
+        if( here.valid_move( pos, *path_it, true, true, true ) ) {
+            return std::nullopt;
+        }
+    } else {
+        const auto goal_moved = plan.goal_kind != monster_plan_goal_kind::target_last_known &&
+                                next_goal != goal;
+        const auto delta = next_goal - pos;
+        const auto straight_step = pos + tripoint_rel_ms( sgn( delta.x() ), sgn( delta.y() ), 0 );
+        if( !( repath_requested || goal_moved ) || can_move_to( straight_step ) ) {
+            return std::nullopt;
+        }
+    }
+
+    const auto [path_settings, route_settings] = get_pathfinding_pair();
+    return RouteRequest{
+        .from = bub_to_abs( pos ),
+        .to = bub_to_abs( next_goal ),
+        .path_settings = path_settings,
+        .route_settings = route_settings,
+        .next_step_only = flow_field_pathfinding,
+    };
+}
+
 void monster::apply_plan( const monster_plan_t &plan )
 {
+    turn_recorder::count( turn_recorder::counter::monsters_planned );
     // Target movement updates last-known position; it does not by itself mean
     // the monster's current movement path is broken.
     if( plan.goal_kind == monster_plan_goal_kind::target_last_known ) {
@@ -1526,7 +1575,8 @@ void monster::execute_action( const monster_action_t &action )
     //     out into a separate action kind (with an early return) caused an infinite
     //     loop: if all call()s failed the cooldown was never reset, decide_action()
     //     saw cooldown==0 again next iteration, and moves were never consumed.
-    if( !pacified && !is_hallucination() &&
+    // Between cooldown ticks nothing can come off cooldown, so most calls skip the scan.
+    if( !pacified && !is_hallucination() && specials_ready_in == 0 &&
         !type->special_attacks.empty() && !special_attacks.empty() ) {
         ZoneScopedN( "mon_execute_special_attacks" );
         auto spec_list = std::vector<const std::pair<const std::string, mtype_special_attack> *> {};
@@ -1640,12 +1690,23 @@ void monster::execute_action( const monster_action_t &action )
         route_attempted = true;
         ZoneScopedN( "mon_execute_repath" );
         std::vector<tripoint_bub_ms> maybe_new_path;
-        if( get_option<bool>( "USE_LEGACY_PATHFINDING" ) )
+        if( resolved_action.prefetched_route )
+        {
+            maybe_new_path = *resolved_action.prefetched_route;
+        } else if( get_option<bool>( "USE_LEGACY_PATHFINDING" ) )
         {
             ZoneScopedN( "mon_execute_route_legacy" );
             auto pf_settings = get_legacy_pathfinding_settings();
             maybe_new_path = g->m.route( bub_pos(), goal, pf_settings,
                                          get_legacy_path_avoid() );
+        } else if( flow_field_pathfinding )
+        {
+            ZoneScopedN( "mon_execute_route_flow_field" );
+            auto pair = get_pathfinding_pair();
+            const auto step = Pathfinding::next_step( bub_pos(), goal, pair.first, pair.second );
+            if( step ) {
+                maybe_new_path = { bub_pos(), *step };
+            }
         } else
         {
             ZoneScopedN( "mon_execute_route_pf" );
@@ -1653,6 +1714,12 @@ void monster::execute_action( const monster_action_t &action )
             maybe_new_path = Pathfinding::route( bub_pos(), goal,
                                                  pair.first, pair.second );
         }
+        if( flow_field_pathfinding && maybe_new_path.size() == 2 && maybe_new_path.back() != goal )
+        {
+            // A flow field step. Keeping `goal` behind it makes the next turn's path check fail
+            //   unless it is adjacent, so we come back here for another lookup.
+            maybe_new_path.push_back( goal );
+        }
         assert( maybe_new_path.empty() ? true : maybe_new_path.back() == this->goal );
         if( maybe_new_path.empty() )
         {
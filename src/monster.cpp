@@ -395,6 +395,7 @@ monster::monster( const monster &source ) : Creature( source ),
 
     hp = source.hp;
     special_attacks = source.special_attacks;
+    specials_ready_in = source.specials_ready_in;
     goal = source.goal;
     pos_abs = source.pos_abs;
     dead = source.dead;
@@ -470,6 +471,7 @@ void monster::poly( const mtype_id &id )
         auto &entry = special_attacks[sa.first];
         entry.cooldown = sa.second->cooldown;
     }
+    specials_ready_in = 0;
     faction = type->default_faction;
     upgrades = type->upgrades;
     reproduces = type->reproduces;
@@ -2448,6 +2450,7 @@ void monster::apply_damage( Creature *source, item *source_weapon, item *source_
             source_projectile->add_monster_kill( type->id );
         }
     } else if( dam > 0 ) {
+        lod_alerted = true;
         mfaction_id attacker_faction;
         if( source != nullptr ) {
             const monster *source_monster = source->as_monster();
@@ -2925,6 +2928,7 @@ void monster::set_special( const std::string &special_name, int time )
     const auto iter = special_attacks.find( special_name );
     if( iter != special_attacks.end() ) {
         iter->second.cooldown = time;
+        specials_ready_in = std::min( specials_ready_in, time );
     } else {
         debugmsg( "%s has no special attack %s", disp_name(), special_name );
     }
@@ -3020,6 +3024,7 @@ void monster::process_turn()
 
     // Special attack cooldowns are updated here.
     // Loop through the monster's special attacks, same as monster::move.
+    specials_ready_in = std::numeric_limits<int>::max();
     for( const auto &sp_type : type->special_attacks ) {
         const std::string &special_name = sp_type.first;
         const auto local_iter = special_attacks.find( special_name );
@@ -3033,6 +3038,7 @@ void monster::process_turn()
 
         local_attack_data.cooldown = std::max( 0, local_attack_data.cooldown -
                                                action_time_scale::calendar_turns_this_tick() );
+        specials_ready_in = std::min( specials_ready_in, local_attack_data.cooldown );
     }
     // Persist grabs as long as there's an adjacent target.
     if( has_effect( effect_grabbing ) ) {
@@ -3163,12 +3169,14 @@ void monster::batch_turns( int n )
     }
 
     // Analytically advance all special attack cooldowns — O(attacks), not O(n).
+    specials_ready_in = std::numeric_limits<int>::max();
     for( const auto &sp_type : type->special_attacks ) {
         const auto local_iter = special_attacks.find( sp_type.first );
         if( local_iter == special_attacks.end() || !local_iter->second.enabled ) {
             continue;
         }
         local_iter->second.cooldown = std::max( 0, local_iter->second.cooldown - n );
+        specials_ready_in = std::min( specials_ready_in, local_iter->second.cooldown );
     }
 
     // Advance the summon timer; desummon the monster if it expires.
@@ -4134,6 +4142,7 @@ void monster::hear_sound( const sound_event &source, const short heard_vol, cons
     if( volume < -3000 ) {
         return;
     }
+    lod_alerted = true;
     // Error is based on volume and goodhearing. Louder sound contributes lightly, goodhearing contributes greatly.
     // Always some error, with more error if the heard sound is very low.
     // Getting within a few tiles *should* enable them to get better info, or just see their target.
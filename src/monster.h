@@ -288,6 +288,15 @@ class monster : public Creature, public location_visitable<monster>
          */
         void apply_plan( const monster_plan_t &plan );
 
+        /**
+         * Route this monster is expected to ask for this turn once @p plan is
+         * applied: its path went stale, or its goal moved and the straight step
+         * towards it is blocked.  Reads only; game::monmove gathers these after
+         * the planning pass and solves them with Pathfinding::route_batch().
+         * A guess — execute_action() routes for itself when it was wrong.
+         */
+        std::optional<RouteRequest> plan_route_request( const monster_plan_t &plan ) const;
+
         /**
          * Decision pass: reads monster and world state to determine
          * the single action this monster intends to take.  const — no mutations
@@ -606,6 +615,12 @@ class monster : public Creature, public location_visitable<monster>
         // within one fixed-window batch.
         int8_t lod_tier     = 0;
         int     lod_cooldown = 0;  // turns remaining before demotion is allowed
+        // Turn from which a Tier-1 monster must plan again; until then it keeps
+        // walking the goal and path of its last plan.  Transient like lod_tier.
+        int lod_next_plan_turn = 0;
+        // Set when the monster hears a sound or takes damage, so it plans at once
+        // and the next tier_assign_all() promotes it to Tier 0.
+        bool lod_alerted = false;
 
 
         Character *mounted_player = nullptr; // player that is mounting this creature
@@ -777,6 +792,9 @@ class monster : public Creature, public location_visitable<monster>
 
         int hp;
         std::map<std::string, mon_special_attack> special_attacks;
+        // Turns until the first enabled special comes off cooldown.  May be lower than the
+        // real value but never higher, so specials only need checking when this is 0.
+        int specials_ready_in = 0;
         // Absolute map-square position for active and overmap-stored monsters.
         tripoint_abs_ms pos_abs;
         tripoint_bub_ms goal;
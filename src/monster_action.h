@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstdint>
+#include <optional>
+#include <vector>
 
 #include "point.h"
 
@@ -57,6 +59,11 @@ struct monster_action_t {
     /// Tier-2 never sets this flag (macro step does not use the path).
     bool                needs_repath   = false;
 
+    /// Route Pathfinding::route_batch() already found from this position to the
+    /// goal; execute_action uses it for the repath instead of searching.
+    /// An empty route means none exists.
+    std::optional<std::vector<tripoint_bub_ms>> prefetched_route;
+
     /// execute_action should call stumble() after consuming move_cost moves.
     /// Used for the MATT_IGNORE / MATT_FOLLOW-at-range idle action that pairs
     /// a stumble with a partial move deduction (100 moves, not all moves).
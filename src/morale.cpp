@@ -226,14 +226,16 @@ double player_morale::morale_point::get_percent_contribution() const
 {
     return percent_contribution;
 }
-void player_morale::morale_point::decay( const time_duration &ticks )
+bool player_morale::morale_point::decay( const time_duration &ticks )
 {
     if( ticks < 0_turns ) {
         debugmsg( "The function called with negative ticks %d.", to_turns<int>( ticks ) );
-        return;
+        return false;
     }
 
     age += ticks;
+    // The bonus holds steady until decay starts
+    return !is_permanent() && age > decay_start;
 }
 
 int player_morale::morale_point::normalize_bonus( int bonus, int max_bonus, bool capped ) const
@@ -464,29 +466,14 @@ void player_morale::calculate_percentage()
 
 int player_morale::get_total_negative_value() const
 {
-    const morale_mult mult = get_temper_mult();
-    int sum = 0;
-    for( const morale_point &m : points ) {
-        const int bonus = m.get_net_bonus( mult );
-        if( bonus < 0 ) {
-            sum += bonus * bonus;
-        }
-    }
-    return std::sqrt( sum );
+    get_level();
+    return std::sqrt( negative_squares );
 }
 
 int player_morale::get_total_positive_value() const
 {
-    const morale_mult mult = get_temper_mult();
-    int sum = 0;
-    for( const morale_point &m : points ) {
-        const int bonus = m.get_net_bonus( mult );
-        if( bonus > 0 ) {
-            sum += bonus * bonus;
-        }
-
-    }
-    return std::sqrt( sum );
+    get_level();
+    return std::sqrt( positive_squares );
 }
 
 int player_morale::get_level() const
@@ -506,6 +493,8 @@ int player_morale::get_level() const
             }
         }
 
+        positive_squares = sum_of_positive_squares;
+        negative_squares = sum_of_negative_squares;
         level = std::sqrt( sum_of_positive_squares ) - std::sqrt( sum_of_negative_squares );
 
         if( took_prozac ) {
@@ -523,14 +512,18 @@ int player_morale::get_level() const
 
 void player_morale::decay( const time_duration &ticks )
 {
-    const auto do_decay = [ &ticks ]( morale_point & m ) {
-        m.decay( ticks );
-    };
-
-    std::ranges::for_each( points, do_decay );
+    // Points that haven't started decaying keep their bonus, so most ticks
+    // leave the cached level alone.  Expiry and the temperature penalties
+    // invalidate it themselves.
+    bool changed = false;
+    for( morale_point &m : points ) {
+        changed |= m.decay( ticks );
+    }
+    if( changed ) {
+        invalidate();
+    }
     remove_expired();
     update_bodytemp_penalty( ticks );
-    invalidate();
 }
 
 void player_morale::display( int focus_eq, int pain_penalty, int fatigue_cap )
@@ -171,7 +171,8 @@ class player_morale
 
                 void add( int new_bonus, int new_max_bonus, time_duration new_duration,
                           time_duration new_decay_start, bool new_cap );
-                void decay( const time_duration &ticks = 1_turns );
+                /** Ages the point, returning whether its net bonus may have changed. */
+                bool decay( const time_duration &ticks = 1_turns );
                 /*
                  *contribution should be bettween [0,100] (inclusive)
                  */
@@ -272,6 +273,9 @@ class player_morale
         // Mutability is required for lazy initialization
         mutable int level;
         mutable bool level_is_valid;
+        // Sums of squared positive and negative bonuses, valid along with level
+        mutable int positive_squares = 0;
+        mutable int negative_squares = 0;
 
         bool took_prozac;
         bool took_prozac_bad;
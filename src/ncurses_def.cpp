@@ -23,8 +23,10 @@
 #include "cursesdef.h"
 #include "catacharset.h"
 #include "color.h"
+#include "frame_timing.h"
 #include "game_ui.h"
 #include "output.h"
+#include "thread_pool.h"
 #include "ui_manager.h"
 
 #include "ncurses_def.h"
@@ -320,7 +322,8 @@ void catacurses::init_interface()
 
 void input_manager::pump_events()
 {
-    if( test_mode ) {
+    // Long loops pump events to stay responsive; off the main thread there is nothing to pump.
+    if( test_mode || is_pool_worker_thread() ) {
         return;
     }
 
@@ -349,9 +352,16 @@ input_event input_manager::get_input_event()
     input_event rval;
     do {
         previously_pressed_key = 0;
-        // flush any output
-        catacurses::doupdate();
-        key = getch();
+        {
+            // flush any output
+            const frame_timing::scoped_phase phase( frame_timing::group::present, "catacurses::doupdate" );
+            catacurses::doupdate();
+        }
+        frame_timing::end_frame();
+        {
+            const frame_timing::scoped_phase phase( frame_timing::group::input, "curses_getch" );
+            key = getch();
+        }
         if( key != ERR ) {
             int newch;
             // Clear the buffer of characters that match the one we're going to act on.
@@ -4031,6 +4031,7 @@ void Character::clear_mutations()
         unset_mutation( my_mutations.begin()->first );
     }
     cached_mutations.clear();
+    recalc_mutation_values();
 }
 
 void Character::clear_skills()
@@ -513,7 +513,6 @@ void npc::set_fac( const faction_id &id )
         return;
     }
     apply_ownership_to_inv();
-    ++g_npc_friends_dirty_version;
 }
 
 void npc::apply_ownership_to_inv()
@@ -791,6 +790,8 @@ auto npc::setpos_impl( const tripoint_abs_ms &new_pos, const bool preserve_movem
             // with the same npc pointer
             debugmsg( "could not find npc %s on its old overmap", name );
         }
+    } else if( !is_fake() && project_to<coords::sm>( old_pos ) != project_to<coords::sm>( new_pos ) ) {
+        get_overmapbuffer( get_dimension() ).npc_moved( *this );
     }
 }
 
@@ -833,6 +834,8 @@ void npc::travel_overmap( const tripoint_abs_sm &pos )
         } else {
             debugmsg( "could not find npc %s on its old overmap", name );
         }
+    } else if( !is_fake() ) {
+        get_overmapbuffer( get_dimension() ).npc_moved( *this );
     }
 }
 
@@ -2448,7 +2451,7 @@ float npc::danger_assessment()
     return ai_cache.danger_assessment;
 }
 
-float npc::average_damage_dealt()
+float npc::average_damage_dealt() const
 {
     return static_cast<float>( npc_ai::melee_value( *this, primary_weapon() ) );
 }
@@ -2758,8 +2761,6 @@ void npc::reboot()
     ai_cache.guard_pos = std::nullopt;
     ai_cache.my_weapon_value = 0;
     ai_cache.friends.clear();
-    ai_cache.cached_npc_friends.clear();
-    ai_cache.npc_friends_version = 0;
     ai_cache.dangerous_explosives.clear();
     ai_cache.threat_map.fill( 0.0f );
     ai_cache.searched_tiles.clear();
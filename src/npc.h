@@ -31,6 +31,7 @@
 #include "item.h"
 #include "line.h"
 #include "lru_cache.h"
+#include "npc_plan.h"
 #include "pimpl.h"
 #include "player.h"
 #include "point.h"
@@ -524,9 +525,6 @@ struct npc_short_term_cache {
 
     // Use weak_ptr to avoid circular references between Creatures
     std::vector<weak_ptr_fast<Creature>> friends;
-    // NPC-typed friends only; rebuilt when g_npc_friends_dirty_version changes
-    std::vector<weak_ptr_fast<Creature>> cached_npc_friends;
-    uint32_t npc_friends_version = 0;
     std::vector<sphere> dangerous_explosives;
     std::array<float, 27> threat_map;
     // Cache of locations the NPC has searched recently in npc::find_item()
@@ -949,7 +947,7 @@ class npc : public player
         // Interaction and assessment of the world around us
         float danger_assessment();
         // Our guess at how much damage we can deal
-        float average_damage_dealt();
+        float average_damage_dealt() const;
         bool bravery_check( int diff );
         bool emergency() const;
         bool emergency( float danger ) const;
@@ -1065,6 +1063,10 @@ class npc : public player
         float evaluate_enemy( const Creature &target ) const;
 
         void assess_danger();
+        /** Read-only half of assess_danger(); safe to run concurrently for different NPCs. */
+        npc_plan_t compute_danger_plan( const npc_plan_context &ctx = npc_plan_context{} ) const;
+        /** Commits a plan to ai_cache and reacts to it.  Main thread only. */
+        void apply_danger_plan( const npc_plan_t &plan );
         // Functions which choose an action for a particular goal
         npc_action method_of_fleeing();
         npc_action method_of_attack();
@@ -1327,6 +1329,8 @@ class npc : public player
         bool hallucination = false; // If true, NPC is an hallucination
         std::vector<npc_need> needs;
         std::optional<int> confident_range_cache;
+        // Planned by game::npcmove() in parallel; consumed by the next assess_danger().
+        std::optional<npc_plan_t> pending_danger_plan;
         // Dummy point that indicates that the goal is invalid.
         static constexpr tripoint_abs_omt no_goal_point{ tripoint_min };
         time_point last_updated;
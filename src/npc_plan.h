@@ -0,0 +1,63 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "coordinates.h"
+
+class monster;
+class npc;
+
+/**
+ * Captures the complete output of npc::compute_danger_plan().
+ *
+ * compute_danger_plan() is the pure half of npc::assess_danger(): it scans
+ * nearby fire, NPCs and monsters and records what it found without mutating
+ * the NPC, its ai_cache or any other creature.  npc::apply_danger_plan()
+ * commits the result on the main thread, together with the parts that need
+ * shared_ptr refcounting or character_danger() (which logs messages).  This
+ * mirrors the monster_plan_t split and lets game::npcmove() plan every NPC's
+ * first move of the turn in parallel.
+ *
+ * Pointers are raw snapshots taken during planning; apply_danger_plan()
+ * revalidates them (is_dead) before committing, since other NPCs act first.
+ */
+struct npc_plan_t {
+    /// Where the NPC stood when planned; a plan is discarded if it has moved since.
+    tripoint_bub_ms origin;
+    /// Last turn's decayed threat map plus this pass's fire and monster contributions.
+    std::array<float, 27> threat_map = {};
+    /// Threat of hostile monsters seen, before characters are weighed in.
+    float assessment = 0.0f;
+    float total_danger = 0.0f;
+    /// Priority of the best target so far; characters must beat it to take over.
+    float highest_priority = 1.0f;
+    monster *target = nullptr;
+    float target_danger = 0.0f;
+
+    /// Fire is within 3 tiles and the NPC is not yet reacting to it.
+    bool fire_bad = false;
+    bool sees_player = false;
+
+    std::vector<npc *> npc_friends;
+    std::vector<npc *> hostile_npcs;
+    std::vector<monster *> friendly_monsters;
+
+    /// Hostile monsters that may be worth shouting about.  apply_danger_plan()
+    /// makes the bravery roll, keeping RNG draws on the main thread.
+    struct monster_warning {
+        monster *critter = nullptr;
+        int dist = 0;
+        float threat = 0.0f;
+    };
+    std::vector<monster_warning> monster_warnings;
+};
+
+/** Shared inputs for a batch of npc::compute_danger_plan() calls. */
+struct npc_plan_context {
+    /// Live monsters to scan.  nullptr scans the creature tracker directly.
+    const std::vector<monster *> *monsters = nullptr;
+    /// Whether planning may refresh monsters' cached generic-NPC attitude.
+    /// Must be false when plans are computed concurrently.
+    bool write_attitude_cache = true;
+};
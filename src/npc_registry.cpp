@@ -0,0 +1,126 @@
+#include "npc_registry.h"
+
+#include <algorithm>
+#include <climits>
+#include <ranges>
+
+#include "character_id.h"
+#include "npc.h"
+
+void npc_registry::add( const shared_ptr_fast<npc> &who )
+{
+    const auto id = who->getID().get_value();
+    const auto at = who->abs_sm_pos().xy();
+    std::lock_guard<std::mutex> lk( mutex_ );
+    const auto [it, inserted] = by_id_.try_emplace( id );
+    if( !inserted ) {
+        if( it->second.filed_at == at ) {
+            it->second.who = who;
+            return;
+        }
+        unfile( id, it->second.filed_at );
+    }
+    it->second = entry{ who, at };
+    by_submap_[at].push_back( id );
+}
+
+void npc_registry::remove( const character_id &id )
+{
+    std::lock_guard<std::mutex> lk( mutex_ );
+    const auto it = by_id_.find( id.get_value() );
+    if( it == by_id_.end() ) {
+        return;
+    }
+    unfile( it->first, it->second.filed_at );
+    by_id_.erase( it );
+}
+
+void npc_registry::moved( const npc &who )
+{
+    const auto id = who.getID().get_value();
+    const auto at = who.abs_sm_pos().xy();
+    std::lock_guard<std::mutex> lk( mutex_ );
+    const auto it = by_id_.find( id );
+    if( it == by_id_.end() || it->second.filed_at == at ) {
+        return;
+    }
+    unfile( id, it->second.filed_at );
+    it->second.filed_at = at;
+    by_submap_[at].push_back( id );
+}
+
+void npc_registry::clear()
+{
+    std::lock_guard<std::mutex> lk( mutex_ );
+    by_id_.clear();
+    by_submap_.clear();
+}
+
+auto npc_registry::find( const character_id &id ) const -> shared_ptr_fast<npc>
+{
+    std::lock_guard<std::mutex> lk( mutex_ );
+    const auto it = by_id_.find( id.get_value() );
+    return it == by_id_.end() ? nullptr : it->second.who.lock();
+}
+
+auto npc_registry::near( const tripoint_abs_sm &center, const int radius ) const ->
+std::vector<shared_ptr_fast<npc>>
+{
+    auto result = std::vector<shared_ptr_fast<npc>>();
+    const auto keep = [&]( const entry & e ) {
+        auto who = e.who.lock();
+        if( !who ) {
+            return;
+        }
+        // Filter on where the NPC is, which agrees with where it's filed unless it moved
+        // by a path that doesn't report it
+        const auto pos = who->abs_sm_pos();
+        if( ( center.z() == INT_MIN || pos.z() == center.z() ) &&
+            square_dist( center.xy(), pos.xy() ) <= radius ) {
+            result.push_back( std::move( who ) );
+        }
+    };
+
+    std::lock_guard<std::mutex> lk( mutex_ );
+    const auto side = std::int64_t{ radius } * 2 + 1;
+    if( side * side >= static_cast<std::int64_t>( by_submap_.size() ) ) {
+        // A wide area holds more submaps than there are NPCs to check
+        for( const entry &e : by_id_ | std::views::values ) {
+            keep( e );
+        }
+    } else {
+        for( const auto y : std::views::iota( center.y() - radius, center.y() + radius + 1 ) ) {
+            for( const auto x : std::views::iota( center.x() - radius, center.x() + radius + 1 ) ) {
+                const auto bucket = by_submap_.find( point_abs_sm( x, y ) );
+                if( bucket == by_submap_.end() ) {
+                    continue;
+                }
+                for( const int id : bucket->second ) {
+                    keep( by_id_.at( id ) );
+                }
+            }
+        }
+    }
+    std::ranges::sort( result, {}, []( const shared_ptr_fast<npc> &who ) {
+        return who->getID().get_value();
+    } );
+    return result;
+}
+
+auto npc_registry::size() const -> std::size_t
+{
+    std::lock_guard<std::mutex> lk( mutex_ );
+    return by_id_.size();
+}
+
+void npc_registry::unfile( const int id, const point_abs_sm &at )
+{
+    const auto bucket = by_submap_.find( at );
+    if( bucket == by_submap_.end() ) {
+        return;
+    }
+    std::erase( bucket->second, id );
+    if( bucket->second.empty() ) {
+        by_submap_.erase( bucket );
+    }
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "coordinates.h"
+#include "memory_fast.h"
+
+class character_id;
+class npc;
+
+/**
+ * Every NPC held by the overmaps of one @ref overmapbuffer, indexed by id and by the
+ * submap each stands in.
+ *
+ * overmap files NPCs here as they enter and leave its list, and NPCs report crossing
+ * into another submap, so id lookups and area scans touch only the NPCs involved
+ * rather than every NPC of every loaded overmap.  Entries don't own their NPC; one
+ * whose overmap was dropped without removing it is skipped and forgotten.
+ */
+class npc_registry
+{
+    public:
+        /** Files @p who under its current submap, refiling it if it's already known. */
+        void add( const shared_ptr_fast<npc> &who );
+        void remove( const character_id &id );
+        /** Refiles @p who if it has left the submap it was filed under.  Cheap if not. */
+        void moved( const npc &who );
+        void clear();
+
+        auto find( const character_id &id ) const -> shared_ptr_fast<npc>;
+        /**
+         * NPCs within @p radius submaps of @p center by square distance, in id order.
+         * A z of INT_MIN matches every z-level.
+         */
+        auto near( const tripoint_abs_sm &center, int radius ) const ->
+        std::vector<shared_ptr_fast<npc>>;
+        auto size() const -> std::size_t;
+
+    private:
+        struct entry {
+            weak_ptr_fast<npc> who;
+            point_abs_sm filed_at;
+        };
+
+        void unfile( int id, const point_abs_sm &at );
+
+        mutable std::mutex mutex_;
+        // Keyed by character_id::get_value()
+        std::unordered_map<int, entry> by_id_;
+        std::unordered_map<point_abs_sm, std::vector<int>> by_submap_;
+};
@@ -475,9 +475,11 @@ static bool too_close( const tripoint_bub_ms &critter_pos, const tripoint_bub_ms
     return rl_dist( critter_pos, ally_pos ) <= def_radius;
 }
 
-void npc::assess_danger()
+npc_plan_t npc::compute_danger_plan( const npc_plan_context &ctx ) const
 {
     ZoneScoped;
+    npc_plan_t plan;
+    plan.origin = bub_pos();
     auto has_mutation_attitude_rules = false;
     for( const trait_id &mut : get_mutations() ) {
         const auto &mutation = mut.obj();
@@ -499,20 +501,13 @@ void npc::assess_danger()
             has_trait( trait_PHEROMONE_INSECT ) || has_trait( trait_TERRIFYING ) ||
             has_effect( effect_attention ) || has_effect( effect_feral_infighting_punishment );
 
-    float assessment = 0.0f;
-    float highest_priority = 1.0f;
     int def_radius = rules.has_flag( ally_rule::follow_close ) ? follow_distance() : 6;
 
-    // Radius we can attack without moving
-    int max_range;
-    if( confident_range_cache ) {
-        max_range = *confident_range_cache;
-    } else {
-        invalidate_range_cache();
-        max_range = *confident_range_cache;
-    }
+    // Radius we can attack without moving.  assess_danger() and game::npcmove()
+    // fill the cache before planning, since refreshing it mutates the NPC.
+    const int max_range = confident_range_cache.value_or( 1 );
 
-    Character &player_character = get_player_character();
+    const Character &player_character = get_player_character();
     // NPCs will hold back from charging if they get in trouble.
     const bool self_defense_only = rules.engagement == combat_engagement::NO_MOVE ||
                                    rules.engagement == combat_engagement::NONE ||
@@ -560,10 +555,9 @@ void npc::assess_danger()
 
         return true;
     };
-    std::array<float, 27> cur_threat_map{};
     // start with a decayed version of last turn's map
     for( direction threat_dir : npc_threat_dir ) {
-        cur_threat_map[std::to_underlying( threat_dir )] = 0.25f * ai_cache.threat_map[std::to_underlying(
+        plan.threat_map[std::to_underlying( threat_dir )] = 0.25f * ai_cache.threat_map[std::to_underlying(
                     threat_dir )];
     }
     map &here = get_map();
@@ -577,158 +571,234 @@ void npc::assess_danger()
             continue;
         }
         const int dist = rl_dist( bub_pos(), pt );
-        cur_threat_map[std::to_underlying( direction_from( bub_pos(),
-                                           pt ) )] += 2.0f * ( NPC_DANGER_MAX - dist );
+        plan.threat_map[std::to_underlying( direction_from( bub_pos(),
+                                            pt ) )] += 2.0f * ( NPC_DANGER_MAX - dist );
         if( dist < 3 && !has_effect( effect_npc_fire_bad ) ) {
-            warn_about( "fire_bad", 1_minutes );
-            add_effect( effect_npc_fire_bad, 5_turns );
-            path.clear();
+            plan.fire_bad = true;
         }
     }
 
-    // Find our Character friends and enemies.
-    // NPC friends are cached across turns; only rebuild when faction membership or active NPC
-    // list changes (tracked via g_npc_friends_dirty_version).
-    std::vector<weak_ptr_fast<Creature>> hostile_guys;
+    // Find our Character friends and enemies.  Only raw pointers are recorded here:
+    // weak_ptr_fast refcounting is not thread-safe, so apply_danger_plan() builds
+    // the ai_cache references.
     auto friend_positions = std::vector<tripoint_bub_ms> {};
-    const auto remember_friend_position = [&]( const weak_ptr_fast<Creature> &guy ) {
-        if( auto ally = guy.lock() ) {
-            friend_positions.push_back( ally->bub_pos() );
-        }
-    };
     {
         ZoneScopedN( "npc_friend_enemy_scan" );
-        const uint32_t current_version = g_npc_friends_dirty_version.load( std::memory_order_relaxed );
-        const bool friends_dirty = ( ai_cache.npc_friends_version != current_version );
-        if( friends_dirty ) {
-            ai_cache.cached_npc_friends.clear();
-        }
         for( const shared_ptr_fast<npc> &npc_ptr : g->raw_npcs() ) {
-            const npc &guy = *npc_ptr;
+            npc &guy = *npc_ptr;
             if( &guy == this || guy.is_dead() ) {
                 continue;
             }
             if( has_faction_relationship( guy, npc_factions::watch_your_back ) ) {
-                if( friends_dirty ) {
-                    ai_cache.cached_npc_friends.emplace_back( g->shared_from( guy ) );
-                }
+                plan.npc_friends.push_back( &guy );
+                friend_positions.push_back( guy.bub_pos() );
             } else if( attitude_to( guy ) != Attitude::A_NEUTRAL && sees( guy.bub_pos() ) ) {
-                hostile_guys.emplace_back( g->shared_from( guy ) );
+                plan.hostile_npcs.push_back( &guy );
             }
         }
-        if( friends_dirty ) {
-            ai_cache.npc_friends_version = current_version;
-        }
-        for( const weak_ptr_fast<Creature> &guy : ai_cache.cached_npc_friends ) {
-            ai_cache.friends.emplace_back( guy );
-            remember_friend_position( guy );
-        }
     }
-    if( sees( player_character.bub_pos() ) ) {
-        if( is_enemy() ) {
-            hostile_guys.emplace_back( g->shared_from( player_character ) );
-        } else if( is_friendly( player_character ) ) {
-            auto player_ref = g->shared_from( player_character );
-            friend_positions.push_back( player_character.bub_pos() );
-            ai_cache.friends.emplace_back( player_ref );
-        }
+    plan.sees_player = sees( player_character.bub_pos() );
+    if( plan.sees_player && !is_enemy() && is_friendly( player_character ) ) {
+        friend_positions.push_back( player_character.bub_pos() );
     }
 
     const auto npc_monster_faction = get_monster_faction();
-    {
-        ZoneScopedN( "assess_all_monsters" );
-        for( const shared_ptr_fast<monster> &mon_ptr : g->critter_tracker->get_monsters_list() ) {
-            if( mon_ptr->is_dead() ) {
-                continue;
-            }
-            monster &critter = *mon_ptr;
-            const auto dist = rl_dist_fast( bub_pos(), critter.bub_pos() );
-            if( dist > default_daylight_level() ) {
-                continue;
-            }
-            Attitude att;
-            if( !has_special_attitude_traits &&
-                critter.cached_npc_attitude_epoch == g_npcmove_attitude_epoch &&
-                critter.cached_npc_attitude_faction == npc_monster_faction ) {
-                ZoneScopedN( "npc_monster_attitude_cache_hit" );
-                att = critter.cached_npc_attitude;
-            } else {
-                ZoneScopedN( "npc_monster_attitude_cache_miss" );
-                att = has_special_attitude_traits ? critter.attitude_to( *this ) :
-                      critter.generic_npc_attitude_to( npc_monster_faction );
-                if( !has_special_attitude_traits ) {
-                    critter.cached_npc_attitude_epoch = g_npcmove_attitude_epoch;
-                    critter.cached_npc_attitude_faction = npc_monster_faction;
-                    critter.cached_npc_attitude = att;
-                }
-            }
-            if( att == Attitude::A_FRIENDLY ) {
-                ai_cache.friends.emplace_back( g->shared_from( critter ) );
-                friend_positions.push_back( critter.bub_pos() );
-                continue;
-            }
-            // Skip non-hostile monsters entirely — includes MATT_IGNORE, MATT_FLEE, and
-            // MATT_FOLLOW (tracking but not yet attacking; take neutral attitude at face value).
-            if( att != Attitude::A_HOSTILE ) {
-                continue;
-            }
-            // Character::sees() includes short-range special senses; do not replace it
-            // with a terrain-only LOS cache here.
-            if( !sees( critter ) ) {
-                continue;
-            }
-            float critter_threat = evaluate_enemy( critter );
-            // warn and consider the odds for distant enemies
-            if( ( is_enemy() || !critter.friendly ) ) {
-                assessment += critter_threat;
-                if( critter_threat > ( 8.0f + personality.bravery + rng( 0, 5 ) ) ) {
-                    warn_about( "monster", 10_minutes, critter.type->nname(), dist, critter.bub_pos() );
-                }
-            }
-            if( must_retreat || no_fighting ) {
-                continue;
-            }
-            // ignore targets behind glass even if we can see them
-            if( !clear_shot_reach( bub_pos(), critter.bub_pos(), false ) ) {
-                continue;
+    const auto assess_monster = [&]( monster & critter ) {
+        if( critter.is_dead() ) {
+            return;
+        }
+        const auto dist = rl_dist_fast( bub_pos(), critter.bub_pos() );
+        if( dist > default_daylight_level() ) {
+            return;
+        }
+        Attitude att;
+        if( !has_special_attitude_traits &&
+            critter.cached_npc_attitude_epoch == g_npcmove_attitude_epoch &&
+            critter.cached_npc_attitude_faction == npc_monster_faction ) {
+            ZoneScopedN( "npc_monster_attitude_cache_hit" );
+            att = critter.cached_npc_attitude;
+        } else {
+            ZoneScopedN( "npc_monster_attitude_cache_miss" );
+            att = has_special_attitude_traits ? critter.attitude_to( *this ) :
+                  critter.generic_npc_attitude_to( npc_monster_faction );
+            if( !has_special_attitude_traits && ctx.write_attitude_cache ) {
+                critter.cached_npc_attitude_epoch = g_npcmove_attitude_epoch;
+                critter.cached_npc_attitude_faction = npc_monster_faction;
+                critter.cached_npc_attitude = att;
             }
+        }
+        if( att == Attitude::A_FRIENDLY ) {
+            plan.friendly_monsters.push_back( &critter );
+            friend_positions.push_back( critter.bub_pos() );
+            return;
+        }
+        // Skip non-hostile monsters entirely — includes MATT_IGNORE, MATT_FLEE, and
+        // MATT_FOLLOW (tracking but not yet attacking; take neutral attitude at face value).
+        if( att != Attitude::A_HOSTILE ) {
+            return;
+        }
+        // Character::sees() includes short-range special senses; do not replace it
+        // with a terrain-only LOS cache here.
+        if( !sees( critter ) ) {
+            return;
+        }
+        float critter_threat = evaluate_enemy( critter );
+        // warn and consider the odds for distant enemies
+        if( ( is_enemy() || !critter.friendly ) ) {
+            plan.assessment += critter_threat;
+            plan.monster_warnings.push_back( { .critter = &critter, .dist = dist, .threat = critter_threat } );
+        }
+        if( must_retreat || no_fighting ) {
+            return;
+        }
+        // ignore targets behind glass even if we can see them
+        if( !clear_shot_reach( bub_pos(), critter.bub_pos(), false ) ) {
+            return;
+        }
 
-            float scaled_distance = std::max( 1.0f, dist / critter.speed_rating() );
-            float hp_percent = 1.0f - static_cast<float>( critter.get_hp() ) / critter.get_hp_max();
-            float critter_danger = std::max( critter_threat * ( hp_percent * 0.5f + 0.5f ),
-                                             NPC_DANGER_VERY_LOW );
-            ai_cache.total_danger += critter_danger / scaled_distance;
+        float scaled_distance = std::max( 1.0f, dist / critter.speed_rating() );
+        float hp_percent = 1.0f - static_cast<float>( critter.get_hp() ) / critter.get_hp_max();
+        float critter_danger = std::max( critter_threat * ( hp_percent * 0.5f + 0.5f ),
+                                         NPC_DANGER_VERY_LOW );
+        plan.total_danger += critter_danger / scaled_distance;
 
-            // don't ignore monsters that are too close or too close to an ally if we can move
-            bool is_too_close = dist <= def_radius;
-            for( const tripoint_bub_ms &ally_pos : friend_positions ) {
-                if( is_too_close || self_defense_only ) {
-                    break;
-                }
-                is_too_close |= too_close( critter.bub_pos(), ally_pos, def_radius );
-            }
-            // ignore distant monsters that our rules prevent us from attacking
-            if( !is_too_close && is_player_ally() && !ok_by_rules( critter, dist, scaled_distance ) ) {
-                continue;
+        // don't ignore monsters that are too close or too close to an ally if we can move
+        bool is_too_close = dist <= def_radius;
+        for( const tripoint_bub_ms &ally_pos : friend_positions ) {
+            if( is_too_close || self_defense_only ) {
+                break;
             }
-            // prioritize the biggest, nearest threats, or the biggest threats that are threatening
-            // us or an ally
-            // critter danger is always at least NPC_DANGER_VERY_LOW
-            float priority = std::max( critter_danger - 2.0f * ( scaled_distance - 1.0f ),
-                                       is_too_close ? critter_danger : 0.0f );
-            cur_threat_map[std::to_underlying( direction_from( bub_pos(), critter.bub_pos() ) )] += priority;
-            if( priority > highest_priority ) {
-                highest_priority = priority;
-                ai_cache.target = g->shared_from( critter );
-                ai_cache.danger = critter_danger;
+            is_too_close |= too_close( critter.bub_pos(), ally_pos, def_radius );
+        }
+        // ignore distant monsters that our rules prevent us from attacking
+        if( !is_too_close && is_player_ally() && !ok_by_rules( critter, dist, scaled_distance ) ) {
+            return;
+        }
+        // prioritize the biggest, nearest threats, or the biggest threats that are threatening
+        // us or an ally
+        // critter danger is always at least NPC_DANGER_VERY_LOW
+        float priority = std::max( critter_danger - 2.0f * ( scaled_distance - 1.0f ),
+                                   is_too_close ? critter_danger : 0.0f );
+        plan.threat_map[std::to_underlying( direction_from( bub_pos(), critter.bub_pos() ) )] += priority;
+        if( priority > plan.highest_priority ) {
+            plan.highest_priority = priority;
+            plan.target = &critter;
+            plan.target_danger = critter_danger;
+        }
+    };
+    {
+        ZoneScopedN( "assess_all_monsters" );
+        if( ctx.monsters != nullptr ) {
+            std::ranges::for_each( *ctx.monsters, [&]( monster * critter ) {
+                assess_monster( *critter );
+            } );
+        } else {
+            // Nothing past daylight range is assessed, so only look that far
+            for( monster *critter : g->critter_tracker->find_in_radius( abs_pos(),
+                    static_cast<int>( default_daylight_level() ) ) ) {
+                assess_monster( *critter );
             }
         }
     } // assess_all_monsters
 
+    return plan;
+}
+
+void npc::apply_danger_plan( const npc_plan_t &plan )
+{
+    ZoneScoped;
+    Character &player_character = get_player_character();
+    if( plan.fire_bad && !has_effect( effect_npc_fire_bad ) ) {
+        warn_about( "fire_bad", 1_minutes );
+        add_effect( effect_npc_fire_bad, 5_turns );
+        path.clear();
+    }
+
+    std::array<float, 27> cur_threat_map = plan.threat_map;
+    float assessment = plan.assessment;
+    float highest_priority = plan.highest_priority;
+    ai_cache.total_danger += plan.total_danger;
+
+    std::vector<weak_ptr_fast<Creature>> hostile_guys;
+    for( npc *guy : plan.npc_friends ) {
+        ai_cache.friends.emplace_back( g->shared_from( *guy ) );
+    }
+    for( npc *guy : plan.hostile_npcs ) {
+        hostile_guys.emplace_back( g->shared_from( *guy ) );
+    }
+    if( plan.sees_player ) {
+        if( is_enemy() ) {
+            hostile_guys.emplace_back( g->shared_from( player_character ) );
+        } else if( is_friendly( player_character ) ) {
+            ai_cache.friends.emplace_back( g->shared_from( player_character ) );
+        }
+    }
+    for( monster *critter : plan.friendly_monsters ) {
+        if( !critter->is_dead() ) {
+            ai_cache.friends.emplace_back( g->shared_from( *critter ) );
+        }
+    }
+    for( const npc_plan_t::monster_warning &warning : plan.monster_warnings ) {
+        // Rolled here rather than in planning so the main-thread RNG sequence
+        // matches the serial code regardless of who computed the plan.
+        if( warning.threat > ( 8.0f + personality.bravery + rng( 0, 5 ) ) &&
+            !warning.critter->is_dead() ) {
+            warn_about( "monster", 10_minutes, warning.critter->type->nname(), warning.dist,
+                        warning.critter->bub_pos() );
+        }
+    }
+    if( plan.target != nullptr && !plan.target->is_dead() ) {
+        ai_cache.target = g->shared_from( *plan.target );
+        ai_cache.danger = plan.target_danger;
+    }
+
     if( assessment == 0.0 && hostile_guys.empty() ) {
         ai_cache.danger_assessment = assessment;
         return;
     }
+
+    int def_radius = rules.has_flag( ally_rule::follow_close ) ? follow_distance() : 6;
+    const int max_range = confident_range_cache.value_or( 1 );
+    const bool self_defense_only = rules.engagement == combat_engagement::NO_MOVE ||
+                                   rules.engagement == combat_engagement::NONE ||
+                                   emergency();
+    const bool no_fighting = rules.has_flag( ally_rule::forbid_engage );
+    const bool must_retreat = is_walking_with() && ( emergency() ||
+                              rules.has_flag( ally_rule::follow_close ) ) &&
+                              !too_close( bub_pos(), player_character.bub_pos(), follow_distance() );
+    if( rules.engagement == combat_engagement::FREE_FIRE ) {
+        def_radius = std::max( 6, max_range );
+    } else if( self_defense_only ) {
+        def_radius = max_range;
+    } else if( no_fighting ) {
+        def_radius = 1;
+    }
+    const auto ok_by_rules = [max_range, def_radius, this, &player_character]( const Creature & c,
+                             int dist,
+    int scaled_dist ) {
+        if( rules.has_flag( ally_rule::forbid_engage ) ) {
+            return false;
+        }
+        switch( rules.engagement ) {
+            case combat_engagement::NONE:
+                return false;
+            case combat_engagement::CLOSE:
+                return ( dist <= max_range && scaled_dist <= def_radius * 0.5 ) ||
+                       too_close( c.bub_pos(), player_character.bub_pos(), def_radius );
+            case combat_engagement::WEAK:
+                return c.get_hp() <= average_damage_dealt();
+            case combat_engagement::HIT:
+                return c.has_effect( effect_hit_by_player );
+            case combat_engagement::NO_MOVE:
+                return dist <= max_range;
+            case combat_engagement::FREE_FIRE:
+                return dist <= max_range;
+            case combat_engagement::ALL:
+                return true;
+        }
+
+        return true;
+    };
     const auto handle_hostile = [&]( const Character & foe, float foe_threat,
     const std::string & bogey, const std::string & warning ) {
         int dist = rl_dist( bub_pos(), foe.bub_pos() );
@@ -790,7 +860,7 @@ void npc::assess_danger()
         assessment = std::max( min_danger, assessment - guy_threat * 0.5f );
     }
 
-    if( sees( player_character.bub_pos() ) ) {
+    if( plan.sees_player ) {
         // Mod for the player
         // cap player difficulty at 150
         float player_diff = evaluate_enemy( player_character );
@@ -828,6 +898,20 @@ void npc::assess_danger()
     ai_cache.danger_assessment = assessment;
 }
 
+void npc::assess_danger()
+{
+    ZoneScoped;
+    if( !confident_range_cache ) {
+        invalidate_range_cache();
+    }
+    // Precomputed by game::npcmove() for this NPC's first move of the turn.
+    std::optional<npc_plan_t> plan = std::exchange( pending_danger_plan, std::nullopt );
+    if( !plan || plan->origin != bub_pos() ) {
+        plan = compute_danger_plan();
+    }
+    apply_danger_plan( *plan );
+}
+
 float npc::character_danger( const Character &u ) const
 {
     float ret = 0.0;
@@ -3281,10 +3365,15 @@ void npc::find_item()
             continue;
         }
         const int prev_num_items = ai_cache.searched_tiles.get( p, -1 );
+        // The submap item rows rule out bare ground without building a stack.
+        const bool ground_items = here.has_items( eq_bub_pos );
+        const optional_vpart_position vp = here.veh_at( p );
+        if( !ground_items && !vp && !whitelisting ) {
+            continue;
+        }
         // Prefetch the number of items present so we can bail out if we already checked here.
         const map_stack m_stack = here.i_at( eq_bub_pos );
         int num_items = m_stack.size();
-        const optional_vpart_position vp = here.veh_at( p );
         if( vp ) {
             const std::optional<vpart_reference> cargo = vp.part_with_feature( VPFLAG_CARGO, true );
             if( cargo ) {
@@ -1480,6 +1480,16 @@ void options_manager::add_options_general()
 
     get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
 
+    add( "BINARY_MAP_SAVES", general, translate_marker( "Binary map saves" ),
+         translate_marker( "If true, map data is saved in a compact binary format that is faster to save and load and takes less disk space.  Maps saved either way can always be loaded, but older game versions cannot read binary maps." ),
+         false
+       );
+
+    add( "DICTIONARY_SAVE_COMPRESSION", general, translate_marker( "Dictionary save compression" ),
+         translate_marker( "If true, map and overmap data in compressed SQLite worlds is compressed with dictionaries shipped with the game, which makes saves smaller.  Saves written either way can always be loaded, but older game versions cannot read dictionary-compressed data." ),
+         true
+       );
+
     add_empty_line();
 
     add( "AUTO_NOTES", general, translate_marker( "Auto notes" ),
@@ -2322,6 +2332,22 @@ void options_manager::add_options_graphics()
         { "off", translate_marker( "Disable" ) }
     },
     "auto" );
+
+    add( "LAZY_TILESET_SPRITES", graphics, translate_marker( "Load tileset sprites on demand" ),
+         translate_marker( "Keep tileset images in system memory and upload each sprite to the graphics card the first time it is drawn.  Lowers video memory use with large tilesets.  Requires tileset reload." ),
+         false, COPT_CURSES_HIDE
+       );
+
+    add( "TILESET_ATLAS_PAGES", graphics, translate_marker( "Tileset texture pages" ),
+         translate_marker( "With on-demand sprite loading, the number of texture pages the tileset may fill before the least recently drawn one is reused.  Each page is up to 4096x4096 pixels.  0 means no limit.  Requires tileset reload." ),
+         0, 64, 0, COPT_CURSES_HIDE
+       );
+    get_option( "TILESET_ATLAS_PAGES" ).setPrerequisite( "LAZY_TILESET_SPRITES" );
+
+    add( "SPRITE_BATCHING", graphics, translate_marker( "Batch map sprites" ),
+         translate_marker( "Submit the sprites of the map view in as few draw calls as possible.  Disable if the map renders incorrectly with your renderer." ),
+         true, COPT_CURSES_HIDE
+       );
 #endif
 
 #if defined(SDL_HINT_RENDER_BATCHING)
@@ -2363,6 +2389,11 @@ void options_manager::add_options_graphics()
     "1", COPT_CURSES_HIDE );
 #endif
 
+    add( "LIGHT_CLUSTER_DISTANCE", graphics, translate_marker( "Vehicle light merge distance" ),
+         translate_marker( "Vehicle lights farther than this from you are merged with their neighbours and cast as one, which speeds up lighting around convoys and lit bases.  0 only merges lights sharing a tile." ),
+         0, 200, 60
+       );
+
 #if defined(CATA_SDL)
     add_empty_line();
     add( "COMPUTE_ACCELERATION", graphics, translate_marker( "Compute Acceleration" ),
@@ -2374,6 +2405,9 @@ void options_manager::add_options_graphics()
         { "gpu_software", translate_marker( "Software GPU (debug)" ) }
     },
     "auto" );
+    add( "PIPELINE_GPU_LIGHTING", graphics, translate_marker( "Pipelined GPU lighting" ),
+         translate_marker( "If true, GPU lighting runs while monsters and NPCs take their turns and is only waited for when the screen is drawn.  Creatures then judge light by the previous turn's lightmap." ),
+         false );
 #endif
 
 }
@@ -2463,6 +2497,13 @@ void options_manager::add_options_performance()
                                "monsters.  At 1 they check scent every turn (full fidelity); at 3 (default) "
                                "only once every 3 turns. " ),
              1, 5, is_android ? 3 : 4 );
+        add( "LOD_COARSE_REPLAN_INTERVAL", page_id,
+             translate_marker( "Coarse Replan Interval" ),
+             translate_marker( "How many turns a Tier-1 (coarse) monster keeps following its last plan "
+                               "before planning again.  Hearing a sound, taking damage or coming into "
+                               "the player's view makes it plan at once.  At 1 they plan every turn "
+                               "(full fidelity). " ),
+             1, 8, 3 );
         add( "LOD_GROUP_MORALE_MAX_TIER", page_id,
              translate_marker( "Group Morale Max Tier" ),
              translate_marker( "Highest LOD tier that participates in group-morale and swarming calculations.  "
@@ -2485,6 +2526,7 @@ void options_manager::add_options_performance()
     get_option( "LOD_TIER_COARSE_DIST" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
     get_option( "LOD_DEMOTION_COOLDOWN" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
     get_option( "LOD_COARSE_SCENT_INTERVAL" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
+    get_option( "LOD_COARSE_REPLAN_INTERVAL" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
     get_option( "LOD_GROUP_MORALE_MAX_TIER" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
     get_option( "ACTIVITY_SKIP_MONSTER_LOD_GATE" ).setPrerequisite( "MONSTER_LOD_ENABLED" );
 
@@ -2556,6 +2598,20 @@ void options_manager::add_options_performance()
                                "streaming or running other CPU-heavy applications alongside the game.  "
                                "Requires restart." ),
              0, 64, 0 );
+        add( "THREAD_POOL_BACKGROUND_WORKERS", page_id,
+             translate_marker( "Background Worker Count" ),
+             translate_marker( "How many worker threads may run background work (map generation, "
+                               "preloading, saving) at the same time.  The others stay free for work "
+                               "the current turn needs, which keeps turns smooth while new areas "
+                               "generate.  0 means automatic (all workers but one).  Requires restart." ),
+             0, 64, 0 );
+        add( "THREAD_POOL_AFFINITY", page_id,
+             translate_marker( "Pin Worker Threads to Cores" ),
+             translate_marker( "Keep each worker thread on its own CPU core, leaving the first core to "
+                               "the main thread.  Can steady frame times on machines with few other "
+                               "programs running; leave off on shared machines.  Linux and Windows "
+                               "only.  Requires restart." ),
+             false );
         add( "PARALLEL_MONSTER_PLANNING", page_id,
              translate_marker( "Parallel Monster Planning" ),
              translate_marker( "Compute monster AI plans (pathfinding target selection, LOS queries) in "
@@ -2569,6 +2625,12 @@ void options_manager::add_options_performance()
                                "planning cost varies widely (large hordes with mixed sight ranges); "
                                "larger values reduce task-dispatch overhead.  Requires restart." ),
              1, 64, 8 );
+        add( "PARALLEL_NPC_PLANNING", page_id,
+             translate_marker( "Parallel NPC Planning" ),
+             translate_marker( "Compute each NPC's danger assessment (nearby threats, friends and fire) "
+                               "in parallel across worker threads before NPCs act.  Disable if NPCs "
+                               "behave unexpectedly.  Requires restart." ),
+             true );
         add( "PARALLEL_MAP_CACHE", page_id,
              translate_marker( "Parallel Map Cache Build" ),
              translate_marker( "Build per-z-level map caches (transparency, outside, floor, "
@@ -2583,13 +2645,87 @@ void options_manager::add_options_performance()
                                "Disable on machines where the ~70 k-cell work unit is too small to "
                                "amortize dispatch latency.  Requires restart." ),
              true );
+        add( "PARALLEL_FIELD_PROCESSING", page_id,
+             translate_marker( "Parallel Field Processing" ),
+             translate_marker( "Process fire, smoke, gas and other fields of loaded submaps across "
+                               "worker threads.  Results are the same either way.  Requires restart." ),
+             true );
+        add( "PARALLEL_ITEM_PROCESSING", page_id,
+             translate_marker( "Parallel Item Processing" ),
+             translate_marker( "Work out spoilage of active food items across worker threads before "
+                               "items are processed.  Results are the same either way.  Requires restart." ),
+             true );
+        add( "PARALLEL_PATHFINDING", page_id,
+             translate_marker( "Parallel Pathfinding" ),
+             translate_marker( "Search routes monsters will need this turn across worker threads after "
+                               "their plans are made, one destination per thread.  Requires restart." ),
+             true );
+        add( "PARALLEL_SOUND_FLOOD_FILL", page_id,
+             translate_marker( "Parallel Sound Propagation" ),
+             translate_marker( "Spread the sounds monsters and NPCs made this turn across worker "
+                               "threads, one sound per thread.  Results are the same either way.  "
+                               "Requires restart." ),
+             true );
+        add( "PARALLEL_EXPLOSION_SHRAPNEL", page_id,
+             translate_marker( "Parallel Explosion Shrapnel" ),
+             translate_marker( "Trace which tiles an explosion's shrapnel can reach across worker "
+                               "threads.  Results are the same either way.  Requires restart." ),
+             true );
+        add( "PARALLEL_AUTODRIVE_PLANNING", page_id,
+             translate_marker( "Parallel Autodrive Planning" ),
+             translate_marker( "Search autodrive routes at several speeds at once across worker "
+                               "threads, instead of retrying slower speeds one by one.  The chosen "
+                               "route is the same either way.  Requires restart." ),
+             true );
+        add( "PARALLEL_DATA_CHECKS", page_id,
+             translate_marker( "Parallel Data Checks" ),
+             translate_marker( "Verify loaded game data across worker threads.  Errors are reported "
+                               "in the same order either way." ),
+             true );
+        add( "BACKGROUND_MAP_WRITES", page_id,
+             translate_marker( "Background Map Writes" ),
+             translate_marker( "Compress and write saved map data on background threads so the game "
+                               "resumes as soon as the map is serialized, instead of waiting for the "
+                               "database.  Only affects the compressed SQLite world format.  "
+                               "Requires restart." ),
+             true );
+        add( "MAP_DB_CACHE_SIZE", page_id,
+             translate_marker( "Map Database Cache (MiB)" ),
+             translate_marker( "Page cache size of each map database connection.  Larger values keep "
+                               "more of the map in memory between loads.  Only affects the compressed "
+                               "SQLite world format.  Requires restart." ),
+             1, 512, is_android ? 8 : 32 );
+        add( "MAP_DB_WAL_AUTOCHECKPOINT", page_id,
+             translate_marker( "Map Database Checkpoint Interval" ),
+             translate_marker( "Number of write-ahead log pages after which map database writes are "
+                               "folded back into the main file.  Larger values make saves cheaper and "
+                               "the log bigger.  Only affects the compressed SQLite world format.  "
+                               "Requires restart." ),
+             100, 100000, 1000 );
+
+        add( "MAP_DB_SNAPSHOT", page_id, translate_marker( "Map Database Snapshot" ),
+             translate_marker( "Keep a memory-mapped read-only copy of the map database next to it "
+                               "and load unchanged map data from there.  The copy is rebuilt in the "
+                               "background after a session that saved changes.  Only affects the "
+                               "compressed SQLite world format.  Requires restart." ),
+             false );
     } );
 
     get_option( "THREAD_POOL_WORKERS" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "THREAD_POOL_BACKGROUND_WORKERS" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "THREAD_POOL_AFFINITY" ).setPrerequisite( "MULTITHREADING_ENABLED" );
     get_option( "PARALLEL_MONSTER_PLANNING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
     get_option( "MONSTER_PLAN_CHUNK_SIZE" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_NPC_PLANNING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
     get_option( "PARALLEL_MAP_CACHE" ).setPrerequisite( "MULTITHREADING_ENABLED" );
     get_option( "PARALLEL_SCENT_UPDATE" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_FIELD_PROCESSING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_ITEM_PROCESSING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_PATHFINDING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_SOUND_FLOOD_FILL" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_EXPLOSION_SHRAPNEL" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_AUTODRIVE_PLANNING" ).setPrerequisite( "MULTITHREADING_ENABLED" );
+    get_option( "PARALLEL_DATA_CHECKS" ).setPrerequisite( "MULTITHREADING_ENABLED" );
 
     add_empty_line();
 
@@ -2621,6 +2757,57 @@ void options_manager::add_options_performance()
                                "This reduces map-shift hitches at the cost of extra per-turn loading work and    "
                                "some additional memory usage." ),
              !is_android );
+        add( "LAZY_BORDER_SIM_INTERVAL", page_id,
+             translate_marker( "Pre-load Border Simulation Interval" ),
+             translate_marker( "Turns between coarse catch-up passes over the pre-loaded border.  "
+                               "Fields decay, items rot and plants grow there without full simulation, "
+                               "within a small per-turn time budget.  0 leaves the border frozen." ),
+             0, 600, is_android ? 0 : 100 );
+        get_option( "LAZY_BORDER_SIM_INTERVAL" ).setPrerequisite( "LAZY_BORDER" );
+        add( "PREDICTIVE_PREFETCH", page_id,
+             translate_marker( "Predictive Prefetch" ),
+             translate_marker( "While driving or auto-travelling, load the area ahead of the reality bubble "
+                               "in the background, scaled to your speed.  Reduces hitches when driving fast "
+                               "at the cost of extra background loading and memory usage." ),
+             !is_android );
+        add( "DEFER_SUBMAP_ITEMS", page_id,
+             translate_marker( "Deferred Item Loading" ),
+             translate_marker( "Keep the items of loaded map areas unparsed until something looks at them or "
+                               "the area enters the reality bubble.  Pre-loaded borders around bases with many "
+                               "items then load faster and use less memory." ),
+             true );
+        add( "ZLEVEL_LIGHTING_CULLING", page_id,
+             translate_marker( "Cull Hidden Z-Level Lighting" ),
+             translate_marker( "Only cast lights on z-levels you could see from where you stand.  Levels "
+                               "behind solid ground or a full ceiling keep just their sunlight until they "
+                               "come into view or something there needs their light." ),
+             true );
+        add( "NPC_FIELD_OF_VIEW", page_id,
+             translate_marker( "Batched NPC Sight" ),
+             translate_marker( "Work out what every NPC can see in one pass at the start of their turns, "
+                               "instead of tracing a line to each thing they look at.  Faster with many "
+                               "NPCs and followers around.  NPCs then see along the same lines you do." ),
+             true );
+        add( "HIERARCHICAL_PATHFINDING", page_id,
+             translate_marker( "Hierarchical Pathfinding" ),
+             translate_marker( "Plan long routes from submap to submap over a map of their crossings kept "
+                               "between turns, and work out exact tiles only along the way.  Much faster "
+                               "for followers and monsters crossing a large reality bubble; routes may be "
+                               "slightly longer than the shortest one." ),
+             true );
+        add( "PERSISTENT_PATHFINDING", page_id,
+             translate_marker( "Persistent Pathfinding" ),
+             translate_marker( "Keep what pathfinding explored towards a target from one turn to the next, "
+                               "and redo only the part that changed terrain, vehicles or creatures affect.  "
+                               "A horde chasing a target that stays put shares one search instead of "
+                               "repeating it every turn." ),
+             true );
+        add( "FLOW_FIELD_PATHFINDING", page_id,
+             translate_marker( "Flow Field Pathfinding" ),
+             translate_marker( "Monsters ask for one step at a time from a map shared by everything of "
+                               "similar speed and abilities heading to the same target, instead of "
+                               "planning a whole route each.  Cheaper for large hordes." ),
+             true );
         add( "ACTIVITY_MOBILE_BUBBLE_SIZE", page_id,
              translate_marker( "Mobile Activity Bubble Size" ),
              translate_marker( "Shrink the reality bubble to this radius while the player is performing a "
@@ -2698,6 +2885,13 @@ void options_manager::add_options_performance()
                                "The retained cache budget is this value squared; lazy border "
                                "loading is budgeted separately." ),
              4, 50, is_android ? 10 : 24 );
+        add( "MAP_MEMORY_BUDGET", page_id,
+             translate_marker( "Map memory budget (MiB)" ),
+             translate_marker( "Approximate memory resident map data may use across all dimensions "
+                               "before recently left areas are saved and unloaded early, those "
+                               "kept by prefetching and portals first.  Areas still in use are "
+                               "never unloaded.  0 for no limit." ),
+             0, 65536, 0 );
         add( "POWER_PORTAL_LOAD_RADIUS", page_id,
              translate_marker( "Power portal load radius (submaps)" ),
              translate_marker( "Radius in submaps around each end of a power-portal link that is "
@@ -2706,6 +2900,25 @@ void options_manager::add_options_performance()
            );
     } );
 
+    add_empty_line();
+
+    add( "LUA_IDLE_GC_STEP", performance, translate_marker( "Lua Idle Collection Step (KiB)" ),
+         translate_marker( "While the game waits for input, collect Lua garbage in steps of this "
+                           "size until a collection cycle finishes, so less of it is left to run "
+                           "during turns and drawing.  0 leaves collection entirely to Lua." ),
+         0, 1024, 64 );
+    add( "LUA_MEMORY_LIMIT", performance, translate_marker( "Lua Memory Limit (MiB)" ),
+         translate_marker( "Memory all Lua scripts may hold together.  Past it, the script that "
+                           "asks for more fails with an out of memory error instead of growing "
+                           "the game's memory further.  0 for no limit." ),
+         0, 8192, 0 );
+    add( "LUA_TASK_BUDGET", performance, translate_marker( "Lua Task Budget (microseconds)" ),
+         translate_marker( "Time each turn that long-running Lua tasks started by mods may take.  "
+                           "Tasks continue on later turns once it is used up, so higher values "
+                           "finish them sooner at the cost of slower turns.  At least one task "
+                           "step runs each turn regardless." ),
+         0, 100000, 2000 );
+
     // get_option( "FIRE_SPREAD_SUBMAP_CAP" ).setPrerequisite( "REALITY_BUBBLE_FIRE_SPREAD", "adjacent" );
 }
 
@@ -2729,6 +2942,16 @@ void options_manager::add_options_debug()
          false
        );
 
+    add( "CACHE_DATA_CHECKS", debug, translate_marker( "Cache data checks" ),
+         translate_marker( "If true, game data that passed the consistency checks before is not checked again as long as the mod list and the mod files are unchanged.  Speeds up repeated loading of the same game data." ),
+         false
+       );
+
+    add( "TURN_SPIKE_THRESHOLD", debug, translate_marker( "Slow turn report threshold (ms)" ),
+         translate_marker( "When a turn takes longer than this, not counting waiting for input, the timings of the turns around it are written to a turn_spike file in the config directory, for attaching to performance reports.  0 to never write them." ),
+         0, 60000, 0
+       );
+
     add_empty_line();
 
     add( "MOD_SOURCE", debug, translate_marker( "Display Mod Source" ),
@@ -4415,6 +4638,8 @@ void options_manager::cache_to_globals()
     log_from_top = ::get_option<std::string>( "LOG_FLOW" ) == "new_top";
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
+    message_limit = ::get_option<int>( "MESSAGE_LIMIT" );
+    turn_spike_threshold_ms = ::get_option<int>( "TURN_SPIKE_THRESHOLD" );
     angled_sunlight_shadows = ::get_option<bool>( "FOV_3D_OCCLUSION" );
     const auto prevent_occlusion_option = ::get_option<std::string>( "PREVENT_OCCLUSION" );
     prevent_occlusion = prevent_occlusion_option == "off" ? 0 : prevent_occlusion_option == "on" ? 1 :
@@ -4425,6 +4650,10 @@ void options_manager::cache_to_globals()
     prevent_occlusion_max_dist = ::get_option<float>( "PREVENT_OCCLUSION_MAX_DIST" );
     static_z_effect = ::get_option<bool>( "STATICZEFFECT" );
     overmap_transparency = ::get_option<bool>( "OVERMAP_TRANSPARENCY" );
+    vehicle_armor_color = ::get_option<bool>( "VEHICLE_ARMOR_COLOR" );
+    lua_idle_gc_step_kb = ::get_option<int>( "LUA_IDLE_GC_STEP" );
+    lua_memory_limit_mb = ::get_option<int>( "LUA_MEMORY_LIMIT" );
+    lua_task_budget_us = ::get_option<int>( "LUA_TASK_BUDGET" );
     PICKUP_RANGE = ::get_option<int>( "PICKUP_RANGE" );
 
     monster_lod_enabled       = ::get_option<bool>( "MONSTER_LOD_ENABLED" );
@@ -4434,6 +4663,7 @@ void options_manager::cache_to_globals()
     lod_action_budget         = ::get_option<int>( "LOD_ACTION_BUDGET" );
     lod_macro_interval        = ::get_option<int>( "LOD_MACRO_INTERVAL" );
     lod_coarse_scent_interval = ::get_option<int>( "LOD_COARSE_SCENT_INTERVAL" );
+    lod_coarse_replan_interval = ::get_option<int>( "LOD_COARSE_REPLAN_INTERVAL" );
     lod_group_morale_max_tier = ::get_option<int>( "LOD_GROUP_MORALE_MAX_TIER" );
     activity_skip_monster_lod_gate = ::get_option<int>( "ACTIVITY_SKIP_MONSTER_LOD_GATE" );
 
@@ -4464,14 +4694,33 @@ void options_manager::cache_to_globals()
     }
 
     safe_mode_proximity = ::get_option<int>( "SAFEMODEPROXIMITY" );
+    light_cluster_distance = ::get_option<int>( "LIGHT_CLUSTER_DISTANCE" );
 
     parallel_enabled          = ::get_option<bool>( "MULTITHREADING_ENABLED" );
     parallel_monster_planning = ::get_option<bool>( "PARALLEL_MONSTER_PLANNING" );
     monster_plan_chunk_size   = ::get_option<int>( "MONSTER_PLAN_CHUNK_SIZE" );
+    parallel_npc_planning     = ::get_option<bool>( "PARALLEL_NPC_PLANNING" );
     parallel_map_cache        = ::get_option<bool>( "PARALLEL_MAP_CACHE" );
     parallel_scent_update     = ::get_option<bool>( "PARALLEL_SCENT_UPDATE" );
+    parallel_field_processing = ::get_option<bool>( "PARALLEL_FIELD_PROCESSING" );
+    parallel_item_processing  = ::get_option<bool>( "PARALLEL_ITEM_PROCESSING" );
+    parallel_pathfinding      = ::get_option<bool>( "PARALLEL_PATHFINDING" );
+    parallel_sound_flood_fill = ::get_option<bool>( "PARALLEL_SOUND_FLOOD_FILL" );
+    parallel_explosion_shrapnel = ::get_option<bool>( "PARALLEL_EXPLOSION_SHRAPNEL" );
+    parallel_autodrive_planning = ::get_option<bool>( "PARALLEL_AUTODRIVE_PLANNING" );
     lazy_border_enabled = ::get_option<bool>( "LAZY_BORDER" );
+    predictive_prefetch_enabled = ::get_option<bool>( "PREDICTIVE_PREFETCH" );
+    deferred_submap_items = ::get_option<bool>( "DEFER_SUBMAP_ITEMS" );
+    zlevel_lighting_culling = ::get_option<bool>( "ZLEVEL_LIGHTING_CULLING" );
+    npc_field_of_view = ::get_option<bool>( "NPC_FIELD_OF_VIEW" );
+    hierarchical_pathfinding = ::get_option<bool>( "HIERARCHICAL_PATHFINDING" );
+    persistent_d_maps = ::get_option<bool>( "PERSISTENT_PATHFINDING" );
+    flow_field_pathfinding = ::get_option<bool>( "FLOW_FIELD_PATHFINDING" );
+    binary_map_saves = ::get_option<bool>( "BINARY_MAP_SAVES" );
+    dictionary_save_compression = ::get_option<bool>( "DICTIONARY_SAVE_COMPRESSION" );
     retained_omt_cache_length = ::get_option<int>( "RETAINED_OMT_CACHE_LENGTH" );
+    map_memory_budget_mb = ::get_option<int>( "MAP_MEMORY_BUDGET" );
+    lazy_border_sim_interval = ::get_option<int>( "LAZY_BORDER_SIM_INTERVAL" );
 
     merge_comestible_mode = ( [] {
         const auto opt = ::get_option<std::string>( "MERGE_COMESTIBLES" );
@@ -4492,6 +4741,7 @@ void options_manager::cache_to_globals()
             preload_config::compute_accel_from_string(
                 ::get_option<std::string>( "COMPUTE_ACCELERATION" ) ) );
     }
+    pipeline_gpu_lighting = ::get_option<bool>( "PIPELINE_GPU_LIGHTING" );
 #endif
 
 #if defined(TILES)
@@ -12,6 +12,7 @@
 #include <cstddef>
 #include <cstring>
 #include <exception>
+#include <list>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -21,6 +22,7 @@
 #include <set>
 #include <submap.h>
 #include <tuple>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <vehicle.h>
@@ -74,6 +76,7 @@
 #include "string_formatter.h"
 #include "string_utils.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "type_id.h"
 #include "type_id_implement.h"
@@ -2878,17 +2881,35 @@ oter_id overmap::get_default_terrain( int z ) const
 void overmap::init_layers()
 {
     for( int k = 0; k < OVERMAP_LAYERS; ++k ) {
-        const oter_id tid = get_default_terrain( k - OVERMAP_DEPTH );
+        layer[k].terrain.fill( get_default_terrain( k - OVERMAP_DEPTH ) );
+        layer[k].visible.fill( false );
+        layer[k].explored.fill( false );
+        layer[k].path.fill( false );
+    }
+}
 
-        for( int i = 0; i < OMAPX; ++i ) {
-            for( int j = 0; j < OMAPY; ++j ) {
-                layer[k].terrain[i][j] = tid;
-                layer[k].visible[i][j] = false;
-                layer[k].explored[i][j] = false;
-                layer[k].path[i][j] = false;
-            }
+void overmap::compact_layers()
+{
+    for( map_layer &l : layer ) {
+        l.terrain.compact();
+        l.visible.compact();
+        l.explored.compact();
+        l.path.compact();
+    }
+}
+
+auto overmap::memory_usage() const -> std::size_t
+{
+    auto bytes = sizeof( overmap );
+    for( const map_layer &l : layer ) {
+        bytes += l.terrain.heap_bytes() + l.visible.heap_bytes() + l.explored.heap_bytes() +
+                 l.path.heap_bytes();
+        bytes += l.notes.capacity() * sizeof( om_note ) + l.extras.capacity() * sizeof( om_map_extra );
+        for( const om_note &note : l.notes ) {
+            bytes += note.text.capacity();
         }
     }
+    return bytes;
 }
 
 void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
@@ -2898,7 +2919,8 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()] = id;
+    layer[p.z() + OVERMAP_DEPTH].terrain.set( p.xy(), id );
+    road_graph.reset();
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -2908,7 +2930,7 @@ const oter_id &overmap::ter( const tripoint_om_omt &p ) const
         return ot_null;
     }
 
-    return layer[p.z() + OVERMAP_DEPTH].terrain[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].terrain.get( p.xy() );
 }
 
 std::string *overmap::join_used_at( const om_pos_dir &p )
@@ -2949,30 +2971,19 @@ void overmap::sync_mapgen_args_init_flags()
     }
 }
 
-bool &overmap::seen( const tripoint_om_omt &p )
-{
-    if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
-    }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
-}
-
 bool overmap::seen( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].visible[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].visible.get( p.xy() );
 }
 
-bool &overmap::explored( const tripoint_om_omt &p )
+void overmap::set_seen( const tripoint_om_omt &p, bool seen )
 {
-    if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+    if( inbounds( p ) ) {
+        layer[p.z() + OVERMAP_DEPTH].visible.set( p.xy(), seen );
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
 }
 
 bool overmap::is_explored( const tripoint_om_omt &p ) const
@@ -2980,16 +2991,14 @@ bool overmap::is_explored( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].explored[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].explored.get( p.xy() );
 }
 
-bool &overmap::path( const tripoint_om_omt &p )
+void overmap::set_explored( const tripoint_om_omt &p, bool explored )
 {
-    if( !inbounds( p ) ) {
-        nullbool = false;
-        return nullbool;
+    if( inbounds( p ) ) {
+        layer[p.z() + OVERMAP_DEPTH].explored.set( p.xy(), explored );
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
 }
 
 bool overmap::is_path( const tripoint_om_omt &p ) const
@@ -2997,25 +3006,32 @@ bool overmap::is_path( const tripoint_om_omt &p ) const
     if( !inbounds( p ) ) {
         return false;
     }
-    return layer[p.z() + OVERMAP_DEPTH].path[p.x()][p.y()];
+    return layer[p.z() + OVERMAP_DEPTH].path.get( p.xy() );
+}
+
+void overmap::set_path( const tripoint_om_omt &p, bool path )
+{
+    if( inbounds( p ) ) {
+        layer[p.z() + OVERMAP_DEPTH].path.set( p.xy(), path );
+    }
 }
 
 bool overmap::mongroup_check( const mongroup &candidate ) const
 {
-    const auto matching_range = zg.equal_range( project_remain<coords::om>
-                                ( candidate.abs_pos ).remainder_tripoint );
-    return std::find_if( matching_range.first, matching_range.second,
-    [candidate]( const std::pair<tripoint_om_sm, mongroup> &match ) {
+    return std::ranges::any_of( zg.ids_at( project_remain<coords::om>
+                                ( candidate.abs_pos ).remainder_tripoint ),
+    [&]( const mongroup_index::id id ) {
+        const mongroup &match = zg.get( id );
         // This is extra strict since we're using it to test serialization.
-        return candidate.type == match.second.type && candidate.abs_pos == match.second.abs_pos &&
-               candidate.radius == match.second.radius &&
-               candidate.population == match.second.population &&
-               candidate.target == match.second.target &&
-               candidate.interest == match.second.interest &&
-               candidate.dying == match.second.dying &&
-               candidate.horde == match.second.horde &&
-               candidate.diffuse == match.second.diffuse;
-    } ) != matching_range.second;
+        return candidate.type == match.type && candidate.abs_pos == match.abs_pos &&
+               candidate.radius == match.radius &&
+               candidate.population == match.population &&
+               candidate.target == match.target &&
+               candidate.interest == match.interest &&
+               candidate.dying == match.dying &&
+               candidate.horde == match.horde &&
+               candidate.diffuse == match.diffuse;
+    } );
 }
 
 bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate ) const
@@ -3031,6 +3047,7 @@ bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate
 void overmap::insert_npc( const shared_ptr_fast<npc> &who )
 {
     npcs.push_back( who );
+    get_overmapbuffer( dimension_id_ ).npc_index().add( who );
     g->set_npcs_dirty();
 }
 
@@ -3045,6 +3062,7 @@ shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
     }
     auto ptr = *iter;
     npcs.erase( iter );
+    get_overmapbuffer( dimension_id_ ).npc_index().remove( id );
     g->set_npcs_dirty();
     return ptr;
 }
@@ -3429,11 +3447,20 @@ static void elevate_bridges(
 std::vector<point_abs_omt> overmap::find_terrain( const std::string &term, int zlevel )
 {
     std::vector<point_abs_omt> found;
+    // Names are matched once per distinct terrain rather than once per tile.
+    std::unordered_map<oter_id, bool> matches;
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
             tripoint_om_omt p( x, y, zlevel );
-            if( seen( p ) &&
-                lcmatch( ter( p )->get_name(), term ) ) {
+            if( !seen( p ) ) {
+                continue;
+            }
+            const oter_id &oter = ter( p );
+            auto it = matches.find( oter );
+            if( it == matches.end() ) {
+                it = matches.emplace( oter, lcmatch( oter->get_name(), term ) ).first;
+            }
+            if( it->second ) {
                 found.push_back( project_combine( pos(), p.xy() ) );
             }
         }
@@ -3478,16 +3505,14 @@ const
 
 void overmap::process_mongroups()
 {
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        mongroup &mg = *it;
         if( mg.dying ) {
             mg.population = ( mg.population * 4 ) / 5;
             mg.radius = ( mg.radius * 9 ) / 10;
         }
         if( mg.empty() ) {
-            zg.erase( it++ );
-        } else {
-            ++it;
+            zg.erase( it.group_id() );
         }
     }
 }
@@ -3603,14 +3628,20 @@ void mongroup::wander( const overmap &om )
 
 void overmap::move_hordes()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
+    // Looked up once per tick rather than once per group
+    std::optional<sol::table> behaviours;
+    if( auto *state = DynamicDataLoader::get_instance().lua.get() ) {
+        auto behaviours_obj = state->lua.globals()["game"]["horde_behaviours"].get<sol::object>();
+        if( behaviours_obj.is<sol::table>() ) {
+            behaviours = behaviours_obj.as<sol::table>();
+        }
+    }
     //MOVE ZOMBIE GROUPS
-    for( auto it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    // Groups are visited by id, not by position, so one that moves is not visited twice.
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        mongroup &mg = *it;
         if( !mg.horde || mg.horde_behaviour == "nemesis" ) {
             // Nemesis hordes have their own move logic.
-            ++it;
             continue;
         }
 
@@ -3624,35 +3655,30 @@ void overmap::move_hordes()
         if( ( mg.abs_pos.xy() == mg.target.xy() ) || mg.interest <= 15 ) {
             auto used_hook_target = false;
 
-            if( auto *state = DynamicDataLoader::get_instance().lua.get() ) {
-                auto &lua = state->lua;
-                auto game = lua.globals()["game"];
-                auto behaviours_obj = game["horde_behaviours"].get<sol::object>();
-                if( behaviours_obj.is<sol::table>() ) {
-                    auto behaviours = behaviours_obj.as<sol::table>();
-                    const auto fn_obj = behaviours.get_or<sol::object>( mg.horde_behaviour, sol::lua_nil );
-                    if( fn_obj.is<sol::protected_function>() || fn_obj.is<sol::function>() ) {
-                        auto func = fn_obj.as<sol::protected_function>();
-                        auto params = lua.create_table();
-                        auto results = lua.create_table();
-                        params["results"] = results;
-                        params["group"] = &mg;
-                        params["pos_abs_sm"] = mg.abs_pos;
-                        params["target_abs_sm"] = mg.target;
-                        params["behaviour"] = mg.horde_behaviour;
-
-                        auto res = func( params );
-                        check_func_result( res );
-
-                        const auto hook_target = results.get<sol::optional<tripoint_abs_sm>>( "target" );
-                        const auto hook_interest = results.get<sol::optional<int>>( "interest" );
-                        if( hook_target.has_value() ) {
-                            mg.set_target( *hook_target );
-                            used_hook_target = true;
-                        }
-                        if( hook_interest.has_value() ) {
-                            mg.set_interest( *hook_interest );
-                        }
+            if( behaviours ) {
+                const auto fn_obj = behaviours->get_or<sol::object>( mg.horde_behaviour, sol::lua_nil );
+                if( fn_obj.is<sol::protected_function>() || fn_obj.is<sol::function>() ) {
+                    auto &lua = DynamicDataLoader::get_instance().lua->lua;
+                    auto func = fn_obj.as<sol::protected_function>();
+                    auto params = lua.create_table();
+                    auto results = lua.create_table();
+                    params["results"] = results;
+                    params["group"] = &mg;
+                    params["pos_abs_sm"] = mg.abs_pos;
+                    params["target_abs_sm"] = mg.target;
+                    params["behaviour"] = mg.horde_behaviour;
+
+                    auto res = func( params );
+                    check_func_result( res );
+
+                    const auto hook_target = results.get<sol::optional<tripoint_abs_sm>>( "target" );
+                    const auto hook_interest = results.get<sol::optional<int>>( "interest" );
+                    if( hook_target.has_value() ) {
+                        mg.set_target( *hook_target );
+                        used_hook_target = true;
+                    }
+                    if( hook_interest.has_value() ) {
+                        mg.set_interest( *hook_interest );
                     }
                 }
             }
@@ -3683,6 +3709,7 @@ void overmap::move_hordes()
         // frequently. The average horde speed for regular Z's is around 100,
         // or one space per 5 minutes.
         if( one_in( movement_chance ) && rng( 0, 100 ) < mg.interest && rng( 0, 200 ) < mg.avg_speed() ) {
+            const tripoint_abs_sm old_pos = mg.abs_pos;
             if( mg.abs_pos.x() > mg.target.x() ) {
                 mg.abs_pos.x()--;
             }
@@ -3696,16 +3723,11 @@ void overmap::move_hordes()
                 mg.abs_pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            const auto new_local_pos = project_remain<coords::om>( mg.abs_pos ).remainder_tripoint;
-            tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( new_local_pos, mg ) );
-            zg.erase( it++ );
-        } else {
-            ++it;
+            if( mg.abs_pos != old_pos ) {
+                zg.move( it.group_id(), project_remain<coords::om>( mg.abs_pos ).remainder_tripoint );
+            }
         }
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -3741,11 +3763,9 @@ void overmap::move_hordes()
 
             // Scan for compatible hordes in this area, selecting the largest.
             mongroup *add_to_group = nullptr;
-            auto group_bucket = zg.equal_range( p );
             std::vector<monster>::size_type add_to_horde_size = 0;
-            std::for_each( group_bucket.first, group_bucket.second,
-            [&]( std::pair<const tripoint_om_sm, mongroup> &horde_entry ) {
-                mongroup &horde = horde_entry.second;
+            std::ranges::for_each( zg.ids_at( p ), [&]( const mongroup_index::id id ) {
+                mongroup &horde = zg.get( id );
 
                 // We only absorb zombies into GROUP_ZOMBIE hordes
                 if( horde.horde && !horde.monsters.empty() && horde.type == GROUP_ZOMBIE &&
@@ -3781,12 +3801,9 @@ void overmap::move_hordes()
 
 void overmap::move_nemesis()
 {
-    // Prevent hordes to be moved twice by putting them in here after moving.
-    decltype( zg ) tmpzg;
-    for( std::multimap<tripoint_om_sm, mongroup>::iterator it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        mongroup &mg = *it;
         if( !mg.horde || mg.horde_behaviour != "nemesis" ) {
-            ++it;
             continue;
         }
 
@@ -3824,9 +3841,8 @@ void overmap::move_nemesis()
                 local_pos.y() = local_sm.y();
                 local_pos.x() = local_sm.x();
 
-                // Erase the group at its old location, add the group with the new location
-                tmpzg.insert( std::pair<tripoint_om_sm, mongroup>( local_pos, mg ) );
-                zg.erase( it++ );
+                // File the group under its new location
+                zg.move( it.group_id(), local_pos );
                 break;
             }
         } else {
@@ -3834,19 +3850,15 @@ void overmap::move_nemesis()
         }
         break;
     }
-    // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
 }
 
 bool overmap::remove_nemesis()
 {
-    for( std::multimap<tripoint_om_sm, mongroup>::iterator it = zg.begin(); it != zg.end(); ) {
-        mongroup &mg = it->second;
-        if( mg.horde_behaviour == "nemesis" ) {
-            zg.erase( it++ );
+    for( auto it = zg.begin(); it != zg.end(); ++it ) {
+        if( it->horde_behaviour == "nemesis" ) {
+            zg.erase( it.group_id() );
             return true;
         }
-        ++it;
     }
     return false;
 }
@@ -3857,8 +3869,7 @@ bool overmap::remove_nemesis()
 */
 void overmap::signal_hordes( const tripoint_abs_sm &p, const int sig_power )
 {
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    for( mongroup &mg : zg ) {
         if( !mg.horde ) {
             continue;
         }
@@ -3899,9 +3910,7 @@ void overmap::signal_hordes( const tripoint_abs_sm &p, const int sig_power )
 
 void overmap::signal_nemesis( const tripoint_abs_sm &p_abs_sm )
 {
-    for( std::pair<const tripoint_om_sm, mongroup> &elem : zg ) {
-        mongroup &mg = elem.second;
-
+    for( mongroup &mg : zg ) {
         if( mg.horde_behaviour == "nemesis" ) {
             // If the horde is a nemesis, we set its target directly on the player.
             mg.set_target( p_abs_sm );
@@ -4137,7 +4146,8 @@ void overmap::place_forests()
     const oter_id forest( "forest" );
     const oter_id forest_thick( "forest_thick" );
 
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( om_noise::om_noise_layer_forest( global_base_point(),
+                                     g->get_seed() ) );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -4150,7 +4160,7 @@ void overmap::place_forests()
                 continue;
             }
 
-            const float n = f.noise_at( p.xy() );
+            const float n = f.at( p.xy() );
 
             // If the noise here meets our threshold, turn it into a forest.
             if( n > settings->overmap_forest.noise_threshold_forest_thick ) {
@@ -4165,9 +4175,12 @@ void overmap::place_forests()
 void overmap::place_lakes()
 {
     const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f_grid( f );
 
+    // Lakes are flood filled past the edge of the overmap, where there's no grid.
     const auto is_lake = [&]( const point_om_omt & p ) {
-        return f.noise_at( p ) > settings->overmap_lake.noise_threshold_lake;
+        const float n = inbounds( p ) ? f_grid.at( p ) : f.noise_at( p );
+        return n > settings->overmap_lake.noise_threshold_lake;
     };
 
     const oter_id lake_surface( "lake_surface" );
@@ -4485,7 +4498,8 @@ void overmap::place_swamps()
     const oter_id forest_water( "forest_water" );
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( om_noise::om_noise_layer_floodplain( global_base_point(),
+                                     g->get_seed() ) );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -4498,12 +4512,12 @@ void overmap::place_swamps()
 
             // If this was a part of our buffered floodplain, and the noise here meets the threshold, and the one_in rng
             // triggers, then we should flood this location and make it a swamp.
-            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) && f.noise_at( { x, y } )
+            const bool should_flood = ( floodplain[x][y] > 0 && !one_in( floodplain[x][y] ) && f.at( { x, y } )
                                         > settings->overmap_forest.noise_threshold_swamp_adjacent_water );
 
             // If this location meets our isolated swamp threshold, regardless of floodplain values, we'll make it
             // into a swamp.
-            const bool should_isolated_swamp = f.noise_at( pos.xy() ) >
+            const bool should_isolated_swamp = f.at( pos.xy() ) >
                                                settings->overmap_forest.noise_threshold_swamp_isolated;
             if( should_flood || should_isolated_swamp )  {
                 ter_set( pos, forest_water );
@@ -4980,17 +4994,34 @@ pf::directed_path<point_om_omt> overmap::lay_out_connection(
     const overmap_connection &connection, const point_om_omt &source, const point_om_omt &dest,
     int z, const bool must_be_unexplored ) const
 {
+    // What the connection makes of each terrain, looked up once per terrain instead of on
+    // every node scored: pick_subtype_for takes a lock, and has() walks every subtype.
+    struct terrain_fit {
+        const overmap_connection::subtype *subtype;
+        bool existing_connection;
+    };
+    std::unordered_map<oter_id, terrain_fit> fits;
+    const auto fit_for = [&]( const oter_id & id ) -> const terrain_fit & {
+        auto it = fits.find( id );
+        if( it == fits.end() ) {
+            const auto fit = terrain_fit{ connection.pick_subtype_for( id ), connection.has( id ) };
+            it = fits.emplace( id, fit ).first;
+        }
+        return it->second;
+    };
+
     const pf::two_node_scoring_fn<point_om_omt> estimate =
     [&]( pf::directed_node<point_om_omt> cur, std::optional<pf::directed_node<point_om_omt>> prev ) {
         const auto &id( ter( tripoint_om_omt( cur.pos, z ) ) );
 
-        const overmap_connection::subtype *subtype = connection.pick_subtype_for( id );
+        const terrain_fit &fit = fit_for( id );
+        const overmap_connection::subtype *subtype = fit.subtype;
 
         if( !subtype ) {
             return pf::node_score::rejected;  // No option for this terrain.
         }
 
-        const bool existing_connection = connection.has( id );
+        const bool existing_connection = fit.existing_connection;
 
         // Only do this check if it needs to be unexplored and there isn't already a connection.
         if( must_be_unexplored && !existing_connection ) {
@@ -5012,7 +5043,7 @@ pf::directed_path<point_om_omt> overmap::lay_out_connection(
         if( prev && prev->dir != om_direction::type::invalid && prev->dir != cur.dir ) {
             // Direction has changed.
             const oter_id &prev_id = ter( tripoint_om_omt( prev->pos, z ) );
-            const overmap_connection::subtype *prev_subtype = connection.pick_subtype_for( prev_id );
+            const overmap_connection::subtype *prev_subtype = fit_for( prev_id ).subtype;
 
             if( !prev_subtype || !prev_subtype->allows_turns() ) {
                 return pf::node_score::rejected;
@@ -5023,7 +5054,10 @@ pf::directed_path<point_om_omt> overmap::lay_out_connection(
             // Non-linear connections starting near overmap border should always be perpendicular to that border
             const oter_id &prev_id = ter( tripoint_om_omt( prev->pos, z ) );
 
-            if( !connection.can_start_at( prev_id ) && !inbounds( cur.pos, 1 ) &&
+            // Same as overmap_connection::can_start_at
+            const overmap_connection::subtype *prev_subtype = fit_for( prev_id ).subtype;
+            const bool can_start_at_prev = prev_subtype && prev_subtype->allows_turns();
+            if( !can_start_at_prev && !inbounds( cur.pos, 1 ) &&
                 inbounds( prev->pos + om_direction::displace( om_direction::opposite( cur.dir ), 1 ) ) ) {
                 return pf::node_score::rejected;
             }
@@ -5606,6 +5640,34 @@ om_direction::type om_direction::from_cube( cube_direction c, const std::string
 
 om_direction::type overmap::random_special_rotation( const overmap_special &special,
         const tripoint_om_omt &p, const bool must_be_unexplored ) const
+{
+    std::vector<om_direction::type> rotations = best_connected_rotations( special, p );
+
+    // Pick first valid rotation at random.
+    std::shuffle( rotations.begin(), rotations.end(), rng_get_engine() );
+    const auto rotation = std::find_if( rotations.begin(), rotations.end(),
+    [&]( om_direction::type elem ) {
+        return can_place_special( special, p, elem, must_be_unexplored );
+    } );
+
+    return rotation != rotations.end() ? *rotation : om_direction::type::invalid;
+}
+
+overmap::special_rotations overmap::check_special_rotations( const overmap_special &special,
+        const tripoint_om_omt &p ) const
+{
+    special_rotations result;
+    result.best = best_connected_rotations( special, p );
+    for( const om_direction::type r : result.best ) {
+        if( can_place_special( special, p, r, false ) ) {
+            result.placeable |= 1u << static_cast<int>( r );
+        }
+    }
+    return result;
+}
+
+std::vector<om_direction::type> overmap::best_connected_rotations(
+    const overmap_special &special, const tripoint_om_omt &p ) const
 {
     std::vector<om_direction::type> rotations( om_direction::size );
     const auto first = rotations.begin();
@@ -5647,13 +5709,8 @@ om_direction::type overmap::random_special_rotation( const overmap_special &spec
         }
     }
 
-    // Pick first valid rotation at random.
-    std::shuffle( first, last, rng_get_engine() );
-    const auto rotation = std::find_if( first, last, [&]( om_direction::type elem ) {
-        return can_place_special( special, p, elem, must_be_unexplored );
-    } );
-
-    return rotation != last ? *rotation : om_direction::type::invalid;
+    rotations.erase( last, rotations.end() );
+    return rotations;
 }
 
 bool overmap::can_place_special( const overmap_special &special, const tripoint_om_omt &p,
@@ -6019,6 +6076,49 @@ int overmap::place_special_attempt( const overmap_special &special, const int ma
         max_per_city = std::ceil( static_cast<float>( max ) / valid_cities );
     }
 
+    // Candidates are checked ahead in parallel blocks.  The checks only read terrain and
+    // draw no random numbers, so picking rotations from them gives the same result as
+    // checking serially.  A placement changes terrain anywhere its connections reach, so
+    // it throws away what was checked.  Placements tend to need few candidates and misses
+    // many, so blocks start small and grow while nothing gets placed.
+    const bool check_ahead = !must_be_unexplored;
+    constexpr size_t min_check_block = 32;
+    constexpr size_t max_check_block = 1024;
+    size_t check_block = min_check_block;
+    std::unordered_map<tripoint_om_omt, special_rotations> checked;
+    const auto check_from = [&]( std::list<tripoint_om_omt>::iterator from ) {
+        std::vector<tripoint_om_omt> block;
+        for( ; from != points.end() && block.size() < check_block; ++from ) {
+            block.push_back( *from );
+        }
+        std::vector<special_rotations> found( block.size() );
+        parallel_for( "special_rotations", 0, static_cast<int>( block.size() ), [&]( const int i ) {
+            found[i] = check_special_rotations( special, block[i] );
+        } );
+        checked.clear();
+        for( size_t i = 0; i < block.size(); i++ ) {
+            checked.emplace( block[i], std::move( found[i] ) );
+        }
+        check_block = std::min( check_block * 2, max_check_block );
+    };
+    const auto rotation_at = [&]( const std::list<tripoint_om_omt>::iterator & p ) {
+        if( !check_ahead ) {
+            return random_special_rotation( special, *p, must_be_unexplored );
+        }
+        auto found = checked.find( *p );
+        if( found == checked.end() ) {
+            check_from( p );
+            found = checked.find( *p );
+        }
+        special_rotations &options = found->second;
+        // Same draw as random_special_rotation() makes.
+        std::shuffle( options.best.begin(), options.best.end(), rng_get_engine() );
+        const auto rotation = std::ranges::find_if( options.best, [&]( om_direction::type r ) {
+            return ( options.placeable & ( 1u << static_cast<int>( r ) ) ) != 0;
+        } );
+        return rotation != options.best.end() ? *rotation : om_direction::type::invalid;
+    };
+
     int placed = 0;
     for( auto p = points.begin(); p != points.end(); ) {
         const city &nearest_city = get_nearest_city( *p );
@@ -6034,13 +6134,15 @@ int overmap::place_special_attempt( const overmap_special &special, const int ma
         }
 
         // See if we can actually place the special there.
-        const auto rotation = random_special_rotation( special, *p, must_be_unexplored );
+        const auto rotation = rotation_at( p );
         if( rotation == om_direction::type::invalid ) {
             p++;
             continue;
         }
         std::vector<tripoint_om_omt> result = place_special( special, *p, rotation, nearest_city, false,
                                               must_be_unexplored );
+        checked.clear();
+        check_block = min_check_block;
         if( need_city ) {
             valid_city[&nearest_city]++;
         }
@@ -6375,6 +6477,7 @@ auto overmap::open( const dimension_id &dim_id,
         // pointers looks like (north, south, west, east)
         generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
     }
+    compact_layers();
 }
 
 // Note: this may throw io errors from std::ofstream
@@ -6405,8 +6508,7 @@ void overmap::add_mon_group( const mongroup &group )
     // makes the diffuse setting obsolete (as it only controls how the radius
     // is interpreted) - it's only used when adding monster groups with function.
     if( group.radius == 1 ) {
-        zg.insert( std::pair<tripoint_om_sm, mongroup>( project_remain<coords::om>
-                   ( group.abs_pos ).remainder_tripoint, group ) );
+        zg.insert( project_remain<coords::om>( group.abs_pos ).remainder_tripoint, group );
         return;
     }
     // diffuse groups use a circular area, non-diffuse groups use a rectangular area
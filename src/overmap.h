@@ -22,11 +22,13 @@
 #include "cube_direction.h"
 #include "enums.h"
 #include "enum_conversions.h"
+#include "flat_hash_map.h"
 #include "game_constants.h"
 #include "mapgendata.h"
 #include "memory_fast.h"
 #include "mongroup.h"
 #include "omdata.h"
+#include "overmap_road_graph.h"
 #include "overmap_types.h" // IWYU pragma: keep
 #include "pimpl.h"
 #include "point.h"
@@ -108,11 +110,91 @@ struct radio_tower {
                  radio_type T = radio_type::MESSAGE_BROADCAST );
 };
 
+/**
+ * One value per OMT of a z-level.  Most levels away from the surface hold the same value
+ * everywhere (solid rock, open air, nothing seen yet), so a layer is kept as that single
+ * value until some OMT is set to something else.
+ */
+template<typename T>
+class overmap_layer_grid
+{
+    public:
+        explicit overmap_layer_grid( const T &value = T() ) : fill_value( value ) {}
+        overmap_layer_grid( const overmap_layer_grid &other ) : fill_value( other.fill_value ) {
+            copy_tiles( other );
+        }
+        overmap_layer_grid( overmap_layer_grid && ) noexcept = default;
+        overmap_layer_grid &operator=( const overmap_layer_grid &other ) {
+            if( this != &other ) {
+                fill_value = other.fill_value;
+                copy_tiles( other );
+            }
+            return *this;
+        }
+        overmap_layer_grid &operator=( overmap_layer_grid && ) noexcept = default;
+
+        const T &get( const point_om_omt &p ) const {
+            return tiles ? tiles[index( p )] : fill_value;
+        }
+        void set( const point_om_omt &p, const T &value ) {
+            if( !tiles ) {
+                if( value == fill_value ) {
+                    return;
+                }
+                tiles = std::make_unique<T[]>( OMAPX * OMAPY );
+                std::fill_n( tiles.get(), OMAPX * OMAPY, fill_value );
+            }
+            tiles[index( p )] = value;
+        }
+        /** Sets every OMT to @p value. */
+        void fill( const T &value ) {
+            fill_value = value;
+            tiles.reset();
+        }
+        /** Goes back to a single value if every OMT has come to hold the same one. */
+        void compact() {
+            if( !tiles ) {
+                return;
+            }
+            const T first = tiles[0];
+            for( int i = 1; i < OMAPX * OMAPY; ++i ) {
+                if( tiles[i] != first ) {
+                    return;
+                }
+            }
+            fill( first );
+        }
+        bool is_uniform() const {
+            return !tiles;
+        }
+        auto heap_bytes() const -> std::size_t {
+            return tiles ? OMAPX * OMAPY * sizeof( T ) : 0;
+        }
+
+    private:
+        static int index( const point_om_omt &p ) {
+            return p.x() * OMAPY + p.y();
+        }
+        void copy_tiles( const overmap_layer_grid &other ) {
+            if( !other.tiles ) {
+                tiles.reset();
+                return;
+            }
+            if( !tiles ) {
+                tiles = std::make_unique<T[]>( OMAPX * OMAPY );
+            }
+            std::copy_n( other.tiles.get(), OMAPX * OMAPY, tiles.get() );
+        }
+
+        T fill_value;
+        std::unique_ptr<T[]> tiles;
+};
+
 struct map_layer {
-    oter_id terrain[OMAPX][OMAPY];
-    bool visible[OMAPX][OMAPY];
-    bool explored[OMAPX][OMAPY];
-    bool path[OMAPX][OMAPY];
+    overmap_layer_grid<oter_id> terrain;
+    overmap_layer_grid<bool> visible;
+    overmap_layer_grid<bool> explored;
+    overmap_layer_grid<bool> path;
     std::vector<om_note> notes;
     std::vector<om_map_extra> extras;
 };
@@ -330,12 +412,16 @@ class overmap
         /** Rebuilds mapgen_args_init_flags_ from mapgen_arg_storage after load. */
         void sync_mapgen_args_init_flags();
 
-        bool &seen( const tripoint_om_omt &p );
         bool seen( const tripoint_om_omt &p ) const;
-        bool &explored( const tripoint_om_omt &p );
+        void set_seen( const tripoint_om_omt &p, bool seen );
         bool is_explored( const tripoint_om_omt &p ) const;
-        bool &path( const tripoint_om_omt &p );
+        void set_explored( const tripoint_om_omt &p, bool explored );
         bool is_path( const tripoint_om_omt &p ) const;
+        void set_path( const tripoint_om_omt &p, bool path );
+        /** Releases per-OMT storage of layers that turned out to hold a single value. */
+        void compact_layers();
+        /** Approximate bytes held by the layers, notes and extras. */
+        auto memory_usage() const -> std::size_t;
 
         bool has_note( const tripoint_om_omt &p ) const;
         std::optional<int> has_note_with_danger_radius( const tripoint_om_omt &p ) const;
@@ -417,7 +503,7 @@ class overmap
         void place_special_forced( const overmap_special_id &special_id, const tripoint_om_omt &p,
                                    om_direction::type dir );
     private:
-        std::multimap<tripoint_om_sm, mongroup> zg;
+        mongroup_index zg;
     public:
         /** Unit test enablers to check if a given mongroup is present. */
         bool mongroup_check( const mongroup &candidate ) const;
@@ -437,6 +523,8 @@ class overmap
         std::vector<city> cities;
         std::map<overmap_connection_id, std::vector<tripoint_om_omt>> connections_out;
         std::optional<overmap_connection_cache> connection_cache;
+        /** Built on first use by overmapbuffer::get_travel_path, dropped by ter_set and path edits. */
+        std::shared_ptr<const overmap_road_graph> road_graph;
         /// Adds the npc to the contained list of npcs ( @ref npcs ).
         void insert_npc( const shared_ptr_fast<npc> &who );
         /// Removes the npc and returns it ( or returns nullptr if not found ).
@@ -459,12 +547,11 @@ class overmap
 
         std::vector<shared_ptr_fast<npc>> npcs;
 
-        bool nullbool = false;
         point_abs_om loc;
         dimension_id dimension_id_;
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
-        std::unordered_map<tripoint_abs_omt, scent_trace> scents;
+        cata::flat_hash_map<tripoint_abs_omt, scent_trace> scents;
 
         // Records the locations where a given overmap special was placed, which
         // can be used after placement to lookup whether a given location was created
@@ -481,7 +568,7 @@ class overmap
         // These are lazily evaluated; empty optional means that they have yet
         // to be evaluated.
         std::vector<std::optional<mapgen_arguments>> mapgen_arg_storage;
-        std::unordered_map<tripoint_om_omt, int> mapgen_args_index;
+        cata::flat_hash_map<tripoint_om_omt, int> mapgen_args_index;
         /** Parallel to mapgen_arg_storage; non-zero means the entry is fully written.
          *  Stored as plain char so the vector is movable; accessed atomically via
          *  std::atomic_ref<char> to provide acquire/release ordering. */
@@ -583,6 +670,12 @@ class overmap
 
         om_direction::type random_special_rotation( const overmap_special &special,
                 const tripoint_om_omt &p, bool must_be_unexplored ) const;
+        /**
+         * Rotations of @p special at @p p that satisfy the most connections with existing
+         * terrain, in om_direction::all order.  random_special_rotation() picks among these.
+         */
+        std::vector<om_direction::type> best_connected_rotations( const overmap_special &special,
+                const tripoint_om_omt &p ) const;
 
         bool can_place_special( const overmap_special &special, const tripoint_om_omt &p,
                                 om_direction::type dir, bool must_be_unexplored ) const;
@@ -614,6 +707,15 @@ class overmap
 
         int place_special_custom( const overmap_special &special, std::vector<tripoint_om_omt> &points );
 
+        /** Outcome of checking a candidate point ahead of place_special_attempt() reaching it. */
+        struct special_rotations {
+            std::vector<om_direction::type> best;
+            /** Bit per om_direction::type among @ref best that the footprint fits in. */
+            unsigned placeable = 0;
+        };
+        special_rotations check_special_rotations( const overmap_special &special,
+                const tripoint_om_omt &p ) const;
+
         void place_mongroups();
         void place_radios();
 
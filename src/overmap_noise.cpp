@@ -3,6 +3,7 @@
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
+#include "thread_pool.h"
 
 namespace om_noise
 {
@@ -35,4 +36,13 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+om_noise_grid::om_noise_grid( const om_noise_layer &layer ) : values( OMAPX * OMAPY )
+{
+    parallel_for( "om_noise_grid", 0, OMAPY, [&]( const int y ) {
+        for( int x = 0; x < OMAPX; x++ ) {
+            values[y * OMAPX + x] = layer.noise_at( point_om_omt( x, y ) );
+        }
+    } );
+}
+
 } // namespace om_noise
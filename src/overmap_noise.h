@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 #include "point.h"
@@ -76,6 +78,25 @@ class om_noise_layer_lake : public om_noise_layer
         float noise_at( const point_om_omt &local_omt_pos ) const override;
 };
 
+/**
+ * A layer's noise over every overmap terrain of the overmap, evaluated up front.
+ * Rows are spread over the thread pool, which is worth it since layers take a few
+ * dozen noise octaves per location and generation reads most of them anyway.
+ */
+class om_noise_grid
+{
+    public:
+        explicit om_noise_grid( const om_noise_layer &layer );
+
+        /** @param omt_local must be inbounds for the overmap. */
+        float at( const point_om_omt &omt_local ) const {
+            return values[omt_local.y() * OMAPX + omt_local.x()];
+        }
+
+    private:
+        std::vector<float> values;
+};
+
 } // namespace om_noise
 
 
@@ -0,0 +1,116 @@
+#include "overmap_road_graph.h"
+
+#include <unordered_set>
+#include <utility>
+
+#include "game_constants.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "point.h"
+
+namespace
+{
+
+// Roads and bridges never leave these levels.
+constexpr int road_min_z = 0;
+constexpr int road_max_z = 1;
+
+bool is_road_tile( const overmap &om, const tripoint_om_omt &p )
+{
+    return overmap_road_graph::is_road( om.ter( p ) ) || om.is_path( p );
+}
+
+bool on_border( const tripoint_om_omt &p )
+{
+    return p.x() == 0 || p.y() == 0 || p.x() == OMAPX - 1 || p.y() == OMAPY - 1;
+}
+
+std::vector<tripoint_om_omt> road_links( const overmap &om, const tripoint_om_omt &p )
+{
+    std::vector<tripoint_om_omt> ret;
+    for( const point &d : four_adjacent_offsets ) {
+        const tripoint_om_omt q = p + d;
+        if( overmap::inbounds( q ) && is_road_tile( om, q ) ) {
+            ret.push_back( q );
+        }
+    }
+    if( overmap_road_graph::is_ramp( om.ter( p ) ) ) {
+        // Only ramp to ramp, so that links stay symmetric
+        for( const int dz : { -1, 1 } ) {
+            const tripoint_om_omt q = p + tripoint( 0, 0, dz );
+            if( q.z() >= road_min_z && q.z() <= road_max_z &&
+                overmap_road_graph::is_ramp( om.ter( q ) ) ) {
+                ret.push_back( q );
+            }
+        }
+    }
+    return ret;
+}
+
+} // namespace
+
+bool overmap_road_graph::is_road( const oter_id &oter )
+{
+    return is_ot_match( "road", oter, ot_match_type::type ) ||
+           is_ot_match( "bridge", oter, ot_match_type::type ) ||
+           is_ot_match( "bridge_road", oter, ot_match_type::type ) ||
+           is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
+           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type ) ||
+           is_ot_match( "road_nesw_manhole", oter, ot_match_type::type );
+}
+
+bool overmap_road_graph::is_ramp( const oter_id &oter )
+{
+    return is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
+           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type );
+}
+
+overmap_road_graph::overmap_road_graph( const overmap &om )
+{
+    std::unordered_map<tripoint_om_omt, std::vector<tripoint_om_omt>> links;
+    for( int z = road_min_z; z <= road_max_z; ++z ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            for( int y = 0; y < OMAPY; ++y ) {
+                const tripoint_om_omt p( x, y, z );
+                if( is_road_tile( om, p ) ) {
+                    links.emplace( p, road_links( om, p ) );
+                }
+            }
+        }
+    }
+    for( const auto &[p, next] : links ) {
+        if( next.size() != 2 || on_border( p ) || is_ramp( om.ter( p ) ) ) {
+            nodes[p];
+        }
+    }
+
+    // Every chain is walked once from each end; the first walk keeps it.
+    std::unordered_set<tripoint_om_omt> folded;
+    for( auto &[start, start_links] : nodes ) {
+        for( const tripoint_om_omt &first : links.at( start ) ) {
+            chain c{ .from = start };
+            tripoint_om_omt prev = start;
+            tripoint_om_omt cur = first;
+            while( !nodes.contains( cur ) ) {
+                const std::vector<tripoint_om_omt> &next_links = links.at( cur );
+                const tripoint_om_omt next = next_links[0] == prev ? next_links[1] : next_links[0];
+                c.tiles.push_back( cur );
+                if( next - cur != cur - prev ) {
+                    c.turns++;
+                }
+                prev = cur;
+                cur = next;
+            }
+            c.to = cur;
+            const bool walked = c.tiles.empty() ? c.to < start : folded.contains( c.tiles.front() );
+            if( walked ) {
+                continue;
+            }
+            folded.insert( c.tiles.begin(), c.tiles.end() );
+            const int index = chains.size();
+            start_links.push_back( { index, false } );
+            nodes[c.to].push_back( { index, true } );
+            chains.emplace_back( std::move( c ) );
+        }
+    }
+}
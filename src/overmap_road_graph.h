@@ -0,0 +1,43 @@
+#pragma once
+
+#include <unordered_map>
+#include <vector>
+
+#include "coordinates.h"
+#include "type_id.h"
+
+class overmap;
+
+/**
+ * Contracted graph of the road network on one overmap, used by long overmap trips.
+ *
+ * Road tiles that join exactly two other road tiles are folded into chains, so only
+ * junctions, dead ends, bridge ramps and tiles on the overmap border remain as nodes.
+ * Border nodes are what ties the graphs of neighbouring overmaps together.
+ * The graph is built lazily and dropped whenever the overmap's terrain or paths change.
+ */
+struct overmap_road_graph {
+    struct chain {
+        tripoint_om_omt from;
+        tripoint_om_omt to;
+        /** Tiles strictly between @ref from and @ref to, in order from @ref from. */
+        std::vector<tripoint_om_omt> tiles;
+        /** How many of @ref tiles turn a corner. */
+        int turns = 0;
+    };
+    struct link {
+        int chain;
+        /** The chain is walked from its @ref chain::to end. */
+        bool reversed;
+    };
+
+    std::vector<chain> chains;
+    std::unordered_map<tripoint_om_omt, std::vector<link>> nodes;
+
+    explicit overmap_road_graph( const overmap &om );
+
+    /** Whether overmap travel prices @p oter as road. */
+    static bool is_road( const oter_id &oter );
+    /** Whether travel may change z-level on @p oter. */
+    static bool is_ramp( const oter_id &oter );
+};
@@ -65,6 +65,7 @@
 #include "sdltiles.h"
 #include "sounds.h"
 #include "string_formatter.h"
+#include "submap_load_manager.h"
 #include "string_id.h"
 #include "string_input_popup.h"
 #include "string_utils.h"
@@ -412,6 +413,43 @@ static bool get_scent_glyph( const tripoint_abs_omt &pos, nc_color &ter_color,
     return false;
 }
 
+/**
+ * Letter and colour of the load request keeping @p pos resident: upper case for requests
+ * that simulate, lower case for resident-only ones, 'r' for columns only retained.
+ */
+static auto residency_glyph( const tripoint_abs_omt &pos )
+-> std::optional<std::pair<std::string, nc_color>>
+{
+    const dimension_id &dim_id = g->get_current_dimension_id();
+    const point_abs_sm sm_base = project_to<coords::sm>( pos.xy() );
+    for( const point &off : { point_zero, point_south, point_east, point_south_east } ) {
+        const auto source = submap_loader.covering_source( dim_id, sm_base + off );
+        if( !source ) {
+            continue;
+        }
+        switch( *source ) {
+            case load_request_source::reality_bubble:
+                return std::pair{ "B", c_light_green };
+            case load_request_source::player_base:
+                return std::pair{ "P", c_green };
+            case load_request_source::script:
+                return std::pair{ "S", c_magenta };
+            case load_request_source::fire_spread:
+                return std::pair{ "F", c_light_red };
+            case load_request_source::portal_preload:
+                return std::pair{ "O", c_light_cyan };
+            case load_request_source::lazy_border:
+                return std::pair{ "l", c_yellow };
+            case load_request_source::prefetch:
+                return std::pair{ "p", c_cyan };
+        }
+    }
+    if( submap_loader.is_retained( dim_id, pos.xy() ) ) {
+        return std::pair{ "r", c_light_gray };
+    }
+    return std::nullopt;
+}
+
 static auto has_player_label( const tripoint_abs_omt &pos ) -> bool
 {
     const auto player_label = overmap_label_note::extract_label( ACTIVE_OVERMAP_BUFFER.note( pos ) );
@@ -1224,6 +1262,13 @@ static void draw_ascii( ui_adaptor &ui,
                 }
             }
 
+            // Are we debugging submap residency?
+            if( blink && data.debug_residency ) {
+                if( const auto residency = residency_glyph( omp ) ) {
+                    std::tie( ter_sym, ter_color ) = *residency;
+                }
+            }
+
             // Preview for place_terrain or place_special
             if( uistate.place_terrain || uistate.place_special ) {
                 if( blink && uistate.place_terrain && omp.xy() == center.xy() ) {
@@ -2040,11 +2085,11 @@ static void set_special_args( tripoint_abs_omt &curs )
     *maybe_args = args;
 }
 
-static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt dest,
+static std::unique_ptr<overmap_travel_plan> plan_overmap_path_to( const tripoint_abs_omt dest,
         bool driving )
 {
     if( !ACTIVE_OVERMAP_BUFFER.seen( dest ) ) {
-        return {};
+        return nullptr;
     }
     const Character &player_character = get_player_character();
     map &here = get_map();
@@ -2055,7 +2100,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
         const optional_vpart_position vp = here.veh_at( player_character.bub_pos() );
         if( !vp.has_value() ) {
             debugmsg( "Failed to find driven vehicle" );
-            return {};
+            return nullptr;
         }
         player_veh = &vp->vehicle();
         // for now we can only handle flyers if already in the air
@@ -2073,7 +2118,7 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
             const bool tiny = player_veh->get_points().size() <= 3;
             params = overmap_path_params::for_land_vehicle( offroad_coeff, tiny, can_float );
         } else {
-            return {};
+            return nullptr;
         }
     } else {
         params = overmap_path_params::for_player();
@@ -2087,9 +2132,9 @@ static std::vector<tripoint_abs_omt> get_overmap_path_to( const tripoint_abs_omt
     const tripoint_abs_omt start_omt_pos = driving ? project_to<coords::omt>
                                            ( player_veh->abs_sm_pos ) : player_omt_pos;
     if( dest == player_omt_pos || dest == start_omt_pos ) {
-        return {};
+        return nullptr;
     } else {
-        return ACTIVE_OVERMAP_BUFFER.get_travel_path( start_omt_pos, dest, params );
+        return ACTIVE_OVERMAP_BUFFER.plan_travel_path( start_omt_pos, dest, params );
     }
 }
 
@@ -2189,14 +2234,26 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
         curs.z() = 0;
     }
 
+    // Route to the chosen destination, searched while the UI keeps taking input
+    std::unique_ptr<overmap_travel_plan> travel_plan;
+    bool travel_plan_driving = false;
+
     ui.on_redraw( [&]( ui_adaptor & ui ) {
         draw( ui, curs, orig, uistate.overmap_show_overlays,
               show_explored, fast_scroll, &ictxt, data, grids_data );
+        if( travel_plan ) {
+            mvwprintz( g->w_omlegend, point( 1, getmaxy( g->w_omlegend ) - 3 ), c_yellow,
+                       _( "Planning route (%d)… %s to cancel" ), travel_plan->searched(),
+                       ictxt.get_desc( "QUIT" ) );
+            wnoutrefresh( g->w_omlegend );
+        }
     } );
 
     do {
 
         ui_manager::redraw();
+        // Poll a pending route often enough for its progress to look alive
+        constexpr int travel_plan_poll_ms = 50;
 #if (defined TILES || defined _WIN32 || defined WINDOWS )
         int scroll_timeout = get_option<int>( "EDGE_SCROLL" );
         // If EDGE_SCROLL is disabled, it will have a value of -1.
@@ -2204,9 +2261,13 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
         if( scroll_timeout < 0 ) {
             scroll_timeout = get_option<int>( "BLINK_SPEED" );
         }
+        if( travel_plan ) {
+            scroll_timeout = std::min( scroll_timeout, travel_plan_poll_ms );
+        }
         action = ictxt.handle_input( scroll_timeout );
 #else
-        action = ictxt.handle_input( get_option<int>( "BLINK_SPEED" ) );
+        action = ictxt.handle_input( travel_plan ? travel_plan_poll_ms :
+                                     get_option<int>( "BLINK_SPEED" ) );
 #endif
         if( const std::optional<tripoint_rel_ms> vec = ictxt.get_direction( action ) ) {
             int scroll_d = fast_scroll ? fast_scroll_offset : 1;
@@ -2235,6 +2296,9 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
             ui.mark_resize();
         } else if( action == "CONFIRM" ) {
             ret = curs;
+        } else if( action == "QUIT" && travel_plan ) {
+            travel_plan.reset();
+            action.clear();
         } else if( action == "QUIT" ) {
             ret = overmap::invalid_tripoint;
         } else if( action == "CREATE_NOTE" ) {
@@ -2250,34 +2314,11 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
             }
         } else if( action == "CHOOSE_DESTINATION" ) {
             avatar &player_character = get_avatar();
-            const bool driving = player_character.in_vehicle && player_character.controlling_vehicle;
-            std::vector<tripoint_abs_omt> path = get_overmap_path_to( curs, driving );
-            bool same_path_selected = false;
-            if( path == player_character.omt_path ) {
-                same_path_selected = true;
-            } else {
-                player_character.omt_path.swap( path );
-            }
-            if( same_path_selected && !player_character.omt_path.empty() ) {
-                std::string confirm_msg;
-                if( !driving && player_character.weight_carried() > player_character.weight_capacity() ) {
-                    confirm_msg = _( "You are overburdened, are you sure you want to travel (it may be painful)?" );
-                } else if( !driving && player_character.in_vehicle ) {
-                    confirm_msg = _( "You are in a vehicle but not driving.  Are you sure you want to walk?" );
-                } else if( driving ) {
-                    confirm_msg = _( "Drive to this point?" );
-                } else {
-                    confirm_msg = _( "Travel to this point?" );
-                }
-                if( query_yn( confirm_msg ) ) {
-                    if( driving ) {
-                        player_character.assign_activity( std::make_unique<player_activity>
-                                                          ( std::make_unique<autodrive_activity_actor>() ) );
-                    } else {
-                        player_character.reset_move_mode();
-                        player_character.assign_activity( ACT_TRAVELLING );
-                    }
-                    action = "QUIT";
+            if( !travel_plan || travel_plan->destination() != curs ) {
+                travel_plan_driving = player_character.in_vehicle && player_character.controlling_vehicle;
+                travel_plan = plan_overmap_path_to( curs, travel_plan_driving );
+                if( !travel_plan ) {
+                    player_character.omt_path.clear();
                 }
             }
         } else if( action == "TOGGLE_BLINKING" ) {
@@ -2343,6 +2384,41 @@ static tripoint_abs_omt display( const tripoint_abs_omt &orig,
             g->list_missions();
         }
 
+        if( travel_plan && travel_plan->ready() ) {
+            avatar &player_character = get_avatar();
+            const bool driving = travel_plan_driving;
+            std::vector<tripoint_abs_omt> path = travel_plan->take_path();
+            travel_plan.reset();
+            bool same_path_selected = false;
+            if( path == player_character.omt_path ) {
+                same_path_selected = true;
+            } else {
+                player_character.omt_path.swap( path );
+            }
+            if( same_path_selected && !player_character.omt_path.empty() ) {
+                std::string confirm_msg;
+                if( !driving && player_character.weight_carried() > player_character.weight_capacity() ) {
+                    confirm_msg = _( "You are overburdened, are you sure you want to travel (it may be painful)?" );
+                } else if( !driving && player_character.in_vehicle ) {
+                    confirm_msg = _( "You are in a vehicle but not driving.  Are you sure you want to walk?" );
+                } else if( driving ) {
+                    confirm_msg = _( "Drive to this point?" );
+                } else {
+                    confirm_msg = _( "Travel to this point?" );
+                }
+                if( query_yn( confirm_msg ) ) {
+                    if( driving ) {
+                        player_character.assign_activity( std::make_unique<player_activity>
+                                                          ( std::make_unique<autodrive_activity_actor>() ) );
+                    } else {
+                        player_character.reset_move_mode();
+                        player_character.assign_activity( ACT_TRAVELLING );
+                    }
+                    action = "QUIT";
+                }
+            }
+        }
+
         std::chrono::time_point<std::chrono::steady_clock> now = std::chrono::steady_clock::now();
         if( now > last_blink + std::chrono::milliseconds( get_option<int>( "BLINK_SPEED" ) ) ) {
             if( uistate.overmap_blinking ) {
@@ -2403,6 +2479,13 @@ void ui::omap::display_distribution_grids()
     overmap_ui::display( g->u.abs_omt_pos(), data );
 }
 
+void ui::omap::display_residency()
+{
+    overmap_ui::draw_data_t data;
+    data.debug_residency = true;
+    overmap_ui::display( get_player_character().abs_omt_pos(), data );
+}
+
 void ui::omap::display_editor()
 {
     overmap_ui::draw_data_t data;
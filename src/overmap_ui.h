@@ -43,6 +43,11 @@ void display_scents();
  * Display overmap like with @ref display() and display distribution grids.
  */
 void display_distribution_grids();
+/**
+ * Display overmap like with @ref display() and display which load request keeps each
+ * overmap tile resident.
+ */
+void display_residency();
 /**
  * Display overmap like with @ref display() and display the given zone.
  */
@@ -92,6 +97,8 @@ struct draw_data_t {
     int iZoneIndex = -1;
     // draw distribution grids
     bool debug_grids = false;
+    // draw submap residency by load request source
+    bool debug_residency = false;
 };
 
 #if defined(TILES)
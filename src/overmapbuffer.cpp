@@ -37,8 +37,10 @@
 #include "mongroup.h"
 #include "monster.h"
 #include "npc.h"
+#include "omdata.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_road_graph.h"
 #include "overmap_special.h"
 #include "overmap_types.h"
 #include "popup.h"
@@ -88,6 +90,17 @@ overmap &overmapbuffer::get( const point_abs_om &p )
         }
     }
 
+    // The overmap being generated ahead may be this one, or border it.  Workers don't
+    // wait for it, as they may be the one generating it.
+    if( !is_pool_worker_thread() ) {
+        finish_generating_ahead( true );
+        read_lock<std::shared_mutex> _l( mutex );
+        const auto it = overmaps.find( p );
+        if( it != overmaps.end() ) {
+            return *it->second.get();
+        }
+    }
+
     overmap *new_om;
     {
         write_lock<std::shared_mutex> _l( mutex );
@@ -127,6 +140,8 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
 
 void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
 {
+    finish_generating_ahead( true );
+
     struct pending {
         point_abs_om                          loc;
         std::future<std::unique_ptr<overmap>> future;
@@ -144,7 +159,7 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
         // Capture loc by value — [&] would reference the loop variable, which
         // advances each iteration, creating a latent race if threads outlive the loop.
         auto dim_id = dimension_id_;
-        futures.push_back( { loc, get_thread_pool().submit_returning( [loc, dim_id] {
+        futures.push_back( { loc, get_thread_pool().submit_returning( "overmap_generate", [loc, dim_id] {
                 auto om = std::make_unique<overmap>( loc, dim_id );
                 om->populate( dim_id );
                 return om;
@@ -162,82 +177,155 @@ void overmapbuffer::generate( const std::vector<point_abs_om> &locs )
                 std::future_status::ready ) {
                 return false;
             }
-            auto om = p.future.get();
-            overmap *om_ptr;
-            bool inserted;
-            {
-                write_lock<std::shared_mutex> _l( mutex );
-                auto [it, ins] = overmaps.emplace( p.loc, std::move( om ) );
-                om_ptr = it->second.get();
-                inserted = ins;
-            }
-            // Run fix passes after releasing the write lock.
-            // fix_mongroups / fix_nemesis / fix_npcs all call get() or has(),
-            // which acquire the mutex themselves.  Holding the write lock here
-            // causes same-thread deadlock on the non-recursive std::shared_mutex.
-            //
-            // Only run if we won the insertion race.  If another path (e.g.
-            // get() called from a neighbour's fix_nemesis) already inserted
-            // this overmap, it already ran the fix passes; running them again
-            // can corrupt mongroup data for the already-fixed entry.
-            if( inserted ) {
-                fix_mongroups( *om_ptr );
-                fix_nemesis( *om_ptr );
-                fix_npcs( *om_ptr );
-            }
+            insert_generated( p.loc, p.future.get() );
             return true;
         } ), futures.end() );
         popup->refresh();
     }
 }
 
+overmap &overmapbuffer::insert_generated( const point_abs_om &loc, std::unique_ptr<overmap> om )
+{
+    overmap *om_ptr;
+    bool inserted;
+    {
+        write_lock<std::shared_mutex> _l( mutex );
+        auto [it, ins] = overmaps.emplace( loc, std::move( om ) );
+        om_ptr = it->second.get();
+        inserted = ins;
+    }
+    // Run fix passes after releasing the write lock.
+    // fix_mongroups / fix_nemesis / fix_npcs all call get() or has(),
+    // which acquire the mutex themselves.  Holding the write lock here
+    // causes same-thread deadlock on the non-recursive std::shared_mutex.
+    //
+    // Only run if we won the insertion race.  If another path (e.g.
+    // get() called from a neighbour's fix_nemesis) already inserted
+    // this overmap, it already ran the fix passes; running them again
+    // can corrupt mongroup data for the already-fixed entry.
+    if( inserted ) {
+        fix_mongroups( *om_ptr );
+        fix_nemesis( *om_ptr );
+        fix_npcs( *om_ptr );
+    }
+    return *om_ptr;
+}
+
+void overmapbuffer::generate_ahead( const tripoint_abs_omt &center )
+{
+    ZoneScoped;
+    // Roughly how far from the edge of an overmap its neighbour starts generating.
+    static constexpr int generate_ahead_distance = OMAPX / 4;
+
+    if( pocket_info_ ) {
+        return;
+    }
+    finish_generating_ahead( false );
+    {
+        std::lock_guard<std::mutex> lk( generating_ahead_mutex_ );
+        if( generating_ahead_ ) {
+            return;
+        }
+    }
+
+    const auto [om_pos, local] = project_remain<coords::om>( center.xy() );
+    const auto distance_to_side = []( const int dir, const int v, const int size ) {
+        return dir < 0 ? v : dir > 0 ? size - 1 - v : 0;
+    };
+    std::optional<point_abs_om> nearest;
+    int nearest_distance = generate_ahead_distance + 1;
+    for( const point &dir : eight_adjacent_offsets ) {
+        const int distance = std::max( distance_to_side( dir.x, local.x(), OMAPX ),
+                                       distance_to_side( dir.y, local.y(), OMAPY ) );
+        const point_abs_om loc = om_pos + dir;
+        if( distance >= nearest_distance ) {
+            continue;
+        }
+        read_lock<std::shared_mutex> _l( mutex );
+        if( !overmaps.contains( loc ) ) {
+            nearest = loc;
+            nearest_distance = distance;
+        }
+    }
+    if( !nearest ) {
+        return;
+    }
+
+    auto dim_id = dimension_id_;
+    const point_abs_om loc = *nearest;
+    std::lock_guard<std::mutex> lk( generating_ahead_mutex_ );
+    generating_ahead_ = overmap_generating_ahead{
+        loc, get_thread_pool().submit_returning( "overmap_generate_ahead", [loc, dim_id] {
+            auto om = std::make_unique<overmap>( loc, dim_id );
+            om->populate( dim_id );
+            return om;
+        } )
+    };
+}
+
+void overmapbuffer::finish_generating_ahead( const bool wait )
+{
+    std::optional<overmap_generating_ahead> ahead;
+    {
+        std::lock_guard<std::mutex> lk( generating_ahead_mutex_ );
+        if( !generating_ahead_ ) {
+            return;
+        }
+        const auto ready = generating_ahead_->result.wait_for( std::chrono::seconds( 0 ) ) ==
+                           std::future_status::ready;
+        if( !wait && !ready ) {
+            return;
+        }
+        ahead = std::move( generating_ahead_ );
+        generating_ahead_.reset();
+    }
+    get_thread_pool().wait_helping( ahead->result );
+    insert_generated( ahead->loc, ahead->result.get() );
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
-    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        auto &mg = it->second;
+    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ++it ) {
+        auto &mg = *it;
         // spawn related code simply sets population to 0 when they have been
         // transformed into spawn points on a submap, the group can then be removed
         if( mg.empty() ) {
-            new_overmap.zg.erase( it++ );
+            new_overmap.zg.erase( it.group_id() );
             continue;
         }
         const auto proj = project_remain<coords::om>( mg.abs_pos );
         // Inside the bounds of the overmap?
         if( proj.quotient == new_overmap.pos() ) {
-            ++it;
             continue;
         }
         if( !has( proj.quotient ) ) {
             // Don't generate new overmaps, as this can be called from the
             // overmap-generating code.
-            ++it;
             continue;
         }
         overmap &om = get( proj.quotient );
         om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        new_overmap.zg.erase( it.group_id() );
     }
 }
 
 void overmapbuffer::fix_nemesis( overmap &new_overmap )
 {
-    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
-        mongroup &mg = it->second;
+    for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ++it ) {
+        mongroup &mg = *it;
 
         if( mg.horde_behaviour != "nemesis" ) {
-            ++it;
             continue;
         }
         const auto proj = project_remain<coords::om>( mg.abs_pos );
 
         if( proj.quotient == new_overmap.pos() ) {
-            ++it;
             continue;
         }
 
         overmap &om = get( proj.quotient );
         om.add_mon_group( mg );
-        new_overmap.zg.erase( it++ );
+        new_overmap.zg.erase( it.group_id() );
         break;
     }
 }
@@ -291,29 +379,61 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
         // Simplest case: just move the pointer
         get( npc_om_pos ).insert_npc( ptr );
     }
+    // Those that stayed came straight from the save or generation without passing
+    // through insert_npc
+    for( const auto &guy : new_overmap.npcs ) {
+        npc_index_.add( guy );
+    }
 }
 
 auto overmapbuffer::save( const dimension_id &dim_id ) -> void
 {
     read_lock<std::shared_mutex> _l( mutex );
 
-    for( auto &omp : overmaps ) {
-        // Note: this may throw io errors from std::ofstream
-        omp.second->save( dim_id );
-    }
+    // Overmaps serialize independently; world funnels the database writes
+    // through its single writer connection.
+    const auto to_save = overmaps | std::views::values
+    | std::views::transform( &std::unique_ptr<overmap>::get )
+    | std::ranges::to<std::vector>();
+    // Note: this may throw io errors from std::ofstream
+    parallel_for( "overmap_save", 0, static_cast<int>( to_save.size() ), [&]( const int i ) {
+        to_save[i]->save( dim_id );
+    } );
 }
 
 void overmapbuffer::clear()
 {
+    // Not inserted: the fix passes could load neighbours of an overmap about to be dropped.
+    std::optional<overmap_generating_ahead> ahead;
+    {
+        std::lock_guard<std::mutex> lk( generating_ahead_mutex_ );
+        ahead = std::move( generating_ahead_ );
+        generating_ahead_.reset();
+    }
+    if( ahead ) {
+        get_thread_pool().wait_helping( ahead->result );
+    }
+
     write_lock<std::shared_mutex> _l( mutex );
 
     overmaps.clear();
+    npc_index_.clear();
     known_non_existing.clear();
     placed_unique_specials.clear();
     pocket_info_.reset();
     fluid_grid::clear();
 }
 
+auto overmapbuffer::memory_usage() -> std::pair<std::size_t, std::size_t>
+{
+    read_lock<std::shared_mutex> _l( mutex );
+    auto bytes = std::size_t{ 0 };
+    for( const auto &[pos, om] : overmaps ) {
+        bytes += om->memory_usage();
+    }
+    return { overmaps.size(), bytes };
+}
+
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
 {
     overmap *om = get_om_global( p ).om;
@@ -514,7 +634,7 @@ bool overmapbuffer::is_explored( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_explored( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->explored( om_loc.local ) = !om_loc.om->explored( om_loc.local );
+    om_loc.om->set_explored( om_loc.local, !om_loc.om->is_explored( om_loc.local ) );
 }
 
 bool overmapbuffer::is_path( const tripoint_abs_omt &p )
@@ -528,7 +648,8 @@ bool overmapbuffer::is_path( const tripoint_abs_omt &p )
 void overmapbuffer::toggle_path( const tripoint_abs_omt &p )
 {
     const overmap_with_local_coords om_loc = get_om_global( p );
-    om_loc.om->path( om_loc.local ) = !om_loc.om->path( om_loc.local );
+    om_loc.om->set_path( om_loc.local, !om_loc.om->is_path( om_loc.local ) );
+    om_loc.om->road_graph.reset();
 }
 
 bool overmapbuffer::has_horde( const tripoint_abs_omt &p )
@@ -686,20 +807,18 @@ mongroup *overmapbuffer::create_horde( const mongroup &group )
     copy.abs_pos = group.abs_pos;
 
     if( copy.radius == 1 ) {
-        auto inserted = om.zg.emplace( proj.remainder_tripoint, copy );
-        return &inserted->second;
+        return &om.zg.insert( proj.remainder_tripoint, copy );
     }
 
     om.add_mon_group( copy );
 
-    auto groups_range = om.zg.equal_range( proj.remainder_tripoint );
-    auto match = std::ranges::find_if( std::ranges::subrange( groups_range.first, groups_range.second ),
-    [&]( const auto & entry ) {
-        const mongroup &stored = entry.second;
+    const auto &ids = om.zg.ids_at( proj.remainder_tripoint );
+    auto match = std::ranges::find_if( ids, [&]( const mongroup_index::id id ) {
+        const mongroup &stored = om.zg.get( id );
         return !stored.empty() && stored.abs_pos == copy.abs_pos && stored.type == copy.type &&
                stored.horde == copy.horde;
     } );
-    return match == groups_range.second ? nullptr : &match->second;
+    return match == ids.end() ? nullptr : &om.zg.get( *match );
 }
 
 std::vector<mongroup *> overmapbuffer::monsters_at( const tripoint_abs_omt &p )
@@ -725,9 +844,8 @@ std::vector<mongroup *> overmapbuffer::groups_at( const tripoint_abs_sm &p )
         return result;
     }
     overmap &om = get( omp );
-    auto groups_range = om.zg.equal_range( tripoint_om_sm( sm_within_om, p.z() ) );
-    for( auto it = groups_range.first; it != groups_range.second; ++it ) {
-        mongroup &mg = it->second;
+    for( const mongroup_index::id id : om.zg.ids_at( tripoint_om_sm( sm_within_om, p.z() ) ) ) {
+        mongroup &mg = om.zg.get( id );
         if( mg.empty() ) {
             continue;
         }
@@ -838,7 +956,7 @@ void overmapbuffer::set_seen( const tripoint_abs_omt &p, bool seen )
         !( om_loc.om->seen( om_loc.local ) ) ) {
         om_loc.om->spawn_ores( p );
     }
-    om_loc.om->seen( om_loc.local ) = seen;
+    om_loc.om->set_seen( om_loc.local, seen );
 }
 
 const oter_id &overmapbuffer::ter( const tripoint_abs_omt &p )
@@ -1023,23 +1141,9 @@ overmap_path_params overmap_path_params::for_aircraft()
     return ret;
 }
 
-static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params,
-                             overmapbuffer &omb )
+static int terrain_cost( const oter_id &oter, bool on_path, const overmap_path_params &params )
 {
-    if( params.only_known_by_player && !omb.seen( omt_pos ) ) {
-        return -1;
-    }
-    if( params.avoid_danger && omb.is_marked_dangerous( omt_pos ) ) {
-        return -1;
-    }
-    const oter_id &oter = omb.ter_existing( omt_pos );
-    if( is_ot_match( "road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge", oter, ot_match_type::type ) ||
-        is_ot_match( "bridge_road", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-        is_ot_match( "bridgehead_ramp", oter, ot_match_type::type ) ||
-        is_ot_match( "road_nesw_manhole", oter, ot_match_type::type ) ||
-        omb.is_path( omt_pos ) ) {
+    if( overmap_road_graph::is_road( oter ) || on_path ) {
         return params.road_cost;
     } else if( is_ot_match( "field", oter, ot_match_type::type ) ) {
         return params.field_cost;
@@ -1076,11 +1180,241 @@ static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path
     }
 }
 
+static int get_terrain_cost( const tripoint_abs_omt &omt_pos, const overmap_path_params &params,
+                             overmapbuffer &omb )
+{
+    if( params.only_known_by_player && !omb.seen( omt_pos ) ) {
+        return -1;
+    }
+    if( params.avoid_danger && omb.is_marked_dangerous( omt_pos ) ) {
+        return -1;
+    }
+    return terrain_cost( omb.ter_existing( omt_pos ), omb.is_path( omt_pos ), params );
+}
+
 static bool is_ramp( const tripoint_abs_omt &omt_pos, overmapbuffer &omb )
 {
-    const oter_id &oter = omb.ter_existing( omt_pos );
-    return is_ot_match( "bridgehead_ground", oter, ot_match_type::type ) ||
-           is_ot_match( "bridgehead_ramp", oter, ot_match_type::type );
+    return overmap_road_graph::is_ramp( omb.ter_existing( omt_pos ) );
+}
+
+namespace
+{
+
+// Shorter trips are searched tile by tile; the road graph only pays for itself
+// once the plain search would flood a wide area.
+constexpr int road_graph_min_distance = OMAPX / 3;
+// How many tiles the walk to the nearest road may look at on either end.
+constexpr size_t road_access_search_count = 4096;
+
+struct road_access {
+    int cost = 0;
+    // From the road node back to where the walk started
+    std::vector<tripoint_abs_omt> tiles;
+};
+
+struct road_node {
+    int cost = 0;
+    std::optional<tripoint_abs_omt> prev;
+    // How prev reached this node; no graph means a step across an overmap border
+    std::shared_ptr<const overmap_road_graph> graph;
+    overmap_road_graph::link via{ -1, false };
+};
+
+struct scored_node {
+    tripoint_abs_omt pos;
+    int score;
+    bool operator>( const scored_node &other ) const {
+        return score > other.score;
+    }
+};
+
+} // namespace
+
+std::shared_ptr<const overmap_road_graph> overmapbuffer::get_road_graph( const point_abs_om &p )
+{
+    overmap *om = get_existing( p );
+    if( om == nullptr ) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock( road_graph_mutex_ );
+    if( !om->road_graph ) {
+        om->road_graph = std::make_shared<const overmap_road_graph>( *om );
+    }
+    return om->road_graph;
+}
+
+std::vector<tripoint_abs_omt> overmapbuffer::find_road_graph_path( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, const overmap_path_params &params, int radius )
+{
+    const auto om_of = [&]( const tripoint_abs_omt & p ) {
+        return project_to<coords::om>( p.xy() );
+    };
+    const auto local_of = [&]( const tripoint_abs_omt & p ) {
+        return project_remain<coords::om>( p ).remainder_tripoint;
+    };
+    std::unordered_map<point_abs_om, std::shared_ptr<const overmap_road_graph>> graphs;
+    const auto graph_at = [&]( const tripoint_abs_omt & p ) {
+        const point_abs_om om_pos = om_of( p );
+        auto it = graphs.find( om_pos );
+        if( it == graphs.end() ) {
+            it = graphs.emplace( om_pos, get_road_graph( om_pos ) ).first;
+        }
+        return it->second;
+    };
+    const auto is_node = [&]( const tripoint_abs_omt & p ) {
+        const std::shared_ptr<const overmap_road_graph> &graph = graph_at( p );
+        return graph && graph->nodes.contains( local_of( p ) );
+    };
+    const auto tile_cost = [&]( const tripoint_abs_omt & p ) {
+        return p == src ? 0 : get_terrain_cost( p, params, *this );
+    };
+
+    // Cheapest walk from the trip's end to every road node near it
+    const auto find_access = [&]( const tripoint_abs_omt & start ) {
+        std::unordered_map<tripoint_abs_omt, road_access> found;
+        std::unordered_map<tripoint_abs_omt, std::pair<int, tripoint_abs_omt>> known;
+        std::priority_queue<scored_node, std::vector<scored_node>, std::greater<>> open;
+        known.emplace( start, std::make_pair( 0, start ) );
+        open.push( { start, 0 } );
+        while( !open.empty() && known.size() < road_access_search_count ) {
+            const scored_node cur = open.top();
+            open.pop();
+            if( cur.score > known.at( cur.pos ).first ) {
+                continue;
+            }
+            if( is_node( cur.pos ) ) {
+                road_access &access = found[cur.pos];
+                access.cost = cur.score;
+                for( tripoint_abs_omt p = cur.pos; p != start; p = known.at( p ).second ) {
+                    access.tiles.push_back( p );
+                }
+                access.tiles.push_back( start );
+                continue;
+            }
+            const int cost = tile_cost( cur.pos );
+            std::vector<tripoint_abs_omt> next;
+            for( const point &d : four_adjacent_offsets ) {
+                next.push_back( cur.pos + d );
+            }
+            if( is_ramp( cur.pos, *this ) ) {
+                next.push_back( cur.pos + tripoint_above );
+                next.push_back( cur.pos + tripoint_below );
+            }
+            for( const tripoint_abs_omt &p : next ) {
+                if( tile_cost( p ) < 0 ) {
+                    continue;
+                }
+                const int score = cur.score + cost;
+                const auto it = known.find( p );
+                if( it == known.end() || it->second.first > score ) {
+                    known[p] = std::make_pair( score, cur.pos );
+                    open.push( { p, score } );
+                }
+            }
+        }
+        return found;
+    };
+
+    const std::unordered_map<tripoint_abs_omt, road_access> src_access = find_access( src );
+    const std::unordered_map<tripoint_abs_omt, road_access> dest_access = find_access( dest );
+    if( src_access.empty() || dest_access.empty() ) {
+        return {};
+    }
+
+    const int road_cost = params.road_cost;
+    const auto estimate = [&]( const tripoint_abs_omt & p ) {
+        // Staircase roads turn on every tile, which is the cheapest road can get
+        return octile_dist( p.xy(), dest.xy(), road_cost * 99 / 140 );
+    };
+    std::unordered_map<tripoint_abs_omt, road_node> reached;
+    std::priority_queue<scored_node, std::vector<scored_node>, std::greater<>> open;
+    for( const auto &[node, access] : src_access ) {
+        reached[node].cost = access.cost;
+        open.push( { node, access.cost + estimate( node ) } );
+    }
+    const auto relax = [&]( const tripoint_abs_omt & from, const tripoint_abs_omt & to, int cost,
+    const std::shared_ptr<const overmap_road_graph> &graph, overmap_road_graph::link via ) {
+        if( octile_dist( src.xy(), to.xy() ) > radius ) {
+            return;
+        }
+        const auto it = reached.find( to );
+        if( it != reached.end() && it->second.cost <= cost ) {
+            return;
+        }
+        reached[to] = road_node{ cost, from, graph, via };
+        open.push( { to, cost + estimate( to ) } );
+    };
+
+    std::optional<tripoint_abs_omt> best;
+    int best_cost = INT_MAX;
+    while( !open.empty() ) {
+        const scored_node cur = open.top();
+        open.pop();
+        if( cur.score >= best_cost ) {
+            break;
+        }
+        const int cur_cost = reached.at( cur.pos ).cost;
+        if( cur.score > cur_cost + estimate( cur.pos ) ) {
+            continue;
+        }
+        if( const auto access = dest_access.find( cur.pos ); access != dest_access.end() &&
+            cur_cost + access->second.cost < best_cost ) {
+            best = cur.pos;
+            best_cost = cur_cost + access->second.cost;
+        }
+
+        const std::shared_ptr<const overmap_road_graph> graph = graph_at( cur.pos );
+        const point_abs_om om_pos = om_of( cur.pos );
+        for( const overmap_road_graph::link &link : graph->nodes.at( local_of( cur.pos ) ) ) {
+            // Seen and danger state can change without touching terrain, so check tiles here
+            const overmap_road_graph::chain &chain = graph->chains[link.chain];
+            const tripoint_abs_omt to = project_combine( om_pos, link.reversed ? chain.from : chain.to );
+            const bool open_chain = std::ranges::all_of( chain.tiles, [&]( const tripoint_om_omt & p ) {
+                return tile_cost( project_combine( om_pos, p ) ) >= 0;
+            } ) && tile_cost( to ) >= 0;
+            if( open_chain ) {
+                const int straight = chain.tiles.size() + 1 - chain.turns;
+                relax( cur.pos, to, cur_cost + straight * road_cost + chain.turns * road_cost * 99 / 140,
+                       graph, link );
+            }
+        }
+        for( const point &d : four_adjacent_offsets ) {
+            const tripoint_abs_omt to = cur.pos + d;
+            if( graph_at( to ) != graph && is_node( to ) && tile_cost( to ) >= 0 ) {
+                relax( cur.pos, to, cur_cost + road_cost, nullptr, { -1, false } );
+            }
+        }
+    }
+    if( !best ) {
+        return {};
+    }
+
+    // Like pf::find_overmap_path, the path runs from dest back to src
+    std::vector<tripoint_abs_omt> ret = dest_access.at( *best ).tiles;
+    std::ranges::reverse( ret );
+    for( tripoint_abs_omt p = *best; reached.at( p ).prev; ) {
+        const road_node &node = reached.at( p );
+        if( node.graph ) {
+            const overmap_road_graph::chain &chain = node.graph->chains[node.via.chain];
+            const auto append = [&]( auto &&tiles ) {
+                for( const tripoint_om_omt &t : tiles ) {
+                    ret.push_back( project_combine( om_of( p ), t ) );
+                }
+            };
+            // Walking back towards prev is the chain in the opposite direction
+            if( node.via.reversed ) {
+                append( chain.tiles );
+            } else {
+                append( chain.tiles | std::views::reverse );
+            }
+        }
+        p = *node.prev;
+        ret.push_back( p );
+    }
+    // ret ends on the first road node, which starts the access walk from src
+    const std::vector<tripoint_abs_omt> &src_tiles = src_access.at( ret.back() ).tiles;
+    ret.insert( ret.end(), src_tiles.begin() + 1, src_tiles.end() );
+    return ret;
 }
 
 std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
@@ -1099,10 +1433,231 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     };
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
+    if( params.road_cost >= 0 && octile_dist( src.xy(), dest.xy() ) >= road_graph_min_distance ) {
+        std::vector<tripoint_abs_omt> road_path = find_road_graph_path( src, dest, params, radius );
+        if( !road_path.empty() ) {
+            return road_path;
+        }
+    }
     const pf::simple_path<tripoint_abs_omt> path = pf::find_overmap_path( src, dest, radius, estimate );
     return path.points;
 }
 
+/** What @ref get_terrain_cost reads, copied out of the overmaps a travel plan may cross. */
+struct overmap_travel_plan::snapshot {
+    struct layer {
+        oter_id terrain[OMAPX][OMAPY];
+        bool seen[OMAPX][OMAPY] = {};
+        bool path[OMAPX][OMAPY] = {};
+        bool dangerous[OMAPX][OMAPY] = {};
+    };
+
+    /** Keyed by overmap x, y and the z-level. */
+    std::unordered_map<tripoint, std::unique_ptr<layer>> layers;
+    overmap_path_params params;
+
+    static constexpr tripoint key( const point_abs_om &om, int z ) {
+        return tripoint( om.x(), om.y(), z );
+    }
+
+    void copy( const overmap *om, const point_abs_om &om_pos, int z ) {
+        auto l = std::make_unique<layer>();
+        if( om != nullptr ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                for( int y = 0; y < OMAPY; ++y ) {
+                    const tripoint_om_omt p( x, y, z );
+                    l->terrain[x][y] = om->ter( p );
+                    l->seen[x][y] = om->seen( p );
+                    l->path[x][y] = om->is_path( p );
+                }
+            }
+            // Same marking as overmap::is_marked_dangerous, done once instead of per tile
+            for( const om_note &note : om->all_notes( z ) ) {
+                if( !note.dangerous ) {
+                    continue;
+                }
+                const int r = note.danger_radius;
+                for( int x = std::max( 0, note.p.x() - r ); x <= std::min( OMAPX - 1, note.p.x() + r ); ++x ) {
+                    for( int y = std::max( 0, note.p.y() - r ); y <= std::min( OMAPY - 1, note.p.y() + r ); ++y ) {
+                        l->dangerous[x][y] = true;
+                    }
+                }
+            }
+        }
+        layers.emplace( key( om_pos, z ), std::move( l ) );
+    }
+
+    /** Null when @p p lies outside the copied area. */
+    const layer *find( const tripoint_abs_omt &p, point_om_omt &local ) const {
+        const auto [om_pos, om_local] = project_remain<coords::om>( p.xy() );
+        const auto it = layers.find( key( om_pos, p.z() ) );
+        if( it == layers.end() ) {
+            return nullptr;
+        }
+        local = om_local;
+        return it->second.get();
+    }
+
+    pf::omt_score score( const tripoint_abs_omt &p, bool is_src ) const {
+        point_om_omt local;
+        const layer *l = find( p, local );
+        if( l == nullptr ) {
+            return pf::omt_score::rejected;
+        }
+        const int x = local.x();
+        const int y = local.y();
+        const oter_id &oter = l->terrain[x][y];
+        if( is_src ) {
+            return pf::omt_score( 0, overmap_road_graph::is_ramp( oter ) );
+        }
+        if( ( params.only_known_by_player && !l->seen[x][y] ) ||
+            ( params.avoid_danger && l->dangerous[x][y] ) ) {
+            return pf::omt_score::rejected;
+        }
+        const int cost = terrain_cost( oter, l->path[x][y], params );
+        if( cost < 0 ) {
+            return pf::omt_score::rejected;
+        }
+        return pf::omt_score( cost, overmap_road_graph::is_ramp( oter ) );
+    }
+};
+
+overmap_travel_plan::overmap_travel_plan( const tripoint_abs_omt &src, const tripoint_abs_omt &dest )
+    : src( src ), dest( dest )
+{
+}
+
+overmap_travel_plan::~overmap_travel_plan()
+{
+    if( result.valid() ) {
+        cancel();
+        get_thread_pool().wait_helping( result );
+    }
+}
+
+bool overmap_travel_plan::ready() const
+{
+    return !result.valid() || result.wait_for( std::chrono::seconds( 0 ) ) == std::future_status::ready;
+}
+
+std::vector<tripoint_abs_omt> overmap_travel_plan::take_path()
+{
+    if( !result.valid() ) {
+        return {};
+    }
+    get_thread_pool().wait_helping( result );
+    return result.get();
+}
+
+std::unique_ptr<overmap_travel_plan> overmapbuffer::plan_travel_path( const tripoint_abs_omt &src,
+        const tripoint_abs_omt &dest, const overmap_path_params &params )
+{
+    auto plan = std::make_unique<overmap_travel_plan>( src, dest );
+    if( src == overmap::invalid_tripoint || dest == overmap::invalid_tripoint ) {
+        return plan;
+    }
+    if( pocket_info_ ) {
+        // Pocket dimensions are small, and their bounds are not worth copying
+        std::promise<std::vector<tripoint_abs_omt>> done;
+        done.set_value( get_travel_path( src, dest, params ) );
+        plan->result = done.get_future();
+        return plan;
+    }
+
+    // The search may climb ramps onto the road levels, but otherwise stays on the z-levels
+    // of its ends. Sideways it gets half an overmap of room around the straight line.
+    constexpr int radius = 4 * OMAPX;
+    constexpr int margin = OMAPX / 2;
+    const point_abs_omt lo( std::min( src.x(), dest.x() ) - margin,
+                            std::min( src.y(), dest.y() ) - margin );
+    const point_abs_omt hi( std::max( src.x(), dest.x() ) + margin,
+                            std::max( src.y(), dest.y() ) + margin );
+    const point_abs_om om_lo = project_to<coords::om>( lo );
+    const point_abs_om om_hi = project_to<coords::om>( hi );
+    const point_abs_om om_src = project_to<coords::om>( src.xy() );
+    const int om_radius = divide_round_up( radius, OMAPX );
+    std::set<int> levels{ src.z(), dest.z(), 0, 1 };
+
+    plan->snap = std::make_unique<overmap_travel_plan::snapshot>();
+    plan->snap->params = params;
+    for( int x = om_lo.x(); x <= om_hi.x(); ++x ) {
+        for( int y = om_lo.y(); y <= om_hi.y(); ++y ) {
+            const point_abs_om om_pos( x, y );
+            if( square_dist( om_pos, om_src ) > om_radius ) {
+                continue;
+            }
+            const overmap *om = get_existing( om_pos );
+            for( const int z : levels ) {
+                plan->snap->copy( om, om_pos, z );
+            }
+        }
+    }
+
+    overmap_travel_plan *const p = plan.get();
+    plan->result = get_thread_pool().submit_returning( task_priority::interactive,
+    "overmap_travel_plan", [p]() {
+        const overmap_travel_plan::snapshot &snap = *p->snap;
+        const pf::omt_scoring_fn estimate = [&]( tripoint_abs_omt pos ) {
+            if( p->cancelled_.load( std::memory_order_relaxed ) ) {
+                return pf::omt_score::rejected;
+            }
+            p->searched_.fetch_add( 1, std::memory_order_relaxed );
+            return snap.score( pos, pos == p->src );
+        };
+        std::vector<tripoint_abs_omt> path = pf::find_overmap_path( p->src, p->dest, radius,
+                                             estimate ).points;
+        if( p->cancelled_.load( std::memory_order_relaxed ) ) {
+            path.clear();
+        }
+        return path;
+    } );
+    return plan;
+}
+
+std::vector<std::vector<tripoint_abs_omt>> overmapbuffer::get_travel_paths(
+            const std::vector<std::pair<tripoint_abs_omt, tripoint_abs_omt>> &trips,
+            const overmap_path_params &params )
+{
+    ZoneScoped;
+    using trip = std::pair<tripoint_abs_omt, tripoint_abs_omt>;
+    std::map<trip, std::vector<tripoint_abs_omt>> found;
+    std::map<trip, std::unique_ptr<overmap_travel_plan>> plans;
+    std::vector<trip> blocking;
+    for( const trip &t : trips ) {
+        if( found.contains( t ) || plans.contains( t ) ) {
+            continue;
+        }
+        const bool long_trip = params.road_cost >= 0 &&
+                               octile_dist( t.first.xy(), t.second.xy() ) >= road_graph_min_distance;
+        if( long_trip ) {
+            found.emplace( t, std::vector<tripoint_abs_omt>() );
+            blocking.push_back( t );
+        } else {
+            plans.emplace( t, plan_travel_path( t.first, t.second, params ) );
+        }
+    }
+    TracyPlot( "Overmap Travel Path Searches", static_cast<int64_t>( found.size() + plans.size() ) );
+
+    // The road graph is cheap enough to walk here while the workers search.
+    for( const trip &t : blocking ) {
+        found[t] = get_travel_path( t.first, t.second, params );
+    }
+    for( auto &[t, plan] : plans ) {
+        std::vector<tripoint_abs_omt> path = plan->take_path();
+        if( path.empty() ) {
+            path = get_travel_path( t.first, t.second, params );
+        }
+        found.emplace( t, std::move( path ) );
+    }
+
+    std::vector<std::vector<tripoint_abs_omt>> ret;
+    ret.reserve( trips.size() );
+    for( const trip &t : trips ) {
+        ret.push_back( found.at( t ) );
+    }
+    return ret;
+}
+
 bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                                   const omt_route_params &params )
 {
@@ -1228,8 +1783,43 @@ bool overmapbuffer::is_findable_location( const tripoint_abs_omt &location,
     return is_findable_location( om_loc, params );
 }
 
+/**
+ * Which overmap terrains pass the type filters of one search, worked out the first time
+ * each terrain is met rather than on every tile.
+ */
+class omt_type_filter
+{
+    public:
+        explicit omt_type_filter( const omt_find_params &params )
+            : params( params )
+            , known( overmap_terrains::get_all().size(), unknown ) {
+        }
+
+        static bool matches( const omt_find_params &params, const oter_id &oter ) {
+            const auto is_match = [&]( const std::pair<std::string, ot_match_type> &elem ) {
+                return is_ot_match( elem.first, oter, elem.second );
+            };
+            return !std::ranges::any_of( params.exclude_types, is_match ) &&
+                   std::ranges::any_of( params.types, is_match );
+        }
+
+        bool passes( const oter_id &oter ) {
+            char &match = known[oter.to_i()];
+            if( match == unknown ) {
+                match = matches( params, oter ) ? included : excluded;
+            }
+            return match == included;
+        }
+
+    private:
+        enum : char { unknown, excluded, included };
+
+        const omt_find_params &params;
+        std::vector<char> known;
+};
+
 bool overmapbuffer::is_findable_location( const overmap_with_local_coords &om_loc,
-        const omt_find_params &params )
+        const omt_find_params &params, omt_type_filter *const types )
 {
     if( om_loc.om == nullptr ) {
         return false;
@@ -1240,30 +1830,16 @@ bool overmapbuffer::is_findable_location( const overmap_with_local_coords &om_lo
         return false;
     }
 
-    const auto is_explored = om_loc.om->explored( om_loc.local );
+    const auto is_explored = om_loc.om->is_explored( om_loc.local );
     if( params.explored.has_value() && params.explored.value() != is_explored ) {
         return false;
     }
 
-    bool is_excluded = false;
-    for( const std::pair<std::string, ot_match_type> &elem : params.exclude_types ) {
-        is_excluded = om_loc.om->check_ot( elem.first, elem.second, om_loc.local );
-        if( is_excluded ) {
-            break;
-        }
-    }
-    if( is_excluded ) {
+    if( !overmap::inbounds( om_loc.local ) ) {
         return false;
     }
-
-    bool is_included = false;
-    for( const std::pair<std::string, ot_match_type> &elem : params.types ) {
-        is_included = om_loc.om->check_ot( elem.first, elem.second, om_loc.local );
-        if( is_included ) {
-            break;
-        }
-    }
-    if( !is_included ) {
+    const oter_id &oter = om_loc.om->ter( om_loc.local );
+    if( !( types ? types->passes( oter ) : omt_type_filter::matches( params, oter ) ) ) {
         return false;
     }
 
@@ -1372,6 +1948,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_sync( const tripoint_abs_o
 
     std::vector<tripoint_abs_omt> find_result;
     find_result.reserve( params.max_results.value_or( 256 ) );
+    omt_type_filter types( params );
     while( true ) {
 
         if( params.popup ) {
@@ -1393,7 +1970,7 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_sync( const tripoint_abs_o
         bool done = false;
         for( const auto &loc : task_omts ) {
             overmap_with_local_coords q{ om_loc, loc.second };
-            if( is_findable_location( q, params ) ) {
+            if( is_findable_location( q, params, &types ) ) {
                 find_result.push_back( loc.first );
             }
             if( params.max_results.has_value() &&
@@ -1497,9 +2074,10 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
                 return result;
             }
 
+            omt_type_filter types( params );
             for( const auto &loc : locals ) {
                 overmap_with_local_coords q{ om_loc, loc.second };
-                if( is_findable_location( q, params ) ) {
+                if( is_findable_location( q, params, &types ) ) {
                     result.push_back( loc.first );
                 }
                 if( params.max_results.has_value() &&
@@ -1511,7 +2089,8 @@ std::vector<tripoint_abs_omt> overmapbuffer::find_all_async( const tripoint_abs_
             return result;
         };
 
-        auto task = get_thread_pool().submit_returning( task_func, task_om, std::move( task_omts ) );
+        auto task = get_thread_pool().submit_returning( task_priority::interactive, "overmap_find_all",
+                    task_func, task_om, std::move( task_omts ) );
 
         tasks.push_back( std::move( task ) );
 
@@ -1601,12 +2180,7 @@ tripoint_abs_omt overmapbuffer::find_random( const tripoint_abs_omt &origin,
 
 shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 {
-    for( auto &it : overmaps ) {
-        if( auto p = it.second->find_npc( id ) ) {
-            return p;
-        }
-    }
-    return nullptr;
+    return npc_index_.find( id );
 }
 
 void overmapbuffer::insert_npc( const shared_ptr_fast<npc> &who )
@@ -1622,12 +2196,26 @@ void overmapbuffer::insert_npc( const shared_ptr_fast<npc> &who )
     om.insert_npc( who );
 }
 
+void overmapbuffer::npc_moved( const npc &who )
+{
+    npc_index_.moved( who );
+}
+
 shared_ptr_fast<npc> overmapbuffer::remove_npc( const character_id &id )
 {
     // Hold a read lock on mutex for safe iteration over overmaps, then
     // npc_mutex_ for the NPC container write.  Order: mutex → npc_mutex_.
     read_lock<std::shared_mutex> rl( mutex );
     std::lock_guard<std::mutex> lk( npc_mutex_ );
+    // The NPC is normally held by the overmap it stands in; scan the rest only if not
+    if( const auto who = npc_index_.find( id ) ) {
+        const auto it = overmaps.find( project_to<coords::om>( who->abs_omt_pos().xy() ) );
+        if( it != overmaps.end() ) {
+            if( const auto p = it->second->erase_npc( id ) ) {
+                return p;
+            }
+        }
+    }
     for( auto &it : overmaps ) {
         if( const auto p = it.second->erase_npc( id ) ) {
             return p;
@@ -1701,44 +2289,20 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_companion_mission_npcs( int
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near( const tripoint_abs_sm &p,
                                int radius )
 {
-    // get_overmaps_near() acquires+releases mutex internally; collect the list
-    // first so we hold npc_mutex_ only while reading NPC containers (not mutex).
-    auto nearby = get_overmaps_near( p.xy(), radius );
-    std::lock_guard<std::mutex> lk( npc_mutex_ );
-    std::vector<shared_ptr_fast<npc>> result;
-    for( auto &it : nearby ) {
-        auto temp = it->get_npcs( [&]( const npc & guy ) {
-            // Global position of NPC, in submap coordinates
-            // TODO: fix point types
-            const tripoint_abs_sm pos( guy.abs_sm_pos() );
-            if( p.z() != INT_MIN && pos.z() != p.z() ) {
-                return false;
-            }
-            return square_dist( p.xy(), pos.xy() ) <= radius;
-        } );
-        result.insert( result.end(), temp.begin(), temp.end() );
-    }
-    return result;
+    return npc_index_.near( p, radius );
 }
 
 // If z == INT_MIN, allow all z-levels
 std::vector<shared_ptr_fast<npc>> overmapbuffer::get_npcs_near_omt( const tripoint_abs_omt &p,
                                int radius )
 {
-    auto nearby = get_overmaps_near( project_to<coords::sm>( p.xy() ), radius );
-    std::lock_guard<std::mutex> lk( npc_mutex_ );
-    std::vector<shared_ptr_fast<npc>> result;
-    for( auto &it : nearby ) {
-        auto temp = it->get_npcs( [&]( const npc & guy ) {
-            // Global position of NPC, in submap coordinates
-            tripoint_abs_omt pos = guy.abs_omt_pos();
-            if( p.z() != INT_MIN && pos.z() != p.z() ) {
-                return false;
-            }
-            return square_dist( p.xy(), pos.xy() ) <= radius;
-        } );
-        result.insert( result.end(), temp.begin(), temp.end() );
-    }
+    // Every submap of an OMT within radius lies within 2 * radius + 1 submaps of the
+    // centre OMT's first submap
+    auto result = npc_index_.near( tripoint_abs_sm( project_to<coords::sm>( p.xy() ), p.z() ),
+                                   radius * 2 + 1 );
+    std::erase_if( result, [&]( const shared_ptr_fast<npc> &guy ) {
+        return square_dist( p.xy(), guy->abs_omt_pos().xy() ) > radius;
+    } );
     return result;
 }
 
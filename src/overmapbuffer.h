@@ -1,7 +1,9 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <set>
@@ -17,7 +19,9 @@
 #include "dimension_info.h"
 #include "enums.h"
 #include "json.h"
+#include "lock_stats.h"
 #include "memory_fast.h"
+#include "npc_registry.h"
 #include "overmap_types.h"
 #include "string_id.h"
 #include "type_id.h"
@@ -28,6 +32,7 @@ class map_extra;
 class mapgendata;
 class monster;
 class npc;
+class omt_type_filter;
 class overmap;
 class overmap_special;
 class overmap_special_batch;
@@ -36,6 +41,7 @@ class vehicle;
 struct mapgen_arguments;
 struct mongroup;
 struct om_vehicle;
+struct overmap_road_graph;
 struct radio_tower;
 struct regional_settings;
 
@@ -160,6 +166,51 @@ struct omt_route_params {
     shared_ptr_fast<throbber_popup> popup = nullptr;
 };
 
+/**
+ * Travel path searched on a pool worker, so the overmap UI stays responsive while a long
+ * trip is planned.
+ *
+ * The overmap data the search may touch is copied when the plan is made, and the worker
+ * only ever reads that copy. Destroying the plan cancels the search and waits for it.
+ * Made by @ref overmapbuffer::plan_travel_path.
+ */
+class overmap_travel_plan
+{
+    public:
+        struct snapshot;
+
+        overmap_travel_plan( const tripoint_abs_omt &src, const tripoint_abs_omt &dest );
+        overmap_travel_plan( const overmap_travel_plan & ) = delete;
+        overmap_travel_plan &operator=( const overmap_travel_plan & ) = delete;
+        ~overmap_travel_plan();
+
+        const tripoint_abs_omt &destination() const {
+            return dest;
+        }
+        /** Whether the search has finished, so that @ref take_path does not block. */
+        bool ready() const;
+        /** Overmap tiles scored so far, for progress display. */
+        int searched() const {
+            return searched_.load( std::memory_order_relaxed );
+        }
+        /** Stops the search early; its path will be empty. */
+        void cancel() {
+            cancelled_.store( true, std::memory_order_relaxed );
+        }
+        /** The path in the same order as @ref overmapbuffer::get_travel_path, empty if none was found. */
+        std::vector<tripoint_abs_omt> take_path();
+
+    private:
+        friend class overmapbuffer;
+
+        tripoint_abs_omt src;
+        tripoint_abs_omt dest;
+        std::unique_ptr<snapshot> snap;
+        std::future<std::vector<tripoint_abs_omt>> result;
+        std::atomic<int> searched_ = 0;
+        std::atomic<bool> cancelled_ = false;
+};
+
 class overmapbuffer
 {
     public:
@@ -191,6 +242,8 @@ class overmapbuffer
         auto save( const dimension_id &dim_id ) -> void;
 
         void clear();
+        /** Loaded overmaps and roughly how many bytes they hold together. */
+        auto memory_usage() -> std::pair<std::size_t, std::size_t>;
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
 
         /**
@@ -207,6 +260,13 @@ class overmapbuffer
         * Generates overmap tiles, if missing
         */
         void generate( const std::vector<point_abs_om> &locs );
+        /**
+         * Starts generating the missing overmap nearest to @p center on the thread pool, if
+         * @p center is close enough to its edge, so it's ready before anything needs it.
+         * Takes in the previous one first if it has finished.  Only one is generated at a
+         * time, so each can still connect its roads and rivers to the ones before it.
+         */
+        void generate_ahead( const tripoint_abs_omt &center );
 
         /**
          * Returns the overmap terrain at the given OMT coordinates.
@@ -354,6 +414,15 @@ class overmapbuffer
          * and stores it there. The overmap takes ownership of the pointer.
          */
         void insert_npc( const shared_ptr_fast<npc> &who );
+        /**
+         * Tells the NPC index that @p who may have crossed into another submap.
+         * Called by npc on every reposition; does nothing if it hasn't.
+         */
+        void npc_moved( const npc &who );
+        /** Index of every NPC held by this buffer's overmaps, kept up to date by overmap. */
+        npc_registry &npc_index() {
+            return npc_index_;
+        }
 
         /**
          * Find all places with the specific overmap terrain type.
@@ -405,6 +474,22 @@ class overmapbuffer
                      const std::function<bool( const oter_id & )> &filter );
         std::vector<tripoint_abs_omt> get_travel_path(
             const tripoint_abs_omt &src, const tripoint_abs_omt &dest, overmap_path_params params );
+        /**
+         * Like @ref get_travel_path, but the search runs on a pool worker. Only the overmaps
+         * around the straight line from @p src to @p dest are copied for it, so a trip that
+         * needs a wider detour than that comes back empty. Main thread only.
+         */
+        std::unique_ptr<overmap_travel_plan> plan_travel_path( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, const overmap_path_params &params );
+        /**
+         * @ref get_travel_path for a batch of trips, returned in the order of @p trips.
+         * Trips with the same ends share one search, and the trips too short for the road graph
+         * are searched on pool workers through @ref plan_travel_path, falling back to a blocking
+         * search when that comes back empty. Main thread only.
+         */
+        std::vector<std::vector<tripoint_abs_omt>> get_travel_paths(
+                    const std::vector<std::pair<tripoint_abs_omt, tripoint_abs_omt>> &trips,
+                    const overmap_path_params &params );
         bool reveal_route( const tripoint_abs_omt &source, const tripoint_abs_omt &dest,
                            const omt_route_params &params );
 
@@ -576,18 +661,34 @@ class overmapbuffer
                             int min_radius, int max_radius );
 
     private:
+        struct overmap_generating_ahead {
+            point_abs_om loc;
+            std::future<std::unique_ptr<overmap>> result;
+        };
+
         dimension_id dimension_id_;
         std::shared_mutex mutex;
+        /** Protects @ref generating_ahead_. */
+        std::mutex generating_ahead_mutex_;
+        std::optional<overmap_generating_ahead> generating_ahead_;
+        /**
+         * Takes in the overmap from @ref generate_ahead, waiting for it if @p wait is set.
+         * Does nothing if there is none, or if it hasn't finished and @p wait is not set.
+         */
+        void finish_generating_ahead( bool wait );
+        /** Adds a newly generated overmap and fixes up what it shares with its neighbours. */
+        overmap &insert_generated( const point_abs_om &loc, std::unique_ptr<overmap> om );
         /**
          * Protects all NPC container reads and writes across every overmap in
          * this buffer.  Must always be acquired AFTER @ref mutex (if both are
-         * needed).  Held exclusively for insert_npc() / remove_npc() and
-         * shared-equivalently for get_npcs_near() family reads.
+         * needed).  Held for insert_npc() / remove_npc(); find_npc() and the
+         * get_npcs_near() family read @ref npc_index_, which locks itself.
          *
          * Separate from @ref mutex so that generation workers can call
          * insert_npc() concurrently without blocking overmapbuffer reads.
          */
         mutable std::mutex npc_mutex_;
+        npc_registry npc_index_;
         /**
          * Protects overmap layer[z].extras and layer[z].notes writes across every
          * overmap in this buffer.  Must be acquired AFTER any @ref mutex operation
@@ -598,7 +699,8 @@ class overmapbuffer
          * Separate from @ref mutex so that generation workers can call add_extra()
          * and add_note() concurrently without blocking unrelated overmapbuffer reads.
          */
-        mutable std::mutex extras_mutex_;
+        using extras_mutex_type = lock_stats::counted<std::mutex, "overmapbuffer::extras_mutex_">;
+        mutable TracyLockable( extras_mutex_type, extras_mutex_ );
         /**
          * Protects lazy initialization of overmap_special mapgen arguments stored in
          * overmap::mapgen_arg_storage.  Must be acquired AFTER any @ref mutex operation
@@ -609,15 +711,27 @@ class overmapbuffer
          * concurrently without blocking unrelated overmapbuffer reads.
          */
         mutable std::mutex mapgen_args_mutex_;
+        /** Protects lazy construction of overmap::road_graph. */
+        std::mutex road_graph_mutex_;
+        /** The road graph of overmap @p p, building it if needed; null if the overmap does not exist. */
+        std::shared_ptr<const overmap_road_graph> get_road_graph( const point_abs_om &p );
+        /**
+         * Long-trip fast path for get_travel_path: walks to the nearest road on either end and
+         * searches the contracted road graphs in between. Returns an empty path when it cannot
+         * answer, in which case the caller searches tile by tile.
+         */
+        std::vector<tripoint_abs_omt> find_road_graph_path( const tripoint_abs_omt &src,
+                const tripoint_abs_omt &dest, const overmap_path_params &params, int radius );
         /**
          * Common function used by the find_closest/all/random to determine if the location is
          * findable based on the specified criteria.
          * @param location Location of search
+         * @param types Remembers which terrain passed the type filters, for searches over many tiles
          * see omt_find_params for definitions of the terms
          */
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
         bool is_findable_location( const overmap_with_local_coords &map_loc,
-                                   const omt_find_params &params );
+                                   const omt_find_params &params, omt_type_filter *types = nullptr );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
         /**
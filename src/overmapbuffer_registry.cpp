@@ -128,13 +128,14 @@ auto save_all_overmapbuffers() -> void
     futures.reserve( 8 );  // most games have at most a handful of dimensions
 
     for_each_overmapbuffer( [&futures]( const dimension_id & dim_id, overmapbuffer & buf ) {
-        futures.push_back( get_thread_pool().submit_returning(
+        futures.push_back( get_thread_pool().submit_returning( "overmap_save",
         [dim_id, &buf]() {
             buf.save( dim_id );
         } ) );
     } );
 
     std::ranges::for_each( futures, []( auto & f ) {
+        get_thread_pool().wait_helping( f );
         f.get();
     } );
 }
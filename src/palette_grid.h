@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * Fixed number of cells holding values of @p T, stored as bit-packed indices into
+ * a palette of the distinct values present.
+ *
+ * The index width starts at 0 bits, so a grid holding a single value (one kind
+ * of terrain, no traps, no radiation) keeps no per-cell storage at all, and grows
+ * through 1, 2, 4 and 8 bits as more distinct values are set.  Before widening,
+ * palette entries no cell refers to any more are dropped.  `fill` goes back to
+ * a single value and frees the indices.
+ *
+ * Reads are one shift and mask into a word plus a palette read.
+ */
+template<typename T, std::size_t N>
+class palette_grid
+{
+        static_assert( N <= 256, "8 bit indices must be able to hold one distinct value per cell" );
+
+    public:
+        explicit palette_grid( const T &value = T() ) : palette_{ value } {}
+
+        palette_grid( palette_grid && ) noexcept = default;
+        auto operator=( palette_grid && ) noexcept -> palette_grid & = default;
+
+        auto get( const std::size_t i ) const -> const T & {
+            return palette_[index_at( i )];
+        }
+
+        auto set( const std::size_t i, const T &value ) -> void {
+            const auto index = find_or_add( value, i );
+            if( bits_ != 0 ) {
+                set_index_at( i, index );
+            }
+        }
+
+        auto fill( const T &value ) -> void {
+            palette_.assign( 1, value );
+            words_.reset();
+            bits_ = 0;
+        }
+
+        /**
+         * Writes `f( value )` for every cell to @p out, in cell order.  @p f runs once per
+         * palette entry rather than once per cell; the per-cell work is then a table read
+         * in a loop over whole index words, which the compiler can vectorize.
+         */
+        template<typename R, typename F>
+        auto map_cells( F &&f, R *out ) const -> void {
+            if( bits_ == 0 ) {
+                std::fill_n( out, N, f( palette_[0] ) );
+                return;
+            }
+            auto lut = std::array<R, 256> {};
+            for( auto p = std::size_t{ 0 }; p < palette_.size(); ++p ) {
+                lut[p] = f( palette_[p] );
+            }
+            // 1, 2, 4 and 8 all divide 64, so no index straddles two words.
+            const auto per_word = word_bits / bits_;
+            const auto mask = ( uint64_t{ 1 } << bits_ ) - 1;
+            for( auto i = std::size_t{ 0 }; i < N; i += per_word ) {
+                const auto word = words_[i / per_word];
+                const auto count = std::min( per_word, N - i );
+                for( auto k = std::size_t{ 0 }; k < count; ++k ) {
+                    out[i + k] = lut[( word >> ( k * bits_ ) ) & mask];
+                }
+            }
+        }
+
+        /** Swaps the values of two cells.  Never changes the palette. */
+        auto swap_cells( const std::size_t a, const std::size_t b ) -> void {
+            if( bits_ == 0 ) {
+                return;
+            }
+            const auto ia = index_at( a );
+            set_index_at( a, index_at( b ) );
+            set_index_at( b, ia );
+        }
+
+        /** Whether every cell holds the same value. */
+        auto is_uniform() const -> bool {
+            return bits_ == 0;
+        }
+
+        /** Distinct values that may be present, for memory accounting. */
+        auto palette_size() const -> std::size_t {
+            return palette_.size();
+        }
+
+        /** Bits per cell, 0 while uniform. */
+        auto index_bits() const -> int {
+            return bits_;
+        }
+
+        /** Heap bytes held by the palette and the indices. */
+        auto heap_bytes() const -> std::size_t {
+            return palette_.capacity() * sizeof( T ) +
+                   ( bits_ == 0 ? 0 : word_count( bits_ ) * sizeof( uint64_t ) );
+        }
+
+    private:
+        static constexpr auto word_bits = std::size_t{ 64 };
+
+        static constexpr auto word_count( const int bits ) -> std::size_t {
+            return ( N * bits + word_bits - 1 ) / word_bits;
+        }
+
+        auto index_at( const std::size_t i ) const -> std::size_t {
+            if( bits_ == 0 ) {
+                return 0;
+            }
+            const auto bit = i * bits_;
+            const auto mask = ( uint64_t{ 1 } << bits_ ) - 1;
+            return static_cast<std::size_t>( ( words_[bit / word_bits] >> ( bit % word_bits ) ) & mask );
+        }
+
+        auto set_index_at( const std::size_t i, const std::size_t index ) -> void {
+            const auto bit = i * bits_;
+            const auto mask = ( uint64_t{ 1 } << bits_ ) - 1;
+            auto &word = words_[bit / word_bits];
+            word = ( word & ~( mask << ( bit % word_bits ) ) ) |
+                   ( static_cast<uint64_t>( index ) << ( bit % word_bits ) );
+        }
+
+        /** Palette index of @p value, adding it if needed; cell @p target is about to take it. */
+        auto find_or_add( const T &value, const std::size_t target ) -> std::size_t {
+            const auto found = std::find( palette_.begin(), palette_.end(), value );
+            if( found != palette_.end() ) {
+                return static_cast<std::size_t>( found - palette_.begin() );
+            }
+            if( palette_.size() >= ( std::size_t{ 1 } << bits_ ) ) {
+                compact( target );
+            }
+            if( palette_.size() >= ( std::size_t{ 1 } << bits_ ) ) {
+                widen( bits_ == 0 ? 1 : bits_ * 2 );
+            }
+            palette_.push_back( value );
+            return palette_.size() - 1;
+        }
+
+        /** Drops palette entries no cell other than @p target uses. */
+        auto compact( const std::size_t target ) -> void {
+            if( bits_ == 0 ) {
+                return;
+            }
+            auto used = std::vector<bool>( palette_.size(), false );
+            for( auto i = std::size_t{ 0 }; i < N; ++i ) {
+                if( i != target ) {
+                    used[index_at( i )] = true;
+                }
+            }
+            if( std::ranges::find( used, false ) == used.end() ) {
+                return;
+            }
+            auto remap = std::vector<std::size_t>( palette_.size(), 0 );
+            auto kept = std::vector<T>();
+            for( auto p = std::size_t{ 0 }; p < palette_.size(); ++p ) {
+                if( used[p] ) {
+                    remap[p] = kept.size();
+                    kept.push_back( std::move( palette_[p] ) );
+                }
+            }
+            for( auto i = std::size_t{ 0 }; i < N; ++i ) {
+                set_index_at( i, i == target ? 0 : remap[index_at( i )] );
+            }
+            palette_ = std::move( kept );
+        }
+
+        auto widen( const int bits ) -> void {
+            auto words = std::make_unique<uint64_t[]>( word_count( bits ) );
+            const auto old_bits = bits_;
+            auto old_words = std::exchange( words_, std::move( words ) );
+            bits_ = bits;
+            for( auto i = std::size_t{ 0 }; old_bits != 0 && i < N; ++i ) {
+                const auto bit = i * old_bits;
+                const auto mask = ( uint64_t{ 1 } << old_bits ) - 1;
+                set_index_at( i, ( old_words[bit / word_bits] >> ( bit % word_bits ) ) & mask );
+            }
+        }
+
+        std::vector<T> palette_;
+        std::unique_ptr<uint64_t[]> words_;
+        int bits_ = 0;
+};
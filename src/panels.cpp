@@ -2,8 +2,10 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iosfwd>
 #include <iterator>
@@ -13,6 +15,7 @@
 #include <ranges>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <utility>
 
 #include "action.h"
@@ -241,7 +244,56 @@ auto get_lua_widget_lines( const cata::lua_sidebar_widgets::widget_entry &widget
     return {};
 }
 
-auto should_render_lua_widget( const cata::lua_sidebar_widgets::widget_entry &widget ) -> bool
+/** What a Lua widget's callbacks last returned, reused for as long as its refresh policy allows. */
+struct lua_widget_cache_entry {
+    uint64_t generation = 0;
+    time_point turn;
+    std::chrono::steady_clock::time_point refreshed;
+    std::optional<bool> visible;
+    std::optional<point> size;
+    std::vector<lua_widget_line> lines;
+};
+
+auto lua_widget_cache() -> std::unordered_map<std::string, lua_widget_cache_entry> & // *NOPAD*
+{
+    static auto cache = std::unordered_map<std::string, lua_widget_cache_entry> {};
+    return cache;
+}
+
+/** The cache entry of @p widget, emptied first if its output has to be asked for again. */
+auto fresh_lua_widget_cache( const cata::lua_sidebar_widgets::widget_entry &widget ) ->
+lua_widget_cache_entry & // *NOPAD*
+{
+    using cata::lua_sidebar_widgets::refresh_policy;
+    auto &entry = lua_widget_cache()[widget.id];
+    const auto now = std::chrono::steady_clock::now();
+    const auto stale = [&]() {
+        if( entry.generation != widget.generation ) {
+            return true;
+        }
+        switch( widget.refresh ) {
+            case refresh_policy::every_frame:
+                return true;
+            case refresh_policy::per_turn:
+                return entry.turn != calendar::turn;
+            case refresh_policy::on_event:
+                return false;
+            case refresh_policy::interval:
+                return now - entry.refreshed >= std::chrono::milliseconds( widget.refresh_interval_ms );
+        }
+        return true;
+    }();
+    if( stale ) {
+        entry = lua_widget_cache_entry{
+            .generation = widget.generation,
+            .turn = calendar::turn,
+            .refreshed = now,
+        };
+    }
+    return entry;
+}
+
+auto query_lua_widget_visible( const cata::lua_sidebar_widgets::widget_entry &widget ) -> bool
 {
     if( widget.panel_visible_fn ) {
         try {
@@ -291,13 +343,28 @@ auto should_render_lua_widget( const cata::lua_sidebar_widgets::widget_entry &wi
     return true;
 }
 
+auto should_render_lua_widget( const cata::lua_sidebar_widgets::widget_entry &widget ) -> bool
+{
+    auto &cache = fresh_lua_widget_cache( widget );
+    if( !cache.visible ) {
+        cache.visible = query_lua_widget_visible( widget );
+    }
+    return *cache.visible;
+}
+
 auto draw_lua_widget_panel( const cata::lua_sidebar_widgets::widget_entry &widget,
                             const catacurses::window &w ) -> void
 {
     werase( w );
     const auto window_height = getmaxy( w );
     const auto window_width = getmaxx( w );
-    const auto lines = get_lua_widget_lines( widget, window_width, window_height );
+    auto &cache = fresh_lua_widget_cache( widget );
+    const auto size = point( window_width, window_height );
+    if( cache.size != size ) {
+        cache.lines = get_lua_widget_lines( widget, window_width, window_height );
+        cache.size = size;
+    }
+    const auto &lines = cache.lines;
     const auto layout_id = panel_manager::get_manager().get_current_layout_id();
     const auto add_leading_space = layout_id == "labels" || layout_id == "labels-narrow";
     const auto max_lines = static_cast<size_t>( window_height );
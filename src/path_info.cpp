@@ -257,6 +257,14 @@ std::string PATH_INFO::lastworld()
 {
     return config_dir_value + "lastworld.json";
 }
+std::string PATH_INFO::lua_cachedir()
+{
+    return user_dir_value + "cache/lua/";
+}
+std::string PATH_INFO::gpu_cachedir()
+{
+    return user_dir_value + "cache/gpu/";
+}
 std::string PATH_INFO::memorialdir()
 {
     return memorialdir_value;
@@ -304,6 +312,10 @@ std::string PATH_INFO::shaders()
 {
     return datadir_value + "shaders/";
 }
+std::string PATH_INFO::save_dictionarydir()
+{
+    return datadir_value + "raw/save_dictionaries/";
+}
 std::string PATH_INFO::sokoban()
 {
     return datadir_value + "raw/" + "sokoban.txt";
@@ -27,11 +27,13 @@ std::string user_fontconfig();
 std::string fontdir();
 std::string user_fontdir();
 std::string language_defs_file();
+std::string gpu_cachedir();
 std::string graveyarddir();
 std::string help();
 std::string keybindingsdir();
 std::string main_menu_tips();
 std::string lastworld();
+std::string lua_cachedir();
 std::string memorialdir();
 std::string moddir();
 std::string options();
@@ -41,6 +43,7 @@ std::string safemode();
 std::string shaders();
 std::string distraction();
 std::string savedir();
+std::string save_dictionarydir();
 std::string sokoban();
 std::string templatedir();
 std::string user_dir();
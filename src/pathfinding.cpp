@@ -1,22 +1,37 @@
 #include "pathfinding.h"
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <ranges>
+#include <span>
 #include <vector>
 
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
 #include "coordinates.h"
+#include "creature.h"
 #include "game.h"
 #include "game_constants.h"
 #include "map.h"
 #include "mapbuffer.h"
 #include "mapbuffer_registry.h"
+#include "mapdata.h"
 #include "map_iterator.h"
 #include "point.h"
+#include "profile.h"
+#include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "trap.h"
+#include "turn_recorder.h"
 #include "veh_type.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
@@ -41,6 +56,65 @@ decltype( Pathfinding::z_caches_include_open_air ) Pathfinding::z_caches_include
 decltype( Pathfinding::z_caches ) Pathfinding::z_caches = {};
 decltype( Pathfinding::z_caches_open_air ) Pathfinding::z_caches_open_air = {};
 decltype( Pathfinding::cached_closest_z_changes ) Pathfinding::cached_closest_z_changes = {};
+decltype( Pathfinding::portal_graphs ) Pathfinding::portal_graphs = {};
+decltype( Pathfinding::vehicle_submaps ) Pathfinding::vehicle_submaps = {};
+decltype( Pathfinding::vehicle_submaps_turn ) Pathfinding::vehicle_submaps_turn = -1;
+
+namespace
+{
+
+// Expansion runs on pool workers during `route_batch`, so these are atomic
+struct stats_counters {
+    std::atomic<std::uint64_t> d_maps_created = 0;
+    std::atomic<std::uint64_t> d_maps_reused = 0;
+    std::atomic<std::uint64_t> d_maps_repaired = 0;
+    std::atomic<std::uint64_t> expansions = 0;
+    std::atomic<std::uint64_t> tiles_expanded = 0;
+    std::atomic<std::uint64_t> expansion_ns = 0;
+    std::array<std::atomic<std::uint64_t>, 4> outcomes = {};
+    std::atomic<std::uint64_t> z_cache_rebuilds = 0;
+    std::atomic<std::uint64_t> uniform_areas = 0;
+};
+stats_counters counters;
+// Totals when the current turn started, and the delta over the previous one
+PathfindingStats turn_start_stats;
+PathfindingStats last_turn;
+
+bool collect_explored_heat = false;
+std::unordered_map<tripoint_abs_ms, int> explored_heat;
+
+constexpr std::array<const char *, 4> outcome_names = {
+    "path found", "target inaccessible", "path not found", "no path exists"
+};
+constexpr std::array<const char *, 4> outcome_plot_names = {
+    "Pathfinding Path Found", "Pathfinding Target Inaccessible", "Pathfinding Path Not Found",
+    "Pathfinding No Path Exists"
+};
+
+void count( std::atomic<std::uint64_t> &counter, std::uint64_t n = 1 )
+{
+    counter.fetch_add( n, std::memory_order_relaxed );
+}
+
+} // namespace
+
+PathfindingStats PathfindingStats::operator-( const PathfindingStats &rhs ) const
+{
+    PathfindingStats ret{
+        .d_maps_created = d_maps_created - rhs.d_maps_created,
+        .d_maps_reused = d_maps_reused - rhs.d_maps_reused,
+        .d_maps_repaired = d_maps_repaired - rhs.d_maps_repaired,
+        .expansions = expansions - rhs.expansions,
+        .tiles_expanded = tiles_expanded - rhs.tiles_expanded,
+        .expansion_time = expansion_time - rhs.expansion_time,
+        .z_cache_rebuilds = z_cache_rebuilds - rhs.z_cache_rebuilds,
+        .uniform_areas = uniform_areas - rhs.uniform_areas,
+    };
+    for( size_t i = 0; i < outcomes.size(); ++i ) {
+        ret.outcomes[i] = outcomes[i] - rhs.outcomes[i];
+    }
+    return ret;
+}
 
 // Thanks for nothing, MVSC
 // For our MVSC builds, std::is_nan and std::is_inf are not constexpr
@@ -87,6 +161,12 @@ struct pathfinding_tile {
     }
 };
 
+// `ExploredSubmap::revision` of a submap that wasn't in memory
+constexpr std::uint64_t absent_submap_revision = UINT64_MAX;
+
+// Width of the speed buckets `Pathfinding::flow_field_settings` rounds to
+constexpr float flow_field_speed_bucket = 25.0f;
+
 auto pathfinding_lookup_options() -> mapbuffer_lookup_options
 {
     return { .mode = mapbuffer_lookup_mode::simulated_only };
@@ -121,6 +201,181 @@ auto passable_ter_furn_at( const mapbuffer_abs_tile_reader &reader,
     return tile->passable_ter_furn();
 }
 
+// What a step costs besides the two tiles it joins; see `step_g_cost`.
+struct step_cost_context {
+    const map &here;
+    mapbuffer &buffer;
+    const PathfindingSettings &settings;
+    // Do other creatures on a tile add `mob_presence_penalty`? Off for portal graphs, which outlive them.
+    bool include_mobs = true;
+};
+
+// Do the vehicles on either tile let us step from `cur` into `next`?
+auto is_step_allowed( const pathfinding_tile &cur_tile, const tripoint_abs_ms &cur,
+                      const tripoint_abs_ms &next, const vehicle *next_vehicle ) -> bool
+{
+    const auto *const cur_vehicle = cur_tile.vehicle_ptr();
+    const bool is_valid_to_step_into_veh =
+        cur_vehicle == nullptr ?
+        true :
+        cur_vehicle->allowed_move( cur_vehicle->abs_to_mount( cur ),
+                                   cur_vehicle->abs_to_mount( next ) );
+
+    const bool is_valid_to_step_out_of_veh =
+        next_vehicle == nullptr ?
+        true :
+        next_vehicle->allowed_move( next_vehicle->abs_to_mount( cur ),
+                                    next_vehicle->abs_to_mount( next ) );
+
+    return is_valid_to_step_into_veh && is_valid_to_step_out_of_veh;
+}
+
+// G-cost of leaving `cur` [moving, opening, climbing or bashing through it], INFINITY if we can't.
+//   `next_vehicle` is the vehicle on the tile we step into.
+//   `has_creature` is set to whether another creature's presence was priced in.
+auto step_g_cost( const step_cost_context &ctx, const pathfinding_tile &cur_tile,
+                  const tripoint_abs_ms &cur, const vehicle *next_vehicle, bool is_diag,
+                  bool *has_creature = nullptr ) -> float
+{
+    const bool can_open_doors = !is_inf( ctx.settings.door_open_cost );
+    const bool can_bash = ctx.settings.bash_strength_val > 0;
+    const bool can_climb = !is_inf( ctx.settings.climb_cost );
+    const bool care_about_mobs = ctx.include_mobs && ctx.settings.mob_presence_penalty > 0;
+    const bool care_about_traps = ctx.settings.trap_cost > 0;
+
+    auto *const cur_vehicle = cur_tile.vehicle_ptr();
+    const auto cur_vehicle_part = cur_tile.part_index();
+    const auto ter_flags = cache_attr::of( cur_tile.terrain );
+    const auto furn_flags = cache_attr::of( cur_tile.furniture );
+    const auto move_cost = cur_tile.move_cost;
+
+    float cur_g = 0.0;
+    cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
+    cur_g *= ctx.settings.move_cost_coeff;
+
+    // First, check for trivial cost modifiers
+    const bool is_rough = move_cost > 2;
+    const bool is_sharp = ( ter_flags & cache_attr::sharp ) != 0;
+
+    cur_g += is_rough ? ctx.settings.rough_terrain_cost : 0.0;
+    cur_g += is_sharp ? ctx.settings.sharp_terrain_cost : 0.0;
+
+    if( care_about_mobs && !std::isinf( cur_g ) ) {
+        const bool creature_here = ctx.buffer.has_creature_at( cur, true );
+        if( has_creature != nullptr ) {
+            *has_creature = creature_here;
+        }
+        cur_g += creature_here ?
+                 ctx.settings.mob_presence_penalty :
+                 0.0;
+    }
+
+    if( care_about_traps && !std::isinf( cur_g ) ) {
+        const trap &maybe_ter_trap = cur_tile.terrain.obj().trap.obj();
+        const trap &maybe_trap = maybe_ter_trap.is_benign() ? cur_tile.trap.obj() : maybe_ter_trap;
+        const bool is_trap = !maybe_trap.is_benign();
+
+        cur_g += is_trap ? ctx.settings.trap_cost : 0.0;
+    }
+
+    const bool is_ledge = ( ter_flags & cache_attr::ledge ) != 0;
+    if( is_ledge && !ctx.settings.can_fly ) {
+        // Close ledges outright for non-fliers
+        cur_g += INFINITY;
+    }
+
+    // And finally, add a potential field extra
+    if( !std::isinf( cur_g ) ) {
+        if( const auto extra = ctx.settings.extra_g_costs.find( cur.xy() );
+            extra != ctx.settings.extra_g_costs.end() ) {
+            cur_g += extra->second;
+        }
+    }
+
+    const bool is_passable = move_cost != 0;
+    float obstacle_g = 0;
+    // Calculate the cost for if the tile is impassable
+    while( !std::isinf( cur_g ) && !is_passable ) {
+        const bool is_climbable = ( ter_flags & cache_attr::climbable ) != 0;
+        const bool is_door = ( ( ter_flags | furn_flags ) & cache_attr::openable ) != 0;
+
+        if( cur_vehicle != nullptr ) {
+            // Do processing for possible vehicle first
+            const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
+                                                cur_vehicle_part ).obstacle_at_part();
+            const int obstacle_part = vpobst ? vpobst->part_index() : -1;
+
+            if( obstacle_part >= 0 ) {
+                const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
+                const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
+                const bool is_cur_point_inside = cur_vehicle == next_vehicle;
+                const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
+
+                if( can_open_doors && valid_to_open ) {
+                    obstacle_g = ctx.settings.door_open_cost;
+                } else if( can_bash ) {
+                    const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
+                                    ctx.settings.bash_strength_val * ctx.settings.bash_strength_quanta,
+                                    DT_BASH );
+                    if( htd == 0 ) {
+                        // We cannot bash down this part
+                        obstacle_g = INFINITY;
+                        break;
+                    } else {
+                        obstacle_g = ctx.settings.bash_cost * htd;
+                        break;
+                    }
+                } else {
+                    // Nothing can be done here. Don't bother with other checks since vehicles take priority.
+                    obstacle_g = INFINITY;
+                    break;
+                }
+            }
+        }
+
+        if( is_climbable && can_climb ) {
+            obstacle_g = ctx.settings.climb_cost;
+            break;
+        }
+        if( is_door && can_open_doors ) {
+            // Doors that can only be open from the inside
+            const bool door_opens_from_inside =
+                ( ( ter_flags | furn_flags ) & cache_attr::opens_inside ) != 0;
+            const bool is_cur_point_inside = !ctx.here.is_outside( abs_to_map_local( ctx.here,
+                                             cur ) );
+            const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
+            if( valid_to_open ) {
+                obstacle_g = ctx.settings.door_open_cost;
+                break;
+            }
+        }
+        if( can_bash ) {
+            // Time to consider bashing the obstacle
+            const int rating = ctx.here.bash_rating_internal(
+                                   ctx.settings.bash_strength_val * ctx.settings.bash_strength_quanta,
+                                   cur_tile.furniture, cur_tile.terrain, false, cur_vehicle, cur_vehicle_part );
+            if( rating > 1 ) {
+                obstacle_g = ( 10. / rating ) * ctx.settings.bash_cost;
+                break;
+            } else if( rating == 1 ) {
+                // Rating == 1 implies it will take at least 10 turns to take this down
+                //   which is a very unattractive target
+                //   so we'll penalize this target a lot
+                obstacle_g = 30.0 * ctx.settings.bash_cost * ctx.settings.bash_cost * ctx.settings.bash_cost;
+                break;
+            }
+
+        }
+        // We can do nothing anymore, close the tile
+        obstacle_g = INFINITY;
+        break;
+    }
+
+    cur_g += obstacle_g;
+
+    return cur_g;
+}
+
 } // namespace
 
 // PathfindingSettings impls
@@ -244,6 +499,7 @@ Pathfinding::Pathfinding( int mx, int my )
     , p_map( mx * my, 0.0f )
     , g_map( mx * my, 0.0f )
     , tile_state( ( mx + 2 ) * ( my + 2 ), State::UNVISITED )
+    , explored_submaps( ( mx / SEEX ) * ( my / SEEY ) )
 {}
 
 /// Pathfinding: map indexing
@@ -292,27 +548,174 @@ void Pathfinding::produce_d_map( point_abs_ms dest, int z, PathfindingSettings s
     d_map->z = z;
     d_map->origin = project_to<coords::ms>( get_map().get_abs_sub() );
     d_map->settings = settings;
+    d_map->repaired_turn = to_turn<int>( calendar::turn );
 
     Pathfinding::d_maps.push_back( std::move( d_map ) );
 }
+void Pathfinding::reset_all()
+{
+    this->reset_maps();
+    this->reset_tile_state();
+    this->unbiased_frontier.clear();
+    this->forbidden_moves.clear();
+    this->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
+    this->is_explored = false;
+    std::ranges::fill( this->explored_submaps, ExploredSubmap() );
+    this->mob_tiles.clear();
+    this->last_used_turn = -1;
+    this->repaired_turn = -1;
+}
+std::pair<std::size_t, std::size_t> Pathfinding::memory_usage()
+{
+    const auto map_bytes = []( const Pathfinding & map ) {
+        return sizeof( Pathfinding ) + map.p_map.capacity() * sizeof( float ) +
+               map.g_map.capacity() * sizeof( float ) + map.tile_state.capacity() * sizeof( State ) +
+               ( map.map_modify_set.capacity() + map.tile_state_modify_set.capacity() +
+                 map.unbiased_frontier.capacity() + map.mob_tiles.capacity() ) * sizeof( point_abs_ms ) +
+               map.explored_submaps.capacity() * sizeof( ExploredSubmap );
+    };
+    auto bytes = std::size_t{ 0 };
+    for( const auto &map : Pathfinding::d_maps ) {
+        bytes += map_bytes( *map );
+    }
+    for( const auto &map : Pathfinding::d_maps_store ) {
+        bytes += map_bytes( *map );
+    }
+    return { Pathfinding::d_maps.size() + Pathfinding::d_maps_store.size(), bytes };
+}
+
 void Pathfinding::clear_d_maps()
 {
     for( auto &map : Pathfinding::d_maps ) {
-        map->reset_maps();
-        map->reset_tile_state();
-        map->unbiased_frontier.clear();
-        map->forbidden_moves.clear();
-        map->domain = Pathfinding::MapDomain::RELATIVE_DOMAIN;
-        map->is_explored = false;
+        map->reset_all();
         Pathfinding::d_maps_store.push_back( std::move( map ) );
     }
     Pathfinding::d_maps.clear();
     Pathfinding::cached_closest_z_changes.clear();
 }
+void Pathfinding::end_turn()
+{
+    const int turn = to_turn<int>( calendar::turn );
+    const PathfindingStats now = Pathfinding::stats();
+    last_turn = now - turn_start_stats;
+    turn_start_stats = now;
+    TracyPlot( "Pathfinding d_maps Created", static_cast<int64_t>( last_turn.d_maps_created ) );
+    TracyPlot( "Pathfinding d_maps Reused", static_cast<int64_t>( last_turn.d_maps_reused ) );
+    TracyPlot( "Pathfinding d_maps Repaired", static_cast<int64_t>( last_turn.d_maps_repaired ) );
+    TracyPlot( "Pathfinding Tiles Expanded", static_cast<int64_t>( last_turn.tiles_expanded ) );
+    TracyPlot( "Pathfinding Expansion ms",
+               static_cast<double>( last_turn.expansion_time.count() ) / 1e6 );
+    for( size_t i = 0; i < outcome_plot_names.size(); ++i ) {
+        TracyPlot( outcome_plot_names[i], static_cast<int64_t>( last_turn.outcomes[i] ) );
+    }
+    TracyPlot( "Pathfinding Z-cache Rebuilds", static_cast<int64_t>( last_turn.z_cache_rebuilds ) );
+    TracyPlot( "Pathfinding Uniform Submaps", static_cast<int64_t>( last_turn.uniform_areas ) );
+
+    explored_heat.clear();
+    if( collect_explored_heat ) {
+        for( const auto &map : Pathfinding::d_maps ) {
+            if( map->last_used_turn != turn ) {
+                continue;
+            }
+            explored_heat[tripoint_abs_ms( map->dest, map->z )]++;
+            for( const point_abs_ms &p : map->map_modify_set ) {
+                explored_heat[tripoint_abs_ms( p, map->z )]++;
+            }
+        }
+    }
+
+    if( !persistent_d_maps ) {
+        Pathfinding::clear_d_maps();
+        return;
+    }
+
+    const point_abs_ms cur_origin = project_to<coords::ms>( get_map().get_abs_sub() );
+    std::vector<std::unique_ptr<Pathfinding>> kept;
+    for( auto &map : Pathfinding::d_maps ) {
+        // A target nobody went for this turn is likely gone, and a shift moved the arrays under us
+        if( map->last_used_turn == turn && map->origin == cur_origin ) {
+            kept.push_back( std::move( map ) );
+        } else {
+            map->reset_all();
+            Pathfinding::d_maps_store.push_back( std::move( map ) );
+        }
+    }
+    Pathfinding::d_maps = std::move( kept );
+    Pathfinding::cached_closest_z_changes.clear();
+}
 void Pathfinding::clear_pool()
 {
     clear_d_maps();
     Pathfinding::d_maps_store.clear();
+    Pathfinding::portal_graphs.clear();
+}
+PathfindingStats Pathfinding::stats()
+{
+    PathfindingStats ret{
+        .d_maps_created = counters.d_maps_created.load( std::memory_order_relaxed ),
+        .d_maps_reused = counters.d_maps_reused.load( std::memory_order_relaxed ),
+        .d_maps_repaired = counters.d_maps_repaired.load( std::memory_order_relaxed ),
+        .expansions = counters.expansions.load( std::memory_order_relaxed ),
+        .tiles_expanded = counters.tiles_expanded.load( std::memory_order_relaxed ),
+        .expansion_time = std::chrono::nanoseconds( counters.expansion_ns.load( std::memory_order_relaxed ) ),
+        .z_cache_rebuilds = counters.z_cache_rebuilds.load( std::memory_order_relaxed ),
+        .uniform_areas = counters.uniform_areas.load( std::memory_order_relaxed ),
+    };
+    for( size_t i = 0; i < ret.outcomes.size(); ++i ) {
+        ret.outcomes[i] = counters.outcomes[i].load( std::memory_order_relaxed );
+    }
+    return ret;
+}
+const PathfindingStats &Pathfinding::last_turn_stats()
+{
+    return last_turn;
+}
+std::string Pathfinding::describe_stats()
+{
+    const PathfindingStats total = Pathfinding::stats();
+    const auto ms = []( std::chrono::nanoseconds ns ) {
+        return static_cast<double>( ns.count() ) / 1e6;
+    };
+    const auto row = []( const char *name, std::uint64_t turn, std::uint64_t all ) {
+        return string_format( "%-24s %12llu %14llu\n", name, static_cast<unsigned long long>( turn ),
+                              static_cast<unsigned long long>( all ) );
+    };
+    std::string out = string_format( "Pathfinding: %d d_maps live, %d pooled\n\n",
+                                     static_cast<int>( Pathfinding::d_maps.size() ),
+                                     static_cast<int>( Pathfinding::d_maps_store.size() ) );
+    out += string_format( "%-24s %12s %14s\n", "counter", "last turn", "since start" );
+    out += row( "d_maps created", last_turn.d_maps_created, total.d_maps_created );
+    out += row( "d_maps reused", last_turn.d_maps_reused, total.d_maps_reused );
+    out += row( "d_maps repaired", last_turn.d_maps_repaired, total.d_maps_repaired );
+    out += row( "expansions", last_turn.expansions, total.expansions );
+    out += row( "tiles expanded", last_turn.tiles_expanded, total.tiles_expanded );
+    for( size_t i = 0; i < outcome_names.size(); ++i ) {
+        out += row( outcome_names[i], last_turn.outcomes[i], total.outcomes[i] );
+    }
+    out += row( "z-cache rebuilds", last_turn.z_cache_rebuilds, total.z_cache_rebuilds );
+    out += row( "uniform submap searches", last_turn.uniform_areas, total.uniform_areas );
+    out += string_format( "%-24s %12.1f %14.1f\n", "expansion ms", ms( last_turn.expansion_time ),
+                          ms( total.expansion_time ) );
+    const std::uint64_t lookups = total.d_maps_created + total.d_maps_reused + total.d_maps_repaired;
+    if( lookups > 0 ) {
+        out += string_format( "\nd_map hit rate %.1f%%, %.0f tiles per expansion\n",
+                              100.0 * static_cast<double>( lookups - total.d_maps_created ) / static_cast<double>( lookups ),
+                              total.expansions > 0 ? static_cast<double>( total.tiles_expanded ) / static_cast<double>
+                              ( total.expansions ) : 0.0 );
+    }
+    return out;
+}
+void Pathfinding::set_collect_explored_heat( bool collect )
+{
+    collect_explored_heat = collect;
+    if( !collect ) {
+        explored_heat.clear();
+    }
+}
+int Pathfinding::explored_heat_at( const tripoint_abs_ms &p )
+{
+    const auto it = explored_heat.find( p );
+    return it == explored_heat.end() ? 0 : it->second;
 }
 void Pathfinding::mark_dirty_z_cache()
 {
@@ -351,8 +754,171 @@ void Pathfinding::reset_tile_state()
         this->tile_state[( this->map_y_ + 1 ) * stride + x] = State::BOUNDS;
     }
 }
+void Pathfinding::note_explored( const point_abs_ms &p )
+{
+    const auto offset = this->map_pos_offset( p );
+    ExploredSubmap &explored =
+        this->explored_submaps[( offset.y() / SEEY ) * ( this->map_x_ / SEEX ) + offset.x() / SEEX];
+    if( explored.revision != 0 ) {
+        return;
+    }
+
+    const map &here = get_map();
+    const point_abs_sm sm = project_to<coords::sm>( p );
+    const submap *const sub = MAPBUFFER_REGISTRY.get( here.get_bound_dimension() )
+                              .lookup_submap_in_memory( tripoint_abs_sm( sm, this->z ) );
+    explored.revision = sub != nullptr ? sub->pf_revision : absent_submap_revision;
+    explored.had_vehicle = Pathfinding::vehicle_submaps[this->z + OVERMAP_DEPTH].contains( sm );
+}
+void Pathfinding::repair()
+{
+    const int turn = to_turn<int>( calendar::turn );
+    if( this->repaired_turn == turn ) {
+        return;
+    }
+    this->repaired_turn = turn;
+
+    const map &here = get_map();
+    auto &buffer = MAPBUFFER_REGISTRY.get( here.get_bound_dimension() );
+    Pathfinding::update_vehicle_submaps();
+    const auto &vehicles_here = Pathfinding::vehicle_submaps[this->z + OVERMAP_DEPTH];
+
+    // Tiles whose g-value may differ from what we explored them with
+    std::vector<point_abs_ms> changed;
+    const point_abs_sm origin_sm = project_to<coords::sm>( this->origin );
+    const int submaps_x = this->map_x_ / SEEX;
+    for( std::size_t i = 0; i < this->explored_submaps.size(); i++ ) {
+        ExploredSubmap &explored = this->explored_submaps[i];
+        if( explored.revision == 0 ) {
+            continue;
+        }
+        const point_abs_sm sm = origin_sm + point_rel_sm( i % submaps_x, i / submaps_x );
+        const submap *const sub = buffer.lookup_submap_in_memory( tripoint_abs_sm( sm, this->z ) );
+        const std::uint64_t revision = sub != nullptr ? sub->pf_revision : absent_submap_revision;
+        if( revision == explored.revision && !explored.had_vehicle && !vehicles_here.contains( sm ) ) {
+            continue;
+        }
+        explored = ExploredSubmap();
+        const point_abs_ms sm_origin = project_to<coords::ms>( sm );
+        for( int y = 0; y < SEEY; y++ ) {
+            for( int x = 0; x < SEEX; x++ ) {
+                changed.push_back( sm_origin + point_rel_ms( x, y ) );
+            }
+        }
+    }
+    if( this->settings.mob_presence_penalty > 0 ) {
+        // Where creatures were when we priced them in, and where they are now
+        changed.insert( changed.end(), this->mob_tiles.begin(), this->mob_tiles.end() );
+        this->mob_tiles.clear();
+        for( const Creature &critter : g->all_creatures() ) {
+            const tripoint_abs_ms pos = critter.abs_pos();
+            if( pos.z() == this->z ) {
+                changed.push_back( pos.xy() );
+            }
+        }
+    }
+    std::erase_if( changed, [this]( const point_abs_ms & p ) {
+        return !this->in_bounds( p );
+    } );
+    if( changed.empty() ) {
+        return;
+    }
+
+    const std::unordered_set<point_abs_ms> changed_set( changed.begin(), changed.end() );
+    const auto touches_changed = [&changed_set]( const std::pair<point_abs_ms, point_abs_ms> &move ) {
+        return changed_set.contains( move.first ) || changed_set.contains( move.second );
+    };
+
+    if( this->domain == MapDomain::RELATIVE_DOMAIN ) {
+        // Relative searches rebuild the tile state anyway, only g-values carry over
+        for( const point_abs_ms &p : changed ) {
+            this->p_at( p ) = 0.0;
+            this->g_at( p ) = 0.0;
+        }
+        std::erase_if( this->forbidden_moves, touches_changed );
+        return;
+    }
+
+    // f-values only grow along the wave, so a tile cheaper than every changed tile and their neighbours
+    //   was reached without going through any of them and still holds
+    float threshold = INFINITY;
+    for( const point_abs_ms &p : changed ) {
+        if( this->tile_state_at( p ) == State::ACCESSIBLE ) {
+            threshold = std::min( threshold, this->get_f_unbiased( p ) );
+        }
+        for( const auto &dir : DIRS_2D ) {
+            const point_abs_ms next = p + dir;
+            if( this->in_bounds( next ) && this->tile_state_at( next ) == State::ACCESSIBLE ) {
+                threshold = std::min( threshold, this->get_f_unbiased( next ) );
+            }
+        }
+    }
+    std::erase_if( this->forbidden_moves, touches_changed );
+    if( is_inf( threshold ) ) {
+        // Nothing we reached was affected
+        return;
+    }
+    if( threshold <= 0.0 ) {
+        // The destination itself is affected
+        this->reset_all();
+        this->repaired_turn = turn;
+        return;
+    }
+
+    // Closed tiles go with the tile which reached them
+    const auto is_stale = [&]( const point_abs_ms & p ) {
+        const float reached_at = this->tile_state_at( p ) == State::IMPASSABLE ?
+                                 this->p_at( p ) : this->get_f_unbiased( p );
+        return reached_at >= threshold || changed_set.contains( p );
+    };
+    std::unordered_set<point_abs_ms> forgotten;
+    for( const point_abs_ms &p : this->tile_state_modify_set ) {
+        if( is_stale( p ) ) {
+            forgotten.insert( p );
+        }
+    }
+    for( const point_abs_ms &p : this->map_modify_set ) {
+        if( is_stale( p ) ) {
+            forgotten.insert( p );
+        }
+    }
+
+    // What's left of the wave resumes from its old frontier and from wherever we forgot tiles
+    std::unordered_set<point_abs_ms> frontier;
+    for( const point_abs_ms &p : this->unbiased_frontier ) {
+        if( !forgotten.contains( p ) && this->tile_state_at( p ) == State::ACCESSIBLE ) {
+            frontier.insert( p );
+        }
+    }
+    for( const point_abs_ms &p : forgotten ) {
+        for( const auto &dir : DIRS_2D ) {
+            const point_abs_ms next = p + dir;
+            if( !forgotten.contains( next ) && this->in_bounds( next ) &&
+                this->tile_state_at( next ) == State::ACCESSIBLE ) {
+                frontier.insert( next );
+            }
+        }
+    }
+
+    for( const point_abs_ms &p : forgotten ) {
+        this->tile_state_at( p ) = State::UNVISITED;
+        this->p_at( p ) = 0.0;
+        this->g_at( p ) = 0.0;
+    }
+    const auto is_forgotten = [&forgotten]( const point_abs_ms & p ) {
+        return forgotten.contains( p );
+    };
+    std::erase_if( this->tile_state_modify_set, is_forgotten );
+    std::erase_if( this->map_modify_set, is_forgotten );
+    std::erase_if( this->mob_tiles, is_forgotten );
+    std::erase_if( this->forbidden_moves, [&forgotten]( const std::pair<point_abs_ms, point_abs_ms> &move ) {
+        return forgotten.contains( move.first ) || forgotten.contains( move.second );
+    } );
+    this->unbiased_frontier.assign( frontier.begin(), frontier.end() );
+    this->is_explored = false;
+}
 /// Pathfinding: Z-levels
-std::unordered_map<point_abs_ms, Pathfinding::ZLevelChangeOpenAirPair>
+cata::flat_hash_map<point_abs_ms, Pathfinding::ZLevelChangeOpenAirPair>
 &Pathfinding::get_z_cache_open_air( const int z )
 {
     assert( -OVERMAP_DEPTH <= z && z <= OVERMAP_HEIGHT );
@@ -379,6 +945,7 @@ void Pathfinding::update_z_caches( bool update_open_air )
         return;
     }
 
+    count( counters.z_cache_rebuilds );
     for( auto &target : Pathfinding::z_caches ) {
         target.clear();
     }
@@ -562,9 +1129,20 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
 {
     using Frontier = std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first>;
 
+    const auto started = std::chrono::steady_clock::now();
+    std::uint64_t expanded = 0;
+    const auto finish = [&]( ExpansionOutcome outcome ) {
+        count( counters.expansions );
+        count( counters.tiles_expanded, expanded );
+        count( counters.outcomes[static_cast<int>( outcome )] );
+        count( counters.expansion_ns, std::chrono::duration_cast<std::chrono::nanoseconds>
+               ( std::chrono::steady_clock::now() - started ).count() );
+        return outcome;
+    };
+
     if( start == this->dest ) {
         // Special case where if we already are standing on the destination tile
-        return ExpansionOutcome::PATH_FOUND;
+        return finish( ExpansionOutcome::PATH_FOUND );
     }
 
     const bool rebuild_needed = this->domain == MapDomain::ABSOLUTE_DOMAIN ?
@@ -583,14 +1161,14 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     if( !rebuild_needed ) {
         switch( this->tile_state_at( start ) ) {
             case Pathfinding::State::ACCESSIBLE:
-                return ExpansionOutcome::PATH_FOUND;
+                return finish( ExpansionOutcome::PATH_FOUND );
             case Pathfinding::State::IMPASSABLE:
-                return ExpansionOutcome::TARGET_INACCESSIBLE;
+                return finish( ExpansionOutcome::TARGET_INACCESSIBLE );
             case Pathfinding::State::INACCESSIBLE:
-                return ExpansionOutcome::NO_PATH_EXISTS;
+                return finish( ExpansionOutcome::NO_PATH_EXISTS );
             case Pathfinding::State::UNVISITED:
                 if( this->is_explored ) {
-                    return ExpansionOutcome::NO_PATH_EXISTS;
+                    return finish( ExpansionOutcome::NO_PATH_EXISTS );
                 }
                 for( const point_abs_ms &p : this->unbiased_frontier ) {
                     biased_frontier.emplace( this->get_f_biased( p, start, route_settings.h_coeff ), p );
@@ -598,7 +1176,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                 break;
             case Pathfinding::State::BOUNDS:
                 // Should not occur ever
-                return ExpansionOutcome::NO_PATH_EXISTS;
+                return finish( ExpansionOutcome::NO_PATH_EXISTS );
         }
     } else {
         // Only reset tile state, we will reuse already calculated g-values
@@ -622,14 +1200,10 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     std::unordered_set<point_abs_ms> culled_frontier;
     ExpansionOutcome result = ExpansionOutcome::UNSET;
 
-    const bool can_open_doors = !is_inf( this->settings.door_open_cost );
-    const bool can_bash = this->settings.bash_strength_val > 0;
-    const bool can_climb = !is_inf( this->settings.climb_cost );
-    const bool care_about_mobs = this->settings.mob_presence_penalty > 0;
-    const bool care_about_traps = this->settings.trap_cost > 0;
     const map &here = get_map();
     auto &buffer = MAPBUFFER_REGISTRY.get( here.get_bound_dimension() );
     const auto tile_reader = buffer.make_abs_tile_reader( pathfinding_lookup_options() );
+    const step_cost_context step_ctx{ .here = here, .buffer = buffer, .settings = this->settings };
 
     while( !biased_frontier.empty() ) {
         // Periodically check if `start` is enclosed
@@ -655,6 +1229,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
             continue;
         }
 
+        ++expanded;
         const tripoint_abs_ms next_point_with_z = tripoint_abs_ms( next_point, this->z );
         const auto next_tile = tile_reader.get_tile_with_vehicle( next_point_with_z );
         const auto next_vp = next_tile ? next_tile->vehicle_part() :
@@ -673,6 +1248,7 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
             if( this->tile_state_at( cur_point ) != Pathfinding::State::UNVISITED ) {
                 continue;
             }
+            this->note_explored( cur_point );
 
             const auto maybe_new_tile = get_pathfinding_tile( tile_reader, cur_point_with_z );
             if( !maybe_new_tile ) {
@@ -681,160 +1257,24 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
                 continue;
             }
             const auto &new_tile = *maybe_new_tile;
-            auto *const cur_vehicle = new_tile.vehicle_ptr();
-            const auto cur_vehicle_part = new_tile.part_index();
-
-            {
-                bool is_move_valid = true;
-
-                const bool is_valid_to_step_into_veh =
-                    cur_vehicle == nullptr ?
-                    true :
-                    cur_vehicle->allowed_move( cur_vehicle->abs_to_mount( cur_point_with_z ),
-                                               cur_vehicle->abs_to_mount( next_point_with_z ) );
-
-                const bool is_valid_to_step_out_of_veh =
-                    next_vehicle == nullptr ?
-                    true :
-                    next_vehicle->allowed_move( next_vehicle->abs_to_mount( cur_point_with_z ),
-                                                next_vehicle->abs_to_mount( next_point_with_z ) );
-
-                is_move_valid &= is_valid_to_step_into_veh;
-                is_move_valid &= is_valid_to_step_out_of_veh;
-
-                if( !is_move_valid ) {
-                    this->forbidden_moves.emplace( cur_point, next_point );
-                    continue;
-                }
+            if( !is_step_allowed( new_tile, cur_point_with_z, next_point_with_z, next_vehicle ) ) {
+                this->forbidden_moves.emplace( cur_point, next_point );
+                continue;
             }
 
-            const auto &terrain = new_tile.terrain.obj();
-            const auto &furniture = new_tile.furniture.obj();
-            const auto move_cost = new_tile.move_cost;
-
             float cur_g = this->g_at( cur_point );
             // May be false for relative search, so we'll reuse g-values there
             const bool is_g_calc_needed = cur_g == 0.0;
 
             if( is_g_calc_needed ) {
-                bool is_diag = dir.x() != 0 && dir.y() != 0;
-                cur_g += is_diag ? 0.75 * move_cost : 0.5 * move_cost;
-                cur_g *= this->settings.move_cost_coeff;
-
-                // First, check for trivial cost modifiers
-                const bool is_rough = move_cost > 2;
-                const bool is_sharp = terrain.has_flag( TFLAG_SHARP );
-
-                cur_g += is_rough ? this->settings.rough_terrain_cost : 0.0;
-                cur_g += is_sharp ? this->settings.sharp_terrain_cost : 0.0;
-
-                if( care_about_mobs && !std::isinf( cur_g ) ) {
-                    cur_g += buffer.has_creature_at( cur_point_with_z, true ) ?
-                             this->settings.mob_presence_penalty :
-                             0.0;
-                }
-
-                if( care_about_traps && !std::isinf( cur_g ) ) {
-                    const trap &maybe_ter_trap = terrain.trap.obj();
-                    const trap &maybe_trap = maybe_ter_trap.is_benign() ? new_tile.trap.obj() : maybe_ter_trap;
-                    const bool is_trap = !maybe_trap.is_benign();
-
-                    cur_g += is_trap ? this->settings.trap_cost : 0.0;
-                }
-
-                const bool is_ledge = terrain.has_flag( TFLAG_NO_FLOOR );
-                if( is_ledge && !this->settings.can_fly ) {
-                    // Close ledges outright for non-fliers
-                    cur_g += INFINITY;
-                }
-
-                // And finally, add a potential field extra
-                if( !std::isinf( cur_g ) && this->settings.extra_g_costs.contains( cur_point ) ) {
-                    cur_g += this->settings.extra_g_costs.at( cur_point );
-                }
-
-                const bool is_passable = move_cost != 0;
-                float obstacle_g = 0;
-                // Calculate the cost for if the tile is impassable
-                while( !std::isinf( cur_g ) && !is_passable ) {
-                    const bool is_climbable = terrain.has_flag( TFLAG_CLIMBABLE );
-                    const bool is_door = !!terrain.open || !!furniture.open;
-
-                    if( cur_vehicle != nullptr ) {
-                        // Do processing for possible vehicle first
-                        const auto vpobst = vpart_position( const_cast<vehicle &>( *cur_vehicle ),
-                                                            cur_vehicle_part ).obstacle_at_part();
-                        const int obstacle_part = vpobst ? vpobst->part_index() : -1;
-
-                        if( obstacle_part >= 0 ) {
-                            const bool part_is_door = cur_vehicle->part_flag( obstacle_part, VPFLAG_OPENABLE );
-                            const bool part_opens_from_inside = cur_vehicle->part_flag( obstacle_part, "OPENCLOSE_INSIDE" );
-                            const bool is_cur_point_inside = cur_vehicle == next_vehicle;
-                            const bool valid_to_open = part_is_door && ( part_opens_from_inside ? is_cur_point_inside : true );
-
-                            if( can_open_doors && valid_to_open ) {
-                                obstacle_g = this->settings.door_open_cost;
-                            } else if( can_bash ) {
-                                const int htd = cur_vehicle->hits_to_destroy( obstacle_part,
-                                                this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                                DT_BASH );
-                                if( htd == 0 ) {
-                                    // We cannot bash down this part
-                                    obstacle_g = INFINITY;
-                                    break;
-                                } else {
-                                    obstacle_g = this->settings.bash_cost * htd;
-                                    break;
-                                }
-                            } else {
-                                // Nothing can be done here. Don't bother with other checks since vehicles take priority.
-                                obstacle_g = INFINITY;
-                                break;
-                            }
-                        }
-                    }
-
-                    if( is_climbable && can_climb ) {
-                        obstacle_g = this->settings.climb_cost;
-                        break;
-                    }
-                    if( is_door && can_open_doors ) {
-                        // Doors that can only be open from the inside
-                        const bool door_opens_from_inside = terrain.has_flag( "OPENCLOSE_INSIDE" ) ||
-                                                            furniture.has_flag( "OPENCLOSE_INSIDE" );
-                        const bool is_cur_point_inside = !here.is_outside( abs_to_map_local( here,
-                                                         cur_point_with_z ) );
-                        const bool valid_to_open = door_opens_from_inside ? is_cur_point_inside : true;
-                        if( valid_to_open ) {
-                            obstacle_g = this->settings.door_open_cost;
-                            break;
-                        }
-                    }
-                    if( can_bash ) {
-                        // Time to consider bashing the obstacle
-                        const int rating = here.bash_rating_internal(
-                                               this->settings.bash_strength_val * this->settings.bash_strength_quanta,
-                                               furniture, terrain, false, cur_vehicle, cur_vehicle_part );
-                        if( rating > 1 ) {
-                            obstacle_g = ( 10. / rating ) * this->settings.bash_cost;
-                            break;
-                        } else if( rating == 1 ) {
-                            // Rating == 1 implies it will take at least 10 turns to take this down
-                            //   which is a very unattractive target
-                            //   so we'll penalize this target a lot
-                            obstacle_g = 30.0 * this->settings.bash_cost * this->settings.bash_cost * this->settings.bash_cost;
-                            break;
-                        }
-
-                    }
-                    // We can do nothing anymore, close the tile
-                    obstacle_g = INFINITY;
-                    break;
-                }
-
-                cur_g += obstacle_g;
-
+                const bool is_diag = dir.x() != 0 && dir.y() != 0;
+                bool has_creature = false;
+                cur_g = step_g_cost( step_ctx, new_tile, cur_point_with_z, next_vehicle, is_diag,
+                                     &has_creature );
                 this->g_at( cur_point ) = cur_g;
+                if( has_creature ) {
+                    this->mob_tiles.push_back( cur_point );
+                }
             }
 
             this->p_at( cur_point ) = this->get_f_unbiased( next_point );
@@ -884,84 +1324,625 @@ Pathfinding::ExpansionOutcome Pathfinding::expand_2d_up_to(
     if( result == ExpansionOutcome::UNSET ) {
         if( is_fully_explored ) {
             this->is_explored = true;
-            return ExpansionOutcome::NO_PATH_EXISTS;
+            return finish( ExpansionOutcome::NO_PATH_EXISTS );
         }
-        return ExpansionOutcome::PATH_NOT_FOUND;
+        return finish( ExpansionOutcome::PATH_NOT_FOUND );
     }
 
-    return result;
+    return finish( result );
 }
 
 
-std::vector<tripoint_abs_ms> Pathfinding::get_route_2d(
-    const point_abs_ms from, const point_abs_ms to, const int z,
-    const PathfindingSettings path_settings,
-    const RouteSettings route_settings )
+/// Pathfinding: hierarchical layer
+namespace
 {
-    if( from == to ) {
-        return std::vector<tripoint_abs_ms> { tripoint_abs_ms( from, z ), tripoint_abs_ms( to, z ) };
+
+// Chebyshev distance in submaps from which routes plan over portal graphs first
+constexpr int hierarchical_min_submaps = 2;
+// Portal graphs kept around at most; the least recently used goes first
+constexpr std::size_t max_portal_graphs = 32;
+// Entrances longer than this get a portal at each end instead of one in the middle
+constexpr int max_single_portal_entrance = 6;
+
+// Settings which share a portal graph. Other creatures are left to the searches near the ends;
+//   bash strength already comes quantized, see `bash_strength_quanta`.
+auto portal_graph_settings( const PathfindingSettings &settings ) -> PathfindingSettings
+{
+    PathfindingSettings result = settings;
+    result.mob_presence_penalty = 0.;
+    return result;
+}
+
+// A rectangle of tiles on one z-level
+struct tile_area {
+    point_abs_ms lo;
+    int width = 0;
+    int height = 0;
+
+    static auto of_submap( const point_abs_sm &sm ) -> tile_area {
+        return tile_area{ .lo = project_to<coords::ms>( sm ), .width = SEEX, .height = SEEY };
     }
+    auto contains( const point_abs_ms &p ) const -> bool {
+        const auto d = p - this->lo;
+        return d.x() >= 0 && d.y() >= 0 && d.x() < this->width && d.y() < this->height;
+    }
+    auto index( const point_abs_ms &p ) const -> int {
+        const auto d = p - this->lo;
+        return d.y() * this->width + d.x();
+    }
+    auto size() const -> int {
+        return this->width * this->height;
+    }
+};
 
-    auto d_map_it = std::ranges::find_if(
-                        Pathfinding::d_maps,
-    [&to, &path_settings, z]( auto & map ) {
-        return map->dest == to && map->z == z && map->settings == path_settings;
-    } );
+// Tiles of an area read once, with the g-cost of leaving each without a vehicle involved
+struct tile_window {
+    tile_area area;
+    int z = 0;
+    std::vector<std::optional<pathfinding_tile>> tiles;
+    // [index * 2 + is_diag], NaN until needed
+    mutable std::vector<float> leave_costs;
 
-    Pathfinding *d_map;
-    if( d_map_it == Pathfinding::d_maps.end() ) {
-        Pathfinding::produce_d_map( to, z, path_settings );
-        d_map = Pathfinding::d_maps.back().get();
-    } else {
-        d_map = d_map_it->get();
+    auto tile( const point_abs_ms &p ) const -> const std::optional<pathfinding_tile> & {
+        return this->tiles[this->area.index( p )];
     }
+};
 
-    if( !d_map->is_in_limited_domain( from, from, route_settings ) ) {
-        // This should only fail if max f-limit is failed
-        return std::vector<tripoint_abs_ms>();
+auto read_window( const mapbuffer_abs_tile_reader &reader, const tile_area &bubble,
+                  const tile_area &area, int z ) -> tile_window
+{
+    tile_window window{ .area = area, .z = z };
+    window.tiles.resize( area.size() );
+    window.leave_costs.assign( area.size() * 2, NAN );
+    for( int y = 0; y < area.height; y++ ) {
+        for( int x = 0; x < area.width; x++ ) {
+            const point_abs_ms p = area.lo + point_rel_ms( x, y );
+            if( bubble.contains( p ) ) {
+                window.tiles[area.index( p )] = get_pathfinding_tile( reader, tripoint_abs_ms( p, z ) );
+            }
+        }
     }
+    return window;
+}
 
-    if( d_map->expand_2d_up_to( from, route_settings ) != ExpansionOutcome::PATH_FOUND ) {
-        return std::vector<tripoint_abs_ms>();
+// G-cost of leaving `p` of `window` when no vehicle is involved, INFINITY if we can't. `p` must have a tile.
+auto window_leave_cost( const step_cost_context &ctx, const tile_window &window,
+                        const point_abs_ms &p, bool is_diag ) -> float
+{
+    float &cached = window.leave_costs[window.area.index( p ) * 2 + ( is_diag ? 1 : 0 )];
+    if( is_nan( cached ) ) {
+        cached = step_g_cost( ctx, *window.tile( p ), tripoint_abs_ms( p, window.z ), nullptr, is_diag );
     }
+    return cached;
+}
 
-    const int chebyshev_distance = square_dist_fast(
-                                       tripoint_abs_ms( from, d_map->z ),
-                                       tripoint_abs_ms( d_map->dest, d_map->z ) );
-    const float max_s = route_settings.max_s_coeff * chebyshev_distance;
+// G-cost of stepping from `cur` into the adjacent `next`, INFINITY if we can't. Both are in `window`.
+auto window_step_cost( const step_cost_context &ctx, const tile_window &window,
+                       const point_abs_ms &cur, const point_abs_ms &next ) -> float
+{
+    const auto &cur_tile = window.tile( cur );
+    const auto &next_tile = window.tile( next );
+    if( !cur_tile || !next_tile ) {
+        return INFINITY;
+    }
 
-    std::vector<tripoint_abs_ms> result;
-    result.push_back( tripoint_abs_ms( from, d_map->z ) );
+    const tripoint_abs_ms cur_with_z( cur, window.z );
+    const tripoint_abs_ms next_with_z( next, window.z );
+    const vehicle *next_vehicle = next_tile->vehicle_ptr();
+    if( ( cur_tile->vehicle_ptr() != nullptr || next_vehicle != nullptr ) &&
+        !is_step_allowed( *cur_tile, cur_with_z, next_with_z, next_vehicle ) ) {
+        return INFINITY;
+    }
 
-    point_abs_ms cur_point = from;
-    float cur_cost = d_map->get_f_unbiased( cur_point );
+    const bool is_diag = cur.x() != next.x() && cur.y() != next.y();
+    if( cur_tile->vehicle_ptr() != nullptr ) {
+        // Vehicle doors care which vehicle we step into, so don't cache
+        return step_g_cost( ctx, *cur_tile, cur_with_z, next_vehicle, is_diag );
+    }
+    return window_leave_cost( ctx, window, cur, is_diag );
+}
+
+// Orthogonal and diagonal g-cost of leaving any tile of `area` [inside `window`], if they are all
+//   there, free of vehicles and cost the same. Creatures, traps and rough ground show up as a difference.
+//   The cheapest route between two tiles of such an area is then a straight one, as many diagonal steps
+//   as the shorter axis needs and orthogonal ones for the rest, which is what jump point search exploits.
+auto uniform_leave_costs( const step_cost_context &ctx, const tile_window &window,
+                          const tile_area &area ) -> std::optional<std::pair<float, float>>
+{
+    std::optional<std::pair<float, float>> uniform;
+    for( int y = 0; y < area.height; y++ ) {
+        for( int x = 0; x < area.width; x++ ) {
+            const point_abs_ms p = area.lo + point_rel_ms( x, y );
+            const auto &tile = window.tile( p );
+            if( !tile || tile->vehicle_ptr() != nullptr ) {
+                return std::nullopt;
+            }
+            const std::pair<float, float> costs( window_leave_cost( ctx, window, p, false ),
+                                                 window_leave_cost( ctx, window, p, true ) );
+            if( is_inf( costs.first ) || is_inf( costs.second ) || ( uniform && *uniform != costs ) ) {
+                return std::nullopt;
+            }
+            uniform = costs;
+        }
+    }
+    // Going around a diagonal step would have to be the cheaper way for the straight route not to be
+    if( !uniform || uniform->second > 2 * uniform->first ) {
+        return std::nullopt;
+    }
+    return uniform;
+}
+
+enum class search_direction {
+    FROM_SOURCE, // Cost of reaching each tile from the source
+    TO_SOURCE // Cost of reaching the source from each tile
+};
+
+// Dijkstra over `area` [inside `window`] only; INFINITY for tiles it can't reach.
+auto area_costs( const step_cost_context &ctx, const tile_window &window, const tile_area &area,
+                 const point_abs_ms &source, const search_direction direction ) -> std::vector<float>
+{
+    using Frontier = std::priority_queue<std::pair<float, point_abs_ms>,
+          std::vector<std::pair<float, point_abs_ms>>, pair_greater_cmp_first>;
+
+    std::vector<float> costs( area.size(), INFINITY );
+    if( const auto uniform = uniform_leave_costs( ctx, window, area ) ) {
+        // Open ground: no need to search it
+        count( counters.uniform_areas );
+        const auto [orthogonal, diagonal] = *uniform;
+        for( int y = 0; y < area.height; y++ ) {
+            for( int x = 0; x < area.width; x++ ) {
+                const point_abs_ms p = area.lo + point_rel_ms( x, y );
+                const int dx = std::abs( p.x() - source.x() );
+                const int dy = std::abs( p.y() - source.y() );
+                costs[area.index( p )] = diagonal * std::min( dx, dy ) + orthogonal * std::abs( dx - dy );
+            }
+        }
+        return costs;
+    }
 
-    while( cur_point != d_map->dest ) {
-        std::vector<std::pair<float, point_abs_ms>> candidates;
+    Frontier frontier;
+    costs[area.index( source )] = 0.0;
+    frontier.emplace( 0.0, source );
 
+    while( !frontier.empty() ) {
+        const auto [cost, p] = frontier.top();
+        frontier.pop();
+        if( cost > costs[area.index( p )] ) {
+            continue;
+        }
         for( const auto &dir : DIRS_2D ) {
-            const point_abs_ms next_point = cur_point + dir;
-            const bool is_in_bounds = d_map->in_bounds( next_point );
-            if( !is_in_bounds ) {
+            const point_abs_ms q = p + dir;
+            if( !area.contains( q ) ) {
                 continue;
             }
+            const float step = direction == search_direction::FROM_SOURCE ?
+                               window_step_cost( ctx, window, p, q ) :
+                               window_step_cost( ctx, window, q, p );
+            float &best = costs[area.index( q )];
+            if( !is_inf( step ) && cost + step < best ) {
+                best = cost + step;
+                frontier.emplace( best, q );
+            }
+        }
+    }
+    return costs;
+}
 
-            const float cost = d_map->get_f_unbiased( next_point );
+// Tiles of the reality bubble
+auto bubble_area( const map &here ) -> tile_area
+{
+    return tile_area{
+        .lo = project_to<coords::ms>( here.get_abs_sub() ),
+        .width = here.getmapsize() * SEEX,
+        .height = here.getmapsize() * SEEY };
+}
 
-            const bool is_accessible = d_map->tile_state_at( next_point ) ==
-                                       Pathfinding::State::ACCESSIBLE;
-            const bool is_not_forbidden = !d_map->forbidden_moves.contains( {cur_point, next_point} );
+} // namespace
+
+Pathfinding::PortalGraph &Pathfinding::get_portal_graph( const PathfindingSettings &settings,
+        int z )
+{
+    const PathfindingSettings key = portal_graph_settings( settings );
+    const int turn = to_turn<int>( calendar::turn );
 
-            const bool is_valid = is_accessible && is_not_forbidden;
-            if( !is_valid ) {
+    auto graph_it = std::ranges::find_if( Pathfinding::portal_graphs, [&key, z]( auto & graph ) {
+        return graph->z == z && graph->settings == key;
+    } );
+    if( graph_it == Pathfinding::portal_graphs.end() ) {
+        if( Pathfinding::portal_graphs.size() >= max_portal_graphs ) {
+            Pathfinding::portal_graphs.erase( std::ranges::min_element( Pathfinding::portal_graphs, {},
+            []( auto & graph ) {
+                return graph->last_used_turn;
+            } ) );
+        }
+        auto graph = std::make_unique<PortalGraph>();
+        graph->settings = key;
+        graph->z = z;
+        Pathfinding::portal_graphs.push_back( std::move( graph ) );
+        graph_it = std::prev( Pathfinding::portal_graphs.end() );
+    }
+    ( *graph_it )->last_used_turn = turn;
+    return **graph_it;
+}
+
+void Pathfinding::update_vehicle_submaps()
+{
+    const int turn = to_turn<int>( calendar::turn );
+    if( Pathfinding::vehicle_submaps_turn == turn ) {
+        return;
+    }
+
+    const map &here = get_map();
+    for( const int z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
+        auto &target = Pathfinding::vehicle_submaps[z + OVERMAP_DEPTH];
+        target.clear();
+        for( vehicle *veh : here.get_cache_ref( z ).vehicle_list ) {
+            for( const tripoint_abs_ms &p : veh->get_points() ) {
+                target.insert( project_to<coords::sm>( p.xy() ) );
+            }
+        }
+    }
+    Pathfinding::vehicle_submaps_turn = turn;
+}
+
+const Pathfinding::Cluster &Pathfinding::get_cluster( PortalGraph &graph,
+        const point_abs_sm &sm )
+{
+    static constexpr std::array<point_rel_sm, 5> cluster_and_neighbours = {
+        point_rel_sm::zero(), point_rel_sm::east(), point_rel_sm::south(),
+        point_rel_sm::west(), point_rel_sm::north(),
+    };
+
+    const map &here = get_map();
+    auto &buffer = MAPBUFFER_REGISTRY.get( here.get_bound_dimension() );
+    const int turn = to_turn<int>( calendar::turn );
+    const tile_area bubble = bubble_area( here );
+    const auto &vehicles_here = Pathfinding::vehicle_submaps[graph.z + OVERMAP_DEPTH];
+
+    std::array<std::uint64_t, 5> revisions = {};
+    bool near_vehicle = false;
+    for( std::size_t i = 0; i < cluster_and_neighbours.size(); i++ ) {
+        const point_abs_sm p = sm + cluster_and_neighbours[i];
+        if( !bubble.contains( project_to<coords::ms>( p ) ) ) {
+            continue;
+        }
+        const submap *const sub = buffer.lookup_submap_in_memory( tripoint_abs_sm( p, graph.z ) );
+        revisions[i] = sub != nullptr ? sub->pf_revision : 0;
+        near_vehicle |= vehicles_here.contains( p );
+    }
+
+    Cluster &cluster = graph.clusters[sm];
+    const bool is_current = cluster.built_turn == turn ||
+                            ( !cluster.near_vehicle && !near_vehicle );
+    if( cluster.built_turn >= 0 && cluster.revisions == revisions && is_current ) {
+        return cluster;
+    }
+
+    cluster = Cluster{ .revisions = revisions, .near_vehicle = near_vehicle, .built_turn = turn };
+
+    // Read a ring of tiles around the submap too, to see across its borders
+    const tile_area area = tile_area::of_submap( sm );
+    const tile_area ring = tile_area{
+        .lo = area.lo + point_rel_ms( -1, -1 ), .width = SEEX + 2, .height = SEEY + 2 };
+    const auto tile_reader = buffer.make_abs_tile_reader( pathfinding_lookup_options() );
+    const tile_window window = read_window( tile_reader, bubble, ring, graph.z );
+    const step_cost_context ctx{
+        .here = here, .buffer = buffer, .settings = graph.settings, .include_mobs = false };
+
+    const auto add_portal = [&]( const point_abs_ms & inside, const point_abs_ms & outside ) {
+        auto portal_it = std::ranges::find( cluster.portals, inside, &Portal::pos );
+        if( portal_it == cluster.portals.end() ) {
+            cluster.portals.push_back( Portal{ .pos = inside } );
+            portal_it = std::prev( cluster.portals.end() );
+        }
+        const float exit_cost = window_step_cost( ctx, window, inside, outside );
+        if( !is_inf( exit_cost ) ) {
+            portal_it->exits.emplace_back( outside, exit_cost );
+        }
+    };
+
+    // An entrance is a run of border tiles we can cross in either direction. Both submaps of a border
+    //   find the same runs, so their portals pair up.
+    for( const point_rel_sm &side : std::span( cluster_and_neighbours ).subspan( 1 ) ) {
+        const point_rel_ms out = point_rel_ms( side.x(), side.y() );
+        const point_rel_ms along = point_rel_ms( side.y() != 0 ? 1 : 0, side.x() != 0 ? 1 : 0 );
+        const point_abs_ms first = area.lo + point_rel_ms( side.x() > 0 ? SEEX - 1 : 0,
+                                   side.y() > 0 ? SEEY - 1 : 0 );
+        const int length = side.x() != 0 ? SEEY : SEEX;
+
+        const auto is_open = [&]( int i ) {
+            const point_abs_ms inside = first + along * i;
+            return !is_inf( window_step_cost( ctx, window, inside, inside + out ) ) ||
+                   !is_inf( window_step_cost( ctx, window, inside + out, inside ) );
+        };
+        for( int i = 0; i < length; i++ ) {
+            if( !is_open( i ) ) {
                 continue;
-            };
+            }
+            int run_end = i;
+            while( run_end + 1 < length && is_open( run_end + 1 ) ) {
+                run_end++;
+            }
+            if( run_end - i + 1 > max_single_portal_entrance ) {
+                add_portal( first + along * i, first + along * i + out );
+                add_portal( first + along * run_end, first + along * run_end + out );
+            } else {
+                const int mid = ( i + run_end ) / 2;
+                add_portal( first + along * mid, first + along * mid + out );
+            }
+            i = run_end;
+        }
+    }
 
-            if( cost < cur_cost ) {
-                candidates.emplace_back( cost, next_point );
+    const std::size_t count = cluster.portals.size();
+    cluster.costs.assign( count * count, INFINITY );
+    for( std::size_t from = 0; from < count; from++ ) {
+        const std::vector<float> costs = area_costs( ctx, window, area, cluster.portals[from].pos,
+                                         search_direction::FROM_SOURCE );
+        for( std::size_t to = 0; to < count; to++ ) {
+            cluster.costs[from * count + to] = costs[area.index( cluster.portals[to].pos )];
+        }
+    }
+    return cluster;
+}
+
+std::optional<std::vector<tripoint_abs_ms>> Pathfinding::get_route_hierarchical(
+            const point_abs_ms from, const point_abs_ms to, const int z,
+            const PathfindingSettings &path_settings,
+            const RouteSettings &route_settings )
+{
+    using Frontier = std::priority_queue<val_pair, std::vector<val_pair>, pair_greater_cmp_first>;
+
+    const point_abs_sm from_sm = project_to<coords::sm>( from );
+    const point_abs_sm to_sm = project_to<coords::sm>( to );
+    // Potential fields and relative search domains are per route, so leave those to the d_maps
+    if( square_dist( from_sm, to_sm ) < hierarchical_min_submaps ||
+        !path_settings.extra_g_costs.empty() || route_settings.is_relative_search_domain() ) {
+        return std::nullopt;
+    }
+
+    const map &here = get_map();
+    auto &buffer = MAPBUFFER_REGISTRY.get( here.get_bound_dimension() );
+    const auto tile_reader = buffer.make_abs_tile_reader( pathfinding_lookup_options() );
+    const tile_area bubble = bubble_area( here );
+    const step_cost_context ctx{ .here = here, .buffer = buffer, .settings = path_settings };
+
+    Pathfinding::update_vehicle_submaps();
+    PortalGraph &graph = Pathfinding::get_portal_graph( path_settings, z );
+
+    const tile_area from_area = tile_area::of_submap( from_sm );
+    const tile_area to_area = tile_area::of_submap( to_sm );
+    const tile_window from_window = read_window( tile_reader, bubble, from_area, z );
+    const tile_window to_window = read_window( tile_reader, bubble, to_area, z );
+    const std::vector<float> from_costs = area_costs( ctx, from_window, from_area, from,
+                                          search_direction::FROM_SOURCE );
+    const std::vector<float> to_costs = area_costs( ctx, to_window, to_area, to,
+                                        search_direction::TO_SOURCE );
+
+    const auto h = [&]( const point_abs_ms & p ) {
+        return route_settings.h_coeff * rl_dist_exact( tripoint_abs_ms( p, 0 ), tripoint_abs_ms( to, 0 ) );
+    };
+
+    // A* over portals; `from` and `to` join the graph through the costs above
+    std::unordered_map<point_abs_ms, float> best;
+    std::unordered_map<point_abs_ms, point_abs_ms> parents;
+    std::unordered_set<point_abs_ms> closed;
+    Frontier frontier;
+
+    const auto relax = [&]( const point_abs_ms & p, float cost,
+    const std::optional<point_abs_ms> &parent ) {
+        if( is_inf( cost ) || closed.contains( p ) ) {
+            return;
+        }
+        auto best_it = best.find( p );
+        if( best_it != best.end() && best_it->second <= cost ) {
+            return;
+        }
+        best.insert_or_assign( p, cost );
+        if( parent ) {
+            parents.insert_or_assign( p, *parent );
+        }
+        frontier.emplace( cost + h( p ), p );
+    };
+
+    for( const Portal &portal : get_cluster( graph, from_sm ).portals ) {
+        relax( portal.pos, from_costs[from_area.index( portal.pos )], std::nullopt );
+    }
+
+    float goal_cost = INFINITY;
+    std::optional<point_abs_ms> goal_parent;
+    while( !frontier.empty() ) {
+        const auto [f, p] = frontier.top();
+        frontier.pop();
+        if( f >= goal_cost ) {
+            break;
+        }
+        if( !closed.insert( p ).second ) {
+            continue;
+        }
+
+        const float cost = best.at( p );
+        const point_abs_sm sm = project_to<coords::sm>( p );
+        if( sm == to_sm && cost + to_costs[to_area.index( p )] < goal_cost ) {
+            goal_cost = cost + to_costs[to_area.index( p )];
+            goal_parent = p;
+        }
+
+        const Cluster &cluster = get_cluster( graph, sm );
+        const auto portal_it = std::ranges::find( cluster.portals, p, &Portal::pos );
+        if( portal_it == cluster.portals.end() ) {
+            continue;
+        }
+        const std::size_t count = cluster.portals.size();
+        const std::size_t index = portal_it - cluster.portals.begin();
+        for( std::size_t to_index = 0; to_index < count; to_index++ ) {
+            relax( cluster.portals[to_index].pos, cost + cluster.costs[index * count + to_index], p );
+        }
+        for( const auto &[exit, exit_cost] : portal_it->exits ) {
+            relax( exit, cost + exit_cost, p );
+        }
+    }
+
+    if( !goal_parent ) {
+        return std::nullopt;
+    }
+
+    // Could be NaN if max_f_coeff = INFINITY * 0
+    const float max_f = route_settings.max_f_coeff * (
+                            route_settings.f_limit_based_on_max_dist ?
+                            route_settings.max_dist :
+                            rl_dist_exact( tripoint_abs_ms( from, z ), tripoint_abs_ms( to, z ) ) );
+    if( !is_nan( max_f ) && goal_cost > max_f ) {
+        return std::nullopt;
+    }
+
+    std::vector<point_abs_ms> waypoints = { to };
+    for( std::optional<point_abs_ms> p = goal_parent; p; ) {
+        waypoints.push_back( *p );
+        const auto parent_it = parents.find( *p );
+        p = parent_it != parents.end() ? std::optional( parent_it->second ) : std::nullopt;
+    }
+    waypoints.push_back( from );
+    std::ranges::reverse( waypoints );
+
+    // Walk down the cost gradient towards each waypoint within its submap, like `get_route_2d` does
+    std::vector<tripoint_abs_ms> result;
+    result.push_back( tripoint_abs_ms( from, z ) );
+    for( std::size_t i = 0; i + 1 < waypoints.size(); i++ ) {
+        const point_abs_ms start = waypoints[i];
+        const point_abs_ms end = waypoints[i + 1];
+        if( start == end ) {
+            continue;
+        }
+        const point_abs_sm sm = project_to<coords::sm>( start );
+        if( sm != project_to<coords::sm>( end ) ) {
+            // A portal's exit into the next submap
+            result.push_back( tripoint_abs_ms( end, z ) );
+            continue;
+        }
+
+        const tile_area area = tile_area::of_submap( sm );
+        const tile_window window = read_window( tile_reader, bubble, area, z );
+        const std::vector<float> costs = area_costs( ctx, window, area, end,
+                                         search_direction::TO_SOURCE );
+        point_abs_ms cur_point = start;
+        float cur_cost = costs[area.index( cur_point )];
+        for( int steps = 0; cur_point != end; steps++ ) {
+            std::vector<std::pair<float, point_abs_ms>> candidates;
+            for( const auto &dir : DIRS_2D ) {
+                const point_abs_ms next_point = cur_point + dir;
+                if( !area.contains( next_point ) ) {
+                    continue;
+                }
+                const float cost = costs[area.index( next_point )];
+                if( cost < cur_cost && !is_inf( window_step_cost( ctx, window, cur_point, next_point ) ) ) {
+                    candidates.emplace_back( cost, next_point );
+                }
             }
+            if( candidates.empty() || steps > area.size() ) {
+                return std::nullopt;
+            }
+
+            std::ranges::sort( candidates, []( auto & p1, auto & p2 ) {
+                return p1.first < p2.first;
+            } );
+            const auto &selected_pair = candidates[route_settings.rank_weighted_rng( candidates.size() )];
+            cur_point = selected_pair.second;
+            cur_cost = selected_pair.first;
+            result.push_back( tripoint_abs_ms( cur_point, z ) );
+        }
+    }
+
+    const int chebyshev_distance = square_dist_fast( tripoint_abs_ms( from, z ), tripoint_abs_ms( to, z ) );
+    if( result.size() - 2 > route_settings.max_s_coeff * chebyshev_distance ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+Pathfinding &Pathfinding::get_d_map( point_abs_ms dest, int z,
+                                     const PathfindingSettings &settings )
+{
+    const point_abs_ms cur_origin = project_to<coords::ms>( get_map().get_abs_sub() );
+    auto d_map_it = std::ranges::find_if(
+                        Pathfinding::d_maps,
+    [&dest, &settings, z, &cur_origin]( auto & map ) {
+        return map->dest == dest && map->z == z && map->settings == settings &&
+               map->origin == cur_origin;
+    } );
+
+    Pathfinding::update_vehicle_submaps();
+    Pathfinding *d_map;
+    if( d_map_it == Pathfinding::d_maps.end() ) {
+        count( counters.d_maps_created );
+        turn_recorder::count( turn_recorder::counter::d_maps_built );
+        Pathfinding::produce_d_map( dest, z, settings );
+        d_map = Pathfinding::d_maps.back().get();
+    } else {
+        d_map = d_map_it->get();
+        count( d_map->repaired_turn == to_turn<int>( calendar::turn ) ? counters.d_maps_reused :
+               counters.d_maps_repaired );
+        // Kept from an earlier turn
+        d_map->repair();
+    }
+    d_map->last_used_turn = to_turn<int>( calendar::turn );
+    return *d_map;
+}
+
+void Pathfinding::downhill_candidates( const point_abs_ms &p, float cost,
+                                       std::vector<val_pair> &out )
+{
+    out.clear();
+    for( const auto &dir : DIRS_2D ) {
+        const point_abs_ms next_point = p + dir;
+        if( !this->in_bounds( next_point ) ) {
+            continue;
+        }
+
+        const bool is_accessible = this->tile_state_at( next_point ) == Pathfinding::State::ACCESSIBLE;
+        const bool is_not_forbidden = !this->forbidden_moves.contains( {p, next_point} );
+        if( !is_accessible || !is_not_forbidden ) {
+            continue;
         }
 
+        const float next_cost = this->get_f_unbiased( next_point );
+        if( next_cost < cost ) {
+            out.emplace_back( next_cost, next_point );
+        }
+    }
+
+    std::ranges::sort( out, []( auto & p1, auto & p2 ) {
+        return p1.first < p2.first;
+    } );
+}
+
+std::vector<tripoint_abs_ms> Pathfinding::walk_route( const point_abs_ms &from,
+        const RouteSettings &route_settings, int max_steps )
+{
+    if( !this->is_in_limited_domain( from, from, route_settings ) ) {
+        // This should only fail if max f-limit is failed
+        return std::vector<tripoint_abs_ms>();
+    }
+
+    if( this->expand_2d_up_to( from, route_settings ) != ExpansionOutcome::PATH_FOUND ) {
+        return std::vector<tripoint_abs_ms>();
+    }
+
+    const int chebyshev_distance = square_dist_fast(
+                                       tripoint_abs_ms( from, this->z ),
+                                       tripoint_abs_ms( this->dest, this->z ) );
+    const float max_s = route_settings.max_s_coeff * chebyshev_distance;
+
+    std::vector<tripoint_abs_ms> result;
+    result.push_back( tripoint_abs_ms( from, this->z ) );
+
+    point_abs_ms cur_point = from;
+    float cur_cost = this->get_f_unbiased( cur_point );
+    std::vector<val_pair> candidates;
+
+    while( cur_point != this->dest && static_cast<int>( result.size() ) <= max_steps ) {
+        this->downhill_candidates( cur_point, cur_cost, candidates );
+
         // This should not be likely to happen, but...
         if( candidates.empty() ) {
             // Maybe instead of looking at directly adjacent points,
@@ -970,18 +1951,12 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_2d(
             return result;
         }
 
-        std::ranges::sort( candidates, []( auto & p1, auto & p2 ) {
-            return p1.first < p2.first;
-        } );
-
         const auto selected_pair = &candidates[route_settings.rank_weighted_rng( candidates.size() )];
 
-        result.push_back( tripoint_abs_ms( selected_pair->second, d_map->z ) );
+        result.push_back( tripoint_abs_ms( selected_pair->second, this->z ) );
         cur_point = selected_pair->second;
         cur_cost = selected_pair->first;
 
-        candidates.clear();
-
         // Path is too long in terms of steps taken
         if( result.size() - 2 > max_s ) {
             result.clear();
@@ -992,10 +1967,29 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_2d(
     return result;
 }
 
-std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
-    const tripoint_abs_ms from, const tripoint_abs_ms to,
+std::vector<tripoint_abs_ms> Pathfinding::get_route_2d(
+    const point_abs_ms from, const point_abs_ms to, const int z,
     const PathfindingSettings path_settings,
     const RouteSettings route_settings )
+{
+    if( from == to ) {
+        return std::vector<tripoint_abs_ms> { tripoint_abs_ms( from, z ), tripoint_abs_ms( to, z ) };
+    }
+
+    if( hierarchical_pathfinding ) {
+        auto hierarchical_route = Pathfinding::get_route_hierarchical( from, to, z, path_settings,
+                                  route_settings );
+        if( hierarchical_route ) {
+            return std::move( *hierarchical_route );
+        }
+    }
+
+    return Pathfinding::get_d_map( to, z, path_settings ).walk_route( from, route_settings );
+}
+
+std::optional<std::vector<Pathfinding::ZLevelChange>> Pathfinding::get_z_path(
+            const tripoint_abs_ms &from, const tripoint_abs_ms &to,
+            const PathfindingSettings &path_settings )
 {
     // We won't bother with complicated Z-level paths because that vastly, vastly increases the pathfinding cost
     // Instead, we will **only** consider taking z_changes that bring us closer to target's Z level.
@@ -1067,7 +2061,7 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
 
                 // Open air processing
                 if( path_settings.can_fly ) {
-                    std::unordered_map<point_abs_ms, ZLevelChangeOpenAirPair> &target =
+                    cata::flat_hash_map<point_abs_ms, ZLevelChangeOpenAirPair> &target =
                         Pathfinding::get_z_cache_open_air( cur_origin.z() );
 
                     // There's a rare case where no valid non-open-air way exists to this Z-level
@@ -1113,7 +2107,7 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
                 if( is_inf( best_distance ) ) {
                     // No trivial Z path exists, give up
                     debugmsg_of( DL::Debug, "Failed to find a trivial path across z-levels" );
-                    return std::vector<tripoint_abs_ms>();
+                    return std::nullopt;
                 }
 
                 Pathfinding::cached_closest_z_changes.insert_or_assign( cache_pair, best_z_change );
@@ -1124,7 +2118,7 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
             constexpr auto unreasonable_z_hops = 1000;
             if( z_path.size() > unreasonable_z_hops ) {
                 debugmsg( "Failed to find a path with less than %d z-level changes", unreasonable_z_hops );
-                return std::vector<tripoint_abs_ms>();
+                return std::nullopt;
             }
 
             cur_origin = best_z_change.from;
@@ -1132,52 +2126,73 @@ std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
         }
     }
 
-    std::unordered_set<tripoint_abs_ms> ramp_excluded;
-    std::vector<tripoint_abs_ms> result;
-    // Now try to construct path
-    {
-        point_abs_ms cur_pos = from.xy();
-        while( !z_path.empty() ) {
-            const Pathfinding::ZLevelChange next = z_path.back();
-
-            const std::vector<tripoint_abs_ms> path_segment = Pathfinding::get_route_2d(
-                        cur_pos, next.from.xy(), next.from.z(),
-                        path_settings, route_settings );
-            if( path_segment.empty() ) {
-                // Give up early based on our inability to path to that z-change
-                result.clear();
-                return result;
-            }
+    return z_path;
+}
 
-            result.insert( result.end(), path_segment.begin(), path_segment.end() );
-            // Ramps are special in that we do not step on the last tile unless we're flying
-            const bool is_ramp_like = !path_settings.can_fly &&
-                                      next.type == Pathfinding::ZLevelChange::Type::RAMP;
-            if( is_ramp_like ) {
-                ramp_excluded.insert( next.from );
-            }
-            cur_pos = next.to.xy();
-            z_path.pop_back();
-        }
+std::vector<Pathfinding::RouteLeg> Pathfinding::get_route_legs( const tripoint_abs_ms &from,
+        const tripoint_abs_ms &to, const std::vector<ZLevelChange> &z_path )
+{
+    std::vector<RouteLeg> legs;
+    legs.reserve( z_path.size() + 1 );
+    point_abs_ms cur_pos = from.xy();
+    for( const ZLevelChange &next : z_path | std::views::reverse ) {
+        legs.push_back( { .from = cur_pos, .to = next.from.xy(), .z = next.from.z() } );
+        cur_pos = next.to.xy();
+    }
+    // We arrived to final Z level
+    legs.push_back( { .from = cur_pos, .to = to.xy(), .z = to.z() } );
+    return legs;
+}
 
-        // We arrived to final Z level
-        const std::vector<tripoint_abs_ms> final_segment = Pathfinding::get_route_2d(
-                    cur_pos, to.xy(), to.z(),
-                    path_settings, route_settings );
-        if( final_segment.empty() ) {
-            result.clear();
-            return result;
+std::vector<tripoint_abs_ms> Pathfinding::join_route_legs(
+    const std::vector<std::vector<tripoint_abs_ms>> &leg_routes,
+    const std::vector<ZLevelChange> &z_path, const PathfindingSettings &path_settings )
+{
+    std::vector<tripoint_abs_ms> result;
+    for( const auto &leg_route : leg_routes ) {
+        if( leg_route.empty() ) {
+            return std::vector<tripoint_abs_ms>();
         }
-        result.insert( result.end(), final_segment.begin(), final_segment.end() );
+        result.insert( result.end(), leg_route.begin(), leg_route.end() );
+    }
 
-        // Finally, remove ramp tiles
-        std::erase_if( result, [&ramp_excluded]( const tripoint_abs_ms & p ) {
-            return ramp_excluded.contains( p );
-        } );
+    // Ramps are special in that we do not step on the last tile unless we're flying
+    std::unordered_set<tripoint_abs_ms> ramp_excluded;
+    for( const ZLevelChange &z_change : z_path ) {
+        const bool is_ramp_like = !path_settings.can_fly &&
+                                  z_change.type == Pathfinding::ZLevelChange::Type::RAMP;
+        if( is_ramp_like ) {
+            ramp_excluded.insert( z_change.from );
+        }
     }
+    std::erase_if( result, [&ramp_excluded]( const tripoint_abs_ms & p ) {
+        return ramp_excluded.contains( p );
+    } );
     return result;
 }
 
+std::vector<tripoint_abs_ms> Pathfinding::get_route_3d(
+    const tripoint_abs_ms from, const tripoint_abs_ms to,
+    const PathfindingSettings path_settings,
+    const RouteSettings route_settings )
+{
+    const auto z_path = Pathfinding::get_z_path( from, to, path_settings );
+    if( !z_path ) {
+        return std::vector<tripoint_abs_ms>();
+    }
+
+    std::vector<std::vector<tripoint_abs_ms>> leg_routes;
+    for( const RouteLeg &leg : Pathfinding::get_route_legs( from, to, *z_path ) ) {
+        leg_routes.push_back( Pathfinding::get_route_2d( leg.from, leg.to, leg.z,
+                              path_settings, route_settings ) );
+        if( leg_routes.back().empty() ) {
+            // Give up early based on our inability to path to that z-change
+            return std::vector<tripoint_abs_ms>();
+        }
+    }
+    return Pathfinding::join_route_legs( leg_routes, *z_path, path_settings );
+}
+
 std::vector<tripoint_abs_ms> Pathfinding::route(
     tripoint_abs_ms from, tripoint_abs_ms to,
     const std::optional<PathfindingSettings> maybe_path_settings,
@@ -1225,3 +2240,192 @@ std::vector<tripoint_bub_ms> Pathfinding::route(
     }
     return result;
 }
+
+std::vector<std::vector<tripoint_abs_ms>> Pathfinding::route_batch(
+    std::span<const RouteRequest> requests )
+{
+    const map &here = get_map();
+
+    // A request split into legs as `get_route_3d` would, with what we found for each
+    struct batch_route {
+        bool valid = false;
+        bool as_flow_field = false;
+        PathfindingSettings path_settings;
+        RouteSettings route_settings;
+        std::vector<ZLevelChange> z_path;
+        std::vector<RouteLeg> legs;
+        std::vector<std::vector<tripoint_abs_ms>> leg_routes;
+    };
+    // A leg left to search for on its d_map
+    struct batch_walk {
+        Pathfinding *d_map;
+        std::size_t route;
+        std::size_t leg;
+    };
+
+    std::vector<batch_route> routes( requests.size() );
+    std::vector<batch_walk> walks;
+    for( std::size_t i = 0; i < requests.size(); i++ ) {
+        const RouteRequest &request = requests[i];
+        batch_route &r = routes[i];
+        const bool same_z = request.from.z() == request.to.z();
+        r.as_flow_field = request.next_step_only && same_z;
+        r.path_settings = request.next_step_only ?
+                          Pathfinding::flow_field_settings( request.path_settings ) :
+                          request.path_settings;
+        r.route_settings = r.as_flow_field ?
+                           Pathfinding::flow_field_route_settings( request.route_settings ) :
+                           request.route_settings;
+
+        if( rl_dist_exact( request.from.raw(), request.to.raw() ) > request.route_settings.max_dist ) {
+            continue;
+        }
+        if( !here.inbounds( abs_to_map_local( here, request.from ) ) ||
+            !here.inbounds( abs_to_map_local( here, request.to ) ) ) {
+            continue;
+        }
+
+        if( same_z ) {
+            r.legs.push_back( { .from = request.from.xy(), .to = request.to.xy(), .z = request.to.z() } );
+        } else {
+            auto z_path = Pathfinding::get_z_path( request.from, request.to, r.path_settings );
+            if( !z_path ) {
+                continue;
+            }
+            r.legs = Pathfinding::get_route_legs( request.from, request.to, *z_path );
+            r.z_path = std::move( *z_path );
+        }
+        r.valid = true;
+        r.leg_routes.resize( r.legs.size() );
+
+        for( std::size_t j = 0; j < r.legs.size(); j++ ) {
+            const RouteLeg &leg = r.legs[j];
+            if( leg.from == leg.to ) {
+                r.leg_routes[j] = { tripoint_abs_ms( leg.from, leg.z ), tripoint_abs_ms( leg.to, leg.z ) };
+                continue;
+            }
+            // Portal graphs are shared by every settings class, so these stay on this thread
+            if( hierarchical_pathfinding && !r.as_flow_field ) {
+                auto hierarchical_route = Pathfinding::get_route_hierarchical( leg.from, leg.to, leg.z,
+                                          r.path_settings, r.route_settings );
+                if( hierarchical_route ) {
+                    r.leg_routes[j] = std::move( *hierarchical_route );
+                    continue;
+                }
+            }
+            walks.push_back( {
+                .d_map = &Pathfinding::get_d_map( leg.to, leg.z, r.path_settings ),
+                .route = i,
+                .leg = j,
+            } );
+        }
+    }
+
+    // Walks on one d_map go in request order; each d_map is a job of its own
+    std::ranges::stable_sort( walks, {}, &batch_walk::d_map );
+    std::vector<std::span<const batch_walk>> jobs;
+    for( auto it = walks.begin(); it != walks.end(); ) {
+        const auto job_end = std::find_if( it, walks.end(), [d_map = it->d_map]( const batch_walk & w ) {
+            return w.d_map != d_map;
+        } );
+        jobs.emplace_back( it, job_end );
+        it = job_end;
+    }
+    const auto run_job = [&routes, &jobs]( int job ) {
+        for( const batch_walk &walk : jobs[job] ) {
+            batch_route &r = routes[walk.route];
+            r.leg_routes[walk.leg] = walk.d_map->walk_route( r.legs[walk.leg].from, r.route_settings,
+                                     r.as_flow_field ? 1 : INT_MAX );
+        }
+    };
+    if( jobs.size() > 1 && parallel_enabled && parallel_pathfinding && !is_pool_worker_thread() ) {
+        parallel_for( "route_batch", 0, static_cast<int>( jobs.size() ), run_job );
+    } else {
+        for( int job = 0; job < static_cast<int>( jobs.size() ); job++ ) {
+            run_job( job );
+        }
+    }
+
+    std::vector<std::vector<tripoint_abs_ms>> results( requests.size() );
+    for( std::size_t i = 0; i < requests.size(); i++ ) {
+        batch_route &r = routes[i];
+        if( !r.valid ) {
+            continue;
+        }
+        results[i] = r.legs.size() == 1 ?
+                     std::move( r.leg_routes.front() ) :
+                     Pathfinding::join_route_legs( r.leg_routes, r.z_path, r.path_settings );
+
+        const tripoint_abs_ms &from = requests[i].from;
+        if( requests[i].next_step_only && results[i].size() > 2 ) {
+            const auto step = std::ranges::find_if( results[i], [&from]( const tripoint_abs_ms & p ) {
+                return p != from;
+            } );
+            results[i] = { from, step != results[i].end() ? *step : from };
+        }
+    }
+    return results;
+}
+
+PathfindingSettings Pathfinding::flow_field_settings( const PathfindingSettings &settings )
+{
+    PathfindingSettings result = settings;
+    // Monsters price moves at 1 / speed; anything slower than a bucket keeps its own
+    const float speed = 1.0f / settings.move_cost_coeff;
+    if( speed >= flow_field_speed_bucket && !is_inf( speed ) ) {
+        result.move_cost_coeff = 1.0f / ( std::round( speed / flow_field_speed_bucket ) *
+                                          flow_field_speed_bucket );
+    }
+    return result;
+}
+
+RouteSettings Pathfinding::flow_field_route_settings( const RouteSettings &route_settings )
+{
+    // The field is plain Dijkstra from the destination. Bias towards one agent or limits relative to it
+    //   would have the next agent's lookup rebuild it.
+    RouteSettings result = route_settings;
+    result.h_coeff = 0.0;
+    result.search_radius_coeff = INFINITY;
+    result.search_cone_angle = 180.0;
+    if( !result.f_limit_based_on_max_dist ) {
+        result.max_f_coeff = INFINITY;
+    }
+    return result;
+}
+
+std::optional<tripoint_abs_ms> Pathfinding::next_step(
+    tripoint_abs_ms from, tripoint_abs_ms to,
+    const std::optional<PathfindingSettings> maybe_path_settings,
+    const std::optional<RouteSettings> maybe_route_settings )
+{
+    const RouteRequest request = {
+        .from = from,
+        .to = to,
+        .path_settings = maybe_path_settings.has_value() ? *maybe_path_settings : PathfindingSettings(),
+        .route_settings = maybe_route_settings.has_value() ? *maybe_route_settings : RouteSettings(),
+        .next_step_only = true,
+    };
+    const auto step_route = Pathfinding::route_batch( std::span( &request, 1 ) ).front();
+    if( step_route.empty() ) {
+        return std::nullopt;
+    }
+    return step_route.back();
+}
+
+std::optional<tripoint_bub_ms> Pathfinding::next_step(
+    tripoint_bub_ms from, tripoint_bub_ms to,
+    const std::optional<PathfindingSettings> maybe_path_settings,
+    const std::optional<RouteSettings> maybe_route_settings )
+{
+    const map &here = get_map();
+
+    here.clip_to_bounds( from );
+    here.clip_to_bounds( to );
+
+    const auto abs_step = Pathfinding::next_step( bub_to_abs( from ), bub_to_abs( to ),
+                          maybe_path_settings, maybe_route_settings );
+    if( !abs_step ) {
+        return std::nullopt;
+    }
+    return abs_to_bub( *abs_step );
+}
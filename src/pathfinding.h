@@ -1,16 +1,24 @@
 #pragma once
 
 #include <array>
+#include <chrono>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <map>
 #include <memory>
 #include <optional>
 #include <set>
+#include <span>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "coordinates.h"
+#include "flat_hash_map.h"
 #include "game_constants.h"
 #include "point.h"
 #include "rng.h"
@@ -61,7 +69,7 @@ struct PathfindingSettings {
     bool can_climb_stairs = false;
 
     // A map of tiles that have an extra G-cost assigned to them. Used for potential fields, preclosed tiles, etc.
-    std::unordered_map<point_abs_ms, float> extra_g_costs;
+    cata::flat_hash_map<point_abs_ms, float> extra_g_costs;
 
     bool operator==( const PathfindingSettings &rhs ) const = default;
     int z_move_type() const;
@@ -172,6 +180,37 @@ struct RouteSettings {
     constexpr bool is_relative_search_domain() const;
 };
 
+// One route wanted from `Pathfinding::route_batch`
+struct RouteRequest {
+    tripoint_abs_ms from;
+    tripoint_abs_ms to;
+    PathfindingSettings path_settings;
+    RouteSettings route_settings;
+    // Only the first step, as `Pathfinding::next_step` would take it; the route is then `from` and that step
+    bool next_step_only = false;
+};
+
+// Counters of pathfinding work, for tuning how `PathfindingSettings` are quantized into d_map classes
+struct PathfindingStats {
+    // `get_d_map` found no map for a settings class and started one
+    std::uint64_t d_maps_created = 0;
+    // ...found one already used this turn
+    std::uint64_t d_maps_reused = 0;
+    // ...found one kept from an earlier turn and repaired it
+    std::uint64_t d_maps_repaired = 0;
+    // Calls of the expansion loop, the tiles they took off the frontier and the time they took
+    std::uint64_t expansions = 0;
+    std::uint64_t tiles_expanded = 0;
+    std::chrono::nanoseconds expansion_time{};
+    // Expansions by how they ended: path found, target inaccessible, path not found, no path exists
+    std::array<std::uint64_t, 4> outcomes = {};
+    std::uint64_t z_cache_rebuilds = 0;
+    // Submap searches of the portal graph answered in closed form, the area being open ground
+    std::uint64_t uniform_areas = 0;
+
+    PathfindingStats operator-( const PathfindingStats &rhs ) const;
+};
+
 class Pathfinding
 {
     private:
@@ -212,6 +251,12 @@ class Pathfinding
             std::optional<ZLevelChange> reach_from_below;
             std::optional<ZLevelChange> reach_from_above;
         };
+        // The part of a route on one z-level
+        struct RouteLeg {
+            point_abs_ms from;
+            point_abs_ms to;
+            int z;
+        };
 
         // Global state: allocated dijikstra d_maps. Pull to `d_maps` from here.
         static std::vector<std::unique_ptr<Pathfinding>> d_maps_store;
@@ -227,11 +272,44 @@ class Pathfinding
         // Global state: Z-level transitions for each z-level (does not include OPEN_AIR due to being numerous, requiring a different approach)
         static std::array<std::vector<ZLevelChange>, OVERMAP_LAYERS> z_caches;
         // Global state: OPEN_AIR type z-level transitions for each z-level
-        static std::array<std::unordered_map<point_abs_ms, ZLevelChangeOpenAirPair>, OVERMAP_LAYERS>
+        static std::array<cata::flat_hash_map<point_abs_ms, ZLevelChangeOpenAirPair>, OVERMAP_LAYERS>
         z_caches_open_air;
         // Global state: We cache `z_path` information taken to prevent multiple iterations for the same target
         static std::map<std::tuple<bool, int, tripoint_abs_ms>, ZLevelChange> cached_closest_z_changes;
 
+        // A tile where paths cross from one submap of a portal graph into the next
+        struct Portal {
+            point_abs_ms pos;
+            // Tiles of neighbouring submaps we can step into from `pos`, and the g-cost of doing so
+            std::vector<std::pair<point_abs_ms, float>> exits;
+        };
+        // One submap of a portal graph: its portals and the cheapest cost between each two of them
+        //   without leaving the submap
+        struct Cluster {
+            // `pf_revision` of the submap and its four neighbours [0 outside the reality bubble] when built
+            std::array<std::uint64_t, 5> revisions = {};
+            // A vehicle was in one of those submaps, so this only holds for the turn it was built in
+            bool near_vehicle = false;
+            int built_turn = -1;
+            std::vector<Portal> portals;
+            // Flat, [from * portals.size() + to]
+            std::vector<float> costs;
+        };
+        // Abstraction of one z-level for one class of settings, built a submap at a time as routes cross it.
+        //   Unlike d_maps these are kept between turns; submap revisions tell which parts went stale.
+        struct PortalGraph {
+            PathfindingSettings settings;
+            int z = 0;
+            int last_used_turn = 0;
+            std::unordered_map<point_abs_sm, Cluster> clusters;
+        };
+
+        // Global state: portal graphs of recently used settings classes
+        static std::vector<std::unique_ptr<PortalGraph>> portal_graphs;
+        // Global state: submaps on each z-level a vehicle part stood in on `vehicle_submaps_turn`
+        static std::array<std::unordered_set<point_abs_sm>, OVERMAP_LAYERS> vehicle_submaps;
+        static int vehicle_submaps_turn;
+
         // Runtime map dimensions (default MAPSIZE_X / MAPSIZE_Y; updated when bubble size changes)
         int map_x_;
         int map_y_;
@@ -270,6 +348,20 @@ class Pathfinding
         // Moves we don't allow to happen
         std::set<std::pair<point_abs_ms, point_abs_ms>> forbidden_moves;
 
+        // What a submap looked like when we first expanded into it
+        struct ExploredSubmap {
+            // Its `pf_revision`; 0 if we haven't expanded into it yet
+            std::uint64_t revision = 0;
+            bool had_vehicle = false;
+        };
+        // Flat, one per submap of the reality bubble from `origin`
+        std::vector<ExploredSubmap> explored_submaps;
+        // Tiles whose g-value includes `mob_presence_penalty`
+        std::vector<point_abs_ms> mob_tiles;
+        // Turn we last routed over this map, and turn it was last checked for changes
+        int last_used_turn = -1;
+        int repaired_turn = -1;
+
         // Possibly shift or move all Z-changes if our `z_area` moved
         //   and scan for new changes.
         // Only process OPEN_AIR changes if `update_open_air` is true. OPEN_AIR tiles are numerous on higher Z levels
@@ -278,10 +370,18 @@ class Pathfinding
 
         // Get a reference to ZCache for this level
         static std::vector<ZLevelChange> &get_z_cache( const int z );
-        static std::unordered_map<point_abs_ms, ZLevelChangeOpenAirPair> &get_z_cache_open_air(
+        static cata::flat_hash_map<point_abs_ms, ZLevelChangeOpenAirPair> &get_z_cache_open_air(
             const int z );
 
         static void produce_d_map( point_abs_ms dest, int z, PathfindingSettings settings );
+        // Find the d_map towards `dest` for `settings`, repaired for this turn, or start a new one
+        static Pathfinding &get_d_map( point_abs_ms dest, int z, const PathfindingSettings &settings );
+
+        // Find or make the portal graph `settings` share on level `z`
+        static PortalGraph &get_portal_graph( const PathfindingSettings &settings, int z );
+        // Get the portals of submap `sm`, rebuilding them if its terrain or a neighbour's changed
+        static const Cluster &get_cluster( PortalGraph &graph, const point_abs_sm &sm );
+        static void update_vehicle_submaps();
 
         // Get `p`-value at `p`
         float &p_at( const point_abs_ms &p );
@@ -294,9 +394,19 @@ class Pathfinding
 
         void reset_maps();
         void reset_tile_state();
+        // Forget everything, ready to go back to `d_maps_store`
+        void reset_all();
+        // Remember the state of the submap `p` is in if we haven't expanded there before
+        void note_explored( const point_abs_ms &p );
+        // Once per turn, forget the part of the map that terrain, vehicle or creature changes
+        //   since it was explored could have affected, LPA*-style: everything costlier than the cheapest
+        //   changed tile. The rest is kept and expansion resumes from its edge.
+        void repair();
         point_rel_ms map_pos_offset( const point_abs_ms &p ) const;
         State &tile_state_at( const point_abs_ms &p );
         bool in_bounds( const point_abs_ms &p );
+        // Fill `out` with the accessible neighbours of `p` we may step to whose f is below `cost`, cheapest first
+        void downhill_candidates( const point_abs_ms &p, float cost, std::vector<val_pair> &out );
 
         // Determine if `start` is surrounded by already visited tiles in `d_map` or tiles allowed by `route_settings`
         //   and if so, clear and fill `out` with all unexplored tiles left.
@@ -313,6 +423,23 @@ class Pathfinding
             const point_abs_ms from, const point_abs_ms to, const int z,
             const PathfindingSettings path_settings,
             const RouteSettings route_settings );
+        // See `Pathfinding::route`. Plans over the portal graph, then walks down to tiles one submap at a time.
+        //   Empty if routes this short or these settings don't use it or the abstraction finds nothing;
+        //   `get_route_2d` searches the full-resolution d_map then.
+        static std::optional<std::vector<tripoint_abs_ms>> get_route_hierarchical(
+                    const point_abs_ms from, const point_abs_ms to, const int z,
+                    const PathfindingSettings &path_settings,
+                    const RouteSettings &route_settings );
+        // Z-level changes a route from `from` to `to` takes, last one first. Empty if there's no way between the levels.
+        static std::optional<std::vector<ZLevelChange>> get_z_path( const tripoint_abs_ms &from,
+                const tripoint_abs_ms &to, const PathfindingSettings &path_settings );
+        // Split a route across `z_path` into one leg per z-level, first one first
+        static std::vector<RouteLeg> get_route_legs( const tripoint_abs_ms &from,
+                const tripoint_abs_ms &to, const std::vector<ZLevelChange> &z_path );
+        // Join the routes of `get_route_legs`, dropping ramp tiles non-fliers don't step on. Empty if any leg is.
+        static std::vector<tripoint_abs_ms> join_route_legs(
+            const std::vector<std::vector<tripoint_abs_ms>> &leg_routes,
+            const std::vector<ZLevelChange> &z_path, const PathfindingSettings &path_settings );
         // See `Pathfinding::route`
         static std::vector<tripoint_abs_ms> get_route_3d(
             const tripoint_abs_ms from, const tripoint_abs_ms to,
@@ -322,6 +449,13 @@ class Pathfinding
 
         // Continue expanding the dijikstra map until we reach `origin` or nothing remains of the frontier. Returns whether a route is present.
         ExpansionOutcome expand_2d_up_to( const point_abs_ms &start, const RouteSettings &route_settings );
+        // Expand up to `from` and walk down to `dest`, at most `max_steps` steps. Empty if there's no route.
+        // Touches only this map and reads the world, so different maps may do this on different threads at once;
+        //   everything shared between maps is set up by `get_d_map` beforehand.
+        std::vector<tripoint_abs_ms> walk_route( const point_abs_ms &from,
+                const RouteSettings &route_settings, int max_steps = INT_MAX );
+        // `route_settings` of a flow field: no bias towards or limits relative to any one agent
+        static RouteSettings flow_field_route_settings( const RouteSettings &route_settings );
     public:
         // Allocates flat arrays for a map of size mx × my.
         explicit Pathfinding( int mx, int my );
@@ -335,10 +469,34 @@ class Pathfinding
                 const std::optional<PathfindingSettings> path_settings = std::nullopt,
                 const std::optional<RouteSettings> route_settings = std::nullopt );
 
+        // Flow field lookup: the tile after `from` on a route to `to`, picked among the cheaper
+        //   neighbours by `alpha` just as `route` would, without walking the rest of the route.
+        // Agents heading to one `to` with one `flow_field_settings` class share a single Dijkstra map,
+        //   expanded no further than the farthest of them, so each lookup after the first is O(1).
+        // Routes across z-levels are planned in full and their second tile returned. Empty if there's no route.
+        static std::optional<tripoint_abs_ms> next_step( tripoint_abs_ms from, tripoint_abs_ms to,
+                const std::optional<PathfindingSettings> path_settings = std::nullopt,
+                const std::optional<RouteSettings> route_settings = std::nullopt );
+        static std::optional<tripoint_bub_ms> next_step( tripoint_bub_ms from, tripoint_bub_ms to,
+                const std::optional<PathfindingSettings> path_settings = std::nullopt,
+                const std::optional<RouteSettings> route_settings = std::nullopt );
+        // `route` or `next_step` of each request, solved together. Legs towards one destination share a
+        //   d_map and run in turn; different d_maps are searched on the thread pool at once.
+        // Portal graphs, z-level caches and the d_maps themselves are set up on the calling thread first.
+        static std::vector<std::vector<tripoint_abs_ms>> route_batch( std::span<const RouteRequest> requests );
+
+        // Settings class of `next_step`: `settings` with `move_cost_coeff` rounded to a speed bucket,
+        //   so monsters of nearly the same speed share their flow fields
+        static PathfindingSettings flow_field_settings( const PathfindingSettings &settings );
+
         // Reset whole pathfinding pretty much
         static void clear_d_maps();
 
-        // Drain active d-maps back to the store, then destroy the pool.
+        // Release d-maps not used this turn and keep the others for the next, where they're repaired
+        //   instead of explored anew. Same as `clear_d_maps` with PERSISTENT_PATHFINDING off.
+        static void end_turn();
+
+        // Drain active d-maps back to the store, then destroy the pool and the portal graphs.
         // Call when the reality-bubble size changes so that stale Pathfinding
         // objects sized for the old g_mapsize_x/y are not reused.
         static void clear_pool();
@@ -346,4 +504,17 @@ class Pathfinding
         // Reset Z-level information. Should only be done when new Z-level changes could have appeared
         //   such as change in terrain
         static void mark_dirty_z_cache();
+
+        // Counters since startup, and their deltas over the last turn `end_turn` closed
+        static PathfindingStats stats();
+        static const PathfindingStats &last_turn_stats();
+        // Both of the above as a table for the debug menu
+        static std::string describe_stats();
+        // d_maps in use and in the store, and roughly how many bytes their arrays hold
+        static std::pair<std::size_t, std::size_t> memory_usage();
+
+        // While on, `end_turn` counts how many d_maps used that turn explored each tile, for the debug overlay
+        static void set_collect_explored_heat( bool collect );
+        // d_maps of the last turn that explored `p`
+        static int explored_heat_at( const tripoint_abs_ms &p );
 };
@@ -84,15 +84,23 @@ float get_animation_phase( int phase_length_ms )
 //later, the main texture is drawn to the display buffer
 //the surface is needed to determine the color format needed by the texture
 SDL_Texture_Ptr create_cache_texture( const SDL_Renderer_Ptr &renderer, int tile_width,
-                                      int tile_height )
+                                      int tile_height,
+                                      SDL_TextureAccess access = SDL_TEXTUREACCESS_TARGET )
 {
     return CreateTexture( renderer,
                           SDL_PIXELFORMAT_ARGB8888,
-                          SDL_TEXTUREACCESS_TARGET,
+                          access,
                           tile_width,
                           tile_height );
 }
 
+// Pixel value of @p color in SDL_PIXELFORMAT_ARGB8888.
+Uint32 pack_argb( const SDL_Color &color )
+{
+    return ( static_cast<Uint32>( color.a ) << 24 ) | ( static_cast<Uint32>( color.r ) << 16 ) |
+           ( static_cast<Uint32>( color.g ) << 8 ) | static_cast<Uint32>( color.b );
+}
+
 SDL_Color get_map_color_at( const tripoint_bub_ms &p )
 {
     const auto &here = get_map();
@@ -134,85 +142,22 @@ SDL_Color get_critter_color( Creature *critter, int flicker, int mixture )
 
 } // namespace
 
-// a texture pool to avoid recreating textures every time player changes their view
-// at most 142 out of 144 textures can be in use due to regular player movement
-//  (moving from submap corner to new corner) with MAPSIZE = 11
-// textures are dumped when the player moves more than one submap in one update
-//  (teleporting, z-level change) to prevent running out of the remaining pool
-class pixel_minimap::shared_texture_pool
-{
-    public:
-        shared_texture_pool( const std::function<SDL_Texture_Ptr()> &generator, const int mapsize ) {
-            const size_t pool_size = static_cast<size_t>( mapsize + 1 ) * ( mapsize + 1 );
-
-            texture_pool.reserve( pool_size );
-            inactive_index.reserve( pool_size );
-
-            for( size_t i = 0; i < pool_size; ++i ) {
-                texture_pool.emplace_back( generator() );
-                inactive_index.push_back( i );
-            }
-        }
-
-        //reserves a texture from the inactive group and returns tracking info
-        SDL_Texture_Ptr request_tex( size_t &index ) {
-            index = invalid_texture_index;
-            if( inactive_index.empty() ) {
-                debugmsg( "Ran out of available textures in the pool." );
-                //shouldn't be happening, but minimap will just be default color instead of crashing
-                return nullptr;
-            }
-            index = inactive_index.back();
-            inactive_index.pop_back();
-            return std::move( texture_pool[index] );
-        }
-
-        //releases the provided texture back into the inactive pool to be used again
-        //called automatically in the submap cache destructor
-        void release_tex( size_t index, SDL_Texture_Ptr &&ptr ) {
-            if( index == invalid_texture_index || index >= texture_pool.size() || !ptr ) {
-                return;
-            }
-            inactive_index.push_back( index );
-            texture_pool[index] = std::move( ptr );
-        }
-
-    private:
-        static constexpr auto invalid_texture_index = std::numeric_limits<size_t>::max();
-        std::vector<SDL_Texture_Ptr> texture_pool;
-        std::vector<size_t> inactive_index;
-};
-
 struct pixel_minimap::submap_cache {
     //the color stored for each submap tile
     std::array<SDL_Color, SEEX *SEEY> minimap_colors = {};
+    //the submap held by this slot, if any
+    std::optional<tripoint_abs_sm> pos;
     //checks if the submap has been looked at by the minimap routine
-    bool touched;
-    //the texture updates are drawn to
+    bool touched = false;
+    //the texture the submap is uploaded to
     SDL_Texture_Ptr chunk_tex;
-    //the submap being handled
-    size_t texture_index;
+    //the pixels of chunk_tex, so that only what changed needs uploading
+    std::vector<Uint32> pixels;
     //the list of updates to apply to the texture
-    //reduces render target switching to once per submap
+    //reduces texture uploads to once per submap
     std::vector<point_sm_ms> update_list;
     //flag used to indicate that the texture needs to be cleared before first use
-    bool ready;
-    shared_texture_pool &pool;
-
-    //reserve the SEEX * SEEY submap tiles
-    submap_cache( shared_texture_pool &pool ) :
-        touched( false ),
-        ready( false ),
-        pool( pool ) {
-        chunk_tex = pool.request_tex( texture_index );
-    }
-
-    //handle the release of the borrowed texture
-    ~submap_cache() {
-        pool.release_tex( texture_index, std::move( chunk_tex ) );
-    }
-
-    submap_cache( submap_cache && ) = default;
+    bool ready = false;
 
     SDL_Color &color_at( point_sm_ms p ) {
         return minimap_colors[p.y() * SEEX + p.x()];
@@ -254,10 +199,13 @@ void pixel_minimap::prepare_cache_for_updates( const tripoint_bub_ms &center )
         std::abs( center_sm_diff.x() ) > 1 ||
         std::abs( center_sm_diff.y() ) > 1 ||
         std::abs( center_sm_diff.z() ) > 0 ) {
-        cache.clear();
+        std::ranges::for_each( cache, []( submap_cache & slot ) {
+            slot.pos.reset();
+            slot.touched = false;
+        } );
     } else {
-        std::ranges::for_each( cache, []( auto & mcp ) {
-            mcp.second.touched = false;
+        std::ranges::for_each( cache, []( submap_cache & slot ) {
+            slot.touched = false;
         } );
     }
 
@@ -265,57 +213,52 @@ void pixel_minimap::prepare_cache_for_updates( const tripoint_bub_ms &center )
     cached_dimension_id = new_dimension_id;
 }
 
-//deletes the mapping of unused submap caches from the main map
-//the touched flag prevents deletion
-void pixel_minimap::clear_unused_cache()
-{
-    for( auto it = cache.begin(); it != cache.end(); ) {
-        it = it->second.touched ? std::next( it ) : cache.erase( it );
-    }
-}
-
-//draws individual updates to the submap cache texture
-//the render target will be set back to display_buffer after all submaps are updated
+//writes individual updates to the pixels of each submap and uploads the rows they touched
 void pixel_minimap::flush_cache_updates()
 {
-    std::ranges::for_each( cache, [&]( auto & mcp ) {
-        if( mcp.second.update_list.empty() ) {
+    std::ranges::for_each( cache, [&]( submap_cache & slot ) {
+        if( slot.update_list.empty() ) {
             return;
         }
-        if( !mcp.second.chunk_tex ) {
-            mcp.second.update_list.clear();
+        if( !slot.chunk_tex ) {
+            slot.update_list.clear();
             return;
         }
 
-        SetRenderTarget( renderer, mcp.second.chunk_tex );
-
-        if( !mcp.second.ready ) {
-            mcp.second.ready = true;
-
-            SetRenderDrawColor( renderer, 0x00, 0x00, 0x00, 0x00 );
-            RenderClear( renderer );
-
-            for( const auto p : submap_tiles() ) {
-                const auto tile_pos = projector->get_tile_pos( p.raw(), { SEEX, SEEY } );
-                const auto tile_size = projector->get_tile_size();
-
-                geometry->rect( renderer, tile_pos, tile_size.x, tile_size.y, SDL_Color() );
+        // Bounds of the pixels written, as [min, max)
+        point dirty_min( chunk_size.x, chunk_size.y );
+        point dirty_max( 0, 0 );
+        const auto fill = [&]( const point pos, const point size, const Uint32 value ) {
+            const point lo( std::max( pos.x, 0 ), std::max( pos.y, 0 ) );
+            const point hi( std::min( pos.x + size.x, chunk_size.x ),
+                            std::min( pos.y + size.y, chunk_size.y ) );
+            for( int y = lo.y; y < hi.y; ++y ) {
+                std::fill_n( slot.pixels.begin() + y * chunk_size.x + lo.x, std::max( hi.x - lo.x, 0 ), value );
             }
+            dirty_min = point( std::min( dirty_min.x, lo.x ), std::min( dirty_min.y, lo.y ) );
+            dirty_max = point( std::max( dirty_max.x, hi.x ), std::max( dirty_max.y, hi.y ) );
+        };
+
+        if( !slot.ready ) {
+            slot.ready = true;
+            fill( point_zero, chunk_size, 0 );
         }
 
-        std::ranges::for_each( mcp.second.update_list, [&]( const auto p ) {
+        std::ranges::for_each( slot.update_list, [&]( const auto p ) {
             const auto tile_pos = projector->get_tile_pos( p.raw(), { SEEX, SEEY } );
-            const auto tile_color = mcp.second.color_at( p );
-
-            if( pixel_size.x == 1 && pixel_size.y == 1 ) {
-                SetRenderDrawColor( renderer, tile_color.r, tile_color.g, tile_color.b, tile_color.a );
-                RenderDrawPoint( renderer, tile_pos );
-            } else {
-                geometry->rect( renderer, tile_pos, pixel_size.x, pixel_size.y, tile_color );
-            }
+            const auto size = pixel_size.x == 1 && pixel_size.y == 1 ? point_south_east : pixel_size;
+            fill( tile_pos, size, pack_argb( slot.color_at( p ) ) );
         } );
+        slot.update_list.clear();
 
-        mcp.second.update_list.clear();
+        if( dirty_min.x >= dirty_max.x || dirty_min.y >= dirty_max.y ) {
+            return;
+        }
+        const SDL_Rect dirty{ dirty_min.x, dirty_min.y, dirty_max.x - dirty_min.x, dirty_max.y - dirty_min.y };
+        const Uint32 *const first = slot.pixels.data() + dirty.y * chunk_size.x + dirty.x;
+        printErrorIf( !SDL_UpdateTexture( slot.chunk_tex.get(), &dirty, first,
+                                          chunk_size.x * static_cast<int>( sizeof( Uint32 ) ) ),
+                      "SDL_UpdateTexture failed" );
     } );
 }
 
@@ -366,13 +309,18 @@ void pixel_minimap::update_cache_at( const tripoint_bub_sm &pos )
 
 pixel_minimap::submap_cache &pixel_minimap::get_cache_at( const tripoint_abs_sm &abs_sm_pos )
 {
-    auto it = cache.find( abs_sm_pos );
-
-    if( it == cache.end() ) {
-        it = cache.emplace( abs_sm_pos, *tex_pool ).first;
+    auto &slot = cache[modulo( abs_sm_pos.y(), cache_side ) * cache_side +
+                       modulo( abs_sm_pos.x(), cache_side )];
+
+    if( slot.pos != abs_sm_pos ) {
+        // The slot held a submap that scrolled out of view; start over.
+        slot.pos = abs_sm_pos;
+        slot.minimap_colors = {};
+        slot.update_list.clear();
+        slot.ready = false;
     }
 
-    return it->second;
+    return slot;
 }
 
 void pixel_minimap::process_cache( const tripoint_bub_ms &center )
@@ -390,13 +338,12 @@ void pixel_minimap::process_cache( const tripoint_bub_ms &center )
     }
 
     flush_cache_updates();
-    clear_unused_cache();
 }
 
 void pixel_minimap::set_screen_rect( const SDL_Rect &screen_rect )
 {
     const auto current_mapsize = get_map().getmapsize();
-    if( this->screen_rect == screen_rect && main_tex && tex_pool && projector
+    if( this->screen_rect == screen_rect && main_tex && !cache.empty() && projector
         && built_view_tiles_count == view_tiles_count && built_mapsize == current_mapsize ) {
         return;
     }
@@ -435,17 +382,18 @@ void pixel_minimap::set_screen_rect( const SDL_Rect &screen_rect )
         main_tex = create_cache_texture( renderer, size_on_screen.x, size_on_screen.y );
     }
 
-    cache.clear();
-
-    const point chunk_size = projector->get_tiles_size( { SEEX, SEEY } );
+    chunk_size = projector->get_tiles_size( { SEEX, SEEY } );
 
-    const auto chunk_texture_generator = [&chunk_size, this]() {
-        SDL_Texture_Ptr result = create_cache_texture( renderer, chunk_size.x, chunk_size.y );
-        SetTextureBlendMode( result, SDL_BLENDMODE_BLEND );
-        return result;
-    };
+    cache_side = current_mapsize;
+    cache.clear();
+    cache.resize( static_cast<size_t>( cache_side ) * cache_side );
+    for( submap_cache &slot : cache ) {
+        slot.chunk_tex = create_cache_texture( renderer, chunk_size.x, chunk_size.y,
+                                               SDL_TEXTUREACCESS_STREAMING );
+        SetTextureBlendMode( slot.chunk_tex, SDL_BLENDMODE_BLEND );
+        slot.pixels.assign( static_cast<size_t>( chunk_size.x ) * chunk_size.y, 0 );
+    }
 
-    tex_pool = std::make_unique<shared_texture_pool>( chunk_texture_generator, current_mapsize );
     built_view_tiles_count = view_tiles_count;
     built_mapsize = current_mapsize;
 }
@@ -454,8 +402,8 @@ void pixel_minimap::reset()
 {
     projector.reset();
     cache.clear();
+    cache_side = 0;
     main_tex.reset();
-    tex_pool.reset();
     built_mapsize = 0;
 }
 
@@ -492,16 +440,16 @@ void pixel_minimap::render_cache( const tripoint_bub_ms &center )
                                          view_tiles_count.y / 2 - sm_offset.y() * SEEY -
                                          center_remainder.y() );
 
-    std::ranges::for_each( cache, [&]( const auto & elem ) {
-        if( !elem.second.touched ) {
+    std::ranges::for_each( cache, [&]( const submap_cache & slot ) {
+        if( !slot.touched || !slot.pos ) {
             return;
         }
 
-        if( !elem.second.chunk_tex ) {
+        if( !slot.chunk_tex ) {
             return;
         }
 
-        const tripoint_rel_sm rel_pos = elem.first - sm_center;
+        const tripoint_rel_sm rel_pos = *slot.pos - sm_center;
 
         if( std::abs( rel_pos.x() ) > sm_offset.x() + 1 ||
             std::abs( rel_pos.y() ) > sm_offset.y() + 1 ||
@@ -516,7 +464,7 @@ void pixel_minimap::render_cache( const tripoint_bub_ms &center )
 
         const SDL_FRect fchunk{ float( chunk_rect.x ), float( chunk_rect.y ),
                                 float( chunk_rect.w ), float( chunk_rect.h ) };
-        RenderCopy( renderer, elem.second.chunk_tex, nullptr, &fchunk );
+        RenderCopy( renderer, slot.chunk_tex, nullptr, &fchunk );
     } );
 }
 
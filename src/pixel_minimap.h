@@ -1,8 +1,8 @@
 #pragma once
 
-#include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "coordinates.h"
 #include "sdl_wrappers.h"
@@ -58,7 +58,6 @@ class pixel_minimap
         void flush_cache_updates();
         void update_cache_at( const tripoint_bub_sm &pos );
         void prepare_cache_for_updates( const tripoint_bub_ms &center );
-        void clear_unused_cache();
 
         void render( const tripoint_bub_ms &center );
         void render_cache( const tripoint_bub_ms &center );
@@ -90,9 +89,11 @@ class pixel_minimap
         std::unique_ptr<pixel_minimap_projector> projector;
         int built_mapsize = 0;
 
-        //the minimap texture pool which is used to reduce new texture allocation spam
-        class shared_texture_pool;
-        std::unique_ptr<shared_texture_pool> tex_pool;
-
-        std::map<tripoint_abs_sm, submap_cache> cache;
+        // One slot per submap of the reality bubble, addressed by absolute submap
+        // position modulo the bubble size, so submaps keep their slot while the
+        // bubble shifts and only the ones scrolling into view are rebuilt.
+        std::vector<submap_cache> cache;
+        int cache_side = 0;
+        // Size in pixels of the texture of one submap.
+        point chunk_size;
 };
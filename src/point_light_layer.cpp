@@ -0,0 +1,228 @@
+#include "point_light_layer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <tuple>
+#include <utility>
+
+#include "lightmap.h"
+#include "shadowcasting.h"
+
+namespace
+{
+
+using source = point_light_layer::source;
+
+/** Tiles from (x0, y0) to (x1, y1), both included. */
+struct tile_box {
+    int x0 = 0;
+    int y0 = 0;
+    int x1 = -1;
+    int y1 = -1;
+};
+
+auto key_of( const source &s )
+{
+    return std::tuple( s.p.x, s.p.y, s.luminance, s.octants );
+}
+
+auto pack( const diagonal_blocks &b ) -> std::uint8_t
+{
+    return static_cast<std::uint8_t>( ( b.nw ? 1 : 0 ) | ( b.ne ? 2 : 0 ) );
+}
+
+auto box_of( const source &s, const point_light_layer::level_inputs &level ) -> tile_box
+{
+    const auto r = point_light_layer::reach( s.luminance, level.max_view_distance );
+    return {
+        std::max( 0, s.p.x - r ), std::max( 0, s.p.y - r ),
+        std::min( level.shape.sx - 1, s.p.x + r ), std::min( level.shape.sy - 1, s.p.y + r )
+    };
+}
+
+// Summed-area tables are (sx + 1) x (sy + 1), column by column, with a zero first row
+// and column, whatever the layout of the level arrays.
+auto sum_at( std::vector<int> &sums, const int sy, const int x, const int y ) -> int &
+{
+    return sums[x * ( sy + 1 ) + y];
+}
+
+auto sum_at( const std::vector<int> &sums, const int sy, const int x, const int y ) -> int
+{
+    return sums[x * ( sy + 1 ) + y];
+}
+
+auto sum_in( const std::vector<int> &sums, const int sy, const tile_box &b ) -> int
+{
+    if( b.x1 < b.x0 || b.y1 < b.y0 ) {
+        return 0;
+    }
+    return sum_at( sums, sy, b.x1 + 1, b.y1 + 1 ) - sum_at( sums, sy, b.x0, b.y1 + 1 ) -
+           sum_at( sums, sy, b.x1 + 1, b.y0 ) + sum_at( sums, sy, b.x0, b.y0 );
+}
+
+template<typename F>
+auto build_sums( std::vector<int> &sums, const int sx, const int sy, F &&value ) -> void
+{
+    sums.assign( static_cast<std::size_t>( sx + 1 ) * ( sy + 1 ), 0 );
+    for( int x = 0; x < sx; ++x ) {
+        for( int y = 0; y < sy; ++y ) {
+            sum_at( sums, sy, x + 1, y + 1 ) = value( x, y ) + sum_at( sums, sy, x, y + 1 ) +
+                                               sum_at( sums, sy, x + 1, y ) - sum_at( sums, sy, x, y );
+        }
+    }
+}
+
+} // namespace
+
+auto point_light_layer::reach( const float luminance, const int max_view_distance ) -> int
+{
+    const auto rows = static_cast<int>( std::ceil( luminance / LIGHT_AMBIENT_LOW ) ) + 1;
+    return std::clamp( rows, 0, max_view_distance );
+}
+
+auto point_light_layer::update( std::vector<source> sources, const level_inputs &level,
+                                const cast_fn &cast ) -> const std::vector<float> &
+{
+    std::ranges::sort( sources, {}, key_of );
+    next_sources_ = std::move( sources );
+    stats_ = {};
+
+    const auto cells = static_cast<std::size_t>( level.shape.sx ) * level.shape.sy;
+    const auto same_level = valid_ && layer_.size() == cells &&
+                            shape_.sx == level.shape.sx && shape_.sy == level.shape.sy &&
+                            shape_.origin == level.shape.origin &&
+                            weather_transparency_ == level.weather_transparency &&
+                            max_view_distance_ == level.max_view_distance &&
+                            trig_dist_ == level.trig_dist;
+    if( same_level ) {
+        update_changed( level, cast );
+    } else {
+        rebuild( level, cast );
+    }
+    snapshot( level );
+    std::swap( sources_, next_sources_ );
+    valid_ = true;
+    return layer_;
+}
+
+auto point_light_layer::rebuild( const level_inputs &level, const cast_fn &cast ) -> void
+{
+    const auto cells = static_cast<std::size_t>( level.shape.sx ) * level.shape.sy;
+    layer_.assign( cells, 0.0f );
+    if( !next_sources_.empty() ) {
+        cast( next_sources_, layer_.data() );
+    }
+    stats_ = { .rebuilt = true, .cast = next_sources_.size(), .dirty_tiles = cells };
+}
+
+auto point_light_layer::update_changed( const level_inputs &level, const cast_fn &cast ) -> void
+{
+    const auto sx = level.shape.sx;
+    const auto sy = level.shape.sy;
+    const auto cells = static_cast<std::size_t>( sx ) * sy;
+    const auto index = [&]( const int x, const int y ) {
+        return cache_layout::index( x, y, level.shape );
+    };
+
+    auto any_changed = false;
+    build_sums( changed_sums_, sx, sy, [&]( const int x, const int y ) {
+        const auto i = index( x, y );
+        const auto changed = transparency_[i] != level.transparency[i] ||
+                             blocked_[i] != pack( level.blocked[i] );
+        any_changed = any_changed || changed;
+        return changed ? 1 : 0;
+    } );
+
+    // Dirty boxes go into a difference table first, so each one costs four writes.
+    stamps_.assign( static_cast<std::size_t>( sx + 1 ) * ( sy + 1 ), 0 );
+    auto stamped = false;
+    const auto stamp = [&]( const source & s ) {
+        const auto b = box_of( s, level );
+        if( b.x1 < b.x0 || b.y1 < b.y0 ) {
+            return;
+        }
+        ++sum_at( stamps_, sy, b.x0, b.y0 );
+        --sum_at( stamps_, sy, b.x1 + 1, b.y0 );
+        --sum_at( stamps_, sy, b.x0, b.y1 + 1 );
+        ++sum_at( stamps_, sy, b.x1 + 1, b.y1 + 1 );
+        stamped = true;
+    };
+
+    // Both lists are sorted by key_of, so one walk finds what appeared and went away.
+    auto old_it = sources_.begin();
+    auto new_it = next_sources_.begin();
+    while( old_it != sources_.end() || new_it != next_sources_.end() ) {
+        if( new_it == next_sources_.end() ||
+            ( old_it != sources_.end() && key_of( *old_it ) < key_of( *new_it ) ) ) {
+            stamp( *old_it++ );
+        } else if( old_it == sources_.end() || key_of( *new_it ) < key_of( *old_it ) ) {
+            stamp( *new_it++ );
+        } else {
+            if( any_changed && sum_in( changed_sums_, sy, box_of( *new_it, level ) ) > 0 ) {
+                stamp( *new_it );
+            }
+            ++old_it;
+            ++new_it;
+        }
+    }
+    if( !stamped ) {
+        return;
+    }
+
+    for( int x = 0; x < sx; ++x ) {
+        for( int y = 0; y < sy; ++y ) {
+            sum_at( stamps_, sy, x, y ) += ( x > 0 ? sum_at( stamps_, sy, x - 1, y ) : 0 ) +
+                                           ( y > 0 ? sum_at( stamps_, sy, x, y - 1 ) : 0 ) -
+                                           ( x > 0 && y > 0 ? sum_at( stamps_, sy, x - 1, y - 1 ) : 0 );
+        }
+    }
+    const auto dirty = [&]( const int x, const int y ) {
+        return sum_at( stamps_, sy, x, y ) > 0;
+    };
+    auto dirty_tiles = std::size_t{ 0 };
+    build_sums( dirty_sums_, sx, sy, [&]( const int x, const int y ) {
+        const auto d = dirty( x, y );
+        dirty_tiles += d ? 1 : 0;
+        return d ? 1 : 0;
+    } );
+    // Past half the level, keeping the clean part saves less than the bookkeeping costs.
+    if( dirty_tiles * 2 > cells ) {
+        rebuild( level, cast );
+        return;
+    }
+
+    to_cast_.clear();
+    for( const auto &s : next_sources_ ) {
+        if( sum_in( dirty_sums_, sy, box_of( s, level ) ) > 0 ) {
+            to_cast_.push_back( s );
+        }
+    }
+    cast_.assign( cells, 0.0f );
+    if( !to_cast_.empty() ) {
+        cast( to_cast_, cast_.data() );
+    }
+    for( int x = 0; x < sx; ++x ) {
+        for( int y = 0; y < sy; ++y ) {
+            if( dirty( x, y ) ) {
+                const auto i = index( x, y );
+                layer_[i] = cast_[i];
+            }
+        }
+    }
+    stats_ = { .rebuilt = false, .cast = to_cast_.size(), .dirty_tiles = dirty_tiles };
+}
+
+auto point_light_layer::snapshot( const level_inputs &level ) -> void
+{
+    const auto cells = static_cast<std::size_t>( level.shape.sx ) * level.shape.sy;
+    transparency_.assign( level.transparency, level.transparency + cells );
+    blocked_.resize( cells );
+    for( std::size_t i = 0; i < cells; ++i ) {
+        blocked_[i] = pack( level.blocked[i] );
+    }
+    shape_ = level.shape;
+    weather_transparency_ = level.weather_transparency;
+    max_view_distance_ = level.max_view_distance;
+    trig_dist_ = level.trig_dist;
+}
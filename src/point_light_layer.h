@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "cache_layout.h"
+#include "point.h"
+
+struct diagonal_blocks;
+
+/**
+ * What the buffered point lights of one z-level (fires, lava, lamps, glowing items)
+ * add to its lightmap, kept from one lightmap build to the next so that only the part
+ * that changed is cast again.
+ *
+ * Sources are compared with those of the previous update and the level's transparency
+ * with a copy taken then.  A source that appeared, went away, moved or changed
+ * brightness or octants, or whose reach holds a tile whose transparency changed, marks
+ * every tile it reaches as dirty.  Only the sources reaching a dirty tile are cast again,
+ * and only the dirty tiles take their new value; the rest of the layer is kept.  Since
+ * light combines by max, the layer is the same as casting every source from scratch.
+ */
+class point_light_layer
+{
+    public:
+        struct source {
+            point p;
+            float luminance = 0.0f;
+            /// Octants to cast, as for castLightOctants.
+            std::uint8_t octants = 0;
+
+            auto operator==( const source & ) const -> bool = default;
+        };
+
+        /** What casting a source depends on apart from the source itself. */
+        struct level_inputs {
+            const float *transparency = nullptr;
+            const diagonal_blocks *blocked = nullptr;
+            cache_layout::grid_shape shape;
+            float weather_transparency = 0.0f;
+            int max_view_distance = 0;
+            bool trig_dist = false;
+        };
+
+        /** Casts @p sources into the zeroed grid @p out, combining with max. */
+        using cast_fn = std::function<void( std::span<const source> sources, float *out )>;
+
+        struct update_stats {
+            bool rebuilt = false;
+            std::size_t cast = 0;
+            std::size_t dirty_tiles = 0;
+        };
+
+        /** Brings the layer up to date with @p sources on @p level and returns it. */
+        auto update( std::vector<source> sources, const level_inputs &level,
+                     const cast_fn &cast ) -> const std::vector<float> &;
+
+        /** Forces the next update to cast every source. */
+        auto invalidate() -> void {
+            valid_ = false;
+        }
+
+        auto last_update() const -> const update_stats & {
+            return stats_;
+        }
+
+        /**
+         * Chebyshev distance past which a point light of @p luminance leaves no light.
+         * The shadowcaster divides by at least the row it is on and only enters a row
+         * while the one before was brighter than LIGHT_AMBIENT_LOW.
+         */
+        static auto reach( float luminance, int max_view_distance ) -> int;
+
+    private:
+        auto rebuild( const level_inputs &level, const cast_fn &cast ) -> void;
+        auto update_changed( const level_inputs &level, const cast_fn &cast ) -> void;
+        auto snapshot( const level_inputs &level ) -> void;
+
+        std::vector<float> layer_;
+        std::vector<source> sources_;
+        std::vector<source> next_sources_;
+
+        // Inputs of the last update, to tell what changed.
+        std::vector<float> transparency_;
+        std::vector<std::uint8_t> blocked_;
+        cache_layout::grid_shape shape_;
+        float weather_transparency_ = 0.0f;
+        int max_view_distance_ = 0;
+        bool trig_dist_ = false;
+        bool valid_ = false;
+
+        // Scratch kept between updates for its allocation.
+        std::vector<float> cast_;
+        std::vector<int> changed_sums_;
+        std::vector<int> stamps_;
+        std::vector<int> dirty_sums_;
+        std::vector<source> to_cast_;
+
+        update_stats stats_;
+};
@@ -1,6 +1,7 @@
 #include <queue>
 
 #include "enums.h"
+#include "flat_hash_map.h"
 #include "game.h"
 #include "line.h"
 #include "map.h"
@@ -59,8 +60,8 @@ void execute_shaped_attack( const shape &sh, const projectile &proj, Creature &a
     };
     const auto &origin = tripoint_bub_ms( sh.get_origin() );
     std::priority_queue<tripoint_distance> queue;
-    std::map<tripoint_bub_ms, aoe_flood_node> open;
-    std::set<tripoint_bub_ms> closed;
+    cata::flat_hash_map<tripoint_bub_ms, aoe_flood_node> open;
+    cata::flat_hash_set<tripoint_bub_ms> closed;
 
     for( const tripoint_bub_ms &child : here.points_in_radius( origin, 1 ) ) {
         double coverage = sigdist_to_coverage( sh.distance_at( child.raw() ) );
@@ -76,10 +77,9 @@ void execute_shaped_attack( const shape &sh, const projectile &proj, Creature &a
     while( !queue.empty() ) {
         auto p = queue.top().p;
         queue.pop();
-        if( closed.contains( p ) || !here.inbounds( p ) ) {
+        if( !here.inbounds( p ) || !closed.insert( p ).second ) {
             continue;
         }
-        closed.insert( p );
         double parent_coverage = open.at( p ).parent_coverage;
         if( parent_coverage <= 0.0 ) {
             continue;
@@ -115,10 +115,13 @@ void execute_shaped_attack( const shape &sh, const projectile &proj, Creature &a
         if( current_coverage > 0.0 ) {
             for( const tripoint_bub_ms &child : here.points_in_radius( p, 1 ) ) {
                 double coverage = sigdist_to_coverage( sh.distance_at( child.raw() ) );
-                if( coverage > 0.0 && !get_map().obstructed_by_vehicle_rotation( p, child ) &&
-                    !closed.contains( child ) &&
-                    ( !open.contains( child ) || open.at( child ).parent_coverage < current_coverage ) ) {
-                    open[child] = aoe_flood_node( p, current_coverage );
+                if( coverage <= 0.0 || closed.contains( child ) ||
+                    get_map().obstructed_by_vehicle_rotation( p, child ) ) {
+                    continue;
+                }
+                const auto [it, inserted] = open.try_emplace( child, p, current_coverage );
+                if( inserted || it->second.parent_coverage < current_coverage ) {
+                    it->second = aoe_flood_node( p, current_coverage );
                     queue.emplace( child, trig_dist_squared( origin, child ) );
                 }
             }
@@ -163,8 +166,8 @@ std::map<tripoint_bub_ms, double> expected_coverage( const shape &sh, const map
     };
     const auto &origin = tripoint_bub_ms( sh.get_origin() );
     std::priority_queue<tripoint_distance> queue;
-    std::map<tripoint_bub_ms, aoe_flood_node> open;
-    std::set<tripoint_bub_ms> closed;
+    cata::flat_hash_map<tripoint_bub_ms, aoe_flood_node> open;
+    cata::flat_hash_set<tripoint_bub_ms> closed;
 
     for( const tripoint_bub_ms &child : here.points_in_radius( origin, 1 ) ) {
         double coverage = sigdist_to_coverage( sh.distance_at( child.raw() ) );
@@ -180,10 +183,9 @@ std::map<tripoint_bub_ms, double> expected_coverage( const shape &sh, const map
     while( !queue.empty() ) {
         auto p = queue.top().p;
         queue.pop();
-        if( closed.contains( p ) ) {
+        if( !closed.insert( p ).second ) {
             continue;
         }
-        closed.insert( p );
         double parent_coverage = open.at( p ).parent_coverage;
         if( parent_coverage <= 0.0 ) {
             continue;
@@ -214,10 +216,13 @@ std::map<tripoint_bub_ms, double> expected_coverage( const shape &sh, const map
         if( current_coverage > 0.0 ) {
             for( const tripoint_bub_ms &child : here.points_in_radius( p, 1 ) ) {
                 double coverage = sigdist_to_coverage( sh.distance_at( child.raw() ) );
-                if( coverage > 0.0 && !get_map().obstructed_by_vehicle_rotation( p, child ) &&
-                    !closed.contains( child ) &&
-                    ( !open.contains( child ) || open.at( child ).parent_coverage < current_coverage ) ) {
-                    open[child] = aoe_flood_node( p, current_coverage );
+                if( coverage <= 0.0 || closed.contains( child ) ||
+                    get_map().obstructed_by_vehicle_rotation( p, child ) ) {
+                    continue;
+                }
+                const auto [it, inserted] = open.try_emplace( child, p, current_coverage );
+                if( inserted || it->second.parent_coverage < current_coverage ) {
+                    it->second = aoe_flood_node( p, current_coverage );
                     queue.emplace( child, trig_dist_squared( origin, child ) );
                 }
             }
@@ -424,6 +424,63 @@ void recipe_dictionary::finalize_internal( std::map<recipe_id, recipe> &obj )
     } );
 }
 
+const std::vector<const recipe *> &recipe_dictionary::recipes_using( const itype_id &id ) const
+{
+    static const std::vector<const recipe *> null_match;
+    const auto iter = item_users.find( id );
+    return iter != item_users.end() ? iter->second : null_match;
+}
+
+const std::vector<const recipe *> &recipe_dictionary::recipes_using( const quality_id &id ) const
+{
+    static const std::vector<const recipe *> null_match;
+    const auto iter = quality_users.find( id );
+    return iter != quality_users.end() ? iter->second : null_match;
+}
+
+void recipe_dictionary::find_requirement_users()
+{
+    item_users.clear();
+    quality_users.clear();
+    charge_users.clear();
+    for( const auto &[id, r] : recipes ) {
+        std::unordered_set<itype_id> items;
+        std::unordered_set<quality_id> qualities;
+        bool uses_charges = false;
+        const auto add_requirements = [&]( const requirement_data & req ) {
+            for( const std::vector<item_comp> &comps : req.get_components() ) {
+                for( const item_comp &comp : comps ) {
+                    items.insert( comp.type );
+                }
+            }
+            for( const std::vector<tool_comp> &tools : req.get_tools() ) {
+                for( const tool_comp &tool : tools ) {
+                    items.insert( tool.type );
+                    uses_charges |= tool.count > 0;
+                }
+            }
+            for( const std::vector<quality_requirement> &quals : req.get_qualities() ) {
+                for( const quality_requirement &qual : quals ) {
+                    qualities.insert( qual.type );
+                }
+            }
+        };
+        add_requirements( r.simple_requirements() );
+        for( const requirement_data &alt : r.deduped_requirements().alternatives() ) {
+            add_requirements( alt );
+        }
+        for( const itype_id &item : items ) {
+            item_users[item].push_back( &r );
+        }
+        for( const quality_id &qual : qualities ) {
+            quality_users[qual].push_back( &r );
+        }
+        if( uses_charges ) {
+            charge_users.push_back( &r );
+        }
+    }
+}
+
 void recipe_dictionary::find_items_on_loops()
 {
     // Check for infinite recipe loops in food (which are problematic for
@@ -530,6 +587,8 @@ void recipe_dictionary::finalize()
     }
 
     recipe_dict.find_items_on_loops();
+    recipe_dict.find_requirement_users();
+    ++recipe_dict.version_;
 }
 
 void recipe_dictionary::reset()
@@ -540,6 +599,10 @@ void recipe_dictionary::reset()
     recipe_dict.recipes.clear();
     recipe_dict.uncraft.clear();
     recipe_dict.items_on_loops.clear();
+    recipe_dict.item_users.clear();
+    recipe_dict.quality_users.clear();
+    recipe_dict.charge_users.clear();
+    ++recipe_dict.version_;
 }
 
 void recipe_dictionary::delete_if( const std::function<bool( const recipe & )> &pred )
@@ -1,11 +1,13 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
 #include <algorithm>
 #include <functional>
 #include <map>
 #include <set>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -38,6 +40,19 @@ class recipe_dictionary
 
         bool is_item_on_loop( const itype_id & ) const;
 
+        /** Recipes that name @p id as a component or tool in any of their alternatives. */
+        const std::vector<const recipe *> &recipes_using( const itype_id &id ) const;
+        /** Recipes that require tool quality @p id in any of their alternatives. */
+        const std::vector<const recipe *> &recipes_using( const quality_id &id ) const;
+        /** Recipes with tools that use up charges, which may come from items they don't name (UPS). */
+        const std::vector<const recipe *> &recipes_using_charges() const {
+            return charge_users;
+        }
+        /** Changes whenever recipes are loaded or unloaded, so pointers to them kept elsewhere go stale. */
+        uint64_t version() const {
+            return version_;
+        }
+
         /** Returns disassembly recipe (or null recipe if no match) */
         static const recipe &get_uncraft( const itype_id &id );
 
@@ -64,9 +79,14 @@ class recipe_dictionary
         std::set<const recipe *> autolearn;
         std::set<const recipe *> blueprints;
         std::unordered_set<itype_id> items_on_loops;
+        std::unordered_map<itype_id, std::vector<const recipe *>> item_users;
+        std::unordered_map<quality_id, std::vector<const recipe *>> quality_users;
+        std::vector<const recipe *> charge_users;
+        uint64_t version_ = 0;
 
         static void finalize_internal( std::map<recipe_id, recipe> &obj );
         void find_items_on_loops();
+        void find_requirement_users();
 };
 
 extern recipe_dictionary recipe_dict;
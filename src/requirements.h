@@ -57,6 +57,7 @@ struct quality {
 
     static void reset();
     static void load_static( const JsonObject &jo, const std::string &src );
+    static const std::vector<quality> &get_all();
 
     LUA_TYPE_OPS( quality, id );
 };
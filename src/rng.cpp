@@ -9,29 +9,45 @@
 #include "cata_utility.h"
 #include "units.h"
 
+// Stream installed by rng_stream_scope, if any.
+// NOLINTNEXTLINE(cata-determinism)
+static thread_local rng_stream *tl_stream = nullptr;
+
+// Draw from the active stream, else from this thread's engine.  Streams get a fresh
+// distribution so state cached by e.g. normal_distribution never leaks between them.
+template<typename Dist>
+static typename Dist::result_type draw( Dist &engine_dist, const typename Dist::param_type &param )
+{
+    if( tl_stream != nullptr ) {
+        Dist stream_dist( param );
+        return stream_dist( *tl_stream );
+    }
+    return engine_dist( rng_get_engine(), param );
+}
+
 unsigned int rng_bits()
 {
     // Whole uint range.
-    static std::uniform_int_distribution<unsigned int> rng_uint_dist;
-    return rng_uint_dist( rng_get_engine() );
+    static thread_local std::uniform_int_distribution<unsigned int> rng_uint_dist;
+    return draw( rng_uint_dist, rng_uint_dist.param() );
 }
 
 int rng( int lo, int hi )
 {
-    static std::uniform_int_distribution<int> rng_int_dist;
+    static thread_local std::uniform_int_distribution<int> rng_int_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
-    return rng_int_dist( rng_get_engine(), std::uniform_int_distribution<>::param_type( lo, hi ) );
+    return draw( rng_int_dist, std::uniform_int_distribution<>::param_type( lo, hi ) );
 }
 
 double rng_float( double lo, double hi )
 {
-    static std::uniform_real_distribution<double> rng_real_dist;
+    static thread_local std::uniform_real_distribution<double> rng_real_dist;
     if( lo > hi ) {
         std::swap( lo, hi );
     }
-    return rng_real_dist( rng_get_engine(), std::uniform_real_distribution<>::param_type( lo, hi ) );
+    return draw( rng_real_dist, std::uniform_real_distribution<>::param_type( lo, hi ) );
 }
 
 units::angle random_direction()
@@ -41,15 +57,14 @@ units::angle random_direction()
 
 double normal_roll( double mean, double stddev )
 {
-    static std::normal_distribution<double> rng_normal_dist;
-    return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
+    static thread_local std::normal_distribution<double> rng_normal_dist;
+    return draw( rng_normal_dist, std::normal_distribution<>::param_type( mean, stddev ) );
 }
 
 double exponential_roll( double lambda )
 {
-    static std::exponential_distribution<double> rng_exponential_dist;
-    return rng_exponential_dist( rng_get_engine(),
-                                 std::exponential_distribution<>::param_type( lambda ) );
+    static thread_local std::exponential_distribution<double> rng_exponential_dist;
+    return draw( rng_exponential_dist, std::exponential_distribution<>::param_type( lambda ) );
 }
 
 double rng_exponential( double min, double mean )
@@ -169,6 +184,48 @@ void rng_set_worker_seed( unsigned int seed )
     tl_worker_engine.seed( seed );
 }
 
+// splitmix64 finalizer: a bijective 64-bit mix with full avalanche.
+static constexpr std::uint64_t mix64( std::uint64_t z )
+{
+    z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+    return z ^ ( z >> 31 );
+}
+
+static constexpr std::uint64_t golden_gamma = 0x9e3779b97f4a7c15ULL;
+
+rng_stream::rng_stream( unsigned int seed, std::uint64_t entity, const time_point &turn,
+                        std::uint64_t salt )
+{
+    std::uint64_t key = mix64( seed + golden_gamma );
+    key = mix64( key ^ entity );
+    key = mix64( key ^ static_cast<std::uint64_t>( to_turn<std::int64_t>( turn ) ) );
+    key_ = mix64( key ^ salt );
+}
+
+rng_stream::result_type rng_stream::operator()()
+{
+    return mix64( key_ + ++counter_ * golden_gamma );
+}
+
+std::uint64_t rng_stream_key( const tripoint_abs_ms &pos )
+{
+    const auto x = static_cast<std::uint32_t>( pos.x() );
+    const auto y = static_cast<std::uint32_t>( pos.y() );
+    return mix64( ( static_cast<std::uint64_t>( x ) << 32 ) | y ) ^ static_cast<std::uint64_t>
+           ( pos.z() );
+}
+
+rng_stream_scope::rng_stream_scope( rng_stream &stream ) : previous_( tl_stream )
+{
+    tl_stream = &stream;
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+    tl_stream = previous_;
+}
+
 namespace weighted_list_detail
 {
 unsigned int gen_rand_i()
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <iosfwd>
 #include <optional>
@@ -13,6 +14,7 @@
 
 class map;
 class time_duration;
+class time_point;
 template<typename Tripoint>
 class tripoint_range;
 struct tripoint;
@@ -40,6 +42,59 @@ unsigned int rng_bits();
  */
 void rng_set_worker_seed( unsigned int seed );
 
+/**
+ * Counter-based random stream for deterministic draws from any thread.
+ *
+ * Draw i is a hash of ( key, i ), where the key mixes the world seed, an
+ * entity key, the turn and a caller-chosen salt.  A stream is therefore a pure
+ * function of its key: it yields the same sequence on any thread, however work
+ * is split, and without touching any shared engine.
+ *
+ * Satisfies UniformRandomBitGenerator, so it can also be passed to std::shuffle.
+ */
+class rng_stream
+{
+    public:
+        using result_type = std::uint64_t;
+
+        rng_stream( unsigned int seed, std::uint64_t entity, const time_point &turn,
+                    std::uint64_t salt = 0 );
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT64_MAX;
+        }
+        result_type operator()();
+
+    private:
+        std::uint64_t key_;
+        std::uint64_t counter_ = 0;
+};
+
+/** Entity key for creatures without a persistent id: where they stand is unique per turn. */
+std::uint64_t rng_stream_key( const tripoint_abs_ms &pos );
+
+/**
+ * While alive, rng(), one_in(), x_in_y(), dice() and the other helpers in this
+ * header draw from @p stream on the current thread instead of the shared or
+ * per-worker engine.  Scopes nest.  Code that calls rng_get_engine() directly
+ * is not redirected.
+ */
+class rng_stream_scope
+{
+    public:
+        explicit rng_stream_scope( rng_stream &stream );
+        ~rng_stream_scope();
+
+        rng_stream_scope( const rng_stream_scope & ) = delete;
+        rng_stream_scope &operator=( const rng_stream_scope & ) = delete;
+
+    private:
+        rng_stream *previous_;
+};
+
 int rng( int lo, int hi );
 double rng_float( double lo, double hi );
 
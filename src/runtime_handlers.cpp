@@ -3,10 +3,12 @@
 #include "debug.h"
 #include "init.h"
 #include "game.h"
+#include "startup_timeline.h"
 
 [[ noreturn ]]
 void exit_handler( int status )
 {
+    startup_timeline::write();
     DynamicDataLoader::get_instance().unload_data();
     deinitDebug();
     g.reset();
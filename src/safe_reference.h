@@ -52,6 +52,7 @@
 #include <unordered_map>
 
 #include "debug.h"
+#include "lock_stats.h"
 
 class item;
 class game;
@@ -389,7 +390,9 @@ class cache_reference
         // submaps (including their active_item_cache) on worker threads, which constructs
         // cache_reference objects concurrently.  Uncontended on the main thread so the
         // cost during normal gameplay is a single atomic CAS per lock/unlock.
-        inline static std::mutex reference_map_mutex_;
+        using reference_map_mutex_type =
+            lock_stats::counted<std::mutex, "cache_reference::reference_map_mutex_">;
+        inline static TracyLockable( reference_map_mutex_type, reference_map_mutex_ );
 
         auto invalidate() -> void {
             p = nullptr;
@@ -0,0 +1,123 @@
+#include "save_dictionary.h"
+
+#include <algorithm>
+#include <charconv>
+#include <map>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "debug.h"
+#include "filesystem.h"
+#include "path_info.h"
+
+namespace
+{
+
+constexpr auto extension = std::string_view{ ".dict" };
+
+struct dictionary_set {
+    std::vector<save_dictionary::dictionary> all;
+    /// Category to index of its newest version in `all`.
+    std::map<std::string, std::size_t, std::less<>> newest;
+};
+
+struct parsed_name {
+    std::string category;
+    int version = 0;
+};
+
+/// Splits `<category>.v<N>` into its parts.
+auto parse_id( std::string_view id ) -> std::optional<parsed_name>
+{
+    const auto dot = id.rfind( ".v" );
+    if( dot == std::string_view::npos || dot == 0 ) {
+        return std::nullopt;
+    }
+    auto version = 0;
+    const auto digits = id.substr( dot + 2 );
+    const auto [end, ec] = std::from_chars( digits.data(), digits.data() + digits.size(), version );
+    if( ec != std::errc{} || end != digits.data() + digits.size() ) {
+        return std::nullopt;
+    }
+    return parsed_name{ .category = std::string( id.substr( 0, dot ) ), .version = version };
+}
+
+auto load_dictionaries() -> dictionary_set
+{
+    auto set = dictionary_set{};
+    auto versions = std::map<std::string, int> {};
+    const auto files = get_files_from_path( std::string( extension ), PATH_INFO::save_dictionarydir(),
+                                            false, true );
+    std::ranges::for_each( files, [&]( const std::string & file ) {
+        const auto base = file.substr( file.find_last_of( "/\\" ) + 1 );
+        const auto id = base.substr( 0, base.size() - extension.size() );
+        const auto name = parse_id( id );
+        if( !name ) {
+            debugmsg( "Save dictionary %s is not named <category>.v<N>%s", file, extension );
+            return;
+        }
+        auto data = read_entire_file( file );
+        if( data.empty() ) {
+            debugmsg( "Save dictionary %s is empty or unreadable", file );
+            return;
+        }
+        set.all.push_back( { .id = id, .data = std::move( data ) } );
+        const auto [iter, inserted] = versions.try_emplace( name->category, name->version );
+        if( inserted || name->version > iter->second ) {
+            iter->second = name->version;
+            set.newest.insert_or_assign( name->category, set.all.size() - 1 );
+        }
+    } );
+    return set;
+}
+
+auto dictionaries() -> const dictionary_set & // *NOPAD*
+{
+    // Compression runs on pool threads; the set is read-only once built.
+    static const auto set = load_dictionaries();
+    return set;
+}
+
+/// Category of the blob stored at @p path, or empty if it has none.
+auto category_of( std::string_view path ) -> std::string_view
+{
+    if( path.ends_with( ".map" ) ) {
+        return "submap";
+    }
+    const auto base = path.substr( path.find_last_of( "/\\" ) + 1 );
+    // Overmap terrain, which also carries the overmap's NPCs, is "o.<x>.<y>".
+    if( base.starts_with( "o." ) ) {
+        return "overmap";
+    }
+    return {};
+}
+
+} // namespace
+
+namespace save_dictionary
+{
+
+auto for_path( const std::string_view path ) -> const dictionary *
+{
+    const auto category = category_of( path );
+    if( category.empty() ) {
+        return nullptr;
+    }
+    const auto &set = dictionaries();
+    const auto iter = set.newest.find( category );
+    return iter == set.newest.end() ? nullptr : &set.all[iter->second];
+}
+
+auto for_compression( const std::string_view compression ) -> const dictionary *
+{
+    if( !compression.starts_with( compression_prefix ) ) {
+        return nullptr;
+    }
+    const auto id = compression.substr( compression_prefix.size() );
+    const auto &all = dictionaries().all;
+    const auto iter = std::ranges::find( all, id, &dictionary::id );
+    return iter == all.end() ? nullptr : &*iter;
+}
+
+} // namespace save_dictionary
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+/**
+ * Preset zlib dictionaries for save blobs.
+ *
+ * Submap and overmap blobs are compressed one at a time, and most of each is
+ * member names and ids that every other blob repeats.  A dictionary trained
+ * on real saves (tools/train_save_dictionary.py) primes the compressor with
+ * them.  Files live in data/raw/save_dictionaries/ as `<category>.v<N>.dict`;
+ * new blobs use the highest version of their category, and the `compression`
+ * column records `zlib-dict:<category>.v<N>` so older versions keep decoding.
+ * Shipped versions must never change or be removed.
+ */
+namespace save_dictionary
+{
+
+constexpr auto compression_prefix = std::string_view{ "zlib-dict:" };
+
+struct dictionary {
+    /// `<category>.v<N>`
+    std::string id;
+    std::string data;
+};
+
+/// Dictionary for new blobs at @p path, or nullptr if its category has none.
+auto for_path( std::string_view path ) -> const dictionary *;
+/// Dictionary named by a `compression` column value, or nullptr if not shipped.
+auto for_compression( std::string_view compression ) -> const dictionary *;
+
+} // namespace save_dictionary
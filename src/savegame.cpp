@@ -148,6 +148,7 @@ void game::serialize( std::ostream &fout )
     json.member( "stair_monsters", coming_to_stairs );
 
     // save stats.
+    events().flush_deferred();
     json.member( "kill_tracker", *kill_tracker_ptr );
     json.member( "stats_tracker", *stats_tracker_ptr );
     json.member( "achievements_tracker", *achievements_tracker_ptr );
@@ -556,7 +557,7 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
                             }
                         }
                         count--;
-                        layer[z].terrain[i][j] = tmp_otid;
+                        layer[z].terrain.set( point_om_omt( i, j ), tmp_otid );
                     }
                 }
                 jsin.end_array();
@@ -807,12 +808,13 @@ void overmap::unserialize( std::istream &fin, const std::string &file_path )
     sync_mapgen_args_init_flags();
 }
 
-static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &array )[OMAPX][OMAPY] )
+static void unserialize_array_from_compacted_sequence( JsonIn &jsin,
+        overmap_layer_grid<bool> &array )
 {
     int count = 0;
     bool value = false;
     for( int j = 0; j < OMAPY; j++ ) {
-        for( auto &array_col : array ) {
+        for( int i = 0; i < OMAPX; i++ ) {
             if( count == 0 ) {
                 jsin.start_array();
                 jsin.read( value );
@@ -820,7 +822,7 @@ static void unserialize_array_from_compacted_sequence( JsonIn &jsin, bool ( &arr
                 jsin.end_array();
             }
             count--;
-            array_col[j] = value;
+            array.set( point_om_omt( i, j ), value );
         }
     }
 }
@@ -896,13 +898,13 @@ void overmap::unserialize_view( std::istream &fin, const std::string &file_path
 }
 
 static void serialize_array_to_compacted_sequence( JsonOut &json,
-        const bool ( &array )[OMAPX][OMAPY] )
+        const overmap_layer_grid<bool> &array )
 {
     int count = 0;
     int lastval = -1;
     for( int j = 0; j < OMAPY; j++ ) {
-        for( const auto &array_col : array ) {
-            const int value = array_col[j];
+        for( int i = 0; i < OMAPX; i++ ) {
+            const int value = array.get( point_om_omt( i, j ) );
             if( value != lastval ) {
                 if( count ) {
                     json.write( count );
@@ -1037,11 +1039,11 @@ void overmap::save_monster_groups( JsonOut &jout ) const
     std::unordered_map<mongroup, std::list<tripoint_abs_sm>, mongroup_hash, mongroup_bin_eq>
     binned_groups;
     binned_groups.reserve( zg.size() );
-    for( const auto &pos_group : zg ) {
+    for( const mongroup &group : zg ) {
         // Each group in bin adds only position
         // so that 100 identical groups are 1 group data and 100 tripoints
-        auto &positions = binned_groups[pos_group.second];
-        positions.emplace_back( pos_group.second.abs_pos );
+        auto &positions = binned_groups[group];
+        positions.emplace_back( group.abs_pos );
     }
 
     for( auto &group_bin : binned_groups ) {
@@ -1073,9 +1075,8 @@ void overmap::serialize( std::ostream &fout ) const
         oter_id last_tertype( -1 );
         json.start_array();
         for( int j = 0; j < OMAPY; j++ ) {
-            // NOLINTNEXTLINE(modernize-loop-convert)
             for( int i = 0; i < OMAPX; i++ ) {
-                oter_id t = layer_terrain[i][j];
+                oter_id t = layer_terrain.get( point_om_omt( i, j ) );
                 if( t != last_tertype ) {
                     if( count ) {
                         json.write( count );
@@ -1274,7 +1275,7 @@ void overmap::serialize( std::ostream &fout ) const
     fout << '\n';
     json.member( "mapgen_arg_index" );
     json.start_array();
-    for( const std::pair<const tripoint_om_omt, int> &p : mapgen_args_index ) {
+    for( const std::pair<tripoint_om_omt, int> &p : mapgen_args_index ) {
         json.start_array();
         json.write( p.first );
         json.write( p.second );
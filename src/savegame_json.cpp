@@ -36,6 +36,7 @@
 #include "avatar.h"
 #include "bionics.h"
 #include "bodypart.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_cartesian_product.h"
 #include "cata_io.h"
@@ -193,6 +194,7 @@ void item_contents::deserialize( JsonIn &jsin )
     JsonObject data = jsin.get_object();
     data.allow_omitted_members();
     data.read( "items", items );
+    invalidate_processing_cache();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -677,6 +679,7 @@ void Character::load( const JsonObject &data )
         cached_mutations.push_back( &mid.obj() );
         it++;
     }
+    recalc_mutation_values();
 
     for( const trait_id &tid : migrations_to_add ) {
         if( !has_trait( tid ) ) {
@@ -2091,6 +2094,7 @@ auto monster::load( const JsonObject &data,
             entry.cooldown = rng( 0, sa.second->cooldown );
         }
     }
+    specials_ready_in = 0;
 
     data.read( "friendly", friendly );
     data.read( "training_level", training_level );
@@ -2843,6 +2847,7 @@ void item::io( Archive &archive )
     erase_if( item_tags, [&]( const flag_id & f ) {
         return !f.is_valid();
     } );
+    own_flag_bits = flag_bits::of( item_tags );
 
     if( note_read ) {
         snip_id = SNIPPET.migrate_hash_to_id( note );
@@ -3062,7 +3067,7 @@ void vehicle_part::deserialize( JsonIn &jsin )
     data.read( "mount_dx", mount.x() );
     data.read( "mount_dy", mount.y() );
     data.read( "open", open );
-    int direction_int;
+    int direction_int = 0;
     data.read( "direction", direction_int );
     direction = units::from_degrees( direction_int );
     data.read( "blood", blood );
@@ -3119,7 +3124,7 @@ void vehicle_part::deserialize( JsonIn &jsin )
         if( ammo_capacity() > 0 ) {
             ammo_set( legacy_fuel, data.get_int( "amount" ) );
         }
-        base->item_tags.insert( flag_id( "VEHICLE" ) );
+        base->set_flag( flag_id( "VEHICLE" ) );
     }
 
     if( data.has_int( "hp" ) && id.obj().durability > 0 ) {
@@ -3146,13 +3151,29 @@ void vehicle_part::serialize( JsonOut &json ) const
     json.member( "base", base );
     json.member( "mount_dx", mount.x() );
     json.member( "mount_dy", mount.y() );
-    json.member( "open", open );
-    json.member( "direction", std::lround( to_degrees( direction ) ) );
-    json.member( "blood", blood );
-    json.member( "proxy_part_id", proxy_part_id );
-    json.member( "proxy_sym", proxy_sym );
-    json.member( "enabled", enabled );
-    json.member( "flags", flags );
+    // Members left at their defaults are omitted, vehicles are a large part of map saves.
+    if( open ) {
+        json.member( "open", open );
+    }
+    const long direction_degrees = std::lround( to_degrees( direction ) );
+    if( direction_degrees != 0 ) {
+        json.member( "direction", direction_degrees );
+    }
+    if( blood != 0 ) {
+        json.member( "blood", blood );
+    }
+    if( !proxy_part_id.is_null() ) {
+        json.member( "proxy_part_id", proxy_part_id );
+    }
+    if( proxy_sym != '\0' ) {
+        json.member( "proxy_sym", proxy_sym );
+    }
+    if( !enabled ) {
+        json.member( "enabled", enabled );
+    }
+    if( flags != 0 ) {
+        json.member( "flags", flags );
+    }
     if( !carry_names.empty() ) {
         std::stack<std::string, std::vector<std::string> > carry_copy = carry_names;
         json.member( "carry" );
@@ -3163,12 +3184,18 @@ void vehicle_part::serialize( JsonOut &json ) const
         }
         json.end_array();
     }
-    json.member( "passenger_id", passenger_id );
-    json.member( "crew_id", crew_id );
+    if( passenger_id.is_valid() ) {
+        json.member( "passenger_id", passenger_id );
+    }
+    if( crew_id.is_valid() ) {
+        json.member( "crew_id", crew_id );
+    }
     if( z_terrain[0] ) {
         json.member( "z_offset", z_terrain[0] );
     }
-    json.member( "items", items );
+    if( !items.empty() ) {
+        json.member( "items", items );
+    }
     if( target.first != tripoint_abs_ms::min() ) {
         json.member( "target_first_x", target.first.x() );
         json.member( "target_first_y", target.first.y() );
@@ -3179,7 +3206,9 @@ void vehicle_part::serialize( JsonOut &json ) const
         json.member( "target_second_y", target.second.y() );
         json.member( "target_second_z", target.second.z() );
     }
-    json.member( "ammo_pref", ammo_pref );
+    if( !ammo_pref.is_null() ) {
+        json.member( "ammo_pref", ammo_pref );
+    }
     json.member( "part_color", part_color_ );
     if( portal_tap_linked ) {
         json.member( "portal_tap_linked", portal_tap_linked );
@@ -3903,16 +3932,15 @@ void player_morale::load( const JsonObject &jsin )
 {
     jsin.allow_omitted_members();
     jsin.read( "morale", points );
+    invalidate();
 }
 
 struct mm_elem {
-    memorized_terrain_tile tile;
-    memorized_terrain_tile terrain;
-    int symbol;
+    mm_tile tile;
+    mm_tile terrain;
+    int symbol = 0;
 
-    bool operator==( const mm_elem &rhs ) const {
-        return symbol == rhs.symbol && tile == rhs.tile && terrain == rhs.terrain;
-    }
+    bool operator==( const mm_elem &rhs ) const = default;
 };
 
 void mm_submap::serialize( JsonOut &jsout ) const
@@ -3923,17 +3951,18 @@ void mm_submap::serialize( JsonOut &jsout ) const
     // Element format: [overlay_tile, subtile, rotation, symbol, ?terrain_str, terrain_sub, terrain_rot, ?count]
     // terrain fields are only written when non-empty, saving space for the ~92% of tiles with no furniture.
 
+    const memorized_tile_names &names = memorized_tile_names::get();
     mm_elem last;
     int num_same = 1;
 
     const auto write_seq = [&]() {
         jsout.start_array();
-        jsout.write( last.tile.tile );
+        jsout.write( names.name( last.tile.name ) );
         jsout.write( last.tile.subtile );
         jsout.write( last.tile.rotation );
         jsout.write( last.symbol );
-        if( !last.terrain.tile.empty() ) {
-            jsout.write( last.terrain.tile );
+        if( last.terrain.name != memorized_tile_names::none ) {
+            jsout.write( names.name( last.terrain.name ) );
             jsout.write( last.terrain.subtile );
             jsout.write( last.terrain.rotation );
         }
@@ -3944,7 +3973,7 @@ void mm_submap::serialize( JsonOut &jsout ) const
     };
 
     for( const auto p : submap_tiles() ) {
-        const mm_elem elem = { tile( p ), terrain_tile( p ), symbol( p ) };
+        const mm_elem elem = { tiles.get( p ), terrain_tiles.get( p ), symbol( p ) };
         if( p.x() == 0 && p.y() == 0 ) {
             last = elem;
         } else if( last == elem ) {
@@ -3966,6 +3995,14 @@ void mm_submap::deserialize( JsonIn &jsin )
 
     // Uses RLE for compression.
 
+    memorized_tile_names &names = memorized_tile_names::get();
+    const auto read_tile = [&]() {
+        const std::string name = jsin.get_string();
+        const int subtile = jsin.get_int();
+        const int rotation = jsin.get_int();
+        return mm_tile{ names.intern( name ), static_cast<int16_t>( subtile ), static_cast<int16_t>( rotation ) };
+    };
+
     mm_elem elem;
     size_t remaining = 0;
 
@@ -3974,39 +4011,29 @@ void mm_submap::deserialize( JsonIn &jsin )
             remaining -= 1;
         } else {
             jsin.start_array();
-            elem.tile.tile = jsin.get_string();
-            elem.tile.subtile = jsin.get_int();
-            elem.tile.rotation = jsin.get_int();
+            elem.tile = read_tile();
             elem.symbol = jsin.get_int();
-            elem.terrain = mm_submap::default_tile;
+            elem.terrain = mm_tile();
             if( jsin.test_string() ) {
                 // New format: optional terrain tile fields follow symbol.
-                elem.terrain.tile = jsin.get_string();
-                elem.terrain.subtile = jsin.get_int();
-                elem.terrain.rotation = jsin.get_int();
-            } else if( elem.tile.tile.starts_with( "t_" ) ) {
+                elem.terrain = read_tile();
+            } else if( names.name( elem.tile.name ).starts_with( "t_" ) ) {
                 // Migration: old saves stored terrain in the overlay slot.
                 // Move it to the terrain slot where draw_terrain now expects it.
                 elem.terrain = elem.tile;
-                elem.tile = mm_submap::default_tile;
+                elem.tile = mm_tile();
             }
             if( jsin.test_int() ) {
                 remaining = jsin.get_int() - 1;
             }
             jsin.end_array();
         }
-        // Try to avoid assigning to save up on memory
-        if( elem.tile != mm_submap::default_tile ) {
-            set_tile( p, elem.tile );
-        }
-        if( elem.terrain != mm_submap::default_tile ) {
-            set_terrain_tile( p, elem.terrain );
-        }
-        if( elem.symbol != mm_submap::default_symbol ) {
-            set_symbol( p, elem.symbol );
-        }
+        tiles.set( p, elem.tile );
+        terrain_tiles.set( p, elem.terrain );
+        symbols.set( p, elem.symbol );
     }
     jsin.end_array();
+    compact();
 }
 
 void mm_region::serialize( JsonOut &jsout ) const
@@ -4049,8 +4076,10 @@ void mm_region::deserialize( JsonIn &jsin )
 void map_memory::load_legacy( JsonIn &jsin )
 {
     struct mig_elem {
-        int symbol;
-        memorized_terrain_tile tile;
+        int symbol = 0;
+        std::string tile;
+        int subtile = 0;
+        int rotation = 0;
     };
     std::map<tripoint_abs_ms, mig_elem> elems;
 
@@ -4063,9 +4092,9 @@ void map_memory::load_legacy( JsonIn &jsin )
         p.y() = jsin.get_int();
         p.z() = jsin.get_int();
         mig_elem &elem = elems[p];
-        elem.tile.tile = jsin.get_string();
-        elem.tile.subtile = jsin.get_int();
-        elem.tile.rotation = jsin.get_int();
+        elem.tile = jsin.get_string();
+        elem.subtile = jsin.get_int();
+        elem.rotation = jsin.get_int();
         jsin.end_array();
     }
     jsin.start_array();
@@ -4086,8 +4115,9 @@ void map_memory::load_legacy( JsonIn &jsin )
         if( !sm ) {
             sm = allocate_submap( cp.quotient_tripoint );
         }
-        if( elem.second.tile != mm_submap::default_tile ) {
-            sm->set_tile( cp.remainder, elem.second.tile );
+        const memorized_terrain_tile tile{ elem.second.tile, elem.second.subtile, elem.second.rotation };
+        if( tile != mm_submap::default_tile ) {
+            sm->set_tile( cp.remainder, tile );
         }
         if( elem.second.symbol != mm_submap::default_symbol ) {
             sm->set_symbol( cp.remainder, elem.second.symbol );
@@ -4356,7 +4386,7 @@ void submap::store( JsonOut &jsout ) const
     std::string last_id;
     int num_same = 1;
     for( const auto sm_ms : submap_tiles() ) {
-        const std::string this_id = ter[sm_ms.x()][sm_ms.y()].obj().id.str();
+        const std::string this_id = get_ter( sm_ms ).obj().id.str();
         if( !last_id.empty() ) {
             if( this_id == last_id ) {
                 num_same++;
@@ -4454,17 +4484,6 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
-    jsout.member( "items" );
-    jsout.start_array();
-    for( const auto sm_ms : submap_tiles() ) {
-        if( !itm[sm_ms.x()][sm_ms.y()].empty() ) {
-            jsout.write( sm_ms.x() );
-            jsout.write( sm_ms.y() );
-            jsout.write( itm[sm_ms.x()][sm_ms.y()] );
-        }
-    }
-    jsout.end_array();
-
     jsout.member( "traps" );
     jsout.start_array();
     for( const auto p : submap_tiles() ) {
@@ -4484,11 +4503,11 @@ void submap::store( JsonOut &jsout ) const
     jsout.start_array();
     for( const auto sm_ms : submap_tiles() ) {
         // Save fields
-        if( fld[sm_ms.x()][sm_ms.y()].field_count() > 0 ) {
+        if( field_at( sm_ms ).field_count() > 0 ) {
             jsout.write( sm_ms.x() );
             jsout.write( sm_ms.y() );
             jsout.start_array();
-            for( auto &elem : fld[sm_ms.x()][sm_ms.y()] ) {
+            for( const auto &elem : field_at( sm_ms ) ) {
                 const field_entry &cur = elem.second;
                 jsout.write( cur.get_field_type().id() );
                 jsout.write( cur.get_field_intensity() );
@@ -4499,6 +4518,24 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_objects( jsout );
+}
+
+void submap::store_objects( JsonOut &jsout ) const
+{
+    if( !store_deferred_items( jsout ) ) {
+        jsout.member( "items" );
+        jsout.start_array();
+        for( const auto sm_ms : submap_tiles() ) {
+            if( !itm[sm_ms.x()][sm_ms.y()].empty() ) {
+                jsout.write( sm_ms.x() );
+                jsout.write( sm_ms.y() );
+                jsout.write( itm[sm_ms.x()][sm_ms.y()] );
+            }
+        }
+        jsout.end_array();
+    }
+
     // Write out as array of arrays of single entries
     jsout.member( "cosmetics" );
     jsout.start_array();
@@ -4607,6 +4644,44 @@ void submap::store( JsonOut &jsout ) const
     jsout.end_array();
 }
 
+void submap::load_items( JsonIn &jsin, const int version )
+{
+    jsin.start_array();
+    while( !jsin.end_array() ) {
+        int i = jsin.get_int();
+        int j = jsin.get_int();
+        const point_sm_ms p( i, j );
+        jsin.start_array();
+        while( !jsin.end_array() ) {
+            detached_ptr<item> tmp;
+            jsin.read( tmp );
+
+            if( tmp->is_emissive() ) {
+                update_lum_add( p, *tmp );
+            }
+
+            if( savegame_loading_version >= 27 && version < 27 ) {
+                tmp->legacy_fast_forward_time();
+            }
+            item &obj = *tmp;
+            itm[p.x()][p.y()].push_back( std::move( tmp ) );
+            note_item_added( p );
+            if( obj.needs_processing() ) {
+                active_items.add( obj );
+            }
+        }
+    }
+    for( auto &it1 : itm ) {
+        for( auto &it2 : it1 ) {
+            std::vector<detached_ptr<item>> cleared = it2.clear();
+            to_cbc_migration::migrate( cleared );
+            for( detached_ptr<item> &item : cleared ) {
+                it2.push_back( std::move( item ) );
+            }
+        }
+    }
+}
+
 void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                    const tripoint_abs_ms offset, const dimension_id &dim )
 {
@@ -4637,7 +4712,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             } else {
                 --remaining;
             }
-            ter[sm_ms.x()][sm_ms.y()] = iid;
+            ter.set( cell( sm_ms ), iid );
         }
         if( remaining ) {
             debugmsg( "Mapbuffer terrain data is corrupt, tile data remaining." );
@@ -4673,41 +4748,26 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             jsin.start_array();
             int i = jsin.get_int();
             int j = jsin.get_int();
-            frn[i][j] = furn_id( jsin.get_string() );
+            frn.set( cell( point_sm_ms( i, j ) ), furn_id( jsin.get_string() ) );
             jsin.end_array();
         }
     } else if( member_name == "items" ) {
-        jsin.start_array();
-        while( !jsin.end_array() ) {
-            int i = jsin.get_int();
-            int j = jsin.get_int();
-            const point_sm_ms p( i, j );
-            jsin.start_array();
-            while( !jsin.end_array() ) {
-                detached_ptr<item> tmp;
-                jsin.read( tmp );
-
-                if( tmp->is_emissive() ) {
-                    update_lum_add( p, *tmp );
-                }
-
-                if( savegame_loading_version >= 27 && version < 27 ) {
-                    tmp->legacy_fast_forward_time();
-                }
-                item &obj = *tmp;
-                itm[p.x()][p.y()].push_back( std::move( tmp ) );
-                if( obj.needs_processing() ) {
-                    active_items.add( obj );
-                }
-            }
-        }
-        for( auto &it1 : itm ) {
-            for( auto &it2 : it1 ) {
-                std::vector<detached_ptr<item>> cleared = it2.clear();
-                to_cbc_migration::migrate( cleared );
-                for( detached_ptr<item> &item : cleared ) {
-                    it2.push_back( std::move( item ) );
-                }
+        // Only current-version items can be parsed later: migrations depend on the loading context.
+        const auto can_defer = deferred_submap_items && version == savegame_version &&
+                               savegame_loading_version == savegame_version;
+        if( !can_defer ) {
+            load_items( jsin, version );
+        } else {
+            const auto start = jsin.tell();
+            jsin.skip_value();
+            // substr() leaves the stream where skip_value() did, separator included.
+            auto text = jsin.substr( start, jsin.tell() - start );
+            text.erase( text.find_last_of( ']' ) + 1 );
+            // An empty array is not worth deferring.
+            if( text.find( '{' ) != std::string::npos ) {
+                deferred_items_ = std::move( text );
+                deferred_items_unindexed_ = true;
+                items_deferred_.store( true, std::memory_order_release );
             }
         }
     } else if( member_name == "traps" ) {
@@ -4718,7 +4778,7 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
             int j = jsin.get_int();
             const point_sm_ms p( i, j );
             // TODO: jsin should support returning an id like jsin.get_id<trap>()
-            trp[p.x()][p.y()] = trap_str_id( jsin.get_string() ).id();
+            trp.set( cell( p ), trap_str_id( jsin.get_string() ).id() );
             trap_cache.push_back( p ); // null traps are not serialized, so this is always valid
             jsin.end_array();
         }
@@ -4746,11 +4806,11 @@ void submap::load( JsonIn &jsin, const std::string &member_name, int version,
                 } else {
                     ft = field_types::get_field_type_by_legacy_enum( type_int ).id;
                 }
-                if( fld[i][j].find_field( ft ) == nullptr ) {
-                    field_count++;
-                    field_cache.push_back( point_sm_ms( i, j ) );
+                if( field_at( point_sm_ms( i, j ) ).find_field( ft ) == nullptr ) {
+                    note_field_added( point_sm_ms( i, j ), ft );
                 }
-                fld[i][j].add_field( ft, intensity, time_duration::from_turns( age ) );
+                mutable_field_at( point_sm_ms( i, j ) ).add_field( ft, intensity,
+                        time_duration::from_turns( age ) );
             }
         }
     } else if( member_name == "graffiti" ) {
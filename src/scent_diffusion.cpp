@@ -0,0 +1,116 @@
+#include "scent_diffusion.h"
+
+#include <algorithm>
+#include <array>
+
+#include "thread_pool.h"
+
+namespace scent_diffusion
+{
+
+namespace
+{
+
+// Down each window column, the sum of transferred scent and of transfer over the three
+// tiles each diffused tile draws from in y.
+auto sum_column( const window &in, step &out, const int x ) -> void
+{
+    const int *sc = in.scent.data() + window_index( x, 0 );
+    const int *st = in.transfer.data() + window_index( x, 0 );
+    int *sum_scent = out.column_scent.data() + out_index( x, 0 );
+    int *sum_transfer = out.column_transfer.data() + out_index( x, 0 );
+    for( int y = 0; y < out_side; ++y ) {
+        sum_scent[y] = st[y] * sc[y] + st[y + 1] * sc[y + 1] + st[y + 2] * sc[y + 2];
+        sum_transfer[y] = st[y] + st[y + 1] + st[y + 2];
+    }
+}
+
+// Diffused column x, which is window column x + 1.
+auto diffuse_column( const window &in, step &out, const int x ) -> void
+{
+    const auto column = [&]( const std::vector<int> &v, const int wx ) {
+        return v.data() + window_index( wx, 0 );
+    };
+    const int *sc_w = column( in.scent, x );
+    const int *sc_c = column( in.scent, x + 1 );
+    const int *sc_e = column( in.scent, x + 2 );
+    const int *st_w = column( in.transfer, x );
+    const int *st_c = column( in.transfer, x + 1 );
+    const int *st_e = column( in.transfer, x + 2 );
+    const int *holes_w = column( in.holes, x );
+    const int *holes_c = column( in.holes, x + 1 );
+    const int *holes_e = column( in.holes, x + 2 );
+    const auto sums = [&]( const std::vector<int> &v, const int sx ) {
+        return v.data() + out_index( sx, 0 );
+    };
+    const int *scent_w = sums( out.column_scent, x );
+    const int *scent_c = sums( out.column_scent, x + 1 );
+    const int *scent_e = sums( out.column_scent, x + 2 );
+    const int *transfer_w = sums( out.column_transfer, x );
+    const int *transfer_c = sums( out.column_transfer, x + 1 );
+    const int *transfer_e = sums( out.column_transfer, x + 2 );
+    // Written here first: the compiler knows a local cannot overlap the inputs, where
+    // writing to out.diffused directly would take more alias checks than it makes.
+    std::array<int, out_side> diffused;
+
+    // Window row y + 1 holds diffused row y.
+    for( int y = 0; y < out_side; ++y ) {
+        int squares_used = transfer_w[y] + transfer_c[y] + transfer_e[y];
+        int total = scent_w[y] + scent_c[y] + scent_e[y];
+
+        // A vehicle wall across a diagonal keeps the tile beyond it from diffusing in.
+        // 0 or 1 as ints rather than branches or bools, so the loop stays vector code.
+        const int se = ( holes_c[y + 1] & hole_nw ) * ( st_e[y + 2] == 5 ? 1 : 0 );
+        const int sw = ( ( holes_c[y + 1] & hole_ne ) >> 1 ) * ( st_w[y + 2] == 5 ? 1 : 0 );
+        const int nw = ( holes_w[y] & hole_nw ) * ( st_w[y] == 5 ? 1 : 0 );
+        const int ne = ( ( holes_e[y] & hole_ne ) >> 1 ) * ( st_e[y] == 5 ? 1 : 0 );
+        squares_used -= 4 * ( se + sw + nw + ne );
+        total -= 4 * ( se * sc_e[y + 2] + sw * sc_w[y + 2] + nw * sc_w[y] + ne * sc_e[y] );
+
+        // Lingering scent
+        const int cur = sc_c[y + 1];
+        const int transfer = st_c[y + 1];
+        int temp_scent = cur * ( 250 - squares_used * transfer );
+        temp_scent -= cur * transfer * ( 45 - squares_used ) / 5;
+
+        diffused[y] = ( temp_scent + total * transfer ) / 250;
+    }
+    std::ranges::copy( diffused, out.diffused.begin() + out_index( x, 0 ) );
+}
+
+} // namespace
+
+auto window::clear() -> void
+{
+    const auto cells = static_cast<std::size_t>( window_side ) * window_side;
+    scent.assign( cells, 0 );
+    transfer.assign( cells, 0 );
+    holes.assign( cells, 0 );
+}
+
+auto diffuse( const window &in, step &out, const bool parallel ) -> void
+{
+    const auto sum_cells = static_cast<std::size_t>( window_side ) * out_side;
+    out.column_scent.resize( sum_cells );
+    out.column_transfer.resize( sum_cells );
+    out.diffused.resize( static_cast<std::size_t>( out_side ) * out_side );
+
+    // Columns are independent within each pass; the second reads what the first wrote.
+    if( parallel ) {
+        parallel_for( "scent_diffuse_x", 0, window_side, [&]( int x ) {
+            sum_column( in, out, x );
+        } );
+        parallel_for( "scent_diffuse_y", 0, out_side, [&]( int x ) {
+            diffuse_column( in, out, x );
+        } );
+    } else {
+        for( int x = 0; x < window_side; ++x ) {
+            sum_column( in, out, x );
+        }
+        for( int x = 0; x < out_side; ++x ) {
+            diffuse_column( in, out, x );
+        }
+    }
+}
+
+} // namespace scent_diffusion
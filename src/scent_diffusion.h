@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+/**
+ * One turn of scent diffusion over the square around the player, on plain arrays so the
+ * same step can run on the CPU or as a compute shader (scent_diffuse_compute.hlsl).
+ *
+ * Every array is one column after another, so a column is contiguous: the passes walk
+ * columns with no branches and the compiler turns them into vector code.  The result
+ * is exactly what the scalar diffusion gave, integer rounding included.
+ */
+namespace scent_diffusion
+{
+
+/// Chebyshev distance from the player of the farthest tile that diffuses.
+constexpr int radius = 40;
+/// Side of the diffused square.
+constexpr int out_side = 2 * radius + 1;
+/// Side of the input window: the diffused square and the one-tile border it draws from.
+constexpr int window_side = out_side + 2;
+
+/// Bits of window::holes, set where a vehicle blocks that diagonal through the tile.
+/// diffuse() relies on these exact values.
+constexpr int hole_nw = 1;
+constexpr int hole_ne = 2;
+
+constexpr auto window_index( const int x, const int y ) -> std::size_t
+{
+    return static_cast<std::size_t>( x ) * window_side + y;
+}
+
+constexpr auto out_index( const int x, const int y ) -> std::size_t
+{
+    return static_cast<std::size_t>( x ) * out_side + y;
+}
+
+/** Inputs of a step, window_side squared each, (0, 0) being the corner of the border. */
+struct window {
+    std::vector<int> scent;
+    /// How much scent a tile passes on: 0 blocks it, 1 reduces it, 5 is normal.
+    std::vector<int> transfer;
+    std::vector<int> holes;
+
+    /** Sizes the arrays and zeroes them, as for tiles outside the map. */
+    auto clear() -> void;
+};
+
+/** Scratch and result of a step, kept between turns for its allocation. */
+struct step {
+    /// New scent of the diffused square, out_side squared.
+    std::vector<int> diffused;
+
+    // Sums over three tiles down each window column.
+    std::vector<int> column_scent;
+    std::vector<int> column_transfer;
+};
+
+/** Diffuses @p in into @p out.diffused, spreading the columns over the thread pool if asked. */
+auto diffuse( const window &in, step &out, bool parallel ) -> void;
+
+} // namespace scent_diffusion
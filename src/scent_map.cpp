@@ -9,6 +9,9 @@
 #include "cached_options.h"
 #include "calendar.h"
 #include "color.h"
+#include "compute/compute_backend.h"
+#include "compute/gpu_platform.h"
+#include "compute/gpu_scent.h"
 #include "cuboid_rectangle.h"
 #include "cursesdef.h"
 #include "debug.h"
@@ -19,11 +22,12 @@
 #include "options.h"
 #include "output.h"
 #include "profile.h"
+#include "scent_diffusion.h"
 #include "string_id.h"
 #include "submap.h"
 #include "thread_pool.h"
 
-static constexpr int SCENT_RADIUS = 40;
+static constexpr int SCENT_RADIUS = scent_diffusion::radius;
 
 static nc_color sev( const size_t level )
 {
@@ -221,28 +225,10 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
     //the block and reduce scent properties are folded into a single scent_transfer value here
     //block=0 reduce=1 normal=5
     auto &_scent_lc = m.access_cache( center.z() );
-    const int st_sy = _scent_lc.cache_y;
-    auto scent_transfer = std::vector<char>( static_cast<size_t>( _scent_lc.cache_x ) * st_sy, 0 );
+    // scent_transfer is read next to the vehicle cache, so it shares the level's shape.
+    const auto st_shape = _scent_lc.shape();
+    auto scent_transfer = std::vector<char>( static_cast<size_t>( st_shape.sx ) * st_shape.sy, 0 );
     const auto *blocked_data = _scent_lc.vehicle_obstructed_cache.data();
-    const int scent_cache_x = _scent_lc.cache_x;
-    const auto safe_st = [&]( int ax, int ay ) -> char {
-        if( ax < 0 || ax >= scent_cache_x || ay < 0 || ay >= st_sy )
-        {
-            return char( 0 );
-        }
-        return scent_transfer[ax * st_sy + ay];
-    };
-    const auto safe_bd = [&]( int ax, int ay ) -> diagonal_blocks {
-        if( ax < 0 || ax >= scent_cache_x || ay < 0 || ay >= st_sy )
-        {
-            return {};
-        }
-        return blocked_data[ax * st_sy + ay];
-    };
-
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > new_scent;
-    std::array < std::array < int, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > sum_3_scent_y;
-    std::array < std::array < char, 3 + SCENT_RADIUS * 2 >, 1 + SCENT_RADIUS * 2 > squares_used_y;
 
     // for loop constants
     const int scentmap_minx = center.x() - SCENT_RADIUS;
@@ -251,15 +237,28 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
     const int scentmap_maxy = center.y() + SCENT_RADIUS;
 
     // The new scent flag searching function. Should be wayyy faster than the old one.
-    m.scent_blockers( scent_transfer, st_sy,
+    m.scent_blockers( scent_transfer, st_shape,
                       tripoint_bub_ms( scentmap_minx - 1, scentmap_miny - 1, -OVERMAP_DEPTH ),
                       tripoint_bub_ms( scentmap_maxx + 1, scentmap_maxy + 1, OVERMAP_HEIGHT ) );
 
-    for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-        sum_3_scent_y[0][x] = 0;
-        squares_used_y[0][x] = 0;
-        sum_3_scent_y[SCENT_RADIUS * 2][x] = 0;
-        squares_used_y[SCENT_RADIUS * 2][x] = 0;
+    // Tiles off the map neither pass scent on nor hold vehicle holes.
+    diffusion_in_.clear();
+    for( int x = 0; x < scent_diffusion::window_side; ++x ) {
+        const int ax = scentmap_minx - 1 + x;
+        if( ax < 0 || ax >= st_shape.sx ) {
+            continue;
+        }
+        for( int y = 0; y < scent_diffusion::window_side; ++y ) {
+            const int ay = scentmap_miny - 1 + y;
+            if( ay < 0 || ay >= st_shape.sy ) {
+                continue;
+            }
+            const auto i = cache_layout::index( ax, ay, st_shape );
+            const auto w = scent_diffusion::window_index( x, y );
+            diffusion_in_.transfer[w] = scent_transfer[i];
+            diffusion_in_.holes[w] = ( blocked_data[i].nw ? scent_diffusion::hole_nw : 0 ) |
+                                     ( blocked_data[i].ne ? scent_diffusion::hole_ne : 0 );
+        }
     }
 
     const bool parallel_scent = parallel_enabled && parallel_scent_update;
@@ -268,12 +267,10 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
     // Pre-cache scent values and liquid flags via per-submap bulk copies.
     // The region covers (scentmap_minx-1 .. scentmap_maxx+1) x (scentmap_miny-1 .. scentmap_maxy+1),
     // which is exactly CACHE_DIM x CACHE_DIM tiles.
-    // Cache x-index == loop variable x (= abs_x - cache_x_offset);
-    // cache y-index == abs_y - cache_y_offset (i.e. y, y+1, or y+2 in the passes below).
-    constexpr int CACHE_DIM = 3 + SCENT_RADIUS * 2;
+    // Cache x-index == abs_x - cache_x_offset; cache y-index == abs_y - cache_y_offset.
+    constexpr int CACHE_DIM = scent_diffusion::window_side;
     const int cache_x_offset = scentmap_minx - 1;
     const int cache_y_offset = scentmap_miny - 1;
-    std::array<std::array<int, CACHE_DIM>, CACHE_DIM> scent_cache = {};
     std::array<std::array<bool, CACHE_DIM>, CACHE_DIM> liquid_mask = {};
 
     const int init_sm_x_min = divide_round_to_minus_infinity( cache_x_offset, SEEX );
@@ -302,127 +299,24 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
                     const int ly = ay - tile_y0;
                     const int cx = ax - cache_x_offset;
                     const int cy = ay - cache_y_offset;
-                    scent_cache[cx][cy] = sm->scent_values[lx][ly];
+                    diffusion_in_.scent[scent_diffusion::window_index( cx, cy )] = sm->scent_values[lx][ly];
                     liquid_mask[cx][cy] = sm->get_ter( point_sm_ms( lx, ly ) ).obj().has_flag( TFLAG_LIQUID );
                 }
             }
         }
     }
 
-    // Y-pass: each x column is independent — no shared writes.
-    if( parallel_scent ) {
-        parallel_for( 0, SCENT_RADIUS * 2 + 3, [&]( int x ) {
-            for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-                point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-                // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-                sum_3_scent_y[y][x] = 0;
-                squares_used_y[y][x] = 0;
-                for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                    sum_3_scent_y[y][x] += safe_st( abs.x, i ) * scent_cache[x][i - cache_y_offset];
-                    squares_used_y[y][x] += safe_st( abs.x, i );
-                }
-            }
-        } );
-    } else {
-        for( int x = 0; x < SCENT_RADIUS * 2 + 3; ++x ) {
-            for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-
-                point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-                // remember the sum of the scent val for the 3 neighboring squares that can defuse into
-                sum_3_scent_y[y][x] = 0;
-                squares_used_y[y][x] = 0;
-                for( int i = abs.y - 1; i <= abs.y + 1; ++i ) {
-                    sum_3_scent_y[y][x] += safe_st( abs.x, i ) * scent_cache[x][i - cache_y_offset];
-                    squares_used_y[y][x] += safe_st( abs.x, i );
-                }
-            }
-        }
+#if defined(CATA_SDL)
+    const auto diffused_on_gpu = cata_compute::uses_sdl_gpu_compute() &&
+                                 cata_gpu::dispatch_scent_diffusion( cata_gpu::get_device(),
+                                         diffusion_in_, diffusion_ );
+#else
+    const auto diffused_on_gpu = false;
+#endif
+    if( !diffused_on_gpu ) {
+        scent_diffusion::diffuse( diffusion_in_, diffusion_, parallel_scent );
     }
-    // implicit barrier at end of parallel_for; sum_3_scent_y is fully populated
-
-    // X-pass: reads sum_3_scent_y (now complete and read-only), writes new_scent[y][x].
-    // Each output column x is independent.
-    if( parallel_scent ) {
-        parallel_for( 1, SCENT_RADIUS * 2 + 2, [&]( int x ) {
-            for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-                const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-                int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-                int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-                //handle vehicle holes
-                if( safe_bd( abs.x, abs.y ).nw &&
-                    safe_st( abs.x + 1, abs.y + 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x + 1][y + 2];
-                }
-                if( safe_bd( abs.x, abs.y ).ne &&
-                    safe_st( abs.x - 1, abs.y + 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x - 1][y + 2];
-                }
-                if( safe_bd( abs.x - 1, abs.y - 1 ).nw &&
-                    safe_st( abs.x - 1, abs.y - 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x - 1][y];
-                }
-                if( safe_bd( abs.x + 1, abs.y - 1 ).ne &&
-                    safe_st( abs.x + 1, abs.y - 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x + 1][y];
-                }
-
-                //Lingering scent
-                const int cur = scent_cache[x][y + 1];
-                int temp_scent = cur * ( 250 - squares_used * safe_st( abs.x, abs.y ) );
-                temp_scent -= cur * safe_st( abs.x, abs.y ) * ( 45 - squares_used ) / 5;
-
-                new_scent[y][x] = ( temp_scent + total * safe_st( abs.x, abs.y ) ) / 250;
-            }
-        } );
-    } else {
-        for( int x = 1; x < SCENT_RADIUS * 2 + 2; ++x ) {
-            for( int y = 0; y < SCENT_RADIUS * 2 + 1; ++y ) {
-                const point abs( x + scentmap_minx - 1, y + scentmap_miny );
-
-                int squares_used = squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
-                int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
-
-                //handle vehicle holes
-                if( safe_bd( abs.x, abs.y ).nw &&
-                    safe_st( abs.x + 1, abs.y + 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x + 1][y + 2];
-                }
-                if( safe_bd( abs.x, abs.y ).ne &&
-                    safe_st( abs.x - 1, abs.y + 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x - 1][y + 2];
-                }
-                if( safe_bd( abs.x - 1, abs.y - 1 ).nw &&
-                    safe_st( abs.x - 1, abs.y - 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x - 1][y];
-                }
-                if( safe_bd( abs.x + 1, abs.y - 1 ).ne &&
-                    safe_st( abs.x + 1, abs.y - 1 ) == 5 ) {
-                    squares_used -= 4;
-                    total -= 4 * scent_cache[x + 1][y];
-                }
 
-                //Lingering scent
-                const int cur = scent_cache[x][y + 1];
-                int temp_scent = cur * ( 250 - squares_used * safe_st( abs.x, abs.y ) );
-                temp_scent -= cur * safe_st( abs.x, abs.y ) * ( 45 - squares_used ) / 5;
-
-                new_scent[y][x] = ( temp_scent + total * safe_st( abs.x, abs.y ) ) / 250;
-            }
-        }
-    }
-    // implicit barrier; new_scent is fully populated.
     // Write-back: batch by submap to replace O(SCENT_RADIUS²) MAPBUFFER lookups with O(num_submaps).
     // liquid_mask was built during the cache-init pass, so no per-tile has_flag calls needed here.
     const bool center_is_liquid = liquid_mask[center.x() - cache_x_offset][center.y() - cache_y_offset];
@@ -454,7 +348,7 @@ void scent_map::update( const tripoint_bub_ms &center, map &m )
                     if( ( center_is_liquid && rl_dist( center.xy(), point_bub_ms( ax, ay ) ) <= 8 ) ||
                         !liquid_mask[cx][cy] ) {
                         sm->scent_values[ax - tile_x0][ay - tile_y0] =
-                            new_scent[ay - scentmap_miny][ax - scentmap_minx + 1];
+                            diffusion_.diffused[scent_diffusion::out_index( ax - scentmap_minx, ay - scentmap_miny )];
                     }
                 }
             }
@@ -10,6 +10,7 @@
 #include "coordinates.h"
 #include "enums.h" // IWYU pragma: keep
 #include "point.h"
+#include "scent_diffusion.h"
 #include "type_id.h"
 
 static constexpr int SCENT_MAP_Z_REACH = 1;
@@ -53,6 +54,10 @@ class scent_map
         // Lets decay() skip the full mapbuffer scan for each dimension.
         std::map<dimension_id, std::set<tripoint_abs_sm>> scent_submaps_;
 
+        // Inputs and result of the diffusion step, kept between turns for their allocation.
+        scent_diffusion::window diffusion_in_;
+        scent_diffusion::step diffusion_;
+
     public:
         scent_map( const game &g, map &m ) : gm( g ), m_( m ) { }
 
@@ -1,13 +1,38 @@
 #if defined(TILES)
 #include "sdl_font.h"
+
+#include <algorithm>
+
 #include "output.h"
 #include "platform_win.h"
 #include "string_utils.h"
 #include "hsv_color.h"
 #include "sdl_utils.h"
+#include "sprite_batch.h"
 
 #define dbg(x) DebugLogFL((x),DC::SDL)
 
+namespace
+{
+
+sprite_batch text_batch;
+
+// Glyphs are rendered white and tinted, so one atlas entry serves every color.
+constexpr SDL_Color glyph_white = { 255, 255, 255, 255 };
+constexpr int atlas_page_size = 1024;
+
+} // namespace
+
+void begin_text_batch( const SDL_Renderer_Ptr &renderer )
+{
+    text_batch.begin( renderer );
+}
+
+void end_text_batch()
+{
+    text_batch.end();
+}
+
 // SDL3_ttf 3.x: TTF_OpenFontIndex removed; use TTF_OpenFontWithProperties with face index property
 static TTF_Font *open_font_index( const std::string &f, int size, int faceIndex )
 {
@@ -329,14 +354,12 @@ CachedTTFFont::CachedTTFFont(
     TTF_SetFontStyle( font.get(), TTF_STYLE_NORMAL );
 }
 
-SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
-        const std::string &ch,
-        const int color )
+SDL_Surface_Ptr CachedTTFFont::create_glyph( const std::string &ch ) const
 {
     SDL_Surface_Ptr sglyph(
         fontblending
-        ? TTF_RenderText_Blended( font.get(), ch.c_str(), 0, windowsPalette[color] )
-        : TTF_RenderText_Solid( font.get(), ch.c_str(), 0, windowsPalette[color] )
+        ? TTF_RenderText_Blended( font.get(), ch.c_str(), 0, glyph_white )
+        : TTF_RenderText_Solid( font.get(), ch.c_str(), 0, glyph_white )
     );
     if( !sglyph ) {
         dbg( DL::Error ) << "Failed to create glyph for " << ch << ": " << SDL_GetError();
@@ -361,12 +384,48 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
         src_rect.h = dst_rect.h;
     }
 
-    if( !printErrorIf( !SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ),
-                       "SDL_BlitSurface failed" ) ) {
-        sglyph = std::move( surface );
+    if( printErrorIf( !SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ),
+                      "SDL_BlitSurface failed" ) ) {
+        return nullptr;
+    }
+    return surface;
+}
+
+CachedTTFFont::cached_t CachedTTFFont::add_to_atlas( const SDL_Renderer_Ptr &renderer,
+        const SDL_Surface_Ptr &glyph )
+{
+    const int page_w = std::max( atlas_page_size, glyph->w );
+    const int page_h = std::max( atlas_page_size, height );
+    if( !atlas_pages.empty() && atlas_cursor.x + glyph->w > atlas_pages.back()->w ) {
+        atlas_cursor = point( 0, atlas_cursor.y + height );
+    }
+    if( atlas_pages.empty() || atlas_cursor.y + height > atlas_pages.back()->h ||
+        glyph->w > atlas_pages.back()->w ) {
+        SDL_Texture_Ptr page = CreateTexture( renderer, SDL_PIXELFORMAT_RGBA32,
+                                              SDL_TEXTUREACCESS_STATIC, page_w, page_h );
+        if( !page ) {
+            return {};
+        }
+        // Fresh textures hold undefined pixels, and glyphs don't cover their whole cell row.
+        std::vector<Uint32> blank( static_cast<size_t>( page_w ) * page_h, 0 );
+        printErrorIf( !SDL_UpdateTexture( page.get(), nullptr, blank.data(), page_w * 4 ),
+                      "SDL_UpdateTexture failed" );
+        SetTextureBlendMode( page, SDL_BLENDMODE_BLEND );
+        atlas_pages.push_back( std::move( page ) );
+        atlas_cursor = point_zero;
     }
 
-    return CreateTextureFromSurface( renderer, sglyph );
+    const SDL_Rect dst = { atlas_cursor.x, atlas_cursor.y, glyph->w, glyph->h };
+    if( printErrorIf( !SDL_UpdateTexture( atlas_pages.back().get(), &dst, glyph->pixels, glyph->pitch ),
+                      "SDL_UpdateTexture failed" ) ) {
+        return {};
+    }
+    atlas_cursor.x += glyph->w;
+    return cached_t{
+        static_cast<int>( atlas_pages.size() ) - 1,
+        SDL_FRect{ float( dst.x ), float( dst.y ), float( dst.w ), float( dst.h ) },
+        glyph->w
+    };
 }
 
 bool CachedTTFFont::isGlyphProvided( const std::string &ch ) const
@@ -378,30 +437,30 @@ void CachedTTFFont::OutputChar( const SDL_Renderer_Ptr &renderer, const Geometry
                                 const std::string &ch, point p,
                                 unsigned char color, const float opacity )
 {
-    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
+    auto it = glyph_cache_map.find( ch );
     if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry {
-            create_glyph( renderer, key.codepoints, key.color ),
-            static_cast<int>( width * utf8_wrapper( key.codepoints ).display_width() )
-        };
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
+        const SDL_Surface_Ptr glyph = create_glyph( ch );
+        it = glyph_cache_map.emplace( ch, glyph ? add_to_atlas( renderer, glyph ) : cached_t{} ).first;
     }
     const cached_t &value = it->second;
 
-    if( !value.texture ) {
+    if( value.page < 0 ) {
         // Nothing we can do here )-:
         return;
     }
+    const SDL_Texture_Ptr &page = atlas_pages[value.page];
+    const SDL_Color &tint = windowsPalette[color & 0xf];
     const SDL_FRect frect{ float( p.x ), float( p.y ), float( value.width ), float( height ) };
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), opacity * 255.0f );
-    }
-    RenderCopy( renderer, value.texture, nullptr, &frect );
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), 255 );
+    if( text_batch.active() ) {
+        text_batch.add( page.get(), SDL_BLENDMODE_BLEND, value.src, frect, 0.0, SDL_FLIP_NONE,
+                        SDL_FColor{ tint.r / 255.0f, tint.g / 255.0f, tint.b / 255.0f, opacity } );
+        return;
     }
+    SDL_SetTextureColorMod( page.get(), tint.r, tint.g, tint.b );
+    SDL_SetTextureAlphaMod( page.get(), opacity * 255.0f );
+    RenderCopy( renderer, page, &value.src, &frect );
+    SDL_SetTextureColorMod( page.get(), 255, 255, 255 );
+    SDL_SetTextureAlphaMod( page.get(), 255 );
 }
 
 BitmapFont::BitmapFont(
@@ -8,6 +8,7 @@
 #include <array>
 #include <map>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 #include <string>
 
@@ -17,7 +18,6 @@
 #include "debug.h"
 #include "font_loader.h"
 #include "point.h"
-#include "hash_utils.h"
 #include "sdl_wrappers.h"
 
 using palette_array = std::array<SDL_Color, color_loader<SDL_Color>::COLOR_NAMES_COUNT>;
@@ -67,7 +67,14 @@ class Font
 };
 using Font_Ptr = std::unique_ptr<Font>;
 
-/// Font implementation on a TrueType font. Its glyphs are cached.
+/// Glyphs of atlas backed fonts output between these calls are queued and drawn
+/// together, one call per atlas page, when the batch ends. Only the glyphs are
+/// deferred, so anything they could overlap must not be drawn inside the batch.
+void begin_text_batch( const SDL_Renderer_Ptr &renderer );
+void end_text_batch();
+
+/// Font implementation on a TrueType font. Its glyphs are rendered once in white,
+/// packed into atlas pages and tinted with the curses color when drawn.
 class CachedTTFFont : public Font
 {
     public:
@@ -83,36 +90,22 @@ class CachedTTFFont : public Font
                          point p,
                          unsigned char color, float opacity = 1.0f ) override;
     protected:
-        SDL_Texture_Ptr create_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch, int color );
-
-        TTF_Font_Ptr font;
-        // Maps (character code, color) to SDL_Texture*
-
-        struct key_t {
-            std::string   codepoints;
-            unsigned char color;
-
-            std::pair<std::string, unsigned char> as_pair() const {
-                return std::make_pair( codepoints, color );
-            }
-
-            friend bool operator==( const key_t &lhs, const key_t &rhs ) noexcept {
-                return lhs.as_pair() == rhs.as_pair();
-            }
-        };
-
-        struct key_t_hash {
-            size_t operator()( const key_t &k ) const {
-                return cata::auto_hash<std::pair<std::string, unsigned char>>()( k.as_pair() );
-            }
-        };
-
         struct cached_t {
-            SDL_Texture_Ptr texture;
-            int          width;
+            // Index into atlas_pages, or -1 if the glyph could not be rendered.
+            int page = -1;
+            SDL_FRect src = {};
+            int width = 0;
         };
 
-        std::unordered_map<key_t, cached_t, key_t_hash> glyph_cache_map;
+        SDL_Surface_Ptr create_glyph( const std::string &ch ) const;
+        cached_t add_to_atlas( const SDL_Renderer_Ptr &renderer, const SDL_Surface_Ptr &glyph );
+
+        TTF_Font_Ptr font;
+        // Maps character code to its place in the atlas
+        std::unordered_map<std::string, cached_t> glyph_cache_map;
+        std::vector<SDL_Texture_Ptr> atlas_pages;
+        // Next free cell of the last page; glyphs are all one row high.
+        point atlas_cursor;
 
         const bool fontblending;
 };
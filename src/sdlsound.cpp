@@ -23,6 +23,7 @@
 #include "rng.h"
 #include "sdl_wrappers.h"
 #include "sounds.h"
+#include "startup_timeline.h"
 #include "units_angle.h"
 
 #define dbg(x) DebugLogFL((x),DC::SDL)
@@ -824,6 +825,7 @@ auto sfx::get_channel_volume( const channel channel ) -> int
 
 auto load_soundset() -> void
 {
+    startup_timeline::span timing( "Soundset", "sound" );
     const std::string default_path     = PATH_INFO::defaultsounddir();
     const std::string default_soundpack = "basic";
     std::string current_soundpack       = get_option<std::string>( "SOUNDPACKS" );
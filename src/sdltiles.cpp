@@ -25,9 +25,11 @@
 #include <unordered_map>
 #include <vector>
 #include "avatar.h"
+#include "cached_options.h"
 #include "cata_tiles.h"
 #include "cata_utility.h"
 #include "catacharset.h"
+#include "catalua.h"
 #include "color.h"
 #include "color_loader.h"
 #include "cuboid_rectangle.h"
@@ -36,6 +38,7 @@
 #include "dynamic_atlas.h"
 #include "filesystem.h"
 #include "font_loader.h"
+#include "frame_timing.h"
 #include "game.h"
 #include "game_ui.h"
 #include "get_version.h"
@@ -68,6 +71,7 @@
 #include "sdl_font.h"
 #include "sdlsound.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "uistate.h"
 #include "ui_manager.h"
 #include "wcwidth.h"
@@ -426,6 +430,8 @@ inline const SDL_Color &color_as_sdl( const unsigned char color )
     return windowsPalette[color];
 }
 
+static void draw_frame_timing_overlay();
+
 #if defined(__ANDROID__)
 void draw_terminal_size_preview();
 void draw_quick_shortcuts();
@@ -524,7 +530,14 @@ void refresh_display()
     draw_quick_shortcuts();
     draw_virtual_joystick();
 #endif
-    SDL_RenderPresent( renderer.get() );
+    if( frame_timing::enabled() ) {
+        draw_frame_timing_overlay();
+    }
+    {
+        ZoneScopedPhaseN( present, "SDL_RenderPresent" );
+        SDL_RenderPresent( renderer.get() );
+    }
+    frame_timing::end_frame();
     SetRenderTarget( renderer, display_buffer );
 }
 
@@ -802,6 +815,100 @@ static point draw_string( Font &font,
     return p;
 }
 
+// Drawn straight to the window on present, so it never ends up in the display buffer.
+static void draw_frame_timing_overlay()
+{
+    using frame_timing::group;
+    static constexpr std::array<unsigned char, frame_timing::num_groups> group_colors = { {
+            catacurses::black + 8, catacurses::yellow, catacurses::green, catacurses::cyan,
+            catacurses::magenta
+        }
+    };
+    static constexpr unsigned char other_color = catacurses::white;
+    static constexpr unsigned char text_color = catacurses::white + 8;
+    // The graph tops out at two stutter thresholds; longer frames are clipped.
+    static constexpr float graph_ms = 2.0f * frame_timing::frame_history::stutter_min_ms;
+    static constexpr int bar_width = 2;
+    static constexpr int graph_height = 100;
+    static constexpr int margin = 4;
+
+    if( !font ) {
+        return;
+    }
+    const frame_timing::frame_history &frames = frame_timing::history();
+    const std::deque<frame_timing::frame_sample> &samples = frames.samples();
+    const std::vector<std::pair<const char *, float>> slowest = frames.slowest_phases( 3 );
+
+    const int line_h = font->height;
+    const int panel_w = static_cast<int>( frame_timing::frame_history::capacity ) * bar_width +
+                        2 * margin;
+    const int panel_h = ( 2 + static_cast<int>( slowest.size() ) ) * line_h + graph_height + 3 * margin;
+    const point origin( std::max( 0, WindowWidth - panel_w - margin ), margin );
+    geometry->rect( renderer, origin, panel_w, panel_h, color_as_sdl( catacurses::black ) );
+
+    const float frame_count = std::max( 1.0f, static_cast<float>( samples.size() ) );
+    point p = origin + point( margin, margin );
+    draw_string( *font, renderer, geometry,
+                 string_format( "p50 %.1f  p95 %.1f  p99 %.1f ms  stutters %d",
+                                frames.percentile( 0.5f ), frames.percentile( 0.95f ),
+                                frames.percentile( 0.99f ), frames.stutters() ), p, text_color );
+    p.y += line_h;
+    // Legend, with the average time of each group per frame
+    point legend = p;
+    for( size_t g = 0; g < frame_timing::num_groups; ++g ) {
+        float total = 0.0f;
+        for( const frame_timing::frame_sample &f : samples ) {
+            total += f.group_ms[g];
+        }
+        legend = draw_string( *font, renderer, geometry,
+                              string_format( "%s %.1f  ", frame_timing::group_name( static_cast<group>( g ) ),
+                                             total / frame_count ), legend, group_colors[g] );
+    }
+    draw_string( *font, renderer, geometry, "other", legend, other_color );
+    p.y += line_h;
+    for( const auto &[name, ms] : slowest ) {
+        draw_string( *font, renderer, geometry,
+                     string_format( "%s %.2f ms/frame", name, ms / frame_count ), p, text_color );
+        p.y += line_h;
+    }
+
+    p.y += margin;
+    const int graph_bottom = p.y + graph_height;
+    const auto to_px = []( const float ms ) {
+        return static_cast<int>( ms * graph_height / graph_ms );
+    };
+    // Reference lines at 60 and 30 frames per second
+    for( const float ms : { 1000.0f / 60.0f, frame_timing::frame_history::stutter_min_ms } ) {
+        geometry->horizontal_line( renderer, point( p.x, graph_bottom - to_px( ms ) ),
+                                   p.x + panel_w - 2 * margin, 1, color_as_sdl( catacurses::black + 8 ) );
+    }
+    int x = p.x + ( static_cast<int>( frame_timing::frame_history::capacity - samples.size() ) * bar_width );
+    for( const frame_timing::frame_sample &f : samples ) {
+        float stacked = 0.0f;
+        const auto add_segment = [&]( const float ms, const unsigned char color ) {
+            const int from = std::min( graph_height, to_px( stacked ) );
+            stacked += ms;
+            const int to = std::min( graph_height, to_px( stacked ) );
+            if( to > from ) {
+                geometry->rect( renderer, point( x, graph_bottom - to ), bar_width, to - from,
+                                color_as_sdl( color ) );
+            }
+        };
+        // Busy time first, so idle input waits are what gets clipped.
+        float accounted = f.group_ms[static_cast<size_t>( group::input )];
+        for( size_t g = 0; g < frame_timing::num_groups; ++g ) {
+            if( g != static_cast<size_t>( group::input ) ) {
+                add_segment( f.group_ms[g], group_colors[g] );
+                accounted += f.group_ms[g];
+            }
+        }
+        add_segment( std::max( 0.0f, f.total_ms - accounted ), other_color );
+        add_segment( f.group_ms[static_cast<size_t>( group::input )],
+                     group_colors[static_cast<size_t>( group::input )] );
+        x += bar_width;
+    }
+}
+
 void draw_sdl_text_outlined( const sdl_text_outline_options &opts )
 {
     if( !font || !renderer || opts.text.empty() ) { return; }
@@ -819,6 +926,132 @@ void draw_sdl_text_outlined( const sdl_text_outline_options &opts )
                  static_cast<unsigned char>( opts.text_color ) );
 }
 
+auto cata_tiles::om_chunk_signature( const tripoint &chunk,
+                                     const bool has_debug_vision ) const -> std::vector<int>
+{
+    const tripoint_abs_omt origin( chunk.x * om_chunk_size, chunk.y * om_chunk_size, chunk.z );
+    std::vector<int> signature;
+    // Bordering terrain decides how connected terrain such as roads is rotated.
+    signature.reserve( ( om_chunk_size + 2 ) * ( om_chunk_size + 2 ) + om_chunk_size * om_chunk_size );
+    for( int y = -1; y <= om_chunk_size; ++y ) {
+        for( int x = -1; x <= om_chunk_size; ++x ) {
+            signature.push_back( ACTIVE_OVERMAP_BUFFER.ter( origin + point( x, y ) ).to_i() );
+        }
+    }
+    for( int y = 0; y < om_chunk_size; ++y ) {
+        for( int x = 0; x < om_chunk_size; ++x ) {
+            const tripoint_abs_omt omp = origin + point( x, y );
+            const bool see = has_debug_vision || ACTIVE_OVERMAP_BUFFER.seen( omp );
+            signature.push_back( ( see ? 1 : 0 ) | ( ACTIVE_OVERMAP_BUFFER.is_explored( omp ) ? 2 : 0 ) );
+        }
+    }
+    return signature;
+}
+
+void cata_tiles::draw_om_terrain_chunks( const tripoint_abs_omt &corner_NW, const point tiles,
+        const bool has_debug_vision, const std::string &default_oter,
+        const std::string &display_oter )
+{
+    ZoneScoped;
+    const om_chunk_context context{
+        .tile_width = tile_width,
+        .tile_height = tile_height,
+        .season = season_of_year( calendar::turn ),
+        .forest_trails = uistate.overmap_show_forest_trails,
+        .default_oter = default_oter,
+        .display_oter = display_oter,
+    };
+    if( context != om_chunks_context ) {
+        om_chunks.clear();
+        om_chunks_context = context;
+    }
+    ++om_chunk_frame;
+
+    const point chunk_min( divide_round_down( corner_NW.x(), om_chunk_size ),
+                           divide_round_down( corner_NW.y(), om_chunk_size ) );
+    const point chunk_max( divide_round_down( corner_NW.x() + tiles.x - 1, om_chunk_size ),
+                           divide_round_down( corner_NW.y() + tiles.y - 1, om_chunk_size ) );
+    const point chunk_pixels( om_chunk_size * tile_width, om_chunk_size * tile_height );
+    int redrawn = 0;
+
+    for( int cy = chunk_min.y; cy <= chunk_max.y; ++cy ) {
+        for( int cx = chunk_min.x; cx <= chunk_max.x; ++cx ) {
+            const tripoint chunk_pos( cx, cy, corner_NW.z() );
+            const tripoint_abs_omt origin( cx * om_chunk_size, cy * om_chunk_size, corner_NW.z() );
+            om_chunk &chunk = om_chunks[chunk_pos];
+            chunk.last_used = om_chunk_frame;
+
+            std::vector<int> signature = om_chunk_signature( chunk_pos, has_debug_vision );
+            if( !chunk.texture || chunk.signature != signature ) {
+                if( !chunk.texture ) {
+                    chunk.texture = CreateTexture( renderer, sdl_color_pixel_format,
+                                                   SDL_TEXTUREACCESS_TARGET, chunk_pixels.x, chunk_pixels.y );
+                    if( !chunk.texture ) {
+                        continue;
+                    }
+                    // Drawn over a cleared view, so it's copied as is.
+                    SetTextureBlendMode( chunk.texture, SDL_BLENDMODE_NONE );
+                }
+                chunk.signature = std::move( signature );
+                redrawn++;
+
+                const auto state = sdl_save_render_state( renderer.get() );
+                const point_bub_ms view_o = o;
+                const point view_op = op;
+                const point view_tiles( screentile_width, screentile_height );
+                SetRenderTarget( renderer, chunk.texture );
+                SDL_SetRenderClipRect( renderer.get(), nullptr );
+                SetRenderDrawColor( renderer, 0, 0, 0, 0 );
+                RenderClear( renderer );
+                o = origin.xy().reinterpret_as<point_bub_ms>();
+                op = point_zero;
+                screentile_width = om_chunk_size;
+                screentile_height = om_chunk_size;
+                for( int y = 0; y < om_chunk_size; ++y ) {
+                    for( int x = 0; x < om_chunk_size; ++x ) {
+                        const tripoint_abs_omt omp = origin + point( x, y );
+                        const bool see = has_debug_vision || ACTIVE_OVERMAP_BUFFER.seen( omp );
+                        std::string id = "unknown_terrain";
+                        int rotation = 0;
+                        int subtile = -1;
+                        if( see ) {
+                            id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
+                            if( !display_oter.empty() && id == default_oter ) {
+                                id = display_oter;
+                            }
+                        }
+                        const lit_level ll = ACTIVE_OVERMAP_BUFFER.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
+                        auto [bgCol, fgCol] = get_overmap_color( ACTIVE_OVERMAP_BUFFER, omp );
+                        const tile_search_params tile { id, C_OVERMAP_TERRAIN, "overmap_terrain", subtile, rotation };
+                        draw_from_id_string( tile, omp.reinterpret_as<tripoint_bub_ms>(), bgCol, fgCol,
+                                             ll, false, 0, false );
+                    }
+                }
+                o = view_o;
+                op = view_op;
+                screentile_width = view_tiles.x;
+                screentile_height = view_tiles.y;
+                sdl_restore_render_state( renderer.get(), state );
+            }
+
+            const point screen = player_to_screen( origin.xy().reinterpret_as<point_bub_ms>() );
+            const SDL_FRect dst{ static_cast<float>( screen.x ), static_cast<float>( screen.y ),
+                                 static_cast<float>( chunk_pixels.x ), static_cast<float>( chunk_pixels.y ) };
+            RenderCopy( renderer, chunk.texture, nullptr, &dst );
+        }
+    }
+
+    // Keep what was panned away from for a while, but not indefinitely.
+    const size_t visible = static_cast<size_t>( chunk_max.x - chunk_min.x + 1 ) *
+                           ( chunk_max.y - chunk_min.y + 1 );
+    if( om_chunks.size() > 2 * visible ) {
+        std::erase_if( om_chunks, [&]( const auto & entry ) {
+            return entry.second.last_used != om_chunk_frame;
+        } );
+    }
+    TracyPlot( "Overmap Chunks Redrawn", static_cast<int64_t>( redrawn ) );
+}
+
 void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bool blink )
 {
     if( !g ) {
@@ -833,6 +1066,10 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
     }
 #endif
 
+#if defined(DYNAMIC_ATLAS)
+    tileset_ptr->begin_frame();
+#endif
+
     int width = OVERMAP_WINDOW_TERM_WIDTH * font->width;
     int height = OVERMAP_WINDOW_TERM_HEIGHT * font->height;
 
@@ -909,62 +1146,74 @@ void cata_tiles::draw_om( point dest, const tripoint_abs_omt &center_abs_omt, bo
                                             ? active_region_settings.display_oter.str()
                                             : std::string{};
 
+    // Plain terrain is composited from cached chunks; what draws beyond a tile
+    // or differs between frames is still drawn tile by tile.
+    // Occlusion retraction shifts sprites by their distance to the view centre.
+    const bool retracts = prevent_occlusion != 0 && ( prevent_occlusion_retract || prevent_occlusion_transp );
+    const bool cache_terrain = !tile_iso && !overmap_transparency && !viewing_weather && !retracts;
+    if( cache_terrain ) {
+        draw_om_terrain_chunks( corner_NW, point( max_col, max_row ), has_debug_vision,
+                                om_default_oter_str, om_display_oter_str );
+    }
+
     for( int row = min_row; row < max_row; row++ ) {
         for( int col = min_col; col < max_col; col++ ) {
             const tripoint_abs_omt omp = corner_NW + point( col, row );
 
             const bool see = has_debug_vision || ACTIVE_OVERMAP_BUFFER.seen( omp );
             const bool los = see && you.overmap_los( omp, sight_points );
-            // the full string from the ter_id including _north etc.
-            TILE_CATEGORY category = TILE_CATEGORY::C_OVERMAP_TERRAIN;
-            std::string id;
-            int rotation = 0;
-            int subtile = -1;
-
-            if( viewing_weather ) {
-                const tripoint_abs_omt omp_sky( omp.xy(), OVERMAP_HEIGHT );
-                if( uistate.overmap_debug_weather ||
-                    you.overmap_los( omp_sky, sight_points * 2 ) ) {
-                    id = overmap_ui::get_weather_at_point( omp_sky.xy() ).c_str();
-                    category = TILE_CATEGORY::C_OVERMAP_WEATHER;
+            if( !cache_terrain ) {
+                // the full string from the ter_id including _north etc.
+                TILE_CATEGORY category = TILE_CATEGORY::C_OVERMAP_TERRAIN;
+                std::string id;
+                int rotation = 0;
+                int subtile = -1;
+
+                if( viewing_weather ) {
+                    const tripoint_abs_omt omp_sky( omp.xy(), OVERMAP_HEIGHT );
+                    if( uistate.overmap_debug_weather ||
+                        you.overmap_los( omp_sky, sight_points * 2 ) ) {
+                        id = overmap_ui::get_weather_at_point( omp_sky.xy() ).c_str();
+                        category = TILE_CATEGORY::C_OVERMAP_WEATHER;
+                    }
                 }
-            }
-            if( id.empty() ) {
-                if( see ) {
-                    id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
-                    if( om_has_display_oter && id == om_default_oter_str ) {
-                        id = om_display_oter_str;
+                if( id.empty() ) {
+                    if( see ) {
+                        id = get_omt_id_rotation_and_subtile( omp, rotation, subtile );
+                        if( om_has_display_oter && id == om_default_oter_str ) {
+                            id = om_display_oter_str;
+                        }
+                    } else {
+                        id = "unknown_terrain";
                     }
-                } else {
-                    id = "unknown_terrain";
                 }
-            }
 
-            if( overmap_transparency && category != TILE_CATEGORY::C_OVERMAP_WEATHER ) {
-                int z_offset = 0;
-                while( id == "open_air" ) {
-                    z_offset++;
-                    const tripoint_abs_omt lower_omp = omp + tripoint( 0, 0, -z_offset );
-                    const bool lower_see = has_debug_vision || ACTIVE_OVERMAP_BUFFER.seen( lower_omp );
-                    if( !lower_see ) {
-                        //actually really strange situation when above overmap is explored, but below one isn't
-                        //so let's account for this just in case, drawing highest seen tile
-                        z_offset--;
-                        break;
+                if( overmap_transparency && category != TILE_CATEGORY::C_OVERMAP_WEATHER ) {
+                    int z_offset = 0;
+                    while( id == "open_air" ) {
+                        z_offset++;
+                        const tripoint_abs_omt lower_omp = omp + tripoint( 0, 0, -z_offset );
+                        const bool lower_see = has_debug_vision || ACTIVE_OVERMAP_BUFFER.seen( lower_omp );
+                        if( !lower_see ) {
+                            //actually really strange situation when above overmap is explored, but below one isn't
+                            //so let's account for this just in case, drawing highest seen tile
+                            z_offset--;
+                            break;
+                        }
+                        id = get_omt_id_rotation_and_subtile( lower_omp, rotation, subtile );
                     }
-                    id = get_omt_id_rotation_and_subtile( lower_omp, rotation, subtile );
-                }
-                draw_om_tile_recursively( omp + tripoint( 0, 0, -z_offset ), id, rotation, subtile, z_offset );
-            } else {
-                const lit_level ll = ACTIVE_OVERMAP_BUFFER.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
+                    draw_om_tile_recursively( omp + tripoint( 0, 0, -z_offset ), id, rotation, subtile, z_offset );
+                } else {
+                    const lit_level ll = ACTIVE_OVERMAP_BUFFER.is_explored( omp ) ? lit_level::LOW : lit_level::LIT;
 
-                auto [bgCol, fgCol] = get_overmap_color( ACTIVE_OVERMAP_BUFFER, omp );
+                    auto [bgCol, fgCol] = get_overmap_color( ACTIVE_OVERMAP_BUFFER, omp );
 
-                // light level is now used for choosing between grayscale filter and normal lit tiles.
-                const tile_search_params tile { id, category, "overmap_terrain", subtile, rotation };
-                draw_from_id_string( tile, omp.reinterpret_as<tripoint_bub_ms>(), bgCol, fgCol,
-                                     ll, false, 0, false,
-                                     height_3d );
+                    // light level is now used for choosing between grayscale filter and normal lit tiles.
+                    const tile_search_params tile { id, category, "overmap_terrain", subtile, rotation };
+                    draw_from_id_string( tile, omp.reinterpret_as<tripoint_bub_ms>(), bgCol, fgCol,
+                                         ll, false, 0, false,
+                                         height_3d );
+                }
             }
 
             if( blink && uistate.overmap_highlighted_omts.contains( omp ) ) {
@@ -1466,6 +1715,9 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
     // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
     static const std::string space_string = " ";
 
+    // Glyphs never leave their own cell, so drawing them after every background
+    // looks the same as interleaving them, and lets them share draw calls.
+    begin_text_batch( renderer );
     bool update = false;
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
@@ -1587,6 +1839,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, point offs
             }
         }
     }
+    end_text_batch();
     win->draw = false; //We drew the window, mark it as so
     //Keeping track of last drawn window and tilemode zoom level
     ::winBuffer = w.weak_ptr();
@@ -3935,7 +4188,8 @@ void input_manager::set_timeout( const int t )
 
 void input_manager::pump_events()
 {
-    if( test_mode ) {
+    // Long loops pump events to stay responsive; off the main thread there is nothing to pump.
+    if( test_mode || is_pool_worker_thread() ) {
         return;
     }
 
@@ -3965,16 +4219,22 @@ input_event input_manager::get_input_event()
     }
 
     if( inputdelay < 0 ) {
-        ZoneScopedN( "sdl_input_wait_blocking" );
+        ZoneScopedPhaseN( input, "sdl_input_wait_blocking" );
+        // Spend the wait on Lua garbage before sleeping, at most one collection cycle per wait.
+        auto lua_gc_pending = true;
         do {
             CheckMessages();
             if( last_input.type != input_event_t::error ) {
                 break;
             }
-            SDL_Delay( 1 );
+            if( lua_gc_pending ) {
+                lua_gc_pending = cata::step_lua_gc_while_idle();
+            } else {
+                SDL_Delay( 1 );
+            }
         } while( last_input.type == input_event_t::error );
     } else if( inputdelay > 0 ) {
-        ZoneScopedN( "sdl_input_wait_timed" );
+        ZoneScopedPhaseN( input, "sdl_input_wait_timed" );
         Uint64 starttime = SDL_GetTicks();
         Uint64 endtime = 0;
         bool timedout = false;
@@ -3991,7 +4251,7 @@ input_event input_manager::get_input_event()
             }
         } while( !timedout );
     } else {
-        ZoneScopedN( "sdl_input_poll_once" );
+        ZoneScopedPhaseN( input, "sdl_input_poll_once" );
         CheckMessages();
     }
 
@@ -0,0 +1,86 @@
+// GPU implementation of scent_diffusion::diffuse.
+// One thread per diffused tile; the sums the CPU shares between columns are taken
+// directly over the 3x3 neighbourhood, which gives the same integers.
+//
+// Buffers are one column after another, as in scent_diffusion.h:
+//   window arrays: idx = x * window_side + y, (0, 0) at the corner of the border
+//   diffused:      idx = x * out_side + y, window tile (x + 1, y + 1)
+//
+// Binding layout (SDL3 GPU / shadercross HLSL conventions):
+//   space0  read-only storage buffers  (t registers)
+//   space1  read-write storage buffers (u registers)
+//   space2  uniform / cbuffer          (b registers)
+
+static const int HOLE_NW = 1;
+static const int HOLE_NE = 2;
+
+cbuffer Constants : register(b0, space2)
+{
+    int window_side;
+    int out_side;
+    int2 _pad;
+};
+
+StructuredBuffer<int> scent    : register(t0, space0);
+StructuredBuffer<int> transfer : register(t1, space0);
+StructuredBuffer<int> holes    : register(t2, space0);
+RWStructuredBuffer<int> diffused : register(u0, space1);
+
+int scent_at( int x, int y )
+{
+    return scent[x * window_side + y];
+}
+
+int transfer_at( int x, int y )
+{
+    return transfer[x * window_side + y];
+}
+
+int holes_at( int x, int y )
+{
+    return holes[x * window_side + y];
+}
+
+// A vehicle wall across a diagonal keeps the tile beyond it from diffusing in.
+int hole( int tile_holes, int bit, int transfer_beyond )
+{
+    return ( tile_holes & bit ) != 0 && transfer_beyond == 5 ? 1 : 0;
+}
+
+[numthreads(8, 8, 1)]
+void main( uint3 dispatch_thread_id : SV_DispatchThreadID )
+{
+    int ox = int( dispatch_thread_id.x );
+    int oy = int( dispatch_thread_id.y );
+    if( ox >= out_side || oy >= out_side ) {
+        return;
+    }
+    int x = ox + 1;
+    int y = oy + 1;
+
+    int squares_used = 0;
+    int total = 0;
+    for( int dx = -1; dx <= 1; ++dx ) {
+        for( int dy = -1; dy <= 1; ++dy ) {
+            int st = transfer_at( x + dx, y + dy );
+            squares_used += st;
+            total += st * scent_at( x + dx, y + dy );
+        }
+    }
+
+    int se = hole( holes_at( x, y ), HOLE_NW, transfer_at( x + 1, y + 1 ) );
+    int sw = hole( holes_at( x, y ), HOLE_NE, transfer_at( x - 1, y + 1 ) );
+    int nw = hole( holes_at( x - 1, y - 1 ), HOLE_NW, transfer_at( x - 1, y - 1 ) );
+    int ne = hole( holes_at( x + 1, y - 1 ), HOLE_NE, transfer_at( x + 1, y - 1 ) );
+    squares_used -= 4 * ( se + sw + nw + ne );
+    total -= 4 * ( se * scent_at( x + 1, y + 1 ) + sw * scent_at( x - 1, y + 1 ) +
+                   nw * scent_at( x - 1, y - 1 ) + ne * scent_at( x + 1, y - 1 ) );
+
+    // Lingering scent
+    int cur = scent_at( x, y );
+    int st = transfer_at( x, y );
+    int temp_scent = cur * ( 250 - squares_used * st );
+    temp_scent -= cur * st * ( 45 - squares_used ) / 5;
+
+    diffused[ox * out_side + oy] = ( temp_scent + total * st ) / 250;
+}
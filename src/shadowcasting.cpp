@@ -7,6 +7,7 @@
 #include <mutex>
 #include <cstring>
 #include <cstdint>
+#include <vector>
 
 #include "cached_options.h"
 #include "cata_unreachable.h"
@@ -242,7 +243,7 @@ static void castLight(
     Out *output_cache,
     const float *input_array,
     const diagonal_blocks *blocked_array,
-    int sx, int sy,
+    const cache_layout::grid_shape &shape,
     point_bub_ms offset, int offset_distance, float numerator,
     const light_model &model,
     octant_xform xf,
@@ -261,15 +262,15 @@ static void castLight(
         switch( quad )
         {
             case quadrant::NW:
-                return blocked_array[p.x * sy + p.y].nw;
+                return blocked_array[cache_layout::index( p.x, p.y, shape )].nw;
             case quadrant::NE:
-                return blocked_array[p.x * sy + p.y].ne;
+                return blocked_array[cache_layout::index( p.x, p.y, shape )].ne;
             case quadrant::SE:
-                return p.x < sx - 1 && p.y < sy - 1 &&
-                blocked_array[( p.x + 1 ) * sy + p.y + 1].nw;
+                return p.x < shape.sx - 1 && p.y < shape.sy - 1 &&
+                blocked_array[cache_layout::index( p.x + 1, p.y + 1, shape )].nw;
             case quadrant::SW:
-                return p.x > 1 && p.y < sy - 1 &&
-                blocked_array[( p.x - 1 ) * sy + p.y + 1].ne;
+                return p.x > 1 && p.y < shape.sy - 1 &&
+                blocked_array[cache_layout::index( p.x - 1, p.y + 1, shape )].ne;
             default:
                 cata::unreachable();
         }
@@ -302,7 +303,7 @@ static void castLight(
             };
 
             if( current.x < 0 || current.y < 0 ||
-                current.x >= sx || current.y >= sy ) {
+                current.x >= shape.sx || current.y >= shape.sy ) {
                 continue;
             }
 
@@ -312,10 +313,10 @@ static void castLight(
 
             if( !started_row ) {
                 started_row = true;
-                current_transparency = input_array[current.x * sy + current.y];
+                current_transparency = input_array[cache_layout::index( current.x, current.y, shape )];
             }
 
-            const int idx = current.x * sy + current.y;
+            const int idx = cache_layout::index( current.x, current.y, shape );
 
             // Compute intensity — use lookup table if on fast path.
             if( lookup != nullptr ) {
@@ -366,7 +367,7 @@ static void castLight(
                                                   current_transparency == lookup->transparency )
                                                 ? lookup : nullptr;
 
-                castLight<Out>( output_cache, input_array, blocked_array, sx, sy,
+                castLight<Out>( output_cache, input_array, blocked_array, shape,
                                 offset, offset_distance, numerator, model, xf,
                                 distance + 1, start, trailing_edge,
                                 next_cumulative, next_lookup, callback );
@@ -393,7 +394,7 @@ static void castLight(
 
         // End of row: check whether we need to leave the fast path.
         if( lookup != nullptr && current_transparency != lookup->transparency ) {
-            castLight<Out>( output_cache, input_array, blocked_array, sx, sy,
+            castLight<Out>( output_cache, input_array, blocked_array, shape,
                             offset, offset_distance, numerator, model, xf,
                             distance + 1, start, end,
                             model.accumulate( lookup->transparency, current_transparency, distance ),
@@ -416,7 +417,7 @@ void castLightAll(
     float *output_cache,
     const float *input_array,
     const diagonal_blocks *blocked_array,
-    int sx, int sy,
+    const cache_layout::grid_shape &shape,
     point_bub_ms offset, int offset_distance, float numerator,
     const light_model &model,
     const exp_lookup *weather_lookup,
@@ -430,8 +431,8 @@ void castLightAll(
         const exp_lookup *fast = nullptr;
         if( model.lookup_calc != nullptr ) {
             const point first{ offset.x() - xf.xy, offset.y() - xf.yy };
-            if( first.x >= 0 && first.y >= 0 && first.x < sx && first.y < sy ) {
-                const float t = input_array[first.x * sy + first.y];
+            if( first.x >= 0 && first.y >= 0 && first.x < shape.sx && first.y < shape.sy ) {
+                const float t = input_array[cache_layout::index( first.x, first.y, shape )];
                 if( t == LIGHT_TRANSPARENCY_OPEN_AIR ) {
                     fast = &s_openair_lookup;
                 } else if( weather_lookup != nullptr && t == weather_lookup->transparency ) {
@@ -440,17 +441,48 @@ void castLightAll(
             }
         }
 
-        castLight<float>( output_cache, input_array, blocked_array, sx, sy,
+        castLight<float>( output_cache, input_array, blocked_array, shape,
                           offset, offset_distance, numerator, model, xf,
                           1, 1.0f, 0.0f, LIGHT_TRANSPARENCY_OPEN_AIR, fast, callback );
     }
 }
 
+void cast_fov_batch(
+    std::span<const fov_observer> observers,
+    const float *input_array,
+    const diagonal_blocks *blocked_array,
+    const cache_layout::grid_shape &shape,
+    const light_model &model,
+    const exp_lookup *weather_lookup,
+    const std::function<void( std::size_t, const float * )> &visit )
+{
+    ZoneScoped;
+    const auto cast_one = [&]( const int i ) {
+        const auto &o = observers[i];
+        thread_local auto scratch = std::vector<float> {};
+        scratch.assign( static_cast<size_t>( shape.sx ) * shape.sy, LIGHT_TRANSPARENCY_SOLID );
+        scratch[cache_layout::index( o.origin.x(), o.origin.y(), shape )] = VISIBILITY_FULL;
+        // Starting that far out stops the rows at the observer's range.
+        const auto offset_distance = std::max( 0, g_max_view_distance - o.range );
+        castLightAll( scratch.data(), input_array, blocked_array, shape, o.origin, offset_distance,
+                      VISIBILITY_FULL, model, weather_lookup );
+        visit( static_cast<std::size_t>( i ), scratch.data() );
+    };
+    const auto count = static_cast<int>( observers.size() );
+    if( count > 1 && parallel_enabled && !is_pool_worker_thread() ) {
+        parallel_for( "fov_batch", 0, count, cast_one );
+    } else {
+        for( int i = 0; i < count; ++i ) {
+            cast_one( i );
+        }
+    }
+}
+
 void castLightOctants(
     float *output_cache,
     const float *input_array,
     const diagonal_blocks *blocked_array,
-    int sx, int sy,
+    const cache_layout::grid_shape &shape,
     point_bub_ms offset, int offset_distance, float numerator,
     const light_model &model,
     uint8_t octant_mask,
@@ -467,8 +499,8 @@ void castLightOctants(
         const exp_lookup *fast = nullptr;
         if( model.lookup_calc != nullptr ) {
             const point first{ offset.x() - xf.xy, offset.y() - xf.yy };
-            if( first.x >= 0 && first.y >= 0 && first.x < sx && first.y < sy ) {
-                const float t = input_array[first.x * sy + first.y];
+            if( first.x >= 0 && first.y >= 0 && first.x < shape.sx && first.y < shape.sy ) {
+                const float t = input_array[cache_layout::index( first.x, first.y, shape )];
                 if( t == LIGHT_TRANSPARENCY_OPEN_AIR ) {
                     fast = &s_openair_lookup;
                 } else if( weather_lookup != nullptr && t == weather_lookup->transparency ) {
@@ -476,7 +508,7 @@ void castLightOctants(
                 }
             }
         }
-        castLight<float>( output_cache, input_array, blocked_array, sx, sy,
+        castLight<float>( output_cache, input_array, blocked_array, shape,
                           offset, offset_distance, numerator, model, xf,
                           1, 1.0f, 0.0f, LIGHT_TRANSPARENCY_OPEN_AIR, fast, callback );
     }
@@ -519,10 +551,10 @@ static void cast_zlight_segment(
             case quadrant::NE:
                 return bc.at( p.x, p.y ).ne;
             case quadrant::SE:
-                return p.x < bc.sx - 1 && p.y < bc.sy - 1 &&
+                return p.x < bc.shape.sx - 1 && p.y < bc.shape.sy - 1 &&
                 bc.at( p.x + 1, p.y + 1 ).nw;
             case quadrant::SW:
-                return p.x > 1 && p.y < bc.sy - 1 &&
+                return p.x > 1 && p.y < bc.shape.sy - 1 &&
                 bc.at( p.x - 1, p.y + 1 ).ne;
             default:
                 cata::unreachable();
@@ -578,7 +610,7 @@ static void cast_zlight_segment(
 
                 const auto &ic = input_arrays[z_index];
                 if( !( current.x >= 0 && current.y >= 0 &&
-                       current.x < ic.sx && current.y < ic.sy ) ) {
+                       current.x < ic.shape.sx && current.y < ic.shape.sy ) ) {
                     continue;
                 }
 
@@ -608,7 +640,7 @@ static void cast_zlight_segment(
                     last_intensity = model.calc( numerator, cumulative_transparency, dist_2d );
                 }
 
-                const auto idx = current.x * ic.sy + current.y;
+                const auto idx = ic.index( current.x, current.y );
                 if( output_caches[z_index].data != nullptr ) {
                     float &out_cell = output_caches[z_index].at( current.x, current.y );
                     atomic_float_max<UseAtomic>( out_cell, last_intensity );
@@ -732,7 +764,7 @@ void cast_zlight(
     rebuild_zdist_table();
 
     if( parallel_enabled && !is_pool_worker_thread() ) {
-        parallel_for_chunked( 0, static_cast<int>( k_zlight_xforms.size() ), 1, [&]( int i ) {
+        parallel_for_chunked( "zlight_shadowcast", 0, static_cast<int>( k_zlight_xforms.size() ), 1, [&]( int i ) {
             cast_zlight_segment<true>(
                 output_caches, input_arrays, floor_caches, blocked_caches,
                 origin, offset_distance, numerator, model, k_zlight_xforms[i],
@@ -2,9 +2,13 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <span>
 #include <string>
 
+#include "cache_layout.h"
 #include "game_constants.h"
 #include "lightmap.h"
 #include "coordinates.h"
@@ -139,14 +143,14 @@ struct light_model {
 
 // ── cache_grid_ref / array_of_grids_of ───────────────────────────────────────
 /// Lightweight non-owning view of one z-level's flat tile-cache array.
-/// Carries runtime dimensions so shadowcasting can compute x*sy+y without
-/// relying on compile-time MAPSIZE strides.
+/// Carries the runtime shape (level_cache::shape()) so shadowcasting can index it
+/// (see cache_layout.h) without relying on compile-time MAPSIZE strides.
 template<typename T>
 struct cache_grid_ref {
-    T  *data = nullptr;
-    int sx   = 0;  ///< tile width  = SEEX * g_mapsize
-    int sy   = 0;  ///< tile height = SEEY * g_mapsize
-    auto at( int x, int y ) const -> T & { return data[x * sy + y]; } // *NOPAD*
+    T *data = nullptr;
+    cache_layout::grid_shape shape;
+    auto index( int x, int y ) const -> int { return cache_layout::index( x, y, shape ); }
+    auto at( int x, int y ) const -> T & { return data[index( x, y )]; } // *NOPAD*
 };
 
 template<typename T>
@@ -213,7 +217,7 @@ void castLightAll(
     float *output_cache,
     const float *input_array,
     const diagonal_blocks *blocked_array,
-    int sx, int sy,
+    const cache_layout::grid_shape &shape,
     point_bub_ms offset, int offset_distance, float numerator,
     const light_model &model,
     const exp_lookup *weather_lookup = nullptr,
@@ -234,13 +238,33 @@ void castLightOctants(
     float *output_cache,
     const float *input_array,
     const diagonal_blocks *blocked_array,
-    int sx, int sy,
+    const cache_layout::grid_shape &shape,
     point_bub_ms offset, int offset_distance, float numerator,
     const light_model &model,
     uint8_t octant_mask,
     const exp_lookup *weather_lookup = nullptr,
     light_update_callback callback = {} );
 
+/// One observer of cast_fov_batch: its tile and the farthest row it needs cast.
+struct fov_observer {
+    point_bub_ms origin;
+    int range = 0;
+};
+
+/// 2D FOV of several observers on one z-level's caches, for AI that wants whole fields
+/// of view rather than a ray per target.  Pool workers split the observers; each casts
+/// the eight k_octant_xforms of one observer into a scratch grid of @p shape and hands
+/// it to @p visit( observer index, grid ) before taking the next.  A tile is in view
+/// when its value is above LIGHT_TRANSPARENCY_SOLID.
+void cast_fov_batch(
+    std::span<const fov_observer> observers,
+    const float *input_array,
+    const diagonal_blocks *blocked_array,
+    const cache_layout::grid_shape &shape,
+    const light_model &model,
+    const exp_lookup *weather_lookup,
+    const std::function<void( std::size_t, const float * )> &visit );
+
 /// 3D FOV cast across all z-levels.
 /// Only model.calc, model.check, and model.accumulate are consulted;
 /// update_float, update_quadrants, and lookup_calc are ignored.
@@ -1,4 +1,6 @@
+#include <mutex>
 #include <set>
+#include <tuple>
 
 #include "debug.h"
 #include "json.h"
@@ -7,6 +9,63 @@
 #include "shape_impl.h"
 #include "point_float.h"
 
+namespace
+{
+
+/** Larger boxes are left to the distance function rather than held in memory. */
+constexpr int max_raster_tiles = 1 << 15;
+/** Distinct cached rasters before the cache starts over. */
+constexpr std::size_t max_cached_rasters = 64;
+
+struct raster_key {
+    std::string type;
+    std::vector<double> parameters;
+    double rotation;
+
+    bool operator<( const raster_key &rhs ) const {
+        return std::tie( type, parameters, rotation ) <
+               std::tie( rhs.type, rhs.parameters, rhs.rotation );
+    }
+};
+
+struct raster_cache {
+    std::mutex mutex;
+    std::map<raster_key, std::shared_ptr<const shape_raster>> rasters;
+};
+
+raster_cache &get_raster_cache()
+{
+    static raster_cache cache;
+    return cache;
+}
+
+} // namespace
+
+shape_raster::shape_raster( const shape_impl &impl, const tripoint &origin,
+                            const inclusive_cuboid<tripoint> &bounds )
+    : bounds( bounds )
+    , size( bounds.p_max - bounds.p_min + tripoint_above + point_south_east )
+{
+    distances.reserve( size.x * size.y * size.z );
+    for( int z = bounds.p_min.z; z <= bounds.p_max.z; z++ ) {
+        for( int y = bounds.p_min.y; y <= bounds.p_max.y; y++ ) {
+            for( int x = bounds.p_min.x; x <= bounds.p_max.x; x++ ) {
+                const tripoint p = origin + tripoint( x, y, z );
+                distances.push_back( impl.signed_distance( rl_vec3d( p.x, p.y, p.z ) ) );
+            }
+        }
+    }
+}
+
+const double *shape_raster::distance_at( const tripoint &offset ) const
+{
+    if( !bounds.contains( offset ) ) {
+        return nullptr;
+    }
+    const tripoint local = offset - bounds.p_min;
+    return &distances[( local.z * size.y + local.y ) * size.x + local.x];
+}
+
 shape::shape( const shape & ) = default;
 shape::shape( const std::shared_ptr<shape_impl> &impl, const tripoint &origin )
     : impl( impl )
@@ -18,6 +77,30 @@ const tripoint &shape::get_origin() const
     return origin;
 }
 
+void shape::rasterize()
+{
+    const inclusive_cuboid<tripoint> bb = bounding_box();
+    // Floods look one tile past the covered area
+    const tripoint min = bb.p_min - origin + point_north_west;
+    const tripoint max = bb.p_max - origin + point_south_east;
+    const tripoint extent = max - min + tripoint_above + point_south_east;
+    if( extent.x * extent.y * extent.z > max_raster_tiles ) {
+        return;
+    }
+    raster = std::make_shared<shape_raster>( *impl, origin,
+             inclusive_cuboid<tripoint>( min, max ) );
+}
+
+const std::shared_ptr<const shape_raster> &shape::get_raster() const
+{
+    return raster;
+}
+
+void shape::set_raster( const std::shared_ptr<const shape_raster> &r )
+{
+    raster = r;
+}
+
 inclusive_cuboid<tripoint> shape::bounding_box() const
 {
     const inclusive_cuboid<rl_vec3d> &bb_float = bounding_box_float();
@@ -36,6 +119,11 @@ inclusive_cuboid<rl_vec3d> shape::bounding_box_float() const
 
 double shape::distance_at( const tripoint &p ) const
 {
+    if( raster ) {
+        if( const double *d = raster->distance_at( p - origin ) ) {
+            return *d;
+        }
+    }
     return distance_at( rl_vec3d( p.x, p.y, p.z ) );
 }
 double shape::distance_at( const rl_vec3d &p ) const
@@ -88,7 +176,37 @@ std::shared_ptr<shape> shape_factory::create( const rl_vec3d &start, const rl_ve
     if( impl == nullptr ) {
         return std::make_shared<shape>( std::make_shared<empty_shape>(), tripoint_zero );
     }
-    return impl->create( start, end );
+    std::shared_ptr<shape> sh = impl->create( start, end );
+    std::vector<double> parameters = impl->get_raster_parameters();
+    // Samples are only the same for another start if it's as whole as this one
+    const bool whole_start = start == rl_vec3d( sh->get_origin() );
+    if( parameters.empty() || !whole_start ) {
+        sh->rasterize();
+        return sh;
+    }
+
+    const rl_vec3d diff = end - start;
+    raster_key key{ impl->get_type(), std::move( parameters ),
+                    units::to_radians( units::atan2( diff.y, diff.x ) ) };
+    raster_cache &cache = get_raster_cache();
+    {
+        std::lock_guard<std::mutex> lk( cache.mutex );
+        const auto it = cache.rasters.find( key );
+        if( it != cache.rasters.end() ) {
+            sh->set_raster( it->second );
+            return sh;
+        }
+    }
+    // Sampled outside the lock; a racing thread just samples the same raster
+    sh->rasterize();
+    if( sh->get_raster() ) {
+        std::lock_guard<std::mutex> lk( cache.mutex );
+        if( cache.rasters.size() >= max_cached_rasters ) {
+            cache.rasters.clear();
+        }
+        cache.rasters.emplace( std::move( key ), sh->get_raster() );
+    }
+    return sh;
 }
 
 double shape_factory::get_range() const
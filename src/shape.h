@@ -2,6 +2,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "cuboid_rectangle.h"
 #include "point.h"
@@ -13,12 +14,34 @@ class shape_factory_impl;
 class JsonIn;
 class JsonOut;
 
+/**
+ * Signed distances of a shape sampled at every tile of a box around its origin.
+ * AoE floods ask for the same tiles many times over, and shapes made again with
+ * the same parameters and direction share one raster.
+ */
+class shape_raster
+{
+    public:
+        /** Samples @p impl over @p bounds, given relative to @p origin. */
+        shape_raster( const shape_impl &impl, const tripoint &origin,
+                      const inclusive_cuboid<tripoint> &bounds );
+
+        /** Distance at @p offset from the origin, or nullptr outside the sampled box. */
+        const double *distance_at( const tripoint &offset ) const;
+
+    private:
+        inclusive_cuboid<tripoint> bounds;
+        tripoint size;
+        std::vector<double> distances;
+};
+
 /**
  * Class describing shapes in 3D space. The shapes can cover some points partially.
  */
 class shape
 {
     public:
+        /** Uses the raster where there is one; the distance function elsewhere. */
         double distance_at( const tripoint &p ) const;
         double distance_at( const rl_vec3d &p ) const;
         /**
@@ -31,9 +54,15 @@ class shape
 
         shape( const std::shared_ptr<shape_impl> &, const tripoint &origin );
         shape( const shape & );
+
+        /** Samples the whole bounding box, plus a tile around it, unless that is huge. */
+        void rasterize();
+        const std::shared_ptr<const shape_raster> &get_raster() const;
+        void set_raster( const std::shared_ptr<const shape_raster> &r );
     private:
         std::shared_ptr<shape_impl> impl;
         tripoint origin;
+        std::shared_ptr<const shape_raster> raster;
 };
 
 /**
@@ -50,6 +79,10 @@ class shape_factory
         void serialize( JsonOut &jsout ) const;
         void deserialize( JsonIn &jsin );
 
+        /**
+         * Rasterized shapes are cached by the factory's parameters and direction, so
+         * aiming and firing the same weapon the same way samples it once.
+         */
         std::shared_ptr<shape> create( const tripoint &start, const tripoint &end ) const;
         std::shared_ptr<shape> create( const rl_vec3d &start, const rl_vec3d &end ) const;
         double get_range() const;
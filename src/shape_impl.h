@@ -256,6 +256,14 @@ class shape_factory_impl
 
         virtual double get_range() const = 0;
         virtual std::string get_description() const = 0;
+        /**
+         * Everything the created shapes depend on besides the start point and the
+         * horizontal direction to the end, for caching rasters.  Empty if the shapes
+         * depend on more and can't be cached.
+         */
+        virtual std::vector<double> get_raster_parameters() const {
+            return {};
+        }
 
         virtual void serialize( JsonOut & ) const {};
         virtual void deserialize( JsonIn & ) {};
@@ -313,6 +321,10 @@ class cone_factory : public shape_factory_impl
             return length;
         }
 
+        std::vector<double> get_raster_parameters() const override {
+            return { units::to_radians( half_angle ), length };
+        }
+
         std::string get_description() const override {
             return string_format( _( "Cone of length <info>%d</info>, apex angle <info>%d</info>" ),
                                   static_cast<int>( length ),
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Hash map split into @p Shards independently locked parts, for lookups that run on
+ * several threads while writers are rare.  Readers take a shared lock on one shard only,
+ * so they never wait on each other and only wait on a writer touching the same shard.
+ *
+ * Values are returned by copy; @p Value is meant to be a pointer or other small handle
+ * whose lifetime the owner manages separately.
+ */
+template<typename Key, typename Value, typename Hash = std::hash<Key>, std::size_t Shards = 64>
+class sharded_map
+{
+        static_assert( Shards > 0 && ( Shards & ( Shards - 1 ) ) == 0, "shard count must be a power of two" );
+
+    public:
+        /** The value stored under @p key, or @p fallback if there is none. */
+        auto find( const Key &key, Value fallback = {} ) const -> Value {
+            const auto &s = shard_of( key );
+            auto lk = std::shared_lock( s.mutex );
+            const auto it = s.map.find( key );
+            return it != s.map.end() ? it->second : fallback;
+        }
+
+        auto contains( const Key &key ) const -> bool {
+            const auto &s = shard_of( key );
+            auto lk = std::shared_lock( s.mutex );
+            return s.map.contains( key );
+        }
+
+        auto insert_or_assign( const Key &key, Value value ) -> void {
+            auto &s = shard_of( key );
+            auto lk = std::unique_lock( s.mutex );
+            s.map.insert_or_assign( key, std::move( value ) );
+        }
+
+        auto erase( const Key &key ) -> bool {
+            auto &s = shard_of( key );
+            auto lk = std::unique_lock( s.mutex );
+            return s.map.erase( key ) != 0;
+        }
+
+        auto clear() -> void {
+            for( auto &s : shards_ ) {
+                auto lk = std::unique_lock( s.mutex );
+                s.map.clear();
+            }
+        }
+
+        /** Entries over all shards; shards are counted one after another, not atomically. */
+        auto size() const -> std::size_t {
+            auto total = std::size_t{ 0 };
+            for( const auto &s : shards_ ) {
+                auto lk = std::shared_lock( s.mutex );
+                total += s.map.size();
+            }
+            return total;
+        }
+
+    private:
+        // One cache line per shard keeps readers of neighbouring shards from sharing the
+        // line their lock counters live on.
+        struct alignas( 64 ) shard {
+            mutable std::shared_mutex mutex;
+            std::unordered_map<Key, Value, Hash> map;
+        };
+
+        static constexpr int shard_bits = std::countr_zero( Shards );
+
+        auto shard_index( const Key &key ) const -> std::size_t {
+            if constexpr( Shards == 1 ) {
+                return 0;
+            } else {
+                // Fibonacci hashing: the top bits of the product depend on every bit of the
+                // hash, so weak hashes of nearby keys still spread over the shards.
+                const auto h = static_cast<std::uint64_t>( Hash{}( key ) );
+                return static_cast<std::size_t>( ( h * 0x9E3779B97F4A7C15ULL ) >> ( 64 - shard_bits ) );
+            }
+        }
+
+        auto shard_of( const Key &key ) -> shard & {
+            return shards_[shard_index( key )];
+        }
+        auto shard_of( const Key &key ) const -> const shard & {
+            return shards_[shard_index( key )];
+        }
+
+        std::array<shard, Shards> shards_;
+};
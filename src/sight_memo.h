@@ -0,0 +1,129 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "point.h"
+
+/**
+ * Line-of-sight answers of one creature for the tiles of its own z-level around it, so
+ * that checking many targets, turn after turn, costs a bit test each after the first.
+ *
+ * Answers stay valid for one key: the map, where it is, the creature's tile and the map's
+ * sight generation (see map::sight_generation), which moves whenever the vision
+ * transparency the rays depend on changes.  Any other key empties the memo first.
+ * Copies and moves start empty, as the answers belong to the original's key.
+ * A whole field of view can be remembered at once, see map::remember_fields_of_view.
+ */
+class sight_memo
+{
+    public:
+        /** Chebyshev distance of the farthest remembered target. */
+        static constexpr int radius = 60;
+
+        struct key {
+            const void *map = nullptr;
+            point map_origin;
+            tripoint origin;
+            std::uint64_t generation = 0;
+
+            auto operator==( const key & ) const -> bool = default;
+        };
+
+        sight_memo() = default;
+        sight_memo( const sight_memo & ) {}
+        sight_memo( sight_memo && ) noexcept {}
+        auto operator=( const sight_memo & ) -> sight_memo & {
+            return *this;
+        }
+        auto operator=( sight_memo && ) noexcept -> sight_memo & {
+            return *this;
+        }
+
+        /** The remembered answer for the target @p offset tiles from the origin of @p k. */
+        auto find( const key &k, const point &offset ) const -> std::optional<bool> {
+            const auto bit = bit_of( offset );
+            if( !bit ) {
+                return std::nullopt;
+            }
+            auto lk = std::lock_guard( mutex_ );
+            if( !( key_ == k ) || known_.empty() || !test( known_, *bit ) ) {
+                return std::nullopt;
+            }
+            return test( visible_, *bit );
+        }
+
+        auto remember( const key &k, const point &offset, const bool visible ) -> void {
+            const auto bit = bit_of( offset );
+            if( !bit ) {
+                return;
+            }
+            auto lk = std::lock_guard( mutex_ );
+            if( !( key_ == k ) || known_.empty() ) {
+                key_ = k;
+                known_.assign( words, 0 );
+                visible_.assign( words, 0 );
+                complete_range_ = -1;
+            }
+            known_[*bit / 64] |= std::uint64_t{ 1 } << ( *bit % 64 );
+            if( visible ) {
+                visible_[*bit / 64] |= std::uint64_t{ 1 } << ( *bit % 64 );
+            }
+        }
+
+        /** Whether every target up to @p range tiles from the origin of @p k is known. */
+        auto complete( const key &k, const int range ) const -> bool {
+            auto lk = std::lock_guard( mutex_ );
+            return key_ == k && complete_range_ >= std::min( range, radius );
+        }
+
+        /**
+         * Forgets everything and remembers @p visible( offset ) for every target up to
+         * @p range tiles from the origin of @p k.
+         */
+        template<typename F>
+        auto remember_all( const key &k, int range, F &&visible ) -> void {
+            range = std::min( range, radius );
+            auto lk = std::lock_guard( mutex_ );
+            key_ = k;
+            known_.assign( words, 0 );
+            visible_.assign( words, 0 );
+            complete_range_ = range;
+            for( int x = -range; x <= range; ++x ) {
+                for( int y = -range; y <= range; ++y ) {
+                    const auto bit = *bit_of( point( x, y ) );
+                    known_[bit / 64] |= std::uint64_t{ 1 } << ( bit % 64 );
+                    if( visible( point( x, y ) ) ) {
+                        visible_[bit / 64] |= std::uint64_t{ 1 } << ( bit % 64 );
+                    }
+                }
+            }
+        }
+
+    private:
+        static constexpr int side = 2 * radius + 1;
+        static constexpr std::size_t words = ( side * side + 63 ) / 64;
+
+        static auto bit_of( const point &offset ) -> std::optional<std::size_t> {
+            if( offset.x < -radius || offset.x > radius || offset.y < -radius || offset.y > radius ) {
+                return std::nullopt;
+            }
+            return static_cast<std::size_t>( ( offset.x + radius ) * side + offset.y + radius );
+        }
+
+        static auto test( const std::vector<std::uint64_t> &bits, const std::size_t bit ) -> bool {
+            return ( bits[bit / 64] >> ( bit % 64 ) ) & 1;
+        }
+
+        // Another creature's turn may ask what this one sees.
+        mutable std::mutex mutex_;
+        key key_;
+        std::vector<std::uint64_t> known_;
+        std::vector<std::uint64_t> visible_;
+        // Chebyshev radius remember_all filled, -1 for single answers only.
+        int complete_range_ = -1;
+};
@@ -8,6 +8,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <map>
 #include <memory>
 #include <optional>
 #include <ostream>
@@ -20,6 +21,7 @@
 
 #include "active_tile_data.h"
 #include "avatar.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "character.h"
 #include "construction.h"
@@ -870,20 +872,20 @@ void map::flood_fill_sound( const sound_event soundevent, const int zlev )
 
 }
 
-// Batch flood fills a given vector of sound events, stepping through all z levels.
-// New sound_cache are then added to the sound_caches vector in map.
-void map::batch_flood_fill_sounds()
+// Flood fills one batched sound through the absorption cache of its z-level.
+// Only reads the map, so the sounds of a batch can be flooded on separate threads.
+static auto flood_fill_batched_sound( const map &m, sound_event flooded_sound,
+                                      const short snowbonus ) -> sound_instance_cache
 {
-    ZoneScoped;
-    // Our que of sound events to flood fill
-    auto &batch_que = sound_batch_floodfill_que;
-    const bool is_winter =  season_of_year( calendar::turn ) == WINTER;
-    const auto &snowbonus = ( is_winter ) ? SOUND_ABSORPTION_SNOW_BONUS : SOUND_ABSORPTION_OPEN_FIELD;
+    const int z = flooded_sound.origin.z();
+    const auto &map_cache = m.get_cache_ref( z );
+    const auto &absorption_cache = map_cache.absorption_cache;
+    const auto &outside_cache = map_cache.outside_cache;
 
-    // How many sounds did we actually process?
-    auto &num_processed_mon_sounds = m_sound_cache.batch_flooded_monster_sounds;
-    auto &num_processed_NPC_sounds = m_sound_cache.batch_flooded_NPC_sounds;
-    auto &num_invalidated_sounds = m_sound_cache.invalidated_batch_sounds;
+    // If we are at zlev 10, we dont want to try to check whats above us to avoid out of bounds checks.
+    const bool check_up_valid = z < 10;
+    // Make sure that there is a valid reference to *a* mapcache, even if we dont call it if we are too high up.
+    const auto &up_map_cache = ( check_up_valid ) ? m.get_cache_ref( z + 1 ) : map_cache;
 
     //// [-1 , 1 ] [ 0 , 1 ] [ 1 , 1 ]   [ 0 ] [ 1 ] [ 2 ]
     //// [-1 , 0 ] [ 0 , 0 ] [ 1 , 0 ] = [ 7 ] [ 8 ] [ 3 ]
@@ -902,11 +904,9 @@ void map::batch_flood_fill_sounds()
         return a.vol < b.vol;
     };
 
-    // max-heap: highest volume processed first. We clear this after each sound processed. pqt = priority tile que
+    // max-heap: highest volume processed first. pqt = priority tile que
     std::priority_queue<propagation_tile, std::vector<propagation_tile>, decltype( cmp )> ptq( cmp );
 
-    // We will just use one checkvars envelope for all the sounds, and set it to zero when we begin to floodfill a sound.
-
     /** Windows MSVS wont compile with variable sized multidimension arrays but everything else will. So we just use the max size.
     *    @param checkvars[][][0] = terrain base sound attenuation cases 1 & 3
     *    @param checkvars[][][1] = terrain base sound attenuation cases 2 & 3
@@ -918,348 +918,438 @@ void map::batch_flood_fill_sounds()
     *    @param checkvars[][][7] = Does the tile count as a sound wall?
     */
     std::bitset<8> checkvars[total_check_envelope_DEAFENING][total_check_envelope_DEAFENING] = {{0}};
-    memset( checkvars, 0, sizeof( checkvars ) );
 
-    // Now we step through our zlevels
-    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
 
-        const auto &map_cache = get_cache( z );
-        const auto &absorption_cache = map_cache.absorption_cache;
-        const auto &outside_cache = map_cache.outside_cache;
+    sound_instance_cache temp_sound_cache( flooded_sound,
+                                           get_flood_dist_enum( flooded_sound.volume ),
+                                           get_flood_radius_by_enum( get_flood_dist_enum(
+                                                   flooded_sound.volume ) ) );
+    auto &svol = temp_sound_cache.volume;
+    auto &f_radius = temp_sound_cache.flood_radius;
+    temp_sound_cache.source_indoors = !outside_cache[map_cache.idx( temp_sound_cache.origin.x(),
+                                                     temp_sound_cache.origin.y() )];
+    auto &escape_vol = temp_sound_cache.base_distance_vol_by_dir;
+    // Set this for use with the slightly cheaper direct line propagation.
+    temp_sound_cache.terrain_sound_absorbtion_at_source = absorption_cache[map_cache.idx(
+                temp_sound_cache.origin.x(), temp_sound_cache.origin.y() )];
+    const auto vol_enum_index = get_san_dir( static_cast<uint8_t>( get_flood_dist_enum(
+                                    flooded_sound.volume ) ) );
+    const auto &actual_check_radius = total_check_radius_by_index[vol_enum_index];
+    // const auto &actual_env_length = total_check_envelop_by_index[vol_enum_index];
+    const auto checkvar_index_p = temp_sound_cache.origin + point{-total_check_radius_DEAFENING, -total_check_radius_DEAFENING};
+    // Our checkvar index point is located at 0,0 of our checkvar envelope.
+    const auto cv_env_rel_ms_adj = point{-checkvar_index_p.x(), -checkvar_index_p.y()};
+    // Located at 0,0 of our flood envelope
+    // const auto &f_env_index_p = temp_sound_cache.envelope_index_point;
+    // const auto f_env_rel_ms_adj = point{-f_env_index_p.x(), -f_env_index_p.y()};
+    const uint8_t startxy = total_check_radius_DEAFENING - actual_check_radius;
+    const uint8_t endxy = total_check_envelope_DEAFENING - startxy;
+
+
+    // We run through this often enough that we might as well make a lambda of it.
+    auto check_walls = [&]( const uint8_t &dir ) -> void{
+        const auto &wall_dirs = wall_check_by_sdirection[get_san_dir( dir )];
+        const auto &wall1_cv_p = adjacent_tiles[wall_dirs.first] + cv_env_rel_ms_adj;
+        const auto &wall1_checkvars = checkvars[wall1_cv_p.x()][wall1_cv_p.y()];
+        const auto &wall2_cv_p = adjacent_tiles[wall_dirs.second] + cv_env_rel_ms_adj;
+        const auto &wall2_checkvars = checkvars[wall2_cv_p.x()][wall2_cv_p.y()];
+        const auto &wall1 = wall1_checkvars[7];
+        const auto &wall2 = wall2_checkvars[7];
+        wall_bools = get_s_wall_bool_pair( wall1, wall2 );
+    };
 
-        // If we are at zlev 10, we dont want to try to check whats above us to avoid out of bounds checks.
-        const bool check_up_valid = z < 10;
-        // Make sure that there is a valid reference to *a* mapcache, even if we dont call it if we are too high up.
-        const auto &up_map_cache = ( check_up_valid ) ? get_cache( z + 1 ) : map_cache;
+    // Given some point, return the corresponding volume vector index.
+    // Only use after confirming that the tile is within the envelope using in_envelope().
+    auto v_index_from_p = [&]( const point_bub_ms & p ) {
+        return temp_sound_cache.p_to_env_index( p );
+    };
 
-        // We cycle through all the sounds in the batch que
-        for( sound_event flooded_sound : batch_que ) {
-            // Skip all sounds that do not originate from our zlevel, are along the map border, or that are too far below our ambient volume.
-            if( flooded_sound.origin.z() != z ) {
-                // We still floodfill these sounds out later, just when we get to the right z-level.
-                continue;
-            } else if( flooded_sound.volume < 7 ) {
-                num_invalidated_sounds++;
+    for( uint8_t x = startxy; x < endxy; x++ ) {
+        for( uint8_t y = startxy; y < endxy; y++ ) {
+            const auto env_tile = checkvar_index_p + point{x, y};
+            auto &env_tile_vars = checkvars[x][y];
+            if( !m.inbounds( env_tile ) ) {
+                // If we are out of bounds, set all bits to true to indicate this.
+                env_tile_vars.set();
                 continue;
             } else {
+                // envelope tile map idx
+                const auto et_midx = map_cache.idx( env_tile.x(), env_tile.y() );
+                const auto tile_absorp = absorption_cache[et_midx];
+                // First two bits set our base terrain absorption from landusecode
+                const uint8_t base_absorp = get_base_absorp_index( tile_absorp );
+                const uint8_t struc_absorp = get_tile_absorp_index( tile_absorp );
+                // Redo the encoding here to make more compact. 6 total cases for the various absorption, which can fit on 3 bits
+                // Which gives us space for floor chache on this level check
+                env_tile_vars[0] = ( base_absorp == 1 ||
+                                     base_absorp == 3 ); // terrain base sound attenuation cases 1 & 3
+                env_tile_vars[1] = ( base_absorp == 2 ||
+                                     base_absorp == 3 ); // terrain base sound attenuation cases 2 & 3
+                env_tile_vars[2] = ( struc_absorp == 1 || struc_absorp == 3 ); // tile sound attenuation cases 1 & 3
+                env_tile_vars[3] = ( struc_absorp == 2 || struc_absorp == 3 ); // tile sound attenuation cases 2 & 3
+                env_tile_vars[4] = ( check_up_valid ) ? up_map_cache.floor_cache[et_midx] > 0 :
+                                   false; // Is there a roof above us?
+                env_tile_vars[5] = map_cache.floor_cache[et_midx] ==
+                                   0; // If there is no floor in our tile, we can escape down.
+                env_tile_vars[6] = outside_cache[et_midx]; // are we outside?
+                env_tile_vars[7] = map_cache.sound_wall_cache[et_midx]; // Does the tile count as a sound wall?
+                // It is impossible for all of these bools to be true at once.
+                // So if they are all true, we know the tile is out of bounds.
+                // If we have no roof, we are outdoors, no soundwall and it is winter, we can assume that there is snow cover.
+            }
+        }
+    }
 
-                // Set our checkvars to zero before we get too much farther and break stuff.
-                memset( checkvars, 0, sizeof( checkvars ) );
-                sound_instance_cache temp_sound_cache( flooded_sound,
-                                                       get_flood_dist_enum( flooded_sound.volume ),
-                                                       get_flood_radius_by_enum( get_flood_dist_enum(
-                                                               flooded_sound.volume ) ) );
-                auto &svol = temp_sound_cache.volume;
-                auto &f_radius = temp_sound_cache.flood_radius;
-                temp_sound_cache.source_indoors = !outside_cache[map_cache.idx( temp_sound_cache.origin.x(),
-                                                                 temp_sound_cache.origin.y() )];
-                auto &escape_vol = temp_sound_cache.base_distance_vol_by_dir;
-                // Set this for use with the slightly cheaper direct line propagation.
-                temp_sound_cache.terrain_sound_absorbtion_at_source = absorption_cache[map_cache.idx(
-                            temp_sound_cache.origin.x(), temp_sound_cache.origin.y() )];
-                const auto vol_enum_index = get_san_dir( static_cast<uint8_t>( get_flood_dist_enum(
-                                                flooded_sound.volume ) ) );
-                const auto &actual_check_radius = total_check_radius_by_index[vol_enum_index];
-                // const auto &actual_env_length = total_check_envelop_by_index[vol_enum_index];
-                const auto checkvar_index_p = temp_sound_cache.origin + point{-total_check_radius_DEAFENING, -total_check_radius_DEAFENING};
-                // Our checkvar index point is located at 0,0 of our checkvar envelope.
-                const auto cv_env_rel_ms_adj = point{-checkvar_index_p.x(), -checkvar_index_p.y()};
-                // Located at 0,0 of our flood envelope
-                // const auto &f_env_index_p = temp_sound_cache.envelope_index_point;
-                // const auto f_env_rel_ms_adj = point{-f_env_index_p.x(), -f_env_index_p.y()};
-                const uint8_t startxy = total_check_radius_DEAFENING - actual_check_radius;
-                const uint8_t endxy = total_check_envelope_DEAFENING - startxy;
-
-
-                // We run through this often enough that we might as well make a lambda of it.
-                auto check_walls = [&]( const uint8_t &dir ) -> void{
-                    const auto &wall_dirs = wall_check_by_sdirection[get_san_dir( dir )];
-                    const auto &wall1_cv_p = adjacent_tiles[wall_dirs.first] + cv_env_rel_ms_adj;
-                    const auto &wall1_checkvars = checkvars[wall1_cv_p.x()][wall1_cv_p.y()];
-                    const auto &wall2_cv_p = adjacent_tiles[wall_dirs.second] + cv_env_rel_ms_adj;
-                    const auto &wall2_checkvars = checkvars[wall2_cv_p.x()][wall2_cv_p.y()];
-                    const auto &wall1 = wall1_checkvars[7];
-                    const auto &wall2 = wall2_checkvars[7];
-                    wall_bools = get_s_wall_bool_pair( wall1, wall2 );
-                };
-
-                // Given some point, return the corresponding volume vector index.
-                // Only use after confirming that the tile is within the envelope using in_envelope().
-                auto v_index_from_p = [&]( const point_bub_ms & p ) {
-                    return temp_sound_cache.p_to_env_index( p );
-                };
-
-                for( uint8_t x = startxy; x < endxy; x++ ) {
-                    for( uint8_t y = startxy; y < endxy; y++ ) {
-                        const auto env_tile = checkvar_index_p + point{x, y};
-                        auto &env_tile_vars = checkvars[x][y];
-                        if( !inbounds( env_tile ) ) {
-                            // If we are out of bounds, set all bits to true to indicate this.
-                            env_tile_vars.set();
-                            continue;
-                        } else {
-                            // envelope tile map idx
-                            const auto et_midx = map_cache.idx( env_tile.x(), env_tile.y() );
-                            const auto tile_absorp = absorption_cache[et_midx];
-                            // First two bits set our base terrain absorption from landusecode
-                            const uint8_t base_absorp = get_base_absorp_index( tile_absorp );
-                            const uint8_t struc_absorp = get_tile_absorp_index( tile_absorp );
-                            // Redo the encoding here to make more compact. 6 total cases for the various absorption, which can fit on 3 bits
-                            // Which gives us space for floor chache on this level check
-                            env_tile_vars[0] = ( base_absorp == 1 ||
-                                                 base_absorp == 3 ); // terrain base sound attenuation cases 1 & 3
-                            env_tile_vars[1] = ( base_absorp == 2 ||
-                                                 base_absorp == 3 ); // terrain base sound attenuation cases 2 & 3
-                            env_tile_vars[2] = ( struc_absorp == 1 || struc_absorp == 3 ); // tile sound attenuation cases 1 & 3
-                            env_tile_vars[3] = ( struc_absorp == 2 || struc_absorp == 3 ); // tile sound attenuation cases 2 & 3
-                            env_tile_vars[4] = ( check_up_valid ) ? up_map_cache.floor_cache[et_midx] > 0 :
-                                               false; // Is there a roof above us?
-                            env_tile_vars[5] = map_cache.floor_cache[et_midx] ==
-                                               0; // If there is no floor in our tile, we can escape down.
-                            env_tile_vars[6] = outside_cache[et_midx]; // are we outside?
-                            env_tile_vars[7] = map_cache.sound_wall_cache[et_midx]; // Does the tile count as a sound wall?
-                            // It is impossible for all of these bools to be true at once.
-                            // So if they are all true, we know the tile is out of bounds.
-                            // If we have no roof, we are outdoors, no soundwall and it is winter, we can assume that there is snow cover.
-                        }
-                    }
+    auto check_escape = [&]( const int &cv_env_x, const int &cv_env_y, const short & tile_vol,
+    const uint8_t &dist ) {
+        const auto &tilevars = checkvars[cv_env_x][cv_env_y];
+        if( tilevars[6] && check_up_valid ) {
+            if( !tilevars[4] && tile_vol > escape_vol[SDI_UP] ) {
+                short vol = tile_vol;
+                if( dist < f_radius ) {
+                    vol -= get_cumulative_vol_dist_loss( dist, f_radius,
+                                                         temp_sound_cache.terrain_sound_absorbtion_at_source );
                 }
+                escape_vol[SDI_UP] = std::max( vol, escape_vol[SDI_UP] );
+            }
+        }
+        if( tilevars[5] && tile_vol > escape_vol[SDI_DOWN] ) {
+            short vol = tile_vol;
+            if( dist < f_radius ) {
+                vol -= get_cumulative_vol_dist_loss( dist, f_radius,
+                                                     temp_sound_cache.terrain_sound_absorbtion_at_source );
+            }
+            escape_vol[SDI_DOWN] = std::max( vol, escape_vol[SDI_DOWN] );
+        }
+    };
+    // Set our initial conditions. We want 100ths of a decibel for the volume
+    // We dont apply directional sound propagation penalties at the very start.
+    // The center of our flood envelope is always (flood radius, flood radius). Index location math is (radius * ( ( 2 * radius ) + 1 ) + radius) = 2 * ( radius * radius ) + ( 2 * radius )
+    auto &origin_volume = svol[temp_sound_cache.p_to_env_index( temp_sound_cache.origin )];
+    origin_volume =  dBspl_to_mdBspl( temp_sound_cache.sound.volume );
+    adjacent_tiles = get_adjacent_tiles( temp_sound_cache.sound.origin.xy() );
+
+    const auto &orig_to_cv = temp_sound_cache.origin + cv_env_rel_ms_adj;
+    check_escape( orig_to_cv.x(), orig_to_cv.y(),
+                  origin_volume - dist_vol_loss[2], 2 );
+
+    // This propagates the sounds from the source tile to the 8 adjacent tiles, setting initial directions, distances and volumes.
+    // Adj tiles are 0-7
+    for( uint8_t i : sanitized_sound_direction_indexes ) {
+        const auto &tile = adjacent_tiles[i];
+        const auto cv_env_tile = tile + cv_env_rel_ms_adj;
+        const auto &t_checkvars = checkvars[cv_env_tile.x()][cv_env_tile.y()];
+        // Lets make sure that we only propagate inbounds, and not along the map border. After this we can just check !tile_along_map_border
+        // We know that our initial adjacent tiles will always be inside the envelope.
+        if( !t_checkvars.all() ) {
+            const auto vol_index = v_index_from_p( tile );
+            // Set our initial distance to 2. At the source there is no sound direction distance modifier.
+            // And set our tile volume based on the distance. We know that the sound origin is atleast 1600mdB.
+            // Set our direction based upon the adjacent tile index.
+            svol[vol_index] = std::max( 0,
+                                        ( origin_volume -  dist_vol_loss[2] - absorption_from_checkvar_bitset(
+                                              t_checkvars ) - snowbonus ) );
+
+
+            if( temp_sound_cache.in_envelope( tile ) && svol[vol_index] > 0 ) {
+
+                check_escape( cv_env_tile.x(), cv_env_tile.y(), svol[vol_index], 2 );
+
+                ptq.emplace( propagation_tile( tile, svol[vol_index], i, 2 ) );
+            }
+        }
+    }
 
-                auto check_escape = [&]( const int &cv_env_x, const int &cv_env_y, const short & tile_vol,
-                const uint8_t &dist ) {
-                    const auto &tilevars = checkvars[cv_env_x][cv_env_y];
-                    if( tilevars[6] && check_up_valid ) {
-                        if( !tilevars[4] && tile_vol > escape_vol[SDI_UP] ) {
-                            short vol = tile_vol;
-                            if( dist < f_radius ) {
-                                vol -= get_cumulative_vol_dist_loss( dist, f_radius,
-                                                                     temp_sound_cache.terrain_sound_absorbtion_at_source );
-                            }
-                            escape_vol[SDI_UP] = std::max( vol, escape_vol[SDI_UP] );
-                        }
-                    }
-                    if( tilevars[5] && tile_vol > escape_vol[SDI_DOWN] ) {
-                        short vol = tile_vol;
-                        if( dist < f_radius ) {
-                            vol -= get_cumulative_vol_dist_loss( dist, f_radius,
-                                                                 temp_sound_cache.terrain_sound_absorbtion_at_source );
-                        }
-                        escape_vol[SDI_DOWN] = std::max( vol, escape_vol[SDI_DOWN] );
+    auto spropagate_from_tile = [&]( const propagation_tile & top_of_que ) {
+        // Make a more consistant reference so we dont potentially somehow sort away our reference.
+        const auto ptile = top_of_que;
+        // Remove the old top listing.
+        ptq.pop();
+
+        // We know that we are not propagating from a tile along the map border, so it is safe to check for walls.
+        // Grab our adjacent tiles, and the values for our center tile.
+        adjacent_tiles = get_adjacent_tiles( ptile.pos );
+        // Set our wall1 and wall2 bools
+        const auto &san_pdir = get_san_dir( ptile.dir );
+        check_walls( ptile.dir );
+
+        // Iterate through adjacent tiles.
+        const auto &dirs_to_check = spropagation_tiles_by_sdirection[san_pdir];
+        for( uint8_t adj_tile_dir : dirs_to_check ) {
+            // Check should be being fed only constexpr inputs by this point.
+            if( skip_due_to_wall( get_s_wall_bool_pair( wall_bools.first, wall_bools.second ), san_pdir,
+                                  adj_tile_dir ) ) {
+                continue;
+            }
+
+            const auto &adj_tile = adjacent_tiles[adj_tile_dir];
+            const auto adj_tile_cve = adj_tile + cv_env_rel_ms_adj;
+            const auto &adjt_checkvars = checkvars[adj_tile_cve.x()][adj_tile_cve.y()];
+            // Dont check tiles that are not valid for propagation, i.e. behind the direction of sound, around a corner, or out of bounds.
+            if( temp_sound_cache.in_envelope( adj_tile ) && !adjt_checkvars.all() ) {
+                auto &adj_tile_vol = svol[v_index_from_p( adj_tile )];
+                // Cap our tile distance between 1 and 121 to prevent overflow. We dont have or need distance loss values past dist_vol_loss[121]
+                // as the change in distance loss values past this point are negligible for gameplay scale.
+                const uint8_t dist_for_vol_loss = get_distance_for_volume_loss( ptile.dist,
+                                                  ( adj_tile_dir == dirs_to_check.front() ||
+                                                    adj_tile_dir == dirs_to_check.back() ) );
+                const short vol_to_check = std::max( 0,
+                                                     ( ptile.vol - absorption_from_checkvar_bitset( adjt_checkvars ) -
+                                                       ( dist_vol_loss[dist_for_vol_loss] ) - snowbonus ) );
+                // General priority goes loudest volume, then largest distance. Smaller distances loose volume more quickly.
+                // If volumes are equal and directions are one off from eachother, the cardinal direction wins.
+                // We dont want to track inaudible single dB values across the entire map for each sound.
+                if( vol_to_check > adj_tile_vol ) {
+                    // Check this if sound propagation is acting up. Comment out if things are playing nice.
+                    if( vol_to_check > dBspl_to_mdBspl( temp_sound_cache.sound.volume ) ) {
+                        debugmsg( "Sound with description [ %1s ] attempted to propagate from %i:%i at %i mdB to %i:%i at %i mdB, a louder volume than the origin volume of %i mdB!"
+                                  , temp_sound_cache.sound.description, ptile.pos.x(), ptile.pos.y(), ptile.vol, adj_tile.x(),
+                                  adj_tile.y(),
+                                  vol_to_check, origin_volume );
+                        // Dont break the laws of physics
+                        continue;
                     }
-                };
-                // Set our initial conditions. We want 100ths of a decibel for the volume
-                // We dont apply directional sound propagation penalties at the very start.
-                // The center of our flood envelope is always (flood radius, flood radius). Index location math is (radius * ( ( 2 * radius ) + 1 ) + radius) = 2 * ( radius * radius ) + ( 2 * radius )
-                auto &origin_volume = svol[temp_sound_cache.p_to_env_index( temp_sound_cache.origin )];
-                origin_volume =  dBspl_to_mdBspl( temp_sound_cache.sound.volume );
-                adjacent_tiles = get_adjacent_tiles( temp_sound_cache.sound.origin.xy() );
-
-                const auto &orig_to_cv = temp_sound_cache.origin + cv_env_rel_ms_adj;
-                check_escape( orig_to_cv.x(), orig_to_cv.y(),
-                              origin_volume - dist_vol_loss[2], 2 );
-
-                // This propagates the sounds from the source tile to the 8 adjacent tiles, setting initial directions, distances and volumes.
-                // Adj tiles are 0-7
-                for( uint8_t i : sanitized_sound_direction_indexes ) {
-                    const auto &tile = adjacent_tiles[i];
-                    const auto cv_env_tile = tile + cv_env_rel_ms_adj;
-                    const auto &t_checkvars = checkvars[cv_env_tile.x()][cv_env_tile.y()];
-                    // Lets make sure that we only propagate inbounds, and not along the map border. After this we can just check !tile_along_map_border
-                    // We know that our initial adjacent tiles will always be inside the envelope.
-                    if( !t_checkvars.all() ) {
-                        const auto vol_index = v_index_from_p( tile );
-                        // Set our initial distance to 2. At the source there is no sound direction distance modifier.
-                        // And set our tile volume based on the distance. We know that the sound origin is atleast 1600mdB.
-                        // Set our direction based upon the adjacent tile index.
-                        svol[vol_index] = std::max( 0,
-                                                    ( origin_volume -  dist_vol_loss[2] - absorption_from_checkvar_bitset(
-                                                          t_checkvars ) - snowbonus ) );
-
-
-                        if( temp_sound_cache.in_envelope( tile ) && svol[vol_index] > 0 ) {
-
-                            check_escape( cv_env_tile.x(), cv_env_tile.y(), svol[vol_index], 2 );
-
-                            ptq.emplace( propagation_tile( tile, svol[vol_index], i, 2 ) );
-                        }
+                    adj_tile_vol = vol_to_check;
+
+                    check_escape( adj_tile_cve.x(), adj_tile_cve.y(), vol_to_check, dist_for_vol_loss );
+
+                    if( adj_tile_vol > SOUND_ABSORPTION_OPEN_FIELD ) {
+                        // If the tiles new volume is greater than our old one and is inside the envelope, mark it for update.
+                        // Will not update if the adjacent tile is along the map boundry.
+                        ptq.emplace( propagation_tile( adj_tile, vol_to_check, adj_tile_dir, dist_for_vol_loss ) );
                     }
                 }
+            }
+        }
 
-                auto spropagate_from_tile = [&]( const propagation_tile & top_of_que ) {
-                    // Make a more consistant reference so we dont potentially somehow sort away our reference.
-                    const auto ptile = top_of_que;
-                    // Remove the old top listing.
-                    ptq.pop();
-
-                    // We know that we are not propagating from a tile along the map border, so it is safe to check for walls.
-                    // Grab our adjacent tiles, and the values for our center tile.
-                    adjacent_tiles = get_adjacent_tiles( ptile.pos );
-                    // Set our wall1 and wall2 bools
-                    const auto &san_pdir = get_san_dir( ptile.dir );
-                    check_walls( ptile.dir );
-
-                    // Iterate through adjacent tiles.
-                    const auto &dirs_to_check = spropagation_tiles_by_sdirection[san_pdir];
-                    for( uint8_t adj_tile_dir : dirs_to_check ) {
-                        // Check should be being fed only constexpr inputs by this point.
-                        if( skip_due_to_wall( get_s_wall_bool_pair( wall_bools.first, wall_bools.second ), san_pdir,
-                                              adj_tile_dir ) ) {
-                            continue;
-                        }
+    };
 
-                        const auto &adj_tile = adjacent_tiles[adj_tile_dir];
-                        const auto adj_tile_cve = adj_tile + cv_env_rel_ms_adj;
-                        const auto &adjt_checkvars = checkvars[adj_tile_cve.x()][adj_tile_cve.y()];
-                        // Dont check tiles that are not valid for propagation, i.e. behind the direction of sound, around a corner, or out of bounds.
-                        if( temp_sound_cache.in_envelope( adj_tile ) && !adjt_checkvars.all() ) {
-                            auto &adj_tile_vol = svol[v_index_from_p( adj_tile )];
-                            // Cap our tile distance between 1 and 121 to prevent overflow. We dont have or need distance loss values past dist_vol_loss[121]
-                            // as the change in distance loss values past this point are negligible for gameplay scale.
-                            const uint8_t dist_for_vol_loss = get_distance_for_volume_loss( ptile.dist,
-                                                              ( adj_tile_dir == dirs_to_check.front() ||
-                                                                adj_tile_dir == dirs_to_check.back() ) );
-                            const short vol_to_check = std::max( 0,
-                                                                 ( ptile.vol - absorption_from_checkvar_bitset( adjt_checkvars ) -
-                                                                   ( dist_vol_loss[dist_for_vol_loss] ) - snowbonus ) );
-                            // General priority goes loudest volume, then largest distance. Smaller distances loose volume more quickly.
-                            // If volumes are equal and directions are one off from eachother, the cardinal direction wins.
-                            // We dont want to track inaudible single dB values across the entire map for each sound.
-                            if( vol_to_check > adj_tile_vol ) {
-                                // Check this if sound propagation is acting up. Comment out if things are playing nice.
-                                if( vol_to_check > dBspl_to_mdBspl( temp_sound_cache.sound.volume ) ) {
-                                    debugmsg( "Sound with description [ %1s ] attempted to propagate from %i:%i at %i mdB to %i:%i at %i mdB, a louder volume than the origin volume of %i mdB!"
-                                              , temp_sound_cache.sound.description, ptile.pos.x(), ptile.pos.y(), ptile.vol, adj_tile.x(),
-                                              adj_tile.y(),
-                                              vol_to_check, origin_volume );
-                                    // Dont break the laws of physics
-                                    continue;
-                                }
-                                adj_tile_vol = vol_to_check;
+    // Run through the priority que using the spropagate_from_tile lambda.
+    // And then we repeat until no new tiles need to be updated.
+    while( !ptq.empty() ) {
+        // Propagate our loudest tile.
+        spropagate_from_tile( ptq.top() );
+        // After calculating our loudest sound should already have been removed.
+    }
 
-                                check_escape( adj_tile_cve.x(), adj_tile_cve.y(), vol_to_check, dist_for_vol_loss );
+    // Probably a cleaner way to do this but oh well.
+    // Less total work than checking if we are at the edge of the envelope, figuring out which side of the envelope, and then incrimenting our bean count every time we propagate a tile.
+    // RMS is sqrt( (x1^2 + x2^2 + ... xn^2)/n )
+    const int envelope_width = get_flood_envelope_by_enum( flood_dist_enum_by_index[vol_enum_index] );
+    const int env_2r = f_radius * 2;
+    double vol_tally = 0;
+    int non_zero = 0;
 
-                                if( adj_tile_vol > SOUND_ABSORPTION_OPEN_FIELD ) {
-                                    // If the tiles new volume is greater than our old one and is inside the envelope, mark it for update.
-                                    // Will not update if the adjacent tile is along the map boundry.
-                                    ptq.emplace( propagation_tile( adj_tile, vol_to_check, adj_tile_dir, dist_for_vol_loss ) );
-                                }
-                            }
-                        }
-                    }
+    auto comp_cart_escape = [&]( const uint8_t &cart_dir ) -> void{
+        escape_vol[cart_dir] = ( non_zero == 0 ) ? 0 : static_cast<short>( std::round( sqrt( ( vol_tally ) / non_zero ) ) );
+        vol_tally = 0;
+        non_zero = 0;
+    };
+    for( int i = 0; i < envelope_width; i++ ) {
+        // Starting with north escapes, so all of our desired volumes will be at envelope_y = radius * 2.
+        if( svol[( i * envelope_width ) + env_2r] > 0 ) {
+            non_zero++;
+            vol_tally += pow( svol[( i * envelope_width ) + env_2r], 2 );
+        }
+    }
+    comp_cart_escape( SDI_N );
 
-                };
+    for( int i = 0; i < envelope_width; i++ ) {
+        // For east escapes all all of our desired volumes will be at envelope_x = radius * 2.
+        if( svol[( env_2r * envelope_width ) + i] > 0 ) {
+            non_zero++;
+            vol_tally += pow( svol[( env_2r * envelope_width ) + i], 2 );
+        }
+    }
+    comp_cart_escape( SDI_E );
 
-                // Run through the priority que using the spropagate_from_tile lambda.
-                // And then we repeat until no new tiles need to be updated.
-                while( !ptq.empty() ) {
-                    // Propagate our loudest tile.
-                    spropagate_from_tile( ptq.top() );
-                    // After calculating our loudest sound should already have been removed.
-                }
+    for( int i = 0; i < envelope_width; i++ ) {
+        // For south escapes all all of our desired volumes will be at envelope_y = 0.
+        if( svol[( i * envelope_width )] > 0 ) {
+            non_zero++;
+            vol_tally += pow( svol[ i * envelope_width ], 2 );
+        }
+    }
+    comp_cart_escape( SDI_S );
 
-                // Probably a cleaner way to do this but oh well.
-                // Less total work than checking if we are at the edge of the envelope, figuring out which side of the envelope, and then incrimenting our bean count every time we propagate a tile.
-                // RMS is sqrt( (x1^2 + x2^2 + ... xn^2)/n )
-                const int envelope_width = get_flood_envelope_by_enum( flood_dist_enum_by_index[vol_enum_index] );
-                const int env_2r = f_radius * 2;
-                double vol_tally = 0;
-                int non_zero = 0;
-
-                auto comp_cart_escape = [&]( const uint8_t &cart_dir ) -> void{
-                    escape_vol[cart_dir] = ( non_zero == 0 ) ? 0 : static_cast<short>( std::round( sqrt( ( vol_tally ) / non_zero ) ) );
-                    vol_tally = 0;
-                    non_zero = 0;
-                };
-                for( int i = 0; i < envelope_width; i++ ) {
-                    // Starting with north escapes, so all of our desired volumes will be at envelope_y = radius * 2.
-                    if( svol[( i * envelope_width ) + env_2r] > 0 ) {
-                        non_zero++;
-                        vol_tally += pow( svol[( i * envelope_width ) + env_2r], 2 );
-                    }
-                }
-                comp_cart_escape( SDI_N );
+    for( int i = 0; i < envelope_width; i++ ) {
+        // For west escapes all all of our desired volumes will be at envelope_x = 0.
 
-                for( int i = 0; i < envelope_width; i++ ) {
-                    // For east escapes all all of our desired volumes will be at envelope_x = radius * 2.
-                    if( svol[( env_2r * envelope_width ) + i] > 0 ) {
-                        non_zero++;
-                        vol_tally += pow( svol[( env_2r * envelope_width ) + i], 2 );
-                    }
-                }
-                comp_cart_escape( SDI_E );
+        if( svol[ i ] > 0 ) {
+            non_zero++;
+            vol_tally += pow( svol[ i ], 2 );
+        }
+    }
+    comp_cart_escape( SDI_W );
 
-                for( int i = 0; i < envelope_width; i++ ) {
-                    // For south escapes all all of our desired volumes will be at envelope_y = 0.
-                    if( svol[( i * envelope_width )] > 0 ) {
-                        non_zero++;
-                        vol_tally += pow( svol[ i * envelope_width ], 2 );
-                    }
-                }
-                comp_cart_escape( SDI_S );
+    // Now run through our diagonals.
+    // Now run through our diagonals.
+    for( uint8_t i : sanitized_sound_direction_indexes_diagonal ) {
+        const auto &cclockwise = wall_check_by_sdirection[i].first;
+        const auto &clockwise = wall_check_by_sdirection[i].second;
+        escape_vol[i] = ( escape_vol[clockwise] != 0 ||
+                          escape_vol[cclockwise] != 0 ) ? std::round( sqrt( ( pow( escape_vol[cclockwise],
+                                  2 ) + pow( escape_vol[clockwise], 2 ) ) / 2 ) ) : 0;
+    }
 
-                for( int i = 0; i < envelope_width; i++ ) {
-                    // For west escapes all all of our desired volumes will be at envelope_x = 0.
+    if( temp_sound_cache.source_indoors && escape_vol[SDI_UP] > 0 ) {
+        temp_sound_cache.escaped_indoors = true;
+    }
 
-                    if( svol[ i ] > 0 ) {
-                        non_zero++;
-                        vol_tally += pow( svol[ i ], 2 );
-                    }
-                }
-                comp_cart_escape( SDI_W );
-
-                // Now run through our diagonals.
-                // Now run through our diagonals.
-                for( uint8_t i : sanitized_sound_direction_indexes_diagonal ) {
-                    const auto &cclockwise = wall_check_by_sdirection[i].first;
-                    const auto &clockwise = wall_check_by_sdirection[i].second;
-                    escape_vol[i] = ( escape_vol[clockwise] != 0 ||
-                                      escape_vol[cclockwise] != 0 ) ? std::round( sqrt( ( pow( escape_vol[cclockwise],
-                                              2 ) + pow( escape_vol[clockwise], 2 ) ) / 2 ) ) : 0;
-                }
+    // And from the maximum escape volume, approximate our minvol radius for easy distance filtering.
+    vol_tally = 0;
+    for( uint8_t dir : sanitized_sound_direction_indexes_full ) {
+        auto &esc_vol = escape_vol[dir];
+        if( esc_vol > origin_volume ) {
+            const auto &sop = temp_sound_cache.origin;
+            debugmsg( "Sound with description [ %1s ] from %i:%i:%i at %i mdB has impossible escape volume in direction %i of %i mdB ",
+                      temp_sound_cache.sound.description, sop.x(), sop.y(), sop.z(), origin_volume, dir, esc_vol );
+            esc_vol = origin_volume;
+        }
+        vol_tally = std::max( vol_tally, static_cast<double>( esc_vol ) );
+    }
+    // We use this for an easy distance check threshold when feeding monsters sound.
+    temp_sound_cache.approximate_minvol_distance = average_minvol_distance(
+                temp_sound_cache.flood_radius, static_cast<short>( vol_tally ),
+                temp_sound_cache.terrain_sound_absorbtion_at_source );
 
-                if( temp_sound_cache.source_indoors && escape_vol[SDI_UP] > 0 ) {
-                    temp_sound_cache.escaped_indoors = true;
-                }
+    return temp_sound_cache;
+}
 
-                // And from the maximum escape volume, approximate our minvol radius for easy distance filtering.
-                vol_tally = 0;
-                for( uint8_t dir : sanitized_sound_direction_indexes_full ) {
-                    auto &esc_vol = escape_vol[dir];
-                    if( esc_vol > origin_volume ) {
-                        const auto &sop = temp_sound_cache.origin;
-                        debugmsg( "Sound with description [ %1s ] from %i:%i:%i at %i mdB has impossible escape volume in direction %i of %i mdB ",
-                                  temp_sound_cache.sound.description, sop.x(), sop.y(), sop.z(), origin_volume, dir, esc_vol );
-                        esc_vol = origin_volume;
-                    }
-                    vol_tally = std::max( vol_tally, static_cast<double>( esc_vol ) );
-                }
-                // We use this for an easy distance check threshold when feeding monsters sound.
-                temp_sound_cache.approximate_minvol_distance = average_minvol_distance(
-                            temp_sound_cache.flood_radius, static_cast<short>( vol_tally ),
-                            temp_sound_cache.terrain_sound_absorbtion_at_source );
-
-
-                // The sound cache should be built out by now.
-                // Add our new sound cache to the games sound_caches vector.
-                // add_msg(m_debug, "Attempting to add sound_cache with origin %i x: %i y: %i z and source volume %i to sound_caches vector .", temp_sound_cache.sound.origin.x, temp_sound_cache.sound.origin.y, temp_sound_cache.sound.origin.z, temp_sound_cache.sound.volume );
-                m_sound_cache.sound_instances.push_back( temp_sound_cache );
-                // add_msg(m_debug, "Sound cache added to vector");
-                if( temp_sound_cache.from_monster ) {
-                    num_processed_mon_sounds++;
-                } else if( temp_sound_cache.from_npc ) {
-                    num_processed_NPC_sounds++;
-                }
-                continue;
-            }
-            // If our sound was not loud enough, invalidate it.
+// Batch flood fills a given vector of sound events, stepping through all z levels.
+// New sound_cache are then added to the sound_caches vector in map.
+void map::batch_flood_fill_sounds()
+{
+    ZoneScoped;
+    // Our que of sound events to flood fill
+    auto &batch_que = sound_batch_floodfill_que;
+    const bool is_winter =  season_of_year( calendar::turn ) == WINTER;
+    const short snowbonus = ( is_winter ) ? SOUND_ABSORPTION_SNOW_BONUS : SOUND_ABSORPTION_OPEN_FIELD;
+
+    // How many sounds did we actually process?
+    auto &num_processed_mon_sounds = m_sound_cache.batch_flooded_monster_sounds;
+    auto &num_processed_NPC_sounds = m_sound_cache.batch_flooded_NPC_sounds;
+    auto &num_invalidated_sounds = m_sound_cache.invalidated_batch_sounds;
+
+    // Sounds go into the sound_caches vector one z-level after another, lowest first.
+    std::vector<const sound_event *> flooded;
+    flooded.reserve( batch_que.size() );
+    for( const sound_event &sound : batch_que ) {
+        const int z = sound.origin.z();
+        if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+            continue;
+        }
+        if( sound.volume < 7 ) {
             num_invalidated_sounds++;
             continue;
         }
+        flooded.push_back( &sound );
+    }
+    std::ranges::stable_sort( flooded, std::less<>(), []( const sound_event * sound ) {
+        return sound->origin.z();
+    } );
+
+    // A flood only depends on where a sound starts and how loud it is, so a horde screaming
+    // from the same tiles shares envelopes.
+    std::map<std::pair<tripoint_bub_ms, short>, size_t> flood_by_source;
+    std::vector<const sound_event *> sources;
+    std::vector<size_t> flood_of;
+    flood_of.reserve( flooded.size() );
+    for( const sound_event *sound : flooded ) {
+        const auto [it, inserted] = flood_by_source.try_emplace( { sound->origin, sound->volume },
+                                    sources.size() );
+        if( inserted ) {
+            sources.push_back( sound );
+        }
+        flood_of.push_back( it->second );
+    }
+
+    std::vector<sound_instance_cache> floods( sources.size() );
+    const int num_floods = static_cast<int>( sources.size() );
+    const auto flood_one = [&]( const int i ) {
+        floods[i] = flood_fill_batched_sound( *this, *sources[i], snowbonus );
+    };
+    if( parallel_enabled && parallel_sound_flood_fill && num_floods > 1 && !is_pool_worker_thread() ) {
+        parallel_for( "sound_flood_fill", 0, num_floods, flood_one );
+    } else {
+        for( int i = 0; i < num_floods; i++ ) {
+            flood_one( i );
+        }
+    }
+
+    std::vector<int> uses_left( floods.size(), 0 );
+    for( const size_t source : flood_of ) {
+        uses_left[source]++;
+    }
+    for( size_t i = 0; i < flooded.size(); i++ ) {
+        const size_t source = flood_of[i];
+        // The last sound from a source takes the envelope itself instead of a copy.
+        sound_instance_cache temp_sound_cache;
+        if( --uses_left[source] == 0 ) {
+            temp_sound_cache = std::move( floods[source] );
+        } else {
+            temp_sound_cache = floods[source];
+        }
+        if( sources[source] != flooded[i] ) {
+            temp_sound_cache.set_sound( *flooded[i] );
+        }
+        if( temp_sound_cache.from_monster ) {
+            num_processed_mon_sounds++;
+        } else if( temp_sound_cache.from_npc ) {
+            num_processed_NPC_sounds++;
+        }
+        m_sound_cache.sound_instances.push_back( std::move( temp_sound_cache ) );
     }
     batch_que.clear();
 
 }
 
+// Fill the checkvars bits of rebuild_absorption_cache that only depend on the terrain and
+// furniture of a tile: 0, 1 and 4 to 7.  Reads the cache_attr tables, not ter_t/furn_t.
+static auto set_structure_checkvars( std::bitset<8> &cv, const ter_id &ter,
+                                     const furn_id &furn ) -> void
+{
+    const auto ter_flags = cache_attr::of( ter );
+    const auto furn_flags = cache_attr::of( furn );
+    // Rather common for tents, standalone curtains, and other such oddities to have one of these. These will count for adjacency purposes, so long as they are not permeable.
+    cv[7] = ( furn_flags & ( cache_attr::no_scent | cache_attr::block_wind ) ) != 0;
+    // There are something like 5 pieces of furniture with the reduce scent flag, and most of them are cardboard walls that are also permeable. Fine to not check that.
+    cv[4] = ( ( ter_flags | furn_flags ) & cache_attr::permeable ) != 0;
+    cv[5] = ( ter_flags & cache_attr::no_scent ) != 0;
+    // For whatever reason some terrain has both blocks wind and permeable, or reduce scent and block wind.
+    cv[6] = ( ter_flags & cache_attr::block_wind ) != 0;
+    // If the tile has furniture that blocks wind/scent, it cant also have valid terrain that does the same.
+    if( cv[7] ) {
+        return;
+    }
+    const bool wall = ( ter_flags & cache_attr::wall ) != 0;
+    const bool connect = ( ter_flags & cache_attr::connect_to_wall ) != 0;
+    // We can now check if there is a wall, a connect to wall, a block wind, or no scent in the tile.
+    if( !cv[5] && !cv[6] && !wall && !connect ) {
+        return;
+    }
+    // This is the only real way we can distinguish open doors from closed ones as in many cases both will have blocks wind.
+    const bool ter_road = ( ter_flags & cache_attr::road ) != 0;
+    const uint8_t move_cost = cache_attr::move_cost( ter );
+    // We only have a full wall if its not permeable, not reduce_scent, not a road, and does not have a move cost >0.
+    // The terrain in question needs to be a proper wall.
+    if( !ter_road && move_cost == 0 && !cv[4] && wall ) {
+        // Full wall absorption is case 3, cv0 && cv1
+        cv[0] = true;
+        cv[1] = true;
+    } else if( ter_road || move_cost != 0 ) {
+        // If ter road is set we most likely have an open door. If the move cost is not zero, we can walk through it
+        // If we can walk through it, it will not meaningfully limit sound propagation.
+        // Tweak this later if passable sound forcefields or something are desired.
+        // This tile counts for adjacency, but will not limit sound to simulate an open door or something.
+        cv[0] = true;
+    } else if( wall || connect ) {
+        // Needs to be a wall, connect to wall, or block wind/scent to potentially be a thick barrier.
+        // We later check against permeability to see if it actually only counts as a barrier.
+        cv[1] = true;
+    }
+}
+
 // Rebuild the sound absorption cache of a given submap
 // This will also build out the sound wall cache of the given submap.
 auto submap::rebuild_absorption_cache( const map &m, const tripoint_bub_sm &grid_pos ) -> void
@@ -1345,105 +1435,18 @@ auto submap::rebuild_absorption_cache( const map &m, const tripoint_bub_sm &grid
                     continue;
                 } else {
                     const auto &tidx = lev_cache.idx( tile.x(), tile.y() );
-                    const auto &ter = m.ter( tile );
-                    const auto &furn = m.furn( tile );
-                    // Rather common for tents, standalone curtains, and other such oddities to have one of these. These will count for adjacency purposes, so long as they are not permeable.
-                    cv[7] = furn->has_flag( TFLAG_NO_SCENT ) || furn->has_flag( TFLAG_BLOCK_WIND );
+                    set_structure_checkvars( cv, m.ter( tile ), m.furn( tile ) );
                     cv[2] = m.is_outside( tile );
                     cv[3] = ( !at_max_zlev ) ? above->floor_cache[tidx] > 0 : false;
-                    // There are something like 5 pieces of furniture with the reduce scent flag, and most of them are cardboard walls that are also permeable. Fine to not check that.
-                    cv[4] = ter->has_flag( TFLAG_PERMEABLE ) || ter->has_flag( TFLAG_REDUCE_SCENT ) ||
-                            furn->has_flag( TFLAG_PERMEABLE );
-                    cv[5] = ter->has_flag( TFLAG_NO_SCENT );
-                    // For whatever reason some terrain has both blocks wind and permeable, or reduce scent and block wind.
-                    cv[6] = ter->has_flag( TFLAG_BLOCK_WIND );
-                    // If the tile has furniture that blocks wind/scent, it cant also have valid terrain that does the same.
-                    if( !cv[7] ) {
-                        // Better for us to poll these once and store it then repeatedly poll map for them
-                        const bool wall = ter->has_flag( TFLAG_WALL );
-                        const bool connect = ter->has_flag( TFLAG_CONNECT_TO_WALL );
-                        // We can now check if there is a wall, a connect to wall, a block wind, or no scent in the tile.
-                        if( cv[5] || cv[6] || wall || connect ) {
-                            const bool ter_road = ter->has_flag(
-                                                      TFLAG_ROAD ); // This is the only real way we can distinguish open doors from closed ones as in many cases both will have blocks wind.
-                            const uint8_t move_cost = ter->movecost;
-                            // We only have a full wall if its not permeable, not reduce_scent, not a road, and does not have a move cost >0.
-                            // The terrain in question needs to be a proper wall.
-                            if( !ter_road && move_cost == 0 && !cv[4] && wall ) {
-                                // Full wall absorption is case 3, cv0 && cv1
-                                cv[0] = true;
-                                cv[1] = true;
-                            } else if( ter_road || move_cost != 0 ) {
-                                // If ter road is set we most likely have an open door. If the move cost is not zero, we can walk through it
-                                // If we can walk through it, it will not meaningfully limit sound propagation.
-                                // Tweak this later if passable sound forcefields or something are desired.
-                                // This tile counts for adjacency, but will not limit sound to simulate an open door or something.
-                                cv[0] = true;
-                            } else {
-                                if( wall || connect ) {
-                                    // Needs to be a wall or connect to wall to count as a thick barrier
-                                    cv[1] = true;
-                                }
-
-                            }
-
-                        }
-
-                    }
-
                 }
             } else {
                 // We are inside our submap We know we are inbounds, and can poll freely.
                 const point_sm_ms sm_tile = point_sm_ms{x - 1, y - 1};
                 const auto tile = cv_abs_trip + point{x, y};
                 const auto tidx = lev_cache.idx( tile.x(), tile.y() );
-                const auto &ter = get_ter( sm_tile ).obj();
-                const auto &furn = get_furn( sm_tile ).obj();
-                // Rather common for tents, standalone curtains, and other such oddities to have one of these. These will count for adjacency purposes, so long as they are not permeable.
-                cv[7] = furn.has_flag( TFLAG_NO_SCENT ) || furn.has_flag( TFLAG_BLOCK_WIND );
+                set_structure_checkvars( cv, get_ter( sm_tile ), get_furn( sm_tile ) );
                 cv[2] = m.is_outside( tile );
                 cv[3] = ( !at_max_zlev ) ? ( above->floor_cache[tidx] != 0 ) : false;
-                // There are something like 5 pieces of furniture with the reduce scent flag, and most of them are cardboard walls that are also permeable. Fine to not check that.
-                cv[4] = ter.has_flag( TFLAG_PERMEABLE ) || ter.has_flag( TFLAG_REDUCE_SCENT ) ||
-                        furn.has_flag( TFLAG_PERMEABLE );
-                cv[5] = ter.has_flag( TFLAG_NO_SCENT );
-                // For whatever reason some terrain has both blocks wind and permeable, or reduce scent and block wind.
-                cv[6] = ter.has_flag( TFLAG_BLOCK_WIND );
-                // If the tile has furniture that blocks wind/scent, it cant also have valid terrain that does the same.
-                if( !cv[7] ) {
-                    // Better for us to poll these once and store it then repeatedly poll map for them
-                    const bool wall = ter.has_flag( TFLAG_WALL );
-                    const bool connect = ter.has_flag( TFLAG_CONNECT_TO_WALL );
-                    // We can now check if there is a wall, a connect to wall, a block wind, or no scent in the tile.
-                    if( cv[5] || cv[6] || wall || connect ) {
-                        const bool ter_road = ter.has_flag(
-                                                  TFLAG_ROAD ); // This is the only real way we can distinguish open doors from closed ones as in many cases both will have blocks wind.
-                        const uint8_t move_cost = ter.movecost;
-                        // We only have a full wall if its not permeable, not reduce_scent, not a road, and does not have a move cost >0.
-                        // The terrain in question needs to be a proper wall.
-                        if( !ter_road && move_cost == 0 && !cv[4] && wall ) {
-                            // Full wall absorption is case 3, cv0 && cv1
-                            cv[0] = true;
-                            cv[1] = true;
-                        } else if( ter_road || move_cost != 0 ) {
-                            // If ter road is set we most likely have an open door. If the move cost is not zero, we can walk through it
-                            // If we can walk through it, it will not meaningfully limit sound propagation.
-                            // Tweak this later if passable sound forcefields or something are desired.
-                            // This tile counts for adjacency, but will not limit sound to simulate an open door or something.
-                            cv[0] = true;
-                        } else {
-                            if( wall || connect ) {
-                                // Needs to be a wall, connect to wall, or block wind/scent to potentially be a thick barrier.
-                                cv[1] = true;
-                                // We later check against permeability to see if it actually only counts as a barrier.
-                            }
-
-                        }
-
-                    }
-
-                }
-
             }
         }
 
@@ -0,0 +1,112 @@
+#include "sprite_batch.h"
+#if defined(TILES)
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <utility>
+
+#include "profile.h"
+
+void sprite_batch::begin( const SDL_Renderer_Ptr &r )
+{
+    flush();
+    renderer = r.get();
+    sprites_queued = 0;
+    calls_submitted = 0;
+}
+
+void sprite_batch::end()
+{
+    flush();
+    renderer = nullptr;
+    TracyPlot( "Sprite Batch Sprites", static_cast<int64_t>( sprites_queued ) );
+    TracyPlot( "Sprite Batch Calls", static_cast<int64_t>( calls_submitted ) );
+}
+
+void sprite_batch::add( SDL_Texture *const tex, const SDL_BlendMode blend,
+                        const SDL_FRect &srcrect, const SDL_FRect &dstrect, const double angle,
+                        const SDL_FlipMode flip, const SDL_FColor &color )
+{
+    if( tex != texture || blend != blend_mode ) {
+        flush();
+        texture = tex;
+        blend_mode = blend;
+    }
+
+    float u0 = srcrect.x / static_cast<float>( tex->w );
+    float v0 = srcrect.y / static_cast<float>( tex->h );
+    float u1 = ( srcrect.x + srcrect.w ) / static_cast<float>( tex->w );
+    float v1 = ( srcrect.y + srcrect.h ) / static_cast<float>( tex->h );
+    if( flip & SDL_FLIP_HORIZONTAL ) {
+        std::swap( u0, u1 );
+    }
+    if( flip & SDL_FLIP_VERTICAL ) {
+        std::swap( v0, v1 );
+    }
+
+    // Corners clockwise from the top left, relative to the centre of the destination.
+    const float half_w = dstrect.w / 2.0f;
+    const float half_h = dstrect.h / 2.0f;
+    const float cx = dstrect.x + half_w;
+    const float cy = dstrect.y + half_h;
+    std::array<SDL_FPoint, 4> corners = { {
+            { -half_w, -half_h }, { half_w, -half_h }, { half_w, half_h }, { -half_w, half_h }
+        }
+    };
+    if( angle != 0.0 ) {
+        const double rad = angle * std::numbers::pi / 180.0;
+        const float s = static_cast<float>( std::sin( rad ) );
+        const float c = static_cast<float>( std::cos( rad ) );
+        for( SDL_FPoint &p : corners ) {
+            p = { p.x * c - p.y * s, p.x * s + p.y * c };
+        }
+    }
+    const std::array<SDL_FPoint, 4> uvs = { { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } } };
+
+    const int first = static_cast<int>( vertices.size() );
+    for( size_t i = 0; i < corners.size(); ++i ) {
+        vertices.push_back( SDL_Vertex{ { cx + corners[i].x, cy + corners[i].y }, color, uvs[i] } );
+    }
+    for( const int i : { 0, 1, 2, 0, 2, 3 } ) {
+        indices.push_back( first + i );
+    }
+    ++sprites_queued;
+}
+
+void sprite_batch::flush()
+{
+    if( vertices.empty() ) {
+        return;
+    }
+    ZoneScoped;
+
+    // The vertices carry the modulation, so the texture's own must not apply on top.
+    Uint8 old_r = 255;
+    Uint8 old_g = 255;
+    Uint8 old_b = 255;
+    Uint8 old_alpha = 255;
+    SDL_BlendMode old_blend_mode = SDL_BLENDMODE_BLEND;
+    SDL_GetTextureColorMod( texture, &old_r, &old_g, &old_b );
+    SDL_GetTextureAlphaMod( texture, &old_alpha );
+    SDL_GetTextureBlendMode( texture, &old_blend_mode );
+    SDL_SetTextureColorMod( texture, 255, 255, 255 );
+    SDL_SetTextureAlphaMod( texture, 255 );
+    SDL_SetTextureBlendMode( texture, blend_mode );
+
+    printErrorIf( !SDL_RenderGeometry( renderer, texture, vertices.data(),
+                                       static_cast<int>( vertices.size() ), indices.data(),
+                                       static_cast<int>( indices.size() ) ),
+                  "SDL_RenderGeometry failed" );
+
+    SDL_SetTextureColorMod( texture, old_r, old_g, old_b );
+    SDL_SetTextureAlphaMod( texture, old_alpha );
+    SDL_SetTextureBlendMode( texture, old_blend_mode );
+
+    vertices.clear();
+    indices.clear();
+    ++calls_submitted;
+}
+
+#endif
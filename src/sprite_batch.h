@@ -0,0 +1,49 @@
+#pragma once
+
+#if defined(TILES)
+
+#include <vector>
+
+#include "sdl_wrappers.h"
+
+/**
+ * Collects textured quads and submits consecutive ones that share a texture and blend
+ * mode with a single SDL_RenderGeometry call.
+ *
+ * Sprites keep the order they were queued in: any change of texture or blend mode
+ * flushes what is pending first, so overlapping sprites still stack the same way.
+ * Colour and alpha modulation travel with the vertices instead of the texture, so
+ * sprites tinted differently can share a call.  Anything drawn to the renderer by other
+ * means while the batch is open must be preceded by @ref flush.
+ */
+class sprite_batch
+{
+    public:
+        /** Starts collecting sprites for @p renderer. */
+        void begin( const SDL_Renderer_Ptr &renderer );
+        /** Submits what is pending and stops collecting. */
+        void end();
+        bool active() const {
+            return renderer != nullptr;
+        }
+
+        /**
+         * Queues @p srcrect of @p tex to be drawn to @p dstrect, as @ref SDL_RenderTextureRotated
+         * would with @p angle degrees clockwise around the centre of @p dstrect.
+         */
+        void add( SDL_Texture *tex, SDL_BlendMode blend, const SDL_FRect &srcrect,
+                  const SDL_FRect &dstrect, double angle, SDL_FlipMode flip, const SDL_FColor &color );
+        /** Submits what is pending. */
+        void flush();
+
+    private:
+        SDL_Renderer *renderer = nullptr;
+        SDL_Texture *texture = nullptr;
+        SDL_BlendMode blend_mode = SDL_BLENDMODE_BLEND;
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+        int sprites_queued = 0;
+        int calls_submitted = 0;
+};
+
+#endif
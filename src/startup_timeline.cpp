@@ -0,0 +1,173 @@
+#include "startup_timeline.h"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <utility>
+#include <vector>
+
+#include "fstream_utils.h"
+#include "json.h"
+
+namespace startup_timeline
+{
+
+namespace
+{
+
+struct event {
+    std::string name;
+    std::string category;
+    std::string mod;
+    clock::time_point start;
+    clock::time_point end;
+    int tid = 0;
+    // Number of calls summed into an aggregated part; 0 for plain spans.
+    int count = 0;
+};
+
+struct timeline {
+    std::mutex mutex;
+    std::string path;
+    clock::time_point origin;
+    std::vector<event> events;
+};
+
+std::atomic<bool> recording = false;
+
+auto get_timeline() -> timeline &
+{
+    static timeline instance;
+    return instance;
+}
+
+auto thread_track() -> int
+{
+    static std::atomic<int> next_track = 0;
+    thread_local const int track = next_track++;
+    return track;
+}
+
+auto add_event( event e ) -> void
+{
+    timeline &t = get_timeline();
+    std::lock_guard<std::mutex> lock( t.mutex );
+    t.events.push_back( std::move( e ) );
+}
+
+auto to_us( const clock::duration d ) -> int64_t
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>( d ).count();
+}
+
+} // namespace
+
+auto enable( const std::string &path ) -> void
+{
+    timeline &t = get_timeline();
+    std::lock_guard<std::mutex> lock( t.mutex );
+    t.path = path;
+    t.origin = clock::now();
+    recording = true;
+}
+
+auto enabled() -> bool
+{
+    return recording.load( std::memory_order_relaxed );
+}
+
+auto record( const std::string &name, const std::string &category, const std::string &mod,
+             const clock::time_point start, const clock::time_point end ) -> void
+{
+    if( !enabled() ) {
+        return;
+    }
+    add_event( { name, category, mod, start, end, thread_track() } );
+}
+
+auto write() -> void
+{
+    if( !enabled() ) {
+        return;
+    }
+    timeline &t = get_timeline();
+    std::vector<event> events;
+    clock::time_point origin;
+    std::string path;
+    {
+        std::lock_guard<std::mutex> lock( t.mutex );
+        events = t.events;
+        origin = t.origin;
+        path = t.path;
+    }
+    write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout );
+        jsout.start_object();
+        jsout.member( "displayTimeUnit", "ms" );
+        jsout.member( "traceEvents" );
+        jsout.start_array();
+        for( const event &e : events ) {
+            jsout.start_object();
+            jsout.member( "name", e.name );
+            jsout.member( "cat", e.category );
+            jsout.member( "ph", "X" );
+            jsout.member( "pid", 1 );
+            jsout.member( "tid", e.tid );
+            jsout.member( "ts", to_us( e.start - origin ) );
+            jsout.member( "dur", to_us( e.end - e.start ) );
+            if( !e.mod.empty() || e.count > 0 ) {
+                jsout.member( "args" );
+                jsout.start_object();
+                if( !e.mod.empty() ) {
+                    jsout.member( "mod", e.mod );
+                }
+                if( e.count > 0 ) {
+                    jsout.member( "calls", e.count );
+                }
+                jsout.end_object();
+            }
+            jsout.end_object();
+        }
+        jsout.end_array();
+        jsout.end_object();
+    }, "startup trace" );
+}
+
+span::span( std::string name, std::string category, std::string mod )
+    : name_( std::move( name ) )
+    , category_( std::move( category ) )
+    , mod_( std::move( mod ) )
+    , active_( enabled() )
+{
+    if( active_ ) {
+        start_ = clock::now();
+    }
+}
+
+span::~span()
+{
+    if( !active_ ) {
+        return;
+    }
+    const clock::time_point end = clock::now();
+    const int tid = thread_track();
+    add_event( { name_, category_, mod_, start_, end, tid } );
+    clock::time_point at = start_;
+    for( const auto &[part, total] : parts_ ) {
+        add_event( { part, category_ + ".part", mod_, at, at + total.time, tid, total.count } );
+        at += total.time;
+    }
+}
+
+auto span::add_part( const std::string &part, const clock::duration d ) -> void
+{
+    if( !active_ ) {
+        return;
+    }
+    part_total &total = parts_[part];
+    total.time += d;
+    ++total.count;
+}
+
+} // namespace startup_timeline
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <string>
+
+/**
+ * Timeline of game startup, written as a Chrome trace (chrome://tracing,
+ * Perfetto) when the game is started with `--startup-trace <path>`.
+ *
+ * Recording is off unless enable() was called, and every entry point returns
+ * right away in that case, so the hooks can stay in place in release builds.
+ * Spans may be recorded from any thread; each thread gets its own track.
+ */
+namespace startup_timeline
+{
+
+using clock = std::chrono::steady_clock;
+
+/** Starts recording; write() saves the trace to @p path. */
+auto enable( const std::string &path ) -> void;
+auto enabled() -> bool;
+
+/**
+ * Records a finished span.  @p mod, if not empty, names the content pack the
+ * time is spent on and is shown in the span's arguments.
+ */
+auto record( const std::string &name, const std::string &category, const std::string &mod,
+             clock::time_point start, clock::time_point end ) -> void;
+
+/**
+ * Writes everything recorded so far, replacing the previous trace.  Called
+ * whenever a loading phase ends, so a trace exists even if the game is killed
+ * later.  Does nothing unless recording is on.
+ */
+auto write() -> void;
+
+/** Records the lifetime of the object as one span. */
+class span
+{
+    public:
+        span( std::string name, std::string category, std::string mod = {} );
+        ~span();
+        span( const span & ) = delete;
+        auto operator=( const span & ) -> span & = delete;
+
+        /**
+         * Adds @p d of time spent on @p part inside this span.  Parts are
+         * summed and shown as child spans laid end to end from the start of
+         * this one, so many short calls (say, one per JSON object) cost a map
+         * lookup rather than a trace event each.
+         */
+        auto add_part( const std::string &part, clock::duration d ) -> void;
+
+    private:
+        struct part_total {
+            clock::duration time = clock::duration::zero();
+            int count = 0;
+        };
+
+        std::string name_;
+        std::string category_;
+        std::string mod_;
+        clock::time_point start_;
+        std::map<std::string, part_total> parts_;
+        bool active_;
+};
+
+} // namespace startup_timeline
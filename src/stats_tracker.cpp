@@ -142,17 +142,20 @@ stats_tracker::~stats_tracker()
 
 event_multiset &stats_tracker::get_events( event_type type )
 {
+    flush_deferred();
     return data.emplace( type, event_multiset( type ) ).first->second;
 }
 
 event_multiset stats_tracker::get_events(
     const string_id<event_transformation> &transform_id )
 {
+    flush_deferred();
     return transform_id->value( *this );
 }
 
 cata_variant stats_tracker::value_of( const string_id<event_statistic> &stat )
 {
+    flush_deferred();
     return stat->value( *this );
 }
 
@@ -246,6 +249,7 @@ std::vector<const score *> stats_tracker::valid_scores() const
 
 void stats_tracker::clear()
 {
+    flush_deferred();
     unwatch_all();
     data.clear();
     event_transformation_states.clear();
@@ -267,6 +271,11 @@ void stats_tracker::unwatch_all()
     unsub_all( stat_watchers );
 }
 
+auto stats_tracker::deferred_events() const -> std::vector<event_type>
+{
+    return { event_type::character_takes_damage, event_type::character_kills_monster };
+}
+
 void stats_tracker::notify( const cata::event &e )
 {
     const event_type type = e.type();
@@ -173,6 +173,8 @@ class stats_tracker : public event_subscriber
 
         void clear();
         void notify( const cata::event & ) override;
+        /** Combat bookkeeping waits for the next flush; queries flush first. */
+        auto deferred_events() const -> std::vector<event_type> override;
 
         void serialize( JsonOut & ) const;
         void deserialize( JsonIn & );
@@ -1,34 +1,131 @@
-#include <unordered_map>
+#include <array>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <vector>
 #include "string_id.h"
 
+// Interned strings are only ever added, so lookups read published tables without
+// locking; only adding a string takes the mutex.  Async mapgen and other pool work
+// create ids from strings that loading interned long before, and never contend.
+
 namespace
 {
-using InternMapType = std::unordered_map<std::string, int>;
-using ReverseLookupVecType = std::vector<const std::string *>;
-} // namespace
 
-inline static InternMapType &get_intern_map()
+constexpr int chunk_bits = 12;
+constexpr int chunk_size = 1 << chunk_bits;
+constexpr int max_chunks = 1 << 12;
+constexpr int no_id = -1;
+
+/** Open-addressing table of ids, probed linearly by string hash and kept at most half full. */
+struct lookup_table {
+    explicit lookup_table( const std::size_t size ) : mask( size - 1 ),
+        slots( std::make_unique<std::atomic<int>[]>( size ) ) {
+        for( std::size_t i = 0; i < size; ++i ) {
+            slots[i].store( no_id, std::memory_order_relaxed );
+        }
+    }
+
+    std::size_t mask;
+    std::unique_ptr<std::atomic<int>[]> slots;
+};
+
+using chunk = std::atomic<const std::string *>;
+
+struct intern_state {
+    intern_state() {
+        tables.push_back( std::make_unique<lookup_table>( chunk_size ) );
+        table.store( tables.back().get(), std::memory_order_release );
+    }
+
+    /** Id -> string, in fixed chunks so published entries never move. */
+    std::array<std::atomic<chunk *>, max_chunks> chunks{};
+    std::atomic<lookup_table *> table;
+
+    /** Held to add a string; guards everything below. */
+    std::mutex mutex;
+    std::deque<std::string> strings;
+    std::vector<std::unique_ptr<chunk[]>> chunk_storage;
+    // Replaced tables are kept: a reader may still be probing one
+    std::vector<std::unique_ptr<lookup_table>> tables;
+};
+
+intern_state &get_intern_state()
 {
-    static InternMapType map{};
-    return map;
+    static intern_state state;
+    return state;
 }
 
-inline static ReverseLookupVecType &get_reverse_lookup_vec()
+const std::string &interned_string( const intern_state &state, const int id )
 {
-    static ReverseLookupVecType vec{};
-    return vec;
+    const chunk *const c = state.chunks[id >> chunk_bits].load( std::memory_order_acquire );
+    return *c[id & ( chunk_size - 1 )].load( std::memory_order_acquire );
 }
 
+int find_in( const intern_state &state, const lookup_table &table, const std::string &s,
+             const std::size_t hash )
+{
+    for( auto slot = hash & table.mask;; slot = ( slot + 1 ) & table.mask ) {
+        const int id = table.slots[slot].load( std::memory_order_acquire );
+        if( id == no_id || interned_string( state, id ) == s ) {
+            return id;
+        }
+    }
+}
+
+void insert_into( lookup_table &table, const int id, const std::size_t hash )
+{
+    auto slot = hash & table.mask;
+    while( table.slots[slot].load( std::memory_order_relaxed ) != no_id ) {
+        slot = ( slot + 1 ) & table.mask;
+    }
+    table.slots[slot].store( id, std::memory_order_release );
+}
+
+} // namespace
+
 template<typename S>
 inline static int universal_string_id_intern( S &&s )
 {
-    int next_id = get_reverse_lookup_vec().size();
-    const auto &pair = get_intern_map().emplace( std::forward<S>( s ), next_id );
-    if( pair.second ) { // inserted
-        get_reverse_lookup_vec().push_back( &pair.first->first );
+    auto &state = get_intern_state();
+    const auto hash = std::hash<std::string> {}( s );
+    if( const int id = find_in( state, *state.table.load( std::memory_order_acquire ), s, hash );
+        id != no_id ) {
+        return id;
+    }
+
+    std::lock_guard<std::mutex> lk( state.mutex );
+    auto *table = state.table.load( std::memory_order_relaxed );
+    // Another thread may have added it, or grown the table, since the unlocked lookup
+    if( const int id = find_in( state, *table, s, hash ); id != no_id ) {
+        return id;
+    }
+
+    const int id = static_cast<int>( state.strings.size() );
+    state.strings.emplace_back( std::forward<S>( s ) );
+    auto &c = state.chunks[id >> chunk_bits];
+    if( !c.load( std::memory_order_relaxed ) ) {
+        state.chunk_storage.push_back( std::make_unique<chunk[]>( chunk_size ) );
+        c.store( state.chunk_storage.back().get(), std::memory_order_release );
+    }
+    c.load( std::memory_order_relaxed )[id & ( chunk_size - 1 )].store( &state.strings.back(),
+            std::memory_order_release );
+
+    if( state.strings.size() * 2 > table->mask + 1 ) {
+        // Built in full before it's published, so readers see every id or the old table
+        state.tables.push_back( std::make_unique<lookup_table>( ( table->mask + 1 ) * 2 ) );
+        table = state.tables.back().get();
+        for( int i = 0; i < id; ++i ) {
+            insert_into( *table, i, std::hash<std::string> {}( state.strings[i] ) );
+        }
+        insert_into( *table, id, hash );
+        state.table.store( table, std::memory_order_release );
+    } else {
+        insert_into( *table, id, hash );
     }
-    return pair.first->second;
+    return id;
 }
 
 int string_identity_static::string_id_intern( const std::string &s )
@@ -48,7 +145,7 @@ int string_identity_static::string_id_intern( std::string &&s )
 
 const std::string &string_identity_static::get_interned_string( int id )
 {
-    return *get_reverse_lookup_vec()[id];
+    return interned_string( get_intern_state(), id );
 }
 
 int string_identity_static::empty_interned_string()
@@ -20,6 +20,8 @@ struct lexicographic;
 template<typename T>
 class generic_factory;
 
+class Item_factory;
+
 /**
  * This represents an identifier (implemented as std::string) of some object.
  * It can be used for all type of objects, one just needs to specify a type as
@@ -147,7 +149,10 @@ class string_identity_static
             return _id == empty_interned_string();
         }
 
-        /** Returns unique int identifier for this string */
+        /**
+         * Returns unique int identifier for this string.  Safe from any thread; takes a
+         * lock only when the string hasn't been interned before.
+         */
         static int string_id_intern( std::string &&s );
         static int string_id_intern( std::string &s );
         static int string_id_intern( const std::string &s );
@@ -160,6 +165,9 @@ class string_identity_static
         template<typename T>
         friend class string_id;
 
+        template<typename T>
+        friend class generic_factory;
+
         template<typename T>
         friend struct std::hash;
 };
@@ -364,6 +372,8 @@ class string_id
         }
 
         friend class generic_factory<T>;
+        // Item types live in Item_factory rather than a generic_factory, but use the same cache
+        friend class Item_factory;
         friend struct std::hash<string_id<T>>;
 };
 
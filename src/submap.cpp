@@ -2,13 +2,18 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <ranges>
 #include <span>
 #include <utility>
 
+#include "compress.h"
 #include "debug.h"
+#include "game.h"
+#include "json.h"
 #include "int_id.h"
 #include "lightmap.h"
 #include "map.h"
@@ -24,6 +29,61 @@
 
 const data_vars::data_set submap::EMPTY_VARS{};
 
+namespace
+{
+
+// Deferred items are rare and parsed once, so one lock for all submaps is enough.
+auto deferred_items_mutex() -> std::mutex & // *NOPAD*
+{
+    static auto mutex = std::mutex{};
+    return mutex;
+}
+
+} // namespace
+
+void submap::parse_deferred_items() const
+{
+    const auto lock = std::lock_guard( deferred_items_mutex() );
+    if( !items_deferred_.load( std::memory_order_relaxed ) ) {
+        return;
+    }
+    ZoneScopedN( "submap_parse_deferred_items" );
+    // Parsing only changes when the items appear; callers see the same contents either way.
+    auto &self = const_cast<submap &>( *this );
+    {
+        memory_istreambuf buf( self.deferred_items_ );
+        std::istream in( &buf );
+        JsonIn jsin( in );
+        self.load_items( jsin, savegame_version );
+    }
+    self.deferred_items_ = std::string();
+    self.items_deferred_.store( false, std::memory_order_release );
+}
+
+auto submap::store_deferred_items( JsonOut &jsout ) const -> bool
+{
+    const auto lock = std::lock_guard( deferred_items_mutex() );
+    if( !items_deferred_.load( std::memory_order_relaxed ) ) {
+        return false;
+    }
+    jsout.member( "items" );
+    *jsout.get_stream() << deferred_items_;
+    jsout.set_need_separator();
+    return true;
+}
+
+auto submap::memory_usage() const -> std::size_t
+{
+    auto bytes = sizeof( submap ) + ter.heap_bytes() + frn.heap_bytes() + lum.heap_bytes() +
+                 trp.heap_bytes() + rad.heap_bytes();
+    if( fld != nullptr ) {
+        bytes += cells * sizeof( field );
+    }
+    bytes += vehicles.capacity() * sizeof( std::unique_ptr<vehicle> );
+    const auto lock = std::lock_guard( deferred_items_mutex() );
+    return bytes + deferred_items_.capacity();
+}
+
 auto submap::static_emitter_tiles() const -> const std::vector<point_sm_ms> &
 {
     if( !emitter_cache.has_value() ) {
@@ -45,13 +105,17 @@ auto submap::static_emitter_tiles() const -> const std::vector<point_sm_ms> &
 template<int sx, int sy>
 void maptile_soa<sx, sy>::swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 )
 {
-    std::swap( ter[p1.x()][p1.y()], ter[p2.x()][p2.y()] );
-    std::swap( frn[p1.x()][p1.y()], frn[p2.x()][p2.y()] );
-    std::swap( lum[p1.x()][p1.y()], lum[p2.x()][p2.y()] );
+    const auto c1 = cell( p1 );
+    const auto c2 = cell( p2 );
+    ter.swap_cells( c1, c2 );
+    frn.swap_cells( c1, c2 );
+    lum.swap_cells( c1, c2 );
     std::swap( itm[p1.x()][p1.y()], itm[p2.x()][p2.y()] );
-    std::swap( fld[p1.x()][p1.y()], fld[p2.x()][p2.y()] );
-    std::swap( trp[p1.x()][p1.y()], trp[p2.x()][p2.y()] );
-    std::swap( rad[p1.x()][p1.y()], rad[p2.x()][p2.y()] );
+    if( fld != nullptr ) {
+        std::swap( fld[c1], fld[c2] );
+    }
+    trp.swap_cells( c1, c2 );
+    rad.swap_cells( c1, c2 );
 }
 
 void submap::swap( submap &first, submap &second )
@@ -61,6 +125,11 @@ void submap::swap( submap &first, submap &second )
     const auto second_item_location_offset =
         project_to<coords::ms>( first.pos_ ) - project_to<coords::ms>( second.pos_ );
 
+    first.load_deferred_items();
+    second.load_deferred_items();
+    first.mark_modified();
+    second.mark_modified();
+    std::swap( first.deferred_items_unindexed_, second.deferred_items_unindexed_ );
     std::swap( first.dim_, second.dim_ );
     std::swap( first.pos_, second.pos_ );
     std::swap( first.ter, second.ter );
@@ -74,6 +143,10 @@ void submap::swap( submap &first, submap &second )
     std::swap( first.field_count, second.field_count );
     std::swap( first.trap_cache, second.trap_cache );
     std::swap( first.field_cache, second.field_cache );
+    std::swap( first.field_types_present, second.field_types_present );
+    std::swap( first.field_rows, second.field_rows );
+    std::swap( first.creature_field_rows, second.creature_field_rows );
+    std::swap( first.item_rows, second.item_rows );
     std::swap( first.emitter_cache, second.emitter_cache );
     std::swap( first.last_touched, second.last_touched );
     std::swap( first.spawns, second.spawns );
@@ -113,17 +186,21 @@ submap::submap( const tripoint_abs_sm &position,
 {
     dim_ = dim;
     pos_ = position;
-    std::fill_n( &ter[0][0], elements, t_null );
-    std::fill_n( &frn[0][0], elements, f_null );
-    std::fill_n( &lum[0][0], elements, 0 );
-    std::fill_n( &trp[0][0], elements, tr_null );
-    std::fill_n( &rad[0][0], elements, 0 );
+    ter.fill( t_null );
+    frn.fill( f_null );
+    trp.fill( tr_null );
 
     is_uniform = false;
 }
 
 submap::~submap() = default;
 
+auto submap::next_pf_revision() -> std::uint64_t
+{
+    static std::atomic<std::uint64_t> counter{ 0 };
+    return ++counter;
+}
+
 auto submap::set_position( const tripoint_abs_sm &position ) -> void
 {
     if( pos_ == position ) {
@@ -141,8 +218,8 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
     is_uniform = false;
     if( !i.is_emissive() ) {
         return;
-    } else if( lum[p.x()][p.y()] && lum[p.x()][p.y()] < 255 ) {
-        lum[p.x()][p.y()]--;
+    } else if( const uint8_t current = lum.get( cell( p ) ); current && current < 255 ) {
+        lum.set( cell( p ), static_cast<uint8_t>( current - 1 ) );
         return;
     }
 
@@ -156,7 +233,7 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
     }
 
     if( count <= 256 ) {
-        lum[p.x()][p.y()] = static_cast<uint8_t>( count - 1 );
+        lum.set( cell( p ), static_cast<uint8_t>( count - 1 ) );
     }
 }
 
@@ -169,6 +246,7 @@ void submap::insert_cosmetic( const point_sm_ms &p, const std::string &type,
     ins.type = type;
     ins.str = str;
 
+    mark_modified();
     cosmetics.push_back( ins );
 }
 
@@ -216,6 +294,7 @@ const std::string &submap::get_graffiti( const point_sm_ms &p ) const
 void submap::set_graffiti( const point_sm_ms &p, const std::string &new_graffiti )
 {
     is_uniform = false;
+    mark_modified();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
@@ -228,6 +307,7 @@ void submap::set_graffiti( const point_sm_ms &p, const std::string &new_graffiti
 void submap::delete_graffiti( const point_sm_ms &p )
 {
     is_uniform = false;
+    mark_modified();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -236,7 +316,7 @@ void submap::delete_graffiti( const point_sm_ms &p )
 }
 bool submap::has_signage( const point_sm_ms &p ) const
 {
-    if( frn[p.x()][p.y()].obj().has_flag( "SIGN" ) ) {
+    if( get_furn( p ).obj().has_flag( "SIGN" ) ) {
         return find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE ).result;
     }
 
@@ -244,7 +324,7 @@ bool submap::has_signage( const point_sm_ms &p ) const
 }
 std::string submap::get_signage( const point_sm_ms &p ) const
 {
-    if( frn[p.x()][p.y()].obj().has_flag( "SIGN" ) ) {
+    if( get_furn( p ).obj().has_flag( "SIGN" ) ) {
         const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
         if( fresult.result ) {
             return cosmetics[ fresult.ndx ].str;
@@ -256,6 +336,7 @@ std::string submap::get_signage( const point_sm_ms &p ) const
 void submap::set_signage( const point_sm_ms &p, const std::string &s )
 {
     is_uniform = false;
+    mark_modified();
     // Find signage at p if available
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
@@ -267,6 +348,7 @@ void submap::set_signage( const point_sm_ms &p, const std::string &s )
 void submap::delete_signage( const point_sm_ms &p )
 {
     is_uniform = false;
+    mark_modified();
     const auto fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         cosmetics[ fresult.ndx ] = cosmetics.back();
@@ -278,7 +360,7 @@ void submap::update_legacy_computer()
 {
     if( legacy_computer ) {
         for( const auto &p : submap_tiles() ) {
-            if( ter[p.x()][p.y()] == t_console ) {
+            if( get_ter( p ) == t_console ) {
                 computers.emplace( p, *legacy_computer );
             }
         }
@@ -288,7 +370,7 @@ void submap::update_legacy_computer()
 
 bool submap::has_computer( const point_sm_ms &p ) const
 {
-    return computers.contains( p ) || ( legacy_computer && ter[p.x()][p.y()] == t_console );
+    return computers.contains( p ) || ( legacy_computer && get_ter( p ) == t_console );
 }
 
 const computer *submap::get_computer( const point_sm_ms &p ) const
@@ -299,7 +381,7 @@ const computer *submap::get_computer( const point_sm_ms &p ) const
     if( it != computers.end() ) {
         return &it->second;
     }
-    if( legacy_computer && ter[p.x()][p.y()] == t_console ) {
+    if( legacy_computer && get_ter( p ) == t_console ) {
         return legacy_computer.get();
     }
     return nullptr;
@@ -310,6 +392,7 @@ computer *submap::get_computer( const point_sm_ms &p )
     // need to update to std::map first so modifications to the returned object
     // only affects the exact const point_sm_ms &p
     update_legacy_computer();
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         return &it->second;
@@ -320,6 +403,7 @@ computer *submap::get_computer( const point_sm_ms &p )
 void submap::set_computer( const point_sm_ms &p, const computer &c )
 {
     update_legacy_computer();
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         it->second = c;
@@ -331,6 +415,7 @@ void submap::set_computer( const point_sm_ms &p, const computer &c )
 void submap::delete_computer( const point_sm_ms &p )
 {
     update_legacy_computer();
+    mark_modified();
     computers.erase( p );
 }
 
@@ -351,6 +436,8 @@ void submap::rotate( int turns )
     if( turns == 0 ) {
         return;
     }
+    load_deferred_items();
+    mark_modified();
 
     const auto rotate_point = [turns]( const point_sm_ms & p ) {
         return p.rotate( turns, { SEEX, SEEY } );
@@ -460,13 +547,69 @@ void submap::rotate( int turns )
         std::views::iota( 0, SEEX * SEEY )
         | std::views::transform( []( int i ) -> point_sm_ms { return { i % SEEX, i / SEEX }; } ),
     [this]( const point_sm_ms & p ) {
-        if( trp[p.x()][p.y()] != tr_null ) {
+        if( get_trap( p ) != tr_null ) {
             trap_cache.push_back( p );
         }
-        if( fld[p.x()][p.y()].displayed_field_type() ) {
+        if( field_at( p ).displayed_field_type() ) {
             field_cache.push_back( p );
         }
     } );
+    compact_field_cache();
+    compact_item_rows();
+}
+
+auto submap::compact_item_rows() -> void
+{
+    item_rows = {};
+    for( const auto &p : submap_tiles() ) {
+        if( !itm[p.x()][p.y()].empty() ) {
+            note_item_added( p );
+        }
+    }
+}
+
+auto submap::compact_field_cache() -> void
+{
+    // Compact + deduplicate the field_cache in one O(n) pass.
+    //
+    // Two failure modes fixed here:
+    //   1. Dead entries: a position is pushed when a field is first created, but
+    //      never removed when it dies.  The cache grows each creation/death cycle.
+    //   2. Duplicate live entries: when a bolt or spread effect adds a second field
+    //      type to a tile already in the cache, add_field() returns true (new type),
+    //      so the same position is pushed again.  The shock_vent state machine then
+    //      runs N times per tick instead of once, flooding the room with electricity.
+    //
+    // The bitset tracks which of the 144 submap tiles have already been kept so
+    // duplicates are discarded in the same pass that removes dead entries.  The
+    // kept entries are exactly the tiles with fields, so the summary is rebuilt
+    // from them on the way.
+    std::bitset<SEEX *SEEY> seen;
+    field_types_present = 0;
+    field_rows = {};
+    creature_field_rows = {};
+    field_cache.erase(
+    std::ranges::remove_if( field_cache, [&]( const point_sm_ms & local ) {
+        const field &curfield = field_at( local );
+        if( !curfield.displayed_field_type() ) {
+            return true;
+        }
+        const auto idx = static_cast<std::size_t>( local.x() + local.y() * SEEX );
+        if( seen.test( idx ) ) {
+            return true;
+        }
+        seen.set( idx );
+        for( const auto &entry : curfield ) {
+            field_types_present |= field_type_bit( entry.first );
+            if( entry.first->affects_creatures ) {
+                creature_field_rows[local.y()] |= static_cast<std::uint16_t>( 1U << local.x() );
+            }
+        }
+        field_rows[local.y()] |= static_cast<std::uint16_t>( 1U << local.x() );
+        return false;
+    } ).begin(),
+    field_cache.end()
+    );
 }
 
 
@@ -483,69 +626,97 @@ auto submap::rebuild_outside_cache( const level_cache *above,
         outside_dirty = false;
         return;
     }
-    const auto abs_p = project_to<coords::ms>( grid_pos ).xy();
-    for( const auto &p : submap_tiles() ) {
-        // A tile is outside if any tile in the 3×3 at z+1 satisfies:
-        // (outside at z+1) AND (no floor at z+1 blocking the path).
-        // Out-of-bounds neighbours (edge of loaded map) are treated as inside.
-        const auto ap = abs_p + p.raw(); // avoid projection cost of project_combine
-        bool result = false;
-        for( int dx = -1; dx <= 1 && !result; ++dx ) {
-            for( int dy = -1; dy <= 1 && !result; ++dy ) {
-                const auto nb = ap + point{ dx, dy };
-                if( !above->inbounds( nb ) ) {
-                    continue; // out of bounds = inside
-                }
-                const int idx = above->idx( nb.x(), nb.y() );
-                if( above->outside_cache[idx] && !above->floor_cache[idx] ) {
-                    result = true;
-                }
+    // Gather the z+1 tiles over this submap plus a one tile border once, then apply the
+    // 3×3 rules as two separable ORs over flat rows:
+    // - outside: some tile of the 3×3 at z+1 is outside and has no floor blocking the path;
+    // - sheltered: some tile of the 3×3 at z+1 has a floor or is itself sheltered
+    //   (coverage propagates downward with a 1-tile overhang).
+    // Out-of-bounds neighbours (edge of loaded map) count as neither.
+    constexpr int pad_x = SEEX + 2;
+    constexpr int pad_y = SEEY + 2;
+    auto open = std::array<std::uint8_t, pad_x * pad_y> {};
+    auto cover = std::array<std::uint8_t, pad_x * pad_y> {};
+    const auto origin = project_to<coords::ms>( grid_pos ).xy() + point_north_west;
+    for( int x = 0; x < pad_x; ++x ) {
+        for( int y = 0; y < pad_y; ++y ) {
+            const auto nb = origin + point{ x, y };
+            if( !above->inbounds( nb ) ) {
+                continue;
             }
+            const int idx = above->idx( nb.x(), nb.y() );
+            const bool floor = above->floor_cache[idx] != 0;
+            open[x * pad_y + y] = above->outside_cache[idx] != 0 && !floor;
+            cover[x * pad_y + y] = floor || above->sheltered_cache[idx] != 0;
         }
-        outside_cache[p.x()][p.y()] = result;
-        // A tile is sheltered if any tile in the 3×3 at z+1 has a floor,
-        // or is itself sheltered (coverage propagates downward with a 1-tile overhang).
-        // Out-of-bounds neighbours are treated as sheltered (edge of loaded map).
-        result = false;
-        for( int dx = -1; dx <= 1 && !result; ++dx ) {
-            for( int dy = -1; dy <= 1 && !result; ++dy ) {
-                const auto nb = ap + point{ dx, dy };
-                if( !above->inbounds( nb ) ) {
-                    continue;
-                }
-                const int idx = above->idx( nb.x(), nb.y() );
-                if( above->floor_cache[idx] || above->sheltered_cache[idx] ) {
-                    result = true;
-                }
-            }
+    }
+    auto open_x = std::array<std::uint8_t, SEEX * pad_y> {};
+    auto cover_x = std::array<std::uint8_t, SEEX * pad_y> {};
+    for( int i = 0; i < SEEX * pad_y; ++i ) {
+        open_x[i] = open[i] | open[i + pad_y] | open[i + 2 * pad_y];
+        cover_x[i] = cover[i] | cover[i + pad_y] | cover[i + 2 * pad_y];
+    }
+    for( int x = 0; x < SEEX; ++x ) {
+        const int row = x * pad_y;
+        for( int y = 0; y < SEEY; ++y ) {
+            outside_cache[x][y] = ( open_x[row + y] | open_x[row + y + 1] | open_x[row + y + 2] ) != 0;
+            sheltered_cache[x][y] = ( cover_x[row + y] | cover_x[row + y + 1] | cover_x[row + y + 2] ) != 0;
         }
-        sheltered_cache[p.x()][p.y()] = result;
     }
     outside_dirty = false;
 }
 
 auto submap::rebuild_floor_cache( const map &m, const tripoint_bub_sm &grid_pos ) -> void
 {
-    if( !floor_dirty ) {
+    if( !floor_dirty && floor_dirty_tiles.none() ) {
         return;
     }
-    // Default: has floor (non-zero).
-    std::ranges::fill( std::span( &floor_cache[0][0], SEEX * SEEY ), '\x01' );
+    auto ter_attrs = std::array<std::uint32_t, cells> {};
+    ter.map_cells( []( const ter_id & t ) { return cache_attr::of( t ); }, ter_attrs.data() );
+    auto below_attrs = std::array<std::uint32_t, cells> {};
+    if( const submap *below = below_submap( m, grid_pos ) ) {
+        below->frn.map_cells( []( const furn_id & f ) { return cache_attr::of( f ); },
+                              below_attrs.data() );
+    }
+    // Same rule as floor_at, over the flat [SEEX][SEEY] cache in cell order.
+    char *const out = &floor_cache[0][0];
+    for( std::size_t i = 0; i < cells; ++i ) {
+        out[i] = ( ter_attrs[i] & cache_attr::no_floor ) == 0 ||
+                 ( below_attrs[i] & cache_attr::sun_roof_above ) != 0;
+    }
+    floor_dirty = false;
+    floor_dirty_tiles.reset();
+}
 
-    const bool lowest_z = grid_pos.z() <= -OVERMAP_DEPTH;
-    const submap *below = lowest_z ? nullptr
-                          : m.get_mapbuffer().lookup_submap_in_memory(
-                              map_local_to_abs( m, grid_pos - tripoint_rel_sm( 0, 0, 1 ) ) );
+auto submap::refresh_floor_tile( const map &m, const tripoint_bub_sm &grid_pos,
+                                 const point_sm_ms &p ) -> char
+{
+    if( floor_dirty ) {
+        rebuild_floor_cache( m, grid_pos );
+    } else if( floor_dirty_tiles.test( cell( p ) ) ) {
+        floor_cache[p.x()][p.y()] = floor_at( p, below_submap( m, grid_pos ) );
+        floor_dirty_tiles.reset( cell( p ) );
+    }
+    return floor_cache[p.x()][p.y()];
+}
 
-    for( const auto &sp : submap_tiles() ) {
-        const auto &ter_obj = get_ter( sp ).obj();
-        if( ter_obj.has_flag( TFLAG_NO_FLOOR ) || ter_obj.has_flag( TFLAG_Z_TRANSPARENT ) ) {
-            if( !below || !below->get_furn( sp ).obj().has_flag( TFLAG_SUN_ROOF_ABOVE ) ) {
-                floor_cache[sp.x()][sp.y()] = '\0';
-            }
+auto submap::below_submap( const map &m, const tripoint_bub_sm &grid_pos ) const -> const submap *
+{
+    if( grid_pos.z() <= -OVERMAP_DEPTH ) {
+        return nullptr;
+    }
+    return m.get_mapbuffer().lookup_submap_in_memory(
+               map_local_to_abs( m, grid_pos - tripoint_rel_sm( 0, 0, 1 ) ) );
+}
+
+auto submap::floor_at( const point_sm_ms &p, const submap *below ) const -> char
+{
+    // Has a floor unless the terrain lacks one and no roof below props it up.
+    if( ( cache_attr::of( get_ter( p ) ) & cache_attr::no_floor ) != 0 ) {
+        if( !below || ( cache_attr::of( below->get_furn( p ) ) & cache_attr::sun_roof_above ) == 0 ) {
+            return '\0';
         }
     }
-    floor_dirty = false;
+    return '\x01';
 }
 
 auto submap::rebuild_pf_cache( const map &m, const tripoint_bub_sm &grid_pos ) -> void
@@ -557,17 +728,17 @@ auto submap::rebuild_pf_cache( const map &m, const tripoint_bub_sm &grid_pos ) -
         const tripoint_bub_ms p = project_combine( grid_pos, sp );
         auto cur_value = PF_NORMAL;
 
-        const auto &terrain   = get_ter( sp ).obj();
-        const auto &furniture = get_furn( sp ).obj();
+        const auto terrain = get_ter( sp );
+        const auto ter_flags = cache_attr::of( terrain );
         int vpart = -1;
         const vehicle *veh = m.veh_at_internal( p, vpart );
-        const int cost = m.move_cost_internal( furniture, terrain, veh, vpart );
+        const int cost = m.move_cost_internal( get_furn( sp ), terrain, veh, vpart );
 
         if( cost > 2 ) {
             cur_value |= PF_SLOW;
         } else if( cost <= 0 ) {
             cur_value |= PF_WALL;
-            if( terrain.has_flag( TFLAG_CLIMBABLE ) ) {
+            if( ( ter_flags & cache_attr::climbable ) != 0 ) {
                 cur_value |= PF_CLIMBABLE;
             }
         }
@@ -584,17 +755,15 @@ auto submap::rebuild_pf_cache( const map &m, const tripoint_bub_sm &grid_pos ) -
             }
         }
 
-        if( !get_trap( sp ).obj().is_benign() || !terrain.trap.obj().is_benign() ) {
+        if( !get_trap( sp ).obj().is_benign() || !terrain.obj().trap.obj().is_benign() ) {
             cur_value |= PF_TRAP;
         }
 
-        if( terrain.has_flag( TFLAG_GOES_DOWN ) || terrain.has_flag( TFLAG_GOES_UP ) ||
-            terrain.has_flag( TFLAG_RAMP )      || terrain.has_flag( TFLAG_RAMP_UP ) ||
-            terrain.has_flag( TFLAG_RAMP_DOWN ) ) {
+        if( ( ter_flags & cache_attr::changes_level ) != 0 ) {
             cur_value |= PF_UPDOWN;
         }
 
-        if( terrain.has_flag( TFLAG_SHARP ) ) {
+        if( ( ter_flags & cache_attr::sharp ) != 0 ) {
             cur_value |= PF_SHARP;
         }
 
@@ -605,7 +774,7 @@ auto submap::rebuild_pf_cache( const map &m, const tripoint_bub_sm &grid_pos ) -
 
 auto submap::rebuild_transparency_cache( const map &m, const tripoint_bub_sm &grid_pos ) -> void
 {
-    if( !transparency_dirty ) {
+    if( !transparency_dirty && transparency_dirty_tiles.none() ) {
         return;
     }
     // outside_cache must be current before applying the weather sight penalty.
@@ -618,30 +787,79 @@ auto submap::rebuild_transparency_cache( const map &m, const tripoint_bub_sm &gr
 
     const float sight_penalty = get_weather().weather_id->sight_penalty;
 
-    for( const auto &sp : submap_tiles() ) {
-        if( ( get_ter( sp ).obj().transparent && get_furn( sp ).obj().transparent ) ) {
-            auto value = LIGHT_TRANSPARENCY_OPEN_AIR;
-            if( outside_cache[sp.x()][sp.y()] ) {
-                value *= sight_penalty;
+    auto ter_attrs = std::array<std::uint32_t, cells> {};
+    ter.map_cells( []( const ter_id & t ) { return cache_attr::of( t ); }, ter_attrs.data() );
+    auto furn_attrs = std::array<std::uint32_t, cells> {};
+    frn.map_cells( []( const furn_id & f ) { return cache_attr::of( f ); }, furn_attrs.data() );
+    // Same as transparency_at without fields, over the flat [SEEX][SEEY] caches in cell order.
+    const bool *const outside = &outside_cache[0][0];
+    float *const out = &transparency_cache[0][0];
+    const float outside_value = LIGHT_TRANSPARENCY_OPEN_AIR * sight_penalty;
+    for( std::size_t i = 0; i < cells; ++i ) {
+        const bool see_through = ( ter_attrs[i] & furn_attrs[i] & cache_attr::transparent ) != 0;
+        out[i] = !see_through ? LIGHT_TRANSPARENCY_SOLID
+                 : outside[i] ? outside_value : LIGHT_TRANSPARENCY_OPEN_AIR;
+    }
+    if( fld != nullptr ) {
+        for( const auto &sp : submap_tiles() ) {
+            float &value = transparency_cache[sp.x()][sp.y()];
+            if( value != LIGHT_TRANSPARENCY_SOLID ) {
+                value = apply_fields( sp, value, grid_pos );
             }
-
-            for( const auto &fld : get_field( sp ) ) {
-                if( !fld.first.is_valid() ) {
-                    debugmsg( "rebuild_transparency_cache: invalid field type id %d at "
-                              "grid(%d,%d,%d) tile(%d,%d) field_count=%d is_uniform=%d",
-                              fld.first.to_i(), grid_pos.x(), grid_pos.y(), grid_pos.z(),
-                              sp.x(), sp.y(), field_count, static_cast<int>( is_uniform ) );
-                    break;
-                }
-                const auto &cur = fld.second;
-                if( !cur.is_transparent() ) {
-                    value *= cur.translucency();
-                }
-            }
-            transparency_cache[sp.x()][sp.y()] = value;
-        } else {
-            transparency_cache[sp.x()][sp.y()] = LIGHT_TRANSPARENCY_SOLID;
         }
     }
     transparency_dirty = false;
+    transparency_dirty_tiles.reset();
+}
+
+auto submap::refresh_transparency_tile( const map &m, const tripoint_bub_sm &grid_pos,
+                                        const point_sm_ms &p ) -> float
+{
+    if( transparency_dirty ) {
+        rebuild_transparency_cache( m, grid_pos );
+    } else if( transparency_dirty_tiles.test( cell( p ) ) ) {
+        if( outside_dirty ) {
+            const level_cache *above = ( grid_pos.z() < OVERMAP_HEIGHT )
+                                       ? &m.get_cache_ref( grid_pos.z() + 1 )
+                                       : nullptr;
+            rebuild_outside_cache( above, grid_pos );
+        }
+        transparency_cache[p.x()][p.y()] =
+            transparency_at( p, get_weather().weather_id->sight_penalty, grid_pos );
+        transparency_dirty_tiles.reset( cell( p ) );
+    }
+    return transparency_cache[p.x()][p.y()];
+}
+
+auto submap::transparency_at( const point_sm_ms &p, const float sight_penalty,
+                              const tripoint_bub_sm &grid_pos ) const -> float
+{
+    if( ( cache_attr::of( get_ter( p ) ) & cache_attr::of( get_furn( p ) ) &
+          cache_attr::transparent ) == 0 ) {
+        return LIGHT_TRANSPARENCY_SOLID;
+    }
+    auto value = LIGHT_TRANSPARENCY_OPEN_AIR;
+    if( outside_cache[p.x()][p.y()] ) {
+        value *= sight_penalty;
+    }
+    return apply_fields( p, value, grid_pos );
+}
+
+auto submap::apply_fields( const point_sm_ms &p, float value,
+                           const tripoint_bub_sm &grid_pos ) const -> float
+{
+    for( const auto &fld : get_field( p ) ) {
+        if( !fld.first.is_valid() ) {
+            debugmsg( "rebuild_transparency_cache: invalid field type id %d at "
+                      "grid(%d,%d,%d) tile(%d,%d) field_count=%d is_uniform=%d",
+                      fld.first.to_i(), grid_pos.x(), grid_pos.y(), grid_pos.z(),
+                      p.x(), p.y(), field_count, static_cast<int>( is_uniform ) );
+            break;
+        }
+        const auto &cur = fld.second;
+        if( !cur.is_transparent() ) {
+            value *= cur.translucency();
+        }
+    }
+    return value;
 }
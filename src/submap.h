@@ -1,6 +1,9 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -8,6 +11,7 @@
 #include <vector>
 #include <string>
 #include <iterator>
+#include <utility>
 #include <map>
 
 #include "active_item_cache.h"
@@ -21,12 +25,18 @@
 #include "legacy_pathfinding.h"
 #include "type_id.h"
 #include "monster.h"
+#include "palette_grid.h"
 #include "point.h"
 #include "poly_serialized.h"
 #include "sounds.h"
 
 class JsonIn;
 class JsonOut;
+namespace submap_binary
+{
+class reader;
+class writer;
+} // namespace submap_binary
 class map;
 struct level_cache;
 struct trap;
@@ -73,18 +83,44 @@ struct spawn_point {
     }
 };
 
+/**
+ * Per-tile contents of a submap.  Terrain, furniture, traps, radiation and item light
+ * are palette_grids indexed by cell(): most submaps hold a handful of distinct values
+ * per layer, and the all-zero layers (traps, radiation, lum) keep no per-tile storage.
+ * Fields are allocated for the whole submap the first time one is needed.
+ */
 template<int sx, int sy>
 struct maptile_soa {
     protected:
         maptile_soa( const tripoint_abs_sm &position, const dimension_id &dim );
     public:
-        ter_id             ter[sx][sy];  // Terrain on each square
-        furn_id            frn[sx][sy];  // Furniture on each square
-        std::uint8_t       lum[sx][sy];  // Number of items emitting light on each square
+        static constexpr std::size_t cells = sx * sy;
+
+        palette_grid<ter_id, cells>       ter;  // Terrain on each square
+        palette_grid<furn_id, cells>      frn;  // Furniture on each square
+        palette_grid<std::uint8_t, cells> lum;  // Number of items emitting light on each square
         location_vector<item> itm[sx][sy]; // Items on each square
-        field              fld[sx][sy];  // Field on each square
-        trap_id            trp[sx][sy];  // Trap on each square
-        int                rad[sx][sy];  // Irradiation of each square
+        std::unique_ptr<field[]>          fld;  // Field on each square, null while there are none
+        palette_grid<trap_id, cells>      trp;  // Trap on each square
+        palette_grid<int, cells>          rad;  // Irradiation of each square
+
+        static constexpr auto cell( const point_sm_ms &p ) -> std::size_t {
+            return static_cast<std::size_t>( p.x() * sy + p.y() );
+        }
+
+        /** Field at @p p, allocating the field layer if this is the first one */
+        auto mutable_field_at( const point_sm_ms &p ) -> field & {
+            if( fld == nullptr ) {
+                fld = std::make_unique<field[]>( cells );
+            }
+            return fld[cell( p )];
+        }
+
+        /** Field at @p p; never allocates */
+        auto field_at( const point_sm_ms &p ) const -> const field & {
+            static const field no_field;
+            return fld == nullptr ? no_field : fld[cell( p )];
+        }
 
         void swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 );
 };
@@ -101,30 +137,33 @@ class submap : maptile_soa<SEEX, SEEY>
         auto set_position( const tripoint_abs_sm &position ) -> void;
 
         trap_id get_trap( const point_sm_ms &p ) const {
-            return trp[p.x()][p.y()];
+            return trp.get( cell( p ) );
         }
 
         void set_trap( const point_sm_ms &p, trap_id trap ) {
             is_uniform = false;
-            trp[p.x()][p.y()] = trap;
+            mark_modified();
+            trp.set( cell( p ), trap );
             if( trap != tr_null ) {
                 trap_cache.push_back( p );
             }
         }
 
         void set_all_traps( const trap_id &trap ) {
-            std::fill_n( &trp[0][0], elements, trap );
+            mark_modified();
+            trp.fill( trap );
             trap_cache.clear();
         }
 
         furn_id get_furn( const point_sm_ms &p ) const {
-            return frn[p.x()][p.y()];
+            return frn.get( cell( p ) );
         }
 
         void set_furn( const point_sm_ms &p, furn_id furn ) {
             is_uniform = false;
+            mark_modified();
             emitter_cache = std::nullopt;
-            frn[p.x()][p.y()] = furn;
+            frn.set( cell( p ), furn );
             frn_vars[p].merge( furn->default_vars );
             if( furn != f_null ) {
                 return;
@@ -133,7 +172,8 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         void set_all_furn( const furn_id &furn ) {
-            std::fill_n( &frn[0][0], elements, furn );
+            mark_modified();
+            frn.fill( furn );
             emitter_cache = std::nullopt;
             if( furn != f_null ) {
                 return;
@@ -143,72 +183,111 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         ter_id get_ter( const point_sm_ms &p ) const {
-            return ter[p.x()][p.y()];
+            return ter.get( cell( p ) );
         }
 
         void set_ter( const point_sm_ms &p, ter_id terr ) {
             is_uniform = false;
+            mark_modified();
             emitter_cache = std::nullopt;
-            ter[p.x()][p.y()] = terr;
+            ter.set( cell( p ), terr );
         }
 
         void set_all_ter( const ter_id &terr ) {
-            std::fill_n( &ter[0][0], elements, terr );
+            mark_modified();
+            ter.fill( terr );
             emitter_cache = std::nullopt;
         }
 
         int get_radiation( const point_sm_ms &p ) const {
-            return rad[p.x()][p.y()];
+            return rad.get( cell( p ) );
         }
 
         void set_radiation( const point_sm_ms &p, const int radiation ) {
             is_uniform = false;
-            rad[p.x()][p.y()] = radiation;
+            mark_modified();
+            rad.set( cell( p ), radiation );
         }
 
         uint8_t get_lum( const point_sm_ms &p ) const {
-            return lum[p.x()][p.y()];
+            return lum.get( cell( p ) );
         }
 
         auto static_emitter_tiles() const -> const std::vector<point_sm_ms> &;
 
+        /**
+         * Approximate bytes held by this submap's own tile data and its unparsed items.
+         * Items and vehicles are objects of their own and aren't included.
+         */
+        auto memory_usage() const -> std::size_t;
+
         void set_lum( const point_sm_ms &p, uint8_t luminance ) {
             is_uniform = false;
-            lum[p.x()][p.y()] = luminance;
+            lum.set( cell( p ), luminance );
         }
 
         void update_lum_add( const point_sm_ms &p, const item &i ) {
             is_uniform = false;
-            if( i.is_emissive() && lum[p.x()][p.y()] < 255 ) {
-                lum[p.x()][p.y()]++;
+            const uint8_t current = lum.get( cell( p ) );
+            if( i.is_emissive() && current < 255 ) {
+                lum.set( cell( p ), static_cast<uint8_t>( current + 1 ) );
             }
         }
 
         void update_lum_rem( const point_sm_ms &p, const item &i );
 
         // TODO: Replace this as it essentially makes itm public
+        // Mutable access counts as a modification; use the const overload to read.
         location_vector<item> &get_items( const point_sm_ms &p ) {
+            load_deferred_items();
+            mark_modified();
             return itm[p.x()][p.y()];
         }
 
         const location_vector<item> &get_items( const point_sm_ms &p ) const {
+            load_deferred_items();
             return itm[p.x()][p.y()];
         }
 
+        /**
+         * With DEFER_SUBMAP_ITEMS, load() keeps the "items" member as JSON text
+         * until the items are first needed.  Until then lum and active_items do
+         * not count them.  get_items() and actualization parse them.
+         */
+        auto has_deferred_items() const -> bool {
+            return items_deferred_.load( std::memory_order_acquire );
+        }
+        /** Parse items load() left serialized.  Safe to call from any thread. */
+        void load_deferred_items() const {
+            if( has_deferred_items() ) {
+                parse_deferred_items();
+            }
+        }
+        /**
+         * True once for a submap whose items were deferred at load, after which
+         * the caller should refresh the mapbuffer's active and luminous item indices.
+         */
+        auto take_deferred_items_unindexed() -> bool {
+            return std::exchange( deferred_items_unindexed_, false );
+        }
+
         // TODO: Replace this as it essentially makes fld public
         field &get_field( const point_sm_ms &p ) {
-            return fld[p.x()][p.y()];
+            mark_modified();
+            return mutable_field_at( p );
         }
 
         const field &get_field( const point_sm_ms &p ) const {
-            return fld[p.x()][p.y()];
+            return field_at( p );
         }
 
         data_vars::data_set &get_ter_vars( const point_sm_ms &p ) {
+            mark_modified();
             return ter_vars[p];
         };
 
         data_vars::data_set &get_furn_vars( const point_sm_ms &p ) {
+            mark_modified();
             return frn_vars[p];
         };
 
@@ -241,6 +320,7 @@ class submap : maptile_soa<SEEX, SEEY>
         }
 
         void set_temperature( int new_temperature ) {
+            mark_modified();
             temperature = new_temperature;
         }
 
@@ -273,11 +353,33 @@ class submap : maptile_soa<SEEX, SEEY>
         void store( JsonOut &jsout ) const;
         void load( JsonIn &jsin, const std::string &member_name, int version,
                    const tripoint_abs_ms offset, const dimension_id &dim );
+        /** Binary counterparts of store()/load(); see submap_binary.h for the layout. */
+        void store_binary( submap_binary::writer &out ) const;
+        void load_binary( submap_binary::reader &in, int version,
+                          const tripoint_abs_ms offset, const dimension_id &dim );
 
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform;
 
+        /**
+         * Modification generation, compared against the one last written to disk
+         * so mapbuffer::save() can skip submaps nobody changed.  Setters and
+         * mutable accessors bump it; code writing the public members directly
+         * (vehicles, spawns, active_furniture, ...) must call mark_modified().
+         * Submaps in the simulated zone are saved regardless.
+         */
+        void mark_modified() {
+            ++generation_;
+        }
+        auto is_modified() const -> bool {
+            return generation_ != saved_generation_;
+        }
+        /// The current contents match what is on disk.
+        void mark_saved() {
+            saved_generation_ = generation_;
+        }
+
         std::vector<cosmetic_t> cosmetics; // Textual "visuals" for squares
 
         active_item_cache active_items;
@@ -291,6 +393,65 @@ class submap : maptile_soa<SEEX, SEEY>
         // field_cache: positions of tiles with active fields; compacted after each
         // processing pass to remove positions whose fields have fully decayed.
         std::vector<point_sm_ms> field_cache;
+        // field_types_present / field_rows: which field types and which tiles of each row
+        // (bit x of field_rows[y]) may hold a field.  A clear bit means none does, so
+        // callers can skip the submap or row; a set bit may be stale until the next
+        // compact_field_cache.  Types are hashed into 64 bits.
+        std::uint64_t field_types_present = 0;
+        std::array<std::uint16_t, SEEY> field_rows = {};
+        // The same as field_rows, for fields that can affect creatures standing in them.
+        std::array<std::uint16_t, SEEY> creature_field_rows = {};
+        static_assert( SEEX <= 16, "field_rows holds one bit per tile of a row" );
+
+        static auto field_type_bit( const field_type_id &type ) -> std::uint64_t {
+            return std::uint64_t{ 1 } << ( static_cast<unsigned>( type.to_i() ) % 64 );
+        }
+        auto may_have_field( const field_type_id &type ) const -> bool {
+            return ( field_types_present & field_type_bit( type ) ) != 0;
+        }
+        auto may_have_field_at( const point_sm_ms &p ) const -> bool {
+            return ( field_rows[p.y()] >> p.x() & 1 ) != 0;
+        }
+        auto may_have_field_in_row( const int y ) const -> bool {
+            return field_rows[y] != 0;
+        }
+        auto may_have_creature_field_at( const point_sm_ms &p ) const -> bool {
+            return ( creature_field_rows[p.y()] >> p.x() & 1 ) != 0;
+        }
+        /** Records that a field of @p type was added to the tile @p p that had none of it. */
+        auto note_field_added( const point_sm_ms &p, const field_type_id &type ) -> void {
+            ++field_count;
+            field_cache.push_back( p );
+            field_types_present |= field_type_bit( type );
+            field_rows[p.y()] |= static_cast<std::uint16_t>( 1U << p.x() );
+            if( type->affects_creatures ) {
+                creature_field_rows[p.y()] |= static_cast<std::uint16_t>( 1U << p.x() );
+            }
+        }
+        /** Drops dead and duplicate field_cache entries and makes the summary exact again. */
+        auto compact_field_cache() -> void;
+        // item_rows: which tiles of each row (bit x of item_rows[y]) may hold items.  Set for
+        // every item added, so a clear bit means none is there and item searches can skip the
+        // tile, row or whole submap; a set bit may be stale until that tile is next checked
+        // by map::has_items or compact_item_rows runs.  Items still deferred by
+        // DEFER_SUBMAP_ITEMS are not in the rows yet, so they count as everywhere.
+        std::array<std::uint16_t, SEEY> item_rows = {};
+        auto may_have_items_at( const point_sm_ms &p ) const -> bool {
+            return ( item_rows[p.y()] >> p.x() & 1 ) != 0 || has_deferred_items();
+        }
+        auto may_have_items() const -> bool {
+            return std::ranges::any_of( item_rows, []( const std::uint16_t row ) {
+                return row != 0;
+            } ) || has_deferred_items();
+        }
+        auto note_item_added( const point_sm_ms &p ) -> void {
+            item_rows[p.y()] |= static_cast<std::uint16_t>( 1U << p.x() );
+        }
+        auto note_no_items_at( const point_sm_ms &p ) -> void {
+            item_rows[p.y()] &= static_cast<std::uint16_t>( ~( 1U << p.x() ) );
+        }
+        /** Makes item_rows exact again. */
+        auto compact_item_rows() -> void;
         // TODO: A future improvement is to unify all per-tile dirty state into a 144-bit
         // bitmask (e.g. std::bitset<SEEX * SEEY> or three uint64_t words), one per category.
         // Bitmask iteration with _Find_first()/_Find_next() or ctz on 64-bit words is
@@ -331,6 +492,15 @@ class submap : maptile_soa<SEEX, SEEY>
         bool floor_dirty        = true;
         bool pf_dirty           = true;
         bool absorption_dirty   = true;
+        // Bumped with every pf_dirty mark, from one counter shared by all submaps, so caches
+        // built over several turns (Pathfinding's portal graphs) can tell this terrain changed.
+        std::uint64_t pf_revision = next_pf_revision();
+        static auto next_pf_revision() -> std::uint64_t;
+        // Single tiles whose transparency/floor entry is stale while the whole-submap
+        // flag above is clear.  Set by map::set_*_cache_dirty( tripoint ), cleared per
+        // tile by refresh_*_tile and all at once by a full rebuild.
+        std::bitset<SEEX * SEEY> transparency_dirty_tiles;
+        std::bitset<SEEX * SEEY> floor_dirty_tiles;
 
         // Since we rebuild the sound_wall_cache at the same time as the absorption cache, we dont need this.
         // bool sound_wall_dirty   = true;
@@ -346,6 +516,19 @@ class submap : maptile_soa<SEEX, SEEY>
         // rebuild_transparency_cache calls rebuild_outside_cache first if outside_dirty.
         auto rebuild_transparency_cache( const map &m, const tripoint_bub_sm &grid_pos ) -> void;
 
+        auto mark_transparency_tile_dirty( const point_sm_ms &p ) -> void {
+            transparency_dirty_tiles.set( cell( p ) );
+        }
+        auto mark_floor_tile_dirty( const point_sm_ms &p ) -> void {
+            floor_dirty_tiles.set( cell( p ) );
+        }
+        // Current cache entry of one tile: rebuilds the whole cache if the submap is
+        // dirty, only this tile if it was marked on its own, and otherwise just reads.
+        auto refresh_transparency_tile( const map &m, const tripoint_bub_sm &grid_pos,
+                                        const point_sm_ms &p ) -> float;
+        auto refresh_floor_tile( const map &m, const tripoint_bub_sm &grid_pos,
+                                 const point_sm_ms &p ) -> char;
+
         // Rebuilds the per-submap sound absorption cache from terrain and furniture data.
         // This will also rebuild the sound wall cache for the submap.
         // Check sounds.cpp for implimentation.
@@ -363,6 +546,14 @@ class submap : maptile_soa<SEEX, SEEY>
         static void swap( submap &first, submap &second );
 
     private:
+        auto transparency_at( const point_sm_ms &p, float sight_penalty,
+                              const tripoint_bub_sm &grid_pos ) const -> float;
+        // @p value attenuated by the non-transparent fields on @p p.
+        auto apply_fields( const point_sm_ms &p, float value,
+                           const tripoint_bub_sm &grid_pos ) const -> float;
+        auto floor_at( const point_sm_ms &p, const submap *below ) const -> char;
+        auto below_submap( const map &m, const tripoint_bub_sm &grid_pos ) const -> const submap *;
+
         static const data_vars::data_set EMPTY_VARS;
         dimension_id dim_;
         tripoint_abs_sm pos_;
@@ -372,8 +563,21 @@ class submap : maptile_soa<SEEX, SEEY>
         std::map<point_sm_ms, computer> computers;
         std::unique_ptr<computer> legacy_computer;
         int temperature = 0;
+        // A new submap has never been written, so it starts out modified.
+        uint64_t generation_ = 1;
+        uint64_t saved_generation_ = 0;
+
+        std::string deferred_items_;
+        std::atomic<bool> items_deferred_ = false;
+        bool deferred_items_unindexed_ = false;
 
         void update_legacy_computer();
+        void load_items( JsonIn &jsin, int version );
+        void parse_deferred_items() const;
+        /** Writes the deferred "items" member verbatim; false if there is none. */
+        auto store_deferred_items( JsonOut &jsout ) const -> bool;
+        /** Members store() writes after the tile layers: items, vehicles, computers and so on. */
+        void store_objects( JsonOut &jsout ) const;
 
         static constexpr size_t elements = SEEX * SEEY;
 };
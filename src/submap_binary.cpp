@@ -0,0 +1,389 @@
+#include "submap_binary.h"
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include "calendar.h"
+#include "compress.h"
+#include "field_type.h"
+#include "json.h"
+#include "mapdata.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "trap.h"
+
+namespace submap_binary
+{
+
+auto is_encoded( const std::string_view blob ) -> bool
+{
+    return blob.starts_with( magic );
+}
+
+auto writer::u8( const uint8_t v ) -> void
+{
+    body_.push_back( static_cast<char>( v ) );
+}
+
+auto writer::u16( const uint16_t v ) -> void
+{
+    u8( static_cast<uint8_t>( v ) );
+    u8( static_cast<uint8_t>( v >> 8 ) );
+}
+
+auto writer::u32( const uint32_t v ) -> void
+{
+    u16( static_cast<uint16_t>( v ) );
+    u16( static_cast<uint16_t>( v >> 16 ) );
+}
+
+auto writer::i32( const int32_t v ) -> void
+{
+    u32( static_cast<uint32_t>( v ) );
+}
+
+auto writer::i64( const int64_t v ) -> void
+{
+    const auto bits = static_cast<uint64_t>( v );
+    u32( static_cast<uint32_t>( bits ) );
+    u32( static_cast<uint32_t>( bits >> 32 ) );
+}
+
+auto writer::str( const std::string_view v ) -> void
+{
+    u32( static_cast<uint32_t>( v.size() ) );
+    body_.append( v );
+}
+
+auto writer::id( const std::string_view v ) -> void
+{
+    const auto key = std::string( v );
+    const auto iter = index_.find( key );
+    if( iter != index_.end() ) {
+        u16( iter->second );
+        return;
+    }
+    if( strings_.size() > UINT16_MAX ) {
+        throw std::runtime_error( "too many distinct ids for one binary submap blob" );
+    }
+    const auto index = static_cast<uint16_t>( strings_.size() );
+    strings_.push_back( key );
+    index_.emplace( key, index );
+    u16( index );
+}
+
+auto writer::begin_record() -> std::size_t
+{
+    const auto offset = body_.size();
+    u32( 0 );
+    return offset;
+}
+
+auto writer::end_record( const std::size_t offset ) -> void
+{
+    const auto length = static_cast<uint32_t>( body_.size() - offset - sizeof( uint32_t ) );
+    for( auto i = std::size_t{ 0 }; i < sizeof( uint32_t ); ++i ) {
+        body_[offset + i] = static_cast<char>( ( length >> ( 8 * i ) ) & 0xff );
+    }
+}
+
+auto writer::finish() const -> std::string
+{
+    auto header = writer{};
+    header.body_.append( magic );
+    header.u16( format_version );
+    header.u32( static_cast<uint32_t>( strings_.size() ) );
+    std::ranges::for_each( strings_, [&header]( const std::string & s ) {
+        header.u16( static_cast<uint16_t>( s.size() ) );
+        header.body_.append( s );
+    } );
+    return std::move( header.body_ ) + body_;
+}
+
+reader::reader( const std::string_view blob ) : data_( blob )
+{
+    if( take( magic.size() ) != magic ) {
+        throw std::runtime_error( "not a binary submap blob" );
+    }
+    const auto version = u16();
+    if( version != format_version ) {
+        throw std::runtime_error( string_format( "unsupported binary submap format version %d",
+                                  version ) );
+    }
+    const auto count = u32();
+    strings_.reserve( std::min<std::size_t>( count, data_.size() ) );
+    for( auto i = uint32_t{ 0 }; i < count; ++i ) {
+        strings_.emplace_back( take( u16() ) );
+    }
+}
+
+auto reader::take( const std::size_t n ) -> std::string_view
+{
+    if( n > data_.size() - pos_ ) {
+        throw std::runtime_error( "binary submap blob is truncated" );
+    }
+    const auto out = data_.substr( pos_, n );
+    pos_ += n;
+    return out;
+}
+
+auto reader::u8() -> uint8_t
+{
+    return static_cast<uint8_t>( take( 1 )[0] );
+}
+
+auto reader::u16() -> uint16_t
+{
+    const auto lo = u8();
+    return static_cast<uint16_t>( lo | ( u8() << 8 ) );
+}
+
+auto reader::u32() -> uint32_t
+{
+    const auto lo = u16();
+    return lo | ( static_cast<uint32_t>( u16() ) << 16 );
+}
+
+auto reader::i32() -> int32_t
+{
+    return static_cast<int32_t>( u32() );
+}
+
+auto reader::i64() -> int64_t
+{
+    const auto lo = u32();
+    return static_cast<int64_t>( lo | ( static_cast<uint64_t>( u32() ) << 32 ) );
+}
+
+auto reader::str() -> std::string_view
+{
+    return take( u32() );
+}
+
+auto reader::id_index() -> uint16_t
+{
+    const auto index = u16();
+    if( index >= strings_.size() ) {
+        throw std::runtime_error( "binary submap blob refers to a missing id" );
+    }
+    return index;
+}
+
+auto reader::string_at( const uint16_t index ) const -> const std::string & // *NOPAD*
+{
+    return strings_.at( index );
+}
+
+auto reader::skip( const std::size_t n ) -> void
+{
+    take( n );
+}
+
+} // namespace submap_binary
+
+namespace
+{
+
+constexpr auto tiles_per_submap = SEEX * SEEY;
+
+auto tile_index( const point_sm_ms &p ) -> uint8_t
+{
+    return static_cast<uint8_t>( p.x() + p.y() * SEEX );
+}
+
+auto tile_at( const uint8_t index ) -> point_sm_ms
+{
+    if( index >= tiles_per_submap ) {
+        throw std::runtime_error( "binary submap blob has a tile outside the submap" );
+    }
+    return point_sm_ms( index % SEEX, index / SEEX );
+}
+
+/// Resolves string-table indices to int ids, looking each one up once.
+template<typename StrId>
+class id_palette
+{
+    public:
+        using int_id_type = decltype( std::declval<StrId>().id() );
+
+        explicit id_palette( const submap_binary::reader &in ) : in_( in ), ids_( in.string_count() ) {}
+
+        auto get( const uint16_t index ) -> int_id_type {
+            auto &slot = ids_[index];
+            if( !slot ) {
+                slot = StrId( in_.string_at( index ) ).id();
+            }
+            return *slot;
+        }
+
+    private:
+        const submap_binary::reader &in_;
+        std::vector<std::optional<int_id_type>> ids_;
+};
+
+/// Value runs over the tiles in submap_tiles() order.
+template<typename Get>
+auto write_runs( submap_binary::writer &out, Get get ) -> void
+{
+    auto runs = std::vector<std::pair<int, uint8_t>> {};
+    for( const auto p : submap_tiles() ) {
+        const auto v = get( p );
+        if( !runs.empty() && runs.back().first == v ) {
+            ++runs.back().second;
+        } else {
+            runs.emplace_back( v, 1 );
+        }
+    }
+    out.u16( static_cast<uint16_t>( runs.size() ) );
+    std::ranges::for_each( runs, [&out]( const std::pair<int, uint8_t> &run ) {
+        out.i32( run.first );
+        out.u8( run.second );
+    } );
+}
+
+template<typename Set>
+auto read_runs( submap_binary::reader &in, Set set ) -> void
+{
+    const auto tiles = submap_tiles();
+    auto iter = tiles.begin();
+    auto remaining = tiles_per_submap;
+    for( auto runs = in.u16(); runs > 0; --runs ) {
+        const auto v = in.i32();
+        const auto length = in.u8();
+        if( length > remaining ) {
+            throw std::runtime_error( "binary submap blob has too many tile values" );
+        }
+        remaining -= length;
+        for( auto i = 0; i < length; ++i, ++iter ) {
+            set( *iter, v );
+        }
+    }
+}
+
+} // namespace
+
+void submap::store_binary( submap_binary::writer &out ) const
+{
+    out.i64( to_turn<int64_t>( last_touched ) );
+    out.i32( temperature );
+
+    for( const auto p : submap_tiles() ) {
+        out.id( get_ter( p ).id().str() );
+    }
+
+    const auto furniture = std::ranges::count_if( submap_tiles(), [this]( const point_sm_ms & p ) {
+        return get_furn( p ) != f_null;
+    } );
+    out.u16( static_cast<uint16_t>( furniture ) );
+    for( const auto p : submap_tiles() ) {
+        if( get_furn( p ) != f_null ) {
+            out.u8( tile_index( p ) );
+            out.id( get_furn( p ).id().str() );
+        }
+    }
+
+    const auto traps = std::ranges::count_if( submap_tiles(), [this]( const point_sm_ms & p ) {
+        return get_trap( p ) != tr_null;
+    } );
+    out.u16( static_cast<uint16_t>( traps ) );
+    for( const auto p : submap_tiles() ) {
+        if( get_trap( p ) != tr_null ) {
+            out.u8( tile_index( p ) );
+            out.id( get_trap( p ).id().str() );
+        }
+    }
+
+    write_runs( out, [this]( const point_sm_ms & p ) {
+        return get_radiation( p );
+    } );
+    write_runs( out, [this]( const point_sm_ms & p ) {
+        return scent_values[p.x()][p.y()];
+    } );
+
+    const auto field_tiles = std::ranges::count_if( submap_tiles(), [this]( const point_sm_ms & p ) {
+        return field_at( p ).field_count() > 0;
+    } );
+    out.u16( static_cast<uint16_t>( field_tiles ) );
+    for( const auto p : submap_tiles() ) {
+        const field &f = field_at( p );
+        if( f.field_count() == 0 ) {
+            continue;
+        }
+        out.u8( tile_index( p ) );
+        out.u8( static_cast<uint8_t>( f.field_count() ) );
+        for( const auto &elem : f ) {
+            const field_entry &cur = elem.second;
+            out.id( cur.get_field_type().id().str() );
+            out.i32( cur.get_field_intensity() );
+            out.i64( to_turns<int64_t>( cur.get_field_age() ) );
+        }
+    }
+
+    std::ostringstream objects;
+    {
+        JsonOut jsout( objects );
+        jsout.start_object();
+        store_objects( jsout );
+        jsout.end_object();
+    }
+    out.str( objects.str() );
+}
+
+void submap::load_binary( submap_binary::reader &in, const int version,
+                          const tripoint_abs_ms offset, const dimension_id &dim )
+{
+    last_touched = std::min( calendar::turn_zero + time_duration::from_turns( in.i64() ),
+                             calendar::turn );
+    temperature = in.i32();
+
+    auto terrain = id_palette<ter_str_id>( in );
+    for( const auto p : submap_tiles() ) {
+        ter.set( cell( p ), terrain.get( in.id_index() ) );
+    }
+
+    auto furniture = id_palette<furn_str_id>( in );
+    for( auto count = in.u16(); count > 0; --count ) {
+        const auto p = tile_at( in.u8() );
+        frn.set( cell( p ), furniture.get( in.id_index() ) );
+    }
+
+    auto traps = id_palette<trap_str_id>( in );
+    for( auto count = in.u16(); count > 0; --count ) {
+        const auto p = tile_at( in.u8() );
+        trp.set( cell( p ), traps.get( in.id_index() ) );
+        trap_cache.push_back( p );
+    }
+
+    read_runs( in, [this]( const point_sm_ms & p, const int v ) {
+        set_radiation( p, v );
+    } );
+    read_runs( in, [this]( const point_sm_ms & p, const int v ) {
+        scent_values[p.x()][p.y()] = v;
+    } );
+
+    auto field_types = id_palette<field_type_str_id>( in );
+    for( auto count = in.u16(); count > 0; --count ) {
+        const auto p = tile_at( in.u8() );
+        for( auto entries = in.u8(); entries > 0; --entries ) {
+            const auto ft = field_types.get( in.id_index() );
+            const auto intensity = in.i32();
+            const auto age = time_duration::from_turns( in.i64() );
+            if( field_at( p ).find_field( ft ) == nullptr ) {
+                note_field_added( p, ft );
+            }
+            mutable_field_at( p ).add_field( ft, intensity, age );
+        }
+    }
+
+    memory_istreambuf objects_buf( in.str() );
+    std::istream objects( &objects_buf );
+    JsonIn jsin( objects );
+    jsin.start_object();
+    while( !jsin.end_object() ) {
+        load( jsin, jsin.get_member_name(), version, offset, dim );
+    }
+}
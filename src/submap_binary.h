@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Compact binary encoding for the submaps of one OMT blob.
+ *
+ * Layout, all integers little-endian:
+ *
+ *     "CBSM"  u16 format_version  u32 string_count  { u16 length, bytes }...  body
+ *
+ * The body refers to ids by their index in the string table, so each id is
+ * written once per blob no matter how many tiles use it.  Terrain is a dense
+ * palette-indexed array; furniture, traps and fields are typed sparse records.
+ * Items, vehicles and the other object members stay an embedded JSON object
+ * so their load-time migrations keep working.
+ *
+ * JSON blobs always start with '[', so readers can tell the formats apart by
+ * the magic alone; the sqlite `compression` column records it as well.
+ */
+namespace submap_binary
+{
+
+constexpr auto magic = std::string_view{ "CBSM" };
+constexpr auto format_version = uint16_t{ 1 };
+/// `compression` column value for a zlib-compressed binary blob.
+constexpr auto compression_tag = std::string_view{ "zlib+cbsm" };
+
+/// True if @p blob starts with the binary submap magic.
+auto is_encoded( std::string_view blob ) -> bool;
+
+/** Builds one blob.  Ids passed to id() land in the string table. */
+class writer
+{
+    public:
+        auto u8( uint8_t v ) -> void;
+        auto u16( uint16_t v ) -> void;
+        auto u32( uint32_t v ) -> void;
+        auto i32( int32_t v ) -> void;
+        auto i64( int64_t v ) -> void;
+        /// Length-prefixed raw bytes.
+        auto str( std::string_view v ) -> void;
+        /// Index of @p v in the string table, adding it on first use.
+        auto id( std::string_view v ) -> void;
+        /// Start a length-prefixed record; pass the result to end_record().
+        auto begin_record() -> std::size_t;
+        auto end_record( std::size_t offset ) -> void;
+
+        /// Header, string table and body.
+        auto finish() const -> std::string;
+
+    private:
+        std::string body_;
+        std::vector<std::string> strings_;
+        std::unordered_map<std::string, uint16_t> index_;
+};
+
+/** Reads a blob built by writer.  Throws std::runtime_error on malformed data. */
+class reader
+{
+    public:
+        explicit reader( std::string_view blob );
+
+        auto u8() -> uint8_t;
+        auto u16() -> uint16_t;
+        auto u32() -> uint32_t;
+        auto i32() -> int32_t;
+        auto i64() -> int64_t;
+        auto str() -> std::string_view;
+        /// String-table index written by writer::id().
+        auto id_index() -> uint16_t;
+        auto id() -> const std::string & { // *NOPAD*
+            return string_at( id_index() );
+        }
+        auto string_at( uint16_t index ) const -> const std::string &; // *NOPAD*
+        auto skip( std::size_t n ) -> void;
+        auto position() const -> std::size_t {
+            return pos_;
+        }
+        auto string_count() const -> std::size_t {
+            return strings_.size();
+        }
+        auto at_end() const -> bool {
+            return pos_ == data_.size();
+        }
+
+    private:
+        auto take( std::size_t n ) -> std::string_view;
+
+        std::string_view data_;
+        std::size_t pos_ = 0;
+        std::vector<std::string> strings_;
+};
+
+} // namespace submap_binary
@@ -46,3 +46,25 @@ void create_burnproducts( std::vector<detached_ptr<item>> &out, const item &fuel
 auto process_fields_in_submap( const dimension_id &dim, submap &sm,
                                const tripoint_abs_sm &pos,
                                mapbuffer &mb ) -> bool;
+
+/**
+ * Process fields in every loaded submap of @p positions, optionally on the thread pool.
+ *
+ * Submaps are split into 27 classes by position modulo 3.  Classes run one
+ * after another; the submaps of a class are far enough apart that spreading
+ * into neighbours cannot collide, so they run concurrently when @p parallel.
+ * Every submap draws from its own rng_stream and map cache invalidations are
+ * applied on the calling thread after each class, so the outcome is identical
+ * with or without workers.
+ *
+ * When @p deferred_dirty is set, the invalidations are appended to it instead of
+ * touching the map, which lets several dimensions be processed at once from pool
+ * workers; the caller applies them on the main thread.
+ *
+ * @return  positions of submaps with a fire field still alive.
+ */
+auto process_fields_in_submaps( const dimension_id &dim,
+                                const std::vector<tripoint_abs_sm> &positions,
+                                mapbuffer &mb, bool parallel,
+                                std::vector<tripoint_bub_ms> *deferred_dirty = nullptr )
+-> std::vector<tripoint_abs_sm>;
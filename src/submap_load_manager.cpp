@@ -7,7 +7,10 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <functional>
 #include <future>
+#include <iterator>
+#include <optional>
 #include <ranges>
 #include <set>
 #include <unordered_set>
@@ -27,7 +30,10 @@
 #include "overmapbuffer.h"
 #include "point.h"
 #include "profile.h"
+#include "string_formatter.h"
+#include "submap.h"
 #include "thread_pool.h"
+#include "turn_recorder.h"
 
 namespace
 {
@@ -35,6 +41,7 @@ static constexpr auto retained_omt_hard_scale = std::size_t { 2 };
 static constexpr auto retained_omt_panic_scale = std::size_t { 4 };
 static constexpr auto retained_omt_max_budget_scale = std::size_t { 8 };
 static constexpr auto lazy_border_steps_to_cross_omt = std::size_t { SEEX * 2 };
+static constexpr auto lazy_border_sim_budget = std::chrono::microseconds { 500 };
 
 auto divide_round_up_size( const std::size_t numerator, const std::size_t denominator )
 -> std::size_t
@@ -129,10 +136,129 @@ auto request_inclusive_end( const submap_load_request &req ) -> point_abs_sm
 {
     return point_abs_sm( req.end.x() - 1, req.end.y() - 1 );
 }
+
+constexpr auto omt_submap_offsets = std::array{ point_zero, point_south, point_east,
+                                                point_south_east };
+
+auto resident_submaps_in_column( mapbuffer &mb, const point_abs_omt &omt_xy ) -> std::uint64_t
+{
+    auto resident = std::uint64_t{ 0 };
+    for( const auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
+        const auto sm_base = project_to<coords::sm>( tripoint_abs_omt{ omt_xy, z } );
+        resident += static_cast<std::uint64_t>( std::ranges::count_if( omt_submap_offsets,
+        [&]( const point & off ) {
+            return mb.lookup_submap_in_memory( sm_base + off ) != nullptr;
+        } ) );
+    }
+    return resident;
+}
+
+auto source_index( const load_request_source source ) -> std::size_t
+{
+    return static_cast<std::size_t>( source );
+}
+
+/** Lower ranks win: simulating requests first, then the earliest source. */
+auto source_rank( const load_request_source source ) -> std::pair<bool, std::size_t>
+{
+    return { is_resident_only_source( source ), source_index( source ) };
+}
+
+/** Best-ranked source among @p requests covering any submap of the column, if any does. */
+template<typename Requests>
+auto best_column_source( const Requests &requests, const dimension_id &dim_id,
+                         const point_abs_omt &omt_xy ) -> std::optional<load_request_source>
+{
+    const auto sm_base = project_to<coords::sm>( omt_xy );
+    auto best = std::optional<load_request_source> {};
+    for( const auto &[handle, req] : requests ) {
+        if( req.dim_id != dim_id || ( best && source_rank( *best ) <= source_rank( req.source ) ) ) {
+            continue;
+        }
+        if( std::ranges::any_of( omt_submap_offsets, [&]( const point & off ) {
+        return contains_request_pos( req, sm_base + off );
+        } ) ) {
+            best = req.source;
+        }
+    }
+    return best;
+}
 } // namespace
 
+auto load_request_source_name( const load_request_source source ) -> const char *
+{
+    switch( source ) {
+        case load_request_source::reality_bubble:
+            return "reality_bubble";
+        case load_request_source::player_base:
+            return "player_base";
+        case load_request_source::script:
+            return "script";
+        case load_request_source::fire_spread:
+            return "fire_spread";
+        case load_request_source::lazy_border:
+            return "lazy_border";
+        case load_request_source::portal_preload:
+            return "portal_preload";
+        case load_request_source::prefetch:
+            return "prefetch";
+    }
+    return "unknown";
+}
+
+auto submap_churn_counts::operator+=( const submap_churn_counts &rhs ) -> submap_churn_counts &
+{
+    for( std::size_t i = 0; i < num_load_request_sources; ++i ) {
+        loaded[i] += rhs.loaded[i];
+        generated[i] += rhs.generated[i];
+        resurrected[i] += rhs.resurrected[i];
+    }
+    evicted += rhs.evicted;
+    thrashed += rhs.thrashed;
+    return *this;
+}
+
+auto describe_churn( const submap_churn_counts &last_turn,
+                     const submap_churn_counts &total ) -> std::string
+{
+    auto out = string_format( "%-16s %22s %22s %22s\n", "submaps", "loaded", "generated",
+                              "resurrected" );
+    out += string_format( "%-16s %10s %11s %10s %11s %10s %11s\n", "source", "last turn", "total",
+                          "last turn", "total", "last turn", "total" );
+    for( std::size_t i = 0; i < num_load_request_sources; ++i ) {
+        out += string_format( "%-16s %10d %11d %10d %11d %10d %11d\n",
+                              load_request_source_name( static_cast<load_request_source>( i ) ),
+                              last_turn.loaded[i], total.loaded[i],
+                              last_turn.generated[i], total.generated[i],
+                              last_turn.resurrected[i], total.resurrected[i] );
+    }
+    out += string_format( "\nEvicted submaps: %d last turn, %d total\n", last_turn.evicted,
+                          total.evicted );
+    out += string_format( "Columns reloaded within %s of eviction: %d last turn, %d total\n",
+                          to_string( submap_load_manager::thrash_window ), last_turn.thrashed,
+                          total.thrashed );
+    return out;
+}
+
 submap_load_manager submap_loader;
 
+auto prefetch_bounds_ahead( const point_abs_sm &bubble_begin, const point_abs_sm &bubble_end,
+                            const point &heading, const int lookahead )
+-> std::optional<std::pair<point_abs_sm, point_abs_sm>>
+{
+    const auto step = point{ signum( heading.x ), signum( heading.y ) };
+    if( step == point_zero || lookahead <= 0 ||
+        bubble_end.x() <= bubble_begin.x() || bubble_end.y() <= bubble_begin.y() ) {
+        return std::nullopt;
+    }
+    const auto shift = point_rel_sm( step * lookahead );
+    const auto begin = point_abs_sm( std::min( bubble_begin.x(), bubble_begin.x() + shift.x() ),
+                                     std::min( bubble_begin.y(), bubble_begin.y() + shift.y() ) );
+    const auto end = point_abs_sm( std::max( bubble_end.x(), bubble_end.x() + shift.x() ),
+                                   std::max( bubble_end.y(), bubble_end.y() + shift.y() ) );
+    return std::make_pair( begin, end );
+}
+
 auto submap_load_manager::request_load(
     load_request_source source,
     const dimension_id &dim_id,
@@ -203,8 +329,8 @@ auto submap_load_manager::compute_desired_set() const -> key_set
     key_set desired;
     std::ranges::for_each( requests_, [&]( const auto & kv ) {
         const submap_load_request &req = kv.second;
-        // lazy_border positions are handled separately in OMT space.
-        if( req.source == load_request_source::lazy_border ) {
+        // Resident-only positions are handled separately in OMT space.
+        if( is_resident_only_source( req.source ) ) {
             return;
         }
         // The desired set is 2-D (horizontal only).  Load requests always cover
@@ -246,7 +372,7 @@ auto submap_load_manager::compute_lazy_border_omts() const -> horizontal_omt_set
     auto lazy_omts = horizontal_omt_set {};
     std::ranges::for_each( requests_, [&]( const auto & kv ) {
         const auto &req = kv.second;
-        if( req.source != load_request_source::lazy_border ) {
+        if( !is_resident_only_source( req.source ) ) {
             return;
         }
         // The request is already an explicit resident-only bounds. Round that
@@ -310,13 +436,15 @@ auto submap_load_manager::retained_omt_base_budget() const -> std::size_t
     return std::max( std::size_t{ 1 }, cache_length / 2 );
 }
 
-auto submap_load_manager::retain_omt( const omt_column_key &key ) -> void
+auto submap_load_manager::retain_omt( const omt_column_key &key,
+                                      const load_request_source source ) -> void
 {
     if( auto it = retained_omt_index_.find( key ); it != retained_omt_index_.end() ) {
+        it->second->source = source;
         retained_omts_.splice( retained_omts_.end(), retained_omts_, it->second );
         return;
     }
-    auto it = retained_omts_.insert( retained_omts_.end(), key );
+    auto it = retained_omts_.insert( retained_omts_.end(), retained_omt{ key, source } );
     retained_omt_index_.emplace( key, it );
 }
 
@@ -333,7 +461,13 @@ auto submap_load_manager::erase_retained_omt( const omt_column_key &key ) -> voi
 auto submap_load_manager::erase_desired_retained_omts( const key_set &desired ) -> void
 {
     std::ranges::for_each( desired, [&]( const desired_key & key ) {
-        erase_retained_omt( { key.first, project_to<coords::omt>( key.second ) } );
+        const auto column = omt_column_key{ key.first, project_to<coords::omt>( key.second ) };
+        if( !retained_omt_index_.contains( column ) ) {
+            return;
+        }
+        churn().resurrected[source_index( column_source( column ) )] +=
+            resident_submaps_in_column( MAPBUFFER_REGISTRY.get( column.first ), column.second );
+        erase_retained_omt( column );
     } );
 }
 
@@ -345,6 +479,12 @@ auto submap_load_manager::evict_omt_column( const omt_column_key &key ) -> void
     if( was_dirty ) {
         dirty_omts_.erase( key );
     }
+    // Eviction writes the column out (or drops an unchanged one) itself.
+    simulated_since_save_.erase( key );
+    churn().evicted += resident_submaps_in_column( mb, omt_xy );
+    forget_old_evictions();
+    recent_evictions_.emplace_back( key, calendar::turn );
+    recent_eviction_index_.insert_or_assign( key, calendar::turn );
     std::ranges::for_each( std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ),
     [&]( const auto z ) {
         const auto pos = tripoint_abs_omt{ omt_xy, z };
@@ -356,7 +496,7 @@ auto submap_load_manager::evict_omt_column( const omt_column_key &key ) -> void
 auto submap_load_manager::evict_oldest_retained_omts( std::size_t count ) -> void
 {
     while( count > 0 && !retained_omts_.empty() ) {
-        const auto key = retained_omts_.front();
+        const auto key = retained_omts_.front().key;
         retained_omts_.pop_front();
         retained_omt_index_.erase( key );
         evict_omt_column( key );
@@ -400,6 +540,52 @@ auto submap_load_manager::process_retained_omt_eviction() -> void
     evict_oldest_retained_omts( budget );
 }
 
+auto submap_load_manager::enforce_memory_budget() -> void
+{
+    if( map_memory_budget_mb <= 0 || retained_omts_.empty() ||
+        ( memory_budget_checked_ &&
+          calendar::turn - *memory_budget_checked_ < memory_budget_interval ) ) {
+        return;
+    }
+    memory_budget_checked_ = calendar::turn;
+    ZoneScopedN( "slm_enforce_memory_budget" );
+
+    auto bytes = std::size_t{ 0 };
+    auto submaps = std::size_t{ 0 };
+    MAPBUFFER_REGISTRY.for_each( [&]( const dimension_id &, mapbuffer & mb ) {
+        bytes += mb.memory_usage();
+        submaps += mb.loaded_submap_count();
+    } );
+    TracyPlot( "Resident Map MB", static_cast<int64_t>( bytes >> 20 ) );
+    const auto cap = static_cast<std::size_t>( map_memory_budget_mb ) << 20;
+    if( bytes <= cap || submaps == 0 ) {
+        return;
+    }
+
+    // Columns are charged the average submap, which is all the mapbuffer can tell
+    // without measuring each one; eviction goes a tenth under the cap so the next
+    // check does not find it over again straight away.
+    const auto per_submap = bytes / submaps;
+    const auto target = cap - cap / 10;
+    auto order = std::vector<retained_omt>( retained_omts_.begin(), retained_omts_.end() );
+    std::ranges::stable_sort( order, std::greater<> {}, []( const retained_omt & r ) {
+        return source_rank( r.source );
+    } );
+    auto evicted = std::size_t{ 0 };
+    for( const auto &[key, source] : order ) {
+        if( bytes <= target ) {
+            break;
+        }
+        const auto freed = resident_submaps_in_column( MAPBUFFER_REGISTRY.get( key.first ),
+                           key.second ) * per_submap;
+        erase_retained_omt( key );
+        evict_omt_column( key );
+        bytes -= std::min<std::size_t>( bytes, freed );
+        ++evicted;
+    }
+    TracyPlot( "Memory Budget Evicted Columns", static_cast<int64_t>( evicted ) );
+}
+
 auto submap_load_manager::load_lazy_omt_zlevel_data( mapbuffer &mb,
         const tripoint_abs_omt &omt_addr,
         const lazy_omt_load_options &options ) -> lazy_omt_load_result
@@ -411,7 +597,8 @@ auto submap_load_manager::load_lazy_omt_zlevel_data( mapbuffer &mb,
     }
 
     result.dirty = mb.preload_omt( omt_addr );
-    if( !is_omt_zlevel_loaded( mb, omt_addr ) ) {
+    result.loaded = is_omt_zlevel_loaded( mb, omt_addr );
+    if( !result.loaded ) {
         // Partial z-levels are rare, but resolving them can discard duplicate
         // generated submaps; keep that on the main thread.
         if( is_pool_worker_thread() && is_any_omt_zlevel_loaded( mb, omt_addr ) ) {
@@ -473,6 +660,14 @@ auto submap_load_manager::apply_lazy_omt_result( const omt_key &key,
     if( result.dirty || result.generated() ) {
         dirty_omts_.insert( { key.first, key.second.xy() } );
     }
+    if( result.loaded || result.generated() ) {
+        const auto column = omt_column_key{ key.first, key.second.xy() };
+        const auto source = source_index( column_source( column ) );
+        auto &counts = result.loaded ? churn().loaded : churn().generated;
+        counts[source] += omt_submap_offsets.size();
+        turn_recorder::count( turn_recorder::counter::submaps_loaded, omt_submap_offsets.size() );
+        note_column_loaded( column );
+    }
     return result.generated();
 }
 
@@ -570,7 +765,7 @@ auto submap_load_manager::start_lazy_omt_job( const omt_key &key ) -> lazy_omt_s
             }
 
             lazy_omt_futures_.emplace( key,
-            get_thread_pool().submit_returning( [&mb, omt_addr = key.second, selected_mapgen]() {
+            get_thread_pool().submit_returning( "lazy_omt_mapgen", [&mb, omt_addr = key.second, selected_mapgen]() {
                 return load_lazy_omt_zlevel_data( mb, omt_addr, {
                     .defer_postprocess_hooks = true,
                     .worker_safe = true,
@@ -583,7 +778,7 @@ auto submap_load_manager::start_lazy_omt_job( const omt_key &key ) -> lazy_omt_s
     }
 
     lazy_omt_futures_.emplace( key,
-    get_thread_pool().submit_returning( [&mb, omt_addr = key.second]() {
+    get_thread_pool().submit_returning( "lazy_omt_load", [&mb, omt_addr = key.second]() {
         return load_lazy_omt_zlevel_data( mb, omt_addr, {
             .defer_postprocess_hooks = true,
             .worker_safe = true,
@@ -594,8 +789,36 @@ auto submap_load_manager::start_lazy_omt_job( const omt_key &key ) -> lazy_omt_s
     return { .started = true };
 }
 
+auto submap_load_manager::is_prefetch_only_omt( const omt_column_key &key ) const -> bool
+{
+    const auto &[dim_id, omt_xy] = key;
+    const auto sm_base = project_to<coords::sm>( omt_xy );
+    auto prefetched = false;
+    for( const auto &[handle, req] : requests_ ) {
+        if( req.dim_id != dim_id || !is_resident_only_source( req.source ) ) {
+            continue;
+        }
+        const auto covers = std::ranges::any_of( std::array{ point_zero, point_south, point_east, point_south_east },
+        [&]( const point & off ) {
+            return contains_request_pos( req, sm_base + off );
+        } );
+        if( !covers ) {
+            continue;
+        }
+        if( req.source != load_request_source::prefetch ) {
+            return false;
+        }
+        prefetched = true;
+    }
+    return prefetched;
+}
+
 auto submap_load_manager::lazy_omt_priority( const omt_column_key &key ) const -> int
 {
+    // Prefetch is speculative: it only gets budget the bubble's own border leaves over.
+    if( is_prefetch_only_omt( key ) ) {
+        return -1;
+    }
     if( lazy_omt_preload_direction_ == point_zero ) {
         return 0;
     }
@@ -656,6 +879,18 @@ auto submap_load_manager::queue_lazy_border_omts( const horizontal_omt_set &bord
         if( lhs_priority != rhs_priority ) {
             return lhs_priority > rhs_priority;
         }
+        // Nearest prefetch columns first: those are the ones the bubble reaches next.
+        if( lhs_priority < 0 && lazy_omt_focus_ ) {
+            const auto focus = project_to<coords::omt>( lazy_omt_focus_->pos.xy() );
+            const auto dist = [&]( const point_abs_omt & p ) {
+                return std::max( std::abs( p.x() - focus.x() ), std::abs( p.y() - focus.y() ) );
+            };
+            const auto lhs_dist = dist( lhs.second );
+            const auto rhs_dist = dist( rhs.second );
+            if( lhs_dist != rhs_dist ) {
+                return lhs_dist < rhs_dist;
+            }
+        }
         if( lhs.first != rhs.first ) {
             return lhs.first < rhs.first;
         }
@@ -854,6 +1089,62 @@ auto submap_load_manager::has_deferred_lazy_border_work() const noexcept -> bool
     return lazy_border_work_deferred_;
 }
 
+auto submap_load_manager::process_lazy_border_simulation() -> void
+{
+    ZoneScoped;
+    if( !lazy_border_enabled || lazy_border_sim_interval <= 0 ) {
+        lazy_sim_queue_.clear();
+        return;
+    }
+    const auto now = to_turn<int>( calendar::turn );
+    if( lazy_sim_queue_.empty() ) {
+        if( lazy_sim_last_round_turn_ >= 0 &&
+            now - lazy_sim_last_round_turn_ < lazy_border_sim_interval ) {
+            return;
+        }
+        lazy_sim_last_round_turn_ = now;
+        std::ranges::copy_if( prev_desired_, std::back_inserter( lazy_sim_queue_ ),
+        [&]( const desired_key & key ) {
+            return !prev_simulated_.contains( key );
+        } );
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + lazy_border_sim_budget;
+    auto caught_up = std::size_t { 0 };
+    while( !lazy_sim_queue_.empty() && std::chrono::steady_clock::now() < deadline ) {
+        const auto key = lazy_sim_queue_.back();
+        lazy_sim_queue_.pop_back();
+        // The border may have moved since the round was queued
+        if( !prev_desired_.contains( key ) || prev_simulated_.contains( key ) ) {
+            continue;
+        }
+        const auto &[dim_id, pos] = key;
+        auto &mb = MAPBUFFER_REGISTRY.get( dim_id );
+        auto touched = false;
+        for( const auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
+            const auto sm_pos = tripoint_abs_sm( pos, z );
+            const auto job_key = omt_key{ dim_id, project_to<coords::omt>( sm_pos ) };
+            // Still being loaded, maybe on a worker
+            if( lazy_omt_futures_.contains( job_key ) || lazy_omt_job_index_.contains( job_key ) ) {
+                continue;
+            }
+            const auto *const sm = mb.lookup_submap_in_memory( sm_pos );
+            if( sm == nullptr ||
+                calendar::turn - sm->last_touched < time_duration::from_turns( lazy_border_sim_interval ) ) {
+                continue;
+            }
+            mb.actualize_submap( sm_pos );
+            touched = true;
+            caught_up++;
+        }
+        if( touched ) {
+            // Changed in memory, so eviction has to write it out
+            dirty_omts_.insert( { dim_id, project_to<coords::omt>( pos ) } );
+        }
+    }
+    TracyPlot( "Lazy Border Submaps Caught Up", static_cast<int64_t>( caught_up ) );
+}
+
 void submap_load_manager::drain_lazy_loads()
 {
     ZoneScopedN( "drain_lazy_loads" );
@@ -891,6 +1182,10 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
 
     TracyPlot( "Thread Pool Workers", static_cast<int64_t>( get_thread_pool().num_workers() ) );
     TracyPlot( "Thread Pool Queue", static_cast<int64_t>( get_thread_pool().queue_size() ) );
+    enforce_memory_budget();
+
+    // Requests before this update, for the source that kept each departing column
+    auto departed_requests = std::vector<std::pair<load_request_handle, submap_load_request>> {};
 
     // Early exit: if no request bounds have changed since the last update,
     // the desired/simulated/border sets are identical — skip the expensive
@@ -923,7 +1218,7 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
             process_or_defer_lazy_border_work( defer_lazy_border_work );
             return;
         }
-        prev_requests_ = std::move( cur_requests );
+        departed_requests = std::exchange( prev_requests_, std::move( cur_requests ) );
     }
 
     // Simulated set: positions that need full per-turn processing.
@@ -968,19 +1263,24 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
     // will receive game logic and must be saved to disk when evicted.
     for( const auto &[dim_id, omt_xy] : new_omts ) {
         dirty_omts_.insert( { dim_id, omt_xy } );
+        simulated_since_save_.insert( { dim_id, omt_xy } );
     }
 
     // ---- Step 1: parallel disk preload for newly-simulated omts ----
     // preload_omt() is thread-safe (disk I/O outside submaps_mutex_; add
     // under the lock).  Running multiple omts in parallel hides disk latency.
-    // Each horizontal OMT drives a z-level loop internally.
+    // Each horizontal OMT is one task that reads its missing z-levels in a
+    // single batch.
     auto resident_zlevels = std::size_t{ 0 };
     auto preloaded_zlevels = std::size_t{ 0 };
+    auto preloaded_by_omt = std::unordered_map<horiz_omt_key, std::size_t,
+                            coord_pair_hash<point_abs_omt>> {};
     {
         ZoneScopedN( "slm_preload_new_omts" );
         std::vector<std::future<void>> preload_futures;
         for( const auto &[dim_id, omt_xy] : new_omts ) {
             auto &mb = MAPBUFFER_REGISTRY.get( dim_id );
+            auto column = std::vector<tripoint_abs_omt> {};
             for( const auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
                 const tripoint_abs_omt omt_addr{ omt_xy, z };
                 const omt_key qk{ dim_id, omt_addr };
@@ -999,13 +1299,19 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
                     continue;
                 }
                 ++preloaded_zlevels;
-                preload_futures.push_back( get_thread_pool().submit_returning(
-                [&mb, omt_addr]() {
-                    mb.preload_omt( omt_addr );
-                } ) );
+                column.push_back( omt_addr );
             }
+            if( column.empty() ) {
+                continue;
+            }
+            preloaded_by_omt.emplace( horiz_omt_key{ dim_id, omt_xy }, column.size() );
+            preload_futures.push_back( get_thread_pool().submit_returning( "mapbuffer_preload",
+            [&mb, column = std::move( column )]() {
+                mb.preload_omts( column );
+            } ) );
         }
         std::ranges::for_each( preload_futures, []( auto & f ) {
+            get_thread_pool().wait_helping( f );
             f.get();
         } );
     } // slm_preload_new_omts
@@ -1034,6 +1340,7 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
         ZoneScopedN( "slm_generate_new_omts" );
         for( const auto &[dim_id, omt_xy] : new_omts ) {
             auto &mb = MAPBUFFER_REGISTRY.get( dim_id );
+            auto generated_here = std::size_t{ 0 };
             for( const auto z : std::views::iota( -OVERMAP_DEPTH, OVERMAP_HEIGHT + 1 ) ) {
                 const auto omt_addr = tripoint_abs_omt{ omt_xy, z };
                 const auto sm_base = project_to<coords::sm>( omt_addr );
@@ -1051,10 +1358,27 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
                     } );
                     if( result.is_generated() ) {
                         ++generated_zlevels;
+                        ++generated_here;
                         generated_omt_columns.emplace( dim_id, omt_xy );
                     }
                 }
             }
+
+            const auto column = omt_column_key{ dim_id, omt_xy };
+            const auto preloaded = preloaded_by_omt.find( column );
+            if( preloaded == preloaded_by_omt.end() ) {
+                continue;
+            }
+            // Whatever the preload brought in didn't need generating
+            const auto loaded_here = preloaded->second -
+                                     std::min( preloaded->second, generated_here );
+            auto &counts = churn();
+            const auto source = source_index( column_source( column ) );
+            counts.generated[source] += generated_here * omt_submap_offsets.size();
+            counts.loaded[source] += loaded_here * omt_submap_offsets.size();
+            turn_recorder::count( turn_recorder::counter::submaps_loaded,
+                                  ( generated_here + loaded_here ) * omt_submap_offsets.size() );
+            note_column_loaded( column );
         }
     }
     TracyPlot( "New Sim OMT Z Generated", static_cast<int64_t>( generated_zlevels ) );
@@ -1123,7 +1447,9 @@ auto submap_load_manager::update( const bool defer_lazy_border_work ) -> void
                 }
             }
             if( !any_still_desired ) {
-                retain_omt( { key.first, omt_xy } );
+                // Only the lazy border wanted a column no request covered
+                retain_omt( ck, best_column_source( departed_requests, key.first, omt_xy )
+                            .value_or( load_request_source::lazy_border ) );
             }
         }
     }
@@ -1170,7 +1496,7 @@ auto submap_load_manager::is_simulated( const dimension_id &dim_id,
         if( !contains_request_pos( req, pos ) ) {
             continue;
         }
-        if( req.source != load_request_source::lazy_border ) {
+        if( !is_resident_only_source( req.source ) ) {
             return true;
         }
         covered_by_lazy_only = true;
@@ -1218,7 +1544,7 @@ auto submap_load_manager::non_bubble_requests() const -> std::vector<submap_load
 {
     auto is_non_bubble = []( const auto & kv ) {
         return kv.second.source != load_request_source::reality_bubble
-               && kv.second.source != load_request_source::lazy_border;
+               && !is_resident_only_source( kv.second.source );
     };
     auto to_request = []( const auto & kv ) -> const submap_load_request & {
         return kv.second;
@@ -1233,6 +1559,87 @@ auto submap_load_manager::is_fully_drained() const noexcept -> bool
     return lazy_omt_futures_.empty();
 }
 
+auto submap_load_manager::churn() -> submap_churn_counts &
+{
+    if( calendar::turn != churn_turn_ ) {
+        churn_total_ += churn_this_turn_;
+        churn_last_turn_ = calendar::turn - churn_turn_ == 1_turns ? churn_this_turn_
+                           : submap_churn_counts {};
+        churn_this_turn_ = {};
+        churn_turn_ = calendar::turn;
+    }
+    return churn_this_turn_;
+}
+
+auto submap_load_manager::last_turn_churn() const -> submap_churn_counts
+{
+    if( calendar::turn == churn_turn_ ) {
+        return churn_last_turn_;
+    }
+    // Nothing has moved since, so the counts of the current turn are the last turn's.
+    return calendar::turn - churn_turn_ == 1_turns ? churn_this_turn_ : submap_churn_counts {};
+}
+
+auto submap_load_manager::total_churn() const -> submap_churn_counts
+{
+    auto total = churn_total_;
+    total += churn_this_turn_;
+    return total;
+}
+
+void submap_load_manager::reset_churn()
+{
+    churn_this_turn_ = {};
+    churn_last_turn_ = {};
+    churn_total_ = {};
+    churn_turn_ = calendar::turn;
+}
+
+auto submap_load_manager::covering_source( const dimension_id &dim_id,
+        const point_abs_sm &pos ) const -> std::optional<load_request_source>
+{
+    auto best = std::optional<load_request_source> {};
+    for( const auto &[handle, req] : requests_ ) {
+        if( req.dim_id != dim_id || !contains_request_pos( req, pos ) ) {
+            continue;
+        }
+        if( !best || source_rank( req.source ) < source_rank( *best ) ) {
+            best = req.source;
+        }
+    }
+    return best;
+}
+
+auto submap_load_manager::column_source( const omt_column_key &key ) const -> load_request_source
+{
+    // Only a lazy job outliving its request is wanted by nobody
+    return best_column_source( requests_, key.first, key.second )
+           .value_or( load_request_source::lazy_border );
+}
+
+auto submap_load_manager::forget_old_evictions() -> void
+{
+    while( !recent_evictions_.empty() &&
+           calendar::turn - recent_evictions_.front().second > thrash_window ) {
+        const auto &[key, evicted_at] = recent_evictions_.front();
+        const auto it = recent_eviction_index_.find( key );
+        // A later eviction of the same column has its own entry further back
+        if( it != recent_eviction_index_.end() && it->second == evicted_at ) {
+            recent_eviction_index_.erase( it );
+        }
+        recent_evictions_.pop_front();
+    }
+}
+
+auto submap_load_manager::note_column_loaded( const omt_column_key &key ) -> void
+{
+    forget_old_evictions();
+    // Later z-levels of the same column find the entry gone and aren't counted again
+    if( recent_eviction_index_.erase( key ) > 0 ) {
+        ++churn().thrashed;
+    }
+}
+
 void submap_load_manager::flush_prev_desired()
 {
     assert( is_fully_drained() );
@@ -1250,6 +1657,20 @@ void submap_load_manager::flush_prev_desired()
     lazy_omt_budget_credit_ = 0.0;
     lazy_omt_last_credit_turn_ = -1;
     dirty_omts_.clear();
+    simulated_since_save_.clear();
+}
+
+auto submap_load_manager::on_maps_saved() -> void
+{
+    static constexpr auto offsets = std::array {
+        point_rel_sm::zero(), point_rel_sm::east(), point_rel_sm::south(), point_rel_sm::south_east()
+    };
+    std::erase_if( simulated_since_save_, [this]( const omt_column_key & key ) {
+        const auto base = project_to<coords::sm>( key.second );
+        return std::ranges::none_of( offsets, [&]( const point_rel_sm & off ) {
+            return is_in_simulated_set( key.first, base + off );
+        } );
+    } );
 }
 
 void submap_load_manager::add_listener( submap_load_listener *listener )
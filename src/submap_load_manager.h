@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
+#include <deque>
 #include <list>
 #include <map>
 #include <memory>
@@ -15,6 +17,7 @@
 
 #include <future>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "mapgen_functions.h"
 #include "point.h"
@@ -71,8 +74,55 @@ enum class load_request_source : int {
     fire_spread,     ///< Fire-spread loader keeping adjacent submaps resident
     lazy_border,     ///< Kept in memory around the bubble but not simulated
     portal_preload,  ///< portal_tile keeping its target area resident
+    prefetch,        ///< Speculative area ahead of a moving player; resident only
 };
 
+inline constexpr auto num_load_request_sources = std::size_t{ 7 };
+
+/** Short name of @p source for reports. */
+auto load_request_source_name( load_request_source source ) -> const char *;
+
+/**
+ * Is a request from @p source kept resident without being simulated?
+ *
+ * Resident-only requests are loaded in the background through the lazy OMT
+ * queue and never fire listener notifications.
+ */
+constexpr auto is_resident_only_source( const load_request_source source ) -> bool
+{
+    return source == load_request_source::lazy_border || source == load_request_source::prefetch;
+}
+
+/**
+ * Submaps moved in and out of memory by the load manager, in submaps.
+ *
+ * Loads and generations are charged to the request that wanted them; a column wanted by
+ * several requests is charged to the one that simulates it, the earliest source first.
+ */
+struct submap_churn_counts {
+    using per_source = std::array<std::uint64_t, num_load_request_sources>;
+
+    /** Read from disk or the pending-write cache. */
+    per_source loaded{};
+    /** Newly generated by mapgen. */
+    per_source generated{};
+    /** Retained columns that were wanted again before they were evicted. */
+    per_source resurrected{};
+    /** Dropped from memory after leaving every request and the retention cache. */
+    std::uint64_t evicted = 0;
+    /**
+     * Columns loaded again within submap_load_manager::thrash_window of being evicted.
+     * Counted in OMT columns, once per reload.
+     */
+    std::uint64_t thrashed = 0;
+
+    auto operator+=( const submap_churn_counts &rhs ) -> submap_churn_counts &;
+};
+
+/** @p churn as a table for the debug menu. */
+auto describe_churn( const submap_churn_counts &last_turn,
+                     const submap_churn_counts &total ) -> std::string;
+
 /** Opaque handle returned by request_load(); used to update or release. */
 using load_request_handle = uint64_t;
 
@@ -86,6 +136,19 @@ struct submap_load_request {
     auto operator==( const submap_load_request &rhs ) const -> bool = default;
 };
 
+/**
+ * Bounds of a prefetch request for a bubble spanning [@p bubble_begin, @p bubble_end)
+ * that is moving @p lookahead submaps along @p heading.
+ *
+ * The result is the bounding box of the bubble and the bubble shifted ahead, so
+ * the strip the bubble will sweep through is covered for cardinal and diagonal
+ * headings alike.  Columns already inside the bubble are simulated and are not
+ * queued again.  Returns nullopt when there is nothing to prefetch.
+ */
+auto prefetch_bounds_ahead( const point_abs_sm &bubble_begin, const point_abs_sm &bubble_end,
+                            const point &heading, int lookahead )
+-> std::optional<std::pair<point_abs_sm, point_abs_sm>>;
+
 /**
  * Tracks which submaps should be resident in memory across all dimensions.
  *
@@ -151,6 +214,17 @@ class submap_load_manager
         /** True when a later GPU in-flight window has lazy-border resident work to drain. */
         auto has_deferred_lazy_border_work() const noexcept -> bool;
 
+        /**
+         * Coarsely catch up resident lazy-border submaps, which are otherwise frozen until
+         * they enter the simulated set.  Every lazy_border_sim_interval turns the border is
+         * queued, then worked through within a small per-turn time budget.  Each submap gets
+         * the same closed-form catch-up it would get on actualization: fields decay, items
+         * rot, plants grow.  Fire needs real simulation and is left alone.
+         *
+         * Call site: game::do_turn(), after update()
+         */
+        auto process_lazy_border_simulation() -> void;
+
         /** Update the player position used to budget lazy-border preloading. */
         auto update_lazy_border_focus( const dimension_id &dim_id,
                                        const tripoint_abs_ms &pos ) -> void;
@@ -191,9 +265,9 @@ class submap_load_manager
 
         /**
          * Return true if @p pos in @p dim_id is covered by any active load
-         * request whose source is NOT lazy_border.
+         * request whose source is not resident-only (see is_resident_only_source()).
          *
-         * Positions that are only in the desired set via a lazy_border request
+         * Positions that are only in the desired set via a resident-only request
          * are kept resident in memory but are not actively simulated (fields,
          * fire, NPCs, etc.).  Use this to gate per-turn processing in
          * world_tick() and similar loops.
@@ -237,6 +311,18 @@ class submap_load_manager
          */
         auto simulated_submaps( const dimension_id &dim_id ) const -> std::span<const point_abs_sm>;
 
+        /**
+         * Return true if the OMT column at @p omt_xy has been in the simulated
+         * zone since the last on_maps_saved().  Game logic there may change
+         * submaps without bumping their modification generation, so
+         * mapbuffer::save() always writes such columns.
+         */
+        auto simulated_since_save( const dimension_id &dim_id, const point_abs_omt &omt_xy ) const -> bool {
+            return simulated_since_save_.contains( { dim_id, omt_xy } );
+        }
+        /** Forget columns that left the simulated zone before the save that just finished. */
+        auto on_maps_saved() -> void;
+
         /**
          * Return the set of dimension IDs that have at least one active request.
          */
@@ -272,6 +358,29 @@ class submap_load_manager
          */
         auto is_fully_drained() const noexcept -> bool;
 
+        /** An evicted column loaded again this soon counts as thrashing. */
+        static constexpr auto thrash_window = 10_minutes;
+        /** How often resident submap memory is measured against map_memory_budget_mb. */
+        static constexpr auto memory_budget_interval = 1_minutes;
+
+        /** Churn during the last complete turn. */
+        auto last_turn_churn() const -> submap_churn_counts;
+        /** Churn since the game started or reset_churn(), the current turn included. */
+        auto total_churn() const -> submap_churn_counts;
+        void reset_churn();
+
+        /**
+         * The request keeping @p pos in @p dim_id loaded, for the overmap residency
+         * overlay.  Requests that simulate win over resident-only ones, then the
+         * earliest source.  Returns nullopt when no request covers @p pos.
+         */
+        auto covering_source( const dimension_id &dim_id,
+                              const point_abs_sm &pos ) const -> std::optional<load_request_source>;
+        /** True if the column at @p omt_xy is only resident because it was left recently. */
+        auto is_retained( const dimension_id &dim_id, const point_abs_omt &omt_xy ) const -> bool {
+            return retained_omt_index_.contains( { dim_id, omt_xy } );
+        }
+
         /** Register a listener to receive load/unload notifications. */
         void add_listener( submap_load_listener *listener );
 
@@ -298,7 +407,12 @@ class submap_load_manager
         using key_set = std::unordered_set<desired_key, coord_pair_hash<point_abs_sm>>;
         using horizontal_omt_set = std::unordered_set<omt_column_key,
               coord_pair_hash<point_abs_omt>>;
-        using retained_omt_list = std::list<omt_column_key>;
+        /** A retained column and the request that last covered it, for budget eviction order. */
+        struct retained_omt {
+            omt_column_key key;
+            load_request_source source;
+        };
+        using retained_omt_list = std::list<retained_omt>;
         using lazy_omt_job_list = std::list<omt_key>;
         struct lazy_omt_focus {
             dimension_id dim_id;
@@ -306,6 +420,7 @@ class submap_load_manager
         };
         struct lazy_omt_load_result {
             bool dirty = false;
+            bool loaded = false;
             mapgen_result generation;
 
             auto generated() const -> bool {
@@ -362,12 +477,19 @@ class submap_load_manager
         auto retained_omt_hard_cap() const -> std::size_t;
         auto retained_omt_panic_cap() const -> std::size_t;
         auto retained_omt_base_budget() const -> std::size_t;
-        auto retain_omt( const omt_column_key &key ) -> void;
+        auto retain_omt( const omt_column_key &key, load_request_source source ) -> void;
         auto erase_retained_omt( const omt_column_key &key ) -> void;
         auto erase_desired_retained_omts( const key_set &desired ) -> void;
         auto evict_omt_column( const omt_column_key &key ) -> void;
         auto evict_oldest_retained_omts( std::size_t count ) -> void;
         auto process_retained_omt_eviction() -> void;
+        /**
+         * Evict retained columns of every dimension while resident submaps exceed
+         * map_memory_budget_mb, checked at most once per memory_budget_interval.
+         * Columns last kept by resident-only requests go first, then the latest
+         * source; the oldest departure goes first within a source.
+         */
+        auto enforce_memory_budget() -> void;
         auto run_deferred_mapgen_hooks_and_omt_post_passes(
             const horizontal_omt_set &generated_omt_columns ) -> void;
         static auto load_lazy_omt_zlevel_data( mapbuffer &mb,
@@ -382,12 +504,20 @@ class submap_load_manager
         auto finish_lazy_omt_job( const omt_key &key ) -> bool;
         auto reap_lazy_omt_jobs() -> void;
         auto start_lazy_omt_job( const omt_key &key ) -> lazy_omt_start_result;
+        /** True if @p key is only wanted by prefetch requests, not by the lazy border. */
+        auto is_prefetch_only_omt( const omt_column_key &key ) const -> bool;
         auto lazy_omt_priority( const omt_column_key &key ) const -> int;
         auto queue_lazy_border_omts( const horizontal_omt_set &border_omts ) -> void;
         auto has_lazy_border_work_pending() const -> bool;
         auto process_or_defer_lazy_border_work( bool defer_lazy_border_work ) -> void;
         auto process_lazy_border_work() -> void;
         auto process_lazy_border_preload() -> void;
+        /** Churn counters of the current turn, rolled over when the turn changes. */
+        auto churn() -> submap_churn_counts &;
+        auto column_source( const omt_column_key &key ) const -> load_request_source;
+        /** Count a thrash if @p key was evicted within thrash_window. */
+        auto note_column_loaded( const omt_column_key &key ) -> void;
+        auto forget_old_evictions() -> void;
 
         /**
          * Omts that have entered the simulated zone at least once since they
@@ -398,6 +528,8 @@ class submap_load_manager
          * dirty so eviction preserves that data.
          */
         std::unordered_set<omt_column_key, coord_pair_hash<point_abs_omt>> dirty_omts_;
+        /** See simulated_since_save(). */
+        std::unordered_set<omt_column_key, coord_pair_hash<point_abs_omt>> simulated_since_save_;
 
         /** Snapshot of all request bounds from the previous update().
          *  Used to detect steady-state and skip expensive recomputation. */
@@ -405,11 +537,25 @@ class submap_load_manager
 
         std::map<dimension_id, std::vector<point_abs_sm>> simulated_submaps_by_dimension_;
 
+        /** Lazy-border positions still to be caught up this round, worked from the back. */
+        std::vector<desired_key> lazy_sim_queue_;
+        int lazy_sim_last_round_turn_ = -1;
+
         point lazy_omt_preload_direction_ = point_zero;
         std::optional<lazy_omt_focus> lazy_omt_focus_;
         double lazy_omt_budget_credit_ = 0.0;
         int lazy_omt_last_credit_turn_ = -1;
         bool lazy_border_work_deferred_ = false;
+
+        submap_churn_counts churn_this_turn_;
+        submap_churn_counts churn_last_turn_;
+        submap_churn_counts churn_total_;
+        time_point churn_turn_ = time_point::from_turn( 0 );
+        /** Recently evicted columns, oldest first, for the thrash detector. */
+        std::deque<std::pair<omt_column_key, time_point>> recent_evictions_;
+        std::unordered_map<omt_column_key, time_point, coord_pair_hash<point_abs_omt>>
+                recent_eviction_index_;
+        std::optional<time_point> memory_budget_checked_;
 };
 
 extern submap_load_manager submap_loader;
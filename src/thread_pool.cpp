@@ -1,26 +1,169 @@
 #include "thread_pool.h"
 
+#include <array>
 #include <chrono>
+#include <cstring>
 #include <functional>
 #include <thread>
+#include <unordered_map>
+
+#if defined(__linux__)
+#   include <pthread.h>
+#   include <sched.h>
+#elif defined(_WIN32)
+#   include "platform_win.h"
+#endif
 
 #include "crash.h"
 #include "options.h"
+#include "profile.h"
 #include "rng.h"
+#include "string_formatter.h"
 
 thread_local bool tl_is_worker_thread = false;
 
+namespace
+{
+
+/** Pool that owns the calling worker thread, and its slot index in that pool. */
+thread_local const cata_thread_pool *tl_pool = nullptr;
+thread_local int tl_slot = -1;
+
+/** Inline helper nodes kept on the stack by run_range() before spilling to the heap. */
+constexpr int inline_range_nodes = 16;
+
+/** Steal attempts per victim deque that still looks non-empty after a lost race. */
+constexpr int steal_retries = 4;
+
+/** Tasks running on this thread; nested ones are not double-counted as busy time. */
+thread_local int tl_run_depth = 0;
+
+auto now_ns() -> int64_t
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch() ).count();
+}
+
+/** Restricts the calling thread to logical CPU @p cpu, where the platform allows it. */
+void pin_this_thread( const unsigned int cpu )
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO( &set );
+    CPU_SET( cpu % CPU_SETSIZE, &set );
+    pthread_setaffinity_np( pthread_self(), sizeof( set ), &set );
+#elif defined(_WIN32)
+    SetThreadAffinityMask( GetCurrentThread(), DWORD_PTR( 1 ) << ( cpu % ( sizeof( DWORD_PTR ) * 8 ) ) );
+#else
+    static_cast<void>( cpu );
+#endif
+}
+
+struct site_registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<cata_pool_detail::site_stats>> sites;
+};
+
+auto get_site_registry() -> site_registry & // *NOPAD*
+{
+    // Leaked on purpose: workers may still record into it during static destruction.
+    static site_registry *registry = new site_registry();
+    return *registry;
+}
+
+} // namespace
+
 bool is_pool_worker_thread()
 {
     return tl_is_worker_thread;
 }
 
-cata_thread_pool::cata_thread_pool( unsigned int num_workers )
+namespace cata_pool_detail
+{
+
+void site_stats::record( uint64_t latency, uint64_t busy )
+{
+    tasks.fetch_add( 1, std::memory_order_relaxed );
+    latency_ns.fetch_add( latency, std::memory_order_relaxed );
+    busy_ns.fetch_add( busy, std::memory_order_relaxed );
+    uint64_t seen = max_latency_ns.load( std::memory_order_relaxed );
+    while( latency > seen &&
+           !max_latency_ns.compare_exchange_weak( seen, latency, std::memory_order_relaxed ) ) {}
+}
+
+site_stats *find_site( const char *label )
+{
+    label = label != nullptr ? label : "unlabelled";
+    // Labels are string literals, so the pointer is a good cache key.  Equal
+    // labels from different translation units still share one bucket.
+    thread_local std::unordered_map<const char *, site_stats *> cache;
+    if( const auto it = cache.find( label ); it != cache.end() ) {
+        return it->second;
+    }
+    site_registry &registry = get_site_registry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    site_stats *found = nullptr;
+    for( const std::unique_ptr<site_stats> &site : registry.sites ) {
+        if( std::strcmp( site->label, label ) == 0 ) {
+            found = site.get();
+            break;
+        }
+    }
+    if( found == nullptr ) {
+        registry.sites.push_back( std::make_unique<site_stats>() );
+        found = registry.sites.back().get();
+        found->label = label;
+    }
+    cache.emplace( label, found );
+    return found;
+}
+
+void range_job::drain()
+{
+    while( true ) {
+        const int chunk = next_chunk.fetch_add( 1, std::memory_order_relaxed );
+        if( chunk >= num_chunks ) {
+            return;
+        }
+        const int chunk_begin = begin + chunk * chunk_size;
+        const int chunk_end = std::min( chunk_begin + chunk_size, end );
+        try {
+            for( int i = chunk_begin; i < chunk_end; ++i ) {
+                body( ctx, i );
+            }
+        } catch( ... ) {
+            std::lock_guard<std::mutex> lock( ex_mutex );
+            if( !first_ex ) {
+                first_ex = std::current_exception();
+            }
+        }
+    }
+}
+
+void range_node::run( task_node *self )
+{
+    range_job &job = *static_cast<range_node *>( self )->job;
+    job.drain();
+    job.helpers_done->count_down();
+}
+
+} // namespace cata_pool_detail
+
+cata_thread_pool::cata_thread_pool( unsigned int num_workers, const thread_pool_options options )
+    : num_workers_( num_workers )
+    , background_limit_( options.background_workers > 0 ?
+                         std::min( options.background_workers, num_workers ) : num_workers )
+    , pin_workers_( options.pin_workers )
+    , owner_thread_( std::this_thread::get_id() )
 {
+    slots_.reserve( num_workers + 1 );
+    for( unsigned int i = 0; i < num_workers + 1; ++i ) {
+        slots_.push_back( std::make_unique<worker_slot>() );
+    }
     workers_.reserve( num_workers );
     for( unsigned int i = 0; i < num_workers; ++i ) {
-        workers_.emplace_back( [this]() {
-            worker_loop();
+        workers_.emplace_back( [this, i]() {
+            worker_loop( static_cast<int>( i ) );
         } );
     }
 }
@@ -28,8 +171,8 @@ cata_thread_pool::cata_thread_pool( unsigned int num_workers )
 cata_thread_pool::~cata_thread_pool()
 {
     {
-        std::lock_guard<std::mutex> lock( mutex_ );
-        stop_ = true;
+        std::lock_guard<std::mutex> lock( sleep_mutex_ );
+        stop_.store( true );
     }
     cv_.notify_all();
     for( std::thread &worker : workers_ ) {
@@ -37,9 +180,248 @@ cata_thread_pool::~cata_thread_pool()
     }
 }
 
-void cata_thread_pool::worker_loop()
+size_t cata_thread_pool::queue_size() const
+{
+    size_t total = injected_count_.load( std::memory_order_relaxed );
+    for( const std::unique_ptr<worker_slot> &slot : slots_ ) {
+        total += slot->ranges.size_approx() + slot->tasks.size_approx() + slot->background.size_approx();
+    }
+    return total;
+}
+
+int cata_thread_pool::local_slot() const
+{
+    if( tl_pool == this ) {
+        return tl_slot;
+    }
+    if( std::this_thread::get_id() == owner_thread_ ) {
+        return static_cast<int>( num_workers_ );
+    }
+    return -1;
+}
+
+void cata_thread_pool::enqueue( cata_pool_detail::task_node *node, queue_kind kind,
+                                int wake_count )
+{
+    const int self = local_slot();
+    node->enqueued_ns = now_ns();
+    bool pushed = false;
+    if( self >= 0 ) {
+        pushed = local_queue( *slots_[self], kind ).push( node );
+    }
+    if( !pushed ) {
+        std::lock_guard<std::mutex> lock( inject_mutex_ );
+        injected_queue( kind ).push_back( node );
+        injected_count_.fetch_add( 1, std::memory_order_relaxed );
+    }
+    if( wake_count > 0 ) {
+        wake( wake_count );
+    }
+}
+
+void cata_thread_pool::wake( int count )
+{
+    epoch_.fetch_add( 1 );
+    if( sleepers_.load() > 0 ) {
+        std::lock_guard<std::mutex> lock( sleep_mutex_ );
+        if( count > 1 ) {
+            cv_.notify_all();
+        } else {
+            cv_.notify_one();
+        }
+    }
+}
+
+cata_pool_detail::task_node *cata_thread_pool::steal_from_others( int self, queue_kind kind )
+{
+    const int n = static_cast<int>( slots_.size() );
+    // Start just past our own slot so thieves spread over different victims.
+    for( int k = 1; k <= n; ++k ) {
+        const int victim = ( self + k + n ) % n;
+        if( victim == self ) {
+            continue;
+        }
+        auto &deque = local_queue( *slots_[victim], kind );
+        for( int attempt = 0; attempt < steal_retries && deque.size_approx() > 0; ++attempt ) {
+            if( cata_pool_detail::task_node *node = deque.steal() ) {
+                return node;
+            }
+        }
+    }
+    return nullptr;
+}
+
+auto cata_thread_pool::local_queue( worker_slot &slot, const queue_kind kind ) ->
+work_stealing_deque<cata_pool_detail::task_node> &
+{
+    switch( kind ) {
+        case queue_kind::range:
+            return slot.ranges;
+        case queue_kind::task:
+            return slot.tasks;
+        case queue_kind::background:
+            break;
+    }
+    return slot.background;
+}
+
+auto cata_thread_pool::injected_queue( const queue_kind kind ) ->
+std::deque<cata_pool_detail::task_node *> &
+{
+    switch( kind ) {
+        case queue_kind::range:
+            return injected_ranges_;
+        case queue_kind::task:
+            return injected_tasks_;
+        case queue_kind::background:
+            break;
+    }
+    return injected_background_;
+}
+
+cata_pool_detail::task_node *cata_thread_pool::find_task( int self, bool ranges_only,
+        bool &stolen, const bool capped )
+{
+    stolen = false;
+    const queue_kind last = ranges_only ? queue_kind::range : queue_kind::background;
+    // Each class is searched everywhere before the next, so a background task queued on
+    // our own deque doesn't run ahead of interactive work queued elsewhere.
+    for( int k = 0; k <= static_cast<int>( last ); ++k ) {
+        const auto kind = static_cast<queue_kind>( k );
+        if( kind == queue_kind::background && capped && !reserve_background() ) {
+            break;
+        }
+        if( self >= 0 ) {
+            if( cata_pool_detail::task_node *node = local_queue( *slots_[self], kind ).pop() ) {
+                return node;
+            }
+        }
+        if( injected_count_.load( std::memory_order_relaxed ) > 0 ) {
+            std::lock_guard<std::mutex> lock( inject_mutex_ );
+            std::deque<cata_pool_detail::task_node *> &queue = injected_queue( kind );
+            if( !queue.empty() ) {
+                cata_pool_detail::task_node *node = queue.front();
+                queue.pop_front();
+                injected_count_.fetch_sub( 1, std::memory_order_relaxed );
+                return node;
+            }
+        }
+        if( cata_pool_detail::task_node *node = steal_from_others( self, kind ) ) {
+            stolen = true;
+            return node;
+        }
+        if( kind == queue_kind::background && capped ) {
+            release_background();
+        }
+    }
+    return nullptr;
+}
+
+bool cata_thread_pool::reserve_background()
+{
+    unsigned int running = background_running_.load( std::memory_order_relaxed );
+    while( running < background_limit_ ) {
+        if( background_running_.compare_exchange_weak( running, running + 1,
+                std::memory_order_relaxed ) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void cata_thread_pool::release_background()
+{
+    background_running_.fetch_sub( 1, std::memory_order_relaxed );
+}
+
+void cata_thread_pool::run_node( cata_pool_detail::task_node *node, int self, bool stolen )
+{
+    // Owned tasks delete themselves, so read the node before running it.
+    cata_pool_detail::site_stats *site = node->site;
+    const int64_t start = now_ns();
+    const int64_t latency = std::max<int64_t>( 0, start - node->enqueued_ns );
+    ++tl_run_depth;
+    node->invoke( node );
+    --tl_run_depth;
+    const auto busy = static_cast<uint64_t>( now_ns() - start );
+    if( site != nullptr ) {
+        site->record( static_cast<uint64_t>( latency ), busy );
+    }
+    if( self >= 0 ) {
+        worker_slot &slot = *slots_[self];
+        slot.tasks_run.fetch_add( 1, std::memory_order_relaxed );
+        if( stolen ) {
+            slot.tasks_stolen.fetch_add( 1, std::memory_order_relaxed );
+        }
+        if( tl_run_depth == 0 ) {
+            slot.busy_ns.fetch_add( busy, std::memory_order_relaxed );
+        }
+    }
+}
+
+bool cata_thread_pool::try_run_one()
+{
+    const int self = local_slot();
+    bool stolen = false;
+    cata_pool_detail::task_node *node = find_task( self, false, stolen );
+    if( node == nullptr ) {
+        return false;
+    }
+    run_node( node, self, stolen );
+    return true;
+}
+
+void cata_thread_pool::run_range( cata_pool_detail::range_job &job )
+{
+    const int helpers = std::min( job.num_chunks, static_cast<int>( num_workers_ ) + 1 ) - 1;
+    std::array<cata_pool_detail::range_node, inline_range_nodes> inline_nodes;
+    std::unique_ptr<cata_pool_detail::range_node[]> spilled_nodes;
+    cata_pool_detail::range_node *nodes = inline_nodes.data();
+    if( helpers > inline_range_nodes ) {
+        spilled_nodes = std::make_unique<cata_pool_detail::range_node[]>( helpers );
+        nodes = spilled_nodes.get();
+    }
+
+    std::latch helpers_done( helpers );
+    job.helpers_done = &helpers_done;
+    for( int i = 0; i < helpers; ++i ) {
+        nodes[i].job = &job;
+        nodes[i].site = job.site;
+        enqueue( &nodes[i], queue_kind::range, 0 );
+    }
+    if( helpers > 0 ) {
+        wake( helpers );
+    }
+
+    job.drain();
+
+    // Every helper node points into this stack frame, so all of them must have
+    // run (even if they find no chunks left) before returning.  Our own unclaimed
+    // helpers sit at the bottom of our deque and are popped first.
+    const int self = local_slot();
+    while( !helpers_done.try_wait() ) {
+        bool stolen = false;
+        if( cata_pool_detail::task_node *node = find_task( self, true, stolen ) ) {
+            run_node( node, self, stolen );
+        } else {
+            helpers_done.wait();
+        }
+    }
+
+    if( job.first_ex ) {
+        std::rethrow_exception( job.first_ex );
+    }
+}
+
+void cata_thread_pool::worker_loop( int index )
 {
     tl_is_worker_thread = true;
+    tl_pool = this;
+    tl_slot = index;
+    if( pin_workers_ ) {
+        const unsigned int cpus = std::max( std::thread::hardware_concurrency(), 1u );
+        pin_this_thread( ( static_cast<unsigned int>( index ) + 1 ) % cpus );
+    }
     // Windows installs signal handlers per-thread for hardware exception signals
     // (SIGSEGV, SIGFPE, SIGILL).  Re-run the crash handler setup so that crashes
     // on worker threads are caught and logged the same way as main-thread crashes.
@@ -56,52 +438,166 @@ void cata_thread_pool::worker_loop()
     rng_set_worker_seed( seed );
 
     while( true ) {
-        std::function<void()> task;
+        // Read the epoch before searching: any push that lands after the search
+        // bumps it, so the wait below cannot miss that work.
+        const uint64_t seen = epoch_.load();
+        bool stolen = false;
+        if( cata_pool_detail::task_node *node = find_task( index, false, stolen, true ) ) {
+            const bool background = node->background;
+            run_node( node, index, stolen );
+            if( background ) {
+                release_background();
+                // A worker may have gone to sleep with background work left over the cap
+                if( queue_size() > 0 ) {
+                    wake( 1 );
+                }
+            }
+            continue;
+        }
+        if( stop_.load() ) {
+            return;
+        }
+        const int64_t idle_start = now_ns();
         {
-            std::unique_lock<std::mutex> lock( mutex_ );
-            cv_.wait( lock, [this]() {
-                return stop_ || !queue_.empty();
+            std::unique_lock<std::mutex> lock( sleep_mutex_ );
+            sleepers_.fetch_add( 1 );
+            cv_.wait( lock, [this, seen]() {
+                return stop_.load() || epoch_.load() != seen;
             } );
-            if( stop_ && queue_.empty() ) {
-                return;
-            }
-            task = std::move( queue_.front() );
-            queue_.pop_front();
+            sleepers_.fetch_sub( 1 );
         }
-        task();
+        slots_[index]->idle_ns.fetch_add( static_cast<uint64_t>( now_ns() - idle_start ),
+                                          std::memory_order_relaxed );
     }
 }
 
-void cata_thread_pool::submit( std::function<void()> task )
+thread_pool_stats cata_thread_pool::stats() const
 {
-    {
-        std::lock_guard<std::mutex> lock( mutex_ );
-        queue_.push_back( std::move( task ) );
+    thread_pool_stats out;
+    out.queue_depth = queue_size();
+    for( const std::unique_ptr<worker_slot> &slot : slots_ ) {
+        out.workers.push_back( {
+            .tasks_run = slot->tasks_run.load( std::memory_order_relaxed ),
+            .tasks_stolen = slot->tasks_stolen.load( std::memory_order_relaxed ),
+            .busy = std::chrono::nanoseconds( slot->busy_ns.load( std::memory_order_relaxed ) ),
+            .idle = std::chrono::nanoseconds( slot->idle_ns.load( std::memory_order_relaxed ) ),
+        } );
     }
-    cv_.notify_one();
+    site_registry &registry = get_site_registry();
+    std::lock_guard<std::mutex> lock( registry.mutex );
+    for( const std::unique_ptr<cata_pool_detail::site_stats> &site : registry.sites ) {
+        out.sites.push_back( {
+            .label = site->label,
+            .tasks = site->tasks.load( std::memory_order_relaxed ),
+            .total_latency = std::chrono::nanoseconds( site->latency_ns.load( std::memory_order_relaxed ) ),
+            .max_latency = std::chrono::nanoseconds( site->max_latency_ns.load( std::memory_order_relaxed ) ),
+            .busy = std::chrono::nanoseconds( site->busy_ns.load( std::memory_order_relaxed ) ),
+        } );
+    }
+    return out;
+}
+
+void cata_thread_pool::plot_stats()
+{
+    thread_pool_stats now = stats();
+    TracyPlot( "Pool Queue Depth", static_cast<int64_t>( now.queue_depth ) );
+
+    uint64_t tasks = 0;
+    uint64_t stolen = 0;
+    std::chrono::nanoseconds busy{};
+    std::chrono::nanoseconds idle{};
+    for( size_t i = 0; i < now.workers.size(); ++i ) {
+        const thread_pool_stats::worker prev = i < last_plotted_.workers.size() ?
+                                               last_plotted_.workers[i] : thread_pool_stats::worker{};
+        tasks += now.workers[i].tasks_run - prev.tasks_run;
+        stolen += now.workers[i].tasks_stolen - prev.tasks_stolen;
+        // The owner thread has no idle counter, so only workers feed utilisation.
+        if( i < num_workers_ ) {
+            busy += now.workers[i].busy - prev.busy;
+            idle += now.workers[i].idle - prev.idle;
+        }
+    }
+    TracyPlot( "Pool Tasks Run", static_cast<int64_t>( tasks ) );
+    TracyPlot( "Pool Tasks Stolen", static_cast<int64_t>( stolen ) );
+    const auto total = busy + idle;
+    TracyPlot( "Pool Worker Utilisation %", total.count() > 0 ?
+               100.0 * static_cast<double>( busy.count() ) / static_cast<double>( total.count() ) : 0.0 );
+
+    // Per-label mean start latency over the interval, in microseconds.  Labels are
+    // string literals, so they are stable plot names.
+    for( size_t i = 0; i < now.sites.size(); ++i ) {
+        const thread_pool_stats::site prev = i < last_plotted_.sites.size() ?
+                                             last_plotted_.sites[i] : thread_pool_stats::site{};
+        const uint64_t site_tasks = now.sites[i].tasks - prev.tasks;
+        if( site_tasks > 0 ) {
+            const auto latency = now.sites[i].total_latency - prev.total_latency;
+            TracyPlot( now.sites[i].label,
+                       static_cast<double>( latency.count() ) / 1000.0 / static_cast<double>( site_tasks ) );
+        }
+    }
+    last_plotted_ = std::move( now );
+}
+
+std::string cata_thread_pool::describe_stats() const
+{
+    const thread_pool_stats s = stats();
+    const auto ms = []( std::chrono::nanoseconds ns ) {
+        return static_cast<double>( ns.count() ) / 1e6;
+    };
+    std::string out = string_format( "Thread pool: %d workers (%d for background work), %d queued\n\n",
+                                     static_cast<int>( num_workers_ ), static_cast<int>( background_limit_ ),
+                                     static_cast<int>( s.queue_depth ) );
+    out += string_format( "%-8s %10s %10s %12s %12s %6s\n", "thread", "tasks", "stolen", "busy ms",
+                          "idle ms", "util%" );
+    for( size_t i = 0; i < s.workers.size(); ++i ) {
+        const thread_pool_stats::worker &w = s.workers[i];
+        const auto total = w.busy + w.idle;
+        const std::string name = i < num_workers_ ? string_format( "w%d", static_cast<int>( i ) ) : "main";
+        out += string_format( "%-8s %10llu %10llu %12.1f %12s %6s\n", name,
+                              static_cast<unsigned long long>( w.tasks_run ),
+                              static_cast<unsigned long long>( w.tasks_stolen ), ms( w.busy ),
+                              i < num_workers_ ? string_format( "%.1f", ms( w.idle ) ) : "-",
+                              i < num_workers_ && total.count() > 0 ?
+                              string_format( "%.0f", 100.0 * ms( w.busy ) / ms( total ) ) : "-" );
+    }
+    out += string_format( "\n%-28s %10s %14s %14s %12s\n", "label", "tasks", "avg start us",
+                          "max start us", "busy ms" );
+    for( const thread_pool_stats::site &site : s.sites ) {
+        const double avg_us = site.tasks > 0 ?
+                              static_cast<double>( site.total_latency.count() ) / 1000.0 / static_cast<double>( site.tasks ) : 0.0;
+        out += string_format( "%-28s %10llu %14.1f %14.1f %12.1f\n", site.label,
+                              static_cast<unsigned long long>( site.tasks ), avg_us,
+                              static_cast<double>( site.max_latency.count() ) / 1000.0, ms( site.busy ) );
+    }
+    return out;
 }
 
 cata_thread_pool &get_thread_pool()
 {
-    // Worker count is read once at first call (the static pool is constructed
-    // only once).  Changes to THREAD_POOL_WORKERS or MULTITHREADING_ENABLED
+    // Pool settings are read once at first call (the static pool is constructed
+    // only once).  Changes to the THREAD_POOL_* options or MULTITHREADING_ENABLED
     // require a restart.
-    static cata_thread_pool pool( []() -> unsigned int {
+    static cata_thread_pool pool = []() -> cata_thread_pool {
         // Respect the "disable multi-threading" setting.  This is read via
         // get_option<bool>() directly (not the cached parallel_enabled global)
         // because cache_to_globals() has not yet run at pool-init time.
         if( !get_option<bool>( "MULTITHREADING_ENABLED" ) )
         {
-            return 0u;
+            return cata_thread_pool( 0u );
         }
         const int workers_opt = get_option<int>( "THREAD_POOL_WORKERS" );
-        if( workers_opt > 0 )
-        {
-            return static_cast<unsigned int>( workers_opt );
-        }
         // 0 = auto: hardware_concurrency()-1, leaving one core for the main/SDL thread.
         const unsigned int hc = std::thread::hardware_concurrency();
-        return hc > 1u ? hc - 1u : 0u;
-    }() );
+        const unsigned int workers = workers_opt > 0 ? static_cast<unsigned int>( workers_opt ) :
+                                     hc > 1u ? hc - 1u : 0u;
+        // 0 = auto: all workers but one, so a burst of mapgen can't hold up a whole turn.
+        const int background_opt = get_option<int>( "THREAD_POOL_BACKGROUND_WORKERS" );
+        const unsigned int background = background_opt > 0 ? static_cast<unsigned int>( background_opt ) :
+                                        workers > 1u ? workers - 1u : 0u;
+        return cata_thread_pool( workers, {
+            .background_workers = background,
+            .pin_workers = get_option<bool>( "THREAD_POOL_AFFINITY" ),
+        } );
+    }();
     return pool;
 }
@@ -1,7 +1,10 @@
 #pragma once
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <deque>
 #include <exception>
 #include <functional>
@@ -9,16 +12,43 @@
 #include <latch>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include "work_stealing_deque.h"
+
 /**
  * Persistent thread pool for parallelizing game work.
  *
  * Workers are sized to hardware_concurrency() - 1 so the main thread
- * retains one core for the SDL event loop and game logic.
+ * retains one core for the SDL event loop and game logic, unless the
+ * THREAD_POOL_WORKERS option says otherwise.
+ *
+ * Scheduling:
+ *   Every worker, plus the thread that constructed the pool (the main thread),
+ *   owns a pair of lock-free work-stealing deques: one for parallel_for chunk
+ *   helpers and one for standalone submit() tasks.  Work submitted from a
+ *   thread that owns deques goes to its own deque; idle workers steal from the
+ *   others.  Any other thread, or an owner whose deque is full, falls back to a
+ *   mutex-guarded injection queue.  Tasks are intrusive nodes holding the
+ *   callable inline, so parallel_for dispatch does not allocate.
+ *
+ *   Threads blocked in parallel_for(), parallel_for_chunked() or wait_helping()
+ *   run queued work instead of sleeping.  parallel_for waiters only pick up
+ *   other parallel_for chunks, so the main thread is never stuck behind a long
+ *   mapgen or save task while its own cache build is waiting.
+ *
+ *   Work is taken in priority order: parallel_for chunks, then interactive
+ *   tasks (ones the current turn or a waiting player needs), then background
+ *   tasks such as mapgen, preload and saving.  A running task is never
+ *   interrupted, so the pool also caps how many workers may start background
+ *   tasks at once (THREAD_POOL_BACKGROUND_WORKERS); the rest stay free for
+ *   per-turn work while a burst of mapgen is queued.  Threads already inside a
+ *   task, and the owner thread in wait_helping(), are exempt from the cap so
+ *   tasks waiting on each other can't deadlock.
  *
  * Constraints (must not be violated by submitted work):
  *  - No worker thread may call any Lua API (Lua 5.3 is not reentrant).
@@ -48,66 +78,327 @@
  *     both acquire extras_mutex_ (a per-overmapbuffer std::mutex) after get_om_global() returns.
  *   • Auto-note discovery (auto_note_settings) and Lua spawn hooks in place_npc() are
  *     main-thread-only and are skipped on worker threads via is_pool_worker_thread().
+ *
+ * Telemetry:
+ *   Every thread that owns deques counts tasks run, tasks stolen and busy time;
+ *   workers also count idle time.  Work is attributed to the label passed to
+ *   submit()/parallel_for() (a string literal naming the call site), which
+ *   records enqueue-to-start latency and run time.  plot_stats() exports the
+ *   per-turn deltas as TracyPlot series and describe_stats() feeds the debug menu.
+ */
+class cata_thread_pool;
+
+/** Scheduling class of a submitted task. */
+enum class task_priority : int {
+    /** Needed for the current turn or by a player waiting on it; runs ahead of background work. */
+    interactive,
+    /** Mapgen, preload, saving and other work nothing is waiting on yet. */
+    background,
+};
+
+/** Tuning of a @ref cata_thread_pool beyond its worker count. */
+struct thread_pool_options {
+    /** Workers that may start background tasks at the same time; 0 for all of them. */
+    unsigned int background_workers = 0;
+    /** Pin worker i to logical CPU i + 1, leaving CPU 0 to the main thread.  Linux and Windows only. */
+    bool pin_workers = false;
+};
+
+/** Snapshot of pool telemetry since startup. */
+struct thread_pool_stats {
+    struct worker {
+        uint64_t tasks_run = 0;
+        uint64_t tasks_stolen = 0;
+        std::chrono::nanoseconds busy{};
+        std::chrono::nanoseconds idle{};
+    };
+    struct site {
+        const char *label = nullptr;
+        uint64_t tasks = 0;
+        std::chrono::nanoseconds total_latency{};
+        std::chrono::nanoseconds max_latency{};
+        std::chrono::nanoseconds busy{};
+    };
+    /** One entry per worker, then the owner (main) thread. */
+    std::vector<worker> workers;
+    std::vector<site> sites;
+    size_t queue_depth = 0;
+};
+
+namespace cata_pool_detail
+{
+
+/** Telemetry bucket for one call-site label.  Process lifetime. */
+struct site_stats {
+    const char *label = nullptr;
+    std::atomic<uint64_t> tasks = 0;
+    std::atomic<uint64_t> latency_ns = 0;
+    std::atomic<uint64_t> max_latency_ns = 0;
+    std::atomic<uint64_t> busy_ns = 0;
+
+    void record( uint64_t latency, uint64_t busy );
+};
+
+/** Bucket for @p label, created on first use.  nullptr means "unlabelled". */
+site_stats *find_site( const char *label );
+
+/**
+ * Intrusive, type-erased unit of pool work.
+ *
+ * Nodes are queued by pointer and never copied or moved while queued, so the
+ * callable can live inline next to the node instead of behind a std::function.
+ */
+struct task_node {
+    void ( *invoke )( task_node *self ) = nullptr;
+    site_stats *site = nullptr;
+    /** steady_clock time of enqueue, for start latency. */
+    int64_t enqueued_ns = 0;
+    bool background = false;
+};
+
+/** Heap node owning its callable; deletes itself after running. */
+template<typename F>
+struct owned_task final : task_node {
+    F fn;
+
+    template<typename G>
+    explicit owned_task( G &&g ) : task_node{ &owned_task::run }, fn( std::forward<G>( g ) ) {}
+
+    static void run( task_node *self ) {
+        const auto owned = std::unique_ptr<owned_task>( static_cast<owned_task *>( self ) );
+        owned->fn();
+    }
+};
+
+/**
+ * Shared state of one parallel_for call.
+ *
+ * Lives on the caller's stack.  Helper nodes queued on the pool each claim
+ * chunks from next_chunk until none are left, so idle threads balance the
+ * load without one queue entry per chunk.
  */
+struct range_job {
+    int begin = 0;
+    int end = 0;
+    int chunk_size = 1;
+    int num_chunks = 0;
+    void ( *body )( void *ctx, int index ) = nullptr;
+    void *ctx = nullptr;
+    site_stats *site = nullptr;
+
+    std::atomic<int> next_chunk = 0;
+    std::latch *helpers_done = nullptr;
+    std::mutex ex_mutex;
+    std::exception_ptr first_ex;
+
+    /** Claims and runs chunks until none are left.  Exceptions are recorded, not thrown. */
+    void drain();
+};
+
+struct range_node final : task_node {
+    range_job *job = nullptr;
+
+    range_node() : task_node{ &range_node::run } {}
+
+    static void run( task_node *self );
+};
+
+template<typename F>
+void run_chunks( cata_thread_pool &pool, const char *label, int begin, int end, int chunk_size,
+                 F &f );
+
+} // namespace cata_pool_detail
+
 class cata_thread_pool
 {
     public:
-        explicit cata_thread_pool( unsigned int num_workers );
+        explicit cata_thread_pool( unsigned int num_workers, thread_pool_options options = {} );
         ~cata_thread_pool();
 
         cata_thread_pool( const cata_thread_pool & ) = delete;
         cata_thread_pool &operator=( const cata_thread_pool & ) = delete;
 
         unsigned int num_workers() const {
-            return static_cast<unsigned int>( workers_.size() );
+            return num_workers_;
+        }
+        /** Workers that may run background tasks at the same time. */
+        unsigned int background_workers() const {
+            return background_limit_;
         }
 
-        size_t queue_size() const {
-            std::lock_guard<std::mutex> lk( mutex_ );
-            return queue_.size();
+        /** Approximate number of queued (not yet started) tasks, for diagnostics. */
+        size_t queue_size() const;
+
+        /** Counters since startup. */
+        thread_pool_stats stats() const;
+        /** Plot queue depth, utilisation, throughput and per-label latency since the last call.  Main thread. */
+        void plot_stats();
+        /** Human-readable telemetry table for the debug menu. */
+        std::string describe_stats() const;
+
+        /**
+         * Enqueue a callable for execution on a worker thread.
+         *
+         * The callable is moved into a single heap node; there is no separate
+         * std::function allocation.  With zero workers it runs synchronously.
+         *
+         * @p label names the call site in telemetry; it must be a string literal.
+         * Tasks are background work unless @p priority says otherwise.
+         */
+        template<typename F>
+        void submit( const task_priority priority, const char *label, F &&task ) {
+            if( num_workers() == 0 ) {
+                task();
+                return;
+            }
+            using node_t = cata_pool_detail::owned_task<std::decay_t<F>>;
+            node_t *node = new node_t( std::forward<F>( task ) );
+            node->site = cata_pool_detail::find_site( label );
+            node->background = priority == task_priority::background;
+            enqueue( node, node->background ? queue_kind::background : queue_kind::task );
         }
 
-        /** Enqueue a callable for execution on a worker thread. */
-        void submit( std::function<void()> task );
+        template<typename F>
+        void submit( const char *label, F &&task ) {
+            submit( task_priority::background, label, std::forward<F>( task ) );
+        }
+
+        template<typename F>
+        void submit( F &&task ) {
+            submit( nullptr, std::forward<F>( task ) );
+        }
 
         /**
          * Enqueue a callable that returns a value and get a future for its result.
          *
-         * std::packaged_task is move-only, so it is wrapped in a shared_ptr to satisfy
-         * the copyability requirement of std::function<void()>.
+         * std::packaged_task is move-only; it is wrapped in a shared_ptr so the
+         * submitted callable stays copyable for callers that forward it.
          *
          * Usage:
-         *   std::future<int> f = pool.submit_returning( []() { return 42; } );
-         *   int result = f.get();
+         *   std::future<int> f = pool.submit_returning( "answer", []() { return 42; } );
+         *   int result = f.get();       // or pool.wait_helping( f ) on the main thread
          */
         template<typename F, typename... Args>
-        auto submit_returning( F &&f, Args &&...args )
+        auto submit_returning( const task_priority priority, const char *label, F &&f,
+                               Args &&...args )
         -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
             using R = std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>;
             auto task = std::make_shared<std::packaged_task<R()>>(
                             std::bind( std::forward<F>( f ), std::forward<Args>( args )... )
                         );
             std::future<R> fut = task->get_future();
-            if( num_workers() == 0 ) {
-                // Single-core fallback: execute synchronously on the calling thread
-                // to avoid enqueuing work that would never be processed by a worker.
+            // submit() runs synchronously on single-core machines, so the future
+            // is already satisfied when there are no workers to process it.
+            submit( priority, label, [task]() {
                 ( *task )();
-            } else {
-                submit( [task]() {
-                    ( *task )();
-                } );
-            }
+            } );
             return fut;
         }
 
+        template<typename F, typename... Args>
+        auto submit_returning( const char *label, F &&f, Args &&...args )
+        -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+            return submit_returning( task_priority::background, label, std::forward<F>( f ),
+                                     std::forward<Args>( args )... );
+        }
+
+        template<typename F, typename... Args>
+        auto submit_returning( F &&f, Args &&...args )
+        -> std::future<std::invoke_result_t<std::decay_t<F>, std::decay_t<Args>...>> {
+            return submit_returning( nullptr, std::forward<F>( f ), std::forward<Args>( args )... );
+        }
+
+        /**
+         * Block until @p fut is ready, running queued pool tasks on the calling
+         * thread in the meantime instead of sleeping.
+         */
+        template<typename T>
+        void wait_helping( std::future<T> &fut ) {
+            while( fut.wait_for( std::chrono::seconds( 0 ) ) != std::future_status::ready ) {
+                if( !try_run_one() ) {
+                    fut.wait_for( std::chrono::microseconds( 250 ) );
+                }
+            }
+        }
+
+        /** Run one queued task on the calling thread.  Returns false if none was found. */
+        bool try_run_one();
+
     private:
-        void worker_loop();
+        template<typename F>
+        friend void cata_pool_detail::run_chunks( cata_thread_pool &, const char *, int, int, int,
+                F & );
 
-        std::vector<std::thread> workers_;
-        std::deque<std::function<void()>> queue_;
-        mutable std::mutex mutex_;
+        /** Queues in the order they are searched. */
+        enum class queue_kind : int {
+            range,
+            task,
+            background,
+        };
+
+        struct worker_slot {
+            work_stealing_deque<cata_pool_detail::task_node> ranges;
+            work_stealing_deque<cata_pool_detail::task_node> tasks;
+            work_stealing_deque<cata_pool_detail::task_node> background;
+            // Written only by the owning thread; read by stats().
+            std::atomic<uint64_t> tasks_run = 0;
+            std::atomic<uint64_t> tasks_stolen = 0;
+            std::atomic<uint64_t> busy_ns = 0;
+            std::atomic<uint64_t> idle_ns = 0;
+        };
+
+        static auto local_queue( worker_slot &slot, queue_kind kind ) ->
+        work_stealing_deque<cata_pool_detail::task_node> &;
+        auto injected_queue( queue_kind kind ) -> std::deque<cata_pool_detail::task_node *> &;
+
+        /** Run @p job on the calling thread plus as many helpers as there are chunks. */
+        void run_range( cata_pool_detail::range_job &job );
+
+        /** Deque slot owned by the calling thread, or -1 if it owns none. */
+        int local_slot() const;
+        /** Queue @p node on the caller's own deque when it has one, then wake @p wake_count sleepers. */
+        void enqueue( cata_pool_detail::task_node *node, queue_kind kind, int wake_count = 1 );
+        /**
+         * @p ranges_only restricts the search to parallel_for chunk helpers.  With
+         * @p capped, background tasks are only taken while under the background cap,
+         * and one taken holds a place under it until release_background().
+         */
+        cata_pool_detail::task_node *find_task( int self, bool ranges_only, bool &stolen,
+                                                bool capped = false );
+        /** Takes a place under the background cap, if one is free. */
+        bool reserve_background();
+        void release_background();
+        /** Run @p node on the calling thread, charging it to slot @p self and the node's label. */
+        void run_node( cata_pool_detail::task_node *node, int self, bool stolen );
+        cata_pool_detail::task_node *steal_from_others( int self, queue_kind kind );
+        void wake( int count );
+        void worker_loop( int index );
+
+        const unsigned int num_workers_;
+        const unsigned int background_limit_;
+        const bool pin_workers_;
+        const std::thread::id owner_thread_;
+        /** One slot per worker, then one for the owner thread. */
+        std::vector<std::unique_ptr<worker_slot>> slots_;
+
+        mutable std::mutex inject_mutex_;
+        std::deque<cata_pool_detail::task_node *> injected_ranges_;
+        std::deque<cata_pool_detail::task_node *> injected_tasks_;
+        std::deque<cata_pool_detail::task_node *> injected_background_;
+        std::atomic<size_t> injected_count_ = 0;
+        /** Background tasks started by idle workers and still running. */
+        std::atomic<unsigned int> background_running_ = 0;
+
+        std::mutex sleep_mutex_;
         std::condition_variable cv_;
-        bool stop_ = false;
+        std::atomic<uint64_t> epoch_ = 0;
+        std::atomic<int> sleepers_ = 0;
+        std::atomic<bool> stop_ = false;
+
+        std::vector<std::thread> workers_;
+
+        /** Totals at the previous plot_stats() call. */
+        thread_pool_stats last_plotted_;
 };
 
 /** Returns the process-lifetime thread pool (lazy-initialized, thread-safe). */
@@ -121,20 +412,48 @@ cata_thread_pool &get_thread_pool();
  */
 bool is_pool_worker_thread();
 
+namespace cata_pool_detail
+{
+
+template<typename F>
+void run_chunks( cata_thread_pool &pool, const char *label, int begin, int end, int chunk_size,
+                 F &f )
+{
+    using fn_t = std::remove_reference_t<F>;
+    range_job job;
+    job.site = find_site( label );
+    job.begin = begin;
+    job.end = end;
+    job.chunk_size = chunk_size;
+    job.num_chunks = ( end - begin + chunk_size - 1 ) / chunk_size;
+    job.body = []( void *ctx, int index ) {
+        ( *static_cast<fn_t *>( ctx ) )( index );
+    };
+    job.ctx = const_cast<void *>( static_cast<const void *>( std::addressof( f ) ) );
+    pool.run_range( job );
+}
+
+} // namespace cata_pool_detail
+
 /**
  * Submit a range of work items and block until all complete.
  *
- * Divides [begin, end) into up to num_workers sub-ranges and dispatches each
- * to a worker thread, then blocks until all workers have returned.
+ * Divides [begin, end) into up to num_workers + 1 sub-ranges.  The calling
+ * thread works on the range too, and keeps running other parallel_for chunks
+ * until every helper it queued has finished.
  *
  * Falls through to a direct serial loop when:
  *   - n <= 1 (trivial range, avoid dispatch overhead), or
  *   - num_workers == 0 (single-core machine).
  *
+ * The first exception thrown by F is rethrown on the calling thread.
+ *
+ * @p label names the call site in pool telemetry; it must be a string literal.
+ *
  * F must be callable as  void F(int index)
  */
 template<typename F>
-void parallel_for( int begin, int end, F &&f )
+void parallel_for( const char *label, int begin, int end, F &&f )
 {
     const int n = end - begin;
     if( n <= 0 ) {
@@ -158,46 +477,28 @@ void parallel_for( int begin, int end, F &&f )
         return;
     }
 
-    const int chunks = std::min( n, nw );
-    std::latch latch( chunks );
-    std::exception_ptr first_ex;
-    std::mutex         ex_mutex;
-
-    for( int c = 0; c < chunks; ++c ) {
-        const int chunk_begin = begin + ( n * c / chunks );
-        const int chunk_end   = begin + ( n * ( c + 1 ) / chunks );
-        pool.submit( [&latch, &f, &first_ex, &ex_mutex, chunk_begin, chunk_end]() {
-            try {
-                for( int i = chunk_begin; i < chunk_end; ++i ) {
-                    f( i );
-                }
-            } catch( ... ) {
-                std::lock_guard<std::mutex> lock( ex_mutex );
-                if( !first_ex ) {
-                    first_ex = std::current_exception();
-                }
-            }
-            latch.count_down();
-        } );
-    }
+    const int chunks = std::min( n, nw + 1 );
+    cata_pool_detail::run_chunks( pool, label, begin, end, ( n + chunks - 1 ) / chunks, f );
+}
 
-    latch.wait();
-    if( first_ex ) {
-        std::rethrow_exception( first_ex );
-    }
+template<typename F>
+void parallel_for( int begin, int end, F &&f )
+{
+    parallel_for( nullptr, begin, end, std::forward<F>( f ) );
 }
 
 /**
- * Like parallel_for, but dispatches one task per chunk_size indices rather
- * than dividing the range evenly by number of workers.  Useful when the
- * natural work unit has a known, fixed size.
+ * Like parallel_for, but splits the range into chunks of chunk_size indices
+ * rather than dividing it evenly by number of workers.  Useful when the
+ * natural work unit has a known, fixed size.  Idle threads claim the next
+ * chunk dynamically, so uneven chunk costs balance out.
  *
  * Falls through to a serial loop when nw == 0 or num_chunks <= 1.
  *
  * F must be callable as  void F(int index)
  */
 template<typename F>
-void parallel_for_chunked( int begin, int end, int chunk_size, F &&f )
+void parallel_for_chunked( const char *label, int begin, int end, int chunk_size, F &&f )
 {
     if( end <= begin || chunk_size <= 0 ) {
         return;
@@ -216,30 +517,11 @@ void parallel_for_chunked( int begin, int end, int chunk_size, F &&f )
         return;
     }
 
-    std::latch latch( num_chunks );
-    std::exception_ptr first_ex;
-    std::mutex         ex_mutex;
-
-    for( int c = 0; c < num_chunks; ++c ) {
-        const int chunk_begin = begin + c * chunk_size;
-        const int chunk_end   = std::min( chunk_begin + chunk_size, end );
-        pool.submit( [&latch, &f, &first_ex, &ex_mutex, chunk_begin, chunk_end]() {
-            try {
-                for( int i = chunk_begin; i < chunk_end; ++i ) {
-                    f( i );
-                }
-            } catch( ... ) {
-                std::lock_guard<std::mutex> lock( ex_mutex );
-                if( !first_ex ) {
-                    first_ex = std::current_exception();
-                }
-            }
-            latch.count_down();
-        } );
-    }
+    cata_pool_detail::run_chunks( pool, label, begin, end, chunk_size, f );
+}
 
-    latch.wait();
-    if( first_ex ) {
-        std::rethrow_exception( first_ex );
-    }
+template<typename F>
+void parallel_for_chunked( int begin, int end, int chunk_size, F &&f )
+{
+    parallel_for_chunked( nullptr, begin, end, chunk_size, std::forward<F>( f ) );
 }
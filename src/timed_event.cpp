@@ -253,6 +253,21 @@ void timed_event::actualize()
     }
 }
 
+/** Does timed_event::per_turn() do anything for @p type?  Keep the two in sync. */
+static auto has_per_turn_effect( const timed_event_type type ) -> bool
+{
+    switch( type ) {
+        case TIMED_EVENT_WANTED:
+        case TIMED_EVENT_SPAWN_WYRMS:
+        case TIMED_EVENT_AMIGARA:
+        case AMIGARA_WHISPERS:
+        case TIMED_EVENT_TEMPLE_OPEN:
+            return true;
+        default:
+            return false;
+    }
+}
+
 void timed_event::per_turn()
 {
     switch( type ) {
@@ -319,31 +334,102 @@ void timed_event::per_turn()
     }
 }
 
+namespace
+{
+
+// Orders the heap so the earliest event is on top, the first added among equal times
+auto later( const time_point &lhs_when, const timed_event_handle lhs_handle,
+            const time_point &rhs_when, const timed_event_handle rhs_handle ) -> bool
+{
+    return lhs_when != rhs_when ? rhs_when < lhs_when : rhs_handle < lhs_handle;
+}
+
+} // namespace
+
+void timed_event_manager::push( const queue_entry &entry )
+{
+    queue.push_back( entry );
+    std::ranges::push_heap( queue, []( const queue_entry & lhs, const queue_entry & rhs ) {
+        return later( lhs.when, lhs.handle, rhs.when, rhs.handle );
+    } );
+}
+
+void timed_event_manager::drop_stale_queue_top()
+{
+    while( !queue.empty() ) {
+        const auto it = events.find( queue.front().handle );
+        if( it != events.end() && it->second.when == queue.front().when ) {
+            return;
+        }
+        std::ranges::pop_heap( queue, []( const queue_entry & lhs, const queue_entry & rhs ) {
+            return later( lhs.when, lhs.handle, rhs.when, rhs.handle );
+        } );
+        queue.pop_back();
+    }
+}
+
+void timed_event_manager::erase( const timed_event_handle handle )
+{
+    events.erase( handle );
+    // Handles are added in increasing order, so the list stays sorted
+    const auto it = std::ranges::lower_bound( per_turn_events, handle );
+    if( it != per_turn_events.end() && *it == handle ) {
+        per_turn_events.erase( it );
+    }
+}
+
 void timed_event_manager::process()
 {
     ZoneScoped;
-    for( auto it = events.begin(); it != events.end(); ) {
-        it->per_turn();
-        if( it->when <= calendar::turn ) {
-            it->actualize();
-            it = events.erase( it );
-        } else {
-            it++;
+    // per_turn() may move an event's time, so queue it again at the new time
+    for( std::size_t i = 0; i < per_turn_events.size(); ++i ) {
+        const auto handle = per_turn_events[i];
+        timed_event &e = events.at( handle );
+        const auto when = e.when;
+        e.per_turn();
+        if( e.when != when ) {
+            push( { e.when, handle } );
         }
     }
+
+    // actualize() may add events, even ones already due, so check the top again each time
+    for( drop_stale_queue_top(); !queue.empty() && queue.front().when <= calendar::turn;
+         drop_stale_queue_top() ) {
+        const auto handle = queue.front().handle;
+        auto e = std::move( events.at( handle ) );
+        erase( handle );
+        e.actualize();
+    }
 }
 
-void timed_event_manager::add( const timed_event_type type, const time_point &when,
-                               const int faction_id )
+auto timed_event_manager::add( const timed_event_type type, const time_point &when,
+                               const int faction_id ) -> timed_event_handle
 {
-    add( type, when, faction_id, g->u.abs_sm_pos() );
+    return add( type, when, faction_id, g->u.abs_sm_pos() );
 }
 
-void timed_event_manager::add( const timed_event_type type, const time_point &when,
+auto timed_event_manager::add( const timed_event_type type, const time_point &when,
                                const int faction_id,
-                               const tripoint_abs_sm &where )
+                               const tripoint_abs_sm &where ) -> timed_event_handle
 {
-    events.emplace_back( type, when, faction_id, where );
+    const auto handle = next_handle++;
+    events.emplace( handle, timed_event( type, when, faction_id, where ) );
+    if( has_per_turn_effect( type ) ) {
+        per_turn_events.push_back( handle );
+    }
+    push( { when, handle } );
+    drop_stale_queue_top();
+    return handle;
+}
+
+bool timed_event_manager::cancel( const timed_event_handle handle )
+{
+    if( !events.contains( handle ) ) {
+        return false;
+    }
+    erase( handle );
+    drop_stale_queue_top();
+    return true;
 }
 
 bool timed_event_manager::queued( const timed_event_type type ) const
@@ -353,20 +439,16 @@ bool timed_event_manager::queued( const timed_event_type type ) const
 
 auto timed_event_manager::next_event_time() const -> std::optional<time_point>
 {
-    if( events.empty() ) {
+    // The top is never stale: every change that could make it so drops it right away
+    if( queue.empty() ) {
         return std::nullopt;
     }
-
-    auto next_time = events.front().when;
-    for( const timed_event &event : events ) {
-        next_time = std::min( next_time, event.when );
-    }
-    return next_time;
+    return queue.front().when;
 }
 
 timed_event *timed_event_manager::get( const timed_event_type type )
 {
-    for( auto &e : events ) {
+    for( auto &[handle, e] : events ) {
         if( e.type == type ) {
             return &e;
         }
@@ -1,7 +1,9 @@
 #pragma once
 
-#include <list>
+#include <cstdint>
+#include <map>
 #include <optional>
+#include <vector>
 
 #include "coordinates.h"
 #include "calendar.h"
@@ -40,28 +42,62 @@ struct timed_event {
     void per_turn();
 };
 
+/** Identifies a queued event for @ref timed_event_manager::cancel. */
+using timed_event_handle = std::uint64_t;
+
+/**
+ * Events queued by time.  The next due event is the top of a min-heap, so finding it is
+ * O(1) and queueing or cancelling one is O(log n).  Only the events of types that do
+ * something every turn are visited every turn.
+ */
 class timed_event_manager
 {
     private:
-        std::list<timed_event> events;
+        struct queue_entry {
+            time_point when;
+            timed_event_handle handle;
+        };
+
+        /** By handle, so in the order they were added. */
+        std::map<timed_event_handle, timed_event> events;
+        /**
+         * Min-heap on time.  Entries for cancelled events, or for times an event's
+         * per_turn() has since moved, are dropped once they reach the top.
+         */
+        std::vector<queue_entry> queue;
+        /** Events whose type has a per-turn effect, in the order they were added. */
+        std::vector<timed_event_handle> per_turn_events;
+        timed_event_handle next_handle = 1;
+
+        void push( const queue_entry &entry );
+        void drop_stale_queue_top();
+        void erase( timed_event_handle handle );
 
     public:
         /**
          * Add an entry to the event queue. Parameters are basically passed
          * through to @ref timed_event::timed_event.
          */
-        void add( timed_event_type type, const time_point &when, int faction_id = -1 );
+        auto add( timed_event_type type, const time_point &when,
+                  int faction_id = -1 ) -> timed_event_handle;
         /**
          * Add an entry to the event queue. Parameters are basically passed
          * through to @ref timed_event::timed_event.
          */
-        void add( timed_event_type type, const time_point &when, int faction_id,
-                  const tripoint_abs_sm &where );
+        auto add( timed_event_type type, const time_point &when, int faction_id,
+                  const tripoint_abs_sm &where ) -> timed_event_handle;
+        /// Remove a queued event without it happening.
+        /// @returns Whether the event was still queued.
+        bool cancel( timed_event_handle handle );
         /// @returns Whether at least one element of the given type is queued.
         bool queued( timed_event_type type ) const;
         /// @returns One of the queued events of the given type, or `nullptr`
-        /// if no event of that type is queued.
+        /// if no event of that type is queued.  Its time must not be changed through it.
         timed_event *get( timed_event_type type );
+        /// @returns How many events are queued.
+        auto size() const -> std::size_t {
+            return events.size();
+        }
         /// @returns The next queued event time, or std::nullopt when no events are queued.
         auto next_event_time() const -> std::optional<time_point>;
         /// Process all queued events, potentially altering the game state and
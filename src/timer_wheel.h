@@ -0,0 +1,206 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+/**
+ * Hierarchical timer wheel of values of @p T keyed by the integer time they are due.
+ *
+ * Three levels of 64 slots cover 1, 64 and 4096 time units per slot; later times wait
+ * in an overflow list.  advance_to() hands every value whose time has come to a
+ * callback, moving values down a level as their slot comes up, so a value is touched
+ * once per level rather than once per time unit.  Jumps longer than the wheel span
+ * (a submap coming back into the bubble after a day) drain everything in one pass.
+ */
+template<typename T>
+class timer_wheel
+{
+    public:
+        struct entry {
+            int due = 0;
+            T value;
+        };
+
+        /** Current time of the wheel: everything due at or before it has been handed out. */
+        auto now() const -> int {
+            return now_;
+        }
+
+        auto size() const -> std::size_t {
+            return size_;
+        }
+
+        auto empty() const -> bool {
+            return size_ == 0;
+        }
+
+        /** Moves an empty wheel to @p now without handing anything out. */
+        auto restart_at( const int now ) -> void {
+            if( size_ == 0 ) {
+                now_ = now;
+            }
+        }
+
+        /**
+         * Moves the wheel to @p now keeping every value's distance to its time, for
+         * clocks that can be set back (tests, debug time travel).
+         */
+        auto rebase( const int now ) -> void {
+            const auto delta = now - now_;
+            auto all = take_all();
+            now_ = now;
+            for( auto &e : all ) {
+                e.due += delta;
+                place( std::move( e ) );
+            }
+        }
+
+        /** Schedules @p value at @p due; times not after now() are due at the next step. */
+        auto schedule( const int due, T value ) -> void {
+            place( entry{ std::max( due, now_ + 1 ), std::move( value ) } );
+            ++size_;
+        }
+
+        /** Calls `fire( T &&value, int due )` for every value due at or before @p now. */
+        template<typename F>
+        auto advance_to( const int now, F &&fire ) -> void {
+            if( now <= now_ ) {
+                return;
+            }
+            if( size_ == 0 ) {
+                now_ = now;
+                return;
+            }
+            if( now - now_ >= span ) {
+                drain_to( now, fire );
+                return;
+            }
+            while( now_ < now ) {
+                ++now_;
+                if( ( now_ & block_mask<2> ) == 0 ) {
+                    cascade( levels_[2][slot_of<2>( now_ )] );
+                    cascade( overflow_ );
+                }
+                if( ( now_ & block_mask<1> ) == 0 ) {
+                    cascade( levels_[1][slot_of<1>( now_ )] );
+                }
+                auto &slot = levels_[0][slot_of<0>( now_ )];
+                if( slot.empty() ) {
+                    continue;
+                }
+                auto due = std::exchange( slot, {} );
+                size_ -= due.size();
+                for( auto &e : due ) {
+                    fire( std::move( e.value ), e.due );
+                }
+                // Keep the allocation for the next lap of this slot.
+                if( slot.empty() ) {
+                    due.clear();
+                    slot = std::move( due );
+                }
+            }
+        }
+
+        template<typename F>
+        auto for_each( F &&f ) const -> void {
+            for( const auto &level : levels_ ) {
+                for( const auto &slot : level ) {
+                    for( const auto &e : slot ) {
+                        f( e.value );
+                    }
+                }
+            }
+            for( const auto &e : overflow_ ) {
+                f( e.value );
+            }
+        }
+
+        /** Drops every value for which @p pred( const T & ) holds; returns how many. */
+        template<typename P>
+        auto erase_if( P &&pred ) -> std::size_t {
+            auto erased = std::size_t{ 0 };
+            const auto erase_in = [&]( std::vector<entry> &slot ) {
+                erased += std::erase_if( slot, [&]( const entry & e ) {
+                    return pred( e.value );
+                } );
+            };
+            for( auto &level : levels_ ) {
+                for( auto &slot : level ) {
+                    erase_in( slot );
+                }
+            }
+            erase_in( overflow_ );
+            size_ -= erased;
+            return erased;
+        }
+
+    private:
+        static constexpr int slot_bits = 6;
+        static constexpr int slots = 1 << slot_bits;
+        static constexpr int span = 1 << ( 3 * slot_bits );
+
+        template<int Level>
+        static constexpr int block_mask = ( 1 << ( Level * slot_bits ) ) - 1;
+
+        template<int Level>
+        static constexpr auto slot_of( const int t ) -> int {
+            return ( t >> ( Level * slot_bits ) ) & ( slots - 1 );
+        }
+
+        /** Puts @p e on the lowest level whose current lap still reaches its time. */
+        auto place( entry &&e ) -> void {
+            if( e.due - now_ < slots ) {
+                levels_[0][slot_of<0>( e.due )].push_back( std::move( e ) );
+            } else if( ( e.due >> slot_bits ) - ( now_ >> slot_bits ) < slots ) {
+                levels_[1][slot_of<1>( e.due )].push_back( std::move( e ) );
+            } else if( ( e.due >> ( 2 * slot_bits ) ) - ( now_ >> ( 2 * slot_bits ) ) < slots ) {
+                levels_[2][slot_of<2>( e.due )].push_back( std::move( e ) );
+            } else {
+                overflow_.push_back( std::move( e ) );
+            }
+        }
+
+        auto cascade( std::vector<entry> &slot ) -> void {
+            for( auto &e : std::exchange( slot, {} ) ) {
+                place( std::move( e ) );
+            }
+        }
+
+        auto take_all() -> std::vector<entry> {
+            auto all = std::vector<entry> {};
+            all.reserve( size_ );
+            for( auto &level : levels_ ) {
+                for( auto &slot : level ) {
+                    std::move( slot.begin(), slot.end(), std::back_inserter( all ) );
+                    slot.clear();
+                }
+            }
+            std::move( overflow_.begin(), overflow_.end(), std::back_inserter( all ) );
+            overflow_.clear();
+            return all;
+        }
+
+        template<typename F>
+        auto drain_to( const int now, F &fire ) -> void {
+            auto all = take_all();
+            now_ = now;
+            size_ = 0;
+            for( auto &e : all ) {
+                if( e.due <= now ) {
+                    fire( std::move( e.value ), e.due );
+                } else {
+                    place( std::move( e ) );
+                    ++size_;
+                }
+            }
+        }
+
+        std::array<std::array<std::vector<entry>, slots>, 3> levels_;
+        std::vector<entry> overflow_;
+        std::size_t size_ = 0;
+        int now_ = 0;
+};
@@ -0,0 +1,222 @@
+#include "turn_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <ostream>
+
+#include "cached_options.h"
+#include "debug.h"
+#include "fstream_utils.h"
+#include "json.h"
+#include "path_info.h"
+
+namespace turn_recorder
+{
+
+namespace
+{
+
+using clock = std::chrono::steady_clock;
+
+std::array<std::atomic<std::uint64_t>, num_counters> counters = {};
+turn_history recorded;
+spike_trigger trigger;
+bool recording_turn = false;
+clock::time_point turn_start;
+
+} // namespace
+
+auto counter_name( const counter c ) -> const char *
+{
+    switch( c ) {
+        case counter::monsters_planned:
+            return "monsters_planned";
+        case counter::d_maps_built:
+            return "d_maps_built";
+        case counter::submaps_loaded:
+            return "submaps_loaded";
+        case counter::items_processed:
+            return "items_processed";
+        case counter::lua_hooks_run:
+            return "lua_hooks_run";
+        case counter::num_counters:
+            break;
+    }
+    return "other";
+}
+
+void count( const counter c, const std::uint64_t n )
+{
+    counters[static_cast<size_t>( c )].fetch_add( n, std::memory_order_relaxed );
+}
+
+auto turn_sample::busy_ms() const -> float
+{
+    return std::max( 0.0f, total_ms - input_ms );
+}
+
+auto turn_history::next() -> turn_sample &
+{
+    if( samples.size() < capacity ) {
+        samples.resize( capacity );
+    }
+    turn_sample &slot = samples[( head + count ) % capacity];
+    if( count == capacity ) {
+        head = ( head + 1 ) % capacity;
+    } else {
+        ++count;
+    }
+    slot.turn = 0;
+    slot.total_ms = 0.0f;
+    slot.input_ms = 0.0f;
+    slot.phase_ms.clear();
+    slot.counts = {};
+    return slot;
+}
+
+void turn_history::clear()
+{
+    head = 0;
+    count = 0;
+}
+
+auto turn_history::operator[]( const size_t i ) const -> const turn_sample &
+{
+    return samples[( head + i ) % capacity];
+}
+
+auto turn_history::back() -> turn_sample &
+{
+    return samples[( head + count - 1 ) % capacity];
+}
+
+void turn_history::serialize( JsonOut &jsout ) const
+{
+    jsout.start_array();
+    for( size_t i = 0; i < size(); ++i ) {
+        const turn_sample &s = ( *this )[i];
+        jsout.start_object();
+        jsout.member( "turn", s.turn );
+        jsout.member( "total_ms", s.total_ms );
+        jsout.member( "input_ms", s.input_ms );
+        jsout.member( "busy_ms", s.busy_ms() );
+        jsout.member( "phases" );
+        jsout.start_object();
+        for( const auto &[name, ms] : s.phase_ms ) {
+            jsout.member( name, ms );
+        }
+        jsout.end_object();
+        jsout.member( "counters" );
+        jsout.start_object();
+        for( size_t c = 0; c < num_counters; ++c ) {
+            jsout.member( counter_name( static_cast<counter>( c ) ), s.counts[c] );
+        }
+        jsout.end_object();
+        jsout.end_object();
+    }
+    jsout.end_array();
+}
+
+auto spike_trigger::on_turn( const float busy_ms, const float threshold_ms ) -> bool
+{
+    if( cooldown > 0 ) {
+        --cooldown;
+    }
+    if( pending >= 0 ) {
+        if( pending-- > 0 ) {
+            return false;
+        }
+        pending = -1;
+        cooldown = dump_cooldown_turns;
+        return true;
+    }
+    if( threshold_ms > 0.0f && busy_ms > threshold_ms && cooldown == 0 ) {
+        pending = turns_after - 1;
+        pending_busy_ms = busy_ms;
+    }
+    return false;
+}
+
+auto history() -> const turn_history &
+{
+    return recorded;
+}
+
+void clear()
+{
+    recorded.clear();
+    trigger = spike_trigger();
+}
+
+auto in_turn() -> bool
+{
+    return recording_turn;
+}
+
+void charge( const frame_timing::group g, const char *const name, const float ms )
+{
+    if( !recording_turn || recorded.size() == 0 ) {
+        return;
+    }
+    turn_sample &current = recorded.back();
+    if( g == frame_timing::group::input ) {
+        current.input_ms += ms;
+        return;
+    }
+    auto it = std::ranges::find( current.phase_ms, name, &std::pair<const char *, float>::first );
+    if( it == current.phase_ms.end() ) {
+        current.phase_ms.emplace_back( name, ms );
+    } else {
+        it->second += ms;
+    }
+}
+
+scoped_turn::scoped_turn( const int turn )
+{
+    turn_sample &sample = recorded.next();
+    sample.turn = turn;
+    for( auto &c : counters ) {
+        c.store( 0, std::memory_order_relaxed );
+    }
+    recording_turn = true;
+    turn_start = clock::now();
+}
+
+scoped_turn::~scoped_turn()
+{
+    recording_turn = false;
+    turn_sample &current = recorded.back();
+    current.total_ms = std::chrono::duration<float, std::milli>( clock::now() - turn_start ).count();
+    for( size_t c = 0; c < num_counters; ++c ) {
+        current.counts[c] = counters[c].load( std::memory_order_relaxed );
+    }
+    if( trigger.on_turn( current.busy_ms(), static_cast<float>( turn_spike_threshold_ms ) ) ) {
+        dump( trigger.spike_busy_ms() );
+    }
+}
+
+auto dump( const float spike_busy_ms ) -> std::string
+{
+    char stamp[32] {};
+    const std::time_t t = std::time( nullptr );
+    std::strftime( stamp, sizeof( stamp ), "%Y-%m-%d-%H-%M-%S", std::localtime( &t ) );
+    const std::string path = PATH_INFO::config_dir() + "turn_spike-" + stamp + ".json";
+
+    const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        jsout.start_object();
+        jsout.member( "threshold_ms", turn_spike_threshold_ms );
+        jsout.member( "spike_busy_ms", spike_busy_ms );
+        jsout.member( "turns", recorded );
+        jsout.end_object();
+    }, "" );
+    if( !written ) {
+        return std::string();
+    }
+    DebugLog( DL::Info, DC::Main ) << "Turn of " << spike_busy_ms << " ms recorded to " << path;
+    return path;
+}
+
+} // namespace turn_recorder
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "frame_timing.h"
+
+class JsonOut;
+
+/**
+ * Flight recorder of the last few turns of game::do_turn, always running.
+ *
+ * Each turn keeps the exclusive time of the do_turn phases (the same zones the frame
+ * timing overlay shows) and a few work counters.  When a turn's busy time goes over the
+ * TURN_SPIKE_THRESHOLD option, the turns around it are written to a JSON file in the
+ * config directory, so a stutter a player noticed can be looked at after the fact.
+ */
+namespace turn_recorder
+{
+
+enum class counter : int {
+    monsters_planned,
+    d_maps_built,
+    submaps_loaded,
+    items_processed,
+    lua_hooks_run,
+    num_counters
+};
+
+inline constexpr auto num_counters = static_cast<size_t>( counter::num_counters );
+
+auto counter_name( counter c ) -> const char *;
+
+/** Adds @p n to @p c for the turn in progress; safe to call from pool workers. */
+void count( counter c, std::uint64_t n = 1 );
+
+struct turn_sample {
+    int turn = 0;
+    // Wall time of the whole do_turn call
+    float total_ms = 0.0f;
+    // Part of it spent waiting for input
+    float input_ms = 0.0f;
+    // Exclusive time of each phase that ran, except input waits
+    std::vector<std::pair<const char *, float>> phase_ms;
+    std::array<std::uint64_t, num_counters> counts = {};
+
+    auto busy_ms() const -> float;
+};
+
+/**
+ * The last @ref capacity turns, oldest first.
+ *
+ * Samples are overwritten in place, so after the first lap recording a turn allocates
+ * nothing unless it runs a phase no earlier turn in its slot did.
+ */
+class turn_history
+{
+    public:
+        static constexpr size_t capacity = 64;
+
+        /** Slot to fill with the next turn, dropping the oldest if full. */
+        auto next() -> turn_sample &;
+        void clear();
+        auto size() const -> size_t {
+            return count;
+        }
+        auto operator[]( size_t i ) const -> const turn_sample &;
+        /** The newest turn, which is the one being recorded during a turn. */
+        auto back() -> turn_sample &;
+
+        void serialize( JsonOut &jsout ) const;
+
+    private:
+        std::vector<turn_sample> samples;
+        size_t head = 0;
+        size_t count = 0;
+};
+
+/**
+ * Decides when a spike gets written out: some turns after it, so the window shows what
+ * followed as well as what led up to it, and not again until @ref dump_cooldown_turns
+ * later, so a save that stutters every turn doesn't fill the disk.
+ */
+class spike_trigger
+{
+    public:
+        static constexpr int turns_after = 8;
+        static constexpr int dump_cooldown_turns = 600;
+
+        /** Notes a finished turn; true once the window around a spike is complete. */
+        auto on_turn( float busy_ms, float threshold_ms ) -> bool;
+        /** Busy time of the turn that went over the threshold. */
+        auto spike_busy_ms() const -> float {
+            return pending_busy_ms;
+        }
+
+    private:
+        int pending = -1;
+        int cooldown = 0;
+        float pending_busy_ms = 0.0f;
+};
+
+auto history() -> const turn_history &;
+void clear();
+
+/** Is a do_turn call being recorded on this thread? */
+auto in_turn() -> bool;
+
+/** Charges @p ms of a closed or interrupted @ref frame_timing::scoped_phase to the turn. */
+void charge( frame_timing::group g, const char *name, float ms );
+
+/** Records game::do_turn while in scope; @p turn identifies it in the dump. */
+class scoped_turn
+{
+    public:
+        explicit scoped_turn( int turn );
+        ~scoped_turn();
+        scoped_turn( const scoped_turn & ) = delete;
+        scoped_turn &operator=( const scoped_turn & ) = delete;
+};
+
+/** Writes the recorded turns to a new file in the config directory; empty on failure. */
+auto dump( float spike_busy_ms ) -> std::string;
+
+} // namespace turn_recorder
@@ -0,0 +1,241 @@
+#include "turn_task_graph.h"
+
+#include <algorithm>
+#include <array>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <ranges>
+#include <utility>
+
+#include "profile.h"
+#include "string_formatter.h"
+#include "string_utils.h"
+#include "thread_pool.h"
+
+namespace
+{
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr auto resource_names = std::array {
+    "calendar", "avatar", "npcs", "monsters", "map_items", "map_fields", "map_terrain",
+    "map_caches", "vehicles", "mapbuffer", "overmap", "power_grids", "fluid_grids", "portals",
+    "weather", "scent", "sound", "messages", "lua", "ui",
+};
+static_assert( resource_names.size() == static_cast<size_t>( turn_resource::num_resources ) );
+
+auto to_set( const std::vector<turn_resource> &resources ) -> turn_resource_set
+{
+    auto set = turn_resource_set{};
+    std::ranges::for_each( resources, [&set]( const turn_resource r ) {
+        set.set( static_cast<size_t>( r ) );
+    } );
+    return set;
+}
+
+auto describe( const turn_resource_set &set ) -> std::string
+{
+    auto out = std::string{};
+    for( auto i = size_t{ 0 }; i < set.size(); ++i ) {
+        if( set.test( i ) ) {
+            out += out.empty() ? "" : ",";
+            out += resource_names[i];
+        }
+    }
+    return out.empty() ? "-" : out;
+}
+
+auto live_graphs_mutex() -> std::mutex & // *NOPAD*
+{
+    static auto mutex = std::mutex{};
+    return mutex;
+}
+
+auto live_graphs() -> std::vector<const turn_task_graph *> & // *NOPAD*
+{
+    static auto graphs = std::vector<const turn_task_graph *> {};
+    return graphs;
+}
+
+} // namespace
+
+turn_task_graph::turn_task_graph( std::string name ) : name_( std::move( name ) )
+{
+    const auto lock = std::lock_guard( live_graphs_mutex() );
+    live_graphs().push_back( this );
+}
+
+turn_task_graph::~turn_task_graph()
+{
+    const auto lock = std::lock_guard( live_graphs_mutex() );
+    std::erase( live_graphs(), this );
+}
+
+auto turn_task_graph::add( turn_task_options opts ) -> int
+{
+    auto t = task{
+        .opts = std::move( opts ),
+        .reads = {},
+        .writes = {},
+        .deps = {},
+    };
+    t.reads = to_set( t.opts.reads );
+    t.writes = to_set( t.opts.writes );
+    const auto index = static_cast<int>( tasks_.size() );
+    for( auto i = 0; i < index; ++i ) {
+        const auto &earlier = tasks_[i];
+        const auto conflicts = ( earlier.writes & ( t.reads | t.writes ) ).any() ||
+                               ( earlier.reads & t.writes ).any();
+        if( conflicts ) {
+            t.deps.push_back( i );
+        }
+    }
+    tasks_.push_back( std::move( t ) );
+    return index;
+}
+
+auto turn_task_graph::dependencies( int index ) const -> const std::vector<int> & // *NOPAD*
+{
+    return tasks_[index].deps;
+}
+
+auto turn_task_graph::run_task( int index ) -> void
+{
+    ZoneScoped;
+    auto &t = tasks_[index];
+    ZoneName( t.opts.name.c_str(), t.opts.name.size() );
+    const auto start = clock_type::now();
+    t.opts.run();
+    t.last_duration = std::chrono::duration_cast<std::chrono::microseconds>( clock_type::now() - start );
+}
+
+auto turn_task_graph::run() -> void
+{
+    const auto start = clock_type::now();
+    auto &pool = get_thread_pool();
+    const auto can_offload = pool.num_workers() > 0;
+    auto done = std::vector<bool>( tasks_.size(), false );
+    auto remaining = tasks_.size();
+    auto waves = 0;
+    auto first_ex = std::exception_ptr{};
+
+    while( remaining > 0 ) {
+        const auto is_ready = [&]( const int i ) {
+            return !done[i] && std::ranges::all_of( tasks_[i].deps, [&done]( const int d ) { return done[d]; } );
+        };
+        const auto wave = std::views::iota( 0, static_cast<int>( tasks_.size() ) )
+                          | std::views::filter( is_ready )
+                          | std::ranges::to<std::vector>();
+        ++waves;
+
+        // Offload first so workers overlap the main-thread phases of this wave.
+        auto offloaded = std::vector<std::future<void>> {};
+        std::ranges::for_each( wave, [&]( const int i ) {
+            if( can_offload && tasks_[i].opts.affinity == turn_task_affinity::any_thread ) {
+                offloaded.push_back( pool.submit_returning( task_priority::interactive, "turn_task_graph",
+                [this, i]() { run_task( i ); } ) );
+            }
+        } );
+        std::ranges::for_each( wave, [&]( const int i ) {
+            if( can_offload && tasks_[i].opts.affinity == turn_task_affinity::any_thread ) {
+                return;
+            }
+            try {
+                run_task( i );
+            } catch( ... ) {
+                first_ex = first_ex ? first_ex : std::current_exception();
+            }
+        } );
+        std::ranges::for_each( offloaded, [&]( std::future<void> &f ) {
+            pool.wait_helping( f );
+            try {
+                f.get();
+            } catch( ... ) {
+                first_ex = first_ex ? first_ex : std::current_exception();
+            }
+        } );
+
+        std::ranges::for_each( wave, [&done]( const int i ) { done[i] = true; } );
+        remaining -= wave.size();
+        if( first_ex ) {
+            break;
+        }
+    }
+
+    last_waves_ = waves;
+    last_total_ = std::chrono::duration_cast<std::chrono::microseconds>( clock_type::now() - start );
+    if( first_ex ) {
+        std::rethrow_exception( first_ex );
+    }
+}
+
+auto turn_task_graph::critical_path() const -> std::vector<int>
+{
+    if( tasks_.empty() ) {
+        return {};
+    }
+    // Edges only point backwards, so declaration order is a topological order.
+    auto finish = std::vector<std::chrono::microseconds>( tasks_.size() );
+    auto via = std::vector<int>( tasks_.size(), -1 );
+    for( auto i = size_t{ 0 }; i < tasks_.size(); ++i ) {
+        auto best = std::chrono::microseconds::zero();
+        std::ranges::for_each( tasks_[i].deps, [&]( const int d ) {
+            if( via[i] == -1 || finish[d] >= best ) {
+                best = finish[d];
+                via[i] = d;
+            }
+        } );
+        finish[i] = best + tasks_[i].last_duration;
+    }
+    // Ties go to the later phase: it sits behind more of the chain.
+    auto last = 0;
+    for( auto i = size_t{ 1 }; i < finish.size(); ++i ) {
+        if( finish[i] >= finish[last] ) {
+            last = static_cast<int>( i );
+        }
+    }
+    auto path = std::vector<int> {};
+    for( auto i = last; i != -1; i = via[i] ) {
+        path.push_back( i );
+    }
+    std::ranges::reverse( path );
+    return path;
+}
+
+auto turn_task_graph::dump() const -> std::string
+{
+    auto out = string_format( "%s: %d phases, %d waves, last run %lld us\n", name_,
+                              static_cast<int>( tasks_.size() ), last_waves_,
+                              static_cast<long long>( last_total_.count() ) );
+    for( auto i = size_t{ 0 }; i < tasks_.size(); ++i ) {
+        const auto &t = tasks_[i];
+        const auto deps = t.deps
+                          | std::views::transform( []( const int d ) { return std::to_string( d ); } )
+                          | std::ranges::to<std::vector>();
+        out += string_format( "  [%d] %-36s %8lld us  %s  reads=%s writes=%s after=%s\n",
+                              static_cast<int>( i ), t.opts.name,
+                              static_cast<long long>( t.last_duration.count() ),
+                              t.opts.affinity == turn_task_affinity::any_thread ? "any " : "main",
+                              describe( t.reads ), describe( t.writes ), deps.empty() ? "-" : join( deps, "," ) );
+    }
+    const auto path = critical_path();
+    auto path_total = std::chrono::microseconds::zero();
+    auto path_names = std::string{};
+    std::ranges::for_each( path, [&]( const int i ) {
+        path_total += tasks_[i].last_duration;
+        path_names += path_names.empty() ? "" : " -> ";
+        path_names += tasks_[i].opts.name;
+    } );
+    out += string_format( "  critical path (%lld us): %s\n", static_cast<long long>( path_total.count() ),
+                          path_names.empty() ? "-" : path_names );
+    return out;
+}
+
+auto turn_task_graph::dump_all() -> std::string
+{
+    const auto lock = std::lock_guard( live_graphs_mutex() );
+    auto out = std::string{};
+    std::ranges::for_each( live_graphs(), [&out]( const turn_task_graph * g ) { out += g->dump(); } );
+    return out;
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+/// Coarse slices of game state that a turn phase declares it reads or writes.
+///
+/// Two phases conflict when one writes a resource the other reads or writes.
+/// Conflicting phases keep their declared order; independent ones may overlap.
+enum class turn_resource : int {
+    calendar,
+    avatar,
+    npcs,
+    monsters,
+    map_items,
+    map_fields,
+    map_terrain,
+    map_caches,
+    vehicles,
+    mapbuffer,
+    overmap,
+    power_grids,
+    fluid_grids,
+    portals,
+    weather,
+    scent,
+    sound,
+    messages,
+    lua,
+    ui,
+    num_resources
+};
+
+using turn_resource_set = std::bitset<static_cast<size_t>( turn_resource::num_resources )>;
+
+/// Where a phase is allowed to run.
+enum class turn_task_affinity : int {
+    /// Default.  Touches Lua, SDL, the message log, safe_reference or other main-thread-only state.
+    main_thread,
+    /// Audited safe to run on a pool worker next to phases it does not conflict with.
+    any_thread,
+};
+
+struct turn_task_options {
+    std::string name;
+    std::vector<turn_resource> reads;
+    std::vector<turn_resource> writes;
+    turn_task_affinity affinity = turn_task_affinity::main_thread;
+    std::function<void()> run;
+};
+
+/// Declarative scheduler for a block of per-turn phases.
+///
+/// Phases are added in the order the straight-line code used to run them.  Each
+/// phase depends on every earlier phase it conflicts with, so execution never
+/// reorders conflicting phases.  Ready any_thread phases go to the thread pool
+/// while the main thread runs the ready main_thread ones.
+///
+/// Every run records per-phase wall time; dump() reports the dependency edges and
+/// the critical path, i.e. the chain that bounds the block's turn time.
+class turn_task_graph
+{
+    public:
+        explicit turn_task_graph( std::string name );
+        ~turn_task_graph();
+
+        turn_task_graph( const turn_task_graph & ) = delete;
+        auto operator=( const turn_task_graph & ) -> turn_task_graph & = delete; // *NOPAD*
+
+        /// Append a phase; returns its index.
+        auto add( turn_task_options opts ) -> int;
+
+        /// Run every phase once, honouring dependencies.  The first exception is rethrown.
+        auto run() -> void;
+
+        /// Indices of phases on the longest dependency chain, weighted by last measured time.
+        auto critical_path() const -> std::vector<int>;
+
+        /// Indices of earlier phases that @p index waits for.
+        auto dependencies( int index ) const -> const std::vector<int> &; // *NOPAD*
+
+        /// Human-readable report: phases, dependencies, last timings and critical path.
+        auto dump() const -> std::string;
+
+        auto name() const -> const std::string & { // *NOPAD*
+            return name_;
+        }
+
+        auto size() const -> size_t {
+            return tasks_.size();
+        }
+
+        /// Reports of every live graph, for the debug menu.
+        static auto dump_all() -> std::string;
+
+    private:
+        struct task {
+            turn_task_options opts;
+            turn_resource_set reads;
+            turn_resource_set writes;
+            std::vector<int> deps;
+            std::chrono::microseconds last_duration = std::chrono::microseconds::zero();
+        };
+
+        auto run_task( int index ) -> void;
+
+        std::string name_;
+        std::vector<task> tasks_;
+        std::chrono::microseconds last_total_ = std::chrono::microseconds::zero();
+        int last_waves_ = 0;
+};
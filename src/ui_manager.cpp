@@ -9,6 +9,7 @@
 
 #include "cached_options.h"
 #include "cursesdef.h"
+#include "frame_timing.h"
 #include "game_ui.h"
 #include "point.h"
 #include "sdltiles.h"
@@ -23,6 +24,11 @@ static bool restart_redrawing = false;
 static std::optional<SDL_Rect> prev_clip_rect;
 #endif
 static ui_stack_t ui_stack;
+// Invalidations are applied when redrawing, so several per input event cost one pass.
+static std::vector<rectangle<point>> pending_damage;
+static bool consistency_pending = false;
+// Past this many distinct rectangles it's cheaper to apply them right away.
+static constexpr size_t max_pending_damage = 16;
 
 ui_adaptor::ui_adaptor() : disabling_uis_below( false ), is_debug_message_ui( false ),
     invalidated( false ), deferred_resize( false )
@@ -84,7 +90,6 @@ ui_adaptor::~ui_adaptor()
     for( auto it = ui_stack.rbegin(); it < ui_stack.rend(); ++it ) {
         if( &it->get() == this ) {
             ui_stack.erase( std::prev( it.base() ) );
-            // TODO avoid invalidating portions that do not need to be redrawn
             ui_manager::invalidate( dimensions, disabling_uis_below );
             break;
         }
@@ -282,7 +287,7 @@ void ui_adaptor::invalidate_ui() const
     // `disable_uis_below`, so when the UI with `disable_uis_below` is removed,
     // this UI is correctly marked for redraw.
     invalidated = true;
-    invalidation_consistency_and_optimization();
+    consistency_pending = true;
 }
 
 void ui_adaptor::reset()
@@ -296,21 +301,51 @@ void ui_adaptor::invalidate( const rectangle<point> &rect, const bool reenable_u
 {
     if( rect.p_min.x >= rect.p_max.x || rect.p_min.y >= rect.p_max.y ) {
         if( reenable_uis_below ) {
-            invalidation_consistency_and_optimization();
+            consistency_pending = true;
         }
         return;
     }
-    // Always invalidate every UI, even if it is below another UI with
-    // `disable_uis_below`, so when the UI with `disable_uis_below` is removed,
-    // UIs below are correctly marked for redraw.
-    for( auto it_upper = ui_stack.cbegin(); it_upper < ui_stack.cend(); ++it_upper ) {
-        const ui_adaptor &ui_upper = it_upper->get();
-        if( !ui_upper.invalidated && overlap( ui_upper.dimensions, rect ) ) {
-            // invalidated by `rect`
-            ui_upper.invalidated = true;
+    consistency_pending = true;
+    const auto covers_rect = [&]( const rectangle<point> &r ) {
+        return rect_contains( r, rect );
+    };
+    if( std::ranges::any_of( pending_damage, covers_rect ) ) {
+        return;
+    }
+    std::erase_if( pending_damage, [&]( const rectangle<point> &r ) {
+        return rect_contains( rect, r );
+    } );
+    pending_damage.emplace_back( rect );
+    if( pending_damage.size() > max_pending_damage ) {
+        apply_pending_invalidation();
+    }
+}
+
+void ui_adaptor::apply_pending_invalidation()
+{
+    // UIs are matched against the damage as they are at redraw time, so a UI that
+    // moved or closed since is handled the same as if it never had been there.
+    for( const rectangle<point> &rect : pending_damage ) {
+        for( auto it = ui_stack.crbegin(); it != ui_stack.crend(); ++it ) {
+            const ui_adaptor &ui = it->get();
+            if( !ui.invalidated && overlap( ui.dimensions, rect ) ) {
+                // invalidated by `rect`
+                ui.invalidated = true;
+            }
+            // A UI covering the whole rectangle repaints all of it, so UIs below
+            // don't need redrawing on its account.  This also holds for UIs below
+            // one with `disable_uis_below`: whatever removes that UI invalidates
+            // its area, which reaches them.
+            if( ui.redraw_cb && rect_contains( ui.dimensions, rect ) ) {
+                break;
+            }
         }
     }
-    invalidation_consistency_and_optimization();
+    pending_damage.clear();
+    if( consistency_pending ) {
+        consistency_pending = false;
+        invalidation_consistency_and_optimization();
+    }
 }
 
 void ui_adaptor::redraw()
@@ -325,6 +360,9 @@ void ui_adaptor::redraw()
 void ui_adaptor::redraw_invalidated()
 {
     ZoneScoped;
+    const frame_timing::scoped_phase phase( frame_timing::group::ui_redraw,
+                                            "ui_adaptor::redraw_invalidated" );
+    apply_pending_invalidation();
     if( test_mode || ui_stack.empty() ) {
         return;
     }
@@ -340,6 +378,8 @@ void ui_adaptor::redraw_invalidated()
         // so far, so we restart redrawing using the changed flags to redraw
         // the area invalidated by the debug message popup.
         restart_redrawing = false;
+        // `debugmsg` closing its popup invalidates the area it covered.
+        apply_pending_invalidation();
 
         // Find the first enabled UI. From now on enabling and disabling UIs
         // have no effect until the end of this call.
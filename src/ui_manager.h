@@ -214,6 +214,8 @@ class ui_adaptor
         static void screen_resized();
     private:
         static void invalidation_consistency_and_optimization();
+        /** Marks the UIs under the damage recorded by @ref invalidate since the last redraw. */
+        static void apply_pending_invalidation();
 
         // pixel dimensions in tiles, console cell dimensions in curses
         rectangle<point> dimensions;
@@ -257,7 +259,9 @@ namespace ui_manager
 /**
  * Invalidate a portion of the screen when a UI is resized, closed, etc.
  * Not supposed to be directly called by the user.
- * rect is the pixel dimensions in tiles or console cell dimensions in curses
+ * rect is the pixel dimensions in tiles or console cell dimensions in curses.
+ * Takes effect on the next redraw, against the UIs as they are then; UIs below
+ * one that covers all of rect are not redrawn.
  **/
 void invalidate( const rectangle<point> &rect, bool reenable_uis_below );
 /**
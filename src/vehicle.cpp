@@ -19,7 +19,6 @@
 #include <queue>
 #include <set>
 #include <sstream>
-#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 #include <ranges>
@@ -404,6 +403,7 @@ void vehicle::copy_static_from( const vehicle &source )
     draft_m = source.draft_m;
     hull_height = source.hull_height;
     hull_area = source.hull_area;
+    lift_totals = source.lift_totals;
     occupied_points = source.occupied_points;
     alternators = source.alternators;
     battery_parts = source.battery_parts;
@@ -3865,18 +3865,14 @@ void vehicle::precalc_mounts( int idir, units::angle dir, const tripoint_mnt_veh
     if( idir < 0 || idir > 1 ) {
         idir = 0;
     }
-    std::unordered_map<tripoint_mnt_veh, point_rel_ms> mount_to_precalc;
+    // Rotating a mount is a table lookup and a few integer operations, so it's
+    // cheaper to redo it for every part than to share results between parts on
+    // the same mount through a hash map built on each turn.
     for( auto &p : parts ) {
         if( p.removed ) {
             continue;
         }
-        auto q = mount_to_precalc.find( p.mount );
-        if( q == mount_to_precalc.end() ) {
-            coord_translate( dir, pivot, p.mount, p.precalc[idir] );
-            mount_to_precalc.insert( { p.mount, p.precalc[idir] } );
-        } else {
-            p.precalc[idir] = q->second;
-        }
+        coord_translate( dir, pivot, p.mount, p.precalc[idir] );
     }
     pivot_anchor[idir] = pivot;
     pivot_rotation[idir] = dir;
@@ -4916,12 +4912,7 @@ double vehicle::coeff_air_drag() const
 
 double vehicle::coeff_balloon_drag() const
 {
-    double volume = std::accumulate( balloons.begin(), balloons.end(), double{0.0},
-    [&]( double acc, int balloon ) {
-        const double height{ parts[ balloon ].info().balloon_height() };
-        return acc + height;
-    } );
-    return std::pow( volume, 2 / 3 );
+    return std::pow( lift_totals.balloon_height, 2 / 3 );
 }
 
 double vehicle::coeff_rolling_drag() const
@@ -4984,20 +4975,12 @@ bool vehicle::can_float() const
 
 double vehicle::total_rotor_area() const
 {
-    return std::accumulate( rotors.begin(), rotors.end(), 0.0,
-    [&]( double acc, int rotor ) {
-        const double radius{ parts[ rotor ].info().rotor_diameter() / 2.0 };
-        return acc + M_PI * std::pow( radius, 2 );
-    } );
+    return lift_totals.rotor_area;
 }
 
 double vehicle::total_propeller_area() const
 {
-    return std::accumulate( propellers.begin(), propellers.end(), 0.0,
-    [&]( double acc, int propeller ) {
-        const double radius{ parts[ propeller ].info().propeller_diameter() / 2.0 };
-        return acc + M_PI * std::pow( radius, 2 );
-    } );
+    return lift_totals.propeller_area;
 }
 
 // Balloons can lift ~1 kg per m^3
@@ -5006,11 +4989,7 @@ double vehicle::total_propeller_area() const
 // Returns a value in newtons
 double vehicle::total_balloon_lift() const
 {
-    return GRAVITY_OF_EARTH * std::accumulate( balloons.begin(), balloons.end(), double{0.0},
-    [&]( double acc, int balloon ) {
-        const double height{ parts[ balloon ].info().balloon_height() };
-        return acc + height;
-    } );
+    return GRAVITY_OF_EARTH * lift_totals.balloon_height;
 }
 
 // Wing Lift
@@ -5019,12 +4998,7 @@ double vehicle::total_wing_lift() const
 {
     const double meterpersec = cmps_to_mps( velocity );
     const double meterpersecsquared = std::pow( meterpersec, 2 );
-    return meterpersecsquared * std::accumulate( wings.begin(), wings.end(), double{0.0},
-    [&]( double acc, int wing ) {
-        const double liftcoff{ parts[ wing ].info().lift_coff() };
-        // m^2 area is always 1
-        return acc + ( 0.5 * liftcoff );
-    } );
+    return meterpersecsquared * lift_totals.wing_lift;
 }
 
 // constants were converted from imperial to SI goodness
@@ -5098,12 +5072,7 @@ int vehicle::get_takeoff_speed( std::string speed_type ) const
     const int needed_force = to_newton( total_mass() ) - thrust_of_rotorcraft( true, false, true ) -
                              total_balloon_lift();
 
-    const double liftwithoutspeed = std::accumulate( wings.begin(), wings.end(), double{0.0},
-    [&]( double acc, int wing ) {
-        const double liftcoff{ parts[ wing ].info().lift_coff() };
-        // m^2 area is always 1
-        return acc + ( 0.5 * liftcoff );
-    } );
+    const double liftwithoutspeed = lift_totals.wing_lift;
     if( liftwithoutspeed < 1 ) {
         return 0;
     }
@@ -5842,13 +5811,19 @@ void vehicle::power_parts()
     // Things that drain energy: engines and accessories.
     int engine_epower = total_engine_epower_w();
     int epower = engine_epower + total_accessory_epower_w() + total_alternator_epower_w();
+    // Parked vehicles with nothing switched on have nothing to move in or out of
+    // their batteries, so don't scan them or walk the connected grid.
+    if( epower == 0 && reactors.empty() ) {
+        return;
+    }
 
     int delta_energy_bat = power_to_energy_bat( epower, 1_turns );
-    int storage_deficit_bat = std::max( 0, fuel_capacity( fuel_type_battery ) -
-                                        fuel_left( fuel_type_battery ) - delta_energy_bat );
     // Reactors trigger only on demand. If we'd otherwise run out of power, see
     // if we can spin up the reactors.
-    if( !reactors.empty() && storage_deficit_bat > 0 ) {
+    const int storage_deficit_bat = reactors.empty() ? 0 :
+                                    std::max( 0, fuel_capacity( fuel_type_battery ) -
+                                              fuel_left( fuel_type_battery ) - delta_energy_bat );
+    if( storage_deficit_bat > 0 ) {
         // Still not enough surplus epower to fully charge battery
         // Produce additional epower from any reactors
         bool reactor_working = false;
@@ -6295,7 +6270,8 @@ void vehicle::idle( bool on_map )
     }
 
     // Disallow running a planter underground for now
-    if( !warm_enough_to_plant( g->u.abs_pos() ) || abs_ms_location().z() < 0 ) {
+    if( has_idle_effect_parts &&
+        ( !warm_enough_to_plant( g->u.abs_pos() ) || abs_ms_location().z() < 0 ) ) {
         for( const vpart_reference &vp : get_enabled_parts( "PLANTER" ) ) {
             if( g->u.sees( bub_ms_location() ) ) {
                 add_msg( _( "The %s's planter turns off due to low temperature." ), name );
@@ -6312,16 +6288,18 @@ void vehicle::idle( bool on_map )
 
     process_emitters();
 
-    if( has_part( "STEREO", true ) ) {
-        play_music();
-    }
+    if( has_idle_effect_parts ) {
+        if( has_part( "STEREO", true ) ) {
+            play_music();
+        }
 
-    if( has_part( "CHIMES", true ) ) {
-        play_chimes();
-    }
+        if( has_part( "CHIMES", true ) ) {
+            play_chimes();
+        }
 
-    if( has_part( "CRASH_TERRAIN_AROUND", true ) ) {
-        crash_terrain_around();
+        if( has_part( "CRASH_TERRAIN_AROUND", true ) ) {
+            crash_terrain_around();
+        }
     }
 
     if( is_alarm_on ) {
@@ -6826,6 +6804,7 @@ void vehicle::refresh()
     extra_drag = 0;
     rail_profile.clear();
     has_autoloaders = false;
+    has_idle_effect_parts = false;
     has_cargo_recharge = false;
     cargo_recharge_targets_dirty = true;
     cargo_recharge_targets_.clear();
@@ -6931,6 +6910,10 @@ void vehicle::refresh()
         if( vpi.has_flag( "AUTOLOADER" ) ) {
             has_autoloaders = true;
         }
+        if( vpi.has_flag( "PLANTER" ) || vpi.has_flag( "STEREO" ) || vpi.has_flag( "CHIMES" ) ||
+            vpi.has_flag( "CRASH_TERRAIN_AROUND" ) ) {
+            has_idle_effect_parts = true;
+        }
         if( vpi.has_flag( VPFLAG_RECHARGE ) ) {
             has_cargo_recharge = true;
         }
@@ -6976,6 +6959,8 @@ void vehicle::refresh()
         }
     }
 
+    refresh_lift_totals();
+
     front_left.x() = mount_max.x();
     front_left.y() = mount_min.y();
     front_right = mount_max;
@@ -6992,6 +6977,60 @@ void vehicle::refresh()
     invalidate_mass();
 }
 
+void vehicle::refresh_broken_part( const int p )
+{
+    if( no_refresh ) {
+        return;
+    }
+    const vpart_info &vpi = part_info( p );
+    // These feed totals or affect other parts, so rebuild everything for them
+    if( vpi.has_flag( "EXTRA_DRAG" ) || vpi.has_flag( "POWERED_BY_ENGINE" ) ||
+        vpi.has_flag( "TURRET_CONTROLS" ) || vpi.has_flag( VPFLAG_RAIL ) ) {
+        refresh();
+        return;
+    }
+
+    // refresh() leaves unavailable parts out of every list below, and the mount
+    // bounds and per-point part lists don't depend on damage.
+    for( std::vector<int> *list : {
+             &alternators, &engines, &reactors, &solar_panels, &rotors, &propellers, &wings,
+             &balloons, &converters, &tanks, &droppers, &wind_turbines, &sails, &water_wheels,
+             &funnels, &loose_parts, &emitters, &wheelcache, &steering, &speciality
+         } ) {
+        std::erase( *list, p );
+    }
+    cargo_recharge_targets_dirty = true;
+    cargo_recharge_targets_.clear();
+    refresh_lift_totals();
+
+    refresh_position();
+
+    check_environmental_effects = true;
+    insides_dirty = true;
+    zones_dirty = true;
+    invalidate_mass();
+}
+
+void vehicle::refresh_lift_totals()
+{
+    lift_totals = lift_part_totals();
+    for( const int rotor : rotors ) {
+        const double radius = parts[ rotor ].info().rotor_diameter() / 2.0;
+        lift_totals.rotor_area += M_PI * std::pow( radius, 2 );
+    }
+    for( const int propeller : propellers ) {
+        const double radius = parts[ propeller ].info().propeller_diameter() / 2.0;
+        lift_totals.propeller_area += M_PI * std::pow( radius, 2 );
+    }
+    for( const int balloon : balloons ) {
+        lift_totals.balloon_height += parts[ balloon ].info().balloon_height();
+    }
+    for( const int wing : wings ) {
+        // m^2 area is always 1
+        lift_totals.wing_lift += 0.5 * parts[ wing ].info().lift_coff();
+    }
+}
+
 void vehicle::refresh_position()
 {
     if( !parts.empty() ) {
@@ -7945,7 +7984,7 @@ int vehicle::damage_direct( int p, int dmg, damage_type type )
         coeff_air_changed = true;
 
         // refresh cache in case the broken part has changed the status
-        refresh();
+        refresh_broken_part( p );
     }
 
     if( parts[p].is_fuel_store() ) {
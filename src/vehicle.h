@@ -443,6 +443,8 @@ class vehicle
 
         //Refresh all caches and re-locate all parts
         void refresh();
+        // Same result as refresh() after part p has just broken, without rescanning every part
+        void refresh_broken_part( int p );
 
         // Do stuff like clean up blood and produce smoke from broken parts. Returns false if nothing needs doing.
         bool do_environmental_effects();
@@ -1653,6 +1655,16 @@ class vehicle
         mutable double hull_height = 0.3;
         mutable double hull_area = 0; // total area of hull in m^2
 
+        // Sums over the lifting part lists, rebuilt along with them in refresh()
+        struct lift_part_totals {
+            double rotor_area = 0; // m^2
+            double propeller_area = 0; // m^2
+            double balloon_height = 0;
+            double wing_lift = 0; // lift per (m/s)^2
+        };
+        lift_part_totals lift_totals;
+        void refresh_lift_totals();
+
         // Cached points occupied by the vehicle
         std::set<tripoint_abs_ms> occupied_points;
 
@@ -1881,6 +1893,10 @@ class vehicle
         // refresh().  Gates the cargo recharge loop in process_items_in_vehicle()
         // (analogous to has_autoloaders gating process_autoloaders() in idle()).
         bool has_cargo_recharge = false;
+        // true if any non-broken part has a flag idle() acts on every turn: PLANTER, STEREO,
+        // CHIMES or CRASH_TERRAIN_AROUND; maintained by refresh().  Lets parked vehicles skip
+        // the part scans for them.
+        bool has_idle_effect_parts = false;
         // skidding mode
         bool skidding = false;
         // has bloody or smoking parts
@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "avatar.h"
+#include "cached_options.h"
 #include "character.h"
 #include "coordinates.h"
 #include "cuboid_rectangle.h"
@@ -30,6 +31,7 @@
 #include "messages.h"
 #include "options.h"
 #include "point.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "type_id.h"
@@ -1094,11 +1096,33 @@ std::optional<navigation_step> vehicle::autodrive_controller::compute_next_step(
         data.path.clear();
     }
     if( data.path.empty() ) {
-        auto new_path = compute_path( data.max_speed_tps );
-        while( !new_path && data.max_speed_tps > MIN_SPEED_TPS ) {
-            // high speed didn't work, try a lower speed
-            data.max_speed_tps /= 2;
+        std::optional<std::vector<navigation_step>> new_path;
+        if( parallel_enabled && parallel_autodrive_planning && !is_pool_worker_thread() ) {
+            // Search every speed the serial fallback could try at once, and keep the
+            // fastest that found a path, so a failed high speed search costs no extra time.
+            std::vector<int> speeds = { data.max_speed_tps };
+            while( speeds.back() > MIN_SPEED_TPS ) {
+                speeds.push_back( speeds.back() / 2 );
+            }
+            std::vector<std::optional<std::vector<navigation_step>>> paths( speeds.size() );
+            parallel_for( "autodrive_compute_path", 0, static_cast<int>( speeds.size() ), [&]( int i ) {
+                paths[i] = compute_path( speeds[i] );
+            } );
+            data.max_speed_tps = speeds.back();
+            for( size_t i = 0; i < speeds.size(); i++ ) {
+                if( paths[i] ) {
+                    data.max_speed_tps = speeds[i];
+                    new_path = std::move( paths[i] );
+                    break;
+                }
+            }
+        } else {
             new_path = compute_path( data.max_speed_tps );
+            while( !new_path && data.max_speed_tps > MIN_SPEED_TPS ) {
+                // high speed didn't work, try a lower speed
+                data.max_speed_tps /= 2;
+                new_path = compute_path( data.max_speed_tps );
+            }
         }
         if( !new_path ) {
             return std::nullopt;
@@ -8,13 +8,13 @@
 #include <set>
 #include <memory>
 
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "catacharset.h"
 #include "cursesdef.h"
 #include "debug.h"
 #include "itype.h"
-#include "options.h"
 #include "output.h"
 #include "string_formatter.h"
 #include "translations.h"
@@ -122,7 +122,7 @@ nc_color vehicle::part_color( const int p, const bool exact ) const
     int parm = -1;
 
     //If armoring is present and the option is set, it colors the visible part
-    if( get_option<bool>( "VEHICLE_ARMOR_COLOR" ) ) {
+    if( vehicle_armor_color ) {
         parm = part_with_feature( p, VPFLAG_ARMOR, false );
     }
 
@@ -150,16 +150,35 @@ nc_color vehicle::part_color( const int p, const bool exact ) const
         return col;
     }
 
-    // curtains turn windshields gray
-    int curtains = part_with_feature( p, VPFLAG_CURTAIN, false );
-    if( curtains >= 0 ) {
-        if( part_with_feature( p, VPFLAG_WINDOW, true ) >= 0 && !parts[curtains].open ) {
-            col = part_info( curtains ).color;
+    // One pass over the square for both curtains and cargo, this runs for every drawn tile
+    int curtains = -1;
+    int cargo_part = -1;
+    bool window = false;
+    const auto it = relative_parts.find( parts[p].mount );
+    if( it != relative_parts.end() ) {
+        for( const int i : it->second ) {
+            if( parts[i].removed ) {
+                continue;
+            }
+            const vpart_info &info = part_info( i );
+            const bool broken = parts[i].is_broken();
+            // part_with_feature() would prefer p itself over the rest of the square
+            if( ( curtains < 0 || i == p ) && info.has_flag( VPFLAG_CURTAIN ) ) {
+                curtains = i;
+            }
+            window = window || ( !broken && info.has_flag( VPFLAG_WINDOW ) );
+            if( ( cargo_part < 0 || i == p ) && !broken && info.has_flag( VPFLAG_CARGO ) ) {
+                cargo_part = i;
+            }
         }
     }
 
+    // curtains turn windshields gray
+    if( curtains >= 0 && window && !parts[curtains].open ) {
+        col = part_info( curtains ).color;
+    }
+
     //Invert colors for cargo parts with stuff in them
-    int cargo_part = part_with_feature( p, VPFLAG_CARGO, true );
     if( cargo_part > 0 && !get_items( cargo_part ).empty() ) {
         return invert_color( col );
     } else {
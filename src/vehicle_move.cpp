@@ -385,6 +385,23 @@ void vehicle::stop( bool update_cache )
     }
 }
 
+// Whether part_collision could hit anything at p when not bashing the floor:
+// a creature, another vehicle, or terrain/furniture that is bashable or
+// impassable.  Lets parts moving over open ground skip the full check.
+static auto may_collide_at( const vehicle &veh, const map &here, const tripoint_bub_ms &p,
+                            const Creature *ignored_critter ) -> bool
+{
+    const Creature *critter = g->critter_at( p, true );
+    if( critter != nullptr && critter != ignored_critter ) {
+        return true;
+    }
+    const optional_vpart_position ovp = here.veh_at( p );
+    if( ovp && &ovp->vehicle() != &veh ) {
+        return true;
+    }
+    return here.is_bashable_ter_furn( p, false ) || here.impassable_ter_furn( p );
+}
+
 auto vehicle::collision( const vehicle_collision_options &options ) -> bool
 {
     auto &colls = options.colls;
@@ -450,6 +467,7 @@ auto vehicle::collision( const vehicle_collision_options &options ) -> bool
     int lowest_velocity = coll_velocity;
     const int sign_before = sgn( velocity_before );
     bool empty = true;
+    const map &here = get_map();
     for( int p = 0; static_cast<size_t>( p ) < parts.size(); p++ ) {
         const vpart_info &info = part_info( p );
         if( ( info.location != part_location_structure && !info.has_flag( VPFLAG_EXTENDABLE )
@@ -463,6 +481,9 @@ auto vehicle::collision( const vehicle_collision_options &options ) -> bool
         const auto dsp = bub_ms_location() + dp + tripoint_rel_ms(
                              parts[p].precalc[1],
                              parts[p].mount.z() + parts[p].z_terrain[1] );
+        if( !bash_floor && !may_collide_at( *this, here, dsp, ignored_critter ) ) {
+            continue;
+        }
         auto coll = part_collision( vehicle_part_collision_options{
             .part = p,
             .pos = dsp,
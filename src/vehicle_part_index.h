@@ -0,0 +1,136 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class vehicle;
+
+/**
+ * Which vehicle part sits on each tile of one z-level, as one 32-bit entry per tile:
+ * a vehicle slot in the high half (0 for no vehicle) and the part index in the low half.
+ * Slots are handed out per vehicle and counted per tile, so a slot is reused once no tile
+ * refers to its vehicle any more.  Tiles are numbered like the other level_cache arrays
+ * (level_cache::idx); the owner decides what a tile index means.
+ */
+class vehicle_part_index
+{
+    public:
+        vehicle_part_index() = default;
+        explicit vehicle_part_index( const std::size_t tiles ) : entries_( tiles, 0 ) {}
+
+        auto has( const int i ) const -> bool {
+            return entries_[i] != 0;
+        }
+
+        /** Vehicle and part index on tile @p i, or `{ nullptr, -1 }` */
+        auto get( const int i ) const -> std::pair<vehicle *, int> {
+            const auto entry = entries_[i];
+            if( entry == 0 ) {
+                return { nullptr, -1 };
+            }
+            return { slots_[( entry >> part_bits ) - 1], static_cast<int>( entry & part_mask ) };
+        }
+
+        /** Puts part @p part of @p veh on tile @p i; false if it cannot be packed. */
+        auto set( const int i, vehicle *veh, const int part ) -> bool {
+            if( part < 0 || static_cast<std::uint32_t>( part ) > part_mask ) {
+                return false;
+            }
+            const auto slot = slot_of( veh );
+            if( slot == no_slot ) {
+                return false;
+            }
+            // Count the new reference first: replacing a part of the same vehicle must not
+            // free its slot in between.
+            ++refs_[slot];
+            if( entries_[i] == 0 ) {
+                ++occupied_;
+            } else {
+                release( entries_[i] );
+            }
+            entries_[i] = ( ( slot + 1 ) << part_bits ) | static_cast<std::uint32_t>( part );
+            return true;
+        }
+
+        /** Empties tile @p i if it holds a part of @p veh; returns whether it did. */
+        auto clear_if( const int i, const vehicle *veh ) -> bool {
+            const auto entry = entries_[i];
+            if( entry == 0 || slots_[( entry >> part_bits ) - 1] != veh ) {
+                return false;
+            }
+            release( entry );
+            entries_[i] = 0;
+            --occupied_;
+            return true;
+        }
+
+        auto clear_all() -> void {
+            if( occupied_ != 0 ) {
+                std::fill( entries_.begin(), entries_.end(), 0 );
+            }
+            slots_.clear();
+            refs_.clear();
+            free_slots_.clear();
+            slot_index_.clear();
+            occupied_ = 0;
+        }
+
+        /** Whether any tile holds a part; constant time. */
+        auto any() const -> bool {
+            return occupied_ != 0;
+        }
+
+    private:
+        static constexpr int part_bits = 16;
+        static constexpr std::uint32_t part_mask = ( std::uint32_t{ 1 } << part_bits ) - 1;
+        static constexpr std::uint32_t max_slots = ( std::uint32_t{ 1 } << ( 32 - part_bits ) ) - 1;
+        static constexpr std::uint32_t no_slot = ~std::uint32_t{ 0 };
+
+        auto slot_of( vehicle *veh ) -> std::uint32_t {
+            if( last_veh_ == veh && last_slot_ < slots_.size() && slots_[last_slot_] == veh ) {
+                return last_slot_;
+            }
+            auto slot = no_slot;
+            if( const auto found = slot_index_.find( veh ); found != slot_index_.end() ) {
+                slot = found->second;
+            } else if( !free_slots_.empty() ) {
+                slot = free_slots_.back();
+                free_slots_.pop_back();
+                slots_[slot] = veh;
+                slot_index_.emplace( veh, slot );
+            } else if( slots_.size() < max_slots ) {
+                slot = static_cast<std::uint32_t>( slots_.size() );
+                slots_.push_back( veh );
+                refs_.push_back( 0 );
+                slot_index_.emplace( veh, slot );
+            } else {
+                return no_slot;
+            }
+            last_veh_ = veh;
+            last_slot_ = slot;
+            return slot;
+        }
+
+        /** Drops the reference a tile holding @p entry had on its slot. */
+        auto release( const std::uint32_t entry ) -> void {
+            const auto slot = ( entry >> part_bits ) - 1;
+            if( --refs_[slot] == 0 ) {
+                slot_index_.erase( slots_[slot] );
+                slots_[slot] = nullptr;
+                free_slots_.push_back( slot );
+            }
+        }
+
+        std::vector<std::uint32_t> entries_;
+        std::vector<vehicle *> slots_;
+        std::vector<int> refs_;
+        std::vector<std::uint32_t> free_slots_;
+        std::unordered_map<const vehicle *, std::uint32_t> slot_index_;
+        const vehicle *last_veh_ = nullptr;
+        std::uint32_t last_slot_ = 0;
+        std::size_t occupied_ = 0;
+};
@@ -0,0 +1,3 @@
+// NOLINT(cata-header-guard)
+#define VERSION "fc4179b"
+#define BUILD_TIMESTAMP "2026-10-14-2330"
@@ -1023,8 +1023,11 @@ static int charges_of_internal( const T &self, const M &main, const itype_id &id
                 return qty < limit ? VisitResponse::SKIP : VisitResponse::ABORT;
             }
         }
-        // recurse through any nested containers
-        return qty < limit ? VisitResponse::NEXT : VisitResponse::ABORT;
+        if( qty >= limit ) {
+            return VisitResponse::ABORT;
+        }
+        // recurse only through nested containers that hold the type somewhere
+        return e->contents.has_type_recursive( id ) ? VisitResponse::NEXT : VisitResponse::SKIP;
     } );
 
     if( qty < limit && found_tool_with_UPS ) {
@@ -1149,12 +1152,16 @@ static int amount_of_internal( const T &self, const itype_id &id, bool pseudo, i
                                const std::function<bool( const item & )> &filter )
 {
     int qty = 0;
-    self.visit_items( [&qty, &id, &pseudo, &limit, &filter]( const item * e ) {
-        if( ( id.str() == "any" || e->typeId() == id ) && filter( *e ) && ( pseudo ||
+    const bool any = id.str() == "any";
+    self.visit_items( [&qty, &id, &pseudo, &limit, &filter, any]( const item * e ) {
+        if( ( any || e->typeId() == id ) && filter( *e ) && ( pseudo ||
                 !e->has_flag( STATIC( flag_id( "PSEUDO" ) ) ) ) ) {
             qty = sum_no_wrap( qty, 1 );
         }
-        return qty != limit ? VisitResponse::NEXT : VisitResponse::ABORT;
+        if( qty == limit ) {
+            return VisitResponse::ABORT;
+        }
+        return any || e->contents.has_type_recursive( id ) ? VisitResponse::NEXT : VisitResponse::SKIP;
     } );
     return qty;
 }
@@ -1,6 +1,7 @@
 #include "weather_gen.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <numeric>
 #include <ostream>
@@ -25,6 +26,60 @@ namespace
 constexpr double tau = M_PI * 2;
 // Out of 24 hours
 constexpr double coldest_hour = 5;
+
+// Temperature noise is sampled on a lattice of one overmap tile by one hour and interpolated
+// in between.  Rot catch-up and other out-of-bubble code ask for the same few places and hours
+// over and over, and the noise barely moves over that distance.
+constexpr int noise_lattice_ms = SEEX * 2;
+constexpr size_t noise_cache_size = 4096;
+
+struct noise_sample {
+    point key;
+    int hour = 0;
+    unsigned seed = 0;
+    bool valid = false;
+    float value = 0.0f;
+};
+
+auto temperature_noise_sample( const point &lattice, int hour, unsigned seed ) -> float
+{
+    // Per thread so that workers processing items never share entries
+    thread_local std::array<noise_sample, noise_cache_size> cache;
+    const size_t hash = std::hash<point> {}( lattice ) ^ ( static_cast<size_t>( hour ) * 0x9e3779b9 ) ^
+                        seed;
+    noise_sample &sample = cache[hash % noise_cache_size];
+    if( !sample.valid || sample.key != lattice || sample.hour != hour || sample.seed != seed ) {
+        const double x = lattice.x * noise_lattice_ms / 2000.0;
+        const double y = lattice.y * noise_lattice_ms / 2000.0;
+        const double z = to_days<double>( time_duration::from_hours( hour ) );
+        sample = { lattice, hour, seed, true, raw_noise_4d( x, y, z, seed ) };
+    }
+    return sample.value;
+}
+
+// Same as raw_noise_4d at the lattice points the weather generator feeds it, trilinear in between
+auto temperature_noise( const point_abs_ms &location, const time_point &t, unsigned seed ) -> double
+{
+    const double fx = static_cast<double>( location.x() ) / noise_lattice_ms;
+    const double fy = static_cast<double>( location.y() ) / noise_lattice_ms;
+    const double fh = to_hours<double>( t - calendar::turn_zero );
+    const point lo( static_cast<int>( std::floor( fx ) ), static_cast<int>( std::floor( fy ) ) );
+    const int hour = static_cast<int>( std::floor( fh ) );
+    const double tx = fx - lo.x;
+    const double ty = fy - lo.y;
+    const double th = fh - hour;
+
+    const auto at_hour = [&]( int h ) {
+        const double top = lerp( temperature_noise_sample( lo, h, seed ),
+                                 temperature_noise_sample( lo + point_east, h, seed ), tx );
+        const double bottom = lerp( temperature_noise_sample( lo + point_south, h, seed ),
+                                    temperature_noise_sample( lo + point_south_east, h, seed ), tx );
+        return lerp( top, bottom, ty );
+    };
+    const double now = at_hour( hour );
+    return th == 0.0 ? now : lerp( now, at_hour( hour + 1 ), th );
+}
+
 } //namespace
 
 weather_generator::weather_generator() = default;
@@ -32,6 +87,7 @@ weather_generator::weather_generator() = default;
 int weather_generator::current_winddir = 1000;
 
 struct weather_gen_common {
+    point_abs_ms location;
     double x;
     double y;
     double z;
@@ -46,6 +102,7 @@ static weather_gen_common get_common_data( const point_abs_ms &location, const t
         const calendar_config &calendar_config, unsigned seed )
 {
     weather_gen_common result;
+    result.location = location;
     // Integer x position / widening factor of the Perlin function.
     result.x = location.x() / 2000.0;
     // Integer y position / widening factor of the Perlin function.
@@ -90,10 +147,6 @@ static units::temperature season_temp( const weather_generator &wg, double year_
 static units::temperature weather_temperature_from_common_data( const weather_generator &wg,
         const weather_gen_common &common, const time_point &t )
 {
-    const double x( common.x );
-    const double y( common.y );
-    const double z( common.z );
-
     const unsigned modSEED = common.modSEED;
     const double dayFraction = time_past_midnight( t ) / 1_days;
     // -1 at coldest_hour, +1 twelve hours later
@@ -103,7 +156,8 @@ static units::temperature weather_temperature_from_common_data( const weather_ge
     const double temperature_celsius =
         units::to_celsius<double>( season_factor ) +
         dayv * units::to_celsius<double>( wg.temperature_daily_amplitude ) +
-        raw_noise_4d( x, y, z, modSEED ) * units::to_celsius<double>( wg.temperature_noise_amplitude );
+        temperature_noise( common.location, t, modSEED ) *
+        units::to_celsius<double>( wg.temperature_noise_amplitude );
 
     return units::from_celsius( temperature_celsius );
 }
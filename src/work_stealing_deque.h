@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Bounded Chase-Lev work-stealing deque of raw pointers.
+ *
+ * The owning thread pushes and pops at the bottom without locking; any other
+ * thread may steal from the top.  This follows the C11 formulation from
+ * Lê et al., "Correct and Efficient Work-Stealing for Weak Memory Models"
+ * (PPoPP 2013), minus buffer growth: push() fails when the ring is full so the
+ * caller can fall back to a shared queue instead of reallocating under thieves.
+ *
+ * The deque never owns the pointed-to objects.
+ */
+template<typename T, size_t Capacity = 1024>
+class work_stealing_deque
+{
+        static_assert( Capacity > 0 && ( Capacity & ( Capacity - 1 ) ) == 0,
+                       "work_stealing_deque capacity must be a power of two" );
+
+    public:
+        work_stealing_deque() = default;
+        work_stealing_deque( const work_stealing_deque & ) = delete;
+        auto operator=( const work_stealing_deque & ) -> work_stealing_deque & = delete; // *NOPAD*
+
+        /** Owner thread only.  Returns false (and leaves the deque unchanged) when full. */
+        auto push( T *item ) -> bool {
+            const auto b = bottom_.load( std::memory_order_relaxed );
+            const auto t = top_.load( std::memory_order_acquire );
+            if( b - t >= static_cast<int64_t>( Capacity ) ) {
+                return false;
+            }
+            slots_[b & mask].store( item, std::memory_order_relaxed );
+            // Release on the store itself rather than a standalone fence: same ordering,
+            // and ThreadSanitizer can see it.
+            bottom_.store( b + 1, std::memory_order_release );
+            return true;
+        }
+
+        /** Owner thread only.  Takes the most recently pushed item, or nullptr when empty. */
+        auto pop() -> T * { // *NOPAD*
+            const auto b = bottom_.load( std::memory_order_relaxed ) - 1;
+            bottom_.store( b, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            auto t = top_.load( std::memory_order_relaxed );
+            if( t > b ) {
+                bottom_.store( b + 1, std::memory_order_relaxed );
+                return nullptr;
+            }
+            auto *item = slots_[b & mask].load( std::memory_order_relaxed );
+            if( t == b ) {
+                // Last element: race thieves for it.
+                if( !top_.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed ) ) {
+                    item = nullptr;
+                }
+                bottom_.store( b + 1, std::memory_order_relaxed );
+            }
+            return item;
+        }
+
+        /**
+         * Any thread.  Takes the oldest item, or nullptr when empty or when another
+         * thread won the race for it.
+         */
+        auto steal() -> T * { // *NOPAD*
+            auto t = top_.load( std::memory_order_acquire );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+            const auto b = bottom_.load( std::memory_order_acquire );
+            if( t >= b ) {
+                return nullptr;
+            }
+            auto *item = slots_[t & mask].load( std::memory_order_relaxed );
+            if( !top_.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst,
+                                               std::memory_order_relaxed ) ) {
+                return nullptr;
+            }
+            return item;
+        }
+
+        /** Racy snapshot, for diagnostics only. */
+        auto size_approx() const -> size_t {
+            const auto b = bottom_.load( std::memory_order_relaxed );
+            const auto t = top_.load( std::memory_order_relaxed );
+            return b > t ? static_cast<size_t>( b - t ) : 0;
+        }
+
+    private:
+        static constexpr auto mask = static_cast<int64_t>( Capacity - 1 );
+
+        alignas( 64 ) std::atomic<int64_t> top_ = 0;
+        alignas( 64 ) std::atomic<int64_t> bottom_ = 0;
+        alignas( 64 ) std::array<std::atomic<T *>, Capacity> slots_ = {};
+};
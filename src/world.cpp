@@ -2,12 +2,18 @@
 
 #include <algorithm>
 #include <chrono>
+#include <condition_variable>
 #include <cstring>
+#include <exception>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <ranges>
+#include <span>
 #include <sstream>
 #include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "catacharset.h"
@@ -21,8 +27,14 @@
 #include "worldfactory.h"
 #include "mod_manager.h"
 #include "path_info.h"
+#include "cached_options.h"
 #include "compress.h"
+#include "map_snapshot.h"
+#include "options.h"
+#include "save_dictionary.h"
 #include "sqlite3.h"
+#include "submap_binary.h"
+#include "thread_pool.h"
 #include "zlib.h"
 
 #define dbg(x) DebugLogFL((x),DC::Main)
@@ -102,6 +114,18 @@ auto open_read_db( const std::string &path ) -> sqlite3 *
     return db;
 }
 
+auto query_user_version( sqlite3 *db ) -> uint32_t
+{
+    sqlite3_stmt *stmt = nullptr;
+    if( sqlite3_prepare_v2( db, "PRAGMA user_version", -1, &stmt, nullptr ) != SQLITE_OK ) {
+        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
+        throw std::runtime_error( "DB query failed" );
+    }
+    const auto version = sqlite3_step( stmt ) == SQLITE_ROW ? sqlite3_column_int( stmt, 0 ) : 0;
+    sqlite3_finalize( stmt );
+    return static_cast<uint32_t>( version );
+}
+
 } // namespace
 
 save_t::save_t( const std::string &name ): name( name ) {}
@@ -309,161 +333,311 @@ void load_external_option( const JsonObject &jo )
 namespace
 {
 
-auto file_exist_in_db( sqlite3 *db, const std::string &path ) -> bool
+/**
+ * Prepared statements of one connection.
+ *
+ * Each statement is compiled on first use and reused for the life of the cache,
+ * which must be cleared before the connection is closed.  Statements are keyed
+ * by the address of their SQL text, so callers pass the constants below.
+ */
+class db_statement_cache
 {
-    int fileCount = 0;
-    const char *sql = "SELECT count() FROM files WHERE path = :path";
-    sqlite3_stmt *stmt = nullptr;
+    public:
+        /** Statement borrowed from the cache; reset and unbound again when it goes out of scope. */
+        class lease
+        {
+            public:
+                explicit lease( sqlite3_stmt *stmt ) : stmt_( stmt ) {}
+                ~lease() {
+                    // Resetting also ends the statement's implicit read transaction.
+                    sqlite3_reset( stmt_ );
+                    sqlite3_clear_bindings( stmt_ );
+                }
+                lease( const lease & ) = delete;
+                auto operator=( const lease & ) -> lease & = delete;
 
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
-    }
+                auto get() const -> sqlite3_stmt * {
+                    return stmt_;
+                }
+
+            private:
+                sqlite3_stmt *stmt_;
+        };
+
+        explicit db_statement_cache( sqlite3 *db ) : db_( db ) {}
+        ~db_statement_cache() {
+            clear();
+        }
+        db_statement_cache( const db_statement_cache & ) = delete;
+        auto operator=( const db_statement_cache & ) -> db_statement_cache & = delete;
+
+        auto db() const -> sqlite3 * {
+            return db_;
+        }
+
+        auto get( const char *sql ) -> lease {
+            auto &stmt = statements_[sql];
+            if( stmt == nullptr &&
+                sqlite3_prepare_v3( db_, sql, -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr ) != SQLITE_OK ) {
+                dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db_ ) << '\n';
+                statements_.erase( sql );
+                throw std::runtime_error( "DB query failed" );
+            }
+            return lease( stmt );
+        }
+
+        auto clear() -> void {
+            std::ranges::for_each( statements_, []( const auto & entry ) {
+                sqlite3_finalize( entry.second );
+            } );
+            statements_.clear();
+        }
+
+    private:
+        sqlite3 *db_;
+        std::unordered_map<const char *, sqlite3_stmt *> statements_;
+};
+
+constexpr const char *count_file_sql = "SELECT count() FROM files WHERE path = :path";
+constexpr const char *select_file_sql =
+    "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
+constexpr const char *upsert_file_sql = R"sql(
+        INSERT INTO files(path, parent, data, compression)
+        VALUES (:path, :parent, :data, :compression)
+        ON CONFLICT(path) DO UPDATE
+            SET data = excluded.data,
+                parent = excluded.parent,
+                compression = excluded.compression;
+    )sql";
+
+auto file_exist_in_db( db_statement_cache &statements, const std::string &path ) -> bool
+{
+    sqlite3 *db = statements.db();
+    const auto lease = statements.get( count_file_sql );
+    sqlite3_stmt *stmt = lease.get();
 
     if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
                            SQLITE_TRANSIENT ) != SQLITE_OK ) {
         dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
-        fileCount = sqlite3_column_int( stmt, 0 );
-    } else {
+    if( sqlite3_step( stmt ) != SQLITE_ROW ) {
         dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
         throw std::runtime_error( "DB query failed" );
     }
-
-    sqlite3_finalize( stmt );
-
-    return fileCount > 0;
+    return sqlite3_column_int( stmt, 0 ) > 0;
 }
 
 struct db_write_payload {
     std::string path;
     std::string parent;
     std::vector<std::byte> data;
+    /// Value of the `compression` column; also records the payload format.
+    std::string compression;
 };
 
-auto make_db_write_payload( const std::string &path,
-                            file_write_fn writer ) -> db_write_payload
+auto parent_of( const std::string &path ) -> std::string
 {
-    std::ostringstream oss;
-    writer( oss );
-    auto data = oss.str();
-
-    std::vector<std::byte> compressed_data;
-    zlib_compress( data, compressed_data );
-
     const auto base_pos = path.find_last_of( "/\\" );
-    auto parent = ( base_pos == std::string::npos ) ? "" : path.substr( 0, base_pos );
+    return ( base_pos == std::string::npos ) ? "" : path.substr( 0, base_pos );
+}
+
+struct payload_format {
+    const save_dictionary::dictionary *dictionary = nullptr;
+    std::string compression = "zlib";
+};
 
-    return { .path = path, .parent = parent, .data = compressed_data };
+/** How to compress a blob for @p path that starts with @p head. */
+auto choose_payload_format( const std::string &path, std::string_view head ) -> payload_format
+{
+    // Binary submaps already store each id once, so dictionaries are for JSON blobs only.
+    if( submap_binary::is_encoded( head ) ) {
+        return { .dictionary = nullptr, .compression = std::string( submap_binary::compression_tag ) };
+    }
+    const auto *dictionary = dictionary_save_compression ? save_dictionary::for_path( path ) : nullptr;
+    if( dictionary == nullptr ) {
+        return {};
+    }
+    return {
+        .dictionary = dictionary,
+        .compression = std::string( save_dictionary::compression_prefix ) + dictionary->id,
+    };
 }
 
-auto write_payload_to_db( sqlite3 *db, const db_write_payload &payload ) -> void
+auto make_db_write_payload( const std::string &path, const std::string &data ) -> db_write_payload
 {
-    auto sql = R"sql(
-        INSERT INTO files(path, parent, data, compression)
-        VALUES (:path, :parent, :data, 'zlib')
-        ON CONFLICT(path) DO UPDATE
-            SET data = excluded.data,
-                parent = excluded.parent,
-                compression = excluded.compression;
-    )sql";
+    auto format = choose_payload_format( path, data );
+    std::vector<std::byte> compressed_data;
+    if( format.dictionary != nullptr ) {
+        zlib_compress( data, compressed_data, format.dictionary->data );
+    } else {
+        zlib_compress( data, compressed_data );
+    }
 
-    sqlite3_stmt *stmt = nullptr;
+    return {
+        .path = path,
+        .parent = parent_of( path ),
+        .data = std::move( compressed_data ),
+        .compression = std::move( format.compression ),
+    };
+}
 
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
+/** Serializes straight into the compressor, without an intermediate copy of the blob. */
+auto make_db_write_payload( const std::string &path,
+                            file_write_fn writer ) -> db_write_payload
+{
+    auto payload = db_write_payload{ .path = path, .parent = parent_of( path ), .data = {}, .compression = {} };
+    auto format = payload_format{};
+    zlib_ostreambuf buf( payload.data, [&]( const std::string_view head ) {
+        format = choose_payload_format( path, head );
+        return format.dictionary != nullptr ? std::string_view( format.dictionary->data ) : std::string_view{};
+    } );
+    std::ostream out( &buf );
+    writer( out );
+    if( !out ) {
+        throw std::runtime_error( "Failed to compress " + path );
     }
+    buf.finish();
+    payload.compression = std::move( format.compression );
+    return payload;
+}
+
+/** Upsert every payload through one prepared statement.  Callers own the transaction. */
+auto write_payloads_to_db( db_statement_cache &statements,
+                           std::span<const db_write_payload> payloads ) -> void
+{
+    sqlite3 *db = statements.db();
+    const auto lease = statements.get( upsert_file_sql );
+    sqlite3_stmt *stmt = lease.get();
+    const auto path_index = sqlite3_bind_parameter_index( stmt, ":path" );
+    const auto parent_index = sqlite3_bind_parameter_index( stmt, ":parent" );
+    const auto data_index = sqlite3_bind_parameter_index( stmt, ":data" );
+    const auto compression_index = sqlite3_bind_parameter_index( stmt, ":compression" );
+
+    std::ranges::for_each( payloads, [&]( const db_write_payload & payload ) {
+        // SQLITE_STATIC: the payload outlives the step below.
+        if( sqlite3_bind_text( stmt, path_index, payload.path.c_str(), -1, SQLITE_STATIC ) != SQLITE_OK ||
+            sqlite3_bind_text( stmt, parent_index, payload.parent.c_str(), -1, SQLITE_STATIC ) != SQLITE_OK ||
+            sqlite3_bind_blob( stmt, data_index, payload.data.data(), payload.data.size(),
+                               SQLITE_STATIC ) != SQLITE_OK ||
+            sqlite3_bind_text( stmt, compression_index, payload.compression.c_str(), -1,
+                               SQLITE_STATIC ) != SQLITE_OK ) {
+            dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
 
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), payload.path.c_str(),
-                           -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":parent" ), payload.parent.c_str(),
-                           -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ||
-        sqlite3_bind_blob( stmt, sqlite3_bind_parameter_index( stmt, ":data" ), payload.data.data(),
-                           payload.data.size(), SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameters: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
+        if( sqlite3_step( stmt ) != SQLITE_DONE ) {
+            dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+        sqlite3_reset( stmt );
+    } );
+}
 
-    if( sqlite3_step( stmt ) != SQLITE_DONE ) {
-        dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
-    }
-    sqlite3_finalize( stmt );
+auto write_payload_to_db( db_statement_cache &statements, const db_write_payload &payload ) -> void
+{
+    write_payloads_to_db( statements, std::span( &payload, 1 ) );
 }
 
 auto write_to_db( sqlite3 *db, const std::string &path, file_write_fn writer ) -> void
 {
-    write_payload_to_db( db, make_db_write_payload( path, writer ) );
+    auto statements = db_statement_cache( db );
+    write_payload_to_db( statements, make_db_write_payload( path, writer ) );
 }
 
-auto read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
-                   bool optional ) -> bool
+/// Decodes a `data` column according to its `compression` column into @p out.
+auto decompress_blob( const std::string_view data, const std::string_view compression,
+                      std::string &out ) -> void
 {
-    const char *sql = "SELECT data, compression FROM files WHERE path = :path LIMIT 1";
-
-    sqlite3_stmt *stmt = nullptr;
-
-    if( sqlite3_prepare_v2( db, sql, -1, &stmt, nullptr ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to prepare statement: " << sqlite3_errmsg( db ) << '\n';
-        throw std::runtime_error( "DB query failed" );
+    if( compression.empty() ) {
+        out.assign( data );
+    } else if( compression == "zlib" || compression == submap_binary::compression_tag ) {
+        // The binary submap format is tagged separately but compressed the same way.
+        zlib_decompress( data.data(), static_cast<int>( data.size() ), out );
+    } else if( compression.starts_with( save_dictionary::compression_prefix ) ) {
+        const auto *dictionary = save_dictionary::for_compression( compression );
+        if( dictionary == nullptr ) {
+            throw std::runtime_error( "Missing save dictionary for compression format: " +
+                                      std::string( compression ) );
+        }
+        zlib_decompress( data.data(), static_cast<int>( data.size() ), out, dictionary->data );
+    } else {
+        throw std::runtime_error( "Unknown compression format: " + std::string( compression ) );
     }
+}
 
-    if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
-                           SQLITE_TRANSIENT ) != SQLITE_OK ) {
-        dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
-        sqlite3_finalize( stmt );
-        throw std::runtime_error( "DB query failed" );
+/// Runs @p reader over a blob that outlives the call, such as one in a map_snapshot.
+auto read_blob( const std::string_view data, const std::string_view compression,
+                file_read_fn reader ) -> void
+{
+    if( compression.empty() ) {
+        memory_istreambuf view( data );
+        std::istream stream( &view );
+        reader( stream );
+        return;
     }
+    auto scratch = scratch_buffer();
+    auto &decompressed = scratch.get();
+    decompress_blob( data, compression, decompressed );
+    memory_istreambuf view( decompressed );
+    std::istream stream( &view );
+    reader( stream );
+}
+
+auto read_from_db( db_statement_cache &statements, const std::string &path, file_read_fn reader,
+                   bool optional ) -> bool
+{
+    sqlite3 *db = statements.db();
+    // Decompress first so the statement is reset before the reader runs.  The
+    // per-thread scratch buffer keeps parallel preloads from reallocating it.
+    auto scratch = scratch_buffer();
+    auto &dataString = scratch.get();
+    {
+        const auto lease = statements.get( select_file_sql );
+        sqlite3_stmt *stmt = lease.get();
+
+        if( sqlite3_bind_text( stmt, sqlite3_bind_parameter_index( stmt, ":path" ), path.c_str(), -1,
+                               SQLITE_TRANSIENT ) != SQLITE_OK ) {
+            dbg( DL::Error ) << "Failed to bind parameter: " << sqlite3_errmsg( db ) << '\n';
+            throw std::runtime_error( "DB query failed" );
+        }
+
+        if( sqlite3_step( stmt ) != SQLITE_ROW ) {
+            if( !optional ) {
+                dbg( DL::Error ) << "Failed to execute query: " << sqlite3_errmsg( db ) << '\n';
+                throw std::runtime_error( "DB query failed" );
+            }
+            return false;
+        }
 
-    if( sqlite3_step( stmt ) == SQLITE_ROW ) {
-        // Retrieve the count result
         const void *blobData = sqlite3_column_blob( stmt, 0 );
         int blobSize = sqlite3_column_bytes( stmt, 0 );
         auto compression_raw = sqlite3_column_text( stmt, 1 );
-        std::string compression = compression_raw ? reinterpret_cast<const char *>( compression_raw ) : "";
+        const auto compression = compression_raw ? std::string_view( reinterpret_cast<const char *>
+                                 ( compression_raw ) ) : std::string_view{};
 
         if( blobData == nullptr ) {
-            sqlite3_finalize( stmt );
             return false; // Return an empty string if there's no data
         }
 
-        std::string dataString;
-        if( compression.empty() ) {
-            dataString = std::string( static_cast<const char *>( blobData ), blobSize );
-        } else if( compression == "zlib" ) {
-            zlib_decompress( blobData, blobSize, dataString );
-        } else {
-            throw std::runtime_error( "Unknown compression format: " + compression );
-        }
-
-        std::istringstream stream( dataString );
-        reader( stream );
-        sqlite3_finalize( stmt );
-    } else {
-        auto err = sqlite3_errmsg( db );
-        sqlite3_finalize( stmt );
-
-        if( !optional ) {
-            dbg( DL::Error ) << "Failed to execute query: " << err << '\n';
-            throw std::runtime_error( "DB query failed" );
-        }
-        return false;
+        decompress_blob( std::string_view( static_cast<const char *>( blobData ), blobSize ),
+                         compression, dataString );
     }
 
+    memory_istreambuf view( dataString );
+    std::istream stream( &view );
+    reader( stream );
     return true;
 }
 
+auto read_from_db( sqlite3 *db, const std::string &path, file_read_fn reader,
+                   bool optional ) -> bool
+{
+    auto statements = db_statement_cache( db );
+    return read_from_db( statements, path, reader, optional );
+}
+
 auto read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn reader,
                         bool optional ) -> bool
 {
@@ -475,10 +649,35 @@ auto read_from_db_json( sqlite3 *db, const std::string &path, file_read_json_fn
 
 } // namespace
 
+/**
+ * Map database connection set.
+ *
+ * In background mode write() only serializes on the calling thread.  The
+ * JSON is compressed by a thread pool task and written by a dedicated writer
+ * thread, which owns every transaction and commits whatever is ready in one
+ * batch.  Until a batch commits, reads of its paths are served from the
+ * queued JSON, so callers never see stale rows.  Writes land in the order
+ * write() was called.
+ *
+ * Every connection keeps its statements prepared for its whole life.
+ *
+ * With use_snapshot, reads of rows this session has not written come from a
+ * memory-mapped map_snapshot next to the database.  A stale or missing
+ * snapshot is rebuilt on a background thread while reads fall back to SQLite.
+ */
+struct sqlite_map_db_options {
+    bool background_writes = false;
+    /// Page cache of each connection, in KiB.
+    int cache_size_kib = 0;
+    /// WAL pages between automatic checkpoints.
+    int wal_autocheckpoint = 1000;
+    bool use_snapshot = false;
+};
+
 class sqlite_map_db
 {
     public:
-        explicit sqlite_map_db( const std::string &path );
+        sqlite_map_db( const std::string &path, const sqlite_map_db_options &options );
         ~sqlite_map_db();
 
         sqlite_map_db( const sqlite_map_db & ) = delete;
@@ -492,34 +691,151 @@ class sqlite_map_db
         auto exists( const std::string &path ) const -> bool;
         auto read( const std::string &path, file_read_fn reader, bool optional ) const -> bool;
         auto read_json( const std::string &path, file_read_json_fn reader, bool optional ) const -> bool;
+        /**
+         * Reads every path that exists, in one read transaction.  @p reader gets
+         * the index of the path in @p paths; paths without a row are skipped.
+         */
+        auto read_many( std::span<const std::string> paths,
+                        const std::function<void( std::size_t, std::istream & )> &reader ) const -> void;
+
+        /// Blocks until every queued background write is committed.  Rethrows the first write error.
+        auto flush() -> void;
 
     private:
-        auto read_connection() const -> sqlite3 *;
+        struct reader_connection {
+            sqlite3 *db = nullptr;
+            db_statement_cache statements;
+
+            explicit reader_connection( sqlite3 *db ) : db( db ), statements( db ) {}
+        };
+
+        auto read_connection() const -> reader_connection &;
+        /// Latest queued JSON for @p path, or nullptr if nothing is in flight.
+        auto in_flight( const std::string &path ) const -> std::shared_ptr<const std::string>;
+        auto enqueue( const std::string &path, std::string data ) -> void;
+        auto writer_loop() -> void;
+        /// Snapshot to read @p path from, or nullptr if SQLite has to answer.
+        auto snapshot_for( const std::string &path ) const -> std::shared_ptr<const map_snapshot>;
+        auto start_compaction() -> void;
+        /// Marks the database as changed so older snapshots are rebuilt.  Needs write_mutex_.
+        auto bump_generation() -> void;
 
         std::string path_;
+        int cache_size_kib_ = 0;
         sqlite3 *writer_db_ = nullptr;
+        /// Guarded by write_mutex_.
+        db_statement_cache writer_statements_;
         mutable std::mutex write_mutex_;
         mutable std::mutex readers_mutex_;
-        mutable std::unordered_map<std::thread::id, sqlite3 *> reader_dbs_;
+        mutable std::unordered_map<std::thread::id, std::unique_ptr<reader_connection>> reader_dbs_;
+
+        struct in_flight_entry {
+            uint64_t seq = 0;
+            std::shared_ptr<const std::string> data;
+        };
+
+        bool background_writes_ = false;
+        mutable std::mutex queue_mutex_;
+        std::condition_variable ready_cv_;
+        std::condition_variable written_cv_;
+        /// Sequence number for the next write().
+        uint64_t next_seq_ = 0;
+        /// Every write numbered below this is committed.
+        uint64_t written_seq_ = 0;
+        /// Compressed payloads waiting for their predecessors.
+        std::map<uint64_t, db_write_payload> ready_;
+        std::unordered_map<std::string, in_flight_entry> in_flight_;
+        std::exception_ptr write_error_;
+        bool stopping_ = false;
+        std::thread writer_thread_;
+
+        /// `PRAGMA user_version` at open.
+        uint32_t generation_ = 0;
+        /// Guarded by write_mutex_.
+        bool generation_bumped_ = false;
+        bool use_snapshot_ = false;
+        std::string snapshot_path_;
+        mutable std::mutex snapshot_mutex_;
+        /// Guarded by snapshot_mutex_, as are the two below.
+        std::shared_ptr<const map_snapshot> snapshot_;
+        std::unordered_set<std::string> written_since_snapshot_;
+        /// Read connection of the compaction thread while it runs.
+        sqlite3 *compact_db_ = nullptr;
+        std::thread compact_thread_;
 };
 
-sqlite_map_db::sqlite_map_db( const std::string &path )
+sqlite_map_db::sqlite_map_db( const std::string &path, const sqlite_map_db_options &options )
     : path_( path )
+    , cache_size_kib_( options.cache_size_kib )
     , writer_db_( open_db( path ) )
+    , writer_statements_( writer_db_ )
+    , background_writes_( options.background_writes )
+    , use_snapshot_( options.use_snapshot )
+    , snapshot_path_( path + ".snapshot" )
 {
     exec_sql( writer_db_, "PRAGMA journal_mode=WAL" );
+    // Map saves tolerate losing the last transaction on power loss, not corruption.
+    exec_sql( writer_db_, "PRAGMA synchronous=NORMAL" );
+    exec_sql( writer_db_, string_format( "PRAGMA wal_autocheckpoint=%d",
+                                         options.wal_autocheckpoint ).c_str() );
+    if( cache_size_kib_ > 0 ) {
+        // Negative sizes are in KiB rather than pages.
+        exec_sql( writer_db_, string_format( "PRAGMA cache_size=-%d", cache_size_kib_ ).c_str() );
+    }
+    generation_ = query_user_version( writer_db_ );
+    if( use_snapshot_ ) {
+        auto snapshot = map_snapshot::open( snapshot_path_ );
+        if( snapshot && snapshot->generation() == generation_ ) {
+            snapshot_ = std::move( snapshot );
+        } else {
+            start_compaction();
+        }
+    }
+    if( background_writes_ ) {
+        writer_thread_ = std::thread( [this]() {
+            writer_loop();
+        } );
+    }
 }
 
 sqlite_map_db::~sqlite_map_db()
 {
+    {
+        const auto lock = std::lock_guard<std::mutex>( snapshot_mutex_ );
+        if( compact_db_ != nullptr ) {
+            // The next save rebuilds it anyway.
+            sqlite3_interrupt( compact_db_ );
+        }
+    }
+    if( compact_thread_.joinable() ) {
+        compact_thread_.join();
+    }
+
+    if( writer_thread_.joinable() ) {
+        try {
+            flush();
+        } catch( const std::exception &err ) {
+            dbg( DL::Error ) << "Background map writes failed: " << err.what();
+        }
+        {
+            const auto lock = std::lock_guard<std::mutex>( queue_mutex_ );
+            stopping_ = true;
+        }
+        ready_cv_.notify_all();
+        writer_thread_.join();
+    }
+
     {
         const auto lock = std::lock_guard<std::mutex>( readers_mutex_ );
+        // sqlite3_close() refuses to close a connection with unfinalized statements.
         std::ranges::for_each( reader_dbs_, []( const auto & reader_entry ) {
-            sqlite3_close( reader_entry.second );
+            reader_entry.second->statements.clear();
+            sqlite3_close( reader_entry.second->db );
         } );
         reader_dbs_.clear();
     }
 
+    writer_statements_.clear();
     if( writer_db_ ) {
         sqlite3_close( writer_db_ );
     }
@@ -527,51 +843,302 @@ sqlite_map_db::~sqlite_map_db()
 
 auto sqlite_map_db::begin_transaction() -> void
 {
+    // The writer thread batches background writes into its own transactions.
+    if( background_writes_ ) {
+        return;
+    }
     const auto lock = std::lock_guard<std::mutex>( write_mutex_ );
     exec_sql( writer_db_, "BEGIN TRANSACTION" );
 }
 
 auto sqlite_map_db::commit_transaction() -> void
 {
+    if( background_writes_ ) {
+        // Report an earlier batch's failure without waiting for the current one.
+        auto error = std::exception_ptr{};
+        {
+            const auto lock = std::lock_guard<std::mutex>( queue_mutex_ );
+            error = std::exchange( write_error_, nullptr );
+        }
+        if( error ) {
+            try {
+                std::rethrow_exception( error );
+            } catch( const std::exception &err ) {
+                debugmsg( "Background map write failed: %s", err.what() );
+            }
+        }
+        return;
+    }
     const auto lock = std::lock_guard<std::mutex>( write_mutex_ );
     exec_sql( writer_db_, "COMMIT" );
 }
 
 auto sqlite_map_db::write( const std::string &path, file_write_fn writer ) -> void
 {
+    if( use_snapshot_ ) {
+        const auto lock = std::lock_guard<std::mutex>( snapshot_mutex_ );
+        written_since_snapshot_.insert( path );
+    }
+    if( background_writes_ ) {
+        std::ostringstream oss;
+        writer( oss );
+        enqueue( path, oss.str() );
+        return;
+    }
     const auto payload = make_db_write_payload( path, writer );
     const auto lock = std::lock_guard<std::mutex>( write_mutex_ );
-    write_payload_to_db( writer_db_, payload );
+    bump_generation();
+    write_payload_to_db( writer_statements_, payload );
 }
 
 auto sqlite_map_db::exists( const std::string &path ) const -> bool
 {
-    return file_exist_in_db( read_connection(), path );
+    if( in_flight( path ) ) {
+        return true;
+    }
+    if( const auto snapshot = snapshot_for( path ) ) {
+        return snapshot->find( path ).has_value();
+    }
+    return file_exist_in_db( read_connection().statements, path );
 }
 
 auto sqlite_map_db::read( const std::string &path, file_read_fn reader,
                           bool optional ) const -> bool
 {
-    return read_from_db( read_connection(), path, reader, optional );
+    if( const auto data = in_flight( path ) ) {
+        memory_istreambuf view( *data );
+        std::istream stream( &view );
+        reader( stream );
+        return true;
+    }
+    if( const auto snapshot = snapshot_for( path ) ) {
+        const auto found = snapshot->find( path );
+        if( !found ) {
+            if( !optional ) {
+                dbg( DL::Error ) << "Missing map db row: " << path << '\n';
+                throw std::runtime_error( "DB query failed" );
+            }
+            return false;
+        }
+        if( found->data.empty() ) {
+            return false;
+        }
+        read_blob( found->data, found->compression, reader );
+        return true;
+    }
+    return read_from_db( read_connection().statements, path, reader, optional );
 }
 
 auto sqlite_map_db::read_json( const std::string &path, file_read_json_fn reader,
                                bool optional ) const -> bool
 {
-    return read_from_db_json( read_connection(), path, reader, optional );
+    return read( path, [&]( std::istream & fin ) {
+        JsonIn jsin( fin, path );
+        reader( jsin );
+    }, optional );
 }
 
-auto sqlite_map_db::read_connection() const -> sqlite3 *
+auto sqlite_map_db::read_many( std::span<const std::string> paths,
+                               const std::function<void( std::size_t, std::istream & )> &reader ) const -> void
+{
+    auto from_db = std::vector<std::size_t> {};
+    for( auto i = std::size_t{ 0 }; i < paths.size(); ++i ) {
+        if( const auto data = in_flight( paths[i] ) ) {
+            memory_istreambuf view( *data );
+            std::istream stream( &view );
+            reader( i, stream );
+        } else if( const auto snapshot = snapshot_for( paths[i] ) ) {
+            const auto found = snapshot->find( paths[i] );
+            if( found && !found->data.empty() ) {
+                read_blob( found->data, found->compression, [&]( std::istream & fin ) {
+                    reader( i, fin );
+                } );
+            }
+        } else {
+            from_db.push_back( i );
+        }
+    }
+    if( from_db.empty() ) {
+        return;
+    }
+
+    auto &connection = read_connection();
+    // One snapshot for the whole batch instead of one per statement.
+    exec_sql( connection.db, "BEGIN" );
+    try {
+        std::ranges::for_each( from_db, [&]( const std::size_t i ) {
+            read_from_db( connection.statements, paths[i], [&]( std::istream & fin ) {
+                reader( i, fin );
+            }, true );
+        } );
+    } catch( ... ) {
+        sqlite3_exec( connection.db, "ROLLBACK", nullptr, nullptr, nullptr );
+        throw;
+    }
+    exec_sql( connection.db, "COMMIT" );
+}
+
+auto sqlite_map_db::flush() -> void
+{
+    if( !background_writes_ ) {
+        return;
+    }
+    auto lock = std::unique_lock<std::mutex>( queue_mutex_ );
+    written_cv_.wait( lock, [this]() {
+        return written_seq_ == next_seq_;
+    } );
+    if( write_error_ ) {
+        std::rethrow_exception( std::exchange( write_error_, nullptr ) );
+    }
+}
+
+auto sqlite_map_db::in_flight( const std::string &path ) const -> std::shared_ptr<const std::string>
+{
+    if( !background_writes_ ) {
+        return nullptr;
+    }
+    const auto lock = std::lock_guard<std::mutex>( queue_mutex_ );
+    const auto iter = in_flight_.find( path );
+    return iter == in_flight_.end() ? nullptr : iter->second.data;
+}
+
+auto sqlite_map_db::enqueue( const std::string &path, std::string data ) -> void
+{
+    auto shared = std::make_shared<const std::string>( std::move( data ) );
+    auto seq = uint64_t{ 0 };
+    {
+        const auto lock = std::lock_guard<std::mutex>( queue_mutex_ );
+        seq = next_seq_++;
+        in_flight_.insert_or_assign( path, in_flight_entry{ .seq = seq, .data = shared } );
+    }
+    get_thread_pool().submit( "save_compress", [this, path, shared, seq]() {
+        auto payload = make_db_write_payload( path, *shared );
+        {
+            const auto lock = std::lock_guard<std::mutex>( queue_mutex_ );
+            ready_.emplace( seq, std::move( payload ) );
+        }
+        ready_cv_.notify_one();
+    } );
+}
+
+auto sqlite_map_db::writer_loop() -> void
+{
+    auto lock = std::unique_lock<std::mutex>( queue_mutex_ );
+    while( true ) {
+        ready_cv_.wait( lock, [this]() {
+            return stopping_ || ready_.contains( written_seq_ );
+        } );
+        if( !ready_.contains( written_seq_ ) ) {
+            return;
+        }
+        // Take the longest in-order run; later payloads wait for stragglers.
+        auto batch = std::vector<db_write_payload> {};
+        auto seq = written_seq_;
+        for( auto iter = ready_.find( seq ); iter != ready_.end() && iter->first == seq;
+             iter = ready_.erase( iter ) ) {
+            batch.push_back( std::move( iter->second ) );
+            ++seq;
+        }
+        lock.unlock();
+
+        auto error = std::exception_ptr{};
+        {
+            const auto write_lock = std::lock_guard<std::mutex>( write_mutex_ );
+            try {
+                exec_sql( writer_db_, "BEGIN TRANSACTION" );
+                bump_generation();
+                write_payloads_to_db( writer_statements_, batch );
+                exec_sql( writer_db_, "COMMIT" );
+            } catch( ... ) {
+                error = std::current_exception();
+                sqlite3_exec( writer_db_, "ROLLBACK", nullptr, nullptr, nullptr );
+                // The rollback took the bump with it.
+                generation_bumped_ = false;
+            }
+        }
+
+        lock.lock();
+        std::ranges::for_each( batch, [&]( const db_write_payload & payload ) {
+            // A newer write() of the same path keeps its entry.
+            const auto iter = in_flight_.find( payload.path );
+            if( iter != in_flight_.end() && iter->second.seq < seq ) {
+                in_flight_.erase( iter );
+            }
+        } );
+        if( error && !write_error_ ) {
+            write_error_ = error;
+        }
+        written_seq_ = seq;
+        written_cv_.notify_all();
+    }
+}
+
+auto sqlite_map_db::snapshot_for( const std::string &path ) const ->
+std::shared_ptr<const map_snapshot>
+{
+    if( !use_snapshot_ ) {
+        return nullptr;
+    }
+    const auto lock = std::lock_guard<std::mutex>( snapshot_mutex_ );
+    if( !snapshot_ || written_since_snapshot_.contains( path ) ) {
+        return nullptr;
+    }
+    return snapshot_;
+}
+
+auto sqlite_map_db::start_compaction() -> void
+{
+    auto generation = uint32_t{ 0 };
+    try {
+        compact_db_ = open_read_db( path_ );
+        // Pin the read snapshot now, before this session writes anything.
+        exec_sql( compact_db_, "BEGIN" );
+        generation = query_user_version( compact_db_ );
+    } catch( const std::exception &err ) {
+        dbg( DL::Warn ) << "Failed to start map snapshot compaction: " << err.what();
+        sqlite3_close( compact_db_ );
+        compact_db_ = nullptr;
+        return;
+    }
+    compact_thread_ = std::thread( [this, generation]() {
+        auto snapshot = std::unique_ptr<map_snapshot> {};
+        try {
+            map_snapshot::write( compact_db_, generation, snapshot_path_ );
+            snapshot = map_snapshot::open( snapshot_path_ );
+        } catch( const std::exception &err ) {
+            dbg( DL::Warn ) << "Failed to write map snapshot: " << err.what();
+        }
+        const auto lock = std::lock_guard<std::mutex>( snapshot_mutex_ );
+        sqlite3_exec( compact_db_, "COMMIT", nullptr, nullptr, nullptr );
+        sqlite3_close( compact_db_ );
+        compact_db_ = nullptr;
+        snapshot_ = std::move( snapshot );
+    } );
+}
+
+auto sqlite_map_db::bump_generation() -> void
+{
+    if( std::exchange( generation_bumped_, true ) ) {
+        return;
+    }
+    exec_sql( writer_db_, string_format( "PRAGMA user_version=%d",
+                                         static_cast<int32_t>( generation_ + 1 ) ).c_str() );
+}
+
+auto sqlite_map_db::read_connection() const -> reader_connection &
 {
     const auto lock = std::lock_guard<std::mutex>( readers_mutex_ );
     const auto thread_id = std::this_thread::get_id();
     if( const auto reader_iter = reader_dbs_.find( thread_id ); reader_iter != reader_dbs_.end() ) {
-        return reader_iter->second;
+        return *reader_iter->second;
     }
 
     auto *reader_db = open_read_db( path_ );
-    reader_dbs_.emplace( thread_id, reader_db );
-    return reader_db;
+    if( cache_size_kib_ > 0 ) {
+        exec_sql( reader_db, string_format( "PRAGMA cache_size=-%d", cache_size_kib_ ).c_str() );
+    }
+    return *reader_dbs_.emplace( thread_id,
+                                 std::make_unique<reader_connection>( reader_db ) ).first->second;
 }
 
 world::world( WORLDINFO *info )
@@ -583,7 +1150,13 @@ world::world( WORLDINFO *info )
     }
 
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        map_db = std::make_unique<sqlite_map_db>( info->folder_path() + "/map.sqlite3" );
+        map_db = std::make_unique<sqlite_map_db>( info->folder_path() + "/map.sqlite3",
+        sqlite_map_db_options{
+            .background_writes = get_option<bool>( "BACKGROUND_MAP_WRITES" ),
+            .cache_size_kib = get_option<int>( "MAP_DB_CACHE_SIZE" ) * 1024,
+            .wal_autocheckpoint = get_option<int>( "MAP_DB_WAL_AUTOCHECKPOINT" ),
+            .use_snapshot = get_option<bool>( "MAP_DB_SNAPSHOT" ),
+        } );
     } else {
         if( !assure_dir_exist( "/maps" ) ) {
             dbg( DL::Error ) << "Unable to create or open world directory structure: " << info->folder_path();
@@ -651,6 +1224,13 @@ int64_t world::commit_save_tx()
     return duration;
 }
 
+void world::flush_map_writes()
+{
+    if( map_db ) {
+        map_db->flush();
+    }
+}
+
 /**
  * DOMAIN SPECIFIC: MAP
  */
@@ -720,6 +1300,47 @@ bool world::read_map_omt( const std::string &dim_id, const tripoint_abs_omt &omt
     }
 }
 
+bool world::read_map_omt_data( const std::string &dim_id, const tripoint_abs_omt &omt_addr,
+                               file_read_fn reader ) const
+{
+    const std::string dirname = get_omt_dirname( dim_id, omt_addr );
+    std::string omt_path = dirname + "/" + get_omt_filename( omt_addr );
+
+    if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
+        return map_db->read( omt_path, reader, true );
+    } else {
+        if( !file_exist( omt_path ) ) {
+            // Same locale fallback as read_map_omt().
+            std::ostringstream buf;
+            buf << dirname << "/" << omt_addr.x() << "." << omt_addr.y() << "." << omt_addr.z() << ".map";
+            if( file_exist( buf.str() ) ) {
+                omt_path = buf.str();
+            }
+        }
+        return read_from_file( omt_path, reader, true );
+    }
+}
+
+void world::read_map_omts_data( const std::string &dim_id,
+                                std::span<const tripoint_abs_omt> omt_addrs,
+                                const std::function<void( const tripoint_abs_omt &, std::istream & )> &reader ) const
+{
+    if( info->world_save_format != save_format::V2_COMPRESSED_SQLITE3 ) {
+        std::ranges::for_each( omt_addrs, [&]( const tripoint_abs_omt & omt_addr ) {
+            read_map_omt_data( dim_id, omt_addr, [&]( std::istream & fin ) {
+                reader( omt_addr, fin );
+            } );
+        } );
+        return;
+    }
+    const auto paths = omt_addrs | std::views::transform( [&]( const tripoint_abs_omt & omt_addr ) {
+        return get_omt_dirname( dim_id, omt_addr ) + "/" + get_omt_filename( omt_addr );
+    } ) | std::ranges::to<std::vector>();
+    map_db->read_many( paths, [&]( const std::size_t index, std::istream & fin ) {
+        reader( omt_addrs[index], fin );
+    } );
+}
+
 bool world::write_map_omt( const std::string &dim_id, const tripoint_abs_omt &omt_addr,
                            file_write_fn writer ) const
 {
@@ -785,8 +1406,11 @@ bool world::write_overmap_player_visibility( const std::string &dim_id, const po
 {
     const auto fname = get_overmap_player_filename( dim_id, p );
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, fname, writer );
+        // Serialize and compress outside the lock.
+        const auto payload = make_db_write_payload( fname, writer );
+        const auto lock = std::lock_guard( player_db_write_mutex_ );
+        auto statements = db_statement_cache( get_player_db() );
+        write_payload_to_db( statements, payload );
         return true;
     } else {
         return write_to_player_file( fname, writer );
@@ -879,8 +1503,10 @@ bool world::write_player_mm_omt( const std::string &dim_id, const tripoint_abs_m
 {
     const auto fname = get_mm_filename( dim_id, p );
     if( info->world_save_format == save_format::V2_COMPRESSED_SQLITE3 ) {
-        sqlite3 *playerdb = get_player_db();
-        write_to_db( playerdb, fname, writer );
+        const auto payload = make_db_write_payload( fname, writer );
+        const auto lock = std::lock_guard( player_db_write_mutex_ );
+        auto statements = db_statement_cache( get_player_db() );
+        write_payload_to_db( statements, payload );
         return true;
     } else {
         const std::string mm_dir = get_player_path() + ".mm1/" + dim_prefix_path( dim_id );
@@ -2,6 +2,8 @@
 
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <span>
 #include <string>
 #include "json.h"
 #include "options.h"
@@ -106,6 +108,13 @@ class world
         void release_player_db();
         /**@}*/
 
+        /**
+         * With background map writes enabled, commit_save_tx() returns once the
+         * map data is serialized; compression and database writes finish later.
+         * Blocks until they have landed.  Throws if any of them failed.
+         */
+        void flush_map_writes();
+
         /*
          * Targeted/domain-specific file operations. Different save formats may choose to
          * lay out files differently, so centralize file placement logic here rather than
@@ -117,6 +126,15 @@ class world
 
         bool read_map_omt( const std::string &dim_id, const tripoint_abs_omt &omt_addr,
                            file_read_json_fn reader ) const;
+        /** Like read_map_omt(), but hands over the raw blob, which may be JSON or binary. */
+        bool read_map_omt_data( const std::string &dim_id, const tripoint_abs_omt &omt_addr,
+                                file_read_fn reader ) const;
+        /**
+         * read_map_omt_data() for several omts at once; SQLite saves read them in one
+         * transaction.  @p reader is called for each omt that has saved data.
+         */
+        void read_map_omts_data( const std::string &dim_id, std::span<const tripoint_abs_omt> omt_addrs,
+                                 const std::function<void( const tripoint_abs_omt &, std::istream & )> &reader ) const;
         bool write_map_omt( const std::string &dim_id, const tripoint_abs_omt &omt_addr,
                             file_write_fn writer ) const;
 
@@ -213,6 +231,8 @@ class world
 
         sqlite3 *save_db = nullptr;
         std::string last_save_id = "";
+        /** Serializes writes to save_db; overmaps are saved from several threads at once. */
+        std::mutex player_db_write_mutex_;
         sqlite3 *get_player_db();
 };
 
@@ -26,6 +26,7 @@
 #include <utility>
 
 static const auto act_wait = activity_id("ACT_WAIT");
+static const auto effect_sleep = efftype_id("sleep");
 
 static auto prepare_fixed_window_wait(const time_duration& duration) -> void {
     clear_all_state();
@@ -141,6 +142,31 @@ TEST_CASE(
     CHECK_FALSE(static_cast<bool>(g->u.activity));
 }
 
+TEST_CASE("fixed window activity skip covers sleep", "[activity][fixed_window][sleep]") {
+    const auto no_autosave = override_option("AUTOSAVE", "false");
+    const auto normal_bubble_size =
+        override_option("REALITY_BUBBLE_SIZE", std::to_string(g_reality_bubble_size));
+    const auto no_mobile_bubble = override_option("ACTIVITY_MOBILE_BUBBLE_SIZE", "0");
+    const auto no_idle_bubble = override_option("ACTIVITY_IDLE_BUBBLE_SIZE", "0");
+    const auto no_underground_bubble = override_option("UNDERGROUND_BUBBLE_SIZE", "0");
+    const auto no_vehicle_bubble = override_option("VEHICLE_BUBBLE_SIZE", "0");
+    const auto no_combat_bubble = override_option("COMBAT_BUBBLE_SIZE", "0");
+    prepare_fixed_window_wait(1_minutes);
+    const auto cleanup = on_out_of_scope([]() { clear_all_state(); });
+
+    // Sleep replaces the wait, leaving no activity behind
+    g->u.set_fatigue(static_cast<int>(fatigue_levels::exhausted));
+    g->u.fall_asleep(2_hours);
+    REQUIRE_FALSE((g->u.activity && *g->u.activity));
+
+    const auto start_turn = calendar::turn;
+
+    CHECK_FALSE(g->do_turn());
+
+    CHECK(calendar::turn > start_turn + 1_turns);
+    CHECK(g->u.has_effect(effect_sleep));
+}
+
 TEST_CASE(
     "fixed window activity skip hard blockers fall back to normal turns",
     "[activity][fixed_"
@@ -0,0 +1,211 @@
+#include "cata_dynamic_bitset.h"
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "enum_bitset.h"
+#include "flat_hash_map.h"
+#include "flat_set.h"
+#include "item.h"
+#include "line.h"
+#include "location_vector.h"
+#include "locations.h"
+#include "mtype.h"
+#include "point.h"
+#include "rng.h"
+
+#include <cstddef>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+// Microbenchmarks of the containers and coordinate math most game code sits on, for
+// judging a change to one of them in isolation.  Run with
+//     ./cata_benchmark "[core_benchmark]"
+// or one group with e.g. ./cata_benchmark "[core_benchmark][coordinates]".  Inputs come
+// from a fixed seed, so runs of two builds measure the same work.
+
+namespace {
+
+constexpr auto benchmark_seed = 20261014U;
+
+// Map-square positions spread over a few overmaps, as long-range lookups see them
+auto random_abs_ms(const int count) -> std::vector<tripoint_abs_ms> {
+    rng_set_engine_seed(benchmark_seed);
+    auto points = std::vector<tripoint_abs_ms>();
+    points.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        points.emplace_back(rng(-2000, 2000), rng(-2000, 2000), rng(-10, 10));
+    }
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("cata_dynamic_bitset operations", "[core_benchmark][cata_dynamic_bitset]") {
+    // One bit per tile of the reality bubble
+    constexpr auto bits = std::size_t{132 * 132};
+    auto set = cata_dynamic_bitset(bits);
+    for (std::size_t i = 0; i < bits; i += 3) { set.set(i); }
+
+    BENCHMARK("set and test every bit") {
+        auto b = cata_dynamic_bitset(bits);
+        for (std::size_t i = 0; i < bits; ++i) { b.set(i); }
+        auto n = 0;
+        for (std::size_t i = 0; i < bits; ++i) { n += b.test(i); }
+        return n;
+    };
+    BENCHMARK("any / all / none") { return set.any() + set.all() + set.none(); };
+    BENCHMARK("shift by a row") {
+        auto b = set;
+        b <<= 132;
+        b >>= 132;
+        return b.any();
+    };
+}
+
+TEST_CASE("cata::flat_set operations", "[core_benchmark][flat_set]") {
+    const auto points = random_abs_ms(1000);
+    auto set = cata::flat_set<tripoint_abs_ms>(points.begin(), points.end());
+
+    BENCHMARK("insert 1000 in random order") {
+        auto s = cata::flat_set<tripoint_abs_ms>();
+        for (const auto& p : points) { s.insert(p); }
+        return s.size();
+    };
+    BENCHMARK("construct from 1000") {
+        return cata::flat_set<tripoint_abs_ms>(points.begin(), points.end()).size();
+    };
+    BENCHMARK("count 1000") {
+        auto n = std::size_t{0};
+        for (const auto& p : points) { n += set.count(p); }
+        return n;
+    };
+}
+
+TEST_CASE("coordinate hash containers", "[core_benchmark][flat_hash_map]") {
+    const auto points = random_abs_ms(1000);
+    auto std_map = std::unordered_map<tripoint_abs_ms, int>();
+    auto flat_map = cata::flat_hash_map<tripoint_abs_ms, int>();
+    for (const auto& p : points) {
+        std_map[p] = 1;
+        flat_map[p] = 1;
+    }
+
+    BENCHMARK("std::unordered_map find 1000") {
+        auto n = 0;
+        for (const auto& p : points) { n += std_map.find(p)->second; }
+        return n;
+    };
+    BENCHMARK("cata::flat_hash_map find 1000") {
+        auto n = 0;
+        for (const auto& p : points) { n += flat_map.find(p)->second; }
+        return n;
+    };
+}
+
+TEST_CASE("location_vector operations", "[core_benchmark][location_vector]") {
+    // A pile of loose items, as on a busy map tile
+    constexpr auto pile = 200;
+
+    BENCHMARK_ADVANCED("push_back then remove from the back")(Catch::Benchmark::Chronometer meter) {
+        auto items = location_vector<item>(new fake_item_location());
+        auto spawned = std::vector<detached_ptr<item>>();
+        for (int i = 0; i < pile; ++i) { spawned.push_back(item::spawn("rock")); }
+        meter.measure([&] {
+            for (auto& it : spawned) { items.push_back(std::move(it)); }
+            for (int i = 0; i < pile; ++i) { spawned[i] = items.remove(items.back()); }
+            return items.size();
+        });
+    };
+    BENCHMARK_ADVANCED("iterate")(Catch::Benchmark::Chronometer meter) {
+        auto items = location_vector<item>(new fake_item_location());
+        for (int i = 0; i < pile; ++i) { items.push_back(item::spawn("rock")); }
+        meter.measure([&] {
+            return std::accumulate(items.begin(), items.end(), 0, [](const int n, const item* it) {
+                return n + it->charges;
+            });
+        });
+    };
+}
+
+TEST_CASE("enum_bitset operations", "[core_benchmark][enum_bitset]") {
+    auto a = enum_bitset<mon_trigger>();
+    auto b = enum_bitset<mon_trigger>();
+    a.set(mon_trigger::MEAT).set(mon_trigger::FIRE);
+    b.set(mon_trigger::FIRE).set(mon_trigger::SOUND);
+    const auto& flags = a;
+
+    BENCHMARK("test one flag") { return flags[mon_trigger::FIRE]; };
+    BENCHMARK("intersect and count") {
+        auto c = a;
+        c &= b;
+        return c.count();
+    };
+    BENCHMARK("compare") { return a == b; };
+}
+
+TEST_CASE("coordinate projections", "[core_benchmark][coordinates]") {
+    const auto points = random_abs_ms(1000);
+
+    BENCHMARK("project_to ms -> omt") {
+        auto sum = 0;
+        for (const auto& p : points) { sum += project_to<coords::omt>(p).x(); }
+        return sum;
+    };
+    BENCHMARK("project_to omt -> ms") {
+        auto sum = 0;
+        for (const auto& p : points) {
+            sum += project_to<coords::ms>(tripoint_abs_omt(p.raw())).x();
+        }
+        return sum;
+    };
+    BENCHMARK("project_remain ms -> sm") {
+        auto sum = 0;
+        for (const auto& p : points) {
+            const auto remain = project_remain<coords::sm>(p);
+            sum += remain.quotient.x() + remain.remainder_tripoint.x();
+        }
+        return sum;
+    };
+    BENCHMARK("project_remain ms -> om") {
+        auto sum = 0;
+        for (const auto& p : points) {
+            const auto remain = project_remain<coords::om>(p);
+            sum += remain.quotient.x() + remain.remainder_tripoint.x();
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("line math", "[core_benchmark][line]") {
+    const auto points = random_abs_ms(1000);
+
+    BENCHMARK("rl_dist 1000 pairs") {
+        auto sum = 0;
+        for (std::size_t i = 1; i < points.size(); ++i) { sum += rl_dist(points[i - 1], points[i]); }
+        return sum;
+    };
+    BENCHMARK("square_dist 1000 pairs") {
+        auto sum = 0;
+        for (std::size_t i = 1; i < points.size(); ++i) {
+            sum += square_dist(points[i - 1], points[i]);
+        }
+        return sum;
+    };
+    BENCHMARK("bresenham 2D, 60 tiles") {
+        auto n = 0;
+        bresenham(point_zero, point(60, 23), 0, [&](const point&) {
+            ++n;
+            return true;
+        });
+        return n;
+    };
+    BENCHMARK("bresenham 3D, 60 tiles") {
+        auto n = 0;
+        bresenham(tripoint_zero, tripoint(60, 23, 5), 0, 0, [&](const tripoint&) {
+            ++n;
+            return true;
+        });
+        return n;
+    };
+    BENCHMARK("line_to 3D, 60 tiles") { return line_to(tripoint_zero, tripoint(60, 23, 5)).size(); };
+}
@@ -0,0 +1,342 @@
+#include "alloc_profiling.h"
+#include "avatar.h"
+#include "cached_options.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "field.h"
+#include "field_type.h"
+#include "frame_timing.h"
+#include "fstream_utils.h"
+#include "game.h"
+#include "item.h"
+#include "json.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mapbuffer.h"
+#include "mapbuffer_registry.h"
+#include "mapdata.h"
+#include "output.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "submap_load_manager.h"
+#include "type_id.h"
+#include "vehicle.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Turn throughput of game::do_turn on fixed scenarios, for comparing builds.  Run with
+//     ./cata_benchmark
+// or a single scenario with e.g. ./cata_benchmark "[horde_siege]".  Every scenario
+// starts from the same seed and plays CATA_BENCHMARK_TURNS turns (default 200) with
+// the avatar passing each turn.  The exclusive time of each do_turn phase is written
+// as JSON to CATA_BENCHMARK_JSON, or to stdout when it isn't set.  Built with
+// CATA_ALLOC_PROFILING, allocations per turn are reported too, by phase and by thread.
+
+namespace {
+
+constexpr auto benchmark_seed = 20261014U;
+constexpr auto default_turns = 200;
+
+const auto secondary_dimensions =
+    std::vector<dimension_id>{dimension_id("benchmark_dim_a"), dimension_id("benchmark_dim_b"),
+                              dimension_id("benchmark_dim_c")};
+
+using clock_type = std::chrono::steady_clock;
+
+struct scenario_result {
+    std::string name;
+    int turns = 0;
+    double seconds = 0.0;
+    // Exclusive milliseconds of each do_turn phase, summed over all turns
+    std::map<std::string, double> phase_ms;
+    // With CATA_ALLOC_PROFILING: main thread allocations of each phase, and those of
+    // every thread during do_turn, by alloc_profiling slot
+    std::map<std::string, alloc_profiling::counts> phase_allocs;
+    std::vector<alloc_profiling::counts> thread_allocs;
+};
+
+auto results = std::vector<scenario_result>{};
+
+auto benchmark_turns() -> int {
+    const auto* const env_turns = std::getenv("CATA_BENCHMARK_TURNS");
+    if (env_turns == nullptr || env_turns[0] == '\0') { return default_turns; }
+    return std::max(1, std::atoi(env_turns));
+}
+
+/// Allocations by every thread during the turns of @p result.
+auto allocations_of(const scenario_result& result) -> alloc_profiling::counts {
+    auto sum = alloc_profiling::counts();
+    for (const auto& allocs : result.thread_allocs) { sum += allocs; }
+    return sum;
+}
+
+auto write_counts(JsonOut& json, const alloc_profiling::counts& allocs, const int turns) -> void {
+    json.start_object();
+    json.member("allocations_per_turn", static_cast<double>(allocs.allocations) / turns);
+    json.member("bytes_per_turn", static_cast<double>(allocs.bytes) / turns);
+    json.end_object();
+}
+
+/// Plays the turns of scenario @p name, calling @p before_turn ahead of each one.
+auto run_turns(const std::string& name, const std::function<void()>& before_turn = [] {})
+    -> void {
+    const auto turns = benchmark_turns();
+    auto result = scenario_result{.name = name};
+    g->new_game = false;
+    frame_timing::set_enabled(true);
+    for (auto turn = 0; turn < turns; ++turn) {
+        before_turn();
+        // The avatar passes, so handle_action never waits for input.
+        g->u.set_moves(0);
+        const auto threads_before = alloc_profiling::per_thread();
+        const auto start = clock_type::now();
+        const auto game_over = g->do_turn();
+        result.seconds += std::chrono::duration<double>(clock_type::now() - start).count();
+        const auto threads_after = alloc_profiling::per_thread();
+        frame_timing::end_frame();
+        const auto& sample = frame_timing::history().samples().back();
+        for (const auto& [phase, ms] : sample.phase_ms) { result.phase_ms[phase] += ms; }
+        for (const auto& [phase, allocs] : sample.phase_allocs) {
+            result.phase_allocs[phase] += allocs;
+        }
+        result.thread_allocs.resize(threads_after.size());
+        for (std::size_t i = 0; i < threads_after.size(); ++i) {
+            const auto before =
+                i < threads_before.size() ? threads_before[i] : alloc_profiling::counts();
+            result.thread_allocs[i] += threads_after[i] - before;
+        }
+        ++result.turns;
+        if (game_over) { break; }
+    }
+    frame_timing::set_enabled(false);
+    WARN(string_format("%s: %.1f turns/s (%d turns, %.3f s)", name,
+                       result.turns / std::max(result.seconds, 1e-9), result.turns,
+                       result.seconds));
+    if constexpr (alloc_profiling::compiled_in) {
+        const auto allocs = allocations_of(result);
+        WARN(string_format("%s: %.0f allocations, %.0f bytes per turn", name,
+                           static_cast<double>(allocs.allocations) / result.turns,
+                           static_cast<double>(allocs.bytes) / result.turns));
+    }
+    results.push_back(std::move(result));
+}
+
+auto write_report(std::ostream& out) -> void {
+    auto json = JsonOut(out, true);
+    json.start_object();
+    json.member("seed", benchmark_seed);
+    json.member("turns", benchmark_turns());
+    if constexpr (alloc_profiling::compiled_in) {
+        // Which of thread_allocations is the thread playing the turns
+        json.member("main_thread_slot", alloc_profiling::this_thread_slot());
+    }
+    json.member("scenarios");
+    json.start_array();
+    for (const auto& result : results) {
+        json.start_object();
+        json.member("name", result.name);
+        json.member("turns", result.turns);
+        json.member("seconds", result.seconds);
+        json.member("turns_per_second", result.turns / std::max(result.seconds, 1e-9));
+        json.member("phase_ms");
+        json.start_object();
+        for (const auto& [phase, ms] : result.phase_ms) { json.member(phase, ms); }
+        json.end_object();
+        if constexpr (alloc_profiling::compiled_in) {
+            json.member("allocations");
+            write_counts(json, allocations_of(result), result.turns);
+            json.member("phase_allocations");
+            json.start_object();
+            for (const auto& [phase, allocs] : result.phase_allocs) {
+                json.member(phase);
+                write_counts(json, allocs, result.turns);
+            }
+            json.end_object();
+            json.member("thread_allocations");
+            json.start_array();
+            for (const auto& allocs : result.thread_allocs) {
+                write_counts(json, allocs, result.turns);
+            }
+            json.end_array();
+        }
+        json.end_object();
+    }
+    json.end_array();
+    json.end_object();
+    out << '\n';
+}
+
+class turn_benchmark_listener : public Catch::TestEventListenerBase {
+  public:
+    using TestEventListenerBase::TestEventListenerBase;
+
+    void testRunEnded(const Catch::TestRunStats& stats) override {
+        if (!results.empty()) {
+            const auto* const path = std::getenv("CATA_BENCHMARK_JSON");
+            if (path != nullptr && path[0] != '\0') {
+                write_to_file(path, [](std::ostream& out) { write_report(out); });
+            } else {
+                auto out = std::ostringstream();
+                write_report(out);
+                cata_printf("%s", out.str());
+            }
+        }
+        TestEventListenerBase::testRunEnded(stats);
+    }
+};
+
+auto start_scenario() -> void {
+    clear_all_state();
+    rng_set_engine_seed(benchmark_seed);
+}
+
+/// Fills the square ring at Chebyshev distance @p radius around @p center with @p terrain.
+auto build_ring(const tripoint_bub_ms& center, const int radius, const ter_id& terrain) -> void {
+    auto& here = get_map();
+    for (auto d = -radius; d <= radius; ++d) {
+        here.ter_set(center + tripoint_rel_ms(d, -radius, 0), terrain);
+        here.ter_set(center + tripoint_rel_ms(d, radius, 0), terrain);
+        here.ter_set(center + tripoint_rel_ms(-radius, d, 0), terrain);
+        here.ter_set(center + tripoint_rel_ms(radius, d, 0), terrain);
+    }
+}
+
+auto add_fire(submap& sm, const point_sm_ms& local) -> void {
+    if (sm.get_field(local).add_field(fd_fire, 3, 0_turns)) {
+        ++sm.field_count;
+        sm.field_cache.push_back(local);
+        sm.is_uniform = false;
+        sm.get_field(local).find_field(fd_fire)->set_field_age(-10_minutes);
+    }
+}
+
+} // namespace
+
+CATCH_REGISTER_LISTENER(turn_benchmark_listener)
+
+TEST_CASE("turn throughput idle in the wilderness", "[turn_benchmark][idle_wilderness]") {
+    start_scenario();
+    run_turns("idle wilderness");
+    clear_all_state();
+}
+
+TEST_CASE("turn throughput under horde siege", "[turn_benchmark][horde_siege]") {
+    start_scenario();
+    const auto center = g->u.bub_pos();
+    build_ring(center, 5, ter_id("t_wall_metal"));
+    for (auto dx = -30; dx <= 30; dx += 6) {
+        for (auto dy = -30; dy <= 30; dy += 6) {
+            if (std::max(std::abs(dx), std::abs(dy)) < 18) { continue; }
+            spawn_test_monster("mon_zombie", center + tripoint_rel_ms(dx, dy, 0));
+        }
+    }
+    run_turns("horde siege");
+    clear_all_state();
+}
+
+TEST_CASE("turn throughput in a big base", "[turn_benchmark][big_base]") {
+    start_scenario();
+    auto& here = get_map();
+    const auto center = g->u.bub_pos();
+    constexpr auto radius = 20;
+    for (const auto& p : here.points_in_radius(center, radius)) {
+        here.ter_set(p, ter_id("t_floor"));
+    }
+    build_ring(center, radius, ter_id("t_wall"));
+    // A rack with a few items every other tile, and a light every fourth rack
+    auto racks = 0;
+    for (auto dx = -radius + 2; dx <= radius - 2; dx += 2) {
+        for (auto dy = -radius + 2; dy <= radius - 2; dy += 2) {
+            const auto p = center + tripoint_rel_ms(dx, dy, 0);
+            if (p == center) { continue; }
+            here.furn_set(p, furn_id("f_rack"));
+            for (const auto* const id : {"meat_cooked", "rock", "hammer"}) {
+                here.add_item(p, item::spawn(itype_id(id), calendar::turn));
+            }
+            if (++racks % 4 == 0) {
+                auto light = item::spawn(itype_id("candle_lit"), calendar::turn);
+                light->activate();
+                here.add_item(p, std::move(light));
+            }
+        }
+    }
+    run_turns("big base");
+    clear_all_state();
+}
+
+TEST_CASE("turn throughput driving down a highway", "[turn_benchmark][highway_drive]") {
+    start_scenario();
+    auto& here = get_map();
+    const auto start = g->u.bub_pos() + tripoint_rel_ms(-40, 0, 0);
+    for (auto x = 0; x < MAPSIZE_X; ++x) {
+        for (auto dy = -4; dy <= 4; ++dy) {
+            here.ter_set(tripoint_bub_ms(x, start.y() + dy, 0), ter_id("t_pavement"));
+        }
+    }
+    auto* const veh = here.add_vehicle(vproto_id("car"), start, 0_degrees, 100, 0);
+    REQUIRE(veh != nullptr);
+    const auto controls = veh->get_avail_parts("CONTROLS");
+    REQUIRE(controls.begin() != controls.end());
+    const auto seat = veh->bub_part_location((*controls.begin()).part_index());
+    g->u.setpos(seat);
+    here.board_vehicle(seat, &g->u);
+    REQUIRE(g->u.in_vehicle);
+    g->u.controlling_vehicle = true;
+    veh->engine_on = true;
+    veh->cruise_velocity = std::min(2235, veh->safe_ground_velocity(false));
+    veh->velocity = veh->cruise_velocity;
+
+    // Holding cruise control, which handle_action would otherwise do each turn
+    run_turns("highway drive", [veh]() { veh->thrust(0); });
+    here.unboard_vehicle(g->u.bub_pos());
+    clear_all_state();
+}
+
+TEST_CASE("turn throughput with pocket dimensions", "[turn_benchmark][multi_dimension]") {
+    start_scenario();
+    auto restore_level = restore_on_out_of_scope<pocket_sim_level>(pocket_simulation_level);
+    pocket_simulation_level = pocket_sim_level::full;
+
+    // A 4x4 submap area per dimension, away from the avatar and each with a few fires
+    const auto area_begin = point_abs_sm(400, 400);
+    const auto area_end = area_begin + point_rel_sm(3, 3);
+    auto handles = std::vector<load_request_handle>{};
+    for (const auto& dim_id : secondary_dimensions) {
+        handles.push_back(submap_loader.request_load(load_request_source::reality_bubble, dim_id,
+                                                     area_begin, area_end));
+        auto& dim = MAPBUFFER_REGISTRY.get(dim_id);
+        for (auto x = area_begin.x(); x <= area_end.x(); ++x) {
+            for (auto y = area_begin.y(); y <= area_end.y(); ++y) {
+                const auto pos = tripoint_abs_sm(x, y, 0);
+                auto sm = std::make_unique<submap>(pos, dim_id);
+                dim.add_submap(pos, sm);
+                if ((x + y) % 2 == 0) { add_fire(*dim.lookup_submap_in_memory(pos), {5, 5}); }
+            }
+        }
+    }
+    const auto cleanup = on_out_of_scope([&]() {
+        std::ranges::for_each(handles,
+                              [](const load_request_handle h) { submap_loader.release_load(h); });
+        std::ranges::for_each(secondary_dimensions, [](const dimension_id& dim_id) {
+            MAPBUFFER_REGISTRY.unload_dimension(dim_id);
+        });
+    });
+
+    run_turns("multi-dimension");
+    clear_all_state();
+}
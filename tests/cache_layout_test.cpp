@@ -0,0 +1,60 @@
+#include "cache_layout.h"
+#include "catch/catch.hpp"
+#include "game_constants.h"
+#include "point.h"
+
+#include <vector>
+
+namespace {
+
+constexpr auto grid_submaps = 5;
+constexpr auto base_shape = cache_layout::grid_shape{SEEX * grid_submaps, SEEY * grid_submaps};
+
+auto check_bijection(const cache_layout::grid_shape& shape) -> void {
+    auto seen = std::vector<bool>(static_cast<size_t>(shape.sx * shape.sy), false);
+    for (auto x = 0; x < shape.sx; ++x) {
+        for (auto y = 0; y < shape.sy; ++y) {
+            const auto i = cache_layout::index(x, y, shape);
+            INFO("tile " << x << "," << y << " origin " << shape.origin.x << "," << shape.origin.y);
+            REQUIRE(i >= 0);
+            REQUIRE(i < shape.sx * shape.sy);
+            CHECK_FALSE(seen[static_cast<size_t>(i)]);
+            seen[static_cast<size_t>(i)] = true;
+            CHECK(cache_layout::point_at(i, shape) == point(x, y));
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("cache_layout_index_round_trips", "[cache_layout]") {
+    check_bijection(base_shape);
+    check_bijection(base_shape.shifted(point(2, 4)));
+    check_bijection(base_shape.shifted(point(-1, -3)));
+}
+
+TEST_CASE("cache_layout_shifted_origin_wraps", "[cache_layout]") {
+    CHECK(base_shape.shifted(point(1, -1)).origin == point(1, grid_submaps - 1));
+    CHECK(base_shape.shifted(point(grid_submaps, 0)).origin == point_zero);
+    CHECK(base_shape.shifted(point(1, 1)).shifted(point(-1, -1)).origin == point_zero);
+}
+
+TEST_CASE("cache_layout_shift_keeps_storage_of_remaining_tiles", "[cache_layout]") {
+    if constexpr (!cache_layout::tiled) {
+        SUCCEED("the linear layout copies on shift");
+        return;
+    }
+    // map::shift moves the origin by the submap shift: the tile that moves to (x, y)
+    // must still be stored where it was.
+    const auto by = point(1, -1);
+    const auto after = base_shape.shifted(by);
+    for (auto x = 0; x < base_shape.sx; ++x) {
+        for (auto y = 0; y < base_shape.sy; ++y) {
+            const auto from = point(x + by.x * SEEX, y + by.y * SEEY);
+            if (from.x < 0 || from.y < 0 || from.x >= base_shape.sx || from.y >= base_shape.sy) {
+                continue;
+            }
+            CHECK(cache_layout::index(x, y, after) == cache_layout::index(from.x, from.y, base_shape));
+        }
+    }
+}
@@ -2,7 +2,9 @@
 #include "catch/catch.hpp"
 #include "item.h"
 
+#include <algorithm>
 #include <atomic>
+#include <functional>
 #include <ranges>
 #include <thread>
 #include <vector>
@@ -43,3 +45,21 @@ TEST_CASE("item arena cleanup tolerates concurrent destruction", "[arena]") {
 
     SUCCEED("concurrent item destruction and arena cleanup completed");
 }
+
+TEST_CASE("item arena hands out a fresh batch in address order", "[arena]") {
+    while (cata_arena<item>::cleanup()) {}
+
+    // A new thread starts with an empty free list, so its first items come from one batch.
+    auto addresses = std::vector<const item*>{};
+    auto worker = std::thread([&addresses]() {
+        for (auto i = 0; i < 64; ++i) {
+            auto* const it = new item();
+            addresses.push_back(it);
+            cata_arena<item>::mark_for_destruction(it);
+        }
+    });
+    worker.join();
+    while (cata_arena<item>::cleanup()) {}
+
+    CHECK(std::ranges::is_sorted(addresses, std::less<>()));
+}
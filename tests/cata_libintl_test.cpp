@@ -471,6 +471,21 @@ TEST_CASE("single_mo_strings", "[libintl][i18n]") {
         list.push_back(trans_catalogue::load_from_file(mo_dir + "single_ru_big_endian.mo"));
         trans_library lib = trans_library::create(std::move(list));
 
+        test_get_strings(lib);
+    }
+    SECTION("File without hash table") {
+        std::stringstream buffer;
+        buffer << cata_ifstream()
+                      .mode(cata_ios_mode::binary)
+                      .open(mo_dir + "single_ru_little_endian.mo")
+                      ->rdbuf();
+        std::string data = buffer.str();
+        // Hash table size lives at offset 20; 0 means the file has none.
+        std::fill_n(data.begin() + 20, 4, '\0');
+        std::vector<trans_catalogue> list;
+        list.push_back(trans_catalogue::load_from_memory(std::move(data)));
+        trans_library lib = trans_library::create(std::move(list));
+
         test_get_strings(lib);
     }
 }
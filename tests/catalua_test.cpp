@@ -1,5 +1,6 @@
 #include "avatar.h"
 #include "bionics.h"
+#include "cached_options.h"
 #include "calendar.h"
 #include "cata_utility.h"
 #include "catacharset.h"
@@ -7,6 +8,7 @@
 #include "catalua_coord.h"
 #include "catalua_hooks.h"
 #include "catalua_impl.h"
+#include "catalua_loader.h"
 #include "catalua_serde.h"
 #include "catalua_sol.h"
 #include "catch/catch.hpp"
@@ -17,6 +19,7 @@
 #include "debug.h"
 #include "effect.h"
 #include "faction.h"
+#include "filesystem.h"
 #include "flag.h"
 #include "fstream_utils.h"
 #include "game.h"
@@ -47,6 +50,7 @@
 #include "vehicle.h"
 #include "vehicle_part.h"
 
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <stdexcept>
@@ -136,6 +140,36 @@ test_data["item_count"] = #map:get_items_at(test_data["pos"])
     here.i_clear(pos);
 }
 
+TEST_CASE("lua_map_reads_and_writes_terrain_by_rectangle", "[lua][map]") {
+    clear_all_state();
+    auto lua = make_lua_state();
+    auto test_data = lua.create_table();
+    lua.globals()["test_data"] = test_data;
+
+    const auto from = get_avatar().bub_pos() + tripoint_rel_ms(2, 2, 0);
+    test_data["from"] = from;
+    test_data["to"] = from + tripoint_rel_ms(2, 1, 0);
+
+    const auto script_res = lua.safe_script(
+        R"(
+local map = gapi.get_map()
+local ids = map:get_ter_in_rect(test_data["from"], test_data["to"])
+test_data["count"] = #ids
+ids[1] = TerId.new("t_rock_floor"):int_id()
+ids[6] = TerId.new("t_dirt"):int_id()
+map:set_ter_in_rect(test_data["from"], test_data["to"], ids)
+test_data["too_few_ok"] = pcall(function() map:set_ter_in_rect(test_data["from"], test_data["to"], { ids[1] }) end)
+)",
+        sol::script_pass_on_error);
+    REQUIRE(script_res.valid());
+
+    auto& here = get_map();
+    CHECK(test_data.get<int>("count") == 6);
+    CHECK(here.ter(from) == ter_id("t_rock_floor"));
+    CHECK(here.ter(from + tripoint_rel_ms(2, 1, 0)) == ter_id("t_dirt"));
+    CHECK_FALSE(test_data.get<bool>("too_few_ok"));
+}
+
 TEST_CASE("item_lua_invoke_at_invokes_use_action", "[lua][item]") {
     auto lua = make_lua_state();
     lua["invoke_pos"] = get_avatar().bub_pos();
@@ -342,6 +376,97 @@ TEST_CASE("lua_activity_bindings", "[lua]") {
     CHECK(test_data.get<int>("finish_nested_charges") == 7);
 }
 
+TEST_CASE("lua_on_every_x_hooks_fire_when_the_turn_crosses_their_interval", "[lua]") {
+    clear_all_state();
+    auto& state = *DynamicDataLoader::get_instance().lua;
+    cata::init_global_state_tables(state, {});
+    sol::state& lua = state.lua;
+    lua.script(R"(
+        fired = 0
+        gapi.add_on_every_x_hook(TimeDuration.from_turns(10), function() fired = fired + 1 end)
+    )");
+
+    const auto start = calendar::turn;
+    calendar::turn = calendar::turn_zero + time_duration::from_turns(95);
+    for (auto i = 0; i < 30; ++i) {
+        cata::run_on_every_x_hooks(state);
+        calendar::turn += 1_turns;
+    }
+    // Turns 100, 110 and 120
+    CHECK(lua.get<int>("fired") == 3);
+
+    // Going back to an earlier turn, as loading an older save does, replans the next due turn
+    calendar::turn = calendar::turn_zero + time_duration::from_turns(40);
+    cata::run_on_every_x_hooks(state);
+    CHECK(lua.get<int>("fired") == 4);
+    calendar::turn = start;
+}
+
+TEST_CASE("lua_tasks_run_a_step_at_a_time_and_can_be_cancelled", "[lua]") {
+    clear_all_state();
+    auto& state = *DynamicDataLoader::get_instance().lua;
+    cata::init_global_state_tables(state, {});
+    sol::state& lua = state.lua;
+    const auto old_budget = lua_task_budget_us;
+    lua_task_budget_us = 0;
+    lua.script(R"(
+        progress = {}
+        result = nil
+        cancelled = false
+        gapi.add_task(function()
+            for i = 1, 3 do coroutine.yield(i) end
+            return "done"
+        end, {
+            on_progress = function(p) progress[#progress + 1] = p end,
+            on_done = function(r) result = r end,
+        })
+        endless = gapi.add_task(function()
+            while true do coroutine.yield() end
+        end, { on_cancel = function() cancelled = true end })
+    )");
+    CHECK(lua.script("return gapi.task_count()").get<int>() == 2);
+
+    // With no budget, every call runs a single step and the tasks take turns
+    cata::run_lua_tasks(state);
+    cata::run_lua_tasks(state);
+    cata::run_lua_tasks(state);
+    CHECK(lua.script("return #progress").get<int>() == 2);
+
+    lua.script("assert(gapi.cancel_task(endless))");
+    for (auto i = 0; i < 4; ++i) {
+        cata::run_lua_tasks(state);
+    }
+    CHECK(lua.get<bool>("cancelled"));
+    CHECK(lua.get<std::string>("result") == "done");
+    CHECK(lua.script("return progress[3]").get<int>() == 3);
+    CHECK(lua.script("return gapi.task_count()").get<int>() == 0);
+    CHECK_FALSE(lua.script("return gapi.cancel_task(endless)").get<bool>());
+    lua_task_budget_us = old_budget;
+}
+
+TEST_CASE("lua_examine_callbacks_are_looked_up_once", "[lua]") {
+    clear_all_state();
+    auto& state = *DynamicDataLoader::get_instance().lua;
+    cata::init_global_state_tables(state, {});
+    sol::state& lua = state.lua;
+    lua.script(R"(
+        examined = 0
+        game.examine_functions["TEST_EXAMINE"] = function() examined = examined + 1 end
+    )");
+
+    cata::run_lua_examine("TEST_EXAMINE", get_avatar(), tripoint_bub_ms(60, 60, 0));
+    // Clearing the table entry shows the second call didn't look it up again
+    lua.script(R"(game.examine_functions["TEST_EXAMINE"] = nil)");
+    cata::run_lua_examine("TEST_EXAMINE", get_avatar(), tripoint_bub_ms(60, 60, 0));
+    CHECK(lua.get<int>("examined") == 2);
+
+    // Reinitializing the state tables drops what was looked up
+    cata::init_global_state_tables(state, {});
+    lua.script(R"(game.examine_functions["TEST_EXAMINE"] = function() examined = 10 end)");
+    cata::run_lua_examine("TEST_EXAMINE", get_avatar(), tripoint_bub_ms(60, 60, 0));
+    CHECK(lua.get<int>("examined") == 10);
+}
+
 TEST_CASE("lua_activity_without_callback_finishes", "[lua]") {
     clear_all_state();
     auto act = std::make_unique<player_activity>(activity_id("ACT_WASH_SELF"), 0);
@@ -740,6 +865,22 @@ TEST_CASE("plumbing_lua_data_hooks", "[lua]") {
     REQUIRE(vehicle_shower.has_flag("FAUCET"));
 }
 
+TEST_CASE("lua_memory_limit_fails_allocations_past_it", "[lua]") {
+    sol::state lua = make_lua_state();
+    const auto before = lua_memory_in_use();
+    lua.script("small = {}");
+    CHECK(lua_memory_in_use() > before);
+
+    const auto old_limit = lua_memory_limit_mb;
+    lua_memory_limit_mb = static_cast<int>(lua_memory_in_use() / (1024 * 1024)) + 1;
+    const auto res = lua.safe_script("big = string.rep('x', 4 * 1024 * 1024)", sol::script_pass_on_error);
+    lua_memory_limit_mb = old_limit;
+    CHECK_FALSE(res.valid());
+
+    lua.script("ok = string.rep('x', 4 * 1024 * 1024)");
+    CHECK(lua.get<std::string>("ok").size() == 4 * 1024 * 1024);
+}
+
 TEST_CASE("lua_called_from_cpp", "[lua]") {
     sol::state lua = make_lua_state();
 
@@ -1066,6 +1207,35 @@ TEST_CASE("lua_table_serde", "[lua]") {
     CHECK(inner_val.as<int>() == 4);
 }
 
+TEST_CASE("lua_table_serde_writes_primitives_bare_and_reads_tagged_saves", "[lua]") {
+    sol::state lua = make_lua_state();
+
+    sol::table t = lua.create_table();
+    t["flag"] = true;
+    t["big"] = int64_t(5000000000);
+    std::string data =
+        serialize_wrapper([&](JsonOut& jsout) { cata::serialize_lua_table(t, jsout); });
+    CHECK(data.find("\"type\"") == std::string::npos);
+
+    const auto load = [&](const std::string& json) {
+        sol::table nt = lua.create_table();
+        deserialize_wrapper(
+            [&](JsonIn& jsin) {
+                JsonObject jsobj = jsin.get_object();
+                cata::deserialize_lua_table(nt, jsobj);
+            },
+            json);
+        return nt;
+    };
+    sol::table nt = load(data);
+    CHECK(nt.get<bool>("flag"));
+    CHECK(nt.get<int64_t>("big") == 5000000000);
+
+    sol::table old = load(R"({"entries":[{"type":"string","data":"big"},)"
+                          R"({"type":"int","data":5000000000}]})");
+    CHECK(old.get<int64_t>("big") == 5000000000);
+}
+
 TEST_CASE("lua_table_serde_error_no_reg", "[lua]") {
     sol::state lua = make_lua_state();
 
@@ -1532,6 +1702,25 @@ TEST_CASE("lua_require_dotted", "[lua]") {
     REQUIRE(result_mul == 21); // 3 * 7
 }
 
+TEST_CASE("lua_chunk_cache_follows_source_changes", "[lua]") {
+    const auto path = "lua_chunk_cache_test_" + get_pid_string() + ".lua";
+    const auto cleanup = on_out_of_scope([&]() { remove_file(path); });
+    const auto run = [&](const std::string& source) {
+        REQUIRE(write_to_file(path, [&](std::ostream& fout) { fout << source; }));
+        sol::state lua = make_lua_state();
+        REQUIRE(cata::lua_loader::load_file(lua.lua_state(), path) == LUA_OK);
+        sol::protected_function chunk(lua.lua_state(), -1);
+        lua_pop(lua.lua_state(), 1);
+        return chunk().get<int>();
+    };
+
+    // The second run of each source loads the cached chunk.
+    CHECK(run("return 1") == 1);
+    CHECK(run("return 1") == 1);
+    CHECK(run("#!shebang\nreturn 2") == 2);
+    CHECK(run("#!shebang\nreturn 2") == 2);
+}
+
 TEST_CASE("robofac_authorization_scans_nearby_hub01_tiles", "[lua][robofac]") {
     auto lua = make_lua_state();
     auto test_data = lua.create_table();
@@ -1654,6 +1843,60 @@ TEST_CASE("lua_has_hooks_tracks_registered_entries", "[lua]") {
     CHECK(cata::has_hooks("on_creature_do_turn", {.state = &state}));
 }
 
+TEST_CASE("lua_run_hooks_builds_params_only_for_registered_entries", "[lua]") {
+    cata::lua_state state;
+    init_test_lua_hook_state(state);
+    sol::state& lua = state.lua;
+
+    auto hook_list = lua.create_table();
+    lua.globals()["game"]["hooks"]["on_mon_death"] = hook_list;
+
+    auto init_calls = 0;
+    const auto init = [&init_calls](sol::table& params) {
+        ++init_calls;
+        params["answer"] = 42;
+    };
+
+    const auto empty_results = cata::run_hooks("on_mon_death", init, {.state = &state});
+    CHECK(init_calls == 0);
+    CHECK(empty_results.get<bool>("allowed"));
+
+    auto seen = 0;
+    hook_list[1] = [&seen](sol::table params) { seen = params.get<int>("answer"); };
+    const auto results = cata::run_hooks("on_mon_death", init, {.state = &state});
+    CHECK(init_calls == 1);
+    CHECK(seen == 42);
+    CHECK(results.get<bool>("allowed"));
+}
+
+TEST_CASE("lua_hook_profile_attributes_calls_to_mods", "[lua]") {
+    cata::lua_state state;
+    init_test_lua_hook_state(state);
+    sol::state& lua = state.lua;
+
+    auto hook_list = lua.create_table();
+    lua.globals()["game"]["hooks"]["on_mon_effect"] = hook_list;
+    hook_list[1] = lua.create_table_with("mod_id", "slow_mod", "fn", [](sol::table) {});
+    hook_list[2] = [](sol::table) {};
+
+    cata::run_hooks("on_mon_effect", nullptr, {.state = &state});
+    CHECK(cata::hook_profile().empty());
+
+    cata::set_hook_profiling(true);
+    cata::run_hooks("on_mon_effect", nullptr, {.state = &state});
+    cata::run_hooks("on_mon_effect", nullptr, {.state = &state});
+    const auto profile = cata::hook_profile();
+    cata::set_hook_profiling(false);
+
+    REQUIRE(profile.size() == 2);
+    const auto slow_mod =
+        std::ranges::find(profile, std::string("slow_mod"), &cata::hook_profile_entry::mod_id);
+    REQUIRE(slow_mod != profile.end());
+    CHECK(slow_mod->hook_name == "on_mon_effect");
+    CHECK(slow_mod->calls == 2);
+    CHECK(cata::hook_profile().empty());
+}
+
 TEST_CASE("lua_hooks_order_and_chaining", "[lua]") {
     cata::lua_state state;
     init_test_lua_hook_state(state);
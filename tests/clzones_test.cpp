@@ -0,0 +1,36 @@
+#include "catch/catch.hpp"
+#include "clzones.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <string>
+
+TEST_CASE("zone_queries_answer_from_zone_boxes", "[zone]") {
+    clear_all_state();
+    zone_manager::reset_manager();
+    auto& zmgr = zone_manager::get_manager();
+    const auto type = zone_type_id("LOOT_FOOD");
+    const auto fac = faction_id("your_followers");
+    const auto start = tripoint_abs_ms(100, 100, 0);
+    const auto end = tripoint_abs_ms(109, 104, 0);
+    zmgr.add("food", type, fac, false, true, start, end);
+
+    CHECK(zmgr.has_defined(type, fac));
+    CHECK(zmgr.has(type, tripoint_abs_ms(105, 102, 0), fac));
+    CHECK_FALSE(zmgr.has(type, tripoint_abs_ms(110, 102, 0), fac));
+    CHECK_FALSE(zmgr.has(type, tripoint_abs_ms(105, 102, 1), fac));
+
+    const auto outside = tripoint_abs_ms(112, 102, 0);
+    CHECK(zmgr.has_near(type, outside, 3, fac));
+    CHECK_FALSE(zmgr.has_near(type, outside, 2, fac));
+    CHECK_FALSE(zmgr.has_near(type, tripoint_abs_ms(105, 102, 1), 3, fac));
+
+    CHECK(zmgr.get_nearest(type, outside, 3, fac) == tripoint_abs_ms(109, 102, 0));
+    CHECK_FALSE(zmgr.get_nearest(type, outside, 2, fac));
+
+    // A 4x5 corner of the zone is within range
+    CHECK(zmgr.get_near(type, outside, 6, nullptr, fac).size() == 20);
+    CHECK(zmgr.get_near(type, outside, 2, nullptr, fac).empty());
+
+    zone_manager::reset_manager();
+}
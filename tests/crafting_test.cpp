@@ -134,6 +134,26 @@ TEST_CASE("recipe_subset") {
     }
 }
 
+TEST_CASE("recipe_dictionary_indexes_requirement_users", "[recipes]") {
+    const auto& r = recipe_id("brew_rum").obj();
+    const auto& reqs = r.simple_requirements();
+    REQUIRE(!reqs.get_components().empty());
+    REQUIRE(!reqs.get_qualities().empty());
+
+    const auto uses = [&r](const std::vector<const recipe*>& users) {
+        return std::ranges::find(users, &r) != users.end();
+    };
+    for (const auto& comp : reqs.get_components().front()) {
+        CHECK(uses(recipe_dict.recipes_using(comp.type)));
+    }
+    for (const auto& qual : reqs.get_qualities().front()) {
+        CHECK(uses(recipe_dict.recipes_using(qual.type)));
+    }
+    // Heating tools use charges
+    CHECK(uses(recipe_dict.recipes_using_charges()));
+    CHECK(recipe_dict.recipes_using(itype_id("debug_nonexistent_item")).empty());
+}
+
 TEST_CASE("available_recipes", "[recipes]") {
     clear_all_state();
     const recipe* r = &recipe_id("magazine_battery_light_mod").obj();
@@ -849,6 +869,30 @@ TEST_CASE("debug hammerspace", "[crafting]") {
     }
 }
 
+TEST_CASE("crafting_inventory_follows_carried_items_across_turns", "[crafting]") {
+    clear_all_state();
+    auto& you = get_avatar();
+    clear_avatar();
+    const auto hammering = quality_id("HAMMER");
+    const auto has_hammering_cached = [&]() {
+        const auto& qualities = you.crafting_inventory().get_quality_cache();
+        return qualities.contains(hammering);
+    };
+    REQUIRE(!you.crafting_inventory().has_quality(hammering));
+
+    auto& hammer = you.i_add(item::spawn(itype_id("hammer")));
+    CHECK(you.crafting_inventory().has_quality(hammering));
+    CHECK(has_hammering_cached());
+
+    calendar::turn += 1_turns;
+    CHECK(you.crafting_inventory().has_quality(hammering));
+    CHECK(has_hammering_cached());
+
+    hammer.detach();
+    CHECK(!you.crafting_inventory().has_quality(hammering));
+    CHECK(!has_hammering_cached());
+}
+
 TEST_CASE("craft catch-up uses activity progress scale", "[crafting][speed]") {
     clear_all_state();
     const auto global_scale = override_option("TIME_ACTION_SCALE", "50");
@@ -34,3 +34,17 @@ TEST_CASE("creature_in_field", "[monster],[field]") {
         }
     }
 }
+
+TEST_CASE("only_fields_that_affect_creatures_mark_their_tile", "[field]") {
+    clear_all_state();
+    static const tripoint_bub_ms target_location{5, 5, 0};
+    map& here = get_map();
+    REQUIRE_FALSE(here.has_creature_field_at(target_location));
+
+    here.add_field(target_location, field_type_id("fd_blood"));
+    CHECK(here.has_field_at(target_location));
+    CHECK_FALSE(here.has_creature_field_at(target_location));
+
+    here.add_field(target_location, field_type_id("fd_acid"));
+    CHECK(here.has_creature_field_at(target_location));
+}
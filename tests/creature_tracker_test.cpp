@@ -0,0 +1,90 @@
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <algorithm>
+#include <vector>
+
+TEST_CASE("creature_tracker_grid_follows_monsters", "[creature_tracker]") {
+    clear_all_state();
+    auto& tracker = *g->critter_tracker;
+    const auto center = tripoint_bub_ms(60, 60, 0);
+    auto& close_zed = spawn_test_monster("mon_zombie", center + point(3, 0));
+    auto& far_zed = spawn_test_monster("mon_zombie", center + point(30, 0));
+    auto& dog = spawn_test_monster("mon_dog", center + point(0, 5));
+
+    const auto found = [&](int radius, const Creature_tracker::monster_filter& filter = nullptr) {
+        return tracker.find_in_radius(bub_to_abs(center), radius, filter);
+    };
+    const auto contains = [](const std::vector<monster*>& list, const monster& mon) {
+        return std::ranges::find(list, &mon) != list.end();
+    };
+
+    SECTION("radius queries only return monsters in range") {
+        const auto in_range = found(10);
+        CHECK(in_range.size() == 2);
+        CHECK(contains(in_range, close_zed));
+        CHECK(contains(in_range, dog));
+        CHECK(found(40).size() == 3);
+    }
+    SECTION("filters pick by faction") {
+        const auto zombies = found(40, [&](const monster& mon) {
+            return Creature_tracker::tracked_faction(mon) == close_zed.faction;
+        });
+        CHECK(zombies.size() == 2);
+        CHECK_FALSE(contains(zombies, dog));
+    }
+    SECTION("nearest is ordered by distance") {
+        const auto nearest = tracker.find_nearest(bub_to_abs(center), 40, 2);
+        REQUIRE(nearest.size() == 2);
+        CHECK(nearest[0] == &close_zed);
+        CHECK(nearest[1] == &dog);
+    }
+    SECTION("moving across submaps updates the grid") {
+        far_zed.setpos(center + point(-2, -2));
+        CHECK(contains(found(5), far_zed));
+        close_zed.setpos(center + point(40, 40));
+        CHECK_FALSE(contains(found(10), close_zed));
+        CHECK(contains(found(40), close_zed));
+    }
+    SECTION("removed monsters leave the grid") {
+        tracker.remove(close_zed);
+        CHECK_FALSE(contains(found(40), close_zed));
+        CHECK(found(40).size() == 2);
+    }
+}
+
+TEST_CASE("creature_tracker_removes_the_dead_in_bulk", "[creature_tracker]") {
+    clear_all_state();
+    auto& tracker = *g->critter_tracker;
+    const auto center = tripoint_bub_ms(60, 60, 0);
+    auto zeds = std::vector<monster*>();
+    for (int i = 0; i < 20; ++i) {
+        zeds.push_back(&spawn_test_monster("mon_zombie", center + point(i - 10, i % 3)));
+    }
+    const auto faction = Creature_tracker::tracked_faction(*zeds.front());
+    const auto faction_size = [&]() { return tracker.factions().at(faction).size(); };
+    REQUIRE(faction_size() == 20);
+
+    // One moves after dying, so it is no longer filed at its own position
+    for (int i = 0; i < 20; i += 2) { zeds[i]->die(nullptr); }
+    zeds[4]->setpos(center + point(0, 10));
+    tracker.remove_dead();
+
+    CHECK(tracker.size() == 10);
+    CHECK(faction_size() == 10);
+    const auto in_range = tracker.find_in_radius(bub_to_abs(center), 20);
+    CHECK(in_range.size() == 10);
+    for (int i = 1; i < 20; i += 2) {
+        CHECK(std::ranges::find(in_range, zeds[i]) != in_range.end());
+        CHECK(tracker.find(zeds[i]->bub_pos()).get() == zeds[i]);
+        CHECK(tracker.temporary_id(*zeds[i]) == i / 2);
+    }
+}
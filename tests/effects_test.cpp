@@ -65,3 +65,18 @@ TEST_CASE("Effect body part switching and inheritance on decay works as expected
     CHECK(!dummy.has_effect(effect_test_juggling_l2));
     CHECK(dummy.has_effect(effect_test_juggling_l1, body_part_hand_l));
 }
+
+TEST_CASE("Effect mods only come from the mod types an effect gives") {
+    REQUIRE(effect_adrenaline.is_valid());
+    CHECK(effect_adrenaline->has_mod("SPEED"));
+    CHECK_FALSE(effect_adrenaline->has_mod("HURT"));
+
+    avatar dummy;
+    dummy.add_effect(effect_adrenaline, 100_turns);
+    const effect& e = dummy.get_effect(effect_adrenaline);
+    CHECK(e.get_mod("SPEED") == 20);
+    CHECK(e.get_mod("HURT") == 0);
+    CHECK(e.get_amount("HURT") == 0);
+    CHECK(e.get_percentage("HURT", 0) == 0);
+    CHECK_FALSE(e.activated(calendar::turn, "HURT", 0, false, 1));
+}
@@ -455,3 +455,30 @@ TEST_CASE("grid_power_stats", "[grids]") {
         }
     }
 }
+
+TEST_CASE("grid_waits_for_its_next_due_tile", "[grids]") {
+    clear_all_state();
+    calendar::turn = calendar::turn_zero;
+    move_player_out_of_the_way();
+
+    auto setup = set_up_grid_with_consumer<steady_consumer_tile, grid_setup_consumer>(
+        get_map(), f_floor_lamp_on);
+    auto& grid = setup.grid;
+    auto& consumer = setup.consumer;
+    REQUIRE(setup.battery.mod_resource(setup.battery.max_stored) == 0);
+
+    const auto first = calendar::turn + 1_seconds;
+    grid.update(first);
+    REQUIRE(grid.next_update_due());
+    CHECK(*grid.next_update_due() == calendar::turn_zero + consumer.consume_every);
+
+    // Nothing on the grid acts before then, so the tiles are not touched
+    grid.update(calendar::turn + consumer.consume_every - 1_seconds);
+    CHECK(consumer.get_last_updated() == first);
+    CHECK(grid.get_resource() == setup.battery.max_stored);
+
+    const auto later = calendar::turn + consumer.consume_every * 2;
+    grid.update(later);
+    CHECK(consumer.get_last_updated() == later);
+    CHECK(grid.get_resource() == setup.battery.max_stored - consumer.power * 2);
+}
@@ -56,3 +56,48 @@ TEST_CASE("destroy_bus_before_subscriber", "[event]") {
                  "e")));
     CHECK(sub.events.size() == 1);
 }
+
+struct kill_subscriber: public test_subscriber {
+    auto subscribed_events() const -> std::vector<event_type> override {
+        return {event_type::character_kills_monster};
+    }
+    auto deferred_events() const -> std::vector<event_type> override {
+        return {event_type::character_kills_monster};
+    }
+};
+
+TEST_CASE("typed_subscribers_get_only_their_events", "[event]") {
+    event_bus bus;
+    kill_subscriber sub;
+    bus.subscribe(&sub);
+
+    bus.send<event_type::game_start>(character_id(5));
+    bus.send<event_type::character_kills_monster>(character_id(5), mtype_id("zombie"));
+    REQUIRE(sub.events.size() == 1);
+    CHECK(sub.events[0].type() == event_type::character_kills_monster);
+}
+
+TEST_CASE("deferred_events_arrive_in_order_when_flushed", "[event]") {
+    event_bus bus;
+    bus.set_defer_events(true);
+    kill_subscriber kills;
+    test_subscriber all;
+    bus.subscribe(&kills);
+    bus.subscribe(&all);
+
+    bus.send<event_type::character_kills_monster>(character_id(5), mtype_id("zombie"));
+    bus.send<event_type::character_kills_monster>(character_id(6), mtype_id("zombie"));
+    CHECK(kills.events.empty());
+    CHECK(all.events.size() == 2);
+
+    bus.flush_deferred();
+    REQUIRE(kills.events.size() == 2);
+    CHECK(kills.events[0].get<character_id>("killer") == character_id(5));
+    CHECK(kills.events[1].get<character_id>("killer") == character_id(6));
+
+    bus.send<event_type::character_kills_monster>(character_id(7), mtype_id("zombie"));
+    bus.set_defer_events(false);
+    CHECK(kills.events.size() == 3);
+    bus.send<event_type::character_kills_monster>(character_id(8), mtype_id("zombie"));
+    CHECK(kills.events.size() == 4);
+}
@@ -0,0 +1,135 @@
+#include "catch/catch.hpp"
+#include "flat_hash_map.h"
+
+#include <algorithm>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "coordinates.h"
+#include "rng.h"
+
+namespace {
+
+// Tiles of a square area, as the pathfinding and zone containers see them
+auto area_points(const int side) -> std::vector<point_abs_ms> {
+    auto points = std::vector<point_abs_ms>();
+    for (int y = 0; y < side; ++y) {
+        for (int x = 0; x < side; ++x) { points.emplace_back(x + 1000, y - 500); }
+    }
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("flat_hash_map_inserts_finds_and_erases", "[flat_hash_map]") {
+    auto map = cata::flat_hash_map<tripoint_abs_omt, std::string>();
+    CHECK(map.empty());
+    CHECK(map.find(tripoint_abs_omt(0, 0, 0)) == map.end());
+
+    CHECK(map.try_emplace(tripoint_abs_omt(1, 2, 3), "a").second);
+    CHECK_FALSE(map.try_emplace(tripoint_abs_omt(1, 2, 3), "b").second);
+    map[tripoint_abs_omt(4, 5, 6)] = "c";
+    map.insert_or_assign(tripoint_abs_omt(1, 2, 3), "d");
+
+    CHECK(map.size() == 2);
+    CHECK(map.at(tripoint_abs_omt(1, 2, 3)) == "d");
+    CHECK(map.contains(tripoint_abs_omt(4, 5, 6)));
+    CHECK_THROWS_AS(map.at(tripoint_abs_omt(0, 0, 0)), std::out_of_range);
+
+    CHECK(map.erase(tripoint_abs_omt(1, 2, 3)) == 1);
+    CHECK(map.erase(tripoint_abs_omt(1, 2, 3)) == 0);
+    CHECK(map.size() == 1);
+    CHECK(map.at(tripoint_abs_omt(4, 5, 6)) == "c");
+}
+
+TEST_CASE("flat_hash_map_matches_unordered_map_under_churn", "[flat_hash_map]") {
+    auto flat = cata::flat_hash_map<point_abs_ms, int>();
+    auto reference = std::unordered_map<point_abs_ms, int>();
+    for (int i = 0; i < 20000; ++i) {
+        const auto p = point_abs_ms(rng(-40, 40), rng(-40, 40));
+        if (one_in(3)) {
+            CHECK(flat.erase(p) == reference.erase(p));
+        } else {
+            flat[p] = i;
+            reference[p] = i;
+        }
+    }
+
+    REQUIRE(flat.size() == reference.size());
+    for (const auto& [p, v] : reference) {
+        const auto it = flat.find(p);
+        REQUIRE(it != flat.end());
+        CHECK(it->second == v);
+    }
+}
+
+TEST_CASE("flat_hash_map_erase_by_iterator_visits_every_value", "[flat_hash_map]") {
+    auto map = cata::flat_hash_map<point_abs_ms, int>();
+    for (const auto& p : area_points(10)) { map[p] = p.x() % 2; }
+
+    // Erasing moves the last value into the gap; the returned iterator points at it
+    for (auto it = map.begin(); it != map.end();) {
+        it = it->second == 1 ? map.erase(it) : std::next(it);
+    }
+    CHECK(map.size() == 50);
+    CHECK(std::ranges::all_of(map, [](const auto& kv) { return kv.second == 0; }));
+}
+
+TEST_CASE("flat_hash_set_compares_by_contents", "[flat_hash_map]") {
+    auto a = cata::flat_hash_set<tripoint_abs_ms>{tripoint_abs_ms(1, 0, 0), tripoint_abs_ms(2, 0, 0)};
+    auto b = cata::flat_hash_set<tripoint_abs_ms>{tripoint_abs_ms(2, 0, 0), tripoint_abs_ms(1, 0, 0)};
+    CHECK(a == b);
+    CHECK_FALSE(a.insert(tripoint_abs_ms(1, 0, 0)).second);
+    b.erase(tripoint_abs_ms(2, 0, 0));
+    CHECK_FALSE(a == b);
+}
+
+// Benchmarks are skipped by default by using [.] tag
+TEST_CASE("flat_hash_map_benchmark", "[.][flat_hash_map][benchmark]") {
+    const auto points = area_points(132);
+    auto std_map = std::unordered_map<point_abs_ms, float>();
+    auto flat_map = cata::flat_hash_map<point_abs_ms, float>();
+    for (const auto& p : points) {
+        std_map[p] = 1.0f;
+        flat_map[p] = 1.0f;
+    }
+
+    BENCHMARK("std::unordered_map build") {
+        auto m = std::unordered_map<point_abs_ms, float>();
+        for (const auto& p : points) { m[p] = 1.0f; }
+        return m.size();
+    };
+    BENCHMARK("cata::flat_hash_map build") {
+        auto m = cata::flat_hash_map<point_abs_ms, float>();
+        for (const auto& p : points) { m[p] = 1.0f; }
+        return m.size();
+    };
+
+    BENCHMARK("std::unordered_map lookup") {
+        auto sum = 0.0f;
+        for (const auto& p : points) {
+            if (const auto it = std_map.find(p + point(1, 1)); it != std_map.end()) { sum += it->second; }
+        }
+        return sum;
+    };
+    BENCHMARK("cata::flat_hash_map lookup") {
+        auto sum = 0.0f;
+        for (const auto& p : points) {
+            if (const auto it = flat_map.find(p + point(1, 1)); it != flat_map.end()) { sum += it->second; }
+        }
+        return sum;
+    };
+
+    BENCHMARK("std::unordered_set insert") {
+        auto s = std::unordered_set<point_abs_ms>();
+        for (const auto& p : points) { s.insert(p); }
+        return s.size();
+    };
+    BENCHMARK("cata::flat_hash_set insert") {
+        auto s = cata::flat_hash_set<point_abs_ms>();
+        for (const auto& p : points) { s.insert(p); }
+        return s.size();
+    };
+}
@@ -0,0 +1,80 @@
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <optional>
+#include <set>
+
+namespace {
+
+auto with_alpha(float alpha) -> RouteSettings {
+    auto settings = RouteSettings();
+    settings.alpha = alpha;
+    return settings;
+}
+
+} // namespace
+
+TEST_CASE("flow_field_steps_lead_to_the_goal", "[pathfinding]") {
+    clear_all_state();
+    auto& here = get_map();
+    build_test_map(ter_id("t_pavement"));
+    for (int y = 50; y <= 70; ++y) {
+        here.ter_set(tripoint_bub_ms(40, y, 0), ter_id("t_concrete_wall"));
+    }
+    Pathfinding::clear_d_maps();
+    const auto to = tripoint_bub_ms(60, 60, 0);
+
+    // Several agents behind the wall follow the same field
+    for (const auto& start : {tripoint_bub_ms(20, 60, 0), tripoint_bub_ms(25, 52, 0),
+                              tripoint_bub_ms(30, 68, 0)}) {
+        auto cur = start;
+        for (int steps = 0; cur != to; ++steps) {
+            REQUIRE(steps < 400);
+            const auto next = Pathfinding::next_step(cur, to, std::nullopt, with_alpha(0.5f));
+            REQUIRE(next.has_value());
+            CHECK(square_dist(cur, *next) == 1);
+            CHECK(here.passable(*next));
+            cur = *next;
+        }
+    }
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE("flow_field_decongests_at_lookup", "[pathfinding]") {
+    clear_all_state();
+    build_test_map(ter_id("t_pavement"));
+    Pathfinding::clear_d_maps();
+    const auto from = tripoint_bub_ms(20, 60, 0);
+    const auto to = tripoint_bub_ms(60, 60, 0);
+
+    const auto steps_taken = [&](float alpha) {
+        std::set<tripoint_bub_ms> steps;
+        for (int i = 0; i < 50; ++i) {
+            const auto next = Pathfinding::next_step(from, to, std::nullopt, with_alpha(alpha));
+            REQUIRE(next.has_value());
+            steps.insert(*next);
+        }
+        return steps;
+    };
+    CHECK(steps_taken(1.0f).size() == 1);
+    CHECK(steps_taken(0.0f).size() > 1);
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE("flow_field_settings_share_similar_speeds", "[pathfinding]") {
+    const auto with_speed = [](float speed) {
+        auto settings = PathfindingSettings();
+        settings.move_cost_coeff = 1.0f / speed;
+        return Pathfinding::flow_field_settings(settings);
+    };
+    CHECK(with_speed(100) == with_speed(110));
+    CHECK_FALSE(with_speed(100) == with_speed(140));
+    // Characters price moves at 1 and keep their own class
+    CHECK(Pathfinding::flow_field_settings(PathfindingSettings()) == PathfindingSettings());
+}
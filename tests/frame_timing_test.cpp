@@ -0,0 +1,151 @@
+#include "catch/catch.hpp"
+#include "frame_timing.h"
+#include "turn_recorder.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+auto frame(float busy_ms, float input_ms = 0.0f) -> frame_timing::frame_sample {
+    auto f = frame_timing::frame_sample();
+    f.total_ms = busy_ms + input_ms;
+    f.group_ms[static_cast<size_t>(frame_timing::group::input)] = input_ms;
+    return f;
+}
+
+} // namespace
+
+TEST_CASE("frame_history_percentiles_ignore_input_waits", "[frame_timing]") {
+    auto history = frame_timing::frame_history();
+    CHECK(history.percentile(0.5f) == 0.0f);
+    for (auto i = 1; i <= 100; ++i) {
+        history.push(frame(static_cast<float>(i), 1000.0f));
+    }
+    CHECK(history.percentile(0.5f) == Approx(50.0f));
+    CHECK(history.percentile(0.99f) == Approx(99.0f));
+    CHECK(history.percentile(1.0f) == Approx(100.0f));
+    CHECK(history.percentile(0.0f) == Approx(1.0f));
+}
+
+TEST_CASE("frame_history_counts_stutters_against_the_median", "[frame_timing]") {
+    auto history = frame_timing::frame_history();
+    for (auto i = 0; i < 40; ++i) {
+        history.push(frame(10.0f));
+    }
+    // Over the absolute threshold, but not twice the median of the slow frames around it
+    for (auto i = 0; i < 60; ++i) {
+        history.push(frame(40.0f));
+    }
+    CHECK(history.stutters() == 0);
+    history.push(frame(90.0f));
+    CHECK(history.stutters() == 1);
+
+    SECTION("old frames fall out of the window") {
+        for (size_t i = 0; i < frame_timing::frame_history::capacity; ++i) {
+            history.push(frame(5.0f));
+        }
+        CHECK(history.samples().size() == frame_timing::frame_history::capacity);
+        CHECK(history.stutters() == 0);
+    }
+}
+
+TEST_CASE("frame_timing_charges_nested_phases_exclusively", "[frame_timing]") {
+    frame_timing::set_enabled(true);
+    {
+        const auto outer = frame_timing::scoped_phase(frame_timing::group::turn, "outer");
+        const auto inner = frame_timing::scoped_phase(frame_timing::group::input, "inner");
+    }
+    frame_timing::end_frame();
+    REQUIRE(frame_timing::history().samples().size() == 1);
+    const auto& f = frame_timing::history().samples().back();
+    auto grouped = 0.0f;
+    for (const auto ms : f.group_ms) {
+        grouped += ms;
+    }
+    CHECK(grouped <= f.total_ms);
+    // Input waits are left out of the phase ranking
+    REQUIRE(f.phase_ms.size() == 1);
+    CHECK(f.phase_ms[0].first == std::string("outer"));
+    frame_timing::set_enabled(false);
+    CHECK(frame_timing::history().samples().empty());
+}
+
+TEST_CASE("frame_timing_charges_allocations_to_the_open_phase", "[frame_timing]") {
+    frame_timing::set_enabled(true);
+    auto held = std::vector<std::string>();
+    {
+        const auto phase = frame_timing::scoped_phase(frame_timing::group::turn, "allocating");
+        held.emplace_back(100, 'x');
+    }
+    frame_timing::end_frame();
+    CHECK(held.size() == 1);
+    const auto& f = frame_timing::history().samples().back();
+    if constexpr (alloc_profiling::compiled_in) {
+        REQUIRE(f.phase_allocs.size() == 1);
+        CHECK(f.phase_allocs[0].second.allocations >= 2);
+        CHECK(f.phase_allocs[0].second.bytes >= 100);
+    } else {
+        CHECK(f.phase_allocs.empty());
+    }
+    frame_timing::set_enabled(false);
+}
+
+TEST_CASE("turn_recorder_keeps_phases_and_counters_with_the_overlay_off", "[frame_timing]") {
+    frame_timing::set_enabled(false);
+    turn_recorder::clear();
+    {
+        const auto turn = turn_recorder::scoped_turn(42);
+        const auto outer = frame_timing::scoped_phase(frame_timing::group::turn, "outer");
+        {
+            const auto wait = frame_timing::scoped_phase(frame_timing::group::input, "wait");
+        }
+        turn_recorder::count(turn_recorder::counter::monsters_planned, 3);
+        turn_recorder::count(turn_recorder::counter::lua_hooks_run);
+    }
+    // Outside a turn, neither phases nor counters are recorded
+    {
+        const auto stray = frame_timing::scoped_phase(frame_timing::group::turn, "stray");
+    }
+    turn_recorder::count(turn_recorder::counter::monsters_planned);
+
+    const auto& history = turn_recorder::history();
+    REQUIRE(history.size() == 1);
+    const auto& t = history[0];
+    CHECK(t.turn == 42);
+    REQUIRE(t.phase_ms.size() == 1);
+    CHECK(t.phase_ms[0].first == std::string("outer"));
+    CHECK(t.phase_ms[0].second + t.input_ms <= t.total_ms);
+    CHECK(t.counts[static_cast<size_t>(turn_recorder::counter::monsters_planned)] == 3);
+    CHECK(t.counts[static_cast<size_t>(turn_recorder::counter::lua_hooks_run)] == 1);
+    CHECK(frame_timing::history().samples().empty());
+}
+
+TEST_CASE("turn_history_drops_the_oldest_turns", "[frame_timing]") {
+    auto history = turn_recorder::turn_history();
+    for (size_t i = 0; i < turn_recorder::turn_history::capacity + 5; ++i) {
+        history.next().turn = static_cast<int>(i);
+    }
+    REQUIRE(history.size() == turn_recorder::turn_history::capacity);
+    CHECK(history[0].turn == 5);
+    CHECK(history.back().turn == static_cast<int>(turn_recorder::turn_history::capacity + 4));
+}
+
+TEST_CASE("spike_trigger_waits_for_the_turns_after_a_spike", "[frame_timing]") {
+    auto trigger = turn_recorder::spike_trigger();
+    CHECK_FALSE(trigger.on_turn(500.0f, 0.0f));
+    CHECK_FALSE(trigger.on_turn(500.0f, 100.0f));
+    CHECK(trigger.spike_busy_ms() == 500.0f);
+    for (auto i = 1; i < turn_recorder::spike_trigger::turns_after; ++i) {
+        CHECK_FALSE(trigger.on_turn(10.0f, 100.0f));
+    }
+    CHECK(trigger.on_turn(10.0f, 100.0f));
+
+    // Spikes right after a dump are left out, so a slow save doesn't write one every turn
+    CHECK_FALSE(trigger.on_turn(500.0f, 100.0f));
+    for (auto i = 0; i < turn_recorder::spike_trigger::dump_cooldown_turns; ++i) {
+        CHECK_FALSE(trigger.on_turn(10.0f, 100.0f));
+    }
+    CHECK_FALSE(trigger.on_turn(600.0f, 100.0f));
+    CHECK(trigger.spike_busy_ms() == 600.0f);
+}
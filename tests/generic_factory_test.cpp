@@ -136,6 +136,30 @@ TEST_CASE("generic_factory_version_wrapper", "[generic_factory]") {
     CHECK_FALSE(test_factory.is_valid(v2));
 }
 
+TEST_CASE("generic_factory_lookup_after_finalize", "[generic_factory]") {
+    generic_factory<test_obj> test_factory("test_factory");
+    for (int i = 0; i < 300; ++i) {
+        test_factory.insert({test_obj_id("id_" + std::to_string(i)), "value_" + std::to_string(i)});
+    }
+    test_factory.finalize();
+
+    // fresh ids have no cached int_id and go through the finalized index
+    for (int i = 0; i < 300; ++i) {
+        const test_obj_id id("id_" + std::to_string(i));
+        REQUIRE(test_factory.is_valid(id));
+        CHECK(test_factory.convert(id, int_id<test_obj>(-1)).to_i() == i);
+        CHECK(test_factory.obj(id).value == "value_" + std::to_string(i));
+    }
+    CHECK_FALSE(test_factory.is_valid(test_obj_id("id_300")));
+    CHECK_FALSE(test_factory.is_valid(test_obj_id("")));
+
+    // inserting after finalize must not leave the index answering
+    test_factory.insert({test_obj_id("id_300"), "value_300"});
+    CHECK(test_factory.is_valid(test_obj_id("id_300")));
+    CHECK(test_factory.obj(test_obj_id("id_300")).value == "value_300");
+    CHECK(test_factory.obj(test_obj_id("id_7")).value == "value_7");
+}
+
 TEST_CASE("string_ids_comparison", "[generic_factory][string_id]") {
     //  checks equality correctness for the following combinations of parameters:
     bool equal = GENERATE(true, false);         // whether ids are equal
@@ -195,6 +219,21 @@ TEST_CASE("generic_factory_lookup_benchmark", "[.][generic_factory][benchmark]")
     }
 
     BENCHMARK("single lookup") { return test_factory.obj(id_200).value; };
+
+    test_factory.finalize();
+    const std::vector<test_obj_id> ids = [] {
+        std::vector<test_obj_id> ret;
+        for (int i = 0; i < 1000; ++i) {
+            ret.emplace_back("id_" + std::to_string(i));
+        }
+        return ret;
+    }();
+    int i = 0;
+    BENCHMARK("first lookup of a fresh id after finalize") {
+        // built from the string so it carries no cached int_id, unlike a copy would
+        const test_obj_id id(ids[(i++) % ids.size()].str());
+        return test_factory.obj(id).value.size();
+    };
 }
 
 TEST_CASE("string_id_compare_benchmark", "[.][generic_factory][string_id][benchmark]") {
@@ -0,0 +1,96 @@
+#include "cached_options.h"
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+// A wall down the middle of the bubble, with one gap near its south end.
+auto build_wall_with_gap(map& here) -> tripoint_bub_ms {
+    build_test_map(ter_id("t_pavement"));
+    const auto side = here.getmapsize() * SEEX;
+    const auto gap = tripoint_bub_ms(side / 2, side - 20, 0);
+    for (int y = 0; y < side; ++y) {
+        if (y != gap.y()) {
+            here.ter_set(tripoint_bub_ms(side / 2, y, 0), ter_id("t_concrete_wall"));
+        }
+    }
+    return gap;
+}
+
+auto route_between(const tripoint_bub_ms& from, const tripoint_bub_ms& to, bool hierarchical)
+    -> std::vector<tripoint_bub_ms> {
+    const auto restore = restore_on_out_of_scope<bool>(hierarchical_pathfinding);
+    hierarchical_pathfinding = hierarchical;
+    Pathfinding::clear_d_maps();
+    return Pathfinding::route(from, to);
+}
+
+auto check_walkable(const map& here, const std::vector<tripoint_bub_ms>& path) -> void {
+    for (std::size_t i = 1; i < path.size(); ++i) {
+        INFO("step " << i << " to " << path[i].to_string());
+        CHECK(square_dist(path[i - 1], path[i]) == 1);
+        CHECK(here.passable(path[i]));
+    }
+}
+
+} // namespace
+
+TEST_CASE("hierarchical_route_goes_through_the_gap", "[pathfinding]") {
+    clear_all_state();
+    auto& here = get_map();
+    const auto gap = build_wall_with_gap(here);
+    const auto from = tripoint_bub_ms(gap.x() - 40, 12, 0);
+    const auto to = tripoint_bub_ms(gap.x() + 40, 12, 0);
+
+    const auto full = route_between(from, to, false);
+    const auto hierarchical = route_between(from, to, true);
+    REQUIRE_FALSE(full.empty());
+    REQUIRE_FALSE(hierarchical.empty());
+    CHECK(hierarchical.front() == from);
+    CHECK(hierarchical.back() == to);
+    CHECK(std::ranges::find(hierarchical, gap) != hierarchical.end());
+    check_walkable(here, hierarchical);
+    // Portals sit in the middle of each crossing, so the route may bend a little more.
+    CHECK(hierarchical.size() <= full.size() * 5 / 4);
+}
+
+TEST_CASE("hierarchical_route_sees_terrain_change_between_turns", "[pathfinding]") {
+    clear_all_state();
+    auto& here = get_map();
+    const auto gap = build_wall_with_gap(here);
+    const auto from = tripoint_bub_ms(gap.x() - 40, 12, 0);
+    const auto to = tripoint_bub_ms(gap.x() + 40, 12, 0);
+    REQUIRE_FALSE(route_between(from, to, true).empty());
+
+    // Closing the gap makes the kept portal graph stale.
+    here.ter_set(gap, ter_id("t_concrete_wall"));
+    CHECK(route_between(from, to, true).empty());
+}
+
+TEST_CASE("hierarchical_route_crosses_open_ground_without_searching_it", "[pathfinding]") {
+    clear_all_state();
+    auto& here = get_map();
+    build_test_map(ter_id("t_pavement"));
+    const auto from = tripoint_bub_ms(20, 15, 0);
+    const auto to = tripoint_bub_ms(100, 90, 0);
+
+    const auto before = Pathfinding::stats();
+    const auto full = route_between(from, to, false);
+    const auto hierarchical = route_between(from, to, true);
+    REQUIRE_FALSE(hierarchical.empty());
+    CHECK(hierarchical.front() == from);
+    CHECK(hierarchical.back() == to);
+    check_walkable(here, hierarchical);
+    CHECK(hierarchical.size() <= full.size() * 5 / 4);
+    CHECK(Pathfinding::stats().uniform_areas > before.uniform_areas);
+}
@@ -1,3 +1,4 @@
+#include "calendar.h"
 #include "catch/catch.hpp"
 #include "flag.h"
 #include "item.h"
@@ -158,3 +159,26 @@ TEST_CASE("item_modifier modifies charges for item", "[item_group]") {
         }
     }
 }
+
+TEST_CASE("distribution_picks_follow_entry_changes", "[item_group]") {
+    auto group = Item_group(Item_group::G_DISTRIBUTION, 100, 0, 0);
+    group.add_item_entry(itype_id("rock"), 10);
+    group.add_item_entry(itype_id("matches"), 80);
+    group.add_item_entry(itype_id("stick"), 10);
+    REQUIRE(group.remove_specific_item("matches"));
+
+    const Item_spawn_data& spawner = group;
+    auto rocks = 0;
+    auto sticks = 0;
+    for (auto i = 0; i < 200; ++i) {
+        const auto spawned = spawner.create_single(calendar::turn_zero);
+        REQUIRE(spawned);
+        const auto id = spawned->typeId();
+        REQUIRE(id != itype_id("matches"));
+        rocks += id == itype_id("rock");
+        sticks += id == itype_id("stick");
+    }
+    CHECK(rocks > 0);
+    CHECK(sticks > 0);
+    CHECK(rocks + sticks == 200);
+}
@@ -0,0 +1,44 @@
+#include "catch/catch.hpp"
+#include "item.h"
+#include "item_search.h"
+#include "itype.h"
+
+TEST_CASE("filter_narrows_only_for_plain_extensions", "[item_search]") {
+    CHECK(filter_narrows("", "rock"));
+    CHECK(filter_narrows("", "-rock,ax"));
+    CHECK(filter_narrows("ro", "rock"));
+    CHECK(filter_narrows("c:fo", "c:food"));
+    CHECK(filter_narrows("rock", "rock"));
+
+    CHECK_FALSE(filter_narrows("rock", "ro"));
+    CHECK_FALSE(filter_narrows("rock", "stick"));
+    // Alternatives and exclusions grow what they match
+    CHECK_FALSE(filter_narrows("rock", "rock,ax"));
+    CHECK_FALSE(filter_narrows("-", "-rock"));
+    // The colon switches from names to categories
+    CHECK_FALSE(filter_narrows("c", "c:food"));
+    CHECK_FALSE(filter_narrows("b:ro", "b:rock"));
+}
+
+TEST_CASE("compiled_item_filters_match_by_field", "[item_search]") {
+    const auto& hammer = *item::spawn_temporary("hammer");
+    const auto& rock = *item::spawn_temporary("rock");
+
+    const auto check = [&](const std::string& filter, bool hammer_matches, bool rock_matches) {
+        CAPTURE(filter);
+        const auto matches = item_filter_from_string(filter);
+        CHECK(matches(hammer) == hammer_matches);
+        CHECK(matches(rock) == rock_matches);
+        const auto type_matches = itype_filter_from_string(filter);
+        CHECK(type_matches(*hammer.type) == hammer_matches);
+        CHECK(type_matches(*rock.type) == rock_matches);
+    };
+    check("hamm", true, false);
+    check("c:workshop", true, false);
+    check("m:steel", true, false);
+    check("q:hammering", true, true);
+    check("q:sanding", false, true);
+    check("-m:steel", false, true);
+    check("m:stone,q:hammer", true, true);
+    check("b:m:wood;q:pry", true, false);
+}
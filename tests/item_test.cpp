@@ -69,6 +69,29 @@ TEST_CASE("simple_item_layers", "[item]") {
     CHECK(item::spawn_temporary("2byarm_guard")->get_layer() == BELTED_LAYER);
 }
 
+TEST_CASE("item_flag_bits_follow_flag_changes", "[item]") {
+    item& hat = *item::spawn_temporary("10gal_hat");
+    REQUIRE(hat.type->item_tag_bits);
+    CHECK(hat.has_flag(flag_VARSIZE));
+    CHECK_FALSE(hat.has_own_flag(flag_VARSIZE));
+    CHECK_FALSE(hat.has_flag(flag_FIT));
+
+    hat.set_flag(flag_FIT);
+    CHECK(hat.has_own_flag(flag_FIT));
+    CHECK(hat.has_flag(flag_FIT));
+
+    auto copy = item::spawn(hat);
+    CHECK(copy->has_own_flag(flag_FIT));
+
+    hat.unset_flag(flag_FIT);
+    CHECK_FALSE(hat.has_own_flag(flag_FIT));
+    CHECK_FALSE(hat.has_flag(flag_FIT));
+    CHECK(copy->has_own_flag(flag_FIT));
+
+    copy->unset_flags();
+    CHECK_FALSE(copy->has_own_flag(flag_FIT));
+}
+
 TEST_CASE("gun_layer", "[item]") {
     item& gun = *item::spawn_temporary("win70");
     detached_ptr<item> mod = item::spawn("shoulder_strap");
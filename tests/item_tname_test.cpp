@@ -99,6 +99,20 @@ TEST_CASE("wet item", "[item][tname][wet]") {
     CHECK(rag.tname() == "rag (wet)");
 }
 
+TEST_CASE("tname memo lasts only for its scope", "[item][tname]") {
+    clear_all_state();
+    item& rag = *item::spawn_temporary("rag");
+    {
+        const auto names = item::tname_memo_scope();
+        CHECK(rag.tname() == "rag");
+        // Items aren't expected to change under an open memo
+        rag.set_flag(flag_WET);
+        CHECK(rag.tname() == "rag");
+        CHECK(rag.tname(2) == "rags (wet)");
+    }
+    CHECK(rag.tname() == "rag (wet)");
+}
+
 TEST_CASE("food in freezer", "[item][tname][freezer]") {
     clear_all_state();
 
@@ -2,13 +2,16 @@
 #include "cached_options.h"
 #include "cata_utility.h"
 #include "catch/catch.hpp"
+#include "compress.h"
 #include "json.h"
 #include "string_formatter.h"
 #include "type_id.h"
 
 #include <list>
 #include <sstream>
+#include <string>
 #include <utility>
+#include <vector>
 
 template <typename T> static void test_serialization(const T& val, const std::string& s) {
     CAPTURE(val);
@@ -300,19 +303,34 @@ TEST_CASE("translation_text_style_check_error_recovery", "[json][translation][.]
     }
 }
 
+// Runs f on json read through an istringstream and through a contiguous
+// buffer, which takes JsonIn's scanning fast paths.
+template <typename F> static void for_each_json_stream(const std::string& json, F&& f) {
+    {
+        INFO("istringstream");
+        std::istringstream iss(json);
+        JsonIn jsin(iss);
+        f(jsin);
+    }
+    {
+        INFO("contiguous buffer");
+        memory_istreambuf buf(json);
+        std::istream is(&buf);
+        JsonIn jsin(is);
+        f(jsin);
+    }
+}
+
 static void test_get_string(const std::string& str, const std::string& json) {
     CAPTURE(json);
-    std::istringstream iss(json);
-    JsonIn jsin(iss);
-    CHECK(jsin.get_string() == str);
+    for_each_json_stream(json, [&](JsonIn& jsin) { CHECK(jsin.get_string() == str); });
 }
 
 template <typename Matcher>
 static void test_get_string_throws_matches(Matcher&& matcher, const std::string& json) {
     CAPTURE(json);
-    std::istringstream iss(json);
-    JsonIn jsin(iss);
-    CHECK_THROWS_MATCHES(jsin.get_string(), JsonError, matcher);
+    for_each_json_stream(
+        json, [&](JsonIn& jsin) { CHECK_THROWS_MATCHES(jsin.get_string(), JsonError, matcher); });
 }
 
 template <typename Matcher>
@@ -592,6 +610,37 @@ TEST_CASE("jsonin_get_string", "[json]") {
         R"("foo\nbar")", 5);
 }
 
+TEST_CASE("jsonin_skip_value", "[json]") {
+    restore_on_out_of_scope<error_log_format_t> restore_error_log_format(error_log_format);
+    error_log_format = error_log_format_t::human_readable;
+
+    const std::string json =
+        R"([ {"a": [1, -2.5e3, {"b": "x\"y\\"}], "c": true, "d": null, "e": [],}, false, "end" ])";
+    for_each_json_stream(json, [&](JsonIn& jsin) {
+        jsin.start_array();
+        jsin.skip_value();
+        CHECK(jsin.get_bool() == false);
+        CHECK(jsin.get_string() == "end");
+        CHECK(jsin.end_array());
+    });
+
+    // Malformed values must fail the same way whichever path skips them.
+    for (const std::string bad : {R"({"a": [1 2]})", R"({"a" 1})", R"(["a)", R"([tru])",
+                                  R"({"a": [1,, 2]})", "[\"a\nb\"]"}) {
+        CAPTURE(bad);
+        auto errors = std::vector<std::string>{};
+        for_each_json_stream(bad, [&](JsonIn& jsin) {
+            try {
+                jsin.skip_value();
+                errors.emplace_back();
+            } catch (const JsonError& err) { errors.emplace_back(err.what()); }
+        });
+        REQUIRE(errors.size() == 2);
+        CHECK(!errors[0].empty());
+        CHECK(errors[0] == errors[1]);
+    }
+}
+
 TEST_CASE("serialize_optional", "[json]") {
     SECTION("simple_empty_optional") {
         std::optional<int> o;
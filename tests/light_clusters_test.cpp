@@ -0,0 +1,124 @@
+#include "catch/catch.hpp"
+#include "light_clusters.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+using namespace light_clusters;
+
+auto point_light(int x, int y, float luminance) -> emitter {
+    return emitter{
+        .p = tripoint_bub_ms(x, y, 0),
+        .shape = emitter_shape::point,
+        .luminance = luminance,
+    };
+}
+
+auto headlight(int x, int y, float luminance, double degrees) -> emitter {
+    return emitter{
+        .p = tripoint_bub_ms(x, y, 0),
+        .shape = emitter_shape::arc,
+        .direction = units::from_degrees(degrees),
+        .width = units::from_degrees(45),
+        .luminance = luminance,
+    };
+}
+
+auto members(const std::vector<cluster>& clusters) -> int {
+    auto total = 0;
+    for (const auto& c : clusters) { total += c.members; }
+    return total;
+}
+
+const auto near_viewer = options{.viewer = tripoint_bub_ms(0, 0, 0), .lod_distance = 20};
+
+} // namespace
+
+TEST_CASE("light_clusters_merge_lights_sharing_a_tile_into_the_brightest", "[lightmap]") {
+    const auto clusters = cluster_emitters(
+        {point_light(3, 3, 10.0f), point_light(3, 3, 40.0f), point_light(3, 3, 25.0f)},
+        near_viewer);
+    REQUIRE(clusters.size() == 1);
+    CHECK(clusters[0].members == 3);
+    CHECK(clusters[0].light.luminance == 40.0f);
+}
+
+TEST_CASE("light_clusters_keep_differing_lights_apart", "[lightmap]") {
+    auto red = point_light(3, 3, 10.0f);
+    red.color_rgb = 0xff0000u;
+    auto blue = point_light(3, 3, 10.0f);
+    blue.color_rgb = 0x0000ffu;
+    CHECK(cluster_emitters({red, blue}, near_viewer).size() == 2);
+
+    CHECK(cluster_emitters({headlight(3, 3, 50.0f, 0), headlight(3, 3, 50.0f, 90)}, near_viewer)
+              .size()
+          == 2);
+    // A full turn is the same direction.
+    CHECK(cluster_emitters({headlight(3, 3, 50.0f, 10), headlight(3, 3, 50.0f, 370)}, near_viewer)
+              .size()
+          == 1);
+
+    CHECK(cluster_emitters({point_light(3, 3, 10.0f), headlight(3, 3, 10.0f, 0)}, near_viewer)
+              .size()
+          == 2);
+
+    // The scope is only compared, never read.
+    auto inside = point_light(3, 3, 10.0f);
+    auto outside = point_light(3, 3, 10.0f);
+    outside.scope = reinterpret_cast<const vehicle*>(&outside);
+    CHECK(cluster_emitters({inside, outside}, near_viewer).size() == 2);
+}
+
+TEST_CASE("light_clusters_merge_neighbours_only_past_the_lod_distance", "[lightmap]") {
+    SECTION("near the viewer every tile is cast") {
+        const auto clusters =
+            cluster_emitters({point_light(5, 0, 10.0f), point_light(6, 0, 20.0f)}, near_viewer);
+        CHECK(clusters.size() == 2);
+    }
+    SECTION("past it neighbours merge into the brightest") {
+        const auto clusters =
+            cluster_emitters({point_light(30, 0, 10.0f), point_light(31, 1, 20.0f)}, near_viewer);
+        REQUIRE(clusters.size() == 1);
+        CHECK(clusters[0].light.luminance == 20.0f);
+        CHECK(clusters[0].light.p == tripoint_bub_ms(31, 1, 0));
+        CHECK(clusters[0].min == point_bub_ms(30, 0));
+        CHECK(clusters[0].max == point_bub_ms(31, 1));
+    }
+    SECTION("two tiles apart merge only past twice the distance") {
+        CHECK(cluster_emitters({point_light(30, 0, 10.0f), point_light(32, 0, 20.0f)}, near_viewer)
+                  .size()
+              == 2);
+        CHECK(cluster_emitters({point_light(50, 0, 10.0f), point_light(52, 0, 20.0f)}, near_viewer)
+                  .size()
+              == 1);
+    }
+    SECTION("a light inside the distance stays its own") {
+        const auto clusters =
+            cluster_emitters({point_light(20, 0, 10.0f), point_light(21, 0, 20.0f)}, near_viewer);
+        CHECK(clusters.size() == 2);
+    }
+    SECTION("a distance of 0 only merges shared tiles") {
+        const auto never = options{.viewer = tripoint_bub_ms(0, 0, 0), .lod_distance = 0};
+        const auto clusters = cluster_emitters(
+            {point_light(90, 0, 10.0f), point_light(91, 0, 20.0f), point_light(91, 0, 5.0f)},
+            never);
+        CHECK(clusters.size() == 2);
+        CHECK(members(clusters) == 3);
+    }
+}
+
+TEST_CASE("light_clusters_account_for_every_light", "[lightmap]") {
+    auto lights = std::vector<emitter>{};
+    for (int x = 0; x < 60; ++x) {
+        for (int y = 0; y < 4; ++y) { lights.push_back(point_light(x, y, 10.0f + (x * 7 + y) % 5)); }
+    }
+    const auto clusters = cluster_emitters(lights, near_viewer);
+    CHECK(members(clusters) == static_cast<int>(lights.size()));
+    CHECK(clusters.size() < lights.size());
+    for (const auto& c : clusters) {
+        CHECK(c.max.x() - c.min.x() <= 4);
+        CHECK(c.max.y() - c.min.y() <= 4);
+    }
+}
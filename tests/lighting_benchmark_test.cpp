@@ -0,0 +1,182 @@
+#include "avatar.h"
+#include "calendar.h"
+#include "cata_utility.h"
+#include "catch/catch.hpp"
+#include "compute/compute_backend.h"
+#include "game.h"
+#include "game_constants.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "options_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "type_id.h"
+#include "units_angle.h"
+#include "vehicle.h"
+#include "vehicle_part.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
+
+#if defined(CATA_SDL)
+#    include "compute/gpu_lm.h"
+#endif
+
+#include <array>
+#include <string>
+
+// Cost of the lighting path on fixed scenes, to choose a compute backend.  Hidden: run it
+// once per backend,
+//     CATA_TEST_COMPUTE_ACCELERATION=cpu tests/cata_test "[lighting_benchmark]"
+//     CATA_TEST_COMPUTE_ACCELERATION=gpu_software tests/cata_test "[lighting_benchmark]"
+//     CATA_TEST_COMPUTE_ACCELERATION=gpu tests/cata_test "[lighting_benchmark]"
+// Each scene is built the same way every run, for every reality bubble size, so numbers are
+// comparable between backends and builds.  On the GPU backends the phases of one lighting
+// pass follow as a warning, the readback among them.
+
+namespace {
+
+const auto midday = calendar::turn_zero + 12_hours;
+const auto midnight = calendar::turn_zero + 0_hours;
+
+auto center_of(const map& here, int z) -> tripoint_bub_ms {
+    const auto side = here.getmapsize() * SEEX;
+    return tripoint_bub_ms(side / 2, side / 2, z);
+}
+
+auto fill_level(map& here, int z, const ter_id& terrain) -> void {
+    for (const auto& p : here.points_on_zlevel(z)) {
+        here.furn_set(p, furn_id("f_null"));
+        here.ter_set(p, terrain);
+    }
+}
+
+// Square rooms in a grid, with a door in the middle of each wall and a light in the middle.
+auto add_rooms(map& here, int z, int room, int spacing, const ter_id& floor, const ter_id& light)
+    -> void {
+    const auto t_wall = ter_id("t_concrete_wall");
+    const auto side = here.getmapsize() * SEEX;
+    for (int x0 = 2; x0 + room < side; x0 += spacing) {
+        for (int y0 = 2; y0 + room < side; y0 += spacing) {
+            for (int x = x0; x < x0 + room; ++x) {
+                for (int y = y0; y < y0 + room; ++y) {
+                    const auto edge = x == x0 || y == y0 || x == x0 + room - 1 || y == y0 + room - 1;
+                    const auto door = x == x0 + room / 2 || y == y0 + room / 2;
+                    here.ter_set(tripoint_bub_ms(x, y, z), edge && !door ? t_wall : floor);
+                }
+            }
+            here.ter_set(tripoint_bub_ms(x0 + room / 2, y0 + room / 2, z), light);
+        }
+    }
+}
+
+auto open_field(map& here) -> void { fill_level(here, 0, ter_id("t_grass")); }
+
+auto dense_city(map& here) -> void {
+    fill_level(here, 0, ter_id("t_pavement"));
+    add_rooms(here, 0, 12, 16, ter_id("t_floor"), ter_id("t_floor_olight"));
+}
+
+auto underground_lab(map& here) -> void {
+    fill_level(here, 0, ter_id("t_grass"));
+    fill_level(here, -1, ter_id("t_rock"));
+    // Corridors through the rock join the rooms' doors.
+    const auto side = here.getmapsize() * SEEX;
+    for (int i = 0; i < side; ++i) {
+        for (int lane = 2 + 5; lane < side; lane += 14) {
+            here.ter_set(tripoint_bub_ms(i, lane, -1), ter_id("t_thconc_floor"));
+            here.ter_set(tripoint_bub_ms(lane, i, -1), ter_id("t_thconc_floor"));
+        }
+    }
+    add_rooms(here, -1, 10, 14, ter_id("t_thconc_floor"), ter_id("t_thconc_floor_olight"));
+}
+
+auto convoy(map& here) -> void {
+    fill_level(here, 0, ter_id("t_pavement"));
+    const auto origin = center_of(here, 0);
+    for (int i = 0; i < 8; ++i) {
+        const auto offset = tripoint_rel_ms(6 + (i % 2) * 5, -24 + i * 7, 0);
+        auto* const veh = here.add_vehicle(vproto_id("car"), origin + offset, 0_degrees, 0, 0);
+        REQUIRE(veh != nullptr);
+        for (const vpart_reference& vp : veh->get_all_parts()) {
+            if (vp.part().is_light()) { vp.part().enabled = true; }
+        }
+    }
+}
+
+struct scene {
+    const char* name;
+    void (*build)(map&);
+    time_point time;
+    int z = 0;
+};
+
+const auto scenes = std::array{
+    scene{.name = "open field at noon", .build = open_field, .time = midday},
+    scene{.name = "dense city at night", .build = dense_city, .time = midnight},
+    scene{.name = "underground lab", .build = underground_lab, .time = midday, .z = -1},
+    scene{.name = "convoy with headlights", .build = convoy, .time = midnight},
+};
+
+auto dirty_structure(map& here, int z) -> void {
+    here.set_transparency_cache_dirty(z);
+    here.set_outside_cache_dirty(z);
+    here.set_floor_cache_dirty(z);
+}
+
+} // namespace
+
+TEST_CASE("lighting backend benchmark", "[.][lighting_benchmark][benchmark]") {
+    const auto bubble_size = GENERATE(2, 4, 6);
+    const auto& s = scenes[GENERATE(0, 1, 2, 3)];
+
+    clear_all_state();
+    // Runs after the option is restored, to resize back.
+    const auto restore = on_out_of_scope([]() {
+        g->on_options_changed();
+        clear_all_state();
+    });
+    const auto bubble = override_option("REALITY_BUBBLE_SIZE", std::to_string(bubble_size));
+    g->on_options_changed();
+    auto& here = get_map();
+    s.build(here);
+    set_time(s.time);
+    g->u.setpos(map_local_to_abs(here, center_of(here, s.z)));
+    here.invalidate_map_cache(s.z);
+    here.build_map_cache(s.z);
+
+    const auto label = [&](const char* kernel) {
+        return string_format(
+            "%s: %s, mapsize %d, %s", kernel, s.name, g_mapsize,
+            std::string{cata_compute::selected_backend_name()});
+    };
+
+    BENCHMARK(label("build_map_cache")) {
+        dirty_structure(here, s.z);
+        here.build_map_cache(s.z, true);
+    };
+
+    BENCHMARK(label("generate_lightmap")) {
+        here.invalidate_lightmap_caches();
+        here.build_map_cache(s.z);
+    };
+
+    BENCHMARK(label("build_seen_cache")) {
+        here.set_seen_cache_dirty(s.z);
+        here.build_map_cache(s.z, true);
+        here.update_visibility_cache(s.z);
+    };
+
+#if defined(CATA_SDL)
+    if (cata_compute::uses_sdl_gpu_compute()) {
+        here.invalidate_lightmap_caches();
+        here.build_map_cache(s.z);
+        const auto t = cata_gpu::last_gpu_lighting_timings();
+        WARN(string_format(
+            "%s phases (ms): collect %.3f, pack %.3f, upload %.3f, record %.3f, "
+            "kernels %.3f, readback %.3f",
+            label("generate_lightmap"), t.collect_sources_ms, t.pack_inputs_ms,
+            t.stage_upload_ms, t.record_commands_ms, t.fence_wait_ms, t.readback_ms));
+    }
+#endif
+}
@@ -0,0 +1,70 @@
+#include "catch/catch.hpp"
+#include "lock_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+
+namespace {
+
+auto usage_of(const std::string& name) -> lock_stats::site_usage {
+    const auto usage = lock_stats::collect();
+    const auto it = std::ranges::find(usage, name, &lock_stats::site_usage::name);
+    REQUIRE(it != usage.end());
+    return *it;
+}
+
+} // namespace
+
+TEST_CASE("counted_mutexes_count_acquisitions_and_contention", "[lock_stats]") {
+    using test_mutex = lock_stats::counted<std::mutex, "lock_stats_test::mutex">;
+    auto a = test_mutex();
+    auto b = test_mutex();
+    lock_stats::reset();
+    {
+        const auto lk = std::lock_guard(a);
+    }
+    {
+        const auto lk = std::lock_guard(b);
+    }
+    CHECK(a.try_lock());
+    a.unlock();
+
+    // Both mutexes report under their one name
+    auto usage = usage_of("lock_stats_test::mutex");
+    CHECK(usage.acquisitions == 3);
+    CHECK(usage.contended == 0);
+
+    a.lock();
+    auto waiter = std::thread([&]() { const auto lk = std::lock_guard(a); });
+    // The acquisition is counted before the waiter finds the mutex held
+    while (usage_of("lock_stats_test::mutex").acquisitions < 5) { std::this_thread::yield(); }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    a.unlock();
+    waiter.join();
+
+    usage = usage_of("lock_stats_test::mutex");
+    CHECK(usage.acquisitions == 5);
+    CHECK(usage.contended == 1);
+    CHECK(usage.wait_ms > 0.0);
+
+    lock_stats::reset();
+    CHECK(usage_of("lock_stats_test::mutex").acquisitions == 0);
+}
+
+TEST_CASE("counted_shared_mutexes_count_shared_locks", "[lock_stats]") {
+    auto m = lock_stats::counted<std::shared_mutex, "lock_stats_test::shared_mutex">();
+    lock_stats::reset();
+    {
+        const auto reader = std::shared_lock(m);
+    }
+    CHECK(m.try_lock_shared());
+    m.unlock_shared();
+    {
+        const auto writer = std::unique_lock(m);
+    }
+    CHECK(usage_of("lock_stats_test::shared_mutex").acquisitions == 3);
+}
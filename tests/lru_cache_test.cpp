@@ -0,0 +1,71 @@
+#include "catch/catch.hpp"
+#include "lru_cache.h"
+
+#include <ranges>
+#include <vector>
+
+#include "point.h"
+
+namespace {
+
+auto keys_of(const lru_cache<tripoint, int>& cache) -> std::vector<tripoint> {
+    auto keys = std::vector<tripoint>();
+    for (const auto& [key, value] : cache.list()) { keys.push_back(key); }
+    return keys;
+}
+
+} // namespace
+
+TEST_CASE("lru_cache_evicts_least_recently_inserted", "[lru_cache]") {
+    auto cache = lru_cache<tripoint, int>();
+    cache.insert(3, tripoint(1, 0, 0), 1);
+    cache.insert(3, tripoint(2, 0, 0), 2);
+    cache.insert(3, tripoint(3, 0, 0), 3);
+
+    // Reinserting refreshes the entry and its value
+    cache.insert(3, tripoint(1, 0, 0), 10);
+    cache.insert(3, tripoint(4, 0, 0), 4);
+
+    CHECK(cache.size() == 3);
+    CHECK(keys_of(cache) == std::vector{tripoint(3, 0, 0), tripoint(1, 0, 0), tripoint(4, 0, 0)});
+    CHECK(cache.get(tripoint(1, 0, 0), -1) == 10);
+    CHECK(cache.get(tripoint(2, 0, 0), -1) == -1);
+    CHECK(cache.find(tripoint(2, 0, 0)) == nullptr);
+    CHECK(cache.stats().evictions == 1);
+    CHECK(cache.stats().hits == 1);
+    CHECK(cache.stats().misses == 2);
+
+    cache.reset_stats();
+    CHECK(cache.stats().hit_rate() == 0.0);
+}
+
+TEST_CASE("lru_cache_stays_consistent_through_removals", "[lru_cache]") {
+    auto cache = lru_cache<tripoint, int>();
+    constexpr auto limit = 64;
+    // Enough churn to wrap probe runs and move entries around the array
+    for (auto i = 0; i < 1000; ++i) {
+        cache.insert(limit, tripoint(i % 97, i % 13, 0), i);
+        if (i % 3 == 0) { cache.remove(tripoint((i + 7) % 97, (i + 7) % 13, 0)); }
+    }
+    CHECK(cache.size() <= limit);
+    for (const auto& [key, value] : cache.list()) {
+        const auto* const found = cache.find(key);
+        REQUIRE(found != nullptr);
+        CHECK(*found == value);
+    }
+
+    const auto listed = cache.list();
+    for (const auto& [key, value] : listed | std::views::take(listed.size() / 2)) {
+        cache.remove(key);
+    }
+    CHECK(cache.size() == listed.size() - listed.size() / 2);
+    for (const auto& [key, value] : listed | std::views::drop(listed.size() / 2)) {
+        CHECK(cache.get(key, -1) == value);
+    }
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+    CHECK(cache.get(tripoint(1, 1, 0), -1) == -1);
+    cache.insert(limit, tripoint(1, 1, 0), 5);
+    CHECK(cache.get(tripoint(1, 1, 0), -1) == 5);
+}
@@ -0,0 +1,59 @@
+#include "cache_layout.h"
+#include "catch/catch.hpp"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <random>
+#include <string>
+
+// Cost of rebuilding the map caches, to compare cache_layout orders.  Hidden: build once
+// per LEVEL_CACHE_LAYOUT and run
+//     tests/cata_test "[map_cache_benchmark]"
+// The scattered walls are seeded, so numbers are comparable between builds.
+
+namespace {
+
+constexpr auto benchmark_seed = 20261014U;
+
+auto scatter_walls(map& here) -> void {
+    const auto t_brick_wall = ter_id("t_brick_wall");
+    auto rng = std::mt19937(benchmark_seed);
+    auto pick = std::uniform_int_distribution<int>(0, 99);
+    for (const auto& p : here.points_on_zlevel(0)) {
+        if (pick(rng) < 8) { here.ter_set(p, t_brick_wall); }
+    }
+}
+
+auto dirty_all(map& here) -> void {
+    here.set_transparency_cache_dirty(0);
+    here.set_outside_cache_dirty(0);
+    here.set_floor_cache_dirty(0);
+    here.set_seen_cache_dirty(0);
+}
+
+} // namespace
+
+TEST_CASE("map cache rebuild", "[.][map_cache_benchmark][benchmark]") {
+    clear_all_state();
+    auto& here = get_map();
+    scatter_walls(here);
+    here.build_map_cache(0);
+
+    WARN("level_cache layout: " << (cache_layout::tiled ? "tiled" : "linear"));
+
+    BENCHMARK("build_map_cache without lightmap") {
+        dirty_all(here);
+        here.build_map_cache(0, true);
+    };
+
+    BENCHMARK("build_map_cache") {
+        dirty_all(here);
+        here.build_map_cache(0);
+    };
+
+    clear_all_state();
+}
@@ -99,3 +99,10 @@ TEST_CASE("mx_minefield theoretical spawn", "[map_extra][overmap]") {
         CHECK(setup_terrain_and_generate(target, dir));
     }
 }
+
+TEST_CASE("map_extra_functions_are_resolved_on_load", "[map_extra]") {
+    const auto& minefield = string_id<map_extra>("mx_minefield").obj();
+    REQUIRE(minefield.generator_method == map_extra_method::map_extra_function);
+    CHECK(minefield.function == MapExtras::get_function(minefield.generator_id));
+    CHECK(minefield.function != nullptr);
+}
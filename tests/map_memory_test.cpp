@@ -1,6 +1,7 @@
 #include "cata_dynamic_bitset.h"
 #include "catch/catch.hpp"
 #include "coordinates.h"
+#include "fstream_utils.h"
 #include "game_constants.h"
 #include "json.h"
 #include "lru_cache.h"
@@ -67,7 +68,48 @@ TEST_CASE("map_memory_forgets", "[map_memory]") {
     memory.memorize_symbol(p3, 1);
 }
 
-// TODO: map memory save / load
+TEST_CASE("map_memory_tile_names_are_interned", "[map_memory]") {
+    auto& names = memorized_tile_names::get();
+    const auto id = names.intern("t_dirt");
+    CHECK(names.intern(std::string("t_dirt")) == id);
+    CHECK(names.intern("t_grass") != id);
+    CHECK(names.name(id) == "t_dirt");
+    CHECK(names.intern("") == memorized_tile_names::none);
+}
+
+TEST_CASE("mm_submap_round_trips_through_json", "[map_memory]") {
+    auto sm = mm_submap();
+    sm.set_tile(point_sm_ms(1, 2), memorized_terrain_tile{"f_chair", 3, 2});
+    sm.set_terrain_tile(point_sm_ms(0, 0), memorized_terrain_tile{"t_floor", 1, 0});
+    sm.set_symbol(point_sm_ms(4, 5), 'x');
+    REQUIRE(!sm.is_empty());
+
+    auto loaded = mm_submap();
+    deserialize(loaded, serialize(sm));
+    CHECK(loaded.tile(point_sm_ms(1, 2)) == memorized_terrain_tile{"f_chair", 3, 2});
+    CHECK(loaded.tile(point_sm_ms(2, 1)).tile.empty());
+    CHECK(loaded.terrain_tile(point_sm_ms(0, 0)) == memorized_terrain_tile{"t_floor", 1, 0});
+    CHECK(loaded.symbol(point_sm_ms(4, 5)) == 'x');
+    CHECK(loaded.symbol(point_sm_ms(5, 4)) == mm_submap::default_symbol);
+}
+
+TEST_CASE("mm_submap_compacts_uniform_layers", "[map_memory]") {
+    auto sm = mm_submap();
+    sm.set_symbol(point_sm_ms(3, 3), 'x');
+    sm.set_symbol(point_sm_ms(3, 3), mm_submap::default_symbol);
+    sm.compact();
+    CHECK(sm.is_empty());
+
+    for (auto y = 0; y < SEEY; ++y) {
+        for (auto x = 0; x < SEEX; ++x) {
+            sm.set_terrain_tile(point_sm_ms(x, y), memorized_terrain_tile{"t_dirt", 0, 0});
+        }
+    }
+    sm.compact();
+    CHECK(!sm.is_empty());
+    CHECK(sm.terrain_tile(point_sm_ms(SEEX - 1, SEEY - 1)) ==
+          memorized_terrain_tile{"t_dirt", 0, 0});
+}
 
 #include <chrono>
 
@@ -1,5 +1,7 @@
 #include "avatar.h"
 #include "avatar_action.h"
+#include "cached_options.h"
+#include "calendar.h"
 #include "cata_utility.h"
 #include "catch/catch.hpp"
 #include "computer.h"
@@ -15,6 +17,7 @@
 #include "map_helpers.h"
 #include "mapbuffer.h"
 #include "mapbuffer_registry.h"
+#include "mapdata.h"
 #include "mapgen_constructor.h"
 #include "monster.h"
 #include "npc.h"
@@ -25,7 +28,9 @@
 #include "type_id.h"
 #include "vehicle.h"
 
+#include <algorithm>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace {
@@ -549,11 +554,166 @@ TEST_CASE("mapbuffer_simulated_lookup_uses_load_manager_membership") {
     CHECK(buffer.get_submap(sm_pos) == nullptr);
     submap_loader.release_load(lazy_handle);
 
+    const auto prefetch_handle = submap_loader.request_load(
+        load_request_source::prefetch, dim_id, request_begin, request_end);
+    CHECK(buffer.get_submap(sm_pos) == nullptr);
+    CHECK(std::ranges::none_of(submap_loader.non_bubble_requests(), [](const submap_load_request& req) {
+        return req.source == load_request_source::prefetch;
+    }));
+    submap_loader.release_load(prefetch_handle);
+
     full_handle =
         submap_loader.request_load(load_request_source::script, dim_id, request_begin, request_end);
     CHECK(buffer.get_submap(sm_pos) == sm);
 }
 
+TEST_CASE("prefetch_bounds_extend_bubble_along_heading") {
+    const auto begin = point_abs_sm(10, 20);
+    const auto end = point_abs_sm(23, 33);
+
+    CHECK_FALSE(prefetch_bounds_ahead(begin, end, point_zero, 4).has_value());
+    CHECK_FALSE(prefetch_bounds_ahead(begin, end, point_east, 0).has_value());
+
+    const auto east = prefetch_bounds_ahead(begin, end, point_east * 7, 4);
+    REQUIRE(east.has_value());
+    CHECK(east->first == begin);
+    CHECK(east->second == point_abs_sm(27, 33));
+
+    const auto north_west = prefetch_bounds_ahead(begin, end, point_north_west, 3);
+    REQUIRE(north_west.has_value());
+    CHECK(north_west->first == point_abs_sm(7, 17));
+    CHECK(north_west->second == end);
+}
+
+TEST_CASE("submap_load_manager_covering_source_prefers_simulation") {
+    static const dimension_id dim_id("covering_source_test_dim");
+    auto loader = submap_load_manager();
+    const auto pos = point_abs_sm(50, 50);
+    loader.request_load(load_request_source::lazy_border, dim_id, pos, pos + point_rel_sm(2, 2));
+    CHECK(loader.covering_source(dim_id, pos) == load_request_source::lazy_border);
+    loader.request_load(load_request_source::fire_spread, dim_id, pos, pos + point_rel_sm(1, 1));
+    loader.request_load(load_request_source::script, dim_id, pos, pos + point_rel_sm(1, 1));
+    CHECK(loader.covering_source(dim_id, pos) == load_request_source::script);
+    CHECK(loader.covering_source(dim_id, pos + point_rel_sm(1, 1)) == load_request_source::lazy_border);
+    CHECK_FALSE(loader.covering_source(dim_id, pos + point_rel_sm(2, 2)).has_value());
+    CHECK_FALSE(loader.covering_source(dimension_id("other_dim"), pos).has_value());
+}
+
+TEST_CASE("submap_load_manager_counts_churn_and_thrashing") {
+    clear_all_state();
+
+    auto restore_cache_length = restore_on_out_of_scope<int>(retained_omt_cache_length);
+    auto restore_turn = restore_on_out_of_scope<time_point>(calendar::turn);
+    // Retain a single column, so leaving a 2x2 area evicts the other three
+    retained_omt_cache_length = 1;
+
+    const auto& dim_id = MAPBUFFER.get_dimension_id();
+    const auto home = point_abs_sm(1600, -1600);
+    const auto away = point_abs_sm(1700, -1600);
+    const auto size = point_rel_sm(4, 4);
+    const auto per_column = std::uint64_t{4 * OVERMAP_LAYERS};
+    const auto script = static_cast<std::size_t>(load_request_source::script);
+    // A local manager keeps the game's own requests out of the retention caps
+    auto loader = submap_load_manager();
+    const auto cleanup = on_out_of_scope([&]() {
+        for (const auto& corner : {home, away}) {
+            for (auto omt = 0; omt < 4; ++omt) {
+                const auto omt_xy = project_to<coords::omt>(corner) + point_rel_omt(omt % 2, omt / 2);
+                for (auto z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z) {
+                    MAPBUFFER.unload_omt(tripoint_abs_omt(omt_xy, z), false);
+                }
+            }
+        }
+    });
+
+    const auto handle = loader.request_load(load_request_source::script, dim_id, home, home + size);
+    loader.update();
+    CHECK(loader.total_churn().loaded[script] + loader.total_churn().generated[script] == 4 * per_column);
+
+    loader.reset_churn();
+    // Leaving evicts two columns at once, since four are over twice the cap, then one more
+    loader.update_request(handle, away, away + size);
+    loader.update();
+    loader.update();
+    CHECK(loader.total_churn().evicted == 3 * per_column);
+    CHECK(loader.total_churn().thrashed == 0);
+
+    // Coming back finds one column still retained and reloads the evicted ones
+    loader.update_request(handle, home, home + size);
+    loader.update();
+    const auto churn = loader.total_churn();
+    CHECK(churn.resurrected[script] == per_column);
+    CHECK(churn.loaded[script] + churn.generated[script] == 7 * per_column);
+    CHECK(churn.thrashed == 3);
+    CHECK(churn.loaded[static_cast<std::size_t>(load_request_source::reality_bubble)] == 0);
+
+    CHECK(loader.last_turn_churn().thrashed == 0);
+    calendar::turn += 1_turns;
+    CHECK(loader.last_turn_churn().thrashed == 3);
+    calendar::turn += 1_turns;
+    CHECK(loader.last_turn_churn().thrashed == 0);
+    CHECK(loader.total_churn().thrashed == 3);
+}
+
+TEST_CASE("submap_load_manager_memory_budget_evicts_by_source") {
+    clear_all_state();
+
+    auto restore_cache_length = restore_on_out_of_scope<int>(retained_omt_cache_length);
+    auto restore_budget = restore_on_out_of_scope<int>(map_memory_budget_mb);
+    auto restore_turn = restore_on_out_of_scope<time_point>(calendar::turn);
+    // Room for every column, so only the memory budget evicts
+    retained_omt_cache_length = 20;
+    map_memory_budget_mb = 0;
+
+    const auto& dim_id = MAPBUFFER.get_dimension_id();
+    const auto base = point_abs_sm(1800, -1600);
+    const auto scripted = point_abs_sm(1900, -1600);
+    const auto size = point_rel_sm(4, 4);
+    const auto columns_of = [](const point_abs_sm& corner) {
+        auto columns = std::vector<point_abs_omt>();
+        for (auto omt = 0; omt < 4; ++omt) {
+            columns.push_back(project_to<coords::omt>(corner) + point_rel_omt(omt % 2, omt / 2));
+        }
+        return columns;
+    };
+    auto loader = submap_load_manager();
+    const auto retained_in = [&](const point_abs_sm& corner) {
+        return std::ranges::count_if(columns_of(corner), [&](const point_abs_omt& omt_xy) {
+            return loader.is_retained(dim_id, omt_xy);
+        });
+    };
+    const auto cleanup = on_out_of_scope([&]() {
+        for (const auto& corner : {base, scripted}) {
+            for (const auto& omt_xy : columns_of(corner)) {
+                for (auto z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z) {
+                    MAPBUFFER.unload_omt(tripoint_abs_omt(omt_xy, z), false);
+                }
+            }
+        }
+    });
+
+    const auto base_handle = loader.request_load(load_request_source::player_base, dim_id, base, base + size);
+    const auto script_handle = loader.request_load(load_request_source::script, dim_id, scripted, scripted + size);
+    loader.update();
+    loader.release_load(base_handle);
+    loader.release_load(script_handle);
+    loader.update();
+    REQUIRE(retained_in(base) == 4);
+    REQUIRE(retained_in(scripted) == 4);
+
+    // Without a budget, leaving is all that happens
+    calendar::turn += 1_minutes;
+    loader.update();
+    CHECK(retained_in(base) + retained_in(scripted) == 8);
+
+    // Over a megabyte of submaps; script columns go before the base's
+    map_memory_budget_mb = 1;
+    loader.update();
+    CHECK(loader.total_churn().evicted > 0);
+    CHECK(retained_in(scripted) < 4);
+    if (retained_in(base) < 4) { CHECK(retained_in(scripted) == 0); }
+}
+
 TEST_CASE("mapbuffer_load_or_generate_lookup_is_explicit") {
     clear_all_state();
 
@@ -826,3 +986,56 @@ TEST_CASE("bash_through_roof_can_destroy_multiple_times") {
         }
     }
 }
+
+TEST_CASE("single_tile_changes_patch_flat_caches", "[map][map_cache]") {
+    clear_all_state();
+    auto& here = get_map();
+    build_test_map(ter_id("t_pavement"));
+    const auto p = tripoint_bub_ms(61, 62, 0);
+    here.build_map_cache(p.z(), true);
+    const auto& ch = here.get_cache_ref(p.z());
+    const auto i = ch.idx(p.x(), p.y());
+    REQUIRE(ch.transparency_cache[i] > LIGHT_TRANSPARENCY_SOLID);
+    REQUIRE(ch.floor_cache[i] != 0);
+
+    here.ter_set(p, ter_id("t_brick_wall"));
+    CHECK(ch.transparency_cache_dirty.none());
+    CHECK_FALSE(ch.transparency_dirty_tiles.empty());
+    here.build_map_cache(p.z(), true);
+    CHECK(ch.transparency_dirty_tiles.empty());
+    CHECK(ch.transparency_cache[i] == LIGHT_TRANSPARENCY_SOLID);
+    CHECK(ch.transparency_cache[ch.idx(p.x() + 1, p.y())] > LIGHT_TRANSPARENCY_SOLID);
+
+    here.ter_set(p, ter_id("t_open_air"));
+    here.build_map_cache(p.z(), true);
+    CHECK(ch.floor_dirty_tiles.empty());
+    CHECK(ch.floor_cache[i] == 0);
+    CHECK(ch.floor_cache[ch.idx(p.x(), p.y() + 1)] != 0);
+    CHECK(here.get_transparency(p) == ch.transparency_cache[i]);
+}
+
+TEST_CASE("cache_attr_tables_match_terrain_and_furniture", "[map][map_cache]") {
+    for (const auto& ter : ter_t::get_all()) {
+        const auto id = ter.id.id();
+        CAPTURE(ter.id.str());
+        CHECK(cache_attr::move_cost(id) == ter.movecost);
+        CHECK(cache_attr::bash_strength(id) == std::pair(ter.bash.str_min, ter.bash.str_max));
+        const auto flags = cache_attr::of(id);
+        CHECK(((flags & cache_attr::transparent) != 0) == ter.transparent);
+        CHECK(((flags & cache_attr::ledge) != 0) == ter.has_flag(TFLAG_NO_FLOOR));
+        CHECK(((flags & cache_attr::climbable) != 0) == ter.has_flag(TFLAG_CLIMBABLE));
+        CHECK(((flags & cache_attr::openable) != 0) == static_cast<bool>(ter.open));
+        CHECK(((flags & cache_attr::wall) != 0) == ter.has_flag(TFLAG_WALL));
+        CHECK(((flags & cache_attr::bash_below) != 0) == ter.bash.bash_below);
+    }
+    for (const auto& furn : furn_t::get_all()) {
+        const auto id = furn.id.id();
+        CAPTURE(furn.id.str());
+        CHECK(cache_attr::move_cost(id) == furn.movecost);
+        CHECK(cache_attr::bash_strength(id) == std::pair(furn.bash.str_min, furn.bash.str_max));
+        const auto flags = cache_attr::of(id);
+        CHECK(((flags & cache_attr::present) != 0) == static_cast<bool>(furn.id));
+        CHECK(((flags & cache_attr::sun_roof_above) != 0) == furn.has_flag(TFLAG_SUN_ROOF_ABOVE));
+        CHECK(((flags & cache_attr::opens_inside) != 0) == furn.has_flag("OPENCLOSE_INSIDE"));
+    }
+}
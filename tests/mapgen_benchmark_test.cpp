@@ -0,0 +1,190 @@
+#include "alloc_profiling.h"
+#include "catch/catch.hpp"
+#include "clzones.h"
+#include "coordinates.h"
+#include "mapbuffer.h"
+#include "mapbuffer_registry.h"
+#include "mapgen_async.h"
+#include "omdata.h"
+#include "overmapbuffer.h"
+#include "rng.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "thread_pool.h"
+#include "type_id.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Throughput of mapgen on fixed sets of overmap terrain, through the synchronous
+// path and the worker path the submap loader uses.  Hidden: run with
+//     tests/cata_test "[mapgen_benchmark]"
+// Every run uses the same seed, so numbers are comparable between builds.
+
+#if !defined(CATA_ALLOC_PROFILING)
+namespace {
+
+// Every allocation through the global operator new, to report allocations per OMT.
+std::atomic<std::size_t> allocations{0};
+
+} // namespace
+
+auto operator new(std::size_t size) -> void* {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto* const p = std::malloc(size == 0 ? 1 : size)) { return p; }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+#endif
+
+namespace {
+
+constexpr auto benchmark_seed = 20261014U;
+// OMTs generated per set and path.  The sets are laid out in rows of the first
+// overmap, south of where the test avatar stands.
+constexpr auto omts_per_run = 64;
+constexpr auto row_length = 32;
+constexpr auto first_row = 40;
+
+using clock_type = std::chrono::steady_clock;
+
+/// Allocations by all threads so far, from whichever operator new is counting them.
+auto allocation_count() -> std::size_t {
+#if defined(CATA_ALLOC_PROFILING)
+    return alloc_profiling::total().allocations;
+#else
+    return allocations.load();
+#endif
+}
+
+struct omt_set {
+    const char* name;
+    std::vector<std::string> terrains;
+};
+
+auto benchmark_sets() -> std::vector<omt_set> {
+    return {
+        {"dense city",
+         {"house_01", "house_w_1", "s_grocery", "s_restaurant", "s_hardware", "office_doctor",
+          "police", "road_ns"}},
+        {"forest", {"forest", "forest_thick", "field"}},
+        {"lab", {"lab", "lab_stairs", "lab_core"}},
+        {"military base", {"mil_base_4j", "mil_base_7i", "mil_base_8i"}},
+    };
+}
+
+/// Rotatable terrain is only defined with its direction suffix.
+auto terrain_id(const std::string& name) -> oter_id {
+    const auto plain = oter_str_id(name);
+    if (plain.is_valid()) { return plain.id(); }
+    const auto north = oter_str_id(name + "_north");
+    REQUIRE(north.is_valid());
+    return north.id();
+}
+
+/// Lays out @p set at row block @p run and returns the OMTs it covers.
+auto lay_out(const omt_set& set, const int run) -> std::vector<tripoint_abs_omt> {
+    auto& omb = ACTIVE_OVERMAP_BUFFER;
+    auto omts = std::vector<tripoint_abs_omt>{};
+    const auto row = first_row + run * (omts_per_run / row_length);
+    for (auto i = 0; i < omts_per_run; ++i) {
+        const auto p = tripoint_abs_omt(i % row_length, row + i / row_length, 0);
+        omb.ter_set(p, terrain_id(set.terrains[i % set.terrains.size()]));
+        omts.push_back(p);
+    }
+    return omts;
+}
+
+struct run_result {
+    double seconds = 0.0;
+    std::size_t allocations = 0;
+};
+
+auto run_sync(mapbuffer& buffer, const std::vector<tripoint_abs_omt>& omts,
+              std::map<std::string, std::pair<double, int>>& by_mapgen) -> run_result {
+    auto result = run_result{};
+    const auto allocations_before = allocation_count();
+    for (const auto& omt : omts) {
+        const auto start = clock_type::now();
+        buffer.generate_omt(omt);
+        const auto seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+        auto& [total, count] = by_mapgen[ACTIVE_OVERMAP_BUFFER.ter(omt)->get_mapgen_id()];
+        total += seconds;
+        ++count;
+        result.seconds += seconds;
+    }
+    result.allocations = allocation_count() - allocations_before;
+    return result;
+}
+
+auto run_async(mapbuffer& buffer, const std::vector<tripoint_abs_omt>& omts) -> run_result {
+    const auto allocations_before = allocation_count();
+    const auto start = clock_type::now();
+    auto results = std::vector<mapgen_result>(omts.size());
+    parallel_for("mapgen_benchmark", 0, static_cast<int>(omts.size()), [&](const int i) {
+        results[i] =
+            buffer.generate_omt(omts[i], {.defer_postprocess_hooks = true, .worker_safe = true});
+    });
+    // Same as the submap loader: whatever needs Lua finishes on the main thread.
+    for (std::size_t i = 0; i < omts.size(); ++i) {
+        if (results[i].needs_main_thread()) {
+            buffer.generate_omt(omts[i], {.defer_postprocess_hooks = true,
+                                          .use_selected_mapgen = true,
+                                          .selected_mapgen = results[i].selected_mapgen});
+        }
+    }
+    run_deferred_mapgen_hooks();
+    flush_deferred_zones();
+    run_deferred_autonotes();
+    return {
+        .seconds = std::chrono::duration<double>(clock_type::now() - start).count(),
+        .allocations = allocation_count() - allocations_before,
+    };
+}
+
+auto report(const std::string& label, const run_result& result) -> void {
+    WARN(string_format("%s: %.1f OMTs/s, %.0f allocations per OMT (%d OMTs, %.3f s)", label,
+                       omts_per_run / result.seconds,
+                       static_cast<double>(result.allocations) / omts_per_run, omts_per_run,
+                       result.seconds));
+}
+
+} // namespace
+
+TEST_CASE("mapgen throughput by terrain set", "[.][mapgen_benchmark][benchmark]") {
+    clear_all_state();
+    auto& buffer = MAPBUFFER_REGISTRY.get(mapbuffer_registry::primary_dimension_id());
+    auto by_mapgen = std::map<std::string, std::pair<double, int>>{};
+
+    auto run = 0;
+    for (const auto& set : benchmark_sets()) {
+        rng_set_engine_seed(benchmark_seed);
+        report(string_format("%s, synchronous", set.name),
+               run_sync(buffer, lay_out(set, run++), by_mapgen));
+        rng_set_engine_seed(benchmark_seed);
+        report(string_format("%s, worker", set.name), run_async(buffer, lay_out(set, run++)));
+    }
+
+    auto slowest = std::vector<std::pair<std::string, std::pair<double, int>>>(by_mapgen.begin(),
+                                                                                by_mapgen.end());
+    std::ranges::sort(slowest, [](const auto& a, const auto& b) {
+        return a.second.first / a.second.second > b.second.first / b.second.second;
+    });
+    for (const auto& [id, timing] : slowest) {
+        WARN(string_format("%s: %.3f ms per OMT (%d OMTs)", id, timing.first / timing.second * 1e3,
+                           timing.second));
+    }
+    clear_all_state();
+}
@@ -1,5 +1,8 @@
 #include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "map.h"
 #include "mapgen.h"
+#include "mapgen_functions.h"
 #include "type_id.h"
 
 TEST_CASE("connects_to", "[mapgen][connects]") {
@@ -86,3 +89,13 @@ TEST_CASE("connects_to", "[mapgen][connects]") {
         CHECK(connects_to(oter_id("sewer_nesw"), west));
     }
 }
+
+TEST_CASE("mapgen_that_only_fills_is_uniform", "[mapgen]") {
+    const auto restore = restore_on_out_of_scope<bool>(disable_mapgen);
+    disable_mapgen = false;
+    CHECK(uniform_mapgen_terrain("lake_water_cube") == ter_id("t_water_cube"));
+    // Filled, but with rows drawn over it
+    CHECK_FALSE(uniform_mapgen_terrain("lake_bed"));
+    CHECK_FALSE(uniform_mapgen_terrain("field"));
+    CHECK_FALSE(uniform_mapgen_terrain("no_such_mapgen"));
+}
@@ -13,7 +13,9 @@
 #include "type_id.h"
 
 #include <cstddef>
+#include <map>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -201,3 +203,52 @@ TEST_CASE("memorials") {
 
     check_memorial<event_type::triggers_alarm>(m, b, "Set off an alarm.", ch);
 }
+
+TEST_CASE("memorial log saves only new entries between compactions", "[memorial]") {
+    clear_all_state();
+    auto files = std::map<std::string, std::string>{};
+    const auto write = [&](const std::string& suffix, file_write_fn writer) {
+        std::ostringstream out;
+        writer(out);
+        files[suffix] = out.str();
+        return true;
+    };
+    const auto read = [&](const std::string& suffix, file_read_fn reader) {
+        const auto iter = files.find(suffix);
+        if (iter == files.end()) { return false; }
+        std::istringstream in(iter->second);
+        reader(in);
+        return true;
+    };
+
+    memorial_logger m;
+    m.add("first", "first");
+    REQUIRE(m.save(write));
+    CHECK(files.size() == 1);
+
+    m.add("second", "second");
+    m.add("third", "third");
+    REQUIRE(m.save(write));
+    REQUIRE(files.contains(".1"));
+    CHECK(files[".1"].find("first") == std::string::npos);
+    CHECK(files[".1"].find("third") != std::string::npos);
+
+    // Nothing new, nothing written.
+    const auto before = files;
+    REQUIRE(m.save(write));
+    CHECK(files == before);
+
+    memorial_logger loaded;
+    loaded.load(read);
+    CHECK(loaded.dump() == m.dump());
+
+    // Enough chunks fold everything back into the base file, leaving the old
+    // chunks stale.
+    for (auto i = 0; i < 40; ++i) {
+        loaded.add("more", "more");
+        REQUIRE(loaded.save(write));
+    }
+    memorial_logger compacted;
+    compacted.load(read);
+    CHECK(compacted.dump() == loaded.dump());
+}
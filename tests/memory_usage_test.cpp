@@ -0,0 +1,47 @@
+#include "catch/catch.hpp"
+#include "mapbuffer.h"
+#include "mapbuffer_registry.h"
+#include "memory_usage.h"
+#include "palette_grid.h"
+#include "state_helpers.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+
+TEST_CASE("palette_grid_heap_bytes_follow_the_index_width", "[memory_usage]") {
+    auto grid = palette_grid<int, 144>(0);
+    const auto uniform = grid.heap_bytes();
+    grid.set(3, 1);
+    const auto one_bit = grid.heap_bytes();
+    CHECK(one_bit > uniform);
+    for (auto i = std::size_t{0}; i < 144; ++i) {
+        grid.set(i, static_cast<int>(i));
+    }
+    CHECK(grid.heap_bytes() > one_bit);
+    grid.fill(2);
+    CHECK(grid.heap_bytes() < one_bit);
+}
+
+TEST_CASE("memory_usage_lists_owners_largest_first", "[memory_usage]") {
+    clear_all_state();
+    const auto usage = memory_usage::collect();
+    CHECK(std::ranges::is_sorted(usage, [](const auto& a, const auto& b) {
+        return a.bytes > b.bytes;
+    }));
+
+    const auto submaps = std::ranges::find(usage, std::string("submaps (primary)"),
+                                           &memory_usage::owner_usage::name);
+    REQUIRE(submaps != usage.end());
+    const auto& buffer = MAPBUFFER_REGISTRY.get(mapbuffer_registry::primary_dimension_id());
+    CHECK(submaps->count == buffer.loaded_submap_count());
+    CHECK(submaps->bytes == buffer.memory_usage());
+    // The test map is loaded, so its submaps and level caches take up something
+    CHECK(submaps->bytes > 0);
+    CHECK(std::ranges::find(usage, std::string("level caches"), &memory_usage::owner_usage::name)
+              ->bytes > 0);
+
+    const auto report = memory_usage::describe(usage);
+    CHECK(report.find("submaps (primary)") != std::string::npos);
+    CHECK(report.find("total") != std::string::npos);
+}
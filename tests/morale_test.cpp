@@ -53,6 +53,8 @@ TEST_CASE("player_morale", "[morale]") {
                 CHECK(m.get(MORALE_FOOD_GOOD) == 10);
                 CHECK(m.get(MORALE_FOOD_BAD) == -5);
                 CHECK(m.get_level() == 5);
+                CHECK(m.get_total_positive_value() == 10);
+                CHECK(m.get_total_negative_value() == 5);
             }
             AND_WHEN("it's finished") {
                 m.decay(20_turns);
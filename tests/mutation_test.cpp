@@ -210,3 +210,18 @@ TEST_CASE("Mutating marloss does not crash on missing category data", "[mutation
     CHECK(dummy.mutate_towards(trait_marloss));
     CHECK(dummy.has_trait(trait_marloss));
 }
+
+TEST_CASE("mutation_values_follow_gained_and_lost_traits", "[mutations]") {
+    npc dummy;
+    clear_character(dummy);
+    CHECK(dummy.mutation_value("speed_modifier") == Approx(1.0f));
+
+    dummy.set_mutation(trait_id("QUICK"));
+    CHECK(dummy.mutation_value("speed_modifier") == Approx(1.1f));
+    // Recalculating enchantments every turn leaves the mutations as they were
+    dummy.recalculate_enchantment_cache();
+    CHECK(dummy.mutation_value("speed_modifier") == Approx(1.1f));
+
+    dummy.unset_mutation(trait_id("QUICK"));
+    CHECK(dummy.mutation_value("speed_modifier") == Approx(1.0f));
+}
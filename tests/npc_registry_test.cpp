@@ -0,0 +1,71 @@
+#include "catch/catch.hpp"
+#include "npc_registry.h"
+
+#include <climits>
+#include <ranges>
+#include <vector>
+
+#include "character_id.h"
+#include "npc.h"
+
+namespace {
+
+auto make_npc_at(const int id, const tripoint_abs_sm& sm) -> shared_ptr_fast<npc> {
+    auto guy = make_shared_fast<npc>();
+    guy->setID(character_id(id), true);
+    guy->spawn_at_precise(sm.xy(), tripoint_sm_ms(0, 0, sm.z()));
+    return guy;
+}
+
+auto ids_of(const std::vector<shared_ptr_fast<npc>>& guys) -> std::vector<int> {
+    return guys | std::views::transform([](const shared_ptr_fast<npc>& guy) {
+               return guy->getID().get_value();
+           })
+           | std::ranges::to<std::vector>();
+}
+
+} // namespace
+
+TEST_CASE("npc_registry_finds_npcs_by_id_and_area", "[npc][npc_registry]") {
+    auto registry = npc_registry();
+    const auto a = make_npc_at(9001, tripoint_abs_sm(0, 0, 0));
+    const auto b = make_npc_at(9002, tripoint_abs_sm(3, 0, 0));
+    const auto c = make_npc_at(9003, tripoint_abs_sm(1, 1, 1));
+    registry.add(b);
+    registry.add(a);
+    registry.add(c);
+
+    CHECK(registry.size() == 3);
+    CHECK(registry.find(character_id(9002)) == b);
+    CHECK(registry.find(character_id(9999)) == nullptr);
+
+    CHECK(ids_of(registry.near(tripoint_abs_sm(0, 0, 0), 1)) == std::vector{9001});
+    CHECK(ids_of(registry.near(tripoint_abs_sm(0, 0, INT_MIN), 1)) == std::vector{9001, 9003});
+    CHECK(ids_of(registry.near(tripoint_abs_sm(0, 0, INT_MIN), 100)) == std::vector{9001, 9002, 9003});
+
+    registry.remove(character_id(9003));
+    CHECK(registry.size() == 2);
+    CHECK(registry.find(character_id(9003)) == nullptr);
+}
+
+TEST_CASE("npc_registry_refiles_moved_npcs", "[npc][npc_registry]") {
+    auto registry = npc_registry();
+    const auto guy = make_npc_at(9001, tripoint_abs_sm(0, 0, 0));
+    registry.add(guy);
+
+    guy->spawn_at_precise(point_abs_sm(20, 20), tripoint_sm_ms(0, 0, 0));
+    registry.moved(*guy);
+
+    CHECK(registry.near(tripoint_abs_sm(0, 0, 0), 1).empty());
+    CHECK(ids_of(registry.near(tripoint_abs_sm(20, 20, 0), 0)) == std::vector{9001});
+}
+
+TEST_CASE("npc_registry_skips_npcs_that_were_dropped", "[npc][npc_registry]") {
+    auto registry = npc_registry();
+    auto guy = make_npc_at(9001, tripoint_abs_sm(0, 0, 0));
+    registry.add(guy);
+    guy.reset();
+
+    CHECK(registry.find(character_id(9001)) == nullptr);
+    CHECK(registry.near(tripoint_abs_sm(0, 0, 0), 5).empty());
+}
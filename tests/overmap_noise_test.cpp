@@ -62,3 +62,14 @@ TEST_CASE("om_noise_layer_lake_export", "[.]") {
     export_raw_noise("lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5);
     export_interpreted_noise("lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25);
 }
+
+TEST_CASE("om_noise_grid_matches_the_layer", "[overmap]") {
+    const om_noise::om_noise_layer_forest f(point_abs_omt(360, -180), 1920237457);
+    const auto grid = om_noise::om_noise_grid(f);
+    for (auto y = 0; y < OMAPY; y += 7) {
+        for (auto x = 0; x < OMAPX; x += 5) {
+            CHECK(grid.at({x, y}) == f.noise_at({x, y}));
+        }
+    }
+    CHECK(grid.at({OMAPX - 1, OMAPY - 1}) == f.noise_at({OMAPX - 1, OMAPY - 1}));
+}
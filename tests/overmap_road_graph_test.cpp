@@ -0,0 +1,56 @@
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "overmap.h"
+#include "overmap_road_graph.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <algorithm>
+#include <memory>
+
+namespace {
+
+auto lay_road(overmap& om, const tripoint_om_omt& from, const tripoint_om_omt& to) -> void {
+    const auto step = tripoint((to.x() > from.x()) - (to.x() < from.x()),
+                               (to.y() > from.y()) - (to.y() < from.y()), 0);
+    for (auto p = from;; p += step) {
+        om.ter_set(p, oter_id(step.x != 0 ? "road_ew" : "road_ns"));
+        if (p == to) { break; }
+    }
+}
+
+} // namespace
+
+TEST_CASE("road_graph_folds_roads_between_junctions", "[overmap]") {
+    clear_all_state();
+    auto om = std::make_unique<overmap>(point_abs_om());
+    // A T junction, and a separate road around one corner
+    lay_road(*om, {10, 90, 0}, {100, 90, 0});
+    lay_road(*om, {50, 91, 0}, {50, 120, 0});
+    lay_road(*om, {10, 150, 0}, {30, 150, 0});
+    lay_road(*om, {30, 151, 0}, {30, 160, 0});
+
+    const auto graph = overmap_road_graph(*om);
+    CHECK(graph.nodes.size() == 6);
+    CHECK(graph.chains.size() == 4);
+    CHECK(graph.nodes.at({50, 90, 0}).size() == 3);
+    CHECK(graph.nodes.at({10, 90, 0}).size() == 1);
+
+    const auto corner = std::ranges::find_if(graph.chains, [](const auto& c) {
+        return c.from == tripoint_om_omt(30, 160, 0) || c.to == tripoint_om_omt(30, 160, 0);
+    });
+    REQUIRE(corner != graph.chains.end());
+    CHECK(corner->tiles.size() == 29);
+    CHECK(corner->turns == 1);
+}
+
+TEST_CASE("road_graph_is_dropped_when_terrain_changes", "[overmap]") {
+    clear_all_state();
+    auto om = std::make_unique<overmap>(point_abs_om());
+    lay_road(*om, {10, 90, 0}, {100, 90, 0});
+    om->road_graph = std::make_shared<const overmap_road_graph>(*om);
+    REQUIRE(om->road_graph->chains.size() == 1);
+
+    om->ter_set({60, 90, 0}, oter_id("field"));
+    CHECK_FALSE(om->road_graph);
+}
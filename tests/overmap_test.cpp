@@ -3,6 +3,7 @@
 #include "coordinates.h"
 #include "enums.h"
 #include "game_constants.h"
+#include "mongroup.h"
 #include "numeric_interval.h"
 #include "omdata.h"
 #include "overmap.h"
@@ -15,7 +16,10 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <memory>
+#include <thread>
+#include <utility>
 #include <vector>
 
 TEST_CASE("set_and_get_overmap_scents", "[overmap]") {
@@ -86,6 +90,31 @@ TEST_CASE("Brute force default batch generation to check for RNG bugs", "[.][ove
     for (auto i = 0; i < 3; ++i) { do_lab_finale_test(); }
 }
 
+TEST_CASE("overmap_specials_placed_the_same_with_the_same_seed", "[overmap][slow]") {
+    const auto addr = point_abs_om(3, -2);
+    const auto generate = [&]() {
+        clear_all_state();
+        rng_set_engine_seed(4242);
+        auto batch = overmap_specials::get_default_batch(addr);
+        ACTIVE_OVERMAP_BUFFER.create_custom_overmap(addr, batch);
+        const overmap* om = ACTIVE_OVERMAP_BUFFER.get_existing(addr);
+        REQUIRE(om != nullptr);
+        auto terrain = std::vector<oter_id>();
+        for (auto z = -OVERMAP_DEPTH; z <= 0; ++z) {
+            for (auto x = 0; x < OMAPX; ++x) {
+                for (auto y = 0; y < OMAPY; ++y) { terrain.push_back(om->ter({x, y, z})); }
+            }
+        }
+        auto placed = std::vector<int>();
+        for (const auto& placement : batch) { placed.push_back(placement.instances_placed); }
+        return std::make_pair(terrain, placed);
+    };
+    const auto first = generate();
+    const auto second = generate();
+    CHECK(first.second == second.second);
+    CHECK(first.first == second.first);
+}
+
 TEST_CASE("is_ot_match", "[overmap][terrain]") {
     clear_all_state();
     SECTION("exact match") {
@@ -189,3 +218,184 @@ TEST_CASE("mutable_overmap_placement", "[overmap][slow]") {
         CHECK(successes > num_trials_per_overmap / 2);
     }
 }
+
+TEST_CASE("travel_plan_finds_the_blocking_search_path", "[overmap]") {
+    clear_all_state();
+    overmap& om = ACTIVE_OVERMAP_BUFFER.get(point_abs_om());
+    for (int x = 0; x < OMAPX; ++x) {
+        for (int y = 0; y < OMAPY; ++y) {
+            om.ter_set({x, y, 0}, oter_id(y == 95 && x >= 50 && x <= 120 ? "road_ew" : "field"));
+        }
+    }
+    const auto src = tripoint_abs_omt(60, 90, 0);
+    const auto dest = tripoint_abs_omt(110, 90, 0);
+    const auto params = overmap_path_params::for_npc();
+
+    const auto blocking = ACTIVE_OVERMAP_BUFFER.get_travel_path(src, dest, params);
+    REQUIRE_FALSE(blocking.empty());
+    auto plan = ACTIVE_OVERMAP_BUFFER.plan_travel_path(src, dest, params);
+    REQUIRE(plan);
+    CHECK(plan->destination() == dest);
+    CHECK(plan->take_path() == blocking);
+    CHECK(plan->ready());
+    CHECK(plan->searched() > 0);
+
+    // A plan dropped mid-search cancels it instead of blocking on it
+    auto dropped = ACTIVE_OVERMAP_BUFFER.plan_travel_path(src, dest, params);
+    dropped->cancel();
+    dropped.reset();
+}
+
+TEST_CASE("batched_travel_paths_match_single_searches", "[overmap]") {
+    clear_all_state();
+    overmap& om = ACTIVE_OVERMAP_BUFFER.get(point_abs_om());
+    for (int x = 0; x < OMAPX; ++x) {
+        for (int y = 0; y < OMAPY; ++y) {
+            om.ter_set({x, y, 0}, oter_id(y == 95 && x >= 10 && x <= 170 ? "road_ew" : "field"));
+        }
+    }
+    const auto params = overmap_path_params::for_npc();
+    const auto short_trip = std::make_pair(tripoint_abs_omt(60, 90, 0), tripoint_abs_omt(90, 100, 0));
+    const auto long_trip = std::make_pair(tripoint_abs_omt(15, 90, 0), tripoint_abs_omt(165, 100, 0));
+    const auto trips = std::vector{short_trip, long_trip, short_trip};
+
+    const auto paths = ACTIVE_OVERMAP_BUFFER.get_travel_paths(trips, params);
+    REQUIRE(paths.size() == trips.size());
+    for (size_t i = 0; i < trips.size(); ++i) {
+        CAPTURE(i);
+        CHECK_FALSE(paths[i].empty());
+        CHECK(paths[i] == ACTIVE_OVERMAP_BUFFER.get_travel_path(trips[i].first, trips[i].second, params));
+    }
+}
+
+TEST_CASE("overmap_layers_hold_one_value_until_a_tile_differs", "[overmap]") {
+    auto grid = overmap_layer_grid<oter_id>(oter_id("empty_rock"));
+    grid.set({3, 4}, oter_id("empty_rock"));
+    CHECK(grid.is_uniform());
+
+    grid.set({3, 4}, oter_id("field"));
+    CHECK_FALSE(grid.is_uniform());
+    CHECK(grid.get({3, 4}) == oter_id("field"));
+    CHECK(grid.get({4, 3}) == oter_id("empty_rock"));
+
+    const auto copy = grid;
+    grid.set({3, 4}, oter_id("empty_rock"));
+    grid.compact();
+    CHECK(grid.is_uniform());
+    CHECK(copy.get({3, 4}) == oter_id("field"));
+
+    auto seen = overmap_layer_grid<bool>();
+    seen.set({OMAPX - 1, OMAPY - 1}, true);
+    CHECK(seen.get({OMAPX - 1, OMAPY - 1}));
+    CHECK_FALSE(seen.get({0, 0}));
+}
+
+TEST_CASE("overmap_view_flags_are_set_per_omt", "[overmap]") {
+    clear_all_state();
+    auto om = std::make_unique<overmap>(point_abs_om());
+    const auto p = tripoint_om_omt(10, 20, -3);
+    om->set_seen(p, true);
+    om->set_explored(p, true);
+    om->set_path(p + tripoint_east, true);
+    CHECK(om->seen(p));
+    CHECK(om->is_explored(p));
+    CHECK_FALSE(om->is_path(p));
+    CHECK(om->is_path(p + tripoint_east));
+    CHECK_FALSE(om->seen(p + tripoint_above));
+    // Out of bounds is ignored rather than written
+    om->set_seen(tripoint_om_omt(-1, 0, 0), true);
+    CHECK_FALSE(om->seen(tripoint_om_omt(-1, 0, 0)));
+}
+
+TEST_CASE("find_all_filters_terrain_by_type_and_exclusion", "[overmap]") {
+    clear_all_state();
+    overmap& om = ACTIVE_OVERMAP_BUFFER.get(point_abs_om());
+    for (int x = 0; x < OMAPX; ++x) {
+        for (int y = 0; y < OMAPY; ++y) {
+            om.ter_set({x, y, 0}, oter_id("field"));
+        }
+    }
+    om.ter_set({40, 40, 0}, oter_id("road_ns"));
+    om.ter_set({41, 40, 0}, oter_id("road_ew"));
+    om.ter_set({42, 40, 0}, oter_id("road_nesw"));
+
+    auto params = omt_find_params{};
+    params.types = {{"road", ot_match_type::type}};
+    params.exclude_types = {{"road_nesw", ot_match_type::exact}};
+    params.search_range = {0, 20};
+    params.existing_only = true;
+    for (const auto force_sync : {true, false}) {
+        CAPTURE(force_sync);
+        params.force_sync = force_sync;
+        auto found = ACTIVE_OVERMAP_BUFFER.find_all(tripoint_abs_omt(40, 45, 0), params);
+        std::sort(found.begin(), found.end());
+        CHECK(found == std::vector{tripoint_abs_omt(40, 40, 0), tripoint_abs_omt(41, 40, 0)});
+    }
+}
+
+TEST_CASE("overmaps_near_the_edge_are_generated_ahead", "[overmap][slow]") {
+    clear_all_state();
+    auto& omb = ACTIVE_OVERMAP_BUFFER;
+    const auto east = point_abs_om(1, 0);
+
+    // Far from every edge nothing is started
+    omb.generate_ahead(tripoint_abs_omt(OMAPX / 2, OMAPY / 2, 0));
+    CHECK_FALSE(omb.has(east));
+
+    // Near the east edge the overmap there is generated, and taken in by a later call
+    const auto near_east = tripoint_abs_omt(OMAPX - 5, OMAPY / 2, 0);
+    omb.generate_ahead(near_east);
+    for (auto i = 0; i < 6000 && !omb.has(east); ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        omb.generate_ahead(near_east);
+    }
+    CHECK(omb.has(east));
+    clear_all_state();
+}
+
+TEST_CASE("moving_hordes_keeps_them_under_their_submap", "[overmap][horde]") {
+    clear_all_state();
+    const auto start = tripoint_abs_sm(20, 20, 0);
+    auto horde = mongroup(mongroup_id("GROUP_ZOMBIE"), start, 1, 10);
+    horde.horde = true;
+    horde.horde_behaviour = "roam";
+    horde.set_target(tripoint_abs_sm(60, 40, 0));
+    horde.set_interest(100);
+    // Moving a group relinks it rather than copying it, so the pointer stays good.
+    const auto* moved = ACTIVE_OVERMAP_BUFFER.create_horde(horde);
+    REQUIRE(moved != nullptr);
+
+    for (int i = 0; i < 80; ++i) {
+        ACTIVE_OVERMAP_BUFFER.move_hordes();
+    }
+    CHECK(moved->abs_pos != start);
+    CHECK(moved->population == 10);
+    const auto here = ACTIVE_OVERMAP_BUFFER.groups_at(moved->abs_pos);
+    CHECK(std::ranges::find(here, moved) != here.end());
+}
+
+TEST_CASE("mongroup_index_keeps_groups_put_while_they_move", "[overmap][horde]") {
+    auto index = mongroup_index();
+    const auto here = tripoint_om_sm(4, 4, 0);
+    const auto there = tripoint_om_sm(5, 4, 0);
+    auto& first = index.insert(here, mongroup(mongroup_id("GROUP_ZOMBIE"), tripoint_abs_sm(4, 4, 0), 1, 10));
+    index.insert(here, mongroup(mongroup_id("GROUP_ZOMBIE"), tripoint_abs_sm(4, 4, 0), 1, 20));
+    REQUIRE(index.size() == 2);
+    REQUIRE(index.ids_at(here).size() == 2);
+
+    const auto first_id = index.ids_at(here).front();
+    index.move(first_id, there);
+    CHECK(index.ids_at(here).size() == 1);
+    REQUIRE(index.ids_at(there).size() == 1);
+    CHECK(&index.get(index.ids_at(there).front()) == &first);
+
+    // Erasing under an iterator leaves it good to advance
+    for (auto it = index.begin(); it != index.end(); ++it) {
+        if (it->population == 20) {
+            index.erase(it.group_id());
+        }
+    }
+    CHECK(index.size() == 1);
+    CHECK(index.ids_at(here).empty());
+    CHECK(std::ranges::distance(index.begin(), index.end()) == 1);
+}
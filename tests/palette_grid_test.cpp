@@ -0,0 +1,112 @@
+#include "catch/catch.hpp"
+#include "palette_grid.h"
+
+#include <array>
+#include <cstddef>
+
+namespace {
+
+constexpr auto cells = std::size_t{144};
+
+template <typename T>
+auto check_matches(const palette_grid<T, cells>& grid, const std::array<T, cells>& ref) -> void {
+    for (auto i = std::size_t{0}; i < cells; ++i) {
+        INFO("cell " << i);
+        CHECK(grid.get(i) == ref[i]);
+    }
+}
+
+} // namespace
+
+TEST_CASE("palette_grid_starts_uniform", "[palette_grid]") {
+    auto grid = palette_grid<int, cells>(7);
+    CHECK(grid.is_uniform());
+    CHECK(grid.index_bits() == 0);
+    CHECK(grid.get(0) == 7);
+    CHECK(grid.get(cells - 1) == 7);
+
+    // setting the value already everywhere keeps it uniform
+    grid.set(10, 7);
+    CHECK(grid.is_uniform());
+}
+
+TEST_CASE("palette_grid_widens_with_distinct_values", "[palette_grid]") {
+    auto grid = palette_grid<int, cells>(0);
+    auto ref = std::array<int, cells>{};
+
+    grid.set(3, 1);
+    ref[3] = 1;
+    CHECK(grid.index_bits() == 1);
+    check_matches(grid, ref);
+
+    grid.set(4, 2);
+    ref[4] = 2;
+    CHECK(grid.index_bits() == 2);
+    check_matches(grid, ref);
+
+    // one distinct value per cell needs the full 8 bits
+    for (auto i = std::size_t{0}; i < cells; ++i) {
+        grid.set(i, static_cast<int>(i) * 3);
+        ref[i] = static_cast<int>(i) * 3;
+    }
+    CHECK(grid.index_bits() == 8);
+    check_matches(grid, ref);
+
+    grid.fill(5);
+    CHECK(grid.is_uniform());
+    CHECK(grid.palette_size() == 1);
+    CHECK(grid.get(100) == 5);
+}
+
+TEST_CASE("palette_grid_reuses_unused_entries", "[palette_grid]") {
+    auto grid = palette_grid<int, cells>(0);
+    auto ref = std::array<int, cells>{};
+
+    // keep overwriting the same cell: stale values are dropped instead of widening
+    for (auto v = 1; v < 100; ++v) {
+        grid.set(0, v);
+        ref[0] = v;
+    }
+    CHECK(grid.index_bits() == 1);
+    CHECK(grid.palette_size() == 2);
+    check_matches(grid, ref);
+}
+
+TEST_CASE("palette_grid_swap_cells", "[palette_grid]") {
+    auto grid = palette_grid<int, cells>(0);
+    auto ref = std::array<int, cells>{};
+    grid.set(1, 11);
+    grid.set(140, 22);
+    ref[1] = 22;
+    ref[140] = 11;
+
+    grid.swap_cells(1, 140);
+    check_matches(grid, ref);
+}
+
+TEST_CASE("palette_grid_map_cells_matches_get", "[palette_grid]") {
+    auto grid = palette_grid<int, cells>(4);
+    auto out = std::array<int, cells>{};
+    grid.map_cells([](const int v) { return v * 10; }, out.data());
+    CHECK(out[0] == 40);
+    CHECK(out[cells - 1] == 40);
+
+    // every index width, including a last word only partly used
+    for (auto distinct : {2, 3, 5, 17, 144}) {
+        for (auto i = std::size_t{0}; i < cells; ++i) {
+            grid.set(i, static_cast<int>(i) % distinct);
+        }
+        auto calls = 0;
+        grid.map_cells(
+            [&calls](const int v) {
+                ++calls;
+                return v * 10;
+            },
+            out.data());
+        CHECK(static_cast<std::size_t>(calls) == grid.palette_size());
+        for (auto i = std::size_t{0}; i < cells; ++i) {
+            INFO("distinct " << distinct << " cell " << i);
+            CHECK(out[i] == grid.get(i) * 10);
+        }
+    }
+}
@@ -0,0 +1,101 @@
+#include "cached_options.h"
+#include "calendar.h"
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <vector>
+
+namespace {
+
+auto next_turn() -> void {
+    Pathfinding::end_turn();
+    calendar::turn += 1_turns;
+}
+
+} // namespace
+
+TEST_CASE("persistent_d_map_is_repaired_after_terrain_change", "[pathfinding]") {
+    clear_all_state();
+    const auto restore_hierarchical = restore_on_out_of_scope<bool>(hierarchical_pathfinding);
+    const auto restore_persistent = restore_on_out_of_scope<bool>(persistent_d_maps);
+    hierarchical_pathfinding = false;
+    persistent_d_maps = true;
+
+    auto& here = get_map();
+    build_test_map(ter_id("t_pavement"));
+    const auto to = tripoint_bub_ms(60, 60, 0);
+    const auto from = tripoint_bub_ms(20, 60, 0);
+    const auto first = Pathfinding::route(from, to);
+    REQUIRE_FALSE(first.empty());
+
+    SECTION("an unchanged map keeps its route") {
+        next_turn();
+        const auto again = Pathfinding::route(tripoint_bub_ms(20, 61, 0), to);
+        REQUIRE_FALSE(again.empty());
+        CHECK(again.back() == to);
+    }
+    SECTION("a wall across the old route is walked around") {
+        next_turn();
+        for (int y = 50; y <= 70; ++y) {
+            here.ter_set(tripoint_bub_ms(40, y, 0), ter_id("t_concrete_wall"));
+        }
+        const auto around = Pathfinding::route(from, to);
+        REQUIRE_FALSE(around.empty());
+        CHECK(around.back() == to);
+        for (const auto& p : around) { CHECK(here.passable(p)); }
+    }
+    SECTION("a walled-in target has no route") {
+        next_turn();
+        for (const auto& p : here.points_in_radius(to, 2)) {
+            if (square_dist(p, to) == 2) { here.ter_set(p, ter_id("t_concrete_wall")); }
+        }
+        CHECK(Pathfinding::route(from, to).empty());
+    }
+    Pathfinding::clear_d_maps();
+}
+
+TEST_CASE("pathfinding_stats_count_d_map_lookups", "[pathfinding]") {
+    clear_all_state();
+    const auto restore_hierarchical = restore_on_out_of_scope<bool>(hierarchical_pathfinding);
+    const auto restore_persistent = restore_on_out_of_scope<bool>(persistent_d_maps);
+    hierarchical_pathfinding = false;
+    persistent_d_maps = true;
+    build_test_map(ter_id("t_pavement"));
+    Pathfinding::clear_d_maps();
+    next_turn();
+
+    const auto to = tripoint_bub_ms(60, 60, 0);
+    REQUIRE_FALSE(Pathfinding::route(tripoint_bub_ms(20, 60, 0), to).empty());
+    REQUIRE_FALSE(Pathfinding::route(tripoint_bub_ms(20, 62, 0), to).empty());
+    next_turn();
+    const auto& first = Pathfinding::last_turn_stats();
+    CHECK(first.d_maps_created == 1);
+    CHECK(first.d_maps_reused == 1);
+    CHECK(first.outcomes[0] == 2);
+    CHECK(first.tiles_expanded > 0);
+
+    REQUIRE_FALSE(Pathfinding::route(tripoint_bub_ms(20, 61, 0), to).empty());
+    next_turn();
+    const auto& second = Pathfinding::last_turn_stats();
+    CHECK(second.d_maps_created == 0);
+    CHECK(second.d_maps_repaired == 1);
+
+    SECTION("heat is only collected on request") {
+        REQUIRE_FALSE(Pathfinding::route(tripoint_bub_ms(20, 61, 0), to).empty());
+        next_turn();
+        CHECK(Pathfinding::explored_heat_at(bub_to_abs(tripoint_bub_ms(40, 60, 0))) == 0);
+        Pathfinding::set_collect_explored_heat(true);
+        REQUIRE_FALSE(Pathfinding::route(tripoint_bub_ms(20, 61, 0), to).empty());
+        next_turn();
+        CHECK(Pathfinding::explored_heat_at(bub_to_abs(tripoint_bub_ms(40, 60, 0))) == 1);
+        Pathfinding::set_collect_explored_heat(false);
+    }
+    Pathfinding::clear_d_maps();
+}
@@ -0,0 +1,136 @@
+#include "catch/catch.hpp"
+#include "lightmap.h"
+#include "point_light_layer.h"
+#include "shadowcasting.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <span>
+#include <vector>
+
+namespace {
+
+using source = point_light_layer::source;
+
+constexpr int grid_size = 48;
+constexpr int max_view = 60;
+
+struct fake_level {
+    std::vector<float> transparency =
+        std::vector<float>(grid_size * grid_size, LIGHT_TRANSPARENCY_OPEN_AIR);
+    std::vector<diagonal_blocks> blocked = std::vector<diagonal_blocks>(grid_size * grid_size);
+
+    auto inputs() const -> point_light_layer::level_inputs {
+        return {
+            .transparency = transparency.data(),
+            .blocked = blocked.data(),
+            .shape = {grid_size, grid_size},
+            .weather_transparency = LIGHT_TRANSPARENCY_OPEN_AIR,
+            .max_view_distance = max_view,
+        };
+    }
+};
+
+// Stands in for the shadowcaster: falls off with distance, stays inside reach() and
+// depends on the transparency of the tiles it lights.
+auto fake_cast(const fake_level& level) -> point_light_layer::cast_fn {
+    return [&level](const std::span<const source> sources, float* out) {
+        const auto shape = cache_layout::grid_shape{grid_size, grid_size};
+        for (const auto& s : sources) {
+            const auto r = point_light_layer::reach(s.luminance, max_view) - 1;
+            for (auto x = std::max(0, s.p.x - r); x <= std::min(grid_size - 1, s.p.x + r); ++x) {
+                for (auto y = std::max(0, s.p.y - r); y <= std::min(grid_size - 1, s.p.y + r);
+                     ++y) {
+                    const auto i = cache_layout::index(x, y, shape);
+                    if (level.transparency[i] <= LIGHT_TRANSPARENCY_SOLID) { continue; }
+                    const auto d = std::max(std::abs(x - s.p.x), std::abs(y - s.p.y));
+                    out[i] = std::max(out[i], s.luminance / static_cast<float>(d + 1));
+                }
+            }
+        }
+    };
+}
+
+auto some_lights() -> std::vector<source> {
+    auto lights = std::vector<source>{};
+    for (auto x = 4; x < grid_size; x += 10) {
+        for (auto y = 4; y < grid_size; y += 10) { lights.push_back({point(x, y), 10.0f, 0xFF}); }
+    }
+    return lights;
+}
+
+auto cast_from_scratch(const fake_level& level, std::vector<source> lights) -> std::vector<float> {
+    auto fresh = point_light_layer{};
+    return fresh.update(std::move(lights), level.inputs(), fake_cast(level));
+}
+
+} // namespace
+
+TEST_CASE("point_light_layer_keeps_an_unchanged_layer", "[lightmap][point_light_layer]") {
+    const auto level = fake_level{};
+    auto layer = point_light_layer{};
+    const auto first = layer.update(some_lights(), level.inputs(), fake_cast(level));
+    CHECK(layer.last_update().rebuilt);
+
+    const auto second = layer.update(some_lights(), level.inputs(), fake_cast(level));
+    CHECK_FALSE(layer.last_update().rebuilt);
+    CHECK(layer.last_update().cast == 0);
+    CHECK(second == first);
+}
+
+TEST_CASE("point_light_layer_recasts_only_around_changed_sources",
+          "[lightmap][point_light_layer]") {
+    const auto level = fake_level{};
+    auto layer = point_light_layer{};
+    auto lights = some_lights();
+    layer.update(lights, level.inputs(), fake_cast(level));
+
+    SECTION("moved") { lights[0].p += point(1, 0); }
+    SECTION("dimmed") { lights[0].luminance = 6.0f; }
+    SECTION("removed") { lights.erase(lights.begin()); }
+    SECTION("added") { lights.push_back({point(40, 40), 4.0f, 0xFF}); }
+
+    const auto& updated = layer.update(lights, level.inputs(), fake_cast(level));
+    CHECK_FALSE(layer.last_update().rebuilt);
+    CHECK(layer.last_update().cast < lights.size());
+    CHECK(updated == cast_from_scratch(level, lights));
+}
+
+TEST_CASE("point_light_layer_recasts_sources_reaching_changed_tiles",
+          "[lightmap][point_light_layer]") {
+    auto level = fake_level{};
+    auto layer = point_light_layer{};
+    const auto lights = some_lights();
+    layer.update(lights, level.inputs(), fake_cast(level));
+
+    const auto wall = point(6, 6);
+    level.transparency[cache_layout::index(wall.x, wall.y, {grid_size, grid_size})] =
+        LIGHT_TRANSPARENCY_SOLID;
+    const auto reaching = std::ranges::count_if(lights, [&](const source& s) {
+        const auto r = point_light_layer::reach(s.luminance, max_view);
+        return std::abs(s.p.x - wall.x) <= r && std::abs(s.p.y - wall.y) <= r;
+    });
+    REQUIRE(reaching > 0);
+
+    const auto& updated = layer.update(lights, level.inputs(), fake_cast(level));
+    CHECK_FALSE(layer.last_update().rebuilt);
+    CHECK(layer.last_update().cast >= static_cast<std::size_t>(reaching));
+    CHECK(layer.last_update().cast < lights.size());
+    CHECK(updated == cast_from_scratch(level, lights));
+}
+
+TEST_CASE("point_light_layer_rebuilds_when_the_level_changes", "[lightmap][point_light_layer]") {
+    const auto level = fake_level{};
+    auto layer = point_light_layer{};
+    layer.update(some_lights(), level.inputs(), fake_cast(level));
+
+    auto hazy = level.inputs();
+    hazy.weather_transparency *= 2.0f;
+    layer.update(some_lights(), hazy, fake_cast(level));
+    CHECK(layer.last_update().rebuilt);
+
+    layer.invalidate();
+    layer.update(some_lights(), hazy, fake_cast(level));
+    CHECK(layer.last_update().rebuilt);
+    CHECK(layer.last_update().cast == some_lights().size());
+}
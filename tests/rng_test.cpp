@@ -1,7 +1,10 @@
 #include "catch/catch.hpp"
 #include "rng.h"
+#include "calendar.h"
 #include "test_statistics.h"
+#include "thread_pool.h"
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <vector>
@@ -70,3 +73,56 @@ TEST_CASE("random_entry_preserves_constness") {
     i1 = 5678;
     CHECK(v1[0] == 5678);
 }
+
+static std::vector<int> draw_from_stream(const unsigned int seed, const std::uint64_t entity, const time_point& turn) {
+    auto stream = rng_stream(seed, entity, turn);
+    const auto scope = rng_stream_scope(stream);
+    auto rolls = std::vector<int>{};
+    for (auto i = 0; i < 16; ++i) {
+        rolls.push_back(rng(0, 1000));
+        rolls.push_back(x_in_y(1, 2) ? 1 : 0);
+    }
+    return rolls;
+}
+
+TEST_CASE("rng_stream_is_a_pure_function_of_its_key", "[rng]") {
+    const auto turn = calendar::turn_zero + 5_turns;
+    const auto expected = draw_from_stream(42, 7, turn);
+
+    CHECK(draw_from_stream(42, 7, turn) == expected);
+    CHECK(draw_from_stream(42, 8, turn) != expected);
+    CHECK(draw_from_stream(42, 7, turn + 1_turns) != expected);
+    CHECK(draw_from_stream(43, 7, turn) != expected);
+}
+
+TEST_CASE("rng_stream_results_do_not_depend_on_threads", "[rng]") {
+    constexpr auto count = 256;
+    const auto turn = calendar::turn_zero + 1_hours;
+    auto serial = std::vector<std::vector<int>>(count);
+    auto parallel = std::vector<std::vector<int>>(count);
+
+    for (auto i = 0; i < count; ++i) { serial[i] = draw_from_stream(1234, i, turn); }
+    parallel_for_chunked(0, count, 3, [&](const int i) { parallel[i] = draw_from_stream(1234, i, turn); });
+
+    CHECK(serial == parallel);
+}
+
+TEST_CASE("rng_stream_scope_restores_the_previous_source", "[rng]") {
+    auto outer = rng_stream(1, 1, calendar::turn_zero);
+    auto inner = rng_stream(1, 2, calendar::turn_zero);
+    auto outer_rolls = std::vector<int>{};
+    {
+        const auto outer_scope = rng_stream_scope(outer);
+        outer_rolls.push_back(rng(0, 1 << 30));
+        {
+            const auto inner_scope = rng_stream_scope(inner);
+            rng(0, 1 << 30);
+        }
+        outer_rolls.push_back(rng(0, 1 << 30));
+    }
+
+    auto replay = rng_stream(1, 1, calendar::turn_zero);
+    const auto replay_scope = rng_stream_scope(replay);
+    CHECK(outer_rolls[0] == rng(0, 1 << 30));
+    CHECK(outer_rolls[1] == rng(0, 1 << 30));
+}
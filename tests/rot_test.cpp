@@ -282,6 +282,39 @@ TEST_CASE("Rate of rotting") {
     }
 }
 
+TEST_CASE("Planned rot matches rot applied in place", "[item][rot]") {
+    weather_manager weather;
+    if (calendar::turn <= calendar::start_of_cataclysm) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    set_map_temperature(weather, 18_c);
+    ensure_no_temperature_mods(tripoint_bub_ms::zero());
+
+    detached_ptr<item> planned = item::spawn("meat_cooked");
+    detached_ptr<item> direct = item::spawn("meat_cooked");
+    const auto context = item::rot_context{
+        .position = tripoint_abs_ms::zero(),
+        .temperature = temperature_flag::TEMP_NORMAL,
+        .weather = &weather,
+        .local_temperature = 0,
+    };
+    planned->update_rot(context);
+    direct->update_rot(context);
+
+    calendar::turn += 30_minutes;
+    const auto update = planned->plan_rot_update(context);
+    REQUIRE(update.has_value());
+    // Planning alone leaves the item untouched.
+    CHECK(planned->get_rot() == direct->get_rot());
+
+    CHECK(planned->apply_rot_update(*update));
+    direct->update_rot(context);
+    CHECK(planned->get_rot() == direct->get_rot());
+    CHECK(planned->get_rot() > 0_turns);
+    // A stale plan is refused once the item has been checked again.
+    CHECK_FALSE(planned->apply_rot_update(*update));
+}
+
 TEST_CASE("Preserving containers stop contained food rot") {
     SECTION("direct rot queries do not age food in a sealed can") {
         prepare_map_storage_test();
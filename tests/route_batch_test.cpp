@@ -0,0 +1,74 @@
+#include "cached_options.h"
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <vector>
+
+namespace {
+
+auto request(const tripoint_bub_ms& from, const tripoint_bub_ms& to, bool next_step_only = false)
+    -> RouteRequest {
+    return RouteRequest{
+        .from = bub_to_abs(from),
+        .to = bub_to_abs(to),
+        .path_settings = PathfindingSettings(),
+        .route_settings = RouteSettings(),
+        .next_step_only = next_step_only,
+    };
+}
+
+} // namespace
+
+TEST_CASE("route_batch_solves_each_request", "[pathfinding]") {
+    clear_all_state();
+    const auto restore_parallel = restore_on_out_of_scope<bool>(parallel_pathfinding);
+    parallel_pathfinding = GENERATE(false, true);
+    auto& here = get_map();
+    build_test_map(ter_id("t_pavement"));
+    for (int y = 50; y <= 70; ++y) {
+        here.ter_set(tripoint_bub_ms(40, y, 0), ter_id("t_concrete_wall"));
+    }
+    // Walled in, so nothing reaches it
+    const auto enclosed = tripoint_bub_ms(80, 30, 0);
+    for (const auto& p : here.points_in_radius(enclosed, 2)) {
+        if (square_dist(p, enclosed) == 2) { here.ter_set(p, ter_id("t_concrete_wall")); }
+    }
+    Pathfinding::clear_d_maps();
+
+    const auto requests = std::vector{
+        request(tripoint_bub_ms(20, 60, 0), tripoint_bub_ms(60, 60, 0)),
+        request(tripoint_bub_ms(25, 52, 0), tripoint_bub_ms(60, 60, 0)),
+        request(tripoint_bub_ms(60, 20, 0), tripoint_bub_ms(20, 20, 0)),
+        request(tripoint_bub_ms(20, 20, 0), enclosed),
+        request(tripoint_bub_ms(30, 68, 0), tripoint_bub_ms(60, 60, 0), true),
+    };
+    const auto routes = Pathfinding::route_batch(requests);
+    REQUIRE(routes.size() == requests.size());
+
+    for (std::size_t i = 0; i < requests.size(); ++i) {
+        INFO("request " << i);
+        if (requests[i].to == bub_to_abs(enclosed)) {
+            CHECK(routes[i].empty());
+            continue;
+        }
+        REQUIRE_FALSE(routes[i].empty());
+        CHECK(routes[i].front() == requests[i].from);
+        if (requests[i].next_step_only) {
+            CHECK(routes[i].size() == 2);
+        } else {
+            CHECK(routes[i].back() == requests[i].to);
+        }
+        for (std::size_t j = 1; j < routes[i].size(); ++j) {
+            CHECK(square_dist(routes[i][j - 1], routes[i][j]) == 1);
+            CHECK(here.passable(abs_to_bub(routes[i][j])));
+        }
+    }
+    Pathfinding::clear_d_maps();
+}
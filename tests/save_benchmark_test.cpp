@@ -0,0 +1,284 @@
+#include "avatar.h"
+#include "cached_options.h"
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "compress.h"
+#include "coordinates.h"
+#include "filesystem.h"
+#include "game.h"
+#include "item.h"
+#include "mapbuffer.h"
+#include "mapbuffer_registry.h"
+#include "mapdata.h"
+#include "overmapbuffer.h"
+#include "overmapbuffer_registry.h"
+#include "save_dictionary.h"
+#include "state_helpers.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "type_id.h"
+#include "world.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// Throughput of the save paths on a generated world.  Hidden: run with
+//     tests/cata_test "[save_benchmark]"
+// Every run uses the same seed, so numbers are comparable between builds.
+
+namespace {
+
+constexpr auto benchmark_omt_count = 64;
+constexpr auto benchmark_seed = 20261014U;
+
+using clock_type = std::chrono::steady_clock;
+
+auto benchmark_omts() -> std::vector<tripoint_abs_omt> {
+    // Far from anything the test world generates.
+    constexpr auto side = 8;
+    return std::views::iota(0, benchmark_omt_count) | std::views::transform([](const int i) {
+               return tripoint_abs_omt{30000 + i % side, 30000 + i / side, 0};
+           }) |
+           std::ranges::to<std::vector>();
+}
+
+auto fill_submap(submap& sm, std::mt19937& rng) -> void {
+    static const auto terrain = std::array{ter_str_id("t_grass"), ter_str_id("t_dirt"),
+                                           ter_str_id("t_floor"), ter_str_id("t_wall")};
+    static const auto furniture = std::array{furn_str_id("f_chair"), furn_str_id("f_table")};
+    static const auto items = std::array{itype_id("rock"), itype_id("sugar")};
+
+    auto pick = std::uniform_int_distribution<int>(0, 99);
+    for (const auto p : submap_tiles()) {
+        sm.set_ter(p, terrain[pick(rng) % terrain.size()].id());
+        const auto roll = pick(rng);
+        if (roll < 10) {
+            sm.set_furn(p, furniture[roll % furniture.size()].id());
+        }
+        if (roll < 25) {
+            for (auto n = roll % 4; n >= 0; --n) {
+                sm.get_items(p).push_back(item::spawn(items[n % items.size()]));
+            }
+        }
+        if (roll == 99) {
+            sm.set_radiation(p, 10);
+        }
+    }
+}
+
+auto populate(mapbuffer& buffer, const std::vector<tripoint_abs_omt>& omts) -> void {
+    auto rng = std::mt19937(benchmark_seed);
+    for (const auto& omt : omts) {
+        const auto base = project_to<coords::sm>(omt);
+        for (const auto offset : {point_rel_sm(0, 0), point_rel_sm(1, 0), point_rel_sm(0, 1),
+                                  point_rel_sm(1, 1)}) {
+            const auto pos = base + offset;
+            auto sm = std::make_unique<submap>(pos, buffer.get_dimension_id());
+            fill_submap(*sm, rng);
+            REQUIRE(buffer.add_submap(pos, sm));
+        }
+    }
+}
+
+auto mark_all_modified(mapbuffer& buffer, const std::vector<tripoint_abs_omt>& omts) -> void {
+    for (const auto& omt : omts) {
+        const auto base = project_to<coords::sm>(omt);
+        for (const auto offset : {point_rel_sm(0, 0), point_rel_sm(1, 0), point_rel_sm(0, 1),
+                                  point_rel_sm(1, 1)}) {
+            if (auto* const sm = buffer.lookup_submap_in_memory(base + offset)) {
+                sm->mark_modified();
+            }
+        }
+    }
+}
+
+/// Total uncompressed size of the saved blobs of @p omts.
+auto saved_bytes(const mapbuffer& buffer, const std::vector<tripoint_abs_omt>& omts) -> std::size_t {
+    auto total = std::size_t{0};
+    g->get_active_world()->read_map_omts_data(
+        buffer.get_dimension_id().str(), omts, [&](const tripoint_abs_omt&, std::istream& fin) {
+            fin.seekg(0, std::ios_base::end);
+            total += static_cast<std::size_t>(fin.tellg());
+        });
+    return total;
+}
+
+template <typename F>
+auto time_once(F&& f) -> double {
+    const auto start = clock_type::now();
+    f();
+    return std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+auto report(const std::string& label, const std::size_t bytes, const int blobs, const double seconds)
+    -> void {
+    WARN(string_format("%s: %.1f MB/s, %.0f blobs/s (%d blobs, %zu bytes, %.3f s)", label,
+                       bytes / seconds / 1e6, blobs / seconds, blobs, bytes, seconds));
+}
+
+} // namespace
+
+TEST_CASE("map save and preload throughput", "[.][save_benchmark][benchmark]") {
+    auto* const w = g->get_active_world();
+    REQUIRE(w != nullptr);
+    const auto omts = benchmark_omts();
+
+    auto buffer = mapbuffer();
+    buffer.set_dimension_id(dimension_id("save_benchmark_" + get_pid_string()));
+    populate(buffer, omts);
+
+    BENCHMARK("mapbuffer::save") {
+        mark_all_modified(buffer, omts);
+        buffer.save(false, false, false);
+        w->flush_map_writes();
+    };
+    mark_all_modified(buffer, omts);
+    const auto save_seconds = time_once([&]() {
+        buffer.save(false, false, false);
+        w->flush_map_writes();
+    });
+    const auto bytes = saved_bytes(buffer, omts);
+    report("mapbuffer::save", bytes, benchmark_omt_count, save_seconds);
+
+    BENCHMARK("mapbuffer::preload_omt") {
+        buffer.clear();
+        for (const auto& omt : omts) {
+            buffer.preload_omt(omt);
+        }
+        buffer.drain_pending_submap_destroy();
+    };
+    buffer.clear();
+    const auto preload_seconds = time_once([&]() {
+        for (const auto& omt : omts) {
+            buffer.preload_omt(omt);
+        }
+    });
+    report("mapbuffer::preload_omt", bytes, benchmark_omt_count, preload_seconds);
+    buffer.drain_pending_submap_destroy();
+    buffer.clear();
+}
+
+TEST_CASE("map blob size by format and compression", "[.][save_benchmark][benchmark]") {
+    auto* const w = g->get_active_world();
+    REQUIRE(w != nullptr);
+    const auto omts = benchmark_omts();
+    const auto* const dictionary = save_dictionary::for_path("maps/0.0.0/0.0.0.map");
+    REQUIRE(dictionary != nullptr);
+    const auto restore_binary = restore_on_out_of_scope<bool>(binary_map_saves);
+
+    for (const auto binary : {false, true}) {
+        binary_map_saves = binary;
+        auto buffer = mapbuffer();
+        buffer.set_dimension_id(dimension_id(
+            string_format("save_benchmark_%s_%s", binary ? "binary" : "json", get_pid_string())));
+        populate(buffer, omts);
+        buffer.save(false, false, false);
+        w->flush_map_writes();
+
+        auto raw = std::size_t{0};
+        auto zlib = std::size_t{0};
+        auto primed = std::size_t{0};
+        w->read_map_omts_data(buffer.get_dimension_id().str(), omts,
+                              [&](const tripoint_abs_omt&, std::istream& fin) {
+                                  const auto blob =
+                                      std::string(std::istreambuf_iterator<char>(fin), {});
+                                  auto out = std::vector<std::byte>{};
+                                  zlib_compress(blob, out);
+                                  zlib += out.size();
+                                  out.clear();
+                                  zlib_compress(blob, out, dictionary->data);
+                                  primed += out.size();
+                                  raw += blob.size();
+                              });
+        REQUIRE(raw > 0);
+        WARN(string_format("%s blobs: %zu bytes raw, %zu zlib (%.1f%%), %zu zlib+%s (%.1f%%)",
+                           binary ? "binary" : "json", raw, zlib, 100.0 * zlib / raw, primed,
+                           dictionary->id, 100.0 * primed / raw));
+        buffer.clear();
+    }
+}
+
+TEST_CASE("overmap save and load throughput", "[.][save_benchmark][benchmark]") {
+    clear_all_state();
+    const auto cleanup = on_out_of_scope([]() { clear_all_state(); });
+    auto* const w = g->get_active_world();
+    REQUIRE(w != nullptr);
+
+    const auto dim = mapbuffer_registry::primary_dimension_id();
+    auto& buffer = get_primary_overmapbuffer();
+    const auto positions = std::array{point_abs_om(0, 0), point_abs_om(1, 0)};
+    for (const auto& p : positions) {
+        buffer.get(p);
+    }
+
+    BENCHMARK("overmapbuffer::save") { buffer.save(dim); };
+    const auto save_seconds = time_once([&]() {
+        buffer.save(dim);
+        w->flush_map_writes();
+    });
+    auto bytes = std::size_t{0};
+    for (const auto& p : positions) {
+        w->read_overmap(dim.str(), p, [&](std::istream& fin) {
+            fin.seekg(0, std::ios_base::end);
+            bytes += static_cast<std::size_t>(fin.tellg());
+        });
+    }
+    report("overmapbuffer::save", bytes, static_cast<int>(positions.size()), save_seconds);
+
+    BENCHMARK("overmapbuffer load") {
+        buffer.clear();
+        for (const auto& p : positions) {
+            buffer.get(p);
+        }
+    };
+    buffer.clear();
+    const auto load_seconds = time_once([&]() {
+        for (const auto& p : positions) {
+            buffer.get(p);
+        }
+    });
+    report("overmapbuffer load", bytes, static_cast<int>(positions.size()), load_seconds);
+}
+
+TEST_CASE("player save and load throughput", "[.][save_benchmark][benchmark]") {
+    clear_all_state();
+    const auto cleanup = on_out_of_scope([]() { clear_all_state(); });
+
+    auto& you = get_avatar();
+    for (auto i = 0; i < 200; ++i) {
+        you.i_add(item::spawn(i % 2 == 0 ? "rock" : "sugar"));
+    }
+
+    auto saved = std::string{};
+    BENCHMARK("game::serialize") {
+        std::ostringstream out;
+        g->serialize(out);
+        saved = out.str();
+        return saved.size();
+    };
+    REQUIRE(!saved.empty());
+    const auto save_seconds = time_once([&]() {
+        std::ostringstream out;
+        g->serialize(out);
+        saved = out.str();
+    });
+    report("game::serialize", saved.size(), 1, save_seconds);
+
+    BENCHMARK("game::unserialize") {
+        std::istringstream in(saved);
+        return g->unserialize(in);
+    };
+    const auto load_seconds = time_once([&]() {
+        std::istringstream in(saved);
+        g->unserialize(in);
+    });
+    report("game::unserialize", saved.size(), 1, load_seconds);
+}
@@ -0,0 +1,86 @@
+#include "catch/catch.hpp"
+#include "compress.h"
+#include "save_dictionary.h"
+
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+TEST_CASE("save dictionaries are chosen by blob category", "[save_dictionary]") {
+    const auto* const submap = save_dictionary::for_path("maps/0.0.0/12.34.0.map");
+    REQUIRE(submap != nullptr);
+    CHECK(submap->id.starts_with("submap.v"));
+
+    const auto* const overmap = save_dictionary::for_path("dimensions/moon/o.1.-2");
+    REQUIRE(overmap != nullptr);
+    CHECK(overmap->id.starts_with("overmap.v"));
+
+    CHECK(save_dictionary::for_path(".seen.1.-2") == nullptr);
+    CHECK(save_dictionary::for_compression("zlib") == nullptr);
+    CHECK(save_dictionary::for_compression("zlib-dict:submap.v999999") == nullptr);
+    CHECK(save_dictionary::for_compression(std::string(save_dictionary::compression_prefix) + submap->id)
+          == submap);
+}
+
+TEST_CASE("dictionary compression round-trips and needs its dictionary", "[save_dictionary]") {
+    const auto* const dictionary = save_dictionary::for_path("maps/0.0.0/0.0.0.map");
+    REQUIRE(dictionary != nullptr);
+
+    const auto input = std::string(R"([{"version":33,"coordinates":[0,0,0],"turn_last_touched":5,)"
+                                   R"("temperature":0,"terrain":[["t_grass",144]],"radiation":[0,144]}])");
+    auto primed = std::vector<std::byte>{};
+    zlib_compress(input, primed, dictionary->data);
+    auto plain = std::vector<std::byte>{};
+    zlib_compress(input, plain);
+    CHECK(primed.size() < plain.size());
+
+    auto output = std::string{};
+    zlib_decompress(primed.data(), static_cast<int>(primed.size()), output, dictionary->data);
+    CHECK(output == input);
+
+    CHECK_THROWS(zlib_decompress(primed.data(), static_cast<int>(primed.size()), output));
+}
+
+TEST_CASE("streamed compression matches the buffered payload", "[save_dictionary]") {
+    const auto* const dictionary = save_dictionary::for_path("maps/0.0.0/0.0.0.map");
+    REQUIRE(dictionary != nullptr);
+
+    // Longer than one staging chunk so the stream deflates more than once.
+    auto input = std::string{};
+    while (input.size() < 200 * 1024) {
+        input += R"({"typeid":"t_grass","charges":)" + std::to_string(input.size()) + "},";
+    }
+
+    auto streamed = std::vector<std::byte>{};
+    {
+        auto buf = zlib_ostreambuf(streamed, [&](std::string_view head) {
+            CHECK(head.size() > 0);
+            return std::string_view(dictionary->data);
+        });
+        auto out = std::ostream(&buf);
+        out << input;
+        buf.finish();
+        CHECK(buf.used_dictionary());
+    }
+
+    auto output = std::string{};
+    zlib_decompress(streamed.data(), static_cast<int>(streamed.size()), output, dictionary->data);
+    CHECK(output == input);
+}
+
+TEST_CASE("memory streambuf reads and seeks without copying", "[save_dictionary]") {
+    const auto data = std::string_view("[1,2,3]");
+    auto buf = memory_istreambuf(data);
+    auto in = std::istream(&buf);
+
+    CHECK(in.get() == '[');
+    CHECK(in.tellg() == 1);
+    in.seekg(-1, std::ios_base::end);
+    CHECK(in.get() == ']');
+    in.seekg(3);
+    CHECK(in.get() == '2');
+    in.unget();
+    CHECK(in.peek() == '2');
+    CHECK(buf.view().data() == data.data());
+}
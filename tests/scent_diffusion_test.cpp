@@ -0,0 +1,106 @@
+#include "catch/catch.hpp"
+#include "scent_diffusion.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <vector>
+
+namespace {
+
+using namespace scent_diffusion;
+
+// The diffusion as scent_map::update did it before the step moved to plain arrays,
+// branches and all, for the vector code to match.
+auto reference_diffusion(const window& in) -> std::vector<int> {
+    const auto st = [&](int x, int y) { return in.transfer[window_index(x, y)]; };
+    const auto sc = [&](int x, int y) { return in.scent[window_index(x, y)]; };
+    const auto holes = [&](int x, int y) { return in.holes[window_index(x, y)]; };
+
+    std::vector<std::array<int, window_side>> sum_3_scent_y(out_side);
+    std::vector<std::array<int, window_side>> squares_used_y(out_side);
+    for (int x = 0; x < window_side; ++x) {
+        for (int y = 0; y < out_side; ++y) {
+            sum_3_scent_y[y][x] = 0;
+            squares_used_y[y][x] = 0;
+            for (int i = y; i <= y + 2; ++i) {
+                sum_3_scent_y[y][x] += st(x, i) * sc(x, i);
+                squares_used_y[y][x] += st(x, i);
+            }
+        }
+    }
+
+    auto diffused = std::vector<int>(out_side * out_side);
+    for (int x = 1; x < window_side - 1; ++x) {
+        for (int y = 0; y < out_side; ++y) {
+            const int wy = y + 1;
+            int squares_used =
+                squares_used_y[y][x - 1] + squares_used_y[y][x] + squares_used_y[y][x + 1];
+            int total = sum_3_scent_y[y][x - 1] + sum_3_scent_y[y][x] + sum_3_scent_y[y][x + 1];
+
+            if ((holes(x, wy) & hole_nw) && st(x + 1, wy + 1) == 5) {
+                squares_used -= 4;
+                total -= 4 * sc(x + 1, wy + 1);
+            }
+            if ((holes(x, wy) & hole_ne) && st(x - 1, wy + 1) == 5) {
+                squares_used -= 4;
+                total -= 4 * sc(x - 1, wy + 1);
+            }
+            if ((holes(x - 1, wy - 1) & hole_nw) && st(x - 1, wy - 1) == 5) {
+                squares_used -= 4;
+                total -= 4 * sc(x - 1, wy - 1);
+            }
+            if ((holes(x + 1, wy - 1) & hole_ne) && st(x + 1, wy - 1) == 5) {
+                squares_used -= 4;
+                total -= 4 * sc(x + 1, wy - 1);
+            }
+
+            const int cur = sc(x, wy);
+            int temp_scent = cur * (250 - squares_used * st(x, wy));
+            temp_scent -= cur * st(x, wy) * (45 - squares_used) / 5;
+            diffused[out_index(x - 1, y)] = (temp_scent + total * st(x, wy)) / 250;
+        }
+    }
+    return diffused;
+}
+
+auto random_window(unsigned seed) -> window {
+    auto rng = std::mt19937(seed);
+    auto transfers = std::array<int, 3>{0, 1, 5};
+    auto in = window{};
+    in.clear();
+    for (auto i = std::size_t{0}; i < in.scent.size(); ++i) {
+        in.scent[i] = std::uniform_int_distribution<int>(0, 1000)(rng);
+        in.transfer[i] = transfers[std::uniform_int_distribution<int>(0, 2)(rng)];
+        in.holes[i] = std::uniform_int_distribution<int>(0, 7)(rng) == 0
+                          ? std::uniform_int_distribution<int>(1, 3)(rng)
+                          : 0;
+    }
+    return in;
+}
+
+} // namespace
+
+TEST_CASE("scent_diffusion_matches_the_scalar_diffusion", "[scent]") {
+    const auto parallel = GENERATE(false, true);
+    CAPTURE(parallel);
+    for (auto seed = 1u; seed <= 4u; ++seed) {
+        CAPTURE(seed);
+        const auto in = random_window(seed);
+        auto out = step{};
+        diffuse(in, out, parallel);
+        CHECK(out.diffused == reference_diffusion(in));
+    }
+}
+
+TEST_CASE("scent_diffusion_keeps_an_even_field_even", "[scent]") {
+    auto in = window{};
+    in.clear();
+    std::ranges::fill(in.scent, 500);
+    std::ranges::fill(in.transfer, 5);
+    auto out = step{};
+    diffuse(in, out, false);
+
+    // 45 squares used of 45: all of a tile's scent is shared out and as much comes back.
+    for (const auto v : out.diffused) { REQUIRE(v == 500); }
+}
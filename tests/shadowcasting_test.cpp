@@ -252,7 +252,7 @@ static void shadowcasting_runoff(const int iterations, const bool test_bresenham
         // Then the current algorithm.
         castLightAll(
             &seen_squares_experiment[0][0], &transparency_cache[0][0], &blocked_cache[0][0],
-            MAPSIZE * SEEX, MAPSIZE * SEEY, offset, 0, VISIBILITY_FULL, k_sight_model);
+            {MAPSIZE * SEEX, MAPSIZE * SEEY}, offset, 0, VISIBILITY_FULL, k_sight_model);
     }
     const auto end2 = std::chrono::high_resolution_clock::now();
 
@@ -315,7 +315,7 @@ static void shadowcasting_3d_2d(const int iterations) {
         // First the control algorithm.
         castLightAll(
             &seen_squares_control[0][0], &transparency_cache[0][0], &blocked_cache[0][0],
-            MAPSIZE * SEEX, MAPSIZE * SEEY, offset.xy(), 0, VISIBILITY_FULL, k_sight_model);
+            {MAPSIZE * SEEX, MAPSIZE * SEEY}, offset.xy(), 0, VISIBILITY_FULL, k_sight_model);
     }
     const auto end1 = std::chrono::high_resolution_clock::now();
 
@@ -328,10 +328,10 @@ static void shadowcasting_3d_2d(const int iterations) {
     array_of_grids_of<const diagonal_blocks> blocked_caches;
     for (int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++) {
         const int zi = z + OVERMAP_DEPTH;
-        seen_caches[zi] = {&seen_squares_experiment[0][0], MAPSIZE * SEEX, MAPSIZE * SEEY};
-        transparency_caches[zi] = {&transparency_cache[0][0], MAPSIZE * SEEX, MAPSIZE * SEEY};
-        floor_caches[zi] = {&floor_cache[0][0], MAPSIZE * SEEX, MAPSIZE * SEEY};
-        blocked_caches[zi] = {&blocked_cache[0][0], MAPSIZE * SEEX, MAPSIZE * SEEY};
+        seen_caches[zi] = {&seen_squares_experiment[0][0], {MAPSIZE * SEEX, MAPSIZE * SEEY}};
+        transparency_caches[zi] = {&transparency_cache[0][0], {MAPSIZE * SEEX, MAPSIZE * SEEY}};
+        floor_caches[zi] = {&floor_cache[0][0], {MAPSIZE * SEEX, MAPSIZE * SEEY}};
+        blocked_caches[zi] = {&blocked_cache[0][0], {MAPSIZE * SEEX, MAPSIZE * SEEY}};
     }
 
     const auto start2 = std::chrono::high_resolution_clock::now();
@@ -420,7 +420,7 @@ static void run_spot_check(const grid_overlay& test_case, const grid_overlay& ex
     }
 
     castLightAll(&seen_squares[0][0], &transparency_cache[0][0], &blocked_cache[0][0],
-                 MAPSIZE * SEEX, MAPSIZE * SEEY, ORIGIN.xy(), 0, VISIBILITY_FULL, k_sight_model);
+                 {MAPSIZE * SEEX, MAPSIZE * SEEY}, ORIGIN.xy(), 0, VISIBILITY_FULL, k_sight_model);
     // Compares the whole grid, but out-of-bounds compares will de-facto pass.
     for (int y = 0; y < expected_result.height(); ++y) {
         for (int x = 0; x < expected_result.width(); ++x) {
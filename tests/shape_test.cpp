@@ -166,3 +166,29 @@ TEST_CASE("cone_factory_test", "[shape]") {
         CHECK(s->distance_at(rl_vec3d(10, 5, 0)) < 0.0);
     }
 }
+
+TEST_CASE("rasterized_shape_matches_distance_function", "[shape]") {
+    const auto factory = shape_factory(std::make_shared<cone_factory>(30_degrees, 8.0));
+    const auto s = factory.create(tripoint(20, 20, 0), tripoint(27, 24, 0));
+    REQUIRE(s->get_raster());
+    const auto bb = s->bounding_box();
+    for (int y = bb.p_min.y - 2; y <= bb.p_max.y + 2; y++) {
+        for (int x = bb.p_min.x - 2; x <= bb.p_max.x + 2; x++) {
+            const auto p = tripoint(x, y, 0);
+            CAPTURE(p);
+            CHECK(s->distance_at(p) == s->distance_at(rl_vec3d(x, y, 0)));
+        }
+    }
+}
+
+TEST_CASE("shapes_aimed_the_same_way_share_a_raster", "[shape]") {
+    const auto factory = shape_factory(std::make_shared<cone_factory>(45_degrees, 5.0));
+    const auto a = factory.create(tripoint(10, 10, 0), tripoint(15, 12, 0));
+    const auto b = factory.create(tripoint(40, 3, 1), tripoint(45, 5, 1));
+    const auto c = factory.create(tripoint(10, 10, 0), tripoint(12, 15, 0));
+    CHECK(a->get_raster() == b->get_raster());
+    CHECK(a->get_raster() != c->get_raster());
+    for (const auto& off : {tripoint(2, 1, 0), tripoint(4, 0, 0), tripoint(-1, 0, 0)}) {
+        CHECK(a->distance_at(tripoint(10, 10, 0) + off) == b->distance_at(tripoint(40, 3, 1) + off));
+    }
+}
@@ -0,0 +1,57 @@
+#include "catch/catch.hpp"
+#include "sharded_map.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+TEST_CASE("sharded_map_finds_inserted_values", "[sharded_map]") {
+    auto map = sharded_map<int, const int*>();
+    auto values = std::vector<int>(1000);
+    for (auto i = 0; i < 1000; ++i) { map.insert_or_assign(i, &values[i]); }
+    CHECK(map.size() == 1000);
+
+    for (auto i = 0; i < 1000; ++i) {
+        CAPTURE(i);
+        CHECK(map.find(i) == &values[i]);
+    }
+    CHECK(map.find(1000) == nullptr);
+    CHECK_FALSE(map.contains(-1));
+
+    CHECK(map.erase(10));
+    CHECK_FALSE(map.erase(10));
+    CHECK(map.find(10) == nullptr);
+
+    map.insert_or_assign(11, &values[0]);
+    CHECK(map.find(11) == &values[0]);
+
+    map.clear();
+    CHECK(map.size() == 0);
+}
+
+TEST_CASE("sharded_map_reads_while_another_thread_writes", "[sharded_map]") {
+    auto map = sharded_map<int, int>();
+    for (auto i = 0; i < 256; ++i) { map.insert_or_assign(i, i + 1); }
+
+    auto stop = std::atomic<bool>(false);
+    auto wrong = std::atomic<int>(0);
+    auto readers = std::vector<std::thread>();
+    for (auto t = 0; t < 4; ++t) {
+        readers.emplace_back([&] {
+            while (!stop.load()) {
+                for (auto i = 0; i < 256; ++i) {
+                    if (map.find(i) != i + 1) { ++wrong; }
+                }
+            }
+        });
+    }
+    // The writer only touches keys the readers never look up.
+    for (auto round = 0; round < 200; ++round) {
+        for (auto i = 1000; i < 1064; ++i) { map.insert_or_assign(i, round); }
+        for (auto i = 1000; i < 1064; ++i) { map.erase(i); }
+    }
+    stop = true;
+    for (auto& r : readers) { r.join(); }
+    CHECK(wrong.load() == 0);
+    CHECK(map.size() == 256);
+}
@@ -0,0 +1,67 @@
+#include "catch/catch.hpp"
+#include "sight_memo.h"
+
+#include <utility>
+
+TEST_CASE("sight_memo_remembers_answers_per_target", "[sight_memo]") {
+    auto memo = sight_memo();
+    const auto key = sight_memo::key{.origin = tripoint(10, 10, 0), .generation = 3};
+    CHECK_FALSE(memo.find(key, point(2, 3)).has_value());
+
+    memo.remember(key, point(2, 3), true);
+    memo.remember(key, point(-5, 0), false);
+    CHECK(memo.find(key, point(2, 3)) == true);
+    CHECK(memo.find(key, point(-5, 0)) == false);
+    CHECK_FALSE(memo.find(key, point(3, 2)).has_value());
+
+    // Targets past the radius are never remembered.
+    memo.remember(key, point(sight_memo::radius + 1, 0), true);
+    CHECK_FALSE(memo.find(key, point(sight_memo::radius + 1, 0)).has_value());
+    memo.remember(key, point(-sight_memo::radius, sight_memo::radius), true);
+    CHECK(memo.find(key, point(-sight_memo::radius, sight_memo::radius)) == true);
+}
+
+TEST_CASE("sight_memo_forgets_on_a_new_key", "[sight_memo]") {
+    auto memo = sight_memo();
+    const auto key = sight_memo::key{.origin = tripoint(10, 10, 0), .generation = 3};
+    memo.remember(key, point(1, 1), true);
+
+    auto moved = key;
+    moved.origin = tripoint(11, 10, 0);
+    CHECK_FALSE(memo.find(moved, point(1, 1)).has_value());
+    auto relit = key;
+    relit.generation = 4;
+    CHECK_FALSE(memo.find(relit, point(1, 1)).has_value());
+    CHECK(memo.find(key, point(1, 1)) == true);
+
+    memo.remember(relit, point(0, 1), false);
+    CHECK_FALSE(memo.find(key, point(1, 1)).has_value());
+    CHECK(memo.find(relit, point(0, 1)) == false);
+
+    // Copies are for another creature and start empty.
+    const auto copy = memo;
+    CHECK_FALSE(copy.find(relit, point(0, 1)).has_value());
+    const auto moved_memo = std::move(memo);
+    CHECK_FALSE(moved_memo.find(relit, point(0, 1)).has_value());
+}
+
+TEST_CASE("sight_memo_remembers_a_whole_field_of_view", "[sight_memo]") {
+    auto memo = sight_memo();
+    const auto key = sight_memo::key{.origin = tripoint(10, 10, 0), .generation = 3};
+    CHECK_FALSE(memo.complete(key, 4));
+
+    memo.remember_all(key, 4, [](const point& p) { return p.x >= 0; });
+    CHECK(memo.complete(key, 4));
+    CHECK(memo.complete(key, 2));
+    CHECK_FALSE(memo.complete(key, 5));
+    CHECK(memo.find(key, point(4, -4)) == true);
+    CHECK(memo.find(key, point(-1, 0)) == false);
+    CHECK_FALSE(memo.find(key, point(5, 0)).has_value());
+
+    // A single answer for another key forgets the field.
+    auto moved = key;
+    moved.origin = tripoint(11, 10, 0);
+    memo.remember(moved, point(1, 0), true);
+    CHECK_FALSE(memo.complete(key, 4));
+    CHECK_FALSE(memo.complete(moved, 1));
+}
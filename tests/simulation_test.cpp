@@ -1,3 +1,7 @@
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
 #include "avatar.h"
 #include "cached_options.h"
 #include "cata_utility.h"
@@ -14,6 +18,7 @@
 #include "submap.h"
 #include "submap_fields.h"
 #include "submap_load_manager.h"
+#include "thread_pool.h"
 #include "type_id.h"
 #include "units.h"
 
@@ -160,3 +165,114 @@ TEST_CASE("fire_isolated_between_dimensions", "[simulation][field][dimension]")
 
     MAPBUFFER_REGISTRY.unload_dimension(TEST_DIM_ID);
 }
+
+// ── Test 4 ────────────────────────────────────────────────────────────────────
+// Verify that process_fields_in_submaps() gives the same result whether the
+// submaps run on the thread pool or one after another.  Established fires sit
+// on the borders of a row of submaps so spreading crosses between them.
+TEST_CASE("parallel_field_processing_matches_serial", "[simulation][field][thread_pool]") {
+    using fire_snapshot = std::vector<std::tuple<int, int, int, int, int, int>>;
+    const auto positions = std::vector<tripoint_abs_sm>{
+        FAR_SM_POS, FAR_SM_POS + tripoint_rel_sm(1, 0, 0), FAR_SM_POS + tripoint_rel_sm(2, 0, 0)};
+
+    const auto run_once = [&](const bool parallel) {
+        clear_all_state();
+        put_player_underground();
+        auto& dim = MAPBUFFER_REGISTRY.get(TEST_DIM_ID);
+        std::ranges::for_each(positions, [&](const tripoint_abs_sm& pos) {
+            auto* sm = make_blank_submap(dim, pos);
+            REQUIRE(sm != nullptr);
+            for (const auto x : {0, 5, SEEX - 1}) {
+                for (const auto y : {0, 5, SEEY - 1}) {
+                    plant_fire(*sm, point_sm_ms{x, y}, 3);
+                    sm->get_field(point_sm_ms{x, y}).find_field(fd_fire)->set_field_age(-10_minutes);
+                }
+            }
+        });
+
+        for (auto turn = 0; turn < 5; ++turn) {
+            process_fields_in_submaps(TEST_DIM_ID, positions, dim, parallel);
+        }
+
+        auto snapshot = fire_snapshot{};
+        std::ranges::for_each(positions, [&](const tripoint_abs_sm& pos) {
+            const auto* sm = dim.lookup_submap_in_memory(pos);
+            REQUIRE(sm != nullptr);
+            for (auto x = 0; x < SEEX; ++x) {
+                for (auto y = 0; y < SEEY; ++y) {
+                    if (const auto* fire = sm->get_field(point_sm_ms{x, y}).find_field(fd_fire)) {
+                        snapshot.emplace_back(pos.x(), pos.y(), x, y, fire->get_field_intensity(),
+                                              to_turns<int>(fire->get_field_age()));
+                    }
+                }
+            }
+        });
+        MAPBUFFER_REGISTRY.unload_dimension(TEST_DIM_ID);
+        return snapshot;
+    };
+
+    const auto serial = run_once(false);
+    const auto parallel = run_once(true);
+    CHECK_FALSE(serial.empty());
+    CHECK(serial == parallel);
+}
+
+// ── Test 5 ────────────────────────────────────────────────────────────────────
+// Verify that two dimensions processed at once from pool workers, as world_tick
+// fans them out, end up with the same fires as when run one after another.
+TEST_CASE("dimensions_fanned_out_match_serial", "[simulation][field][thread_pool]") {
+    using fire_snapshot = std::vector<std::tuple<int, int, int, int, int>>;
+    const auto dims = std::vector<dimension_id>{TEST_DIM_ID, dimension_id("sim_test_dim_b")};
+    const auto positions = std::vector<tripoint_abs_sm>{FAR_SM_POS, FAR_SM_POS + tripoint_rel_sm(1, 0, 0)};
+
+    const auto run_once = [&](const bool fan_out) {
+        clear_all_state();
+        put_player_underground();
+        std::ranges::for_each(dims, [&](const dimension_id& dim_id) {
+            auto& dim = MAPBUFFER_REGISTRY.get(dim_id);
+            std::ranges::for_each(positions, [&](const tripoint_abs_sm& pos) {
+                auto* sm = make_blank_submap(dim, pos);
+                REQUIRE(sm != nullptr);
+                plant_fire(*sm, point_sm_ms{SEEX - 1, 5}, 3);
+                sm->get_field(point_sm_ms{SEEX - 1, 5}).find_field(fd_fire)->set_field_age(-10_minutes);
+            });
+        });
+
+        for (auto turn = 0; turn < 5; ++turn) {
+            auto dirty = std::vector<std::vector<tripoint_bub_ms>>(dims.size());
+            const auto run = [&](const int i) {
+                process_fields_in_submaps(dims[i], positions, MAPBUFFER_REGISTRY.get(dims[i]), false,
+                                          fan_out ? &dirty[i] : nullptr);
+            };
+            if (fan_out) {
+                parallel_for(0, static_cast<int>(dims.size()), run);
+            } else {
+                for (auto i = 0; i < static_cast<int>(dims.size()); ++i) {
+                    run(i);
+                }
+            }
+        }
+
+        auto snapshot = fire_snapshot{};
+        for (auto i = 0; i < static_cast<int>(dims.size()); ++i) {
+            std::ranges::for_each(positions, [&](const tripoint_abs_sm& pos) {
+                const auto* sm = MAPBUFFER_REGISTRY.get(dims[i]).lookup_submap_in_memory(pos);
+                REQUIRE(sm != nullptr);
+                for (auto x = 0; x < SEEX; ++x) {
+                    for (auto y = 0; y < SEEY; ++y) {
+                        if (const auto* fire = sm->get_field(point_sm_ms{x, y}).find_field(fd_fire)) {
+                            snapshot.emplace_back(i, pos.x(), x, y, fire->get_field_intensity());
+                        }
+                    }
+                }
+            });
+        }
+        std::ranges::for_each(dims, [](const dimension_id& dim_id) { MAPBUFFER_REGISTRY.unload_dimension(dim_id); });
+        return snapshot;
+    };
+
+    const auto serial = run_once(false);
+    const auto fanned_out = run_once(true);
+    CHECK_FALSE(serial.empty());
+    CHECK(serial == fanned_out);
+}
@@ -5,7 +5,10 @@
 #include "string_id_utils.h"
 #include "type_id.h"
 
+#include <string>
+#include <thread>
 #include <unordered_set>
+#include <vector>
 
 TEST_CASE("sizeof_new_id", "[.][int_id][string_id]") {
     DYNAMIC_SECTION("sizeof: dynamic string_id: " << sizeof(trait_group::Trait_group_tag)) {}
@@ -51,6 +54,35 @@ TEST_CASE("string_ids_intern_test", "[string_id]") {
     }
 }
 
+TEST_CASE("string_ids_intern_concurrently", "[string_id]") {
+    static constexpr int num_ids = 20000;
+    static constexpr int num_threads = 4;
+
+    struct test_obj {};
+    using id = string_id<test_obj>;
+    // Every thread interns the same strings, new and already known alike, in its own order
+    auto interned = std::vector<std::vector<id>>(num_threads);
+    auto threads = std::vector<std::thread>();
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([t, &interned] {
+            for (int i = 0; i < num_ids; ++i) {
+                const int n = (i * (t + 1)) % num_ids;
+                interned[t].push_back(id("concurrent_id" + std::to_string(n)));
+            }
+        });
+    }
+    for (auto& thread : threads) { thread.join(); }
+
+    for (int t = 0; t < num_threads; ++t) {
+        for (int i = 0; i < num_ids; i += 97) {
+            const int n = (i * (t + 1)) % num_ids;
+            CAPTURE(t, n);
+            CHECK(interned[t][i] == id("concurrent_id" + std::to_string(n)));
+            CHECK(interned[t][i].str() == "concurrent_id" + std::to_string(n));
+        }
+    }
+}
+
 TEST_CASE("string_ids_collection_equality", "[string_id]") {
     struct test_obj {};
     using id = string_id<test_obj>;
@@ -1,10 +1,24 @@
+#include "batch_turns.h"
+#include "cached_options.h"
 #include "catch/catch.hpp"
+#include "cata_utility.h"
 #include "coordinates.h"
+#include "field_type.h"
+#include "game.h"
 #include "game_constants.h"
 #include "int_id.h"
+#include "item.h"
+#include "json.h"
+#include "mapdata.h"
 #include "submap.h"
+#include "submap_binary.h"
+#include "trap.h"
 #include "type_id.h"
 
+#include <sstream>
+#include <string>
+#include <vector>
+
 TEST_CASE("submap rotation", "[submap]") {
     // Corners are labelled starting from the upper-left one, clockwise.
     // NOLINTNEXTLINE(cata-point-initialization)
@@ -88,3 +102,194 @@ TEST_CASE("submap rotation", "[submap]") {
         }
     }
 }
+
+TEST_CASE("binary submap encoding round-trips tile layers", "[submap][savegame]") {
+    const auto dirt = ter_str_id("t_dirt").id();
+    const auto floor = ter_str_id("t_floor").id();
+    const auto chair = furn_str_id("f_chair").id();
+    const auto bubblewrap = trap_str_id("tr_bubblewrap").id();
+    const auto blood = field_type_str_id("fd_blood").id();
+    const auto p = point_sm_ms{3, 7};
+
+    submap original(tripoint_abs_sm::zero(), {});
+    original.set_all_ter(dirt);
+    original.set_ter(p, floor);
+    original.set_furn(p, chair);
+    original.set_trap(point_sm_ms{SEEX - 1, SEEY - 1}, bubblewrap);
+    original.set_radiation(p, 12);
+    original.get_field(p).add_field(blood, 2, 5_turns);
+    original.insert_cosmetic(p, "SIGNAGE", "keep out");
+
+    auto out = submap_binary::writer{};
+    original.store_binary(out);
+    const auto blob = out.finish();
+    REQUIRE(submap_binary::is_encoded(blob));
+
+    auto in = submap_binary::reader(blob);
+    submap loaded(tripoint_abs_sm::zero(), {});
+    loaded.load_binary(in, savegame_version, tripoint_abs_ms::zero(), {});
+    CHECK(in.at_end());
+
+    CHECK(loaded.get_ter(point_sm_ms::zero()) == dirt);
+    CHECK(loaded.get_ter(p) == floor);
+    CHECK(loaded.get_furn(p) == chair);
+    CHECK(loaded.get_furn(point_sm_ms::zero()) == f_null);
+    CHECK(loaded.get_trap(point_sm_ms{SEEX - 1, SEEY - 1}) == bubblewrap);
+    CHECK(loaded.get_radiation(p) == 12);
+    CHECK(loaded.get_radiation(point_sm_ms::zero()) == 0);
+    REQUIRE(loaded.get_field(p).find_field(blood) != nullptr);
+    CHECK(loaded.get_field(p).find_field(blood)->get_field_intensity() == 2);
+    CHECK(loaded.field_count == 1);
+    REQUIRE(loaded.cosmetics.size() == 1);
+    CHECK(loaded.cosmetics[0].pos == p);
+    CHECK(loaded.cosmetics[0].str == "keep out");
+}
+
+TEST_CASE("submap field summary follows added and decayed fields", "[submap][field]") {
+    const auto blood = field_type_str_id("fd_blood").id();
+    const auto fire = field_type_str_id("fd_fire").id();
+    const auto p = point_sm_ms{4, 9};
+
+    submap sm(tripoint_abs_sm::zero(), {});
+    CHECK_FALSE(sm.may_have_field(blood));
+    CHECK_FALSE(sm.may_have_field_in_row(p.y()));
+
+    REQUIRE(sm.get_field(p).add_field(blood, 1, 0_turns));
+    sm.note_field_added(p, blood);
+    CHECK(sm.may_have_field(blood));
+    CHECK(sm.may_have_field_at(p));
+    CHECK_FALSE(sm.may_have_field_at(p + point_rel_ms::east()));
+    CHECK_FALSE(sm.may_have_field_in_row(p.y() - 1));
+    if (submap::field_type_bit(fire) != submap::field_type_bit(blood)) {
+        CHECK_FALSE(sm.may_have_field(fire));
+    }
+
+    // a dead field stays in the summary until the cache is compacted
+    REQUIRE(sm.get_field(p).remove_field(blood));
+    CHECK(sm.may_have_field_at(p));
+    sm.compact_field_cache();
+    CHECK(sm.field_cache.empty());
+    CHECK_FALSE(sm.may_have_field(blood));
+    CHECK_FALSE(sm.may_have_field_at(p));
+}
+
+TEST_CASE("submap item rows follow added and removed items", "[submap][item]") {
+    const auto p = point_sm_ms{7, 3};
+
+    submap sm(tripoint_abs_sm::zero(), {});
+    CHECK_FALSE(sm.may_have_items());
+    CHECK_FALSE(sm.may_have_items_at(p));
+
+    sm.get_items(p).push_back(item::spawn("rock"));
+    sm.note_item_added(p);
+    CHECK(sm.may_have_items());
+    CHECK(sm.may_have_items_at(p));
+    CHECK_FALSE(sm.may_have_items_at(p + point_rel_ms::east()));
+
+    // a picked up item stays in the rows until they are compacted
+    sm.get_items(p).clear();
+    CHECK(sm.may_have_items_at(p));
+    sm.compact_item_rows();
+    CHECK_FALSE(sm.may_have_items());
+}
+
+TEST_CASE("submap modification generation tracks writes since the last save", "[submap][savegame]") {
+    const auto p = point_sm_ms{2, 5};
+    submap sm(tripoint_abs_sm::zero(), {});
+
+    // Never written anywhere yet.
+    CHECK(sm.is_modified());
+    sm.mark_saved();
+    CHECK_FALSE(sm.is_modified());
+
+    const auto& readonly = sm;
+    CHECK(readonly.get_items(p).empty());
+    CHECK(readonly.get_field(p).field_count() == 0);
+    CHECK_FALSE(sm.is_modified());
+
+    SECTION("setters") {
+        sm.set_ter(p, ter_str_id("t_floor").id());
+        CHECK(sm.is_modified());
+    }
+    SECTION("mutable accessors") {
+        sm.get_items(p);
+        CHECK(sm.is_modified());
+    }
+    SECTION("cosmetics") {
+        sm.set_graffiti(p, "was here");
+        CHECK(sm.is_modified());
+        sm.mark_saved();
+        sm.delete_graffiti(p);
+        CHECK(sm.is_modified());
+    }
+}
+
+namespace {
+
+auto store_json(const submap& sm) -> std::string {
+    std::ostringstream os;
+    JsonOut jsout(os);
+    jsout.start_object();
+    sm.store(jsout);
+    jsout.end_object();
+    return os.str();
+}
+
+auto load_json(submap& sm, const std::string& json) -> void {
+    std::istringstream is(json);
+    JsonIn jsin(is);
+    jsin.start_object();
+    while (!jsin.end_object()) {
+        sm.load(jsin, jsin.get_member_name(), savegame_version, tripoint_abs_ms::zero(), {});
+    }
+}
+
+} // namespace
+
+TEST_CASE("deferred submap items stay serialized until first use", "[submap][savegame]") {
+    const auto p = point_sm_ms{4, 1};
+    submap original(tripoint_abs_sm::zero(), {});
+    original.set_all_ter(ter_str_id("t_floor").id());
+    original.get_items(p).push_back(item::spawn("rock"));
+    original.get_items(p).push_back(item::spawn("rock"));
+    const auto json = store_json(original);
+
+    const auto restore = restore_on_out_of_scope<bool>(deferred_submap_items);
+    deferred_submap_items = true;
+    submap loaded(tripoint_abs_sm::zero(), {});
+    load_json(loaded, json);
+    REQUIRE(loaded.has_deferred_items());
+    CHECK(loaded.get_ter(p) == ter_str_id("t_floor").id());
+
+    // Saving an untouched submap writes the original text back.
+    CHECK(store_json(loaded) == json);
+    CHECK(loaded.has_deferred_items());
+
+    const auto& readonly = loaded;
+    CHECK(readonly.get_items(p).size() == 2);
+    CHECK_FALSE(loaded.has_deferred_items());
+    CHECK(loaded.take_deferred_items_unindexed());
+    CHECK_FALSE(loaded.take_deferred_items_unindexed());
+
+    submap empty(tripoint_abs_sm::zero(), {});
+    load_json(empty, store_json(submap(tripoint_abs_sm::zero(), {})));
+    CHECK_FALSE(empty.has_deferred_items());
+}
+
+TEST_CASE("submap batch turns run every registered step", "[submap]") {
+    const auto builtin = std::vector<std::string>{"field", "items", "vehicles"};
+    REQUIRE(submap_batch_turns_steps() == builtin);
+
+    int advanced = 0;
+    register_submap_batch_turns("test_step", [&](submap&, int n) { advanced += n; });
+    CHECK(submap_batch_turns_steps().back() == "test_step");
+    submap sm(tripoint_abs_sm::zero(), {});
+    run_submap_batch_turns(sm, 25);
+    run_submap_batch_turns(sm, 0);
+    CHECK(advanced == 25);
+
+    unregister_submap_batch_turns("test_step");
+    run_submap_batch_turns(sm, 25);
+    CHECK(advanced == 25);
+    CHECK(submap_batch_turns_steps() == builtin);
+}
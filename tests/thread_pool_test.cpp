@@ -0,0 +1,136 @@
+#include "catch/catch.hpp"
+#include "debug.h"
+#include "string_formatter.h"
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+TEST_CASE("parallel_for and parallel_for_chunked each visit every index once", "[thread_pool]") {
+    constexpr auto count = 10000;
+    auto hits = std::vector<std::atomic<int>>(count);
+
+    parallel_for(0, count, [&hits](const int i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+    parallel_for_chunked(0, count, 7, [&hits](const int i) { hits[i].fetch_add(1, std::memory_order_relaxed); });
+
+    const auto all_twice = std::ranges::all_of(hits, [](const auto& h) { return h.load() == 2; });
+    CHECK(all_twice);
+}
+
+TEST_CASE("nested parallel_for completes from worker threads", "[thread_pool]") {
+    constexpr auto outer = 32;
+    constexpr auto inner = 257;
+    auto total = std::atomic<long>{0};
+
+    parallel_for(0, outer, [&total](const int) {
+        parallel_for_chunked(0, inner, 3, [&total](const int i) { total.fetch_add(i, std::memory_order_relaxed); });
+    });
+
+    CHECK(total.load() == static_cast<long>(outer) * (inner * (inner - 1) / 2));
+}
+
+TEST_CASE("parallel_for rethrows the first exception on the caller", "[thread_pool]") {
+    auto ran = std::atomic<int>{0};
+    const auto body = [&ran](const int i) {
+        ran.fetch_add(1, std::memory_order_relaxed);
+        if (i == 37) { throw std::runtime_error("boom"); }
+    };
+
+    CHECK_THROWS_AS(parallel_for(0, 100, body), std::runtime_error);
+    CHECK(ran.load() == 100);
+}
+
+TEST_CASE("debugmsgs collected on workers replay in index order", "[thread_pool]") {
+    constexpr auto count = 64;
+    auto msgs = std::vector<std::vector<deferred_debugmsg>>(count);
+
+    parallel_for(0, count, [&msgs](const int i) {
+        msgs[i] = collect_debugmsgs_during([i]() { debugmsg("check %d", i); });
+    });
+
+    auto expected = std::string{};
+    for (const auto i : std::views::iota(0, count)) {
+        REQUIRE(msgs[i].size() == 1);
+        expected += string_format("check %d", i);
+    }
+    const auto replayed = capture_debugmsg_during([&msgs]() {
+        for (const auto& m : msgs) { replay_debugmsgs(m); }
+    });
+    CHECK(replayed == expected);
+}
+
+TEST_CASE("wait_helping drains submitted tasks", "[thread_pool]") {
+    auto& pool = get_thread_pool();
+    auto futures = std::vector<std::future<int>>{};
+    for (const auto i : std::views::iota(0, 200)) {
+        futures.push_back(pool.submit_returning([](const int x) { return x * 2; }, i));
+    }
+
+    auto sum = 0;
+    for (auto& f : futures) {
+        pool.wait_helping(f);
+        sum += f.get();
+    }
+
+    CHECK(sum == 2 * (199 * 200 / 2));
+}
+
+TEST_CASE("labelled work is counted in pool telemetry", "[thread_pool]") {
+    auto& pool = get_thread_pool();
+    const auto site_tasks = [&pool]() -> uint64_t {
+        const auto stats = pool.stats();
+        const auto it = std::ranges::find_if(
+            stats.sites, [](const thread_pool_stats::site& s) { return std::string_view(s.label) == "test_site"; });
+        return it == stats.sites.end() ? 0 : it->tasks;
+    };
+    const auto before = site_tasks();
+
+    auto f = pool.submit_returning("test_site", []() { return 1; });
+    pool.wait_helping(f);
+    CHECK(f.get() == 1);
+
+    CHECK(pool.stats().workers.size() == pool.num_workers() + 1);
+    if (pool.num_workers() > 0) { CHECK(site_tasks() == before + 1); }
+    CHECK_FALSE(pool.describe_stats().empty());
+}
+
+TEST_CASE("interactive tasks run while background tasks hold their workers", "[thread_pool]") {
+    auto pool = cata_thread_pool(2, {.background_workers = 1});
+    REQUIRE(pool.background_workers() == 1);
+    auto started = std::atomic<int>{0};
+    auto release = std::atomic<bool>{false};
+    const auto blocking = [&started, &release]() {
+        started.fetch_add(1);
+        while (!release.load()) { std::this_thread::yield(); }
+    };
+    const auto wait_until = [](const auto& done) {
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!done() && std::chrono::steady_clock::now() < deadline) { std::this_thread::yield(); }
+        return done();
+    };
+
+    auto first = pool.submit_returning("test_background", blocking);
+    auto second = pool.submit_returning("test_background", blocking);
+    REQUIRE(wait_until([&started]() { return started.load() == 1; }));
+
+    // The second worker is left for interactive work instead of the queued background task
+    auto interactive = pool.submit_returning(task_priority::interactive, "test_interactive", []() { return 7; });
+    REQUIRE(interactive.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+    CHECK(interactive.get() == 7);
+    CHECK(started.load() == 1);
+
+    release.store(true);
+    CHECK(wait_until([&first, &second]() {
+        return first.wait_for(std::chrono::seconds(0)) == std::future_status::ready &&
+               second.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+    }));
+    CHECK(started.load() == 2);
+}
@@ -0,0 +1,35 @@
+#include "calendar.h"
+#include "cata_utility.h"
+#include "catch/catch.hpp"
+#include "coordinates.h"
+#include "timed_event.h"
+
+TEST_CASE("timed_events_are_due_earliest_first_and_cancellable", "[timed_event]") {
+    const auto restore_turn = restore_on_out_of_scope<time_point>(calendar::turn);
+    calendar::turn = calendar::turn_zero + 1_days;
+    const auto start = calendar::turn;
+    const auto where = tripoint_abs_sm(0, 0, 0);
+    auto events = timed_event_manager();
+    CHECK_FALSE(events.next_event_time().has_value());
+
+    const auto late = events.add(TIMED_EVENT_NULL, start + 30_turns, -1, where);
+    const auto early = events.add(TIMED_EVENT_NULL, start + 10_turns, -1, where);
+    events.add(TIMED_EVENT_NULL, start + 20_turns, -1, where);
+    REQUIRE(events.next_event_time() == start + 10_turns);
+
+    // Cancelling the next event exposes the one after it
+    CHECK(events.cancel(early));
+    CHECK_FALSE(events.cancel(early));
+    CHECK(events.next_event_time() == start + 20_turns);
+
+    calendar::turn = start + 25_turns;
+    events.process();
+    CHECK(events.size() == 1);
+    CHECK(events.next_event_time() == start + 30_turns);
+    CHECK(events.queued(TIMED_EVENT_NULL));
+
+    CHECK(events.cancel(late));
+    CHECK(events.size() == 0);
+    CHECK_FALSE(events.next_event_time().has_value());
+    CHECK_FALSE(events.queued(TIMED_EVENT_NULL));
+}
@@ -0,0 +1,99 @@
+#include "catch/catch.hpp"
+#include "timer_wheel.h"
+
+#include <utility>
+#include <vector>
+
+namespace {
+
+auto advance_collect(timer_wheel<int>& wheel, const int now) -> std::vector<std::pair<int, int>> {
+    auto fired = std::vector<std::pair<int, int>>{};
+    wheel.advance_to(now, [&](int&& value, const int due) { fired.emplace_back(value, due); });
+    return fired;
+}
+
+} // namespace
+
+TEST_CASE("timer_wheel_fires_values_when_due", "[timer_wheel]") {
+    auto wheel = timer_wheel<int>();
+    wheel.restart_at(100);
+    wheel.schedule(103, 3);
+    wheel.schedule(101, 1);
+    wheel.schedule(102, 2);
+    REQUIRE(wheel.size() == 3);
+
+    CHECK(advance_collect(wheel, 100).empty());
+    CHECK(advance_collect(wheel, 101) == std::vector<std::pair<int, int>>{{1, 101}});
+    CHECK(advance_collect(wheel, 103) == std::vector<std::pair<int, int>>{{2, 102}, {3, 103}});
+    CHECK(wheel.empty());
+}
+
+TEST_CASE("timer_wheel_cascades_across_levels", "[timer_wheel]") {
+    auto wheel = timer_wheel<int>();
+    wheel.restart_at(10);
+    // One value per level and one past the wheel span.
+    const auto dues = std::vector<int>{40, 10 + 64 * 3 + 5, 10 + 4096 * 2 + 70, 10 + (1 << 18) + 9};
+    for (const auto due : dues) { wheel.schedule(due, due); }
+
+    auto fired = std::vector<std::pair<int, int>>{};
+    for (auto turn = 11; turn <= dues.back() + 1; ++turn) {
+        for (const auto& f : advance_collect(wheel, turn)) {
+            CHECK(f.second == turn);
+            fired.push_back(f);
+        }
+    }
+    REQUIRE(fired.size() == dues.size());
+    for (auto i = 0U; i < dues.size(); ++i) { CHECK(fired[i].first == dues[i]); }
+}
+
+TEST_CASE("timer_wheel_long_jump_fires_everything_due", "[timer_wheel]") {
+    auto wheel = timer_wheel<int>();
+    wheel.schedule(5, 5);
+    wheel.schedule(5000, 5000);
+    wheel.schedule(1 << 20, 1);
+
+    auto fired = advance_collect(wheel, 1 << 19);
+    REQUIRE(fired.size() == 2);
+    CHECK(wheel.size() == 1);
+    CHECK(wheel.now() == 1 << 19);
+
+    fired = advance_collect(wheel, 1 << 20);
+    REQUIRE(fired.size() == 1);
+    CHECK(fired.front().second == 1 << 20);
+}
+
+TEST_CASE("timer_wheel_rearms_from_the_callback", "[timer_wheel]") {
+    auto wheel = timer_wheel<int>();
+    wheel.schedule(7, 0);
+    auto fires = 0;
+    const auto rearm = [&](int&& value, const int due) {
+        ++fires;
+        wheel.schedule(due + 7, value + 1);
+    };
+    wheel.advance_to(70, rearm);
+    CHECK(fires == 10);
+    CHECK(wheel.size() == 1);
+    wheel.advance_to(700, rearm);
+    CHECK(fires == 100);
+}
+
+TEST_CASE("timer_wheel_erase_and_rebase", "[timer_wheel]") {
+    auto wheel = timer_wheel<int>();
+    for (auto i = 1; i <= 200; ++i) { wheel.schedule(i * 50, i); }
+    CHECK(wheel.erase_if([](const int value) { return value % 2 == 0; }) == 100);
+    CHECK(wheel.size() == 100);
+
+    auto count = 0;
+    wheel.for_each([&](const int value) {
+        CHECK(value % 2 == 1);
+        ++count;
+    });
+    CHECK(count == 100);
+
+    // Setting the clock back keeps each value's distance to its time.
+    wheel.rebase(-1000);
+    CHECK(wheel.now() == -1000);
+    const auto fired = advance_collect(wheel, -950);
+    REQUIRE(fired.size() == 1);
+    CHECK(fired.front() == std::pair<int, int>{1, -950});
+}
@@ -0,0 +1,60 @@
+#include "catch/catch.hpp"
+#include "turn_task_graph.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+TEST_CASE("turn_task_graph derives dependencies from resource conflicts", "[turn_task_graph]") {
+    using res = turn_resource;
+    auto graph = turn_task_graph("test_graph");
+    const auto a = graph.add({.name = "a", .reads = {}, .writes = {res::weather}, .run = []() {}});
+    const auto b = graph.add({.name = "b", .reads = {}, .writes = {res::fluid_grids}, .run = []() {}});
+    const auto c = graph.add({.name = "c", .reads = {res::weather}, .writes = {}, .run = []() {}});
+    const auto d = graph.add({.name = "d", .reads = {res::weather}, .writes = {res::fluid_grids}, .run = []() {}});
+
+    CHECK(graph.dependencies(a).empty());
+    CHECK(graph.dependencies(b).empty());
+    CHECK(graph.dependencies(c) == std::vector<int>{a});
+    CHECK(graph.dependencies(d) == std::vector<int>{a, b});
+}
+
+TEST_CASE("turn_task_graph runs conflicting phases in declaration order", "[turn_task_graph]") {
+    using res = turn_resource;
+    auto order = std::vector<int>{};
+    auto order_mutex = std::mutex{};
+    const auto record = [&](const int i) {
+        return [&order, &order_mutex, i]() {
+            const auto lock = std::lock_guard(order_mutex);
+            order.push_back(i);
+        };
+    };
+    auto graph = turn_task_graph("ordered_graph");
+    graph.add({.name = "first", .reads = {}, .writes = {res::scent}, .affinity = turn_task_affinity::any_thread,
+               .run = record(0)});
+    graph.add({.name = "second", .reads = {res::scent}, .writes = {res::sound}, .run = record(1)});
+    graph.add({.name = "third", .reads = {res::sound}, .writes = {}, .affinity = turn_task_affinity::any_thread,
+               .run = record(2)});
+
+    graph.run();
+
+    CHECK(order == std::vector<int>{0, 1, 2});
+    CHECK(graph.critical_path() == std::vector<int>{0, 1, 2});
+}
+
+TEST_CASE("turn_task_graph runs every independent phase once", "[turn_task_graph]") {
+    auto runs = std::atomic<int>{0};
+    auto graph = turn_task_graph("independent_graph");
+    for (auto i = 0; i < 16; ++i) {
+        graph.add({.name = "independent",
+                   .reads = {turn_resource::calendar},
+                   .writes = {},
+                   .affinity = turn_task_affinity::any_thread,
+                   .run = [&runs]() { runs.fetch_add(1); }});
+    }
+
+    graph.run();
+
+    CHECK(runs.load() == 16);
+    CHECK(graph.critical_path().size() == 1);
+}
@@ -11,6 +11,7 @@
 #include "units_volume.h"
 #include "vehicle.h"
 #include "vehicle_part.h"
+#include "vehicle_selector.h"
 #include "vpart_position.h"
 #include "vpart_range.h"
 
@@ -179,6 +180,43 @@ TEST_CASE(
     };
 }
 
+TEST_CASE(
+    "vehicle cargo fill benchmark",
+    "[.][benchmark][vehicle]") {
+    static constexpr auto cargo_item_count = 2048;
+    const auto fixture = make_cargo_benchmark_fixture(cargo_benchmark_options{
+        .cargo_item_count = 0,
+    });
+
+    BENCHMARK_ADVANCED("fill vehicle cargo with 2048 items")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&fixture]() {
+            fill_vehicle_cargo(*fixture.veh, cargo_benchmark_options{
+                .cargo_item_count = cargo_item_count,
+            });
+            return fixture.veh->get_items(cargo_part_indices(*fixture.veh).front()).size();
+        });
+    };
+}
+
+TEST_CASE(
+    "vehicle cargo item query benchmark",
+    "[.][benchmark][vehicle]") {
+    static constexpr auto cargo_item_count = 8196;
+    const auto fixture = make_cargo_benchmark_fixture(cargo_benchmark_options{
+        .cargo_item_count = cargo_item_count,
+    });
+    auto selector = vehicle_selector(fixture.crafter->bub_pos(), 2);
+
+    BENCHMARK_ADVANCED("has_amount and charges_of over 8196 vehicle cargo items")
+    (Catch::Benchmark::Chronometer meter) {
+        meter.measure([&selector]() {
+            return selector.has_amount(itype_id("hammer"), 1) ||
+                   selector.charges_of(fuel_type_battery) > 0;
+        });
+    };
+}
+
 TEST_CASE(
     "vehicle idle benchmark with solar panels and storage batteries",
     "[.][benchmark]["
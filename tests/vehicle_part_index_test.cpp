@@ -0,0 +1,55 @@
+#include "catch/catch.hpp"
+#include "vehicle_part_index.h"
+
+// Only the addresses are used, so the tests never need a real vehicle.
+namespace {
+
+auto fake_vehicle(const int n) -> vehicle* {
+    static char storage[8];
+    return reinterpret_cast<vehicle*>(&storage[n]);
+}
+
+} // namespace
+
+TEST_CASE("vehicle_part_index_set_get_clear", "[vehicle][map_cache]") {
+    auto index = vehicle_part_index(16);
+    const auto a = fake_vehicle(0);
+    const auto b = fake_vehicle(1);
+    CHECK_FALSE(index.any());
+    CHECK(index.get(3) == std::pair<vehicle*, int>(nullptr, -1));
+
+    REQUIRE(index.set(3, a, 7));
+    REQUIRE(index.set(4, b, 65535));
+    CHECK(index.any());
+    CHECK(index.get(3) == std::pair<vehicle*, int>(a, 7));
+    CHECK(index.get(4) == std::pair<vehicle*, int>(b, 65535));
+    CHECK_FALSE(index.set(5, a, 65536));
+
+    // only the vehicle on the tile can clear it
+    CHECK_FALSE(index.clear_if(3, b));
+    CHECK(index.clear_if(3, a));
+    CHECK_FALSE(index.has(3));
+    CHECK(index.clear_if(4, b));
+    CHECK_FALSE(index.any());
+}
+
+TEST_CASE("vehicle_part_index_reuses_slots_of_gone_vehicles", "[vehicle][map_cache]") {
+    auto index = vehicle_part_index(4);
+    const auto a = fake_vehicle(0);
+    const auto b = fake_vehicle(1);
+    REQUIRE(index.set(0, a, 1));
+    // overwriting a's only tile drops a's slot; b takes a slot and both stay readable
+    REQUIRE(index.set(0, b, 2));
+    REQUIRE(index.set(1, a, 3));
+    CHECK(index.get(0) == std::pair<vehicle*, int>(b, 2));
+    CHECK(index.get(1) == std::pair<vehicle*, int>(a, 3));
+    // replacing a part of the same vehicle keeps its slot
+    REQUIRE(index.set(1, a, 4));
+    CHECK(index.get(1) == std::pair<vehicle*, int>(a, 4));
+
+    index.clear_all();
+    CHECK_FALSE(index.any());
+    CHECK_FALSE(index.has(0));
+    REQUIRE(index.set(2, b, 5));
+    CHECK(index.get(2) == std::pair<vehicle*, int>(b, 5));
+}
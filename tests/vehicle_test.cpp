@@ -255,6 +255,34 @@ TEST_CASE("vehicle deserialize keeps valid saved parts after an invalid part", "
     CHECK(veh.mount_to_abs(tripoint_mnt_veh(0, 0, 0)) == tripoint_abs_ms(4, 6, 0));
 }
 
+TEST_CASE("vehicle parts save only members that differ from their defaults", "[vehicle][save]") {
+    auto json = std::istringstream(vehicle_with_legacy_pivot_json());
+    auto jsin = JsonIn(json);
+    auto veh = vehicle();
+    REQUIRE(jsin.read(veh, true));
+    veh.part(0).blood = 50;
+
+    auto os = std::ostringstream();
+    auto jsout = JsonOut(os);
+    veh.part(0).serialize(jsout);
+    const auto saved = os.str();
+    CHECK(saved.find("\"blood\":50") != std::string::npos);
+    CHECK(saved.find("\"enabled\":false") != std::string::npos);
+    CHECK(saved.find("\"open\"") == std::string::npos);
+    CHECK(saved.find("\"passenger_id\"") == std::string::npos);
+    CHECK(saved.find("\"items\"") == std::string::npos);
+
+    auto is = std::istringstream(saved);
+    auto part_in = JsonIn(is);
+    auto loaded = vehicle_part();
+    loaded.deserialize(part_in);
+    CHECK(loaded.blood == 50);
+    CHECK_FALSE(loaded.enabled);
+    CHECK_FALSE(loaded.open);
+    CHECK(loaded.direction == 0_degrees);
+    CHECK_FALSE(loaded.passenger_id.is_valid());
+}
+
 TEST_CASE("detaching_vehicle_unboards_passengers") {
     clear_all_state();
     const tripoint_bub_ms test_origin(60, 60, 0);
@@ -496,6 +524,31 @@ TEST_CASE("add_item_to_broken_vehicle_part") {
     CHECK(itm2);
 }
 
+TEST_CASE("breaking_a_part_refreshes_like_a_full_refresh", "[vehicle]") {
+    clear_all_state();
+    vehicle* veh_ptr =
+        get_map().add_vehicle(vproto_id("car"), tripoint_bub_ms(60, 60, 0), 0_degrees, 100, 0);
+    REQUIRE(veh_ptr != nullptr);
+    REQUIRE(!veh_ptr->wheelcache.empty());
+    REQUIRE(!veh_ptr->engines.empty());
+
+    const auto wheel = veh_ptr->wheelcache.front();
+    const auto engine = veh_ptr->engines.front();
+    veh_ptr->damage(wheel, 100000, DT_TRUE, true, false);
+    veh_ptr->damage(engine, 100000, DT_TRUE, true, false);
+    REQUIRE(veh_ptr->part(wheel).is_broken());
+    REQUIRE(veh_ptr->part(engine).is_broken());
+
+    const auto wheels = veh_ptr->wheelcache;
+    const auto engines = veh_ptr->engines;
+    const auto steering = veh_ptr->steering;
+    veh_ptr->enable_refresh();
+    CHECK(wheels == veh_ptr->wheelcache);
+    CHECK(engines == veh_ptr->engines);
+    CHECK(steering == veh_ptr->steering);
+    CHECK(std::ranges::find(wheels, wheel) == wheels.end());
+}
+
 TEST_CASE("damage_vehicle_oob") {
     clear_all_state();
     const tripoint_bub_ms test_origin(60, 60, 0);
@@ -1,5 +1,7 @@
+#include "cached_options.h"
 #include "calendar.h"
 #include "catch/catch.hpp"
+#include "cata_utility.h"
 #include "character.h"
 #include "coordinates.h"
 #include "field.h"
@@ -9,6 +11,7 @@
 #include "lightmap.h"
 #include "map.h"
 #include "map_helpers.h"
+#include "mapdata.h"
 #include "player_helpers.h"
 #include "shadowcasting.h"
 #include "state_helpers.h"
@@ -662,3 +665,69 @@ TEST_CASE("vision_see_into_vehicle", "[shadowcasting][vision]") {
 
     t.test();
 }
+
+TEST_CASE("vision_many_point_lights_match_serial_casting", "[shadowcasting][vision]") {
+    clear_all_state();
+    const auto was_parallel = parallel_map_cache;
+    const auto restore = on_out_of_scope([was_parallel]() {
+        parallel_map_cache = was_parallel;
+        clear_all_state();
+    });
+    calendar::turn = midnight;
+
+    auto& here = get_map();
+    const auto z = get_player_character().bub_pos().z();
+    // Enough separate fires for the flush to split them over the pool, with walls between
+    // some of them so the shadows differ per source.
+    for (auto y = 6; y < MAPSIZE_Y - 6; y += 5) {
+        for (auto x = 6; x < MAPSIZE_X - 6; x += 5) {
+            here.add_field(tripoint_bub_ms(x, y, z), fd_fire, 2);
+            here.ter_set(tripoint_bub_ms(x + 1, y + 2, z), t_wall);
+        }
+    }
+
+    const auto lightmap_with = [&](const bool parallel) {
+        parallel_map_cache = parallel;
+        here.access_cache(z).point_lights.invalidate();
+        here.invalidate_map_cache(z);
+        here.build_map_cache(z);
+        return here.access_cache(z).lm;
+    };
+    const auto serial = lightmap_with(false);
+    const auto parallel = lightmap_with(true);
+    REQUIRE(serial.size() == parallel.size());
+    auto differing = 0;
+    for (auto i = std::size_t{0}; i < serial.size(); ++i) {
+        if (serial[i] != parallel[i]) { ++differing; }
+    }
+    CHECK(differing == 0);
+}
+
+TEST_CASE("vision_relit_point_lights_match_full_relight", "[shadowcasting][vision]") {
+    clear_all_state();
+    const auto restore = on_out_of_scope([]() { clear_all_state(); });
+    calendar::turn = midnight;
+
+    auto& here = get_map();
+    const auto z = get_player_character().bub_pos().z();
+    const auto fires = std::vector<tripoint_bub_ms>{
+        {20, 20, z}, {30, 24, z}, {60, 60, z}, {64, 58, z}, {100, 90, z}};
+    for (const auto& p : fires) { here.add_field(p, fd_fire, 2); }
+    const auto build = [&]() {
+        here.invalidate_map_cache(z);
+        here.build_map_cache(z);
+    };
+    build();
+
+    // Put one fire out and wall in another: only the lights around them are cast again.
+    here.remove_field(fires[0], fd_fire);
+    here.ter_set(fires[3] + point_east, t_wall);
+    build();
+    const auto relit = here.access_cache(z).lm;
+    CHECK_FALSE(here.access_cache(z).point_lights.last_update().rebuilt);
+
+    here.access_cache(z).point_lights.invalidate();
+    build();
+    CHECK(here.access_cache(z).point_lights.last_update().rebuilt);
+    CHECK(relit == here.access_cache(z).lm);
+}
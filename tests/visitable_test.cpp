@@ -18,3 +18,27 @@ TEST_CASE("visitable_summation") {
 
     CHECK(test_inv.charges_of(itype_id("water"), item::INFINITE_CHARGES) > 1);
 }
+
+TEST_CASE("visitable_queries_follow_nested_contents_changes") {
+    detached_ptr<item> backpack = item::spawn("backpack", calendar::turn);
+    detached_ptr<item> bottle = item::spawn("bottle_plastic", calendar::turn);
+    detached_ptr<item> water = item::spawn("water", calendar::turn);
+    water->charges = 2;
+    bottle->put_in(std::move(water));
+    backpack->put_in(std::move(bottle));
+    const auto water_id = itype_id("water");
+
+    CHECK(backpack->contents.has_type_recursive(water_id));
+    CHECK(backpack->charges_of(water_id) == 2);
+    CHECK(backpack->amount_of(water_id) == 1);
+    CHECK(backpack->amount_of(itype_id("bottle_plastic")) == 1);
+
+    auto& inner = backpack->contents.front();
+    inner.contents.clear_items();
+    CHECK_FALSE(backpack->contents.has_type_recursive(water_id));
+    CHECK(backpack->charges_of(water_id) == 0);
+    CHECK(backpack->amount_of(water_id) == 0);
+
+    inner.put_in(item::spawn("water", calendar::turn, 3));
+    CHECK(backpack->charges_of(water_id) == 3);
+}
@@ -1,6 +1,7 @@
 #include "calendar.h"
 #include "catch/catch.hpp"
 #include "coordinates.h"
+#include "simplexnoise.h"
 #include "weather.h"
 #include "weather_gen.h"
 
@@ -100,6 +101,41 @@ TEST_CASE("eternal seasons", "[weather]") {
     }
 }
 
+TEST_CASE("temperature noise is interpolated between hourly overmap tile samples", "[weather]") {
+    auto generator = weather_generator();
+    for (auto& season : generator.season_stats) { season.average_temperature = 10_c; }
+    generator.temperature_daily_amplitude = 0_c;
+    generator.temperature_noise_amplitude = 100_c;
+    const auto calendar = calendar_config(calendar::turn_zero, calendar::turn_zero, SPRING, true);
+    const unsigned seed = 7;
+    const auto noise_at = [&](const tripoint_abs_ms& p, const time_point& t) {
+        return (units::to_celsius<double>(generator.get_weather_temperature(p, t, calendar, seed))
+                - 10.0)
+               / 100.0;
+    };
+
+    const auto hour = calendar::turn_zero + 10_hours;
+    const auto corner = tripoint_abs_ms(48, -24, 0);
+    CHECK(noise_at(corner, hour) == Approx(raw_noise_4d(48 / 2000.0, -24 / 2000.0,
+                                                        to_days<double>(10_hours), seed)));
+
+    auto lowest = 1.0;
+    auto highest = -1.0;
+    for (const auto& d : {point_zero, point(24, 0), point(0, 24), point(24, 24)}) {
+        for (const auto& t : {hour, hour + 1_hours}) {
+            const auto n = noise_at(corner + d, t);
+            lowest = std::min(lowest, n);
+            highest = std::max(highest, n);
+        }
+    }
+    const auto between = noise_at(corner + point(12, 5), hour + 20_minutes);
+    CHECK(between >= Approx(lowest));
+    CHECK(between <= Approx(highest));
+    // Asking again, after the samples may have been evicted, gives the same answer
+    for (int i = 0; i < 10000; ++i) { noise_at(tripoint_abs_ms(i * 24, 0, 0), hour); }
+    CHECK(noise_at(corner + point(12, 5), hour + 20_minutes) == between);
+}
+
 TEST_CASE("water temperatures track season temperatures", "[weather]") {
     auto generator = weather_generator();
     auto& season_stats = generator.season_stats;
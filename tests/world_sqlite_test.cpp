@@ -2,14 +2,19 @@
 #include "coordinates.h"
 #include "filesystem.h"
 #include "game.h"
+#include "map_snapshot.h"
+#include "sqlite3.h"
 #include "thread_pool.h"
 #include "world.h"
 
 #include <algorithm>
 #include <atomic>
+#include <iterator>
 #include <ostream>
 #include <ranges>
 #include <stdexcept>
+#include <string>
+#include <vector>
 
 namespace {
 
@@ -72,3 +77,71 @@ TEST_CASE("sqlite map database accepts concurrent map reads", "[world][sqlite]")
 
     CHECK(all_read.load(std::memory_order_relaxed));
 }
+
+TEST_CASE("sqlite map database reads a batch of omts in one call", "[world][sqlite]") {
+    auto* const w = g->get_active_world();
+    REQUIRE(w != nullptr);
+    REQUIRE(w->info->world_save_format == save_format::V2_COMPRESSED_SQLITE3);
+
+    static constexpr auto batch_size = 8;
+    const auto dim_id = "sqlite_batch_reads_" + get_pid_string();
+
+    // Only even omts are written; the batch must skip the rest.
+    const auto omts = std::views::iota(0, batch_size)
+                      | std::views::transform([](const auto i) { return concurrent_test_omt(i + 200); })
+                      | std::ranges::to<std::vector>();
+    std::ranges::for_each(std::views::iota(0, batch_size / 2), [&](const auto i) {
+        REQUIRE(w->write_map_omt(dim_id, omts[i * 2], [i](std::ostream& out) { out << "[" << i << "]"; }));
+    });
+
+    auto seen = std::vector<std::string>(batch_size);
+    w->read_map_omts_data(dim_id, omts, [&](const tripoint_abs_omt& omt_addr, std::istream& fin) {
+        const auto index = std::ranges::find(omts, omt_addr) - omts.begin();
+        seen[index] = std::string(std::istreambuf_iterator<char>(fin), {});
+    });
+
+    std::ranges::for_each(std::views::iota(0, batch_size), [&](const auto i) {
+        CAPTURE(i);
+        CHECK(seen[i] == (i % 2 == 0 ? "[" + std::to_string(i / 2) + "]" : ""));
+    });
+}
+
+TEST_CASE("map snapshot packs every row of a map database", "[world][sqlite]") {
+    auto* const w = g->get_active_world();
+    REQUIRE(w != nullptr);
+    const auto db_path = w->info->folder_path() + "/snapshot_test_" + get_pid_string() + ".sqlite3";
+    const auto snapshot_path = db_path + ".snapshot";
+
+    sqlite3* db = nullptr;
+    REQUIRE(sqlite3_open(db_path.c_str(), &db) == SQLITE_OK);
+    REQUIRE(sqlite3_exec(db,
+                         "CREATE TABLE files (path TEXT PRIMARY KEY, compression TEXT, data BLOB);"
+                         "INSERT INTO files VALUES ('maps/b.map', 'zlib', x'0102');"
+                         "INSERT INTO files VALUES ('maps/a.map', NULL, '[1]');"
+                         "INSERT INTO files VALUES ('maps/c.map', 'zlib', x'03');",
+                         nullptr, nullptr, nullptr) == SQLITE_OK);
+    map_snapshot::write(db, 7, snapshot_path);
+    sqlite3_close(db);
+
+    auto snapshot = map_snapshot::open(snapshot_path);
+    REQUIRE(snapshot != nullptr);
+    CHECK(snapshot->generation() == 7);
+    CHECK(snapshot->size() == 3);
+
+    const auto a = snapshot->find("maps/a.map");
+    REQUIRE(a.has_value());
+    CHECK(a->data == "[1]");
+    CHECK(a->compression.empty());
+    const auto c = snapshot->find("maps/c.map");
+    REQUIRE(c.has_value());
+    CHECK(c->data == std::string_view("\x03", 1));
+    CHECK(c->compression == "zlib");
+    CHECK(snapshot->find("maps/b.map")->data.size() == 2);
+    CHECK_FALSE(snapshot->find("maps/d.map").has_value());
+    CHECK_FALSE(snapshot->find("maps/").has_value());
+
+    // Windows cannot delete a mapped file.
+    snapshot.reset();
+    remove_file(db_path);
+    remove_file(snapshot_path);
+}
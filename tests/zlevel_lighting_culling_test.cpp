@@ -0,0 +1,73 @@
+#include "cached_options.h"
+#include "catch/catch.hpp"
+#include "cata_utility.h"
+#include "game_constants.h"
+#include "lightmap.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "point.h"
+#include "state_helpers.h"
+#include "type_id.h"
+
+#include <cstddef>
+
+namespace {
+
+auto level_bit(int z) -> std::size_t { return static_cast<std::size_t>(z + OVERMAP_DEPTH); }
+
+// A lit room two levels down, under solid rock, while the avatar stands on the surface.
+auto build_buried_room(map& here) -> tripoint_bub_ms {
+    const auto center = tripoint_bub_ms(30, 30, -2);
+    for (int dx = -3; dx <= 3; ++dx) {
+        for (int dy = -3; dy <= 3; ++dy) {
+            here.ter_set(center + tripoint_rel_ms(dx, dy, 0), ter_id("t_thconc_floor"));
+        }
+    }
+    here.ter_set(center, ter_id("t_thconc_floor_olight"));
+    here.invalidate_map_cache(-2);
+    here.invalidate_lightmap_caches();
+    return center;
+}
+
+} // namespace
+
+TEST_CASE("zlevel_lighting_culling_stops_at_solid_ground", "[lightmap][vision]") {
+    clear_all_state();
+    const auto restore = restore_on_out_of_scope<bool>(zlevel_lighting_culling);
+    zlevel_lighting_culling = true;
+    auto& here = get_map();
+    here.build_map_cache(0);
+
+    // The surface has a floor everywhere; the open air above has none.
+    const auto [lo, hi] = here.zlevel_sight_span(0);
+    CHECK(lo == 0);
+    CHECK(hi == OVERMAP_HEIGHT);
+    const auto observed = here.lighting_observed_levels(0);
+    CHECK(observed.test(level_bit(0)));
+    CHECK(observed.test(level_bit(1)));
+    CHECK_FALSE(observed.test(level_bit(-1)));
+    CHECK_FALSE(observed.test(level_bit(-2)));
+}
+
+TEST_CASE("zlevel_lighting_culling_lights_a_hidden_level_once_read", "[lightmap][vision]") {
+    clear_all_state();
+    const auto restore = restore_on_out_of_scope<bool>(zlevel_lighting_culling);
+    auto& here = get_map();
+
+    SECTION("with culling the buried light waits for a reader") {
+        zlevel_lighting_culling = true;
+        const auto light = build_buried_room(here);
+        here.build_map_cache(0);
+        // This read is what asks for the level's lights.
+        CHECK(here.ambient_light_at(light) < LIGHT_AMBIENT_LIT);
+        here.build_map_cache(0);
+        CHECK(here.ambient_light_at(light) >= LIGHT_AMBIENT_LIT);
+    }
+    SECTION("without culling it is lit straight away") {
+        zlevel_lighting_culling = false;
+        const auto light = build_buried_room(here);
+        here.build_map_cache(0);
+        CHECK(here.ambient_light_at(light) >= LIGHT_AMBIENT_LIT);
+    }
+    clear_all_state();
+}
@@ -0,0 +1,147 @@
+#!/usr/bin/env python3
+"""Train a preset zlib dictionary for save blobs.
+
+Samples the blobs of one category from existing worlds and writes
+data/raw/save_dictionaries/<category>.v<N>.dict.  See src/save_dictionary.h.
+
+Shipped dictionaries must never change: old saves name the exact version they
+were compressed with.  Train a new version instead.
+
+Example:
+
+    tools/train_save_dictionary.py --category submap --version 2 \\
+        save/World1 save/World2
+"""
+
+import argparse
+import collections
+import os
+import random
+import re
+import sqlite3
+import sys
+import zlib
+
+# zlib only looks back this far, so a longer dictionary is dead weight.
+MAX_DICTIONARY_SIZE = 32768
+TOKEN = re.compile(rb'"(?:[^"\\]|\\.)*"|-?\d+|[\[\]{}:,]|\s+')
+MIN_BLOBS = 2
+MAX_NGRAM = 8
+
+
+def category_of(path):
+    """Keep in step with category_of() in src/save_dictionary.cpp."""
+    if path.endswith(".map"):
+        return "submap"
+    if re.split(r"[/\\]", path)[-1].startswith("o."):
+        return "overmap"
+    return None
+
+
+def load_dictionaries(directory):
+    out = {}
+    if os.path.isdir(directory):
+        for name in os.listdir(directory):
+            if name.endswith(".dict"):
+                with open(os.path.join(directory, name), "rb") as f:
+                    out[name[:-len(".dict")]] = f.read()
+    return out
+
+
+def decompress(data, compression, dictionaries):
+    if not compression:
+        return data
+    if compression.startswith("zlib-dict:"):
+        d = zlib.decompressobj(zdict=dictionaries[compression[len("zlib-dict:"):]])
+        return d.decompress(data) + d.flush()
+    return zlib.decompress(data)
+
+
+def blobs_from_world(world, category, dictionaries):
+    db_path = os.path.join(world, "map.sqlite3")
+    if os.path.exists(db_path):
+        db = sqlite3.connect("file:{}?mode=ro".format(db_path), uri=True)
+        for path, data, compression in db.execute(
+                "SELECT path, data, compression FROM files"):
+            if category_of(path) == category:
+                yield decompress(data, compression, dictionaries)
+        db.close()
+        return
+    # Uncompressed worlds keep one file per blob.
+    for root, _, files in os.walk(world):
+        for name in files:
+            if category_of(name) == category:
+                with open(os.path.join(root, name), "rb") as f:
+                    yield f.read()
+
+
+def train(blobs, size):
+    """Greedy substring pick: score is bytes saved across the sample."""
+    counts = collections.Counter()
+    for blob in blobs:
+        tokens = TOKEN.findall(blob)
+        seen = set()
+        for n in range(1, MAX_NGRAM + 1):
+            for i in range(len(tokens) - n + 1):
+                seen.add(b"".join(tokens[i:i + n]))
+        # Count each substring once per blob so one huge blob cannot dominate.
+        counts.update(s for s in seen if len(s) >= 4)
+
+    candidates = sorted(
+        ((count * len(s), s) for s, count in counts.items() if count >= MIN_BLOBS),
+        reverse=True)
+    chosen = []
+    total = 0
+    for _, s in candidates:
+        if total + len(s) > size:
+            continue
+        if any(s in c for c in chosen):
+            continue
+        chosen.append(s)
+        total += len(s)
+        if total >= size:
+            break
+    # zlib favours short distances, so the most valuable strings go last.
+    return b"".join(reversed(chosen))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("worlds", nargs="+", help="world directories to sample")
+    parser.add_argument("--category", required=True, choices=["submap", "overmap"])
+    parser.add_argument("--version", required=True, type=int)
+    parser.add_argument("--size", type=int, default=MAX_DICTIONARY_SIZE)
+    parser.add_argument("--samples", type=int, default=2000,
+                        help="blobs to sample across all worlds")
+    parser.add_argument("--out", default="data/raw/save_dictionaries")
+    args = parser.parse_args()
+
+    target = os.path.join(args.out, "{}.v{}.dict".format(args.category, args.version))
+    if os.path.exists(target):
+        sys.exit("{} already exists; shipped dictionaries must not change".format(target))
+
+    dictionaries = load_dictionaries(args.out)
+    blobs = [b for w in args.worlds for b in blobs_from_world(w, args.category, dictionaries)
+             if not b.startswith(b"CBSM")]
+    if not blobs:
+        sys.exit("no {} blobs found".format(args.category))
+    random.seed(0)
+    sample = random.sample(blobs, min(args.samples, len(blobs)))
+
+    dictionary = train(sample, min(args.size, MAX_DICTIONARY_SIZE))
+    with open(target, "wb") as f:
+        f.write(dictionary)
+
+    plain = sum(len(zlib.compress(b, 1)) for b in sample)
+    primed = 0
+    for b in sample:
+        c = zlib.compressobj(1, zdict=dictionary)
+        primed += len(c.compress(b) + c.flush())
+    print("{}: {} bytes, sample compresses to {:.1%} of plain zlib".format(
+        target, len(dictionary), primed / plain))
+
+
+if __name__ == "__main__":
+    main()